@@ -0,0 +1,20 @@
+# Metal compute backend for the carve stock-removal simulation (macOS only);
+# other platforms build the CPU tile rasterizer alone
+
+option(CHIP_CARVING_GPU_SIMULATION "Rasterize carve simulations with Metal compute on macOS" ON)
+
+set(CARVE_SIMULATION_METAL_SOURCE ${CMAKE_CURRENT_LIST_DIR}/../src/geometry/CarveSimulationMetal.mm)
+
+if(APPLE AND CHIP_CARVING_GPU_SIMULATION)
+    enable_language(OBJCXX)
+    set_source_files_properties(${CARVE_SIMULATION_METAL_SOURCE} PROPERTIES COMPILE_OPTIONS "-fobjc-arc")
+endif()
+
+# Function to add the Metal backend to a target that compiles CarveSimulationGpu.cpp
+function(add_carve_simulation_gpu target)
+    if(APPLE AND CHIP_CARVING_GPU_SIMULATION)
+        target_sources(${target} PRIVATE ${CARVE_SIMULATION_METAL_SOURCE})
+        target_compile_definitions(${target} PRIVATE CHIP_CARVING_METAL)
+        target_link_libraries(${target} "-framework Metal" "-framework Foundation")
+    endif()
+endfunction()
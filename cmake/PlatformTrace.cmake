@@ -0,0 +1,24 @@
+# Native profiler annotations for trace spans (utils/PlatformTrace.h).
+# macOS (os_signpost) and Windows (ETW TraceLogging) need nothing extra; Intel
+# ITT replaces them when enabled and ittnotify is found (VTune's SDK directory)
+
+option(CHIP_CARVING_ITT "Annotate trace spans with Intel ITT for VTune" OFF)
+
+if(CHIP_CARVING_ITT)
+    find_path(ITTNOTIFY_INCLUDE_DIR ittnotify.h
+        HINTS $ENV{VTUNE_PROFILER_DIR}/include $ENV{VTUNE_PROFILER_DIR}/sdk/include)
+    find_library(ITTNOTIFY_LIBRARY NAMES ittnotify libittnotify
+        HINTS $ENV{VTUNE_PROFILER_DIR}/lib64 $ENV{VTUNE_PROFILER_DIR}/sdk/lib64)
+    if(NOT ITTNOTIFY_INCLUDE_DIR OR NOT ITTNOTIFY_LIBRARY)
+        message(WARNING "CHIP_CARVING_ITT is on but ittnotify was not found; trace spans use the platform default")
+    endif()
+endif()
+
+# Function to add the ITT backend to a target that compiles PlatformTrace.cpp
+function(add_platform_trace target)
+    if(CHIP_CARVING_ITT AND ITTNOTIFY_INCLUDE_DIR AND ITTNOTIFY_LIBRARY)
+        target_include_directories(${target} PRIVATE ${ITTNOTIFY_INCLUDE_DIR})
+        target_compile_definitions(${target} PRIVATE CHIP_CARVING_ITT)
+        target_link_libraries(${target} ${ITTNOTIFY_LIBRARY} ${CMAKE_DL_LIBS})
+    endif()
+endfunction()
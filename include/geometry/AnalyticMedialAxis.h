@@ -0,0 +1,87 @@
+/**
+ * AnalyticMedialAxis.h
+ *
+ * Closed-form medial axis generation for imported shapes whose geometry is
+ * known exactly. Profiles that still match their imported shape skip
+ * polygonization and OpenVoronoi entirely (Leaf, TriArc); anything else falls back to
+ * MedialAxisProcessor.
+ */
+
+#pragma once
+
+#include <vector>
+
+#include "Leaf.h"
+#include "MedialAxisProcessor.h"
+#include "Point2D.h"
+#include "Shape.h"
+#include "TriArc.h"
+
+namespace ChipCarving {
+namespace Geometry {
+
+// Number of segments used to sample an analytic medial axis chain
+constexpr int ANALYTIC_MEDIAL_AXIS_SEGMENTS = 64;
+
+/**
+ * Check whether a polygon is an unedited tessellation of a leaf
+ * Every vertex must lie on one of the two leaf arcs, both foci must be present,
+ * and both arcs must be represented.
+ * @param polygon Profile polygon (same units as the leaf)
+ * @param leaf Leaf to compare against
+ * @param tolerance Maximum distance of a vertex from the leaf boundary
+ * @return true if the polygon traces the leaf boundary
+ */
+bool polygonMatchesLeaf(const std::vector<Point2D>& polygon, const Leaf& leaf, double tolerance);
+
+/**
+ * Compute the medial axis of a leaf in closed form
+ *
+ * The medial axis of a vesica piscis is the chord between its foci. At distance
+ * t from the chord midpoint the clearance is r - sqrt(d^2 + t^2), where r is the
+ * arc radius and d the chord-center to arc-center distance.
+ *
+ * @param leaf Leaf shape (results are in the leaf's units)
+ * @param segments Number of chain segments to sample
+ * @return Medial axis results with a single chain from focus1 to focus2
+ */
+MedialAxisResults computeLeafMedialAxis(const Leaf& leaf, int segments = ANALYTIC_MEDIAL_AXIS_SEGMENTS);
+
+/**
+ * Check whether a polygon is an unedited tessellation of a TriArc
+ * Every vertex must lie on one of the three edges, all three corners must be
+ * present, and every curved edge must be represented.
+ * @param polygon Profile polygon (same units as the TriArc)
+ * @param triArc TriArc to compare against
+ * @param tolerance Maximum distance of a vertex from the TriArc boundary
+ * @return true if the polygon traces the TriArc boundary
+ */
+bool polygonMatchesTriArc(const std::vector<Point2D>& polygon, const TriArc& triArc, double tolerance);
+
+/**
+ * Compute the medial axis of a TriArc without polygonization or OpenVoronoi
+ *
+ * Each branch is traced exactly as the intersection of its two adjacent edges
+ * offset inward by the branch clearance; the junction is where the third
+ * edge's offset meets the branch, found by bisection.
+ *
+ * @param triArc TriArc shape (results are in the TriArc's units)
+ * @param segments Number of segments sampled per branch
+ * @return Medial axis results with chains vertex0 -> junction -> vertex1 and junction -> vertex2
+ */
+MedialAxisResults computeTriArcMedialAxis(const TriArc& triArc, int segments = ANALYTIC_MEDIAL_AXIS_SEGMENTS / 2);
+
+/**
+ * Try to compute the medial axis of a profile analytically from its source shape
+ * @param shape Imported shape the profile may have been drawn from
+ * @param shapeScale Multiplier converting shape units to polygon units
+ * @param polygon Profile polygon
+ * @param tolerance Match tolerance in polygon units
+ * @param results Output results (only written on success)
+ * @return true if the shape type is supported and the polygon still matches it
+ */
+bool computeAnalyticMedialAxis(const Shape& shape, double shapeScale, const std::vector<Point2D>& polygon,
+                               double tolerance, MedialAxisResults& results);
+
+}  // namespace Geometry
+}  // namespace ChipCarving
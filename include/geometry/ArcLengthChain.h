@@ -0,0 +1,69 @@
+/**
+ * ArcLengthChain.h
+ *
+ * Arc-length parameterization of one medial axis chain. The cumulative length
+ * table is built in one pass; positions and clearances at any distance s
+ * along the chain are then found by binary search over it instead of walking
+ * the chain from its start.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <vector>
+
+#include "MedialAxisChains.h"
+#include "Point2D.h"
+
+namespace ChipCarving {
+namespace Geometry {
+
+class ArcLengthChain {
+ public:
+  // Segment i runs from chain point i to point i + 1; t in [0, 1] along it
+  struct Location {
+    size_t segment = 0;
+    double t = 0.0;
+  };
+
+  ArcLengthChain() = default;
+  explicit ArcLengthChain(const MedialAxisChains::ChainView& chain, double unitScale = 1.0) {
+    assign(chain, unitScale);
+  }
+
+  /**
+   * Parameterize chain, reusing this table's storage. The chain's arrays are
+   * read again by pointAt() and clearanceAt(), so they must outlive this.
+   * @param unitScale Applied to coordinates, clearances and lengths (e.g. cm to mm)
+   */
+  void assign(const MedialAxisChains::ChainView& chain, double unitScale = 1.0);
+
+  size_t size() const {
+    return lengths_.size();
+  }
+  bool empty() const {
+    return lengths_.empty();
+  }
+  double totalLength() const {
+    return lengths_.empty() ? 0.0 : lengths_.back();
+  }
+  // Distance along the chain to point i
+  double arcLength(size_t i) const {
+    return lengths_[i];
+  }
+
+  // Segment and position within it at distance s (clamped to the chain)
+  Location locate(double s) const;
+
+  // Linearly interpolated position and clearance at distance s (scaled)
+  Point2D pointAt(double s) const;
+  double clearanceAt(double s) const;
+
+ private:
+  MedialAxisChains::ChainView chain_{nullptr, nullptr, nullptr, 0};
+  double unitScale_ = 1.0;
+  std::vector<double> lengths_{};  // lengths_[i] = distance along the chain to point i
+};
+
+}  // namespace Geometry
+}  // namespace ChipCarving
@@ -0,0 +1,51 @@
+/**
+ * CanonicalShape.h
+ *
+ * Similarity-invariant fingerprints of profile outlines. A polygon is moved to
+ * its area centroid, turned onto its principal axis and scaled to unit area,
+ * so repeated copies of one shape (rosettes, borders) share a key no matter
+ * where they sit, how they are rotated, how large they are or which vertex
+ * they start at. The medial axis of one copy maps onto every other copy.
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+#include "MedialAxisProcessor.h"
+#include "Point2D.h"
+
+namespace ChipCarving {
+namespace Geometry {
+
+struct CanonicalShape {
+  uint64_t key = 0;              // Hash of the quantized normalized outline
+  Point2D centroid{0, 0};        // Area centroid in world coordinates
+  double angle = 0.0;            // Rotation from the canonical frame to world (radians)
+  double scale = 0.0;            // Square root of the area
+  std::vector<Point2D> normal{};  // Counter-clockwise normalized outline from its canonical start vertex
+};
+
+/**
+ * Normalize polygon by centroid, principal axis and scale
+ * @param polygon Outline in world coordinates (a closing duplicate vertex is ignored)
+ * @return false for fewer than 3 vertices or zero area
+ */
+bool canonicalizeShape(const std::vector<Point2D>& polygon, CanonicalShape& shape);
+
+/**
+ * Whether two canonical shapes are the same outline, checked vertex by vertex
+ * so a key collision never merges different shapes
+ */
+bool sameCanonicalShape(const CanonicalShape& a, const CanonicalShape& b);
+
+/**
+ * Map a medial axis computed for one copy of a shape onto another copy;
+ * points and clearances follow the rotation, translation and scale between them
+ */
+MedialAxisResults transformMedialAxis(const MedialAxisResults& results, const CanonicalShape& from,
+                                      const CanonicalShape& to);
+
+}  // namespace Geometry
+}  // namespace ChipCarving
@@ -0,0 +1,130 @@
+/**
+ * CarveSimulation.h
+ *
+ * Raster stock-removal simulation for toolpath verification. V-bit sweeps of
+ * VCarveResults are rasterized into a depth map on a tile grid, each tile on
+ * a worker thread, and the map is compared with the shapes' contains() masks:
+ * cuts outside every shape are gouges, uncut cells inside one are missed
+ * areas. Verifies a carve in seconds instead of a Fusion CAM simulation.
+ * On macOS the sweeps can instead be rasterized by a Metal compute kernel,
+ * one GPU thread per cell, falling back to the CPU tiles without a device.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "Point2D.h"
+#include "Point3D.h"
+#include "Shape.h"
+#include "VCarvePath.h"
+
+namespace ChipCarving {
+namespace Geometry {
+
+enum class CarveSimulationBackend : uint8_t {
+  CPU,  // Tiles on worker threads
+  GPU,  // Compute kernel where available (Metal on macOS), else CPU tiles
+};
+
+struct CarveSimulationParams {
+  double resolution = 0.1;        // Cell size (mm)
+  double toolAngle = 90.0;        // V-bit included angle (degrees)
+  double toolDiameter = 6.35;     // Cutting diameter (mm); the cone ends there
+  double depthTolerance = 0.05;   // Cuts shallower than this count as uncut (mm)
+  int workers = 0;                // Worker threads (0 = hardware concurrency, 1 = sequential)
+  int tileSize = 64;              // Cells per tile side
+  size_t maxCells = 64u << 20;    // Larger areas are rejected instead of exhausting memory
+  CarveSimulationBackend backend = CarveSimulationBackend::CPU;  // Where the sweeps are rasterized
+};
+
+/**
+ * Cut depth per cell, row-major from origin (mm, positive = down, 0 = uncut)
+ */
+struct DepthMap {
+  Point2D origin{};  // Lower-left corner of cell (0, 0)
+  double resolution = 0.0;
+  int width = 0;
+  int height = 0;
+  std::vector<float> depth{};
+  CarveSimulationBackend backend = CarveSimulationBackend::CPU;  // Where it was rasterized
+
+  float at(int x, int y) const {
+    return depth[static_cast<size_t>(y) * width + x];
+  }
+  Point2D cellCenter(int x, int y) const {
+    return Point2D(origin.x + (x + 0.5) * resolution, origin.y + (y + 0.5) * resolution);
+  }
+};
+
+enum class CarveCell : uint8_t {
+  STOCK,   // Outside every shape and uncut
+  CARVED,  // Inside a shape and cut
+  GOUGE,   // Cut outside every shape
+  MISSED,  // Inside a shape but left uncut
+};
+
+/**
+ * Cell classification against the shape masks. Cells within a tolerance band
+ * of a shape boundary, where a correct V-carve is shallower than
+ * depthTolerance, are never reported as gouges or misses.
+ */
+struct CarveVerification {
+  int width = 0;
+  int height = 0;
+  std::vector<CarveCell> cells{};  // Same layout as the depth map
+  size_t insideCells = 0;
+  size_t carvedCells = 0;
+  size_t gougeCells = 0;
+  size_t missedCells = 0;
+  double maxGougeDepth = 0.0;  // mm
+
+  bool passed() const {
+    return gougeCells == 0 && missedCells == 0;
+  }
+};
+
+/**
+ * Area covering shapes and everything the tool can reach around them
+ * @param margin Added on every side (mm); at least the tool radius
+ */
+ShapeBounds simulationArea(const std::vector<const Shape*>& shapes, double margin);
+
+/**
+ * Whether this build has a GPU backend and the machine a device to run it
+ */
+bool carveSimulationGpuAvailable();
+
+/**
+ * Rasterize the V-bit sweeps of every valid path over area
+ * Depth varies linearly along each segment; a cell takes the deepest cut of
+ * any segment, computed exactly for the cone swept along it. The GPU backend
+ * computes the same cut in single precision.
+ * @throws std::invalid_argument for a non-positive resolution or tool angle, or too many cells
+ */
+DepthMap simulateCarve(const VCarveResults& results, const ShapeBounds& area, const CarveSimulationParams& params);
+
+/**
+ * Rasterize toolpaths given as points with z = -depth, as carve-cli stores them
+ */
+DepthMap simulateCarve(const std::vector<std::vector<Point3D>>& toolpaths, const ShapeBounds& area,
+                       const CarveSimulationParams& params);
+
+/**
+ * Classify every cell of map against the shapes' contains() masks
+ */
+CarveVerification verifyCarve(const DepthMap& map, const std::vector<const Shape*>& shapes,
+                              const CarveSimulationParams& params);
+
+/**
+ * Write the verification as an RGB PNG, north up: stock, carved shaded by
+ * depth, gouges red, missed areas blue
+ * @return false if the file could not be written
+ */
+bool writeCarveVerificationPng(const std::string& path, const DepthMap& map, const CarveVerification& verification);
+
+}  // namespace Geometry
+}  // namespace ChipCarving
@@ -0,0 +1,89 @@
+/**
+ * CompactPaths.h
+ *
+ * Compact storage for computed toolpaths held between compute and write.
+ * Coordinates are bounded by the stock, so float32 offsets from a double
+ * origin keep well under a micron of precision at half the memory of the
+ * double-precision point structs. Values are stored structure-of-arrays and
+ * are converted back to doubles only where the sketch or G-code is written.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "Point2D.h"
+
+namespace ChipCarving {
+namespace Geometry {
+
+struct VCarvePath;
+struct SampledMedialPath;
+
+/**
+ * V-carve paths in float32 structure-of-arrays form
+ */
+struct CompactVCarvePaths {
+  Point2D origin{0, 0};            ///< Positions are stored relative to this point (mm)
+  std::vector<float> x{};          ///< Offset from origin.x per point (mm)
+  std::vector<float> y{};          ///< Offset from origin.y per point (mm)
+  std::vector<float> depth{};      ///< VCarvePoint::depth per point (mm)
+  std::vector<float> clearance{};  ///< VCarvePoint::clearanceRadius per point (mm)
+  std::vector<float> surfaceZ{};   ///< VCarvePoint::surfaceZ per point (mm)
+  std::vector<uint8_t> surfaceProjected{};
+
+  std::vector<uint32_t> pathStarts{};  ///< First point of each path; one extra entry ends the last path
+  std::vector<double> pathLengths{};
+  std::vector<uint8_t> pathClosed{};
+
+  size_t pathCount() const {
+    return pathStarts.empty() ? 0 : pathStarts.size() - 1;
+  }
+
+  size_t pointCount() const {
+    return x.size();
+  }
+
+  // Heap bytes held by the arrays
+  size_t bytes() const;
+};
+
+/**
+ * Sampled medial axis paths in float32 structure-of-arrays form
+ */
+struct CompactSampledMedialPaths {
+  Point2D origin{0, 0};
+  std::vector<float> x{};
+  std::vector<float> y{};
+  std::vector<float> clearance{};
+  std::vector<uint32_t> pathStarts{};  ///< First point of each path; one extra entry ends the last path
+  std::vector<double> pathLengths{};
+
+  size_t pathCount() const {
+    return pathStarts.empty() ? 0 : pathStarts.size() - 1;
+  }
+
+  size_t bytes() const;
+};
+
+/**
+ * Pack paths into compact storage relative to their first point
+ * @param paths Paths to pack; left unchanged
+ */
+CompactVCarvePaths compactVCarvePaths(const std::vector<VCarvePath>& paths);
+
+/**
+ * Unpack compact paths back to double precision
+ * @param compact Packed paths
+ * @param paths Replaced with the unpacked paths
+ */
+void expandVCarvePaths(const CompactVCarvePaths& compact, std::vector<VCarvePath>& paths);
+
+CompactSampledMedialPaths compactSampledMedialPaths(const std::vector<SampledMedialPath>& paths);
+
+void expandSampledMedialPaths(const CompactSampledMedialPaths& compact, std::vector<SampledMedialPath>& paths);
+
+}  // namespace Geometry
+}  // namespace ChipCarving
@@ -0,0 +1,42 @@
+/**
+ * CurveChaining.h
+ *
+ * End-to-end ordering of the curves that make up a sketch profile. Curve
+ * endpoints are bucketed in a spatial hash with one cell per tolerance, so
+ * finding the curve that continues the chain only looks at the 27 cells around
+ * the current end point instead of every remaining curve.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <vector>
+
+#include "Point3D.h"
+
+namespace ChipCarving {
+namespace Geometry {
+
+// One curve in chain order, traversed end to start when reversed
+struct ChainedCurve {
+  size_t index = 0;
+  bool reversed = false;
+};
+
+/**
+ * Chain curves starting from curve 0 in its own direction
+ *
+ * At each step the lowest-index unused curve with an endpoint within tolerance
+ * of the current end is taken: in its own direction if its start matches,
+ * reversed if only its end does. Chaining stops at the first gap.
+ *
+ * @param starts Start point of each curve
+ * @param ends End point of each curve (same size as starts)
+ * @param tolerance Maximum endpoint distance that still connects (> 0)
+ * @return Chain order; shorter than the curve count if the chain is broken
+ */
+std::vector<ChainedCurve> chainCurveEndpoints(const std::vector<Point3D>& starts, const std::vector<Point3D>& ends,
+                                              double tolerance);
+
+}  // namespace Geometry
+}  // namespace ChipCarving
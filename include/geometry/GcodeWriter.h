@@ -0,0 +1,95 @@
+/**
+ * GcodeWriter.h
+ *
+ * Streaming G-code output for V-carve toolpaths, so a job can go straight to
+ * the machine without building sketch curves and regenerating Fusion CAM.
+ * Every move is written to the stream as soon as its path is added; the
+ * program is never held in memory.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <ostream>
+#include <string>
+#include <vector>
+
+#include "Point3D.h"
+#include "PolylineArcFitter.h"
+#include "VCarvePath.h"
+#include "adapters/IFusionInterface.h"
+
+namespace ChipCarving {
+namespace Geometry {
+
+/**
+ * Post-processor settings (mm, mm/min, rpm)
+ */
+struct GcodePost {
+  double safeZ = 5.0;          // Rapid-travel height above Z = 0
+  double feedRate = 1000.0;    // Cutting feed
+  double plungeRate = 300.0;   // Feed for the plunge into each path
+  int spindleRpm = 18000;      // 0 = no spindle commands
+  double arcTolerance = 0.01;  // Fit G2/G3 helical arcs within this distance (0 = G1 only)
+  int decimals = 4;            // Coordinate precision
+};
+
+/**
+ * Post settings from the dialog parameters
+ */
+GcodePost gcodePostFromParameters(const Adapters::MedialAxisParameters& params);
+
+/**
+ * Absolute-coordinate (G90, mm) program: header, one rapid-plunge-cut-retract
+ * cycle per path, footer. Z is relative to the work origin; V-carve depths are
+ * written as negative Z.
+ */
+class GcodeWriter {
+ public:
+  GcodeWriter(std::ostream& out, const GcodePost& post);
+
+  /**
+   * Write the program header
+   * @param title Program comment (parentheses are replaced)
+   */
+  void begin(const std::string& title);
+
+  /**
+   * Cut one path; ignored when it has fewer than two points
+   */
+  void writePath(const std::vector<Point3D>& points);
+
+  /**
+   * Cut one V-carve path at z = -depth
+   */
+  void writePath(const VCarvePath& path);
+
+  /**
+   * Retract, stop the spindle and end the program
+   */
+  void end();
+
+  size_t pathCount() const {
+    return pathCount_;
+  }
+  size_t lineCount() const {
+    return lineCount_;
+  }
+  size_t arcCount() const {
+    return arcCount_;
+  }
+
+ private:
+  void writeAxis(char axis, double value);
+  void writeArc(const std::vector<Point3D>& points, const PolylineSpan& span, bool withFeed);
+
+  std::ostream& out_;
+  GcodePost post_{};
+  std::vector<Point3D> scratch_{};  // Reused for VCarvePath conversion
+  size_t pathCount_ = 0;
+  size_t lineCount_ = 0;
+  size_t arcCount_ = 0;
+};
+
+}  // namespace Geometry
+}  // namespace ChipCarving
@@ -17,26 +17,26 @@ namespace Geometry {
  * A vesica piscis formed by the intersection of two circles with the same radius,
  * each centered at one of the two focus points.
  */
-class Leaf : public Shape {
+class Leaf final : public Shape {
  private:
   Point2D focus1_;
   Point2D focus2_;
   double radius_;
 
  public:
+  static constexpr double CONTAINS_TOLERANCE = 1e-9;  // Keeps the foci, on both arcs, inside
+
   /**
    * Constructor with automatic radius calculation
    * @param f1 First focus point
    * @param f2 Second focus point
    * @param radius Circle radius (if < 0, uses default calculation: 0.65 * chord_length)
    */
-  Leaf(const Point2D& f1, const Point2D& f2, double radius = -1.0) : focus1_(f1), focus2_(f2) {
-    if (radius < 0) {
-      double dist = distance(f1, f2);
-      radius_ = dist * 0.65;  // Default from TypeScript ShapeFactory
-    } else {
-      radius_ = radius;
-    }
+  Leaf(const Point2D& f1, const Point2D& f2, double radius = -1.0)
+      : focus1_(f1),
+        focus2_(f2),
+        radius_(radius < 0 ? distance(f1, f2) * 0.65 : radius) {  // Default from TypeScript ShapeFactory
+    computeDerivedGeometry();
   }
 
   // Getters
@@ -60,6 +60,7 @@ class Leaf : public Shape {
     double endAngle;
     bool anticlockwise;
 
+    ArcParams() : center(0, 0), radius(0), startAngle(0), endAngle(0), anticlockwise(false) {}
     ArcParams(const Point2D& c, double r, double start, double end, bool ccw)
         : center(c), radius(r), startAngle(start), endAngle(end), anticlockwise(ccw) {}
   };
@@ -68,24 +69,32 @@ class Leaf : public Shape {
    * Calculate the centers of the two arcs that form the leaf
    * @return pair of arc centers (first arc center, second arc center)
    */
-  std::pair<Point2D, Point2D> getArcCenters() const;
+  const std::pair<Point2D, Point2D>& getArcCenters() const {
+    return arcCenters_;
+  }
 
   /**
    * Get complete arc parameters for drawing both arcs in Fusion 360
    * @return pair of arc parameters for the two arcs that form the leaf
    */
-  std::pair<ArcParams, ArcParams> getArcParameters() const;
+  const std::pair<ArcParams, ArcParams>& getArcParameters() const {
+    return arcParams_;
+  }
 
   /**
    * Calculate the sagitta (distance from chord midpoint to arc peak)
    * Used for shape editing and verification
    */
-  double getSagitta() const;
+  double getSagitta() const {
+    return sagitta_;
+  }
 
   /**
    * Check if the leaf geometry is valid (radius large enough for chord length)
    */
-  bool isValidGeometry() const;
+  bool isValidGeometry() const {
+    return validGeometry_;
+  }
 
   // Shape interface implementation
   std::vector<Point2D> getVertices() const override {
@@ -95,15 +104,24 @@ class Leaf : public Shape {
   // NOTE: getPolygonVertices() removed - polygonization now handled by Fusion strokes
 
   void drawToSketch(Adapters::ISketch* sketch, Adapters::ILogger* logger) const override;
+  std::vector<ShapeEdge> getBoundaryEdges() const override;  // The two arcs, focus1 first
+  ShapeBounds getBounds() const override {
+    return bounds_;
+  }
   bool contains(const Point2D& point) const override;
   Point2D getCentroid() const override;
 
  private:
-  /**
-   * Calculate distance from chord center to arc center (d_center in TypeScript)
-   * Used internally for arc calculations
-   */
-  double getChordCenterToArcCenterDistance() const;
+  // Derived once at construction; the leaf is immutable
+  bool validGeometry_ = false;
+  double centerDistance_ = 0.0;  // Chord center to arc center (d_center in TypeScript)
+  double sagitta_ = 0.0;
+  std::pair<Point2D, Point2D> arcCenters_{};
+  std::pair<ArcParams, ArcParams> arcParams_{};
+  ShapeBounds bounds_{};
+
+  void computeDerivedGeometry();
+  std::pair<ArcParams, ArcParams> computeArcParameters() const;
 };
 
 }  // namespace Geometry
@@ -0,0 +1,85 @@
+/**
+ * MedialAxisBatch.h
+ *
+ * Concurrent medial axis computation for a batch of independent profile polygons.
+ * Each OpenVoronoi diagram is self-contained, so profiles can be processed on a
+ * worker pool without any Fusion API involvement.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <vector>
+
+#include "MedialAxisProcessor.h"
+#include "Point2D.h"
+#include "utils/JobProgress.h"
+
+namespace ChipCarving {
+namespace Geometry {
+
+/**
+ * Resolve the number of worker threads to use for a batch
+ * @param requestedWorkers Requested worker count (0 = use hardware concurrency)
+ * @param jobCount Number of polygons in the batch
+ * @return Worker count in the range [1, jobCount] (1 when the batch is empty)
+ */
+int resolveMedialAxisWorkerCount(int requestedWorkers, size_t jobCount);
+
+/**
+ * Relative cost of one medial axis for scheduling: n log2 n in the polygon's
+ * vertex count, holes included, following OpenVoronoi's incremental insertion
+ */
+double estimateMedialAxisCost(size_t vertexCount);
+
+/**
+ * Compute one polygon of a batch, converting escaped exceptions into a failed
+ * result so a single bad profile never takes down the others. Engines come
+ * from MedialAxisEngineSet::standard(), so profiles the straight skeleton
+ * takes skip OpenVoronoi when the processor enables it.
+ * The result's computeMs holds the time taken.
+ * @param processor Processor owned by the calling thread
+ */
+MedialAxisResults computeMedialAxisProfile(MedialAxisProcessor& processor, const std::vector<Point2D>& polygon,
+                                           const std::vector<std::vector<Point2D>>& holes = {});
+
+/**
+ * Compute the medial axis of every polygon in a batch
+ *
+ * Results are returned in the same order as the input polygons regardless of
+ * the order in which workers finish. Each worker uses its own copy of the
+ * prototype processor, so no state is shared between diagrams. Worker threads
+ * run with console logging suppressed; only the calling thread writes to the
+ * Fusion UI.
+ *
+ * With several workers the polygons are scheduled largest-first by
+ * estimateMedialAxisCost() on a work-stealing pool (utils/TaskScheduler.h),
+ * and partitioned polygons hand their tiles to idle workers. The measured
+ * seconds per cost unit are logged after each batch.
+ *
+ * @param polygons Profile polygons in world coordinates
+ * @param prototype Processor whose parameters (tolerance, threshold, walk points) are used
+ * @param requestedWorkers Worker count (0 = hardware concurrency, 1 = sequential on calling thread)
+ * @param progress Optional; advanced once per polygon, and polygons not yet
+ *        started when it is cancelled are skipped (left failed with "Cancelled")
+ * @param holes Optional inner loops of each polygon, parallel to polygons
+ * @return One MedialAxisResults per input polygon, in input order
+ */
+std::vector<MedialAxisResults> computeMedialAxisBatch(
+    const std::vector<std::vector<Point2D>>& polygons, const MedialAxisProcessor& prototype, int requestedWorkers = 0,
+    Utils::JobProgress* progress = nullptr, const std::vector<std::vector<std::vector<Point2D>>>* holes = nullptr);
+
+/**
+ * computeMedialAxisBatch, computing each repeated outline once: polygons with
+ * the same canonical shape (see CanonicalShape.h) share the medial axis of
+ * their largest copy, mapped onto each of them. Polygons with holes are always
+ * computed, as are the copies of a shape whose largest copy failed.
+ * @param sharedCount Optional output: number of results mapped from another copy
+ */
+std::vector<MedialAxisResults> computeDeduplicatedMedialAxisBatch(
+    const std::vector<std::vector<Point2D>>& polygons, const MedialAxisProcessor& prototype, int requestedWorkers = 0,
+    Utils::JobProgress* progress = nullptr, const std::vector<std::vector<std::vector<Point2D>>>* holes = nullptr,
+    size_t* sharedCount = nullptr);
+
+}  // namespace Geometry
+}  // namespace ChipCarving
@@ -0,0 +1,97 @@
+/**
+ * MedialAxisCache.h
+ *
+ * Content-addressed LRU cache of medial axis results. Entries are keyed by a
+ * hash of the polygon vertices and the processor parameters that affect the
+ * result, so changing only tool settings reuses the previous computation.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <list>
+#include <unordered_map>
+#include <vector>
+
+#include "MedialAxisProcessor.h"
+#include "Point2D.h"
+
+namespace ChipCarving {
+namespace Geometry {
+
+/**
+ * Bounded-memory LRU cache mapping geometry hashes to MedialAxisResults
+ * Not thread-safe; owned and used by the main thread.
+ */
+class MedialAxisCache {
+ public:
+  static constexpr size_t DEFAULT_MAX_BYTES = 64 * 1024 * 1024;
+
+  explicit MedialAxisCache(size_t maxBytes = DEFAULT_MAX_BYTES);
+
+  /**
+   * Compute the cache key for a polygon processed with the given parameters
+   * @param polygon Polygon vertices in world coordinates
+   * @param processor Processor whose tolerance, threshold and walk points are hashed
+   * @return 64-bit FNV-1a hash
+   */
+  static uint64_t computeKey(const std::vector<Point2D>& polygon, const MedialAxisProcessor& processor);
+
+  /**
+   * Approximate heap footprint of a result, used for the memory budget
+   */
+  static size_t estimateBytes(const MedialAxisResults& results);
+
+  /**
+   * Look up a result and mark it most recently used
+   * @return true if found (results is overwritten with the cached copy)
+   */
+  bool lookup(uint64_t key, MedialAxisResults& results);
+
+  /**
+   * Insert or replace a result, evicting least recently used entries to stay within budget
+   * Results larger than the whole budget are not cached.
+   */
+  void insert(uint64_t key, const MedialAxisResults& results);
+
+  void clear();
+
+  size_t size() const {
+    return entries_.size();
+  }
+  size_t getBytesUsed() const {
+    return bytesUsed_;
+  }
+  size_t getMaxBytes() const {
+    return maxBytes_;
+  }
+  void setMaxBytes(size_t maxBytes);
+
+  // Statistics since construction or last clear()
+  size_t getHits() const {
+    return hits_;
+  }
+  size_t getMisses() const {
+    return misses_;
+  }
+
+ private:
+  struct Entry {
+    uint64_t key = 0;
+    MedialAxisResults results{};
+    size_t bytes = 0;
+  };
+
+  std::list<Entry> entries_{};  // Most recently used first
+  std::unordered_map<uint64_t, std::list<Entry>::iterator> index_{};
+  size_t maxBytes_ = DEFAULT_MAX_BYTES;
+  size_t bytesUsed_ = 0;
+  size_t hits_ = 0;
+  size_t misses_ = 0;
+
+  void evictToFit(size_t incomingBytes);
+};
+
+}  // namespace Geometry
+}  // namespace ChipCarving
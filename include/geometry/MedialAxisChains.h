@@ -0,0 +1,222 @@
+/**
+ * MedialAxisChains.h
+ *
+ * Structure-of-arrays storage for medial axis chains. All chains of a result
+ * share three contiguous arrays (x, y, clearance radius) plus a chain offset
+ * table, so a result costs a handful of allocations regardless of chain count.
+ * Chain views keep the familiar "iterate chains, then points" access pattern.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <iterator>
+#include <vector>
+
+#include "Point2D.h"
+
+namespace ChipCarving {
+namespace Geometry {
+
+class MedialAxisChains {
+ public:
+  /**
+   * Read-only view of one chain: points and their clearance radii
+   */
+  class ChainView {
+   public:
+    class Iterator {
+     public:
+      using iterator_category = std::input_iterator_tag;
+      using value_type = Point2D;
+      using difference_type = std::ptrdiff_t;
+      using pointer = void;
+      using reference = Point2D;
+
+      Iterator(const double* x, const double* y, size_t index) : x_(x), y_(y), index_(index) {}
+      Point2D operator*() const {
+        return Point2D(x_[index_], y_[index_]);
+      }
+      Iterator& operator++() {
+        ++index_;
+        return *this;
+      }
+      bool operator==(const Iterator& other) const {
+        return index_ == other.index_;
+      }
+      bool operator!=(const Iterator& other) const {
+        return index_ != other.index_;
+      }
+
+     private:
+      const double* x_;
+      const double* y_;
+      size_t index_;
+    };
+
+    ChainView(const double* x, const double* y, const double* radii, size_t size)
+        : x_(x), y_(y), radii_(radii), size_(size) {}
+
+    size_t size() const {
+      return size_;
+    }
+    bool empty() const {
+      return size_ == 0;
+    }
+    Point2D operator[](size_t i) const {
+      return Point2D(x_[i], y_[i]);
+    }
+    Point2D front() const {
+      return (*this)[0];
+    }
+    Point2D back() const {
+      return (*this)[size_ - 1];
+    }
+    double clearance(size_t i) const {
+      return radii_[i];
+    }
+
+    // Contiguous coordinate and clearance arrays for this chain
+    const double* xData() const {
+      return x_;
+    }
+    const double* yData() const {
+      return y_;
+    }
+    const double* clearanceData() const {
+      return radii_;
+    }
+
+    Iterator begin() const {
+      return Iterator(x_, y_, 0);
+    }
+    Iterator end() const {
+      return Iterator(x_, y_, size_);
+    }
+
+    std::vector<Point2D> points() const;
+    std::vector<double> clearances() const;
+
+   private:
+    const double* x_;
+    const double* y_;
+    const double* radii_;
+    size_t size_;
+  };
+
+  class Iterator {
+   public:
+    using iterator_category = std::input_iterator_tag;
+    using value_type = ChainView;
+    using difference_type = std::ptrdiff_t;
+    using pointer = void;
+    using reference = ChainView;
+
+    Iterator(const MedialAxisChains* chains, size_t index) : chains_(chains), index_(index) {}
+    ChainView operator*() const {
+      return (*chains_)[index_];
+    }
+    Iterator& operator++() {
+      ++index_;
+      return *this;
+    }
+    bool operator==(const Iterator& other) const {
+      return index_ == other.index_;
+    }
+    bool operator!=(const Iterator& other) const {
+      return index_ != other.index_;
+    }
+
+   private:
+    const MedialAxisChains* chains_;
+    size_t index_;
+  };
+
+  // Number of chains
+  size_t size() const {
+    return offsets_.size() - 1;
+  }
+  bool empty() const {
+    return size() == 0;
+  }
+
+  // Number of points across all chains
+  size_t pointCount() const {
+    return x_.size();
+  }
+
+  ChainView operator[](size_t i) const {
+    size_t begin = offsets_[i];
+    return ChainView(x_.data() + begin, y_.data() + begin, radii_.data() + begin, offsets_[i + 1] - begin);
+  }
+  ChainView front() const {
+    return (*this)[0];
+  }
+  ChainView back() const {
+    return (*this)[size() - 1];
+  }
+
+  Iterator begin() const {
+    return Iterator(this, 0);
+  }
+  Iterator end() const {
+    return Iterator(this, size());
+  }
+
+  /**
+   * Append a chain
+   * @return false (and nothing appended) if points and clearances differ in size
+   */
+  bool addChain(const std::vector<Point2D>& points, const std::vector<double>& clearances);
+
+  /**
+   * Start a new, empty chain; addPoint() appends to the last chain
+   */
+  void beginChain();
+  void addPoint(const Point2D& point, double clearance);
+
+  /**
+   * Replace all storage at once (offsets must start at 0, be non-decreasing and
+   * end at the array length)
+   * @return false (and nothing changed) if the arrays are inconsistent
+   */
+  bool assign(std::vector<double> x, std::vector<double> y, std::vector<double> radii, std::vector<size_t> offsets);
+
+  void reserve(size_t chainCount, size_t pointCount);
+  void clear();
+
+  /**
+   * Build from the nested chain/clearance representation
+   * Chains whose clearance list has a different length are skipped.
+   */
+  static MedialAxisChains fromNested(const std::vector<std::vector<Point2D>>& chains,
+                                     const std::vector<std::vector<double>>& clearances);
+
+  // Flat storage, for serialization and batch processing
+  const std::vector<double>& xs() const {
+    return x_;
+  }
+  const std::vector<double>& ys() const {
+    return y_;
+  }
+  const std::vector<double>& radii() const {
+    return radii_;
+  }
+  const std::vector<size_t>& offsets() const {
+    return offsets_;
+  }
+
+  // Heap bytes held by the flat arrays
+  size_t capacityBytes() const {
+    return (x_.capacity() + y_.capacity() + radii_.capacity()) * sizeof(double) + offsets_.capacity() * sizeof(size_t);
+  }
+
+ private:
+  std::vector<double> x_{};
+  std::vector<double> y_{};
+  std::vector<double> radii_{};
+  std::vector<size_t> offsets_{0};  // Chain i spans [offsets_[i], offsets_[i + 1])
+};
+
+}  // namespace Geometry
+}  // namespace ChipCarving
@@ -0,0 +1,130 @@
+/**
+ * MedialAxisDiskCache.h
+ *
+ * Persistent on-disk store for medial axis results, so repeat sessions on the
+ * same design skip OpenVoronoi entirely. Each result is one file with a fixed
+ * header followed by contiguous chain-size, point and clearance arrays; files
+ * are memory-mapped and copied straight into the result vectors.
+ *
+ * The directory may be shared by several machines (a network folder), so one
+ * seat's results serve the others. Entries are content-addressed and
+ * immutable: a name stands for one geometry, engine and format, and once
+ * published it is never rewritten. Writers publish a uniquely named temporary
+ * file with link() (rename() where links are unsupported), so concurrent
+ * writers never expose a partial or mixed entry, and a payload checksum
+ * rejects entries damaged in transit. A shared cache also keeps a read-mostly
+ * index: each machine appends the keys it publishes to its own file under
+ * index/, and lookups consult the keys read from all of them, so a miss costs
+ * no round trip to the file server.
+ */
+
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+#include <utility>
+#include <vector>
+
+#include "MedialAxisProcessor.h"
+
+namespace ChipCarving {
+namespace Geometry {
+
+/**
+ * Directory-backed medial axis result store
+ * Entries are keyed by geometry hash (see MedialAxisCache::computeKey), the
+ * medial axis engine version and the file format, so upgrading OpenVoronoi or
+ * the plugin invalidates old files without disturbing seats still on them.
+ */
+class MedialAxisDiskCache {
+ public:
+  static constexpr double INDEX_REFRESH_SECONDS = 5.0;  // Index files are read again after this long at most
+  static constexpr long STALE_TEMP_SECONDS = 3600;      // trim() deletes temporaries abandoned this long ago
+
+  /**
+   * @param directory Cache directory (created if missing; empty disables the cache)
+   * @param engineVersion Engine version string stored with every entry
+   * @param shared The directory is shared with other machines: entries are read rather than mapped, and
+   *        lookups go through the index of published keys
+   */
+  explicit MedialAxisDiskCache(const std::string& directory, const std::string& engineVersion = currentEngineVersion(),
+                               bool shared = false);
+
+  /**
+   * Version of the linked medial axis engine (ovd::version())
+   */
+  static std::string currentEngineVersion();
+
+  bool isEnabled() const {
+    return enabled_;
+  }
+  const std::string& getDirectory() const {
+    return directory_;
+  }
+  bool isShared() const {
+    return shared_;
+  }
+
+  /**
+   * Load a cached result. An entry whose payload fails its checksum is deleted,
+   * so the next store() publishes it again; in a shared cache it is a miss, and
+   * the next trim() deletes it.
+   * @return true if a valid entry for this key and engine version exists
+   */
+  bool load(uint64_t key, MedialAxisResults& results) const;
+
+  /**
+   * Store a successful result (failed results are ignored). An entry another
+   * writer has published already is left as it is.
+   * @return true if the entry exists now
+   */
+  bool store(uint64_t key, const MedialAxisResults& results) const;
+
+  /**
+   * Path of the cache file for a key
+   */
+  std::string pathForKey(uint64_t key) const;
+
+  /**
+   * Delete entries until the directory's cache files total at most maxBytes.
+   * Entries of other engine versions go first (they can never load), then the
+   * least recently written. Temporaries of writers that died, and shared
+   * entries load() found damaged, are deleted too. Every seat of a shared
+   * cache trims it to its own budget, and drops the deleted keys from its own
+   * index file.
+   * @return Bytes of cache files left
+   */
+  uint64_t trim(uint64_t maxBytes) const;
+
+ private:
+  // Name no other writer uses, on this machine or another
+  static std::string temporaryPath(const std::string& path);
+
+  // Whether the index lists key, reading the index files again if they are older than INDEX_REFRESH_SECONDS
+  bool isIndexed(uint64_t key) const;
+  // Read what the index files gained since they were last read (indexMutex_ held)
+  void refreshIndex() const;
+  void appendToIndex(uint64_t key) const;
+  // Rewrite this machine's index file without the deleted entries, given as (key, engine hash)
+  void removeFromIndex(const std::vector<std::pair<uint64_t, uint64_t>>& removed) const;
+
+  std::string directory_{};
+  uint64_t engineHash_ = 0;
+  bool enabled_ = false;
+  bool shared_ = false;
+
+  // Shared caches only
+  std::string indexPath_{};  // This machine's index file
+  mutable std::mutex indexMutex_{};
+  mutable std::unordered_set<uint64_t> indexedKeys_{};                // Of this engine version
+  mutable std::unordered_set<uint64_t> damagedKeys_{};                // Left for trim() to delete
+  mutable std::unordered_map<std::string, uint64_t> indexOffsets_{};  // Bytes read of each index file
+  mutable std::chrono::steady_clock::time_point indexReadAt_{};
+};
+
+}  // namespace Geometry
+}  // namespace ChipCarving
@@ -0,0 +1,79 @@
+/**
+ * MedialAxisDistanceField.h
+ *
+ * Approximate medial axis from a Euclidean distance transform, for previews.
+ * The profile is rasterized onto a pixel grid (outer loop and holes by the
+ * even-odd rule), the outside pixels along the outline take their closest
+ * outline point, and jump flooding gives every pixel its nearest such point
+ * in passes split over threads. Pixels where neighbours' nearest outline
+ * points lie far apart form the ridges; thinned ridges are traced into chains
+ * whose clearance is the distance there.
+ *
+ * The grid is sized from a pixel budget, so the cost is proportional to the
+ * pixel count however many vertices or near-degenerate edges the profile has.
+ * Positions and clearances are good to about a pixel and the topology is not
+ * Voronoi's: small features below a few pixels are lost.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <vector>
+
+#include "MedialAxisProcessor.h"
+#include "MedialAxisSpurs.h"
+#include "Point2D.h"
+#include "utils/JobProgress.h"
+
+namespace ChipCarving {
+namespace Geometry {
+
+struct DistanceFieldOptions {
+  size_t maxPixels = 65536;           // Pixel budget per profile; the pixel grows to stay within it
+  double pixelSize = 0.0;             // Smallest pixel edge (world units; 0 = the budget alone decides)
+  double minFeatureSeparation = 2.0;  // Nearest outline points of neighbours must be this far apart (pixels)
+  double medialThreshold = 0.8;       // As MedialAxisProcessor's: ridges between nearly parallel sides are dropped
+  double minSpurPixels = 3.0;         // Shorter spurs are raster staircase noise and always pruned
+  SpurPruningOptions spurPruning{};   // Further pruning, as MedialAxisProcessor applies it
+  int workers = 1;                    // Threads splitting the flooding passes (0 = hardware concurrency)
+};
+
+/**
+ * Options that follow a processor's settings: pixels no finer than its polygon
+ * tolerance, and its medial threshold and spur pruning. Previews and coarse
+ * passes take their options from here, so they match the exact pass's axes.
+ */
+DistanceFieldOptions distanceFieldOptions(const MedialAxisProcessor& processor, int workers = 1);
+
+/**
+ * Approximate medial axis of a polygon with optional holes. Inside a
+ * TaskScheduler task the passes are split into subtasks for idle workers
+ * instead of starting threads.
+ * @param results Output chains, graph, statistics and transform, as
+ *                MedialAxisProcessor fills them
+ * @return false if the polygon is degenerate or no ridge survives
+ */
+bool computeDistanceFieldMedialAxis(const std::vector<Point2D>& polygon,
+                                    const std::vector<std::vector<Point2D>>& holes,
+                                    const DistanceFieldOptions& options, MedialAxisResults& results);
+
+/**
+ * Relative cost of one profile for scheduling: the pixels its grid will have
+ */
+double estimateDistanceFieldCost(const std::vector<Point2D>& polygon, const DistanceFieldOptions& options);
+
+/**
+ * Distance-field medial axis of every polygon of a batch, each computed
+ * through MedialAxisEngineSet::distanceField(options), like
+ * computeMedialAxisBatch (see MedialAxisBatch.h): results in input order,
+ * largest grids first on a work-stealing pool, progress advanced per polygon
+ * and polygons not started once it is cancelled left failed with "Cancelled".
+ * On a pool the passes of each polygon become subtasks for idle workers; run
+ * sequentially (one worker or one polygon), they use options.workers threads.
+ */
+std::vector<MedialAxisResults> computeDistanceFieldMedialAxisBatch(
+    const std::vector<std::vector<Point2D>>& polygons, const DistanceFieldOptions& options, int requestedWorkers = 0,
+    Utils::JobProgress* progress = nullptr, const std::vector<std::vector<std::vector<Point2D>>>* holes = nullptr);
+
+}  // namespace Geometry
+}  // namespace ChipCarving
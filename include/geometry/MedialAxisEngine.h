@@ -0,0 +1,187 @@
+/**
+ * MedialAxisEngine.h
+ *
+ * Pluggable medial axis engines. A MedialAxisEngineSet offers each profile to
+ * its engines in order; the first engine whose vertex range and accepts()
+ * admit the profile computes it, and one that fails passes the profile on.
+ * The standard set puts the closed-form Leaf/TriArc engine and, when enabled,
+ * the straight skeleton of purely polygonal profiles before OpenVoronoi, so
+ * unedited imported shapes and polygons never reach the Voronoi library.
+ * Generate Paths and the CLI try analytic() before their caches, and batches
+ * compute every other profile through standard() (MedialAxisBatch.h).
+ * Previews and the anytime coarse pass use distanceField().
+ * Other engines slot in by implementing IMedialAxisEngine; benchmarks A/B
+ * engines by building a set of one.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+#include "MedialAxisDistanceField.h"
+#include "MedialAxisProcessor.h"
+#include "Point2D.h"
+#include "Shape.h"
+
+namespace ChipCarving {
+namespace Geometry {
+
+/**
+ * One profile as the engines see it
+ */
+struct MedialAxisProfile {
+  const std::vector<Point2D>* polygon = nullptr;             // Outer loop
+  const std::vector<std::vector<Point2D>>* holes = nullptr;  // Inner loops (optional)
+  const Shape* sourceShape = nullptr;                        // Imported shape it may trace (optional)
+  double shapeScale = 1.0;                                   // Shape units to polygon units
+  double matchTolerance = 0.001;                             // Shape match tolerance (polygon units)
+
+  size_t vertexCount() const;
+  bool hasHoles() const {
+    return holes && !holes->empty();
+  }
+};
+
+class IMedialAxisEngine {
+ public:
+  virtual ~IMedialAxisEngine() = default;
+
+  // Short identifier for logs and benchmark labels
+  virtual const char* name() const = 0;
+
+  // Cheap test of whether compute() can handle the profile (shape type, holes)
+  virtual bool accepts(const MedialAxisProfile& profile) const = 0;
+
+  /**
+   * @param results Output; only meaningful on success, except that the last
+   *                engine of a set leaves its error message there
+   * @return false if this engine could not compute the profile
+   */
+  virtual bool compute(const MedialAxisProfile& profile, MedialAxisResults& results) = 0;
+};
+
+// Closed-form medial axes of profiles that still match their Leaf or TriArc (see AnalyticMedialAxis.h)
+class AnalyticMedialAxisEngine : public IMedialAxisEngine {
+ public:
+  const char* name() const override {
+    return "analytic";
+  }
+  bool accepts(const MedialAxisProfile& profile) const override;
+  bool compute(const MedialAxisProfile& profile, MedialAxisResults& results) override;
+};
+
+// OpenVoronoi through a MedialAxisProcessor owned by the calling thread
+class OpenVoronoiMedialAxisEngine : public IMedialAxisEngine {
+ public:
+  explicit OpenVoronoiMedialAxisEngine(MedialAxisProcessor& processor) : processor_(processor) {}
+
+  const char* name() const override {
+    return "openvoronoi";
+  }
+  bool accepts(const MedialAxisProfile& profile) const override;
+  bool compute(const MedialAxisProfile& profile, MedialAxisResults& results) override;
+
+ private:
+  MedialAxisProcessor& processor_;
+};
+
+// Straight skeletons of profiles with only straight edges and no holes (see StraightSkeleton.h)
+class StraightSkeletonMedialAxisEngine : public IMedialAxisEngine {
+ public:
+  static constexpr size_t MAX_VERTICES = 256;  // Its event search is quadratic per event
+
+  const char* name() const override {
+    return "straight-skeleton";
+  }
+  bool accepts(const MedialAxisProfile& profile) const override;
+  bool compute(const MedialAxisProfile& profile, MedialAxisResults& results) override;
+};
+
+/**
+ * Boost.Polygon's sweep-line Voronoi diagram of the polygon's edges, built in
+ * O(n log n) on the unit circle fit snapped to a 32-bit integer grid. Applies
+ * the processor's medial threshold, walk points and spur pruning, so results
+ * stand in for OpenVoronoi's. Loops must be simple and must not cross each
+ * other; unlike the processor, this engine does not check them.
+ */
+class BoostVoronoiMedialAxisEngine : public IMedialAxisEngine {
+ public:
+  explicit BoostVoronoiMedialAxisEngine(const MedialAxisProcessor& processor) : processor_(processor) {}
+
+  const char* name() const override {
+    return "boost-voronoi";
+  }
+  bool accepts(const MedialAxisProfile& profile) const override;
+  bool compute(const MedialAxisProfile& profile, MedialAxisResults& results) override;
+
+ private:
+  const MedialAxisProcessor& processor_;
+};
+
+/**
+ * Approximate medial axes from a distance transform of the rasterized profile
+ * (see MedialAxisDistanceField.h), for previews: cost follows the pixel budget
+ * rather than the vertex count, and the result is good to about a pixel
+ */
+class DistanceFieldMedialAxisEngine : public IMedialAxisEngine {
+ public:
+  explicit DistanceFieldMedialAxisEngine(const DistanceFieldOptions& options = DistanceFieldOptions())
+      : options_(options) {}
+
+  const char* name() const override {
+    return "distance-field";
+  }
+  bool accepts(const MedialAxisProfile& profile) const override;
+  bool compute(const MedialAxisProfile& profile, MedialAxisResults& results) override;
+
+ private:
+  DistanceFieldOptions options_;
+};
+
+/**
+ * Engines tried in order, each limited to profiles of a vertex count range
+ * (outer loop and holes together). Not thread-safe: build one set per thread.
+ */
+class MedialAxisEngineSet {
+ public:
+  static constexpr size_t NO_ENGINE = SIZE_MAX;
+
+  void add(std::unique_ptr<IMedialAxisEngine> engine, size_t minVertices = 0, size_t maxVertices = SIZE_MAX);
+
+  size_t size() const {
+    return entries_.size();
+  }
+  const IMedialAxisEngine& engine(size_t index) const {
+    return *entries_[index].engine;
+  }
+
+  /**
+   * Compute profile with the first engine that takes it and succeeds
+   * @return Index of that engine, or NO_ENGINE if none did (results then hold
+   *         the last attempted engine's error, or an error if none accepted)
+   */
+  size_t compute(const MedialAxisProfile& profile, MedialAxisResults& results);
+
+  // The analytic engine, which needs no diagram; empty if the processor traces clearing offsets, which it has not
+  static MedialAxisEngineSet analytic(const MedialAxisProcessor& processor);
+
+  // analytic() (if useAnalytic), the straight skeleton (if the processor enables it), then OpenVoronoi
+  static MedialAxisEngineSet standard(MedialAxisProcessor& processor, bool useAnalytic = true);
+
+  // The distance-field engine alone (options usually from distanceFieldOptions())
+  static MedialAxisEngineSet distanceField(const DistanceFieldOptions& options);
+
+ private:
+  struct Entry {
+    std::unique_ptr<IMedialAxisEngine> engine;
+    size_t minVertices;
+    size_t maxVertices;
+  };
+  std::vector<Entry> entries_{};
+};
+
+}  // namespace Geometry
+}  // namespace ChipCarving
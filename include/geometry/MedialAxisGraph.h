@@ -0,0 +1,95 @@
+/**
+ * MedialAxisGraph.h
+ *
+ * Topology of a medial axis: every chain is an edge between two nodes, and a
+ * node is a chain endpoint shared by every chain that ends there (a junction
+ * when three or more meet, a free end when only one does). Node IDs are
+ * assigned in order of first appearance (chain 0 start, chain 0 end, chain 1
+ * start, ...), so they are stable for a given chain list.
+ *
+ * Only topology is stored; a node's position is read back from the chains,
+ * so transforming the chains (see transformMedialAxis) keeps the graph valid.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "MedialAxisChains.h"
+#include "Point2D.h"
+
+namespace ChipCarving {
+namespace Geometry {
+
+class MedialAxisGraph {
+ public:
+  static constexpr uint32_t NO_NODE = UINT32_MAX;
+
+  // Edge i is chain i; empty chains have no nodes
+  struct Edge {
+    uint32_t start = NO_NODE;  // Node at the chain's first point
+    uint32_t end = NO_NODE;    // Node at the chain's last point (equals start for a loop)
+  };
+
+  /**
+   * Join chain endpoints into nodes
+   * @param tolerance Endpoints at most this far apart share a node (0 = bitwise equal
+   *                  points only, as OpenVoronoi reports shared vertices)
+   */
+  static MedialAxisGraph fromChains(const MedialAxisChains& chains, double tolerance = 0.0);
+
+  size_t nodeCount() const {
+    return nodeOffsets_.size() - 1;
+  }
+  size_t edgeCount() const {
+    return edges_.size();
+  }
+  bool empty() const {
+    return edges_.empty();
+  }
+
+  const Edge& edge(size_t chain) const {
+    return edges_[chain];
+  }
+
+  // Chain ends at node; a loop chain counts twice
+  size_t degree(uint32_t node) const {
+    return nodeOffsets_[node + 1] - nodeOffsets_[node];
+  }
+  bool isJunction(uint32_t node) const {
+    return degree(node) >= 3;
+  }
+
+  // Chains ending at node, in chain order
+  const uint32_t* incidentBegin(uint32_t node) const {
+    return nodeEdges_.data() + nodeOffsets_[node];
+  }
+  const uint32_t* incidentEnd(uint32_t node) const {
+    return nodeEdges_.data() + nodeOffsets_[node + 1];
+  }
+
+  /**
+   * Node where two chains meet
+   * @return chainA's end node if chainB also ends there, else its start node if
+   *         shared, else NO_NODE
+   */
+  uint32_t sharedNode(size_t chainA, size_t chainB) const;
+
+  // Position of node, read from the first chain ending there
+  Point2D position(const MedialAxisChains& chains, uint32_t node) const;
+
+  // Heap bytes held by the tables
+  size_t capacityBytes() const {
+    return edges_.capacity() * sizeof(Edge) + (nodeOffsets_.capacity() + nodeEdges_.capacity()) * sizeof(uint32_t);
+  }
+
+ private:
+  std::vector<Edge> edges_{};
+  std::vector<uint32_t> nodeOffsets_{0};  // Node n's chains are nodeEdges_[nodeOffsets_[n], nodeOffsets_[n + 1])
+  std::vector<uint32_t> nodeEdges_{};
+};
+
+}  // namespace Geometry
+}  // namespace ChipCarving
@@ -0,0 +1,45 @@
+/**
+ * MedialAxisPartition.h
+ *
+ * Divide-and-conquer medial axis for very large polygons. The bounding box is
+ * cut into a grid of tiles; each tile builds its own OpenVoronoi diagram from
+ * the boundary segments within a halo around it, on a worker pool, and keeps
+ * the medial chains inside the tile. Chains cut at tile seams are stitched
+ * back together afterwards.
+ *
+ * A medial point whose clearance is below the halo width has all of its
+ * nearest boundary inside the tile's diagram, so it is exactly where the full
+ * diagram would put it. If any kept point reaches the halo the partition is
+ * rejected and the caller computes the full diagram instead.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <vector>
+
+#include "MedialAxisProcessor.h"
+#include "Point2D.h"
+
+namespace ChipCarving {
+namespace Geometry {
+
+struct MedialAxisPartitionOptions {
+  size_t verticesPerTile = 2000;  // Target polygon vertices per tile
+  double haloFraction = 0.5;      // Halo width as a fraction of the larger tile side
+  int workers = 0;                // Worker threads (0 = hardware concurrency)
+};
+
+/**
+ * Compute the medial axis of polygon tile by tile
+ * @param prototype Processor whose threshold and walk points are used
+ * @param polygon Polygon in world coordinates (a closing duplicate vertex is ignored)
+ * @param results Chains and statistics on success; the transform is left to the caller
+ * @return false if the polygon fits one tile, a tile failed, or a clearance reached
+ *         the halo (results are then untouched)
+ */
+bool computePartitionedMedialAxis(const MedialAxisProcessor& prototype, const std::vector<Point2D>& polygon,
+                                  const MedialAxisPartitionOptions& options, MedialAxisResults& results);
+
+}  // namespace Geometry
+}  // namespace ChipCarving
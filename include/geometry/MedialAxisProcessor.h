@@ -7,12 +7,19 @@
 
 #pragma once
 
+#include <cstddef>
 #include <memory>
 #include <vector>
 
+#include "MedialAxisChains.h"
+#include "MedialAxisGraph.h"
+#include "MedialAxisRetry.h"
+#include "MedialAxisSpurs.h"
+#include "MedialAxisWorkspace.h"
 #include "MedialAxisUtilities.h"
 #include "Point2D.h"
 #include "Shape.h"
+#include "VoronoiSiteOrder.h"
 
 namespace ChipCarving {
 namespace Geometry {
@@ -27,13 +34,46 @@ struct TransformParams {
   Point2D originalMax{0, 0};  // Original bounding box maximum
 };
 
+/**
+ * Bounding box of a world polygon and the transform fitting it into the unit
+ * circle, as MedialAxisProcessor records it; other engines use it so their
+ * results carry the same transform
+ */
+void fitUnitCircleTransform(const std::vector<Point2D>& polygon, TransformParams& transform);
+
+/**
+ * Flat-bottom clearing offsets taken from the medial axis diagram: the first
+ * loop runs firstOffset inside the boundary, the next ones stepover further
+ * in each until the region closes (world units; off unless both are positive)
+ */
+struct ClearingOffsets {
+  double firstOffset = 0.0;
+  double stepover = 0.0;
+
+  bool enabled() const {
+    return firstOffset > 0.0 && stepover > 0.0;
+  }
+};
+
+/**
+ * One closed clearing offset loop in world coordinates, arcs tessellated to
+ * the polygon tolerance; the first point is not repeated at the end
+ */
+struct ClearingLoop {
+  std::vector<Point2D> points{};
+  double offset = 0.0;  // Distance from the boundary
+};
+
 /**
  * Complete medial axis computation results
  */
 struct MedialAxisResults {
-  std::vector<std::vector<Point2D>> chains{};         // Medial axis chains in world coordinates
-  std::vector<std::vector<double>> clearanceRadii{};  // Clearance radii for each chain point
-  TransformParams transform{};                        // Transform parameters used
+  MedialAxisChains chains{};    // Medial axis chains and clearance radii in world coordinates
+  MedialAxisGraph graph{};      // Chains as edges between junction and endpoint nodes
+  TransformParams transform{};  // Transform parameters used
+
+  // Offset loops of the same diagram when MedialAxisProcessor::setClearingOffsets() is on, innermost last
+  std::vector<ClearingLoop> clearingLoops{};
 
   // Statistics
   int numChains = 0;
@@ -41,10 +81,24 @@ struct MedialAxisResults {
   double totalLength = 0.0;
   double minClearance = 0.0;
   double maxClearance = 0.0;
+  double computeMs = 0.0;  // Set by computeMedialAxisProfile(); 0 for results from caches or analytic shapes
 
   // Success/error status
   bool success = false;
   std::string errorMessage{};
+
+  // Full-diagram OpenVoronoi attempts, the plain one first (empty for tiled results)
+  std::vector<MedialAxisAttempt> attempts{};
+};
+
+/**
+ * How much of each OpenVoronoi diagram's half-edge graph is checked after
+ * site insertion. A failed check is only logged, so production runs skip it.
+ */
+enum class DiagramValidation {
+  OFF,      // Never check
+  SAMPLED,  // Check one diagram in MedialAxisProcessor::VALIDATION_SAMPLE_INTERVAL
+  FULL      // Check every diagram
 };
 
 /**
@@ -55,6 +109,14 @@ struct MedialAxisResults {
  */
 class MedialAxisProcessor {
  public:
+  static constexpr int VALIDATION_SAMPLE_INTERVAL = 16;
+
+#ifdef NDEBUG
+  static constexpr DiagramValidation DEFAULT_VALIDATION = DiagramValidation::OFF;
+#else
+  static constexpr DiagramValidation DEFAULT_VALIDATION = DiagramValidation::FULL;
+#endif
+
   /**
    * Constructor with default parameters
    */
@@ -75,12 +137,23 @@ class MedialAxisProcessor {
   MedialAxisResults computeMedialAxis(const Shape& shape);
 
   /**
-   * Compute medial axis from pre-polygonized vertices
+   * Compute medial axis from pre-polygonized vertices, thinned to
+   * polygonTolerance_ first if setSimplifyInput(true)
    * @param polygon The polygon vertices in world coordinates
    * @return Complete medial axis results
    */
   MedialAxisResults computeMedialAxis(const std::vector<Point2D>& polygon);
 
+  /**
+   * Compute medial axis of a profile with holes in a single diagram; the
+   * chains stay between the outer loop and the holes
+   * @param polygon Outer loop vertices in world coordinates
+   * @param holes Inner loops, each inside polygon (either winding)
+   * @return Complete medial axis results
+   */
+  MedialAxisResults computeMedialAxis(const std::vector<Point2D>& polygon,
+                                      const std::vector<std::vector<Point2D>>& holes);
+
   /**
    * Get sampled medial axis paths suitable for toolpath generation
    * @param results MedialAxisResults from computeMedialAxis
@@ -89,6 +162,14 @@ class MedialAxisProcessor {
    */
   std::vector<SampledMedialPath> getSampledPaths(const MedialAxisResults& results, double spacing = 1.0);
 
+  /**
+   * Append sampled medial axis paths to caller-provided storage
+   * @param results MedialAxisResults from computeMedialAxis
+   * @param spacing Spacing between sampled points (mm)
+   * @param sampledPaths Output; one path is appended per non-empty chain
+   */
+  void getSampledPaths(const MedialAxisResults& results, double spacing, std::vector<SampledMedialPath>& sampledPaths);
+
   // Parameter accessors
   double getPolygonTolerance() const {
     return polygonTolerance_;
@@ -104,11 +185,18 @@ class MedialAxisProcessor {
     medialThreshold_ = threshold;
   }
 
-  // Enable/disable verbose logging for debugging
+  // Enable/disable verbose logging for debugging (verbose runs always validate every diagram)
   void setVerbose(bool verbose) {
     verbose_ = verbose;
   }
 
+  void setDiagramValidation(DiagramValidation validation) {
+    validation_ = validation;
+  }
+  DiagramValidation getDiagramValidation() const {
+    return verbose_ ? DiagramValidation::FULL : validation_;
+  }
+
   // Set MedialAxisWalk intermediate points parameter (for testing)
   void setMedialAxisWalkPoints(int points) {
     medialAxisWalkPoints_ = points;
@@ -117,47 +205,142 @@ class MedialAxisProcessor {
     return medialAxisWalkPoints_;
   }
 
+  /**
+   * Split polygons with at least this many vertices into tiles computed in
+   * parallel (see MedialAxisPartition.h); 0 keeps one diagram per polygon
+   * @param workers Tile worker threads (0 = hardware concurrency)
+   */
+  void setPartitioning(size_t minVertices, int workers = 0) {
+    partitionMinVertices_ = minVertices;
+    partitionWorkers_ = workers;
+  }
+  size_t getPartitionMinVertices() const {
+    return partitionMinVertices_;
+  }
+
+  /**
+   * Compute mirror-symmetric polygons from one fundamental wedge and reflect
+   * the chains onto the rest (see MedialAxisSymmetry.h); off by default
+   */
+  void setSymmetryDetection(bool enabled) {
+    symmetryDetection_ = enabled;
+  }
+  bool getSymmetryDetection() const {
+    return symmetryDetection_;
+  }
+
+  // Thin the input polygon to within polygonTolerance_, keeping sharp corners. Off by default: polygonTolerance_
+  // defaults to 0.25 world units, so enable it where the tolerance is set in the polygon's units
+  void setSimplifyInput(bool simplify) {
+    simplifyInput_ = simplify;
+  }
+  bool getSimplifyInput() const {
+    return simplifyInput_;
+  }
+
+  // Retry failed OpenVoronoi computations down medialAxisRetryLadder() (on by default)
+  void setRetryOnFailure(bool retry) {
+    retryOnFailure_ = retry;
+  }
+  bool getRetryOnFailure() const {
+    return retryOnFailure_;
+  }
+
+  // Prune insignificant spurs from computed diagrams (off by default; see MedialAxisSpurs.h)
+  void setSpurPruning(const SpurPruningOptions& options) {
+    spurPruning_ = options;
+  }
+  const SpurPruningOptions& getSpurPruning() const {
+    return spurPruning_;
+  }
+
+  // Let computeMedialAxisProfile() take the straight skeleton of profiles with only straight
+  // edges and no holes (off by default; see StraightSkeleton.h)
+  void setStraightSkeleton(bool enabled) {
+    straightSkeleton_ = enabled;
+  }
+  bool getStraightSkeleton() const {
+    return straightSkeleton_;
+  }
+
+  /**
+   * Also trace flat-bottom clearing offset loops in each OpenVoronoi diagram before it is
+   * reduced to the medial axis (off by default). Only the full diagram has them, so
+   * symmetric and tiled computation are skipped while this is on.
+   */
+  void setClearingOffsets(const ClearingOffsets& offsets) {
+    clearingOffsets_ = offsets;
+  }
+  const ClearingOffsets& getClearingOffsets() const {
+    return clearingOffsets_;
+  }
+
+  // Point site insertion order for OpenVoronoi (Hilbert by default)
+  void setSiteInsertionOrder(SiteInsertionOrder order) {
+    siteOrder_ = order;
+  }
+  SiteInsertionOrder getSiteInsertionOrder() const {
+    return siteOrder_;
+  }
+
  private:
-  double polygonTolerance_;   // Maximum error for polygon approximation (mm)
+  double polygonTolerance_;   // Maximum error for polygon approximation (world units)
   double medialThreshold_;    // OpenVoronoi threshold for edge parallelism
   bool verbose_;              // Enable verbose logging
   int medialAxisWalkPoints_;  // MedialAxisWalk intermediate points parameter
+  size_t partitionMinVertices_ = 0;  // Tiled computation threshold (0 = off)
+  int partitionWorkers_ = 0;
+  bool symmetryDetection_ = false;
+  SiteInsertionOrder siteOrder_ = SiteInsertionOrder::HILBERT;
+  DiagramValidation validation_ = DEFAULT_VALIDATION;
+  int diagramsComputed_ = 0;  // For SAMPLED validation
+  bool retryOnFailure_ = true;
+  bool simplifyInput_ = false;
+  bool straightSkeleton_ = false;
+  SpurPruningOptions spurPruning_{};
+  ClearingOffsets clearingOffsets_{};
+  MedialAxisWorkspace workspace_{};  // Buffers reused across computeMedialAxis calls
 
   /**
-   * Transform polygon from world coordinates to unit circle
-   * @param polygon Input polygon in world coordinates
+   * Bounding box and unit circle fit of a world polygon
    * @param params Output transformation parameters
-   * @return Transformed polygon in unit circle coordinates
    */
-  std::vector<Point2D> transformToUnitCircle(const std::vector<Point2D>& polygon, TransformParams& params);
+  void fitUnitCircle(const std::vector<Point2D>& polygon, TransformParams& params);
+
+  // Apply spurPruning_ to a finished diagram
+  void pruneSpurs(MedialAxisResults& results) const;
 
   /**
    * Transform point from unit circle back to world coordinates
    * @param unitPoint Point in unit circle coordinates
-   * @param params Transformation parameters from transformToUnitCircle
+   * @param params Transformation parameters from fitUnitCircle
    * @return Point in world coordinates
    */
   Point2D transformFromUnitCircle(const Point2D& unitPoint, const TransformParams& params);
 
   /**
-   * Validate polygon for OpenVoronoi processing
-   * @param polygon Polygon in unit circle coordinates
+   * Map polygon to (p - offset) * scale into unitPolygon and check it for
+   * OpenVoronoi in the same pass: degenerate edges, the unit circle, area and
+   * winding of every loop, then self-intersections by sweep line and holes
+   * outside the outer loop. Holes wound like the outer loop are reversed.
+   * @param loopStarts First vertex of each loop (outer loop first), then the polygon size
+   * @param unitPolygon Output buffer, resized to the polygon
+   * @param interiorSide Output polygon_interior_filter side for the outer winding
    * @return true if polygon is valid for OpenVoronoi
    */
-  bool validatePolygonForOpenVoronoi(const std::vector<Point2D>& polygon);
+  bool prepareUnitPolygon(const std::vector<Point2D>& polygon, const std::vector<size_t>& loopStarts,
+                          const Point2D& offset, double scale, std::vector<Point2D>& unitPolygon, bool& interiorSide);
 
   /**
    * Core OpenVoronoi computation on unit circle polygon
-   * @param transformedPolygon Polygon in unit circle coordinates
+   * @param transformedPolygon Polygon in unit circle coordinates, checked by prepareUnitPolygon
+   * @param loopStarts Loops of transformedPolygon, as given to prepareUnitPolygon
+   * @param interiorSide Side prepareUnitPolygon reported for the winding
    * @param results Output results structure (will be populated)
    * @return true if computation succeeded
    */
-  bool computeOpenVoronoi(const std::vector<Point2D>& transformedPolygon, MedialAxisResults& results);
-
-  /**
-   * Log message if verbose mode is enabled
-   */
-  void log(const std::string& message);
+  bool computeOpenVoronoi(const std::vector<Point2D>& transformedPolygon, const std::vector<size_t>& loopStarts,
+                          bool interiorSide, MedialAxisResults& results);
 };
 
 }  // namespace Geometry
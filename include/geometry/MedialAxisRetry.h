@@ -0,0 +1,56 @@
+/**
+ * MedialAxisRetry.h
+ *
+ * Fallback ladder for OpenVoronoi computations that throw on near-degenerate
+ * input. Each rung reworks the unit circle polygon a little more before the
+ * diagram is built again, so one bad profile does not fail a whole run.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <string>
+#include <vector>
+
+#include "Point2D.h"
+
+namespace ChipCarving {
+namespace Geometry {
+
+enum class MedialAxisRetry {
+  NONE,        // Polygon as given
+  PERTURBED,   // Vertices jittered by a tiny fixed-seed offset
+  SIMPLIFIED,  // Near-collinear vertices removed with a coarser tolerance
+  RESCALED     // Refit into a smaller circle so every coordinate rounds differently
+};
+
+const char* medialAxisRetryName(MedialAxisRetry retry);
+
+// One OpenVoronoi computation of a profile
+struct MedialAxisAttempt {
+  MedialAxisRetry retry = MedialAxisRetry::NONE;
+  bool success = false;
+  std::string errorMessage{};
+};
+
+// Rungs tried after the plain computation fails, in order
+const std::vector<MedialAxisRetry>& medialAxisRetryLadder();
+
+/**
+ * Rework a unit circle polygon for one rung of the ladder
+ * @param unitPolygon Polygon from MedialAxisProcessor::prepareUnitPolygon
+ * @param scale World to unit scale, multiplied by any extra scaling applied
+ * @return The polygon to insert; empty if the rung cannot apply (too few vertices left)
+ */
+std::vector<Point2D> retryPolygon(const std::vector<Point2D>& unitPolygon, MedialAxisRetry retry, double& scale);
+
+/**
+ * Rework a multi-loop unit circle polygon, simplifying each loop on its own
+ * @param loopStarts First vertex of each loop in unitPolygon, then its size
+ * @param reworkedStarts Output loopStarts of the returned polygon
+ */
+std::vector<Point2D> retryPolygon(const std::vector<Point2D>& unitPolygon, const std::vector<size_t>& loopStarts,
+                                  MedialAxisRetry retry, double& scale, std::vector<size_t>& reworkedStarts);
+
+}  // namespace Geometry
+}  // namespace ChipCarving
@@ -0,0 +1,40 @@
+/**
+ * MedialAxisSpurs.h
+ *
+ * Pruning of insignificant medial axis branches. Noisy tessellated strokes
+ * grow tiny branches toward every small bump of the outline; each one would
+ * become its own sampled path, toolpath and spline. A spur is a chain from a
+ * free end to a junction; one that is short, or whose clearance hardly
+ * changes along it, carves nothing the neighbouring chains do not.
+ */
+
+#pragma once
+
+#include <cstddef>
+
+namespace ChipCarving {
+namespace Geometry {
+
+struct MedialAxisResults;
+
+struct SpurPruningOptions {
+  double minLength = 0.0;           ///< Spurs shorter than this are removed (world units, 0 = off)
+  double minClearanceChange = 0.0;  ///< Spurs whose clearance varies less than this are removed (0 = off)
+
+  bool enabled() const {
+    return minLength > 0.0 || minClearanceChange > 0.0;
+  }
+};
+
+/**
+ * Remove insignificant spurs in a single pass, shortest first. A junction
+ * always keeps at least two chains, so pruning never disconnects the axis or
+ * eats into a chain that is not a spur. Chains, statistics and the graph are
+ * rebuilt in place.
+ * @param results Successful medial axis results with their graph
+ * @return Number of chains removed
+ */
+size_t pruneMedialAxisSpurs(MedialAxisResults& results, const SpurPruningOptions& options);
+
+}  // namespace Geometry
+}  // namespace ChipCarving
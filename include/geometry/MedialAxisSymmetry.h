@@ -0,0 +1,69 @@
+/**
+ * MedialAxisSymmetry.h
+ *
+ * Medial axis of mirror-symmetric polygons from one fundamental region. Leaves
+ * mirror about their chord and its bisector, regular TriArcs about three axes,
+ * and many custom profiles are symmetric by construction. With k mirror axes
+ * through the area centroid the polygon is 2k copies of a wedge of angle π/k;
+ * one OpenVoronoi diagram is built from the boundary within a halo of that
+ * wedge, its chains are clipped to the wedge and reflected and turned onto the
+ * other copies, and the copies are stitched where they meet on the axes.
+ *
+ * The halo works as in MedialAxisPartition.h: a kept medial point whose
+ * clearance is below the halo width has all of its nearest boundary in the
+ * diagram. Since a medial point on an axis has its nearest boundary on both
+ * sides, the saving is smaller than 2k for fat shapes; the wedge is skipped
+ * when its diagram would take most of the edges anyway.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <vector>
+
+#include "MedialAxisProcessor.h"
+#include "Point2D.h"
+
+namespace ChipCarving {
+namespace Geometry {
+
+struct PolygonSymmetry {
+  Point2D centre{0, 0};    // Area centroid; every mirror axis passes through it
+  double axisAngle = 0.0;  // Direction of one mirror axis (radians, in [0, π))
+  int mirrorAxes = 0;      // Evenly spaced axes; k of them also make the outline k-fold rotationally symmetric
+
+  // Copies of the fundamental wedge that make up the polygon
+  int order() const {
+    return 2 * mirrorAxes;
+  }
+};
+
+struct MedialAxisSymmetryOptions {
+  double tolerance = 0.0;         // Largest mirror mismatch (world units; 0 = 1e-6 of the polygon extent)
+  double haloFraction = 0.25;     // First halo width, as a fraction of the polygon's radius about its centre
+  double maxSiteFraction = 0.75;  // Edges the wedge's diagram may take before the full diagram is computed
+  size_t minVertices = 64;        // Smaller polygons are not worth detecting
+  int maxMirrorAxes = 12;         // Narrower wedges are all halo
+};
+
+/**
+ * Find the mirror axes of a polygon: every reflected vertex must lie within
+ * tolerance of the boundary, so vertices need not pair up one to one
+ * @param polygon Outline in world coordinates (a closing duplicate vertex is ignored)
+ * @return false if the polygon has no mirror axis
+ */
+bool detectPolygonSymmetry(const std::vector<Point2D>& polygon, double tolerance, PolygonSymmetry& symmetry);
+
+/**
+ * Compute the medial axis of a mirror-symmetric polygon from its fundamental wedge
+ * @param prototype Processor whose threshold, walk points and site order are used
+ * @param polygon Polygon in world coordinates (a closing duplicate vertex is ignored)
+ * @param results Chains and statistics on success; the transform is left to the caller
+ * @return false if the polygon is too small or not symmetric, the wedge saves too little,
+ *         or its diagram failed (results are then untouched)
+ */
+bool computeSymmetricMedialAxis(const MedialAxisProcessor& prototype, const std::vector<Point2D>& polygon,
+                                const MedialAxisSymmetryOptions& options, MedialAxisResults& results);
+
+}  // namespace Geometry
+}  // namespace ChipCarving
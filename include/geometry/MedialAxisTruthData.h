@@ -0,0 +1,96 @@
+/**
+ * MedialAxisTruthData.h
+ *
+ * Medial axis truth files for the geometry regression tests, in the
+ * readable text format of tests/medial_axis_truth_data ("path i:" blocks of
+ * "point j: x y clearance" lines) or a binary format for production-sized
+ * fixtures, which is memory-mapped and loaded with one copy per array.
+ *
+ * A fixture may also carry the input polygon and processor parameters it was
+ * recorded from, and the OpenVoronoi version that recorded it, so the
+ * regression runner can recompute and compare it. Text files give these in
+ * optional "engine:", "tolerance:", "threshold:" and "polygon: N" (followed
+ * by "vertex i: x y" lines) entries ahead of the paths.
+ *
+ * Binary layout (native byte order):
+ *   TruthHeader
+ *   char     engineVersion[engineVersionBytes]
+ *   double   polygon[2 * polygonPoints]   (x, y interleaved)
+ *   uint32_t chainSizes[numChains]
+ *   double   x[totalPoints]            (all chains, concatenated)
+ *   double   y[totalPoints]            (same order as x)
+ *   double   clearances[totalPoints]   (same order as x)
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <string>
+#include <vector>
+
+#include "MedialAxisChains.h"
+#include "Point2D.h"
+
+namespace ChipCarving {
+namespace Geometry {
+
+/**
+ * First difference found by compareTruthChains
+ */
+struct TruthMismatch {
+  size_t chain = 0;
+  size_t point = 0;
+  std::string reason{};
+};
+
+/**
+ * Truth chains with the input and engine they were recorded from
+ */
+struct TruthFixture {
+  std::string engineVersion{};     // OpenVoronoi version that recorded chains; empty if unknown
+  std::vector<Point2D> polygon{};  // Input outline; empty for chains-only fixtures
+  double polygonTolerance = 0.25;  // MedialAxisProcessor parameters the chains were recorded with
+  double medialThreshold = 0.8;
+  MedialAxisChains chains{};
+};
+
+/**
+ * Load a truth file in either format, told apart by the binary magic
+ * @return false if the file is missing or malformed; fixture is then unchanged
+ */
+bool loadTruthFixture(const std::string& path, TruthFixture& fixture);
+
+/**
+ * Load only the chains of a truth file in either format
+ * @return false if the file is missing or malformed; chains is then unchanged
+ */
+bool loadTruthFile(const std::string& path, MedialAxisChains& chains);
+
+/**
+ * Write a fixture in the binary format
+ * @return false if the file could not be written
+ */
+bool storeBinaryTruthFixture(const std::string& path, const TruthFixture& fixture);
+
+/**
+ * Write chains in the binary format, without polygon or engine metadata
+ * @return false if the file could not be written
+ */
+bool storeBinaryTruthFile(const std::string& path, const MedialAxisChains& chains);
+
+/**
+ * Write a fixture in the text format, with full double precision
+ * @return false if the file could not be written
+ */
+bool storeTextTruthFixture(const std::string& path, const TruthFixture& fixture);
+
+/**
+ * Compare chain by chain and point by point, stopping at the first chain
+ * count, chain size, coordinate or clearance that differs beyond tolerance
+ * @param mismatch Filled with that difference if not null
+ */
+bool compareTruthChains(const MedialAxisChains& expected, const MedialAxisChains& actual, double tolerance,
+                        TruthMismatch* mismatch = nullptr);
+
+}  // namespace Geometry
+}  // namespace ChipCarving
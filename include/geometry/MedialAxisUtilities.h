@@ -9,6 +9,7 @@
 
 #include <vector>
 
+#include "MedialAxisChains.h"
 #include "Point2D.h"
 
 namespace ChipCarving {
@@ -20,8 +21,10 @@ namespace Geometry {
 struct SampledMedialPoint {
   Point2D position;        ///< (x, y) position in world coordinates
   double clearanceRadius;  ///< Clearance radius (max tool radius) at this point
+  bool forced;             ///< Placed at a forced position (e.g. a boundary crossing); never merged away
 
-  SampledMedialPoint(const Point2D& pos, double clearance) : position(pos), clearanceRadius(clearance) {}
+  SampledMedialPoint(const Point2D& pos, double clearance, bool forcedSample = false)
+      : position(pos), clearanceRadius(clearance), forced(forcedSample) {}
 };
 
 /**
@@ -30,6 +33,7 @@ struct SampledMedialPoint {
 struct SampledMedialPath {
   std::vector<SampledMedialPoint> points{};  ///< Sampled points along this path
   double totalLength = 0.0;                  ///< Total length of this path in mm
+  int chain = -1;                            ///< Index of the sampled medial axis chain (-1 = not from one)
 };
 
 /**
@@ -53,5 +57,93 @@ std::vector<SampledMedialPath> sampleMedialAxisPaths(const std::vector<std::vect
                                                      const std::vector<std::vector<double>>& clearanceRadii,
                                                      double targetSpacing = 1.0);
 
+/**
+ * Sample medial axis chains in place, in a single pass per chain.
+ *
+ * Same sampling as sampleMedialAxisPaths, but chain points and clearances are
+ * read straight from the flat chain storage and scaled on the fly, and the
+ * densified chain is never materialized. Sampled paths are appended to the
+ * caller's vector, so a vector reused across profiles keeps its capacity.
+ *
+ * @param chains Medial axis chains with clearance radii
+ * @param unitScale Factor applied to positions and clearances (10.0 for cm -> mm)
+ * @param targetSpacing Target spacing between sampled points, in output units
+ * @param sampledPaths Output; one path is appended per non-empty chain
+ * @param forcedPositions Optional per chain: sorted distances along it (output
+ *        units) sampled exactly, e.g. boundary crossings; regular samples
+ *        closer than the minimum separation to one give way to it
+ */
+void sampleMedialAxisChains(const MedialAxisChains& chains, double unitScale, double targetSpacing,
+                            std::vector<SampledMedialPath>& sampledPaths,
+                            const std::vector<std::vector<double>>* forcedPositions = nullptr);
+
+/**
+ * Where each chain crosses or touches a boundary loop, as distances along it
+ *
+ * Chain segments and loop edges go through one Bentley-Ottmann sweep
+ * (findSegmentCrossings), so the cost follows the crossings found rather than
+ * every chain segment against every edge. Crossings within the minimum sample
+ * separation of a chain end are left out: the ends are always sampled.
+ *
+ * @param chains Medial axis chains, in the loops' units
+ * @param boundaries Closed loops (a closing duplicate vertex is allowed)
+ * @param unitScale Applied to the distances, as for sampleMedialAxisChains
+ * @param positions Output, one sorted list per chain; the forcedPositions of sampleMedialAxisChains
+ */
+void findChainBoundaryCrossings(const MedialAxisChains& chains,
+                                const std::vector<const std::vector<Point2D>*>& boundaries, double unitScale,
+                                std::vector<std::vector<double>>& positions);
+
+/**
+ * Sample medial axis chains at exact distances along them.
+ *
+ * Samples sit at the same evenly spaced distances sampleMedialAxisChains aims
+ * for, evaluated on the chain's arc-length parameterization rather than picked
+ * from a densified copy of it. With boundary loops given, each sample's
+ * clearance is its distance to the nearest loop edge instead of an
+ * interpolation between chain points, which overstates it where the chain's
+ * straight segments cut across a curved (parabolic) Voronoi edge.
+ *
+ * @param chains Medial axis chains with clearance radii, in the loops' units
+ * @param unitScale Factor applied to positions, clearances and distances (10.0 for cm -> mm)
+ * @param targetSpacing Target spacing between sampled points, in output units
+ * @param boundaries The profile's closed loops (empty = interpolated clearances)
+ * @param sampledPaths Output; one path is appended per non-empty chain
+ * @param forcedPositions As for sampleMedialAxisChains
+ */
+void sampleMedialAxisChainsExact(const MedialAxisChains& chains, double unitScale, double targetSpacing,
+                                 const std::vector<const std::vector<Point2D>*>& boundaries,
+                                 std::vector<SampledMedialPath>& sampledPaths,
+                                 const std::vector<std::vector<double>>* forcedPositions = nullptr);
+
+/**
+ * Tolerances for adaptive (error-driven) medial axis sampling
+ */
+struct AdaptiveSamplingOptions {
+  double chordTolerance = 0.02;   ///< Max (x, y, depth) deviation of the chain from its samples
+  double depthPerClearance = 1.0;  ///< V-carve depth per unit clearance (1 / tan(half tool angle))
+  double maxDepth = 0.0;           ///< Depth clamp applied before measuring deviation (0 = none)
+  double maxSpacing = 0.0;         ///< Upper bound on the gap between samples (0 = none)
+};
+
+/**
+ * Sample medial axis chains adaptively.
+ *
+ * Each chain is treated as a 3D polyline of (x, y, V-carve depth) and reduced
+ * to the vertices needed to keep every dropped vertex within chordTolerance of
+ * the line between its neighbouring samples. Straight runs of constant
+ * clearance collapse to their endpoints, while corners and fast-changing
+ * clearance keep their vertices. Samples always lie on chain vertices, apart
+ * from the evenly spaced points inserted when maxSpacing is set.
+ *
+ * @param chains Medial axis chains with clearance radii
+ * @param unitScale Factor applied to positions and clearances (10.0 for cm -> mm)
+ * @param options Tolerances, in output units
+ * @param sampledPaths Output; one path is appended per non-empty chain
+ */
+void sampleMedialAxisChainsAdaptive(const MedialAxisChains& chains, double unitScale,
+                                    const AdaptiveSamplingOptions& options,
+                                    std::vector<SampledMedialPath>& sampledPaths);
+
 }  // namespace Geometry
 }  // namespace ChipCarving
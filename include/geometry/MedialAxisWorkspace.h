@@ -0,0 +1,54 @@
+/**
+ * MedialAxisWorkspace.h
+ *
+ * Scratch buffers a MedialAxisProcessor keeps between profiles, so a run of
+ * many small profiles stops allocating once the buffers have grown to fit.
+ * Each worker thread computes with its own processor copy, and copies start
+ * with an empty workspace rather than sharing or duplicating the buffers.
+ *
+ * OpenVoronoi's VoronoiDiagram and MedialAxisWalk chain lists have no way to
+ * be reset or given storage, so those are still built per profile.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "Point2D.h"
+
+namespace ChipCarving {
+namespace Geometry {
+
+// Polygon edge bounding box for the self-intersection sweep
+struct EdgeBounds {
+  double minX = 0.0;
+  double maxX = 0.0;
+  double minY = 0.0;
+  double maxY = 0.0;
+  size_t next = 0;  // Vertex the edge ends at
+};
+
+struct MedialAxisWorkspace {
+  MedialAxisWorkspace() = default;
+  MedialAxisWorkspace(const MedialAxisWorkspace&) {}
+  MedialAxisWorkspace& operator=(const MedialAxisWorkspace&) {
+    return *this;
+  }
+
+  std::vector<Point2D> loopPolygon{};        // Outer loop then holes, each simplified when enabled
+  std::vector<size_t> loopStarts{};          // First vertex of each loop in loopPolygon, then its size
+  std::vector<size_t> attemptLoopStarts{};   // loopStarts of attemptPolygon
+  std::vector<Point2D> unitPolygon{};        // Unit circle polygon from prepareUnitPolygon
+  std::vector<Point2D> attemptPolygon{};     // Retry ladder rework of unitPolygon
+  std::vector<int> pointIds{};               // OpenVoronoi point site ids by polygon vertex
+  std::vector<size_t> insertionOrder{};      // Point site insertion permutation
+  std::vector<uint64_t> hilbertKeys{};       // Scratch for the Hilbert insertion order
+  std::vector<EdgeBounds> edgeBounds{};      // Self-intersection sweep, by edge
+  std::vector<size_t> edgeOrder{};           // Edges by left end
+  std::vector<size_t> activeEdges{};         // Edges whose x range is still open
+};
+
+}  // namespace Geometry
+}  // namespace ChipCarving
@@ -0,0 +1,27 @@
+/**
+ * NumberScanner.h
+ *
+ * Allocation-free scan of decimal numbers embedded in text (SVG path data,
+ * truth files). Finds the same numbers, in the same order, as the regex
+ * [-+]?[0-9]*\.?[0-9]+([eE][-+]?[0-9]+)? and converts each one in place:
+ * numbers of up to 15 significant digits with small exponents are exact
+ * without strtod, anything else falls back to it.
+ */
+
+#pragma once
+
+#include <cstddef>
+
+namespace ChipCarving {
+namespace Geometry {
+
+/**
+ * Find the next number in [cursor, end)
+ * @param cursor Advanced past the number, or to end if there is none
+ * @param value The number, correctly rounded
+ * @return false if no number is left
+ */
+bool scanNumber(const char*& cursor, const char* end, double& value);
+
+}  // namespace Geometry
+}  // namespace ChipCarving
@@ -0,0 +1,72 @@
+/**
+ * PointKernels.h
+ *
+ * Batch kernels over point arrays, for the loops that transform, measure or
+ * search whole polygons and medial axis chains. Points come either as Point2D
+ * arrays or as separate x and y arrays (the MedialAxisChains layout). Each
+ * kernel is vectorized with AVX2, SSE2 or NEON, whichever the compiler
+ * targets, and falls back to scalar code otherwise. Every lane does the same
+ * operations in the same order as the scalar Point2D helpers, so results are
+ * identical on every path.
+ */
+
+#pragma once
+
+#include <cstddef>
+
+#include "Point2D.h"
+
+namespace ChipCarving {
+namespace Geometry {
+
+struct PointBounds {
+  Point2D min{};
+  Point2D max{};
+};
+
+// Bounding box of the points; both corners at the origin for no points
+PointBounds pointBounds(const Point2D* points, size_t count);
+PointBounds pointBounds(const double* x, const double* y, size_t count);
+
+/**
+ * out[i] = (points[i] - offset) * scale, e.g. into the medial axis unit circle
+ * @param out May be points itself
+ */
+void transformPoints(const Point2D* points, size_t count, const Point2D& offset, double scale, Point2D* out);
+
+/**
+ * lengths[i] = distance from point i to point i + 1 once both are multiplied
+ * by scale (count - 1 lengths; none for fewer than two points)
+ */
+void segmentLengths(const double* x, const double* y, size_t count, double scale, double* lengths);
+
+/**
+ * lengths[i] = distance along the scaled polyline to point i (count entries,
+ * lengths[0] = 0)
+ * @return Total length
+ */
+double cumulativeLengths(const double* x, const double* y, size_t count, double scale, double* lengths);
+
+/**
+ * Index of the point nearest query (the first of equally near ones); count > 0
+ * @param distanceSquared Set to its squared distance from query
+ */
+size_t nearestPoint(const double* x, const double* y, size_t count, const Point2D& query, double& distanceSquared);
+
+/**
+ * distances[i] = distance() from (x[i], y[i]) to center
+ */
+void pointDistances(const double* x, const double* y, size_t count, const Point2D& center, double* distances);
+
+/**
+ * values[i] = (coefficients.x * (x[i] - origin.x) + coefficients.y * (y[i] - origin.y)) / divisor,
+ * the barycentric coordinate of a point in a triangle given its edge coefficients
+ */
+void linearForms(const double* x, const double* y, size_t count, const Point2D& origin, const Point2D& coefficients,
+                 double divisor, double* values);
+
+// Instruction set the kernels were built for: "avx2", "sse2", "neon" or "scalar"
+const char* pointKernelInstructionSet();
+
+}  // namespace Geometry
+}  // namespace ChipCarving
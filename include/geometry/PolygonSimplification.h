@@ -0,0 +1,29 @@
+/**
+ * PolygonSimplification.h
+ *
+ * Douglas-Peucker thinning of closed 2D polygons before they become Voronoi
+ * sites. Sharp corners are always kept and each corner-to-corner span is
+ * simplified on its own, so tessellated arcs lose only the vertices that stay
+ * within tolerance of their chords.
+ */
+
+#pragma once
+
+#include <vector>
+
+#include "Point2D.h"
+
+namespace ChipCarving {
+namespace Geometry {
+
+/**
+ * Remove vertices that lie within tolerance of the simplified outline
+ * @param polygon Closed polygon (a duplicate closing vertex is kept as such)
+ * @param tolerance Maximum distance of a dropped vertex to the result, in polygon units
+ * @param cornerAngle Turns sharper than this (radians) are never removed
+ * @return The simplified polygon, or polygon itself if fewer than 3 vertices would remain
+ */
+std::vector<Point2D> simplifyPolygon(const std::vector<Point2D>& polygon, double tolerance, double cornerAngle);
+
+}  // namespace Geometry
+}  // namespace ChipCarving
@@ -0,0 +1,79 @@
+/**
+ * PolylineArcFitter.h
+ *
+ * Splits a 3D toolpath polyline into runs of straight segments and circular
+ * arcs, for sketch output as chained SketchLines / SketchArcs instead of a
+ * fitted spline.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <vector>
+
+#include "Point2D.h"
+#include "Point3D.h"
+
+namespace ChipCarving {
+namespace Geometry {
+
+/**
+ * A run of consecutive polyline points [first, last]
+ * Line spans are drawn as one segment per point pair; arc spans as a single
+ * arc through points[first], points[(first + last) / 2] and points[last].
+ */
+struct PolylineSpan {
+  bool isArc = false;
+  size_t first = 0;
+  size_t last = 0;
+
+  size_t mid() const {
+    return (first + last) / 2;
+  }
+};
+
+/**
+ * Cover a polyline with line and arc spans
+ *
+ * A run of at least MIN_ARC_POINTS points becomes an arc when every point in
+ * it lies within tolerance of a common circle, the points advance around that
+ * circle in one direction, and the arc is not flat enough to be a single line.
+ *
+ * @param points Polyline points (at least 2)
+ * @param tolerance Maximum distance of a point from its arc (0 = lines only)
+ * @return Spans in order, each starting where the previous one ends
+ */
+std::vector<PolylineSpan> fitPolylineSpans(const std::vector<Point3D>& points, double tolerance);
+
+constexpr size_t MIN_ARC_POINTS = 4;
+
+/**
+ * Circle in the XY plane through the projections of three points
+ */
+struct HelicalArc {
+  Point2D center;
+  double radius = 0.0;
+  bool counterClockwise = true;  // Direction from the first point through the second to the third
+};
+
+/**
+ * @return false if the XY projections of a, b and c are collinear
+ */
+bool helicalArcThrough(const Point3D& a, const Point3D& b, const Point3D& c, HelicalArc& arc);
+
+/**
+ * Cover a polyline with line and helical arc spans for G2/G3 output
+ *
+ * Like fitPolylineSpans(), except an arc span must lie on a circle in the XY
+ * plane with Z varying linearly along the sweep, which is the only arc a G17
+ * controller can interpolate. Ramps around a curve still become arcs; 3D
+ * circles tilted out of the XY plane do not.
+ *
+ * @param points Polyline points (at least 2)
+ * @param tolerance Maximum XY or Z distance of a point from its arc (0 = lines only)
+ * @return Spans in order, each starting where the previous one ends
+ */
+std::vector<PolylineSpan> fitHelicalArcSpans(const std::vector<Point3D>& points, double tolerance);
+
+}  // namespace Geometry
+}  // namespace ChipCarving
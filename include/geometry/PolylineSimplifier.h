@@ -0,0 +1,49 @@
+/**
+ * PolylineSimplifier.h
+ *
+ * Douglas-Peucker simplification of 3D polylines (toolpaths and lifted medial
+ * axis chains). Point-to-chord distances are computed over structure-of-arrays
+ * scratch buffers in a branch-free loop the compiler can vectorize.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <utility>
+#include <vector>
+
+#include "Point3D.h"
+
+namespace ChipCarving {
+namespace Geometry {
+
+class PolylineSimplifier {
+ public:
+  /**
+   * Mark the vertices needed to keep every dropped vertex within tolerance of
+   * the chord between its neighbouring kept vertices (endpoints are always kept)
+   * @param keep Output flags, one per point
+   */
+  void markRequired(const std::vector<Point3D>& points, double tolerance, std::vector<bool>& keep);
+
+  /**
+   * Remove the vertices markRequired() does not need, in place
+   * @return Number of points removed
+   */
+  size_t simplify(std::vector<Point3D>& points, double tolerance);
+
+ private:
+  // Squared distance of vertices first+1 .. last-1 to chord first -> last
+  void computeChordDistances(size_t first, size_t last);
+
+  // Scratch buffers reused across calls
+  std::vector<double> x_{};
+  std::vector<double> y_{};
+  std::vector<double> z_{};
+  std::vector<double> distance2_{};
+  std::vector<std::pair<size_t, size_t>> spans_{};
+  std::vector<bool> keep_{};
+};
+
+}  // namespace Geometry
+}  // namespace ChipCarving
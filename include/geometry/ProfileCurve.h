@@ -0,0 +1,73 @@
+/**
+ * ProfileCurve.h
+ *
+ * Exact curves of a sketch profile loop (lines, circular arcs and NURBS
+ * splines) and their polygonization to a chord error. The plugin reads each
+ * curve's world geometry once and leaves the tessellation to the pipeline, so
+ * the vertex count follows polygonTolerance instead of Fusion's stroke
+ * tolerance, and no Fusion stroke calls happen per curve. Arcs get the fewest
+ * chords whose sagitta stays within the tolerance; splines are bisected until
+ * every chord midpoint lies within it.
+ */
+
+#pragma once
+
+#include <vector>
+
+#include "Point2D.h"
+
+namespace ChipCarving {
+namespace Geometry {
+
+struct ProfileCurve {
+  enum class Type { LINE, ARC, SPLINE };
+
+  Type type = Type::LINE;
+  bool reversed = false;  // Traversed end to start in its loop
+  Point2D start{};        // Curve start, before any reversal
+  Point2D end{};
+
+  // Arcs: counter-clockwise for a positive sweep
+  Point2D center{};
+  double radius = 0.0;
+  double startAngle = 0.0;
+  double sweep = 0.0;
+
+  // Splines: NURBS with controlPoints.size() + degree + 1 knots
+  int degree = 0;
+  std::vector<Point2D> controlPoints{};
+  std::vector<double> weights{};  // Empty for a non-rational spline
+  std::vector<double> knots{};
+};
+
+ProfileCurve makeLineCurve(const Point2D& start, const Point2D& end);
+
+/**
+ * @param sweep Signed sweep in radians; +/-2*pi for a full circle
+ */
+ProfileCurve makeArcCurve(const Point2D& center, double radius, double startAngle, double sweep);
+
+/**
+ * @return A spline curve, or a line through the first and last control points if the knots do not fit
+ */
+ProfileCurve makeSplineCurve(int degree, std::vector<Point2D> controlPoints, std::vector<double> weights,
+                             std::vector<double> knots);
+
+/**
+ * Point on a spline curve at parameter t, clamped to its knot range
+ */
+Point2D evaluateSplineCurve(const ProfileCurve& curve, double t);
+
+/**
+ * Append a curve's polygon in loop direction, without its final point
+ * @param maxError Maximum chord-to-curve distance (curve units)
+ */
+void appendCurvePolygon(const ProfileCurve& curve, double maxError, std::vector<Point2D>& polygon);
+
+/**
+ * Polygonize a closed loop of curves in chain order: implicitly closed, no duplicate end vertex
+ */
+std::vector<Point2D> polygonizeProfileLoop(const std::vector<ProfileCurve>& loop, double maxError);
+
+}  // namespace Geometry
+}  // namespace ChipCarving
@@ -0,0 +1,48 @@
+/**
+ * ProfileTolerance.h
+ *
+ * Polygon tolerance and sampling distance chosen per profile. A boundary off
+ * by e moves a V-bit of included angle θ by e·cot(θ/2) in depth, so a depth
+ * error target sets the tolerance; a profile's tightest curve and its half
+ * width cap it so small chips keep their shape. The sampling distance is the
+ * chord that stays within that depth error over a medial curve as tight as
+ * the profile's features.
+ */
+
+#pragma once
+
+#include <vector>
+
+#include "Point2D.h"
+
+namespace ChipCarving {
+namespace Geometry {
+
+// Bounds and target of the automatic choice (mm and degrees)
+struct AutoToleranceOptions {
+  double depthError = 0.2;  // V-carve depth error allowed from polygonization
+  double toolAngle = 60.0;  // Included angle of the V-bit
+  double minTolerance = 0.01;
+  double maxTolerance = 0.5;
+  double minSampling = 0.1;
+  double maxSampling = 2.0;
+};
+
+struct ProfileTolerance {
+  double polygonTolerance = 0.0;  // mm
+  double samplingDistance = 0.0;  // mm
+  double minFeatureRadius = 0.0;  // mm; tightest smooth curve of the loops, or their half width if straight
+};
+
+/**
+ * Choose one profile's tolerance and sampling distance
+ * @param outline Outer loop, in polygon units
+ * @param holes Inner loops, same units
+ * @param unitsToMm Millimeters per polygon unit (10 for Fusion's cm)
+ */
+ProfileTolerance chooseProfileTolerance(const std::vector<Point2D>& outline,
+                                        const std::vector<std::vector<Point2D>>& holes, double unitsToMm,
+                                        const AutoToleranceOptions& options);
+
+}  // namespace Geometry
+}  // namespace ChipCarving
@@ -5,12 +5,13 @@
 
 #pragma once
 
-#include <sstream>
 #include <string>
 #include <vector>
 
+#include "CarveSimulation.h"
 #include "Leaf.h"
 #include "Point2D.h"
+#include "SVGWriter.h"
 #include "TriArc.h"
 
 namespace ChipCarving {
@@ -18,10 +19,14 @@ namespace Geometry {
 
 /**
  * Simple SVG builder for creating visual verification files
+ *
+ * Elements are kept in memory until generate() or saveToFile(). For large
+ * debug exports call streamToFile() first: elements are then written to the
+ * file as they are added and finishStream() completes it.
  */
 class SVGGenerator {
  private:
-  std::stringstream svg_{};
+  SVGWriter svg_{};
   double width_ = 0.0;
   double height_ = 0.0;
   double scale_ = 0.0;
@@ -74,11 +79,28 @@ class SVGGenerator {
   void addArc(const Point2D& center, double radius, double startAngle, double endAngle, bool anticlockwise = false,
               const std::string& color = "blue", double strokeWidth = 1.0);
 
+  /**
+   * Add an open polyline, or a polygon if closed (stroke only, not filled)
+   */
+  void addPolyline(const std::vector<Point2D>& points, const std::string& color = "black", double strokeWidth = 1.0,
+                   bool closed = false);
+
   /**
    * Add a circle (stroke only, not filled)
    */
   void addCircle(const Point2D& center, double radius, const std::string& color = "blue", double strokeWidth = 1.0);
 
+  /**
+   * Add a filled rectangle between two world corners
+   */
+  void addRect(const Point2D& min, const Point2D& max, const std::string& fill = "red", double opacity = 1.0);
+
+  /**
+   * Add the gouges (red) and missed areas (blue) of a carve verification,
+   * one rectangle per run of equal cells in a raster row
+   */
+  void addCarveVerification(const DepthMap& map, const CarveVerification& verification);
+
   /**
    * Add text label
    */
@@ -87,14 +109,28 @@ class SVGGenerator {
 
   /**
    * Generate the complete SVG string
+   * @return Empty while streaming; the elements are already in the file
    */
   std::string generate() const;
 
   /**
    * Save SVG to file
+   * @return false while streaming
    */
   bool saveToFile(const std::string& filename) const;
 
+  /**
+   * Write the elements added so far and all later ones straight to filename
+   * @return false if the file could not be opened; the generator keeps buffering in memory
+   */
+  bool streamToFile(const std::string& filename);
+
+  /**
+   * Close the SVG element and the streamed file
+   * @return false if not streaming or a write failed
+   */
+  bool finishStream();
+
  private:
   /**
    * Convert world coordinates to SVG coordinates
@@ -123,6 +159,13 @@ class SVGComparator {
    */
   static bool compare(const std::string& file1, const std::string& file2, double tolerance = DEFAULT_TOLERANCE);
 
+  /**
+   * Compare the numbers of two SVG texts in order, stopping at the first
+   * difference beyond tolerance; nothing is collected
+   */
+  static bool compareContent(const char* content1, size_t size1, const char* content2, size_t size2,
+                             double tolerance = DEFAULT_TOLERANCE);
+
   /**
    * Extract numerical values from SVG path data
    */
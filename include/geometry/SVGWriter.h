@@ -0,0 +1,88 @@
+/**
+ * SVGWriter.h
+ *
+ * Output buffer behind SVGGenerator. Numbers are formatted by hand with a
+ * fixed three decimals, matching std::fixed << std::setprecision(3) without
+ * stream formatting. In memory mode everything is kept for generate(); in
+ * streaming mode the buffer is written to a file whenever it fills, so
+ * exports of any size use a constant amount of memory.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <fstream>
+#include <string>
+
+namespace ChipCarving {
+namespace Geometry {
+
+class SVGWriter {
+ public:
+  static constexpr size_t STREAM_BUFFER_BYTES = 64 * 1024;
+
+  SVGWriter() = default;
+  SVGWriter(const SVGWriter&) = delete;
+  SVGWriter& operator=(const SVGWriter&) = delete;
+
+  SVGWriter& operator<<(const char* text) {
+    buffer_ += text;
+    return flushIfFull();
+  }
+  SVGWriter& operator<<(const std::string& text) {
+    buffer_ += text;
+    return flushIfFull();
+  }
+  SVGWriter& operator<<(double value) {
+    appendFixed(buffer_, value);
+    return flushIfFull();
+  }
+  SVGWriter& operator<<(int value) {
+    buffer_ += std::to_string(value);
+    return flushIfFull();
+  }
+
+  /**
+   * Switch to streaming: what is buffered so far and everything written
+   * afterwards goes to filename
+   * @return false if the file could not be opened; the writer stays in memory mode
+   */
+  bool openStream(const std::string& filename);
+
+  /**
+   * Flush the buffer and close the stream
+   * @return true if every write succeeded
+   */
+  bool closeStream();
+
+  bool isStreaming() const {
+    return stream_.is_open();
+  }
+
+  /**
+   * Everything written so far; in streaming mode only the unflushed tail
+   */
+  const std::string& buffered() const {
+    return buffer_;
+  }
+
+  /**
+   * Append value with exactly three decimals, rounding half to even like printf
+   */
+  static void appendFixed(std::string& out, double value);
+
+ private:
+  SVGWriter& flushIfFull() {
+    if (buffer_.size() >= STREAM_BUFFER_BYTES && stream_.is_open()) {
+      flush();
+    }
+    return *this;
+  }
+  void flush();
+
+  std::string buffer_{};
+  std::ofstream stream_{};
+};
+
+}  // namespace Geometry
+}  // namespace ChipCarving
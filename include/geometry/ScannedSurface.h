@@ -0,0 +1,161 @@
+/**
+ * ScannedSurface.h
+ *
+ * Projection surface read from a scanned blank instead of modeled in Fusion:
+ * a heightmap (16- or 8-bit grayscale PNG, or the plugin's own height grid)
+ * or a PLY/STL scan mesh. Height grids are read in place from a memory
+ * mapping; heightmaps are interpolated through SurfaceHeightfield tiles that
+ * are built on first use and evicted least recently used, so a large scan
+ * never has to be held at double precision. Meshes answer from a
+ * SurfaceMeshBVH. Everything here is in millimeters.
+ *
+ * Height grid layout (native byte order):
+ *   HeightGridHeader
+ *   float heights[columns * rows]  (row-major from originY up, x fastest; NaN = no surface)
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "Point2D.h"
+#include "SurfaceHeightfield.h"
+#include "SurfaceMeshBVH.h"
+
+namespace ChipCarving {
+namespace Utils {
+class MappedFile;
+}
+
+namespace Geometry {
+
+/**
+ * Where a scan sits in the design (mm)
+ */
+struct ScanPlacement {
+  double originX = 0.0;       // Added to scan XY; a PNG's lower-left pixel lands here
+  double originY = 0.0;
+  double pixelSize = 0.1;     // PNG pixel pitch (height grids and meshes carry their own scale)
+  double heightRange = 10.0;  // PNG height of a white pixel; black is 0
+  double zOffset = 0.0;       // Added to every height
+
+  bool operator==(const ScanPlacement& other) const {
+    return originX == other.originX && originY == other.originY && pixelSize == other.pixelSize &&
+           heightRange == other.heightRange && zOffset == other.zOffset;
+  }
+};
+
+struct HeightGridHeader {
+  char magic[4];  // "CCHG"
+  uint32_t formatVersion;
+  uint32_t columns;
+  uint32_t rows;
+  double originX;  // mm
+  double originY;
+  double spacing;
+};
+
+class ScannedSurface {
+ public:
+  enum class Format { HEIGHT_GRID, PNG, MESH };
+
+  static constexpr size_t TILE_CELLS = 128;       // Cells along each side of a cached tile
+  static constexpr size_t MAX_CACHED_TILES = 64;  // About 8.5 MB of tile heights
+
+  /**
+   * Read a scan file, recognized by its contents
+   * @param error Why the file could not be used, when null is returned
+   */
+  static std::shared_ptr<const ScannedSurface> load(const std::string& path, const ScanPlacement& placement,
+                                                    std::string& error);
+
+  /**
+   * Surface Z (mm) at each XY point (mm), NaN off the scan or where it has no data
+   * Safe to call from several threads; a batch holds the tile cache for its duration
+   */
+  std::vector<double> sampleHeights(const std::vector<Point2D>& points) const;
+
+  Format format() const {
+    return format_;
+  }
+  // Raster nodes along X and Y (0 for a mesh)
+  size_t columns() const {
+    return columns_;
+  }
+  size_t rows() const {
+    return rows_;
+  }
+  // True if raster heights are read straight from the mapped file
+  bool isMapped() const {
+    return mappedHeights_ != nullptr;
+  }
+  size_t cachedTileCount() const;
+
+ private:
+  ScannedSurface();
+
+  bool loadRaster(const Utils::MappedFile& file, const ScanPlacement& placement, std::string& error);
+
+  // Node height, row 0 at originY
+  double nodeHeight(size_t column, size_t row) const;
+
+  // Heights of one tile, built if it is not cached; tileMutex_ must be held
+  const SurfaceHeightfield& tile(size_t tileColumn, size_t tileRow) const;
+
+  Format format_ = Format::HEIGHT_GRID;
+  std::shared_ptr<const Utils::MappedFile> file_{};
+  const unsigned char* mappedHeights_ = nullptr;  // float heights inside file_
+  std::vector<float> ownedHeights_{};             // Decoded PNG heights
+  size_t columns_ = 0;
+  size_t rows_ = 0;
+  Point2D origin_{};
+  double spacing_ = 0.0;
+  double zOffset_ = 0.0;
+  std::unique_ptr<const SurfaceMeshBVH> mesh_{};
+
+  struct Tile {
+    size_t key = 0;
+    uint64_t lastUse = 0;
+    SurfaceHeightfield heights{};
+  };
+  mutable std::mutex tileMutex_{};
+  mutable std::vector<Tile> tiles_{};  // Reserved up front, so tile references stay valid
+  mutable std::unordered_map<size_t, size_t> tileSlots_{};
+  mutable uint64_t useClock_ = 0;
+};
+
+/**
+ * The scan of the most recent run, reloaded only when its path, placement or
+ * file changes between runs
+ */
+class ScannedSurfaceCache {
+ public:
+  // Null if the file cannot be used; error is only set by the load that failed, so it is reported once
+  std::shared_ptr<const ScannedSurface> get(const std::string& path, const ScanPlacement& placement,
+                                            std::string& error);
+
+ private:
+  std::mutex mutex_{};
+  std::string path_{};
+  ScanPlacement placement_{};
+  int64_t fileSize_ = -1;
+  int64_t modifiedTime_ = 0;
+  bool loaded_ = false;  // Also set after a failed load of the same file
+  std::shared_ptr<const ScannedSurface> surface_{};
+};
+
+/**
+ * Write heights (mm) as a height grid file
+ * @param heights columns * rows heights, row-major from originY
+ */
+bool writeHeightGrid(const std::string& path, const Point2D& origin, double spacing, size_t columns, size_t rows,
+                     const std::vector<float>& heights);
+
+}  // namespace Geometry
+}  // namespace ChipCarving
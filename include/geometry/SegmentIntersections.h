@@ -0,0 +1,44 @@
+/**
+ * SegmentIntersections.h
+ *
+ * Bentley-Ottmann sweep over line segments. Segments are tagged with a group
+ * (e.g. medial axis chains and profile edges) and only points where segments
+ * of different groups meet are reported, in O((n + k) log n) for n segments
+ * and k intersecting pairs, instead of testing every pair.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <vector>
+
+#include "Point2D.h"
+
+namespace ChipCarving {
+namespace Geometry {
+
+struct SweepSegment {
+  Point2D a{};
+  Point2D b{};
+  int group = 0;
+};
+
+struct SegmentCrossing {
+  size_t first = 0;   // Index into the swept segments; first < second
+  size_t second = 0;
+  Point2D point{};
+};
+
+/**
+ * Every point where two segments of different groups touch or cross
+ *
+ * A pair is reported once, at one point: where the segments cross, where an
+ * end of one lies on the other, or, for collinear overlapping segments, at an
+ * end of the overlap. Zero-length segments are ignored.
+ *
+ * @param crossings Cleared and filled, ordered by point (x, then y)
+ */
+void findSegmentCrossings(const std::vector<SweepSegment>& segments, std::vector<SegmentCrossing>& crossings);
+
+}  // namespace Geometry
+}  // namespace ChipCarving
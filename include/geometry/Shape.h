@@ -18,6 +18,29 @@ class ILogger;
 
 namespace Geometry {
 
+/**
+ * One straight or circular edge of a shape's boundary
+ */
+struct ShapeEdge {
+  Point2D start{};
+  Point2D end{};
+  bool isArc = false;
+  Point2D mid{};  // On the arc between start and end (arcs only)
+};
+
+/**
+ * Axis-aligned bounding box of a shape
+ */
+struct ShapeBounds {
+  Point2D min{};
+  Point2D max{};
+
+  bool contains(const Point2D& point, double tolerance = 0.0) const {
+    return point.x >= min.x - tolerance && point.x <= max.x + tolerance && point.y >= min.y - tolerance &&
+           point.y <= max.y + tolerance;
+  }
+};
+
 /**
  * Abstract base class for all chip carving shapes
  */
@@ -50,6 +73,19 @@ class Shape {
    */
   virtual void drawToSketch(Adapters::ISketch* sketch, Adapters::ILogger* logger = nullptr) const = 0;
 
+  /**
+   * Boundary edges in drawing order, for batched sketch writes
+   * @return Empty if the shape can only be drawn with drawToSketch()
+   */
+  virtual std::vector<ShapeEdge> getBoundaryEdges() const {
+    return {};
+  }
+
+  /**
+   * Tight bounding box of the shape's boundary, arcs included
+   */
+  virtual ShapeBounds getBounds() const = 0;
+
   /**
    * Check if a point is inside the shape
    * @param point The point to test
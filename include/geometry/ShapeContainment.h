@@ -0,0 +1,107 @@
+/**
+ * ShapeContainment.h
+ *
+ * Point-in-shape tests in bulk against a ShapeStore, for simulation
+ * verification, selection hit-testing and profile matching. Shape boxes are
+ * binned into a uniform grid built once per shape set; a query buckets its
+ * points by grid cell and each cell tests its points, held as separate x and
+ * y arrays, against the cell's candidate leaves and tri-arcs with the
+ * PointKernels distance and barycentric kernels. Cells are shared out among
+ * worker threads. Every point gets the answer Shape::contains gives it.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "Point2D.h"
+#include "Shape.h"
+#include "ShapeStore.h"
+
+namespace ChipCarving {
+namespace Geometry {
+
+class ShapeContainmentIndex {
+ public:
+  static constexpr size_t NO_SHAPE = static_cast<size_t>(-1);
+  static constexpr size_t MAX_GRID_CELLS = 4096;        // Upper bound on grid cells regardless of the shape count
+  static constexpr size_t PARALLEL_MIN_POINTS = 16384;  // Smaller queries run on the calling thread
+
+  ShapeContainmentIndex() = default;
+
+  // Copies what the tests need; shapes may change or go away afterwards
+  explicit ShapeContainmentIndex(const ShapeStore& shapes);
+
+  /**
+   * inside[i] = 1 if points[i] is inside any shape, else 0
+   * @param workers Worker threads (0 = hardware concurrency, 1 = calling thread only)
+   */
+  void containsBatch(const Point2D* points, size_t count, uint8_t* inside, int workers = 0) const;
+
+  /**
+   * shapes[i] = lowest import index of a shape containing points[i], NO_SHAPE if none does
+   */
+  void containingShapes(const Point2D* points, size_t count, size_t* shapes, int workers = 0) const;
+
+  size_t size() const {
+    return shapeCount_;
+  }
+  bool empty() const {
+    return shapeCount_ == 0;
+  }
+
+ private:
+  // Leaf::contains: inside the box and within the radius of both arc centers
+  struct LeafTest {
+    ShapeBounds box{};  // Grown by the tolerance
+    Point2D center1{};
+    Point2D center2{};
+    double limit = 0.0;  // Radius plus tolerance
+  };
+
+  // TriArc::contains: inside the box and all three barycentric coordinates non-negative
+  struct TriArcTest {
+    ShapeBounds box{};  // Grown by the tolerance
+    Point2D origin{};   // Third vertex
+    Point2D coefficientsA{};
+    Point2D coefficientsB{};
+    double denominator = 0.0;
+  };
+
+  struct Candidate {
+    ShapeKind kind = ShapeKind::LEAF;
+    uint32_t test = 0;  // Into leaves_ or triArcs_
+    size_t shape = 0;   // Import index
+  };
+
+  size_t cellIndex(double x, double y) const;
+
+  /**
+   * Set first[i] for the count points of one tile against its cell's candidates
+   * @param scratch Room for 2 * count doubles
+   * @param first All NO_SHAPE on entry
+   */
+  void testTile(const std::vector<Candidate>& candidates, const double* x, const double* y, size_t count,
+                double* scratch, size_t* first) const;
+
+  size_t shapeCount_ = 0;
+  std::vector<LeafTest> leaves_{};
+  std::vector<TriArcTest> triArcs_{};
+  ShapeBounds area_{};  // Around every test box; points outside it are in no shape
+  double cellWidth_ = 1.0;
+  double cellHeight_ = 1.0;
+  size_t columns_ = 0;
+  size_t rows_ = 0;
+  std::vector<std::vector<Candidate>> cells_{};  // Row-major; each list in import order
+};
+
+/**
+ * inside[i] = 1 if points[i] is inside any of shapes, for a one-off query
+ * (keep a ShapeContainmentIndex for repeated ones)
+ */
+void containsBatch(const ShapeStore& shapes, const Point2D* points, size_t count, uint8_t* inside, int workers = 0);
+
+}  // namespace Geometry
+}  // namespace ChipCarving
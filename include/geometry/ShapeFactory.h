@@ -17,9 +17,25 @@ namespace ChipCarving {
 namespace Adapters {
 class ILogger;
 }
+namespace Parsers {
+class JsonReader;
+}
+namespace Utils {
+class MonotonicArena;
+}
 
 namespace Geometry {
 
+/**
+ * Members of one shape object, read but not yet validated
+ */
+struct ShapeSpec {
+  std::string type{};  // "LEAF" or "TRI_ARC"
+  std::vector<Point2D> vertices{};
+  std::vector<double> curvatures{};  // TRI_ARC only
+  double radius = 0.0;               // LEAF only
+};
+
 /**
  * Factory class for creating Shape objects from parsed JSON data
  */
@@ -33,6 +49,50 @@ class ShapeFactory {
    */
   static std::unique_ptr<Shape> createFromJson(const std::string& shapeJson, const Adapters::ILogger* logger = nullptr);
 
+  /**
+   * Create a shape from the JSON object at the reader's cursor
+   * Consumes the whole object, so callers can stream shapes out of a larger document.
+   * @throws std::runtime_error on malformed JSON, unknown shape type or invalid data
+   */
+  static std::unique_ptr<Shape> createFromJson(Parsers::JsonReader& reader, const Adapters::ILogger* logger = nullptr);
+
+  /**
+   * Read the shape object at the reader's cursor without constructing it
+   * @throws std::runtime_error on malformed JSON, unknown shape type or missing members
+   */
+  static ShapeSpec readSpec(Parsers::JsonReader& reader);
+
+  /**
+   * Read the shape object at the reader's cursor into spec, reusing its storage
+   * Streaming callers keep one spec, so skipped shapes allocate nothing once it has grown.
+   * @throws std::runtime_error on malformed JSON, unknown shape type or missing members
+   */
+  static void readSpec(Parsers::JsonReader& reader, ShapeSpec& spec);
+
+  /**
+   * Validate and construct a shape from a spec read by readSpec()
+   * @throws std::runtime_error if the shape data is invalid
+   */
+  static std::unique_ptr<Shape> createFromSpec(const ShapeSpec& spec, const Adapters::ILogger* logger = nullptr);
+
+  /**
+   * Validate a spec and construct its shape in arena
+   * The arena only frees the memory; the caller destroys the shape before the arena goes.
+   * @throws std::runtime_error if the shape data is invalid
+   */
+  static Shape* createFromSpec(const ShapeSpec& spec, Utils::MonotonicArena& arena,
+                               const Adapters::ILogger* logger = nullptr);
+
+  /**
+   * Validate and construct many shapes on worker threads
+   * Shapes keep their spec's order. Small batches, or requestedWorkers == 1,
+   * run on the calling thread; requestedWorkers <= 0 uses every core.
+   * @throws std::runtime_error of the first invalid spec, prefixed with its index
+   */
+  static std::vector<std::unique_ptr<Shape>> createShapes(const std::vector<ShapeSpec>& specs,
+                                                          int requestedWorkers = 0,
+                                                          const Adapters::ILogger* logger = nullptr);
+
   /**
    * Create a Leaf shape from JSON data
    * @param vertices Array of 2 points (foci)
@@ -53,26 +113,6 @@ class ShapeFactory {
                                              const Adapters::ILogger* logger = nullptr);
 
  private:
-  /**
-   * Extract shape type from JSON
-   */
-  static std::string extractShapeType(const std::string& shapeJson);
-
-  /**
-   * Extract vertices array from JSON
-   */
-  static std::vector<Point2D> extractVertices(const std::string& shapeJson);
-
-  /**
-   * Extract radius from JSON (for Leaf shapes)
-   */
-  static double extractRadius(const std::string& shapeJson);
-
-  /**
-   * Extract curvatures array from JSON (for TriArc shapes)
-   */
-  static std::vector<double> extractCurvatures(const std::string& shapeJson);
-
   /**
    * Validate Leaf parameters
    */
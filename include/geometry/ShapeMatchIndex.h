@@ -0,0 +1,72 @@
+/**
+ * ShapeMatchIndex.h
+ *
+ * Hash grid over the area centroids of imported shapes, built once per import,
+ * so a selected profile finds the imported shape it was drawn from without
+ * scanning them all. Each entry keeps the shape's area and bounding box as
+ * well; a query returns only shapes agreeing on all three, which the caller
+ * then verifies exactly (AnalyticMedialAxisEngine) before trusting the match.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+#include "Point2D.h"
+#include "Shape.h"
+#include "ShapeStore.h"
+
+namespace ChipCarving {
+namespace Geometry {
+
+class ShapeMatchIndex {
+ public:
+  struct Key {
+    Point2D centroid{0, 0};  // Area centroid
+    double area = 0.0;       // Unsigned
+    ShapeBounds bounds{};
+  };
+
+  ShapeMatchIndex() = default;
+
+  /**
+   * Index every shape of shapes by its outline
+   * @param scale From shape units to query units (the plugin passes mm to cm)
+   */
+  ShapeMatchIndex(const ShapeStore& shapes, double scale);
+
+  /**
+   * Key of an outline (a closing duplicate vertex is ignored)
+   * @return false for fewer than 3 vertices or zero area
+   */
+  static bool polygonKey(const std::vector<Point2D>& polygon, Key& key);
+
+  /**
+   * Import indices of the shapes whose key matches, nearest centroid first
+   * @param tolerance Absolute slack in query units on top of the relative
+   *        slack that absorbs the difference between two tessellations
+   * @param candidates Cleared and filled; reused across queries to avoid allocation
+   */
+  void candidates(const Key& key, double tolerance, std::vector<size_t>& candidates) const;
+
+  size_t size() const {
+    return keys_.size();
+  }
+  bool empty() const {
+    return keys_.empty();
+  }
+
+ private:
+  int64_t cellOf(double value) const;
+  static uint64_t cellKey(int64_t column, int64_t row);
+
+  std::vector<Key> keys_{};  // By import index; zero area for shapes without an outline
+  double cellSize_ = 1.0;
+  std::unordered_map<uint64_t, std::vector<size_t>> cells_{};  // Import indices by centroid cell
+};
+
+}  // namespace Geometry
+}  // namespace ChipCarving
@@ -0,0 +1,76 @@
+/**
+ * ShapeOutlineBatch.h
+ *
+ * The boundary edges of a whole design gathered into one buffer for a single
+ * batched sketch write. Edge end points of all shapes are merged through a
+ * spatial hash with one cell per merge tolerance, so shapes touching at a
+ * vertex share one sketch point and every vertex is created once.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "Point2D.h"
+#include "Shape.h"
+
+namespace ChipCarving {
+namespace Geometry {
+
+// One boundary edge between two merged outline vertices
+struct OutlineEdge {
+  size_t start = 0;
+  size_t end = 0;
+  bool isArc = false;
+  Point2D mid{};  // On the arc between its ends (arcs only)
+  size_t tag = 0;   // Index into ShapeOutlineBatch::tags() of its shape's tag
+};
+
+class ShapeOutlineBatch {
+ public:
+  static constexpr double DEFAULT_MERGE_TOLERANCE = 1e-4;  // mm; imported vertices agree far closer
+
+  explicit ShapeOutlineBatch(double mergeTolerance = DEFAULT_MERGE_TOLERANCE);
+
+  /**
+   * Append a shape's boundary edges
+   * @param tag Curve tag its edges are written with (see ISketch::setCurveTag); empty keeps the sketch's own
+   * @return false if the shape has none (it must be drawn with drawToSketch)
+   */
+  bool addShape(const Shape& shape, const std::string& tag = "");
+
+  const std::vector<Point2D>& vertices() const {
+    return vertices_;
+  }
+  const std::vector<OutlineEdge>& edges() const {
+    return edges_;
+  }
+
+  // Tags of the added shapes in order, each run of one tag stored once; tags()[0] is the empty tag
+  const std::vector<std::string>& tags() const {
+    return tags_;
+  }
+
+  // Edge end points that reused a vertex of another edge instead of adding one
+  size_t sharedVertexCount() const {
+    return sharedVertices_;
+  }
+
+ private:
+  size_t vertexIndex(const Point2D& point);
+
+  double tolerance_;
+  double inverseCell_;
+  std::vector<Point2D> vertices_{};
+  std::vector<OutlineEdge> edges_{};
+  std::vector<std::string> tags_{std::string()};
+  std::unordered_map<uint64_t, std::vector<size_t>> cells_{};
+  size_t sharedVertices_ = 0;
+};
+
+}  // namespace Geometry
+}  // namespace ChipCarving
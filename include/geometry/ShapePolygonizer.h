@@ -0,0 +1,50 @@
+/**
+ * ShapePolygonizer.h
+ *
+ * Polygon approximation of imported shapes for pipelines that run without
+ * Fusion. The plugin gets its profile polygons from Fusion's stroke
+ * tessellation; headless tools build the same kind of polygon here: points
+ * along each boundary arc, implicitly closed, no duplicate end vertex.
+ */
+
+#pragma once
+
+#include <vector>
+
+#include "Leaf.h"
+#include "Point2D.h"
+#include "Shape.h"
+#include "TriArc.h"
+
+namespace ChipCarving {
+namespace Geometry {
+
+/**
+ * Number of chords needed to keep an arc within maxError of its polygon
+ * @param radius Arc radius
+ * @param sweep Absolute arc sweep in radians
+ * @param maxError Maximum chord-to-arc distance (same units as radius)
+ * @return Segment count, at least 2
+ */
+int arcSegmentCount(double radius, double sweep, double maxError);
+
+/**
+ * Polygonize a leaf: focus1 -> focus2 along the first arc, then back along the second
+ */
+std::vector<Point2D> polygonizeLeaf(const Leaf& leaf, double maxError);
+
+/**
+ * Polygonize a TriArc: each edge from its start vertex, straight edges as a single vertex
+ */
+std::vector<Point2D> polygonizeTriArc(const TriArc& triArc, double maxError);
+
+/**
+ * Polygonize any supported shape
+ * @param shape Leaf or TriArc
+ * @param maxError Maximum chord-to-arc distance (shape units)
+ * @return Polygon vertices, or an empty vector for unsupported shape types
+ */
+std::vector<Point2D> polygonizeShape(const Shape& shape, double maxError);
+
+}  // namespace Geometry
+}  // namespace ChipCarving
@@ -0,0 +1,105 @@
+/**
+ * ShapeStore.h
+ *
+ * Imported shapes held by value in one contiguous array per type, Leaf and
+ * TriArc records, with a handle per shape in import order. Batch passes walk
+ * each array in turn with the concrete (final) type, so calls resolve
+ * without virtual dispatch and without chasing a pointer per shape; at(i)
+ * is a Shape view of the record for code written against the interface.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "Leaf.h"
+#include "Shape.h"
+#include "TriArc.h"
+
+namespace ChipCarving {
+namespace Geometry {
+
+enum class ShapeKind : uint8_t {
+  LEAF,
+  TRI_ARC,
+};
+
+struct ShapeHandle {
+  ShapeKind kind = ShapeKind::LEAF;
+  uint32_t index = 0;  // Into the array of its kind
+};
+
+class ShapeStore {
+ public:
+  /**
+   * Copy shape into the array of its type
+   * @return false for a shape of any other type, which is not stored
+   */
+  bool add(const Shape& shape);
+  void add(const Leaf& leaf);
+  void add(const TriArc& triArc);
+
+  void clear();
+
+  size_t size() const {
+    return handles_.size();
+  }
+  bool empty() const {
+    return handles_.empty();
+  }
+  ShapeHandle handle(size_t index) const {
+    return handles_[index];
+  }
+
+  /**
+   * Shape view of the index-th shape in import order; valid until the next add() or clear()
+   */
+  const Shape& at(size_t index) const {
+    ShapeHandle h = handles_[index];
+    return h.kind == ShapeKind::LEAF ? static_cast<const Shape&>(leaves_[h.index])
+                                     : static_cast<const Shape&>(triArcs_[h.index]);
+  }
+
+  const std::vector<Leaf>& leaves() const {
+    return leaves_;
+  }
+  const std::vector<TriArc>& triArcs() const {
+    return triArcs_;
+  }
+
+  /**
+   * Call visit(shape, importIndex) for every shape, all leaves then all
+   * tri-arcs, with shape of its concrete type
+   */
+  template <typename Visit>
+  void forEachByType(Visit&& visit) const {
+    for (size_t i = 0; i < leaves_.size(); ++i) {
+      visit(leaves_[i], leafOrder_[i]);
+    }
+    for (size_t i = 0; i < triArcs_.size(); ++i) {
+      visit(triArcs_[i], triArcOrder_[i]);
+    }
+  }
+
+  /**
+   * Box around every shape (all zero when empty)
+   */
+  ShapeBounds bounds() const;
+
+  /**
+   * Defining vertices of all shapes, as getVertices() would count them
+   */
+  size_t vertexCount() const;
+
+ private:
+  std::vector<Leaf> leaves_{};
+  std::vector<TriArc> triArcs_{};
+  std::vector<size_t> leafOrder_{};    // Import index of each leaf
+  std::vector<size_t> triArcOrder_{};  // Import index of each tri-arc
+  std::vector<ShapeHandle> handles_{};
+};
+
+}  // namespace Geometry
+}  // namespace ChipCarving
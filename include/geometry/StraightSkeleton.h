@@ -0,0 +1,45 @@
+/**
+ * StraightSkeleton.h
+ *
+ * Straight skeleton of purely polygonal profiles (stars, straight-stroke
+ * lettering). Every edge moves inward at unit speed and the skeleton is the
+ * trace of the wavefront's vertices, so each polygon corner, reflex corners
+ * included, starts an arc and a V-carve reaches it exactly. The clearance of
+ * a skeleton point is the time the wavefront reached it. There is no
+ * threshold filtering or spur clean-up: a polygon has no tessellation spikes.
+ *
+ * The wavefront is simulated event by event with a brute-force search for the
+ * next edge or split event, O(n^2) per event, for profiles of a few hundred
+ * vertices.
+ */
+
+#pragma once
+
+#include <vector>
+
+#include "MedialAxisProcessor.h"
+#include "Point2D.h"
+
+namespace ChipCarving {
+namespace Geometry {
+
+constexpr double STRAIGHT_EDGE_MIN_TURN = 10.0 * 3.14159265358979323846 / 180.0;
+
+/**
+ * Whether a polygon is made of straight edges: after dropping collinear
+ * vertices, every vertex turns by at least minTurn (radians), whereas a
+ * tessellated curve turns a little at every vertex
+ */
+bool polygonHasOnlyStraightEdges(const std::vector<Point2D>& polygon, double minTurn = STRAIGHT_EDGE_MIN_TURN);
+
+/**
+ * Straight skeleton of a simple polygon without holes (either winding)
+ * @param results Output chains, graph, statistics and transform, as
+ *                MedialAxisProcessor fills them
+ * @return false if the polygon is degenerate or the wavefront met a case it
+ *         does not resolve (results.errorMessage says which)
+ */
+bool computeStraightSkeleton(const std::vector<Point2D>& polygon, MedialAxisResults& results);
+
+}  // namespace Geometry
+}  // namespace ChipCarving
@@ -0,0 +1,70 @@
+/**
+ * SurfaceBoundsIndex.h
+ *
+ * Uniform XY grid over the bounding boxes of the bodies a downward surface ray
+ * may hit. A query returns only the boxes whose XY projection contains the
+ * point, highest top first, so a ray cast can stop as soon as it has a hit at
+ * or above the top of every box still to be checked.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <vector>
+
+namespace ChipCarving {
+namespace Geometry {
+
+/**
+ * Candidate boxes for a vertical ray at an XY location
+ * Units are whatever the caller uses (the plugin uses cm).
+ */
+class SurfaceBoundsIndex {
+ public:
+  // Upper bound on grid cells regardless of the box count
+  static constexpr size_t MAX_GRID_CELLS = 4096;
+
+  struct Box {
+    double minX = 0.0;
+    double minY = 0.0;
+    double maxX = 0.0;
+    double maxY = 0.0;
+    double maxZ = 0.0;
+  };
+
+  SurfaceBoundsIndex() = default;
+
+  /**
+   * Index boxes; ids returned by candidates() are positions in this vector
+   * @param margin Grown onto every box in XY so points on an edge still match
+   */
+  SurfaceBoundsIndex(const std::vector<Box>& boxes, double margin);
+
+  /**
+   * Ids of the boxes containing (x, y), in descending maxZ order
+   * @param candidates Cleared and filled; reused across queries to avoid allocation
+   */
+  void candidates(double x, double y, std::vector<size_t>& candidates) const;
+
+  double maxZ(size_t id) const {
+    return boxes_[id].maxZ;
+  }
+  size_t size() const {
+    return boxes_.size();
+  }
+
+ private:
+  size_t cellIndex(double x, double y) const;
+
+  std::vector<Box> boxes_{};  // Grown by the margin
+  double originX_ = 0.0;
+  double originY_ = 0.0;
+  double cellWidth_ = 1.0;
+  double cellHeight_ = 1.0;
+  size_t columns_ = 0;
+  size_t rows_ = 0;
+  std::vector<std::vector<size_t>> cells_{};  // Row-major; each list in descending maxZ order
+};
+
+}  // namespace Geometry
+}  // namespace ChipCarving
@@ -0,0 +1,82 @@
+/**
+ * SurfaceHeightMemo.h
+ *
+ * Surface Z results keyed by XY quantized to a fixed step, so a generation run
+ * never sends the same location to the surface query twice. Misses (no surface
+ * under the point) are remembered as NaN like any other result.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <unordered_map>
+#include <vector>
+
+#include "Point2D.h"
+
+namespace ChipCarving {
+namespace Geometry {
+
+class SurfaceHeightMemo {
+ public:
+  // 1 µm in Fusion's internal unit (cm)
+  static constexpr double DEFAULT_QUANTUM = 1.0e-4;
+
+  explicit SurfaceHeightMemo(double quantum = DEFAULT_QUANTUM);
+
+  /**
+   * Height stored for the quantization cell containing point
+   * @return false if the cell has not been queried yet
+   */
+  bool lookup(const Point2D& point, double& z) const;
+
+  // Record the height (or NaN) found for point's cell
+  void store(const Point2D& point, double z);
+
+  /**
+   * Heights for every point, sending query one batch of the distinct cells not
+   * seen before (repeats within points are queried once) and remembering them
+   * @param query Surface Z for each location, in order; missing entries count as NaN
+   */
+  std::vector<double> resolve(const std::vector<Point2D>& points,
+                              const std::function<std::vector<double>(const std::vector<Point2D>&)>& query);
+
+  size_t size() const {
+    return heights_.size();
+  }
+  size_t hitCount() const {
+    return hits_;
+  }
+  void clear() {
+    heights_.clear();
+    hits_ = 0;
+  }
+
+ private:
+  struct Key {
+    int64_t x;
+    int64_t y;
+
+    bool operator==(const Key& other) const {
+      return x == other.x && y == other.y;
+    }
+  };
+
+  struct KeyHash {
+    size_t operator()(const Key& key) const {
+      return static_cast<size_t>(static_cast<uint64_t>(key.x) * 0x9E3779B97F4A7C15ULL ^
+                                 static_cast<uint64_t>(key.y) * 0xC2B2AE3D27D4EB4FULL);
+    }
+  };
+
+  Key keyOf(const Point2D& point) const;
+
+  double inverseQuantum_ = 1.0 / DEFAULT_QUANTUM;
+  std::unordered_map<Key, double, KeyHash> heights_{};
+  mutable size_t hits_ = 0;
+};
+
+}  // namespace Geometry
+}  // namespace ChipCarving
@@ -0,0 +1,99 @@
+/**
+ * SurfaceHeightfield.h
+ *
+ * Regular XY grid of surface heights for surface-projected V-carve. The target
+ * surface is sampled once at every grid node and V-carve point heights are
+ * bilinearly interpolated, so projection cost no longer depends on the V-carve
+ * sampling distance.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <vector>
+
+#include "Point2D.h"
+
+namespace ChipCarving {
+namespace Geometry {
+
+/**
+ * Row-major height grid over an axis-aligned rectangle
+ * Units are whatever the caller uses for XY and Z (the plugin uses cm).
+ * Nodes without a surface hold NaN; interpolation in any cell touching such a
+ * node returns NaN so callers can fall back to a direct query.
+ */
+class SurfaceHeightfield {
+ public:
+  // Upper bound on grid nodes; coarser spacing is used for very large regions
+  static constexpr size_t MAX_GRID_NODES = 1000000;
+
+  SurfaceHeightfield() = default;
+
+  /**
+   * Lay out a grid covering [minCorner, maxCorner]
+   * @param spacing Requested node spacing (increased if the grid would exceed MAX_GRID_NODES)
+   */
+  SurfaceHeightfield(const Point2D& minCorner, const Point2D& maxCorner, double spacing);
+
+  /**
+   * Lay out exactly columns x rows nodes from origin, for grids that already
+   * exist (tiles of a scanned heightmap); no node budget applies
+   */
+  SurfaceHeightfield(const Point2D& origin, double spacing, size_t columns, size_t rows);
+
+  /**
+   * XY location of every grid node, row-major (x fastest), for a batched surface query
+   */
+  std::vector<Point2D> getNodePositions() const;
+
+  /**
+   * Set node heights in getNodePositions() order
+   * @return true if the size matches the grid
+   */
+  bool setHeights(std::vector<double> heights);
+
+  /**
+   * Bilinear height at (x, y); NaN outside the grid or next to a node without a surface
+   */
+  double sample(double x, double y) const;
+
+  /**
+   * Bilinear height at (x, y) with the analytic gradient of the same cell
+   * @param dzdx, dzdy Output slope of the interpolated surface (NaN wherever the height is)
+   */
+  double sample(double x, double y, double& dzdx, double& dzdy) const;
+
+  bool isValid() const {
+    return columns_ > 0 && rows_ > 0 && heights_.size() == columns_ * rows_;
+  }
+  size_t getColumns() const {
+    return columns_;
+  }
+  size_t getRows() const {
+    return rows_;
+  }
+  double getSpacing() const {
+    return spacing_;
+  }
+
+ private:
+  Point2D origin_{};
+  double spacing_ = 0.0;
+  size_t columns_ = 0;
+  size_t rows_ = 0;
+  std::vector<double> heights_{};
+};
+
+// Largest depth scale applied on slopes, 1 / cos(60°); steeper walls keep this
+constexpr double MAX_SLOPE_DEPTH_SCALE = 2.0;
+
+/**
+ * Vertical depth scale, 1 / cos(tilt), that makes a cut into a surface of this
+ * gradient as deep along the surface normal as the vertical depth on the flat;
+ * capped at MAX_SLOPE_DEPTH_SCALE, 1 for a NaN gradient
+ */
+double slopeDepthScale(double dzdx, double dzdy);
+
+}  // namespace Geometry
+}  // namespace ChipCarving
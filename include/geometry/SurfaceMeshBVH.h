@@ -0,0 +1,90 @@
+/**
+ * SurfaceMeshBVH.h
+ *
+ * Bounding volume hierarchy over a triangle mesh for downward surface rays,
+ * so scanned blanks imported as mesh bodies can be projected onto without
+ * testing every triangle per ray. Rays are vertical, so the surface area
+ * heuristic weighs each box by its XY area, the chance a ray passes through
+ * it, and every node keeps its top Z so a query stops descending once its hit
+ * is at or above everything left.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "Point2D.h"
+
+namespace ChipCarving {
+namespace Geometry {
+
+/**
+ * Topmost mesh point under an XY location
+ * Units are whatever the mesh uses (the plugin uses cm). Built once, the
+ * hierarchy is read-only, so any number of threads can query it.
+ */
+class SurfaceMeshBVH {
+ public:
+  static constexpr size_t MAX_LEAF_TRIANGLES = 4;
+  static constexpr int SAH_BINS = 16;
+
+  SurfaceMeshBVH() = default;
+
+  /**
+   * Build over a mesh in Fusion's TriangleMesh layout
+   * Triangles with an index out of range, a NaN coordinate or no XY area (they
+   * are parallel to a vertical ray) are left out
+   * @param coords x, y, z triples, one per node
+   * @param indices Three node indices per triangle
+   */
+  SurfaceMeshBVH(const std::vector<double>& coords, const std::vector<int>& indices);
+
+  // Topmost mesh Z under (x, y); NaN where the mesh does not cover it
+  double topZ(double x, double y) const;
+
+  /**
+   * Raise every height to the mesh's topmost Z under its point, in parallel
+   * NaN heights count as no hit yet, so several meshes can be applied in turn
+   * @param heights One per point, updated in place
+   * @param workers Threads to use (0 = hardware concurrency)
+   */
+  void raiseTopZ(const std::vector<Point2D>& points, std::vector<double>& heights, int workers = 0) const;
+
+  size_t triangleCount() const {
+    return triangles_.size();
+  }
+  size_t nodeCount() const {
+    return nodes_.size();
+  }
+  bool empty() const {
+    return triangles_.empty();
+  }
+
+ private:
+  struct Triangle {
+    double ax, ay, az;
+    double bx, by, bz;
+    double cx, cy, cz;
+  };
+
+  // Leaves hold count triangles from first; an inner node's left child follows it and its right child is at first
+  struct Node {
+    double minX, minY, maxX, maxY, maxZ;
+    uint32_t first;
+    uint32_t count;
+  };
+
+  // Node over triangles_[begin, end), split by binned SAH; returns its index
+  uint32_t build(std::vector<double>& centroids, size_t begin, size_t end);
+
+  // Raise bestZ to the triangle's Z at (x, y) if the vertical line there passes through it
+  static void intersect(const Triangle& triangle, double x, double y, double& bestZ, bool& found);
+
+  std::vector<Triangle> triangles_{};
+  std::vector<Node> nodes_{};
+};
+
+}  // namespace Geometry
+}  // namespace ChipCarving
@@ -0,0 +1,106 @@
+/**
+ * ToolModel.h
+ *
+ * Cut depth from medial axis clearance for each cutter family. The tool
+ * touches both walls when its profile is as wide as the clearance radius at
+ * the sketch plane, so the depth is the height of that profile radius above
+ * the tip. Each family has its own kernel, and calculateToolDepths picks one
+ * per batch: the loop over points is specialized to a single straight-line
+ * kernel the compiler can vectorize.
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <limits>
+
+#include "adapters/MedialAxisParameters.h"
+
+namespace ChipCarving {
+namespace Geometry {
+
+/**
+ * Profile constants of one cutter, derived once from the tool parameters
+ */
+struct ToolModel {
+  Adapters::ToolShape shape = Adapters::ToolShape::V_BIT;
+  double cotHalfAngle = 1.0;  // Depth per unit of radius along the cone
+  double tipRadius = 0.0;     // Flat or ball tip radius (mm)
+  double flankRadius = 0.0;   // Tapered ball: profile radius where the cone leaves the ball (mm)
+  double flankDepth = 0.0;    // Tapered ball: height of that point above the tip (mm)
+  double maxRadius = std::numeric_limits<double>::max();  // Widest clearance the cutter covers (mm)
+  double maxDepth = std::numeric_limits<double>::max();
+  bool valid = false;  // False for an angle outside (0, 180) or a tip wider than the tool
+
+  /**
+   * Model of the cutter in params: toolShape, toolAngle, toolTipDiameter,
+   * toolDiameter (the clearance cap; 0 = no cap) and maxVCarveDepth
+   */
+  static ToolModel fromParameters(const Adapters::MedialAxisParameters& params);
+
+  // Pointed V-bit of toolAngle degrees with no diameter cap
+  static ToolModel vBit(double toolAngle, double maxDepth);
+
+  // Depth (mm) for one clearance radius (mm)
+  double depth(double clearanceRadius) const;
+
+  /**
+   * Inverse of depth(): the clearance radius (mm) cut at depth (mm), capped at
+   * maxRadius. At maxDepth it is the widest clearance the cutter reaches;
+   * wider regions are left for flat-bottom clearing.
+   */
+  double radiusAtDepth(double depth) const;
+};
+
+template <Adapters::ToolShape Shape>
+struct ToolDepthKernel;
+
+template <>
+struct ToolDepthKernel<Adapters::ToolShape::V_BIT> {
+  static double depth(const ToolModel& tool, double radius) {
+    return radius * tool.cotHalfAngle;
+  }
+};
+
+// The flat is as wide as the tip, so a narrower clearance is not cut at all
+template <>
+struct ToolDepthKernel<Adapters::ToolShape::FLAT_TIP_V_BIT> {
+  static double depth(const ToolModel& tool, double radius) {
+    return std::max(0.0, radius - tool.tipRadius) * tool.cotHalfAngle;
+  }
+};
+
+// Up the ball to its tangent with the cone, then up the cone; both sides are computed and one is selected
+template <>
+struct ToolDepthKernel<Adapters::ToolShape::TAPERED_BALL> {
+  static double depth(const ToolModel& tool, double radius) {
+    double onBall = tool.tipRadius - std::sqrt(std::max(0.0, tool.tipRadius * tool.tipRadius - radius * radius));
+    double onCone = tool.flankDepth + (radius - tool.flankRadius) * tool.cotHalfAngle;
+    return radius < tool.flankRadius ? onBall : onCone;
+  }
+};
+
+/**
+ * Depths for a contiguous run of clearance radii with one tool family's kernel
+ * Radii are capped at the tool radius and depths at maxDepth; non-positive
+ * radii carve nothing
+ * @param depths Output, count depths (mm); may alias clearanceRadii
+ */
+template <Adapters::ToolShape Shape>
+void calculateToolDepths(const ToolModel& tool, const double* clearanceRadii, size_t count, double* depths) {
+  for (size_t i = 0; i < count; ++i) {
+    double radius = std::min(clearanceRadii[i], tool.maxRadius);
+    double depth = std::min(ToolDepthKernel<Shape>::depth(tool, radius), tool.maxDepth);
+    depths[i] = radius > 0.0 ? depth : 0.0;
+  }
+}
+
+/**
+ * Same, dispatching once on tool.shape; an invalid tool carves nothing
+ */
+void calculateToolDepths(const ToolModel& tool, const double* clearanceRadii, size_t count, double* depths);
+
+}  // namespace Geometry
+}  // namespace ChipCarving
@@ -0,0 +1,87 @@
+/**
+ * ToolpathSVGExport.h
+ *
+ * Offline review of a Generate Paths run: polygonized profiles, medial axis
+ * chains colored by clearance and V-carve paths colored by depth, streamed
+ * to an SVG file profile by profile through SVGGenerator.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "MedialAxisChains.h"
+#include "Point2D.h"
+#include "SVGGenerator.h"
+#include "Shape.h"
+#include "VCarvePath.h"
+
+namespace ChipCarving {
+namespace Geometry {
+
+struct ToolpathSVGStyle {
+  double canvasWidth = 1600.0;  // SVG units; the height follows the bounds' aspect ratio
+  double maxClearance = 1.0;    // Clearance drawn in the deepest color (mm)
+  double maxDepth = 1.0;        // Depth drawn in the deepest color (mm)
+  int colorLevels = 16;         // Color steps; runs of equal color share one polyline
+};
+
+/**
+ * "#rrggbb" on a blue (0) to red (1) hue ramp; fraction is clamped to [0, 1]
+ */
+std::string toolpathRampColor(double fraction);
+
+class ToolpathSVGExporter {
+ public:
+  /**
+   * @param bounds Everything that will be drawn (mm)
+   */
+  ToolpathSVGExporter(const ShapeBounds& bounds, const ToolpathSVGStyle& style);
+
+  /**
+   * Start streaming to path
+   * @return false if the file could not be opened
+   */
+  bool open(const std::string& path);
+
+  /**
+   * Closed loop of a profile; unitScale converts its coordinates to mm
+   */
+  void addOutline(const std::vector<Point2D>& loop, double unitScale = 1.0);
+
+  /**
+   * Medial axis chains; unitScale converts coordinates and clearances to mm
+   */
+  void addMedialAxis(const MedialAxisChains& chains, double unitScale = 1.0);
+
+  /**
+   * V-carve paths (mm)
+   */
+  void addToolpaths(const VCarveResults& results);
+
+  /**
+   * Close the document
+   * @return false if not open or a write failed
+   */
+  bool finish();
+
+  size_t polylineCount() const {
+    return polylineCount_;
+  }
+
+ private:
+  // Split values along points into runs of one color level, one polyline each
+  void addColoredRuns(const std::vector<Point2D>& points, const std::vector<double>& values, double maxValue,
+                      double strokeWidth);
+  int colorLevel(double value, double maxValue) const;
+
+  ToolpathSVGStyle style_{};
+  std::unique_ptr<SVGGenerator> svg_{};
+  size_t polylineCount_ = 0;
+};
+
+}  // namespace Geometry
+}  // namespace ChipCarving
@@ -39,10 +39,13 @@ struct ArcParams {
  * - Bulge factor range: [-0.99, -0.01]
  * - Bulge factor = (sagitta × 2) / chord_length
  */
-class TriArc : public Shape {
+class TriArc final : public Shape {
  private:
   std::array<Point2D, 3> vertices_{};
   std::array<double, 3> bulgeFactors_{};
+  std::array<ArcParams, 3> arcParams_{};  // Derived from the vertices and bulges above
+  bool validBulgeFactors_ = false;
+  ShapeBounds bounds_{};  // Concave arcs stay inside the vertices' box
 
   static constexpr double DEFAULT_BULGE = -0.125;
   static constexpr double MIN_BULGE = -0.2;
@@ -50,6 +53,10 @@ class TriArc : public Shape {
   static constexpr double EPSILON = 1e-9;
 
  public:
+  // contains() tests the vertex triangle: points within the tolerance of its box, then barycentric coordinates
+  static constexpr double BOUNDS_TOLERANCE = 1e-9;        // Vertices stay inside despite rounding
+  static constexpr double DEGENERATE_DENOMINATOR = 1e-10;  // Collinear vertices contain nothing
+
   /**
    * Create TriArc with three vertices and optional bulge factors
    * @param v1 First vertex
@@ -64,6 +71,10 @@ class TriArc : public Shape {
   std::vector<Point2D> getVertices() const override;
   // NOTE: getPolygonVertices() removed - polygonization now handled by Fusion strokes
   void drawToSketch(Adapters::ISketch* sketch, Adapters::ILogger* logger) const override;
+  std::vector<ShapeEdge> getBoundaryEdges() const override;  // Edge i runs from vertex i to vertex i + 1
+  ShapeBounds getBounds() const override {
+    return bounds_;
+  }
   bool contains(const Point2D& point) const override;
   Point2D getCentroid() const override;
 
@@ -81,9 +92,12 @@ class TriArc : public Shape {
 
   /**
    * Get arc parameters for each edge (for Fusion 360 drawing)
+   * Computed once at construction and whenever the bulge factors change
    * @return Array of 3 ArcParams, one for each edge
    */
-  std::array<ArcParams, 3> getArcParameters() const;
+  const std::array<ArcParams, 3>& getArcParameters() const {
+    return arcParams_;
+  }
 
   /**
    * Get arc parameters for specific edge
@@ -126,7 +140,7 @@ class TriArc : public Shape {
   bool hasValidBulgeFactors() const;
 
   /**
-   * Clamp bulge factors to valid range [-0.99, -0.01]
+   * Clamp bulge factors to valid range [-0.99, -0.01] and refresh the arc parameters
    */
   void clampBulgeFactors();
 
@@ -143,6 +157,9 @@ class TriArc : public Shape {
   double getChordLength(int arcIndex) const;
 
  private:
+  // Arc parameters of one edge from the current vertices and bulge factors
+  ArcParams computeArcParameters(int arcIndex) const;
+
   /**
    * Calculate arc center for specific edge using bulge factor
    * @param p1 Start point of edge
@@ -7,12 +7,14 @@
 
 #pragma once
 
+#include <cstddef>
 #include <functional>
 
 #include "MedialAxisProcessor.h"
 #include "MedialAxisUtilities.h"
 #include "VCarvePath.h"
 #include "adapters/IFusionInterface.h"
+#include "utils/UnitConversion.h"
 
 namespace ChipCarving {
 namespace Geometry {
@@ -43,21 +45,29 @@ class VCarveCalculator {
    * Generate V-carve toolpaths from sampled medial paths
    * @param sampledPaths Pre-sampled medial axis paths
    * @param params Tool and V-carve parameters
+   * @param graph Graph of the sampled chains; paths then merge where their chains meet
+   *              instead of by endpoint distance
+   * @param clearingLoops Clearing offset loops of the same medial axis results, cut as clearingPaths()
    * @return V-carve toolpaths ready for 3D sketch generation
    */
   VCarveResults generateVCarvePaths(const std::vector<SampledMedialPath>& sampledPaths,
-                                    const Adapters::MedialAxisParameters& params);
+                                    const Adapters::MedialAxisParameters& params,
+                                    const MedialAxisGraph* graph = nullptr,
+                                    const std::vector<ClearingLoop>* clearingLoops = nullptr);
 
   /**
-   * Function type for querying surface Z at XY location
-   * @param x X coordinate in mm
-   * @param y Y coordinate in mm
+   * Function type for querying surface Z at XY location, in the calculator's
+   * millimeters; a Fusion-backed query converts to and from cm itself
+   * @param x X coordinate
+   * @param y Y coordinate
    * @return Z coordinate at surface, or NaN if no surface
    */
-  using SurfaceQueryFunction = std::function<double(double x, double y)>;
+  using SurfaceQueryFunction = std::function<Utils::Millimeters(Utils::Millimeters x, Utils::Millimeters y)>;
 
   /**
    * Generate V-carve toolpaths with surface projection
+   * Points over the surface are marked projected with their surface Z, so
+   * VCarvePoint::sketchRelativeZ() yields the final sketch-relative Z directly
    * @param sampledPaths Pre-sampled medial axis paths
    * @param params Tool and V-carve parameters
    * @param sketchPlaneZ Z position of sketch plane in mm
@@ -69,7 +79,8 @@ class VCarveCalculator {
                                                const SurfaceQueryFunction& surfaceQuery);
 
   /**
-   * Calculate V-carve depth for a given clearance radius and tool
+   * Calculate V-carve depth for a given clearance radius and a pointed V-bit
+   * with no diameter cap; toolpaths use the ToolModel of their parameters
    * @param clearanceRadius Clearance radius from medial axis (mm)
    * @param toolAngle V-bit angle in degrees
    * @param maxDepth Maximum allowed depth (safety limit)
@@ -77,6 +88,93 @@ class VCarveCalculator {
    */
   static double calculateVCarveDepth(double clearanceRadius, double toolAngle, double maxDepth);
 
+  /**
+   * Batch form of calculateVCarveDepth over a contiguous run of clearance radii,
+   * with the V-bit kernel of calculateToolDepths
+   * @param clearanceRadii count radii (mm)
+   * @param depths Output, count depths (mm); may alias clearanceRadii
+   */
+  static void calculateVCarveDepths(const double* clearanceRadii, size_t count, double toolAngle, double maxDepth,
+                                    double* depths);
+
+  /**
+   * Deepen the projected points of a path on sloped surfaces, so the depth is
+   * measured along the surface normal instead of vertically (see slopeDepthScale)
+   * @param gradients Surface dz/dx, dz/dy per point; NaN entries fall back to the slope
+   *                  between the projected neighbours along the path, which misses any
+   *                  slope across it
+   * @param maxDepth Scaled depths are limited to this (mm), but never made shallower
+   */
+  static void compensateSurfaceSlope(VCarvePath& path, const Point2D* gradients, double maxDepth);
+
+  /**
+   * Apply path optimization and merging
+   * Paths that all carry graph nodes merge where they share a node; otherwise
+   * endpoints are bucketed in a grid so merging runs in near-linear time
+   * @param paths Input paths to optimize (consumed)
+   * @param params Parameters for optimization (pathMergeTolerance)
+   * @return Optimized paths
+   */
+  std::vector<VCarvePath> optimizePaths(std::vector<VCarvePath> paths, const Adapters::MedialAxisParameters& params);
+
+  // Depth difference (mm) within which neighbouring points count as one plateau for compressPlateaus
+  static constexpr double PLATEAU_DEPTH_TOLERANCE = 1e-6;
+
+  /**
+   * Collapse runs of constant depth (points clamped at maxVCarveDepth, or
+   * straight constant-clearance stretches) to the points the line between
+   * their kept neighbours cannot cover. Path ends and forced samples stay.
+   * @param path Converted from sampledPath, one point per sample
+   * @param mergeTolerance Max XY deviation of a merged point (mm, 0 = off)
+   * @return Points removed
+   */
+  static size_t compressPlateaus(VCarvePath& path, const SampledMedialPath& sampledPath, double mergeTolerance);
+
+  // Depth range (mm) within which a chain counts as flat and may be cut twice
+  static constexpr double RETRACE_DEPTH_TOLERANCE = 0.001;
+
+  /**
+   * Cover every medial graph chain in as few continuous paths as possible: an
+   * Euler trail decomposition of each connected graph, where a flat chain
+   * between two odd nodes is cut a second time rather than lifting the tool.
+   * A graph with 2k odd nodes left over is cut in k paths (one if none).
+   * @param paths One path per chain, each carrying its graph nodes (consumed);
+   *              without nodes this falls back to optimizePaths
+   * @param params Parameters for the optimizePaths fallback
+   * @return Continuous paths, each starting at a graph node
+   */
+  std::vector<VCarvePath> planContinuousPaths(std::vector<VCarvePath> paths,
+                                              const Adapters::MedialAxisParameters& params);
+
+  /**
+   * Depth passes of one cut for step-down cutting: pass k cuts no deeper than
+   * k * stepDown and the last is path itself. Within a plateau (a run of
+   * points clamped to the pass depth) points that lie on the line between
+   * their kept neighbours are merged away.
+   * @param alternate Reverse every other pass so each starts where the one
+   *                  before ended; the last pass keeps path's direction
+   * @param mergeTolerance Max XY deviation of a merged plateau point (mm)
+   * @return One path if path is no deeper than stepDown
+   */
+  static std::vector<VCarvePath> stepDownPasses(const VCarvePath& path, double stepDown, bool alternate,
+                                                double mergeTolerance);
+
+  /**
+   * Clearing offsets for params.clearingStepover, to give the medial axis
+   * processor: the first loop where the cutter stops reaching the boundary
+   * at maxVCarveDepth, in Fusion units (cm) like the medial axis results
+   * @return Disabled offsets if clearingStepover is 0 or the tool is invalid
+   */
+  static ClearingOffsets clearingOffsets(const Adapters::MedialAxisParameters& params);
+
+  /**
+   * Flat-bottom clearing paths: each loop (cm) closed on its first point, at
+   * the depth the V-carve bottoms out at (maxVCarveDepth unless the tool
+   * diameter caps it first)
+   */
+  static std::vector<VCarvePath> clearingPaths(const std::vector<ClearingLoop>& loops,
+                                               const Adapters::MedialAxisParameters& params);
+
  private:
   /**
    * Convert a single sampled medial path to V-carve path
@@ -86,6 +184,10 @@ class VCarveCalculator {
    */
   VCarvePath convertSampledPath(const SampledMedialPath& sampledPath, const Adapters::MedialAxisParameters& params);
 
+  // Depth for every point of sampledPath, computed with the ToolModel of params
+  static std::vector<double> sampledPathDepths(const SampledMedialPath& sampledPath,
+                                               const Adapters::MedialAxisParameters& params);
+
   /**
    * Validate tool parameters for V-carve generation
    * @param params Parameters to validate
@@ -94,16 +196,25 @@ class VCarveCalculator {
   bool validateParameters(const Adapters::MedialAxisParameters& params);
 
   /**
-   * Apply path optimization and merging
-   * @param paths Input paths to optimize
-   * @param params Parameters for optimization
-   * @return Optimized paths
+   * Reorder (and optionally reverse) paths to minimize rapid travel between cuts
+   * Nearest-neighbor tour refined with 2-opt; records rapid distance before and after
+   * @param results Results whose paths are reordered in place
+   * @param params Parameters (orderToolpaths, allowPathReversal)
    */
-  std::vector<VCarvePath> optimizePaths(const std::vector<VCarvePath>& paths,
-                                        const Adapters::MedialAxisParameters& params);
+  void orderPaths(VCarveResults& results, const Adapters::MedialAxisParameters& params);
+
+  /**
+   * Replace each ordered path by its step-down passes (params.stepDownDepth,
+   * 0 = off), so every chip is finished before the tool moves to the next
+   */
+  void applyStepDown(VCarveResults& results, const Adapters::MedialAxisParameters& params);
+
+  // Append the clearingPaths() of loops, after merging so they stay separate paths but before ordering
+  void addClearingPaths(VCarveResults& results, const std::vector<ClearingLoop>& loops,
+                        const Adapters::MedialAxisParameters& params);
 
   /**
-   * Check if two path endpoints can be connected
+   * Check if two path endpoints can be connected (by shared node when both carry graph nodes)
    * @param path1 First path
    * @param path2 Second path
    * @param tolerance Connection tolerance in mm
@@ -115,9 +226,19 @@ class VCarveCalculator {
    * Merge two connectable paths into one
    * @param path1 First path
    * @param path2 Second path
-   * @return Merged path
+   * @param tolerance Connection tolerance in mm
+   * @return Merged path (empty if the paths do not connect)
+   */
+  VCarvePath mergePaths(const VCarvePath& path1, const VCarvePath& path2, double tolerance = 0.1);
+
+  /**
+   * Append a connectable path onto target in place, moving its points
+   * @param target Path that receives the merged points
+   * @param source Path to splice in (left in a moved-from state)
+   * @param tolerance Connection tolerance in mm
+   * @return true if the paths connected and were spliced
    */
-  VCarvePath mergePaths(const VCarvePath& path1, const VCarvePath& path2);
+  bool splicePaths(VCarvePath& target, VCarvePath&& source, double tolerance);
 };
 
 }  // namespace Geometry
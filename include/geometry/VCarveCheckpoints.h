@@ -0,0 +1,56 @@
+/**
+ * VCarveCheckpoints.h
+ *
+ * Crash checkpoints of computed V-carve paths. Generate Paths saves each
+ * profile's paths as soon as they are computed, keyed by a hash of everything
+ * they depend on; a rerun with identical inputs after Fusion went down loads
+ * them instead of recomputing, so only the sketches are written again.
+ * Checkpoints of a run are removed once its sketches are written. Medial axes
+ * need no checkpoints here: MedialAxisDiskCache already keeps them.
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <string>
+
+#include "VCarvePath.h"
+
+namespace ChipCarving {
+namespace Geometry {
+
+class VCarveCheckpoints {
+ public:
+  // @param directory Checkpoint directory (created if its parent exists; empty disables checkpoints)
+  explicit VCarveCheckpoints(const std::string& directory);
+
+  bool isEnabled() const {
+    return enabled_;
+  }
+
+  /**
+   * Load a profile's checkpointed paths
+   * @return true if a complete checkpoint for key exists
+   */
+  bool load(uint64_t key, VCarveResults& results) const;
+
+  /**
+   * Save a profile's paths (failed or compacted results are ignored). Written
+   * to a temporary file and renamed, so a crash never leaves a partial checkpoint.
+   * Safe to call from worker threads for different keys.
+   * @return true if the checkpoint was written
+   */
+  bool store(uint64_t key, const VCarveResults& results) const;
+
+  // Delete a checkpoint once its profile is written
+  void remove(uint64_t key) const;
+
+  std::string pathForKey(uint64_t key) const;
+
+ private:
+  std::string directory_{};
+  bool enabled_ = false;
+};
+
+}  // namespace Geometry
+}  // namespace ChipCarving
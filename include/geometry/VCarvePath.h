@@ -7,8 +7,11 @@
 
 #pragma once
 
+#include <string>
 #include <vector>
 
+#include "CompactPaths.h"
+#include "MedialAxisGraph.h"
 #include "Point2D.h"
 
 namespace ChipCarving {
@@ -19,22 +22,86 @@ namespace Geometry {
  */
 struct VCarvePoint {
   Point2D position;        ///< (x, y) position in world coordinates (mm)
-  double depth;            ///< Z-depth below sketch plane (mm, positive = down)
+  double depth;            ///< Z-depth below sketch plane, or below surfaceZ when projected (mm, positive = down)
   double clearanceRadius;  ///< Original clearance radius from medial axis (mm)
+  double surfaceZ;         ///< World Z of the target surface under position (mm), set when projected
+  bool surfaceProjected;   ///< Whether depth is measured from surfaceZ instead of the sketch plane
 
-  VCarvePoint(const Point2D& pos, double d, double clearance) : position(pos), depth(d), clearanceRadius(clearance) {}
+  VCarvePoint(const Point2D& pos, double d, double clearance)
+      : position(pos), depth(d), clearanceRadius(clearance), surfaceZ(0.0), surfaceProjected(false) {}
 
-  VCarvePoint() : position(0, 0), depth(0.0), clearanceRadius(0.0) {}
+  VCarvePoint() : position(0, 0), depth(0.0), clearanceRadius(0.0), surfaceZ(0.0), surfaceProjected(false) {}
+
+  /**
+   * Carve below the target surface instead of the sketch plane
+   * @param z World Z of the surface under this point (mm)
+   */
+  void projectToSurface(double z) {
+    surfaceZ = z;
+    surfaceProjected = true;
+  }
+
+  /**
+   * Cut Z relative to the sketch plane, as Fusion reads 3D sketch points (mm)
+   * @param sketchPlaneZ World Z of the sketch plane (mm)
+   */
+  double sketchRelativeZ(double sketchPlaneZ) const {
+    return surfaceProjected ? surfaceZ - sketchPlaneZ - depth : -depth;
+  }
 };
 
 /**
  * Represents a continuous V-carve toolpath consisting of connected points
+ *
+ * totalLength and the depth range are kept up to date by append() and
+ * appendPath() as the path grows and by joinStatistics() when paths are
+ * spliced, so summaries need no pass over the points. Code that edits points directly calls updateStatistics()
+ * afterwards; statistics that cover a different point count than the path
+ * has are recomputed by VCarveResults::updateStatistics().
  */
 struct VCarvePath {
   std::vector<VCarvePoint> points{};  ///< Sequential points along this path
   double totalLength = 0.0;           ///< Total 2D length of path in mm
   bool isClosed = false;              ///< Whether path forms a closed loop
 
+  // Medial axis graph nodes at the first and last point, when the path follows graph chains
+  uint32_t startNode = MedialAxisGraph::NO_NODE;
+  uint32_t endNode = MedialAxisGraph::NO_NODE;
+
+  // Depth range of the first measuredPoints points (mm)
+  double minDepth = 0.0;
+  double maxDepth = 0.0;
+  size_t measuredPoints = 0;
+
+  /**
+   * Add a point, extending the length and depth range
+   */
+  void append(const VCarvePoint& point);
+
+  /**
+   * Add the points of source, reversed if asked, after this path's last point
+   * @param skipFirst Leave out source's first point (in the order added), which repeats this path's last one
+   */
+  void appendPath(const VCarvePath& source, bool reversed, bool skipFirst);
+
+  /**
+   * Fold in the statistics of source before its points are spliced onto this path
+   * @param gap Length of the move bridging the two paths (mm)
+   */
+  void joinStatistics(const VCarvePath& source, double gap);
+
+  /**
+   * Recompute length and depth range in one pass over the points
+   */
+  void updateStatistics();
+
+  /**
+   * Whether length and depth range cover every point
+   */
+  bool statisticsCurrent() const {
+    return measuredPoints == points.size();
+  }
+
   /**
    * Calculate total 2D path length
    * @return Total length in mm
@@ -73,12 +140,32 @@ struct VCarveResults {
   double maxDepth = 0.0;     ///< Deepest cut across all paths (mm)
   double minDepth = 0.0;     ///< Shallowest cut across all paths (mm)
 
+  // Rapid travel between consecutive paths (end of one to start of the next)
+  double rapidDistance = 0.0;           ///< Rapid travel in final path order (mm)
+  double unorderedRapidDistance = 0.0;  ///< Rapid travel before path ordering (mm)
+  bool pathsOrdered = false;            ///< Whether the path ordering stage ran
+
   // Success/error status
   bool success = false;        ///< Whether generation succeeded
   std::string errorMessage{};  ///< Error details if failed
 
+  // Paths packed by compact() while they wait to be written; statistics stay as they were
+  CompactVCarvePaths compactStorage{};
+  bool compacted = false;
+
   /**
-   * Update statistics based on current paths
+   * Move paths into float32 storage, freeing the double-precision points
+   */
+  void compact();
+
+  /**
+   * Restore paths from compact storage (no-op unless compacted)
+   */
+  void expand();
+
+  /**
+   * Update statistics from the paths' own; only paths whose statistics are
+   * out of date are rescanned
    */
   void updateStatistics();
 
@@ -89,5 +176,12 @@ struct VCarveResults {
   std::string getSummary() const;
 };
 
+/**
+ * Total rapid (non-cutting) travel when paths are cut in the given order
+ * @param paths Paths in cutting order
+ * @return Sum of 2D distances from each path's end to the next path's start (mm)
+ */
+double calculateRapidDistance(const std::vector<VCarvePath>& paths);
+
 }  // namespace Geometry
 }  // namespace ChipCarving
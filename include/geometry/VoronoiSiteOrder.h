@@ -0,0 +1,48 @@
+/**
+ * VoronoiSiteOrder.h
+ *
+ * Insertion order and grid size for OpenVoronoi point sites. OpenVoronoi
+ * locates each new site by walking from the nearest grid bin, so inserting
+ * polygon vertices in boundary order (each next to the last) is its worst
+ * case; a Hilbert curve or shuffled order spreads insertions across the diagram.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "Point2D.h"
+
+namespace ChipCarving {
+namespace Geometry {
+
+enum class SiteInsertionOrder {
+  POLYGON,  // Boundary order, as the vertices are given
+  HILBERT,  // Along a Hilbert curve over the bounding box
+  SHUFFLED  // Fixed-seed shuffle, so results are reproducible
+};
+
+/**
+ * Order in which to insert points as point sites
+ * @return A permutation of [0, points.size())
+ */
+std::vector<size_t> siteInsertionOrder(const std::vector<Point2D>& points, SiteInsertionOrder order);
+
+/**
+ * Same order written into caller-owned buffers, so repeated calls reuse their capacity
+ * @param indices Output permutation
+ * @param keys Scratch for the Hilbert curve positions
+ */
+void siteInsertionOrder(const std::vector<Point2D>& points, SiteInsertionOrder order, std::vector<size_t>& indices,
+                        std::vector<uint64_t>& keys);
+
+/**
+ * Bins per side of OpenVoronoi's face grid over [-1, 1]^2 for these unit
+ * circle points, aiming for about one site per bin inside their bounding box
+ */
+int openVoronoiBinCount(const std::vector<Point2D>& unitPoints);
+
+}  // namespace Geometry
+}  // namespace ChipCarving
@@ -0,0 +1,146 @@
+/**
+ * BinaryDesign.h
+ *
+ * Compact binary container for design files. Designs that are imported again
+ * and again skip JSON parsing: the reader validates the header and table sizes
+ * of a memory-mapped file and copies fixed-size records straight out of it.
+ *
+ * File layout (native byte order, every record a multiple of 8 bytes):
+ *   BinaryDesignHeader
+ *   BinaryShapeRecord shapes[shapeCount]
+ *   BinaryImageRecord images[imageCount]
+ *   char              strings[stringBytes]   (metadata, image ids, raw image data)
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <string>
+
+#include "parsers/DesignParser.h"
+
+namespace ChipCarving {
+namespace Parsers {
+
+constexpr char BINARY_DESIGN_MAGIC[4] = {'C', 'C', 'D', 'B'};
+constexpr uint32_t BINARY_DESIGN_VERSION = 1;
+constexpr size_t BINARY_DESIGN_METADATA_FIELDS = 5;  // name, author, created, modified, description
+
+enum class BinaryShapeType : uint32_t { Leaf = 0, TriArc = 1 };
+
+// Byte range of the string section
+struct BinaryStringRef {
+  uint64_t offset;
+  uint64_t length;
+};
+
+struct BinaryDesignHeader {
+  char magic[4];
+  uint32_t formatVersion;
+  uint32_t shapeCount;
+  uint32_t imageCount;
+  uint64_t stringBytes;
+  uint64_t sourceSize;      // Size and modification time of the JSON file it was converted from (0 if none)
+  int64_t sourceModified;
+  uint32_t metadataPresent;  // Bit i set if metadata field i is present
+  uint32_t reserved;
+  BinaryStringRef metadata[BINARY_DESIGN_METADATA_FIELDS];
+};
+
+struct BinaryShapeRecord {
+  uint32_t type;  // BinaryShapeType
+  uint32_t reserved;
+  double vertices[3][2];  // Leaf: the two foci; TriArc: the three corners
+  double curvatures[3];   // TriArc only
+  double radius;          // Leaf only
+};
+
+struct BinaryImageRecord {
+  BinaryStringRef id;
+  BinaryStringRef data;
+  double positionX;
+  double positionY;
+  double rotation;
+  double scale;
+  double opacity;
+  double naturalWidth;
+  double naturalHeight;
+};
+
+/**
+ * Reader for a memory-mapped binary design
+ * Background images keep their data deferred into the mapping, as with
+ * DesignParseOptions::deferBackgroundImageData.
+ */
+class BinaryDesignReader {
+ public:
+  /**
+   * @throws std::runtime_error if the file cannot be opened or is not a valid binary design
+   */
+  explicit BinaryDesignReader(const std::string& path);
+  explicit BinaryDesignReader(std::shared_ptr<const Utils::MappedFile> file);
+
+  // True if the mapped bytes start with the binary design magic
+  static bool isBinaryDesign(const Utils::MappedFile& file);
+
+  size_t shapeCount() const {
+    return header_.shapeCount;
+  }
+  size_t imageCount() const {
+    return header_.imageCount;
+  }
+  uint64_t sourceSize() const {
+    return header_.sourceSize;
+  }
+  int64_t sourceModified() const {
+    return header_.sourceModified;
+  }
+
+  BinaryShapeRecord shapeRecord(size_t index) const;
+  BackgroundImage image(size_t index) const;
+  DesignMetadata metadata() const;
+
+  /**
+   * Validate and construct one shape
+   * @throws std::runtime_error if the record is not a valid Leaf or TriArc
+   */
+  std::unique_ptr<Geometry::Shape> createShape(size_t index, const Adapters::ILogger* logger = nullptr) const;
+
+  // Hand metadata, accepted shapes and images to handler, as DesignParser::parseFromString does
+  void read(DesignParseHandler& handler, const Adapters::ILogger* logger = nullptr) const;
+
+  // The whole design, its shapes built in parallel for large designs
+  DesignFile readAll(const Adapters::ILogger* logger = nullptr) const;
+
+ private:
+  std::string readString(const BinaryStringRef& ref) const;
+
+  std::shared_ptr<const Utils::MappedFile> file_;
+  BinaryDesignHeader header_{};
+  size_t stringsOffset_ = 0;
+};
+
+/**
+ * Write design as a binary design file (through a temporary file, then renamed)
+ * @param sourcePath JSON file the design was parsed from, whose size and modification time are recorded
+ * @return false if the file could not be written
+ * @throws std::runtime_error if a shape is neither a Leaf nor a TriArc
+ */
+bool writeBinaryDesign(const DesignFile& design, const std::string& path, const std::string& sourcePath = "");
+
+/**
+ * Convert a design-schema-v2 JSON file into a binary design file
+ * @return false if the binary file could not be written
+ * @throws std::runtime_error if the JSON file cannot be read or parsed
+ */
+bool convertDesignToBinary(const std::string& jsonPath, const std::string& binaryPath);
+
+// Binary cache entry for jsonPath in directory
+std::string binaryDesignCachePath(const std::string& directory, const std::string& jsonPath);
+
+// The cache entry at cachePath if it was converted from jsonPath's current contents, else null
+std::unique_ptr<BinaryDesignReader> openFreshBinaryDesign(const std::string& cachePath, const std::string& jsonPath);
+
+}  // namespace Parsers
+}  // namespace ChipCarving
@@ -11,6 +11,7 @@
 
 #include "geometry/Point2D.h"
 #include "geometry/Shape.h"
+#include "utils/MonotonicArena.h"
 #include "utils/Optional.h"
 
 namespace ChipCarving {
@@ -19,9 +20,15 @@ namespace ChipCarving {
 namespace Adapters {
 class ILogger;
 }
+namespace Utils {
+class MappedFile;
+}
 
 namespace Parsers {
 
+class JsonInput;
+class JsonReader;
+
 /**
  * Metadata about a design file
  */
@@ -38,27 +45,115 @@ struct DesignMetadata {
  */
 struct BackgroundImage {
   std::string id{};
-  std::string imageData{};  // Base64 encoded
+  std::string imageData{};  // Base64 encoded; empty while deferred
   Geometry::Point2D position{0, 0};
   double rotation = 0.0;
   double scale = 1.0;
   double opacity = 1.0;
   double naturalWidth = 0.0;
   double naturalHeight = 0.0;
+
+  // Deferred imageData: the raw JSON string token at [imageDataOffset, imageDataOffset + imageDataLength)
+  // of the mapped design file, which stays mapped while any image refers to it. Binary designs
+  // store the unescaped bytes instead (imageDataIsJson false).
+  std::shared_ptr<const Utils::MappedFile> imageSource{};
+  size_t imageDataOffset = 0;
+  size_t imageDataLength = 0;
+  bool imageDataIsJson = true;
+
+  bool hasDeferredImageData() const {
+    return imageSource != nullptr;
+  }
+
+  /**
+   * Image data, decoding the deferred byte range if needed
+   * @throws std::runtime_error if the deferred token is not a valid JSON string
+   */
+  std::string loadImageData() const;
+};
+
+/**
+ * Options for parsing design files
+ */
+struct DesignParseOptions {
+  // Record background image payloads as byte ranges into the mapped file instead of copying them.
+  // Only applies to parseFromFile(); the plugin never reads image data during import. Compressed
+  // files have no decoded mapping to refer into, so their image data is always copied.
+  bool deferBackgroundImageData = false;
+
+  // Existing directory of binary copies of parsed JSON files (see BinaryDesign.h); a copy is
+  // read instead of the JSON while the file is unchanged, and written after parsing it. Empty is off.
+  std::string binaryCacheDirectory{};
+
+  // Build the shapes of a whole-file JSON parse one by one into a single arena shared by them,
+  // reusing one spec, instead of one heap allocation each built on worker threads. Binary
+  // designs and streaming parses (DesignParseHandler) always allocate shapes one by one.
+  bool arenaAllocation = false;
 };
 
+/**
+ * Deleter of a design's shapes: heap shapes are deleted; arena shapes are destroyed and keep
+ * their arena alive, so it is freed with the last of them
+ */
+struct ShapeDeleter {
+  std::shared_ptr<Utils::MonotonicArena> arena{};
+
+  ShapeDeleter() = default;
+  ShapeDeleter(std::default_delete<Geometry::Shape>) {}  // Lets std::unique_ptr<Shape> convert
+  explicit ShapeDeleter(std::shared_ptr<Utils::MonotonicArena> shapeArena) : arena(std::move(shapeArena)) {}
+
+  void operator()(Geometry::Shape* shape) const {
+    if (arena) {
+      shape->~Shape();
+    } else {
+      delete shape;
+    }
+  }
+};
+
+using DesignShape = std::unique_ptr<Geometry::Shape, ShapeDeleter>;
+
 /**
  * Complete design file contents
  */
 struct DesignFile {
   std::string version{};
   DesignMetadata metadata{};
-  std::vector<std::unique_ptr<Geometry::Shape>> shapes{};
+  std::vector<DesignShape> shapes{};
   std::vector<BackgroundImage> backgroundImages{};
 };
 
+/**
+ * Receives a design file's contents in file order as DesignParser reads them
+ * Each shape is handed over as soon as its object has been read, so callers can draw it or
+ * queue work on it while the rest of the file is parsed. A parse error can still be thrown
+ * after earlier members have been delivered.
+ */
+class DesignParseHandler {
+ public:
+  virtual ~DesignParseHandler() = default;
+
+  virtual void onMetadata(const DesignMetadata& metadata) {
+    (void)metadata;
+  }
+
+  // Shapes of types this rejects are read past without being constructed
+  virtual bool acceptsShape(const std::string& type) const {
+    (void)type;
+    return true;
+  }
+
+  // index counts every shape in the file, rejected ones included
+  virtual void onShape(std::unique_ptr<Geometry::Shape> shape, size_t index) = 0;
+
+  virtual void onBackgroundImage(BackgroundImage image) {
+    (void)image;
+  }
+};
+
 /**
  * JSON parser for design files
+ * Reads the document in a single pass with JsonReader; errors carry line and column.
  */
 class DesignParser {
  public:
@@ -70,6 +165,13 @@ class DesignParser {
    */
   static DesignFile parseFromString(const std::string& jsonContent, const Adapters::ILogger* logger = nullptr);
 
+  /**
+   * Parse a design file from JSON string; of the options only arenaAllocation applies
+   * @throws std::runtime_error if parsing fails
+   */
+  static DesignFile parseFromString(const std::string& jsonContent, const DesignParseOptions& options,
+                                    const Adapters::ILogger* logger = nullptr);
+
   /**
    * Parse a design file from file path
    * @param filePath Path to JSON file
@@ -78,6 +180,31 @@ class DesignParser {
    */
   static DesignFile parseFromFile(const std::string& filePath, const Adapters::ILogger* logger = nullptr);
 
+  /**
+   * Parse a memory-mapped design file; binary design files (BinaryDesign.h) are read without parsing,
+   * gzip-compressed JSON is decompressed a deflate block at a time as it is parsed
+   * @param filePath Path to JSON, gzip-compressed JSON or binary design file
+   * @param options Parse options (deferred background image data, binary cache, arena allocation)
+   * @return Parsed design file
+   * @throws std::runtime_error if file read or parsing fails
+   */
+  static DesignFile parseFromFile(const std::string& filePath, const DesignParseOptions& options,
+                                  const Adapters::ILogger* logger = nullptr);
+
+  /**
+   * Parse a design file from JSON string, handing its contents to handler as they are read
+   * @throws std::runtime_error if parsing fails, possibly after some shapes were delivered
+   */
+  static void parseFromString(const std::string& jsonContent, DesignParseHandler& handler,
+                              const Adapters::ILogger* logger = nullptr);
+
+  /**
+   * Parse a memory-mapped (or gzip-compressed) design file, handing its contents to handler as they are read
+   * @throws std::runtime_error if file read or parsing fails, possibly after some shapes were delivered
+   */
+  static void parseFromFile(const std::string& filePath, const DesignParseOptions& options,
+                            DesignParseHandler& handler, const Adapters::ILogger* logger = nullptr);
+
   /**
    * Validate JSON against schema (basic validation)
    * @param jsonContent JSON content as string
@@ -87,45 +214,54 @@ class DesignParser {
 
  private:
   /**
-   * Parse metadata section
+   * Decompressing input for a gzip-compressed file, or null for an uncompressed one
+   * @throws std::runtime_error for a compression format that is not supported
    */
-  static DesignMetadata parseMetadata(const std::string& jsonContent);
+  static std::unique_ptr<JsonInput> openCompressedInput(const std::shared_ptr<const Utils::MappedFile>& file,
+                                                        const std::string& filePath);
 
   /**
-   * Parse shapes array
+   * Parse a whole document; source is set when background image data is deferred
    */
-  static std::vector<std::unique_ptr<Geometry::Shape>> parseShapes(const std::string& jsonContent,
-                                                                   const Adapters::ILogger* logger = nullptr);
+  static DesignFile parse(JsonReader& reader, const std::shared_ptr<const Utils::MappedFile>& source,
+                          bool arenaAllocation, const Adapters::ILogger* logger);
 
   /**
-   * Parse background images array
+   * Parse a whole document into handler and check its version and shapes; shapes go to
+   * batchShapes instead of handler when it is set, built in parallel or, with arena, into it
    */
-  static std::vector<BackgroundImage> parseBackgroundImages(const std::string& jsonContent);
+  static void parseDocument(JsonReader& reader, const std::shared_ptr<const Utils::MappedFile>& source,
+                            DesignParseHandler& handler, const Adapters::ILogger* logger,
+                            std::vector<DesignShape>* batchShapes,
+                            const std::shared_ptr<Utils::MonotonicArena>& arena = nullptr);
 
   /**
-   * Parse a single point from JSON
+   * Parse metadata object at the reader's cursor (non-string fields are ignored)
    */
-  static Geometry::Point2D parsePoint(const std::string& pointJson);
+  static DesignMetadata parseMetadata(JsonReader& reader);
 
   /**
-   * Extract string value from JSON
+   * Parse shapes array at the reader's cursor
    */
-  static std::string extractString(const std::string& json, const std::string& key);
+  static std::vector<DesignShape> parseShapes(JsonReader& reader, const Adapters::ILogger* logger = nullptr);
 
   /**
-   * Extract number value from JSON
+   * Parse shapes array at the reader's cursor, building each shape into arena as it is read
    */
-  static double extractNumber(const std::string& json, const std::string& key);
+  static std::vector<DesignShape> parseShapes(JsonReader& reader, const std::shared_ptr<Utils::MonotonicArena>& arena,
+                                              const Adapters::ILogger* logger);
 
   /**
-   * Extract array from JSON
+   * Stream the shapes array at the reader's cursor into handler
+   * @return Number of shapes in the array, rejected ones included
    */
-  static std::string extractArray(const std::string& json, const std::string& key);
+  static size_t streamShapes(JsonReader& reader, DesignParseHandler& handler, const Adapters::ILogger* logger);
 
   /**
-   * Extract object from JSON
+   * Parse background images array at the reader's cursor into handler
    */
-  static std::string extractObject(const std::string& json, const std::string& key);
+  static void parseBackgroundImages(JsonReader& reader, const std::shared_ptr<const Utils::MappedFile>& source,
+                                    DesignParseHandler& handler);
 };
 
 }  // namespace Parsers
@@ -0,0 +1,151 @@
+/**
+ * Single-pass JSON reader for design files
+ *
+ * Pull-style cursor over an in-memory buffer: callers walk objects and arrays
+ * member by member and read values in place, so a document is scanned exactly
+ * once with no intermediate substrings. Errors report line and column.
+ * A document can also be pulled from a JsonInput chunk by chunk; only the
+ * unread part of the current chunk and the token being read are held.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <string>
+
+#include "geometry/Point2D.h"
+
+namespace ChipCarving {
+namespace Parsers {
+
+/**
+ * Source of a document read in chunks, such as a decompressor
+ */
+class JsonInput {
+ public:
+  virtual ~JsonInput() = default;
+
+  /**
+   * Next chunk of the document, valid until the following call
+   * @return false at the end of the document
+   * @throws std::runtime_error if the input cannot be read
+   */
+  virtual bool next(const char*& data, size_t& size) = 0;
+};
+
+class JsonReader {
+ public:
+  enum class ValueType { Object, Array, String, Number, Boolean, Null };
+
+  /**
+   * @param data Buffer to read; must outlive the reader
+   * @param size Buffer length in bytes
+   */
+  JsonReader(const char* data, size_t size);
+  explicit JsonReader(const std::string& text) : JsonReader(text.data(), text.size()) {}
+  explicit JsonReader(std::string&& text) = delete;  // Would dangle
+
+  /**
+   * @param input Chunk source; must outlive the reader
+   */
+  explicit JsonReader(JsonInput& input);
+
+  /**
+   * Type of the next value (skips whitespace)
+   * @throws std::runtime_error at end of input or on a character no value starts with
+   */
+  ValueType peekType();
+
+  /**
+   * Consume '{'; then call nextMember() until it returns false
+   */
+  void beginObject();
+
+  /**
+   * Advance to the next member of the current object
+   * @param key Receives the member name; the cursor is left on its value
+   * @return false once the closing '}' has been consumed
+   */
+  bool nextMember(std::string& key);
+
+  /**
+   * Consume '['; then call nextElement() until it returns false
+   */
+  void beginArray();
+
+  /**
+   * Advance to the next element of the current array
+   * @return false once the closing ']' has been consumed
+   */
+  bool nextElement();
+
+  std::string readString();
+  void readString(std::string& out);
+
+  /**
+   * Skip a string without decoding or copying it; escapes are validated only
+   * when the token is later decoded with readString()
+   * @param tokenOffset Receives the document offset of the opening quote
+   * @param tokenLength Receives the token length including both quotes
+   */
+  void skipString(size_t& tokenOffset, size_t& tokenLength);
+  double readNumber();
+  bool readBoolean();
+  void readNull();
+
+  /**
+   * Skip the next value, including any nested objects and arrays
+   */
+  void skipValue();
+
+  /**
+   * Require that only whitespace remains
+   */
+  void expectEnd();
+
+  /**
+   * Throw std::runtime_error with the current line and column
+   */
+  [[noreturn]] void fail(const std::string& message) const;
+
+  // Offset of the cursor from the start of the document
+  size_t offset() const {
+    return base_ + pos_;
+  }
+
+ private:
+  /**
+   * Append the input's next chunk, dropping the bytes before *keepFrom (default: the cursor)
+   * @return false at the end of the input, or always for an in-memory buffer
+   */
+  bool refill(size_t* keepFrom = nullptr);
+
+  // Refill until count bytes are available at the cursor
+  bool ensure(size_t count);
+
+  void skipWhitespace();
+  void expect(char c, const char* what);
+  void expectLiteral(const char* literal);
+  unsigned int readHex4();
+
+  const char* data_;
+  size_t size_;
+  size_t pos_ = 0;
+  char previous_ = '\0';  // Last structural token: '{', '[' or 'v' after a complete value
+
+  // Chunked input: data_ is window_, which starts base_ bytes into the document at baseLine_/baseColumn_
+  JsonInput* input_ = nullptr;
+  std::string window_{};
+  size_t base_ = 0;
+  size_t baseLine_ = 1;
+  size_t baseColumn_ = 1;
+};
+
+/**
+ * Read a {"x": ..., "y": ...} object; other members are ignored
+ * @throws std::runtime_error if either coordinate is missing
+ */
+Geometry::Point2D readPoint(JsonReader& reader);
+
+}  // namespace Parsers
+}  // namespace ChipCarving
@@ -0,0 +1,48 @@
+/**
+ * AllocationTracking.h
+ *
+ * Heap allocation counts behind the per-stage allocation figures of
+ * RunMetrics. A build with CHIP_CARVING_ALLOCATION_TRACKING defined for
+ * AllocationTracking.cpp (the tests' CMake option of that name; the
+ * benchmarks always) replaces the global operator new and delete with
+ * counting versions, and each TraceSpan records what its thread allocated
+ * while it was open. Blocks carry their size, so the bytes still live (and
+ * their peak) are known too. The add-in never enables it: it shares Fusion's
+ * heap. In other builds every count stays zero.
+ */
+
+#pragma once
+
+#include <cstdint>
+
+namespace ChipCarving {
+namespace Utils {
+
+struct AllocationTotals {
+  uint64_t count = 0;  // Calls to operator new
+  uint64_t bytes = 0;  // Bytes requested by those calls
+};
+
+// True if this build counts allocations
+bool allocationTrackingEnabled();
+
+// Allocations made by the calling thread since it started
+AllocationTotals threadAllocationTotals();
+
+// Allocations made by every thread since the program started
+AllocationTotals processAllocationTotals();
+
+// Bytes allocated by every thread and not yet freed
+uint64_t liveAllocatedBytes();
+
+// Highest liveAllocatedBytes() since the last reset
+uint64_t peakLiveAllocatedBytes();
+
+// Restart the peak from the current live bytes; returns the peak it replaces
+uint64_t resetPeakLiveAllocatedBytes();
+
+// Raise the peak to at least bytes (restores an enclosing window's peak)
+void raisePeakLiveAllocatedBytes(uint64_t bytes);
+
+}  // namespace Utils
+}  // namespace ChipCarving
@@ -0,0 +1,70 @@
+/**
+ * ApiCallTimer.h
+ *
+ * Fusion API call accounting at the adapter boundary. The Fusion adapters
+ * wrap each API call they make in an ApiCallTimer (or timedApiCall), which
+ * adds its count and time to the span open on the thread's bound RunMetrics
+ * under one of four exclusive kinds, so a run's summary shows per stage how
+ * many objects, ray casts and sketch entities it asked Fusion for and what
+ * they cost. A bound TraceRecorder also gets running "fusion.<kind>"
+ * counters. With nothing bound a timer does not read the clock.
+ */
+
+#pragma once
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+
+namespace ChipCarving {
+namespace Utils {
+
+class RunMetrics;
+class TraceRecorder;
+
+enum class ApiCallKind {
+  Call,          // Any other API call (sketch and feature creation, attributes, progress dialog)
+  ObjectCreate,  // Point3D::create, ObjectCollection::create and other transient API objects
+  RayCast,       // findBRepUsingRay
+  SketchEntity,  // Lines, arcs, splines and points added to a sketch
+};
+
+constexpr size_t API_CALL_KIND_COUNT = 4;
+
+// Short name used in summaries and JSON, e.g. "rayCasts"
+const char* apiCallKindName(ApiCallKind kind);
+
+struct ApiCallTotals {
+  uint64_t count = 0;
+  double totalMs = 0.0;
+};
+
+/**
+ * Times its own scope as count API calls of one kind; wrap only the call
+ * itself, since nested timers would count the inner call's time twice
+ */
+class ApiCallTimer {
+ public:
+  explicit ApiCallTimer(ApiCallKind kind, uint64_t count = 1);
+  ~ApiCallTimer();
+
+  ApiCallTimer(const ApiCallTimer&) = delete;
+  ApiCallTimer& operator=(const ApiCallTimer&) = delete;
+
+ private:
+  ApiCallKind kind_;
+  uint64_t count_;
+  RunMetrics* metrics_;
+  TraceRecorder* recorder_;
+  std::chrono::steady_clock::time_point start_{};
+};
+
+// Make one API call inside an ApiCallTimer and return its result
+template <typename Call>
+decltype(auto) timedApiCall(ApiCallKind kind, Call&& call) {
+  ApiCallTimer timer(kind);
+  return call();
+}
+
+}  // namespace Utils
+}  // namespace ChipCarving
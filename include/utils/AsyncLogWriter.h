@@ -0,0 +1,93 @@
+/**
+ * AsyncLogWriter.h
+ *
+ * Background log writer fed by a lock-free ring of preformatted records.
+ * Callers never touch the file: push() claims a ring slot with one CAS and
+ * returns, and a writer thread drains the ring into the sink, flushing only
+ * when a record asks for it (errors), on flush(), and on shutdown.
+ */
+
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+
+namespace ChipCarving {
+namespace Utils {
+
+class AsyncLogWriter {
+ public:
+  using RecordSink = std::function<void(const std::string& record)>;
+  using FlushSink = std::function<void()>;
+
+  static constexpr size_t DEFAULT_CAPACITY = 8192;
+
+  /**
+   * @param write Called on the writer thread for each record, in push order
+   * @param flush Called on the writer thread to persist written records
+   * @param capacity Ring size in records (rounded up to a power of two)
+   */
+  AsyncLogWriter(RecordSink write, FlushSink flush, size_t capacity = DEFAULT_CAPACITY);
+
+  // Drains every pushed record, flushes and joins the writer thread
+  ~AsyncLogWriter();
+
+  AsyncLogWriter(const AsyncLogWriter&) = delete;
+  AsyncLogWriter& operator=(const AsyncLogWriter&) = delete;
+
+  /**
+   * Queue a record without blocking (safe from any thread)
+   * @param flushAfter Wake the writer now and flush once this record is written
+   * @return false if the ring was full; the record is dropped and counted
+   */
+  bool push(std::string record, bool flushAfter = false);
+
+  /**
+   * Block until every record pushed before this call is written and flushed
+   */
+  void flush();
+
+  size_t droppedCount() const {
+    return dropped_.load(std::memory_order_relaxed);
+  }
+
+ private:
+  struct Slot {
+    std::atomic<size_t> sequence{0};
+    std::string record{};
+    bool flushAfter = false;
+  };
+
+  void run();
+
+  // Write all published records; returns true if any of them asked for a flush
+  bool drain();
+  void reportDropped();
+
+  RecordSink write_;
+  FlushSink flushSink_;
+  std::unique_ptr<Slot[]> slots_;
+  size_t mask_ = 0;
+
+  std::atomic<size_t> enqueuePos_{0};
+  std::atomic<size_t> dropped_{0};
+  size_t dequeuePos_ = 0;       // Writer thread only
+  size_t droppedReported_ = 0;  // Writer thread only
+
+  std::mutex mutex_{};
+  std::condition_variable wake_{};
+  std::condition_variable flushed_{};
+  size_t flushedPos_ = 0;  // Guarded by mutex_
+  bool flushRequested_ = false;
+  bool stopping_ = false;
+  std::thread writer_{};
+};
+
+}  // namespace Utils
+}  // namespace ChipCarving
@@ -0,0 +1,89 @@
+/**
+ * BoundedQueue.h
+ *
+ * Fixed-capacity blocking FIFO connecting the stages of a pipeline. Producers
+ * block while the queue is full and consumers while it is empty; close() wakes
+ * everyone so a stage can drain what is left and exit.
+ */
+
+#pragma once
+
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <mutex>
+#include <utility>
+
+namespace ChipCarving {
+namespace Utils {
+
+template <typename T>
+class BoundedQueue {
+ public:
+  explicit BoundedQueue(size_t capacity) : capacity_(capacity > 0 ? capacity : 1) {}
+
+  BoundedQueue(const BoundedQueue&) = delete;
+  BoundedQueue& operator=(const BoundedQueue&) = delete;
+
+  // Block until there is room; returns false (dropping item) once closed
+  bool push(T item) {
+    std::unique_lock<std::mutex> lock(mutex_);
+    notFull_.wait(lock, [this] { return closed_ || items_.size() < capacity_; });
+    if (closed_) {
+      return false;
+    }
+    items_.push_back(std::move(item));
+    notEmpty_.notify_one();
+    return true;
+  }
+
+  // Block until an item is available; returns false once closed and drained
+  bool pop(T& item) {
+    std::unique_lock<std::mutex> lock(mutex_);
+    notEmpty_.wait(lock, [this] { return closed_ || !items_.empty(); });
+    return takeFront(item);
+  }
+
+  // Take an item only if one is ready
+  bool tryPop(T& item) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return takeFront(item);
+  }
+
+  // Refuse further pushes; items already queued can still be popped
+  void close() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    closed_ = true;
+    notEmpty_.notify_all();
+    notFull_.notify_all();
+  }
+
+  size_t size() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return items_.size();
+  }
+  size_t capacity() const {
+    return capacity_;
+  }
+
+ private:
+  bool takeFront(T& item) {
+    if (items_.empty()) {
+      return false;
+    }
+    item = std::move(items_.front());
+    items_.pop_front();
+    notFull_.notify_one();
+    return true;
+  }
+
+  const size_t capacity_;
+  mutable std::mutex mutex_{};
+  std::condition_variable notEmpty_{};
+  std::condition_variable notFull_{};
+  std::deque<T> items_{};
+  bool closed_ = false;
+};
+
+}  // namespace Utils
+}  // namespace ChipCarving
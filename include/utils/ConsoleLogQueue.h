@@ -0,0 +1,58 @@
+/**
+ * ConsoleLogQueue.h
+ *
+ * Console lines logged off the main thread, held until the main thread writes
+ * them to the Text Commands palette. Any thread may push; only the first push
+ * into an empty queue asks for a wakeup, so a burst of worker messages costs
+ * one main-thread event. Lines past the capacity are counted and dropped
+ * rather than blocking a worker on a busy UI.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace ChipCarving {
+namespace Utils {
+
+class ConsoleLogQueue {
+ public:
+  using LineSink = std::function<void(const std::string&)>;
+
+  static constexpr size_t DEFAULT_CAPACITY = 4096;
+
+  explicit ConsoleLogQueue(size_t capacity = DEFAULT_CAPACITY);
+
+  ConsoleLogQueue(const ConsoleLogQueue&) = delete;
+  ConsoleLogQueue& operator=(const ConsoleLogQueue&) = delete;
+
+  /**
+   * Queue a formatted line (any thread)
+   * @return true if the queue was empty, i.e. the caller should wake the main thread
+   */
+  bool push(std::string line);
+
+  /**
+   * Write every queued line in order, then a note for any that were dropped
+   * (main thread). The lock is released before sink runs, so sink may log.
+   * @return Number of lines written, excluding the dropped note
+   */
+  size_t drain(const LineSink& sink);
+
+  size_t size() const;
+  size_t droppedCount() const;
+
+ private:
+  size_t capacity_;
+  mutable std::mutex mutex_;
+  std::vector<std::string> lines_{};
+  size_t dropped_ = 0;       // Since the last drain
+  size_t totalDropped_ = 0;  // Since construction
+};
+
+}  // namespace Utils
+}  // namespace ChipCarving
@@ -0,0 +1,99 @@
+/**
+ * Inflate.h
+ *
+ * Decoder for zlib (RFC 1950) streams of deflate (RFC 1951) blocks, enough to
+ * read PNG image data and gzip design files. Stored, fixed and dynamic Huffman
+ * blocks are supported, and the checksum trailers of zlib streams (Adler-32)
+ * and gzip members (CRC-32) are verified.
+ * Note: this is kept in the tree rather than linking libz so the output caps
+ * are enforced inside the decoder as each byte is produced, and a malformed
+ * file fails at its caller's cap; the add-in's link line also stays the
+ * Fusion SDK, OpenVoronoi and Boost.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+namespace ChipCarving {
+namespace Utils {
+
+/**
+ * Decompress a whole zlib stream
+ * @param out Receives the decompressed bytes (appended)
+ * @param maxOutput Fail rather than produce more than this many bytes
+ * @return false on a malformed, truncated or oversized stream, or one whose Adler-32 does not match
+ */
+bool inflateZlib(const unsigned char* data, size_t size, std::vector<unsigned char>& out, size_t maxOutput);
+
+/**
+ * Incremental decoder of a raw deflate stream, one block at a time
+ * Only the 32K window of earlier output is kept between blocks, so a large
+ * stream decodes in memory bounded by its largest block.
+ */
+class InflateStream {
+ public:
+  // @param maxBlockOutput Fail rather than decode a block longer than this
+  InflateStream(const unsigned char* data, size_t size, size_t maxBlockOutput);
+  ~InflateStream();
+
+  // Decode the next block; false after the final block or on a malformed stream (see failed())
+  bool nextBlock();
+
+  // The last decoded block's bytes, valid until the next call
+  const unsigned char* block() const;
+  size_t blockSize() const;
+
+  bool failed() const;
+
+  // Whole input bytes used so far; once the stream has ended, where the data after it starts
+  size_t inputUsed() const;
+
+ private:
+  struct State;
+  std::unique_ptr<State> state_;
+};
+
+/**
+ * Decoder for gzip (RFC 1952) files, one deflate block at a time
+ * Concatenated members read as one stream. Each member's CRC-32 and length
+ * trailers are checked once its last block is decoded, so failed() reports a
+ * mismatch after the member's data has been handed out; the optional header
+ * CRC is not checked.
+ */
+class GzipReader {
+ public:
+  // @param maxBlockOutput Fail rather than decode a deflate block longer than this
+  GzipReader(const unsigned char* data, size_t size, size_t maxBlockOutput);
+  ~GzipReader();
+
+  // True if data starts with the gzip magic
+  static bool isGzip(const unsigned char* data, size_t size);
+
+  // Next decoded chunk, valid until the next call; false at the end or on a malformed file (see failed())
+  bool next(const unsigned char*& data, size_t& size);
+
+  bool failed() const {
+    return failed_;
+  }
+
+ private:
+  bool beginMember();
+  bool endMember();
+
+  const unsigned char* data_;
+  size_t size_;
+  size_t maxBlockOutput_;
+  size_t memberStart_ = 0;
+  size_t headerSize_ = 0;
+  uint32_t memberLength_ = 0;  // Decoded bytes modulo 2^32, as the trailer records them
+  uint32_t memberCrc_ = 0;     // CRC-32 of the bytes decoded so far
+  std::unique_ptr<InflateStream> inflate_{};
+  bool failed_ = false;
+};
+
+}  // namespace Utils
+}  // namespace ChipCarving
@@ -0,0 +1,88 @@
+/**
+ * JobProgress.h
+ *
+ * Progress and cancellation shared between a background job and the thread
+ * that started it. The job reports stages and completed items; any thread may
+ * cancel, and the job checks isCancelled() between items. A listener (for the
+ * add-in, a Fusion custom event) is told about progress at a bounded rate.
+ */
+
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <functional>
+#include <mutex>
+
+namespace ChipCarving {
+namespace Utils {
+
+class JobProgress {
+ public:
+  using Listener = std::function<void()>;
+
+  // Default minimum time between progress notifications of the same stage
+  static constexpr int DEFAULT_NOTIFY_INTERVAL_MS = 100;
+  // How often waitUnlessCancelled() checks for cancellation
+  static constexpr int CANCEL_POLL_MS = 10;
+
+  struct Snapshot {
+    const char* stage = "";  // String literal given to beginStage
+    size_t completed = 0;
+    size_t total = 0;
+    bool cancelled = false;
+  };
+
+  JobProgress() = default;
+  JobProgress(const JobProgress&) = delete;
+  JobProgress& operator=(const JobProgress&) = delete;
+
+  /**
+   * @param listener Called on the reporting thread; must be safe from any thread
+   * @param intervalMs Minimum time between advance() notifications (stage
+   *        changes and finish() always notify)
+   */
+  void setListener(Listener listener, int intervalMs = DEFAULT_NOTIFY_INTERVAL_MS);
+
+  // Start a stage of total items (name must outlive the job; use string literals)
+  void beginStage(const char* stage, size_t total);
+
+  // Mark items of the current stage done
+  void advance(size_t count = 1);
+
+  // Mark the whole job done (successfully or not) and notify
+  void finish();
+
+  void cancel() {
+    cancelled_.store(true, std::memory_order_relaxed);
+  }
+  bool isCancelled() const {
+    return cancelled_.load(std::memory_order_relaxed);
+  }
+  bool isFinished() const {
+    return finished_.load(std::memory_order_acquire);
+  }
+
+  // Sleep through delayMs, waking early if cancelled; false if the job was cancelled meanwhile
+  bool waitUnlessCancelled(int delayMs) const;
+
+  Snapshot snapshot() const;
+
+ private:
+  void notify(bool force);
+
+  mutable std::mutex mutex_{};
+  const char* stage_ = "";
+  size_t total_ = 0;
+  std::atomic<size_t> completed_{0};
+  std::atomic<bool> cancelled_{false};
+  std::atomic<bool> finished_{false};
+
+  Listener listener_{};
+  std::chrono::steady_clock::duration interval_{};
+  std::chrono::steady_clock::time_point lastNotify_{};
+};
+
+}  // namespace Utils
+}  // namespace ChipCarving
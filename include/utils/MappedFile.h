@@ -0,0 +1,60 @@
+/**
+ * MappedFile.h
+ *
+ * Read-only memory mapping of a whole file, released on destruction.
+ * Uses mmap on macOS and MapViewOfFile on Windows; where mapping fails (some
+ * network drives) the file is read once into an owned buffer instead.
+ * Split from MedialAxisDiskCache.cpp so the design parser can share it
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <string>
+
+namespace ChipCarving {
+namespace Utils {
+
+class MappedFile {
+ public:
+  // mapFile = false reads the file into the buffer instead: a mapping faults if another machine deletes the file
+  explicit MappedFile(const std::string& path, bool mapFile = true);
+  ~MappedFile();
+
+  MappedFile(const MappedFile&) = delete;
+  MappedFile& operator=(const MappedFile&) = delete;
+
+  // True if the file could be opened; an empty file is open but has no data
+  bool isOpen() const {
+    return open_;
+  }
+
+  // True if data() points into a mapping rather than the read fallback buffer
+  bool isMapped() const {
+    return mapped_;
+  }
+
+  const unsigned char* data() const {
+    return data_;
+  }
+  const char* chars() const {
+    return reinterpret_cast<const char*>(data_);
+  }
+  size_t size() const {
+    return size_;
+  }
+
+ private:
+  // Platform mapping; returns false (with open_ set if the file exists) when it fails
+  bool map(const std::string& path);
+  void unmap();
+
+  const unsigned char* data_ = nullptr;
+  size_t size_ = 0;
+  bool open_ = false;
+  bool mapped_ = false;
+  std::string buffer_{};  // Read fallback storage
+};
+
+}  // namespace Utils
+}  // namespace ChipCarving
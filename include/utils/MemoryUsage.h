@@ -0,0 +1,74 @@
+/**
+ * MemoryUsage.h
+ *
+ * Process memory behind the per-stage peak figures of RunMetrics.
+ * Resident set size comes from the OS (/proc on Linux, task_info on macOS,
+ * GetProcessMemoryInfo on Windows) and is read by a MemorySampler thread
+ * while a run is open, so spans only load atomics. Live heap bytes come from
+ * the allocation hooks in builds that count allocations (AllocationTracking.h)
+ * and are exact there.
+ *
+ * A span opens a peak window on entry and closes it on exit; windows nest, the
+ * enclosing one keeping the larger of its own and its child's peaks. Windows
+ * belong to the thread that binds RunMetrics; other threads' memory counts
+ * toward the peaks but they open no windows of their own.
+ */
+
+#pragma once
+
+#include <condition_variable>
+#include <cstdint>
+#include <mutex>
+#include <thread>
+
+namespace ChipCarving {
+namespace Utils {
+
+struct MemoryPeaks {
+  uint64_t residentBytes = 0;  // Zero when no sampler ran or the OS gave no figure
+  uint64_t liveBytes = 0;      // Zero unless allocationTrackingEnabled()
+};
+
+// Resident set size of the process now (0 if the OS gives no figure)
+uint64_t currentResidentBytes();
+
+// Highest resident set size of the process over its lifetime (0 if unknown)
+uint64_t processPeakResidentBytes();
+
+/**
+ * Start a peak window
+ * @return The enclosing window's peaks so far; hand them to closeMemoryWindow
+ */
+MemoryPeaks openMemoryWindow();
+
+/**
+ * End the innermost window
+ * @return Its peaks, which are also folded back into the enclosing window
+ */
+MemoryPeaks closeMemoryWindow(const MemoryPeaks& enclosing);
+
+/**
+ * Samples the resident set size every interval for its lifetime, and once on
+ * construction and destruction. Samplers may nest; only the outermost runs a thread.
+ */
+class MemorySampler {
+ public:
+  static constexpr int DEFAULT_INTERVAL_MS = 5;
+
+  explicit MemorySampler(int intervalMs = DEFAULT_INTERVAL_MS);
+  ~MemorySampler();
+
+  MemorySampler(const MemorySampler&) = delete;
+  MemorySampler& operator=(const MemorySampler&) = delete;
+
+ private:
+  void run(int intervalMs);
+
+  std::mutex mutex_{};
+  std::condition_variable wake_{};
+  bool stopping_ = false;
+  std::thread thread_{};
+};
+
+}  // namespace Utils
+}  // namespace ChipCarving
@@ -0,0 +1,80 @@
+/**
+ * MonotonicArena.h
+ *
+ * Bump allocator over a chain of heap blocks, each twice the size of the one
+ * before (up to MAX_BLOCK_SIZE). Memory is only ever handed out; all of it is
+ * freed together when the arena is destroyed, so building many small objects
+ * costs a handful of heap allocations instead of one per object. The arena
+ * never runs destructors: whoever holds an object made by create() destroys
+ * it before the arena goes (see Parsers::ShapeDeleter). Not thread safe.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <new>
+#include <utility>
+
+namespace ChipCarving {
+namespace Utils {
+
+class MonotonicArena {
+ public:
+  static constexpr size_t DEFAULT_BLOCK_SIZE = 64 * 1024;
+  static constexpr size_t MAX_BLOCK_SIZE = 16 * 1024 * 1024;
+
+  explicit MonotonicArena(size_t initialBlockSize = DEFAULT_BLOCK_SIZE);
+  ~MonotonicArena();
+
+  MonotonicArena(const MonotonicArena&) = delete;
+  MonotonicArena& operator=(const MonotonicArena&) = delete;
+
+  /**
+   * Uninitialized memory valid until the arena is destroyed
+   * @param alignment A power of two no larger than alignof(std::max_align_t)
+   */
+  void* allocate(size_t bytes, size_t alignment = alignof(std::max_align_t)) {
+    size_t padding = (alignment - reinterpret_cast<size_t>(cursor_) % alignment) % alignment;
+    if (cursor_ == nullptr || bytes + padding > static_cast<size_t>(end_ - cursor_)) {
+      return allocateFromNewBlock(bytes);
+    }
+    void* memory = cursor_ + padding;
+    cursor_ += padding + bytes;
+    bytesUsed_ += bytes;
+    return memory;
+  }
+
+  template <typename T, typename... Args>
+  T* create(Args&&... args) {
+    static_assert(alignof(T) <= alignof(std::max_align_t), "over-aligned types are not supported");
+    return new (allocate(sizeof(T), alignof(T))) T(std::forward<Args>(args)...);
+  }
+
+  // Heap blocks obtained so far
+  size_t blockCount() const {
+    return blockCount_;
+  }
+
+  // Bytes handed out, padding excluded
+  size_t bytesUsed() const {
+    return bytesUsed_;
+  }
+
+ private:
+  struct Block {
+    Block* previous;
+  };
+
+  // Start a block big enough for bytes and hand them out from its start
+  void* allocateFromNewBlock(size_t bytes);
+
+  Block* head_ = nullptr;
+  char* cursor_ = nullptr;
+  char* end_ = nullptr;
+  size_t nextBlockSize_;
+  size_t blockCount_ = 0;
+  size_t bytesUsed_ = 0;
+};
+
+}  // namespace Utils
+}  // namespace ChipCarving
@@ -0,0 +1,36 @@
+/**
+ * PlatformTrace.h
+ *
+ * Forwards TraceSpan scopes to the platform's native profiler, so stages show
+ * up as named intervals in Instruments (os_signpost on macOS), VTune (Intel
+ * ITT, when built with CHIP_CARVING_ITT) or WPA/PerfView (ETW TraceLogging on
+ * Windows). Off by default and switched at runtime from Settings; while off a
+ * span pays one relaxed atomic load. Builds with no backend report "none" and
+ * ignore the switch.
+ */
+
+#pragma once
+
+#include <cstdint>
+
+namespace ChipCarving {
+namespace Utils {
+
+// Backend compiled in: "os_signpost", "ITT", "ETW" or "none"
+const char* platformTraceBackend();
+
+// Turn annotations on or off for every thread (no-op without a backend)
+void setPlatformTraceEnabled(bool enabled);
+
+bool platformTraceEnabled();
+
+/**
+ * Open a native interval for a span (name must outlive the run, as for TraceSpan)
+ * @return Token to hand to endPlatformSpan on the same thread
+ */
+uint64_t beginPlatformSpan(const char* name);
+
+void endPlatformSpan(const char* name, uint64_t token);
+
+}  // namespace Utils
+}  // namespace ChipCarving
@@ -0,0 +1,113 @@
+/**
+ * RunErrorContext.h
+ *
+ * Errors of one Generate Paths run, collected from its worker threads and
+ * reported on the main thread once the workers have joined. Each worker owns a
+ * Collector that records into a plain vector, so recording takes no lock; the
+ * collector hands its errors to the context once, when it goes out of scope.
+ * Collector::guard() is a template, so a hot loop's body is called directly
+ * rather than through std::function.
+ *
+ * Usage:
+ *   RunErrorContext errors;
+ *   // worker thread
+ *   RunErrorContext::Collector collector(errors);
+ *   collector.guard(profileIndex, "vcarve", [&]() { computeVCarve(profile); });
+ *   // main thread, after join
+ *   errors.report(logger);
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <exception>
+#include <mutex>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace ChipCarving {
+namespace Adapters {
+class ILogger;
+}
+namespace Utils {
+
+class RunErrorContext {
+ public:
+  static constexpr size_t NO_PROFILE = static_cast<size_t>(-1);
+
+  struct Error {
+    size_t profile = NO_PROFILE;  // Index of the profile being processed, NO_PROFILE for run-wide errors
+    const char* operation = "";   // Static string naming the failed step
+    std::string message{};
+  };
+
+  // Errors of one worker thread; not shared between threads
+  class Collector {
+   public:
+    explicit Collector(RunErrorContext& context) : context_(context) {}
+    ~Collector() {
+      context_.merge(errors_);
+    }
+
+    Collector(const Collector&) = delete;
+    Collector& operator=(const Collector&) = delete;
+
+    void record(size_t profile, const char* operation, std::string message) {
+      errors_.push_back(Error{profile, operation, std::move(message)});
+    }
+
+    // Call func(), recording any exception it throws; returns false if it threw
+    template <typename F>
+    bool guard(size_t profile, const char* operation, F&& func) {
+      try {
+        std::forward<F>(func)();
+        return true;
+      } catch (const std::exception& e) {
+        record(profile, operation, e.what());
+      } catch (...) {
+        record(profile, operation, "Unknown exception");
+      }
+      return false;
+    }
+
+    size_t size() const {
+      return errors_.size();
+    }
+
+   private:
+    RunErrorContext& context_;
+    std::vector<Error> errors_{};
+  };
+
+  RunErrorContext() = default;
+  RunErrorContext(const RunErrorContext&) = delete;
+  RunErrorContext& operator=(const RunErrorContext&) = delete;
+
+  // Record a single error from any thread (locks; use a Collector in loops)
+  void record(size_t profile, const char* operation, std::string message);
+
+  size_t errorCount() const;
+
+  // Take every error collected so far, ordered by profile and then by recording order
+  std::vector<Error> takeErrors();
+
+  /**
+   * Log every collected error as a warning, in profile order, to the console
+   * and to logger if given (main thread). The context is empty afterwards.
+   * @return Number of errors reported
+   */
+  size_t report(const Adapters::ILogger* logger = nullptr);
+
+  // "Exception in vcarve for profile 3: message"
+  static std::string describe(const Error& error);
+
+ private:
+  void merge(std::vector<Error>& errors);
+
+  mutable std::mutex mutex_;
+  std::vector<Error> errors_{};
+};
+
+}  // namespace Utils
+}  // namespace ChipCarving
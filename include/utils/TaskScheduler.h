@@ -0,0 +1,139 @@
+/**
+ * TaskScheduler.h
+ *
+ * Work-stealing pool for batches of independent tasks with very different
+ * costs, such as medial axes of 40-vertex leaves next to 20k-vertex lettering.
+ * Tasks carry an estimated cost; each worker keeps its own queue in descending
+ * cost order, takes its largest task first and, when it runs dry, steals the
+ * largest task from another worker's queue. Submitted tasks are dealt out
+ * largest-first, so the big outlines start immediately instead of last.
+ *
+ * A running task may split itself: it spawns subtasks into a TaskGroup, which
+ * idle workers steal, and waits for them, running its own group's subtasks in
+ * the meantime. Every task's run time is recorded next to its estimate so the
+ * cost model can be refitted from real runs (fitSecondsPerCost()).
+ *
+ * Worker threads bind the creating thread's trace recorder and run with
+ * console logging suppressed, like the other geometry worker pools.
+ */
+
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace ChipCarving {
+namespace Utils {
+
+class TaskScheduler {
+ public:
+  using Task = std::function<void()>;
+
+  struct TaskTiming {
+    double cost = 0.0;      // Estimate given at submit() or spawn()
+    double seconds = 0.0;   // Run time, excluding subtasks the task ran while waiting
+    bool spawned = false;   // A TaskGroup subtask rather than a submitted task
+  };
+
+  // Subtasks of the running task; create and wait on the worker thread that runs it
+  class TaskGroup {
+   public:
+    // @throws std::logic_error when not called from inside a task
+    TaskGroup();
+    ~TaskGroup();
+
+    TaskGroup(const TaskGroup&) = delete;
+    TaskGroup& operator=(const TaskGroup&) = delete;
+
+    void spawn(double cost, Task task);
+
+    /**
+     * Block until every spawned subtask has finished. The waiting worker only
+     * runs this group's subtasks, so the task's own per-worker state is never
+     * re-entered by an unrelated task.
+     */
+    void wait();
+
+   private:
+    friend class TaskScheduler;
+    TaskScheduler& scheduler_;
+    size_t worker_;
+    std::atomic<size_t> remaining_{0};
+  };
+
+  // @param workers Worker thread count (at least 1)
+  explicit TaskScheduler(int workers);
+  ~TaskScheduler();
+
+  TaskScheduler(const TaskScheduler&) = delete;
+  TaskScheduler& operator=(const TaskScheduler&) = delete;
+
+  // Queue a task for the next run()
+  void submit(double cost, Task task);
+
+  /**
+   * Run every submitted task, and everything they spawn, on the worker threads
+   * and wait for them. The first exception a task throws is rethrown here once
+   * all tasks have finished.
+   */
+  void run();
+
+  // Timings of the last run(), in no particular order
+  const std::vector<TaskTiming>& timings() const {
+    return timings_;
+  }
+
+  int workerCount() const {
+    return static_cast<int>(workers_.size());
+  }
+
+  // Index of the calling scheduler worker thread, or -1 on any other thread
+  static int currentWorkerIndex();
+
+  /**
+   * Least-squares seconds per cost unit over timings (a line through the
+   * origin), for recalibrating a cost estimate from a run
+   * @return 0 if no timing has a positive cost
+   */
+  static double fitSecondsPerCost(const std::vector<TaskTiming>& timings);
+
+ private:
+  struct Entry {
+    double cost = 0.0;
+    Task task{};
+    TaskGroup* group = nullptr;
+  };
+
+  struct Worker {
+    std::mutex mutex;
+    std::deque<Entry> tasks{};  // Descending cost
+    std::vector<TaskTiming> timings{};
+  };
+
+  void push(size_t worker, Entry entry);
+  // Largest task of worker's queue, then of the others; only group's tasks if group is set
+  bool take(size_t worker, const TaskGroup* group, Entry& entry);
+  void execute(size_t worker, Entry& entry);
+  void workerLoop(size_t worker);
+
+  std::vector<std::unique_ptr<Worker>> workers_;
+  std::vector<Entry> submitted_{};
+  std::vector<TaskTiming> timings_{};
+
+  std::atomic<size_t> unfinished_{0};
+  std::mutex wakeMutex_;
+  std::condition_variable wake_;
+
+  std::mutex errorMutex_;
+  std::exception_ptr firstError_{};
+};
+
+}  // namespace Utils
+}  // namespace ChipCarving
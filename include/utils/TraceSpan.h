@@ -0,0 +1,241 @@
+/**
+ * TraceSpan.h
+ *
+ * Scoped timing spans aggregated into a per-run metrics tree.
+ * A run binds a RunMetrics to the calling thread with ScopedRunMetrics; each
+ * TraceSpan then nests under whichever span is open on that thread. Repeated
+ * spans with the same name under the same parent merge into one node (count,
+ * total, max), so per-call spans in hot adapter methods stay cheap.
+ *
+ * A run may also bind a TraceRecorder, which keeps every span and counter
+ * update with its thread and timestamps for export as a Chrome Trace Event
+ * file (chrome://tracing, ui.perfetto.dev). Worker threads bind only the
+ * recorder (ScopedTraceRecorder); with nothing bound a span does nothing,
+ * unless native profiler annotations are on (utils/PlatformTrace.h).
+ *
+ * In builds that count allocations (utils/AllocationTracking.h) each span
+ * also totals what its thread allocated while it was open, children included.
+ * Each span keeps the process's peak resident and live heap bytes while it
+ * was open (utils/MemoryUsage.h); resident peaks need a MemorySampler running.
+ * Fusion API calls timed with utils/ApiCallTimer.h are totalled per kind
+ * under the innermost span open when they were made.
+ */
+
+#pragma once
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "utils/AllocationTracking.h"
+#include "utils/ApiCallTimer.h"
+#include "utils/MemoryUsage.h"
+
+namespace ChipCarving {
+namespace Utils {
+
+class RunMetrics {
+ public:
+  static constexpr size_t NO_PARENT = static_cast<size_t>(-1);
+
+  struct Span {
+    const char* name = "";     // String literal given to TraceSpan
+    size_t parent = NO_PARENT;  // Index into spans()
+    size_t count = 0;
+    double totalMs = 0.0;
+    double maxMs = 0.0;
+    uint64_t allocations = 0;     // Zero unless allocationTrackingEnabled()
+    uint64_t allocatedBytes = 0;
+    uint64_t peakResidentBytes = 0;  // Highest over its calls; zero without a MemorySampler
+    uint64_t peakLiveBytes = 0;      // Zero unless allocationTrackingEnabled()
+  };
+
+  // Fusion API calls of one kind made while span was the innermost open span
+  struct ApiCalls {
+    size_t span = NO_PARENT;  // NO_PARENT for calls made outside every span
+    ApiCallKind kind = ApiCallKind::Call;
+    ApiCallTotals totals{};
+  };
+
+  // Spans in first-opened order; parents always precede their children
+  const std::vector<Span>& spans() const {
+    return spans_;
+  }
+
+  // Slash-separated path from the root, e.g. "generatePaths/vcarve/fusion.addSpline3D"
+  std::string pathOf(size_t index) const;
+
+  // Span with the given path, or nullptr
+  const Span* find(const std::string& path) const;
+
+  // API call totals in first-made order; children's calls are not included in their parents'
+  const std::vector<ApiCalls>& apiCalls() const {
+    return apiCalls_;
+  }
+
+  // Calls of one kind over the whole run
+  ApiCallTotals apiCallTotals(ApiCallKind kind) const;
+
+  /**
+   * One-line JSON object for machine analysis:
+   * {"unixTime":...,"spans":[{"path":"...","count":N,"totalMs":T,"maxMs":M},...]}
+   * with "allocations", "allocatedBytes" and "peakLiveBytes" per span when tracking allocations,
+   * "peakResidentBytes" for spans that ran while memory was sampled, and an
+   * "apiCalls" array of {"path","kind","count","totalMs"} when Fusion API calls were made
+   */
+  std::string toJson() const;
+
+  // Indented tree with counts, times, allocations and memory peaks, then API calls per stage, for the log
+  std::string summary() const;
+
+  /**
+   * Append toJson() as one line of a JSON-lines file
+   * @return false if the file could not be written
+   */
+  bool appendTo(const std::string& filePath) const;
+
+  bool empty() const {
+    return spans_.empty();
+  }
+  void clear();
+
+ private:
+  friend class TraceSpan;
+  friend class ApiCallTimer;
+
+  size_t open(const char* name);
+  void close(size_t index, double elapsedMs, const AllocationTotals& allocated, const MemoryPeaks& memory);
+  void addApiCalls(ApiCallKind kind, uint64_t count, double elapsedMs);
+  std::string apiCallsJson() const;
+  std::string apiCallsSummary() const;
+
+  std::vector<Span> spans_{};
+  std::vector<ApiCalls> apiCalls_{};
+  size_t current_ = NO_PARENT;
+  long long unixTime_ = 0;  // Set when the first span opens
+};
+
+/**
+ * Timeline of one run in Chrome Trace Event format (safe to feed from any thread)
+ */
+class TraceRecorder {
+ public:
+  // Caps memory on runs with millions of surface queries; later events are counted, not kept
+  static constexpr size_t MAX_EVENTS = 1000000;
+
+  // The constructing thread is listed first, as the command thread
+  TraceRecorder();
+
+  void recordSpan(const char* name, std::chrono::steady_clock::time_point start,
+                  std::chrono::steady_clock::time_point end);
+
+  // Add delta to a running counter and record its new value
+  void addToCounter(const char* name, double delta);
+
+  size_t eventCount() const;
+  size_t droppedCount() const;
+
+  // JSON object with a traceEvents array; timestamps are microseconds from construction
+  std::string toJson() const;
+
+  /**
+   * Write toJson() to a file, replacing it
+   * @return false if the file could not be written
+   */
+  bool writeTo(const std::string& filePath) const;
+
+ private:
+  struct Event {
+    const char* name;
+    char phase;  // 'X' complete span, 'C' counter
+    size_t thread;
+    double timestampUs;
+    double value;  // Duration in microseconds for spans, counter value for counters
+  };
+
+  // Index of the calling thread in threads_; mutex_ must be held
+  size_t threadIndex();
+  double sinceOrigin(std::chrono::steady_clock::time_point time) const;
+  void append(const Event& event);
+
+  mutable std::mutex mutex_{};
+  std::chrono::steady_clock::time_point origin_{};
+  std::vector<Event> events_{};
+  std::vector<std::thread::id> threads_{};
+  std::vector<std::pair<const char*, double>> counters_{};
+  size_t dropped_ = 0;
+};
+
+/**
+ * Binds metrics (and optionally a trace recorder) to the calling thread for the
+ * lifetime of the object (restores the previous binding, so runs may nest)
+ */
+class ScopedRunMetrics {
+ public:
+  explicit ScopedRunMetrics(RunMetrics& metrics, TraceRecorder* recorder = nullptr);
+  ~ScopedRunMetrics();
+
+  ScopedRunMetrics(const ScopedRunMetrics&) = delete;
+  ScopedRunMetrics& operator=(const ScopedRunMetrics&) = delete;
+
+ private:
+  RunMetrics* previousMetrics_;
+  TraceRecorder* previousRecorder_;
+};
+
+/**
+ * Binds only a trace recorder, for worker threads of a traced run
+ * (nullptr leaves the thread untraced)
+ */
+class ScopedTraceRecorder {
+ public:
+  explicit ScopedTraceRecorder(TraceRecorder* recorder);
+  ~ScopedTraceRecorder();
+
+  ScopedTraceRecorder(const ScopedTraceRecorder&) = delete;
+  ScopedTraceRecorder& operator=(const ScopedTraceRecorder&) = delete;
+
+ private:
+  TraceRecorder* previous_;
+};
+
+// Metrics bound to the calling thread, or nullptr
+RunMetrics* currentRunMetrics();
+
+// Recorder bound to the calling thread, or nullptr; hand it to worker threads
+TraceRecorder* currentTraceRecorder();
+
+// Add to a named trace counter (points inserted, splines created, ...); no-op when untraced
+void traceCount(const char* name, double delta = 1.0);
+
+/**
+ * Times its own scope into the thread's bound RunMetrics
+ */
+class TraceSpan {
+ public:
+  // name must outlive the run (use string literals)
+  explicit TraceSpan(const char* name);
+  ~TraceSpan();
+
+  TraceSpan(const TraceSpan&) = delete;
+  TraceSpan& operator=(const TraceSpan&) = delete;
+
+ private:
+  const char* name_;
+  RunMetrics* metrics_;
+  TraceRecorder* recorder_;
+  bool platform_;  // Opened a native profiler interval
+  uint64_t platformToken_ = 0;
+  size_t index_ = RunMetrics::NO_PARENT;
+  std::chrono::steady_clock::time_point start_{};
+  AllocationTotals startAllocations_{};
+  MemoryPeaks enclosingMemory_{};
+};
+
+}  // namespace Utils
+}  // namespace ChipCarving
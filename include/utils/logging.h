@@ -1,5 +1,6 @@
 #pragma once
 
+#include <functional>
 #include <sstream>
 #include <string>
 
@@ -9,7 +10,8 @@
 enum class LogLevel { LOG_DEBUG = 0, INFO = 1, WARNING = 2, ERROR = 3 };
 
 /**
- * Log a message to the Fusion 360 Text Commands window
+ * Log a message to the Fusion 360 Text Commands window. Off the main thread
+ * the line is queued and written by the next FlushQueuedConsoleLog().
  */
 void LogToConsole(const std::string& message);
 
@@ -28,6 +30,26 @@ void SetMinLogLevel(LogLevel level);
  */
 LogLevel GetMinLogLevel();
 
+/**
+ * Suppress console output for the calling thread only
+ * Batch workers silence themselves so per-profile chatter stays out of the palette
+ */
+void SetThreadConsoleLoggingSuppressed(bool suppressed);
+
+/**
+ * Make the calling thread the one that writes to the palette. Other threads'
+ * lines are queued, and wakeMainThread runs (on the logging thread) when the
+ * queue goes from empty to non-empty; it must only schedule the main thread,
+ * e.g. by firing a custom event whose handler calls FlushQueuedConsoleLog().
+ * An empty function writes what is still queued and stops queueing.
+ */
+void SetConsoleLogMainThread(std::function<void()> wakeMainThread);
+
+/**
+ * Write lines queued by other threads (main thread only)
+ */
+void FlushQueuedConsoleLog();
+
 // Conditional debug logging macros
 #ifdef DEBUG
 #define LOG_DEBUG(msg)                                                                 \
@@ -10,8 +10,14 @@
 
 #include <fstream>
 #include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
 
 #include "IFusionInterface.h"
+#include "geometry/SurfaceMeshBVH.h"
+#include "utils/AsyncLogWriter.h"
 
 namespace ChipCarving {
 namespace Adapters {
@@ -22,7 +28,12 @@ namespace Adapters {
  */
 class FusionLogger : public ILogger {
  public:
-  explicit FusionLogger(const std::string& logFilePath);
+  /**
+   * @param asyncWrites Hand preformatted records to a background writer thread
+   *        (flushed on errors and shutdown) instead of writing and flushing
+   *        every line on the calling thread
+   */
+  explicit FusionLogger(const std::string& logFilePath, bool asyncWrites = true);
   ~FusionLogger() override;
 
   void logInfo(const std::string& message) const override;
@@ -32,13 +43,21 @@ class FusionLogger : public ILogger {
 
  private:
   mutable std::ofstream logFile_{};
+  mutable std::mutex fileMutex_{};  // Serializes synchronous writes from any thread
   std::string logFilePath_{};
 
+  // Destroyed in the destructor body, before the file it writes to
+  std::unique_ptr<Utils::AsyncLogWriter> asyncWriter_{};
+
   void writeLog(const std::string& message, const std::string& level) const;
+  void writeRecord(const std::string& record) const;
   void rotateLogFile();
   void checkAndRotateIfNeeded();
 };
 
+// Custom event fired by notifyMainThread(); the add-in registers its handler at startup
+constexpr const char* GENERATION_PROGRESS_EVENT_ID = "ChipCarvingGenerationProgress";
+
 /**
  * Fusion 360 user interface implementation
  * Wraps Fusion UI operations
@@ -50,6 +69,7 @@ class FusionUserInterface : public IUserInterface {
 
   void showMessageBox(const std::string& title, const std::string& message) override;
   std::string showFileDialog(const std::string& title, const std::string& filter) override;
+  std::vector<std::string> showMultiFileDialog(const std::string& title, const std::string& filter) override;
   std::string selectJsonFile() override;
   bool confirmAction(const std::string& message) override;
 
@@ -58,8 +78,17 @@ class FusionUserInterface : public IUserInterface {
   SketchSelection showSketchSelectionDialog(const std::string& title) override;
   void updateSelectionCount(int count) override;
 
+  // Background job progress
+  void showProgress(const std::string& title, const std::string& message, int maximum) override;
+  void updateProgress(const std::string& message, int value, int maximum) override;
+  bool wasProgressCancelled() override;
+  void hideProgress() override;
+  void notifyMainThread() override;
+  void showRunReport(const std::string& report) override;
+
  private:
   adsk::core::Ptr<adsk::core::UserInterface> ui_{};
+  adsk::core::Ptr<adsk::core::ProgressDialog> progressDialog_{};
 };
 
 /**
@@ -80,7 +109,10 @@ class FusionSketch : public ISketch {
   bool addArcByThreePointsToSketch(int startPointIndex, int midPointIndex, int endPointIndex) override;
   bool addLineByTwoPointsToSketch(int startPointIndex, int endPointIndex) override;
   bool deleteSketchPoint(int pointIndex) override;
+  int addOutlineBatch(const Geometry::ShapeOutlineBatch& batch) override;
   void finishSketch() override;
+  void beginBulkEdit() override;
+  void endBulkEdit() override;
 
   // Construction geometry methods
   bool addConstructionLine(double x1, double y1, double x2, double y2) override;
@@ -90,13 +122,32 @@ class FusionSketch : public ISketch {
 
   // 3D sketch methods for V-carve toolpaths
   bool addSpline3D(const std::vector<Geometry::Point3D>& points) override;
+  bool addPolyline3D(const std::vector<Geometry::Point3D>& points,
+                     const std::vector<Geometry::PolylineSpan>& spans) override;
+  std::vector<bool> addSplines3D(const std::vector<std::vector<Geometry::Point3D>>& paths) override;
+  std::vector<bool> addPolylines3D(const std::vector<std::vector<Geometry::Point3D>>& paths,
+                                   const std::vector<std::vector<Geometry::PolylineSpan>>& spans) override;
   bool addLine3D(double x1, double y1, double z1, double x2, double y2, double z2) override;
   bool addPoint3D(double x, double y, double z) override;
 
   // Get 3D toolpath curves for solid operations
   std::vector<std::string> getSketchCurveEntityIds() override;
 
+  // Incremental regeneration tags
+  void setCurveTag(const std::string& tag, const std::string& sourceToken) override;
+  std::vector<std::string> getCurveTags() override;
+  int deleteCurvesWithTag(const std::string& tag) override;
+
+  const adsk::core::Ptr<adsk::fusion::Sketch>& nativeSketch() const {
+    return sketch_;
+  }
+
  private:
+  // Attach the current curve tag, if any, to a curve just added
+  void tagCurve(const adsk::core::Ptr<adsk::fusion::SketchCurve>& curve);
+  void tagCurve(const adsk::core::Ptr<adsk::fusion::SketchCurve>& curve, const std::string& tag,
+                const std::string& sourceToken);
+
   std::string name_{};
   adsk::core::Ptr<adsk::core::Application> app_{};
   adsk::core::Ptr<adsk::fusion::Sketch> sketch_{};
@@ -106,6 +157,31 @@ class FusionSketch : public ISketch {
   std::vector<adsk::core::Ptr<adsk::fusion::SketchLine>> constructionLines_{};
   std::vector<adsk::core::Ptr<adsk::fusion::SketchCircle>> constructionCircles_{};
   std::vector<adsk::core::Ptr<adsk::fusion::SketchPoint>> constructionPoints_{};
+
+  // Bulk edit nesting and the compute-deferred state to restore afterwards
+  int bulkEditDepth_ = 0;
+  bool computeWasDeferred_ = false;
+
+  std::string curveTag_{};
+  std::string curveSourceToken_{};
+};
+
+/**
+ * Fusion 360 custom graphics implementation
+ * Adds line and point buffers to one custom graphics group
+ */
+class FusionCustomGraphics : public ICustomGraphics {
+ public:
+  FusionCustomGraphics(const adsk::core::Ptr<adsk::core::Application>& app,
+                       const adsk::core::Ptr<adsk::fusion::CustomGraphicsGroup>& group);
+  ~FusionCustomGraphics() override = default;
+
+  bool addLineStrips(const std::vector<std::vector<Geometry::Point3D>>& strips, Role role) override;
+  bool addPointSet(const std::vector<Geometry::Point3D>& points, Role role) override;
+
+ private:
+  adsk::core::Ptr<adsk::core::Application> app_{};
+  adsk::core::Ptr<adsk::fusion::CustomGraphicsGroup> group_{};
 };
 
 /**
@@ -122,10 +198,14 @@ class FusionWorkspace : public IWorkspace {
   std::unique_ptr<ISketch> createSketchInTargetComponent(const std::string& name,
                                                          const std::string& surfaceEntityId) override;
   std::unique_ptr<ISketch> findSketch(const std::string& name) override;
+  std::unique_ptr<ISketch> resetSketch(std::unique_ptr<ISketch> sketch, const std::string& planeEntityId,
+                                       size_t recreateAbove) override;
+  bool deleteSketch(const std::string& name, const std::string& planeEntityId) override;
   std::vector<std::string> getAllSketchNames() override;
+  SketchSelection getSketchProfiles(const std::string& sketchName) override;
 
   // Enhanced UI Phase 5.2: Profile geometry extraction
-  bool extractProfileVertices(const std::string& entityId, std::vector<std::pair<double, double>>& vertices,
+  bool extractProfileVertices(const std::string& entityId, std::vector<Geometry::Point2D>& vertices,
                               TransformParams& transform) override;
 
   // Extract plane entity ID from a profile's parent sketch
@@ -136,10 +216,84 @@ class FusionWorkspace : public IWorkspace {
 
   // Surface query methods for projection
   double getSurfaceZAtXY(const std::string& surfaceId, double x, double y) override;
+  std::vector<double> getSurfaceZBatch(const std::string& surfaceId, const std::vector<Geometry::Point2D>& points,
+                                       bool useFaceEvaluator) override;
+
+  void beginEntityLookupSession() override;
+  void endEntityLookupSession() override;
+  void invalidateEntityLookups() override;
+
+  // One timeline group per outermost session; a base feature edit for direct-edit output
+  void beginOutputSession(const std::string& name, bool directEdit) override;
+  void endOutputSession() override;
+
+  // Named custom graphics groups in the root component
+  std::unique_ptr<ICustomGraphics> createCustomGraphics(const std::string& name) override;
+  void removeCustomGraphics(const std::string& name) override;
 
  private:
   adsk::core::Ptr<adsk::core::Application> app_{};
 
+  // Token -> entities resolved in the open lookup session, valid for entityIndexDesign_ only
+  int entityLookupDepth_ = 0;
+  adsk::core::Ptr<adsk::fusion::Design> entityIndexDesign_{};
+  std::unordered_map<std::string, std::vector<adsk::core::Ptr<adsk::core::Base>>> entityTokenIndex_{};
+
+  // Mesh body hierarchies by entity token, built once from the display mesh and
+  // rebuilt when its node or triangle count changes; dropped with the token index
+  struct MeshHierarchy {
+    size_t nodeCount = 0;
+    size_t triangleCount = 0;
+    std::shared_ptr<const Geometry::SurfaceMeshBVH> bvh{};
+  };
+  std::unordered_map<std::string, MeshHierarchy> meshHierarchies_{};
+  std::shared_ptr<const Geometry::SurfaceMeshBVH> meshHierarchy(const adsk::core::Ptr<adsk::fusion::MeshBody>& body);
+
+  // End of the outermost lookup session: the token index and mesh hierarchies go
+  void dropEntityTokenIndex();
+
+  // Sketch setup resolved across runs for sessionCacheDesign_, dropped only by
+  // invalidateEntityLookups() (document events); entries are used while isValid()
+  struct ProfilePlane {
+    adsk::core::Ptr<adsk::fusion::Profile> profile{};
+    std::string planeToken{};
+  };
+  adsk::core::Ptr<adsk::fusion::Design> sessionCacheDesign_{};
+  // Keyed by profile token, plane token, surface token and sketch name respectively
+  std::unordered_map<std::string, ProfilePlane> profilePlanes_{};
+  std::unordered_map<std::string, adsk::core::Ptr<adsk::core::Base>> sketchPlanes_{};
+  std::unordered_map<std::string, adsk::core::Ptr<adsk::fusion::Component>> targetComponents_{};
+  std::unordered_map<std::string, adsk::core::Ptr<adsk::fusion::Sketch>> rootSketches_{};
+
+  // Clear the session cache when design is not the one it was filled for
+  void useSessionCache(const adsk::core::Ptr<adsk::fusion::Design>& design);
+  void clearSessionCache();
+  void rememberRootSketch(const std::string& name, const adsk::core::Ptr<adsk::fusion::Sketch>& sketch);
+
+  // Entity for a sketch plane token: the session cache, then a token lookup; nullptr if not found
+  adsk::core::Ptr<adsk::core::Base> findSketchPlane(const std::string& planeEntityId);
+
+  // True if resetSketch() and deleteSketch() may touch sketch: a root component sketch on the
+  // plane a run would create it on, outside a direct-edit output session
+  bool isReplaceableOutputSketch(const adsk::core::Ptr<adsk::fusion::Design>& design,
+                                 const adsk::core::Ptr<adsk::fusion::Sketch>& sketch,
+                                 const std::string& planeEntityId);
+
+  // Delete sketch and add an empty one of the same name on its plane at its place in the timeline
+  adsk::core::Ptr<adsk::fusion::Sketch> recreateSketch(const adsk::core::Ptr<adsk::fusion::Design>& design,
+                                                       const adsk::core::Ptr<adsk::fusion::Sketch>& sketch);
+
+  // Open output session: timeline index of its first item (-1 = nothing to group) and,
+  // for direct-edit output, the base feature whose edit holds its sketches
+  int outputSessionDepth_ = 0;
+  std::string outputSessionName_{};
+  bool outputDirectEdit_ = false;
+  int outputTimelineStart_ = -1;
+  adsk::core::Ptr<adsk::fusion::BaseFeature> outputBaseFeature_{};
+
+  // Call before adding a sketch to component: starts the session's base feature edit there
+  void prepareOutputComponent(const adsk::core::Ptr<adsk::fusion::Component>& component);
+
   // Helper method for getting world geometry of sketch curves
   adsk::core::Ptr<adsk::core::Curve3D> getCurveWorldGeometry(
       const adsk::core::Ptr<adsk::fusion::SketchCurve>& sketchCurve);
@@ -0,0 +1,161 @@
+/**
+ * FusionCustomGraphics.cpp
+ *
+ * Named custom graphics groups for visualizations and the Generate Paths
+ * preview. Custom graphics are drawn by the viewport only: they are not sketch
+ * entities, add nothing to the timeline or undo history and each buffer is a
+ * single API call however many lines or points it holds.
+ */
+
+#include "FusionAPIAdapter.h"
+#include "utils/logging.h"
+
+using adsk::core::Color;
+using adsk::core::Ptr;
+
+namespace ChipCarving {
+namespace Adapters {
+
+namespace {
+
+constexpr int OPAQUE = 255;
+constexpr float LINE_WEIGHT = 2.0f;       // Pixels
+constexpr float THIN_LINE_WEIGHT = 1.0f;  // Pixels, for the clearance circles that overlap each other
+
+// Apart from sketch and construction colors, and from each other
+Ptr<Color> roleColor(ICustomGraphics::Role role) {
+  switch (role) {
+    case ICustomGraphics::Role::MEDIAL_AXIS:
+      return Color::create(220, 0, 0, OPAQUE);  // Red
+    case ICustomGraphics::Role::CLEARANCE:
+      return Color::create(0, 120, 220, OPAQUE);  // Blue
+    case ICustomGraphics::Role::OUTLINE:
+      return Color::create(0, 160, 60, OPAQUE);  // Green
+    case ICustomGraphics::Role::PREVIEW:
+    default:
+      return Color::create(255, 128, 0, OPAQUE);  // Orange
+  }
+}
+
+void appendCoordinates(const Geometry::Point3D& point, std::vector<double>& coordinates) {
+  coordinates.push_back(point.x);
+  coordinates.push_back(point.y);
+  coordinates.push_back(point.z);
+}
+
+void refreshViewport(const Ptr<adsk::core::Application>& app) {
+  if (app && app->activeViewport()) {
+    app->activeViewport()->refresh();
+  }
+}
+
+Ptr<adsk::fusion::CustomGraphicsGroups> rootGraphicsGroups(const Ptr<adsk::core::Application>& app) {
+  if (!app) {
+    return nullptr;
+  }
+  Ptr<adsk::fusion::Design> design = app->activeProduct();
+  if (!design || !design->rootComponent()) {
+    return nullptr;
+  }
+  return design->rootComponent()->customGraphicsGroups();
+}
+
+}  // namespace
+
+FusionCustomGraphics::FusionCustomGraphics(const Ptr<adsk::core::Application>& app,
+                                           const Ptr<adsk::fusion::CustomGraphicsGroup>& group)
+    : app_(app), group_(group) {}
+
+bool FusionCustomGraphics::addLineStrips(const std::vector<std::vector<Geometry::Point3D>>& strips, Role role) {
+  // One line strip per polyline, all in a single coordinate buffer
+  std::vector<double> coordinates;
+  std::vector<int> stripLengths;
+  for (const auto& strip : strips) {
+    if (strip.size() < 2) {
+      continue;
+    }
+    for (const auto& point : strip) {
+      appendCoordinates(point, coordinates);
+    }
+    stripLengths.push_back(static_cast<int>(strip.size()));
+  }
+  if (stripLengths.empty()) {
+    return true;
+  }
+
+  Ptr<adsk::fusion::CustomGraphicsCoordinates> graphicsCoordinates =
+      adsk::fusion::CustomGraphicsCoordinates::create(coordinates);
+  Ptr<adsk::fusion::CustomGraphicsLines> lines =
+      group_ ? group_->addLines(graphicsCoordinates, std::vector<int>(), true, stripLengths) : nullptr;
+  if (!lines) {
+    LOG_ERROR("customGraphicsGroup.addLines failed for " << stripLengths.size() << " strips");
+    return false;
+  }
+  lines->color(adsk::fusion::CustomGraphicsSolidColorEffect::create(roleColor(role)));
+  lines->weight(role == Role::CLEARANCE ? THIN_LINE_WEIGHT : LINE_WEIGHT);
+  refreshViewport(app_);
+  return true;
+}
+
+bool FusionCustomGraphics::addPointSet(const std::vector<Geometry::Point3D>& points, Role role) {
+  if (points.empty()) {
+    return true;
+  }
+  std::vector<double> coordinates;
+  coordinates.reserve(points.size() * 3);
+  for (const auto& point : points) {
+    appendCoordinates(point, coordinates);
+  }
+
+  Ptr<adsk::fusion::CustomGraphicsCoordinates> graphicsCoordinates =
+      adsk::fusion::CustomGraphicsCoordinates::create(coordinates);
+  Ptr<adsk::fusion::CustomGraphicsPointSet> pointSet =
+      group_ ? group_->addPointSet(graphicsCoordinates, std::vector<int>(),
+                                   adsk::fusion::PointCloudCustomGraphicsPointType, "")
+             : nullptr;
+  if (!pointSet) {
+    LOG_ERROR("customGraphicsGroup.addPointSet failed for " << points.size() << " points");
+    return false;
+  }
+  pointSet->color(adsk::fusion::CustomGraphicsSolidColorEffect::create(roleColor(role)));
+  refreshViewport(app_);
+  return true;
+}
+
+std::unique_ptr<ICustomGraphics> FusionWorkspace::createCustomGraphics(const std::string& name) {
+  removeCustomGraphics(name);
+  Ptr<adsk::fusion::CustomGraphicsGroups> groups = rootGraphicsGroups(app_);
+  if (!groups) {
+    return nullptr;
+  }
+  Ptr<adsk::fusion::CustomGraphicsGroup> group = groups->add();
+  if (!group) {
+    logApiError("customGraphicsGroups.add");
+    return nullptr;
+  }
+  // The id finds the group again to replace or remove it, also after a reload of the add-in
+  group->id(name);
+  return std::make_unique<FusionCustomGraphics>(app_, group);
+}
+
+void FusionWorkspace::removeCustomGraphics(const std::string& name) {
+  Ptr<adsk::fusion::CustomGraphicsGroups> groups = rootGraphicsGroups(app_);
+  if (!groups) {
+    return;
+  }
+  bool removed = false;
+  // Backwards, as deleting a group shifts the ones after it
+  for (size_t i = groups->count(); i-- > 0;) {
+    Ptr<adsk::fusion::CustomGraphicsGroup> group = groups->item(i);
+    if (group && group->id() == name) {
+      group->deleteMe();
+      removed = true;
+    }
+  }
+  if (removed) {
+    refreshViewport(app_);
+  }
+}
+
+}  // namespace Adapters
+}  // namespace ChipCarving
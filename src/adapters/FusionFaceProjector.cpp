@@ -0,0 +1,111 @@
+/**
+ * FusionFaceProjector.cpp
+ *
+ * Warm-started Newton projection onto a BRepFace via SurfaceEvaluator
+ * Split from FusionWorkspaceCurveSurface.cpp for maintainability
+ */
+
+#include "FusionFaceProjector.h"
+
+#include <cmath>
+
+#include "utils/ApiCallTimer.h"
+#include "utils/UnitConversion.h"
+
+using adsk::core::Ptr;
+using ChipCarving::Utils::ApiCallKind;
+using ChipCarving::Utils::timedApiCall;
+
+namespace ChipCarving {
+namespace Adapters {
+
+namespace {
+
+// Newton iterations before giving up on a warm start (coherent queries need 1-2)
+constexpr int MAX_NEWTON_ITERATIONS = 8;
+
+// Jacobian determinant below which the face is treated as vertical at this point
+constexpr double MIN_JACOBIAN_DETERMINANT = 1e-12;
+
+}  // namespace
+
+FusionFaceProjector::FusionFaceProjector(const Ptr<adsk::fusion::BRepFace>& face) {
+  if (!face) {
+    return;
+  }
+  evaluator_ = face->evaluator();
+
+  // Seeds start above the face so the closest point lands on its top side
+  Ptr<adsk::core::BoundingBox3D> box = face->boundingBox();
+  if (box && box->maxPoint()) {
+    seedZ_ = box->maxPoint()->z() + 1.0;
+  }
+}
+
+bool FusionFaceProjector::seed(double x, double y) {
+  Ptr<adsk::core::Point3D> above =
+      timedApiCall(ApiCallKind::ObjectCreate, [&] { return adsk::core::Point3D::create(x, y, seedZ_); });
+  Ptr<adsk::core::Point2D> parameter;
+  if (!above || !evaluator_->getParameterAtPoint(above, parameter) || !parameter) {
+    hasParameter_ = false;
+    return false;
+  }
+  parameter_ = parameter;
+  hasParameter_ = true;
+  return true;
+}
+
+bool FusionFaceProjector::project(double x, double y, double& z) {
+  if (!evaluator_) {
+    return false;
+  }
+
+  // Warm start from the previous query; re-seed once if that fails to converge
+  bool warm = hasParameter_;
+  for (int attempt = 0; attempt < (warm ? 2 : 1); ++attempt) {
+    if ((!warm || attempt > 0) && !seed(x, y)) {
+      return false;
+    }
+
+    double u = parameter_->x();
+    double v = parameter_->y();
+    for (int iteration = 0; iteration < MAX_NEWTON_ITERATIONS; ++iteration) {
+      Ptr<adsk::core::Point2D> parameter =
+          timedApiCall(ApiCallKind::ObjectCreate, [u, v] { return adsk::core::Point2D::create(u, v); });
+      Ptr<adsk::core::Point3D> point;
+      if (!parameter || !evaluator_->getPointAtParameter(parameter, point) || !point) {
+        break;
+      }
+
+      double rx = x - point->x();
+      double ry = y - point->y();
+      if (std::hypot(rx, ry) < Utils::Tolerance::RAY_CASTING) {
+        if (!evaluator_->isParameterOnFace(parameter)) {
+          return false;
+        }
+        parameter_ = parameter;
+        z = point->z();
+        return true;
+      }
+
+      // Solve [Su.xy Sv.xy] * (du, dv) = residual
+      Ptr<adsk::core::Vector3D> partialU;
+      Ptr<adsk::core::Vector3D> partialV;
+      if (!evaluator_->getFirstDerivative(parameter, partialU, partialV) || !partialU || !partialV) {
+        break;
+      }
+      double det = partialU->x() * partialV->y() - partialV->x() * partialU->y();
+      if (std::abs(det) < MIN_JACOBIAN_DETERMINANT) {
+        break;
+      }
+      u += (rx * partialV->y() - ry * partialV->x()) / det;
+      v += (partialU->x() * ry - partialU->y() * rx) / det;
+    }
+  }
+
+  hasParameter_ = false;
+  return false;
+}
+
+}  // namespace Adapters
+}  // namespace ChipCarving
@@ -0,0 +1,49 @@
+/**
+ * FusionFaceProjector.h
+ *
+ * Vertical projection onto a single BRepFace using its SurfaceEvaluator
+ * Split from FusionWorkspaceCurveSurface.cpp for maintainability
+ */
+
+#pragma once
+
+#include <Core/CoreAll.h>
+#include <Fusion/FusionAll.h>
+
+namespace ChipCarving {
+namespace Adapters {
+
+/**
+ * Finds the face point directly above or below an XY location by Newton
+ * iteration in the face's (u, v) parameter space. Each query is seeded with the
+ * previous query's parameters, so spatially coherent queries (consecutive
+ * samples along a path, grid rows) converge in one or two iterations instead of
+ * a full BRep ray query.
+ */
+class FusionFaceProjector {
+ public:
+  explicit FusionFaceProjector(const adsk::core::Ptr<adsk::fusion::BRepFace>& face);
+
+  bool isValid() const {
+    return evaluator_ != nullptr;
+  }
+
+  /**
+   * Project (x, y) vertically onto the face
+   * @param z Output face Z (cm) on success
+   * @return false if Newton did not converge or the solution is off the face
+   */
+  bool project(double x, double y, double& z);
+
+ private:
+  // Closest-point seed from above the face, used for the first query and after a failure
+  bool seed(double x, double y);
+
+  adsk::core::Ptr<adsk::core::SurfaceEvaluator> evaluator_{};
+  adsk::core::Ptr<adsk::core::Point2D> parameter_{};
+  double seedZ_ = 0.0;
+  bool hasParameter_ = false;
+};
+
+}  // namespace Adapters
+}  // namespace ChipCarving
@@ -6,6 +6,7 @@
 
 #include <chrono>
 #include <cstdio>
+#include <ctime>
 #include <iomanip>
 #include <iostream>
 #include <sstream>
@@ -21,8 +22,33 @@ using adsk::core::UserInterface;
 namespace ChipCarving {
 namespace Adapters {
 
+namespace {
+
+// "[HH:MM:SS] " for now; localtime and put_time are reused within the same second
+const std::string& timestampPrefix() {
+  thread_local std::time_t cachedTime = 0;
+  thread_local std::string cachedPrefix;
+
+  std::time_t now = std::chrono::system_clock::to_time_t(std::chrono::system_clock::now());
+  if (now != cachedTime || cachedPrefix.empty()) {
+    std::tm local{};
+#ifdef _WIN32
+    localtime_s(&local, &now);
+#else
+    localtime_r(&now, &local);
+#endif
+    std::ostringstream prefix;
+    prefix << "[" << std::put_time(&local, "%H:%M:%S") << "] ";
+    cachedPrefix = prefix.str();
+    cachedTime = now;
+  }
+  return cachedPrefix;
+}
+
+}  // namespace
+
 // FusionLogger Implementation
-FusionLogger::FusionLogger(const std::string& logFilePath) : logFilePath_(logFilePath) {
+FusionLogger::FusionLogger(const std::string& logFilePath, bool asyncWrites) : logFilePath_(logFilePath) {
   // Log rotation: Move existing log to backup before creating new one
   rotateLogFile();
 
@@ -40,9 +66,17 @@ FusionLogger::FusionLogger(const std::string& logFilePath) : logFilePath_(logFil
     logFile_ << "========================================\n";
     logFile_.flush();
   }
+
+  if (asyncWrites) {
+    asyncWriter_ = std::make_unique<Utils::AsyncLogWriter>([this](const std::string& record) { writeRecord(record); },
+                                                           [this]() { logFile_.flush(); });
+  }
 }
 
 FusionLogger::~FusionLogger() {
+  // Drain and join the writer before touching the file here
+  asyncWriter_.reset();
+
   if (logFile_.is_open()) {
     logFile_ << "========================================\n";
     logFile_ << "SESSION ENDED\n";
@@ -68,22 +102,30 @@ void FusionLogger::logError(const std::string& message) const {
 }
 
 void FusionLogger::writeLog(const std::string& message, const std::string& level) const {
-  // Check and rotate log file if needed before writing
-  const_cast<FusionLogger*>(this)->checkAndRotateIfNeeded();
-
-  auto now = std::chrono::system_clock::now();
-  auto time_t = std::chrono::system_clock::to_time_t(now);
+  std::string fullMessage;
+  const std::string& prefix = timestampPrefix();
+  fullMessage.reserve(prefix.size() + level.size() + message.size() + 3);
+  fullMessage.append(prefix).append("[").append(level).append("] ").append(message);
+
+  if (asyncWriter_) {
+    // Errors are flushed right away so they survive a crash
+    asyncWriter_->push(std::move(fullMessage), level == "ERROR");
+    return;
+  }
 
-  std::stringstream timestampedMessage;
-  timestampedMessage << "[" << std::put_time(std::localtime(&time_t), "%H:%M:%S") << "] "
-                     << "[" << level << "] " << message;
+  // The async writer has one thread of its own; direct writes may come from several
+  std::lock_guard<std::mutex> lock(fileMutex_);
+  writeRecord(fullMessage);
+  logFile_.flush();  // Ensure immediate write
+}
 
-  std::string fullMessage = timestampedMessage.str();
+void FusionLogger::writeRecord(const std::string& fullMessage) const {
+  // Check and rotate log file if needed before writing
+  const_cast<FusionLogger*>(this)->checkAndRotateIfNeeded();
 
   // Write to file with error handling
   if (logFile_.is_open()) {
     logFile_ << fullMessage << '\n';
-    logFile_.flush();  // Ensure immediate write
 
     // Check for write errors
     if (logFile_.fail()) {
@@ -195,6 +237,26 @@ std::string FusionUserInterface::showFileDialog(const std::string& title, const
   return "";
 }
 
+std::vector<std::string> FusionUserInterface::showMultiFileDialog(const std::string& title, const std::string& filter) {
+  if (!ui_) {
+    return {};
+  }
+
+  Ptr<FileDialog> fileDialog = ui_->createFileDialog();
+  if (!fileDialog) {
+    return {};
+  }
+
+  fileDialog->isMultiSelectEnabled(true);
+  fileDialog->title(title);
+  fileDialog->filter(filter);
+
+  if (fileDialog->showOpen() != DialogOK) {
+    return {};
+  }
+  return fileDialog->filenames();
+}
+
 std::string FusionUserInterface::selectJsonFile() {
   return showFileDialog("Select JSON File", "JSON Files (*.json)");
 }
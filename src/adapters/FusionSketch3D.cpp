@@ -7,22 +7,29 @@
 
 #include "FusionAPIAdapter.h"
 #include "geometry/Point3D.h"
+#include "geometry/PolylineArcFitter.h"
+#include "utils/ApiCallTimer.h"
+#include "utils/TraceSpan.h"
 #include "utils/UnitConversion.h"
 
 using adsk::core::ObjectCollection;
 using adsk::core::Point3D;
 using adsk::core::Ptr;
+using ChipCarving::Utils::ApiCallKind;
+using ChipCarving::Utils::timedApiCall;
 
 namespace ChipCarving {
 namespace Adapters {
 
 bool FusionSketch::addSpline3D(const std::vector<Geometry::Point3D>& points) {
+  Utils::TraceSpan span("fusion.addSpline3D");
   if (!sketch_ || points.size() < 2) {
     return false;
   }
 
   // Create 3D points for the spline
-  adsk::core::Ptr<adsk::core::ObjectCollection> point3DCollection = adsk::core::ObjectCollection::create();
+  adsk::core::Ptr<adsk::core::ObjectCollection> point3DCollection =
+      timedApiCall(ApiCallKind::ObjectCreate, [] { return adsk::core::ObjectCollection::create(); });
 
   for (const auto& point : points) {
     // Convert from mm to cm (Fusion's internal units)
@@ -30,9 +37,10 @@ bool FusionSketch::addSpline3D(const std::vector<Geometry::Point3D>& points) {
     double y_cm = Utils::mmToFusionLength(point.y);
     double z_cm = Utils::mmToFusionLength(point.z);
 
-    adsk::core::Ptr<adsk::core::Point3D> fusionPoint = adsk::core::Point3D::create(x_cm, y_cm, z_cm);
+    adsk::core::Ptr<adsk::core::Point3D> fusionPoint =
+        timedApiCall(ApiCallKind::ObjectCreate, [&] { return adsk::core::Point3D::create(x_cm, y_cm, z_cm); });
     if (fusionPoint) {
-      point3DCollection->add(fusionPoint);
+      timedApiCall(ApiCallKind::Call, [&] { return point3DCollection->add(fusionPoint); });
     }
   }
 
@@ -43,13 +51,135 @@ bool FusionSketch::addSpline3D(const std::vector<Geometry::Point3D>& points) {
   // Create the 3D spline curve
   adsk::core::Ptr<adsk::fusion::SketchFittedSplines> splines = sketch_->sketchCurves()->sketchFittedSplines();
   if (splines) {
-    adsk::core::Ptr<adsk::fusion::SketchFittedSpline> spline = splines->add(point3DCollection);
+    adsk::core::Ptr<adsk::fusion::SketchFittedSpline> spline =
+        timedApiCall(ApiCallKind::SketchEntity, [&] { return splines->add(point3DCollection); });
+    if (spline) {
+      Utils::traceCount("splinesCreated");
+      tagCurve(spline);
+    }
     return spline != nullptr;
   }
 
   return false;
 }
 
+namespace {
+
+// Convert from mm to cm (Fusion's internal units)
+Ptr<Point3D> toFusionPoint(const Geometry::Point3D& point) {
+  return timedApiCall(ApiCallKind::ObjectCreate, [&] {
+    return Point3D::create(Utils::mmToFusionLength(point.x), Utils::mmToFusionLength(point.y),
+                           Utils::mmToFusionLength(point.z));
+  });
+}
+
+// The arc end sketch point that sits at the requested end (arcs may be stored reversed)
+Ptr<adsk::fusion::SketchPoint> arcEndPoint(const Ptr<adsk::fusion::SketchArc>& arc, const Ptr<Point3D>& end) {
+  Ptr<adsk::fusion::SketchPoint> endPoint = arc->endSketchPoint();
+  Ptr<adsk::fusion::SketchPoint> startPoint = arc->startSketchPoint();
+  if (endPoint && startPoint && startPoint->geometry() && endPoint->geometry() &&
+      startPoint->geometry()->distanceTo(end) < endPoint->geometry()->distanceTo(end)) {
+    return startPoint;
+  }
+  return endPoint;
+}
+
+}  // namespace
+
+bool FusionSketch::addPolyline3D(const std::vector<Geometry::Point3D>& points,
+                                 const std::vector<Geometry::PolylineSpan>& spans) {
+  if (!sketch_ || points.size() < 2 || spans.empty()) {
+    return false;
+  }
+
+  Ptr<adsk::fusion::SketchLines> lines = sketch_->sketchCurves()->sketchLines();
+  Ptr<adsk::fusion::SketchArcs> arcs = sketch_->sketchCurves()->sketchArcs();
+  if (!lines || !arcs) {
+    return false;
+  }
+
+  // Each curve starts on the previous curve's end sketch point, so the path
+  // stays one connected chain instead of coincident but separate points
+  Ptr<adsk::core::Base> previousEnd = toFusionPoint(points[spans.front().first]);
+  for (const auto& span : spans) {
+    if (span.last >= points.size() || span.last <= span.first) {
+      return false;
+    }
+
+    if (span.isArc) {
+      Ptr<Point3D> mid = toFusionPoint(points[span.mid()]);
+      Ptr<Point3D> end = toFusionPoint(points[span.last]);
+      Ptr<adsk::fusion::SketchArc> arc =
+          timedApiCall(ApiCallKind::SketchEntity, [&] { return arcs->addByThreePoints(previousEnd, mid, end); });
+      if (!arc) {
+        return false;
+      }
+      tagCurve(arc);
+      previousEnd = arcEndPoint(arc, end);
+      continue;
+    }
+
+    for (size_t i = span.first + 1; i <= span.last; ++i) {
+      Ptr<Point3D> end = toFusionPoint(points[i]);
+      Ptr<adsk::fusion::SketchLine> line =
+          timedApiCall(ApiCallKind::SketchEntity, [&] { return lines->addByTwoPoints(previousEnd, end); });
+      if (!line) {
+        return false;
+      }
+      tagCurve(line);
+      previousEnd = line->endSketchPoint();
+    }
+  }
+  return true;
+}
+
+std::vector<bool> FusionSketch::addSplines3D(const std::vector<std::vector<Geometry::Point3D>>& paths) {
+  Utils::TraceSpan span("fusion.addSplines3D");
+  std::vector<bool> created(paths.size(), false);
+  if (!sketch_ || paths.empty()) {
+    return created;
+  }
+  Ptr<adsk::fusion::SketchFittedSplines> splines = sketch_->sketchCurves()->sketchFittedSplines();
+  if (!splines) {
+    return created;
+  }
+
+  // One fit point collection for the whole batch, and one sketch solve at the end
+  SketchBulkEdit bulkEdit(this);
+  Ptr<ObjectCollection> fitPoints = timedApiCall(ApiCallKind::ObjectCreate, [] { return ObjectCollection::create(); });
+  for (size_t i = 0; i < paths.size(); ++i) {
+    fitPoints->clear();
+    for (const auto& point : paths[i]) {
+      Ptr<Point3D> fusionPoint = toFusionPoint(point);
+      if (fusionPoint) {
+        timedApiCall(ApiCallKind::Call, [&] { return fitPoints->add(fusionPoint); });
+      }
+    }
+    if (fitPoints->count() < 2) {
+      continue;
+    }
+    Ptr<adsk::fusion::SketchFittedSpline> spline =
+        timedApiCall(ApiCallKind::SketchEntity, [&] { return splines->add(fitPoints); });
+    if (spline) {
+      Utils::traceCount("splinesCreated");
+      tagCurve(spline);
+      created[i] = true;
+    }
+  }
+  return created;
+}
+
+std::vector<bool> FusionSketch::addPolylines3D(const std::vector<std::vector<Geometry::Point3D>>& paths,
+                                               const std::vector<std::vector<Geometry::PolylineSpan>>& spans) {
+  Utils::TraceSpan span("fusion.addPolylines3D");
+  std::vector<bool> created(paths.size(), false);
+  SketchBulkEdit bulkEdit(this);
+  for (size_t i = 0; i < paths.size() && i < spans.size(); ++i) {
+    created[i] = addPolyline3D(paths[i], spans[i]);
+  }
+  return created;
+}
+
 bool FusionSketch::addLine3D(double x1, double y1, double z1, double x2, double y2, double z2) {
   if (!sketch_) {
     return false;
@@ -64,8 +194,10 @@ bool FusionSketch::addLine3D(double x1, double y1, double z1, double x2, double
   double z2_cm = Utils::mmToFusionLength(z2);
 
   // Create 3D points
-  adsk::core::Ptr<adsk::core::Point3D> startPoint = adsk::core::Point3D::create(x1_cm, y1_cm, z1_cm);
-  adsk::core::Ptr<adsk::core::Point3D> endPoint = adsk::core::Point3D::create(x2_cm, y2_cm, z2_cm);
+  adsk::core::Ptr<adsk::core::Point3D> startPoint =
+      timedApiCall(ApiCallKind::ObjectCreate, [&] { return adsk::core::Point3D::create(x1_cm, y1_cm, z1_cm); });
+  adsk::core::Ptr<adsk::core::Point3D> endPoint =
+      timedApiCall(ApiCallKind::ObjectCreate, [&] { return adsk::core::Point3D::create(x2_cm, y2_cm, z2_cm); });
 
   if (!startPoint || !endPoint) {
     return false;
@@ -74,7 +206,11 @@ bool FusionSketch::addLine3D(double x1, double y1, double z1, double x2, double
   // Create the 3D line
   adsk::core::Ptr<adsk::fusion::SketchLines> lines = sketch_->sketchCurves()->sketchLines();
   if (lines) {
-    adsk::core::Ptr<adsk::fusion::SketchLine> line = lines->addByTwoPoints(startPoint, endPoint);
+    adsk::core::Ptr<adsk::fusion::SketchLine> line =
+        timedApiCall(ApiCallKind::SketchEntity, [&] { return lines->addByTwoPoints(startPoint, endPoint); });
+    if (line) {
+      tagCurve(line);
+    }
     return line != nullptr;
   }
 
@@ -92,7 +228,8 @@ bool FusionSketch::addPoint3D(double x, double y, double z) {
   double z_cm = Utils::mmToFusionLength(z);
 
   // Create 3D point
-  adsk::core::Ptr<adsk::core::Point3D> point3D = adsk::core::Point3D::create(x_cm, y_cm, z_cm);
+  adsk::core::Ptr<adsk::core::Point3D> point3D =
+      timedApiCall(ApiCallKind::ObjectCreate, [&] { return adsk::core::Point3D::create(x_cm, y_cm, z_cm); });
 
   if (!point3D) {
     return false;
@@ -101,7 +238,8 @@ bool FusionSketch::addPoint3D(double x, double y, double z) {
   // Add the 3D point to the sketch
   adsk::core::Ptr<adsk::fusion::SketchPoints> points = sketch_->sketchPoints();
   if (points) {
-    adsk::core::Ptr<adsk::fusion::SketchPoint> sketchPoint = points->add(point3D);
+    adsk::core::Ptr<adsk::fusion::SketchPoint> sketchPoint =
+        timedApiCall(ApiCallKind::SketchEntity, [&] { return points->add(point3D); });
     return sketchPoint != nullptr;
   }
 
@@ -6,11 +6,14 @@
  */
 
 #include "FusionAPIAdapter.h"
+#include "utils/ApiCallTimer.h"
 #include "utils/UnitConversion.h"
 #include "utils/logging.h"
 
 using adsk::core::Point3D;
 using adsk::core::Ptr;
+using ChipCarving::Utils::ApiCallKind;
+using ChipCarving::Utils::timedApiCall;
 
 namespace ChipCarving {
 namespace Adapters {
@@ -34,11 +37,16 @@ bool FusionSketch::addConstructionLine(double x1, double y1, double x2, double y
 
   // Create start and end points (convert from mm to Fusion's database units -
   // cm)
-  Ptr<Point3D> startPoint = Point3D::create(Utils::mmToFusionLength(x1), Utils::mmToFusionLength(y1), 0);
-  Ptr<Point3D> endPoint = Point3D::create(Utils::mmToFusionLength(x2), Utils::mmToFusionLength(y2), 0);
+  Ptr<Point3D> startPoint = timedApiCall(ApiCallKind::ObjectCreate, [&] {
+    return Point3D::create(Utils::mmToFusionLength(x1), Utils::mmToFusionLength(y1), 0);
+  });
+  Ptr<Point3D> endPoint = timedApiCall(ApiCallKind::ObjectCreate, [&] {
+    return Point3D::create(Utils::mmToFusionLength(x2), Utils::mmToFusionLength(y2), 0);
+  });
 
   // Add line to sketch
-  Ptr<adsk::fusion::SketchLine> line = lines->addByTwoPoints(startPoint, endPoint);
+  Ptr<adsk::fusion::SketchLine> line =
+      timedApiCall(ApiCallKind::SketchEntity, [&] { return lines->addByTwoPoints(startPoint, endPoint); });
   if (!line) {
     return false;
   }
@@ -64,10 +72,14 @@ bool FusionSketch::addConstructionCircle(double centerX, double centerY, double
   }
 
   // Create center point (convert from mm to Fusion's database units - cm)
-  Ptr<Point3D> centerPoint = Point3D::create(Utils::mmToFusionLength(centerX), Utils::mmToFusionLength(centerY), 0);
+  Ptr<Point3D> centerPoint = timedApiCall(ApiCallKind::ObjectCreate, [&] {
+    return Point3D::create(Utils::mmToFusionLength(centerX), Utils::mmToFusionLength(centerY), 0);
+  });
 
   // Add circle to sketch (convert radius from mm to cm)
-  Ptr<adsk::fusion::SketchCircle> circle = circles->addByCenterRadius(centerPoint, Utils::mmToFusionLength(radius));
+  Ptr<adsk::fusion::SketchCircle> circle = timedApiCall(ApiCallKind::SketchEntity, [&] {
+    return circles->addByCenterRadius(centerPoint, Utils::mmToFusionLength(radius));
+  });
   if (!circle) {
     return false;
   }
@@ -93,8 +105,11 @@ bool FusionSketch::addConstructionPoint(double x, double y) {
   }
 
   // Create point (convert from mm to Fusion's database units - cm)
-  Ptr<Point3D> point = Point3D::create(Utils::mmToFusionLength(x), Utils::mmToFusionLength(y), 0);
-  Ptr<adsk::fusion::SketchPoint> sketchPoint = points->add(point);
+  Ptr<Point3D> point = timedApiCall(ApiCallKind::ObjectCreate, [&] {
+    return Point3D::create(Utils::mmToFusionLength(x), Utils::mmToFusionLength(y), 0);
+  });
+  Ptr<adsk::fusion::SketchPoint> sketchPoint =
+      timedApiCall(ApiCallKind::SketchEntity, [&] { return points->add(point); });
   if (!sketchPoint) {
     return false;
   }
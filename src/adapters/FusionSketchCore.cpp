@@ -9,6 +9,9 @@
 
 #include "FusionAPIAdapter.h"
 #include "geometry/Shape.h"
+#include "geometry/ShapeOutlineBatch.h"
+#include "utils/ApiCallTimer.h"
+#include "utils/TraceSpan.h"
 #include "utils/UnitConversion.h"
 
 #ifndef M_PI
@@ -18,10 +21,21 @@
 using adsk::core::Application;
 using adsk::core::Point3D;
 using adsk::core::Ptr;
+using ChipCarving::Utils::ApiCallKind;
+using ChipCarving::Utils::timedApiCall;
 
 namespace ChipCarving {
 namespace Adapters {
 
+namespace {
+
+// Sketch plane point from Fusion's database units (cm)
+Ptr<Point3D> createPoint(double x, double y) {
+  return timedApiCall(ApiCallKind::ObjectCreate, [x, y] { return Point3D::create(x, y, 0); });
+}
+
+}  // namespace
+
 // FusionSketch Implementation
 FusionSketch::FusionSketch(const std::string& name, const Ptr<Application>& app,
                            const Ptr<adsk::fusion::Sketch>& sketch)
@@ -63,10 +77,12 @@ bool FusionSketch::addLineToSketch(double x1, double y1, double x2, double y2) {
 
   // Create start and end points (convert from mm to Fusion's database units -
   // cm)
-  Ptr<Point3D> startPoint = Point3D::create(Utils::mmToFusionLength(x1), Utils::mmToFusionLength(y1), 0);
-  Ptr<Point3D> endPoint = Point3D::create(Utils::mmToFusionLength(x2), Utils::mmToFusionLength(y2), 0);
+  Ptr<Point3D> startPoint = createPoint(Utils::mmToFusionLength(x1), Utils::mmToFusionLength(y1));
+  Ptr<Point3D> endPoint = createPoint(Utils::mmToFusionLength(x2), Utils::mmToFusionLength(y2));
 
-  Ptr<adsk::fusion::SketchLine> line = lines->addByTwoPoints(startPoint, endPoint);
+  Ptr<adsk::fusion::SketchLine> line =
+      timedApiCall(ApiCallKind::SketchEntity, [&] { return lines->addByTwoPoints(startPoint, endPoint); });
+  tagCurve(line);
 
   return line != nullptr;
 }
@@ -86,7 +102,7 @@ bool FusionSketch::addArcToSketch(double centerX, double centerY, double radius,
   double endRad = endAngle * M_PI / 180.0;
 
   // Create center point (convert from mm to Fusion's database units - cm)
-  Ptr<Point3D> centerPoint = Point3D::create(Utils::mmToFusionLength(centerX), Utils::mmToFusionLength(centerY), 0);
+  Ptr<Point3D> centerPoint = createPoint(Utils::mmToFusionLength(centerX), Utils::mmToFusionLength(centerY));
 
   // Create start and end points on the arc (convert from mm to cm)
   double fusionRadius = Utils::mmToFusionLength(radius);
@@ -95,11 +111,13 @@ bool FusionSketch::addArcToSketch(double centerX, double centerY, double radius,
   double endX = Utils::mmToFusionLength(centerX) + fusionRadius * cos(endRad);
   double endY = Utils::mmToFusionLength(centerY) + fusionRadius * sin(endRad);
 
-  Ptr<Point3D> startPoint = Point3D::create(startX, startY, 0);
-  Ptr<Point3D> endPoint = Point3D::create(endX, endY, 0);
+  Ptr<Point3D> startPoint = createPoint(startX, startY);
+  Ptr<Point3D> endPoint = createPoint(endX, endY);
 
   // Add arc by center and two points
-  Ptr<adsk::fusion::SketchArc> arc = arcs->addByCenterStartEnd(centerPoint, startPoint, endPoint);
+  Ptr<adsk::fusion::SketchArc> arc = timedApiCall(
+      ApiCallKind::SketchEntity, [&] { return arcs->addByCenterStartEnd(centerPoint, startPoint, endPoint); });
+  tagCurve(arc);
 
   return arc != nullptr;
 }
@@ -115,8 +133,9 @@ int FusionSketch::addPointToSketch(double x, double y) {
   }
 
   // Create point (convert from mm to Fusion's database units - cm)
-  Ptr<Point3D> point = Point3D::create(Utils::mmToFusionLength(x), Utils::mmToFusionLength(y), 0);
-  Ptr<adsk::fusion::SketchPoint> sketchPoint = points->add(point);
+  Ptr<Point3D> point = createPoint(Utils::mmToFusionLength(x), Utils::mmToFusionLength(y));
+  Ptr<adsk::fusion::SketchPoint> sketchPoint =
+      timedApiCall(ApiCallKind::SketchEntity, [&] { return points->add(point); });
 
   if (!sketchPoint) {
     return -1;
@@ -158,7 +177,9 @@ bool FusionSketch::addArcByThreePointsToSketch(int startPointIndex, int midPoint
   // startPoint: SketchPoint (for constraint), point: Point3D (geometry),
   // endPoint: SketchPoint (for constraint)
   Ptr<adsk::core::Point3D> midPoint3D = midPt->geometry();
-  Ptr<adsk::fusion::SketchArc> arc = arcs->addByThreePoints(startPt, midPoint3D, endPt);
+  Ptr<adsk::fusion::SketchArc> arc =
+      timedApiCall(ApiCallKind::SketchEntity, [&] { return arcs->addByThreePoints(startPt, midPoint3D, endPt); });
+  tagCurve(arc);
 
   return arc != nullptr;
 }
@@ -183,11 +204,64 @@ bool FusionSketch::addLineByTwoPointsToSketch(int startPointIndex, int endPointI
   }
 
   // Create line by two points
-  Ptr<adsk::fusion::SketchLine> line = lines->addByTwoPoints(startPt, endPt);
+  Ptr<adsk::fusion::SketchLine> line =
+      timedApiCall(ApiCallKind::SketchEntity, [&] { return lines->addByTwoPoints(startPt, endPt); });
+  tagCurve(line);
 
   return line != nullptr;
 }
 
+int FusionSketch::addOutlineBatch(const Geometry::ShapeOutlineBatch& batch) {
+  Utils::TraceSpan span("fusion.addOutlineBatch");
+  if (!sketch_) {
+    return 0;
+  }
+  Ptr<adsk::fusion::SketchPoints> points = sketch_->sketchPoints();
+  Ptr<adsk::fusion::SketchArcs> arcs = sketch_->sketchCurves()->sketchArcs();
+  Ptr<adsk::fusion::SketchLines> lines = sketch_->sketchCurves()->sketchLines();
+  if (!points || !arcs || !lines) {
+    return 0;
+  }
+  SketchBulkEdit bulkEdit(this);
+
+  // Shared vertices are created once; arc midpoints go in as plain geometry,
+  // so no construction points are added and deleted again
+  std::vector<Ptr<adsk::fusion::SketchPoint>> vertexPoints;
+  vertexPoints.reserve(batch.vertices().size());
+  for (const auto& vertex : batch.vertices()) {
+    Ptr<Point3D> point = createPoint(Utils::mmToFusionLength(vertex.x), Utils::mmToFusionLength(vertex.y));
+    vertexPoints.push_back(timedApiCall(ApiCallKind::SketchEntity, [&] { return points->add(point); }));
+  }
+
+  int created = 0;
+  for (const auto& edge : batch.edges()) {
+    const Ptr<adsk::fusion::SketchPoint>& startPt = vertexPoints[edge.start];
+    const Ptr<adsk::fusion::SketchPoint>& endPt = vertexPoints[edge.end];
+    if (!startPt || !endPt) {
+      continue;
+    }
+    Ptr<adsk::fusion::SketchCurve> curve;
+    if (edge.isArc) {
+      Ptr<Point3D> mid = createPoint(Utils::mmToFusionLength(edge.mid.x), Utils::mmToFusionLength(edge.mid.y));
+      curve = timedApiCall(ApiCallKind::SketchEntity, [&] { return arcs->addByThreePoints(startPt, mid, endPt); });
+    } else {
+      curve = timedApiCall(ApiCallKind::SketchEntity, [&] { return lines->addByTwoPoints(startPt, endPt); });
+    }
+    if (curve) {
+      // Edges of a tagged shape carry its tag, the rest the sketch's current one
+      const std::string& tag = batch.tags()[edge.tag];
+      if (tag.empty()) {
+        tagCurve(curve);
+      } else {
+        tagCurve(curve, tag, "");
+      }
+      ++created;
+    }
+  }
+  Utils::traceCount("outlineCurvesCreated", created);
+  return created;
+}
+
 bool FusionSketch::deleteSketchPoint(int pointIndex) {
   if (!sketch_ || pointIndex < 0 || pointIndex >= static_cast<int>(sketchPoints_.size())) {
     return false;
@@ -236,5 +310,23 @@ void FusionSketch::finishSketch() {
   (void)sketch_;  // Suppress unused warning
 }
 
+void FusionSketch::beginBulkEdit() {
+  if (bulkEditDepth_++ > 0 || !sketch_) {
+    return;
+  }
+
+  // Each curve added to a live sketch triggers an incremental solve; deferring
+  // compute batches them into one solve when the outermost scope ends
+  computeWasDeferred_ = sketch_->isComputeDeferred();
+  sketch_->isComputeDeferred(true);
+}
+
+void FusionSketch::endBulkEdit() {
+  if (bulkEditDepth_ == 0 || --bulkEditDepth_ > 0 || !sketch_) {
+    return;
+  }
+  sketch_->isComputeDeferred(computeWasDeferred_);
+}
+
 }  // namespace Adapters
 }  // namespace ChipCarving
@@ -0,0 +1,84 @@
+/**
+ * FusionSketchTags.cpp
+ *
+ * Incremental regeneration tags for FusionSketch. Tags are curve attributes,
+ * so they are saved with the design and survive a restart of the add-in.
+ */
+
+#include <set>
+
+#include "FusionAPIAdapter.h"
+
+using adsk::core::Ptr;
+
+namespace ChipCarving {
+namespace Adapters {
+
+namespace {
+
+constexpr const char* TAG_GROUP = "ChipCarving";
+constexpr const char* TAG_NAME = "profileTag";
+constexpr const char* SOURCE_NAME = "sourceProfile";
+
+std::string curveTag(const Ptr<adsk::fusion::SketchCurve>& curve) {
+  Ptr<adsk::core::Attributes> attributes = curve->attributes();
+  Ptr<adsk::core::Attribute> attribute = attributes ? attributes->itemByName(TAG_GROUP, TAG_NAME) : nullptr;
+  return attribute ? attribute->value() : std::string();
+}
+
+}  // namespace
+
+void FusionSketch::setCurveTag(const std::string& tag, const std::string& sourceToken) {
+  curveTag_ = tag;
+  curveSourceToken_ = sourceToken;
+}
+
+void FusionSketch::tagCurve(const Ptr<adsk::fusion::SketchCurve>& curve) {
+  tagCurve(curve, curveTag_, curveSourceToken_);
+}
+
+void FusionSketch::tagCurve(const Ptr<adsk::fusion::SketchCurve>& curve, const std::string& tag,
+                            const std::string& sourceToken) {
+  if (tag.empty() || !curve) {
+    return;
+  }
+  Ptr<adsk::core::Attributes> attributes = curve->attributes();
+  if (attributes) {
+    attributes->add(TAG_GROUP, TAG_NAME, tag);
+    attributes->add(TAG_GROUP, SOURCE_NAME, sourceToken);
+  }
+}
+
+std::vector<std::string> FusionSketch::getCurveTags() {
+  std::set<std::string> tags;
+  Ptr<adsk::fusion::SketchCurves> curves = sketch_ ? sketch_->sketchCurves() : nullptr;
+  if (!curves) {
+    return {};
+  }
+  for (size_t i = 0; i < curves->count(); ++i) {
+    Ptr<adsk::fusion::SketchCurve> curve = curves->item(i);
+    if (curve) {
+      tags.insert(curveTag(curve));
+    }
+  }
+  return std::vector<std::string>(tags.begin(), tags.end());
+}
+
+int FusionSketch::deleteCurvesWithTag(const std::string& tag) {
+  Ptr<adsk::fusion::SketchCurves> curves = sketch_ ? sketch_->sketchCurves() : nullptr;
+  if (!curves) {
+    return 0;
+  }
+  // Backwards, as deleting a curve shifts the ones after it
+  int deleted = 0;
+  for (size_t i = curves->count(); i-- > 0;) {
+    Ptr<adsk::fusion::SketchCurve> curve = curves->item(i);
+    if (curve && curveTag(curve) == tag && curve->deleteMe()) {
+      ++deleted;
+    }
+  }
+  return deleted;
+}
+
+}  // namespace Adapters
+}  // namespace ChipCarving
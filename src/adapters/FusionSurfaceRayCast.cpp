@@ -0,0 +1,124 @@
+/**
+ * FusionSurfaceRayCast.cpp
+ *
+ * Downward ray casts against the components and mesh bodies of a design
+ * Split from FusionWorkspaceCurveSurface.cpp for maintainability
+ */
+
+#include "FusionSurfaceRayCast.h"
+
+#include <cmath>
+#include <limits>
+
+#include "utils/ApiCallTimer.h"
+#include "utils/UnitConversion.h"
+
+using adsk::core::Ptr;
+using ChipCarving::Utils::ApiCallKind;
+using ChipCarving::Utils::timedApiCall;
+
+namespace ChipCarving {
+namespace Adapters {
+
+namespace {
+
+// Start rays 10 meters above (should be well above any surface)
+constexpr double RAY_START_Z = 1000.0;
+
+// Whether a ray hit entity lies on the target body
+// Body names are unique within a component, so they identify the body when the
+// API hands back a different wrapper object for the same entity
+bool isOnTargetBody(const Ptr<adsk::core::Base>& entity, const Ptr<adsk::fusion::BRepBody>& targetBody) {
+  Ptr<adsk::fusion::BRepFace> face = entity;
+  if (!face) {
+    return false;
+  }
+  Ptr<adsk::fusion::BRepBody> body = face->body();
+  return body && (body.get() == targetBody.get() || body->name() == targetBody->name());
+}
+
+// Raise bestZ to the topmost face hit of one component
+void castComponent(const SurfaceQueryContext& context, const Ptr<adsk::fusion::Component>& component,
+                   const Ptr<adsk::core::Point3D>& rayOrigin, double& bestZ, bool& found) {
+  if (!component)
+    return;
+
+  Ptr<adsk::core::ObjectCollection> hitPoints =
+      timedApiCall(ApiCallKind::ObjectCreate, [] { return adsk::core::ObjectCollection::create(); });
+  if (!hitPoints)
+    return;
+
+  Ptr<adsk::core::ObjectCollection> intersectedEntities = timedApiCall(ApiCallKind::RayCast, [&] {
+    return component->findBRepUsingRay(rayOrigin, context.rayDirection,
+                                       adsk::fusion::BRepEntityTypes::BRepFaceEntityType, Utils::Tolerance::RAY_CASTING,
+                                       false,  // visibleEntitiesOnly - include all faces (critical for
+                                               // cross-component)
+                                       hitPoints);
+  });
+
+  if (intersectedEntities && intersectedEntities->count() > 0) {
+    for (size_t i = 0; i < hitPoints->count(); ++i) {
+      Ptr<adsk::core::Point3D> hitPoint = hitPoints->item(i);
+      // Hit points are returned in the same order as the intersected entities
+      if (context.targetBody && !isOnTargetBody(intersectedEntities->item(i), context.targetBody))
+        continue;
+      if (hitPoint && hitPoint->z() > bestZ) {
+        bestZ = hitPoint->z();
+        found = true;
+      }
+    }
+  }
+}
+
+}  // namespace
+
+bool hasBRepComponents(const SurfaceQueryContext& context) {
+  return !context.components.empty() || !context.unboundedComponents.empty();
+}
+
+std::vector<double> meshSurfaceHeights(const SurfaceQueryContext& context,
+                                       const std::vector<Geometry::Point2D>& points) {
+  std::vector<double> heights(points.size(), std::numeric_limits<double>::quiet_NaN());
+  for (const auto& mesh : context.meshes) {
+    mesh->raiseTopZ(points, heights);
+  }
+  return heights;
+}
+
+double castSurfaceRay(SurfaceQueryContext& context, double x, double y, double meshZ) {
+  // Mesh hits come first and can end the B-Rep casts early
+  bool found = !std::isnan(meshZ);
+  double bestZ = found ? meshZ : std::numeric_limits<double>::lowest();
+  if (!hasBRepComponents(context)) {
+    return found ? bestZ : std::numeric_limits<double>::quiet_NaN();
+  }
+  Ptr<adsk::core::Point3D> rayOrigin =
+      timedApiCall(ApiCallKind::ObjectCreate, [x, y] { return adsk::core::Point3D::create(x, y, RAY_START_Z); });
+  if (!rayOrigin) {
+    return found ? bestZ : std::numeric_limits<double>::quiet_NaN();
+  }
+
+  if (!context.indexedComponents) {
+    for (const auto& component : context.components) {
+      castComponent(context, component, rayOrigin, bestZ, found);
+    }
+  } else {
+    // Candidates come highest box first: once a hit reaches the top of the
+    // next box, no remaining component can be higher
+    context.componentIndex.candidates(x, y, context.candidates);
+    for (size_t id : context.candidates) {
+      if (found && bestZ >= context.componentIndex.maxZ(id) + Utils::Tolerance::RAY_CASTING) {
+        break;
+      }
+      castComponent(context, context.components[id], rayOrigin, bestZ, found);
+    }
+  }
+  for (const auto& component : context.unboundedComponents) {
+    castComponent(context, component, rayOrigin, bestZ, found);
+  }
+
+  return found ? bestZ : std::numeric_limits<double>::quiet_NaN();
+}
+
+}  // namespace Adapters
+}  // namespace ChipCarving
@@ -0,0 +1,53 @@
+/**
+ * FusionSurfaceRayCast.h
+ *
+ * Downward ray casts against the components and mesh bodies of a design
+ * Split from FusionWorkspaceCurveSurface.cpp for maintainability
+ */
+
+#pragma once
+
+#include <Core/CoreAll.h>
+#include <Fusion/FusionAll.h>
+
+#include <cstddef>
+#include <memory>
+#include <vector>
+
+#include "geometry/SurfaceBoundsIndex.h"
+#include "geometry/SurfaceMeshBVH.h"
+
+namespace ChipCarving {
+namespace Adapters {
+
+// Scene state shared by every ray in a surface Z batch
+// When targetBody is set only that body's faces are considered (targeted mode);
+// a targeted mesh body leaves no components, only its mesh
+// When componentIndex is built (one box per component) only components whose
+// box contains the ray are cast, highest first
+struct SurfaceQueryContext {
+  std::vector<adsk::core::Ptr<adsk::fusion::Component>> components{};
+  Geometry::SurfaceBoundsIndex componentIndex{};
+  bool indexedComponents = false;
+  std::vector<adsk::core::Ptr<adsk::fusion::Component>> unboundedComponents{};  // Cast for every ray
+  std::vector<std::shared_ptr<const Geometry::SurfaceMeshBVH>> meshes{};  // Queried in parallel before the B-Rep casts
+  adsk::core::Ptr<adsk::core::Vector3D> rayDirection{};
+  adsk::core::Ptr<adsk::fusion::BRepBody> targetBody{};
+  std::vector<size_t> candidates{};  // Scratch for componentIndex queries
+};
+
+// Whether any B-Rep component is left to ray cast after the meshes
+bool hasBRepComponents(const SurfaceQueryContext& context);
+
+// Topmost mesh Z under every point, from the meshes' hierarchies on worker threads; NaN without a hit
+std::vector<double> meshSurfaceHeights(const SurfaceQueryContext& context,
+                                       const std::vector<Geometry::Point2D>& points);
+
+/**
+ * Topmost surface Z under (x, y) across B-Rep faces and mesh bodies; NaN without a hit
+ * @param meshZ The point's meshSurfaceHeights entry; a B-Rep face must be above it to count
+ */
+double castSurfaceRay(SurfaceQueryContext& context, double x, double y, double meshZ);
+
+}  // namespace Adapters
+}  // namespace ChipCarving
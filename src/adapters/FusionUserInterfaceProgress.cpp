@@ -0,0 +1,82 @@
+/**
+ * FusionUserInterfaceProgress.cpp
+ *
+ * Progress dialog and main-thread notification for background jobs, and the
+ * run report in the Text Commands palette
+ * Split from FusionLogger.cpp for maintainability
+ */
+
+#include "FusionAPIAdapter.h"
+#include "utils/ApiCallTimer.h"
+
+using adsk::core::Application;
+using adsk::core::ProgressDialog;
+using adsk::core::Ptr;
+using adsk::core::TextCommandPalette;
+using ChipCarving::Utils::ApiCallKind;
+using ChipCarving::Utils::ApiCallTimer;
+
+namespace ChipCarving {
+namespace Adapters {
+
+void FusionUserInterface::showProgress(const std::string& title, const std::string& message, int maximum) {
+  if (!ui_) {
+    return;
+  }
+
+  ApiCallTimer timer(ApiCallKind::Call);
+  progressDialog_ = ui_->createProgressDialog();
+  if (!progressDialog_) {
+    return;
+  }
+  progressDialog_->isCancelButtonShown(true);
+  progressDialog_->cancelButtonText("Cancel");
+  progressDialog_->show(title, message, 0, maximum);
+}
+
+void FusionUserInterface::updateProgress(const std::string& message, int value, int maximum) {
+  if (!progressDialog_) {
+    return;
+  }
+  ApiCallTimer timer(ApiCallKind::Call, 3);
+  progressDialog_->maximumValue(maximum);
+  progressDialog_->progressValue(value);
+  progressDialog_->message(message);
+}
+
+bool FusionUserInterface::wasProgressCancelled() {
+  return progressDialog_ && progressDialog_->wasCancelled();
+}
+
+void FusionUserInterface::hideProgress() {
+  if (progressDialog_) {
+    progressDialog_->hide();
+    progressDialog_ = nullptr;
+  }
+}
+
+void FusionUserInterface::notifyMainThread() {
+  // fireCustomEvent is the one Fusion call that is safe off the main thread; the
+  // handler runs on the main thread once Fusion is idle
+  Ptr<Application> app = Application::get();
+  if (app) {
+    app->fireCustomEvent(GENERATION_PROGRESS_EVENT_ID);
+  }
+}
+
+void FusionUserInterface::showRunReport(const std::string& report) {
+  ApiCallTimer timer(ApiCallKind::Call, 4);
+  if (!ui_ || !ui_->palettes()) {
+    return;
+  }
+  // A message box per run would interrupt; the Text Commands palette keeps a history
+  Ptr<TextCommandPalette> palette = ui_->palettes()->itemById("TextCommands");
+  if (!palette) {
+    return;
+  }
+  palette->isVisible(true);
+  palette->writeText(report);
+}
+
+}  // namespace Adapters
+}  // namespace ChipCarving
@@ -101,8 +101,15 @@ bool FusionWorkspace::extractCurvesFromProfile(const adsk::core::Ptr<adsk::fusio
   }
   LOG_DEBUG("Found " << loops->count() << " loops");
 
-  // Use the first loop (outer loop)
+  // Use the outer loop; Fusion does not guarantee it comes first
   Ptr<adsk::fusion::ProfileLoop> loop = loops->item(0);
+  for (size_t i = 0; i < loops->count(); ++i) {
+    Ptr<adsk::fusion::ProfileLoop> candidate = loops->item(i);
+    if (candidate && candidate->isOuter()) {
+      loop = candidate;
+      break;
+    }
+  }
   if (!loop || !loop->isValid()) {
     LOG_ERROR("Could not get valid profile loop");
     return false;
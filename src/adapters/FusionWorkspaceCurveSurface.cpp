@@ -6,10 +6,19 @@
  */
 
 #include <cmath>
+#include <functional>
 #include <iostream>
+#include <limits>
+#include <memory>
+#include <utility>
 #include <vector>
 
 #include "FusionAPIAdapter.h"
+#include "FusionFaceProjector.h"
+#include "FusionSurfaceRayCast.h"
+#include "geometry/Point2D.h"
+#include "utils/FusionComponentTraverser.h"
+#include "utils/TraceSpan.h"
 #include "utils/UnitConversion.h"
 #include "utils/logging.h"
 
@@ -19,230 +28,224 @@ using adsk::core::Ptr;
 namespace ChipCarving {
 namespace Adapters {
 
-double FusionWorkspace::getSurfaceZAtXY(const std::string& /*surfaceId*/, double x, double y) {
-  LOG_DEBUG("=== ENHANCED SURFACE QUERY: getSurfaceZAtXY called ===");
-  LOG_DEBUG("Query point: (" << x << ", " << y << ") cm");
+namespace {
+
+// Ray direction shared by every query: straight down
+bool createRayDirection(SurfaceQueryContext& context) {
+  context.rayDirection = adsk::core::Vector3D::create(0.0, 0.0, -1.0);
+  if (!context.rayDirection) {
+    LOG_ERROR("Could not create ray geometry");
+    return false;
+  }
+  return true;
+}
+
+// Targeted mode: ray cast only the component owning the target face and keep
+// hits on the face's body, skipping every other component and mesh body
+bool buildTargetedQueryContext(const Ptr<adsk::fusion::BRepFace>& targetFace,
+                               const Ptr<adsk::fusion::Component>& targetComp, SurfaceQueryContext& context) {
+  Ptr<adsk::fusion::BRepBody> body = targetFace->body();
+  if (!body || !targetComp || !createRayDirection(context)) {
+    return false;
+  }
 
-  if (!app_) {
+  context.components.push_back(targetComp);
+  context.targetBody = body;
+  LOG_DEBUG("Surface query context: targeted at body '" << body->name() << "' in component '" << targetComp->name()
+                                                       << "'");
+  return true;
+}
+
+using MeshLookup = std::function<std::shared_ptr<const Geometry::SurfaceMeshBVH>(const Ptr<adsk::fusion::MeshBody>&)>;
+
+// Collect every component owning B-Rep bodies and the mesh bodies of all components
+// Search ALL components, not just the root: this fixes the "root sketch +
+// separate component surface" issue
+bool buildSurfaceQueryContext(const Ptr<adsk::core::Application>& app, const MeshLookup& meshLookup,
+                              SurfaceQueryContext& context) {
+  if (!app) {
     LOG_ERROR("No Fusion 360 application instance");
-    return std::numeric_limits<double>::quiet_NaN();
+    return false;
   }
 
-  // Get the active design
-  Ptr<adsk::fusion::Design> design = app_->activeProduct();
+  Ptr<adsk::fusion::Design> design = app->activeProduct();
   if (!design) {
     LOG_ERROR("No active design");
-    return std::numeric_limits<double>::quiet_NaN();
+    return false;
   }
 
-  // Get the root component
-  Ptr<adsk::fusion::Component> rootComp = design->rootComponent();
-  if (!rootComp) {
+  // Shared traversal, rebuilt only when the design has changed
+  auto snapshot = Utils::FusionComponentTraverser::snapshot(design);
+  if (!snapshot) {
     LOG_ERROR("No root component");
-    return std::numeric_limits<double>::quiet_NaN();
+    return false;
   }
 
-  // ENHANCED APPROACH: Universal ray casting across ALL components and
-  // surface types This works with: root sketches + separate component
-  // surfaces, B-Rep bodies, mesh bodies
-
-  LOG_DEBUG("Using enhanced universal ray casting for cross-component surface "
-            "detection");
-
-  // Create a ray from above the surface pointing downward (in world
-  // coordinates)
-  double rayStartZ = 1000.0;  // Start ray 10 meters above (should be well above any surface)
-  Ptr<adsk::core::Point3D> rayOrigin = adsk::core::Point3D::create(x, y, rayStartZ);
-  Ptr<adsk::core::Vector3D> rayDirection = adsk::core::Vector3D::create(0.0, 0.0, -1.0);  // Pointing down
-
-  if (!rayOrigin || !rayDirection) {
-    LOG_ERROR("Could not create ray geometry");
-    return std::numeric_limits<double>::quiet_NaN();
+  if (!createRayDirection(context)) {
+    return false;
   }
 
-  // Strategy: Search ALL components recursively, not just root component
-  // This fixes the "root sketch + separate component surface" issue
-  std::vector<Ptr<adsk::fusion::Component>> allComponents;
-  allComponents.push_back(rootComp);
+  // Components without usable bounds are cast for every ray
+  std::vector<Geometry::SurfaceBoundsIndex::Box> boxes;
+  for (const auto& bodyComponent : snapshot->bodyComponents) {
+    const Utils::WorldBounds& bounds = bodyComponent.bounds;
+    if (bounds.empty) {
+      context.unboundedComponents.push_back(bodyComponent.component);
+      continue;
+    }
+    Geometry::SurfaceBoundsIndex::Box box;
+    box.minX = bounds.minX;
+    box.minY = bounds.minY;
+    box.maxX = bounds.maxX;
+    box.maxY = bounds.maxY;
+    box.maxZ = bounds.maxZ;
+    context.components.push_back(bodyComponent.component);
+    boxes.push_back(box);
+  }
+  context.componentIndex = Geometry::SurfaceBoundsIndex(boxes, Utils::Tolerance::RAY_CASTING);
+  context.indexedComponents = true;
 
-  // Add all occurrences (sub-components) recursively
-  auto occurrences = rootComp->allOccurrences();
-  if (occurrences) {
-    LOG_DEBUG("Found " << occurrences->count() << " component occurrences to search");
-    for (size_t i = 0; i < occurrences->count(); ++i) {
-      auto occurrence = occurrences->item(i);
-      if (occurrence && occurrence->component()) {
-        allComponents.push_back(occurrence->component());
+  for (const auto& component : snapshot->components) {
+    if (!component) {
+      continue;
+    }
+    auto meshBodies = component->meshBodies();
+    if (!meshBodies) {
+      continue;
+    }
+    for (size_t meshIdx = 0; meshIdx < meshBodies->count(); ++meshIdx) {
+      if (auto hierarchy = meshLookup(meshBodies->item(meshIdx))) {
+        context.meshes.push_back(std::move(hierarchy));
       }
     }
   }
+  LOG_DEBUG("Surface query context: " << context.components.size() << " components, " << context.meshes.size()
+                                      << " mesh bodies");
+  return true;
+}
 
-  LOG_DEBUG("Searching " << allComponents.size() << " total components for surfaces");
+}  // namespace
 
-  double bestZ = std::numeric_limits<double>::lowest();
-  bool foundValidPoint = false;
+std::shared_ptr<const Geometry::SurfaceMeshBVH> FusionWorkspace::meshHierarchy(
+    const Ptr<adsk::fusion::MeshBody>& body) {
+  if (!body) {
+    return nullptr;
+  }
+  auto mesh = body->displayMesh();
+  if (!mesh) {
+    return nullptr;
+  }
+  std::string token = body->entityToken();
+  size_t nodeCount = static_cast<size_t>(mesh->nodeCount());
+  size_t triangleCount = static_cast<size_t>(mesh->triangleCount());
+  auto cached = meshHierarchies_.find(token);
+  if (cached != meshHierarchies_.end() && cached->second.nodeCount == nodeCount &&
+      cached->second.triangleCount == triangleCount) {
+    return cached->second.bvh;
+  }
 
-  // Search each component for intersections
-  for (size_t compIdx = 0; compIdx < allComponents.size(); ++compIdx) {
-    const auto& component = allComponents[compIdx];
-    if (!component)
-      continue;
+  // Read the triangle mesh once into the hierarchy's own storage
+  Utils::TraceSpan span("fusion.meshHierarchy");
+  std::vector<double> coords;
+  coords.reserve(nodeCount * 3);
+  for (const auto& node : mesh->nodeCoordinates()) {
+    coords.push_back(node ? node->x() : std::numeric_limits<double>::quiet_NaN());
+    coords.push_back(node ? node->y() : std::numeric_limits<double>::quiet_NaN());
+    coords.push_back(node ? node->z() : std::numeric_limits<double>::quiet_NaN());
+  }
+  std::vector<int> indices = mesh->nodeIndices();
+  auto bvh = std::make_shared<const Geometry::SurfaceMeshBVH>(coords, indices);
+  LOG_DEBUG("Mesh body '" << body->name() << "': " << bvh->triangleCount() << " triangles in " << bvh->nodeCount()
+                          << " hierarchy nodes");
+  if (bvh->empty()) {
+    bvh = nullptr;
+  }
+  meshHierarchies_[token] = MeshHierarchy{nodeCount, triangleCount, bvh};
+  return bvh;
+}
 
-    LOG_DEBUG("Searching component " << compIdx);
+double FusionWorkspace::getSurfaceZAtXY(const std::string& surfaceId, double x, double y) {
+  Utils::TraceSpan span("fusion.getSurfaceZAtXY");
+  LOG_DEBUG("Query point: (" << x << ", " << y << ") cm");
 
-    // Create object collection for hit points
-    Ptr<adsk::core::ObjectCollection> hitPoints = adsk::core::ObjectCollection::create();
-    if (!hitPoints)
-      continue;
+  std::vector<double> heights = getSurfaceZBatch(surfaceId, {Geometry::Point2D(x, y)}, true);
+  if (heights.empty() || std::isnan(heights[0])) {
+    LOG_WARNING("Enhanced ray casting found no valid surface at XY location (" << x << ", " << y << ")");
+    return std::numeric_limits<double>::quiet_NaN();
+  }
+  return heights[0];
+}
 
-    // Cast ray to find intersections with ALL surface types
-    // This searches both B-Rep faces AND mesh surfaces in this component
-    Ptr<adsk::core::ObjectCollection> intersectedEntities = component->findBRepUsingRay(
-        rayOrigin, rayDirection, adsk::fusion::BRepEntityTypes::BRepFaceEntityType, Utils::Tolerance::RAY_CASTING,
-        false,  // visibleEntitiesOnly - include all faces (critical for
-                // cross-component)
-        hitPoints);
-
-    if (intersectedEntities && intersectedEntities->count() > 0) {
-      LOG_DEBUG("Component " << compIdx << " ray casting found " << intersectedEntities->count()
-                             << " intersected entities with " << hitPoints->count() << " hit points");
-
-      // Process all hit points from this component
-      for (size_t i = 0; i < hitPoints->count(); ++i) {
-        Ptr<adsk::core::Point3D> hitPoint = hitPoints->item(i);
-        if (hitPoint) {
-          double hitZ = hitPoint->z();
-          LOG_DEBUG("Component " << compIdx << " hit point " << i << ": (" << hitPoint->x() << ", " << hitPoint->y()
-                                 << ", " << hitZ << ")");
-
-          // Track the topmost (highest Z) intersection point across ALL
-          // components
-          if (hitZ > bestZ) {
-            bestZ = hitZ;
-            foundValidPoint = true;
-            LOG_DEBUG("New topmost surface found at Z = " << bestZ << " cm in component " << compIdx);
-          }
-        }
+std::vector<double> FusionWorkspace::getSurfaceZBatch(const std::string& surfaceId,
+                                                      const std::vector<Geometry::Point2D>& points,
+                                                      bool useFaceEvaluator) {
+  Utils::TraceSpan span("fusion.getSurfaceZBatch");
+  Utils::traceCount("surfaceQueries", static_cast<double>(points.size()));
+  std::vector<double> heights(points.size(), std::numeric_limits<double>::quiet_NaN());
+  if (points.empty()) {
+    return heights;
+  }
+
+  // Resolve the target surface once per batch; when the token resolves to a
+  // face it is evaluated parametrically, with ray casts against its body only
+  // for points the evaluator cannot project
+  SurfaceQueryContext context;
+  std::unique_ptr<FusionFaceProjector> projector;
+  bool targeted = false;
+  for (const auto& entity : findEntitiesByToken(surfaceId)) {
+    Ptr<adsk::fusion::BRepFace> face = entity;
+    if (face && buildTargetedQueryContext(face, getComponentFromEntity(entity), context)) {
+      if (useFaceEvaluator) {
+        projector = std::make_unique<FusionFaceProjector>(face);
       }
+      targeted = true;
+      break;
+    }
+    // A targeted mesh body is answered from its hierarchy alone
+    Ptr<adsk::fusion::MeshBody> meshBody = entity;
+    if (auto hierarchy = meshHierarchy(meshBody)) {
+      context.meshes.push_back(std::move(hierarchy));
+      LOG_DEBUG("Surface query context: targeted at mesh body '" << meshBody->name() << "'");
+      targeted = true;
+      break;
     }
+  }
 
-    // ADDITIONAL: Also check mesh bodies in this component (for mesh
-    // surface support)
-    auto meshBodies = component->meshBodies();
-    if (meshBodies && meshBodies->count() > 0) {
-      LOG_DEBUG("Component " << compIdx << " has " << meshBodies->count()
-                             << " mesh bodies - implementing mesh ray intersection");
-
-      for (size_t meshIdx = 0; meshIdx < meshBodies->count(); ++meshIdx) {
-        auto meshBody = meshBodies->item(meshIdx);
-        if (!meshBody || !meshBody->displayMesh())
-          continue;
-
-        auto mesh = meshBody->displayMesh();
-        if (!mesh)
-          continue;
-
-        auto nodeCoords = mesh->nodeCoordinates();
-        auto nodeIndices = mesh->nodeIndices();
-
-        if (nodeCoords.empty() || nodeIndices.empty())
-          continue;
-
-        LOG_DEBUG("Checking mesh " << meshIdx << " with " << nodeCoords.size() << " vertices and "
-                                   << nodeIndices.size() / 3 << " triangles");
-
-        // Simple mesh ray intersection - check triangles
-        for (size_t triIdx = 0; triIdx < nodeIndices.size(); triIdx += 3) {
-          if (triIdx + 2 >= nodeIndices.size())
-            break;
-
-          // Get triangle vertices
-          auto v0Idx = nodeIndices[triIdx];
-          auto v1Idx = nodeIndices[triIdx + 1];
-          auto v2Idx = nodeIndices[triIdx + 2];
-
-          if (static_cast<size_t>(v0Idx) >= nodeCoords.size() || static_cast<size_t>(v1Idx) >= nodeCoords.size() ||
-              static_cast<size_t>(v2Idx) >= nodeCoords.size())
-            continue;
-
-          const auto& v0 = nodeCoords[v0Idx];
-          const auto& v1 = nodeCoords[v1Idx];
-          const auto& v2 = nodeCoords[v2Idx];
-
-          if (!v0 || !v1 || !v2)
-            continue;
-
-          // Möller–Trumbore ray-triangle intersection algorithm
-          // Ray: origin (x, y, rayStartZ), direction (0, 0, -1)
-
-          // Edge vectors from v0 to v1 and v0 to v2
-          double edge1X = v1->x() - v0->x();
-          double edge1Y = v1->y() - v0->y();
-          double edge1Z = v1->z() - v0->z();
-          double edge2X = v2->x() - v0->x();
-          double edge2Y = v2->y() - v0->y();
-          double edge2Z = v2->z() - v0->z();
-
-          // h = rayDir × edge2, where rayDir = (0, 0, -1)
-          double hX = edge2Y;   // 0*edge2Z - (-1)*edge2Y
-          double hY = -edge2X;  // (-1)*edge2X - 0*edge2Z
-          double hZ = 0.0;      // 0*edge2Y - 0*edge2X
-
-          // a = edge1 · h (determinant)
-          double a = edge1X * hX + edge1Y * hY + edge1Z * hZ;
-
-          // Ray parallel to triangle?
-          if (std::abs(a) < 1e-9)
-            continue;
-
-          double f = 1.0 / a;
-
-          // s = rayOrigin - v0
-          double sX = x - v0->x();
-          double sY = y - v0->y();
-          double sZ = rayStartZ - v0->z();
-
-          // u = f * (s · h) - first barycentric coordinate
-          double u = f * (sX * hX + sY * hY + sZ * hZ);
-          if (u < 0.0 || u > 1.0)
-            continue;
-
-          // q = s × edge1
-          double qX = sY * edge1Z - sZ * edge1Y;
-          double qY = sZ * edge1X - sX * edge1Z;
-          double qZ = sX * edge1Y - sY * edge1X;
-
-          // v = f * (rayDir · q) - second barycentric coordinate
-          double v = f * (-qZ);  // rayDir = (0, 0, -1), so dot = -qZ
-          if (v < 0.0 || u + v > 1.0)
-            continue;
-
-          // t = f * (edge2 · q) - ray parameter (distance)
-          double t = f * (edge2X * qX + edge2Y * qY + edge2Z * qZ);
-          if (t < 0.0)
-            continue;
-
-          // Hit point Z (ray goes down, so subtract)
-          double hitZ = rayStartZ - t;
-
-          if (hitZ > bestZ && hitZ < rayStartZ) {
-            bestZ = hitZ;
-            foundValidPoint = true;
-            LOG_DEBUG("Mesh hit at Z=" << bestZ << " (bary u=" << u << " v=" << v << ")");
-          }
-        }
-      }
+  // Fallback: universal ray casting across ALL components and surface types:
+  // root sketches + separate component surfaces, B-Rep bodies, mesh bodies
+  if (!targeted) {
+    LOG_DEBUG("Target surface '" << surfaceId << "' not resolved, searching all components");
+    context = SurfaceQueryContext();
+    auto meshLookup = [this](const Ptr<adsk::fusion::MeshBody>& body) { return meshHierarchy(body); };
+    if (!buildSurfaceQueryContext(app_, meshLookup, context)) {
+      return heights;
+    }
+  }
+
+  // Mesh heights for the whole batch run on worker threads; the B-Rep casts
+  // below go through the Fusion API on this thread
+  std::vector<double> meshHeights = meshSurfaceHeights(context, points);
+
+  size_t missCount = 0;
+  size_t evaluatedCount = 0;
+  for (size_t i = 0; i < points.size(); ++i) {
+    if (projector && projector->isValid() && projector->project(points[i].x, points[i].y, heights[i])) {
+      evaluatedCount++;
+      continue;
+    }
+    heights[i] = castSurfaceRay(context, points[i].x, points[i].y, meshHeights[i]);
+    if (std::isnan(heights[i])) {
+      missCount++;
     }
   }
 
-  if (foundValidPoint) {
-    LOG_DEBUG("Enhanced ray casting found topmost surface at Z = " << bestZ << " cm across " << allComponents.size()
-                                                                   << " components");
-    return bestZ;
+  LOG_DEBUG("Surface Z batch: " << points.size() << " points, " << evaluatedCount << " evaluated on the face, "
+                                << missCount << " without a surface");
+  if (missCount > 0 && points.size() > 1) {
+    LOG_WARNING("Enhanced ray casting found no valid surface for " << missCount << " of " << points.size()
+                                                                   << " points");
   }
-  LOG_WARNING("Enhanced ray casting found no valid surface at XY location (" << x << ", " << y << ") across "
-                                                                             << allComponents.size() << " components");
-  return std::numeric_limits<double>::quiet_NaN();
+  return heights;
 }
 
 }  // namespace Adapters
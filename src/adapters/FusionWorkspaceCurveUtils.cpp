@@ -20,95 +20,68 @@ std::string FusionWorkspace::extractPlaneEntityIdFromProfile(const std::string&
   LOG_DEBUG("extractPlaneEntityIdFromProfile called with profileEntityId: " << profileEntityId);
 
   if (!app_) {
-    LOG_ERROR("No Fusion 360 application instance");
     return "";
   }
 
-  // Get the active design
+  // A recompute that could move the sketch to another plane also replaces its profiles
   Ptr<adsk::fusion::Design> design = app_->activeProduct();
-  if (!design) {
-    LOG_ERROR("No active design");
-    return "";
+  if (design) {
+    useSessionCache(design);
+    auto cached = profilePlanes_.find(profileEntityId);
+    if (cached != profilePlanes_.end() && cached->second.profile && cached->second.profile->isValid()) {
+      return cached->second.planeToken;
+    }
   }
 
-  // Get the root component
-  Ptr<adsk::fusion::Component> rootComp = design->rootComponent();
-  if (!rootComp) {
-    LOG_ERROR("No root component");
+  // Token lookup instead of walking every sketch profile; shares the session index
+  // with the profile extraction that follows
+  Ptr<adsk::fusion::Profile> profile;
+  for (const auto& entity : findEntitiesByToken(profileEntityId)) {
+    profile = entity;
+    if (profile) {
+      break;
+    }
+  }
+  if (!profile || !profile->isValid()) {
+    LOG_DEBUG("Profile with token '" << profileEntityId << "' not found");
     return "";
   }
 
-  // Find the profile using the entity ID
-  LOG_DEBUG("Searching for profile with token: " << profileEntityId);
-
-  // Search through all sketches to find the profile
-  Ptr<adsk::fusion::Sketches> sketches = rootComp->sketches();
-  if (!sketches) {
-    LOG_ERROR("No sketches collection");
+  Ptr<adsk::fusion::Sketch> sketch = profile->parentSketch();
+  if (!sketch) {
+    LOG_WARNING("Profile has no parent sketch");
     return "";
   }
-
-  for (int sketchIndex = 0; sketchIndex < static_cast<int>(sketches->count()); ++sketchIndex) {
-    Ptr<adsk::fusion::Sketch> sketch = sketches->item(sketchIndex);
-    if (!sketch || !sketch->isValid()) {
-      LOG_DEBUG("Skipping invalid sketch at index " << sketchIndex);
-      continue;
+  LOG_DEBUG("Found matching profile in sketch: " << sketch->name());
+
+  // Get the sketch's reference plane
+  Ptr<adsk::core::Base> referenceEntity = sketch->referencePlane();
+  if (referenceEntity) {
+    // Try to cast to construction plane
+    Ptr<adsk::fusion::ConstructionPlane> constructionPlane = referenceEntity;
+    if (constructionPlane) {
+      std::string planeToken = constructionPlane->entityToken();
+      LOG_DEBUG("Extracted construction plane token: " << planeToken);
+      profilePlanes_[profileEntityId] = {profile, planeToken};
+      return planeToken;
     }
 
-    LOG_DEBUG("Checking sketch " << sketchIndex << ": " << sketch->name());
-
-    // Check profiles in this sketch
-    Ptr<adsk::fusion::Profiles> profiles = sketch->profiles();
-    if (!profiles)
-      continue;
-
-    for (int profileIndex = 0; profileIndex < static_cast<int>(profiles->count()); ++profileIndex) {
-      Ptr<adsk::fusion::Profile> profile = profiles->item(profileIndex);
-      if (!profile || !profile->isValid()) {
-        LOG_DEBUG("Skipping invalid profile at index " << profileIndex);
-        continue;
-      }
-
-      std::string currentProfileId = profile->entityToken();
-      LOG_DEBUG("Profile " << profileIndex << " token: " << currentProfileId);
-
-      if (currentProfileId == profileEntityId) {
-        // Found the profile! Get its sketch's plane
-        LOG_DEBUG("Found matching profile in sketch: " << sketch->name());
-
-        // Get the sketch's reference plane
-        Ptr<adsk::core::Base> referenceEntity = sketch->referencePlane();
-        if (referenceEntity) {
-          // Try to cast to construction plane
-          Ptr<adsk::fusion::ConstructionPlane> constructionPlane = referenceEntity;
-          if (constructionPlane) {
-            std::string planeToken = constructionPlane->entityToken();
-            LOG_DEBUG("Extracted construction plane token: " << planeToken);
-            return planeToken;
-          }
-
-          // Try to cast to B-Rep face (if sketch is on a face)
-          Ptr<adsk::fusion::BRepFace> face = referenceEntity;
-          if (face) {
-            std::string faceToken = face->entityToken();
-            LOG_DEBUG("Extracted face plane token: " << faceToken);
-            return faceToken;
-          }
-
-          LOG_WARNING("Reference plane found but couldn't extract entity token");
-        } else {
-          LOG_WARNING("Profile's sketch has no reference plane");
-        }
-
-        // If we can't get the plane token, return empty string but log the
-        // attempt
-        LOG_WARNING("Could not extract plane entity ID from profile's sketch");
-        return "";
-      }
+    // Try to cast to B-Rep face (if sketch is on a face)
+    Ptr<adsk::fusion::BRepFace> face = referenceEntity;
+    if (face) {
+      std::string faceToken = face->entityToken();
+      LOG_DEBUG("Extracted face plane token: " << faceToken);
+      profilePlanes_[profileEntityId] = {profile, faceToken};
+      return faceToken;
     }
+
+    LOG_WARNING("Reference plane found but couldn't extract entity token");
+  } else {
+    LOG_WARNING("Profile's sketch has no reference plane");
   }
 
-  LOG_DEBUG("Profile with token '" << profileEntityId << "' not found in any sketch");
+  // If we can't get the plane token, return empty string but log the attempt
+  LOG_WARNING("Could not extract plane entity ID from profile's sketch");
   return "";
 }
 
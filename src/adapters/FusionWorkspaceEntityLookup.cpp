@@ -12,11 +12,17 @@
  * - Simpler, more maintainable code
  * - Handles edge cases that manual iteration might miss
  *
+ * Within an entity lookup session the results are also kept in a per-session
+ * token index, so the per-profile and plane lookups of one Generate Paths run
+ * reach the design once per token.
+ *
  * IF YOU EXPERIENCE ISSUES:
  * The previous manual iteration approach is preserved in git history.
  * See the commit that introduced this file for the old implementation.
  */
 
+#include <algorithm>
+
 #include "FusionAPIAdapter.h"
 #include "utils/logging.h"
 
@@ -26,6 +32,30 @@ using adsk::core::Ptr;
 namespace ChipCarving {
 namespace Adapters {
 
+void FusionWorkspace::beginEntityLookupSession() {
+  ++entityLookupDepth_;
+}
+
+void FusionWorkspace::endEntityLookupSession() {
+  if (entityLookupDepth_ > 0 && --entityLookupDepth_ == 0) {
+    dropEntityTokenIndex();
+  }
+}
+
+void FusionWorkspace::invalidateEntityLookups() {
+  dropEntityTokenIndex();
+  clearSessionCache();
+}
+
+void FusionWorkspace::dropEntityTokenIndex() {
+  if (!entityTokenIndex_.empty()) {
+    LOG_DEBUG("Dropping " << entityTokenIndex_.size() << " indexed entity token(s)");
+  }
+  entityTokenIndex_.clear();
+  entityIndexDesign_ = nullptr;
+  meshHierarchies_.clear();
+}
+
 std::vector<Ptr<Base>> FusionWorkspace::findEntitiesByToken(const std::string& entityToken) {
   std::vector<Ptr<Base>> result;
 
@@ -46,6 +76,26 @@ std::vector<Ptr<Base>> FusionWorkspace::findEntitiesByToken(const std::string& e
     return result;
   }
 
+  // Inside a lookup session, answer repeated tokens from the index as long as
+  // the same design is active and every indexed entity is still alive
+  bool indexing = entityLookupDepth_ > 0;
+  if (indexing) {
+    if (entityIndexDesign_ && entityIndexDesign_.get() != design.get()) {
+      invalidateEntityLookups();
+    }
+    entityIndexDesign_ = design;
+
+    auto indexed = entityTokenIndex_.find(entityToken);
+    if (indexed != entityTokenIndex_.end()) {
+      bool alive = std::all_of(indexed->second.begin(), indexed->second.end(),
+                               [](const Ptr<Base>& entity) { return entity && entity->isValid(); });
+      if (alive) {
+        return indexed->second;
+      }
+      entityTokenIndex_.erase(indexed);
+    }
+  }
+
   // Use the official Fusion API method for direct lookup
   // This is O(1) - Fusion maintains internal index of entity tokens
   result = design->findEntityByToken(entityToken);
@@ -54,6 +104,10 @@ std::vector<Ptr<Base>> FusionWorkspace::findEntitiesByToken(const std::string& e
     LOG_DEBUG("findEntitiesByToken: No entity found for token: " << entityToken);
   } else {
     LOG_DEBUG("findEntitiesByToken: Found " << result.size() << " entity(ies) for token");
+    // Misses are not indexed: sketches created later in the session may own the token
+    if (indexing) {
+      entityTokenIndex_.emplace(entityToken, result);
+    }
   }
 
   return result;
@@ -0,0 +1,91 @@
+/**
+ * FusionWorkspaceOutputSession.cpp
+ *
+ * Output sessions for FusionWorkspace: the sketches of one generation run form
+ * a single timeline group, and for direct-edit output they are created inside
+ * a base feature, so upstream edits do not recompute them and undoing the run
+ * removes one timeline item
+ */
+
+#include "FusionAPIAdapter.h"
+#include "utils/logging.h"
+
+using adsk::core::Ptr;
+
+namespace ChipCarving {
+namespace Adapters {
+
+void FusionWorkspace::beginOutputSession(const std::string& name, bool directEdit) {
+  if (outputSessionDepth_++ > 0 || !app_) {
+    return;
+  }
+  outputSessionName_ = name;
+  outputDirectEdit_ = directEdit;
+  outputTimelineStart_ = -1;
+  outputBaseFeature_ = nullptr;
+
+  // Direct modeling designs have no timeline to group and nothing to recompute
+  Ptr<adsk::fusion::Design> design = app_->activeProduct();
+  if (!design || design->designType() != adsk::fusion::ParametricDesignType) {
+    return;
+  }
+  Ptr<adsk::fusion::Timeline> timeline = design->timeline();
+  if (timeline) {
+    outputTimelineStart_ = static_cast<int>(timeline->count());
+  }
+}
+
+void FusionWorkspace::prepareOutputComponent(const Ptr<adsk::fusion::Component>& component) {
+  if (outputSessionDepth_ == 0 || !outputDirectEdit_ || outputTimelineStart_ < 0 || outputBaseFeature_ ||
+      !component) {
+    return;
+  }
+
+  // The first sketch of the session opens the base feature in its component;
+  // later sketches of the run go to the same component
+  Ptr<adsk::fusion::Features> features = component->features();
+  Ptr<adsk::fusion::BaseFeatures> baseFeatures = features ? features->baseFeatures() : nullptr;
+  if (!baseFeatures) {
+    return;
+  }
+  outputBaseFeature_ = baseFeatures->add();
+  if (!outputBaseFeature_ || !outputBaseFeature_->startEdit()) {
+    logApiError("baseFeatures->add()->startEdit()");
+    outputBaseFeature_ = nullptr;
+    return;
+  }
+  outputBaseFeature_->name(outputSessionName_);
+  LOG_DEBUG("Writing output sketches inside base feature '" << outputSessionName_ << "'");
+}
+
+void FusionWorkspace::endOutputSession() {
+  if (outputSessionDepth_ == 0 || --outputSessionDepth_ > 0) {
+    return;
+  }
+  if (outputBaseFeature_) {
+    if (!outputBaseFeature_->finishEdit()) {
+      logApiError("baseFeature->finishEdit()");
+    }
+    outputBaseFeature_ = nullptr;
+  }
+  if (outputTimelineStart_ < 0) {
+    return;
+  }
+
+  // A lone sketch or the base feature is already one item
+  Ptr<adsk::fusion::Design> design = app_->activeProduct();
+  Ptr<adsk::fusion::Timeline> timeline = design ? design->timeline() : nullptr;
+  int end = timeline ? static_cast<int>(timeline->count()) - 1 : -1;
+  if (end > outputTimelineStart_) {
+    Ptr<adsk::fusion::TimelineGroup> group = timeline->timelineGroups()->add(outputTimelineStart_, end);
+    if (group) {
+      group->name(outputSessionName_);
+    } else {
+      logApiError("timelineGroups->add()");
+    }
+  }
+  outputTimelineStart_ = -1;
+}
+
+}  // namespace Adapters
+}  // namespace ChipCarving
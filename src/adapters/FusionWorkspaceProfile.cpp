@@ -7,10 +7,12 @@
 
 #include <cmath>
 #include <string>
+#include <utility>
 #include <vector>
 
 #include "FusionAPIAdapter.h"
 #include "FusionWorkspaceProfileTypes.h"
+#include "utils/TraceSpan.h"
 #include "utils/UnitConversion.h"
 #include "utils/logging.h"
 
@@ -20,8 +22,9 @@ namespace ChipCarving {
 namespace Adapters {
 
 bool FusionWorkspace::extractProfileVertices(const std::string& entityId,
-                                             std::vector<std::pair<double, double>>& vertices,
+                                             std::vector<Geometry::Point2D>& vertices,
                                              TransformParams& transform) {
+  Utils::TraceSpan span("fusion.extractProfileVertices");
   // Enhanced UI Phase 5.2: Extract geometry from Fusion 360 sketch profiles
   // FIXED: This function now returns vertices in WORLD COORDINATES
   // for proper medial axis computation. Construction geometry is created
@@ -144,7 +147,7 @@ bool FusionWorkspace::extractProfileVertices(const std::string& entityId,
             LOG_DEBUG("Point has Z value: " << z << " cm (world coordinates)");
           }
 
-          vertices.push_back({x, y});
+          vertices.emplace_back(x, y);
         }
       }
     } else {
@@ -161,7 +164,7 @@ bool FusionWorkspace::extractProfileVertices(const std::string& entityId,
             LOG_DEBUG("Point has Z value: " << z << " cm (world coordinates)");
           }
 
-          vertices.push_back({x, y});
+          vertices.emplace_back(x, y);
         }
       }
     }
@@ -188,5 +191,45 @@ bool FusionWorkspace::extractProfileVertices(const std::string& entityId,
 
 // NOTE: extractProfileGeometry() is in FusionWorkspaceProfileGeometry.cpp
 
+SketchSelection FusionWorkspace::getSketchProfiles(const std::string& sketchName) {
+  SketchSelection selection;
+  selection.errorMessage = "No active design";
+  if (!app_) {
+    return selection;
+  }
+  Ptr<adsk::fusion::Design> design = app_->activeProduct();
+  if (!design || !design->rootComponent()) {
+    return selection;
+  }
+  Ptr<adsk::fusion::Sketches> sketches = design->rootComponent()->sketches();
+  if (!sketches) {
+    return selection;
+  }
+
+  for (size_t i = 0; i < sketches->count(); ++i) {
+    Ptr<adsk::fusion::Sketch> sketch = sketches->item(i);
+    if (!sketch || sketch->name() != sketchName || !sketch->profiles()) {
+      continue;
+    }
+    Ptr<adsk::fusion::Profiles> profiles = sketch->profiles();
+    for (size_t p = 0; p < profiles->count(); ++p) {
+      Ptr<adsk::fusion::Profile> profile = profiles->item(p);
+      ProfileGeometry geometry;
+      // Closed profiles only, as the selection dialog accepts them
+      if (profile && extractProfileGeometry(profile, geometry) && geometry.area > 0) {
+        selection.selectedEntityIds.push_back(profile->entityToken());
+        selection.selectedProfiles.push_back(std::move(geometry));
+        selection.closedPathCount++;
+      }
+    }
+    break;
+  }
+
+  selection.isValid = selection.closedPathCount > 0;
+  selection.errorMessage = selection.isValid ? "" : "Sketch '" + sketchName + "' has no closed profiles";
+  LOG_DEBUG("Read " << selection.closedPathCount << " profiles of sketch '" << sketchName << "'");
+  return selection;
+}
+
 }  // namespace Adapters
 }  // namespace ChipCarving
@@ -66,6 +66,9 @@ bool FusionWorkspace::extractProfileGeometry(const Ptr<adsk::fusion::Profile>& p
   Ptr<adsk::fusion::Sketch> sketch = firstCurve->sketchEntity()->parentSketch();
   if (sketch) {
     geometry.sketchName = sketch->name();
+    if (sketch->parentComponent()) {
+      geometry.componentEntityId = sketch->parentComponent()->entityToken();
+    }
 
     // Get plane entity ID
     Ptr<adsk::core::Base> referenceEntity = sketch->referencePlane();
@@ -151,14 +154,14 @@ bool FusionWorkspace::extractProfileGeometry(const Ptr<adsk::fusion::Profile>& p
       // Add points in reverse order, skip first point (which is last in reverse)
       for (int j = static_cast<int>(strokePoints.size()) - 1; j >= 1; --j) {
         if (strokePoints[j]) {
-          geometry.vertices.push_back({strokePoints[j]->x(), strokePoints[j]->y()});
+          geometry.vertices.emplace_back(strokePoints[j]->x(), strokePoints[j]->y());
         }
       }
     } else {
       // Add points in normal order
       for (size_t j = 0; j < numPoints; ++j) {
         if (strokePoints[j]) {
-          geometry.vertices.push_back({strokePoints[j]->x(), strokePoints[j]->y()});
+          geometry.vertices.emplace_back(strokePoints[j]->x(), strokePoints[j]->y());
         }
       }
     }
@@ -11,6 +11,7 @@
  */
 
 #include "FusionAPIAdapter.h"
+#include "utils/FusionComponentTraverser.h"
 #include "utils/logging.h"
 
 using adsk::core::Base;
@@ -82,23 +83,9 @@ Ptr<adsk::fusion::Profile> FusionWorkspace::findProfileByEntityToken(const std::
     return nullptr;
   }
 
-  // Build list of all components
-  std::vector<Ptr<adsk::fusion::Component>> allComponents;
-  allComponents.push_back(rootComp);
-
-  auto occurrences = rootComp->allOccurrences();
-  if (occurrences) {
-    for (size_t i = 0; i < occurrences->count(); ++i) {
-      auto occurrence = occurrences->item(i);
-      if (!occurrence || !occurrence->isValid()) {
-        LOG_DEBUG("Skipping invalid occurrence at index " << i);
-        continue;
-      }
-      if (occurrence->component()) {
-        allComponents.push_back(occurrence->component());
-      }
-    }
-  }
+  // Root and occurrence components from the shared traversal snapshot
+  Utils::FusionComponentTraverser traverser(rootComp);
+  std::vector<Ptr<adsk::fusion::Component>> allComponents = traverser.getAllComponents();
 
   LOG_DEBUG("Fallback: Searching " << allComponents.size() << " components");
 
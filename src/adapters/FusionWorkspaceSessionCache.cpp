@@ -0,0 +1,44 @@
+/**
+ * FusionWorkspaceSessionCache.cpp
+ *
+ * Sketch setup kept across Generate Paths runs: the plane behind each profile,
+ * resolved sketch planes, target components and root sketches by name. Runs on
+ * an unchanged setup reuse them instead of resolving entity tokens and walking
+ * sketches again; document events drop them (invalidateEntityLookups()).
+ */
+
+#include "FusionAPIAdapter.h"
+#include "utils/logging.h"
+
+using adsk::core::Ptr;
+
+namespace ChipCarving {
+namespace Adapters {
+
+void FusionWorkspace::useSessionCache(const Ptr<adsk::fusion::Design>& design) {
+  if (sessionCacheDesign_ && sessionCacheDesign_.get() != design.get()) {
+    clearSessionCache();
+  }
+  sessionCacheDesign_ = design;
+}
+
+void FusionWorkspace::clearSessionCache() {
+  size_t entries = profilePlanes_.size() + sketchPlanes_.size() + targetComponents_.size() + rootSketches_.size();
+  if (entries > 0) {
+    LOG_DEBUG("Dropping " << entries << " cached sketch setup lookup(s)");
+  }
+  profilePlanes_.clear();
+  sketchPlanes_.clear();
+  targetComponents_.clear();
+  rootSketches_.clear();
+  sessionCacheDesign_ = nullptr;
+}
+
+void FusionWorkspace::rememberRootSketch(const std::string& name, const Ptr<adsk::fusion::Sketch>& sketch) {
+  if (sketch) {
+    rootSketches_[name] = sketch;
+  }
+}
+
+}  // namespace Adapters
+}  // namespace ChipCarving
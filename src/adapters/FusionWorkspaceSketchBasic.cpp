@@ -6,9 +6,12 @@
  */
 
 #include "FusionAPIAdapter.h"
+#include "utils/ApiCallTimer.h"
 
 using adsk::core::Application;
 using adsk::core::Ptr;
+using ChipCarving::Utils::ApiCallKind;
+using ChipCarving::Utils::timedApiCall;
 
 namespace ChipCarving {
 namespace Adapters {
@@ -45,13 +48,16 @@ std::unique_ptr<ISketch> FusionWorkspace::createSketch(const std::string& name)
     return nullptr;
   }
 
-  Ptr<adsk::fusion::Sketch> sketch = sketches->add(xyPlane);
+  prepareOutputComponent(rootComp);
+  Ptr<adsk::fusion::Sketch> sketch = timedApiCall(ApiCallKind::Call, [&] { return sketches->add(xyPlane); });
   if (!sketch) {
     return nullptr;
   }
 
   // Set the sketch name
   sketch->name(name);
+  useSessionCache(design);
+  rememberRootSketch(name, sketch);
 
   return std::make_unique<FusionSketch>(name, app_, sketch);
 }
@@ -11,6 +11,7 @@
  */
 
 #include "FusionAPIAdapter.h"
+#include "utils/ApiCallTimer.h"
 #include "utils/logging.h"
 
 using adsk::core::Base;
@@ -46,7 +47,12 @@ std::unique_ptr<ISketch> FusionWorkspace::createSketchInTargetComponent(const st
   // This replaces ~100 lines of manual iteration through components/bodies/faces
   // ========================================================================
 
-  if (!surfaceEntityId.empty()) {
+  useSessionCache(design);
+  auto cached = targetComponents_.find(surfaceEntityId);
+  if (cached != targetComponents_.end() && cached->second && cached->second->isValid()) {
+    targetComponent = cached->second;
+    LOG_DEBUG("Using cached target component: " << targetComponent->name());
+  } else if (!surfaceEntityId.empty()) {
     LOG_DEBUG("Looking up surface entity directly: " << surfaceEntityId);
 
     // Use the official Fusion API for O(1) entity lookup
@@ -57,6 +63,7 @@ std::unique_ptr<ISketch> FusionWorkspace::createSketchInTargetComponent(const st
       targetComponent = getComponentFromEntity(entities[0]);
 
       if (targetComponent) {
+        targetComponents_[surfaceEntityId] = targetComponent;
         LOG_DEBUG("FOUND via direct lookup! Component: " << targetComponent->name());
       } else {
         LOG_WARNING("Entity found but could not determine parent component");
@@ -86,7 +93,9 @@ std::unique_ptr<ISketch> FusionWorkspace::createSketchInTargetComponent(const st
     return nullptr;
   }
 
-  Ptr<adsk::fusion::Sketch> sketch = sketches->add(xyPlane);
+  prepareOutputComponent(targetComponent);
+  Ptr<adsk::fusion::Sketch> sketch =
+      Utils::timedApiCall(Utils::ApiCallKind::Call, [&] { return sketches->add(xyPlane); });
   if (!sketch) {
     logApiError("sketches->add(xyPlane)");
     return nullptr;
@@ -13,6 +13,7 @@
 #include <cmath>
 
 #include "FusionAPIAdapter.h"
+#include "utils/ApiCallTimer.h"
 #include "utils/UnitConversion.h"
 #include "utils/logging.h"
 
@@ -58,24 +59,15 @@ std::unique_ptr<ISketch> FusionWorkspace::createSketchOnPlane(const std::string&
   // This replaces manual iteration through construction planes and faces
   // ========================================================================
 
+  useSessionCache(design);
   Ptr<Base> planeEntity = nullptr;
-
   if (planeEntityId.empty()) {
     // No plane specified, use XY plane
     LOG_DEBUG("No plane entity ID provided, using XY plane");
     planeEntity = rootComp->xYConstructionPlane();
   } else {
-    LOG_DEBUG("Looking up plane entity directly: " << planeEntityId);
-
-    // Use the official Fusion API for O(1) entity lookup
-    std::vector<Ptr<Base>> entities = findEntitiesByToken(planeEntityId);
-
-    if (!entities.empty()) {
-      planeEntity = entities[0];
-      LOG_DEBUG("FOUND plane entity via direct lookup. Type: " << planeEntity->objectType());
-    } else {
-      LOG_WARNING("Direct plane lookup failed for token: " << planeEntityId);
-    }
+    // Still validated below, as a timeline edit can tilt a cached plane
+    planeEntity = findSketchPlane(planeEntityId);
   }
 
   // Fall back to XY plane if entity not found
@@ -149,7 +141,9 @@ std::unique_ptr<ISketch> FusionWorkspace::createSketchOnPlane(const std::string&
   }
 
   // Create the sketch on the plane
-  Ptr<adsk::fusion::Sketch> sketch = sketches->add(planeEntity);
+  prepareOutputComponent(rootComp);
+  Ptr<adsk::fusion::Sketch> sketch =
+      Utils::timedApiCall(Utils::ApiCallKind::Call, [&] { return sketches->add(planeEntity); });
   if (!sketch) {
     logApiError("sketches->add(planeEntity)");
     return nullptr;
@@ -157,11 +151,39 @@ std::unique_ptr<ISketch> FusionWorkspace::createSketchOnPlane(const std::string&
 
   // Set the sketch name
   sketch->name(name);
+  rememberRootSketch(name, sketch);
 
   LOG_DEBUG("Created sketch '" << name << "' on plane");
   return std::make_unique<FusionSketch>(name, app_, sketch);
 }
 
+Ptr<Base> FusionWorkspace::findSketchPlane(const std::string& planeEntityId) {
+  Ptr<adsk::fusion::Design> design = app_ ? app_->activeProduct() : nullptr;
+  if (!design || planeEntityId.empty()) {
+    return nullptr;
+  }
+
+  useSessionCache(design);
+  auto cached = sketchPlanes_.find(planeEntityId);
+  if (cached != sketchPlanes_.end() && cached->second && cached->second->isValid()) {
+    // Resolved by an earlier run
+    LOG_DEBUG("Using cached plane entity for token: " << planeEntityId);
+    return cached->second;
+  }
+
+  LOG_DEBUG("Looking up plane entity directly: " << planeEntityId);
+
+  // Use the official Fusion API for O(1) entity lookup
+  std::vector<Ptr<Base>> entities = findEntitiesByToken(planeEntityId);
+  if (entities.empty()) {
+    LOG_WARNING("Direct plane lookup failed for token: " << planeEntityId);
+    return nullptr;
+  }
+  sketchPlanes_[planeEntityId] = entities[0];
+  LOG_DEBUG("FOUND plane entity via direct lookup. Type: " << entities[0]->objectType());
+  return entities[0];
+}
+
 std::unique_ptr<ISketch> FusionWorkspace::findSketch(const std::string& name) {
   if (!app_) {
     return nullptr;
@@ -173,6 +195,16 @@ std::unique_ptr<ISketch> FusionWorkspace::findSketch(const std::string& name) {
     return nullptr;
   }
 
+  // Sketch found or created by an earlier call, unless deleted or renamed since
+  useSessionCache(design);
+  auto cached = rootSketches_.find(name);
+  if (cached != rootSketches_.end()) {
+    if (cached->second && cached->second->isValid() && cached->second->name() == name) {
+      return std::make_unique<FusionSketch>(name, app_, cached->second);
+    }
+    rootSketches_.erase(cached);
+  }
+
   // Get the root component
   Ptr<adsk::fusion::Component> rootComp = design->rootComponent();
   if (!rootComp) {
@@ -190,6 +222,7 @@ std::unique_ptr<ISketch> FusionWorkspace::findSketch(const std::string& name) {
     Ptr<adsk::fusion::Sketch> sketch = sketches->item(i);
     if (sketch && sketch->name() == name) {
       // Found existing sketch with matching name
+      rememberRootSketch(name, sketch);
       return std::make_unique<FusionSketch>(name, app_, sketch);
     }
   }
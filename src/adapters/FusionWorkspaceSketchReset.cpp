@@ -0,0 +1,194 @@
+/**
+ * FusionWorkspaceSketchReset.cpp
+ *
+ * Emptying an earlier run's output sketch for FusionWorkspace: entity by
+ * entity while that is cheap, else by recreating the sketch in its place;
+ * deleting one this run no longer writes
+ */
+
+#include <cmath>
+
+#include "FusionAPIAdapter.h"
+#include "utils/ApiCallTimer.h"
+#include "utils/UnitConversion.h"
+#include "utils/logging.h"
+
+using adsk::core::Base;
+using adsk::core::Ptr;
+using ChipCarving::Utils::ApiCallKind;
+using ChipCarving::Utils::timedApiCall;
+
+namespace ChipCarving {
+namespace Adapters {
+
+namespace {
+
+// Height of a construction plane or planar face parallel to XY (output sketches are on nothing else)
+bool xyPlaneHeight(const Ptr<Base>& entity, double& z) {
+  Ptr<adsk::core::Plane> plane;
+  Ptr<adsk::fusion::ConstructionPlane> constructionPlane = entity;
+  Ptr<adsk::fusion::BRepFace> face = entity;
+  if (constructionPlane) {
+    plane = constructionPlane->geometry();
+  } else if (face) {
+    Ptr<adsk::core::Surface> surface = face->geometry();
+    plane = surface;
+  }
+  Ptr<adsk::core::Vector3D> normal = plane ? plane->normal() : nullptr;
+  Ptr<adsk::core::Point3D> origin = plane ? plane->origin() : nullptr;
+  if (!normal || !origin || std::abs(std::abs(normal->z()) - 1.0) >= Utils::Tolerance::GEOMETRIC) {
+    return false;
+  }
+  z = origin->z();
+  return true;
+}
+
+// Delete every curve, then every point but the sketch origin, solving once at the end
+void deleteSketchEntities(const Ptr<adsk::fusion::Sketch>& sketch) {
+  bool wasDeferred = sketch->isComputeDeferred();
+  sketch->isComputeDeferred(true);
+  Ptr<adsk::fusion::SketchCurves> curves = sketch->sketchCurves();
+  for (size_t i = curves ? curves->count() : 0; i-- > 0;) {
+    Ptr<adsk::fusion::SketchCurve> curve = curves->item(i);
+    if (curve && curve->isValid()) {
+      timedApiCall(ApiCallKind::Call, [&] { return curve->deleteMe(); });
+    }
+  }
+  Ptr<adsk::fusion::SketchPoints> points = sketch->sketchPoints();
+  for (size_t i = points ? points->count() : 0; i-- > 0;) {
+    Ptr<adsk::fusion::SketchPoint> point = points->item(i);
+    if (point && point->isValid() && point->isDeletable()) {
+      timedApiCall(ApiCallKind::Call, [&] { return point->deleteMe(); });
+    }
+  }
+  sketch->isComputeDeferred(wasDeferred);
+}
+
+}  // namespace
+
+bool FusionWorkspace::isReplaceableOutputSketch(const Ptr<adsk::fusion::Design>& design,
+                                                const Ptr<adsk::fusion::Sketch>& sketch,
+                                                const std::string& planeEntityId) {
+  if (outputSessionDepth_ > 0 && outputDirectEdit_) {
+    // Direct-edit output goes into this run's base feature, not an earlier one
+    return false;
+  }
+  Ptr<adsk::fusion::Component> rootComp = design ? design->rootComponent() : nullptr;
+  Ptr<adsk::fusion::Component> parent = sketch && sketch->isValid() ? sketch->parentComponent() : nullptr;
+  if (!rootComp || !parent || parent->id() != rootComp->id()) {
+    return false;
+  }
+
+  // Only on the plane this run would create it on
+  useSessionCache(design);
+  Ptr<Base> wanted = rootComp->xYConstructionPlane();
+  if (!planeEntityId.empty()) {
+    wanted = findSketchPlane(planeEntityId);
+  }
+  double sketchZ = 0.0;
+  double wantedZ = 0.0;
+  if (!wanted || !xyPlaneHeight(sketch->referencePlane(), sketchZ) || !xyPlaneHeight(wanted, wantedZ) ||
+      std::abs(sketchZ - wantedZ) >= Utils::Tolerance::GEOMETRIC) {
+    LOG_DEBUG("Sketch '" << sketch->name() << "' is on another plane; leaving it as it is");
+    return false;
+  }
+  return true;
+}
+
+std::unique_ptr<ISketch> FusionWorkspace::resetSketch(std::unique_ptr<ISketch> sketch,
+                                                      const std::string& planeEntityId, size_t recreateAbove) {
+  auto* fusionSketch = dynamic_cast<FusionSketch*>(sketch.get());
+  if (!app_ || !fusionSketch) {
+    return nullptr;
+  }
+  Ptr<adsk::fusion::Sketch> native = fusionSketch->nativeSketch();
+  Ptr<adsk::fusion::Design> design = app_->activeProduct();
+  if (!isReplaceableOutputSketch(design, native, planeEntityId)) {
+    return nullptr;
+  }
+
+  Ptr<adsk::fusion::SketchCurves> curves = native->sketchCurves();
+  Ptr<adsk::fusion::SketchPoints> points = native->sketchPoints();
+  size_t entities = (curves ? curves->count() : 0) + (points ? points->count() : 0);
+  std::string name = native->name();
+  if (entities <= recreateAbove) {
+    LOG_DEBUG("Clearing " << entities << " entities of sketch '" << name << "'");
+    deleteSketchEntities(native);
+  } else {
+    LOG_DEBUG("Recreating sketch '" << name << "' instead of deleting its " << entities << " entities");
+    native = recreateSketch(design, native);
+    if (!native) {
+      return nullptr;
+    }
+  }
+  rememberRootSketch(name, native);
+  return std::make_unique<FusionSketch>(name, app_, native);
+}
+
+bool FusionWorkspace::deleteSketch(const std::string& name, const std::string& planeEntityId) {
+  std::unique_ptr<ISketch> sketch = findSketch(name);
+  auto* fusionSketch = dynamic_cast<FusionSketch*>(sketch.get());
+  Ptr<adsk::fusion::Sketch> native = fusionSketch ? fusionSketch->nativeSketch() : nullptr;
+  Ptr<adsk::fusion::Design> design = app_ ? app_->activeProduct() : nullptr;
+  if (!native || !isReplaceableOutputSketch(design, native, planeEntityId)) {
+    return false;
+  }
+  rootSketches_.erase(name);
+  if (!timedApiCall(ApiCallKind::Call, [&] { return native->deleteMe(); })) {
+    logApiError("sketch->deleteMe()");
+    return false;
+  }
+  LOG_DEBUG("Deleted sketch '" << name << "'");
+  return true;
+}
+
+Ptr<adsk::fusion::Sketch> FusionWorkspace::recreateSketch(const Ptr<adsk::fusion::Design>& design,
+                                                          const Ptr<adsk::fusion::Sketch>& sketch) {
+  Ptr<Base> plane = sketch->referencePlane();
+  Ptr<adsk::fusion::Component> component = sketch->parentComponent();
+  Ptr<adsk::fusion::Sketches> sketches = component ? component->sketches() : nullptr;
+  if (!plane || !sketches) {
+    return nullptr;
+  }
+  std::string name = sketch->name();
+  bool visible = sketch->isVisible();
+
+  // Parametric designs: the new sketch goes where the old one was, and the marker back where it was
+  Ptr<adsk::fusion::Timeline> timeline =
+      design->designType() == adsk::fusion::ParametricDesignType ? design->timeline() : nullptr;
+  Ptr<adsk::fusion::TimelineObject> item = timeline ? sketch->timelineObject() : nullptr;
+  int index = item ? item->index() : -1;
+  int marker = timeline ? timeline->markerPosition() : -1;
+  bool markerAtEnd = timeline && marker == static_cast<int>(timeline->count());
+
+  if (!timedApiCall(ApiCallKind::Call, [&] { return sketch->deleteMe(); })) {
+    logApiError("sketch->deleteMe()");
+    return nullptr;
+  }
+  if (index == 0) {
+    timeline->moveToBeginning();
+  } else if (index > 0) {
+    Ptr<adsk::fusion::TimelineObject> previous = timeline->item(index - 1);
+    if (previous) {
+      previous->rollTo(false);
+    }
+  }
+
+  Ptr<adsk::fusion::Sketch> created = timedApiCall(ApiCallKind::Call, [&] { return sketches->add(plane); });
+  if (markerAtEnd) {
+    timeline->moveToEnd();
+  } else if (index >= 0) {
+    // Every other item is back where it was, unless the sketch could not be added
+    timeline->markerPosition(created || marker <= index ? marker : marker - 1);
+  }
+  if (!created) {
+    logApiError("sketches->add(referencePlane)");
+    return nullptr;
+  }
+  created->name(name);
+  created->isVisible(visible);
+  return created;
+}
+
+}  // namespace Adapters
+}  // namespace ChipCarving
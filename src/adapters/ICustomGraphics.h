@@ -0,0 +1,41 @@
+/**
+ * Abstract interface for viewport custom graphics
+ * Split from IFusionInterface.h for maintainability
+ */
+
+#pragma once
+
+#include <vector>
+
+// Forward declarations
+namespace ChipCarving {
+namespace Geometry {
+struct Point3D;
+}  // namespace Geometry
+}  // namespace ChipCarving
+
+namespace ChipCarving {
+namespace Adapters {
+
+/**
+ * Geometry the viewport draws without storing it in the design, its timeline
+ * or the undo history. Each call uploads one buffer however many strips or
+ * points it holds, and the graphics stay shown after this object is gone.
+ * Allows testing without the Fusion 360 custom graphics API
+ */
+class ICustomGraphics {
+ public:
+  // What the graphics show; each role has its own color
+  enum class Role { MEDIAL_AXIS, CLEARANCE, OUTLINE, PREVIEW };
+
+  virtual ~ICustomGraphics() = default;
+
+  // Line strips in world coordinates (cm); strips with fewer than 2 points are skipped
+  virtual bool addLineStrips(const std::vector<std::vector<Geometry::Point3D>>& strips, Role role) = 0;
+
+  // Points in world coordinates (cm)
+  virtual bool addPointSet(const std::vector<Geometry::Point3D>& points, Role role) = 0;
+};
+
+}  // namespace Adapters
+}  // namespace ChipCarving
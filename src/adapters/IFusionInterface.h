@@ -5,15 +5,23 @@
 
 #pragma once
 
+#include <cstddef>
 #include <memory>
 #include <string>
 #include <vector>
 
+#include "ICustomGraphics.h"
+#include "MedialAxisParameters.h"
+#include "geometry/ProfileCurve.h"
+
 // Forward declarations
 namespace ChipCarving {
 namespace Geometry {
 class Shape;
+class ShapeOutlineBatch;
+struct Point2D;
 struct Point3D;
+struct PolylineSpan;
 }  // namespace Geometry
 }  // namespace ChipCarving
 
@@ -34,35 +42,6 @@ class ILogger {
   virtual void logError(const std::string& message) const = 0;
 };
 
-/**
- * Structure for medial axis processing parameters
- */
-struct MedialAxisParameters {
-  double polygonTolerance = 0.25;          // Maximum polygon approximation error (mm)
-  double samplingDistance = 1.0;           // Distance between sampled points (mm)
-  double clearanceCircleSpacing = 5.0;     // Distance between clearance circles (mm)
-  double crossSize = 3.0;                  // Size of center cross marks in mm (0 = no crosses)
-  bool forceBoundaryIntersections = true;  // Force sampling at boundary intersections
-  bool showMedialLines = true;             // Show medial axis lines in construction geometry
-  bool showClearanceCircles = true;        // Show clearance circles in construction geometry
-  bool showPolygonizedShape = false;       // Show polygonized shape outline
-  bool generateVisualization = false;      // Generate visualization sketches (default off)
-
-  // Tool parameters for V-carve generation
-  std::string toolName = "90° V-bit";  // Tool name for sketch naming
-  double toolAngle = 90.0;             // V-bit angle in degrees
-  double toolDiameter = 6.35;          // Tool diameter in mm (1/4 inch default)
-
-  // V-carve toolpath parameters
-  bool generateVCarveToolpaths = false;  // Generate V-carve toolpaths (default off)
-  double maxVCarveDepth = 25.0;          // Maximum V-carve depth in mm (safety limit, default 25mm)
-
-  // Surface projection parameters
-  std::string targetSurfaceId{};  // Entity ID of surface to project onto (empty =
-                                  // XY plane)
-  bool projectToSurface = true;   // Always project toolpaths onto surface
-};
-
 // Forward declaration for ProfileGeometry
 struct ProfileGeometry;
 
@@ -89,6 +68,8 @@ class IUserInterface {
   // Basic UI operations
   virtual void showMessageBox(const std::string& title, const std::string& message) = 0;
   virtual std::string showFileDialog(const std::string& title, const std::string& filter) = 0;
+  // Multi-select open dialog; empty if cancelled
+  virtual std::vector<std::string> showMultiFileDialog(const std::string& title, const std::string& filter) = 0;
   virtual std::string selectJsonFile() = 0;
   virtual bool confirmAction(const std::string& message) = 0;
 
@@ -96,6 +77,18 @@ class IUserInterface {
   virtual bool showParameterDialog(const std::string& title, MedialAxisParameters& params) = 0;
   virtual SketchSelection showSketchSelectionDialog(const std::string& title) = 0;
   virtual void updateSelectionCount(int count) = 0;
+
+  // Cancelable progress dialog for background jobs (main thread only)
+  virtual void showProgress(const std::string& title, const std::string& message, int maximum) = 0;
+  virtual void updateProgress(const std::string& message, int value, int maximum) = 0;
+  virtual bool wasProgressCancelled() = 0;
+  virtual void hideProgress() = 0;
+
+  // Performance report of a finished run, shown without interrupting the user (main thread only)
+  virtual void showRunReport(const std::string& report) = 0;
+
+  // Safe from any thread: have the main thread call PluginManager::pumpBackgroundGeneration()
+  virtual void notifyMainThread() = 0;
 };
 
 /**
@@ -114,8 +107,15 @@ class ISketch {
   virtual bool addArcByThreePointsToSketch(int startPointIndex, int midPointIndex, int endPointIndex) = 0;
   virtual bool addLineByTwoPointsToSketch(int startPointIndex, int endPointIndex) = 0;
   virtual bool deleteSketchPoint(int pointIndex) = 0;
+  // Batched 2D outline: each merged vertex becomes one sketch point (returns curves created)
+  virtual int addOutlineBatch(const Geometry::ShapeOutlineBatch& batch) = 0;
   virtual void finishSketch() = 0;
 
+  // Bulk edits defer sketch solving until the outermost endBulkEdit()
+  // (prefer SketchBulkEdit, which pairs the calls)
+  virtual void beginBulkEdit() = 0;
+  virtual void endBulkEdit() = 0;
+
   // Construction geometry methods
   virtual bool addConstructionLine(double x1, double y1, double x2, double y2) = 0;
   virtual bool addConstructionCircle(double centerX, double centerY, double radius) = 0;
@@ -124,11 +124,46 @@ class ISketch {
 
   // 3D sketch methods for V-carve toolpaths
   virtual bool addSpline3D(const std::vector<Geometry::Point3D>& points) = 0;
+  // Chained 3D lines and arcs sharing end points (see Geometry::fitPolylineSpans)
+  virtual bool addPolyline3D(const std::vector<Geometry::Point3D>& points,
+                             const std::vector<Geometry::PolylineSpan>& spans) = 0;
+  // Batched forms, one curve per path solved together; element i is false where path i failed
+  virtual std::vector<bool> addSplines3D(const std::vector<std::vector<Geometry::Point3D>>& paths) = 0;
+  virtual std::vector<bool> addPolylines3D(const std::vector<std::vector<Geometry::Point3D>>& paths,
+                                           const std::vector<std::vector<Geometry::PolylineSpan>>& spans) = 0;
   virtual bool addLine3D(double x1, double y1, double z1, double x2, double y2, double z2) = 0;
   virtual bool addPoint3D(double x, double y, double z) = 0;
 
   // Get 3D toolpath curves for solid operations
   virtual std::vector<std::string> getSketchCurveEntityIds() = 0;
+
+  // Curves added after setCurveTag() carry tag and their source profile's token (empty tag = untagged)
+  virtual void setCurveTag(const std::string& tag, const std::string& sourceToken) = 0;
+  virtual std::vector<std::string> getCurveTags() = 0;  // Distinct tags of all curves, "" for untagged ones
+  virtual int deleteCurvesWithTag(const std::string& tag) = 0;
+};
+
+/**
+ * Scoped ISketch bulk edit: sketch solving is deferred while any scope is open
+ */
+class SketchBulkEdit {
+ public:
+  explicit SketchBulkEdit(ISketch* sketch) : sketch_(sketch) {
+    if (sketch_) {
+      sketch_->beginBulkEdit();
+    }
+  }
+  ~SketchBulkEdit() {
+    if (sketch_) {
+      sketch_->endBulkEdit();
+    }
+  }
+
+  SketchBulkEdit(const SketchBulkEdit&) = delete;
+  SketchBulkEdit& operator=(const SketchBulkEdit&) = delete;
+
+ private:
+  ISketch* sketch_;
 };
 
 /**
@@ -152,9 +187,31 @@ class IWorkspace {
   // Find existing sketch by name
   virtual std::unique_ptr<ISketch> findSketch(const std::string& name) = 0;
 
+  /**
+   * Empty a sketch found by findSketch() for regeneration, keeping its name,
+   * plane, component and place in the timeline and browser. Up to recreateAbove
+   * curves and points are deleted one by one; a fuller sketch is deleted whole
+   * and recreated in its place, which costs Fusion a few calls instead of one
+   * per entity.
+   * @param planeEntityId Plane the caller would create the sketch on (as for createSketchOnPlane)
+   * @return The emptied sketch (possibly a new object), or nullptr if the sketch is on another plane,
+   *         in another component, in a direct-edit output session, or could not be emptied
+   */
+  virtual std::unique_ptr<ISketch> resetSketch(std::unique_ptr<ISketch> sketch, const std::string& planeEntityId,
+                                               size_t recreateAbove) = 0;
+
+  /**
+   * Delete the named sketch, under the conditions resetSketch() would reuse it
+   * @return False if there is no such sketch or it was left in place
+   */
+  virtual bool deleteSketch(const std::string& name, const std::string& planeEntityId) = 0;
+
   // Get all sketch names in the workspace
   virtual std::vector<std::string> getAllSketchNames() = 0;
 
+  // Every closed profile of the named sketch with its geometry extracted (invalid if there are none)
+  virtual SketchSelection getSketchProfiles(const std::string& sketchName) = 0;
+
   // Enhanced UI Phase 5.2: Profile geometry extraction
   // Structure to hold transformation parameters from world to unit circle
   // coordinates
@@ -165,7 +222,9 @@ class IWorkspace {
     double sketchPlaneZ = 0.0;  // Z position of the sketch plane (cm)
   };
 
-  virtual bool extractProfileVertices(const std::string& entityId, std::vector<std::pair<double, double>>& vertices,
+  // Outer loop of a profile in world coordinates (cm), written straight into the caller's
+  // vertices (cleared first, capacity kept), so each vertex is copied once out of Fusion
+  virtual bool extractProfileVertices(const std::string& entityId, std::vector<Geometry::Point2D>& vertices,
                                       TransformParams& transform) = 0;
 
   // Extract plane entity ID from a profile's parent sketch
@@ -178,18 +237,98 @@ class IWorkspace {
   // Returns the Z coordinate where a vertical line through (x,y) intersects the
   // surface Returns NaN if no intersection found
   virtual double getSurfaceZAtXY(const std::string& surfaceId, double x, double y) = 0;
+
+  // Batched form of getSurfaceZAtXY for many XY locations (cm)
+  // Scene setup (component list, ray direction, mesh data) is done once for the
+  // whole batch; the result has one entry per point, NaN where nothing was hit.
+  // Without useFaceEvaluator a target face is ray cast like any other surface
+  virtual std::vector<double> getSurfaceZBatch(const std::string& surfaceId,
+                                               const std::vector<Geometry::Point2D>& points,
+                                               bool useFaceEvaluator) = 0;
+
+  // Entity token lookups (profiles, sketch planes, surfaces) are indexed while
+  // any lookup session is open, so each token hits the design only once per
+  // session; the index is dropped when the outermost session ends
+  virtual void beginEntityLookupSession() = 0;
+  virtual void endEntityLookupSession() = 0;
+
+  // Drop indexed lookups without ending the session, and the sketch planes, target
+  // components and sketches remembered across runs (document activated or closed)
+  virtual void invalidateEntityLookups() = 0;
+
+  // Sketches created while any output session is open form one timeline group named after
+  // the outermost session; with directEdit they are written inside one base feature, outside
+  // the parametric recompute chain (prefer OutputSession, which pairs the calls)
+  virtual void beginOutputSession(const std::string& name, bool directEdit) = 0;
+  virtual void endOutputSession() = 0;
+
+  // Custom graphics group called name, replacing any group of that name
+  virtual std::unique_ptr<ICustomGraphics> createCustomGraphics(const std::string& name) = 0;
+
+  // Remove the custom graphics group called name, if there is one
+  virtual void removeCustomGraphics(const std::string& name) = 0;
+};
+
+/**
+ * Scoped IWorkspace entity lookup session
+ */
+class EntityLookupSession {
+ public:
+  explicit EntityLookupSession(IWorkspace* workspace) : workspace_(workspace) {
+    if (workspace_) {
+      workspace_->beginEntityLookupSession();
+    }
+  }
+  ~EntityLookupSession() {
+    if (workspace_) {
+      workspace_->endEntityLookupSession();
+    }
+  }
+
+  EntityLookupSession(const EntityLookupSession&) = delete;
+  EntityLookupSession& operator=(const EntityLookupSession&) = delete;
+
+ private:
+  IWorkspace* workspace_;
+};
+
+/**
+ * Scoped IWorkspace output session
+ */
+class OutputSession {
+ public:
+  OutputSession(IWorkspace* workspace, const std::string& name, bool directEdit) : workspace_(workspace) {
+    if (workspace_) {
+      workspace_->beginOutputSession(name, directEdit);
+    }
+  }
+  ~OutputSession() {
+    if (workspace_) {
+      workspace_->endOutputSession();
+    }
+  }
+
+  OutputSession(const OutputSession&) = delete;
+  OutputSession& operator=(const OutputSession&) = delete;
+
+ private:
+  IWorkspace* workspace_;
 };
 
 /**
  * Structure to store extracted profile geometry
  */
 struct ProfileGeometry {
-  std::vector<std::pair<double, double>> vertices{};  // Profile vertices in world coordinates (cm)
-  IWorkspace::TransformParams transform{};            // Transform parameters for the profile
-  std::string sketchName{};                           // Parent sketch name for debugging
-  double area = 0.0;                                  // Area from areaProperties (sq cm)
-  std::pair<double, double> centroid{0.0, 0.0};       // Centroid from areaProperties (cm)
-  std::string planeEntityId{};                        // Entity ID of the sketch plane
+  std::vector<Geometry::Point2D> vertices{};                      // Profile vertices in world coordinates (cm)
+  std::vector<std::vector<Geometry::Point2D>> holes{};            // Inner loops, same coordinates
+  std::vector<Geometry::ProfileCurve> curves{};                   // Exact outer loop in chain order, if no vertices
+  std::vector<std::vector<Geometry::ProfileCurve>> holeCurves{};  // Exact inner loops, same
+  IWorkspace::TransformParams transform{};                        // Transform parameters for the profile
+  std::string sketchName{};                                       // Parent sketch name for debugging
+  double area = 0.0;                                              // Area from areaProperties (sq cm)
+  std::pair<double, double> centroid{0.0, 0.0};                   // Centroid from areaProperties (cm)
+  std::string planeEntityId{};                                    // Entity ID of the sketch plane
+  std::string componentEntityId{};                                // Entity ID of the parent sketch's component
 };
 
 /**
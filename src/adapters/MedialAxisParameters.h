@@ -0,0 +1,149 @@
+/**
+ * Parameters of a medial axis and V-carve generation run
+ * Split from IFusionInterface.h for maintainability
+ */
+
+#pragma once
+
+#include <string>
+
+namespace ChipCarving {
+namespace Adapters {
+
+// Cutter families the V-carve depth is computed for
+enum class ToolShape {
+  V_BIT,           // Pointed cone
+  FLAT_TIP_V_BIT,  // Cone truncated by a flat of toolTipDiameter
+  TAPERED_BALL     // Cone ending in a ball of toolTipDiameter
+};
+
+/**
+ * Structure for medial axis processing parameters
+ */
+struct MedialAxisParameters {
+  double polygonTolerance = 0.25;          // Maximum polygon approximation error (mm)
+  double samplingDistance = 1.0;           // Distance between sampled points (mm)
+  double spurPruneLength = 0.0;            // Drop junction spurs shorter than this (mm, 0 = keep)
+  double spurPruneClearance = 0.0;         // Drop spurs whose clearance changes less than this (mm, 0 = keep)
+  bool adaptiveSampling = false;           // Sample by chord error instead of fixed distance
+  double samplingChordTolerance = 0.02;    // Max position/depth deviation for adaptive sampling (mm)
+  bool exactSampling = false;              // Fixed distance: sample exact chain distances, clearance to the profile
+  bool autoTolerance = false;              // Pick polygon tolerance and sampling distance per profile
+  double autoDepthError = 0.2;             // Auto: V-carve depth error allowed from polygonization (mm)
+  double autoToleranceMin = 0.01;          // Auto: polygon tolerance bounds (mm)
+  double autoToleranceMax = 0.5;
+  double autoSamplingMin = 0.1;            // Auto: sampling distance bounds (mm)
+  double autoSamplingMax = 2.0;
+  double clearanceCircleSpacing = 5.0;     // Distance between clearance circles (mm)
+  double crossSize = 3.0;                  // Size of center cross marks in mm (0 = no crosses)
+  bool forceBoundaryIntersections = true;  // Force sampling at boundary intersections
+  bool showMedialLines = true;             // Show medial axis lines in construction geometry
+  bool showClearanceCircles = true;        // Show clearance circles in construction geometry
+  bool showPolygonizedShape = false;       // Show polygonized shape outline
+  bool generateVisualization = false;      // Generate visualization sketches (default off)
+  bool visualizeAsCustomGraphics = true;   // Draw the visualization as viewport graphics, not a sketch
+
+  // Tool parameters for V-carve generation
+  std::string toolName = "90° V-bit";  // Tool name for sketch naming
+  double toolAngle = 90.0;             // V-bit angle in degrees (taper angle for a tapered ball)
+  double toolDiameter = 6.35;          // Tool diameter in mm (1/4 inch default); caps the clearance cut
+  ToolShape toolShape = ToolShape::V_BIT;
+  double toolTipDiameter = 0.0;  // Flat or ball tip diameter of the other tool shapes (mm)
+
+  // V-carve toolpath parameters
+  bool generateVCarveToolpaths = false;  // Generate V-carve toolpaths (default off)
+  double maxVCarveDepth = 25.0;          // Maximum V-carve depth in mm (safety limit, default 25mm)
+  double stepDownDepth = 0.0;            // Cut each path in passes at most this much deeper (mm, 0 = one pass)
+  double clearingStepover = 0.0;         // Clear regions wider than the depth limit reaches with offset loops
+                                         // this far apart at that depth (mm, 0 = off)
+  double pathMergeTolerance = 0.1;       // Maximum endpoint gap in mm for joining V-carve paths
+  bool minimizeRetracts = false;         // Cut each connected medial axis in the fewest continuous paths
+  bool orderToolpaths = true;            // Reorder V-carve paths to minimize rapid travel
+  bool allowPathReversal = true;         // Allow cutting paths in reverse when ordering
+  double pathSimplifyTolerance = 0.01;   // Max 3D deviation when thinning spline fit points (mm, 0 = off)
+  bool outputPolylines = false;          // Emit V-carve paths as 3D lines and arcs instead of fitted splines
+
+  // Direct G-code export (skips sketch curves and CAM regeneration)
+  std::string gcodeExportPath{};    // Also write V-carve toolpaths to this G-code file (empty = off)
+  bool gcodeSkipSketch = false;     // With a G-code file, do not create the toolpath sketch
+  double gcodeSafeZ = 5.0;          // Rapid height above the sketch plane (mm)
+  double gcodeFeedRate = 1000.0;    // Cutting feed (mm/min)
+  double gcodePlungeRate = 300.0;   // Plunge feed (mm/min)
+  int gcodeSpindleRpm = 18000;      // Spindle speed (0 = no spindle commands)
+  double gcodeArcTolerance = 0.01;  // Fit G2/G3 helical arcs within this distance (mm, 0 = G1 only)
+
+  // Offline review: profiles, medial axes colored by clearance and toolpaths colored by depth
+  std::string svgExportPath{};  // Write them to this SVG file (empty = off)
+
+  // Surface projection parameters
+  std::string targetSurfaceId{};  // Entity ID of surface to project onto (empty =
+                                  // XY plane)
+  bool projectToSurface = true;   // Always project toolpaths onto surface
+  double surfaceGridResolution = 0.0;  // Heightfield node spacing in mm (0 = query
+                                       // the surface at every V-carve point)
+  bool useFaceEvaluator = true;        // Project onto a target face with its surface evaluator (false = rays only)
+  bool surfaceSlopeCompensation = false;  // Deepen cuts on slopes so their depth is measured along the surface normal
+
+  // Scanned blank projected onto instead of the target surface (no Fusion surface needed)
+  std::string surfaceScanPath{};         // Heightmap PNG, height grid, PLY or STL file (empty = off)
+  double surfaceScanOriginX = 0.0;       // Design XY the scan's origin is placed at (mm)
+  double surfaceScanOriginY = 0.0;
+  double surfaceScanPixelSize = 0.1;     // Heightmap PNG pixel pitch (mm)
+  double surfaceScanHeightRange = 10.0;  // Heightmap PNG height of a white pixel (mm)
+  double surfaceScanZOffset = 0.0;       // Added to every scan height (mm)
+
+  // Performance parameters
+  bool useAnalyticMedialAxis = true;  // Closed-form medial axis for unedited imported shapes
+  bool useStraightSkeleton = false;   // Straight skeleton for profiles with only straight edges
+  bool useMedialAxisCache = true;     // Reuse medial axis results for unchanged profiles
+  bool shareRepeatedShapes = true;    // One medial axis per outline repeated under rotation, translation and scale
+  int medialAxisWorkers = 0;  // Worker threads for medial axis stage (0 = hardware
+                              // concurrency, 1 = sequential)
+  bool strictDeterminism = false;  // Bit-identical output for any worker count: medial axes computed during a
+                                   // run reach the caches only once it ends, in profile order
+  int medialAxisPartitionVertices = 0;  // Tile profiles with at least this many vertices across
+                                        // worker threads (0 = one diagram per profile)
+  bool detectSymmetry = false;  // Compute mirror-symmetric profiles from the wedge between two mirror axes
+                                // and reflect it onto the rest (within the polygon tolerance)
+  bool streamProfiles = true;  // Free each profile's polygon, medial axis and toolpaths once written, so
+                               // a pipelined run holds only its in-flight window
+  bool compactToolpathStorage = false;  // Hold computed toolpaths as float32 until they are written, halving
+                                        // the toolpath memory of runs that compute every profile first
+  bool checkpointToolpaths = true;  // Save each profile's V-carve paths once computed, so a rerun after a crash
+                                   // only writes sketches again (needs the medial axis disk cache)
+  int toolpathSketchPathLimit = 0;  // Start another toolpath sketch once one holds this many paths
+                                    // (0 = one sketch); bounds each sketch's solve cost
+  double spatialTileSize = 0.0;  // Generate whole-panel selections tile by tile on a square grid this wide (mm),
+                                 // each tile into its own sketches (0 = one run over the whole selection)
+  std::string tileJournalPath{};  // Tiled runs record their finished tiles here (empty = no journal)
+  bool resumeTiledRun = false;    // Skip the tiles the journal records; otherwise a tiled run starts it over
+  bool runInBackground = true;  // Compute on a worker thread with a cancelable progress dialog
+  bool incrementalRegeneration = false;  // Rewrite only the toolpaths of changed profiles in the existing sketch
+  bool progressiveRefinement = false;    // In the background, write coarse toolpaths first and replace them
+                                         // with exact ones batch by batch (limited like incremental regeneration)
+  bool outputToBaseFeature = false;      // Create the run's sketches inside one base feature (direct edit),
+                                         // outside the parametric recompute chain
+  double generationTimeBudget = 0.0;  // Seconds extraction and computation may take; coarse toolpaths are computed
+                                      // first and refined cheapest profile first until the deadline (0 = no limit;
+                                      // one output group, untiled, not incremental)
+};
+
+// True if toolpaths are projected onto a target face or a scanned blank, or onto the surface a caller
+// queries itself (surfaceGiven)
+inline bool projectsOntoSurface(const MedialAxisParameters& params, bool surfaceGiven = false) {
+  return params.projectToSurface &&
+         (surfaceGiven || !params.targetSurfaceId.empty() || !params.surfaceScanPath.empty());
+}
+
+// One V-bit of a multi-tool run; it replaces the tool fields of MedialAxisParameters
+struct ToolDefinition {
+  std::string toolName = "90° V-bit";
+  double toolAngle = 90.0;       // V-bit angle in degrees
+  double toolDiameter = 6.35;    // mm
+  ToolShape toolShape = ToolShape::V_BIT;
+  double toolTipDiameter = 0.0;  // mm
+  double maxVCarveDepth = 25.0;  // mm
+};
+
+}  // namespace Adapters
+}  // namespace ChipCarving
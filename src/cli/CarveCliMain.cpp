@@ -0,0 +1,272 @@
+/**
+ * CarveCliMain.cpp
+ *
+ * carve-cli: generate V-carve toolpaths from design files without Fusion 360
+ *
+ *   carve-cli --tool-angle 60 --formats json,gcode --output-dir out a.json b.json
+ *
+ * Designs are carved in parallel; each writes <output-dir>/<name>.<ext> per
+ * requested format. Exit status is 0 when every design produced toolpaths,
+ * 1 when any design failed and 2 on a usage error.
+ */
+
+#include <cstdlib>
+#include <iostream>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "cli/CarveJob.h"
+#include "cli/ToolpathWriter.h"
+#include "utils/logging.h"
+
+using ChipCarving::Cli::CarveJobResult;
+using ChipCarving::Cli::CarveOptions;
+using ChipCarving::Cli::ToolpathFormat;
+using ChipCarving::Geometry::GcodePost;
+
+namespace {
+
+const int EXIT_USAGE = 2;
+
+void printUsage(const char* program) {
+  std::cerr << "Usage: " << program << " [options] design.json|design.ccdb...\n"
+            << "Tool:\n"
+            << "  --tool-angle DEG     V-bit included angle, taper angle of a tapered ball (default 90)\n"
+            << "  --tool-diameter MM   Cutting diameter; wider clearances are cut no deeper (default 6.35)\n"
+            << "  --tool-shape SHAPE   v, flat-v or tapered-ball (default v)\n"
+            << "  --tip-diameter MM    Flat or ball tip diameter of flat-v and tapered-ball tools\n"
+            << "  --max-depth MM       Depth limit (default 25)\n"
+            << "  --step-down MM       Cut in passes at most this much deeper each (default 0 = one pass)\n"
+            << "  --clearing MM        Clear past the depth limit with offset loops this far apart (default 0 = off)\n"
+            << "Paths:\n"
+            << "  --tolerance MM       Shape polygonization error (default 0.25)\n"
+            << "  --sampling MM        Medial axis sampling distance (default 1)\n"
+            << "  --adaptive MM        Sample by chord error instead of fixed distance\n"
+            << "  --exact-sampling     Sample exact distances along the medial axis, clearance to the outline\n"
+            << "  --simplify MM        Toolpath simplification tolerance (default 0.01, 0 = off)\n"
+            << "  --no-analytic        Always use OpenVoronoi, even for unedited shapes\n"
+            << "  --no-shared-shapes   Compute repeated shapes separately instead of mapping one copy\n"
+            << "  --straight-skeleton  Take the straight skeleton of profiles with only straight edges\n"
+            << "  --symmetry           Compute mirror-symmetric edited shapes from one wedge between axes\n"
+            << "Output:\n"
+            << "  --formats LIST       Comma-separated json, svg, gcode (default json)\n"
+            << "  --output-dir DIR     Existing directory for outputs (default next to each design)\n"
+            << "  --safe-z MM          G-code rapid height (default 5)\n"
+            << "  --feed MM_MIN        G-code cutting feed (default 1000)\n"
+            << "  --plunge MM_MIN      G-code plunge feed (default 300)\n"
+            << "  --spindle RPM        G-code spindle speed, 0 = none (default 18000)\n"
+            << "  --arc-tolerance MM   G-code G2/G3 arc fitting tolerance, 0 = G1 only (default 0.01)\n"
+            << "  --simulate MM        Rasterize the cuts at this cell size, check them against the shapes\n"
+            << "                       and write <name>_simulation.png (gouges red, missed areas blue)\n"
+            << "  --simulate-gpu       Rasterize on the GPU where available (Metal on macOS)\n"
+            << "Run:\n"
+            << "  --jobs N             Worker threads (default: all cores)\n"
+            << "  --design-cache DIR   Existing directory of binary copies of the JSON designs, reused while\n"
+            << "                       each design is unchanged\n"
+            << "  --verbose            Log pipeline progress to stderr\n";
+}
+
+std::vector<ToolpathFormat> parseFormats(const std::string& list) {
+  std::vector<ToolpathFormat> formats;
+  std::stringstream stream(list);
+  std::string name;
+  while (std::getline(stream, name, ',')) {
+    ToolpathFormat format;
+    if (!ChipCarving::Cli::parseToolpathFormat(name, format)) {
+      throw std::invalid_argument("Unknown format: " + name);
+    }
+    formats.push_back(format);
+  }
+  return formats;
+}
+
+ChipCarving::Adapters::ToolShape parseToolShape(const std::string& name) {
+  if (name == "v") {
+    return ChipCarving::Adapters::ToolShape::V_BIT;
+  }
+  if (name == "flat-v") {
+    return ChipCarving::Adapters::ToolShape::FLAT_TIP_V_BIT;
+  }
+  if (name == "tapered-ball") {
+    return ChipCarving::Adapters::ToolShape::TAPERED_BALL;
+  }
+  throw std::invalid_argument("Unknown tool shape: " + name);
+}
+
+// <dir>/<design name without extension>; dir empty = alongside the design
+std::string outputStem(const std::string& designPath, const std::string& outputDir) {
+  size_t slash = designPath.find_last_of('/');
+  std::string name = slash == std::string::npos ? designPath : designPath.substr(slash + 1);
+  size_t dot = name.find_last_of('.');
+  if (dot != std::string::npos && dot > 0) {
+    name = name.substr(0, dot);
+  }
+  if (outputDir.empty()) {
+    return slash == std::string::npos ? name : designPath.substr(0, slash + 1) + name;
+  }
+  return outputDir + "/" + name;
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+  CarveOptions options;
+  options.params.generateVCarveToolpaths = true;
+  GcodePost gcode;
+  std::vector<ToolpathFormat> formats{ToolpathFormat::Json};
+  std::string outputDir;
+  std::vector<std::string> designPaths;
+
+  try {
+    for (int i = 1; i < argc; ++i) {
+      std::string arg = argv[i];
+      if (arg == "-h" || arg == "--help") {
+        printUsage(argv[0]);
+        return 0;
+      }
+      if (arg == "--no-analytic") {
+        options.params.useAnalyticMedialAxis = false;
+        continue;
+      }
+      if (arg == "--straight-skeleton") {
+        options.params.useStraightSkeleton = true;
+        continue;
+      }
+      if (arg == "--symmetry") {
+        options.params.detectSymmetry = true;
+        continue;
+      }
+      if (arg == "--exact-sampling") {
+        options.params.exactSampling = true;
+        continue;
+      }
+      if (arg == "--no-shared-shapes") {
+        options.params.shareRepeatedShapes = false;
+        continue;
+      }
+      if (arg == "--simulate-gpu") {
+        options.simulationGpu = true;
+        continue;
+      }
+      if (arg == "--verbose") {
+        SetMinLogLevel(LogLevel::INFO);
+        continue;
+      }
+      if (arg.compare(0, 2, "--") != 0) {
+        designPaths.push_back(arg);
+        continue;
+      }
+      if (i + 1 >= argc) {
+        throw std::invalid_argument("Missing value for " + arg);
+      }
+      std::string value = argv[++i];
+      if (arg == "--tool-angle") {
+        options.params.toolAngle = std::stod(value);
+      } else if (arg == "--tool-diameter") {
+        options.params.toolDiameter = std::stod(value);
+      } else if (arg == "--tool-shape") {
+        options.params.toolShape = parseToolShape(value);
+      } else if (arg == "--tip-diameter") {
+        options.params.toolTipDiameter = std::stod(value);
+      } else if (arg == "--max-depth") {
+        options.params.maxVCarveDepth = std::stod(value);
+      } else if (arg == "--step-down") {
+        options.params.stepDownDepth = std::stod(value);
+      } else if (arg == "--clearing") {
+        options.params.clearingStepover = std::stod(value);
+      } else if (arg == "--tolerance") {
+        options.params.polygonTolerance = std::stod(value);
+      } else if (arg == "--sampling") {
+        options.params.samplingDistance = std::stod(value);
+      } else if (arg == "--adaptive") {
+        options.params.adaptiveSampling = true;
+        options.params.samplingChordTolerance = std::stod(value);
+      } else if (arg == "--simplify") {
+        options.params.pathSimplifyTolerance = std::stod(value);
+      } else if (arg == "--formats") {
+        formats = parseFormats(value);
+      } else if (arg == "--output-dir") {
+        outputDir = value;
+      } else if (arg == "--safe-z") {
+        gcode.safeZ = std::stod(value);
+      } else if (arg == "--feed") {
+        gcode.feedRate = std::stod(value);
+      } else if (arg == "--plunge") {
+        gcode.plungeRate = std::stod(value);
+      } else if (arg == "--spindle") {
+        gcode.spindleRpm = std::stoi(value);
+      } else if (arg == "--arc-tolerance") {
+        gcode.arcTolerance = std::stod(value);
+      } else if (arg == "--simulate") {
+        options.simulationResolution = std::stod(value);
+      } else if (arg == "--jobs") {
+        options.workers = std::stoi(value);
+      } else if (arg == "--design-cache") {
+        options.designCacheDirectory = value;
+      } else {
+        throw std::invalid_argument("Unknown option: " + arg);
+      }
+    }
+    if (designPaths.empty()) {
+      throw std::invalid_argument("No design files given");
+    }
+    if (options.simulationResolution < 0.0) {
+      throw std::invalid_argument("--simulate must be a positive cell size");
+    }
+    if (options.params.toolAngle <= 0.0 || options.params.toolAngle >= 180.0) {
+      throw std::invalid_argument("--tool-angle must be between 0 and 180 degrees");
+    }
+    if (options.params.toolShape != ChipCarving::Adapters::ToolShape::V_BIT &&
+        options.params.toolTipDiameter >= options.params.toolDiameter) {
+      throw std::invalid_argument("--tip-diameter must be smaller than --tool-diameter");
+    }
+    if (options.params.toolShape != ChipCarving::Adapters::ToolShape::V_BIT && options.simulationResolution > 0.0) {
+      throw std::invalid_argument("--simulate models pointed V-bits only");
+    }
+  } catch (const std::exception& e) {
+    std::cerr << "carve-cli: " << e.what() << "\n";
+    printUsage(argv[0]);
+    return EXIT_USAGE;
+  }
+
+  std::vector<CarveJobResult> results = ChipCarving::Cli::runCarveJobs(designPaths, options);
+
+  int failures = 0;
+  for (const auto& result : results) {
+    if (!result.success) {
+      std::cerr << result.designPath << ": FAILED: " << result.errorMessage << "\n";
+      failures++;
+      continue;
+    }
+
+    std::string stem = outputStem(result.designPath, outputDir);
+    for (ToolpathFormat format : formats) {
+      std::string path = stem + ChipCarving::Cli::toolpathFormatExtension(format);
+      if (!ChipCarving::Cli::writeToolpathFile(path, format, result, options.params, gcode)) {
+        std::cerr << result.designPath << ": failed to write " << path << "\n";
+        failures++;
+      }
+    }
+    std::cout << result.designPath << ": " << result.shapeCount << " shapes (" << result.analyticShapes
+              << " analytic, " << result.sharedShapes << " shared, " << result.failedShapes << " failed), "
+              << result.toolpaths.size() << " toolpaths, " << static_cast<int>(result.elapsedMs) << " ms\n";
+    if (result.simulated) {
+      const auto& verification = result.verification;
+      std::string path = stem + "_simulation.png";
+      if (!ChipCarving::Geometry::writeCarveVerificationPng(path, result.simulation, verification)) {
+        std::cerr << result.designPath << ": failed to write " << path << "\n";
+        failures++;
+      }
+      bool gpu = result.simulation.backend == ChipCarving::Geometry::CarveSimulationBackend::GPU;
+      std::cout << result.designPath << ": simulation " << (gpu ? "(gpu) " : "")
+                << (verification.passed() ? "passed" : "FAILED") << ", "
+                << verification.carvedCells << "/" << verification.insideCells << " cells carved, "
+                << verification.gougeCells << " gouged (max " << verification.maxGougeDepth << " mm), "
+                << verification.missedCells << " missed\n";
+    }
+  }
+
+  return failures == 0 ? EXIT_SUCCESS : EXIT_FAILURE;
+}
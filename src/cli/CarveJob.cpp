@@ -0,0 +1,275 @@
+/**
+ * CarveJob.cpp
+ *
+ * Headless pipeline stages and the design-level worker pool for carve-cli
+ */
+
+#include "cli/CarveJob.h"
+
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <exception>
+#include <thread>
+
+#include "geometry/MedialAxisBatch.h"
+#include "geometry/MedialAxisEngine.h"
+#include "geometry/MedialAxisProcessor.h"
+#include "geometry/MedialAxisUtilities.h"
+#include "geometry/PolylineSimplifier.h"
+#include "geometry/ShapePolygonizer.h"
+#include "geometry/VCarveCalculator.h"
+#include "parsers/DesignParser.h"
+#include "utils/UnitConversion.h"
+#include "utils/logging.h"
+
+namespace ChipCarving {
+namespace Cli {
+
+namespace {
+
+// Same sampling policy as Core::sampleMedialAxisForVCarve; chains are
+// in cm like the plugin's profile polygons, so both samplers scale to mm
+void sampleChains(Geometry::MedialAxisProcessor& processor, const Geometry::MedialAxisResults& medialResult,
+                  const Adapters::MedialAxisParameters& params, const std::vector<Geometry::Point2D>& outline,
+                  std::vector<Geometry::SampledMedialPath>& sampledPaths) {
+  sampledPaths.clear();
+  bool forcing = params.forceBoundaryIntersections;
+  if (!params.adaptiveSampling && (forcing || params.exactSampling)) {
+    std::vector<std::vector<double>> crossings;
+    if (forcing) {
+      Geometry::findChainBoundaryCrossings(medialResult.chains, {&outline}, Utils::fusionLengthToMm(1.0), crossings);
+    }
+    if (params.exactSampling) {
+      Geometry::sampleMedialAxisChainsExact(medialResult.chains, Utils::fusionLengthToMm(1.0), params.samplingDistance,
+                                            {&outline}, sampledPaths, forcing ? &crossings : nullptr);
+    } else {
+      Geometry::sampleMedialAxisChains(medialResult.chains, Utils::fusionLengthToMm(1.0), params.samplingDistance,
+                                       sampledPaths, &crossings);
+    }
+    return;
+  }
+  if (!params.adaptiveSampling) {
+    processor.getSampledPaths(medialResult, params.samplingDistance, sampledPaths);
+    return;
+  }
+
+  Geometry::AdaptiveSamplingOptions samplingOptions;
+  samplingOptions.chordTolerance = params.samplingChordTolerance;
+  samplingOptions.depthPerClearance = 1.0 / std::tan((params.toolAngle * M_PI / 180.0) / 2.0);
+  samplingOptions.maxDepth = params.maxVCarveDepth;
+  Geometry::sampleMedialAxisChainsAdaptive(medialResult.chains, Utils::fusionLengthToMm(1.0), samplingOptions,
+                                           sampledPaths);
+}
+
+// Designs run in parallel with each other, so shapes go into one arena per design rather than
+// being built on threads of their own
+Parsers::DesignParseOptions cliParseOptions() {
+  Parsers::DesignParseOptions options;
+  options.arenaAllocation = true;
+  return options;
+}
+
+// Rasterize the final toolpaths and check them against the design's shapes
+void simulateDesign(const Parsers::DesignFile& design, const CarveOptions& options, int workers,
+                    CarveJobResult& result) {
+  Geometry::CarveSimulationParams simulation;
+  simulation.resolution = options.simulationResolution;
+  simulation.toolAngle = options.params.toolAngle;
+  simulation.toolDiameter = options.params.toolDiameter;
+  simulation.workers = workers;
+  if (options.simulationGpu) {
+    simulation.backend = Geometry::CarveSimulationBackend::GPU;
+  }
+
+  std::vector<const Geometry::Shape*> shapes;
+  for (const auto& shape : design.shapes) {
+    shapes.push_back(shape.get());
+  }
+  Geometry::ShapeBounds area =
+      Geometry::simulationArea(shapes, simulation.toolDiameter / 2.0 + simulation.resolution);
+  result.simulation = Geometry::simulateCarve(result.toolpaths, area, simulation);
+  result.verification = Geometry::verifyCarve(result.simulation, shapes, simulation);
+  result.simulated = true;
+}
+
+CarveJobResult carveDesign(const std::string& designPath, const Parsers::DesignFile& design,
+                           const CarveOptions& options, int medialAxisWorkers) {
+  const Adapters::MedialAxisParameters& params = options.params;
+  CarveJobResult result;
+  result.designPath = designPath;
+  result.shapeCount = static_cast<int>(design.shapes.size());
+
+  // Shapes are in mm; the medial axis runs in Fusion units (cm) so results
+  // match what the plugin computes for the same profiles
+  const double shapeScale = Utils::mmToFusionLength(1.0);
+  Geometry::MedialAxisProcessor processor;
+  processor.setPolygonTolerance(Utils::mmToFusionLength(params.polygonTolerance));
+  Geometry::SpurPruningOptions spurPruning;
+  spurPruning.minLength = Utils::mmToFusionLength(params.spurPruneLength);
+  spurPruning.minClearanceChange = Utils::mmToFusionLength(params.spurPruneClearance);
+  processor.setSpurPruning(spurPruning);
+  processor.setStraightSkeleton(params.useStraightSkeleton);
+  processor.setSymmetryDetection(params.detectSymmetry);
+  processor.setClearingOffsets(Geometry::VCarveCalculator::clearingOffsets(params));
+
+  // Unedited Leaf and TriArc shapes take the closed form; the rest go to OpenVoronoi in one parallel batch
+  Geometry::MedialAxisEngineSet analytic = params.useAnalyticMedialAxis
+                                               ? Geometry::MedialAxisEngineSet::analytic(processor)
+                                               : Geometry::MedialAxisEngineSet();
+  std::vector<Geometry::MedialAxisResults> medialResults(design.shapes.size());
+  std::vector<size_t> voronoiIndices;
+  std::vector<std::vector<Geometry::Point2D>> voronoiPolygons;
+  for (size_t i = 0; i < design.shapes.size(); ++i) {
+    std::vector<Geometry::Point2D> outline = Geometry::polygonizeShape(*design.shapes[i], params.polygonTolerance);
+    std::vector<Geometry::Point2D> polygon;
+    polygon.reserve(outline.size());
+    for (const auto& point : outline) {
+      polygon.push_back(point * shapeScale);
+    }
+    result.outlines.push_back(std::move(outline));
+
+    Geometry::MedialAxisProfile profile;
+    profile.polygon = &polygon;
+    profile.sourceShape = design.shapes[i].get();
+    profile.shapeScale = shapeScale;
+    profile.matchTolerance = Utils::Tolerance::GEOMETRIC;
+    if (analytic.size() > 0 &&
+        analytic.compute(profile, medialResults[i]) != Geometry::MedialAxisEngineSet::NO_ENGINE) {
+      result.analyticShapes++;
+      continue;
+    }
+    voronoiIndices.push_back(i);
+    voronoiPolygons.push_back(std::move(polygon));
+  }
+
+  std::vector<Geometry::MedialAxisResults> voronoiResults;
+  if (params.shareRepeatedShapes) {
+    size_t sharedShapes = 0;
+    voronoiResults = Geometry::computeDeduplicatedMedialAxisBatch(voronoiPolygons, processor, medialAxisWorkers,
+                                                                  nullptr, nullptr, &sharedShapes);
+    result.sharedShapes = static_cast<int>(sharedShapes);
+  } else {
+    voronoiResults = Geometry::computeMedialAxisBatch(voronoiPolygons, processor, medialAxisWorkers);
+  }
+  for (size_t j = 0; j < voronoiIndices.size(); ++j) {
+    medialResults[voronoiIndices[j]] = std::move(voronoiResults[j]);
+  }
+
+  Geometry::VCarveCalculator calculator;
+  Geometry::PolylineSimplifier simplifier;
+  std::vector<Geometry::SampledMedialPath> sampledPaths;
+  for (size_t i = 0; i < medialResults.size(); ++i) {
+    const Geometry::MedialAxisResults& medialResult = medialResults[i];
+    if (!medialResult.success) {
+      LOG_INFO(designPath << ": shape " << i << " medial axis failed: " << medialResult.errorMessage);
+      result.failedShapes++;
+      continue;
+    }
+
+    std::vector<Geometry::Point2D> outline;
+    if (params.forceBoundaryIntersections) {
+      for (const auto& point : result.outlines[i]) {
+        outline.push_back(point * shapeScale);
+      }
+    }
+    sampleChains(processor, medialResult, params, outline, sampledPaths);
+    Geometry::VCarveResults vcarveResults =
+        calculator.generateVCarvePaths(sampledPaths, params, &medialResult.graph, &medialResult.clearingLoops);
+    if (!vcarveResults.success) {
+      LOG_INFO(designPath << ": shape " << i << " V-carve failed: " << vcarveResults.errorMessage);
+      result.failedShapes++;
+      continue;
+    }
+
+    for (const auto& vcarvePath : vcarveResults.paths) {
+      if (!vcarvePath.isValid()) {
+        continue;
+      }
+      std::vector<Geometry::Point3D> toolpath;
+      toolpath.reserve(vcarvePath.points.size());
+      for (const auto& vcarvePoint : vcarvePath.points) {
+        toolpath.emplace_back(vcarvePoint.position, vcarvePoint.depth > 0.0 ? -vcarvePoint.depth : 0.0);
+      }
+      if (params.pathSimplifyTolerance > 0.0) {
+        simplifier.simplify(toolpath, params.pathSimplifyTolerance);
+      }
+      result.toolpaths.push_back(std::move(toolpath));
+    }
+  }
+
+  result.success = result.failedShapes < result.shapeCount;
+  if (!result.success) {
+    result.errorMessage = "No shape produced a toolpath";
+  } else if (options.simulationResolution > 0.0) {
+    simulateDesign(design, options, medialAxisWorkers, result);
+  }
+  return result;
+}
+
+template <typename Load>
+CarveJobResult timedJob(const std::string& designPath, const CarveOptions& options, int medialAxisWorkers,
+                        Load load) {
+  auto start = std::chrono::steady_clock::now();
+  CarveJobResult result;
+  try {
+    result = carveDesign(designPath, load(), options, medialAxisWorkers);
+  } catch (const std::exception& e) {
+    result = CarveJobResult();
+    result.designPath = designPath;
+    result.errorMessage = e.what();
+  }
+  result.elapsedMs =
+      std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+  return result;
+}
+
+}  // namespace
+
+CarveJobResult runCarveJobFromString(const std::string& designPath, const std::string& jsonContent,
+                                     const CarveOptions& options, int medialAxisWorkers) {
+  return timedJob(designPath, options, medialAxisWorkers,
+                  [&jsonContent]() { return Parsers::DesignParser::parseFromString(jsonContent, cliParseOptions()); });
+}
+
+CarveJobResult runCarveJob(const std::string& designPath, const CarveOptions& options, int medialAxisWorkers) {
+  return timedJob(designPath, options, medialAxisWorkers,
+                  [&designPath, &options]() {
+                    Parsers::DesignParseOptions parseOptions = cliParseOptions();
+                    parseOptions.binaryCacheDirectory = options.designCacheDirectory;
+                    return Parsers::DesignParser::parseFromFile(designPath, parseOptions);
+                  });
+}
+
+std::vector<CarveJobResult> runCarveJobs(const std::vector<std::string>& designPaths, const CarveOptions& options) {
+  std::vector<CarveJobResult> results(designPaths.size());
+  int workers = Geometry::resolveMedialAxisWorkerCount(options.workers, designPaths.size());
+
+  if (workers == 1) {
+    for (size_t i = 0; i < designPaths.size(); ++i) {
+      results[i] = runCarveJob(designPaths[i], options, options.workers);
+    }
+    return results;
+  }
+
+  // Same pull-next-index pool as computeMedialAxisBatch, one design per pull
+  std::atomic<size_t> nextIndex{0};
+  auto worker = [&]() {
+    for (size_t i = nextIndex.fetch_add(1); i < designPaths.size(); i = nextIndex.fetch_add(1)) {
+      results[i] = runCarveJob(designPaths[i], options, 1);
+    }
+  };
+
+  std::vector<std::thread> threads;
+  threads.reserve(static_cast<size_t>(workers));
+  for (int t = 0; t < workers; ++t) {
+    threads.emplace_back(worker);
+  }
+  for (auto& thread : threads) {
+    thread.join();
+  }
+  return results;
+}
+
+}  // namespace Cli
+}  // namespace ChipCarving
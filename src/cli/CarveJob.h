@@ -0,0 +1,80 @@
+/**
+ * CarveJob.h
+ *
+ * Headless V-carve pipeline for carve-cli: design file -> shape polygons ->
+ * medial axis -> V-carve toolpaths, with no Fusion dependency. Designs are
+ * independent, so a batch runs one design per worker thread.
+ */
+
+#pragma once
+
+#include <string>
+#include <vector>
+
+#include "adapters/IFusionInterface.h"
+#include "geometry/CarveSimulation.h"
+#include "geometry/Point2D.h"
+#include "geometry/Point3D.h"
+
+namespace ChipCarving {
+namespace Cli {
+
+/**
+ * Options shared by every job in a batch
+ */
+struct CarveOptions {
+  Adapters::MedialAxisParameters params{};  // Tool, sampling and path options (mm); surface options are ignored
+  int workers = 0;                          // Worker threads (0 = hardware concurrency, 1 = sequential)
+  double simulationResolution = 0.0;        // Stock-removal check cell size (mm, 0 = off)
+  bool simulationGpu = false;               // Rasterize the check on the GPU where available
+  std::string designCacheDirectory{};       // Binary design cache for JSON designs (empty = off)
+};
+
+/**
+ * Toolpaths for one design, in design units (mm)
+ */
+struct CarveJobResult {
+  std::string designPath{};
+  bool success = false;
+  std::string errorMessage{};
+
+  std::vector<std::vector<Geometry::Point2D>> outlines{};  // Polygonized shape boundaries
+  std::vector<std::vector<Geometry::Point3D>> toolpaths{};  // Cut order; z = -depth below the stock top
+  int shapeCount = 0;
+  int failedShapes = 0;  // Shapes whose medial axis could not be computed
+  int analyticShapes = 0;
+  int sharedShapes = 0;  // Shapes whose medial axis was mapped from a repeated copy
+  double elapsedMs = 0.0;
+
+  // Stock-removal simulation of the toolpaths, checked against the shapes
+  bool simulated = false;
+  Geometry::DepthMap simulation{};
+  Geometry::CarveVerification verification{};
+};
+
+/**
+ * Run the pipeline on every shape of an already-read design
+ * @param designPath Path or name recorded in the result
+ * @param jsonContent Design-schema-v2 document
+ * @param options Tool and path options
+ * @param medialAxisWorkers Workers for the OpenVoronoi stage of this design
+ */
+CarveJobResult runCarveJobFromString(const std::string& designPath, const std::string& jsonContent,
+                                     const CarveOptions& options, int medialAxisWorkers = 1);
+
+/**
+ * Read and carve one design file; errors are reported in the result, never thrown
+ */
+CarveJobResult runCarveJob(const std::string& designPath, const CarveOptions& options, int medialAxisWorkers = 1);
+
+/**
+ * Carve a batch of design files
+ *
+ * Each worker takes the next unprocessed design, so long and short designs
+ * balance across cores. A batch of one design spends the workers on its
+ * medial axis stage instead. Results are returned in input order.
+ */
+std::vector<CarveJobResult> runCarveJobs(const std::vector<std::string>& designPaths, const CarveOptions& options);
+
+}  // namespace Cli
+}  // namespace ChipCarving
@@ -0,0 +1,65 @@
+/**
+ * ConsoleLogging.cpp
+ *
+ * Logging backend for carve-cli: writes to stderr instead of the Fusion Text
+ * Commands window. Batch workers log concurrently, so lines are serialized.
+ */
+
+#include <atomic>
+#include <iostream>
+#include <mutex>
+
+#include "utils/logging.h"
+
+// Global minimum log level (WARNING keeps batch output readable; --verbose lowers it)
+static std::atomic<LogLevel> g_minLogLevel{LogLevel::WARNING};
+
+// Per-thread suppression flag (mirrors the plugin implementation)
+static thread_local bool t_consoleLoggingSuppressed = false;
+
+static std::mutex g_outputMutex;
+
+void LogToConsole(const std::string& message) {
+  LogToConsole(LogLevel::INFO, message);
+}
+
+void LogToConsole(LogLevel level, const std::string& message) {
+  if (t_consoleLoggingSuppressed || static_cast<int>(level) < static_cast<int>(g_minLogLevel.load())) {
+    return;
+  }
+
+  const char* levelPrefix = "[INFO]";
+  switch (level) {
+    case LogLevel::LOG_DEBUG:
+      levelPrefix = "[DEBUG]";
+      break;
+    case LogLevel::INFO:
+      break;
+    case LogLevel::WARNING:
+      levelPrefix = "[WARN]";
+      break;
+    case LogLevel::ERROR:
+      levelPrefix = "[ERROR]";
+      break;
+  }
+
+  std::lock_guard<std::mutex> lock(g_outputMutex);
+  std::cerr << levelPrefix << " " << message << std::endl;
+}
+
+void SetMinLogLevel(LogLevel level) {
+  g_minLogLevel = level;
+}
+
+LogLevel GetMinLogLevel() {
+  return g_minLogLevel;
+}
+
+void SetThreadConsoleLoggingSuppressed(bool suppressed) {
+  t_consoleLoggingSuppressed = suppressed;
+}
+
+// stderr is shared by all threads under g_outputMutex, so nothing is queued
+void SetConsoleLogMainThread(std::function<void()> /* wakeMainThread */) {}
+
+void FlushQueuedConsoleLog() {}
@@ -0,0 +1,168 @@
+/**
+ * ToolpathWriter.cpp
+ *
+ * JSON, SVG and G-code serialization of carve-cli results
+ */
+
+#include "cli/ToolpathWriter.h"
+
+#include <algorithm>
+#include <cstdio>
+#include <fstream>
+#include <iomanip>
+#include <limits>
+#include <sstream>
+
+namespace ChipCarving {
+namespace Cli {
+
+namespace {
+
+const double SVG_MARGIN = 5.0;  // mm around the design bounds
+
+void writeJsonString(std::ostream& out, const std::string& text) {
+  out << '"';
+  for (char c : text) {
+    if (c == '"' || c == '\\') {
+      out << '\\' << c;
+    } else if (static_cast<unsigned char>(c) < 0x20) {
+      char escaped[8];
+      std::snprintf(escaped, sizeof(escaped), "\\u%04x", static_cast<unsigned char>(c));
+      out << escaped;
+    } else {
+      out << c;
+    }
+  }
+  out << '"';
+}
+
+void writeSvgPoints(std::ostream& out, const std::vector<Geometry::Point2D>& points) {
+  for (size_t i = 0; i < points.size(); ++i) {
+    out << (i > 0 ? " " : "") << points[i].x << "," << -points[i].y;
+  }
+}
+
+}  // namespace
+
+bool parseToolpathFormat(const std::string& name, ToolpathFormat& format) {
+  if (name == "json") {
+    format = ToolpathFormat::Json;
+  } else if (name == "svg") {
+    format = ToolpathFormat::Svg;
+  } else if (name == "gcode") {
+    format = ToolpathFormat::Gcode;
+  } else {
+    return false;
+  }
+  return true;
+}
+
+const char* toolpathFormatExtension(ToolpathFormat format) {
+  switch (format) {
+    case ToolpathFormat::Svg:
+      return ".svg";
+    case ToolpathFormat::Gcode:
+      return ".nc";
+    case ToolpathFormat::Json:
+    default:
+      return ".json";
+  }
+}
+
+void writeToolpathJson(std::ostream& out, const CarveJobResult& result, const Adapters::MedialAxisParameters& params) {
+  out << std::fixed << std::setprecision(4);
+  out << "{\"design\": ";
+  writeJsonString(out, result.designPath);
+  out << ", \"tool\": {\"name\": ";
+  writeJsonString(out, params.toolName);
+  out << ", \"angle\": " << params.toolAngle << ", \"maxDepth\": " << params.maxVCarveDepth << "}";
+  out << ", \"shapes\": " << result.shapeCount << ", \"failedShapes\": " << result.failedShapes;
+  out << ", \"toolpaths\": [";
+  for (size_t p = 0; p < result.toolpaths.size(); ++p) {
+    out << (p > 0 ? ",\n  [" : "\n  [");
+    const auto& toolpath = result.toolpaths[p];
+    for (size_t i = 0; i < toolpath.size(); ++i) {
+      out << (i > 0 ? ", [" : "[") << toolpath[i].x << ", " << toolpath[i].y << ", " << toolpath[i].z << "]";
+    }
+    out << "]";
+  }
+  out << "\n]}\n";
+}
+
+void writeToolpathSvg(std::ostream& out, const CarveJobResult& result) {
+  double minX = std::numeric_limits<double>::max();
+  double minY = minX;
+  double maxX = std::numeric_limits<double>::lowest();
+  double maxY = maxX;
+  for (const auto& outline : result.outlines) {
+    for (const auto& point : outline) {
+      minX = std::min(minX, point.x);
+      minY = std::min(minY, point.y);
+      maxX = std::max(maxX, point.x);
+      maxY = std::max(maxY, point.y);
+    }
+  }
+  if (minX > maxX) {
+    minX = minY = maxX = maxY = 0.0;
+  }
+
+  // SVG y grows downwards; points are written with y negated
+  out << std::fixed << std::setprecision(3);
+  out << "<svg xmlns=\"http://www.w3.org/2000/svg\" viewBox=\"" << minX - SVG_MARGIN << " " << -maxY - SVG_MARGIN
+      << " " << maxX - minX + 2 * SVG_MARGIN << " " << maxY - minY + 2 * SVG_MARGIN << "\">\n";
+  out << "<g fill=\"none\" stroke=\"#999\" stroke-width=\"0.2\">\n";
+  for (const auto& outline : result.outlines) {
+    out << "<polygon points=\"";
+    writeSvgPoints(out, outline);
+    out << "\"/>\n";
+  }
+  out << "</g>\n<g fill=\"none\" stroke=\"#d00\" stroke-width=\"0.3\">\n";
+  std::vector<Geometry::Point2D> plan;
+  for (const auto& toolpath : result.toolpaths) {
+    plan.clear();
+    for (const auto& point : toolpath) {
+      plan.emplace_back(point.x, point.y);
+    }
+    out << "<polyline points=\"";
+    writeSvgPoints(out, plan);
+    out << "\"/>\n";
+  }
+  out << "</g>\n</svg>\n";
+}
+
+void writeToolpathGcode(std::ostream& out, const CarveJobResult& result, const Adapters::MedialAxisParameters& params,
+                        const Geometry::GcodePost& post) {
+  std::ostringstream title;
+  title << "carve-cli " << result.designPath << ", " << params.toolAngle << " deg V-bit, max depth "
+        << params.maxVCarveDepth;
+
+  Geometry::GcodeWriter gcode(out, post);
+  gcode.begin(title.str());
+  for (const auto& toolpath : result.toolpaths) {
+    gcode.writePath(toolpath);
+  }
+  gcode.end();
+}
+
+bool writeToolpathFile(const std::string& path, ToolpathFormat format, const CarveJobResult& result,
+                       const Adapters::MedialAxisParameters& params, const Geometry::GcodePost& post) {
+  std::ofstream out(path);
+  if (!out) {
+    return false;
+  }
+  switch (format) {
+    case ToolpathFormat::Json:
+      writeToolpathJson(out, result, params);
+      break;
+    case ToolpathFormat::Svg:
+      writeToolpathSvg(out, result);
+      break;
+    case ToolpathFormat::Gcode:
+      writeToolpathGcode(out, result, params, post);
+      break;
+  }
+  return static_cast<bool>(out);
+}
+
+}  // namespace Cli
+}  // namespace ChipCarving
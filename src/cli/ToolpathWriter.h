@@ -0,0 +1,56 @@
+/**
+ * ToolpathWriter.h
+ *
+ * Output formats for carve-cli toolpaths: JSON for regression comparisons,
+ * SVG for a quick visual check, and G-code for the machine.
+ */
+
+#pragma once
+
+#include <ostream>
+#include <string>
+
+#include "cli/CarveJob.h"
+#include "geometry/GcodeWriter.h"
+
+namespace ChipCarving {
+namespace Cli {
+
+enum class ToolpathFormat { Json, Svg, Gcode };
+
+/**
+ * @return false if name is not "json", "svg" or "gcode"
+ */
+bool parseToolpathFormat(const std::string& name, ToolpathFormat& format);
+
+/**
+ * File extension (with dot) for a format
+ */
+const char* toolpathFormatExtension(ToolpathFormat format);
+
+/**
+ * {"design": ..., "tool": {...}, "shapes": N, "toolpaths": [[[x, y, z], ...], ...]}
+ */
+void writeToolpathJson(std::ostream& out, const CarveJobResult& result, const Adapters::MedialAxisParameters& params);
+
+/**
+ * Plan view: shape outlines in grey, toolpaths in red, y up
+ */
+void writeToolpathSvg(std::ostream& out, const CarveJobResult& result);
+
+/**
+ * Absolute-coordinate G-code with one plunge-cut-retract cycle per toolpath,
+ * written by the same GcodeWriter as the add-in's direct export
+ */
+void writeToolpathGcode(std::ostream& out, const CarveJobResult& result, const Adapters::MedialAxisParameters& params,
+                        const Geometry::GcodePost& post);
+
+/**
+ * Write a result in the given format
+ * @return false if the file could not be written
+ */
+bool writeToolpathFile(const std::string& path, ToolpathFormat format, const CarveJobResult& result,
+                       const Adapters::MedialAxisParameters& params, const Geometry::GcodePost& post);
+
+}  // namespace Cli
+}  // namespace ChipCarving
@@ -11,6 +11,8 @@
 #include <map>
 #include <memory>
 #include <string>
+#include <unordered_map>
+#include <unordered_set>
 #include <vector>
 
 #include "adapters/IFusionInterface.h"
@@ -40,9 +42,8 @@ class BaseCommandHandler : public adsk::core::CommandCreatedEventHandler {
   BaseCommandHandler& operator=(BaseCommandHandler&&) = delete;
 
  protected:
-  std::shared_ptr<Core::PluginManager> pluginManager() const {
-    return pluginManager_;
-  }
+  // Initializes the plugin manager on first use, so the add-in loads without creating it (null on failure)
+  std::shared_ptr<Core::PluginManager> pluginManager() const;
 
  private:
   std::shared_ptr<Core::PluginManager> pluginManager_;
@@ -63,7 +64,7 @@ class ImportDesignCommandHandler : public BaseCommandHandler {
   void handleInputChanged(const adsk::core::Ptr<adsk::core::InputChangedEventArgs>& args);
   void cleanupEventHandlers();
 
-  std::string selectedFilePath_;
+  std::vector<std::string> selectedFilePaths_;
 
   // Event handlers for cleanup (Issue #1: Event Handler Memory Management)
   std::vector<adsk::core::CommandEventHandler*> commandEventHandlers_;
@@ -84,24 +85,80 @@ class GeneratePathsCommandHandler : public BaseCommandHandler {
   // Helper methods for dialog creation
   void createParameterInputs(const adsk::core::Ptr<adsk::core::CommandInputs>& inputs);
   Adapters::MedialAxisParameters getParametersFromInputs(const adsk::core::Ptr<adsk::core::CommandInputs>& inputs);
+  void createGcodeExportInputs(const adsk::core::Ptr<adsk::core::CommandInputs>& inputs);
+  void readGcodeExportParameters(const adsk::core::Ptr<adsk::core::CommandInputs>& inputs,
+                                 Adapters::MedialAxisParameters& params);
+  void createSurfaceScanInputs(const adsk::core::Ptr<adsk::core::CommandInputs>& inputs);
+  void readSurfaceScanParameters(const adsk::core::Ptr<adsk::core::CommandInputs>& inputs,
+                                 Adapters::MedialAxisParameters& params);
+  void createSamplingInputs(const adsk::core::Ptr<adsk::core::CommandInputs>& inputs);
+  void readSamplingParameters(const adsk::core::Ptr<adsk::core::CommandInputs>& inputs,
+                              Adapters::MedialAxisParameters& params);
+  void createRunInputs(const adsk::core::Ptr<adsk::core::CommandInputs>& inputs);
+  void readRunParameters(const adsk::core::Ptr<adsk::core::CommandInputs>& inputs,
+                         Adapters::MedialAxisParameters& params);
   Adapters::SketchSelection getSelectionFromInputs(const adsk::core::Ptr<adsk::core::CommandInputs>& inputs);
 
   // Enhanced UI Phase 4: Command execution
   void executeMedialAxisProcessing(const adsk::core::Ptr<adsk::core::CommandInputs>& inputs);
 
-  // Immediate geometry extraction (prevents stale tokens)
-  void clearCachedGeometry();
-  void extractAndCacheProfileGeometry(const adsk::core::Ptr<adsk::fusion::Profile>& profile, int index);
+  // Live coarse preview (custom graphics) of the current inputs; restarted on every input change
+  void previewMedialAxisProcessing(const adsk::core::Ptr<adsk::core::CommandInputs>& inputs);
+  void clearPreview();
 
-  // Selection validation
+  // Geometry extraction, batched per burst of selection changes (prevents stale tokens)
+  struct PendingProfile;  // Read from Fusion, loops not chained yet
+  void clearCachedGeometry();
+  // Selection changes only mark the cache stale; the next preview or execute extracts the whole burst at once
+  void markCachedGeometryStale();
+  void flushCachedGeometry(const adsk::core::Ptr<adsk::core::CommandInputs>& inputs);
+  // Cache the selection's profiles in selection order, extracting only those not cached yet
+  void updateCachedGeometry(const adsk::core::Ptr<adsk::core::SelectionCommandInput>& selectionInput);
+  // Main thread: false if the profile was cached from an earlier extraction instead
+  bool readProfileGeometry(const adsk::core::Ptr<adsk::fusion::Profile>& profile, int index, PendingProfile& pending);
+  // Chain every stroked loop of the batch on worker threads; no Fusion calls
+  void chainPendingProfiles(std::vector<PendingProfile>& pending);
+  void cacheExtractedProfile(PendingProfile& pending);
+  // Keep the geometry extracted by earlier dialogs while design stays the active one
+  void useProfileGeometryCache(const adsk::core::Ptr<adsk::fusion::Design>& design);
+
+  // Selection validation; each selection change examines only the entities added or removed since the last
+  struct SketchProfileIndex {
+    std::vector<std::vector<std::string>> closedProfileCurves{};             // Curve tokens of each closed profile
+    std::unordered_map<std::string, std::vector<size_t>> profilesByCurve{};  // Closed profiles using a curve
+  };
+  struct ValidatedEntity {
+    bool isProfile = false;
+    std::string sketchToken{};  // Parent sketch of a curve
+  };
+  const SketchProfileIndex& sketchProfileIndex(const adsk::core::Ptr<adsk::fusion::Sketch>& sketch);
   bool isPartOfClosedProfile(const adsk::core::Ptr<adsk::fusion::SketchCurve>& curve);
   void validateAndCleanSelection(const adsk::core::Ptr<adsk::core::SelectionCommandInput>& selectionInput);
+  void clearSelectionValidation();
+
+  std::unordered_map<std::string, SketchProfileIndex> sketchProfileIndices_;  // By sketch token
+  std::unordered_map<std::string, bool> closedCurveVerdicts_;  // By curve token: part of a closed profile
+  std::unordered_map<std::string, ValidatedEntity> validatedEntities_;  // The selection as last validated
+  // Selected curves that complete a closed profile, by sketch token
+  std::unordered_map<std::string, std::unordered_set<std::string>> completeCurvesBySketch_;
 
   // Sketch tracking for incremental generation
   std::map<std::string, std::string> toolToSketchMap_;
 
   // Cached geometry to avoid stale token issues
   std::vector<Adapters::ProfileGeometry> cachedProfiles_;
+  std::vector<std::string> cachedProfileTokens_;  // Entity token of each cachedProfiles_ entry (empty = none)
+  bool cachedGeometryStale_ = false;               // The selection changed since the last extraction
+
+  // Geometry of every profile extracted in the design, across dialogs; an entry is used while
+  // its parent sketch still has the revision it was extracted at
+  struct ExtractedProfile {
+    std::string sketchRevision{};
+    Adapters::ProfileGeometry geometry{};
+  };
+  static constexpr size_t MAX_EXTRACTED_PROFILES = 4096;
+  std::unordered_map<std::string, ExtractedProfile> extractedProfiles_;  // By profile entity token
+  adsk::core::Ptr<adsk::fusion::Design> extractedProfilesDesign_;
 
   // Event handlers for cleanup (Issue #1: Event Handler Memory Management)
   std::vector<adsk::core::CommandEventHandler*> commandEventHandlers_;
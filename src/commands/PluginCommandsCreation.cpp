@@ -64,6 +64,15 @@ void GeneratePathsCommandHandler::notify(const adsk::core::Ptr<adsk::core::Comma
 
   createParameterInputs(inputs);
 
+  // The selection starts empty; geometry extracted by earlier dialogs stays while the design is unchanged
+  clearCachedGeometry();
+  adsk::core::Ptr<adsk::fusion::Design> design;
+  if (auto app = adsk::core::Application::get()) {
+    design = app->activeProduct();
+  }
+  useProfileGeometryCache(design);
+  clearSelectionValidation();
+
   // Set the command to be modal so it stays open for selection
   cmd->isExecutedWhenPreEmpted(false);
 
@@ -86,29 +95,27 @@ void GeneratePathsCommandHandler::notify(const adsk::core::Ptr<adsk::core::Comma
   cmd->execute()->add(onExecute);
   commandEventHandlers_.push_back(onExecute);
 
-  // Create and register preview handler (minimal implementation)
+  // Create and register preview handler: Fusion fires executePreview after
+  // each input change; the coarse preview is debounced and computed off the
+  // main thread, so the handler returns right away
   class PreviewHandler : public adsk::core::CommandEventHandler {
    public:
-    explicit PreviewHandler(GeneratePathsCommandHandler* parent) : parent_(parent) {
-      (void)parent_;  // Suppress unused field warning - placeholder for
-                      // preview functionality
-    }
+    explicit PreviewHandler(GeneratePathsCommandHandler* parent) : parent_(parent) {}
     void notify(const adsk::core::Ptr<adsk::core::CommandEventArgs>& eventArgs) override {
-      (void)eventArgs;  // Suppress unused parameter warning - required by
-                        // Fusion API
-      // Minimal preview handler - just validate inputs without executing
+      if ((parent_ != nullptr) && eventArgs && eventArgs->command() && eventArgs->command()->commandInputs()) {
+        parent_->previewMedialAxisProcessing(eventArgs->command()->commandInputs());
+      }
     }
 
    private:
-    GeneratePathsCommandHandler* parent_;  // TODO(developer): Use parent for preview functionality
+    GeneratePathsCommandHandler* parent_;
   };
 
   auto* onPreview = new PreviewHandler(this);
   cmd->executePreview()->add(onPreview);
   commandEventHandlers_.push_back(onPreview);
 
-  // Create and register input changed handler for immediate geometry
-  // extraction
+  // Create and register input changed handler for selection validation
   class InputChangedHandler : public adsk::core::InputChangedEventHandler {
    public:
     explicit InputChangedHandler(GeneratePathsCommandHandler* parent) : parent_(parent) {}
@@ -119,8 +126,8 @@ void GeneratePathsCommandHandler::notify(const adsk::core::Ptr<adsk::core::Comma
       auto input = eventArgs->input();
       std::string inputId = input->id();
 
-      // IMMEDIATE EXTRACTION: Extract geometry as soon as profiles are
-      // selected
+      // A window selection fires a change per entity: validate each, and
+      // extract the burst's new profiles once when Fusion previews
       if (inputId == "sketchProfiles") {
         auto selectionInput = input->cast<adsk::core::SelectionCommandInput>();
         if (selectionInput) {
@@ -129,29 +136,7 @@ void GeneratePathsCommandHandler::notify(const adsk::core::Ptr<adsk::core::Comma
           // VALIDATION: Remove invalid selections (non-closed curves)
           parent_->validateAndCleanSelection(selectionInput);
 
-          // Clear any existing cached geometry
-          parent_->clearCachedGeometry();
-
-          // Extract geometry immediately from each selected profile
-          for (int i = 0; i < static_cast<int>(selectionInput->selectionCount()); i++) {
-            auto selection = selectionInput->selection(i);
-            if (selection && selection->entity()) {
-              auto entity = selection->entity();
-              auto profile = entity->cast<adsk::fusion::Profile>();
-
-              if (profile && profile->parentSketch()) {
-                LOG_INFO("  Extracting geometry from Selection " << i << ": Profile from sketch '"
-                                                                 << profile->parentSketch()->name() << "'");
-
-                // Extract geometry IMMEDIATELY while profile is still valid
-                parent_->extractAndCacheProfileGeometry(profile, i);
-              } else {
-                LOG_INFO("  Selection " << i << ": Not a profile (" << entity->objectType() << ")");
-              }
-            }
-          }
-
-          LOG_INFO("Immediate extraction completed for " << selectionInput->selectionCount() << " selections");
+          parent_->markCachedGeometryStale();
         }
       }
     }
@@ -204,7 +189,11 @@ void GeneratePathsCommandHandler::notify(const adsk::core::Ptr<adsk::core::Comma
   // closes
   class DestroyHandler : public adsk::core::CommandEventHandler {
    public:
+    explicit DestroyHandler(GeneratePathsCommandHandler* parent) : parent_(parent) {}
     void notify(const adsk::core::Ptr<adsk::core::CommandEventArgs>& eventArgs) override {
+      // A cancelled dialog leaves no preview behind
+      parent_->clearPreview();
+
       if (!eventArgs || !eventArgs->command())
         return;
 
@@ -235,9 +224,12 @@ void GeneratePathsCommandHandler::notify(const adsk::core::Ptr<adsk::core::Comma
         LOG_INFO("Restored original selection filters on dialog close");
       }
     }
+
+   private:
+    GeneratePathsCommandHandler* parent_;
   };
 
-  auto* onDestroy = new DestroyHandler();
+  auto* onDestroy = new DestroyHandler(this);
   cmd->destroy()->add(onDestroy);
   commandEventHandlers_.push_back(onDestroy);
 }
@@ -29,10 +29,14 @@ void GeneratePathsCommandHandler::executeMedialAxisProcessing(
           return false;
         }
 
+        // The real paths replace the preview graphics
+        clearPreview();
+
         // Get parameters from dialog inputs
         ChipCarving::Adapters::MedialAxisParameters params = getParametersFromInputs(inputs);
 
-        // Get selected profiles from dialog
+        // Get selected profiles from dialog, extracting any selected since the last preview
+        flushCachedGeometry(inputs);
         ChipCarving::Adapters::SketchSelection selection = getSelectionFromInputs(inputs);
 
         // DEBUG: Log selection details extensively
@@ -65,8 +69,12 @@ void GeneratePathsCommandHandler::executeMedialAxisProcessing(
         // placeholder)
 
         // Execute medial axis generation with construction geometry visualization
+        // In the background the command returns once the worker starts; the
+        // progress event writes the sketches when it completes
         if (pluginManager()) {
-          bool success = pluginManager()->executeMedialAxisGeneration(selection, params);
+          bool success = params.runInBackground
+                             ? pluginManager()->startMedialAxisGeneration(selection, params)
+                             : pluginManager()->executeMedialAxisGeneration(selection, params);
           if (!success) {
             // Error handling is done within executeMedialAxisGeneration
             return false;
@@ -77,5 +85,35 @@ void GeneratePathsCommandHandler::executeMedialAxisProcessing(
       true);  // true = show errors to user
 }
 
+void GeneratePathsCommandHandler::previewMedialAxisProcessing(
+    const adsk::core::Ptr<adsk::core::CommandInputs>& inputs) {
+  Core::PreviewGeneration* preview = pluginManager() ? pluginManager()->getPreview() : nullptr;
+  if (!inputs || !preview) {
+    return;
+  }
+  // Fusion previews once a burst of input changes has been handled: show the count held back
+  // and extract the burst's newly selected profiles in one batch
+  pluginManager()->flushSelectionCount();
+  flushCachedGeometry(inputs);
+
+  // Only geometry extracted when profiles were selected; the preview never
+  // looks entities up again
+  if (cachedProfiles_.empty()) {
+    preview->clear();
+    return;
+  }
+  Adapters::SketchSelection selection = getSelectionFromInputs(inputs);
+  Adapters::MedialAxisParameters params = getParametersFromInputs(inputs);
+  preview->start(selection, params);
+  pluginManager()->speculateMedialAxes(selection, params);
+}
+
+void GeneratePathsCommandHandler::clearPreview() {
+  Core::PreviewGeneration* preview = pluginManager() ? pluginManager()->getPreview() : nullptr;
+  if (preview) {
+    preview->clear();
+  }
+}
+
 }  // namespace Commands
 }  // namespace ChipCarving
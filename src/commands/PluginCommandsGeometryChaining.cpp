@@ -8,6 +8,7 @@
 
 #include "PluginCommandsGeometryChaining.h"
 
+#include "geometry/CurveChaining.h"
 #include "utils/UnitConversion.h"
 #include "utils/logging.h"
 
@@ -21,8 +22,8 @@ void logChainingInfo(size_t curveCount, bool hadTessellationIssues, double toler
   }
 }
 
-std::vector<std::pair<double, double>> chainCurvesAndExtractVertices(const std::vector<CurveData>& allCurves) {
-  std::vector<std::pair<double, double>> vertices;
+std::vector<Geometry::Point2D> chainCurvesAndExtractVertices(const std::vector<StrokedCurve>& allCurves) {
+  std::vector<Geometry::Point2D> vertices;
 
   if (allCurves.empty()) {
     return vertices;
@@ -36,7 +37,7 @@ std::vector<std::pair<double, double>> chainCurvesAndExtractVertices(const std::
   // tolerance
   bool hadTessellationIssues = false;
   for (const auto& curve : allCurves) {
-    if (curve.strokePoints.size() <= 2) {
+    if (curve.points.size() <= 2) {
       hadTessellationIssues = true;
       break;
     }
@@ -45,95 +46,57 @@ std::vector<std::pair<double, double>> chainCurvesAndExtractVertices(const std::
   const double tolerance = hadTessellationIssues ? baseTolerance * 10 : baseTolerance;
   logChainingInfo(allCurves.size(), hadTessellationIssues, tolerance);
 
-  // Start with first curve
-  std::vector<size_t> chainOrder;
-  chainOrder.push_back(0);
-  std::vector<CurveData> tempCurves = allCurves;  // Make mutable copy
-  tempCurves[0].used = true;
-  auto currentEndPoint = tempCurves[0].endPoint;
-
-  // Chain remaining curves
-  for (size_t chainPos = 1; chainPos < tempCurves.size(); ++chainPos) {
-    bool foundNext = false;
-
-    for (size_t i = 0; i < tempCurves.size(); ++i) {
-      if (tempCurves[i].used)
-        continue;
-
-      // Check if this curve's start connects to current end
-      double distStart = std::sqrt(std::pow(currentEndPoint->x() - tempCurves[i].startPoint->x(), 2) +
-                                   std::pow(currentEndPoint->y() - tempCurves[i].startPoint->y(), 2) +
-                                   std::pow(currentEndPoint->z() - tempCurves[i].startPoint->z(), 2));
-
-      // Check if this curve's end connects to current end (needs reversal)
-      double distEnd = std::sqrt(std::pow(currentEndPoint->x() - tempCurves[i].endPoint->x(), 2) +
-                                 std::pow(currentEndPoint->y() - tempCurves[i].endPoint->y(), 2) +
-                                 std::pow(currentEndPoint->z() - tempCurves[i].endPoint->z(), 2));
-
-      if (distStart < tolerance) {
-        // Normal orientation
-        chainOrder.push_back(i);
-        tempCurves[i].used = true;
-        currentEndPoint = tempCurves[i].endPoint;
-        foundNext = true;
-        LOG_INFO("    Chained curve " << i << " (normal)");
-        break;
-      }
-      if (distEnd < tolerance) {
-        // Reversed orientation - mark with high bit flag
-        chainOrder.push_back(i | 0x80000000);
-        tempCurves[i].used = true;
-        currentEndPoint = tempCurves[i].startPoint;
-        foundNext = true;
-        LOG_INFO("    Chained curve " << i << " (reversed)");
-        break;
-      }
-    }
+  // Only endpoints are copied; stroke points are read from allCurves in chain order
+  std::vector<Geometry::Point3D> starts;
+  std::vector<Geometry::Point3D> ends;
+  starts.reserve(allCurves.size());
+  ends.reserve(allCurves.size());
+  for (const auto& curve : allCurves) {
+    starts.push_back(curve.points.front());
+    ends.push_back(curve.points.back());
+  }
 
-    if (!foundNext) {
-      LOG_ERROR("    Could not find connecting curve at position " << chainPos << " of " << tempCurves.size());
-      LOG_ERROR("    Current endpoint: (" << currentEndPoint->x() << ", " << currentEndPoint->y() << ", "
-                                          << currentEndPoint->z() << ")");
-
-      // Log remaining unconnected curves for debugging
-      int unconnectedCount = 0;
-      for (size_t i = 0; i < tempCurves.size(); ++i) {
-        if (!tempCurves[i].used) {
-          LOG_ERROR("    Unconnected curve " << i << ": start(" << tempCurves[i].startPoint->x() << ", "
-                                             << tempCurves[i].startPoint->y() << ") end(" << tempCurves[i].endPoint->x()
-                                             << ", " << tempCurves[i].endPoint->y() << ")");
-          unconnectedCount++;
-        }
+  std::vector<Geometry::ChainedCurve> chainOrder = Geometry::chainCurveEndpoints(starts, ends, tolerance);
+  for (size_t chainPos = 1; chainPos < chainOrder.size(); ++chainPos) {
+    LOG_DEBUG("    Chained curve " << chainOrder[chainPos].index
+                                   << (chainOrder[chainPos].reversed ? " (reversed)" : " (normal)"));
+  }
+
+  if (chainOrder.size() < allCurves.size()) {
+    const Geometry::ChainedCurve& last = chainOrder.back();
+    const Geometry::Point3D& currentEndPoint = last.reversed ? starts[last.index] : ends[last.index];
+    LOG_ERROR("    Could not find connecting curve at position " << chainOrder.size() << " of " << allCurves.size());
+    LOG_ERROR("    Current endpoint: (" << currentEndPoint.x << ", " << currentEndPoint.y << ", " << currentEndPoint.z
+                                        << ")");
+
+    // Log remaining unconnected curves for debugging
+    std::vector<bool> used(allCurves.size(), false);
+    for (const auto& chained : chainOrder) {
+      used[chained.index] = true;
+    }
+    for (size_t i = 0; i < allCurves.size(); ++i) {
+      if (!used[i]) {
+        LOG_ERROR("    Unconnected curve " << i << ": start(" << starts[i].x << ", " << starts[i].y << ") end("
+                                           << ends[i].x << ", " << ends[i].y << ")");
       }
-      LOG_ERROR("    Total unconnected curves: " << unconnectedCount << " - profile will be incomplete");
-      break;
     }
+    LOG_ERROR("    Total unconnected curves: " << allCurves.size() - chainOrder.size()
+                                               << " - profile will be incomplete");
   }
 
   // Extract vertices from chained curves
-  for (size_t i = 0; i < chainOrder.size(); ++i) {
-    bool reversed = (chainOrder[i] & 0x80000000) != 0;
-    size_t curveIdx = chainOrder[i] & 0x7FFFFFFF;
-
-    const CurveData& curve = tempCurves[curveIdx];
-    const auto& strokePoints = curve.strokePoints;
-
-    // Determine how many points to add (skip last to avoid duplicates)
-    size_t numPoints = strokePoints.size() - 1;
+  for (const auto& chained : chainOrder) {
+    const auto& strokePoints = allCurves[chained.index].points;
 
-    if (reversed) {
+    if (chained.reversed) {
       // Add points in reverse order, skip first point (which is last in reverse)
-      for (int j = static_cast<int>(strokePoints.size()) - 1; j >= 1; --j) {
-        if (strokePoints[j]) {
-          vertices.push_back({strokePoints[j]->x(), strokePoints[j]->y()});
-        }
+      for (size_t j = strokePoints.size(); j-- > 1;) {
+        vertices.emplace_back(strokePoints[j].x, strokePoints[j].y);
       }
     } else {
-      // Add points in normal order
-      for (size_t j = 0; j < numPoints; ++j) {
-        if (strokePoints[j]) {
-          vertices.push_back({strokePoints[j]->x(), strokePoints[j]->y()});
-        }
+      // Add points in normal order (skip last to avoid duplicates)
+      for (size_t j = 0; j + 1 < strokePoints.size(); ++j) {
+        vertices.emplace_back(strokePoints[j].x, strokePoints[j].y);
       }
     }
   }
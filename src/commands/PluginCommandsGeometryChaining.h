@@ -7,16 +7,23 @@
 
 #pragma once
 
+#include <Core/CoreAll.h>
+#include <Fusion/FusionAll.h>
+
 #include <cmath>
 #include <utility>
 #include <vector>
 
-#include "adapters/FusionWorkspaceProfileTypes.h"
+#include "geometry/Point3D.h"
+#include "geometry/ProfileCurve.h"
 
 namespace ChipCarving {
 namespace Commands {
 
-using ChipCarving::Adapters::CurveData;
+// Stroke points of one profile curve, copied out of Fusion so the loop can be chained on any thread
+struct StrokedCurve {
+  std::vector<Geometry::Point3D> points{};
+};
 
 /**
  * Log curve chaining info for debugging
@@ -24,11 +31,20 @@ using ChipCarving::Adapters::CurveData;
 void logChainingInfo(size_t curveCount, bool hadTessellationIssues, double tolerance);
 
 /**
- * Chain curves together and extract vertices in order
- * @param allCurves Vector of curve data to chain
- * @return Vector of (x,y) vertex pairs forming the chained polygon
+ * Chain curves together and extract vertices in order; makes no Fusion calls
+ * @param allCurves Stroked curves of one loop, each with at least one point
+ * @return Vertices forming the chained polygon
+ */
+std::vector<Geometry::Point2D> chainCurvesAndExtractVertices(const std::vector<StrokedCurve>& allCurves);
+
+/**
+ * Read a loop's lines, arcs, circles and splines exactly and chain them
+ * @param profileCurves Curves of one profile loop
+ * @param loop Receives the curves in chain order, in world coordinates (cm)
+ * @return False if a curve has another type or the chain is broken; the loop is stroked instead
  */
-std::vector<std::pair<double, double>> chainCurvesAndExtractVertices(const std::vector<CurveData>& allCurves);
+bool readExactProfileLoop(const adsk::core::Ptr<adsk::fusion::ProfileCurves>& profileCurves,
+                          std::vector<Geometry::ProfileCurve>& loop);
 
 }  // namespace Commands
 }  // namespace ChipCarving
@@ -0,0 +1,157 @@
+/**
+ * PluginCommandsGeometryCurves.cpp
+ *
+ * Exact profile curve extraction for PluginCommands: lines, arcs, circles and
+ * splines are read from their world geometry and chained here, and the
+ * pipeline polygonizes them to polygonTolerance later (see
+ * geometry/ProfileCurve.h). Loops with other curve types are stroked instead.
+ */
+
+#include <cmath>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "PluginCommandsGeometryChaining.h"
+#include "geometry/CurveChaining.h"
+#include "geometry/Point3D.h"
+#include "utils/UnitConversion.h"
+#include "utils/logging.h"
+
+namespace ChipCarving {
+namespace Commands {
+
+namespace {
+
+// Arcs and splines off the world XY plane are left to Fusion's strokes
+constexpr double PLANAR_NORMAL_Z = 1.0 - 1e-9;
+
+Geometry::Point2D toPoint2D(const adsk::core::Ptr<adsk::core::Point3D>& point) {
+  return Geometry::Point2D(point->x(), point->y());
+}
+
+bool readArc(const adsk::core::Ptr<adsk::core::Arc3D>& arc, Geometry::ProfileCurve& curve) {
+  adsk::core::Ptr<adsk::core::Point3D> center;
+  adsk::core::Ptr<adsk::core::Vector3D> normal;
+  adsk::core::Ptr<adsk::core::Vector3D> reference;
+  double radius = 0.0;
+  double startAngle = 0.0;
+  double endAngle = 0.0;
+  if (!arc || !arc->getData(center, normal, reference, radius, startAngle, endAngle) || !center || !normal ||
+      !reference || std::abs(normal->z()) < PLANAR_NORMAL_Z) {
+    return false;
+  }
+  // Arc3D angles run counter-clockwise about its normal from the reference vector
+  double direction = normal->z() > 0.0 ? 1.0 : -1.0;
+  double referenceAngle = std::atan2(reference->y(), reference->x());
+  curve = Geometry::makeArcCurve(toPoint2D(center), radius, referenceAngle + direction * startAngle,
+                                 direction * (endAngle - startAngle));
+  return true;
+}
+
+bool readSpline(const adsk::core::Ptr<adsk::core::NurbsCurve3D>& nurbs, Geometry::ProfileCurve& curve) {
+  std::vector<adsk::core::Ptr<adsk::core::Point3D>> controlPoints;
+  int degree = 0;
+  std::vector<double> knots;
+  bool isRational = false;
+  std::vector<double> weights;
+  bool isPeriodic = false;
+  if (!nurbs || !nurbs->getData(controlPoints, degree, knots, isRational, weights, isPeriodic) || isPeriodic ||
+      degree < 1 || knots.size() != controlPoints.size() + static_cast<size_t>(degree) + 1) {
+    return false;
+  }
+
+  std::vector<Geometry::Point2D> points;
+  points.reserve(controlPoints.size());
+  for (const auto& point : controlPoints) {
+    if (!point) {
+      return false;
+    }
+    points.push_back(toPoint2D(point));
+  }
+  if (!isRational) {
+    weights.clear();
+  }
+  curve = Geometry::makeSplineCurve(degree, std::move(points), std::move(weights), std::move(knots));
+  return curve.type == Geometry::ProfileCurve::Type::SPLINE;
+}
+
+// Exact world geometry of one sketch curve; false for types that are stroked
+bool readExactCurve(const adsk::core::Ptr<adsk::fusion::SketchEntity>& entity, Geometry::ProfileCurve& curve) {
+  if (auto line = entity->cast<adsk::fusion::SketchLine>()) {
+    auto geometry = line->worldGeometry();
+    if (!geometry || !geometry->startPoint() || !geometry->endPoint()) {
+      return false;
+    }
+    curve = Geometry::makeLineCurve(toPoint2D(geometry->startPoint()), toPoint2D(geometry->endPoint()));
+    return true;
+  }
+  if (auto arc = entity->cast<adsk::fusion::SketchArc>()) {
+    return readArc(arc->worldGeometry(), curve);
+  }
+  if (auto circle = entity->cast<adsk::fusion::SketchCircle>()) {
+    auto geometry = circle->worldGeometry();
+    auto normal = geometry ? geometry->normal() : nullptr;
+    if (!normal || !geometry->center() || std::abs(normal->z()) < PLANAR_NORMAL_Z) {
+      return false;
+    }
+    curve = Geometry::makeArcCurve(toPoint2D(geometry->center()), geometry->radius(), 0.0, 2.0 * M_PI);
+    return true;
+  }
+  if (auto spline = entity->cast<adsk::fusion::SketchFittedSpline>()) {
+    return readSpline(spline->worldGeometry(), curve);
+  }
+  if (auto spline = entity->cast<adsk::fusion::SketchControlPointSpline>()) {
+    return readSpline(spline->worldGeometry(), curve);
+  }
+  return false;
+}
+
+}  // namespace
+
+bool readExactProfileLoop(const adsk::core::Ptr<adsk::fusion::ProfileCurves>& profileCurves,
+                          std::vector<Geometry::ProfileCurve>& loop) {
+  std::vector<Geometry::ProfileCurve> curves;
+  curves.reserve(profileCurves->count());
+  for (size_t curveIdx = 0; curveIdx < profileCurves->count(); ++curveIdx) {
+    auto profileCurve = profileCurves->item(static_cast<int>(curveIdx));
+    auto sketchEntity = profileCurve ? profileCurve->sketchEntity() : nullptr;
+    Geometry::ProfileCurve curve;
+    if (!sketchEntity || !readExactCurve(sketchEntity, curve)) {
+      LOG_DEBUG("    Curve " << curveIdx << " has no exact geometry, stroking the loop");
+      return false;
+    }
+    curves.push_back(std::move(curve));
+  }
+  if (curves.empty()) {
+    return false;
+  }
+
+  std::vector<Geometry::Point3D> starts;
+  std::vector<Geometry::Point3D> ends;
+  starts.reserve(curves.size());
+  ends.reserve(curves.size());
+  for (const auto& curve : curves) {
+    starts.emplace_back(curve.start.x, curve.start.y, 0.0);
+    ends.emplace_back(curve.end.x, curve.end.y, 0.0);
+  }
+  std::vector<Geometry::ChainedCurve> chainOrder =
+      Geometry::chainCurveEndpoints(starts, ends, Utils::Tolerance::GEOMETRIC);
+  if (chainOrder.size() < curves.size()) {
+    LOG_WARNING("    Exact curves chain only " + std::to_string(chainOrder.size()) + " of " +
+                std::to_string(curves.size()) + " curves, stroking the loop");
+    return false;
+  }
+
+  loop.clear();
+  loop.reserve(curves.size());
+  for (const auto& chained : chainOrder) {
+    loop.push_back(std::move(curves[chained.index]));
+    loop.back().reversed = chained.reversed;
+  }
+  LOG_INFO("  Read " << loop.size() << " exact curves for polygonization");
+  return true;
+}
+
+}  // namespace Commands
+}  // namespace ChipCarving
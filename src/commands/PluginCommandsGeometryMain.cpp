@@ -4,250 +4,215 @@
  * Main geometry extraction for PluginCommands
  * Part of PluginCommandsGeometry refactoring (Item #1a)
  * Extracted from PluginCommandsGeometry.cpp
+ *
+ * Note: readProfileGeometry() is in PluginCommandsGeometryRead.cpp
  */
 
-#include "PluginCommands.h"
-#include "PluginCommandsGeometryChaining.h"
+#include <algorithm>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "PluginCommandsGeometryPending.h"
+#include "utils/TaskScheduler.h"
 #include "utils/UnitConversion.h"
 #include "utils/logging.h"
 
 namespace ChipCarving {
 namespace Commands {
 
+namespace {
+
+size_t strokePointCount(const std::vector<StrokedCurve>& loop) {
+  size_t points = 0;
+  for (const auto& curve : loop) {
+    points += curve.points.size();
+  }
+  return points;
+}
+
+}  // namespace
+
 void GeneratePathsCommandHandler::clearCachedGeometry() {
   cachedProfiles_.clear();
+  cachedProfileTokens_.clear();
+  cachedGeometryStale_ = false;
   LOG_INFO("Cleared cached profile geometry");
 }
 
-void GeneratePathsCommandHandler::extractAndCacheProfileGeometry(const adsk::core::Ptr<adsk::fusion::Profile>& profile,
-                                                                 int index) {
-  if (!profile) {
-    LOG_INFO("Cannot extract geometry from null profile at index " << index);
+void GeneratePathsCommandHandler::useProfileGeometryCache(const adsk::core::Ptr<adsk::fusion::Design>& design) {
+  // Entity tokens belong to one design, so another active document starts over
+  if (!design || !extractedProfilesDesign_ || extractedProfilesDesign_.get() != design.get()) {
+    if (!extractedProfiles_.empty()) {
+      LOG_DEBUG("Dropping " << extractedProfiles_.size() << " profile(s) extracted in another design");
+    }
+    extractedProfiles_.clear();
+  }
+  extractedProfilesDesign_ = design;
+}
+
+void GeneratePathsCommandHandler::markCachedGeometryStale() {
+  cachedGeometryStale_ = true;
+}
+
+void GeneratePathsCommandHandler::flushCachedGeometry(const adsk::core::Ptr<adsk::core::CommandInputs>& inputs) {
+  if (!cachedGeometryStale_ || !inputs) {
     return;
   }
+  cachedGeometryStale_ = false;
+  adsk::core::Ptr<adsk::core::SelectionCommandInput> selectionInput = inputs->itemById("sketchProfiles");
+  updateCachedGeometry(selectionInput);
+}
 
-  ChipCarving::Adapters::ProfileGeometry profileGeom;
-
-  // Get basic profile information while it's still valid
-  auto sketch = profile->parentSketch();
-  if (sketch) {
-    profileGeom.sketchName = sketch->name();
-
-    // Get plane entity ID
-    auto referenceEntity = sketch->referencePlane();
-    if (referenceEntity) {
-      auto constructionPlane = referenceEntity->cast<adsk::fusion::ConstructionPlane>();
-      if (constructionPlane) {
-        profileGeom.planeEntityId = constructionPlane->entityToken();
-      } else {
-        auto face = referenceEntity->cast<adsk::fusion::BRepFace>();
-        if (face) {
-          profileGeom.planeEntityId = face->entityToken();
-        }
-      }
+void GeneratePathsCommandHandler::updateCachedGeometry(
+    const adsk::core::Ptr<adsk::core::SelectionCommandInput>& selectionInput) {
+  // Profiles still selected keep their geometry, moved to their new selection index
+  std::unordered_map<std::string, Adapters::ProfileGeometry> previous;
+  for (size_t i = 0; i < cachedProfiles_.size(); ++i) {
+    if (!cachedProfileTokens_[i].empty()) {
+      previous[cachedProfileTokens_[i]] = std::move(cachedProfiles_[i]);
     }
   }
-
-  // Extract area properties
-  auto areaProps = profile->areaProperties();
-  if (areaProps) {
-    profileGeom.area = areaProps->area();
-    auto centroid = areaProps->centroid();
-    if (centroid) {
-      profileGeom.centroid = {centroid->x(), centroid->y()};
+  cachedProfiles_.clear();
+  cachedProfileTokens_.clear();
+
+  // Newly selected profiles are read from Fusion here, then chained together off this thread
+  int count = selectionInput ? static_cast<int>(selectionInput->selectionCount()) : 0;
+  std::vector<PendingProfile> pending;
+  size_t extracted = 0;
+  size_t reused = 0;
+  for (int i = 0; i < count; ++i) {
+    auto selection = selectionInput->selection(i);
+    if (!selection || !selection->entity()) {
+      continue;
     }
+    std::string token = selection->entity()->entityToken();
+    auto kept = previous.find(token);
+    if (kept != previous.end()) {
+      cachedProfiles_.resize(std::max(cachedProfiles_.size(), static_cast<size_t>(i) + 1));
+      cachedProfiles_[i] = std::move(kept->second);
+      previous.erase(kept);
+      ++reused;
+    } else {
+      auto profile = selection->entity()->cast<adsk::fusion::Profile>();
+      if (!profile || !profile->parentSketch()) {
+        continue;
+      }
+      // Read geometry IMMEDIATELY while profile is still valid
+      PendingProfile read;
+      if (readProfileGeometry(profile, i, read)) {
+        pending.push_back(std::move(read));
+      }
+      ++extracted;
+    }
+    cachedProfileTokens_.resize(cachedProfiles_.size());
+    cachedProfileTokens_[i] = std::move(token);
   }
 
-  // CRITICAL: Extract all vertices immediately while profile is valid
-  // We need to chain curves properly to avoid self-intersections
-
-  std::vector<CurveData> allCurves;
-
-  auto profileLoops = profile->profileLoops();
-  if (profileLoops) {
-    for (size_t loopIdx = 0; loopIdx < profileLoops->count(); ++loopIdx) {
-      auto loop = profileLoops->item(static_cast<int>(loopIdx));
-      if (!loop)
-        continue;
+  chainPendingProfiles(pending);
+  for (auto& profile : pending) {
+    cacheExtractedProfile(profile);
+  }
+  LOG_INFO("Extracted " << extracted << " newly selected profiles, kept " << reused << " extracted before");
+}
 
-      auto profileCurves = loop->profileCurves();
-      if (!profileCurves)
-        continue;
+void GeneratePathsCommandHandler::chainPendingProfiles(std::vector<PendingProfile>& pending) {
+  // One task per stroked loop; each writes only its own vertices or hole
+  struct LoopTask {
+    const std::vector<StrokedCurve>* curves;
+    std::vector<Geometry::Point2D>* vertices;
+  };
+  std::vector<LoopTask> loops;
+  for (auto& profile : pending) {
+    profile.geometry.holes.resize(profile.holeLoops.size());
+    if (!profile.outerLoop.empty()) {
+      loops.push_back({&profile.outerLoop, &profile.geometry.vertices});
+    }
+    for (size_t i = 0; i < profile.holeLoops.size(); ++i) {
+      loops.push_back({&profile.holeLoops[i], &profile.geometry.holes[i]});
+    }
+  }
 
-      // Collect curve data for proper chaining
-      allCurves.reserve(profileCurves->count());
-      for (size_t curveIdx = 0; curveIdx < profileCurves->count(); ++curveIdx) {
-        CurveData curveData;
-        curveData.originalIndex = curveIdx;
-        curveData.used = false;
-
-        auto profileCurve = profileCurves->item(static_cast<int>(curveIdx));
-        if (!profileCurve)
-          continue;
-
-        auto sketchEntity = profileCurve->sketchEntity();
-        if (!sketchEntity)
-          continue;
-
-        // Extract geometry using the same approach as existing code
-        adsk::core::Ptr<adsk::core::Curve3D> worldGeometry = nullptr;
-
-        // Get world geometry from sketch entity
-        auto sketchCurve = sketchEntity->cast<adsk::fusion::SketchCurve>();
-        if (sketchCurve) {
-          // Try each entity type and get its world geometry
-          if (auto line = sketchEntity->cast<adsk::fusion::SketchLine>()) {
-            worldGeometry = line->worldGeometry();
-            LOG_INFO("    Curve " << curveIdx << " is a SketchLine");
-          } else if (auto arc = sketchEntity->cast<adsk::fusion::SketchArc>()) {
-            worldGeometry = arc->worldGeometry();
-            LOG_INFO("    Curve " << curveIdx << " is a SketchArc");
-          } else if (auto circle = sketchEntity->cast<adsk::fusion::SketchCircle>()) {
-            worldGeometry = circle->worldGeometry();
-            LOG_INFO("    Curve " << curveIdx << " is a SketchCircle");
-          } else if (auto spline = sketchEntity->cast<adsk::fusion::SketchFittedSpline>()) {
-            worldGeometry = spline->worldGeometry();
-            LOG_INFO("    Curve " << curveIdx << " is a SketchFittedSpline");
-          } else if (auto nurbs = sketchEntity->cast<adsk::fusion::SketchControlPointSpline>()) {
-            worldGeometry = nurbs->worldGeometry();
-            LOG_INFO("    Curve " << curveIdx << " is a SketchControlPointSpline");
-          } else if (auto ellipse = sketchEntity->cast<adsk::fusion::SketchEllipse>()) {
-            worldGeometry = ellipse->worldGeometry();
-            LOG_INFO("    Curve " << curveIdx << " is a SketchEllipse");
-          } else if (auto ellipticalArc = sketchEntity->cast<adsk::fusion::SketchEllipticalArc>()) {
-            worldGeometry = ellipticalArc->worldGeometry();
-            LOG_INFO("    Curve " << curveIdx << " is a SketchEllipticalArc");
-          }
-        }
-
-        if (worldGeometry) {
-          // Use tessellation like existing code to get proper polygon
-          // vertices
-          auto evaluator = worldGeometry->evaluator();
-          if (evaluator) {
-            double startParam = 0.0;
-            double endParam = 0.0;
-            if (evaluator->getParameterExtents(startParam, endParam)) {
-              // Use getStrokes for proper tessellation
-              std::vector<adsk::core::Ptr<adsk::core::Point3D>> strokePoints;
-
-              // Determine tolerance based on curve type
-              double chordTolerance = 0.01;  // Default: 0.1mm tolerance for accurate curves
-
-              // For lines, use coarser tolerance since they don't need
-              // tessellation
-              if (auto line = sketchEntity->cast<adsk::fusion::SketchLine>()) {
-                chordTolerance = 0.1;  // 1mm tolerance for lines (should only
-                                       // give 2 points)
-              } else {
-                // For arcs, circles, splines etc., use fine tolerance for
-                // smooth curves
-                chordTolerance = 0.005;  // 0.05mm tolerance for accurate
-                                         // curve representation
-              }
-
-              LOG_INFO("    Using tolerance " << chordTolerance << " cm for tessellation");
-              if (evaluator->getStrokes(startParam, endParam, chordTolerance, strokePoints)) {
-                LOG_INFO("    Generated " << strokePoints.size() << " stroke points");
-
-                // Validate tessellation quality for non-linear curves
-                if (!sketchEntity->cast<adsk::fusion::SketchLine>() && strokePoints.size() < 3) {
-                  LOG_WARNING("    Insufficient tessellation for curve " + std::to_string(curveIdx) + " (" +
-                              std::to_string(strokePoints.size()) + " points) - attempting finer tolerance");
-
-                  // Try again with finer tolerance
-                  strokePoints.clear();
-                  chordTolerance = Utils::Tolerance::TESSELLATION;
-                  if (evaluator->getStrokes(startParam, endParam, chordTolerance, strokePoints)) {
-                    LOG_INFO("    Retessellated with finer tolerance: " << strokePoints.size() << " points");
-                  }
-                }
-                // Store stroke points and endpoints for chaining
-                curveData.strokePoints = strokePoints;
-                if (!strokePoints.empty()) {
-                  curveData.startPoint = strokePoints.front();
-                  curveData.endPoint = strokePoints.back();
-                }
-                allCurves.push_back(curveData);
-              } else {
-                LOG_ERROR("    getStrokes failed for curve " << curveIdx << " - geometry will be missing from profile");
-                // Try fallback with endpoints only for critical path
-                // continuity
-                std::vector<adsk::core::Ptr<adsk::core::Point3D>> fallbackPoints;
-                adsk::core::Ptr<adsk::core::Point3D> startPt;
-                adsk::core::Ptr<adsk::core::Point3D> endPt;
-                if (evaluator->getPointAtParameter(startParam, startPt) &&
-                    evaluator->getPointAtParameter(endParam, endPt)) {
-                  fallbackPoints.push_back(startPt);
-                  fallbackPoints.push_back(endPt);
-                  curveData.strokePoints = fallbackPoints;
-                  curveData.startPoint = startPt;
-                  curveData.endPoint = endPt;
-                  allCurves.push_back(curveData);
-                  LOG_WARNING("    Using fallback endpoints-only approach for "
-                              "curve " +
-                              std::to_string(curveIdx));
-                }
-              }
-            }
-          }
-        }
-      }
+  int workers = std::min(static_cast<int>(std::thread::hardware_concurrency()), static_cast<int>(loops.size()));
+  if (workers <= 1) {
+    for (const auto& loop : loops) {
+      *loop.vertices = chainCurvesAndExtractVertices(*loop.curves);
     }
+    return;
   }
 
-  // Delegate to chaining logic in separate file
-  profileGeom.vertices = chainCurvesAndExtractVertices(allCurves);
+  LOG_DEBUG("Chaining " << loops.size() << " loops of " << pending.size() << " profiles on " << workers
+                        << " threads");
+  Utils::TaskScheduler scheduler(workers);
+  for (const auto& loop : loops) {
+    scheduler.submit(static_cast<double>(strokePointCount(*loop.curves)),
+                     [loop]() { *loop.vertices = chainCurvesAndExtractVertices(*loop.curves); });
+  }
+  scheduler.run();
+}
+
+void GeneratePathsCommandHandler::cacheExtractedProfile(PendingProfile& pending) {
+  Adapters::ProfileGeometry& geometry = pending.geometry;
+  for (size_t i = 0; i < geometry.holes.size(); ++i) {
+    LOG_INFO("  Hole " << i + 1 << " has " << geometry.holes[i].size() << " vertices");
+  }
 
   // Validate extraction results
-  if (profileGeom.vertices.size() < 3) {
-    LOG_ERROR("Extracted polygon has insufficient vertices (" << profileGeom.vertices.size()
+  if (geometry.vertices.size() < 3 && geometry.curves.empty()) {
+    LOG_ERROR("Extracted polygon has insufficient vertices (" << geometry.vertices.size()
                                                               << ") - minimum 3 required for valid polygon");
   }
 
   // Set transform parameters (identity for now since vertices are in world
   // coordinates)
-  profileGeom.transform.centerX = 0.0;
-  profileGeom.transform.centerY = 0.0;
-  profileGeom.transform.scale = 1.0;
+  geometry.transform.centerX = 0.0;
+  geometry.transform.centerY = 0.0;
+  geometry.transform.scale = 1.0;
 
   // Log detailed geometry information for debugging
-  LOG_INFO("Extracted " << profileGeom.vertices.size() << " vertices from profile " << index);
-  if (!profileGeom.vertices.empty()) {
+  LOG_INFO("Extracted " << geometry.vertices.size() << " vertices and " << geometry.curves.size()
+                        << " exact curves from profile " << pending.index);
+  if (!geometry.vertices.empty()) {
     // Log first few vertices for debugging
-    size_t numToLog = std::min(static_cast<size_t>(6), profileGeom.vertices.size());
+    size_t numToLog = std::min(static_cast<size_t>(6), geometry.vertices.size());
     for (size_t i = 0; i < numToLog; ++i) {
-      LOG_INFO("  Vertex " << i << ": (" << profileGeom.vertices[i].first << ", " << profileGeom.vertices[i].second
-                           << ")");
+      LOG_INFO("  Vertex " << i << ": (" << geometry.vertices[i].x << ", " << geometry.vertices[i].y << ")");
     }
-    if (profileGeom.vertices.size() > 6) {
-      LOG_INFO("  ... and " << (profileGeom.vertices.size() - 6) << " more vertices");
+    if (geometry.vertices.size() > 6) {
+      LOG_INFO("  ... and " << (geometry.vertices.size() - 6) << " more vertices");
     }
 
     // Calculate and log bounding box
-    double minX = profileGeom.vertices[0].first;
-    double maxX = profileGeom.vertices[0].first;
-    double minY = profileGeom.vertices[0].second;
-    double maxY = profileGeom.vertices[0].second;
-    for (const auto& v : profileGeom.vertices) {
-      minX = std::min(minX, v.first);
-      maxX = std::max(maxX, v.first);
-      minY = std::min(minY, v.second);
-      maxY = std::max(maxY, v.second);
+    double minX = geometry.vertices[0].x;
+    double maxX = geometry.vertices[0].x;
+    double minY = geometry.vertices[0].y;
+    double maxY = geometry.vertices[0].y;
+    for (const auto& v : geometry.vertices) {
+      minX = std::min(minX, v.x);
+      maxX = std::max(maxX, v.x);
+      minY = std::min(minY, v.y);
+      maxY = std::max(maxY, v.y);
     }
     LOG_INFO("  Bounding box: (" << minX << ", " << minY << ") to (" << maxX << ", " << maxY << ")");
     LOG_INFO("  Size: " << (maxX - minX) << " x " << (maxY - minY) << " cm");
   }
 
-  // Store in cache
-  if (index >= static_cast<int>(cachedProfiles_.size())) {
-    cachedProfiles_.resize(index + 1);
+  // Store in cache, and for later dialogs on the same sketch revision
+  if (!pending.token.empty() && !pending.sketchRevision.empty()) {
+    if (extractedProfiles_.size() >= MAX_EXTRACTED_PROFILES) {
+      extractedProfiles_.clear();
+    }
+    extractedProfiles_[pending.token] = ExtractedProfile{pending.sketchRevision, geometry};
   }
-  cachedProfiles_[index] = profileGeom;
+  cachedProfiles_[pending.index] = std::move(geometry);
 
-  LOG_INFO("Successfully cached geometry for profile " << index << " from sketch '" << profileGeom.sketchName
-                                                       << "' with " << profileGeom.vertices.size()
-                                                       << " vertices and area " << profileGeom.area << " sq cm");
+  const Adapters::ProfileGeometry& cached = cachedProfiles_[pending.index];
+  LOG_INFO("Successfully cached geometry for profile " << pending.index << " from sketch '" << cached.sketchName
+                                                       << "' with " << cached.vertices.size() << " vertices, "
+                                                       << cached.curves.size() << " exact curves and area "
+                                                       << cached.area << " sq cm");
 }
 
 }  // namespace Commands
@@ -0,0 +1,29 @@
+/**
+ * PluginCommandsGeometryPending.h
+ *
+ * Profile geometry read from Fusion whose stroked loops are not chained yet
+ * Split from PluginCommandsGeometryMain.cpp for maintainability
+ */
+
+#pragma once
+
+#include <string>
+#include <vector>
+
+#include "PluginCommands.h"
+#include "PluginCommandsGeometryChaining.h"
+
+namespace ChipCarving {
+namespace Commands {
+
+struct GeneratePathsCommandHandler::PendingProfile {
+  int index = 0;
+  std::string token{};
+  std::string sketchRevision{};
+  Adapters::ProfileGeometry geometry{};                // Everything but the stroked loops' vertices
+  std::vector<StrokedCurve> outerLoop{};               // Empty when read exactly
+  std::vector<std::vector<StrokedCurve>> holeLoops{};  // Stroked inner loops, in geometry.holes order
+};
+
+}  // namespace Commands
+}  // namespace ChipCarving
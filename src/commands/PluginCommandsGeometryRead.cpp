@@ -0,0 +1,242 @@
+/**
+ * PluginCommandsGeometryRead.cpp
+ *
+ * Reads one selected profile's geometry from Fusion, exactly or as stroked loops
+ * Split from PluginCommandsGeometryMain.cpp for maintainability
+ */
+
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "PluginCommandsGeometryPending.h"
+#include "utils/UnitConversion.h"
+#include "utils/logging.h"
+
+namespace ChipCarving {
+namespace Commands {
+
+namespace {
+
+StrokedCurve copyStrokePoints(const std::vector<adsk::core::Ptr<adsk::core::Point3D>>& strokePoints) {
+  StrokedCurve stroked;
+  stroked.points.reserve(strokePoints.size());
+  for (const auto& point : strokePoints) {
+    if (point) {
+      stroked.points.emplace_back(point->x(), point->y(), point->z());
+    }
+  }
+  return stroked;
+}
+
+}  // namespace
+
+bool GeneratePathsCommandHandler::readProfileGeometry(const adsk::core::Ptr<adsk::fusion::Profile>& profile, int index,
+                                                      PendingProfile& pending) {
+  if (!profile) {
+    LOG_INFO("Cannot extract geometry from null profile at index " << index);
+    return false;
+  }
+
+  if (index >= static_cast<int>(cachedProfiles_.size())) {
+    cachedProfiles_.resize(index + 1);
+  }
+
+  // Reuse the geometry of an earlier dialog unless the sketch was edited since
+  auto sketch = profile->parentSketch();
+  std::string token = profile->entityToken();
+  std::string sketchRevision = sketch ? sketch->revisionId() : std::string();
+  auto extracted = extractedProfiles_.find(token);
+  if (extracted != extractedProfiles_.end()) {
+    if (!sketchRevision.empty() && extracted->second.sketchRevision == sketchRevision) {
+      cachedProfiles_[index] = extracted->second.geometry;
+      LOG_INFO("Reused geometry of profile " << index << " extracted at sketch revision " << sketchRevision);
+      return false;
+    }
+    extractedProfiles_.erase(extracted);
+  }
+
+  pending.index = index;
+  pending.token = std::move(token);
+  pending.sketchRevision = std::move(sketchRevision);
+  Adapters::ProfileGeometry& profileGeom = pending.geometry;
+
+  // Get basic profile information while it's still valid
+  if (sketch) {
+    profileGeom.sketchName = sketch->name();
+    if (sketch->parentComponent()) {
+      profileGeom.componentEntityId = sketch->parentComponent()->entityToken();
+    }
+
+    // Get plane entity ID
+    auto referenceEntity = sketch->referencePlane();
+    if (referenceEntity) {
+      auto constructionPlane = referenceEntity->cast<adsk::fusion::ConstructionPlane>();
+      if (constructionPlane) {
+        profileGeom.planeEntityId = constructionPlane->entityToken();
+      } else {
+        auto face = referenceEntity->cast<adsk::fusion::BRepFace>();
+        if (face) {
+          profileGeom.planeEntityId = face->entityToken();
+        }
+      }
+    }
+  }
+
+  // Extract area properties
+  auto areaProps = profile->areaProperties();
+  if (areaProps) {
+    profileGeom.area = areaProps->area();
+    auto centroid = areaProps->centroid();
+    if (centroid) {
+      profileGeom.centroid = {centroid->x(), centroid->y()};
+    }
+  }
+
+  // CRITICAL: Read all loops immediately while profile is valid. Each loop
+  // is chained on its own (chainPendingProfiles): the outer loop gives the
+  // vertices, inner loops the holes
+
+  auto profileLoops = profile->profileLoops();
+  if (profileLoops) {
+    for (size_t loopIdx = 0; loopIdx < profileLoops->count(); ++loopIdx) {
+      auto loop = profileLoops->item(static_cast<int>(loopIdx));
+      if (!loop)
+        continue;
+
+      auto profileCurves = loop->profileCurves();
+      if (!profileCurves)
+        continue;
+
+      // Exact curves are polygonized later at polygonTolerance, off this thread
+      std::vector<Geometry::ProfileCurve> exactLoop;
+      if (readExactProfileLoop(profileCurves, exactLoop)) {
+        if (loop->isOuter()) {
+          profileGeom.curves = std::move(exactLoop);
+        } else {
+          profileGeom.holeCurves.push_back(std::move(exactLoop));
+        }
+        continue;
+      }
+
+      // Collect stroke points of each curve for chaining
+      std::vector<StrokedCurve> allCurves;
+      allCurves.reserve(profileCurves->count());
+      for (size_t curveIdx = 0; curveIdx < profileCurves->count(); ++curveIdx) {
+        auto profileCurve = profileCurves->item(static_cast<int>(curveIdx));
+        if (!profileCurve)
+          continue;
+
+        auto sketchEntity = profileCurve->sketchEntity();
+        if (!sketchEntity)
+          continue;
+
+        // Extract geometry using the same approach as existing code
+        adsk::core::Ptr<adsk::core::Curve3D> worldGeometry = nullptr;
+
+        // Get world geometry from sketch entity
+        auto sketchCurve = sketchEntity->cast<adsk::fusion::SketchCurve>();
+        if (sketchCurve) {
+          // Try each entity type and get its world geometry
+          if (auto line = sketchEntity->cast<adsk::fusion::SketchLine>()) {
+            worldGeometry = line->worldGeometry();
+            LOG_INFO("    Curve " << curveIdx << " is a SketchLine");
+          } else if (auto arc = sketchEntity->cast<adsk::fusion::SketchArc>()) {
+            worldGeometry = arc->worldGeometry();
+            LOG_INFO("    Curve " << curveIdx << " is a SketchArc");
+          } else if (auto circle = sketchEntity->cast<adsk::fusion::SketchCircle>()) {
+            worldGeometry = circle->worldGeometry();
+            LOG_INFO("    Curve " << curveIdx << " is a SketchCircle");
+          } else if (auto spline = sketchEntity->cast<adsk::fusion::SketchFittedSpline>()) {
+            worldGeometry = spline->worldGeometry();
+            LOG_INFO("    Curve " << curveIdx << " is a SketchFittedSpline");
+          } else if (auto nurbs = sketchEntity->cast<adsk::fusion::SketchControlPointSpline>()) {
+            worldGeometry = nurbs->worldGeometry();
+            LOG_INFO("    Curve " << curveIdx << " is a SketchControlPointSpline");
+          } else if (auto ellipse = sketchEntity->cast<adsk::fusion::SketchEllipse>()) {
+            worldGeometry = ellipse->worldGeometry();
+            LOG_INFO("    Curve " << curveIdx << " is a SketchEllipse");
+          } else if (auto ellipticalArc = sketchEntity->cast<adsk::fusion::SketchEllipticalArc>()) {
+            worldGeometry = ellipticalArc->worldGeometry();
+            LOG_INFO("    Curve " << curveIdx << " is a SketchEllipticalArc");
+          }
+        }
+
+        if (worldGeometry) {
+          // Use tessellation like existing code to get proper polygon
+          // vertices
+          auto evaluator = worldGeometry->evaluator();
+          if (evaluator) {
+            double startParam = 0.0;
+            double endParam = 0.0;
+            if (evaluator->getParameterExtents(startParam, endParam)) {
+              // Use getStrokes for proper tessellation
+              std::vector<adsk::core::Ptr<adsk::core::Point3D>> strokePoints;
+
+              // Determine tolerance based on curve type
+              double chordTolerance = 0.01;  // Default: 0.1mm tolerance for accurate curves
+
+              // For lines, use coarser tolerance since they don't need
+              // tessellation
+              if (auto line = sketchEntity->cast<adsk::fusion::SketchLine>()) {
+                chordTolerance = 0.1;  // 1mm tolerance for lines (should only
+                                       // give 2 points)
+              } else {
+                // For arcs, circles, splines etc., use fine tolerance for
+                // smooth curves
+                chordTolerance = 0.005;  // 0.05mm tolerance for accurate
+                                         // curve representation
+              }
+
+              LOG_INFO("    Using tolerance " << chordTolerance << " cm for tessellation");
+              if (evaluator->getStrokes(startParam, endParam, chordTolerance, strokePoints)) {
+                LOG_INFO("    Generated " << strokePoints.size() << " stroke points");
+
+                // Validate tessellation quality for non-linear curves
+                if (!sketchEntity->cast<adsk::fusion::SketchLine>() && strokePoints.size() < 3) {
+                  LOG_WARNING("    Insufficient tessellation for curve " + std::to_string(curveIdx) + " (" +
+                              std::to_string(strokePoints.size()) + " points) - attempting finer tolerance");
+
+                  // Try again with finer tolerance
+                  strokePoints.clear();
+                  chordTolerance = Utils::Tolerance::TESSELLATION;
+                  if (evaluator->getStrokes(startParam, endParam, chordTolerance, strokePoints)) {
+                    LOG_INFO("    Retessellated with finer tolerance: " << strokePoints.size() << " points");
+                  }
+                }
+                // Copy the stroke points out for chaining
+                StrokedCurve stroked = copyStrokePoints(strokePoints);
+                if (!stroked.points.empty()) {
+                  allCurves.push_back(std::move(stroked));
+                }
+              } else {
+                LOG_ERROR("    getStrokes failed for curve " << curveIdx << " - geometry will be missing from profile");
+                // Try fallback with endpoints only for critical path
+                // continuity
+                adsk::core::Ptr<adsk::core::Point3D> startPt;
+                adsk::core::Ptr<adsk::core::Point3D> endPt;
+                if (evaluator->getPointAtParameter(startParam, startPt) &&
+                    evaluator->getPointAtParameter(endParam, endPt) && startPt && endPt) {
+                  allCurves.push_back(copyStrokePoints({startPt, endPt}));
+                  LOG_WARNING("    Using fallback endpoints-only approach for "
+                              "curve " +
+                              std::to_string(curveIdx));
+                }
+              }
+            }
+          }
+        }
+      }
+
+      if (loop->isOuter()) {
+        pending.outerLoop = std::move(allCurves);
+      } else {
+        pending.holeLoops.push_back(std::move(allCurves));
+      }
+    }
+  }
+  return true;
+}
+
+}  // namespace Commands
+}  // namespace ChipCarving
@@ -7,6 +7,7 @@
 
 #include "PluginCommands.h"
 #include "core/PluginManager.h"
+#include "utils/logging.h"
 
 namespace ChipCarving {
 namespace Commands {
@@ -15,6 +16,14 @@ namespace Commands {
 BaseCommandHandler::BaseCommandHandler(std::shared_ptr<Core::PluginManager> pluginManager)
     : pluginManager_(std::move(pluginManager)) {}
 
+std::shared_ptr<Core::PluginManager> BaseCommandHandler::pluginManager() const {
+  if (pluginManager_ && !pluginManager_->isInitialized() && !pluginManager_->initialize()) {
+    LOG_ERROR("Failed to initialize the plugin manager");
+    return nullptr;
+  }
+  return pluginManager_;
+}
+
 // ImportDesignCommandHandler Implementation
 ImportDesignCommandHandler::ImportDesignCommandHandler(std::shared_ptr<Core::PluginManager> pluginManager)
     : BaseCommandHandler(std::move(pluginManager)) {}
@@ -56,16 +65,16 @@ void ImportDesignCommandHandler::notify(const adsk::core::Ptr<adsk::core::Comman
 
   // Add wide title to make dialog wider
   inputs->addTextBoxCommandInput("titleText", "",
-                                 "<b>Import Design</b><br/>Import a JSON chip carving design file with "
+                                 "<b>Import Design</b><br/>Import JSON chip carving design files with "
                                  "Leaf and TriArc shapes, then optionally select a construction plane "
                                  "or surface for placement.",
                                  3, true);
 
   // Add file selection input
-  inputs->addBoolValueInput("fileSelectionButton", "Select Design File", false, "", true);
+  inputs->addBoolValueInput("fileSelectionButton", "Select Design Files", false, "", true);
 
-  // Add text input to show selected file (read-only)
-  auto filePathInput = inputs->addStringValueInput("selectedFilePath", "Selected File", "No file selected");
+  // Add text input to show selected files (read-only)
+  auto filePathInput = inputs->addStringValueInput("selectedFilePath", "Selected Files", "No file selected");
   filePathInput->isReadOnly(true);
 
   // Add plane/surface selection input
@@ -76,6 +85,21 @@ void ImportDesignCommandHandler::notify(const adsk::core::Ptr<adsk::core::Comman
   planeSelection->tooltip("Optional: Select a construction plane or flat surface for the sketch. "
                           "Must be parallel to XY plane. Defaults to XY plane if not selected.");
 
+  // Re-importing the last design updates its sketch in place
+  auto updateInput = inputs->addBoolValueInput("updatePreviousImport", "Update Previous Import", true, "", true);
+  if (updateInput) {
+    updateInput->tooltip("When the last imported file is imported again onto the same plane, redraw only the "
+                         "shapes that changed and delete removed ones, leaving the rest of its sketch in place.");
+  }
+
+  // Watch mode repeats that update, and the last Generate Paths run, on every save
+  auto watchInput = inputs->addBoolValueInput("watchDesignFile", "Watch Design File", true, "", false);
+  if (watchInput) {
+    watchInput->tooltip("Keep watching a single imported file: each save updates its sketch and, if Generate Paths "
+                        "ran on that sketch with incremental regeneration, regenerates the changed toolpaths in the "
+                        "background.");
+  }
+
   // Create and register execute handler
   class ExecuteHandler : public adsk::core::CommandEventHandler {
    public:
@@ -129,18 +153,20 @@ void ImportDesignCommandHandler::handleInputChanged(const adsk::core::Ptr<adsk::
       if (factory) {
         auto ui = factory->createUserInterface();
         if (ui) {
-          selectedFilePath_ = ui->showFileDialog("Select Design File", "JSON Files (*.json)");
+          selectedFilePaths_ = ui->showMultiFileDialog("Select Design Files", "JSON Files (*.json)");
 
           // Update the file path display
           auto filePathInput = inputs->itemById("selectedFilePath");
           if (filePathInput) {
             auto stringInput = filePathInput->cast<adsk::core::StringValueCommandInput>();
             if (stringInput) {
-              if (!selectedFilePath_.empty()) {
+              if (selectedFilePaths_.size() > 1) {
+                stringInput->value(std::to_string(selectedFilePaths_.size()) + " files");
+              } else if (!selectedFilePaths_.empty()) {
                 // Show just the filename, not the full path
-                size_t lastSlash = selectedFilePath_.find_last_of("/\\");
-                std::string filename =
-                    (lastSlash != std::string::npos) ? selectedFilePath_.substr(lastSlash + 1) : selectedFilePath_;
+                const std::string& path = selectedFilePaths_.front();
+                size_t lastSlash = path.find_last_of("/\\");
+                std::string filename = (lastSlash != std::string::npos) ? path.substr(lastSlash + 1) : path;
                 stringInput->value(filename);
               } else {
                 stringInput->value("No file selected");
@@ -166,13 +192,13 @@ void ImportDesignCommandHandler::executeImportDesign(const adsk::core::Ptr<adsk:
     return;
 
   // Check if a file was selected
-  if (selectedFilePath_.empty()) {
+  if (selectedFilePaths_.empty()) {
     if (pluginManager()) {
       auto* factory = pluginManager()->getFactory();
       if (factory) {
         auto ui = factory->createUserInterface();
         if (ui) {
-          ui->showMessageBox("Import Design", "Please select a JSON design file.");
+          ui->showMessageBox("Import Design", "Please select one or more JSON design files.");
         }
       }
     }
@@ -205,8 +231,29 @@ void ImportDesignCommandHandler::executeImportDesign(const adsk::core::Ptr<adsk:
     }
   }
 
-  // Execute the import with the selected file and optional plane
-  pluginManager()->executeImportDesign(selectedFilePath_, planeEntityId);
+  bool updatePrevious = true;
+  auto updateInput = inputs->itemById("updatePreviousImport");
+  if (updateInput) {
+    auto boolInput = updateInput->cast<adsk::core::BoolValueCommandInput>();
+    if (boolInput) {
+      updatePrevious = boolInput->value();
+    }
+  }
+
+  bool watchDesign = false;
+  auto watchInput = inputs->itemById("watchDesignFile");
+  if (watchInput) {
+    auto boolInput = watchInput->cast<adsk::core::BoolValueCommandInput>();
+    if (boolInput) {
+      watchDesign = boolInput->value() && selectedFilePaths_.size() == 1;
+    }
+  }
+
+  // Execute the import with the selected files and optional plane; watch mode follows the import that succeeded
+  bool imported = pluginManager()->executeImportDesigns(selectedFilePaths_, planeEntityId, updatePrevious);
+  if (imported || !watchDesign) {
+    pluginManager()->setDesignWatchEnabled(watchDesign);
+  }
 }
 
 }  // namespace Commands
@@ -4,10 +4,15 @@
  * Parameter input creation and processing for PluginCommands
  * Split from PluginCommands.cpp for maintainability
  *
- * Note: getSelectionFromInputs() is in PluginCommandsParametersSelection.cpp
+ * Note: getSelectionFromInputs() is in PluginCommandsParametersSelection.cpp, the
+ * G-code export inputs are in PluginCommandsParametersGcode.cpp, and the sampling
+ * and run inputs are in PluginCommandsParametersSampling.cpp and PluginCommandsParametersRun.cpp
  */
 
+#include <algorithm>
+
 #include "PluginCommands.h"
+#include "core/PluginManager.h"
 #include "utils/UnitConversion.h"
 
 using ChipCarving::Utils::fusionLengthToMm;
@@ -16,6 +21,11 @@ namespace ChipCarving {
 namespace Commands {
 
 void GeneratePathsCommandHandler::createParameterInputs(const adsk::core::Ptr<adsk::core::CommandInputs>& inputs) {
+  // Output mode and surface grid default to the Settings dialog's performance choices
+  Adapters::MedialAxisParameters defaults;
+  if (pluginManager()) {
+    pluginManager()->getPerformanceSettings().applyTo(defaults);
+  }
   // Add wide description to make dialog wider
   adsk::core::Ptr<adsk::core::TextBoxCommandInput> titleDesc =
       inputs->addTextBoxCommandInput("titleDescription", "",
@@ -77,13 +87,40 @@ void GeneratePathsCommandHandler::createParameterInputs(const adsk::core::Ptr<ad
       vcarveInputs->addValueInput("maxVCarveDepth", "Maximum Depth", "mm", adsk::core::ValueInput::createByReal(2.5));
   maxDepth->tooltip("Maximum allowed V-carve depth for safety (default: 25.0mm)");
 
+  adsk::core::Ptr<adsk::core::ValueCommandInput> stepDown = vcarveInputs->addValueInput(
+      "stepDownDepth", "Step Down", "mm",
+      adsk::core::ValueInput::createByReal(Utils::mmToFusionLength(defaults.stepDownDepth)));
+  stepDown->tooltip("Cut every path in depth passes at most this much deeper than the one before, all from one "
+                    "medial axis computation (0 = one full-depth pass)");
+
+  adsk::core::Ptr<adsk::core::ValueCommandInput> clearingStepover = vcarveInputs->addValueInput(
+      "clearingStepover", "Clearing Stepover", "mm",
+      adsk::core::ValueInput::createByReal(Utils::mmToFusionLength(defaults.clearingStepover)));
+  clearingStepover->tooltip("Clear the middle of regions wider than the tool reaches at the maximum depth with "
+                            "offset loops this far apart, traced from the same Voronoi diagram (0 = off)");
+
+  adsk::core::Ptr<adsk::core::ValueCommandInput> simplifyTolerance = vcarveInputs->addValueInput(
+      "pathSimplifyTolerance", "Path Simplify Tolerance", "mm", adsk::core::ValueInput::createByReal(0.001));
+  simplifyTolerance->tooltip("Drop spline fit points whose removal keeps the 3D toolpath within this distance "
+                             "(0 = keep every point, default: 0.01mm)");
+
+  // Toolpath curve type - fitted splines are smooth, lines and arcs are much faster to create
+  adsk::core::Ptr<adsk::core::DropDownCommandInput> curveDropdown = vcarveInputs->addDropDownCommandInput(
+      "toolpathCurveType", "Toolpath Curves", adsk::core::DropDownStyles::TextListDropDownStyle);
+  curveDropdown->listItems()->add("Fitted Splines", !defaults.outputPolylines);
+  curveDropdown->listItems()->add("Lines and Arcs", defaults.outputPolylines);
+  curveDropdown->tooltip("Create V-carve paths as fitted splines, or as connected 3D lines and arcs (faster for "
+                         "large designs)");
+
   // Always enable project to surface - it's the only mode we use
   adsk::core::Ptr<adsk::core::SelectionCommandInput> surfaceSelection =
       vcarveInputs->addSelectionInput("targetSurface", "Target Surface", "Select surface for projection");
   surfaceSelection->addSelectionFilter("Faces");  // Only allow face/surface selection
-  // Note: Selection limits not available in API, user can select multiple but
-  // we only use first
+  // Selection limits are not in the API; only the first selection is used
   surfaceSelection->tooltip("Select a surface to project the V-carve toolpaths onto");
+  createSurfaceScanInputs(vcarveInputs);
+
+  createGcodeExportInputs(inputs);
 
   // 3. VISUALIZATION OPTIONS (collapsible, default closed)
   adsk::core::Ptr<adsk::core::GroupCommandInput> constructionGroup =
@@ -95,6 +132,8 @@ void GeneratePathsCommandHandler::createParameterInputs(const adsk::core::Ptr<ad
   adsk::core::Ptr<adsk::core::BoolValueCommandInput> generateViz =
       constructionInputs->addBoolValueInput("generateVisualization", "Generate Visualization", true, "", false);
   generateViz->tooltip("Generate visualization sketches (default: off)");
+  constructionInputs->addBoolValueInput("visualizeAsCustomGraphics", "Viewport Graphics", true, "", true)
+      ->tooltip("Draw the visualization as viewport graphics instead of a construction sketch");
 
   adsk::core::Ptr<adsk::core::BoolValueCommandInput> showMedial =
       constructionInputs->addBoolValueInput("showMedialLines", "Medial Axis Lines", true, "", true);
@@ -134,17 +173,30 @@ void GeneratePathsCommandHandler::createParameterInputs(const adsk::core::Ptr<ad
   forceBoundary->tooltip("Ensure every intersection with shape boundary is included in the "
                          "path");
 
-  // Surface sampling distance - controls V-carve path density for better
-  // surface following Fusion 360 internal units are cm, so 2.0mm = 0.2cm
+  // Surface sampling distance (V-carve point density); Fusion units are cm, so 2.0mm = 0.2cm
   adsk::core::Ptr<adsk::core::ValueCommandInput> samplingDistance = groupInputs->addValueInput(
       "surfaceSamplingDistance", "Surface Sampling Distance", "mm", adsk::core::ValueInput::createByReal(0.2));
   samplingDistance->tooltip("Distance between V-carve points for surface following (smaller = more "
                             "accurate, default: 2.0mm)");
+
+  // Surface grid resolution - samples the target surface once on a grid instead
+  // of at every V-carve point (0 = per-point queries); Settings picks the default
+  adsk::core::Ptr<adsk::core::ValueCommandInput> gridResolution = groupInputs->addValueInput(
+      "surfaceGridResolution", "Surface Grid Resolution", "mm",
+      adsk::core::ValueInput::createByReal(Utils::mmToFusionLength(defaults.surfaceGridResolution)));
+  gridResolution->tooltip("Spacing of the precomputed surface height grid used for projection (0 = query the "
+                          "surface at every V-carve point, default: the Settings surface query)");
+
+  createSamplingInputs(groupInputs);
+  createRunInputs(groupInputs);
 }
 
 ChipCarving::Adapters::MedialAxisParameters GeneratePathsCommandHandler::getParametersFromInputs(
     const adsk::core::Ptr<adsk::core::CommandInputs>& inputs) {
   ChipCarving::Adapters::MedialAxisParameters params;
+  if (pluginManager()) {
+    pluginManager()->getPerformanceSettings().applyTo(params);  // Inputs below override what they cover
+  }
 
   // Get tool selection
   adsk::core::Ptr<adsk::core::DropDownCommandInput> toolDropdown = inputs->itemById("toolSelection");
@@ -176,9 +228,13 @@ ChipCarving::Adapters::MedialAxisParameters GeneratePathsCommandHandler::getPara
     params.samplingDistance = 2.0;  // 2mm default
   }
 
-  // REMOVED: Reading clearanceCircleSpacing - no longer needed
-  // Set default clearance circle spacing (not used, but may be expected by
-  // other code)
+  adsk::core::Ptr<adsk::core::ValueCommandInput> gridResolutionInput = inputs->itemById("surfaceGridResolution");
+  if (gridResolutionInput) {
+    // Convert from Fusion's database units (cm) to mm
+    params.surfaceGridResolution = fusionLengthToMm(gridResolutionInput->value());
+  }
+
+  // Clearance circle spacing has no input; keep the default other code may expect
   params.clearanceCircleSpacing = 5.0;  // 5mm default
 
   adsk::core::Ptr<adsk::core::ValueCommandInput> crossSizeInput = inputs->itemById("crossSize");
@@ -211,6 +267,10 @@ ChipCarving::Adapters::MedialAxisParameters GeneratePathsCommandHandler::getPara
   if (generateViz) {
     params.generateVisualization = generateViz->value();
   }
+  adsk::core::Ptr<adsk::core::BoolValueCommandInput> vizGraphics = inputs->itemById("visualizeAsCustomGraphics");
+  if (vizGraphics) {
+    params.visualizeAsCustomGraphics = vizGraphics->value();
+  }
 
   // V-carve parameters
   adsk::core::Ptr<adsk::core::BoolValueCommandInput> generateVCarve = inputs->itemById("generateVCarveToolpaths");
@@ -224,6 +284,27 @@ ChipCarving::Adapters::MedialAxisParameters GeneratePathsCommandHandler::getPara
     params.maxVCarveDepth = fusionLengthToMm(maxDepth->value());
   }
 
+  adsk::core::Ptr<adsk::core::ValueCommandInput> stepDown = inputs->itemById("stepDownDepth");
+  if (stepDown) {
+    params.stepDownDepth = std::max(0.0, fusionLengthToMm(stepDown->value()));
+  }
+
+  adsk::core::Ptr<adsk::core::ValueCommandInput> clearingStepover = inputs->itemById("clearingStepover");
+  if (clearingStepover) {
+    params.clearingStepover = std::max(0.0, fusionLengthToMm(clearingStepover->value()));
+  }
+
+  adsk::core::Ptr<adsk::core::ValueCommandInput> simplifyTolerance = inputs->itemById("pathSimplifyTolerance");
+  if (simplifyTolerance) {
+    // Convert from Fusion's database units (cm) to mm
+    params.pathSimplifyTolerance = fusionLengthToMm(simplifyTolerance->value());
+  }
+
+  adsk::core::Ptr<adsk::core::DropDownCommandInput> curveDropdown = inputs->itemById("toolpathCurveType");
+  if (curveDropdown && curveDropdown->selectedItem()) {
+    params.outputPolylines = curveDropdown->selectedItem()->name() == "Lines and Arcs";
+  }
+
   // Always enable project to surface - it's the only mode we use
   params.projectToSurface = true;
 
@@ -241,6 +322,11 @@ ChipCarving::Adapters::MedialAxisParameters GeneratePathsCommandHandler::getPara
     }
   }
 
+  readGcodeExportParameters(inputs, params);
+  readSurfaceScanParameters(inputs, params);
+  readSamplingParameters(inputs, params);
+  readRunParameters(inputs, params);
+
   return params;
 }
 
@@ -0,0 +1,107 @@
+/**
+ * PluginCommandsParametersGcode.cpp
+ *
+ * G-code and review SVG export inputs for the Generate Paths dialog
+ * Split from PluginCommandsParameters.cpp for maintainability
+ */
+
+#include "PluginCommands.h"
+#include "utils/UnitConversion.h"
+
+using ChipCarving::Utils::fusionLengthToMm;
+
+namespace ChipCarving {
+namespace Commands {
+
+void GeneratePathsCommandHandler::createGcodeExportInputs(const adsk::core::Ptr<adsk::core::CommandInputs>& inputs) {
+  // G-CODE EXPORT (collapsible, default closed)
+  adsk::core::Ptr<adsk::core::GroupCommandInput> gcodeGroup =
+      inputs->addGroupCommandInput("gcodeGroup", "G-code Export");
+  gcodeGroup->isExpanded(false);
+  gcodeGroup->isEnabledCheckBoxDisplayed(false);
+  adsk::core::Ptr<adsk::core::CommandInputs> gcodeInputs = gcodeGroup->children();
+
+  adsk::core::Ptr<adsk::core::StringValueCommandInput> gcodePath =
+      gcodeInputs->addStringValueInput("gcodeExportPath", "G-code File", "");
+  gcodePath->tooltip("Write the V-carve toolpaths straight to this G-code file, skipping Fusion CAM "
+                     "(empty = no G-code)");
+
+  adsk::core::Ptr<adsk::core::BoolValueCommandInput> skipSketch =
+      gcodeInputs->addBoolValueInput("gcodeSkipSketch", "Skip Toolpath Sketch", true, "", false);
+  skipSketch->tooltip("When writing G-code, do not create the V-carve toolpath sketch (fastest for large designs)");
+
+  // FIXED UNITS - Fusion 360 internal units are cm, so 5mm = 0.5cm
+  adsk::core::Ptr<adsk::core::ValueCommandInput> safeZ =
+      gcodeInputs->addValueInput("gcodeSafeZ", "Safe Z", "mm", adsk::core::ValueInput::createByReal(0.5));
+  safeZ->tooltip("Rapid-travel height above the sketch plane (default: 5.0mm)");
+
+  adsk::core::Ptr<adsk::core::IntegerSpinnerCommandInput> feedRate =
+      gcodeInputs->addIntegerSpinnerCommandInput("gcodeFeedRate", "Feed Rate (mm/min)", 1, 100000, 100, 1000);
+  feedRate->tooltip("Cutting feed rate (default: 1000 mm/min)");
+
+  adsk::core::Ptr<adsk::core::IntegerSpinnerCommandInput> plungeRate =
+      gcodeInputs->addIntegerSpinnerCommandInput("gcodePlungeRate", "Plunge Rate (mm/min)", 1, 100000, 50, 300);
+  plungeRate->tooltip("Feed rate for the plunge into each toolpath (default: 300 mm/min)");
+
+  adsk::core::Ptr<adsk::core::IntegerSpinnerCommandInput> spindle =
+      gcodeInputs->addIntegerSpinnerCommandInput("gcodeSpindleRpm", "Spindle Speed (rpm)", 0, 60000, 1000, 18000);
+  spindle->tooltip("Spindle speed for M3 (0 = no spindle commands, default: 18000 rpm)");
+
+  adsk::core::Ptr<adsk::core::ValueCommandInput> arcTolerance = gcodeInputs->addValueInput(
+      "gcodeArcTolerance", "Arc Fit Tolerance", "mm", adsk::core::ValueInput::createByReal(0.001));
+  arcTolerance->tooltip("Replace runs of G1 moves with G2/G3 helical arcs that stay within this distance "
+                        "(0 = G1 only, default: 0.01mm)");
+
+  adsk::core::Ptr<adsk::core::StringValueCommandInput> svgPath =
+      gcodeInputs->addStringValueInput("svgExportPath", "Review SVG File", "");
+  svgPath->tooltip("Also write the profiles, medial axes colored by clearance and toolpaths colored by depth "
+                   "to this SVG file for offline review (empty = no SVG)");
+}
+
+void GeneratePathsCommandHandler::readGcodeExportParameters(const adsk::core::Ptr<adsk::core::CommandInputs>& inputs,
+                                                            Adapters::MedialAxisParameters& params) {
+  adsk::core::Ptr<adsk::core::StringValueCommandInput> gcodePath = inputs->itemById("gcodeExportPath");
+  if (gcodePath) {
+    params.gcodeExportPath = gcodePath->value();
+  }
+
+  adsk::core::Ptr<adsk::core::BoolValueCommandInput> skipSketch = inputs->itemById("gcodeSkipSketch");
+  if (skipSketch) {
+    params.gcodeSkipSketch = skipSketch->value();
+  }
+
+  adsk::core::Ptr<adsk::core::ValueCommandInput> safeZ = inputs->itemById("gcodeSafeZ");
+  if (safeZ) {
+    // Convert from Fusion's database units (cm) to mm
+    params.gcodeSafeZ = fusionLengthToMm(safeZ->value());
+  }
+
+  adsk::core::Ptr<adsk::core::IntegerSpinnerCommandInput> feedRate = inputs->itemById("gcodeFeedRate");
+  if (feedRate) {
+    params.gcodeFeedRate = feedRate->value();
+  }
+
+  adsk::core::Ptr<adsk::core::IntegerSpinnerCommandInput> plungeRate = inputs->itemById("gcodePlungeRate");
+  if (plungeRate) {
+    params.gcodePlungeRate = plungeRate->value();
+  }
+
+  adsk::core::Ptr<adsk::core::IntegerSpinnerCommandInput> spindle = inputs->itemById("gcodeSpindleRpm");
+  if (spindle) {
+    params.gcodeSpindleRpm = spindle->value();
+  }
+
+  adsk::core::Ptr<adsk::core::ValueCommandInput> arcTolerance = inputs->itemById("gcodeArcTolerance");
+  if (arcTolerance) {
+    // Convert from Fusion's database units (cm) to mm
+    params.gcodeArcTolerance = fusionLengthToMm(arcTolerance->value());
+  }
+
+  adsk::core::Ptr<adsk::core::StringValueCommandInput> svgPath = inputs->itemById("svgExportPath");
+  if (svgPath) {
+    params.svgExportPath = svgPath->value();
+  }
+}
+
+}  // namespace Commands
+}  // namespace ChipCarving
@@ -0,0 +1,79 @@
+/**
+ * PluginCommandsParametersRun.cpp
+ *
+ * Background, tiling, incremental, progressive and time budget inputs for the Generate Paths dialog
+ * Split from PluginCommandsParameters.cpp for maintainability
+ */
+
+#include <algorithm>
+
+#include "PluginCommands.h"
+#include "utils/UnitConversion.h"
+
+using ChipCarving::Utils::fusionLengthToMm;
+
+namespace ChipCarving {
+namespace Commands {
+
+void GeneratePathsCommandHandler::createRunInputs(const adsk::core::Ptr<adsk::core::CommandInputs>& inputs) {
+  // Background generation keeps Fusion responsive and allows cancelling long runs
+  adsk::core::Ptr<adsk::core::BoolValueCommandInput> runInBackground =
+      inputs->addBoolValueInput("runInBackground", "Run in Background", true, "", true);
+  runInBackground->tooltip("Compute medial axes and V-carve paths on a worker thread with a cancellable progress "
+                           "dialog; sketches are written once the computation finishes");
+  inputs->addValueInput("spatialTileSize", "Tile Size", "mm", adsk::core::ValueInput::createByReal(0.0))
+      ->tooltip("Generate large panels tile by tile on a square grid of this size, each tile into its own "
+                "sketches, so memory stays bounded by one tile (0 = no tiling)");
+  inputs->addBoolValueInput("resumeTiledRun", "Resume Tiled Run", true, "", false)
+      ->tooltip("Skip the tiles an interrupted tiled run of the same selection and tool already finished");
+  inputs->addBoolValueInput("incrementalRegeneration", "Only Changed Profiles", true, "", false)
+      ->tooltip("Keep the toolpaths of unchanged profiles in the existing toolpath sketch and regenerate only "
+                "profiles that were moved or edited (not with G-code export or visualization)");
+  inputs->addBoolValueInput("progressiveRefinement", "Progressive Refinement", true, "", false)
+      ->tooltip("Run in the background: write coarse toolpaths for every profile at once, then replace them with "
+                "exact ones a batch of profiles at a time (not with G-code export or visualization)");
+  inputs->addBoolValueInput("outputToBaseFeature", "Direct Edit Output", true, "", false)
+      ->tooltip("Write the generated sketches inside one base feature, outside the parametric timeline, so edits "
+                "upstream do not recompute them (not with Only Changed Profiles)");
+  inputs->addValueInput("generationTimeBudget", "Time Budget (s)", "", adsk::core::ValueInput::createByReal(0.0))
+      ->tooltip("Return within about this many seconds: every profile gets coarse toolpaths first, then exact ones "
+                "cheapest first while time remains; the run report lists profiles left coarse (0 = no limit)");
+}
+
+void GeneratePathsCommandHandler::readRunParameters(const adsk::core::Ptr<adsk::core::CommandInputs>& inputs,
+                                                    Adapters::MedialAxisParameters& params) {
+  adsk::core::Ptr<adsk::core::BoolValueCommandInput> runInBackgroundInput = inputs->itemById("runInBackground");
+  if (runInBackgroundInput) {
+    params.runInBackground = runInBackgroundInput->value();
+  }
+  adsk::core::Ptr<adsk::core::ValueCommandInput> tileSizeInput = inputs->itemById("spatialTileSize");
+  if (tileSizeInput) {
+    // Convert from Fusion's database units (cm) to mm
+    params.spatialTileSize = fusionLengthToMm(tileSizeInput->value());
+  }
+  adsk::core::Ptr<adsk::core::BoolValueCommandInput> resumeTilesInput = inputs->itemById("resumeTiledRun");
+  if (resumeTilesInput) {
+    params.resumeTiledRun = resumeTilesInput->value();
+  }
+  // Finished tiles are journaled next to the log, so a run cut short by a crash can resume
+  params.tileJournalPath = "/tmp/chip_carving_cpp_tiles.journal";
+  adsk::core::Ptr<adsk::core::BoolValueCommandInput> incrementalInput = inputs->itemById("incrementalRegeneration");
+  if (incrementalInput) {
+    params.incrementalRegeneration = incrementalInput->value();
+  }
+  adsk::core::Ptr<adsk::core::BoolValueCommandInput> progressiveInput = inputs->itemById("progressiveRefinement");
+  if (progressiveInput) {
+    params.progressiveRefinement = progressiveInput->value();
+  }
+  adsk::core::Ptr<adsk::core::BoolValueCommandInput> baseFeatureInput = inputs->itemById("outputToBaseFeature");
+  if (baseFeatureInput) {
+    params.outputToBaseFeature = baseFeatureInput->value();
+  }
+  adsk::core::Ptr<adsk::core::ValueCommandInput> timeBudgetInput = inputs->itemById("generationTimeBudget");
+  if (timeBudgetInput) {
+    params.generationTimeBudget = std::max(0.0, timeBudgetInput->value());
+  }
+}
+
+}  // namespace Commands
+}  // namespace ChipCarving
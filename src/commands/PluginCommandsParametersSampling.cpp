@@ -0,0 +1,98 @@
+/**
+ * PluginCommandsParametersSampling.cpp
+ *
+ * Adaptive, exact and auto-tolerance sampling inputs for the Generate Paths dialog
+ * Split from PluginCommandsParameters.cpp for maintainability
+ */
+
+#include <utility>
+
+#include "PluginCommands.h"
+#include "utils/UnitConversion.h"
+
+using ChipCarving::Utils::fusionLengthToMm;
+
+namespace ChipCarving {
+namespace Commands {
+
+void GeneratePathsCommandHandler::createSamplingInputs(const adsk::core::Ptr<adsk::core::CommandInputs>& inputs) {
+  // Adaptive sampling - places points by chord error rather than fixed spacing
+  adsk::core::Ptr<adsk::core::BoolValueCommandInput> adaptiveSampling =
+      inputs->addBoolValueInput("adaptiveSampling", "Adaptive Sampling", true, "", false);
+  adaptiveSampling->tooltip("Place V-carve points only where position or depth would otherwise deviate by more than "
+                            "the chord tolerance (straight runs become sparse)");
+
+  adsk::core::Ptr<adsk::core::ValueCommandInput> chordTolerance = inputs->addValueInput(
+      "samplingChordTolerance", "Sampling Chord Tolerance", "mm", adsk::core::ValueInput::createByReal(0.002));
+  chordTolerance->tooltip("Maximum position or depth error allowed between adaptive samples (default: 0.02mm)");
+
+  // Exact sampling - fixed-distance samples evaluated on the chain, clearance measured to the profile
+  inputs->addBoolValueInput("exactSampling", "Exact Sampling", true, "", false)
+      ->tooltip("Place fixed-distance V-carve points at exact distances along the medial axis and measure their "
+                "clearance to the profile instead of interpolating it (more accurate depth on curved sections)");
+
+  // Auto tolerance - polygon tolerance and sampling distance chosen per profile
+  Adapters::MedialAxisParameters autoDefaults;
+  inputs->addBoolValueInput("autoTolerance", "Auto Tolerance", true, "", false)
+      ->tooltip("Choose each profile's polygon tolerance and sampling distance from its size, its tightest curve "
+                "and the V-bit angle, within the bounds below (instead of Polygon Tolerance and Sampling Distance)");
+  inputs
+      ->addValueInput("autoDepthError", "Auto Depth Error", "mm",
+                      adsk::core::ValueInput::createByReal(Utils::mmToFusionLength(autoDefaults.autoDepthError)))
+      ->tooltip("V-carve depth error allowed from polygonizing the outlines (default: 0.2mm)");
+  inputs
+      ->addValueInput("autoToleranceMin", "Auto Tolerance Min", "mm",
+                      adsk::core::ValueInput::createByReal(Utils::mmToFusionLength(autoDefaults.autoToleranceMin)))
+      ->tooltip("Finest polygon tolerance any profile gets (default: 0.01mm)");
+  inputs
+      ->addValueInput("autoToleranceMax", "Auto Tolerance Max", "mm",
+                      adsk::core::ValueInput::createByReal(Utils::mmToFusionLength(autoDefaults.autoToleranceMax)))
+      ->tooltip("Coarsest polygon tolerance any profile gets (default: 0.5mm)");
+  inputs
+      ->addValueInput("autoSamplingMin", "Auto Sampling Min", "mm",
+                      adsk::core::ValueInput::createByReal(Utils::mmToFusionLength(autoDefaults.autoSamplingMin)))
+      ->tooltip("Shortest sampling distance any profile gets (default: 0.1mm)");
+  inputs
+      ->addValueInput("autoSamplingMax", "Auto Sampling Max", "mm",
+                      adsk::core::ValueInput::createByReal(Utils::mmToFusionLength(autoDefaults.autoSamplingMax)))
+      ->tooltip("Longest sampling distance any profile gets (default: 2mm)");
+}
+
+void GeneratePathsCommandHandler::readSamplingParameters(const adsk::core::Ptr<adsk::core::CommandInputs>& inputs,
+                                                         Adapters::MedialAxisParameters& params) {
+  adsk::core::Ptr<adsk::core::BoolValueCommandInput> adaptiveSamplingInput = inputs->itemById("adaptiveSampling");
+  if (adaptiveSamplingInput) {
+    params.adaptiveSampling = adaptiveSamplingInput->value();
+  }
+
+  adsk::core::Ptr<adsk::core::BoolValueCommandInput> exactSamplingInput = inputs->itemById("exactSampling");
+  if (exactSamplingInput) {
+    params.exactSampling = exactSamplingInput->value();
+  }
+
+  adsk::core::Ptr<adsk::core::ValueCommandInput> chordToleranceInput = inputs->itemById("samplingChordTolerance");
+  if (chordToleranceInput) {
+    // Convert from Fusion's database units (cm) to mm
+    params.samplingChordTolerance = fusionLengthToMm(chordToleranceInput->value());
+  }
+
+  adsk::core::Ptr<adsk::core::BoolValueCommandInput> autoToleranceInput = inputs->itemById("autoTolerance");
+  if (autoToleranceInput) {
+    params.autoTolerance = autoToleranceInput->value();
+  }
+  // Auto tolerance bounds, converted from Fusion's database units (cm) to mm
+  const std::pair<const char*, double*> autoBounds[] = {{"autoDepthError", &params.autoDepthError},
+                                                        {"autoToleranceMin", &params.autoToleranceMin},
+                                                        {"autoToleranceMax", &params.autoToleranceMax},
+                                                        {"autoSamplingMin", &params.autoSamplingMin},
+                                                        {"autoSamplingMax", &params.autoSamplingMax}};
+  for (const auto& bound : autoBounds) {
+    adsk::core::Ptr<adsk::core::ValueCommandInput> boundInput = inputs->itemById(bound.first);
+    if (boundInput) {
+      *bound.second = fusionLengthToMm(boundInput->value());
+    }
+  }
+}
+
+}  // namespace Commands
+}  // namespace ChipCarving
@@ -0,0 +1,83 @@
+/**
+ * PluginCommandsParametersScan.cpp
+ *
+ * Scanned blank and slope compensation inputs for the Generate Paths dialog
+ * Split from PluginCommandsParameters.cpp for maintainability
+ */
+
+#include <string>
+
+#include "PluginCommands.h"
+#include "utils/UnitConversion.h"
+
+using ChipCarving::Utils::fusionLengthToMm;
+using ChipCarving::Utils::mmToFusionLength;
+
+namespace ChipCarving {
+namespace Commands {
+
+namespace {
+
+// Scan placement inputs are lengths in mm, read back from Fusion's cm
+struct ScanLengthInput {
+  const char* id;
+  const char* name;
+  double Adapters::MedialAxisParameters::*field;
+  const char* tooltip;
+};
+
+const ScanLengthInput SCAN_LENGTH_INPUTS[] = {
+    {"surfaceScanOriginX", "Scan Origin X", &Adapters::MedialAxisParameters::surfaceScanOriginX,
+     "Design X of the scan's origin (a heightmap's lower-left pixel)"},
+    {"surfaceScanOriginY", "Scan Origin Y", &Adapters::MedialAxisParameters::surfaceScanOriginY,
+     "Design Y of the scan's origin (a heightmap's lower-left pixel)"},
+    {"surfaceScanPixelSize", "Heightmap Pixel Size", &Adapters::MedialAxisParameters::surfaceScanPixelSize,
+     "Distance between heightmap PNG pixels (height grids and meshes carry their own scale, default: 0.1mm)"},
+    {"surfaceScanHeightRange", "Heightmap Height Range", &Adapters::MedialAxisParameters::surfaceScanHeightRange,
+     "Height of a white heightmap PNG pixel; black is 0 (default: 10mm)"},
+    {"surfaceScanZOffset", "Scan Z Offset", &Adapters::MedialAxisParameters::surfaceScanZOffset,
+     "Added to every scan height, to put the scan's zero on the blank's underside or the sketch plane"},
+};
+
+}  // namespace
+
+void GeneratePathsCommandHandler::createSurfaceScanInputs(const adsk::core::Ptr<adsk::core::CommandInputs>& inputs) {
+  adsk::core::Ptr<adsk::core::StringValueCommandInput> scanPath =
+      inputs->addStringValueInput("surfaceScanPath", "Scanned Blank File", "");
+  scanPath->tooltip("Project onto a scan of the blank instead of the target surface: a grayscale heightmap PNG, "
+                    "a height grid (.chg), or a PLY or STL mesh in mm (empty = use the target surface)");
+
+  Adapters::MedialAxisParameters defaults;
+  for (const ScanLengthInput& input : SCAN_LENGTH_INPUTS) {
+    adsk::core::Ptr<adsk::core::ValueCommandInput> value = inputs->addValueInput(
+        input.id, input.name, "mm", adsk::core::ValueInput::createByReal(mmToFusionLength(defaults.*input.field)));
+    value->tooltip(input.tooltip);
+  }
+
+  inputs->addBoolValueInput("surfaceSlopeCompensation", "Slope Depth Compensation", true, "", false)
+      ->tooltip("Deepen cuts on sloped surfaces so chips are as deep, measured across the surface, as on the "
+                "flat (up to 2x at 60°; exact with a surface grid resolution, along the path otherwise)");
+}
+
+void GeneratePathsCommandHandler::readSurfaceScanParameters(const adsk::core::Ptr<adsk::core::CommandInputs>& inputs,
+                                                            Adapters::MedialAxisParameters& params) {
+  adsk::core::Ptr<adsk::core::StringValueCommandInput> scanPath = inputs->itemById("surfaceScanPath");
+  if (scanPath) {
+    params.surfaceScanPath = scanPath->value();
+  }
+  adsk::core::Ptr<adsk::core::BoolValueCommandInput> slopeCompensation = inputs->itemById("surfaceSlopeCompensation");
+  if (slopeCompensation) {
+    params.surfaceSlopeCompensation = slopeCompensation->value();
+  }
+
+  for (const ScanLengthInput& input : SCAN_LENGTH_INPUTS) {
+    adsk::core::Ptr<adsk::core::ValueCommandInput> value = inputs->itemById(input.id);
+    if (value) {
+      // Convert from Fusion's database units (cm) to mm
+      params.*input.field = fusionLengthToMm(value->value());
+    }
+  }
+}
+
+}  // namespace Commands
+}  // namespace ChipCarving
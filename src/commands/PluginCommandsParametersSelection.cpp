@@ -102,6 +102,9 @@ Adapters::SketchSelection GeneratePathsCommandHandler::getSelectionFromInputs(
         // Get sketch name if available
         if (profile->parentSketch()) {
           profileGeom.sketchName = profile->parentSketch()->name();
+          if (profile->parentSketch()->parentComponent()) {
+            profileGeom.componentEntityId = profile->parentSketch()->parentComponent()->entityToken();
+          }
 
           // Get plane entity ID
           auto referenceEntity = profile->parentSketch()->referencePlane();
@@ -211,6 +214,9 @@ Adapters::SketchSelection GeneratePathsCommandHandler::getSelectionFromInputs(
               }
 
               profileGeom.sketchName = sketch->name();
+              if (sketch->parentComponent()) {
+                profileGeom.componentEntityId = sketch->parentComponent()->entityToken();
+              }
 
               auto referenceEntity = sketch->referencePlane();
               if (referenceEntity) {
@@ -3,81 +3,107 @@
  *
  * Selection validation for PluginCommands
  * Ensures only closed profiles can be selected
+ *
+ * A window selection fires one selection change per entity, so validation is
+ * incremental: entities already validated are only looked up by token, the
+ * closed profiles of each sketch are walked once and every curve's verdict is
+ * kept, and complete profiles are rechecked only in sketches whose selected
+ * curves changed.
  */
 
-#include <algorithm>
-#include <map>
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+#include <utility>
 #include <vector>
 
 #include "PluginCommands.h"
+#include "core/PluginManager.h"  // IWYU pragma: keep
 #include "utils/logging.h"
 
 namespace ChipCarving {
 namespace Commands {
 
-bool GeneratePathsCommandHandler::isPartOfClosedProfile(const adsk::core::Ptr<adsk::fusion::SketchCurve>& curve) {
-  if (!curve || !curve->parentSketch()) {
-    return false;
+const GeneratePathsCommandHandler::SketchProfileIndex& GeneratePathsCommandHandler::sketchProfileIndex(
+    const adsk::core::Ptr<adsk::fusion::Sketch>& sketch) {
+  std::string sketchToken = sketch->entityToken();
+  auto cached = sketchProfileIndices_.find(sketchToken);
+  if (cached != sketchProfileIndices_.end()) {
+    return cached->second;
   }
 
-  // Get the parent sketch
-  auto sketch = curve->parentSketch();
+  SketchProfileIndex& index = sketchProfileIndices_[sketchToken];
   auto profiles = sketch->profiles();
-
-  LOG_INFO("    Checking curve in sketch with " << (profiles ? profiles->count() : 0) << " profiles");
-
-  if (!profiles || profiles->count() == 0) {
-    return false;
+  if (!profiles) {
+    return index;
   }
-
-  // Check each profile in the sketch
   for (int p = 0; p < static_cast<int>(profiles->count()); ++p) {
     auto profile = profiles->item(p);
     if (!profile || !profile->isValid()) {
-      LOG_DEBUG("Skipping invalid profile at index " << p);
       continue;
     }
 
-    // Check if this profile is closed (has area)
+    // Only closed profiles (with area) count
     auto areaProps = profile->areaProperties();
     if (!areaProps || areaProps->area() <= 0) {
-      LOG_INFO("      Profile " << p << " is not closed (no area)");
-      continue;  // Not a closed profile
+      continue;
     }
 
-    LOG_INFO("      Profile " << p << " has area: " << areaProps->area());
-
-    // Check if the curve is part of this profile
+    std::vector<std::string> curves;
     auto profileLoops = profile->profileLoops();
-    if (!profileLoops)
-      continue;
-
-    for (size_t l = 0; l < profileLoops->count(); ++l) {
-      auto loop = profileLoops->item(l);
-      if (!loop || !loop->isValid()) {
-        LOG_DEBUG("Skipping invalid loop at index " << l);
-        continue;
-      }
-
-      auto loopCurves = loop->profileCurves();
-      if (!loopCurves)
-        continue;
-
-      for (size_t c = 0; c < loopCurves->count(); ++c) {
-        auto profileCurve = loopCurves->item(c);
-        if (!profileCurve || !profileCurve->isValid())
+    if (profileLoops) {
+      for (size_t l = 0; l < profileLoops->count(); ++l) {
+        auto loop = profileLoops->item(l);
+        if (!loop || !loop->isValid()) {
+          continue;
+        }
+        auto loopCurves = loop->profileCurves();
+        if (!loopCurves) {
           continue;
-        if (profileCurve->sketchEntity()) {
-          // Check if this is our curve
-          if (profileCurve->sketchEntity()->entityToken() == curve->entityToken()) {
-            return true;  // Found it in a closed profile
+        }
+        for (size_t c = 0; c < loopCurves->count(); ++c) {
+          auto profileCurve = loopCurves->item(c);
+          if (profileCurve && profileCurve->isValid() && profileCurve->sketchEntity()) {
+            curves.push_back(profileCurve->sketchEntity()->entityToken());
           }
         }
       }
     }
+    if (curves.empty()) {
+      continue;
+    }
+    for (const auto& curve : curves) {
+      index.profilesByCurve[curve].push_back(index.closedProfileCurves.size());
+    }
+    index.closedProfileCurves.push_back(std::move(curves));
+  }
+
+  LOG_INFO("Indexed " << index.closedProfileCurves.size() << " closed profiles of sketch '" << sketch->name()
+                      << "'");
+  return index;
+}
+
+bool GeneratePathsCommandHandler::isPartOfClosedProfile(const adsk::core::Ptr<adsk::fusion::SketchCurve>& curve) {
+  if (!curve || !curve->parentSketch()) {
+    return false;
   }
 
-  return false;  // Curve not found in any closed profile
+  std::string curveToken = curve->entityToken();
+  auto verdict = closedCurveVerdicts_.find(curveToken);
+  if (verdict != closedCurveVerdicts_.end()) {
+    return verdict->second;
+  }
+  const SketchProfileIndex& index = sketchProfileIndex(curve->parentSketch());
+  bool closed = index.profilesByCurve.count(curveToken) > 0;
+  closedCurveVerdicts_[curveToken] = closed;
+  return closed;
+}
+
+void GeneratePathsCommandHandler::clearSelectionValidation() {
+  sketchProfileIndices_.clear();
+  closedCurveVerdicts_.clear();
+  validatedEntities_.clear();
+  completeCurvesBySketch_.clear();
 }
 
 void GeneratePathsCommandHandler::validateAndCleanSelection(
@@ -85,176 +111,120 @@ void GeneratePathsCommandHandler::validateAndCleanSelection(
   if (!selectionInput)
     return;
 
-  LOG_INFO("Validating " << selectionInput->selectionCount() << " selections...");
-
-  // Track which curves belong to which profiles
-  std::map<std::string, std::vector<adsk::core::Ptr<adsk::fusion::SketchCurve>>> curvesBySketch;
-  std::vector<int> indicesToRemove;
+  int count = static_cast<int>(selectionInput->selectionCount());
+  std::vector<std::string> tokens(static_cast<size_t>(count));
+  std::vector<bool> keep(static_cast<size_t>(count), true);
+  std::unordered_set<std::string> current;
+  std::unordered_set<std::string> changedSketches;
+  std::unordered_map<std::string, std::unordered_set<std::string>> curvesBySketch;  // Selected, by sketch token
+  size_t added = 0;
 
-  // Process selections from back to front to safely remove invalid ones
-  for (int i = static_cast<int>(selectionInput->selectionCount()) - 1; i >= 0; --i) {
+  for (int i = 0; i < count; ++i) {
     auto selection = selectionInput->selection(i);
     if (!selection || !selection->entity()) {
-      indicesToRemove.push_back(i);
+      keep[i] = false;
       continue;
     }
-
     auto entity = selection->entity();
-    std::string entityType = entity->objectType();
-    LOG_INFO("  Selection " << i << " type: " << entityType);
-
-    // If it's already a profile, it's valid
-    if (entity->cast<adsk::fusion::Profile>()) {
-      LOG_INFO("  Selection " << i << " is a valid profile");
-      continue;
-    }
-
-    // If it's a curve, we need to track it to see if user selected ALL curves
-    // of a profile
-    auto sketchCurve = entity->cast<adsk::fusion::SketchCurve>();
-    if (sketchCurve) {
-      // Log parent sketch info
-      if (sketchCurve->parentSketch()) {
-        LOG_INFO("    Parent sketch: " << sketchCurve->parentSketch()->name());
-        std::string sketchId = sketchCurve->parentSketch()->entityToken();
-        curvesBySketch[sketchId].push_back(sketchCurve);
+    tokens[i] = entity->entityToken();
+    current.insert(tokens[i]);
+
+    // Entities validated by an earlier change need no Fusion lookups beyond their token
+    auto validated = validatedEntities_.find(tokens[i]);
+    if (validated == validatedEntities_.end()) {
+      ValidatedEntity kind;
+      auto sketchCurve = entity->cast<adsk::fusion::SketchCurve>();
+      if (entity->cast<adsk::fusion::Profile>()) {
+        kind.isProfile = true;
+      } else if (sketchCurve && isPartOfClosedProfile(sketchCurve)) {
+        kind.sketchToken = sketchCurve->parentSketch()->entityToken();
+        changedSketches.insert(kind.sketchToken);
+      } else {
+        LOG_DEBUG("  Removing selection " << i << ": " << entity->objectType() << " is not a closed profile");
+        keep[i] = false;
+        continue;
       }
-
-      // Mark individual curves for removal - we'll check later if they form
-      // complete profiles
-      LOG_INFO("  Selection " << i << " is an individual curve - marking for potential removal");
-      indicesToRemove.push_back(i);
-    } else {
-      // Unknown entity type - remove it
-      LOG_INFO("  Removing selection " << i << ": Unknown entity type " << entity->objectType());
-      indicesToRemove.push_back(i);
+      validated = validatedEntities_.emplace(tokens[i], std::move(kind)).first;
+      ++added;
+    }
+    if (!validated->second.isProfile) {
+      curvesBySketch[validated->second.sketchToken].insert(tokens[i]);
     }
   }
 
-  // Check if any selected curves form complete profiles
-  for (const auto& sketchCurvePair : curvesBySketch) {
-    const auto& sketchId = sketchCurvePair.first;
-    const auto& curves = sketchCurvePair.second;
-    if (!curves.empty() && curves[0]->parentSketch()) {
-      auto sketch = curves[0]->parentSketch();
-      auto profiles = sketch->profiles();
-
-      if (profiles) {
-        // Check each profile to see if we have all its curves selected
-        for (int p = 0; p < static_cast<int>(profiles->count()); ++p) {
-          auto profile = profiles->item(p);
-          if (!profile || !profile->isValid())
-            continue;
-
-          // Only check closed profiles
-          auto areaProps = profile->areaProperties();
-          if (!areaProps || areaProps->area() <= 0)
-            continue;
-
-          // Count curves in this profile
-          int profileCurveCount = 0;
-          int matchingCurveCount = 0;
-
-          auto profileLoops = profile->profileLoops();
-          if (profileLoops) {
-            for (int l = 0; l < static_cast<int>(profileLoops->count()); ++l) {
-              auto loop = profileLoops->item(l);
-              if (!loop || !loop->isValid())
-                continue;
-
-              auto loopCurves = loop->profileCurves();
-              if (loopCurves) {
-                profileCurveCount += static_cast<int>(loopCurves->count());
-
-                // Check if our selected curves match
-                for (int c = 0; c < static_cast<int>(loopCurves->count()); ++c) {
-                  auto profileCurve = loopCurves->item(c);
-                  if (!profileCurve || !profileCurve->isValid())
-                    continue;
-                  if (profileCurve->sketchEntity()) {
-                    std::string curveToken = profileCurve->sketchEntity()->entityToken();
-
-                    // Check if this curve is in our selection
-                    for (const auto& selectedCurve : curves) {
-                      if (selectedCurve->entityToken() == curveToken) {
-                        matchingCurveCount++;
-                        break;
-                      }
-                    }
-                  }
-                }
-              }
-            }
-          }
-
-          // If we have ALL curves from this profile, remove them from
-          // indicesToRemove
-          if (matchingCurveCount == profileCurveCount && profileCurveCount > 0) {
-            LOG_INFO("  Found complete profile from " << matchingCurveCount << " selected curves");
-
-            // Remove these curves from indicesToRemove
-            for (int i = static_cast<int>(selectionInput->selectionCount()) - 1; i >= 0; --i) {
-              auto selection = selectionInput->selection(i);
-              if (selection && selection->entity()) {
-                auto entity = selection->entity();
-                auto curve = entity->cast<adsk::fusion::SketchCurve>();
-                if (curve && curve->parentSketch() && curve->parentSketch()->entityToken() == sketchId) {
-                  // This curve is part of the complete profile - remove from
-                  // removal list
-                  indicesToRemove.erase(std::remove(indicesToRemove.begin(), indicesToRemove.end(), i),
-                                        indicesToRemove.end());
-                }
-              }
-            }
-          }
-        }
-      }
+  // Deselected entities; a deselected curve may leave its profile incomplete
+  size_t removed = 0;
+  for (auto it = validatedEntities_.begin(); it != validatedEntities_.end();) {
+    if (current.count(it->first) > 0) {
+      ++it;
+      continue;
+    }
+    if (!it->second.isProfile) {
+      changedSketches.insert(it->second.sketchToken);
     }
+    it = validatedEntities_.erase(it);
+    ++removed;
   }
 
-  // If we have invalid selections, we need to rebuild the selection list
-  if (!indicesToRemove.empty()) {
-    // Collect all valid selections first
-    std::vector<adsk::core::Ptr<adsk::core::Base>> validSelections;
-
-    for (int i = 0; i < static_cast<int>(selectionInput->selectionCount()); ++i) {
-      // Skip if this index is marked for removal
-      bool shouldRemove = false;
-      for (int removeIdx : indicesToRemove) {
-        if (i == removeIdx) {
-          shouldRemove = true;
-          break;
-        }
+  // Individual curves stay only while together they make up a whole closed profile
+  for (const auto& sketchToken : changedSketches) {
+    auto& complete = completeCurvesBySketch_[sketchToken];
+    complete.clear();
+    const auto& selected = curvesBySketch[sketchToken];
+    auto index = sketchProfileIndices_.find(sketchToken);
+    if (index == sketchProfileIndices_.end()) {
+      continue;
+    }
+    for (const auto& profileCurves : index->second.closedProfileCurves) {
+      bool whole = true;
+      for (const auto& curve : profileCurves) {
+        whole = whole && selected.count(curve) > 0;
       }
-
-      if (!shouldRemove) {
-        auto selection = selectionInput->selection(i);
-        if (selection && selection->entity()) {
-          validSelections.push_back(selection->entity());
-        }
+      if (whole) {
+        complete.insert(profileCurves.begin(), profileCurves.end());
+        LOG_INFO("  Found complete profile from " << profileCurves.size() << " selected curves");
       }
     }
+  }
 
-    // Clear all selections and re-add only valid ones
-    selectionInput->clearSelection();
-
-    for (auto& validEntity : validSelections) {
-      selectionInput->addSelection(validEntity);
+  size_t invalidCount = 0;
+  for (int i = 0; i < count; ++i) {
+    if (keep[i]) {
+      const ValidatedEntity& validated = validatedEntities_.at(tokens[i]);
+      keep[i] = validated.isProfile || completeCurvesBySketch_[validated.sketchToken].count(tokens[i]) > 0;
     }
+    if (!keep[i]) {
+      ++invalidCount;
+      // Dropped curves are validated again if selected again, against the profiles selected by then
+      validatedEntities_.erase(tokens[i]);
+    }
+  }
 
-    LOG_INFO("Removed " << indicesToRemove.size() << " invalid selections. " << validSelections.size()
-                        << " valid selections remain.");
+  LOG_DEBUG("Validated selection of " << count << ": " << added << " added, " << removed << " removed, "
+                                      << invalidCount << " invalid");
+  if (invalidCount == 0) {
+    if (pluginManager()) {
+      pluginManager()->reportSelectionCount(count);
+    }
+    return;
   }
 
-  // Optional: Log a warning if user selected curves that don't form complete
-  // profiles
-  for (const auto& sketchCurvePair : curvesBySketch) {
-    const auto& curves = sketchCurvePair.second;
-    if (!curves.empty() && curves[0]->parentSketch()) {
-      auto sketch = curves[0]->parentSketch();
-      LOG_INFO("Sketch '" << sketch->name() << "' has " << curves.size() << " selected curves from closed profiles");
+  // Rebuild the selection list with only the valid entities
+  std::vector<adsk::core::Ptr<adsk::core::Base>> validSelections;
+  for (int i = 0; i < count; ++i) {
+    if (keep[i]) {
+      validSelections.push_back(selectionInput->selection(i)->entity());
     }
   }
+  selectionInput->clearSelection();
+  for (auto& validEntity : validSelections) {
+    selectionInput->addSelection(validEntity);
+  }
+  LOG_INFO("Removed " << invalidCount << " invalid selections. " << validSelections.size()
+                      << " valid selections remain.");
+  if (pluginManager()) {
+    pluginManager()->reportSelectionCount(static_cast<int>(validSelections.size()));
+  }
 }
 
 }  // namespace Commands
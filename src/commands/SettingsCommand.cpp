@@ -7,12 +7,23 @@
 
 #include "SettingsCommand.h"
 
+#include "core/PerformanceSettings.h"
 #include "core/PluginManager.h"
+#include "utils/PlatformTrace.h"
+#include "utils/UnitConversion.h"
 #include "utils/logging.h"
 
 namespace ChipCarving {
 namespace Commands {
 
+namespace {
+
+// Dropdown labels, in PerformanceSettings::SurfaceQuery order
+const char* const SURFACE_QUERY_LABELS[] = {"Ray Casting", "Heightfield Grid", "Surface Evaluator"};
+const char* const POLYLINE_OUTPUT_LABEL = "Lines and Arcs";
+
+}  // namespace
+
 SettingsCommandHandler::SettingsCommandHandler(std::shared_ptr<Core::PluginManager> pluginManager)
     : pluginManager_(std::move(pluginManager)) {}
 
@@ -31,6 +42,10 @@ void SettingsCommandHandler::notify(const adsk::core::Ptr<adsk::core::CommandCre
   if (!eventArgs || !pluginManager_) {
     return;
   }
+  // The dialog shows the settings file, which the plugin manager reads when it first initializes
+  if (!pluginManager_->initialize()) {
+    return;
+  }
 
   adsk::core::Ptr<adsk::core::Command> cmd = eventArgs->command();
   if (!cmd) {
@@ -44,7 +59,7 @@ void SettingsCommandHandler::notify(const adsk::core::Ptr<adsk::core::CommandCre
   cmd->isRepeatable(false);
 
   // Set dialog size
-  cmd->setDialogInitialSize(400, 300);
+  cmd->setDialogInitialSize(400, 640);
   cmd->setDialogMinimumSize(350, 250);
 
   // Create command inputs
@@ -107,6 +122,85 @@ void SettingsCommandHandler::createSettingsInputs(const adsk::core::Ptr<adsk::co
                                             "Note: This setting applies immediately and persists for the "
                                             "current session only.",
                                             1, true);
+
+  // Diagnostics Settings Group
+  adsk::core::Ptr<adsk::core::GroupCommandInput> diagnosticsGroup =
+      inputs->addGroupCommandInput("diagnosticsGroup", "Diagnostics");
+  diagnosticsGroup->isExpanded(true);
+  diagnosticsGroup->isEnabledCheckBoxDisplayed(false);
+  adsk::core::Ptr<adsk::core::CommandInputs> diagnosticsInputs = diagnosticsGroup->children();
+
+  adsk::core::Ptr<adsk::core::BoolValueCommandInput> chromeTraceCheckbox = diagnosticsInputs->addBoolValueInput(
+      "writeChromeTrace", "Write Chrome trace for Generate Paths", true, "", pluginManager_->isChromeTraceEnabled());
+  chromeTraceCheckbox->tooltip("When enabled, each Generate Paths run writes a chip_carving_trace_*.json file next "
+                               "to the log, with per-thread stage timings and counters for Voronoi points, splines "
+                               "and surface queries.\n"
+                               "Open it in ui.perfetto.dev or chrome://tracing.\n"
+                               "Default: disabled");
+
+  std::string backend = Utils::platformTraceBackend();
+  adsk::core::Ptr<adsk::core::BoolValueCommandInput> platformTraceCheckbox = diagnosticsInputs->addBoolValueInput(
+      "platformTrace", "Annotate stages for native profiler (" + backend + ")", true, "",
+      pluginManager_->getPerformanceSettings().platformTrace);
+  platformTraceCheckbox->tooltip("When enabled, each traced stage is also reported to the platform profiler as a "
+                                 "named interval: os_signpost for Instruments on macOS, ETW for WPA or PerfView on "
+                                 "Windows, or Intel ITT for VTune in builds with CHIP_CARVING_ITT.\n"
+                                 "Leave disabled unless a profiler is attached.\n"
+                                 "Default: disabled");
+  platformTraceCheckbox->isEnabled(backend != "none");
+
+  createPerformanceInputs(inputs);
+}
+
+void SettingsCommandHandler::createPerformanceInputs(const adsk::core::Ptr<adsk::core::CommandInputs>& inputs) {
+  const Core::PerformanceSettings& settings = pluginManager_->getPerformanceSettings();
+
+  adsk::core::Ptr<adsk::core::GroupCommandInput> performanceGroup =
+      inputs->addGroupCommandInput("performanceGroup", "Performance");
+  performanceGroup->isExpanded(true);
+  performanceGroup->isEnabledCheckBoxDisplayed(false);
+  adsk::core::Ptr<adsk::core::CommandInputs> performanceInputs = performanceGroup->children();
+
+  performanceInputs
+      ->addIntegerSpinnerCommandInput("medialAxisWorkers", "Worker Threads", 0, 256, 1, settings.medialAxisWorkers)
+      ->tooltip("Threads for medial axis and V-carve computation (0 = one per CPU core, 1 = sequential)");
+  performanceInputs
+      ->addIntegerSpinnerCommandInput("medialCacheMb", "Medial Axis Cache (MB)", 0, 65536, 16, settings.medialCacheMb)
+      ->tooltip("Memory for medial axis results reused by later Generate Paths runs in this session (0 = none)");
+  performanceInputs->addStringValueInput("diskCacheDirectory", "Disk Cache Folder", settings.diskCacheDirectory)
+      ->tooltip("Folder where medial axis results persist across sessions (empty = no disk cache)");
+  performanceInputs
+      ->addIntegerSpinnerCommandInput("diskCacheMb", "Disk Cache Size (MB)", 0, 1048576, 64, settings.diskCacheMb)
+      ->tooltip("Oldest disk cache entries are deleted when the folder grows past this size; checked at startup "
+                "and on Apply (0 = unlimited)");
+  performanceInputs->addBoolValueInput("diskCacheShared", "Shared Disk Cache", true, "", settings.diskCacheShared)
+      ->tooltip("The disk cache folder is a network share the whole team uses: results computed on one machine "
+                "are reused on the others, and V-carve checkpoints stay on this machine");
+
+  adsk::core::Ptr<adsk::core::DropDownCommandInput> surfaceQuery = performanceInputs->addDropDownCommandInput(
+      "surfaceQuery", "Surface Queries", adsk::core::DropDownStyles::TextListDropDownStyle);
+  for (size_t i = 0; i < sizeof(SURFACE_QUERY_LABELS) / sizeof(SURFACE_QUERY_LABELS[0]); ++i) {
+    surfaceQuery->listItems()->add(SURFACE_QUERY_LABELS[i], static_cast<size_t>(settings.surfaceQuery) == i);
+  }
+  surfaceQuery->tooltip("How V-carve points find the target surface: ray casts only, a height grid sampled once "
+                        "per run, or the face's surface evaluator with ray casts as fallback");
+
+  // FIXED UNITS - Fusion 360 internal units are cm
+  performanceInputs
+      ->addValueInput("heightfieldResolution", "Heightfield Resolution", "mm",
+                      adsk::core::ValueInput::createByReal(Utils::mmToFusionLength(settings.heightfieldResolution)))
+      ->tooltip("Default surface grid spacing with Heightfield Grid queries (Generate Paths can override it)");
+
+  adsk::core::Ptr<adsk::core::DropDownCommandInput> outputMode = performanceInputs->addDropDownCommandInput(
+      "toolpathOutputMode", "Toolpath Curves", adsk::core::DropDownStyles::TextListDropDownStyle);
+  outputMode->listItems()->add("Fitted Splines", !settings.outputPolylines);
+  outputMode->listItems()->add(POLYLINE_OUTPUT_LABEL, settings.outputPolylines);
+  outputMode->tooltip("Default toolpath curve type for Generate Paths (lines and arcs are much faster to create)");
+
+  performanceInputs->addTextBoxCommandInput("performanceInfo", "",
+                                            "Note: Performance settings are saved and apply to the next Generate "
+                                            "Paths run.",
+                                            1, true);
 }
 
 void SettingsCommandHandler::applySettings(const adsk::core::Ptr<adsk::core::CommandInputs>& inputs) {
@@ -130,6 +224,53 @@ void SettingsCommandHandler::applySettings(const adsk::core::Ptr<adsk::core::Com
       LOG_WARNING("Log level set to WARNING (INFO and DEBUG messages hidden)");
     }
   }
+
+  Core::PerformanceSettings settings = pluginManager_->getPerformanceSettings();
+  adsk::core::Ptr<adsk::core::BoolValueCommandInput> chromeTraceCheckbox = inputs->itemById("writeChromeTrace");
+  if (chromeTraceCheckbox) {
+    settings.writeChromeTrace = chromeTraceCheckbox->value();
+  }
+  adsk::core::Ptr<adsk::core::BoolValueCommandInput> platformTraceCheckbox = inputs->itemById("platformTrace");
+  if (platformTraceCheckbox) {
+    settings.platformTrace = platformTraceCheckbox->value();
+  }
+  adsk::core::Ptr<adsk::core::IntegerSpinnerCommandInput> workers = inputs->itemById("medialAxisWorkers");
+  if (workers) {
+    settings.medialAxisWorkers = workers->value();
+  }
+  adsk::core::Ptr<adsk::core::IntegerSpinnerCommandInput> medialCacheMb = inputs->itemById("medialCacheMb");
+  if (medialCacheMb) {
+    settings.medialCacheMb = medialCacheMb->value();
+  }
+  adsk::core::Ptr<adsk::core::StringValueCommandInput> diskCacheDirectory = inputs->itemById("diskCacheDirectory");
+  if (diskCacheDirectory) {
+    settings.diskCacheDirectory = diskCacheDirectory->value();
+  }
+  adsk::core::Ptr<adsk::core::IntegerSpinnerCommandInput> diskCacheMb = inputs->itemById("diskCacheMb");
+  if (diskCacheMb) {
+    settings.diskCacheMb = diskCacheMb->value();
+  }
+  adsk::core::Ptr<adsk::core::BoolValueCommandInput> diskCacheShared = inputs->itemById("diskCacheShared");
+  if (diskCacheShared) {
+    settings.diskCacheShared = diskCacheShared->value();
+  }
+  adsk::core::Ptr<adsk::core::DropDownCommandInput> surfaceQuery = inputs->itemById("surfaceQuery");
+  if (surfaceQuery && surfaceQuery->selectedItem()) {
+    settings.surfaceQuery = static_cast<Core::PerformanceSettings::SurfaceQuery>(surfaceQuery->selectedItem()->index());
+  }
+  adsk::core::Ptr<adsk::core::ValueCommandInput> heightfieldResolution = inputs->itemById("heightfieldResolution");
+  if (heightfieldResolution) {
+    // Convert from Fusion's database units (cm) to mm
+    settings.heightfieldResolution = Utils::fusionLengthToMm(heightfieldResolution->value());
+  }
+  adsk::core::Ptr<adsk::core::DropDownCommandInput> outputMode = inputs->itemById("toolpathOutputMode");
+  if (outputMode && outputMode->selectedItem()) {
+    settings.outputPolylines = outputMode->selectedItem()->name() == POLYLINE_OUTPUT_LABEL;
+  }
+
+  if (!pluginManager_->setPerformanceSettings(settings)) {
+    LOG_WARNING("Performance settings were not saved");
+  }
 }
 
 }  // namespace Commands
@@ -45,6 +45,11 @@ class SettingsCommandHandler : public adsk::core::CommandCreatedEventHandler {
    */
   void createSettingsInputs(const adsk::core::Ptr<adsk::core::CommandInputs>& inputs);
 
+  /**
+   * Creates the performance group from the plugin manager's saved performance settings
+   */
+  void createPerformanceInputs(const adsk::core::Ptr<adsk::core::CommandInputs>& inputs);
+
   /**
    * Applies settings from the dialog inputs
    */
@@ -0,0 +1,113 @@
+/**
+ * DesignWatch.cpp
+ *
+ * Polling watcher for the last imported design file
+ */
+
+#include "DesignWatch.h"
+
+#include <sys/stat.h>
+
+#include <exception>
+#include <set>
+#include <utility>
+
+#include "utils/logging.h"
+
+namespace ChipCarving {
+namespace Core {
+
+constexpr int DesignWatch::DEFAULT_POLL_MS;
+
+DesignWatch::FileStamp DesignWatch::stampFile(const std::string& path) {
+  FileStamp stamp;
+  struct stat info {};
+  if (::stat(path.c_str(), &info) == 0) {
+    stamp.exists = true;
+    stamp.size = static_cast<uint64_t>(info.st_size);
+    stamp.modified = static_cast<int64_t>(info.st_mtime);
+  }
+  return stamp;
+}
+
+void recordWatchedGeneration(WatchedGeneration& generation, const Adapters::SketchSelection& selection,
+                             const Adapters::MedialAxisParameters& params) {
+  generation.params = params;
+  generation.sketchNames.clear();
+  std::set<std::string> seen;
+  for (const auto& profile : selection.selectedProfiles) {
+    if (!profile.sketchName.empty() && seen.insert(profile.sketchName).second) {
+      generation.sketchNames.push_back(profile.sketchName);
+    }
+  }
+}
+
+DesignWatch::DesignWatch(std::string filePath, Adapters::IUserInterface* ui, int pollMs)
+    : filePath_(std::move(filePath)), ui_(ui), pollMs_(pollMs) {
+  // Stamped here, not on the worker, so a save straight after enabling the watch still counts as a change
+  FileStamp applied = stampFile(filePath_);
+  worker_ = std::thread([this, applied]() { run(applied); });
+}
+
+DesignWatch::~DesignWatch() {
+  progress_.cancel();
+  if (worker_.joinable()) {
+    worker_.join();
+  }
+}
+
+bool DesignWatch::takeChange(Parsers::DesignFile& design, std::string& errorMessage) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  if (!changed_) {
+    return false;
+  }
+  changed_ = false;
+  design = std::move(design_);
+  design_ = Parsers::DesignFile();
+  errorMessage = std::move(errorMessage_);
+  errorMessage_.clear();
+  return true;
+}
+
+void DesignWatch::run(FileStamp applied) {
+  SetThreadConsoleLoggingSuppressed(true);
+  while (progress_.waitUnlessCancelled(pollMs_)) {
+    FileStamp stamp = stampFile(filePath_);
+    // A missing file is mid-save (editors often write a copy and rename it over the original)
+    if (!stamp.exists || stamp == applied) {
+      continue;
+    }
+    // Parse once a whole poll has passed without further writes
+    if (!progress_.waitUnlessCancelled(pollMs_)) {
+      break;
+    }
+    if (stampFile(filePath_) != stamp) {
+      continue;
+    }
+    applied = stamp;
+
+    Parsers::DesignFile design;
+    std::string errorMessage;
+    try {
+      Parsers::DesignParseOptions options;
+      options.deferBackgroundImageData = true;
+      design = Parsers::DesignParser::parseFromFile(filePath_, options);
+    } catch (const std::exception& e) {
+      errorMessage = e.what();
+    } catch (...) {
+      errorMessage = "Unknown parse error";
+    }
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      changed_ = true;
+      design_ = std::move(design);
+      errorMessage_ = std::move(errorMessage);
+    }
+    if (ui_) {
+      ui_->notifyMainThread();
+    }
+  }
+}
+
+}  // namespace Core
+}  // namespace ChipCarving
@@ -0,0 +1,95 @@
+/**
+ * DesignWatch.h
+ *
+ * Watch mode: a worker thread polls the last imported design file and, once
+ * a save has settled, parses it and asks the UI to call back on the main
+ * thread. PluginManager then updates the import sketch in place (see
+ * ImportDiff.h) and repeats the last Generate Paths run as an incremental
+ * background job, so only profiles of changed shapes are recomputed.
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "adapters/IFusionInterface.h"
+#include "parsers/DesignParser.h"
+#include "utils/JobProgress.h"
+
+namespace ChipCarving {
+namespace Core {
+
+// The Generate Paths run watch mode repeats after a watched design changes
+struct WatchedGeneration {
+  Adapters::MedialAxisParameters params{};
+  std::vector<std::string> sketchNames{};  // Sketches its profiles came from; empty if none was recorded
+};
+
+// Remember selection's sketches and params as the run to repeat
+void recordWatchedGeneration(WatchedGeneration& generation, const Adapters::SketchSelection& selection,
+                             const Adapters::MedialAxisParameters& params);
+
+class DesignWatch {
+ public:
+  static constexpr int DEFAULT_POLL_MS = 500;  // Also the quiet time a save must stay unchanged before parsing
+
+  /**
+   * Start watching filePath; changes are measured from its current size and modification time
+   * @param ui Notified from the worker when a parsed change is ready
+   */
+  DesignWatch(std::string filePath, Adapters::IUserInterface* ui, int pollMs = DEFAULT_POLL_MS);
+  ~DesignWatch();
+
+  DesignWatch(const DesignWatch&) = delete;
+  DesignWatch& operator=(const DesignWatch&) = delete;
+
+  const std::string& filePath() const {
+    return filePath_;
+  }
+
+  /**
+   * Take the latest parsed change (main thread); older unapplied changes are superseded
+   * @param errorMessage Set instead of design if the saved file could not be parsed
+   * @return false if there is no change to apply
+   */
+  bool takeChange(Parsers::DesignFile& design, std::string& errorMessage);
+
+ private:
+  // Size and modification time of the file; an editor's save changes at least one of them
+  struct FileStamp {
+    bool exists = false;
+    uint64_t size = 0;
+    int64_t modified = 0;
+
+    bool operator==(const FileStamp& other) const {
+      return exists == other.exists && size == other.size && modified == other.modified;
+    }
+    bool operator!=(const FileStamp& other) const {
+      return !(*this == other);
+    }
+  };
+
+  static FileStamp stampFile(const std::string& path);
+
+  // Worker loop; applied is the file as it was when the watch started
+  void run(FileStamp applied);
+
+  std::string filePath_;
+  Adapters::IUserInterface* ui_;
+  int pollMs_;
+
+  std::mutex mutex_{};
+  bool changed_ = false;
+  Parsers::DesignFile design_{};
+  std::string errorMessage_{};
+
+  Utils::JobProgress progress_{};  // Only its cancellation and wait are used, to stop the worker
+  std::thread worker_{};
+};
+
+}  // namespace Core
+}  // namespace ChipCarving
@@ -0,0 +1,169 @@
+/**
+ * GenerationJob.h
+ *
+ * State of one Generate Paths run as it moves through PluginManager's stages:
+ * extract (main thread), compute (worker threads) and write (main thread)
+ * Split from PluginManager.h for maintainability
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <fstream>
+#include <memory>
+#include <string>
+#include <thread>
+#include <unordered_set>
+#include <vector>
+
+#include "RunReport.h"
+#include "adapters/IFusionInterface.h"
+#include "geometry/GcodeWriter.h"
+#include "geometry/MedialAxisProcessor.h"
+#include "geometry/Point3D.h"
+#include "geometry/PolylineArcFitter.h"
+#include "geometry/PolylineSimplifier.h"
+#include "geometry/SurfaceHeightMemo.h"
+#include "geometry/SurfaceHeightfield.h"
+#include "geometry/ToolpathSVGExport.h"
+#include "geometry/VCarvePath.h"
+#include "utils/JobProgress.h"
+#include "utils/TraceSpan.h"
+
+namespace ChipCarving {
+namespace Core {
+
+// Pass of a progressive Generate Paths run: coarse toolpaths for every profile, then exact ones batch by batch
+enum class ProgressivePass { NONE, COARSE, REFINE };
+
+// Incremental regeneration of an earlier run's toolpath sketch (see IncrementalRegeneration.h)
+struct IncrementalState {
+  bool enabled = false;
+  std::unique_ptr<Adapters::ISketch> sketch{};     // Earlier run's toolpath sketch, reused instead of recreated
+  std::unordered_set<std::string> existingTags{};  // Tags of its curves ("" for untagged curves)
+  std::unordered_set<std::string> keptTags{};      // Unchanged profiles whose curves stay
+  std::vector<std::string> profileTags{};          // Indexed by extracted profile
+  std::vector<std::string> profileTokens{};        // Source profile entity tokens, same indexing
+
+  // Progressive refinement only (see ProgressiveRefinement in IncrementalRegeneration.h)
+  ProgressivePass pass = ProgressivePass::NONE;
+  Adapters::MedialAxisParameters otherPassParams{};  // COARSE: the exact parameters; REFINE: the coarse ones
+  size_t refineLimit = 0;                            // REFINE: profiles this batch computes at most
+  size_t coarseProfiles = 0;                         // Profiles left with coarse toolpaths by this run
+};
+
+// One Generate Paths run, handed from the extract stage (main thread) to the
+// compute stage (worker threads) to the write stage (main thread). All vectors
+// are indexed by extracted profile; a streaming pipelined run empties each
+// profile's entries once it is written.
+struct GenerationJob {
+  Adapters::MedialAxisParameters params{};
+  std::string sourcePlaneId{};
+  std::vector<std::vector<Geometry::Point2D>> profilePolygons{};
+  std::vector<std::vector<std::vector<Geometry::Point2D>>> profileHoles{};  // Inner loops of each profile
+  std::vector<Adapters::IWorkspace::TransformParams> profileTransforms{};
+  std::vector<std::string> profileSources{};  // Source profile entity tokens, for the run report
+  std::vector<uint64_t> checkpointKeys{};     // V-carve checkpoint of each profile (0 = none)
+  std::vector<double> samplingDistances{};    // Each profile's sampling distance (mm; see applyAutoTolerance)
+  std::vector<Geometry::MedialAxisResults> medialResults{};
+  std::vector<Geometry::VCarveResults> vcarveProfiles{};
+  std::vector<std::vector<Geometry::SampledMedialPath>> sampledPaths{};  // Kept for the visualization, if shared
+  std::string errorMessage{};  // Set by the compute stage if it threw
+  IncrementalState incremental{};
+  RunReport report{};  // Added to PluginManager's report of the run once written
+
+  // Preview only: the cached profiles, polygonized on the worker at the preview tolerance
+  std::vector<Adapters::ProfileGeometry> previewProfiles{};
+
+  // Background mode only
+  Utils::RunMetrics metrics{};
+  std::unique_ptr<Utils::TraceRecorder> trace{};
+  Utils::JobProgress progress{};
+  std::thread worker{};
+};
+
+// Surface sampling, fit point bookkeeping and sketch curve batches shared by the profiles of one V-carve write
+struct VCarveWriteState {
+  Geometry::SurfaceHeightfield heightfield{};
+  bool hasHeightfield = false;
+  Geometry::SurfaceHeightMemo surfaceHeights{};  // Direct surface queries, one per 1 µm XY cell
+  Geometry::PolylineSimplifier simplifier{};
+  size_t fitPointsBefore = 0;
+  size_t fitPointsRemoved = 0;
+  int totalPaths = 0;
+  std::vector<std::vector<Geometry::Point3D>> sketchPaths{};  // One profile's curves, reused across profiles
+  std::vector<std::vector<Geometry::PolylineSpan>> sketchSpans{};
+};
+
+// Sketches and streams the write stage fills profile by profile. Sketches are
+// created at the first profile that needs them; bulk edits are declared after
+// their sketch so they end (and the sketch solves) before it is released.
+struct GenerationOutput {
+  std::unique_ptr<Adapters::OutputSession> outputSession{};  // Opened by the first sketch, closed last
+  std::unique_ptr<Adapters::ISketch> constructionSketch{};
+  std::unique_ptr<Adapters::SketchBulkEdit> visualizationEdit{};
+  std::unique_ptr<Adapters::ICustomGraphics> visualizationGraphics{};  // Instead of constructionSketch
+
+  bool vcarveOpened = false;
+  std::unique_ptr<Adapters::ISketch> vcarveSketch{};
+  std::unique_ptr<Adapters::SketchBulkEdit> vcarveEdit{};
+  size_t vcarveShard = 0;    // Index of vcarveSketch among the run's toolpath sketches
+  int vcarveShardPaths = 0;  // Paths written to vcarveSketch
+  std::ofstream gcodeFile{};
+  std::unique_ptr<Geometry::GcodeWriter> gcode{};
+  VCarveWriteState vcarve{};
+
+  bool reviewOpened = false;
+  std::unique_ptr<Geometry::ToolpathSVGExporter> reviewSvg{};  // Streamed profile by profile
+
+  int successCount = 0;
+  int totalPoints = 0;
+  double totalLength = 0.0;
+};
+
+// Add one computed profile's medial axis to job.report
+void reportProfileMedialAxis(GenerationJob& job, size_t index, const Geometry::MedialAxisResults& results);
+
+// Apply the polygon tolerance, input simplification, partitioning, spur pruning and clearing offsets
+// Generate Paths runs with
+void configureGenerationProcessor(Geometry::MedialAxisProcessor& processor,
+                                  const Adapters::MedialAxisParameters& params);
+
+// Whether the V-carve stage samples exactly what the medial line visualization draws, so it can keep them
+bool sharesSampledPaths(const Adapters::MedialAxisParameters& params);
+
+// The spur pruning thresholds of params, converted from mm to Fusion units (cm)
+Geometry::SpurPruningOptions spurPruningOptions(const Adapters::MedialAxisParameters& params);
+
+/**
+ * A cached profile's outer loop: its vertices as they are, or its exact curves
+ * polygonized to curveTolerance (cm). Generate Paths, the preview and the
+ * speculative medial axes all build their polygons here, so cache keys agree.
+ */
+std::vector<Geometry::Point2D> cachedProfileOutline(const Adapters::ProfileGeometry& profile, double curveTolerance);
+
+/**
+ * Split a selection into its output groups: profiles on the same sketch plane in
+ * the same component, in order of first appearance. A selection without cached
+ * profile geometry (no plane to group by) is one group.
+ */
+std::vector<Adapters::SketchSelection> groupSelectionByOutput(const Adapters::SketchSelection& selection);
+
+// "paths.nc" -> "paths-60_V-bit.nc", so runs sharing an export path write separate files
+std::string suffixedExportPath(const std::string& path, const std::string& label);
+
+/**
+ * With params.autoTolerance, simplify a profile's loops (cm) to the tolerance
+ * chosen for them (see ProfileTolerance.h)
+ * @return The profile's sampling distance (mm): its own, or params.samplingDistance
+ */
+double applyAutoTolerance(const Adapters::MedialAxisParameters& params, std::vector<Geometry::Point2D>& polygon,
+                          std::vector<std::vector<Geometry::Point2D>>& holes);
+
+// A cached profile's holes with at least 3 vertices, built the same way
+std::vector<std::vector<Geometry::Point2D>> cachedProfileHoles(const Adapters::ProfileGeometry& profile,
+                                                               double curveTolerance);
+
+}  // namespace Core
+}  // namespace ChipCarving
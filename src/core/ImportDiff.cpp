@@ -0,0 +1,108 @@
+/**
+ * ImportDiff.cpp
+ *
+ * Shape tags and update plans for updating re-imports
+ */
+
+#include "ImportDiff.h"
+
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <set>
+#include <unordered_map>
+
+namespace ChipCarving {
+namespace Core {
+
+namespace {
+
+constexpr uint64_t FNV_OFFSET_BASIS = 14695981039346656037ULL;
+constexpr uint64_t FNV_PRIME = 1099511628211ULL;
+
+void hashDouble(uint64_t& hash, double value) {
+  // -0.0 and 0.0 describe the same geometry
+  if (value == 0.0) {
+    value = 0.0;
+  }
+  unsigned char bytes[sizeof(value)];
+  std::memcpy(bytes, &value, sizeof(value));
+  for (unsigned char byte : bytes) {
+    hash ^= byte;
+    hash *= FNV_PRIME;
+  }
+}
+
+void hashPoint(uint64_t& hash, const Geometry::Point2D& point) {
+  hashDouble(hash, point.x);
+  hashDouble(hash, point.y);
+}
+
+// The drawn outline, or the vertices of a shape that draws itself
+std::string shapeTag(const Geometry::Shape& shape) {
+  uint64_t hash = FNV_OFFSET_BASIS;
+  for (const auto& edge : shape.getBoundaryEdges()) {
+    hashPoint(hash, edge.start);
+    hashPoint(hash, edge.end);
+    hashDouble(hash, edge.isArc ? 1.0 : 0.0);
+    if (edge.isArc) {
+      hashPoint(hash, edge.mid);
+    }
+  }
+  for (const auto& vertex : shape.getVertices()) {
+    hashPoint(hash, vertex);
+  }
+
+  char tag[17];
+  std::snprintf(tag, sizeof(tag), "%016llx", static_cast<unsigned long long>(hash));
+  return tag;
+}
+
+}  // namespace
+
+std::vector<std::string> importedShapeTags(const Geometry::ShapeStore& shapes, size_t first, size_t last) {
+  std::vector<std::string> tags;
+  std::unordered_map<std::string, size_t> repeats;
+  for (size_t i = first; i < last && i < shapes.size(); ++i) {
+    std::string tag = shapeTag(shapes.at(i));
+    size_t repeat = ++repeats[tag];
+    tags.push_back(repeat == 1 ? tag : tag + "-" + std::to_string(repeat));
+  }
+  return tags;
+}
+
+std::string importSketchName(const std::vector<std::string>& filePaths, size_t index) {
+  if (filePaths.size() < 2) {
+    return "Imported Design";
+  }
+  size_t slash = filePaths[index].find_last_of("/\\");
+  std::string stem = slash == std::string::npos ? filePaths[index] : filePaths[index].substr(slash + 1);
+  size_t dot = stem.find_last_of('.');
+  return "Imported Design - " + (dot == std::string::npos || dot == 0 ? stem : stem.substr(0, dot));
+}
+
+ImportUpdate planImportUpdate(const std::vector<std::string>& shapeTags, const std::vector<std::string>& sketchTags) {
+  ImportUpdate update;
+  std::set<std::string> existing(sketchTags.begin(), sketchTags.end());
+  std::set<std::string> wanted;
+  for (size_t i = 0; i < shapeTags.size(); ++i) {
+    if (shapeTags[i].empty()) {
+      continue;
+    }
+    wanted.insert(shapeTags[i]);
+    if (existing.count(shapeTags[i]) > 0) {
+      ++update.keptShapes;
+    } else {
+      update.drawShapes.push_back(i);
+    }
+  }
+  for (const auto& tag : existing) {
+    if (wanted.count(tag) == 0) {
+      update.staleTags.push_back(tag);
+    }
+  }
+  return update;
+}
+
+}  // namespace Core
+}  // namespace ChipCarving
@@ -0,0 +1,40 @@
+/**
+ * ImportDiff.h
+ *
+ * Updating re-import: every curve of an imported design's sketch carries a
+ * tag hashing the outline of the shape it was drawn from. Re-importing the
+ * same file draws only shapes whose tag is missing from the sketch, deletes
+ * the curves of tags the file no longer produces (and untagged curves) and
+ * leaves the rest of the sketch in place.
+ */
+
+#pragma once
+
+#include <string>
+#include <vector>
+
+#include "geometry/ShapeStore.h"
+
+namespace ChipCarving {
+namespace Core {
+
+// "Imported Design" for a single file, "Imported Design - leaves" for each of several
+std::string importSketchName(const std::vector<std::string>& filePaths, size_t index);
+
+/**
+ * Tags of shapes [first, last): a hash of each outline (16 hex digits), with
+ * "-2", "-3", ... appended to repeats of an identical shape
+ */
+std::vector<std::string> importedShapeTags(const Geometry::ShapeStore& shapes, size_t first, size_t last);
+
+struct ImportUpdate {
+  std::vector<size_t> drawShapes{};     // Indices into the shape tags of shapes that must be drawn
+  std::vector<std::string> staleTags{};  // Tags in the sketch whose curves must be deleted
+  size_t keptShapes = 0;
+};
+
+// Compare the shape tags of a re-import with the tags of the sketch it updates
+ImportUpdate planImportUpdate(const std::vector<std::string>& shapeTags, const std::vector<std::string>& sketchTags);
+
+}  // namespace Core
+}  // namespace ChipCarving
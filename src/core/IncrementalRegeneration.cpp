@@ -0,0 +1,232 @@
+/**
+ * IncrementalRegeneration.cpp
+ *
+ * Profile tags and stale curve removal for incremental Generate Paths
+ */
+
+#include "IncrementalRegeneration.h"
+
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <utility>
+
+#include "utils/logging.h"
+
+namespace ChipCarving {
+namespace Core {
+
+namespace {
+
+constexpr uint64_t FNV_OFFSET_BASIS = 14695981039346656037ULL;
+constexpr uint64_t FNV_PRIME = 1099511628211ULL;
+
+// Polygon tolerance and sampling distance multiplier of a progressive run's coarse pass
+constexpr double COARSE_PASS_COARSENING = 4.0;
+
+void hashBytes(uint64_t& hash, const void* data, size_t size) {
+  const auto* bytes = static_cast<const unsigned char*>(data);
+  for (size_t i = 0; i < size; ++i) {
+    hash ^= bytes[i];
+    hash *= FNV_PRIME;
+  }
+}
+
+void hashDouble(uint64_t& hash, double value) {
+  // -0.0 and 0.0 describe the same geometry
+  if (value == 0.0) {
+    value = 0.0;
+  }
+  uint64_t bits = 0;
+  std::memcpy(&bits, &value, sizeof(bits));
+  hashBytes(hash, &bits, sizeof(bits));
+}
+
+void hashInt(uint64_t& hash, int64_t value) {
+  hashBytes(hash, &value, sizeof(value));
+}
+
+void hashLoop(uint64_t& hash, const std::vector<Geometry::Point2D>& loop) {
+  hashInt(hash, static_cast<int64_t>(loop.size()));
+  for (const auto& point : loop) {
+    hashDouble(hash, point.x);
+    hashDouble(hash, point.y);
+  }
+}
+
+}  // namespace
+
+std::string toolpathSketchName(const Adapters::MedialAxisParameters& params, size_t shard) {
+  std::string name = "V-Carve Toolpaths - " + params.toolName;
+  return shard == 0 ? name : name + " (" + std::to_string(shard + 1) + ")";
+}
+
+bool canRegenerateIncrementally(const Adapters::MedialAxisParameters& params) {
+  return params.incrementalRegeneration && params.generateVCarveToolpaths && params.gcodeExportPath.empty() &&
+         params.svgExportPath.empty() && !params.generateVisualization && params.toolpathSketchPathLimit <= 0 &&
+         !params.outputToBaseFeature;
+}
+
+constexpr size_t ProgressiveRefinement::BATCHES;
+
+bool canRefineProgressively(const Adapters::MedialAxisParameters& params) {
+  Adapters::MedialAxisParameters incremental = params;
+  incremental.incrementalRegeneration = true;
+  return params.progressiveRefinement && canRegenerateIncrementally(incremental);
+}
+
+Adapters::MedialAxisParameters coarseToolpathParameters(const Adapters::MedialAxisParameters& params) {
+  Adapters::MedialAxisParameters coarse = params;
+  coarse.polygonTolerance *= COARSE_PASS_COARSENING;
+  coarse.samplingDistance *= COARSE_PASS_COARSENING;
+  coarse.adaptiveSampling = false;
+  return coarse;
+}
+
+std::string profileToolpathTag(const std::vector<Geometry::Point2D>& polygon,
+                               const std::vector<std::vector<Geometry::Point2D>>& holes,
+                               const Adapters::IWorkspace::TransformParams& transform,
+                               const Adapters::MedialAxisParameters& params) {
+  uint64_t hash = FNV_OFFSET_BASIS;
+  hashLoop(hash, polygon);
+  hashInt(hash, static_cast<int64_t>(holes.size()));
+  for (const auto& hole : holes) {
+    hashLoop(hash, hole);
+  }
+  hashDouble(hash, transform.sketchPlaneZ);
+
+  // Everything between the outline and the sketch curves; the tool name is the sketch's
+  hashDouble(hash, params.polygonTolerance);
+  hashDouble(hash, params.samplingDistance);
+  hashDouble(hash, params.spurPruneLength);
+  hashDouble(hash, params.spurPruneClearance);
+  hashInt(hash, params.adaptiveSampling);
+  hashDouble(hash, params.samplingChordTolerance);
+  hashInt(hash, params.exactSampling);
+  hashInt(hash, params.autoTolerance);
+  hashDouble(hash, params.autoDepthError);
+  hashDouble(hash, params.autoToleranceMin);
+  hashDouble(hash, params.autoToleranceMax);
+  hashDouble(hash, params.autoSamplingMin);
+  hashDouble(hash, params.autoSamplingMax);
+  hashInt(hash, params.forceBoundaryIntersections);
+  hashDouble(hash, params.toolAngle);
+  hashDouble(hash, params.toolDiameter);
+  hashInt(hash, static_cast<int64_t>(params.toolShape));
+  hashDouble(hash, params.toolTipDiameter);
+  hashDouble(hash, params.maxVCarveDepth);
+  hashDouble(hash, params.stepDownDepth);
+  hashDouble(hash, params.clearingStepover);
+  hashDouble(hash, params.pathMergeTolerance);
+  hashInt(hash, params.minimizeRetracts);
+  hashInt(hash, params.orderToolpaths);
+  hashInt(hash, params.allowPathReversal);
+  hashDouble(hash, params.pathSimplifyTolerance);
+  hashInt(hash, params.outputPolylines);
+  hashBytes(hash, params.targetSurfaceId.data(), params.targetSurfaceId.size());
+  hashInt(hash, params.projectToSurface);
+  hashDouble(hash, params.surfaceGridResolution);
+  hashBytes(hash, params.surfaceScanPath.data(), params.surfaceScanPath.size());
+  hashDouble(hash, params.surfaceScanOriginX);
+  hashDouble(hash, params.surfaceScanOriginY);
+  hashDouble(hash, params.surfaceScanPixelSize);
+  hashDouble(hash, params.surfaceScanHeightRange);
+  hashDouble(hash, params.surfaceScanZOffset);
+  hashInt(hash, params.useFaceEvaluator);
+  hashInt(hash, params.surfaceSlopeCompensation);
+  hashInt(hash, params.useAnalyticMedialAxis);
+  hashInt(hash, params.useStraightSkeleton);
+  hashInt(hash, params.medialAxisPartitionVertices);
+  hashInt(hash, params.detectSymmetry);
+
+  char tag[17];
+  std::snprintf(tag, sizeof(tag), "%016llx", static_cast<unsigned long long>(hash));
+  return tag;
+}
+
+std::string profileSourceToken(const Adapters::SketchSelection& selection, size_t index) {
+  return index < selection.selectedEntityIds.size() ? selection.selectedEntityIds[index] : std::string();
+}
+
+void beginIncrementalRegeneration(Adapters::IWorkspace* workspace, GenerationJob& job) {
+  // The pass of a progressive run is set up by the caller
+  IncrementalState& state = job.incremental;
+  IncrementalState fresh;
+  fresh.pass = state.pass;
+  fresh.otherPassParams = std::move(state.otherPassParams);
+  fresh.refineLimit = state.refineLimit;
+  state = std::move(fresh);
+  if (!job.params.incrementalRegeneration) {
+    return;
+  }
+  if (!canRegenerateIncrementally(job.params)) {
+    LOG_INFO("Incremental regeneration needs V-carve toolpaths without G-code export or visualization; "
+             "regenerating every profile");
+    return;
+  }
+
+  state.enabled = true;
+  state.sketch = workspace->findSketch(toolpathSketchName(job.params));
+  if (!state.sketch) {
+    LOG_INFO("Incremental regeneration: no earlier toolpath sketch, regenerating every profile");
+    return;
+  }
+  for (const auto& tag : state.sketch->getCurveTags()) {
+    state.existingTags.insert(tag);
+  }
+  LOG_INFO("Incremental regeneration: earlier toolpath sketch holds " << state.existingTags.size()
+                                                                      << " profile tags");
+}
+
+bool admitIncrementalProfile(GenerationJob& job, const std::vector<Geometry::Point2D>& polygon,
+                             const std::vector<std::vector<Geometry::Point2D>>& holes,
+                             const Adapters::IWorkspace::TransformParams& transform, const std::string& sourceToken) {
+  IncrementalState& state = job.incremental;
+  if (!state.enabled) {
+    return true;
+  }
+
+  std::string tag = profileToolpathTag(polygon, holes, transform, job.params);
+  if (state.existingTags.count(tag) > 0) {
+    state.keptTags.insert(tag);
+    state.coarseProfiles += state.pass == ProgressivePass::COARSE ? 1 : 0;
+    return false;
+  }
+  if (state.pass == ProgressivePass::COARSE) {
+    // An earlier progressive run refined this profile already
+    std::string exactTag = profileToolpathTag(polygon, holes, transform, state.otherPassParams);
+    if (state.existingTags.count(exactTag) > 0) {
+      state.keptTags.insert(exactTag);
+      return false;
+    }
+    ++state.coarseProfiles;
+  } else if (state.pass == ProgressivePass::REFINE && state.profileTags.size() >= state.refineLimit) {
+    // Left for a later batch
+    state.keptTags.insert(profileToolpathTag(polygon, holes, transform, state.otherPassParams));
+    ++state.coarseProfiles;
+    return false;
+  }
+  state.profileTags.push_back(tag);
+  state.profileTokens.push_back(sourceToken);
+  return true;
+}
+
+void removeStaleToolpaths(GenerationJob& job, Adapters::ISketch* sketch) {
+  IncrementalState& state = job.incremental;
+  if (!state.enabled || !sketch) {
+    return;
+  }
+
+  int removed = 0;
+  for (const auto& tag : state.existingTags) {
+    if (state.keptTags.count(tag) == 0) {
+      removed += sketch->deleteCurvesWithTag(tag);
+    }
+  }
+  LOG_INFO("Incremental regeneration: kept " << state.keptTags.size() << " unchanged profiles, rewrote "
+                                             << state.profileTags.size() << ", removed " << removed
+                                             << " stale curves");
+}
+
+}  // namespace Core
+}  // namespace ChipCarving
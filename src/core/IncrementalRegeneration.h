@@ -0,0 +1,86 @@
+/**
+ * IncrementalRegeneration.h
+ *
+ * Incremental Generate Paths: every toolpath curve carries a tag naming the
+ * geometry and parameters of the profile it was cut from. A rerun computes
+ * and writes only profiles whose tag is missing from the earlier run's
+ * sketch, deletes the curves of tags no longer produced and leaves the rest
+ * of the sketch untouched. Edits to the target surface itself keep their
+ * tags; a full run picks them up.
+ *
+ * Progressive refinement builds on the tags: a coarse pass writes every
+ * profile's toolpaths at coarsened tolerances, then refinement batches
+ * recompute a bounded number of profiles at the run's own tolerances each,
+ * replacing their coarse curves while the remaining ones stay in place.
+ */
+
+#pragma once
+
+#include <string>
+#include <vector>
+
+#include "GenerationJob.h"
+#include "adapters/IFusionInterface.h"
+#include "geometry/Point2D.h"
+
+namespace ChipCarving {
+namespace Core {
+
+// Shard 0 is the tool's plain sketch name; later shards of a large run add " (2)", " (3)", ...
+std::string toolpathSketchName(const Adapters::MedialAxisParameters& params, size_t shard = 0);
+
+// Only an unsharded parametric toolpath sketch is incremental: G-code files and the visualization need every
+// profile, and a base feature's sketches cannot be edited outside its edit session
+bool canRegenerateIncrementally(const Adapters::MedialAxisParameters& params);
+
+/**
+ * Tag of one profile's toolpaths: a hash of its outline, holes and sketch
+ * plane with every parameter its toolpaths depend on (16 hex digits)
+ */
+std::string profileToolpathTag(const std::vector<Geometry::Point2D>& polygon,
+                               const std::vector<std::vector<Geometry::Point2D>>& holes,
+                               const Adapters::IWorkspace::TransformParams& transform,
+                               const Adapters::MedialAxisParameters& params);
+
+/**
+ * A background Generate Paths run whose coarse toolpaths are still being
+ * replaced: PluginManager starts a refinement batch each time one is written
+ */
+struct ProgressiveRefinement {
+  static constexpr size_t BATCHES = 8;  // Refinement batches a selection is split into, at most
+
+  Adapters::SketchSelection selection{};
+  Adapters::MedialAxisParameters params{};  // Exact, with incremental regeneration on
+  size_t batchSize = 1;                     // Profiles refined per batch
+  size_t profileCount = 0;
+  size_t coarseProfiles = 0;  // Still waiting for their exact toolpaths
+};
+
+// Progressive refinement needs what incremental regeneration does
+bool canRefineProgressively(const Adapters::MedialAxisParameters& params);
+
+// The coarse pass's parameters: polygon tolerance and sampling distance coarsened, fixed-distance sampling
+Adapters::MedialAxisParameters coarseToolpathParameters(const Adapters::MedialAxisParameters& params);
+
+// Entity token of selection's profile index, recorded alongside its tag ("" if there is none)
+std::string profileSourceToken(const Adapters::SketchSelection& selection, size_t index);
+
+// Read the tags of the earlier run's toolpath sketch into job.incremental (main thread)
+void beginIncrementalRegeneration(Adapters::IWorkspace* workspace, GenerationJob& job);
+
+/**
+ * Decide whether an extracted profile joins the job
+ * @return false if its toolpaths are already in the sketch (the profile is
+ *         kept as it is), or if a refinement batch is full and it keeps its
+ *         coarse toolpaths; true if it is computed, with its tag recorded at
+ *         the job's next profile index
+ */
+bool admitIncrementalProfile(GenerationJob& job, const std::vector<Geometry::Point2D>& polygon,
+                             const std::vector<std::vector<Geometry::Point2D>>& holes,
+                             const Adapters::IWorkspace::TransformParams& transform, const std::string& sourceToken);
+
+// Delete the curves of profiles that changed or left the selection, and untagged curves
+void removeStaleToolpaths(GenerationJob& job, Adapters::ISketch* sketch);
+
+}  // namespace Core
+}  // namespace ChipCarving
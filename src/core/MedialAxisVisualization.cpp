@@ -0,0 +1,109 @@
+/**
+ * MedialAxisVisualization.cpp
+ *
+ * Custom graphics buffers for medial axis visualization
+ */
+
+#include "MedialAxisVisualization.h"
+
+#include <cmath>
+
+#include "utils/UnitConversion.h"
+
+namespace ChipCarving {
+namespace Core {
+
+namespace {
+
+constexpr int CIRCLE_SEGMENTS = 48;           // Straight segments per clearance circle
+constexpr double MIN_CIRCLE_RADIUS = 0.001;   // Smallest clearance drawn as a circle (cm, 0.01 mm)
+constexpr double PI = 3.14159265358979323846;
+
+std::vector<Geometry::Point3D> circleStrip(const Geometry::Point2D& center, double radius, double z) {
+  std::vector<Geometry::Point3D> strip;
+  strip.reserve(CIRCLE_SEGMENTS + 1);
+  for (int k = 0; k <= CIRCLE_SEGMENTS; ++k) {
+    double angle = 2.0 * PI * (k % CIRCLE_SEGMENTS) / CIRCLE_SEGMENTS;
+    strip.emplace_back(center.x + radius * std::cos(angle), center.y + radius * std::sin(angle), z);
+  }
+  return strip;
+}
+
+}  // namespace
+
+VisualizationBuffers buildVisualizationBuffers(Geometry::MedialAxisProcessor& processor,
+                                               const Geometry::MedialAxisResults& results,
+                                               const Adapters::MedialAxisParameters& params, double planeZ,
+                                               const std::vector<Geometry::Point2D>& polygon,
+                                               const std::vector<Geometry::SampledMedialPath>* sampledPaths) {
+  VisualizationBuffers buffers;
+  if (!results.success) {
+    return buffers;
+  }
+
+  // Sampled paths are in world coordinates (mm)
+  if (params.showMedialLines) {
+    std::vector<Geometry::SampledMedialPath> resampled;
+    if (!sampledPaths || sampledPaths->empty()) {
+      processor.getSampledPaths(results, params.samplingDistance, resampled);
+      sampledPaths = &resampled;
+    }
+    for (const auto& path : *sampledPaths) {
+      buffers.medialLines.emplace_back();
+      buffers.medialLines.back().reserve(path.points.size());
+      for (const auto& point : path.points) {
+        buffers.medialLines.back().emplace_back(Utils::mmToFusionLength(point.position.x),
+                                                Utils::mmToFusionLength(point.position.y), planeZ);
+      }
+    }
+  }
+
+  // Circles and crosses at the medial axis vertices exactly as OpenVoronoi produced them (cm)
+  if (params.showClearanceCircles) {
+    double cross = Utils::mmToFusionLength(params.crossSize);
+    for (size_t chainIdx = 0; chainIdx < results.chains.size(); ++chainIdx) {
+      auto chain = results.chains[chainIdx];
+      for (size_t i = 0; i < chain.size(); ++i) {
+        Geometry::Point2D center = chain[i];
+        buffers.centers.emplace_back(center.x, center.y, planeZ);
+        if (chain.clearance(i) >= MIN_CIRCLE_RADIUS) {
+          buffers.clearance.push_back(circleStrip(center, chain.clearance(i), planeZ));
+        }
+        if (cross > 0.0) {
+          buffers.clearance.push_back({Geometry::Point3D(center.x - cross, center.y, planeZ),
+                                       Geometry::Point3D(center.x + cross, center.y, planeZ)});
+          buffers.clearance.push_back({Geometry::Point3D(center.x, center.y - cross, planeZ),
+                                       Geometry::Point3D(center.x, center.y + cross, planeZ)});
+        }
+      }
+    }
+  }
+
+  if (params.showPolygonizedShape && !polygon.empty()) {
+    buffers.outline.emplace_back();
+    for (size_t i = 0; i <= polygon.size(); ++i) {
+      const Geometry::Point2D& p = polygon[i % polygon.size()];
+      buffers.outline.back().emplace_back(p.x, p.y, planeZ);
+    }
+  }
+  return buffers;
+}
+
+void uploadVisualizationBuffers(const VisualizationBuffers& buffers, Adapters::ICustomGraphics& graphics) {
+  using Role = Adapters::ICustomGraphics::Role;
+  if (!buffers.medialLines.empty()) {
+    graphics.addLineStrips(buffers.medialLines, Role::MEDIAL_AXIS);
+  }
+  if (!buffers.clearance.empty()) {
+    graphics.addLineStrips(buffers.clearance, Role::CLEARANCE);
+  }
+  if (!buffers.centers.empty()) {
+    graphics.addPointSet(buffers.centers, Role::CLEARANCE);
+  }
+  if (!buffers.outline.empty()) {
+    graphics.addLineStrips(buffers.outline, Role::OUTLINE);
+  }
+}
+
+}  // namespace Core
+}  // namespace ChipCarving
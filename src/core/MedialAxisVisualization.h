@@ -0,0 +1,47 @@
+/**
+ * MedialAxisVisualization.h
+ *
+ * Medial axis visualization as custom graphics buffers: the same medial lines,
+ * clearance circles, center crosses and polygon outline as the construction
+ * sketch, but uploaded per profile as a few line strip and point buffers
+ * instead of one sketch entity per segment
+ */
+
+#pragma once
+
+#include <vector>
+
+#include "adapters/IFusionInterface.h"
+#include "geometry/MedialAxisProcessor.h"
+#include "geometry/Point2D.h"
+#include "geometry/Point3D.h"
+
+namespace ChipCarving {
+namespace Core {
+
+// One profile's visualization in world coordinates (cm) on its sketch plane
+struct VisualizationBuffers {
+  std::vector<std::vector<Geometry::Point3D>> medialLines{};  // Sampled medial axis paths
+  std::vector<std::vector<Geometry::Point3D>> clearance{};    // Closed clearance circles and center crosses
+  std::vector<std::vector<Geometry::Point3D>> outline{};      // Closed polygonized boundary
+  std::vector<Geometry::Point3D> centers{};                   // Medial axis vertices
+};
+
+/**
+ * Build one profile's buffers with the construction sketch's display options
+ * @param processor Samples the medial lines at params.samplingDistance
+ * @param planeZ World Z of the profile's sketch plane (cm)
+ * @param polygon Profile polygon in world coordinates (cm), for the outline
+ * @param sampledPaths The V-carve stage's samples of results to draw instead of resampling (optional)
+ */
+VisualizationBuffers buildVisualizationBuffers(Geometry::MedialAxisProcessor& processor,
+                                               const Geometry::MedialAxisResults& results,
+                                               const Adapters::MedialAxisParameters& params, double planeZ,
+                                               const std::vector<Geometry::Point2D>& polygon,
+                                               const std::vector<Geometry::SampledMedialPath>* sampledPaths = nullptr);
+
+// Upload non-empty buffers, one call per role
+void uploadVisualizationBuffers(const VisualizationBuffers& buffers, Adapters::ICustomGraphics& graphics);
+
+}  // namespace Core
+}  // namespace ChipCarving
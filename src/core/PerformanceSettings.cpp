@@ -0,0 +1,163 @@
+/**
+ * PerformanceSettings.cpp
+ *
+ * Persisted performance settings and their effect on Generate Paths runs
+ */
+
+#include "PerformanceSettings.h"
+
+#include <cstdio>
+#include <fstream>
+#include <sstream>
+#include <stdexcept>
+
+#include "parsers/JsonReader.h"
+#include "utils/logging.h"
+
+namespace ChipCarving {
+namespace Core {
+
+namespace {
+
+using Parsers::JsonReader;
+
+void appendJsonString(std::ostream& out, const std::string& text) {
+  out << '"';
+  for (char c : text) {
+    if (c == '"' || c == '\\') {
+      out << '\\' << c;
+    } else if (static_cast<unsigned char>(c) < 0x20) {
+      char escaped[8];
+      std::snprintf(escaped, sizeof(escaped), "\\u%04x", static_cast<unsigned int>(c));
+      out << escaped;
+    } else {
+      out << c;
+    }
+  }
+  out << '"';
+}
+
+bool parseSurfaceQuery(const std::string& name, PerformanceSettings::SurfaceQuery& query) {
+  for (auto candidate : {PerformanceSettings::SurfaceQuery::RAY, PerformanceSettings::SurfaceQuery::HEIGHTFIELD,
+                         PerformanceSettings::SurfaceQuery::EVALUATOR}) {
+    if (name == surfaceQueryName(candidate)) {
+      query = candidate;
+      return true;
+    }
+  }
+  return false;
+}
+
+// Members of the wrong type are skipped like unknown ones
+void readMember(JsonReader& reader, const std::string& key, PerformanceSettings& settings) {
+  JsonReader::ValueType type = reader.peekType();
+  if (type == JsonReader::ValueType::Number && key == "medialAxisWorkers") {
+    settings.medialAxisWorkers = static_cast<int>(reader.readNumber());
+  } else if (type == JsonReader::ValueType::Number && key == "medialCacheMb") {
+    settings.medialCacheMb = static_cast<int>(reader.readNumber());
+  } else if (type == JsonReader::ValueType::String && key == "diskCacheDirectory") {
+    reader.readString(settings.diskCacheDirectory);
+  } else if (type == JsonReader::ValueType::Number && key == "diskCacheMb") {
+    settings.diskCacheMb = static_cast<int>(reader.readNumber());
+  } else if (type == JsonReader::ValueType::Boolean && key == "diskCacheShared") {
+    settings.diskCacheShared = reader.readBoolean();
+  } else if (type == JsonReader::ValueType::String && key == "surfaceQuery") {
+    std::string name = reader.readString();
+    if (!parseSurfaceQuery(name, settings.surfaceQuery)) {
+      LOG_WARNING("Unknown surface query '" << name << "' in performance settings");
+    }
+  } else if (type == JsonReader::ValueType::Number && key == "heightfieldResolution") {
+    settings.heightfieldResolution = reader.readNumber();
+  } else if (type == JsonReader::ValueType::Boolean && key == "outputPolylines") {
+    settings.outputPolylines = reader.readBoolean();
+  } else if (type == JsonReader::ValueType::Boolean && key == "writeChromeTrace") {
+    settings.writeChromeTrace = reader.readBoolean();
+  } else if (type == JsonReader::ValueType::Boolean && key == "platformTrace") {
+    settings.platformTrace = reader.readBoolean();
+  } else {
+    reader.skipValue();
+  }
+}
+
+}  // namespace
+
+const char* surfaceQueryName(PerformanceSettings::SurfaceQuery query) {
+  switch (query) {
+    case PerformanceSettings::SurfaceQuery::RAY:
+      return "ray";
+    case PerformanceSettings::SurfaceQuery::HEIGHTFIELD:
+      return "heightfield";
+    default:
+      return "evaluator";
+  }
+}
+
+void PerformanceSettings::applyTo(Adapters::MedialAxisParameters& params) const {
+  params.medialAxisWorkers = medialAxisWorkers;
+  params.outputPolylines = outputPolylines;
+  params.useFaceEvaluator = surfaceQuery != SurfaceQuery::RAY;
+  params.surfaceGridResolution = surfaceQuery == SurfaceQuery::HEIGHTFIELD ? heightfieldResolution : 0.0;
+}
+
+void PerformanceSettings::sanitize() {
+  PerformanceSettings defaults;
+  if (medialAxisWorkers < 0) {
+    medialAxisWorkers = defaults.medialAxisWorkers;
+  }
+  if (medialCacheMb < 0) {
+    medialCacheMb = defaults.medialCacheMb;
+  }
+  if (diskCacheMb < 0) {
+    diskCacheMb = defaults.diskCacheMb;
+  }
+  if (!(heightfieldResolution > 0.0)) {
+    heightfieldResolution = defaults.heightfieldResolution;
+  }
+}
+
+bool loadPerformanceSettings(const std::string& filePath, PerformanceSettings& settings) {
+  std::ifstream in(filePath, std::ios::binary);
+  if (!in.is_open()) {
+    return false;
+  }
+  std::stringstream buffer;
+  buffer << in.rdbuf();
+  std::string text = buffer.str();
+
+  PerformanceSettings loaded = settings;
+  try {
+    JsonReader reader(text);
+    reader.beginObject();
+    std::string key;
+    while (reader.nextMember(key)) {
+      readMember(reader, key, loaded);
+    }
+    reader.expectEnd();
+  } catch (const std::runtime_error& e) {
+    LOG_WARNING("Ignoring performance settings in " << filePath << ": " << e.what());
+    return false;
+  }
+  loaded.sanitize();
+  settings = loaded;
+  return true;
+}
+
+bool savePerformanceSettings(const std::string& filePath, const PerformanceSettings& settings) {
+  std::ofstream out(filePath, std::ios::out | std::ios::trunc);
+  if (!out.is_open()) {
+    return false;
+  }
+  out << "{\n  \"medialAxisWorkers\": " << settings.medialAxisWorkers << ",\n  \"medialCacheMb\": "
+      << settings.medialCacheMb << ",\n  \"diskCacheDirectory\": ";
+  appendJsonString(out, settings.diskCacheDirectory);
+  out << ",\n  \"diskCacheMb\": " << settings.diskCacheMb
+      << ",\n  \"diskCacheShared\": " << (settings.diskCacheShared ? "true" : "false") << ",\n  \"surfaceQuery\": \""
+      << surfaceQueryName(settings.surfaceQuery) << "\",\n  \"heightfieldResolution\": "
+      << settings.heightfieldResolution << ",\n  \"outputPolylines\": " << (settings.outputPolylines ? "true" : "false")
+      << ",\n  \"writeChromeTrace\": " << (settings.writeChromeTrace ? "true" : "false")
+      << ",\n  \"platformTrace\": " << (settings.platformTrace ? "true" : "false") << "\n}\n";
+  return static_cast<bool>(out);
+}
+
+}  // namespace Core
+}  // namespace ChipCarving
@@ -0,0 +1,65 @@
+/**
+ * PerformanceSettings.h
+ *
+ * Per-machine performance tuning from the Settings dialog: worker threads,
+ * medial axis cache budgets and location, how the target surface is queried,
+ * sketch output mode and trace export. Settings are stored as one JSON object
+ * so they survive restarts; PluginManager applies the cache settings and
+ * applyTo() gives each Generate Paths run its defaults.
+ */
+
+#pragma once
+
+#include <string>
+
+#include "adapters/MedialAxisParameters.h"
+
+namespace ChipCarving {
+namespace Core {
+
+struct PerformanceSettings {
+  // How V-carve points find the target surface's height
+  enum class SurfaceQuery {
+    RAY,          // Ray casts against the surface's body only
+    HEIGHTFIELD,  // Interpolate a grid sampled once per run at heightfieldResolution
+    EVALUATOR     // The face's surface evaluator, ray casts where it cannot project
+  };
+
+  int medialAxisWorkers = 0;  // 0 = hardware concurrency, 1 = sequential
+  int medialCacheMb = 64;     // In-memory medial axis cache budget
+  std::string diskCacheDirectory = "/tmp/chip_carving_cpp_medial_cache";  // Empty disables the disk cache
+  int diskCacheMb = 512;                                                  // Disk cache budget (0 = unlimited)
+  bool diskCacheShared = false;  // The disk cache folder is on a network share other machines use too
+  SurfaceQuery surfaceQuery = SurfaceQuery::EVALUATOR;
+  double heightfieldResolution = 0.5;  // Heightfield node spacing (mm)
+  bool outputPolylines = false;        // V-carve paths as 3D lines and arcs instead of fitted splines
+  bool writeChromeTrace = false;       // Write a Chrome trace file for each Generate Paths run
+  bool platformTrace = false;          // Annotate trace spans for the native profiler (utils/PlatformTrace.h)
+
+  /**
+   * Set a run's performance fields: worker count, surface query and output
+   * mode (the dialog may still override the heightfield resolution)
+   */
+  void applyTo(Adapters::MedialAxisParameters& params) const;
+
+  // Clamp out-of-range values (negative counts and budgets, non-positive resolution) to defaults
+  void sanitize();
+};
+
+const char* surfaceQueryName(PerformanceSettings::SurfaceQuery query);
+
+/**
+ * Read settings saved by savePerformanceSettings(). Missing or unknown
+ * members keep their current values, so older files still load.
+ * @return false if the file does not exist or is not valid JSON (settings are left unchanged)
+ */
+bool loadPerformanceSettings(const std::string& filePath, PerformanceSettings& settings);
+
+/**
+ * Write settings as a JSON object, replacing the file
+ * @return false if the file could not be written
+ */
+bool savePerformanceSettings(const std::string& filePath, const PerformanceSettings& settings);
+
+}  // namespace Core
+}  // namespace ChipCarving
@@ -198,13 +198,31 @@ bool PluginInitializer::InitializePlugin(const char* /* context */, PluginMode m
   }
 
   try {
-    // Initialize plugin manager with factory
+    // The plugin manager initializes itself the first time a command uses it: the logger (and its log
+    // rotation), the adapters, the medial axis processor and the settings file are not touched at Fusion
+    // startup, so loading the add-in only registers its commands and events
     std::string logPath = "/tmp/chip_carving_cpp.log";
     auto factory = std::make_unique<Adapters::FusionAPIFactory>(app, ui, logPath);
     pluginManager = std::make_unique<Core::PluginManager>(std::move(factory));
-    if (!pluginManager->initialize()) {
-      return false;
-    }
+
+    // Per-machine performance settings from the Settings dialog, next to the log, read at initialization;
+    // by default medial axis results persist there too so repeat jobs skip OpenVoronoi
+    pluginManager->setPerformanceSettingsFile("/tmp/chip_carving_cpp_settings.json");
+
+    // One JSON line of stage timings per command, for comparing runs
+    pluginManager->setRunMetricsFile("/tmp/chip_carving_cpp_metrics.jsonl");
+
+    // One line per Import Design / Generate Paths run with versions and counts, for trends across seats
+    pluginManager->setRunHistoryFile("/tmp/chip_carving_cpp_history.jsonl");
+
+    // Chrome traces (enabled from Settings) go next to the log as well
+    pluginManager->setChromeTraceDirectory("/tmp");
+
+    // Background Generate Paths reports back to the main thread through a custom event
+    CreateGenerationProgressEvent();
+
+    // Entity token lookups are indexed per design
+    AddDocumentEventHandlers();
 
     // Try toolbar creation
     if (!CreateToolbarPanel()) {
@@ -225,6 +243,12 @@ bool PluginInitializer::InitializePlugin(const char* /* context */, PluginMode m
 }
 
 bool PluginInitializer::ShutdownPlugin() {
+  try {
+    RemoveDocumentEventHandlers();
+  } catch (...) {
+    LOG_ERROR("Document event cleanup failed");
+  }
+
   // Clean up UI elements - use try-catch for resilience
   // If one cleanup step fails, continue with others
   try {
@@ -264,6 +288,13 @@ bool PluginInitializer::ShutdownPlugin() {
     LOG_ERROR("Plugin manager cleanup failed: Unknown error");
   }
 
+  // After the plugin manager has joined any background worker that could still fire it
+  try {
+    RemoveGenerationProgressEvent();
+  } catch (...) {
+    LOG_ERROR("Progress event cleanup failed");
+  }
+
   return true;
 }
 
@@ -19,6 +19,10 @@ class PluginInitializer {
   static void CreateImportDesignCommand();
   static void CreateGeneratePathsCommand();
   static void CreateSettingsCommand();
+  static void CreateGenerationProgressEvent();
+  static void RemoveGenerationProgressEvent();
+  static void AddDocumentEventHandlers();
+  static void RemoveDocumentEventHandlers();
 };
 
 }  // namespace ChipCarving
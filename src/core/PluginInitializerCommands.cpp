@@ -5,19 +5,31 @@
  * Split from PluginInitializer.cpp for maintainability
  */
 
+#include <Core/Application/CustomEvent.h>
+#include <Core/Application/CustomEventArgs.h>
+#include <Core/Application/DocumentEvent.h>
+#include <Core/Application/DocumentEventArgs.h>
 #include <Core/UserInterface/CommandControl.h>
 #include <Core/UserInterface/ToolbarControls.h>
 
 #include "PluginInitializer.h"
 #include "PluginInitializerGlobals.h"
+#include "adapters/FusionAPIAdapter.h"
+#include "utils/FusionComponentTraverser.h"
 #include "utils/logging.h"
 
 using adsk::core::CommandControl;
 using adsk::core::CommandDefinition;
 using adsk::core::CommandDefinitions;
+using adsk::core::CustomEvent;
+using adsk::core::CustomEventArgs;
+using adsk::core::CustomEventHandler;
+using adsk::core::DocumentEventArgs;
+using adsk::core::DocumentEventHandler;
 using adsk::core::Ptr;
 using adsk::core::ToolbarControls;
 
+using ChipCarving::Internal::app;
 using ChipCarving::Internal::commandControls;
 using ChipCarving::Internal::commandDefinitions;
 using ChipCarving::Internal::generateHandler;
@@ -29,6 +41,42 @@ using ChipCarving::Internal::ui;
 
 namespace ChipCarving {
 
+namespace {
+
+// Runs on the main thread for each notifyMainThread() of a background Generate Paths job or preview,
+// and when a worker thread queues a console line
+class GenerationProgressHandler : public CustomEventHandler {
+ public:
+  void notify(const Ptr<CustomEventArgs>& /* eventArgs */) override {
+    FlushQueuedConsoleLog();
+    if (pluginManager) {
+      pluginManager->pumpBackgroundGeneration();
+      if (pluginManager->getPreview()) {
+        pluginManager->getPreview()->pump();
+      }
+    }
+  }
+};
+
+GenerationProgressHandler generationProgressHandler;
+Ptr<CustomEvent> generationProgressEvent;
+
+// Entity tokens and component snapshots belong to one design, so switching or
+// closing documents drops them
+class DocumentChangedHandler : public DocumentEventHandler {
+ public:
+  void notify(const Ptr<DocumentEventArgs>& /* eventArgs */) override {
+    if (pluginManager) {
+      pluginManager->invalidateEntityLookups();
+    }
+    Utils::FusionComponentTraverser::clearSnapshot();
+  }
+};
+
+DocumentChangedHandler documentChangedHandler;
+
+}  // namespace
+
 void PluginInitializer::CreateImportDesignCommand() {
   std::string cmdId = "ChipCarvingImportDesignCpp";
 
@@ -173,4 +221,53 @@ void PluginInitializer::CreateSettingsCommand() {
   }
 }
 
+void PluginInitializer::CreateGenerationProgressEvent() {
+  if (!app) {
+    return;
+  }
+
+  generationProgressEvent = app->registerCustomEvent(Adapters::GENERATION_PROGRESS_EVENT_ID);
+  if (!generationProgressEvent) {
+    LOG_ERROR("Failed to register the Generate Paths progress event; background generation will not finish");
+    return;
+  }
+  generationProgressEvent->add(&generationProgressHandler);
+
+  // Worker threads' console lines reach the palette through the same event
+  SetConsoleLogMainThread([]() {
+    Ptr<adsk::core::Application> application = adsk::core::Application::get();
+    if (application) {
+      application->fireCustomEvent(Adapters::GENERATION_PROGRESS_EVENT_ID);
+    }
+  });
+}
+
+void PluginInitializer::AddDocumentEventHandlers() {
+  if (!app) {
+    return;
+  }
+  app->documentActivated()->add(&documentChangedHandler);
+  app->documentClosed()->add(&documentChangedHandler);
+}
+
+void PluginInitializer::RemoveDocumentEventHandlers() {
+  if (!app) {
+    return;
+  }
+  app->documentActivated()->remove(&documentChangedHandler);
+  app->documentClosed()->remove(&documentChangedHandler);
+  Utils::FusionComponentTraverser::clearSnapshot();
+}
+
+void PluginInitializer::RemoveGenerationProgressEvent() {
+  SetConsoleLogMainThread(nullptr);
+  if (generationProgressEvent) {
+    generationProgressEvent->remove(&generationProgressHandler);
+    generationProgressEvent = nullptr;
+  }
+  if (app) {
+    app->unregisterCustomEvent(Adapters::GENERATION_PROGRESS_EVENT_ID);
+  }
+}
+
 }  // namespace ChipCarving
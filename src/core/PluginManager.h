@@ -5,14 +5,31 @@
 
 #pragma once
 
+#include <chrono>
+#include <cstdint>
 #include <memory>
 #include <string>
 #include <vector>
 
+#include "DesignWatch.h"
+#include "GenerationJob.h"
+#include "IncrementalRegeneration.h"
+#include "PerformanceSettings.h"
+#include "PreviewGeneration.h"
+#include "SpeculativeMedialAxis.h"
 #include "adapters/IFusionInterface.h"
+#include "geometry/GcodeWriter.h"
+#include "geometry/MedialAxisCache.h"
+#include "geometry/MedialAxisDiskCache.h"
 #include "geometry/MedialAxisProcessor.h"
-#include "geometry/Shape.h"
+#include "geometry/ShapeMatchIndex.h"
+#include "geometry/ShapeStore.h"
+#include "geometry/SurfaceHeightfield.h"
+#include "geometry/VCarveCheckpoints.h"
+#include "geometry/VCarvePath.h"
 #include "parsers/DesignParser.h"
+#include "utils/JobProgress.h"
+#include "utils/TraceSpan.h"
 
 namespace ChipCarving {
 namespace Core {
@@ -22,15 +39,12 @@ namespace Core {
  * Handles command execution without direct Fusion API dependencies
  */
 class PluginManager {
-  ///
-  /// Setup error handler UI integration
+  // Setup error handler UI integration
   void setupErrorHandling();
 
-  ///
-  /// Setup error handler UI integration
  public:
   explicit PluginManager(std::unique_ptr<Adapters::IFusionFactory> factory);
-  ~PluginManager() = default;
+  ~PluginManager();
 
   // Plugin lifecycle
   bool initialize();
@@ -39,16 +53,102 @@ class PluginManager {
   // Command implementations
   bool executeImportDesign();
   bool executeImportDesign(const std::string& filePath, const std::string& planeEntityId = "");
+  // Parse design files in parallel and draw each into its own sketch; see ImportDiff.h for updatePrevious
+  bool executeImportDesigns(const std::vector<std::string>& filePaths, const std::string& planeEntityId = "",
+                            bool updatePrevious = false);
   bool executeGeneratePaths();
 
-  // Enhanced UI Phase 5: Medial axis generation with construction geometry
+  // Medial axis generation with construction geometry; several sketch planes or components run as one batch
   bool executeMedialAxisGeneration(const Adapters::SketchSelection& selection,
                                    const Adapters::MedialAxisParameters& params);
 
-  // Configuration methods
+  // Generate Paths per tool (overriding params' tool fields) from one medial axis; V-carve runs in parallel
+  bool executeMultiToolGeneration(const Adapters::SketchSelection& selection,
+                                  const Adapters::MedialAxisParameters& params,
+                                  const std::vector<Adapters::ToolDefinition>& tools);
+
+  // Start Generate Paths as a background job: profiles are extracted here, the medial axis and V-carve geometry
+  // run on a worker thread that asks the UI to call pumpBackgroundGeneration() on the main thread as it progresses.
+  // False if the job could not start (the error has been shown). With params.progressiveRefinement the job
+  // writes coarse toolpaths and each one written starts a batch that replaces some of them with exact ones
+  bool startMedialAxisGeneration(const Adapters::SketchSelection& selection,
+                                 const Adapters::MedialAxisParameters& params);
+
+  // Main-thread tick of a background job: updates the progress dialog, passes on cancel requests and, once the
+  // worker is done, writes the sketches; then applies a watched design change. True while a job still runs
+  bool pumpBackgroundGeneration();
+
+  // Ask a running background job to stop; pumpBackgroundGeneration() then discards its results
+  void cancelBackgroundGeneration();
+  bool isBackgroundGenerationRunning() const;
+  // The progressive run whose coarse toolpaths are still being replaced (null if none)
+  const ProgressiveRefinement* getProgressiveRefinement() const;
+
+  // Coarse Generate Paths preview for the command dialog (null until initialized)
+  PreviewGeneration* getPreview() const {
+    return preview_.get();
+  }
+
+  // Restart the speculative medial axes of selection's profiles; false while a job runs or caching is off
+  bool speculateMedialAxes(const Adapters::SketchSelection& selection, const Adapters::MedialAxisParameters& params);
+
+  // Selection count for the dialog; within intervalMs of the last one shown a count is only
+  // held, and flushSelectionCount() shows the latest held count
+  static constexpr int DEFAULT_SELECTION_COUNT_INTERVAL_MS = 100;
+  void reportSelectionCount(int count);
+  void flushSelectionCount();
+  void setSelectionCountIntervalMs(int intervalMs);
+
+  // The active document changed: entity tokens resolved so far no longer apply
+  void invalidateEntityLookups();
+
+  // Watch mode for lastImportedFile_ (see DesignWatch.h); false if nothing has been imported
+  bool setDesignWatchEnabled(bool enabled, int pollMs = DesignWatch::DEFAULT_POLL_MS);
+  bool isDesignWatchEnabled() const {
+    return designWatch_ != nullptr;
+  }
+
   void setMedialAxisParameters(double polygonTolerance, double medialThreshold);
 
-  // Status and information
+  // Enable the persistent medial axis cache in directory, with V-carve checkpoints in its "checkpoints"
+  // subdirectory (empty disables both). A shared directory is one several machines use at once: the cache
+  // publishes immutable entries through its key index, and the checkpoints stay on this machine.
+  void setMedialAxisCacheDirectory(const std::string& directory, bool shared = false);
+
+  // Per-machine cache budgets, disk cache location and trace export (commands apply the rest to each run with
+  // PerformanceSettings::applyTo), saved to the settings file if set; false while a job runs or if saving fails
+  bool setPerformanceSettings(const PerformanceSettings& settings);
+  const PerformanceSettings& getPerformanceSettings() const {
+    return performanceSettings_;
+  }
+  // Load and apply the settings saved in filePath (defaults if there are none); before initialize(), when it runs
+  void setPerformanceSettingsFile(const std::string& filePath);
+
+  // Append each command's stage timings to a JSON-lines file (empty keeps metrics in memory only)
+  void setRunMetricsFile(const std::string& filePath);
+
+  // Append a line per Import Design or Generate Paths run to a JSON-lines run history (see RunHistory.h); off if empty
+  void setRunHistoryFile(const std::string& filePath);
+
+  // Stage timings of the most recent import or Generate Paths run
+  const Utils::RunMetrics& getLastRunMetrics() const {
+    return lastRunMetrics_;
+  }
+
+  // Profiles, medial axis sources and slowest profiles of the most recent Generate Paths run
+  const RunReport& getLastRunReport() const {
+    return lastRunReport_;
+  }
+
+  // Write each Generate Paths run as a Chrome Trace Event file (Perfetto) into directory; off until set
+  void setChromeTraceDirectory(const std::string& directory);
+  bool isChromeTraceEnabled() const;
+
+  // Trace file of the most recent traced run (empty if none was written)
+  const std::string& getLastChromeTracePath() const {
+    return lastChromeTracePath_;
+  }
+
   std::string getVersion() const;
   std::string getName() const;
   bool isInitialized() const {
@@ -58,7 +158,6 @@ class PluginManager {
     return !importedShapes_.empty();
   }
 
-  // Access to factory for UI operations
   Adapters::IFusionFactory* getFactory() const {
     return factory_.get();
   }
@@ -69,49 +168,178 @@ class PluginManager {
   std::unique_ptr<Adapters::IUserInterface> ui_{};
   std::unique_ptr<Adapters::IWorkspace> workspace_{};
 
-  // Imported design data
-  std::vector<std::unique_ptr<Geometry::Shape>> importedShapes_{};
+  // Imported design data, one contiguous array per shape type
+  Geometry::ShapeStore importedShapes_{};
+  Geometry::ShapeMatchIndex importedShapeIndex_{};  // Of importedShapes_ in cm, rebuilt at import
   std::string lastImportedFile_{};
-  std::string lastImportedPlaneEntityId_{};  // Store plane entity ID for medial
-                                             // axis generation
+  std::string lastImportedPlaneEntityId_{};  // Store plane entity ID for medial axis generation
 
   // Medial axis processing
   std::unique_ptr<Geometry::MedialAxisProcessor> medialProcessor_{};
+  std::unique_ptr<Geometry::MedialAxisCache> medialCache_{};  // Reused across Generate Paths runs
+  std::unique_ptr<Geometry::MedialAxisDiskCache> medialDiskCache_{};  // Optional, persists across sessions
+  std::unique_ptr<Geometry::VCarveCheckpoints> vcarveCheckpoints_{};  // Beside the disk cache, until written
+
+  // Stage timings
+  Utils::RunMetrics lastRunMetrics_{};
+  RunReport lastRunReport_{};  // Profiles of the most recent Generate Paths run
+  std::string runMetricsFile_{};
+  std::string runHistoryFile_{};
+  std::string importedDesignHash_{};  // Of importedShapes_, computed for the first run history line that needs it
+  std::string chromeTraceDirectory_{};
+  std::string lastChromeTracePath_{};
+  PerformanceSettings performanceSettings_{};
+  std::string performanceSettingsFile_{};
 
   bool initialized_ = false;
 
-  // Helper methods
+  // Background, progressive and time-budgeted runs and surface queries (see PluginManagerHelpers.h)
+  class BackgroundGeneration;
+  class AnytimeGeneration;
+  class SurfaceProjection;
+  std::unique_ptr<BackgroundGeneration> background_{};
+  std::unique_ptr<AnytimeGeneration> anytime_{};
+  std::unique_ptr<SurfaceProjection> surface_{};
+  std::unique_ptr<PreviewGeneration> preview_{};  // Reports to ui_ and draws in workspace_
+  std::unique_ptr<SpeculativeMedialAxis> speculation_{};  // Copies medialProcessor_; results go to medialCache_
+  std::unique_ptr<DesignWatch> designWatch_{};             // Reports to ui_
+  WatchedGeneration lastGeneration_{};
+
+  // Debounced selection count (reportSelectionCount)
+  int selectionCountIntervalMs_ = DEFAULT_SELECTION_COUNT_INTERVAL_MS;
+  int shownSelectionCount_ = -1;
+  int heldSelectionCount_ = -1;  // -1 = none held
+  std::chrono::steady_clock::time_point selectionCountShownAt_{};
+
+  // executeImportDesigns for designs parsed from filePaths already, if parsed is set
+  bool importDesigns(const std::vector<std::string>& filePaths, std::vector<Parsers::DesignFile>* parsed,
+                     const std::string& planeEntityId, bool updatePrevious);
+  // Update the import from the watched file's latest change, then repeat the last Generate Paths run on it
+  void pumpDesignWatch();
+
+  // sampledPaths: the V-carve stage's samples of results, drawn instead of resampling (optional)
   void addConstructionGeometryVisualization(Adapters::ISketch* sketch, const Geometry::MedialAxisResults& results,
                                             const Adapters::MedialAxisParameters& params,
-                                            const Adapters::IWorkspace::TransformParams& transform,
+                                            const std::vector<Geometry::SampledMedialPath>* sampledPaths,
                                             const std::vector<Geometry::Point2D>& polygon);
 
-  // Enhanced UI Phase 5.2: Profile geometry extraction
-  // Structure to hold profile geometry with transformation parameters
-  struct ProfileData {
-    std::vector<Geometry::Point2D> polygon{};
-    Adapters::IWorkspace::TransformParams transform{};
-  };
+  // Body of executeMedialAxisGeneration, run inside its metrics scope
+  bool runMedialAxisGeneration(const Adapters::SketchSelection& selection,
+                               const Adapters::MedialAxisParameters& params);
+  // Extract every output group, compute all their profiles in one pass, then write each group's sketches
+  bool runBatchGeneration(const std::vector<Adapters::SketchSelection>& groups,
+                          const Adapters::MedialAxisParameters& params);
+  // Generate each tile of a spatially tiled selection end to end (see SpatialTiling.h)
+  bool runTiledGeneration(const Adapters::SketchSelection& selection, const Adapters::MedialAxisParameters& params);
+  bool runMultiToolGeneration(const Adapters::SketchSelection& selection, const Adapters::MedialAxisParameters& params,
+                              const std::vector<Adapters::ToolDefinition>& tools);
+
+  // Generate Paths stages (see GenerationJob); failures are shown to the user
+  bool beginGenerationJob(const Adapters::SketchSelection& selection, GenerationJob& job);
+  bool prepareGenerationJob(const Adapters::SketchSelection& selection, GenerationJob& job);
+  void computeGenerationJob(GenerationJob& job, Utils::JobProgress* progress);
+  bool finishGenerationJob(GenerationJob& job);
+
+  // Run all three stages over a bounded window of profiles of job (from beginGenerationJob): the main thread
+  // extracts profile N+1 and writes profile N-1 while workers compute profile N
+  bool runGenerationPipeline(const Adapters::SketchSelection& selection, GenerationJob& job);
+
+  // Write stage for one profile of job (in profile order), then closing the sketches and G-code
+  bool writeGenerationProfile(GenerationJob& job, size_t index, GenerationOutput& output);
+  bool finishGenerationOutput(GenerationJob& job, GenerationOutput& output);
+
+  // Create the V-carve sketch and G-code stream (and surface grid) at the first successful profile
+  void openVCarveOutput(GenerationJob& job, GenerationOutput& output);
+
+  // Enhanced UI Phase 5.2: Profile geometry extraction into job, less the profiles an incremental run keeps
+  bool extractProfileGeometry(const Adapters::SketchSelection& selection, GenerationJob& job);
+
+  // Extract one selected profile and its holes; false if it cannot be read or has fewer than 3 vertices
+  bool extractProfileAt(const Adapters::SketchSelection& selection, size_t index,
+                        std::vector<Geometry::Point2D>& polygon, Adapters::IWorkspace::TransformParams& transform,
+                        std::vector<std::vector<Geometry::Point2D>>& holes);
+
+  // Medial axes of all profile polygons (world coordinates, cm): analytic, cached or from OpenVoronoi, one per
+  // profile in profile order (failures have success = false). Profiles with profileHoles always run OpenVoronoi;
+  // report, if given, counts the analytic and cached medial axes
+  std::vector<Geometry::MedialAxisResults> computeProfileMedialAxes(
+      const std::vector<std::vector<Geometry::Point2D>>& profilePolygons, const Adapters::MedialAxisParameters& params,
+      Utils::JobProgress* progress = nullptr,
+      const std::vector<std::vector<std::vector<Geometry::Point2D>>>* profileHoles = nullptr,
+      RunReport* report = nullptr);
+
+  // Rebuild importedShapeIndex_ after importedShapes_ changed
+  void indexImportedShapes();
 
-  bool extractProfileGeometry(const Adapters::SketchSelection& selection,
-                              std::vector<std::vector<Geometry::Point2D>>& profilePolygons,
-                              std::vector<Adapters::IWorkspace::TransformParams>& profileTransforms);
+  // Closed-form medial axis of a profile polygon (world coordinates, cm) that still matches an imported shape;
+  // true if one matched, and only then are results written
+  bool computeAnalyticMedialAxis(const std::vector<Geometry::Point2D>& polygon,
+                                 Geometry::MedialAxisResults& results) const;
+
+  // Where a profile's medial axis came from without running OpenVoronoi
+  enum class StoredMedialAxis { NONE, ANALYTIC, MEMORY, DISK };
+
+  // Resolve a profile from the analytic shapes or the caches (main thread only); key receives the cache key for
+  // storeMedialAxis() once OpenVoronoi has run
+  StoredMedialAxis resolveStoredMedialAxis(const std::vector<Geometry::Point2D>& polygon,
+                                           const Adapters::MedialAxisParameters& params,
+                                           Geometry::MedialAxisResults& results, uint64_t& key);
+  void storeMedialAxis(uint64_t key, const Geometry::MedialAxisResults& results,
+                       const Adapters::MedialAxisParameters& params);
+  static void countStoredMedialAxis(StoredMedialAxis source, RunReport& report);
 
   void logStartup();
   void logShutdown();
+
+  // Log lastRunMetrics_ and append it to the metrics file, if set; show lastRunReport_ to the user and add
+  // the run to the run history, if set (params is the Generate Paths run's, nullptr for imports)
+  void reportRunMetrics(const Adapters::MedialAxisParameters* params = nullptr);
+  void appendRunHistoryLine(const Adapters::MedialAxisParameters* params);
+
+  // Write a finished run's trace into chromeTraceDirectory_
+  void writeChromeTrace(const Utils::TraceRecorder& trace);
   std::string formatMedialAxisResults(const Geometry::MedialAxisResults& results);
 
-  /**
-   * Generate V-carve toolpaths from medial axis results and add to sketch
-   * @param medialResults Vector of medial axis computation results
-   * @param params Parameters including V-carve settings
-   * @param sketch Target sketch for V-carve toolpaths
-   * @param transforms Coordinate transformations for each profile
-   * @return true if V-carve generation succeeded
-   */
+  // Generate V-carve toolpaths from medial axis results (one transform per profile) into sketch (null when
+  // writing G-code only) and the optional G-code stream, each path as soon as it is computed
   bool generateVCarveToolpaths(const std::vector<Geometry::MedialAxisResults>& medialResults,
                                const Adapters::MedialAxisParameters& params, Adapters::ISketch* sketch,
-                               const std::vector<Adapters::IWorkspace::TransformParams>& transforms);
+                               const std::vector<Adapters::IWorkspace::TransformParams>& transforms,
+                               Geometry::GcodeWriter* gcode = nullptr);
+
+  /**
+   * V-carve paths for every profile (pure geometry, safe on a worker thread)
+   * @param progress Optional; advanced per profile, and stops early once cancelled
+   * @param processor Sampling processor owned by the calling thread (default medialProcessor_)
+   * @param keptSamples Optional; receives each profile's sampled paths, for the visualization to reuse
+   * @param checkpointKeys Optional, one per profile (0 = none); checkpointed paths are loaded, others stored
+   * @param outlines, holes Optional, one per profile; the loops boundary crossings are sampled on
+   * @param samplingDistances Optional, one per profile (mm); each profile's own sampling distance
+   * @return One result per medial axis result (failed or skipped profiles have success = false)
+   */
+  std::vector<Geometry::VCarveResults> computeVCarveProfiles(
+      const std::vector<Geometry::MedialAxisResults>& medialResults, const Adapters::MedialAxisParameters& params,
+      Utils::JobProgress* progress = nullptr, Geometry::MedialAxisProcessor* processor = nullptr,
+      std::vector<std::vector<Geometry::SampledMedialPath>>* keptSamples = nullptr,
+      const std::vector<uint64_t>* checkpointKeys = nullptr,
+      const std::vector<std::vector<Geometry::Point2D>>* outlines = nullptr,
+      const std::vector<std::vector<std::vector<Geometry::Point2D>>>* holes = nullptr,
+      const std::vector<double>* samplingDistances = nullptr);
+
+  // Project vcarveProfiles (from computeVCarveProfiles, in place) onto the target surface and add them to the
+  // sketch and/or G-code stream (main thread: queries and edits Fusion)
+  bool writeVCarveToolpaths(std::vector<Geometry::VCarveResults>& vcarveProfiles,
+                            const std::vector<Geometry::MedialAxisResults>& medialResults,
+                            const Adapters::MedialAxisParameters& params, Adapters::ISketch* sketch,
+                            const std::vector<Adapters::IWorkspace::TransformParams>& transforms,
+                            Geometry::GcodeWriter* gcode);
+
+  // writeVCarveToolpaths for one profile
+  void writeVCarveProfile(Geometry::VCarveResults& vcarveResults,
+                          const Adapters::IWorkspace::TransformParams& transform,
+                          const Adapters::MedialAxisParameters& params, Adapters::ISketch* sketch,
+                          Geometry::GcodeWriter* gcode, VCarveWriteState& state);
+  void logVCarveWriteState(const VCarveWriteState& state);
 };
 
 }  // namespace Core
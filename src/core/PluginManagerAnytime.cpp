@@ -0,0 +1,233 @@
+/**
+ * PluginManagerAnytime.cpp
+ *
+ * Deadline-bounded Generate Paths for PluginManager. Every profile first gets
+ * coarse toolpaths from the distance-field medial axis engine, whose cost
+ * follows its pixel budget rather than the outline. Exact medial axes and
+ * toolpaths then replace them cheapest profile first, each started only while
+ * its estimated time still fits before the deadline. A profile in progress is
+ * never interrupted, and the sketches are written once the deadline has
+ * passed or every profile is exact; profiles left coarse are listed in the
+ * run report.
+ */
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <mutex>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "PluginManagerHelpers.h"
+#include "geometry/MedialAxisBatch.h"
+#include "geometry/MedialAxisDistanceField.h"
+#include "geometry/VCarveCalculator.h"
+#include "utils/RunErrorContext.h"
+#include "utils/UnitConversion.h"
+#include "utils/logging.h"
+
+namespace ChipCarving {
+namespace Core {
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+// Seconds per estimateMedialAxisCost() unit assumed until a run has measured exact profiles
+constexpr double DEFAULT_SECONDS_PER_COST = 1.0e-6;
+
+// Estimates are stretched by this much before they are compared with the time left
+constexpr double ESTIMATE_MARGIN = 1.5;
+
+// One profile of the exact pass
+struct RefineTask {
+  size_t index = 0;             // Position in GenerationJob's vectors
+  double cost = 0.0;            // estimateMedialAxisCost() of its vertices; 0 if its medial axis is stored
+  bool medialResolved = false;  // Analytic shape or cache hit; OpenVoronoi is skipped
+  uint64_t cacheKey = 0;
+  Geometry::MedialAxisResults medial{};
+  Geometry::VCarveResults vcarve{};
+  bool refined = false;
+};
+
+double secondsLeft(Clock::time_point deadline) {
+  return std::chrono::duration<double>(deadline - Clock::now()).count();
+}
+
+}  // namespace
+
+bool PluginManager::AnytimeGeneration::run(const Adapters::SketchSelection& selection,
+                                           const Adapters::MedialAxisParameters& params) {
+  Clock::time_point deadline = Clock::now() + std::chrono::duration_cast<Clock::duration>(
+                                                  std::chrono::duration<double>(params.generationTimeBudget));
+  GenerationJob job;
+  job.params = params;
+  if (params.incrementalRegeneration) {
+    // Coarse toolpaths tagged as exact ones would be kept by the next incremental run
+    LOG_INFO("Time-budgeted generation rewrites every profile; not regenerating incrementally");
+    job.params.incrementalRegeneration = false;
+  }
+  if (!manager_.prepareGenerationJob(selection, job)) {
+    return false;
+  }
+  const Adapters::MedialAxisParameters& exact = job.params;
+  size_t profileCount = job.profilePolygons.size();
+  job.medialResults.assign(profileCount, Geometry::MedialAxisResults());
+  job.vcarveProfiles.assign(profileCount, Geometry::VCarveResults());
+
+  // Stored medial axes are exact already (main thread: caches and analytic shapes)
+  std::vector<RefineTask> tasks(profileCount);
+  for (size_t i = 0; i < profileCount; ++i) {
+    RefineTask& task = tasks[i];
+    task.index = i;
+    size_t vertexCount = job.profilePolygons[i].size();
+    for (const auto& hole : job.profileHoles[i]) {
+      vertexCount += hole.size();
+    }
+    // The analytic shapes and cache keys only describe the outer loop
+    StoredMedialAxis stored =
+        job.profileHoles[i].empty()
+            ? manager_.resolveStoredMedialAxis(job.profilePolygons[i], exact, task.medial, task.cacheKey)
+            : StoredMedialAxis::NONE;
+    countStoredMedialAxis(stored, job.report);
+    task.medialResolved = stored != StoredMedialAxis::NONE;
+    task.cost = task.medialResolved ? 0.0 : Geometry::estimateMedialAxisCost(vertexCount);
+  }
+
+  // Coarse pass: distance-field medial axes and coarse toolpaths for every profile still to compute
+  {
+    Utils::TraceSpan coarseSpan("coarse");
+    std::vector<size_t> coarseIndices;
+    std::vector<std::vector<Geometry::Point2D>> coarsePolygons;
+    std::vector<std::vector<std::vector<Geometry::Point2D>>> coarseHoles;
+    for (const auto& task : tasks) {
+      if (!task.medialResolved) {
+        coarseIndices.push_back(task.index);
+        coarsePolygons.push_back(job.profilePolygons[task.index]);
+        coarseHoles.push_back(job.profileHoles[task.index]);
+      }
+    }
+    // The exact pass's medial threshold and spur pruning at the coarse tolerance
+    Adapters::MedialAxisParameters coarse = coarseToolpathParameters(exact);
+    Geometry::MedialAxisProcessor coarseProcessor(*manager_.medialProcessor_);
+    coarseProcessor.setPolygonTolerance(Utils::mmToFusionLength(coarse.polygonTolerance));
+    std::vector<Geometry::MedialAxisResults> coarseMedial = Geometry::computeDistanceFieldMedialAxisBatch(
+        coarsePolygons, Geometry::distanceFieldOptions(coarseProcessor, exact.medialAxisWorkers),
+        exact.medialAxisWorkers, nullptr, &coarseHoles);
+    std::vector<Geometry::VCarveResults> coarseVCarve;
+    if (exact.generateVCarveToolpaths) {
+      coarseVCarve = manager_.computeVCarveProfiles(coarseMedial, coarse, nullptr, nullptr, nullptr, nullptr,
+                                                    &coarsePolygons, &coarseHoles);
+    }
+    for (size_t k = 0; k < coarseIndices.size(); ++k) {
+      job.medialResults[coarseIndices[k]] = std::move(coarseMedial[k]);
+      if (k < coarseVCarve.size()) {
+        job.vcarveProfiles[coarseIndices[k]] = std::move(coarseVCarve[k]);
+      }
+    }
+  }
+
+  // Exact pass: cheapest first, so the most profiles are exact when the deadline comes
+  std::stable_sort(tasks.begin(), tasks.end(),
+                   [](const RefineTask& a, const RefineTask& b) { return a.cost < b.cost; });
+  double measuredSeconds = 0.0;
+  double measuredCost = 0.0;
+  std::mutex measuredMutex;
+  double priorSecondsPerCost = secondsPerCost_ > 0.0 ? secondsPerCost_ : DEFAULT_SECONDS_PER_COST;
+  auto secondsPerCost = [&]() {
+    std::lock_guard<std::mutex> lock(measuredMutex);
+    return measuredCost > 0.0 ? measuredSeconds / measuredCost : priorSecondsPerCost;
+  };
+
+  Utils::TraceRecorder* recorder = Utils::currentTraceRecorder();
+  const Geometry::MedialAxisProcessor& prototype = *manager_.medialProcessor_;
+  const Geometry::VCarveCheckpoints* checkpoints = manager_.vcarveCheckpoints_.get();
+  Utils::RunErrorContext errors;
+  std::atomic<size_t> nextTask{0};
+  auto worker = [&]() {
+    SetThreadConsoleLoggingSuppressed(true);
+    Utils::ScopedTraceRecorder trace(recorder);
+    Utils::RunErrorContext::Collector errorCollector(errors);
+    Geometry::MedialAxisProcessor processor(prototype);
+    processor.setVerbose(false);
+    Geometry::VCarveCalculator calculator;
+    std::vector<Geometry::SampledMedialPath> sampledPaths;
+
+    for (size_t t = nextTask.fetch_add(1); t < tasks.size(); t = nextTask.fetch_add(1)) {
+      RefineTask& task = tasks[t];
+      // Stored medial axes got no coarse pass, so they always get their exact toolpaths
+      if (!task.medialResolved && task.cost * secondsPerCost() * ESTIMATE_MARGIN > secondsLeft(deadline)) {
+        continue;  // Stays coarse
+      }
+      size_t i = task.index;
+      Clock::time_point start = Clock::now();
+      if (!task.medialResolved) {
+        task.medial = Geometry::computeMedialAxisProfile(processor, job.profilePolygons[i], job.profileHoles[i]);
+      }
+      uint64_t checkpointKey = job.checkpointKeys[i];
+      bool checkpointed = checkpointKey != 0 && checkpoints->load(checkpointKey, task.vcarve);
+      if (!checkpointed && exact.generateVCarveToolpaths && task.medial.success && !task.medial.chains.empty()) {
+        bool sampled = errorCollector.guard(i, "V-carve computation", [&]() {
+          Utils::TraceSpan vcarveSpan("vcarveProfile");
+          sampleMedialAxisForVCarve(processor, task.medial, exact, sampledPaths, &job.profilePolygons[i],
+                                    &job.profileHoles[i], job.samplingDistances[i]);
+          task.vcarve =
+              calculator.generateVCarvePaths(sampledPaths, exact, &task.medial.graph, &task.medial.clearingLoops);
+        });
+        if (!sampled) {
+          task.vcarve = Geometry::VCarveResults();
+        } else if (checkpointKey != 0) {
+          checkpoints->store(checkpointKey, task.vcarve);
+        }
+      }
+      task.refined = true;
+      if (task.cost > 0.0) {
+        std::lock_guard<std::mutex> lock(measuredMutex);
+        measuredSeconds += std::chrono::duration<double>(Clock::now() - start).count();
+        measuredCost += task.cost;
+      }
+    }
+  };
+
+  {
+    Utils::TraceSpan refineSpan("refine");
+    int workerCount = Geometry::resolveMedialAxisWorkerCount(exact.medialAxisWorkers, tasks.size());
+    std::vector<std::thread> workers;
+    for (int t = 0; t < workerCount; ++t) {
+      workers.emplace_back(worker);
+    }
+    for (auto& thread : workers) {
+      thread.join();
+    }
+  }
+  errors.report(manager_.logger_.get());
+  if (measuredCost > 0.0) {
+    secondsPerCost_ = measuredSeconds / measuredCost;
+  }
+
+  // An exact result replaces the coarse one unless OpenVoronoi failed where the distance field did not
+  std::sort(tasks.begin(), tasks.end(), [](const RefineTask& a, const RefineTask& b) { return a.index < b.index; });
+  size_t refinedCount = 0;
+  for (auto& task : tasks) {
+    size_t i = task.index;
+    if (task.refined && !task.medialResolved && job.profileHoles[i].empty()) {
+      manager_.storeMedialAxis(task.cacheKey, task.medial, exact);
+    }
+    if (task.refined && (task.medial.success || !job.medialResults[i].success)) {
+      job.medialResults[i] = std::move(task.medial);
+      job.vcarveProfiles[i] = std::move(task.vcarve);
+      ++refinedCount;
+    } else {
+      job.report.reducedPrecisionProfiles.push_back(job.profileSources[i]);
+    }
+    reportProfileMedialAxis(job, i, job.medialResults[i]);
+  }
+  LOG_INFO("Time budget of " << params.generationTimeBudget << " s: " << refinedCount << " of " << profileCount
+                             << " profiles exact, " << profileCount - refinedCount << " left coarse, "
+                             << secondsLeft(deadline) << " s to spare");
+  return manager_.finishGenerationJob(job);
+}
+
+}  // namespace Core
+}  // namespace ChipCarving
@@ -0,0 +1,302 @@
+/**
+ * PluginManagerBackground.cpp
+ *
+ * Background Generate Paths for PluginManager: the extract and write stages
+ * stay on the main thread (they call Fusion), the compute stage runs on a
+ * worker thread that reports progress and honors cancel requests
+ */
+
+#include <algorithm>
+#include <chrono>
+#include <exception>
+#include <string>
+#include <utility>
+
+#include "PluginManagerHelpers.h"
+#include "utils/logging.h"
+
+namespace ChipCarving {
+namespace Core {
+
+PluginManager::~PluginManager() {
+  background_->abandon();
+}
+
+void PluginManager::BackgroundGeneration::abandon() {
+  if (!job_) {
+    return;
+  }
+  job_->progress.cancel();
+  if (job_->worker.joinable()) {
+    job_->worker.join();
+  }
+  job_.reset();
+  if (manager_.ui_) {
+    manager_.ui_->hideProgress();
+  }
+}
+
+bool PluginManager::BackgroundGeneration::rejectWhileRunning(const std::string& commandName) {
+  if (!job_) {
+    return false;
+  }
+  manager_.ui_->showMessageBox(commandName + " - Busy",
+                      "Generate Paths is still running in the background.\nWait for it to finish or cancel it first.");
+  return true;
+}
+
+bool PluginManager::startMedialAxisGeneration(const Adapters::SketchSelection& selection,
+                                              const Adapters::MedialAxisParameters& params) {
+  if (!initialized_ || background_->rejectWhileRunning("Medial Axis Generation")) {
+    return false;
+  }
+  recordWatchedGeneration(lastGeneration_, selection, params);
+  background_->endRefinement();
+
+  // A background job writes one set of output sketches, so batches over several planes or components and
+  // tiled runs (which write each tile as it finishes) run here, as do time-budgeted runs (which return by then)
+  if (groupSelectionByOutput(selection).size() > 1 || params.spatialTileSize > 0.0 ||
+      params.generationTimeBudget > 0.0) {
+    return executeMedialAxisGeneration(selection, params);
+  }
+  return background_->start(selection, params);
+}
+
+bool PluginManager::BackgroundGeneration::start(const Adapters::SketchSelection& selection,
+                                                const Adapters::MedialAxisParameters& params) {
+  auto job = std::make_unique<GenerationJob>();
+  job->params = params;
+  if (params.progressiveRefinement) {
+    if (canRefineProgressively(params)) {
+      // Coarse toolpaths for every profile first; each batch written starts the next (pumpBackgroundGeneration)
+      refinement_ = std::make_unique<ProgressiveRefinement>();
+      refinement_->selection = selection;
+      refinement_->params = params;
+      refinement_->params.incrementalRegeneration = true;
+      job->params = coarseToolpathParameters(refinement_->params);
+      job->incremental.pass = ProgressivePass::COARSE;
+      job->incremental.otherPassParams = refinement_->params;
+    } else {
+      LOG_INFO("Progressive refinement needs V-carve toolpaths without G-code export or visualization; "
+               "generating exact toolpaths at once");
+    }
+  }
+  if (!startJob(selection, std::move(job))) {
+    refinement_.reset();
+    return false;
+  }
+  return true;
+}
+
+bool PluginManager::BackgroundGeneration::startJob(const Adapters::SketchSelection& selection,
+                                                   std::unique_ptr<GenerationJob> job) {
+  Adapters::IUserInterface* ui = manager_.ui_.get();
+  manager_.lastRunReport_ = RunReport();
+  if (manager_.isChromeTraceEnabled()) {
+    job->trace = std::make_unique<Utils::TraceRecorder>();
+  }
+
+  bool prepared = false;
+  try {
+    Utils::MemorySampler memorySampler;
+    Utils::ScopedRunMetrics runMetrics(job->metrics, job->trace.get());
+    Utils::TraceSpan generateSpan("generatePaths");
+    prepared = manager_.prepareGenerationJob(selection, *job);
+  } catch (const std::exception& e) {
+    ui->showMessageBox("Medial Axis Generation - Error", "Failed to generate medial axis: " + std::string(e.what()));
+  } catch (...) {
+    ui->showMessageBox("Medial Axis Generation - Error", "Unknown error during medial axis generation");
+  }
+  if (!prepared) {
+    manager_.lastRunMetrics_ = job->metrics;
+    manager_.reportRunMetrics(&job->params);
+    return false;
+  }
+
+  ui->showProgress("Generate Paths", "Computing medial axes...", static_cast<int>(job->profilePolygons.size()));
+
+  // The UI only forwards the notification; Fusion then calls pumpBackgroundGeneration() on the main thread
+  job->progress.setListener([ui]() { ui->notifyMainThread(); });
+
+  GenerationJob* running = job.get();
+  job_ = std::move(job);
+  PluginManager& manager = manager_;
+  running->worker = std::thread([&manager, running]() {
+    SetThreadConsoleLoggingSuppressed(true);
+    try {
+      Utils::MemorySampler memorySampler;
+      Utils::ScopedRunMetrics runMetrics(running->metrics, running->trace.get());
+      Utils::TraceSpan generateSpan("generatePaths");
+      manager.computeGenerationJob(*running, &running->progress);
+    } catch (const std::exception& e) {
+      running->errorMessage = e.what();
+    } catch (...) {
+      running->errorMessage = "Unknown error";
+    }
+    running->progress.finish();
+  });
+
+  LOG_INFO("Generate Paths running in the background for " << running->profilePolygons.size() << " profiles");
+  return true;
+}
+
+void PluginManager::BackgroundGeneration::continueRefinement(const GenerationJob& finished, bool written) {
+  if (!refinement_ || finished.incremental.pass == ProgressivePass::NONE) {
+    return;
+  }
+  ProgressiveRefinement& refinement = *refinement_;
+  if (!written) {
+    manager_.logger_->logInfo(
+        "Progressive refinement stopped; profiles without exact toolpaths keep their coarse ones");
+    refinement_.reset();
+    return;
+  }
+
+  refinement.coarseProfiles = finished.incremental.coarseProfiles;
+  if (finished.incremental.pass == ProgressivePass::COARSE) {
+    refinement.profileCount = refinement.selection.selectedProfiles.empty()
+                                  ? refinement.selection.selectedEntityIds.size()
+                                  : refinement.selection.selectedProfiles.size();
+    refinement.batchSize = std::max<size_t>(
+        1, (refinement.coarseProfiles + ProgressiveRefinement::BATCHES - 1) / ProgressiveRefinement::BATCHES);
+  }
+  if (refinement.coarseProfiles == 0) {
+    manager_.logger_->logInfo("Progressive refinement finished: every profile has exact toolpaths");
+    refinement_.reset();
+    return;
+  }
+  LOG_INFO("Progressive refinement: " << refinement.coarseProfiles << " of " << refinement.profileCount
+                                      << " profiles still have coarse toolpaths");
+
+  auto job = std::make_unique<GenerationJob>();
+  job->params = refinement.params;
+  job->incremental.pass = ProgressivePass::REFINE;
+  job->incremental.otherPassParams = coarseToolpathParameters(refinement.params);
+  job->incremental.refineLimit = refinement.batchSize;
+  if (!startJob(refinement.selection, std::move(job))) {
+    refinement_.reset();
+  }
+}
+
+bool PluginManager::speculateMedialAxes(const Adapters::SketchSelection& selection,
+                                        const Adapters::MedialAxisParameters& params) {
+  // A running job's worker owns medialProcessor_, and without the cache nothing could take the results
+  if (!initialized_ || !speculation_ || background_->isRunning() || !params.useMedialAxisCache) {
+    return false;
+  }
+  return speculation_->start(selection, params, *medialProcessor_);
+}
+
+constexpr int PluginManager::DEFAULT_SELECTION_COUNT_INTERVAL_MS;
+
+void PluginManager::reportSelectionCount(int count) {
+  // A window selection changes the selection once per entity; the count shown follows at a readable rate
+  heldSelectionCount_ = count;
+  auto elapsed = std::chrono::steady_clock::now() - selectionCountShownAt_;
+  if (shownSelectionCount_ < 0 || elapsed >= std::chrono::milliseconds(selectionCountIntervalMs_)) {
+    flushSelectionCount();
+  }
+}
+
+void PluginManager::setSelectionCountIntervalMs(int intervalMs) {
+  selectionCountIntervalMs_ = intervalMs;
+}
+
+void PluginManager::flushSelectionCount() {
+  if (heldSelectionCount_ < 0) {
+    return;
+  }
+  if (ui_ && heldSelectionCount_ != shownSelectionCount_) {
+    ui_->updateSelectionCount(heldSelectionCount_);
+    shownSelectionCount_ = heldSelectionCount_;
+    selectionCountShownAt_ = std::chrono::steady_clock::now();
+  }
+  heldSelectionCount_ = -1;
+}
+
+bool PluginManager::pumpBackgroundGeneration() {
+  if (speculation_) {
+    speculation_->pump();
+  }
+  if (background_->isRunning() && background_->pump()) {
+    return true;
+  }
+  // A design saved while the job ran is applied now
+  pumpDesignWatch();
+  return background_->isRunning();
+}
+
+bool PluginManager::isBackgroundGenerationRunning() const {
+  return background_->isRunning();
+}
+
+const ProgressiveRefinement* PluginManager::getProgressiveRefinement() const {
+  return background_->refinement();
+}
+
+bool PluginManager::BackgroundGeneration::pump() {
+  GenerationJob& job = *job_;
+  Adapters::IUserInterface* ui = manager_.ui_.get();
+
+  if (ui->wasProgressCancelled()) {
+    job.progress.cancel();
+  }
+
+  if (!job.progress.isFinished()) {
+    Utils::JobProgress::Snapshot snapshot = job.progress.snapshot();
+    std::string message = std::string(snapshot.cancelled ? "Cancelling" : snapshot.stage) + "... " +
+                          std::to_string(snapshot.completed) + " of " + std::to_string(snapshot.total);
+    if (refinement_ && job.incremental.pass == ProgressivePass::REFINE) {
+      message = "Refining toolpaths (" + std::to_string(refinement_->profileCount - refinement_->coarseProfiles) +
+                " of " + std::to_string(refinement_->profileCount) + " exact): " + message;
+    }
+    ui->updateProgress(message, static_cast<int>(snapshot.completed), static_cast<int>(snapshot.total));
+    return true;
+  }
+
+  // The worker has finished computing, so its state is ours again
+  job.worker.join();
+  std::unique_ptr<GenerationJob> finished = std::move(job_);
+  ui->hideProgress();
+
+  bool written = false;
+  if (finished->progress.isCancelled()) {
+    manager_.logger_->logInfo("Generate Paths cancelled; no sketches were changed");
+  } else if (!finished->errorMessage.empty()) {
+    ui->showMessageBox("Medial Axis Generation - Error", "Failed to generate medial axis: " + finished->errorMessage);
+  } else {
+    try {
+      Utils::MemorySampler memorySampler;
+      Utils::ScopedRunMetrics runMetrics(finished->metrics, finished->trace.get());
+      Utils::TraceSpan generateSpan("generatePaths");
+      Adapters::EntityLookupSession lookups(manager_.workspace_.get());
+      written = manager_.finishGenerationJob(*finished);
+    } catch (const std::exception& e) {
+      ui->showMessageBox("Medial Axis Generation - Error", "Failed to generate medial axis: " + std::string(e.what()));
+    } catch (...) {
+      ui->showMessageBox("Medial Axis Generation - Error", "Unknown error during medial axis generation");
+    }
+  }
+
+  manager_.lastRunMetrics_ = finished->metrics;
+  manager_.reportRunMetrics(&finished->params);
+  if (finished->trace) {
+    manager_.writeChromeTrace(*finished->trace);
+  }
+  // The next batch of a progressive run starts as soon as one is written
+  continueRefinement(*finished, written);
+  return false;
+}
+
+void PluginManager::cancelBackgroundGeneration() {
+  background_->cancel();
+}
+
+void PluginManager::BackgroundGeneration::cancel() {
+  if (job_) {
+    job_->progress.cancel();
+  }
+}
+
+}  // namespace Core
+}  // namespace ChipCarving
@@ -0,0 +1,192 @@
+/**
+ * PluginManagerBatch.cpp
+ *
+ * Batch Generate Paths for PluginManager: a selection spanning several sketch
+ * planes or components is split into output groups. Every group is extracted
+ * in one entity lookup session and all their profiles are computed in one
+ * parallel medial axis and V-carve pass; each group's sketches are then
+ * written in a single pass on its own plane. Tiled runs instead generate
+ * each grid tile of the selection end to end before starting the next.
+ */
+
+#include <map>
+#include <set>
+#include <string>
+#include <unordered_set>
+#include <utility>
+#include <vector>
+
+#include "PluginManager.h"
+#include "SpatialTiling.h"
+#include "utils/UnitConversion.h"
+#include "utils/logging.h"
+
+namespace ChipCarving {
+namespace Core {
+
+namespace {
+
+// The group's sketch names, "Top, Lid", or "Group 2" if it has none; labels name the group's sketches
+std::string groupLabel(const Adapters::SketchSelection& group, size_t index) {
+  std::string label;
+  std::set<std::string> seen;
+  for (const auto& profile : group.selectedProfiles) {
+    if (!profile.sketchName.empty() && seen.insert(profile.sketchName).second) {
+      label += (label.empty() ? "" : ", ") + profile.sketchName;
+    }
+  }
+  return label.empty() ? "Group " + std::to_string(index + 1) : label;
+}
+
+// Move count elements of from, starting at first, to the end of into
+template <typename T>
+void moveRange(std::vector<T>& from, size_t first, size_t count, std::vector<T>& into) {
+  if (first + count > from.size()) {
+    return;
+  }
+  for (size_t i = first; i < first + count; ++i) {
+    into.push_back(std::move(from[i]));
+  }
+}
+
+}  // namespace
+
+std::vector<Adapters::SketchSelection> groupSelectionByOutput(const Adapters::SketchSelection& selection) {
+  if (selection.selectedProfiles.empty()) {
+    return {selection};
+  }
+
+  std::vector<Adapters::SketchSelection> groups;
+  std::map<std::pair<std::string, std::string>, size_t> groupByTarget;
+  for (size_t i = 0; i < selection.selectedProfiles.size(); ++i) {
+    const Adapters::ProfileGeometry& profile = selection.selectedProfiles[i];
+    auto found = groupByTarget.emplace(std::make_pair(profile.planeEntityId, profile.componentEntityId), groups.size());
+    if (found.second) {
+      groups.emplace_back();
+      groups.back().isValid = selection.isValid;
+      groups.back().errorMessage = selection.errorMessage;
+    }
+    Adapters::SketchSelection& group = groups[found.first->second];
+    group.selectedProfiles.push_back(profile);
+    if (i < selection.selectedEntityIds.size()) {
+      group.selectedEntityIds.push_back(selection.selectedEntityIds[i]);
+    }
+    group.closedPathCount++;
+  }
+  return groups;
+}
+
+bool PluginManager::runBatchGeneration(const std::vector<Adapters::SketchSelection>& groups,
+                                       const Adapters::MedialAxisParameters& params) {
+  LOG_INFO("Batch Generate Paths over " << groups.size() << " sketch planes and components");
+
+  // Each group's sketches, G-code and review SVG are named after its sketches
+  std::vector<GenerationJob> jobs(groups.size());
+  std::set<std::string> labels;
+  for (size_t g = 0; g < groups.size(); ++g) {
+    std::string label = groupLabel(groups[g], g);
+    if (!labels.insert(label).second) {
+      label += " (" + std::to_string(g + 1) + ")";
+      labels.insert(label);
+    }
+    jobs[g].params = params;
+    jobs[g].params.toolName = params.toolName + " - " + label;
+    if (!params.gcodeExportPath.empty()) {
+      jobs[g].params.gcodeExportPath = suffixedExportPath(params.gcodeExportPath, label);
+    }
+    if (!params.svgExportPath.empty()) {
+      jobs[g].params.svgExportPath = suffixedExportPath(params.svgExportPath, label);
+    }
+  }
+
+  // Extract every group in one lookup session, then compute all their profiles together
+  Adapters::EntityLookupSession lookups(workspace_.get());
+  GenerationJob batch;
+  batch.params = params;
+  std::vector<size_t> profileCounts(groups.size(), 0);
+  for (size_t g = 0; g < groups.size(); ++g) {
+    if (!prepareGenerationJob(groups[g], jobs[g])) {
+      return false;
+    }
+    GenerationJob& job = jobs[g];
+    profileCounts[g] = job.profilePolygons.size();
+    moveRange(job.profilePolygons, 0, profileCounts[g], batch.profilePolygons);
+    moveRange(job.profileHoles, 0, profileCounts[g], batch.profileHoles);
+    moveRange(job.profileSources, 0, profileCounts[g], batch.profileSources);
+    moveRange(job.checkpointKeys, 0, profileCounts[g], batch.checkpointKeys);
+    moveRange(job.samplingDistances, 0, profileCounts[g], batch.samplingDistances);
+    job.profilePolygons.clear();
+    job.profileHoles.clear();
+    job.profileSources.clear();
+    job.checkpointKeys.clear();
+    job.samplingDistances.clear();
+  }
+  computeGenerationJob(batch, nullptr);
+  lastRunReport_.merge(batch.report);
+
+  // Hand each group its profiles back and write its sketches in one pass
+  bool written = true;
+  size_t first = 0;
+  for (size_t g = 0; g < groups.size(); ++g) {
+    GenerationJob& job = jobs[g];
+    size_t count = profileCounts[g];
+    moveRange(batch.profilePolygons, first, count, job.profilePolygons);
+    moveRange(batch.profileHoles, first, count, job.profileHoles);
+    moveRange(batch.medialResults, first, count, job.medialResults);
+    moveRange(batch.vcarveProfiles, first, count, job.vcarveProfiles);
+    moveRange(batch.sampledPaths, first, count, job.sampledPaths);
+    moveRange(batch.checkpointKeys, first, count, job.checkpointKeys);
+    first += count;
+    LOG_INFO("Writing " << count << " profiles of " << job.params.toolName);
+    written = finishGenerationJob(job) && written;
+  }
+  return written;
+}
+
+bool PluginManager::runTiledGeneration(const Adapters::SketchSelection& selection,
+                                       const Adapters::MedialAxisParameters& params) {
+  std::vector<SelectionTile> tiles =
+      splitSelectionIntoTiles(selection, Utils::mmToFusionLength(params.spatialTileSize));
+  std::unordered_set<std::string> finished;
+  if (!params.tileJournalPath.empty() && params.resumeTiledRun) {
+    finished = loadTileJournal(params.tileJournalPath);
+  } else if (!params.tileJournalPath.empty() && !clearTileJournal(params.tileJournalPath)) {
+    LOG_WARNING("Cannot write tile journal " << params.tileJournalPath);
+  }
+  LOG_INFO("Tiled Generate Paths: " << tiles.size() << " tiles of " << params.spatialTileSize << " mm");
+
+  // One tile at a time: its profiles, medial axes, toolpaths and heightfield window are released before the next
+  Adapters::EntityLookupSession lookups(workspace_.get());
+  size_t skipped = 0;
+  for (const auto& tile : tiles) {
+    GenerationJob job;
+    job.params = params;
+    job.params.toolName = params.toolName + " - " + tile.label;
+    if (!params.gcodeExportPath.empty()) {
+      job.params.gcodeExportPath = suffixedExportPath(params.gcodeExportPath, tile.label);
+    }
+    if (!params.svgExportPath.empty()) {
+      job.params.svgExportPath = suffixedExportPath(params.svgExportPath, tile.label);
+    }
+
+    std::string key = tileJournalKey(tile, params);
+    if (finished.count(key) > 0) {
+      ++skipped;
+      continue;
+    }
+    LOG_INFO("Generating " << tile.label << ": " << tile.selection.closedPathCount << " profiles");
+    if (!beginGenerationJob(tile.selection, job) || !runGenerationPipeline(tile.selection, job)) {
+      return false;
+    }
+    if (!params.tileJournalPath.empty() && !appendTileJournal(params.tileJournalPath, key)) {
+      LOG_WARNING("Cannot record " << tile.label << " in tile journal " << params.tileJournalPath);
+    }
+  }
+  if (skipped > 0) {
+    logger_->logInfo("Resumed tiled run: skipped " + std::to_string(skipped) + " tiles finished earlier");
+  }
+  return true;
+}
+
+}  // namespace Core
+}  // namespace ChipCarving
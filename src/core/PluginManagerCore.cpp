@@ -5,13 +5,27 @@
  * Split from PluginManager.cpp for maintainability
  */
 
-#include "PluginManager.h"
+#include <cstdint>
+#include <string>
+
+#include "PluginManagerHelpers.h"
+#include "utils/PlatformTrace.h"
 #include "utils/logging.h"
 #include "version.h"
 namespace ChipCarving {
 namespace Core {
 
-PluginManager::PluginManager(std::unique_ptr<Adapters::IFusionFactory> factory) : factory_(std::move(factory)) {}
+namespace {
+
+constexpr uint64_t BYTES_PER_MB = 1024 * 1024;
+
+}  // namespace
+
+PluginManager::PluginManager(std::unique_ptr<Adapters::IFusionFactory> factory)
+    : factory_(std::move(factory)),
+      background_(std::make_unique<BackgroundGeneration>(*this)),
+      anytime_(std::make_unique<AnytimeGeneration>(*this)),
+      surface_(std::make_unique<SurfaceProjection>(*this)) {}
 
 bool PluginManager::initialize() {
   if (initialized_) {
@@ -37,12 +51,23 @@ bool PluginManager::initialize() {
     // Initialize MedialAxisProcessor with default parameters
     medialProcessor_ = std::make_unique<Geometry::MedialAxisProcessor>(0.25, 0.8);
     medialProcessor_->setVerbose(true);  // Enable verbose logging to debug crash
+    medialCache_ = std::make_unique<Geometry::MedialAxisCache>(
+        static_cast<size_t>(performanceSettings_.medialCacheMb * BYTES_PER_MB));
+    preview_ = std::make_unique<PreviewGeneration>(ui_.get(), workspace_.get(),
+                                                   medialProcessor_->getMedialThreshold());
+    speculation_ = std::make_unique<SpeculativeMedialAxis>(ui_.get());
 
     // Log startup (file logs have been removed)
 
     logStartup();
     initialized_ = true;
 
+    // A settings file set before initialization is read now, once the caches it sizes exist
+    if (!performanceSettingsFile_.empty()) {
+      std::string settingsFile = performanceSettingsFile_;
+      setPerformanceSettingsFile(settingsFile);
+    }
+
     return true;
   } catch (const std::exception& e) {
     LOG_ERROR("Exception during initialization: " << e.what());
@@ -61,6 +86,15 @@ void PluginManager::shutdown() {
   try {
     logShutdown();
 
+    // The worker reports to ui_, so it must stop before the UI goes away
+    background_->abandon();
+    if (preview_) {
+      preview_->clear();
+      preview_.reset();
+    }
+    speculation_.reset();
+    designWatch_.reset();
+
     // Clean up resources
     workspace_.reset();
     ui_.reset();
@@ -75,6 +109,59 @@ void PluginManager::shutdown() {
   }
 }
 
+void PluginManager::invalidateEntityLookups() {
+  // A progressive run's selection names entities of the document being left
+  background_->endRefinement();
+  if (workspace_) {
+    workspace_->invalidateEntityLookups();
+  }
+}
+
+bool PluginManager::setPerformanceSettings(const PerformanceSettings& settings) {
+  // The caches belong to a running job's worker
+  if (background_->rejectWhileRunning("Settings")) {
+    return false;
+  }
+  performanceSettings_ = settings;
+  performanceSettings_.sanitize();
+  Utils::setPlatformTraceEnabled(performanceSettings_.platformTrace);
+
+  if (medialCache_) {
+    medialCache_->setMaxBytes(static_cast<size_t>(performanceSettings_.medialCacheMb * BYTES_PER_MB));
+  }
+  if (!medialDiskCache_ || medialDiskCache_->getDirectory() != performanceSettings_.diskCacheDirectory ||
+      medialDiskCache_->isShared() != performanceSettings_.diskCacheShared) {
+    setMedialAxisCacheDirectory(performanceSettings_.diskCacheDirectory, performanceSettings_.diskCacheShared);
+  }
+  if (medialDiskCache_ && performanceSettings_.diskCacheMb > 0) {
+    uint64_t diskBytes = medialDiskCache_->trim(performanceSettings_.diskCacheMb * BYTES_PER_MB);
+    LOG_INFO("Medial axis disk cache holds " << diskBytes / BYTES_PER_MB << " of " << performanceSettings_.diskCacheMb
+                                             << " MB");
+  }
+
+  if (!performanceSettingsFile_.empty() &&
+      !savePerformanceSettings(performanceSettingsFile_, performanceSettings_)) {
+    LOG_WARNING("Cannot save performance settings to " << performanceSettingsFile_);
+    return false;
+  }
+  return true;
+}
+
+void PluginManager::setPerformanceSettingsFile(const std::string& filePath) {
+  if (!initialized_) {
+    performanceSettingsFile_ = filePath;
+    return;
+  }
+  PerformanceSettings settings;
+  if (!filePath.empty() && loadPerformanceSettings(filePath, settings)) {
+    LOG_INFO("Loaded performance settings from " << filePath);
+  }
+  // Loaded settings are applied before the file is set, so loading never rewrites it
+  performanceSettingsFile_.clear();
+  setPerformanceSettings(settings);
+  performanceSettingsFile_ = filePath;
+}
+
 std::string PluginManager::getVersion() const {
   return ADDIN_VERSION_STRING;
 }
@@ -0,0 +1,167 @@
+/**
+ * PluginManagerHelpers.h
+ *
+ * Helpers of PluginManager (internal to src/core): background, progressive
+ * and time-budgeted Generate Paths runs, surface height queries, the
+ * per-profile V-carve sampling and checkpoint functions, and the output
+ * sketches. The classes are nested in PluginManager, so they use its stages
+ * and adapters directly.
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "GenerationJob.h"
+#include "IncrementalRegeneration.h"
+#include "PluginManager.h"
+#include "geometry/MedialAxisProcessor.h"
+#include "geometry/ScannedSurface.h"
+#include "geometry/SurfaceHeightfield.h"
+#include "geometry/VCarveCheckpoints.h"
+
+namespace ChipCarving {
+namespace Core {
+
+// The running background job, and the progressive run whose batches follow it
+class PluginManager::BackgroundGeneration {
+ public:
+  explicit BackgroundGeneration(PluginManager& manager) : manager_(manager) {}
+
+  bool isRunning() const {
+    return job_ != nullptr;
+  }
+  const ProgressiveRefinement* refinement() const {
+    return refinement_.get();
+  }
+  void endRefinement() {
+    refinement_.reset();
+  }
+
+  // Show that a job is running and return true, or return false if none is
+  bool rejectWhileRunning(const std::string& commandName);
+
+  // Start params' run in the background, progressively if it asks to be; false if it could not start
+  bool start(const Adapters::SketchSelection& selection, const Adapters::MedialAxisParameters& params);
+
+  // Main-thread tick of the running job; true while it still computes. A finished job is written,
+  // and the next refinement batch of a progressive run started
+  bool pump();
+
+  void cancel();
+
+  // Cancel and join the running job without applying its results
+  void abandon();
+
+ private:
+  // Prepare job on the main thread and start its compute stage on a worker; false if it could not start
+  bool startJob(const Adapters::SketchSelection& selection, std::unique_ptr<GenerationJob> job);
+  // After a progressive run's job: start its next refinement batch, or end the run
+  void continueRefinement(const GenerationJob& finished, bool written);
+
+  PluginManager& manager_;
+  // Medial processor, caches and imported shapes are this job's worker's until it is joined
+  std::unique_ptr<GenerationJob> job_{};
+  std::unique_ptr<ProgressiveRefinement> refinement_{};
+};
+
+// Generate Paths within params.generationTimeBudget (see PluginManagerAnytime.cpp)
+class PluginManager::AnytimeGeneration {
+ public:
+  explicit AnytimeGeneration(PluginManager& manager) : manager_(manager) {}
+
+  // Coarse toolpaths for every profile first, then exact ones cheapest profile first while they are
+  // expected to finish in time
+  bool run(const Adapters::SketchSelection& selection, const Adapters::MedialAxisParameters& params);
+
+ private:
+  PluginManager& manager_;
+  double secondsPerCost_ = 0.0;  // Exact profile time per medial axis cost unit last measured (0 = none)
+};
+
+// Target surface or scanned blank heights for surface-projected toolpaths (see PluginManagerSurfaceProjection.cpp)
+class PluginManager::SurfaceProjection {
+ public:
+  explicit SurfaceProjection(PluginManager& manager) : manager_(manager) {}
+
+  /**
+   * Sample the target surface on a regular grid covering all medial axes into heightfield
+   * @return true if params.surfaceGridResolution is set and sampling succeeded (heightfield is written only then)
+   */
+  bool buildHeightfield(const std::vector<Geometry::MedialAxisResults>& medialResults,
+                        const Adapters::MedialAxisParameters& params, Geometry::SurfaceHeightfield& heightfield);
+
+  /**
+   * Target surface Z (cm) at each XY point (cm), NaN where there is no surface
+   * Interpolates from the heightfield (with its dz/dx, dz/dy in gradients) when given, querying the workspace
+   * only for points the grid cannot answer (NaN gradients); with a memo, no XY is queried twice
+   */
+  std::vector<double> queryHeights(const std::vector<Geometry::Point2D>& points,
+                                   const Adapters::MedialAxisParameters& params,
+                                   const Geometry::SurfaceHeightfield* heightfield,
+                                   Geometry::SurfaceHeightMemo* memo = nullptr,
+                                   std::vector<Geometry::Point2D>* gradients = nullptr);
+
+  // Surface Z (cm) at points (cm) from the scanned blank if one is set, else the target surface
+  std::vector<double> query(const std::vector<Geometry::Point2D>& points, const Adapters::MedialAxisParameters& params);
+
+ private:
+  PluginManager& manager_;
+  Geometry::ScannedSurfaceCache scans_{};  // Scanned blank of params.surfaceScanPath, kept between runs
+};
+
+// Number of profiles PluginManager::extractProfileAt() can be asked for
+size_t selectionProfileCount(const Adapters::SketchSelection& selection);
+
+/**
+ * Sample one profile's medial axis (mm) for V-carving, at the fixed sampling
+ * distance or adaptively by chord error when params.adaptiveSampling is set
+ * @param processor Medial processor owned by the calling thread
+ * @param sampledPaths Output; cleared and refilled
+ * @param outline, holes The profile's loops (cm); with params.forceBoundaryIntersections fixed-distance
+ *        sampling also samples exactly where a chain crosses one of them, and with params.exactSampling
+ *        clearances are measured to them
+ * @param samplingDistance The profile's own sampling distance (mm; 0 = params.samplingDistance)
+ */
+void sampleMedialAxisForVCarve(Geometry::MedialAxisProcessor& processor,
+                               const Geometry::MedialAxisResults& medialResult,
+                               const Adapters::MedialAxisParameters& params,
+                               std::vector<Geometry::SampledMedialPath>& sampledPaths,
+                               const std::vector<Geometry::Point2D>* outline = nullptr,
+                               const std::vector<std::vector<Geometry::Point2D>>* holes = nullptr,
+                               double samplingDistance = 0.0);
+
+/**
+ * Checkpoint key of a profile's V-carve paths: its toolpath tag as a number
+ * @return 0 if the run keeps no checkpoints
+ */
+uint64_t vcarveCheckpointKey(const Geometry::VCarveCheckpoints* checkpoints,
+                             const std::vector<Geometry::Point2D>& polygon,
+                             const std::vector<std::vector<Geometry::Point2D>>& holes,
+                             const Adapters::IWorkspace::TransformParams& transform,
+                             const Adapters::MedialAxisParameters& params);
+
+// Delete the checkpoints of a written job
+void removeVCarveCheckpoints(Geometry::VCarveCheckpoints* checkpoints, const GenerationJob& job);
+
+// Sketch on the selected target surface's component, else the design's plane. The
+// run's sketches share one output session: one timeline group, or one base feature
+std::unique_ptr<Adapters::ISketch> createOutputSketch(Adapters::IWorkspace* workspace, const std::string& name,
+                                                      const Adapters::MedialAxisParameters& params,
+                                                      const std::string& sourcePlaneId,
+                                                      const std::string& importedPlaneId, GenerationOutput& output);
+
+// Delete the toolpath sketches after lastShard that an earlier run spread its paths across,
+// which createOutputSketch() would have reused; returns how many were deleted
+size_t deleteStaleToolpathShards(Adapters::IWorkspace* workspace, const Adapters::MedialAxisParameters& params,
+                                 size_t lastShard, const std::string& sourcePlaneId,
+                                 const std::string& importedPlaneId);
+
+// End the toolpath sketch's bulk edit, solving it if this run wrote to it
+void closeVCarveSketch(GenerationOutput& output);
+
+}  // namespace Core
+}  // namespace ChipCarving
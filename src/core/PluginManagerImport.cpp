@@ -1,27 +1,173 @@
 /**
  * PluginManagerImport.cpp
  *
- * Import design functionality for PluginManager
+ * Import design functionality for PluginManager; several files are parsed
+ * on worker threads, then each is drawn into its own sketch
  * Split from PluginManager.cpp for maintainability
  */
 
-#include <chrono>
+#include <atomic>
+#include <exception>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
 
-#include "PluginManager.h"
+#include "ImportDiff.h"
+#include "PluginManagerHelpers.h"
+#include "geometry/MedialAxisBatch.h"
+#include "geometry/ShapeOutlineBatch.h"
 #include "parsers/DesignParser.h"
 #include "utils/logging.h"
 
 namespace ChipCarving {
 namespace Core {
 
+namespace {
+
+std::string fileName(const std::string& path) {
+  size_t slash = path.find_last_of("/\\");
+  return slash == std::string::npos ? path : path.substr(slash + 1);
+}
+
+// Shapes are all the import needs; background photos stay in the mapped file
+Parsers::DesignParseOptions importParseOptions() {
+  Parsers::DesignParseOptions options;
+  options.deferBackgroundImageData = true;
+  return options;
+}
+
+// Buffers a worker's parse messages so they reach the Fusion logger from the main thread
+class DeferredLogger : public Adapters::ILogger {
+ public:
+  void logInfo(const std::string& message) const override {
+    messages_.emplace_back(&Adapters::ILogger::logInfo, message);
+  }
+  void logDebug(const std::string& message) const override {
+    messages_.emplace_back(&Adapters::ILogger::logDebug, message);
+  }
+  void logWarning(const std::string& message) const override {
+    messages_.emplace_back(&Adapters::ILogger::logWarning, message);
+  }
+  void logError(const std::string& message) const override {
+    messages_.emplace_back(&Adapters::ILogger::logError, message);
+  }
+
+  void replay(const Adapters::ILogger* logger) const {
+    for (const auto& message : messages_) {
+      if (logger) {
+        (logger->*message.first)(message.second);
+      }
+    }
+  }
+
+ private:
+  using LogMethod = void (Adapters::ILogger::*)(const std::string&) const;
+  mutable std::vector<std::pair<LogMethod, std::string>> messages_{};
+};
+
+// Parse every file on worker threads; the first failure, in file order, is thrown with its file name
+std::vector<Parsers::DesignFile> parseDesignFiles(const std::vector<std::string>& filePaths,
+                                                  const Adapters::ILogger* logger) {
+  std::vector<Parsers::DesignFile> designs(filePaths.size());
+  std::vector<DeferredLogger> fileLoggers(filePaths.size());
+  std::vector<std::string> errors(filePaths.size());
+  std::atomic<size_t> nextFile{0};
+  Utils::TraceRecorder* recorder = Utils::currentTraceRecorder();
+  auto parseFiles = [&]() {
+    for (size_t f = nextFile.fetch_add(1); f < filePaths.size(); f = nextFile.fetch_add(1)) {
+      try {
+        designs[f] = Parsers::DesignParser::parseFromFile(filePaths[f], importParseOptions(), &fileLoggers[f]);
+      } catch (const std::exception& e) {
+        errors[f] = e.what();
+      } catch (...) {
+        errors[f] = "Unknown parse error";
+      }
+    }
+  };
+
+  // A single file is parsed on the calling thread, where run metrics see its allocations
+  int workerCount = Geometry::resolveMedialAxisWorkerCount(0, filePaths.size());
+  if (workerCount <= 1) {
+    parseFiles();
+  } else {
+    std::vector<std::thread> workers;
+    for (int w = 0; w < workerCount; ++w) {
+      workers.emplace_back([&]() {
+        SetThreadConsoleLoggingSuppressed(true);
+        Utils::ScopedTraceRecorder threadTrace(recorder);
+        parseFiles();
+      });
+    }
+    for (auto& thread : workers) {
+      thread.join();
+    }
+  }
+
+  for (size_t f = 0; f < filePaths.size(); ++f) {
+    fileLoggers[f].replay(logger);
+    if (!errors[f].empty()) {
+      throw std::runtime_error(filePaths.size() > 1 ? fileName(filePaths[f]) + ": " + errors[f] : errors[f]);
+    }
+  }
+  return designs;
+}
+
+// Gather the outlines of shapes first + indices into one batch so the sketch gets each shared
+// vertex once and no arc midpoint points; shapes without boundary edges draw themselves.
+// tags, if not empty, holds each shape's curve tag by index.
+void drawImportedShapes(Adapters::ISketch* sketch, const Geometry::ShapeStore& shapes, size_t first,
+                        const std::vector<size_t>& indices, const std::vector<std::string>& tags,
+                        Adapters::ILogger* logger) {
+  Geometry::ShapeOutlineBatch batch;
+  size_t fallbackShapes = 0;
+  for (size_t index : indices) {
+    if (first + index >= shapes.size()) {
+      continue;
+    }
+    const Geometry::Shape& shape = shapes.at(first + index);
+    const std::string& tag = index < tags.size() ? tags[index] : std::string();
+    try {
+      Utils::TraceSpan shapeSpan("addShape");
+      if (!batch.addShape(shape, tag)) {
+        sketch->setCurveTag(tag, "");
+        sketch->addShape(&shape, logger);
+        sketch->setCurveTag("", "");
+        ++fallbackShapes;
+      }
+    } catch (const std::exception& e) {
+      (void)e;  // Continue with other shapes
+    }
+  }
+  if (batch.edges().empty()) {
+    return;
+  }
+
+  Utils::TraceSpan batchSpan("outlineBatch");
+  int curves = sketch->addOutlineBatch(batch);
+  LOG_INFO("Imported " << indices.size() << " shapes as " << curves << " curves on " << batch.vertices().size()
+                       << " points (" << batch.sharedVertexCount() << " shared vertices, " << fallbackShapes
+                       << " shapes drawn individually)");
+}
+
+std::vector<size_t> shapeIndices(size_t count) {
+  std::vector<size_t> indices(count);
+  for (size_t i = 0; i < count; ++i) {
+    indices[i] = i;
+  }
+  return indices;
+}
+
+}  // namespace
+
 bool PluginManager::executeImportDesign() {
-  if (!initialized_) {
+  // Imported shapes feed the analytic medial axis of a running background job
+  if (!initialized_ || background_->rejectWhileRunning("Import Design")) {
     return false;
   }
 
   try {
-    auto totalStart = std::chrono::high_resolution_clock::now();
-
     // Get file selection from user
     std::string filePath = ui_->showFileDialog("Select Design File", "JSON Files (*.json)");
 
@@ -29,58 +175,49 @@ bool PluginManager::executeImportDesign() {
       return true;  // User cancelled, not an error
     }
 
-    // Read and parse the design file
-    auto parseStart = std::chrono::high_resolution_clock::now();
-    auto design = Parsers::DesignParser::parseFromFile(filePath, logger_.get());
-    auto parseEnd = std::chrono::high_resolution_clock::now();
-    auto parseDuration = std::chrono::duration_cast<std::chrono::milliseconds>(parseEnd - parseStart);
-    logger_->logInfo("⏱️ JSON parsing took: " + std::to_string(parseDuration.count()) + "ms");
+    lastRunMetrics_.clear();
+    lastRunReport_ = RunReport();
+    {
+      Utils::MemorySampler memorySampler;
+      Utils::ScopedRunMetrics runMetrics(lastRunMetrics_);
+      Utils::TraceSpan importSpan("importDesign");
 
-    // Clear previous imports
-    importedShapes_.clear();
+      // Read and parse the design file
+      Parsers::DesignFile design;
+      {
+        Utils::TraceSpan parseSpan("parse");
+        design = Parsers::DesignParser::parseFromFile(filePath, importParseOptions(), logger_.get());
+      }
 
-    // Store shapes for medial axis processing
-    for (auto& shape : design.shapes) {
-      try {
-        // Move shape to our storage (transfer ownership)
-        importedShapes_.push_back(std::move(shape));
-      } catch (const std::exception& e) {
-        (void)e;  // Continue with other shapes
+      // Clear previous imports
+      importedShapes_.clear();
+      importedDesignHash_.clear();
+
+      // Copy shapes into the per-type arrays for medial axis processing
+      for (const auto& shape : design.shapes) {
+        if (shape) {
+          importedShapes_.add(*shape);
+        }
       }
-    }
 
-    // Store the file path for reference
-    lastImportedFile_ = filePath;
+      indexImportedShapes();
 
-    // Create sketch from stored shapes for visualization
-    auto sketchStart = std::chrono::high_resolution_clock::now();
-    auto sketch = workspace_->createSketch("Imported Design");
-    if (!sketch) {
-      throw std::runtime_error("Failed to create sketch in workspace");
-    }
+      // Store the file path for reference
+      lastImportedFile_ = filePath;
 
-    // Add each stored shape to the sketch
-    for (size_t i = 0; i < importedShapes_.size(); ++i) {
-      const auto& shape = importedShapes_[i];
-      try {
-        auto shapeStart = std::chrono::high_resolution_clock::now();
-        sketch->addShape(shape.get(), logger_.get());
-        auto shapeEnd = std::chrono::high_resolution_clock::now();
-        auto shapeDuration = std::chrono::duration_cast<std::chrono::milliseconds>(shapeEnd - shapeStart);
-        logger_->logInfo("⏱️ Shape " + std::to_string(i) + " drawing took: " + std::to_string(shapeDuration.count()) +
-                         "ms");
-      } catch (const std::exception& e) {
-        (void)e;  // Continue with other shapes
+      // Create sketch from stored shapes for visualization
+      Utils::TraceSpan sketchSpan("sketch");
+      auto sketch = workspace_->createSketch("Imported Design");
+      if (!sketch) {
+        throw std::runtime_error("Failed to create sketch in workspace");
       }
-    }
 
-    auto sketchEnd = std::chrono::high_resolution_clock::now();
-    auto sketchDuration = std::chrono::duration_cast<std::chrono::milliseconds>(sketchEnd - sketchStart);
-    logger_->logInfo("⏱️ Total sketch creation took: " + std::to_string(sketchDuration.count()) + "ms");
+      // Solve the sketch once after all shapes are drawn
+      Adapters::SketchBulkEdit bulkEdit(sketch.get());
 
-    auto totalEnd = std::chrono::high_resolution_clock::now();
-    auto totalDuration = std::chrono::duration_cast<std::chrono::milliseconds>(totalEnd - totalStart);
-    logger_->logInfo("⏱️ TOTAL IMPORT took: " + std::to_string(totalDuration.count()) + "ms");
+      drawImportedShapes(sketch.get(), importedShapes_, 0, shapeIndices(importedShapes_.size()), {}, logger_.get());
+    }
+    reportRunMetrics();
 
     // Log completion (no popup)
     return true;
@@ -96,60 +233,105 @@ bool PluginManager::executeImportDesign() {
 }
 
 bool PluginManager::executeImportDesign(const std::string& filePath, const std::string& planeEntityId) {
-  if (!initialized_) {
+  if (filePath.empty()) {
+    return false;
+  }
+  return executeImportDesigns({filePath}, planeEntityId);
+}
+
+bool PluginManager::executeImportDesigns(const std::vector<std::string>& filePaths, const std::string& planeEntityId,
+                                         bool updatePrevious) {
+  return importDesigns(filePaths, nullptr, planeEntityId, updatePrevious);
+}
+
+bool PluginManager::importDesigns(const std::vector<std::string>& filePaths, std::vector<Parsers::DesignFile>* parsed,
+                                  const std::string& planeEntityId, bool updatePrevious) {
+  if (!initialized_ || background_->rejectWhileRunning("Import Design")) {
     return false;
   }
 
   try {
-    if (filePath.empty()) {
+    if (filePaths.empty()) {
       return false;
     }
 
-    // Read and parse the design file
-    auto design = Parsers::DesignParser::parseFromFile(filePath, logger_.get());
+    lastRunMetrics_.clear();
+    lastRunReport_ = RunReport();
+    {
+      Utils::MemorySampler memorySampler;
+      Utils::ScopedRunMetrics runMetrics(lastRunMetrics_);
+      Utils::TraceSpan importSpan("importDesign");
 
-    // Clear previous imports
-    importedShapes_.clear();
+      // Read and parse every design file before anything is drawn
+      std::vector<Parsers::DesignFile> designs;
+      if (parsed) {
+        designs = std::move(*parsed);
+      } else {
+        Utils::TraceSpan parseSpan("parse");
+        designs = parseDesignFiles(filePaths, logger_.get());
+      }
 
-    // Store shapes for medial axis processing
-    for (auto& shape : design.shapes) {
-      try {
-        // Move shape to our storage (transfer ownership)
-        importedShapes_.push_back(std::move(shape));
-      } catch (const std::exception& e) {
-        (void)e;  // Continue with other shapes
+      // Clear previous imports and store the shapes of every file for medial axis processing
+      importedShapes_.clear();
+      importedDesignHash_.clear();
+      std::vector<size_t> firstShapes;
+      for (auto& design : designs) {
+        firstShapes.push_back(importedShapes_.size());
+      indexImportedShapes();
+        for (const auto& shape : design.shapes) {
+          if (shape) {
+            importedShapes_.add(*shape);
+          }
+        }
       }
-    }
+      firstShapes.push_back(importedShapes_.size());
 
-    // Store the file path and plane entity ID for reference
-    lastImportedFile_ = filePath;
-    lastImportedPlaneEntityId_ = planeEntityId;
+      // Only a re-import of the last imported file onto the same plane updates its earlier sketch
+      bool reimport = updatePrevious && filePaths.size() == 1 && filePaths.front() == lastImportedFile_ &&
+                      planeEntityId == lastImportedPlaneEntityId_;
 
-    // Debug logging
-    LOG_DEBUG("Stored plane entity ID during import: '" << planeEntityId << "' (length: " << planeEntityId.length()
-                                                        << ")");
+      // Store the file path and plane entity ID for reference
+      lastImportedFile_ = filePaths.back();
+      lastImportedPlaneEntityId_ = planeEntityId;
+      LOG_DEBUG("Stored plane entity ID during import: '" << planeEntityId << "' (length: " << planeEntityId.length()
+                                                          << ")");
 
-    // Create sketch on specified plane or XY plane
-    std::unique_ptr<Adapters::ISketch> sketch;
-    if (!planeEntityId.empty()) {
-      sketch = workspace_->createSketchOnPlane("Imported Design", planeEntityId);
-    } else {
-      sketch = workspace_->createSketch("Imported Design");
-    }
+      // One sketch per file on the specified plane or XY plane, each solved once after all its shapes are drawn
+      for (size_t f = 0; f < filePaths.size(); ++f) {
+        Utils::TraceSpan sketchSpan("sketch");
+        std::string sketchName = importSketchName(filePaths, f);
+        std::unique_ptr<Adapters::ISketch> sketch = reimport ? workspace_->findSketch(sketchName) : nullptr;
+        bool updating = sketch != nullptr;
+        if (!updating && !planeEntityId.empty()) {
+          sketch = workspace_->createSketchOnPlane(sketchName, planeEntityId);
+        } else if (!updating) {
+          sketch = workspace_->createSketch(sketchName);
+        }
 
-    if (!sketch) {
-      throw std::runtime_error("Failed to create sketch in workspace");
-    }
+        if (!sketch) {
+          throw std::runtime_error("Failed to create sketch in workspace");
+        }
 
-    // Add each stored shape to the sketch
-    for (size_t i = 0; i < importedShapes_.size(); ++i) {
-      const auto& shape = importedShapes_[i];
-      try {
-        sketch->addShape(shape.get(), logger_.get());
-      } catch (const std::exception& e) {
-        (void)e;  // Continue with other shapes
+        Adapters::SketchBulkEdit bulkEdit(sketch.get());
+        std::vector<std::string> tags;
+        std::vector<size_t> indices = shapeIndices(firstShapes[f + 1] - firstShapes[f]);
+        if (updatePrevious) {
+          tags = importedShapeTags(importedShapes_, firstShapes[f], firstShapes[f + 1]);
+        }
+        if (updating) {
+          ImportUpdate update = planImportUpdate(tags, sketch->getCurveTags());
+          int removed = 0;
+          for (const auto& tag : update.staleTags) {
+            removed += sketch->deleteCurvesWithTag(tag);
+          }
+          indices = update.drawShapes;
+          LOG_INFO("Updating " << sketchName << ": kept " << update.keptShapes << " unchanged shapes, drawing "
+                               << indices.size() << ", removed " << removed << " stale curves");
+        }
+        drawImportedShapes(sketch.get(), importedShapes_, firstShapes[f], indices, tags, logger_.get());
       }
     }
+    reportRunMetrics();
 
     // Log completion (no popup)
     return true;
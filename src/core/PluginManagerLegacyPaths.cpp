@@ -5,7 +5,7 @@
  * Split from PluginManagerPaths.cpp for maintainability
  */
 
-#include "PluginManager.h"
+#include "PluginManagerHelpers.h"
 #include "geometry/MedialAxisProcessor.h"
 #include "geometry/Point2D.h"
 
@@ -13,7 +13,7 @@ namespace ChipCarving {
 namespace Core {
 
 bool PluginManager::executeGeneratePaths() {
-  if (!initialized_) {
+  if (!initialized_ || background_->rejectWhileRunning("Generate Paths")) {
     return false;
   }
 
@@ -42,16 +42,17 @@ bool PluginManager::executeGeneratePaths() {
     int processedShapes = 0;
 
     // Process each imported shape
-    for (const auto& shape : importedShapes_) {
+    for (size_t i = 0; i < importedShapes_.size(); ++i) {
+      const Geometry::Shape& shape = importedShapes_.at(i);
       try {
         logger_->logInfo("Processing shape " + std::to_string(processedShapes + 1));
 
         // Add shape outline to sketch first
-        shape->drawToSketch(medialSketch.get(), logger_.get());
+        shape.drawToSketch(medialSketch.get(), logger_.get());
 
         // Generate and display medial axis for each shape
         Geometry::MedialAxisProcessor processor;
-        auto results = processor.computeMedialAxis(*shape);
+        auto results = processor.computeMedialAxis(shape);
 
         if (results.success && !results.chains.empty()) {
           hasAnyResults = true;
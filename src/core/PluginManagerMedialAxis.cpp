@@ -0,0 +1,171 @@
+/**
+ * PluginManagerMedialAxis.cpp
+ *
+ * Medial axis stage of path generation for PluginManager
+ * Split from PluginManagerPathsCore.cpp for maintainability
+ */
+
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "PluginManager.h"
+#include "geometry/MedialAxisBatch.h"
+#include "geometry/MedialAxisCache.h"
+#include "geometry/MedialAxisDiskCache.h"
+#include "utils/logging.h"
+
+namespace ChipCarving {
+namespace Core {
+
+namespace {
+
+// V-carve checkpoints of a shared disk cache
+constexpr const char* LOCAL_CHECKPOINT_DIRECTORY = "/tmp/chip_carving_cpp_checkpoints";
+
+}  // namespace
+
+void PluginManager::setMedialAxisCacheDirectory(const std::string& directory, bool shared) {
+  if (directory.empty()) {
+    medialDiskCache_.reset();
+    vcarveCheckpoints_.reset();
+    return;
+  }
+
+  medialDiskCache_ = std::make_unique<Geometry::MedialAxisDiskCache>(
+      directory, Geometry::MedialAxisDiskCache::currentEngineVersion(), shared);
+  if (!medialDiskCache_->isEnabled()) {
+    LOG_WARNING("Medial axis disk cache disabled: cannot create directory " << directory);
+  }
+  // Checkpoints recover this machine's interrupted run; on a team folder they would only add network writes
+  vcarveCheckpoints_ =
+      std::make_unique<Geometry::VCarveCheckpoints>(shared ? LOCAL_CHECKPOINT_DIRECTORY : directory + "/checkpoints");
+}
+
+PluginManager::StoredMedialAxis PluginManager::resolveStoredMedialAxis(const std::vector<Geometry::Point2D>& polygon,
+                                                                       const Adapters::MedialAxisParameters& params,
+                                                                       Geometry::MedialAxisResults& results,
+                                                                       uint64_t& key) {
+  // Cheapest source first: closed-form medial axis for unedited imported
+  // shapes, then the in-memory cache, then the on-disk cache
+  key = 0;
+  if (params.useAnalyticMedialAxis && computeAnalyticMedialAxis(polygon, results)) {
+    return StoredMedialAxis::ANALYTIC;
+  }
+
+  key = Geometry::MedialAxisCache::computeKey(polygon, *medialProcessor_);
+  bool useCache = params.useMedialAxisCache && medialCache_;
+  if (useCache && medialCache_->lookup(key, results)) {
+    results.computeMs = 0.0;
+    return StoredMedialAxis::MEMORY;
+  }
+
+  if (useCache && medialDiskCache_ && medialDiskCache_->isEnabled() && medialDiskCache_->load(key, results)) {
+    results.computeMs = 0.0;
+    medialCache_->insert(key, results);
+    return StoredMedialAxis::DISK;
+  }
+  return StoredMedialAxis::NONE;
+}
+
+void PluginManager::storeMedialAxis(uint64_t key, const Geometry::MedialAxisResults& results,
+                                    const Adapters::MedialAxisParameters& params) {
+  // Only successful results are cached so a transient failure is retried next run
+  if (!params.useMedialAxisCache || !medialCache_ || !results.success) {
+    return;
+  }
+
+  medialCache_->insert(key, results);
+  if (medialDiskCache_ && medialDiskCache_->isEnabled() && !medialDiskCache_->store(key, results)) {
+    LOG_WARNING("Failed to write medial axis cache entry " << medialDiskCache_->pathForKey(key));
+  }
+}
+
+void PluginManager::countStoredMedialAxis(StoredMedialAxis source, RunReport& report) {
+  report.analyticMedialAxes += source == StoredMedialAxis::ANALYTIC ? 1 : 0;
+  report.memoryCacheHits += source == StoredMedialAxis::MEMORY ? 1 : 0;
+  report.diskCacheHits += source == StoredMedialAxis::DISK ? 1 : 0;
+}
+
+std::vector<Geometry::MedialAxisResults> PluginManager::computeProfileMedialAxes(
+    const std::vector<std::vector<Geometry::Point2D>>& profilePolygons, const Adapters::MedialAxisParameters& params,
+    Utils::JobProgress* progress, const std::vector<std::vector<std::vector<Geometry::Point2D>>>* profileHoles,
+    RunReport* report) {
+  std::vector<Geometry::MedialAxisResults> allResults(profilePolygons.size());
+
+  // Resolve each profile from the analytic shapes or the caches, leaving the
+  // rest for OpenVoronoi
+  std::vector<size_t> voronoiIndices;
+  std::vector<uint64_t> voronoiKeys;
+  std::vector<std::vector<Geometry::Point2D>> voronoiPolygons;
+  std::vector<std::vector<std::vector<Geometry::Point2D>>> voronoiHoles;
+  size_t analyticCount = 0;
+  size_t cachedCount = 0;
+  size_t diskCount = 0;
+
+  for (size_t i = 0; i < profilePolygons.size(); ++i) {
+    if (progress && progress->isCancelled()) {
+      return allResults;
+    }
+
+    // The analytic shapes and cache keys only describe the outer loop
+    bool hasHoles = profileHoles && i < profileHoles->size() && !(*profileHoles)[i].empty();
+    uint64_t key = 0;
+    StoredMedialAxis source =
+        hasHoles ? StoredMedialAxis::NONE : resolveStoredMedialAxis(profilePolygons[i], params, allResults[i], key);
+    if (source == StoredMedialAxis::NONE) {
+      voronoiIndices.push_back(i);
+      voronoiKeys.push_back(key);
+      voronoiPolygons.push_back(profilePolygons[i]);
+      voronoiHoles.push_back(hasHoles ? (*profileHoles)[i] : std::vector<std::vector<Geometry::Point2D>>{});
+      continue;
+    }
+
+    analyticCount += source == StoredMedialAxis::ANALYTIC ? 1 : 0;
+    cachedCount += source == StoredMedialAxis::MEMORY ? 1 : 0;
+    diskCount += source == StoredMedialAxis::DISK ? 1 : 0;
+    if (report) {
+      countStoredMedialAxis(source, *report);
+    }
+
+    // Profiles resolved here count as done right away; OpenVoronoi ones as their workers finish
+    if (progress) {
+      progress->advance();
+    }
+  }
+  LOG_INFO("Medial axis sources: " << analyticCount << " analytic, " << cachedCount << " cached, " << diskCount
+                                   << " from disk, " << voronoiPolygons.size() << " OpenVoronoi");
+
+  // OpenVoronoi is pure geometry (no Fusion API calls), so it runs on a worker
+  // pool; results come back in profile order
+  int workerCount = Geometry::resolveMedialAxisWorkerCount(params.medialAxisWorkers, voronoiPolygons.size());
+  LOG_INFO("Computing medial axes using " << workerCount << " worker thread(s)");
+  std::vector<Geometry::MedialAxisResults> voronoiResults;
+  if (params.shareRepeatedShapes) {
+    size_t sharedCount = 0;
+    voronoiResults = Geometry::computeDeduplicatedMedialAxisBatch(voronoiPolygons, *medialProcessor_, workerCount,
+                                                                  progress, &voronoiHoles, &sharedCount);
+    LOG_INFO("Medial axes of " << sharedCount << " repeated profiles mapped from another copy");
+  } else {
+    voronoiResults =
+        Geometry::computeMedialAxisBatch(voronoiPolygons, *medialProcessor_, workerCount, progress, &voronoiHoles);
+  }
+
+  for (size_t k = 0; k < voronoiIndices.size(); ++k) {
+    if (voronoiHoles[k].empty()) {
+      storeMedialAxis(voronoiKeys[k], voronoiResults[k], params);
+    }
+    allResults[voronoiIndices[k]] = std::move(voronoiResults[k]);
+  }
+
+  if (params.useMedialAxisCache && medialCache_) {
+    LOG_INFO("Medial axis cache: " << medialCache_->size() << " entries, " << medialCache_->getBytesUsed()
+                                   << " bytes");
+  }
+
+  return allResults;
+}
+
+}  // namespace Core
+}  // namespace ChipCarving
@@ -0,0 +1,190 @@
+/**
+ * PluginManagerMultiTool.cpp
+ *
+ * Multi-tool Generate Paths for PluginManager: profiles are extracted and
+ * their medial axes computed once, then V-carve runs for every tool in
+ * parallel and each tool's toolpaths are written to their own sketch
+ */
+
+#include <atomic>
+#include <cctype>
+#include <exception>
+#include <memory>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "PluginManagerHelpers.h"
+#include "geometry/MedialAxisBatch.h"
+#include "utils/RunErrorContext.h"
+#include "utils/logging.h"
+
+namespace ChipCarving {
+namespace Core {
+
+namespace {
+
+Adapters::MedialAxisParameters toolParameters(const Adapters::MedialAxisParameters& params,
+                                              const Adapters::ToolDefinition& tool) {
+  Adapters::MedialAxisParameters toolParams = params;
+  toolParams.toolName = tool.toolName;
+  toolParams.toolAngle = tool.toolAngle;
+  toolParams.toolDiameter = tool.toolDiameter;
+  toolParams.toolShape = tool.toolShape;
+  toolParams.toolTipDiameter = tool.toolTipDiameter;
+  toolParams.maxVCarveDepth = tool.maxVCarveDepth;
+  return toolParams;
+}
+
+}  // namespace
+
+std::string suffixedExportPath(const std::string& path, const std::string& label) {
+  std::string suffix;
+  for (char c : label) {
+    unsigned char byte = static_cast<unsigned char>(c);
+    if (byte >= 0x80) {
+      continue;  // Drop non-ASCII such as the degree sign
+    }
+    suffix += (std::isalnum(byte) || c == '-' || c == '_') ? c : '_';
+  }
+
+  size_t slash = path.find_last_of("/\\");
+  size_t dot = path.find_last_of('.');
+  if (dot == std::string::npos || (slash != std::string::npos && dot < slash)) {
+    return path + "-" + suffix;
+  }
+  return path.substr(0, dot) + "-" + suffix + path.substr(dot);
+}
+
+bool PluginManager::executeMultiToolGeneration(const Adapters::SketchSelection& selection,
+                                               const Adapters::MedialAxisParameters& params,
+                                               const std::vector<Adapters::ToolDefinition>& tools) {
+  if (!initialized_ || background_->rejectWhileRunning("Medial Axis Generation")) {
+    return false;
+  }
+
+  lastRunMetrics_.clear();
+  lastRunReport_ = RunReport();
+  std::unique_ptr<Utils::TraceRecorder> trace;
+  if (isChromeTraceEnabled()) {
+    trace = std::make_unique<Utils::TraceRecorder>();
+  }
+
+  bool success = false;
+  {
+    Utils::MemorySampler memorySampler;
+    Utils::ScopedRunMetrics runMetrics(lastRunMetrics_, trace.get());
+    Utils::TraceSpan generateSpan("generatePaths");
+    success = runMultiToolGeneration(selection, params, tools);
+  }
+  reportRunMetrics(&params);
+  if (trace) {
+    writeChromeTrace(*trace);
+  }
+  return success;
+}
+
+bool PluginManager::runMultiToolGeneration(const Adapters::SketchSelection& selection,
+                                           const Adapters::MedialAxisParameters& params,
+                                           const std::vector<Adapters::ToolDefinition>& tools) {
+  if (tools.empty()) {
+    ui_->showMessageBox("Medial Axis Generation - Error", "No tools selected for multi-tool generation");
+    return false;
+  }
+
+  std::vector<Adapters::MedialAxisParameters> toolParams;
+  for (const auto& tool : tools) {
+    toolParams.push_back(toolParameters(params, tool));
+    toolParams.back().generateVCarveToolpaths = true;
+    toolParams.back().incrementalRegeneration = false;  // One extraction is shared by every tool's sketch
+    if (tools.size() > 1 && !params.gcodeExportPath.empty()) {
+      toolParams.back().gcodeExportPath = suffixedExportPath(params.gcodeExportPath, tool.toolName);
+    }
+    if (tools.size() > 1 && !params.svgExportPath.empty()) {
+      toolParams.back().svgExportPath = suffixedExportPath(params.svgExportPath, tool.toolName);
+    }
+  }
+
+  try {
+    Adapters::EntityLookupSession lookups(workspace_.get());
+    GenerationJob job;
+    job.params = toolParams[0];
+    if (!prepareGenerationJob(selection, job)) {
+      return false;
+    }
+
+    // The medial axis does not depend on the tool, so every tool shares one computation
+    {
+      Utils::TraceSpan medialSpan("medialAxis");
+      Utils::TraceSpan computeSpan("compute");
+      job.medialResults =
+          computeProfileMedialAxes(job.profilePolygons, job.params, nullptr, &job.profileHoles, &job.report);
+      for (size_t i = 0; i < job.medialResults.size(); ++i) {
+        reportProfileMedialAxis(job, i, job.medialResults[i]);
+      }
+    }
+
+    // Pure geometry per tool, each worker sampling with its own processor copy
+    std::vector<std::vector<Geometry::VCarveResults>> toolProfiles(tools.size());
+    {
+      Utils::TraceSpan vcarveSpan("vcarve");
+      Utils::TraceSpan computeSpan("compute");
+      std::atomic<size_t> nextTool{0};
+      Utils::RunErrorContext errors;
+      Utils::TraceRecorder* recorder = Utils::currentTraceRecorder();
+      auto worker = [&]() {
+        SetThreadConsoleLoggingSuppressed(true);
+        Utils::ScopedTraceRecorder threadTrace(recorder);
+        Utils::RunErrorContext::Collector errorCollector(errors);
+        Geometry::MedialAxisProcessor processor(*medialProcessor_);
+        processor.setVerbose(false);
+        for (size_t t = nextTool.fetch_add(1); t < tools.size(); t = nextTool.fetch_add(1)) {
+          // Errors are indexed by tool rather than profile here
+          // The first tool's samples are the ones its visualization draws
+          auto* keptSamples = t == 0 && sharesSampledPaths(toolParams[t]) ? &job.sampledPaths : nullptr;
+          errorCollector.guard(t, "V-carve computation", [&]() {
+            toolProfiles[t] = computeVCarveProfiles(job.medialResults, toolParams[t], nullptr, &processor, keptSamples,
+                                                    nullptr, &job.profilePolygons, &job.profileHoles,
+                                                    &job.samplingDistances);
+          });
+        }
+      };
+
+      int workerCount = Geometry::resolveMedialAxisWorkerCount(params.medialAxisWorkers, tools.size());
+      std::vector<std::thread> workers;
+      for (int w = 0; w < workerCount; ++w) {
+        workers.emplace_back(worker);
+      }
+      for (auto& thread : workers) {
+        thread.join();
+      }
+      for (const auto& error : errors.takeErrors()) {
+        LOG_WARNING("V-carve computation failed for " << tools[error.profile].toolName << ": " << error.message);
+      }
+    }
+
+    // Write stage per tool on the main thread; the medial axis sketch is only drawn once
+    bool written = true;
+    for (size_t t = 0; t < tools.size(); ++t) {
+      job.params = toolParams[t];
+      job.params.generateVisualization = params.generateVisualization && t == 0;
+      job.vcarveProfiles = std::move(toolProfiles[t]);
+      LOG_INFO("Writing V-carve toolpaths for " << tools[t].toolName);
+      written = finishGenerationJob(job) && written;
+      job.report = RunReport();  // The shared medial axes are reported once
+    }
+    return written;
+  } catch (const std::exception& e) {
+    std::string errorMsg = "Failed to generate medial axis: " + std::string(e.what());
+    ui_->showMessageBox("Medial Axis Generation - Error", errorMsg);
+    return false;
+  } catch (...) {
+    std::string errorMsg = "Unknown error during medial axis generation";
+    ui_->showMessageBox("Medial Axis Generation - Error", errorMsg);
+    return false;
+  }
+}
+
+}  // namespace Core
+}  // namespace ChipCarving
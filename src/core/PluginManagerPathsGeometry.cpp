@@ -5,75 +5,111 @@
  * Split from PluginManagerPaths.cpp for maintainability
  */
 
-#include <algorithm>
+#include <cmath>
+#include <utility>
 #include <vector>
 
-#include "core/PluginManager.h"
+#include "core/IncrementalRegeneration.h"
+#include "core/PluginManagerHelpers.h"
+#include "geometry/MedialAxisEngine.h"
 #include "geometry/Point2D.h"
+#include "geometry/PolygonSimplification.h"
+#include "geometry/ProfileCurve.h"
+#include "geometry/ProfileTolerance.h"
+#include "utils/UnitConversion.h"
 #include "utils/logging.h"
 
 namespace ChipCarving {
 namespace Core {
 
-namespace {
-
-// Convert vertex pairs to Point2D polygon
-std::vector<Geometry::Point2D> convertToPolygon(const std::vector<std::pair<double, double>>& vertices) {
-  std::vector<Geometry::Point2D> polygon;
-  polygon.reserve(vertices.size());
-  std::transform(vertices.begin(), vertices.end(), std::back_inserter(polygon),
-                 [](const auto& v) { return Geometry::Point2D(v.first, v.second); });
-  return polygon;
+std::vector<Geometry::Point2D> cachedProfileOutline(const Adapters::ProfileGeometry& profile, double curveTolerance) {
+  if (profile.vertices.empty() && !profile.curves.empty()) {
+    return Geometry::polygonizeProfileLoop(profile.curves, curveTolerance);
+  }
+  return profile.vertices;
 }
 
-// Extract from cached profile geometry
-void extractFromCachedProfiles(const std::vector<Adapters::ProfileGeometry>& profiles,
-                               std::vector<std::vector<Geometry::Point2D>>& polygons,
-                               std::vector<Adapters::IWorkspace::TransformParams>& transforms) {
-  for (size_t i = 0; i < profiles.size(); ++i) {
-    const auto& profileGeom = profiles[i];
-
-    if (profileGeom.vertices.size() < 3) {
-      LOG_INFO("Profile " << i << " has insufficient vertices, skipping");
-      continue;
+std::vector<std::vector<Geometry::Point2D>> cachedProfileHoles(const Adapters::ProfileGeometry& profile,
+                                                               double curveTolerance) {
+  std::vector<std::vector<Geometry::Point2D>> holes;
+  for (const auto& hole : profile.holes) {
+    if (hole.size() >= 3) {
+      holes.push_back(hole);
+    }
+  }
+  for (const auto& holeCurves : profile.holeCurves) {
+    std::vector<Geometry::Point2D> hole = Geometry::polygonizeProfileLoop(holeCurves, curveTolerance);
+    if (hole.size() >= 3) {
+      holes.push_back(std::move(hole));
     }
-
-    LOG_INFO("Using cached geometry for profile " << i << " from sketch '" << profileGeom.sketchName << "' with "
-                                                  << profileGeom.vertices.size() << " vertices");
-
-    auto polygon = convertToPolygon(profileGeom.vertices);
-    polygons.push_back(std::move(polygon));
-    transforms.push_back(profileGeom.transform);
   }
+  return holes;
 }
 
-// Extract via workspace interface (fallback path)
-void extractFromEntityIds(const std::vector<std::string>& entityIds, Adapters::IWorkspace* workspace,
-                          std::vector<std::vector<Geometry::Point2D>>& polygons,
-                          std::vector<Adapters::IWorkspace::TransformParams>& transforms) {
-  for (const auto& entityId : entityIds) {
-    std::vector<std::pair<double, double>> rawVertices;
-    Adapters::IWorkspace::TransformParams transform;
+double applyAutoTolerance(const Adapters::MedialAxisParameters& params, std::vector<Geometry::Point2D>& polygon,
+                          std::vector<std::vector<Geometry::Point2D>>& holes) {
+  if (!params.autoTolerance) {
+    return params.samplingDistance;
+  }
+  Geometry::AutoToleranceOptions options;
+  options.depthError = params.autoDepthError;
+  options.toolAngle = params.toolAngle;
+  options.minTolerance = params.autoToleranceMin;
+  options.maxTolerance = params.autoToleranceMax;
+  options.minSampling = params.autoSamplingMin;
+  options.maxSampling = params.autoSamplingMax;
+  Geometry::ProfileTolerance chosen =
+      Geometry::chooseProfileTolerance(polygon, holes, Utils::fusionLengthToMm(1.0), options);
+
+  LOG_DEBUG("Auto tolerance " << chosen.polygonTolerance << " mm, sampling " << chosen.samplingDistance
+                              << " mm for a profile of " << polygon.size() << " vertices with features down to "
+                              << chosen.minFeatureRadius << " mm");
+
+  // The same corner protection as the processor's own input simplification
+  const double tolerance = Utils::mmToFusionLength(chosen.polygonTolerance);
+  const double cornerAngle = 20.0 * M_PI / 180.0;
+  polygon = Geometry::simplifyPolygon(polygon, tolerance, cornerAngle);
+  for (auto& hole : holes) {
+    hole = Geometry::simplifyPolygon(hole, tolerance, cornerAngle);
+  }
+  return chosen.samplingDistance;
+}
 
-    if (!workspace->extractProfileVertices(entityId, rawVertices, transform)) {
-      continue;
-    }
+size_t selectionProfileCount(const Adapters::SketchSelection& selection) {
+  // Cached profile geometry wins; entity IDs are the fallback path
+  return selection.selectedProfiles.empty() ? selection.selectedEntityIds.size() : selection.selectedProfiles.size();
+}
 
-    if (rawVertices.size() < 3) {
-      continue;
+bool PluginManager::extractProfileAt(const Adapters::SketchSelection& selection, size_t index,
+                                     std::vector<Geometry::Point2D>& polygon,
+                                     Adapters::IWorkspace::TransformParams& transform,
+                                     std::vector<std::vector<Geometry::Point2D>>& holes) {
+  holes.clear();
+  if (!selection.selectedProfiles.empty()) {
+    const auto& profileGeom = selection.selectedProfiles[index];
+    // Exact curves are polygonized here rather than stroked by Fusion while the selection was cached
+    const double curveTolerance = medialProcessor_->getPolygonTolerance();
+    polygon = cachedProfileOutline(profileGeom, curveTolerance);
+    if (polygon.size() < 3) {
+      LOG_INFO("Profile " << index << " has insufficient vertices, skipping");
+      return false;
     }
 
-    auto polygon = convertToPolygon(rawVertices);
-    polygons.push_back(std::move(polygon));
-    transforms.push_back(transform);
+    LOG_INFO("Using cached geometry for profile " << index << " from sketch '" << profileGeom.sketchName << "' with "
+                                                  << polygon.size() << " vertices and "
+                                                  << profileGeom.holes.size() + profileGeom.holeCurves.size()
+                                                  << " holes");
+    transform = profileGeom.transform;
+    holes = cachedProfileHoles(profileGeom, curveTolerance);
+    return true;
   }
-}
 
-}  // namespace
+  // Extract via workspace interface (outer loop only), straight into the caller's polygon
+  return workspace_->extractProfileVertices(selection.selectedEntityIds[index], polygon, transform) &&
+         polygon.size() >= 3;
+}
 
-bool PluginManager::extractProfileGeometry(const Adapters::SketchSelection& selection,
-                                           std::vector<std::vector<Geometry::Point2D>>& profilePolygons,
-                                           std::vector<Adapters::IWorkspace::TransformParams>& profileTransforms) {
+bool PluginManager::extractProfileGeometry(const Adapters::SketchSelection& selection, GenerationJob& job) {
   if (!initialized_ || !workspace_) {
     return false;
   }
@@ -85,23 +121,71 @@ bool PluginManager::extractProfileGeometry(const Adapters::SketchSelection& sele
 
   LOG_INFO("Extracting profile geometry for " << selection.selectedEntityIds.size() << " profiles");
 
-  profilePolygons.clear();
-  profileTransforms.clear();
+  job.profilePolygons.clear();
+  job.profileTransforms.clear();
+  job.profileHoles.clear();
+  job.profileSources.clear();
+  job.checkpointKeys.clear();
+  job.samplingDistances.clear();
 
-  if (!selection.selectedProfiles.empty()) {
-    extractFromCachedProfiles(selection.selectedProfiles, profilePolygons, profileTransforms);
-  } else {
-    extractFromEntityIds(selection.selectedEntityIds, workspace_.get(), profilePolygons, profileTransforms);
+  for (size_t i = 0; i < selectionProfileCount(selection); ++i) {
+    std::vector<Geometry::Point2D> polygon;
+    Adapters::IWorkspace::TransformParams transform;
+    std::vector<std::vector<Geometry::Point2D>> holes;
+    if (extractProfileAt(selection, i, polygon, transform, holes) &&
+        admitIncrementalProfile(job, polygon, holes, transform, profileSourceToken(selection, i))) {
+      job.samplingDistances.push_back(applyAutoTolerance(job.params, polygon, holes));
+      job.checkpointKeys.push_back(
+          vcarveCheckpointKey(vcarveCheckpoints_.get(), polygon, holes, transform, job.params));
+      job.profilePolygons.push_back(std::move(polygon));
+      job.profileTransforms.push_back(transform);
+      job.profileHoles.push_back(std::move(holes));
+      job.profileSources.push_back(profileSourceToken(selection, i));
+    }
   }
 
-  if (profilePolygons.empty()) {
+  if (job.profilePolygons.empty() && job.incremental.keptTags.empty()) {
     LOG_INFO("No valid profile polygons extracted");
     return false;
   }
 
-  LOG_INFO("Successfully extracted " << profilePolygons.size() << " profile polygons");
+  LOG_INFO("Successfully extracted " << job.profilePolygons.size() << " profile polygons");
   return true;
 }
 
+void PluginManager::indexImportedShapes() {
+  // Imported shapes are in mm; profile polygons are in Fusion units (cm)
+  Utils::TraceSpan indexSpan("indexShapes");
+  importedShapeIndex_ = Geometry::ShapeMatchIndex(importedShapes_, Utils::mmToFusionLength(1.0));
+}
+
+bool PluginManager::computeAnalyticMedialAxis(const std::vector<Geometry::Point2D>& polygon,
+                                              Geometry::MedialAxisResults& results) const {
+  Geometry::ShapeMatchIndex::Key key;
+  if (importedShapeIndex_.empty() || !Geometry::ShapeMatchIndex::polygonKey(polygon, key)) {
+    return false;
+  }
+
+  // Only shapes agreeing on centroid, area and bounds are verified exactly
+  std::vector<size_t> candidates;
+  importedShapeIndex_.candidates(key, Utils::Tolerance::GEOMETRIC, candidates);
+
+  Geometry::MedialAxisEngineSet engines = Geometry::MedialAxisEngineSet::analytic(*medialProcessor_);
+  Geometry::MedialAxisProfile profile;
+  profile.polygon = &polygon;
+  profile.shapeScale = Utils::mmToFusionLength(1.0);
+  profile.matchTolerance = Utils::Tolerance::GEOMETRIC;
+  Geometry::MedialAxisResults computed;
+  for (size_t index : candidates) {
+    profile.sourceShape = &importedShapes_.at(index);
+    if (engines.compute(profile, computed) != Geometry::MedialAxisEngineSet::NO_ENGINE) {
+      results = std::move(computed);
+      return true;
+    }
+  }
+
+  return false;
+}
+
 }  // namespace Core
 }  // namespace ChipCarving
@@ -0,0 +1,123 @@
+/**
+ * PluginManagerPathsSketches.cpp
+ *
+ * Output sketches of path generation for PluginManager: created or reused by
+ * name, and toolpath sketch shards opened, closed and pruned
+ * Split from PluginManagerPathsWrite.cpp for maintainability
+ */
+
+#include <memory>
+#include <string>
+#include <utility>
+
+#include "IncrementalRegeneration.h"
+#include "PluginManagerHelpers.h"
+#include "geometry/GcodeWriter.h"
+#include "utils/logging.h"
+
+namespace ChipCarving {
+namespace Core {
+
+namespace {
+
+// Above this many curves and points an earlier run's sketch is recreated rather than emptied entity by entity
+constexpr size_t RECREATE_SKETCH_ABOVE_ENTITIES = 500;
+
+}  // namespace
+
+std::unique_ptr<Adapters::ISketch> createOutputSketch(Adapters::IWorkspace* workspace, const std::string& name,
+                                                      const Adapters::MedialAxisParameters& params,
+                                                      const std::string& sourcePlaneId,
+                                                      const std::string& importedPlaneId, GenerationOutput& output) {
+  if (!output.outputSession) {
+    output.outputSession = std::make_unique<Adapters::OutputSession>(workspace, "Chip Carving - " + params.toolName,
+                                                                     params.outputToBaseFeature);
+  }
+
+  // An earlier run's sketch of this name on the same plane is emptied and
+  // written again, keeping its place in the browser; otherwise a new one is made
+  const std::string& planeId = !sourcePlaneId.empty() ? sourcePlaneId : importedPlaneId;
+  auto existingSketch = params.targetSurfaceId.empty() ? workspace->findSketch(name) : nullptr;
+  if (existingSketch) {
+    auto reset = workspace->resetSketch(std::move(existingSketch), planeId, RECREATE_SKETCH_ABOVE_ENTITIES);
+    if (reset) {
+      LOG_DEBUG("Reusing sketch '" << name << "'");
+      return reset;
+    }
+  }
+
+  if (!params.targetSurfaceId.empty()) {
+    LOG_DEBUG("Creating sketch '" << name << "' in target surface component: '" << params.targetSurfaceId << "'");
+    return workspace->createSketchInTargetComponent(name, params.targetSurfaceId);
+  }
+  if (!sourcePlaneId.empty()) {
+    LOG_DEBUG("Using source plane entity ID for sketch '" << name << "': '" << sourcePlaneId << "'");
+    return workspace->createSketchOnPlane(name, sourcePlaneId);
+  }
+  if (!importedPlaneId.empty()) {
+    LOG_DEBUG("Using stored plane entity ID for sketch '" << name << "': '" << importedPlaneId << "'");
+    return workspace->createSketchOnPlane(name, importedPlaneId);
+  }
+  return workspace->createSketch(name);
+}
+
+size_t deleteStaleToolpathShards(Adapters::IWorkspace* workspace, const Adapters::MedialAxisParameters& params,
+                                 size_t lastShard, const std::string& sourcePlaneId,
+                                 const std::string& importedPlaneId) {
+  if (!params.targetSurfaceId.empty()) {
+    return 0;
+  }
+  const std::string& planeId = !sourcePlaneId.empty() ? sourcePlaneId : importedPlaneId;
+  size_t shard = lastShard + 1;
+  while (workspace->deleteSketch(toolpathSketchName(params, shard), planeId)) {
+    ++shard;
+  }
+  return shard - lastShard - 1;
+}
+
+void closeVCarveSketch(GenerationOutput& output) {
+  output.vcarveEdit.reset();
+  if (output.vcarveSketch && output.vcarveShardPaths > 0) {
+    output.vcarveSketch->finishSketch();
+  }
+}
+
+void PluginManager::openVCarveOutput(GenerationJob& job, GenerationOutput& output) {
+  const Adapters::MedialAxisParameters& params = job.params;
+  output.vcarveOpened = true;
+
+  bool writeGcode = !params.gcodeExportPath.empty();
+  if (!writeGcode || !params.gcodeSkipSketch) {
+    // Same plane (or target component) as the source design; an incremental
+    // run adds to the earlier sketch, whose unchanged curves stay
+    output.vcarveSketch = job.incremental.sketch
+                              ? std::move(job.incremental.sketch)
+                              : createOutputSketch(workspace_.get(), toolpathSketchName(params), params,
+                                                   job.sourcePlaneId, lastImportedPlaneEntityId_, output);
+    if (output.vcarveSketch) {
+      // Solve the sketch once after all toolpath curves are added
+      output.vcarveEdit = std::make_unique<Adapters::SketchBulkEdit>(output.vcarveSketch.get());
+    }
+  }
+
+  // G-code is streamed to disk path by path, alongside (or instead of) the sketch
+  if (writeGcode) {
+    output.gcodeFile.open(params.gcodeExportPath);
+    if (output.gcodeFile) {
+      output.gcode =
+          std::make_unique<Geometry::GcodeWriter>(output.gcodeFile, Geometry::gcodePostFromParameters(params));
+      output.gcode->begin("Chip carving V-carve - " + params.toolName);
+    } else {
+      ui_->showMessageBox("Medial Axis Generation - Error",
+                          "Failed to open G-code file for writing:\n" + params.gcodeExportPath);
+    }
+  }
+
+  // Sample curved target surfaces once on a grid shared by all profiles (the
+  // pipeline holds writes back until every medial axis is known when a grid is used)
+  output.vcarve.hasHeightfield = Adapters::projectsOntoSurface(params) &&
+                                 surface_->buildHeightfield(job.medialResults, params, output.vcarve.heightfield);
+}
+
+}  // namespace Core
+}  // namespace ChipCarving
@@ -15,20 +15,28 @@ namespace Core {
 void PluginManager::addConstructionGeometryVisualization(Adapters::ISketch* sketch,
                                                          const Geometry::MedialAxisResults& results,
                                                          const Adapters::MedialAxisParameters& params,
-                                                         const Adapters::IWorkspace::TransformParams& /* transform */,
+                                                         const std::vector<Geometry::SampledMedialPath>* sharedPaths,
                                                          const std::vector<Geometry::Point2D>& polygon) {
   if (!sketch || !results.success) {
     return;
   }
 
+  // Solve the sketch once after all lines and circles are added
+  Adapters::SketchBulkEdit bulkEdit(sketch);
+
   try {
     // NOTE: Not applying any coordinate transformations
     // Fusion handles the transformation when creating sketch entities on the
     // correct plane
 
     // Get properly sampled medial axis paths at user-specified sampling
-    // distance
-    auto sampledPaths = medialProcessor_->getSampledPaths(results, params.samplingDistance);
+    // distance, unless the V-carve stage already sampled them
+    std::vector<Geometry::SampledMedialPath> resampled;
+    if (!sharedPaths || sharedPaths->empty()) {
+      resampled = medialProcessor_->getSampledPaths(results, params.samplingDistance);
+      sharedPaths = &resampled;
+    }
+    const auto& sampledPaths = *sharedPaths;
 
     // Enhanced UI Phase 5.3: Add medial axis lines using sampled paths
     if (params.showMedialLines && !sampledPaths.empty()) {
@@ -81,12 +89,7 @@ void PluginManager::addConstructionGeometryVisualization(Adapters::ISketch* sket
       // Draw clearance circles only at actual medial axis vertices from
       // OpenVoronoi
       for (size_t chainIdx = 0; chainIdx < results.chains.size(); ++chainIdx) {
-        const auto& chain = results.chains[chainIdx];
-        const auto& clearances = results.clearanceRadii[chainIdx];
-
-        if (chain.size() != clearances.size()) {
-          continue;
-        }
+        auto chain = results.chains[chainIdx];
 
         // Draw clearance circles for ALL vertices exactly as OpenVoronoi
         // generated them This confirms every circle shown is a genuine
@@ -98,9 +101,9 @@ void PluginManager::addConstructionGeometryVisualization(Adapters::ISketch* sket
           }
 
           // Chain points are in world coordinates (cm), convert to mm
-          double x_world_mm = chain[i].x * 10.0;
-          double y_world_mm = chain[i].y * 10.0;
-          double radius_world_mm = clearances[i] * 10.0;
+          double x_world_mm = Utils::fusionLengthToMm(chain[i].x);
+          double y_world_mm = Utils::fusionLengthToMm(chain[i].y);
+          double radius_world_mm = Utils::fusionLengthToMm(chain.clearance(i));
 
           // Log every circle to verify they're all from OpenVoronoi
 
@@ -0,0 +1,269 @@
+/**
+ * PluginManagerPathsWrite.cpp
+ *
+ * Write stage of path generation for PluginManager: visualization and V-carve
+ * sketches plus the G-code and review SVG streams, filled one profile at a time
+ * Split from PluginManagerPathsCore.cpp for maintainability
+ * Note: the output sketches are made in PluginManagerPathsSketches.cpp
+ */
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <exception>
+#include <memory>
+#include <string>
+#include <utility>
+
+#include "IncrementalRegeneration.h"
+#include "MedialAxisVisualization.h"
+#include "PluginManagerHelpers.h"
+#include "geometry/Point2D.h"
+#include "geometry/ToolModel.h"
+#include "utils/UnitConversion.h"
+#include "utils/logging.h"
+
+namespace ChipCarving {
+namespace Core {
+
+namespace {
+
+// Review SVG framed around every extracted profile. Colors span what the tool
+// can cut, so they mean the same in every profile however the run is pipelined.
+std::unique_ptr<Geometry::ToolpathSVGExporter> createReviewSvg(const GenerationJob& job) {
+  const Adapters::MedialAxisParameters& params = job.params;
+  const double toMm = Utils::fusionLengthToMm(1.0);
+  Geometry::ShapeBounds bounds;
+  bool first = true;
+  for (const auto& polygon : job.profilePolygons) {
+    for (const auto& point : polygon) {
+      Geometry::Point2D mm(point.x * toMm, point.y * toMm);
+      bounds.min = first ? mm : Geometry::Point2D(std::min(bounds.min.x, mm.x), std::min(bounds.min.y, mm.y));
+      bounds.max = first ? mm : Geometry::Point2D(std::max(bounds.max.x, mm.x), std::max(bounds.max.y, mm.y));
+      first = false;
+    }
+  }
+
+  Geometry::ToolpathSVGStyle style;
+  style.maxClearance = params.toolDiameter / 2.0;
+  style.maxDepth = params.maxVCarveDepth;
+  Geometry::ToolModel tool = Geometry::ToolModel::fromParameters(params);
+  if (tool.valid) {
+    style.maxDepth = tool.depth(style.maxClearance);
+  }
+  return std::make_unique<Geometry::ToolpathSVGExporter>(bounds, style);
+}
+
+// Outline and holes, then the medial axis and toolpaths of a successful profile
+void addReviewProfile(const GenerationJob& job, size_t index, Geometry::ToolpathSVGExporter& review) {
+  const double toMm = Utils::fusionLengthToMm(1.0);
+  review.addOutline(job.profilePolygons[index], toMm);
+  if (index < job.profileHoles.size()) {
+    for (const auto& hole : job.profileHoles[index]) {
+      review.addOutline(hole, toMm);
+    }
+  }
+  const auto& results = job.medialResults[index];
+  if (!results.success) {
+    return;
+  }
+  review.addMedialAxis(results.chains, toMm);
+  if (job.params.generateVCarveToolpaths && index < job.vcarveProfiles.size()) {
+    review.addToolpaths(job.vcarveProfiles[index]);
+  }
+}
+
+}  // namespace
+
+bool PluginManager::finishGenerationJob(GenerationJob& job) {
+  GenerationOutput output;
+  {
+    Utils::TraceSpan writeSpan("write");
+    for (size_t i = 0; i < job.profilePolygons.size(); ++i) {
+      if (!writeGenerationProfile(job, i, output)) {
+        return false;
+      }
+    }
+  }
+  return finishGenerationOutput(job, output);
+}
+
+bool PluginManager::writeGenerationProfile(GenerationJob& job, size_t index, GenerationOutput& output) {
+  const Adapters::MedialAxisParameters& params = job.params;
+
+  if (params.generateVisualization && params.visualizeAsCustomGraphics && !output.visualizationGraphics) {
+    output.visualizationGraphics = workspace_->createCustomGraphics("Medial Axis - " + params.toolName);
+    if (!output.visualizationGraphics) {
+      ui_->showMessageBox("Medial Axis Generation - Error", "Failed to create visualization graphics");
+      return false;
+    }
+  } else if (params.generateVisualization && !params.visualizeAsCustomGraphics && !output.constructionSketch) {
+    output.constructionSketch = createOutputSketch(workspace_.get(), "Medial Axis - " + params.toolName, params,
+                                                   job.sourcePlaneId, lastImportedPlaneEntityId_, output);
+    if (!output.constructionSketch) {
+      ui_->showMessageBox("Medial Axis Generation - Error", "Failed to create construction geometry sketch");
+      return false;
+    }
+    // Defer sketch solves across all profiles
+    output.visualizationEdit = std::make_unique<Adapters::SketchBulkEdit>(output.constructionSketch.get());
+  }
+
+  const auto& polygon = job.profilePolygons[index];
+  const auto& results = job.medialResults[index];
+  LOG_INFO("Profile " << index << " with " << polygon.size() << " vertices - medial axis success: " << results.success);
+  if (index < job.vcarveProfiles.size()) {
+    // Compact toolpaths go back to doubles at the write boundary
+    job.vcarveProfiles[index].expand();
+  }
+
+  if (!params.svgExportPath.empty() && !output.reviewOpened) {
+    output.reviewOpened = true;
+    output.reviewSvg = createReviewSvg(job);
+    if (!output.reviewSvg->open(params.svgExportPath)) {
+      output.reviewSvg.reset();
+      ui_->showMessageBox("Medial Axis Generation - Error",
+                          "Failed to open review SVG file for writing:\n" + params.svgExportPath);
+    }
+  }
+  if (output.reviewSvg) {
+    Utils::TraceSpan reviewSpan("reviewSvg");
+    addReviewProfile(job, index, *output.reviewSvg);
+  }
+
+  if (!results.success) {
+    LOG_ERROR("  Medial axis FAILED: " << results.errorMessage);
+    return true;
+  }
+
+  LOG_INFO("  Medial axis SUCCESS: " << results.chains.size() << " chains, " << results.totalPoints
+                                     << " points, length=" << results.totalLength);
+  output.successCount++;
+  output.totalPoints += results.totalPoints;
+  output.totalLength += results.totalLength;
+
+  // Enhanced UI Phase 5.3: Add construction geometry visualization
+  if (params.generateVisualization) {
+    Utils::TraceSpan vizSpan("visualization");
+    const std::vector<Geometry::SampledMedialPath>* sampledPaths =
+        index < job.sampledPaths.size() ? &job.sampledPaths[index] : nullptr;
+    if (output.visualizationGraphics) {
+      uploadVisualizationBuffers(buildVisualizationBuffers(*medialProcessor_, results, params,
+                                                           job.profileTransforms[index].sketchPlaneZ, polygon,
+                                                           sampledPaths),
+                                 *output.visualizationGraphics);
+    } else {
+      addConstructionGeometryVisualization(output.constructionSketch.get(), results, params, sampledPaths,
+                                           polygon);
+    }
+  }
+
+  if (!params.generateVCarveToolpaths || index >= job.vcarveProfiles.size()) {
+    return true;
+  }
+
+  if (!output.vcarveOpened) {
+    openVCarveOutput(job, output);
+  }
+
+  // Sketch solve cost grows faster than its curve count, so a large run moves
+  // on to a fresh sketch once the current one holds its share of paths
+  if (output.vcarveSketch && params.toolpathSketchPathLimit > 0 &&
+      output.vcarveShardPaths >= params.toolpathSketchPathLimit) {
+    closeVCarveSketch(output);
+    output.vcarveShard++;
+    output.vcarveShardPaths = 0;
+    output.vcarveSketch = createOutputSketch(workspace_.get(), toolpathSketchName(params, output.vcarveShard), params,
+                                             job.sourcePlaneId, lastImportedPlaneEntityId_, output);
+    if (output.vcarveSketch) {
+      output.vcarveEdit = std::make_unique<Adapters::SketchBulkEdit>(output.vcarveSketch.get());
+    } else {
+      logger_->logError("Failed to create toolpath sketch " + toolpathSketchName(params, output.vcarveShard));
+    }
+  }
+  if (!output.vcarveSketch && !output.gcode) {
+    return true;
+  }
+
+  // A profile whose toolpaths cannot be written is logged and skipped
+  Utils::TraceSpan vcarveSpan("vcarve");
+  if (output.vcarveSketch && index < job.incremental.profileTags.size()) {
+    output.vcarveSketch->setCurveTag(job.incremental.profileTags[index], job.incremental.profileTokens[index]);
+  }
+  int pathsBefore = output.vcarve.totalPaths;
+  try {
+    writeVCarveProfile(job.vcarveProfiles[index], job.profileTransforms[index], params, output.vcarveSketch.get(),
+                       output.gcode.get(), output.vcarve);
+  } catch (const std::exception& e) {
+    logger_->logError("Exception in writeVCarveProfile: " + std::string(e.what()));
+  } catch (...) {
+    logger_->logError("Unknown exception in writeVCarveProfile");
+  }
+  output.vcarveShardPaths += output.vcarve.totalPaths - pathsBefore;
+  return true;
+}
+
+bool PluginManager::finishGenerationOutput(GenerationJob& job, GenerationOutput& output) {
+  const Adapters::MedialAxisParameters& params = job.params;
+
+  // Finalize construction geometry sketch if visualization is enabled
+  output.visualizationEdit.reset();
+  if (output.constructionSketch) {
+    Utils::TraceSpan finishSpan("finishVisualization");
+    output.constructionSketch->finishSketch();
+  }
+
+  // Incremental runs drop the curves of profiles that changed or left the selection
+  if (!output.vcarveOpened && job.incremental.sketch) {
+    Adapters::SketchBulkEdit staleEdit(job.incremental.sketch.get());
+    removeStaleToolpaths(job, job.incremental.sketch.get());
+  }
+
+  if (output.vcarveOpened) {
+    Utils::TraceSpan finishSpan("finishVCarve");
+    logVCarveWriteState(output.vcarve);
+    removeStaleToolpaths(job, output.vcarveSketch.get());
+    closeVCarveSketch(output);
+    if (params.gcodeExportPath.empty() || !params.gcodeSkipSketch) {
+      size_t deleted = deleteStaleToolpathShards(workspace_.get(), params, output.vcarveShard, job.sourcePlaneId,
+                                                 lastImportedPlaneEntityId_);
+      if (deleted > 0) {
+        logger_->logInfo("Deleted " + std::to_string(deleted) + " toolpath sketches left over from an earlier run");
+      }
+    }
+    if (output.vcarveShard > 0) {
+      logger_->logInfo("V-carve toolpaths spread across " + std::to_string(output.vcarveShard + 1) +
+                       " sketches of up to " + std::to_string(params.toolpathSketchPathLimit) + " paths");
+    }
+
+    if (output.gcode) {
+      output.gcode->end();
+      logger_->logInfo("⏱️ G-code written to " + params.gcodeExportPath + ": " +
+                       std::to_string(output.gcode->pathCount()) + " paths, " +
+                       std::to_string(output.gcode->lineCount()) + " lines, " +
+                       std::to_string(output.gcode->arcCount()) + " arcs");
+    }
+  }
+
+  // Every sketch is solved: close the base feature edit and group the timeline
+  output.outputSession.reset();
+
+  if (output.reviewSvg) {
+    if (output.reviewSvg->finish()) {
+      logger_->logInfo("Review SVG written to " + params.svgExportPath + ": " +
+                       std::to_string(output.reviewSvg->polylineCount()) + " polylines");
+    } else {
+      logger_->logError("Failed to write review SVG " + params.svgExportPath);
+    }
+  }
+
+  // The sketches hold the paths now; a rerun computes them again
+  removeVCarveCheckpoints(vcarveCheckpoints_.get(), job);
+  lastRunReport_.merge(job.report);
+  LOG_INFO("Medial Axis Generation Complete: " << output.successCount << " of " << job.profilePolygons.size()
+                                               << " profiles, " << output.totalPoints << " points, "
+                                               << static_cast<int>(output.totalLength) << " mm");
+  return true;
+}
+
+}  // namespace Core
+}  // namespace ChipCarving
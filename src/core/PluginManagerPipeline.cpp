@@ -0,0 +1,314 @@
+/**
+ * PluginManagerPipeline.cpp
+ *
+ * Pipelined Generate Paths for PluginManager. The main thread owns every
+ * Fusion call: it extracts profile N+1 and writes profile N-1 while worker
+ * threads compute the medial axis and V-carve paths of profile N. Profiles
+ * flow through two bounded queues, and writes happen in profile order.
+ * With streamProfiles each profile's geometry is freed once it is written,
+ * so memory follows the profiles held at once rather than the whole design.
+ * With strictDeterminism the output does not depend on the worker count or on
+ * which worker finishes first: every profile maps to its own result slot, and
+ * the caches only take this run's medial axes once it ends.
+ * Note: the compute stage is in PluginManagerPipelineWorker.cpp
+ */
+
+#include <algorithm>
+#include <cstdint>
+#include <exception>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "IncrementalRegeneration.h"
+#include "PluginManagerHelpers.h"
+#include "PluginManagerPipelineWorker.h"
+#include "geometry/CanonicalShape.h"
+#include "geometry/MedialAxisBatch.h"
+#include "utils/BoundedQueue.h"
+#include "utils/RunErrorContext.h"
+#include "utils/logging.h"
+
+namespace ChipCarving {
+namespace Core {
+
+namespace {
+
+// Profiles each worker may have queued or in hand; extraction runs this far ahead of the writes
+constexpr size_t PROFILES_IN_FLIGHT_PER_WORKER = 2;
+
+// Streaming runs also cap extracted profiles not yet written, so a slow profile cannot
+// leave everything extracted after it waiting in memory for its turn to be written
+constexpr size_t PROFILES_HELD_PER_WORKER = 4;
+
+// An outline whose medial axis is computed once and mapped onto its later copies
+struct RepeatedShape {
+  size_t source = 0;  // Profile computed with OpenVoronoi
+  Geometry::CanonicalShape shape{};
+  bool collected = false;
+  std::vector<PipelineProfile> waiting{};  // Copies extracted before the source was collected
+};
+
+// A computed medial axis a strict run stores in the caches once it ends
+struct DeferredStore {
+  size_t index = 0;
+  uint64_t cacheKey = 0;
+  Geometry::MedialAxisResults medial{};
+};
+
+// A written profile's geometry is not read again; its slot stays so indices and counts hold
+void releaseWrittenProfile(GenerationJob& job, size_t index) {
+  std::vector<Geometry::Point2D>().swap(job.profilePolygons[index]);
+  std::vector<std::vector<Geometry::Point2D>>().swap(job.profileHoles[index]);
+  job.medialResults[index] = Geometry::MedialAxisResults();
+  job.vcarveProfiles[index] = Geometry::VCarveResults();
+  if (index < job.sampledPaths.size()) {
+    std::vector<Geometry::SampledMedialPath>().swap(job.sampledPaths[index]);
+  }
+}
+
+}  // namespace
+
+bool PluginManager::runGenerationPipeline(const Adapters::SketchSelection& selection, GenerationJob& job) {
+  const Adapters::MedialAxisParameters& params = job.params;
+  size_t sourceCount = workspace_ && !selection.selectedEntityIds.empty() ? selectionProfileCount(selection) : 0;
+  int workerCount = Geometry::resolveMedialAxisWorkerCount(params.medialAxisWorkers, sourceCount);
+  size_t window = static_cast<size_t>(workerCount) * PROFILES_IN_FLIGHT_PER_WORKER;
+  size_t heldLimit = static_cast<size_t>(workerCount) * PROFILES_HELD_PER_WORKER;
+  Utils::BoundedQueue<PipelineProfile> pending(window);
+  Utils::BoundedQueue<PipelineProfile> computed(window);
+
+  // Compute stage: pure geometry, each worker with its own processor copy
+  Utils::TraceRecorder* recorder = Utils::currentTraceRecorder();
+  const Geometry::MedialAxisProcessor& prototype = *medialProcessor_;
+  const Geometry::VCarveCheckpoints* checkpoints = vcarveCheckpoints_.get();
+  Utils::RunErrorContext errors;
+  auto worker = [&pending, &computed, &params, &prototype, &errors, checkpoints, recorder]() {
+    runPipelineWorker(pending, computed, params, prototype, checkpoints, errors, recorder);
+  };
+
+  std::vector<std::thread> workers;
+  for (int t = 0; t < workerCount; ++t) {
+    workers.emplace_back(worker);
+  }
+  auto stopWorkers = [&pending, &computed, &workers]() {
+    pending.close();
+    computed.close();
+    for (auto& thread : workers) {
+      thread.join();
+    }
+    workers.clear();
+  };
+
+  // A surface grid must cover every profile, so its writes wait for the last medial axis
+  bool deferWrites = Adapters::projectsOntoSurface(params) && params.surfaceGridResolution > 0.0;
+  GenerationOutput output;
+  std::vector<bool> ready;
+  size_t nextSource = 0;
+  size_t nextWrite = 0;
+  size_t inFlight = 0;
+  size_t resolvedCount = 0;
+  size_t sharedCount = 0;
+
+  // Repeated outlines by canonical key; copies no larger than the source reuse its medial axis
+  std::vector<RepeatedShape> repeated;
+  std::unordered_map<uint64_t, std::vector<size_t>> repeatedByKey;
+  std::unordered_map<size_t, size_t> repeatedBySource;
+  size_t waitingCount = 0;
+  auto release = [&job, &pending](const RepeatedShape& shape, PipelineProfile& copy) {
+    const Geometry::MedialAxisResults& source = job.medialResults[shape.source];
+    Geometry::CanonicalShape copyShape;
+    copy.medialResolved = source.success && Geometry::canonicalizeShape(copy.polygon, copyShape);
+    if (copy.medialResolved) {
+      copy.medial = Geometry::transformMedialAxis(source, shape.shape, copyShape);
+      copy.medial.computeMs = 0.0;  // Mapped, not computed
+    }
+    pending.push(std::move(copy));
+  };
+
+  // Workers finish in any order; a result stored on collection could turn a later profile's
+  // extraction into a cache hit on one run and a computed or mapped medial axis on the next
+  std::vector<DeferredStore> deferredStores;
+  auto collect = [this, &job, &params, &ready, &inFlight, &repeated, &repeatedBySource, &waitingCount, &release,
+                  &deferredStores](PipelineProfile& profile) {
+    if (!profile.medialResolved && profile.holes.empty()) {
+      if (params.strictDeterminism) {
+        deferredStores.push_back(DeferredStore{profile.index, profile.cacheKey, profile.medial});
+      } else {
+        storeMedialAxis(profile.cacheKey, profile.medial, params);
+      }
+    }
+    reportProfileMedialAxis(job, profile.index, profile.medial);
+    job.medialResults[profile.index] = std::move(profile.medial);
+    job.vcarveProfiles[profile.index] = std::move(profile.vcarve);
+    if (profile.index < job.sampledPaths.size()) {
+      job.sampledPaths[profile.index] = std::move(profile.sampledPaths);
+    }
+    ready[profile.index] = true;
+    --inFlight;
+
+    auto source = repeatedBySource.find(profile.index);
+    if (source != repeatedBySource.end()) {
+      RepeatedShape& shape = repeated[source->second];
+      shape.collected = true;
+      for (auto& copy : shape.waiting) {
+        release(shape, copy);
+      }
+      waitingCount -= shape.waiting.size();
+      shape.waiting.clear();
+    }
+  };
+  // Repeated-shape sources stay: a later copy may still be mapped from them
+  size_t releasedCount = 0;
+  auto writeReady = [this, &job, &params, &output, &ready, &nextWrite, &repeatedBySource, &releasedCount]() {
+    while (nextWrite < ready.size() && ready[nextWrite]) {
+      {
+        Utils::TraceSpan writeSpan("write");
+        if (!writeGenerationProfile(job, nextWrite, output)) {
+          return false;
+        }
+      }
+      if (params.streamProfiles && repeatedBySource.count(nextWrite) == 0) {
+        releaseWrittenProfile(job, nextWrite);
+        ++releasedCount;
+      }
+      ++nextWrite;
+    }
+    return true;
+  };
+
+  bool written = true;
+  try {
+    while (true) {
+      // Write stage: whatever the workers have finished, in profile order
+      PipelineProfile profile;
+      while (computed.tryPop(profile)) {
+        collect(profile);
+      }
+      if (!deferWrites && !writeReady()) {
+        written = false;
+        break;
+      }
+
+      // Extract stage: keep the workers fed up to the in-flight window
+      bool holdRoom = !params.streamProfiles || deferWrites || job.profilePolygons.size() - nextWrite < heldLimit;
+      if (nextSource < sourceCount && inFlight < window && holdRoom) {
+        PipelineProfile next;
+        Adapters::IWorkspace::TransformParams transform;
+        bool extracted = false;
+        {
+          Utils::TraceSpan extractionSpan("extractProfiles");
+          extracted = extractProfileAt(selection, nextSource++, next.polygon, transform, next.holes);
+        }
+        std::string token = profileSourceToken(selection, nextSource - 1);
+        if (!extracted || !admitIncrementalProfile(job, next.polygon, next.holes, transform, token)) {
+          continue;
+        }
+
+        next.index = job.profilePolygons.size();
+        next.samplingDistance = applyAutoTolerance(params, next.polygon, next.holes);
+        next.checkpointKey = vcarveCheckpointKey(vcarveCheckpoints_.get(), next.polygon, next.holes, transform, params);
+        // The analytic shapes and cache keys only describe the outer loop
+        StoredMedialAxis stored = next.holes.empty()
+                                      ? resolveStoredMedialAxis(next.polygon, params, next.medial, next.cacheKey)
+                                      : StoredMedialAxis::NONE;
+        next.medialResolved = stored != StoredMedialAxis::NONE;
+        resolvedCount += next.medialResolved ? 1 : 0;
+        countStoredMedialAxis(stored, job.report);
+        job.profilePolygons.push_back(next.polygon);
+        job.profileSources.push_back(std::move(token));
+        job.checkpointKeys.push_back(next.checkpointKey);
+        job.samplingDistances.push_back(next.samplingDistance);
+        job.profileHoles.push_back(next.holes);
+        job.profileTransforms.push_back(transform);
+        job.medialResults.emplace_back();
+        job.vcarveProfiles.emplace_back();
+        if (sharesSampledPaths(params)) {
+          job.sampledPaths.emplace_back();
+        }
+        ready.push_back(false);
+        ++inFlight;
+
+        Geometry::CanonicalShape shape;
+        if (!next.medialResolved && params.shareRepeatedShapes && next.holes.empty() &&
+            Geometry::canonicalizeShape(next.polygon, shape)) {
+          std::vector<size_t>& candidates = repeatedByKey[shape.key];
+          auto match = std::find_if(candidates.begin(), candidates.end(), [&](size_t r) {
+            return Geometry::sameCanonicalShape(repeated[r].shape, shape) && shape.scale <= repeated[r].shape.scale;
+          });
+          if (match != candidates.end()) {
+            ++sharedCount;
+            RepeatedShape& source = repeated[*match];
+            if (source.collected) {
+              release(source, next);
+            } else {
+              source.waiting.push_back(std::move(next));
+              ++waitingCount;
+            }
+            continue;
+          }
+          repeatedBySource[next.index] = repeated.size();
+          candidates.push_back(repeated.size());
+          repeated.push_back(RepeatedShape{next.index, std::move(shape), false, {}});
+        }
+
+        pending.push(std::move(next));
+        continue;
+      }
+
+      // Copies still waiting on their source are queued when it is collected
+      if (nextSource == sourceCount && waitingCount == 0) {
+        pending.close();
+      }
+      if (inFlight == 0) {
+        break;
+      }
+
+      // Nothing left to extract for now: wait for a worker
+      if (computed.pop(profile)) {
+        collect(profile);
+      }
+    }
+  } catch (...) {
+    stopWorkers();
+    throw;
+  }
+  stopWorkers();
+  errors.report(logger_.get());
+
+  // Profile order also fixes which entries the memory cache evicts
+  std::sort(deferredStores.begin(), deferredStores.end(),
+            [](const DeferredStore& a, const DeferredStore& b) { return a.index < b.index; });
+  for (const auto& store : deferredStores) {
+    storeMedialAxis(store.cacheKey, store.medial, params);
+  }
+  std::vector<DeferredStore>().swap(deferredStores);
+
+  if (!written) {
+    return false;
+  }
+  if (job.profilePolygons.empty() && job.incremental.keptTags.empty()) {
+    LOG_INFO("Profile extraction failed or no polygons found");
+    ui_->showMessageBox("Medial Axis Generation - Extraction Error",
+                        "Failed to extract geometry from selected profiles.\nPlease "
+                        "ensure valid closed sketch profiles are selected.");
+    return false;
+  }
+
+  LOG_INFO("Pipelined " << job.profilePolygons.size() << " profiles on " << workerCount << " worker thread(s), "
+                        << resolvedCount << " medial axes from analytic shapes or caches, " << sharedCount
+                        << " mapped from repeated shapes");
+  if (deferWrites && !writeReady()) {
+    return false;
+  }
+  if (params.streamProfiles) {
+    LOG_INFO("Released " << releasedCount << " profiles as they were written"
+                         << (deferWrites ? "" : ", at most " + std::to_string(heldLimit) + " held unwritten"));
+  }
+  return finishGenerationOutput(job, output);
+}
+
+}  // namespace Core
+}  // namespace ChipCarving
@@ -0,0 +1,64 @@
+/**
+ * PluginManagerPipelineWorker.cpp
+ *
+ * Compute stage of pipelined Generate Paths: pure geometry, run on worker threads
+ * Split from PluginManagerPipeline.cpp for maintainability
+ */
+
+#include "PluginManagerPipelineWorker.h"
+
+#include <utility>
+
+#include "PluginManagerHelpers.h"
+#include "geometry/MedialAxisBatch.h"
+#include "geometry/VCarveCalculator.h"
+#include "utils/logging.h"
+
+namespace ChipCarving {
+namespace Core {
+
+void runPipelineWorker(Utils::BoundedQueue<PipelineProfile>& pending, Utils::BoundedQueue<PipelineProfile>& computed,
+                       const Adapters::MedialAxisParameters& params, const Geometry::MedialAxisProcessor& prototype,
+                       const Geometry::VCarveCheckpoints* checkpoints, Utils::RunErrorContext& errors,
+                       Utils::TraceRecorder* recorder) {
+  SetThreadConsoleLoggingSuppressed(true);
+  Utils::ScopedTraceRecorder trace(recorder);
+  Utils::RunErrorContext::Collector errorCollector(errors);
+  Geometry::MedialAxisProcessor processor(prototype);
+  processor.setVerbose(false);
+  Geometry::VCarveCalculator calculator;
+  std::vector<Geometry::SampledMedialPath> reusedPaths;
+  bool keepSamples = sharesSampledPaths(params);
+
+  PipelineProfile profile;
+  while (pending.pop(profile)) {
+    if (!profile.medialResolved) {
+      profile.medial = Geometry::computeMedialAxisProfile(processor, profile.polygon, profile.holes);
+    }
+    // Paths checkpointed by an earlier run that did not get to write them need no sampling
+    bool checkpointed = profile.checkpointKey != 0 && checkpoints->load(profile.checkpointKey, profile.vcarve);
+    if (!checkpointed && params.generateVCarveToolpaths && profile.medial.success &&
+        !profile.medial.chains.empty()) {
+      bool sampled = errorCollector.guard(profile.index, "V-carve computation", [&]() {
+        Utils::TraceSpan vcarveSpan("vcarveProfile");
+        auto& sampledPaths = keepSamples ? profile.sampledPaths : reusedPaths;
+        sampleMedialAxisForVCarve(processor, profile.medial, params, sampledPaths, &profile.polygon, &profile.holes,
+                                  profile.samplingDistance);
+        profile.vcarve = calculator.generateVCarvePaths(sampledPaths, params, &profile.medial.graph,
+                                                        &profile.medial.clearingLoops);
+      });
+      if (!sampled) {
+        profile.vcarve = Geometry::VCarveResults();
+        profile.sampledPaths.clear();
+      } else if (profile.checkpointKey != 0) {
+        checkpoints->store(profile.checkpointKey, profile.vcarve);
+      }
+    }
+    if (!computed.push(std::move(profile))) {
+      return;
+    }
+  }
+}
+
+}  // namespace Core
+}  // namespace ChipCarving
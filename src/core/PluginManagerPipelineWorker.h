@@ -0,0 +1,48 @@
+/**
+ * PluginManagerPipelineWorker.h
+ *
+ * Compute stage of pipelined Generate Paths (internal to src/core): the
+ * profiles passed between the stages, and the worker loop that turns an
+ * extracted profile into its medial axis and V-carve paths
+ * Split from PluginManagerPipeline.cpp for maintainability
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "GenerationJob.h"
+#include "geometry/MedialAxisProcessor.h"
+#include "geometry/VCarveCheckpoints.h"
+#include "utils/BoundedQueue.h"
+#include "utils/RunErrorContext.h"
+#include "utils/TraceSpan.h"
+
+namespace ChipCarving {
+namespace Core {
+
+// One profile on its way from the extract stage to the write stage
+struct PipelineProfile {
+  size_t index = 0;  // Position in GenerationJob's vectors
+  std::vector<Geometry::Point2D> polygon{};
+  std::vector<std::vector<Geometry::Point2D>> holes{};
+  bool medialResolved = false;  // Analytic shape or cache hit; OpenVoronoi is skipped
+  uint64_t cacheKey = 0;
+  uint64_t checkpointKey = 0;  // V-carve checkpoint (0 = none)
+  double samplingDistance = 0.0;  // mm (applyAutoTolerance)
+  Geometry::MedialAxisResults medial{};
+  Geometry::VCarveResults vcarve{};
+  std::vector<Geometry::SampledMedialPath> sampledPaths{};  // Kept for the visualization (sharesSampledPaths)
+};
+
+// Compute profiles from pending into computed until pending is closed and empty, or computed is
+// closed. Each worker runs on its own copy of prototype, with console logging off
+void runPipelineWorker(Utils::BoundedQueue<PipelineProfile>& pending, Utils::BoundedQueue<PipelineProfile>& computed,
+                       const Adapters::MedialAxisParameters& params, const Geometry::MedialAxisProcessor& prototype,
+                       const Geometry::VCarveCheckpoints* checkpoints, Utils::RunErrorContext& errors,
+                       Utils::TraceRecorder* recorder);
+
+}  // namespace Core
+}  // namespace ChipCarving
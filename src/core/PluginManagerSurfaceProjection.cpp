@@ -0,0 +1,153 @@
+/**
+ * PluginManagerSurfaceProjection.cpp
+ *
+ * Surface height queries for surface-projected V-carve toolpaths
+ * Split from PluginManagerVCarve.cpp for maintainability
+ */
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "PluginManagerHelpers.h"
+#include "utils/UnitConversion.h"
+#include "utils/logging.h"
+
+namespace ChipCarving {
+namespace Core {
+
+bool PluginManager::SurfaceProjection::buildHeightfield(const std::vector<Geometry::MedialAxisResults>& medialResults,
+                                                       const Adapters::MedialAxisParameters& params,
+                                                       Geometry::SurfaceHeightfield& heightfield) {
+  if ((!manager_.workspace_ && params.surfaceScanPath.empty()) || params.surfaceGridResolution <= 0.0) {
+    return false;
+  }
+
+  // Grid covers the medial axes of all profiles (cm), padded by one cell
+  double spacing = Utils::mmToFusionLength(params.surfaceGridResolution);
+  Geometry::Point2D minCorner(std::numeric_limits<double>::max(), std::numeric_limits<double>::max());
+  Geometry::Point2D maxCorner(std::numeric_limits<double>::lowest(), std::numeric_limits<double>::lowest());
+  bool hasPoints = false;
+  for (const auto& result : medialResults) {
+    if (!result.success) {
+      continue;
+    }
+    for (const auto& chain : result.chains) {
+      for (const auto& point : chain) {
+        minCorner.x = std::min(minCorner.x, point.x);
+        minCorner.y = std::min(minCorner.y, point.y);
+        maxCorner.x = std::max(maxCorner.x, point.x);
+        maxCorner.y = std::max(maxCorner.y, point.y);
+        hasPoints = true;
+      }
+    }
+  }
+  if (!hasPoints) {
+    return false;
+  }
+
+  Geometry::SurfaceHeightfield grid(Geometry::Point2D(minCorner.x - spacing, minCorner.y - spacing),
+                                    Geometry::Point2D(maxCorner.x + spacing, maxCorner.y + spacing), spacing);
+  std::vector<Geometry::Point2D> nodes = grid.getNodePositions();
+  if (nodes.empty() || !grid.setHeights(query(nodes, params))) {
+    LOG_WARNING("Surface heightfield sampling failed, falling back to per-point surface queries");
+    return false;
+  }
+
+  LOG_INFO("Surface heightfield: " << grid.getColumns() << " x " << grid.getRows() << " nodes at "
+                                   << grid.getSpacing() * 10.0 << " mm spacing");
+  heightfield = std::move(grid);
+  return true;
+}
+
+std::vector<double> PluginManager::SurfaceProjection::queryHeights(const std::vector<Geometry::Point2D>& points,
+                                                                   const Adapters::MedialAxisParameters& params,
+                                                                   const Geometry::SurfaceHeightfield* heightfield,
+                                                                   Geometry::SurfaceHeightMemo* memo,
+                                                                   std::vector<Geometry::Point2D>* gradients) {
+  const double NaN = std::numeric_limits<double>::quiet_NaN();
+  std::vector<double> heights(points.size(), NaN);
+  std::vector<size_t> directIndices;
+  std::vector<Geometry::Point2D> directPoints;
+  if (gradients) {
+    gradients->assign(points.size(), Geometry::Point2D(NaN, NaN));
+  }
+
+  if (heightfield && heightfield->isValid()) {
+    // Interpolate from the grid, with the slope of the same cell; points near a
+    // surface boundary (NaN cells) are queried directly so the edge stays exact
+    for (size_t i = 0; i < points.size(); ++i) {
+      Geometry::Point2D slope;
+      heights[i] = heightfield->sample(points[i].x, points[i].y, slope.x, slope.y);
+      if (gradients) {
+        (*gradients)[i] = slope;
+      }
+      if (std::isnan(heights[i])) {
+        directIndices.push_back(i);
+        directPoints.push_back(points[i]);
+      }
+    }
+    if (directPoints.empty()) {
+      return heights;
+    }
+  } else {
+    directPoints = points;
+  }
+
+  auto querySurface = [this, &params](const std::vector<Geometry::Point2D>& batch) {
+    return query(batch, params);
+  };
+  std::vector<double> direct = memo ? memo->resolve(directPoints, querySurface) : querySurface(directPoints);
+
+  if (directIndices.empty()) {
+    return direct;
+  }
+  for (size_t k = 0; k < directIndices.size(); ++k) {
+    heights[directIndices[k]] = direct[k];
+  }
+  return heights;
+}
+
+std::vector<double> PluginManager::SurfaceProjection::query(const std::vector<Geometry::Point2D>& points,
+                                                            const Adapters::MedialAxisParameters& params) {
+  std::vector<double> heights;
+  if (!params.surfaceScanPath.empty()) {
+    Geometry::ScanPlacement placement;
+    placement.originX = params.surfaceScanOriginX;
+    placement.originY = params.surfaceScanOriginY;
+    placement.pixelSize = params.surfaceScanPixelSize;
+    placement.heightRange = params.surfaceScanHeightRange;
+    placement.zOffset = params.surfaceScanZOffset;
+    std::string error;
+    auto scan = scans_.get(params.surfaceScanPath, placement, error);
+    if (!error.empty()) {
+      manager_.logger_->logError("Surface scan " + params.surfaceScanPath + ": " + error);
+    }
+    if (scan) {
+      // Scans are in mm, surface queries in Fusion lengths
+      std::vector<Geometry::Point2D> scanPoints;
+      scanPoints.reserve(points.size());
+      for (const auto& point : points) {
+        scanPoints.emplace_back(Utils::fusionLengthToMm(point.x), Utils::fusionLengthToMm(point.y));
+      }
+      heights = scan->sampleHeights(scanPoints);
+      for (double& height : heights) {
+        height = Utils::mmToFusionLength(height);
+      }
+    }
+  } else if (manager_.workspace_) {
+    heights = manager_.workspace_->getSurfaceZBatch(params.targetSurfaceId, points, params.useFaceEvaluator);
+    if (heights.size() != points.size()) {
+      manager_.logger_->logWarning("Surface Z batch returned " + std::to_string(heights.size()) + " heights for " +
+                          std::to_string(points.size()) + " points");
+    }
+  }
+  heights.resize(points.size(), std::numeric_limits<double>::quiet_NaN());
+  return heights;
+}
+
+}  // namespace Core
+}  // namespace ChipCarving
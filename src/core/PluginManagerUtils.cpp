@@ -5,7 +5,12 @@
  * Split from PluginManager.cpp for maintainability
  */
 
+#include <chrono>
+
 #include "PluginManager.h"
+#include "RunHistory.h"
+#include "geometry/MedialAxisBatch.h"
+#include "utils/logging.h"
 
 namespace ChipCarving {
 namespace Core {
@@ -22,6 +27,91 @@ void PluginManager::logShutdown() {
   }
 }
 
+void PluginManager::setRunMetricsFile(const std::string& filePath) {
+  runMetricsFile_ = filePath;
+}
+
+void PluginManager::setRunHistoryFile(const std::string& filePath) {
+  runHistoryFile_ = filePath;
+}
+
+void PluginManager::setChromeTraceDirectory(const std::string& directory) {
+  chromeTraceDirectory_ = directory;
+}
+
+bool PluginManager::isChromeTraceEnabled() const {
+  return performanceSettings_.writeChromeTrace && !chromeTraceDirectory_.empty();
+}
+
+void PluginManager::reportRunMetrics(const Adapters::MedialAxisParameters* params) {
+  if (lastRunMetrics_.empty()) {
+    return;
+  }
+  if (!runHistoryFile_.empty()) {
+    appendRunHistoryLine(params);
+  }
+  if (logger_) {
+    logger_->logInfo("⏱️ Stage timings:\n" + lastRunMetrics_.summary());
+  }
+  if (!runMetricsFile_.empty() && !lastRunMetrics_.appendTo(runMetricsFile_)) {
+    LOG_WARNING("Cannot append run metrics to " << runMetricsFile_);
+  }
+  if (!lastRunReport_.empty()) {
+    std::string report = lastRunReport_.format(lastRunMetrics_);
+    if (logger_) {
+      logger_->logInfo("⏱️ " + report);
+    }
+    if (ui_) {
+      ui_->showRunReport(report);
+    }
+  }
+}
+
+void PluginManager::appendRunHistoryLine(const Adapters::MedialAxisParameters* params) {
+  if (importedDesignHash_.empty() && !importedShapes_.empty()) {
+    importedDesignHash_ = importedDesignHash(importedShapes_);
+  }
+
+  RunHistoryEntry entry;
+  entry.pluginVersion = getVersion();
+  entry.engineVersion = Geometry::MedialAxisDiskCache::currentEngineVersion();
+  entry.designHash = importedDesignHash_;
+  if (params) {
+    entry.profiles = lastRunReport_.profiles;
+    entry.vertices = lastRunReport_.vertices;
+    entry.points = lastRunReport_.points;
+    entry.generation = true;
+    entry.threads = Geometry::resolveMedialAxisWorkerCount(params->medialAxisWorkers, lastRunReport_.profiles);
+    entry.analyticMedialAxis = params->useAnalyticMedialAxis;
+    entry.memoryCache = params->useMedialAxisCache && medialCache_;
+    entry.diskCache = entry.memoryCache && medialDiskCache_ && medialDiskCache_->isEnabled();
+    entry.shareRepeatedShapes = params->shareRepeatedShapes;
+    entry.memoryCacheHits = lastRunReport_.memoryCacheHits;
+    entry.diskCacheHits = lastRunReport_.diskCacheHits;
+  } else {
+    entry.profiles = importedShapes_.size();
+    entry.vertices = static_cast<long long>(importedShapes_.vertexCount());
+  }
+
+  if (!appendRunHistory(runHistoryFile_, entry, lastRunMetrics_)) {
+    LOG_WARNING("Cannot append run history to " << runHistoryFile_);
+  }
+}
+
+void PluginManager::writeChromeTrace(const Utils::TraceRecorder& trace) {
+  auto now = std::chrono::system_clock::now().time_since_epoch();
+  std::string path = chromeTraceDirectory_ + "/chip_carving_trace_" +
+                     std::to_string(std::chrono::duration_cast<std::chrono::milliseconds>(now).count()) + ".json";
+  if (!trace.writeTo(path)) {
+    LOG_WARNING("Cannot write Chrome trace to " << path);
+    return;
+  }
+  lastChromeTracePath_ = path;
+  if (logger_) {
+    logger_->logInfo("⏱️ Chrome trace written to " + path + " (" + std::to_string(trace.eventCount()) + " events)");
+  }
+}
+
 std::string PluginManager::formatMedialAxisResults(const Geometry::MedialAxisResults& results) {
   std::string formatted = "Chains: " + std::to_string(results.numChains) +
                           ", Points: " + std::to_string(results.totalPoints) +
@@ -5,19 +5,164 @@
  * Split from PluginManagerPaths.cpp for maintainability
  */
 
-#include "PluginManager.h"
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "IncrementalRegeneration.h"
+#include "PluginManagerHelpers.h"
 #include "geometry/Point2D.h"
 #include "geometry/Point3D.h"
+#include "geometry/MedialAxisUtilities.h"
+#include "geometry/PolylineArcFitter.h"
+#include "geometry/PolylineSimplifier.h"
 #include "geometry/VCarveCalculator.h"
+#include "utils/UnitConversion.h"
 #include "utils/logging.h"
 
 namespace ChipCarving {
 namespace Core {
 
+void sampleMedialAxisForVCarve(Geometry::MedialAxisProcessor& processor,
+                               const Geometry::MedialAxisResults& medialResult,
+                               const Adapters::MedialAxisParameters& params,
+                               std::vector<Geometry::SampledMedialPath>& sampledPaths,
+                               const std::vector<Geometry::Point2D>* outline,
+                               const std::vector<std::vector<Geometry::Point2D>>* holes, double samplingDistance) {
+  sampledPaths.clear();
+  double spacing = samplingDistance > 0.0 ? samplingDistance : params.samplingDistance;
+  bool forcing = params.forceBoundaryIntersections;
+  if (!params.adaptiveSampling && (forcing || params.exactSampling) && outline && medialResult.success) {
+    std::vector<const std::vector<Geometry::Point2D>*> boundaries{outline};
+    if (holes) {
+      for (const auto& hole : *holes) {
+        boundaries.push_back(&hole);
+      }
+    }
+    std::vector<std::vector<double>> crossings;
+    if (forcing) {
+      Geometry::findChainBoundaryCrossings(medialResult.chains, boundaries, Utils::fusionLengthToMm(1.0), crossings);
+    }
+    if (params.exactSampling) {
+      Geometry::sampleMedialAxisChainsExact(medialResult.chains, Utils::fusionLengthToMm(1.0), spacing, boundaries,
+                                            sampledPaths, forcing ? &crossings : nullptr);
+    } else {
+      Geometry::sampleMedialAxisChains(medialResult.chains, Utils::fusionLengthToMm(1.0), spacing, sampledPaths,
+                                       &crossings);
+    }
+    return;
+  }
+  if (!params.adaptiveSampling) {
+    processor.getSampledPaths(medialResult, spacing, sampledPaths);
+    return;
+  }
+
+  // Depth error is measured on the clamped V-bit depth the cut will actually use
+  Geometry::AdaptiveSamplingOptions options;
+  options.chordTolerance = params.samplingChordTolerance;
+  options.depthPerClearance = 1.0 / std::tan((params.toolAngle * M_PI / 180.0) / 2.0);
+  options.maxDepth = params.maxVCarveDepth;
+
+  // The target surface may curve where the medial axis is straight, so keep
+  // the fixed sampling distance as an upper bound when projecting
+  if (Adapters::projectsOntoSurface(params)) {
+    options.maxSpacing = spacing;
+  }
+
+  Geometry::sampleMedialAxisChainsAdaptive(medialResult.chains, Utils::fusionLengthToMm(1.0), options, sampledPaths);
+}
+
+std::vector<Geometry::VCarveResults> PluginManager::computeVCarveProfiles(
+    const std::vector<Geometry::MedialAxisResults>& medialResults, const Adapters::MedialAxisParameters& params,
+    Utils::JobProgress* progress, Geometry::MedialAxisProcessor* processor,
+    std::vector<std::vector<Geometry::SampledMedialPath>>* keptSamples, const std::vector<uint64_t>* checkpointKeys,
+    const std::vector<std::vector<Geometry::Point2D>>* outlines,
+    const std::vector<std::vector<std::vector<Geometry::Point2D>>>* holes,
+    const std::vector<double>* samplingDistances) {
+  std::vector<Geometry::VCarveResults> vcarveProfiles(medialResults.size());
+  Geometry::VCarveCalculator calculator;
+  Geometry::MedialAxisProcessor& sampler = processor ? *processor : *medialProcessor_;
+
+  // Clearing loops were traced for the processor's tool; another tool of a multi-tool run goes without them
+  Geometry::ClearingOffsets clearing = Geometry::VCarveCalculator::clearingOffsets(params);
+  const Geometry::ClearingOffsets& traced = sampler.getClearingOffsets();
+  bool useClearing = clearing.enabled() && clearing.firstOffset == traced.firstOffset &&
+                     clearing.stepover == traced.stepover;
+
+  // Sampled paths are rebuilt per profile in the same storage unless they are kept
+  std::vector<Geometry::SampledMedialPath> reusedPaths;
+  if (keptSamples) {
+    keptSamples->assign(medialResults.size(), {});
+  }
+
+  for (size_t i = 0; i < medialResults.size(); ++i) {
+    if (progress && progress->isCancelled()) {
+      break;
+    }
+
+    const auto& medialResult = medialResults[i];
+    uint64_t checkpointKey = checkpointKeys && i < checkpointKeys->size() ? (*checkpointKeys)[i] : 0;
+    if (medialResult.success && !medialResult.chains.empty()) {
+      // A checkpoint from an earlier run that did not get to write its sketches
+      bool checkpointed = checkpointKey != 0 && vcarveCheckpoints_->load(checkpointKey, vcarveProfiles[i]);
+      if (!checkpointed) {
+        // Generate V-carve paths using sampled medial axis paths for uniform
+        // spacing (and better surface following when projecting)
+        auto& sampledPaths = keptSamples ? (*keptSamples)[i] : reusedPaths;
+        const std::vector<Geometry::Point2D>* outline = outlines && i < outlines->size() ? &(*outlines)[i] : nullptr;
+        const std::vector<std::vector<Geometry::Point2D>>* profileHoles =
+            holes && i < holes->size() ? &(*holes)[i] : nullptr;
+        double spacing = samplingDistances && i < samplingDistances->size() ? (*samplingDistances)[i] : 0.0;
+        sampleMedialAxisForVCarve(sampler, medialResult, params, sampledPaths, outline, profileHoles, spacing);
+        vcarveProfiles[i] = calculator.generateVCarvePaths(sampledPaths, params, &medialResult.graph,
+                                                           useClearing ? &medialResult.clearingLoops : nullptr);
+        if (checkpointKey != 0) {
+          vcarveCheckpoints_->store(checkpointKey, vcarveProfiles[i]);
+        }
+      }
+      if (params.compactToolpathStorage) {
+        vcarveProfiles[i].compact();
+      }
+    }
+
+    if (progress) {
+      progress->advance();
+    }
+  }
+  return vcarveProfiles;
+}
+
+uint64_t vcarveCheckpointKey(const Geometry::VCarveCheckpoints* checkpoints,
+                             const std::vector<Geometry::Point2D>& polygon,
+                             const std::vector<std::vector<Geometry::Point2D>>& holes,
+                             const Adapters::IWorkspace::TransformParams& transform,
+                             const Adapters::MedialAxisParameters& params) {
+  if (!params.checkpointToolpaths || !params.generateVCarveToolpaths || !checkpoints || !checkpoints->isEnabled()) {
+    return 0;
+  }
+  // The tag already covers the outline, holes, plane and every toolpath parameter
+  return std::stoull(profileToolpathTag(polygon, holes, transform, params), nullptr, 16);
+}
+
+void removeVCarveCheckpoints(Geometry::VCarveCheckpoints* checkpoints, const GenerationJob& job) {
+  if (!checkpoints) {
+    return;
+  }
+  for (uint64_t key : job.checkpointKeys) {
+    if (key != 0) {
+      checkpoints->remove(key);
+    }
+  }
+}
+
 bool PluginManager::generateVCarveToolpaths(const std::vector<Geometry::MedialAxisResults>& medialResults,
                                             const Adapters::MedialAxisParameters& params, Adapters::ISketch* sketch,
-                                            const std::vector<Adapters::IWorkspace::TransformParams>& transforms) {
-  if (!sketch || medialResults.empty()) {
+                                            const std::vector<Adapters::IWorkspace::TransformParams>& transforms,
+                                            Geometry::GcodeWriter* gcode) {
+  if ((!sketch && !gcode) || medialResults.empty()) {
     return false;
   }
 
@@ -26,184 +171,169 @@ bool PluginManager::generateVCarveToolpaths(const std::vector<Geometry::MedialAx
   }
 
   try {
-    // NOTE: Not applying any coordinate transformations
-    // Fusion handles the transformation when creating sketch entities on the
-    // correct plane
+    std::vector<Geometry::VCarveResults> vcarveProfiles = computeVCarveProfiles(medialResults, params);
+    return writeVCarveToolpaths(vcarveProfiles, medialResults, params, sketch, transforms, gcode);
+  } catch (const std::exception& e) {
+    logger_->logError("Exception in generateVCarveToolpaths: " + std::string(e.what()));
+    return false;
+  } catch (...) {
+    logger_->logError("Unknown exception in generateVCarveToolpaths");
+    return false;
+  }
+}
 
-    // Create V-carve calculator
-    Geometry::VCarveCalculator calculator;
+bool PluginManager::writeVCarveToolpaths(std::vector<Geometry::VCarveResults>& vcarveProfiles,
+                                         const std::vector<Geometry::MedialAxisResults>& medialResults,
+                                         const Adapters::MedialAxisParameters& params, Adapters::ISketch* sketch,
+                                         const std::vector<Adapters::IWorkspace::TransformParams>& transforms,
+                                         Geometry::GcodeWriter* gcode) {
+  if ((!sketch && !gcode) || vcarveProfiles.empty()) {
+    return false;
+  }
 
-    int totalVCarvePaths = 0;
+  if (transforms.size() != vcarveProfiles.size() || medialResults.size() != vcarveProfiles.size()) {
+    return false;
+  }
 
-    // Process each medial axis result independently
-    for (size_t i = 0; i < medialResults.size(); ++i) {
-      const auto& medialResult = medialResults[i];
-      const auto& transform = transforms[i];  // Get corresponding transform for this profile
+  // Solve the sketch once after all toolpath curves are added
+  Adapters::SketchBulkEdit bulkEdit(sketch);
 
-      if (!medialResult.success || medialResult.chains.empty()) {
-        continue;
-      }
+  try {
+    // Sample curved target surfaces once on a grid shared by all profiles
+    VCarveWriteState state;
+    state.hasHeightfield =
+        Adapters::projectsOntoSurface(params) && surface_->buildHeightfield(medialResults, params, state.heightfield);
+
+    // Process each profile's V-carve paths independently
+    for (size_t i = 0; i < vcarveProfiles.size(); ++i) {
+      writeVCarveProfile(vcarveProfiles[i], transforms[i], params, sketch, gcode, state);
+    }
+    logVCarveWriteState(state);
 
-      // Get sketch plane Z in mm (transform stores it in cm)
-      double sketchPlaneZ_mm = transform.sketchPlaneZ * 10.0;
-
-      Geometry::VCarveResults vcarveResults;
-
-      // Check if surface projection is needed
-      if (params.projectToSurface && !params.targetSurfaceId.empty() && workspace_) {
-        // Create surface query function that calls workspace
-        // FIXED: Medial axis coordinates are already in cm, don't convert again
-        auto surfaceQuery = [this, &params](double x_cm, double y_cm) -> double {
-          // Coordinates are already in cm, no conversion needed
-          double z_cm = workspace_->getSurfaceZAtXY(params.targetSurfaceId, x_cm, y_cm);
-          // Convert result back to mm for V-carve calculator
-          double z_mm = z_cm * 10.0;
-
-          // FIXED: Debug logging to trace surface query conversion
-          static int queryCount = 0;
-          if (queryCount < 3) {
-            LOG_DEBUG("[SURFACE QUERY TRACE] Query " << queryCount << ": (" << x_cm << ", " << y_cm
-                                                     << ") cm -> z_cm=" << z_cm << " cm -> z_mm=" << z_mm << " mm");
-            queryCount++;
-          }
-
-          return z_mm;
-        };
-
-        // Generate sampled paths for this specific medial result
-        auto sampledPaths = medialProcessor_->getSampledPaths(medialResult, params.samplingDistance);
-
-        // Generate V-carve paths using sampled medial axis paths for better
-        // surface following This uses the user-specified sampling distance for
-        // uniform spacing
-        vcarveResults = calculator.generateVCarvePaths(sampledPaths, params);
-
-        // Apply surface projection to the V-carve points
-        for (auto& vcarvePath : vcarveResults.paths) {
-          for (auto& vcarvePoint : vcarvePath.points) {
-            // Query surface Z at this XY position
-            // FIXED: Convert mm coordinates to cm for surface query
-            double x_cm = vcarvePoint.position.x / 10.0;
-            double y_cm = vcarvePoint.position.y / 10.0;
-            double surfaceZ_mm = surfaceQuery(x_cm, y_cm);
-
-            // FIXED: Debug logging for surface Z storage
-            static int storeCount = 0;
-            if (storeCount < 3) {
-              LOG_DEBUG("[SURFACE STORE TRACE] Store " << storeCount << ": position(" << vcarvePoint.position.x << ", "
-                                                       << vcarvePoint.position.y
-                                                       << ") mm -> surfaceZ_mm=" << surfaceZ_mm << " mm");
-              storeCount++;
-            }
-
-            if (!std::isnan(surfaceZ_mm)) {
-              // Store the original depth (how deep below sketch plane)
-              double originalDepth = vcarvePoint.depth;
-
-              // For surface projection, we need to store how far below the
-              // surface to carve NOT the absolute Z position
-
-              // Store the original carve depth with a marker to indicate
-              // surface projection We use a large negative offset to
-              // distinguish from regular depths
-              const double SURFACE_PROJECTION_MARKER = -1000000.0;
-              vcarvePoint.depth = SURFACE_PROJECTION_MARKER - originalDepth;
-
-              // Also store the surface Z for later use
-              // We'll use the clearanceRadius field temporarily since we're
-              // already calculating it
-              vcarvePoint.clearanceRadius = surfaceZ_mm;
-            }
-          }
-        }
-      } else {
-        // Generate sampled paths for this specific medial result
-        auto sampledPaths = medialProcessor_->getSampledPaths(medialResult, params.samplingDistance);
+    return state.totalPaths > 0;
+  } catch (const std::exception& e) {
+    logger_->logError("Exception in writeVCarveToolpaths: " + std::string(e.what()));
+    return false;
+  } catch (...) {
+    logger_->logError("Unknown exception in writeVCarveToolpaths");
+    return false;
+  }
+}
 
-        // Generate V-carve paths using sampled medial axis paths for uniform
-        // spacing
-        vcarveResults = calculator.generateVCarvePaths(sampledPaths, params);
+void PluginManager::writeVCarveProfile(Geometry::VCarveResults& vcarveResults,
+                                       const Adapters::IWorkspace::TransformParams& transform,
+                                       const Adapters::MedialAxisParameters& params, Adapters::ISketch* sketch,
+                                       Geometry::GcodeWriter* gcode, VCarveWriteState& state) {
+  if (!vcarveResults.success) {
+    return;
+  }
+  vcarveResults.expand();
+
+  // NOTE: Not applying any coordinate transformations
+  // Fusion handles the transformation when creating sketch entities on the
+  // correct plane
+
+  // Toolpaths are in mm; the transform and the surface queries are Fusion lengths (cm)
+  double sketchPlaneZ_mm = Utils::fusionLengthToMm(transform.sketchPlaneZ);
+
+  // Query surface Z for every V-carve point of this profile in one batch
+  bool projecting = Adapters::projectsOntoSurface(params) && (workspace_ || !params.surfaceScanPath.empty());
+  std::vector<double> surfaceZs_cm;
+  std::vector<Geometry::Point2D> surfaceGradients;
+  if (projecting) {
+    std::vector<Geometry::Point2D> queryPoints;
+    for (const auto& vcarvePath : vcarveResults.paths) {
+      for (const auto& vcarvePoint : vcarvePath.points) {
+        queryPoints.emplace_back(Utils::mmToFusionLength(vcarvePoint.position.x),
+                                 Utils::mmToFusionLength(vcarvePoint.position.y));
       }
+    }
+    surfaceZs_cm = surface_->queryHeights(queryPoints, params, state.hasHeightfield ? &state.heightfield : nullptr,
+                                       &state.surfaceHeights, &surfaceGradients);
+  }
 
-      if (!vcarveResults.success) {
-        continue;
+  // Project and emit in one pass; points without a surface carve below the sketch plane.
+  // Sketch curves are collected and added in one batch per profile
+  std::vector<std::vector<Geometry::Point3D>>& sketchPaths = state.sketchPaths;
+  std::vector<std::vector<Geometry::PolylineSpan>>& sketchSpans = state.sketchSpans;
+  sketchPaths.clear();
+  sketchSpans.clear();
+  size_t queryIndex = 0;
+  for (auto& vcarvePath : vcarveResults.paths) {
+    if (projecting) {
+      size_t pathStart = queryIndex;
+      for (auto& vcarvePoint : vcarvePath.points) {
+        double surfaceZ_cm = surfaceZs_cm[queryIndex++];
+        if (!std::isnan(surfaceZ_cm)) {
+          vcarvePoint.projectToSurface(Utils::fusionLengthToMm(surfaceZ_cm));
+        }
+      }
+      // Gradients are unitless, so the cm heightfield slopes apply to the mm path as they are
+      if (params.surfaceSlopeCompensation) {
+        Geometry::VCarveCalculator::compensateSurfaceSlope(vcarvePath, surfaceGradients.data() + pathStart,
+                                                           params.maxVCarveDepth);
       }
+    }
+    if (!vcarvePath.isValid()) {
+      continue;
+    }
 
-      // Add V-carve paths to sketch as 3D splines
-      for (const auto& vcarvePath : vcarveResults.paths) {
-        if (!vcarvePath.isValid()) {
-          continue;
-        }
+    // XY are in world coordinates, Z is relative to the sketch plane: Fusion
+    // interprets 3D sketch Z coordinates relative to the plane
+    std::vector<Geometry::Point3D> splinePoints;
+    splinePoints.reserve(vcarvePath.points.size());
+    for (const auto& vcarvePoint : vcarvePath.points) {
+      splinePoints.emplace_back(vcarvePoint.position.x, vcarvePoint.position.y,
+                                vcarvePoint.sketchRelativeZ(sketchPlaneZ_mm));
+    }
 
-        // Convert VCarvePoints to Point3D for spline creation
-        std::vector<Geometry::Point3D> splinePoints;
-        splinePoints.reserve(vcarvePath.points.size());
-
-        for (const auto& vcarvePoint : vcarvePath.points) {
-          // V-carve points are already in world coordinates (mm)
-          double x_world_mm = vcarvePoint.position.x;
-          double y_world_mm = vcarvePoint.position.y;
-
-          // Calculate Z coordinate
-          // IMPORTANT: Fusion interprets 3D sketch Z coordinates as RELATIVE to
-          // the sketch plane
-          double z_sketch_relative_mm;
-
-          const double SURFACE_PROJECTION_MARKER = -1000000.0;
-          if (vcarvePoint.depth < SURFACE_PROJECTION_MARKER + 1000.0) {
-            // This is a surface projection point
-            // Extract the carve depth from the encoded value
-            double carveDepth = -(vcarvePoint.depth - SURFACE_PROJECTION_MARKER);
-            double surfaceZ_mm = vcarvePoint.clearanceRadius;  // Temporarily stored here
-
-            // Calculate the target Z position (surfaceZ - carveDepth)
-            double targetZ_mm = surfaceZ_mm - sketchPlaneZ_mm - carveDepth;
-
-            // Convert to sketch-relative coordinates
-            z_sketch_relative_mm = targetZ_mm;
-
-            // FIXED: Debug logging to understand V-carve positioning
-            static int debugCount = 0;
-            if (debugCount < 5) {
-              LOG_DEBUG("[VCARVE DEBUG] Point " << debugCount << ": surfaceZ=" << surfaceZ_mm
-                                                << "mm, carveDepth=" << carveDepth << "mm, targetZ=" << targetZ_mm
-                                                << "mm, sketchPlaneZ=" << sketchPlaneZ_mm
-                                                << "mm, z_relative=" << z_sketch_relative_mm << "mm");
-              debugCount++;
-            }
-          } else {
-            // Regular depth, carve below the sketch plane
-            z_sketch_relative_mm = -vcarvePoint.depth;
-          }
-
-          // Create 3D point with sketch-relative coordinates
-          // XY are in world coordinates, Z is relative to sketch plane
-          Geometry::Point3D point3D(x_world_mm, y_world_mm, z_sketch_relative_mm);
-          splinePoints.push_back(point3D);
-        }
+    state.fitPointsBefore += splinePoints.size();
+    if (params.pathSimplifyTolerance > 0.0) {
+      state.fitPointsRemoved += state.simplifier.simplify(splinePoints, params.pathSimplifyTolerance);
+    }
 
-        // Add 3D spline to sketch
-        if (splinePoints.size() >= 2) {
-          bool success = sketch->addSpline3D(splinePoints);
-          if (!success) {
-            logger_->logWarning("Failed to add V-carve 3D spline to sketch");
-          }
-        } else {
-          logger_->logWarning("V-carve path has insufficient points for spline creation");
-        }
+    // Stream the path to G-code with the same sketch-relative Z
+    if (gcode) {
+      gcode->writePath(splinePoints);
+      if (!sketch) {
+        continue;
       }
+    }
 
-      // Update totals
-      totalVCarvePaths += vcarveResults.totalPaths;
+    if (splinePoints.size() < 2) {
+      logger_->logWarning("V-carve path has insufficient points for spline creation");
+      continue;
+    }
+    if (params.outputPolylines) {
+      // Arcs are only fitted where they stay within the simplification tolerance
+      sketchSpans.push_back(Geometry::fitPolylineSpans(splinePoints, params.pathSimplifyTolerance));
     }
+    sketchPaths.push_back(std::move(splinePoints));
+  }
 
-    return totalVCarvePaths > 0;
-  } catch (const std::exception& e) {
-    logger_->logError("Exception in generateVCarveToolpaths: " + std::string(e.what()));
-    return false;
-  } catch (...) {
-    logger_->logError("Unknown exception in generateVCarveToolpaths");
-    return false;
+  // Add 3D splines (or chained lines and arcs) to sketch
+  if (sketch && !sketchPaths.empty()) {
+    std::vector<bool> created =
+        params.outputPolylines ? sketch->addPolylines3D(sketchPaths, sketchSpans) : sketch->addSplines3D(sketchPaths);
+    size_t failed = sketchPaths.size() - static_cast<size_t>(std::count(created.begin(), created.end(), true));
+    if (failed > 0) {
+      logger_->logWarning("Failed to add " + std::to_string(failed) + " of " + std::to_string(sketchPaths.size()) +
+                          (params.outputPolylines ? " V-carve 3D polylines" : " V-carve 3D splines") + " to sketch");
+    }
+  }
+
+  state.totalPaths += vcarveResults.totalPaths;
+}
+
+void PluginManager::logVCarveWriteState(const VCarveWriteState& state) {
+  if (state.surfaceHeights.size() > 0) {
+    LOG_INFO("Surface queries: " << state.surfaceHeights.size() << " distinct XY locations, "
+                                 << state.surfaceHeights.hitCount() << " repeats answered from the memo");
+  }
+  if (state.fitPointsRemoved > 0) {
+    LOG_INFO("V-carve spline fit points: " << state.fitPointsBefore << " -> "
+                                           << (state.fitPointsBefore - state.fitPointsRemoved)
+                                           << " after simplification");
   }
 }
 
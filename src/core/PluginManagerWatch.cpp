@@ -0,0 +1,94 @@
+/**
+ * PluginManagerWatch.cpp
+ *
+ * Watch mode for PluginManager: a saved change of the last imported design
+ * updates its sketch in place and repeats the last Generate Paths run over
+ * the import sketch's fresh profiles as an incremental background job
+ */
+
+#include <algorithm>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "ImportDiff.h"
+#include "IncrementalRegeneration.h"
+#include "PluginManagerHelpers.h"
+#include "utils/logging.h"
+
+namespace ChipCarving {
+namespace Core {
+
+bool PluginManager::setDesignWatchEnabled(bool enabled, int pollMs) {
+  if (!enabled || !initialized_ || lastImportedFile_.empty()) {
+    designWatch_.reset();
+    return !enabled;
+  }
+  if (!designWatch_ || designWatch_->filePath() != lastImportedFile_) {
+    designWatch_ = std::make_unique<DesignWatch>(lastImportedFile_, ui_.get(), pollMs);
+    LOG_INFO("Watching " << lastImportedFile_ << " for changes");
+  }
+  return true;
+}
+
+void PluginManager::pumpDesignWatch() {
+  // A running job's results are written first; the change waits in the watcher until then
+  if (!designWatch_ || background_->isRunning()) {
+    return;
+  }
+  // Another file was imported since the watch started
+  if (designWatch_->filePath() != lastImportedFile_) {
+    setDesignWatchEnabled(true);
+    return;
+  }
+
+  Parsers::DesignFile design;
+  std::string errorMessage;
+  if (!designWatch_->takeChange(design, errorMessage)) {
+    return;
+  }
+  const std::string filePath = designWatch_->filePath();
+  if (!errorMessage.empty()) {
+    logger_->logWarning("Watched design " + filePath + " could not be read, keeping the last import: " + errorMessage);
+    return;
+  }
+
+  LOG_INFO("Watched design " << filePath << " changed, updating its import");
+  std::vector<Parsers::DesignFile> designs;
+  designs.push_back(std::move(design));
+  if (!importDesigns({filePath}, &designs, lastImportedPlaneEntityId_, true)) {
+    return;
+  }
+
+  // Only toolpaths generated from the import sketch follow it
+  WatchedGeneration generation = lastGeneration_;
+  const std::string sketchName = importSketchName({filePath}, 0);
+  if (std::find(generation.sketchNames.begin(), generation.sketchNames.end(), sketchName) ==
+      generation.sketchNames.end()) {
+    return;
+  }
+  if (!canRegenerateIncrementally(generation.params)) {
+    LOG_INFO("Watch mode repeats only incremental Generate Paths runs; run Generate Paths to update the toolpaths");
+    return;
+  }
+
+  // The earlier selection's profiles were cached before the sketch changed, so every sketch it spanned is read again
+  Adapters::SketchSelection selection;
+  for (const auto& name : generation.sketchNames) {
+    Adapters::SketchSelection profiles = workspace_->getSketchProfiles(name);
+    selection.selectedEntityIds.insert(selection.selectedEntityIds.end(), profiles.selectedEntityIds.begin(),
+                                       profiles.selectedEntityIds.end());
+    selection.selectedProfiles.insert(selection.selectedProfiles.end(), profiles.selectedProfiles.begin(),
+                                      profiles.selectedProfiles.end());
+    selection.closedPathCount += profiles.closedPathCount;
+  }
+  selection.isValid = selection.closedPathCount > 0;
+  if (!selection.isValid) {
+    LOG_INFO("Watched design " << filePath << " has no closed profiles left to regenerate");
+    return;
+  }
+  startMedialAxisGeneration(selection, generation.params);
+}
+
+}  // namespace Core
+}  // namespace ChipCarving
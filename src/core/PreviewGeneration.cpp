@@ -0,0 +1,219 @@
+/**
+ * PreviewGeneration.cpp
+ *
+ * Debounced, cancellable Generate Paths preview drawn as custom graphics
+ */
+
+#include "PreviewGeneration.h"
+
+#include <algorithm>
+#include <exception>
+#include <string>
+#include <thread>
+#include <utility>
+
+#include "geometry/MedialAxisDistanceField.h"
+#include "geometry/MedialAxisProcessor.h"
+#include "geometry/Point3D.h"
+#include "geometry/VCarveCalculator.h"
+#include "utils/UnitConversion.h"
+#include "utils/logging.h"
+
+namespace ChipCarving {
+namespace Core {
+
+namespace {
+
+constexpr const char* PREVIEW_GRAPHICS_NAME = "Generate Paths Preview";
+
+void polygonizePreviewProfiles(GenerationJob& job, double curveTolerance) {
+  for (const auto& profile : job.previewProfiles) {
+    std::vector<Geometry::Point2D> polygon = cachedProfileOutline(profile, curveTolerance);
+    if (polygon.size() < 3) {
+      continue;
+    }
+    job.profilePolygons.push_back(std::move(polygon));
+    job.profileTransforms.push_back(profile.transform);
+    job.profileHoles.push_back(cachedProfileHoles(profile, curveTolerance));
+  }
+}
+
+// Pure geometry on the preview worker: no caches, analytic shapes or Fusion calls. Medial axes come from the
+// distance-field engine, whose cost follows its pixel budget rather than the profiles' vertex counts.
+void computePreview(GenerationJob& job, double medialThreshold) {
+  const Adapters::MedialAxisParameters& params = job.params;
+  // Profile vertices are in Fusion units (cm), like Generate Paths
+  Geometry::MedialAxisProcessor processor(Utils::mmToFusionLength(params.polygonTolerance), medialThreshold);
+  processor.setSimplifyInput(true);
+  processor.setSpurPruning(spurPruningOptions(params));
+  polygonizePreviewProfiles(job, processor.getPolygonTolerance());
+
+  job.progress.beginStage("Previewing medial axes", job.profilePolygons.size());
+  job.medialResults = Geometry::computeDistanceFieldMedialAxisBatch(
+      job.profilePolygons, Geometry::distanceFieldOptions(processor, params.medialAxisWorkers),
+      params.medialAxisWorkers, &job.progress, &job.profileHoles);
+  if (!params.generateVCarveToolpaths) {
+    return;
+  }
+
+  job.progress.beginStage("Previewing V-carve toolpaths", job.medialResults.size());
+  job.vcarveProfiles.resize(job.medialResults.size());
+  Geometry::VCarveCalculator calculator;
+  std::vector<Geometry::SampledMedialPath> sampledPaths;
+  for (size_t i = 0; i < job.medialResults.size(); ++i) {
+    if (job.progress.isCancelled()) {
+      return;
+    }
+    const Geometry::MedialAxisResults& medialResult = job.medialResults[i];
+    if (medialResult.success && !medialResult.chains.empty()) {
+      sampledPaths.clear();
+      processor.getSampledPaths(medialResult, params.samplingDistance, sampledPaths);
+      job.vcarveProfiles[i] = calculator.generateVCarvePaths(sampledPaths, params, &medialResult.graph);
+    }
+    job.progress.advance();
+  }
+}
+
+}  // namespace
+
+PreviewGeneration::PreviewGeneration(Adapters::IUserInterface* ui, Adapters::IWorkspace* workspace,
+                                     double medialThreshold)
+    : ui_(ui), workspace_(workspace), medialThreshold_(medialThreshold) {}
+
+PreviewGeneration::~PreviewGeneration() {
+  retireJob();
+  for (auto& stale : staleJobs_) {
+    stale->worker.join();
+  }
+}
+
+Adapters::MedialAxisParameters PreviewGeneration::coarseParameters(const Adapters::MedialAxisParameters& params) {
+  Adapters::MedialAxisParameters coarse = params;
+  coarse.polygonTolerance *= COARSENING;
+  coarse.samplingDistance *= COARSENING;
+  coarse.adaptiveSampling = false;
+  coarse.projectToSurface = false;  // Surface queries are Fusion calls; the preview stays on the sketch plane
+  return coarse;
+}
+
+void PreviewGeneration::retireJob() {
+  if (job_) {
+    job_->progress.cancel();
+    staleJobs_.push_back(std::move(job_));
+  }
+}
+
+bool PreviewGeneration::start(const Adapters::SketchSelection& selection,
+                              const Adapters::MedialAxisParameters& params) {
+  retireJob();
+
+  // Only the geometry the dialog extracted as profiles were selected: the
+  // preview must not look entities up again on every input change
+  auto job = std::make_unique<GenerationJob>();
+  job->params = coarseParameters(params);
+  for (const auto& profile : selection.selectedProfiles) {
+    if (profile.vertices.size() >= 3 || !profile.curves.empty()) {
+      job->previewProfiles.push_back(profile);
+    }
+  }
+  if (job->previewProfiles.empty()) {
+    workspace_->removeCustomGraphics(PREVIEW_GRAPHICS_NAME);
+    return false;
+  }
+
+  Adapters::IUserInterface* ui = ui_;
+  job->progress.setListener([ui]() { ui->notifyMainThread(); });
+
+  GenerationJob* running = job.get();
+  double medialThreshold = medialThreshold_;
+  int debounceMs = debounceMs_;
+  job_ = std::move(job);
+  running->worker = std::thread([running, medialThreshold, debounceMs]() {
+    SetThreadConsoleLoggingSuppressed(true);
+    if (running->progress.waitUnlessCancelled(debounceMs)) {
+      try {
+        computePreview(*running, medialThreshold);
+      } catch (const std::exception& e) {
+        running->errorMessage = e.what();
+      } catch (...) {
+        running->errorMessage = "Unknown error";
+      }
+    }
+    running->progress.finish();
+  });
+  return true;
+}
+
+bool PreviewGeneration::pump() {
+  // Superseded workers stop at their next cancellation check
+  staleJobs_.erase(std::remove_if(staleJobs_.begin(), staleJobs_.end(),
+                                  [](const std::unique_ptr<GenerationJob>& stale) {
+                                    if (!stale->progress.isFinished()) {
+                                      return false;
+                                    }
+                                    stale->worker.join();
+                                    return true;
+                                  }),
+                   staleJobs_.end());
+
+  if (!job_) {
+    return false;
+  }
+  if (!job_->progress.isFinished()) {
+    return true;
+  }
+
+  job_->worker.join();
+  std::unique_ptr<GenerationJob> finished = std::move(job_);
+  if (!finished->errorMessage.empty()) {
+    LOG_WARNING("Generate Paths preview failed: " << finished->errorMessage);
+    return false;
+  }
+  draw(*finished);
+  return false;
+}
+
+void PreviewGeneration::clear() {
+  retireJob();
+  workspace_->removeCustomGraphics(PREVIEW_GRAPHICS_NAME);
+}
+
+void PreviewGeneration::draw(const GenerationJob& job) {
+  // V-carve paths at cut depth below the sketch plane, or the bare medial axis on it
+  std::vector<std::vector<Geometry::Point3D>> polylines;
+  for (size_t i = 0; i < job.medialResults.size(); ++i) {
+    double planeZ = job.profileTransforms[i].sketchPlaneZ;
+    if (i < job.vcarveProfiles.size() && job.vcarveProfiles[i].success) {
+      for (const auto& path : job.vcarveProfiles[i].paths) {
+        polylines.emplace_back();
+        for (const auto& point : path.points) {
+          polylines.back().emplace_back(Utils::mmToFusionLength(point.position.x),
+                                        Utils::mmToFusionLength(point.position.y),
+                                        planeZ - Utils::mmToFusionLength(point.depth));
+        }
+      }
+      continue;
+    }
+    if (!job.medialResults[i].success) {
+      continue;
+    }
+    const Geometry::MedialAxisChains& chains = job.medialResults[i].chains;
+    for (size_t k = 0; k < chains.size(); ++k) {
+      polylines.emplace_back();
+      for (size_t p = 0; p < chains[k].size(); ++p) {
+        Geometry::Point2D point = chains[k][p];
+        polylines.back().emplace_back(point.x, point.y, planeZ);
+      }
+    }
+  }
+
+  std::unique_ptr<Adapters::ICustomGraphics> graphics = workspace_->createCustomGraphics(PREVIEW_GRAPHICS_NAME);
+  if (graphics) {
+    graphics->addLineStrips(polylines, Adapters::ICustomGraphics::Role::PREVIEW);
+  }
+  LOG_DEBUG("Generate Paths preview: " << polylines.size() << " polylines for " << job.medialResults.size()
+                                       << " profiles");
+}
+
+}  // namespace Core
+}  // namespace ChipCarving
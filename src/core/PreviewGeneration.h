@@ -0,0 +1,83 @@
+/**
+ * PreviewGeneration.h
+ *
+ * Live low-resolution Generate Paths preview for the command dialog. Medial
+ * axes (and V-carve paths) are computed at coarse tolerances on a worker
+ * thread and drawn as transient custom graphics instead of sketch entities,
+ * so parameters can be tuned without a full run and an undo. The medial axes
+ * are the distance-field engine's approximations, one pixel per coarse
+ * polygon tolerance within a fixed pixel budget per profile, so a preview
+ * never waits on a pathological outline's Voronoi diagram.
+ */
+
+#pragma once
+
+#include <memory>
+#include <vector>
+
+#include "GenerationJob.h"
+#include "adapters/IFusionInterface.h"
+
+namespace ChipCarving {
+namespace Core {
+
+class PreviewGeneration {
+ public:
+  static constexpr int DEFAULT_DEBOUNCE_MS = 250;  // Quiet time after the last input change before computing
+  static constexpr double COARSENING = 4.0;        // Preview polygon tolerance and sampling distance multiplier
+
+  /**
+   * @param ui Notified from the worker so the main thread calls pump()
+   * @param workspace Draws the preview graphics (main thread only)
+   * @param medialThreshold Same medial axis filter as Generate Paths
+   */
+  PreviewGeneration(Adapters::IUserInterface* ui, Adapters::IWorkspace* workspace, double medialThreshold);
+  ~PreviewGeneration();
+
+  PreviewGeneration(const PreviewGeneration&) = delete;
+  PreviewGeneration& operator=(const PreviewGeneration&) = delete;
+
+  // The dialog's parameters at preview resolution (sampling at a fixed distance, no surface projection)
+  static Adapters::MedialAxisParameters coarseParameters(const Adapters::MedialAxisParameters& params);
+
+  /**
+   * Replace the running preview with one of selection's cached profile
+   * geometry. The previous job is cancelled; the new worker first waits out
+   * the debounce delay, so a burst of input changes computes only the last one
+   * @return false if no profile can be previewed (any shown graphics are removed)
+   */
+  bool start(const Adapters::SketchSelection& selection, const Adapters::MedialAxisParameters& params);
+
+  /**
+   * Main-thread tick: joins cancelled workers once they stop and draws the
+   * current preview when it finishes
+   * @return true while the current preview is still computing
+   */
+  bool pump();
+
+  // Cancel any preview and remove its graphics (dialog executed or closed)
+  void clear();
+
+  bool isRunning() const {
+    return job_ != nullptr;
+  }
+  void setDebounceMs(int debounceMs) {
+    debounceMs_ = debounceMs;
+  }
+
+ private:
+  // Cancel the current job; pump() joins its worker once it has stopped
+  void retireJob();
+  void draw(const GenerationJob& job);
+
+  Adapters::IUserInterface* ui_;
+  Adapters::IWorkspace* workspace_;
+  double medialThreshold_;
+  int debounceMs_ = DEFAULT_DEBOUNCE_MS;
+
+  std::unique_ptr<GenerationJob> job_{};
+  std::vector<std::unique_ptr<GenerationJob>> staleJobs_{};
+};
+
+}  // namespace Core
+}  // namespace ChipCarving
@@ -0,0 +1,146 @@
+/**
+ * RunHistory.cpp
+ *
+ * Append-only JSON-lines history of Import Design and Generate Paths runs
+ */
+
+#include "RunHistory.h"
+
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <fstream>
+#include <vector>
+
+#include "ImportDiff.h"
+#include "utils/TraceJson.h"
+
+namespace ChipCarving {
+namespace Core {
+
+namespace {
+
+void appendMember(std::string& json, const char* name, const std::string& value) {
+  json += ",\"";
+  json += name;
+  json += "\":";
+  Utils::appendJsonString(json, value);
+}
+
+void appendNumber(std::string& json, const char* name, long long value) {
+  json += ",\"";
+  json += name;
+  json += "\":" + std::to_string(value);
+}
+
+void appendBool(std::string& json, const char* name, bool value, bool first = false) {
+  json += first ? "\"" : ",\"";
+  json += name;
+  json += value ? "\":true" : "\":false";
+}
+
+// Root spans and their children; deeper spans stay in the metrics file
+bool isStage(const std::vector<Utils::RunMetrics::Span>& spans, size_t index) {
+  size_t parent = spans[index].parent;
+  return parent == Utils::RunMetrics::NO_PARENT || spans[parent].parent == Utils::RunMetrics::NO_PARENT;
+}
+
+// "name":{"stage path":bytes,...} over the stages with a nonzero value; nothing if there are none
+template <typename Bytes>
+void appendStageBytes(std::string& json, const char* name, const Utils::RunMetrics& metrics, Bytes bytesOf) {
+  const auto& spans = metrics.spans();
+  std::string members;
+  for (size_t i = 0; i < spans.size(); ++i) {
+    uint64_t bytes = bytesOf(spans[i]);
+    if (!isStage(spans, i) || bytes == 0) {
+      continue;
+    }
+    members += members.empty() ? "" : ",";
+    Utils::appendJsonString(members, metrics.pathOf(i));
+    members += ":" + std::to_string(bytes);
+  }
+  if (!members.empty()) {
+    json += ",\"";
+    json += name;
+    json += "\":{" + members + "}";
+  }
+}
+
+}  // namespace
+
+std::string runHistoryJson(const RunHistoryEntry& entry, const Utils::RunMetrics& metrics) {
+  const auto& spans = metrics.spans();
+  long long unixTime =
+      std::chrono::duration_cast<std::chrono::seconds>(std::chrono::system_clock::now().time_since_epoch()).count();
+
+  std::string json = "{\"unixTime\":" + std::to_string(unixTime);
+  appendMember(json, "command", spans.empty() ? std::string() : std::string(spans.front().name));
+  appendMember(json, "pluginVersion", entry.pluginVersion);
+  appendMember(json, "engineVersion", entry.engineVersion);
+  appendMember(json, "designHash", entry.designHash);
+  appendNumber(json, "profiles", static_cast<long long>(entry.profiles));
+  appendNumber(json, "vertices", entry.vertices);
+  appendNumber(json, "points", entry.points);
+
+  json += ",\"stages\":{";
+  bool first = true;
+  for (size_t i = 0; i < spans.size(); ++i) {
+    if (!isStage(spans, i)) {
+      continue;
+    }
+    if (!first) {
+      json.push_back(',');
+    }
+    first = false;
+    Utils::appendJsonString(json, metrics.pathOf(i));
+    json += ":" + Utils::formatFixed(spans[i].totalMs);
+  }
+  json.push_back('}');
+  appendStageBytes(json, "peakResidentBytes", metrics,
+                   [](const Utils::RunMetrics::Span& span) { return span.peakResidentBytes; });
+  appendStageBytes(json, "peakLiveBytes", metrics,
+                   [](const Utils::RunMetrics::Span& span) { return span.peakLiveBytes; });
+
+  if (entry.generation) {
+    appendNumber(json, "threads", entry.threads);
+    json += ",\"cache\":{";
+    appendBool(json, "analytic", entry.analyticMedialAxis, true);
+    appendBool(json, "memory", entry.memoryCache);
+    appendBool(json, "disk", entry.diskCache);
+    appendBool(json, "shareRepeatedShapes", entry.shareRepeatedShapes);
+    appendNumber(json, "memoryHits", static_cast<long long>(entry.memoryCacheHits));
+    appendNumber(json, "diskHits", static_cast<long long>(entry.diskCacheHits));
+    json.push_back('}');
+  }
+  json.push_back('}');
+  return json;
+}
+
+bool appendRunHistory(const std::string& filePath, const RunHistoryEntry& entry, const Utils::RunMetrics& metrics) {
+  std::ofstream out(filePath, std::ios::out | std::ios::app);
+  if (!out.is_open()) {
+    return false;
+  }
+  out << runHistoryJson(entry, metrics) << '\n';
+  return static_cast<bool>(out);
+}
+
+std::string importedDesignHash(const Geometry::ShapeStore& shapes) {
+  // FNV-1a over the shape tags of updating re-imports, which already hash each outline
+  uint64_t hash = 14695981039346656037ULL;
+  for (const auto& tag : importedShapeTags(shapes, 0, shapes.size())) {
+    for (char c : tag) {
+      hash ^= static_cast<unsigned char>(c);
+      hash *= 1099511628211ULL;
+    }
+    hash ^= '\n';
+    hash *= 1099511628211ULL;
+  }
+
+  char text[17];
+  std::snprintf(text, sizeof(text), "%016llx", static_cast<unsigned long long>(hash));
+  return text;
+}
+
+}  // namespace Core
+}  // namespace ChipCarving
@@ -0,0 +1,62 @@
+/**
+ * RunHistory.h
+ *
+ * Append-only run history: one JSON line per Import Design or Generate Paths
+ * run with the plugin and OpenVoronoi versions, a hash of the imported design,
+ * profile/vertex/point counts, stage timings and memory peaks, thread count
+ * and cache settings. Lines from many seats and versions can be concatenated
+ * and aggregated without parsing the free-form log.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <string>
+#include <vector>
+
+#include "geometry/ShapeStore.h"
+#include "utils/TraceSpan.h"
+
+namespace ChipCarving {
+namespace Core {
+
+struct RunHistoryEntry {
+  std::string pluginVersion{};
+  std::string engineVersion{};  // OpenVoronoi
+  std::string designHash{};     // importedDesignHash() of the imported shapes ("" before any import)
+  size_t profiles = 0;          // Imported shapes, or profiles of a Generate Paths run
+  long long vertices = 0;
+  long long points = 0;  // Medial axis points (0 for imports)
+
+  // Generate Paths only
+  bool generation = false;
+  int threads = 0;  // Medial axis worker threads
+  bool analyticMedialAxis = false;
+  bool memoryCache = false;
+  bool diskCache = false;
+  bool shareRepeatedShapes = false;
+  size_t memoryCacheHits = 0;
+  size_t diskCacheHits = 0;
+};
+
+/**
+ * One-line JSON object:
+ * {"unixTime":...,"command":"generatePaths","pluginVersion":"...","engineVersion":"...","designHash":"...",
+ *  "profiles":N,"vertices":V,"points":P,"stages":{"generatePaths":T,"generatePaths/write":T,...},...}
+ * with "threads" and a "cache" object for Generate Paths runs; the command is the run's first root span and
+ * the stages are its root spans and their children, in milliseconds. "peakResidentBytes" and "peakLiveBytes"
+ * objects give the same stages' memory peaks when they were measured (see utils/MemoryUsage.h)
+ */
+std::string runHistoryJson(const RunHistoryEntry& entry, const Utils::RunMetrics& metrics);
+
+/**
+ * Append runHistoryJson() as one line of filePath
+ * @return false if the file could not be written
+ */
+bool appendRunHistory(const std::string& filePath, const RunHistoryEntry& entry, const Utils::RunMetrics& metrics);
+
+// Hash of every imported shape's outline (16 hex digits), the same for the same design whichever file it came from
+std::string importedDesignHash(const Geometry::ShapeStore& shapes);
+
+}  // namespace Core
+}  // namespace ChipCarving
@@ -0,0 +1,222 @@
+/**
+ * RunReport.cpp
+ *
+ * Per-run performance report of Generate Paths
+ */
+
+#include "RunReport.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <cstdio>
+
+#include "utils/TraceJson.h"
+
+namespace ChipCarving {
+namespace Core {
+
+namespace {
+
+std::string formatMs(double ms) {
+  char buffer[32];
+  std::snprintf(buffer, sizeof(buffer), "%.1f ms", ms);
+  return buffer;
+}
+
+std::string formatPercent(size_t part, size_t whole) {
+  char buffer[16];
+  std::snprintf(buffer, sizeof(buffer), "%.0f%%", 100.0 * static_cast<double>(part) / static_cast<double>(whole));
+  return buffer;
+}
+
+/**
+ * " 812.3 MB <what> (vcarve 790.1 MB, write 812.3 MB)": the run's peak and each
+ * stage's, stages merged by name; empty if nothing was measured
+ */
+template <typename Bytes>
+std::string formatPeaks(const Utils::RunMetrics& metrics, const char* what, Bytes bytesOf) {
+  const auto& spans = metrics.spans();
+  uint64_t runPeak = 0;
+  std::vector<std::pair<std::string, uint64_t>> stages;
+  for (const auto& span : spans) {
+    uint64_t bytes = bytesOf(span);
+    if (span.parent == Utils::RunMetrics::NO_PARENT) {
+      runPeak = std::max(runPeak, bytes);
+      continue;
+    }
+    if (spans[span.parent].parent != Utils::RunMetrics::NO_PARENT || bytes == 0) {
+      continue;
+    }
+    auto stage = std::find_if(stages.begin(), stages.end(),
+                              [&span](const std::pair<std::string, uint64_t>& s) { return s.first == span.name; });
+    if (stage == stages.end()) {
+      stages.emplace_back(span.name, bytes);
+    } else {
+      stage->second = std::max(stage->second, bytes);
+    }
+  }
+  if (runPeak == 0) {
+    return std::string();
+  }
+
+  std::string text = " " + Utils::formatMegabytes(runPeak) + " " + what;
+  for (size_t i = 0; i < stages.size(); ++i) {
+    text += (i == 0 ? " (" : ", ") + stages[i].first + " " + Utils::formatMegabytes(stages[i].second);
+  }
+  return stages.empty() ? text : text + ")";
+}
+
+}  // namespace
+
+constexpr size_t RunReport::SLOWEST_PROFILE_COUNT;
+constexpr size_t RunReport::LISTED_REDUCED_PRECISION_COUNT;
+
+void RunReport::addProfile(const std::string& entityToken, const Geometry::MedialAxisResults& results) {
+  ProfileTiming timing;
+  timing.entityToken = entityToken;
+  timing.medialAxisMs = results.computeMs;
+  timing.retries = results.attempts.empty() ? 0 : results.attempts.size() - 1;
+  timing.success = results.success;
+
+  ++profiles;
+  failedProfiles += results.success ? 0 : 1;
+  points += results.success ? results.totalPoints : 0;
+  medialAxisRetries += timing.retries;
+  keepIfSlow(timing);
+}
+
+void RunReport::merge(const RunReport& other) {
+  profiles += other.profiles;
+  failedProfiles += other.failedProfiles;
+  points += other.points;
+  vertices += other.vertices;
+  analyticMedialAxes += other.analyticMedialAxes;
+  memoryCacheHits += other.memoryCacheHits;
+  diskCacheHits += other.diskCacheHits;
+  medialAxisRetries += other.medialAxisRetries;
+  for (const auto& timing : other.slowestProfiles) {
+    keepIfSlow(timing);
+  }
+  reducedPrecisionProfiles.insert(reducedPrecisionProfiles.end(), other.reducedPrecisionProfiles.begin(),
+                                  other.reducedPrecisionProfiles.end());
+}
+
+void RunReport::keepIfSlow(const ProfileTiming& timing) {
+  auto slower = [](const ProfileTiming& a, const ProfileTiming& b) { return a.medialAxisMs > b.medialAxisMs; };
+  if (timing.medialAxisMs <= 0.0) {
+    return;
+  }
+  if (slowestProfiles.size() == SLOWEST_PROFILE_COUNT) {
+    if (!slower(timing, slowestProfiles.back())) {
+      return;
+    }
+    slowestProfiles.pop_back();
+  }
+  slowestProfiles.insert(std::upper_bound(slowestProfiles.begin(), slowestProfiles.end(), timing, slower), timing);
+}
+
+std::string RunReport::format(const Utils::RunMetrics& metrics) const {
+  // Run time is the root spans' total; stages are their children, merged by name
+  const auto& spans = metrics.spans();
+  double runMs = 0.0;
+  std::vector<std::pair<std::string, double>> stages;
+  for (const auto& span : spans) {
+    if (span.parent == Utils::RunMetrics::NO_PARENT) {
+      runMs += span.totalMs;
+      continue;
+    }
+    if (spans[span.parent].parent != Utils::RunMetrics::NO_PARENT) {
+      continue;
+    }
+    auto stage = std::find_if(stages.begin(), stages.end(),
+                              [&span](const std::pair<std::string, double>& s) { return s.first == span.name; });
+    if (stage == stages.end()) {
+      stages.emplace_back(span.name, span.totalMs);
+    } else {
+      stage->second += span.totalMs;
+    }
+  }
+
+  std::string text = "Run report: " + std::to_string(profiles) + " profiles";
+  if (failedProfiles > 0) {
+    text += " (" + std::to_string(failedProfiles) + " failed)";
+  }
+  text += " in " + formatMs(runMs);
+  if (runMs > 0.0) {
+    char rate[32];
+    std::snprintf(rate, sizeof(rate), ", %.1f profiles/s", static_cast<double>(profiles) * 1000.0 / runMs);
+    text += rate;
+  }
+  text += ", " + std::to_string(points) + " medial axis points\n";
+
+  if (!stages.empty()) {
+    text += "  Stages:";
+    for (size_t i = 0; i < stages.size(); ++i) {
+      text += (i == 0 ? " " : ", ") + stages[i].first + " " + formatMs(stages[i].second);
+    }
+    text.push_back('\n');
+  }
+
+  std::string apiCalls;
+  for (size_t kind = 0; kind < Utils::API_CALL_KIND_COUNT; ++kind) {
+    auto apiKind = static_cast<Utils::ApiCallKind>(kind);
+    Utils::ApiCallTotals totals = metrics.apiCallTotals(apiKind);
+    if (totals.count > 0) {
+      apiCalls += (apiCalls.empty() ? " " : ", ") + std::to_string(totals.count) + " " +
+                  Utils::apiCallKindName(apiKind) + " " + formatMs(totals.totalMs);
+    }
+  }
+  if (!apiCalls.empty()) {
+    text += "  Fusion API:" + apiCalls + "\n";
+  }
+
+  std::string resident = formatPeaks(metrics, "resident",
+                                     [](const Utils::RunMetrics::Span& span) { return span.peakResidentBytes; });
+  std::string live =
+      formatPeaks(metrics, "live heap", [](const Utils::RunMetrics::Span& span) { return span.peakLiveBytes; });
+  if (!resident.empty() || !live.empty()) {
+    text += "  Peak memory:" + resident + (resident.empty() || live.empty() ? "" : ";") + live + "\n";
+  }
+
+  // Analytic medial axes never consult the caches
+  size_t cacheHits = memoryCacheHits + diskCacheHits;
+  size_t cacheLookups = profiles > analyticMedialAxes ? profiles - analyticMedialAxes : 0;
+  text += "  Medial axes: " + std::to_string(analyticMedialAxes) + " analytic, " + std::to_string(cacheHits) +
+          " cached (" + std::to_string(memoryCacheHits) + " memory, " + std::to_string(diskCacheHits) + " disk)";
+  if (cacheLookups > 0) {
+    text += ", cache hit rate " + formatPercent(std::min(cacheHits, cacheLookups), cacheLookups);
+  }
+  text += ", " + std::to_string(medialAxisRetries) + " retries\n";
+
+  if (!slowestProfiles.empty()) {
+    text += "  Slowest profiles:\n";
+    for (const auto& timing : slowestProfiles) {
+      text += "    " + formatMs(timing.medialAxisMs) + "  " +
+              (timing.entityToken.empty() ? std::string("(no entity token)") : timing.entityToken);
+      if (timing.retries > 0) {
+        text += ", " + std::to_string(timing.retries) + (timing.retries == 1 ? " retry" : " retries");
+      }
+      if (!timing.success) {
+        text += ", failed";
+      }
+      text.push_back('\n');
+    }
+  }
+
+  if (!reducedPrecisionProfiles.empty()) {
+    text += "  Reduced precision (time budget ran out): " + std::to_string(reducedPrecisionProfiles.size()) +
+            (reducedPrecisionProfiles.size() == 1 ? " profile\n" : " profiles\n");
+    size_t listed = std::min(reducedPrecisionProfiles.size(), LISTED_REDUCED_PRECISION_COUNT);
+    for (size_t i = 0; i < listed; ++i) {
+      const std::string& token = reducedPrecisionProfiles[i];
+      text += "    " + (token.empty() ? std::string("(no entity token)") : token) + "\n";
+    }
+    if (listed < reducedPrecisionProfiles.size()) {
+      text += "    and " + std::to_string(reducedPrecisionProfiles.size() - listed) + " more\n";
+    }
+  }
+  return text;
+}
+
+}  // namespace Core
+}  // namespace ChipCarving
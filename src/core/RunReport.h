@@ -0,0 +1,71 @@
+/**
+ * RunReport.h
+ *
+ * Compact performance report of one Generate Paths run, shown to the user
+ * after generation: stage times, profile throughput, medial axis points, Fusion
+ * API calls, peak memory per stage, cache hit rates, retries, the slowest
+ * profiles with their entity tokens and the profiles a time budget left at
+ * reduced precision. Generation jobs fill a report as they
+ * write their profiles; stage times, memory peaks and API calls come from the
+ * run's RunMetrics when it is formatted.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <string>
+#include <vector>
+
+#include "geometry/MedialAxisProcessor.h"
+#include "utils/TraceSpan.h"
+
+namespace ChipCarving {
+namespace Core {
+
+struct RunReport {
+  static constexpr size_t SLOWEST_PROFILE_COUNT = 5;
+  static constexpr size_t LISTED_REDUCED_PRECISION_COUNT = 10;  // Reduced-precision profiles named in format()
+
+  struct ProfileTiming {
+    std::string entityToken{};  // Source profile entity token ("" if unknown)
+    double medialAxisMs = 0.0;  // Time computing its medial axis (0 when resolved without computing)
+    size_t retries = 0;
+    bool success = false;
+  };
+
+  size_t profiles = 0;
+  size_t failedProfiles = 0;
+  long long points = 0;    // Medial axis points of successful profiles
+  long long vertices = 0;  // Polygon vertices of the profiles, holes included
+
+  // Where the medial axes came from; profiles not counted here were computed
+  size_t analyticMedialAxes = 0;
+  size_t memoryCacheHits = 0;
+  size_t diskCacheHits = 0;
+  size_t medialAxisRetries = 0;  // OpenVoronoi attempts after a failed one
+
+  std::vector<ProfileTiming> slowestProfiles{};  // Slowest first, at most SLOWEST_PROFILE_COUNT
+  std::vector<std::string> reducedPrecisionProfiles{};  // Entity tokens of profiles a time budget left coarse
+
+  bool empty() const {
+    return profiles == 0;
+  }
+
+  // Count one written profile and its medial axis
+  void addProfile(const std::string& entityToken, const Geometry::MedialAxisResults& results);
+
+  // Add another report of the same run (batch and multi-tool runs write several jobs)
+  void merge(const RunReport& other);
+
+  /**
+   * Text for the user, a line per item
+   * @param metrics The run's stage timings, memory peaks and Fusion API calls
+   */
+  std::string format(const Utils::RunMetrics& metrics) const;
+
+ private:
+  void keepIfSlow(const ProfileTiming& timing);
+};
+
+}  // namespace Core
+}  // namespace ChipCarving
@@ -0,0 +1,161 @@
+/**
+ * SpatialTiling.cpp
+ *
+ * Grid tiles of a Generate Paths selection and the journal of finished tiles
+ */
+
+#include "SpatialTiling.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <fstream>
+#include <limits>
+#include <map>
+#include <set>
+#include <tuple>
+
+namespace ChipCarving {
+namespace Core {
+
+namespace {
+
+struct Bounds {
+  double minX = std::numeric_limits<double>::max();
+  double minY = std::numeric_limits<double>::max();
+  double maxX = std::numeric_limits<double>::lowest();
+  double maxY = std::numeric_limits<double>::lowest();
+
+  void add(double x, double y) {
+    minX = std::min(minX, x);
+    minY = std::min(minY, y);
+    maxX = std::max(maxX, x);
+    maxY = std::max(maxY, y);
+  }
+  bool empty() const {
+    return minX > maxX;
+  }
+};
+
+// Centre of the profile's outer loop; arcs and splines count by their end and control points
+std::pair<double, double> profileCentre(const Adapters::ProfileGeometry& profile) {
+  Bounds bounds;
+  for (const auto& vertex : profile.vertices) {
+    bounds.add(vertex.x, vertex.y);
+  }
+  for (const auto& curve : profile.curves) {
+    bounds.add(curve.start.x, curve.start.y);
+    bounds.add(curve.end.x, curve.end.y);
+    for (const auto& point : curve.controlPoints) {
+      bounds.add(point.x, point.y);
+    }
+  }
+  if (bounds.empty()) {
+    return profile.centroid;
+  }
+  return {(bounds.minX + bounds.maxX) / 2.0, (bounds.minY + bounds.maxY) / 2.0};
+}
+
+void hashText(uint64_t& hash, const std::string& text) {
+  for (char c : text) {
+    hash ^= static_cast<unsigned char>(c);
+    hash *= 1099511628211ULL;
+  }
+  hash ^= '\n';
+  hash *= 1099511628211ULL;
+}
+
+}  // namespace
+
+std::vector<SelectionTile> splitSelectionIntoTiles(const Adapters::SketchSelection& selection, double tileSize) {
+  if (selection.selectedProfiles.empty() || !(tileSize > 0.0)) {
+    SelectionTile whole;
+    whole.label = "Tile 0,0";
+    whole.selection = selection;
+    return {whole};
+  }
+
+  // (plane, component, row, column) -> tile; the map orders tiles by row, then column, per output target
+  using TileKey = std::tuple<std::string, std::string, int, int>;
+  std::map<TileKey, size_t> tileByKey;
+  std::vector<SelectionTile> tiles;
+  for (size_t i = 0; i < selection.selectedProfiles.size(); ++i) {
+    const Adapters::ProfileGeometry& profile = selection.selectedProfiles[i];
+    std::pair<double, double> centre = profileCentre(profile);
+    int column = static_cast<int>(std::floor(centre.first / tileSize));
+    int row = static_cast<int>(std::floor(centre.second / tileSize));
+
+    TileKey key(profile.planeEntityId, profile.componentEntityId, row, column);
+    auto found = tileByKey.emplace(key, tiles.size());
+    if (found.second) {
+      tiles.emplace_back();
+      tiles.back().column = column;
+      tiles.back().row = row;
+      tiles.back().selection.isValid = selection.isValid;
+      tiles.back().selection.errorMessage = selection.errorMessage;
+    }
+    Adapters::SketchSelection& tile = tiles[found.first->second].selection;
+    tile.selectedProfiles.push_back(profile);
+    if (i < selection.selectedEntityIds.size()) {
+      tile.selectedEntityIds.push_back(selection.selectedEntityIds[i]);
+    }
+    tile.closedPathCount++;
+  }
+
+  std::vector<SelectionTile> ordered;
+  std::set<std::string> labels;
+  for (const auto& entry : tileByKey) {
+    SelectionTile& tile = tiles[entry.second];
+    tile.label = "Tile " + std::to_string(tile.column) + "," + std::to_string(tile.row);
+    if (!labels.insert(tile.label).second) {
+      tile.label += " (" + std::to_string(ordered.size() + 1) + ")";
+      labels.insert(tile.label);
+    }
+    ordered.push_back(std::move(tile));
+  }
+  return ordered;
+}
+
+std::string tileJournalKey(const SelectionTile& tile, const Adapters::MedialAxisParameters& params) {
+  uint64_t hash = 14695981039346656037ULL;
+  hashText(hash, params.toolName);
+  hashText(hash, std::to_string(params.spatialTileSize));
+  for (const auto& token : tile.selection.selectedEntityIds) {
+    hashText(hash, token);
+  }
+
+  char text[17];
+  std::snprintf(text, sizeof(text), "%016llx", static_cast<unsigned long long>(hash));
+  return tile.label + " " + text;
+}
+
+std::unordered_set<std::string> loadTileJournal(const std::string& filePath) {
+  std::unordered_set<std::string> keys;
+  std::ifstream file(filePath);
+  std::string line;
+  while (std::getline(file, line)) {
+    if (!line.empty()) {
+      keys.insert(line);
+    }
+  }
+  return keys;
+}
+
+bool clearTileJournal(const std::string& filePath) {
+  std::ofstream out(filePath, std::ios::out | std::ios::trunc);
+  return out.is_open();
+}
+
+bool appendTileJournal(const std::string& filePath, const std::string& key) {
+  std::ofstream out(filePath, std::ios::out | std::ios::app);
+  if (!out.is_open()) {
+    return false;
+  }
+  out << key << '\n';
+  out.flush();
+  return static_cast<bool>(out);
+}
+
+}  // namespace Core
+}  // namespace ChipCarving
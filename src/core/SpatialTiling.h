@@ -0,0 +1,53 @@
+/**
+ * SpatialTiling.h
+ *
+ * Tiled Generate Paths for whole-panel jobs: a selection is split by a square
+ * grid into tiles that are generated end to end one after another, each into
+ * its own sketches with its own surface heightfield window, so memory and the
+ * surface caches stay bounded by a tile. Finished tiles are recorded in a
+ * journal; a rerun after a crash skips them.
+ */
+
+#pragma once
+
+#include <string>
+#include <unordered_set>
+#include <vector>
+
+#include "adapters/IFusionInterface.h"
+
+namespace ChipCarving {
+namespace Core {
+
+struct SelectionTile {
+  int column = 0;  // Grid cell, counted from the origin
+  int row = 0;
+  std::string label{};  // "Tile 3,1", unique within the run
+  Adapters::SketchSelection selection{};
+};
+
+/**
+ * Split a selection by a square grid of tileSize (cm). Each profile goes to
+ * the cell of its bounding box centre; profiles on different sketch planes or
+ * components never share a tile. Tiles come in row, then column order. A
+ * selection without cached profile geometry is one tile.
+ */
+std::vector<SelectionTile> splitSelectionIntoTiles(const Adapters::SketchSelection& selection, double tileSize);
+
+// Journal key of a tile: its label with a hash of its profiles' entity tokens and the run's tool and tile size
+std::string tileJournalKey(const SelectionTile& tile, const Adapters::MedialAxisParameters& params);
+
+// Keys recorded in a tile journal (none if it does not exist)
+std::unordered_set<std::string> loadTileJournal(const std::string& filePath);
+
+// Empty the journal for a run that starts over; false if it could not be written
+bool clearTileJournal(const std::string& filePath);
+
+/**
+ * Record a finished tile, one key per line, flushed before returning
+ * @return false if the journal could not be written
+ */
+bool appendTileJournal(const std::string& filePath, const std::string& key);
+
+}  // namespace Core
+}  // namespace ChipCarving
@@ -0,0 +1,126 @@
+/**
+ * SpeculativeMedialAxis.cpp
+ *
+ * Debounced, cancellable medial axis computation for the dialog's selection
+ */
+
+#include "SpeculativeMedialAxis.h"
+
+#include <algorithm>
+#include <utility>
+
+#include "GenerationJob.h"
+#include "geometry/MedialAxisBatch.h"
+#include "geometry/MedialAxisCache.h"
+#include "utils/logging.h"
+
+namespace ChipCarving {
+namespace Core {
+
+constexpr int SpeculativeMedialAxis::DEFAULT_DEBOUNCE_MS;
+
+SpeculativeMedialAxis::SpeculativeMedialAxis(Adapters::IUserInterface* ui) : ui_(ui) {}
+
+SpeculativeMedialAxis::~SpeculativeMedialAxis() {
+  retireJob();
+  for (auto& stale : staleJobs_) {
+    stale->worker.join();
+  }
+}
+
+void SpeculativeMedialAxis::retireJob() {
+  if (job_) {
+    job_->progress.cancel();
+    staleJobs_.push_back(std::move(job_));
+  }
+}
+
+bool SpeculativeMedialAxis::start(const Adapters::SketchSelection& selection,
+                                  const Adapters::MedialAxisParameters& params,
+                                  const Geometry::MedialAxisProcessor& prototype) {
+  retireJob();
+
+  auto job = std::make_unique<Job>(prototype);
+  configureGenerationProcessor(job->processor, params);
+  job->processor.setVerbose(false);
+  for (const auto& profile : selection.selectedProfiles) {
+    if (!profile.holes.empty() || !profile.holeCurves.empty()) {
+      continue;
+    }
+    std::vector<Geometry::Point2D> polygon = cachedProfileOutline(profile, job->processor.getPolygonTolerance());
+    if (polygon.size() >= 3) {
+      job->polygons.push_back(std::move(polygon));
+    }
+  }
+  if (job->polygons.empty()) {
+    return false;
+  }
+  job->workers = Geometry::resolveMedialAxisWorkerCount(params.medialAxisWorkers, job->polygons.size());
+
+  Adapters::IUserInterface* ui = ui_;
+  job->progress.setListener([ui]() { ui->notifyMainThread(); });
+
+  Job* running = job.get();
+  int debounceMs = debounceMs_;
+  job_ = std::move(job);
+  running->worker = std::thread([running, debounceMs]() {
+    SetThreadConsoleLoggingSuppressed(true);
+    if (running->progress.waitUnlessCancelled(debounceMs)) {
+      running->progress.beginStage("Speculating medial axes", running->polygons.size());
+      // Cancellation stops the batch between profiles; unfinished ones come back unsuccessful
+      try {
+        running->results = Geometry::computeMedialAxisBatch(running->polygons, running->processor, running->workers,
+                                                            &running->progress);
+      } catch (...) {
+        running->results.clear();  // Generate Paths computes them itself and reports the error
+      }
+    }
+    running->progress.finish();
+  });
+  return true;
+}
+
+std::vector<SpeculativeMedialAxis::Result> SpeculativeMedialAxis::take(const Geometry::MedialAxisProcessor& processor) {
+  std::vector<Result> taken;
+  if (!job_) {
+    return taken;
+  }
+  // The key of an empty polygon covers only the parameters
+  if (Geometry::MedialAxisCache::computeKey({}, job_->processor) !=
+      Geometry::MedialAxisCache::computeKey({}, processor)) {
+    LOG_INFO("Speculative medial axes used other parameters, discarding them");
+    retireJob();
+    return taken;
+  }
+
+  std::unique_ptr<Job> job = std::move(job_);
+  job->worker.join();
+  for (size_t i = 0; i < job->results.size(); ++i) {
+    if (job->results[i].success) {
+      taken.push_back(Result{Geometry::MedialAxisCache::computeKey(job->polygons[i], job->processor),
+                             std::move(job->results[i])});
+    }
+  }
+  LOG_INFO("Took " << taken.size() << " of " << job->polygons.size() << " speculative medial axes");
+  return taken;
+}
+
+void SpeculativeMedialAxis::pump() {
+  // Superseded workers stop at their next cancellation check
+  staleJobs_.erase(std::remove_if(staleJobs_.begin(), staleJobs_.end(),
+                                  [](const std::unique_ptr<Job>& stale) {
+                                    if (!stale->progress.isFinished()) {
+                                      return false;
+                                    }
+                                    stale->worker.join();
+                                    return true;
+                                  }),
+                   staleJobs_.end());
+}
+
+void SpeculativeMedialAxis::clear() {
+  retireJob();
+}
+
+}  // namespace Core
+}  // namespace ChipCarving
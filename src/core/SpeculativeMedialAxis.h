@@ -0,0 +1,98 @@
+/**
+ * SpeculativeMedialAxis.h
+ *
+ * Medial axes of the Generate Paths dialog's cached profiles, computed on a
+ * worker thread while the dialog is still open. Each selection or tolerance
+ * change restarts the computation with the dialog's parameters, and Generate
+ * Paths takes the finished results into its medial axis cache before it
+ * extracts profiles. OK on an unchanged selection then finds every medial axis
+ * there instead of running OpenVoronoi.
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <thread>
+#include <vector>
+
+#include "adapters/IFusionInterface.h"
+#include "geometry/MedialAxisProcessor.h"
+#include "utils/JobProgress.h"
+
+namespace ChipCarving {
+namespace Core {
+
+class SpeculativeMedialAxis {
+ public:
+  static constexpr int DEFAULT_DEBOUNCE_MS = 250;  // Quiet time after the last input change before computing
+
+  // One finished medial axis and its cache key
+  struct Result {
+    uint64_t key = 0;
+    Geometry::MedialAxisResults results{};
+  };
+
+  // @param ui Notified from the worker so the main thread calls pump()
+  explicit SpeculativeMedialAxis(Adapters::IUserInterface* ui);
+  ~SpeculativeMedialAxis();
+
+  SpeculativeMedialAxis(const SpeculativeMedialAxis&) = delete;
+  SpeculativeMedialAxis& operator=(const SpeculativeMedialAxis&) = delete;
+
+  /**
+   * Replace the running speculation with one over selection's cached
+   * profiles. Profiles with holes are skipped, since only outer loops are
+   * cached. The previous job is cancelled; the new one waits out the debounce
+   * delay first.
+   * @param prototype Generate Paths' processor, copied and configured for params
+   * @return false if no profile can be speculated on
+   */
+  bool start(const Adapters::SketchSelection& selection, const Adapters::MedialAxisParameters& params,
+             const Geometry::MedialAxisProcessor& prototype);
+
+  /**
+   * Take the current speculation's successful results (main thread). A job
+   * computed with the same cache parameters as processor is waited for, since
+   * its work is the run's own; any other job is cancelled and yields nothing.
+   * @param processor The processor the run computes with
+   */
+  std::vector<Result> take(const Geometry::MedialAxisProcessor& processor);
+
+  // Main-thread tick: joins cancelled workers once they stop
+  void pump();
+
+  // Cancel the current speculation
+  void clear();
+
+  bool isRunning() const {
+    return job_ != nullptr;
+  }
+  void setDebounceMs(int debounceMs) {
+    debounceMs_ = debounceMs;
+  }
+
+ private:
+  struct Job {
+    explicit Job(const Geometry::MedialAxisProcessor& prototype) : processor(prototype) {}
+
+    Geometry::MedialAxisProcessor processor;
+    int workers = 0;
+    std::vector<std::vector<Geometry::Point2D>> polygons{};
+    std::vector<Geometry::MedialAxisResults> results{};
+    Utils::JobProgress progress{};
+    std::thread worker{};
+  };
+
+  // Cancel the current job; pump() joins its worker once it has stopped
+  void retireJob();
+
+  Adapters::IUserInterface* ui_;
+  int debounceMs_ = DEFAULT_DEBOUNCE_MS;
+
+  std::unique_ptr<Job> job_{};
+  std::vector<std::unique_ptr<Job>> staleJobs_{};
+};
+
+}  // namespace Core
+}  // namespace ChipCarving
@@ -0,0 +1,155 @@
+/**
+ * AnalyticMedialAxis.cpp
+ *
+ * Closed-form medial axis for imported shapes (Leaf) and shape dispatch
+ *
+ * Note: the TriArc solver is in AnalyticMedialAxisTriArc.cpp
+ */
+
+#include "geometry/AnalyticMedialAxis.h"
+
+#include <algorithm>
+#include <cmath>
+#include <utility>
+
+#include "geometry/PointKernels.h"
+
+namespace ChipCarving {
+namespace Geometry {
+
+namespace {
+
+// Match the bounding-box transform MedialAxisProcessor records, so analytic and
+// OpenVoronoi results are interchangeable downstream
+void fillTransformFromPolygon(const std::vector<Point2D>& polygon, TransformParams& transform) {
+  if (polygon.empty()) {
+    return;
+  }
+
+  PointBounds bounds = pointBounds(polygon.data(), polygon.size());
+  transform.originalMin = bounds.min;
+  transform.originalMax = bounds.max;
+
+  double maxDimension =
+      std::max(transform.originalMax.x - transform.originalMin.x, transform.originalMax.y - transform.originalMin.y);
+  transform.scale = (maxDimension > 0) ? 0.85 / maxDimension : 1.0;
+  transform.offset = midpoint(transform.originalMin, transform.originalMax);
+}
+
+}  // namespace
+
+bool polygonMatchesLeaf(const std::vector<Point2D>& polygon, const Leaf& leaf, double tolerance) {
+  if (polygon.size() < 3 || !leaf.isValidGeometry()) {
+    return false;
+  }
+
+  const auto centers = leaf.getArcCenters();
+  const Point2D focus1 = leaf.getFocus1();
+  const Point2D focus2 = leaf.getFocus2();
+  const double radius = leaf.getRadius();
+
+  // Side of the chord each vertex lies on; a real leaf has vertices on both arcs
+  const double chordX = focus2.x - focus1.x;
+  const double chordY = focus2.y - focus1.y;
+
+  bool hasFocus1 = false;
+  bool hasFocus2 = false;
+  bool hasPositiveSide = false;
+  bool hasNegativeSide = false;
+
+  for (const auto& vertex : polygon) {
+    // The leaf is the intersection of both arc disks, so its boundary is where
+    // the farther of the two arc centers is exactly one radius away
+    double boundaryDistance = std::max(distance(vertex, centers.first), distance(vertex, centers.second));
+    if (std::abs(boundaryDistance - radius) > tolerance) {
+      return false;
+    }
+
+    hasFocus1 = hasFocus1 || distance(vertex, focus1) <= tolerance;
+    hasFocus2 = hasFocus2 || distance(vertex, focus2) <= tolerance;
+
+    double side = chordX * (vertex.y - focus1.y) - chordY * (vertex.x - focus1.x);
+    hasPositiveSide = hasPositiveSide || side > tolerance;
+    hasNegativeSide = hasNegativeSide || side < -tolerance;
+  }
+
+  return hasFocus1 && hasFocus2 && hasPositiveSide && hasNegativeSide;
+}
+
+MedialAxisResults computeLeafMedialAxis(const Leaf& leaf, int segments) {
+  MedialAxisResults results;
+
+  if (!leaf.isValidGeometry()) {
+    results.errorMessage = "Leaf geometry is invalid for analytic medial axis";
+    return results;
+  }
+
+  const Point2D focus1 = leaf.getFocus1();
+  const Point2D focus2 = leaf.getFocus2();
+  const Point2D mid = midpoint(focus1, focus2);
+  const double radius = leaf.getRadius();
+  const double centerDistance = distance(mid, leaf.getArcCenters().first);
+  const double halfChord = distance(focus1, focus2) / 2.0;
+  const int count = std::max(2, segments);
+
+  std::vector<Point2D> chain;
+  std::vector<double> clearances;
+  chain.reserve(static_cast<size_t>(count) + 1);
+  clearances.reserve(static_cast<size_t>(count) + 1);
+
+  for (int i = 0; i <= count; ++i) {
+    double u = static_cast<double>(i) / count;
+    Point2D point(focus1.x + (focus2.x - focus1.x) * u, focus1.y + (focus2.y - focus1.y) * u);
+    double t = (u - 0.5) * 2.0 * halfChord;
+    double clearance = radius - std::sqrt(centerDistance * centerDistance + t * t);
+
+    chain.push_back(point);
+    clearances.push_back(std::max(0.0, clearance));
+  }
+
+  results.chains.addChain(chain, clearances);
+  results.graph = MedialAxisGraph::fromChains(results.chains);
+  results.numChains = 1;
+  results.totalPoints = count + 1;
+  results.totalLength = 2.0 * halfChord;
+  results.minClearance = 0.0;
+  results.maxClearance = leaf.getSagitta();
+  results.success = true;
+  return results;
+}
+
+bool computeAnalyticMedialAxis(const Shape& shape, double shapeScale, const std::vector<Point2D>& polygon,
+                               double tolerance, MedialAxisResults& results) {
+  if (const auto* leaf = dynamic_cast<const Leaf*>(&shape)) {
+    Leaf scaled(leaf->getFocus1() * shapeScale, leaf->getFocus2() * shapeScale, leaf->getRadius() * shapeScale);
+    if (!polygonMatchesLeaf(polygon, scaled, tolerance)) {
+      return false;
+    }
+
+    results = computeLeafMedialAxis(scaled);
+    fillTransformFromPolygon(polygon, results.transform);
+    return results.success;
+  }
+
+  if (const auto* triArc = dynamic_cast<const TriArc*>(&shape)) {
+    TriArc scaled(triArc->getVertex(0) * shapeScale, triArc->getVertex(1) * shapeScale,
+                  triArc->getVertex(2) * shapeScale, triArc->getBulgeFactors());
+    if (!polygonMatchesTriArc(polygon, scaled, tolerance)) {
+      return false;
+    }
+
+    MedialAxisResults triArcResults = computeTriArcMedialAxis(scaled);
+    if (!triArcResults.success) {
+      return false;
+    }
+
+    results = std::move(triArcResults);
+    fillTransformFromPolygon(polygon, results.transform);
+    return true;
+  }
+
+  return false;
+}
+
+}  // namespace Geometry
+}  // namespace ChipCarving
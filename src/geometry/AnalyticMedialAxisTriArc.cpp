@@ -0,0 +1,338 @@
+/**
+ * AnalyticMedialAxisTriArc.cpp
+ *
+ * Semi-analytic medial axis for TriArc shapes
+ * Split from AnalyticMedialAxis.cpp for maintainability
+ *
+ * A TriArc is a triangle whose edges are concave arcs (or straight lines). Each
+ * medial axis branch is the locus of points equidistant from two adjacent edges,
+ * i.e. the intersection of the two edges offset inward by the same clearance.
+ * Branches start at a vertex (clearance 0) and meet at the junction, where the
+ * offset of the opposite edge passes through the same point.
+ */
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <string>
+
+#include "geometry/AnalyticMedialAxis.h"
+
+namespace ChipCarving {
+namespace Geometry {
+
+namespace {
+
+// Steps used to bracket the junction clearance before bisection
+constexpr int JUNCTION_MARCH_STEPS = 256;
+constexpr int JUNCTION_BISECTION_ITERATIONS = 60;
+
+/**
+ * One TriArc boundary edge
+ */
+struct BoundaryEdge {
+  bool straight = true;
+  Point2D start{};
+  Point2D end{};
+  Point2D center{};        // Arc center (outside the shape for concave arcs)
+  double radius = 0.0;     // Arc radius
+  Point2D inwardNormal{};  // Unit chord normal pointing toward the centroid
+};
+
+double dot(const Point2D& a, const Point2D& b) {
+  return a.x * b.x + a.y * b.y;
+}
+
+std::array<BoundaryEdge, 3> buildEdges(const TriArc& triArc) {
+  std::array<BoundaryEdge, 3> edges;
+  const Point2D centroid = triArc.getCentroid();
+
+  for (int i = 0; i < 3; ++i) {
+    BoundaryEdge& edge = edges[i];
+    edge.start = triArc.getVertex(i);
+    edge.end = triArc.getVertex((i + 1) % 3);
+
+    double length = distance(edge.start, edge.end);
+    if (length > 0) {
+      edge.inwardNormal = Point2D(-(edge.end.y - edge.start.y) / length, (edge.end.x - edge.start.x) / length);
+      if (dot(edge.inwardNormal, centroid - edge.start) < 0) {
+        edge.inwardNormal = edge.inwardNormal * -1.0;
+      }
+    }
+
+    edge.straight = triArc.isEdgeStraight(i);
+    if (!edge.straight) {
+      ArcParams arc = triArc.getArcParameters(i);
+      edge.center = arc.center;
+      edge.radius = arc.radius;
+      edge.straight = !std::isfinite(arc.radius) || arc.radius <= 0;
+    }
+  }
+
+  return edges;
+}
+
+// Distance from a point to an edge, positive inside the shape
+double clearanceTo(const BoundaryEdge& edge, const Point2D& point) {
+  if (edge.straight) {
+    return dot(point - edge.start, edge.inwardNormal);
+  }
+  return distance(point, edge.center) - edge.radius;
+}
+
+void intersectCircles(const Point2D& c1, double r1, const Point2D& c2, double r2, std::vector<Point2D>& out) {
+  double d = distance(c1, c2);
+  if (d < 1e-12) {
+    return;
+  }
+
+  double x = (d * d + r1 * r1 - r2 * r2) / (2.0 * d);
+  double h2 = r1 * r1 - x * x;
+  if (h2 < 0) {
+    if (h2 < -1e-12 * r1 * r1) {
+      return;
+    }
+    h2 = 0;  // Tangent within rounding error
+  }
+
+  double h = std::sqrt(h2);
+  Point2D axis((c2.x - c1.x) / d, (c2.y - c1.y) / d);
+  Point2D base = c1 + axis * x;
+  out.emplace_back(base.x - axis.y * h, base.y + axis.x * h);
+  out.emplace_back(base.x + axis.y * h, base.y - axis.x * h);
+}
+
+void intersectLineCircle(const Point2D& origin, const Point2D& direction, const Point2D& center, double radius,
+                         std::vector<Point2D>& out) {
+  Point2D w = origin - center;
+  double b = dot(direction, w);
+  double c = dot(w, w) - radius * radius;
+  double disc = b * b - c;
+  if (disc < 0) {
+    return;
+  }
+
+  double root = std::sqrt(disc);
+  out.push_back(origin + direction * (-b - root));
+  out.push_back(origin + direction * (-b + root));
+}
+
+// Points at the same clearance from both edges (intersections of their inward offsets)
+std::vector<Point2D> offsetIntersections(const BoundaryEdge& a, const BoundaryEdge& b, double clearance) {
+  std::vector<Point2D> points;
+
+  if (!a.straight && !b.straight) {
+    intersectCircles(a.center, a.radius + clearance, b.center, b.radius + clearance, points);
+    return points;
+  }
+
+  if (a.straight && b.straight) {
+    Point2D pa = a.start + a.inwardNormal * clearance;
+    Point2D pb = b.start + b.inwardNormal * clearance;
+    Point2D da = a.end - a.start;
+    Point2D db = b.end - b.start;
+    double cross = da.x * db.y - da.y * db.x;
+    if (std::abs(cross) > 1e-12) {
+      double t = ((pb.x - pa.x) * db.y - (pb.y - pa.y) * db.x) / cross;
+      points.push_back(pa + da * t);
+    }
+    return points;
+  }
+
+  const BoundaryEdge& line = a.straight ? a : b;
+  const BoundaryEdge& arc = a.straight ? b : a;
+  double length = distance(line.start, line.end);
+  if (length > 0) {
+    Point2D direction = (line.end - line.start) * (1.0 / length);
+    intersectLineCircle(line.start + line.inwardNormal * clearance, direction, arc.center, arc.radius + clearance,
+                        points);
+  }
+  return points;
+}
+
+// Follow a branch continuously: pick the offset intersection nearest the previous point
+bool nextBranchPoint(const BoundaryEdge& a, const BoundaryEdge& b, double clearance, const Point2D& previous,
+                     Point2D& next) {
+  auto candidates = offsetIntersections(a, b, clearance);
+  if (candidates.empty()) {
+    return false;
+  }
+
+  next = *std::min_element(candidates.begin(), candidates.end(), [&previous](const Point2D& p, const Point2D& q) {
+    return distance(p, previous) < distance(q, previous);
+  });
+  return true;
+}
+
+// Locate the junction by walking the branch from vertex 0 until its clearance
+// to the opposite edge (edge 1) drops to the branch clearance
+bool findJunction(const std::array<BoundaryEdge, 3>& edges, double maxClearance, Point2D& junction,
+                  double& junctionClearance) {
+  const BoundaryEdge& before = edges[2];
+  const BoundaryEdge& after = edges[0];
+  const BoundaryEdge& opposite = edges[1];
+
+  double lo = 0.0;
+  Point2D loPoint = after.start;
+  for (int step = 1; step <= JUNCTION_MARCH_STEPS; ++step) {
+    double hi = maxClearance * step / JUNCTION_MARCH_STEPS;
+    Point2D hiPoint;
+    if (!nextBranchPoint(before, after, hi, loPoint, hiPoint)) {
+      return false;
+    }
+
+    if (clearanceTo(opposite, hiPoint) - hi > 0) {
+      lo = hi;
+      loPoint = hiPoint;
+      continue;
+    }
+
+    for (int i = 0; i < JUNCTION_BISECTION_ITERATIONS; ++i) {
+      double mid = 0.5 * (lo + hi);
+      Point2D midPoint;
+      if (!nextBranchPoint(before, after, mid, loPoint, midPoint)) {
+        return false;
+      }
+      if (clearanceTo(opposite, midPoint) - mid > 0) {
+        lo = mid;
+        loPoint = midPoint;
+      } else {
+        hi = mid;
+      }
+    }
+
+    junction = loPoint;
+    junctionClearance = lo;
+    return true;
+  }
+
+  return false;
+}
+
+double polylineLength(const std::vector<Point2D>& chain) {
+  double length = 0.0;
+  for (size_t i = 1; i < chain.size(); ++i) {
+    length += distance(chain[i - 1], chain[i]);
+  }
+  return length;
+}
+
+}  // namespace
+
+bool polygonMatchesTriArc(const std::vector<Point2D>& polygon, const TriArc& triArc, double tolerance) {
+  if (polygon.size() < 3) {
+    return false;
+  }
+
+  const auto edges = buildEdges(triArc);
+  std::array<bool, 3> hasCorner{{false, false, false}};
+  std::array<bool, 3> hasInterior{{false, false, false}};
+
+  for (const auto& vertex : polygon) {
+    bool onBoundary = false;
+    for (int i = 0; i < 3; ++i) {
+      const BoundaryEdge& edge = edges[i];
+      hasCorner[i] = hasCorner[i] || distance(vertex, edge.start) <= tolerance;
+
+      double length = distance(edge.start, edge.end);
+      if (length <= 0) {
+        continue;
+      }
+
+      // Must be on the edge curve, within the chord span, and on the shape side
+      // of the chord (rules out the far half of the arc circle)
+      double t = dot(vertex - edge.start, edge.end - edge.start) / (length * length);
+      double margin = tolerance / length;
+      if (std::abs(clearanceTo(edge, vertex)) > tolerance || t < -margin || t > 1.0 + margin ||
+          (!edge.straight && dot(vertex - edge.start, edge.inwardNormal) < -tolerance)) {
+        continue;
+      }
+
+      onBoundary = true;
+      if (distance(vertex, edge.start) > tolerance && distance(vertex, edge.end) > tolerance) {
+        hasInterior[i] = true;
+      }
+    }
+
+    if (!onBoundary) {
+      return false;
+    }
+  }
+
+  for (int i = 0; i < 3; ++i) {
+    // Straight edges tessellate to their endpoints only
+    if (!hasCorner[i] || (!edges[i].straight && !hasInterior[i])) {
+      return false;
+    }
+  }
+  return true;
+}
+
+MedialAxisResults computeTriArcMedialAxis(const TriArc& triArc, int segments) {
+  MedialAxisResults results;
+  const auto edges = buildEdges(triArc);
+
+  double maxChord = 0.0;
+  for (const auto& edge : edges) {
+    maxChord = std::max(maxChord, distance(edge.start, edge.end));
+  }
+
+  // The inscribed circle is always smaller than half the longest edge
+  Point2D junction;
+  double junctionClearance = 0.0;
+  if (maxChord <= 0 || !findJunction(edges, 0.5 * maxChord, junction, junctionClearance)) {
+    results.errorMessage = "TriArc junction could not be located for analytic medial axis";
+    return results;
+  }
+
+  // Trace each vertex branch; vertex k lies between edge k-1 and edge k
+  const int count = std::max(2, segments);
+  std::array<std::vector<Point2D>, 3> branches;
+  std::array<std::vector<double>, 3> branchClearances;
+  for (int k = 0; k < 3; ++k) {
+    const BoundaryEdge& before = edges[(k + 2) % 3];
+    const BoundaryEdge& after = edges[k];
+    Point2D previous = after.start;
+    branches[k].push_back(previous);
+    branchClearances[k].push_back(0.0);
+
+    for (int i = 1; i < count; ++i) {
+      double clearance = junctionClearance * i / count;
+      Point2D next;
+      if (!nextBranchPoint(before, after, clearance, previous, next)) {
+        results.errorMessage = "TriArc branch " + std::to_string(k) + " could not be traced";
+        return results;
+      }
+      branches[k].push_back(next);
+      branchClearances[k].push_back(clearance);
+      previous = next;
+    }
+
+    branches[k].push_back(junction);
+    branchClearances[k].push_back(junctionClearance);
+  }
+
+  // Chain 0 runs vertex 0 -> junction -> vertex 1; chain 1 runs junction -> vertex 2
+  std::vector<Point2D> through = branches[0];
+  std::vector<double> throughClearances = branchClearances[0];
+  through.insert(through.end(), branches[1].rbegin() + 1, branches[1].rend());
+  throughClearances.insert(throughClearances.end(), branchClearances[1].rbegin() + 1, branchClearances[1].rend());
+
+  std::vector<Point2D> spur(branches[2].rbegin(), branches[2].rend());
+  std::vector<double> spurClearances(branchClearances[2].rbegin(), branchClearances[2].rend());
+
+  results.totalLength = polylineLength(through) + polylineLength(spur);
+  results.totalPoints = static_cast<int>(through.size() + spur.size());
+  results.chains.reserve(2, through.size() + spur.size());
+  results.chains.addChain(through, throughClearances);
+  results.chains.addChain(spur, spurClearances);
+  results.graph = MedialAxisGraph::fromChains(results.chains);
+  results.numChains = 2;
+  results.minClearance = 0.0;
+  results.maxClearance = junctionClearance;
+  results.success = true;
+  return results;
+}
+
+}  // namespace Geometry
+}  // namespace ChipCarving
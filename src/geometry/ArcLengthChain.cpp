@@ -0,0 +1,60 @@
+/**
+ * ArcLengthChain.cpp
+ *
+ * Arc-length parameterization of medial axis chains
+ */
+
+#include "geometry/ArcLengthChain.h"
+
+#include <algorithm>
+
+#include "geometry/PointKernels.h"
+
+namespace ChipCarving {
+namespace Geometry {
+
+void ArcLengthChain::assign(const MedialAxisChains::ChainView& chain, double unitScale) {
+  chain_ = chain;
+  unitScale_ = unitScale;
+  lengths_.resize(chain.size());
+  cumulativeLengths(chain.xData(), chain.yData(), chain.size(), unitScale, lengths_.data());
+}
+
+ArcLengthChain::Location ArcLengthChain::locate(double s) const {
+  Location location;
+  if (lengths_.size() < 2) {
+    return location;
+  }
+
+  // First point past s ends the segment; s at or past the end stays on the last one
+  s = std::max(0.0, std::min(s, totalLength()));
+  auto next = std::upper_bound(lengths_.begin() + 1, lengths_.end() - 1, s);
+  location.segment = static_cast<size_t>(next - lengths_.begin()) - 1;
+  double segmentLength = lengths_[location.segment + 1] - lengths_[location.segment];
+  location.t = segmentLength > 0.0 ? std::min(1.0, (s - lengths_[location.segment]) / segmentLength) : 0.0;
+  return location;
+}
+
+Point2D ArcLengthChain::pointAt(double s) const {
+  if (lengths_.empty()) {
+    return Point2D(0, 0);
+  }
+  Location location = locate(s);
+  Point2D start = chain_[location.segment];
+  Point2D end = chain_[std::min(location.segment + 1, chain_.size() - 1)];
+  return Point2D((start.x + location.t * (end.x - start.x)) * unitScale_,
+                 (start.y + location.t * (end.y - start.y)) * unitScale_);
+}
+
+double ArcLengthChain::clearanceAt(double s) const {
+  if (lengths_.empty()) {
+    return 0.0;
+  }
+  Location location = locate(s);
+  double start = chain_.clearance(location.segment);
+  double end = chain_.clearance(std::min(location.segment + 1, chain_.size() - 1));
+  return (start + location.t * (end - start)) * unitScale_;
+}
+
+}  // namespace Geometry
+}  // namespace ChipCarving
@@ -0,0 +1,194 @@
+/**
+ * CanonicalShape.cpp
+ *
+ * Centroid, principal axis and scale normalization of profile outlines
+ */
+
+#include "geometry/CanonicalShape.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <utility>
+
+namespace ChipCarving {
+namespace Geometry {
+
+namespace {
+
+constexpr double QUANTUM = 1.0e-6;          // Key grid in normalized units (unit area)
+constexpr double MATCH_TOLERANCE = 1.0e-5;  // Largest vertex difference between matching normalized outlines
+constexpr double MIN_ANISOTROPY = 1.0e-3;   // Relative inertia spread below which the major axis is undefined
+constexpr double PI = 3.14159265358979323846;
+constexpr double INF = std::numeric_limits<double>::infinity();
+constexpr uint64_t FNV_OFFSET_BASIS = 14695981039346656037ULL;
+constexpr uint64_t FNV_PRIME = 1099511628211ULL;
+
+void hashValue(uint64_t& hash, int64_t value) {
+  uint64_t bits = static_cast<uint64_t>(value);
+  for (int i = 0; i < 8; ++i) {
+    hash ^= (bits >> (8 * i)) & 0xff;
+    hash *= FNV_PRIME;
+  }
+}
+
+int64_t quantize(double value) {
+  return static_cast<int64_t>(std::llround(value / QUANTUM));
+}
+
+}  // namespace
+
+bool canonicalizeShape(const std::vector<Point2D>& polygon, CanonicalShape& shape) {
+  size_t n = polygon.size();
+  if (n > 3 && distance(polygon.front(), polygon.back()) < 1e-10) {
+    --n;
+  }
+  if (n < 3) {
+    return false;
+  }
+
+  // Area moments about the first vertex, which keeps the sums well conditioned
+  const Point2D origin = polygon[0];
+  double area = 0.0, sx = 0.0, sy = 0.0, sxx = 0.0, syy = 0.0, sxy = 0.0;
+  for (size_t i = 0; i < n; ++i) {
+    Point2D a = polygon[i] - origin;
+    Point2D b = polygon[(i + 1) % n] - origin;
+    double cross = a.x * b.y - b.x * a.y;
+    area += cross;
+    sx += (a.x + b.x) * cross;
+    sy += (a.y + b.y) * cross;
+    sxx += (a.x * a.x + a.x * b.x + b.x * b.x) * cross;
+    syy += (a.y * a.y + a.y * b.y + b.y * b.y) * cross;
+    sxy += (a.x * b.y + 2.0 * a.x * a.y + 2.0 * b.x * b.y + b.x * a.y) * cross;
+  }
+  area /= 2.0;
+  if (!(std::abs(area) > 0.0)) {
+    return false;
+  }
+  Point2D center(sx / (6.0 * area), sy / (6.0 * area));
+  double cxx = sxx / (12.0 * area) - center.x * center.x;
+  double cyy = syy / (12.0 * area) - center.y * center.y;
+  double cxy = sxy / (24.0 * area) - center.x * center.y;
+  shape.centroid = center + origin;
+  shape.scale = std::sqrt(std::abs(area));
+
+  // The major axis fixes the rotation up to a half turn, settled by the vertex
+  // reaching furthest along it. Shapes with equal inertia in every direction
+  // (regular polygons, TriArcs) point at their furthest vertex instead; any
+  // tie there is a symmetry, so the normalized outline is the same either way
+  double spread = std::hypot(cxx - cyy, 2.0 * cxy);
+  if (spread > MIN_ANISOTROPY * (cxx + cyy)) {
+    shape.angle = 0.5 * std::atan2(2.0 * cxy, cxx - cyy);
+    Point2D axis(std::cos(shape.angle), std::sin(shape.angle));
+    double reach = 0.0;
+    for (size_t i = 0; i < n; ++i) {
+      Point2D offset = polygon[i] - shape.centroid;
+      double along = offset.x * axis.x + offset.y * axis.y;
+      if (std::abs(along) > std::abs(reach)) {
+        reach = along;
+      }
+    }
+    if (reach < 0.0) {
+      shape.angle += PI;
+    }
+  } else {
+    double furthest = -1.0;
+    for (size_t i = 0; i < n; ++i) {
+      Point2D offset = polygon[i] - shape.centroid;
+      double reach = offset.x * offset.x + offset.y * offset.y;
+      if (reach > furthest) {
+        furthest = reach;
+        shape.angle = std::atan2(offset.y, offset.x);
+      }
+    }
+  }
+
+  double c = std::cos(shape.angle) / shape.scale;
+  double s = std::sin(shape.angle) / shape.scale;
+  shape.normal.resize(n);
+  for (size_t i = 0; i < n; ++i) {
+    Point2D offset = polygon[area > 0.0 ? i : n - 1 - i] - shape.centroid;
+    shape.normal[i] = Point2D(offset.x * c + offset.y * s, offset.y * c - offset.x * s);
+  }
+
+  // Start at the lowest quantized vertex so the key ignores where the outline began
+  auto lower = [](const Point2D& a, const Point2D& b) {
+    return std::make_pair(quantize(a.x), quantize(a.y)) < std::make_pair(quantize(b.x), quantize(b.y));
+  };
+  std::rotate(shape.normal.begin(), std::min_element(shape.normal.begin(), shape.normal.end(), lower),
+              shape.normal.end());
+
+  shape.key = FNV_OFFSET_BASIS;
+  hashValue(shape.key, static_cast<int64_t>(n));
+  for (const auto& point : shape.normal) {
+    hashValue(shape.key, quantize(point.x));
+    hashValue(shape.key, quantize(point.y));
+  }
+  return true;
+}
+
+bool sameCanonicalShape(const CanonicalShape& a, const CanonicalShape& b) {
+  if (a.key != b.key || a.normal.size() != b.normal.size()) {
+    return false;
+  }
+  for (size_t i = 0; i < a.normal.size(); ++i) {
+    if (std::abs(a.normal[i].x - b.normal[i].x) > MATCH_TOLERANCE ||
+        std::abs(a.normal[i].y - b.normal[i].y) > MATCH_TOLERANCE) {
+      return false;
+    }
+  }
+  return true;
+}
+
+MedialAxisResults transformMedialAxis(const MedialAxisResults& results, const CanonicalShape& from,
+                                      const CanonicalShape& to) {
+  double ratio = to.scale / from.scale;
+  double c = std::cos(to.angle - from.angle) * ratio;
+  double s = std::sin(to.angle - from.angle) * ratio;
+
+  MedialAxisResults mapped = results;
+  const MedialAxisChains& chains = results.chains;
+  std::vector<double> x(chains.pointCount());
+  std::vector<double> y(chains.pointCount());
+  std::vector<double> radii(chains.pointCount());
+  for (size_t i = 0; i < chains.pointCount(); ++i) {
+    double dx = chains.xs()[i] - from.centroid.x;
+    double dy = chains.ys()[i] - from.centroid.y;
+    x[i] = to.centroid.x + dx * c - dy * s;
+    y[i] = to.centroid.y + dx * s + dy * c;
+    radii[i] = chains.radii()[i] * ratio;
+  }
+  mapped.chains.assign(std::move(x), std::move(y), std::move(radii), chains.offsets());
+  for (auto& loop : mapped.clearingLoops) {
+    for (auto& point : loop.points) {
+      Point2D offset = point - from.centroid;
+      point = Point2D(to.centroid.x + offset.x * c - offset.y * s, to.centroid.y + offset.x * s + offset.y * c);
+    }
+    loop.offset *= ratio;
+  }
+
+  mapped.totalLength *= ratio;
+  mapped.minClearance *= ratio;
+  mapped.maxClearance *= ratio;
+
+  // The unit circle fit follows the copy; its box bounds the mapped corners of the original one
+  Point2D corners[] = {results.transform.originalMin, results.transform.originalMax,
+                       Point2D(results.transform.originalMin.x, results.transform.originalMax.y),
+                       Point2D(results.transform.originalMax.x, results.transform.originalMin.y)};
+  Point2D low(INF, INF);
+  Point2D high(-INF, -INF);
+  for (const auto& corner : corners) {
+    Point2D offset = corner - from.centroid;
+    Point2D point(to.centroid.x + offset.x * c - offset.y * s, to.centroid.y + offset.x * s + offset.y * c);
+    low = Point2D(std::min(low.x, point.x), std::min(low.y, point.y));
+    high = Point2D(std::max(high.x, point.x), std::max(high.y, point.y));
+  }
+  mapped.transform.originalMin = low;
+  mapped.transform.originalMax = high;
+  mapped.transform.offset = (low + high) * 0.5;
+  mapped.transform.scale = results.transform.scale / ratio;
+  return mapped;
+}
+
+}  // namespace Geometry
+}  // namespace ChipCarving
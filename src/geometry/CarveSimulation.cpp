@@ -0,0 +1,288 @@
+/**
+ * CarveSimulation.cpp
+ *
+ * Tile-parallel V-bit rasterization
+ * Note: verifyCarve() is in CarveSimulationVerify.cpp
+ */
+
+#include "geometry/CarveSimulation.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <functional>
+#include <limits>
+#include <stdexcept>
+#include <string>
+#include <thread>
+
+#include "CarveSimulationTiles.h"
+#include "geometry/CarveSimulationGpu.h"
+
+#ifndef M_PI
+#define M_PI 3.14159265358979323846
+#endif
+
+namespace ChipCarving {
+namespace Geometry {
+
+TileGrid makeTileGrid(const DepthMap& map, int tileSize) {
+  TileGrid grid;
+  grid.tileSize = std::max(1, tileSize);
+  grid.tilesX = (map.width + grid.tileSize - 1) / grid.tileSize;
+  grid.tilesY = (map.height + grid.tileSize - 1) / grid.tileSize;
+  return grid;
+}
+
+bool tileRange(const DepthMap& map, const TileGrid& grid, const Point2D& min, const Point2D& max, int& x0, int& y0,
+               int& x1, int& y1) {
+  double span = map.resolution * grid.tileSize;
+  x0 = std::max(0, static_cast<int>(std::floor((min.x - map.origin.x) / span)));
+  y0 = std::max(0, static_cast<int>(std::floor((min.y - map.origin.y) / span)));
+  x1 = std::min(grid.tilesX - 1, static_cast<int>(std::floor((max.x - map.origin.x) / span)));
+  y1 = std::min(grid.tilesY - 1, static_cast<int>(std::floor((max.y - map.origin.y) / span)));
+  return x0 <= x1 && y0 <= y1;
+}
+
+void forEachTile(const TileGrid& grid, int requestedWorkers, const std::function<void(int, int)>& work) {
+  int tileCount = grid.tilesX * grid.tilesY;
+  int workers = requestedWorkers > 0 ? requestedWorkers : static_cast<int>(std::thread::hardware_concurrency());
+  workers = std::max(1, std::min(workers, tileCount));
+
+  std::atomic<int> nextTile{0};
+  auto worker = [&]() {
+    for (int tile = nextTile.fetch_add(1); tile < tileCount; tile = nextTile.fetch_add(1)) {
+      work(tile % grid.tilesX, tile / grid.tilesX);
+    }
+  };
+  if (workers == 1) {
+    worker();
+    return;
+  }
+  std::vector<std::thread> threads;
+  threads.reserve(static_cast<size_t>(workers));
+  for (int t = 0; t < workers; ++t) {
+    threads.emplace_back(worker);
+  }
+  for (auto& thread : threads) {
+    thread.join();
+  }
+}
+
+namespace {
+
+constexpr double DEGENERATE_SEGMENT = 1e-9;
+
+// One straight move with the tool tip depth varying linearly from a to b
+struct CutSegment {
+  Point2D a;
+  Point2D b;
+  double depthA;
+  double depthB;
+};
+
+/**
+ * Deepest cut of the cone swept along segment at point
+ * Along the segment the cut is depth(u) - cot * distance(u), a concave
+ * function of the position u, so its maximum is the clamped stationary point.
+ */
+double segmentCut(const CutSegment& segment, const Point2D& point, double cotHalfAngle, double toolRadius) {
+  double dx = segment.b.x - segment.a.x;
+  double dy = segment.b.y - segment.a.y;
+  double length = std::sqrt(dx * dx + dy * dy);
+  double px = point.x - segment.a.x;
+  double py = point.y - segment.a.y;
+  if (length < DEGENERATE_SEGMENT) {
+    double dist = std::sqrt(px * px + py * py);
+    return dist <= toolRadius ? std::max(segment.depthA, segment.depthB) - cotHalfAngle * dist : 0.0;
+  }
+
+  double along = (px * dx + py * dy) / length;
+  double offset = std::abs(px * dy - py * dx) / length;
+  double slope = (segment.depthB - segment.depthA) / length;
+  double ratio = slope / cotHalfAngle;
+  double u;
+  if (ratio >= 1.0) {
+    u = length;  // Depth grows faster than the cone: the deep end cuts deepest
+  } else if (ratio <= -1.0) {
+    u = 0.0;
+  } else {
+    u = along + offset * ratio / std::sqrt(1.0 - ratio * ratio);
+  }
+  u = std::max(0.0, std::min(length, u));
+
+  double dist = std::sqrt((u - along) * (u - along) + offset * offset);
+  if (dist > toolRadius) {
+    // Past the cutting diameter; only the nearest position can still reach
+    u = std::max(0.0, std::min(length, along));
+    dist = std::sqrt((u - along) * (u - along) + offset * offset);
+    if (dist > toolRadius) {
+      return 0.0;
+    }
+  }
+  return segment.depthA + slope * u - cotHalfAngle * dist;
+}
+
+// Segments relative to the map origin and the tile bins flattened for the kernel
+GpuCarveJob makeGpuJob(const std::vector<CutSegment>& segments, const std::vector<std::vector<size_t>>& tileSegments,
+                       const DepthMap& map, const TileGrid& grid, double cotHalfAngle, double toolRadius) {
+  GpuCarveJob job;
+  job.segments.reserve(segments.size());
+  for (const CutSegment& s : segments) {
+    job.segments.push_back({static_cast<float>(s.a.x - map.origin.x), static_cast<float>(s.a.y - map.origin.y),
+                            static_cast<float>(s.b.x - map.origin.x), static_cast<float>(s.b.y - map.origin.y),
+                            static_cast<float>(s.depthA), static_cast<float>(s.depthB)});
+  }
+  job.tileOffsets.reserve(tileSegments.size() + 1);
+  job.tileOffsets.push_back(0);
+  for (const auto& bin : tileSegments) {
+    job.tileSegments.insert(job.tileSegments.end(), bin.begin(), bin.end());
+    job.tileOffsets.push_back(static_cast<uint32_t>(job.tileSegments.size()));
+  }
+  job.tileSize = grid.tileSize;
+  job.tilesX = grid.tilesX;
+  job.cotHalfAngle = static_cast<float>(cotHalfAngle);
+  job.toolRadius = static_cast<float>(std::min(toolRadius, static_cast<double>(std::numeric_limits<float>::max())));
+  return job;
+}
+
+DepthMap rasterize(const std::vector<CutSegment>& segments, const ShapeBounds& area,
+                   const CarveSimulationParams& params) {
+  if (params.resolution <= 0.0 || params.toolAngle <= 0.0 || params.toolAngle >= 180.0) {
+    throw std::invalid_argument("Carve simulation needs a positive resolution and a tool angle below 180 degrees");
+  }
+  DepthMap map;
+  map.origin = area.min;
+  map.resolution = params.resolution;
+  map.width = std::max(1, static_cast<int>(std::ceil((area.max.x - area.min.x) / params.resolution)));
+  map.height = std::max(1, static_cast<int>(std::ceil((area.max.y - area.min.y) / params.resolution)));
+  if (static_cast<double>(map.width) * map.height > static_cast<double>(params.maxCells)) {
+    throw std::invalid_argument("Carve simulation area needs " + std::to_string(map.width) + " x " +
+                                std::to_string(map.height) + " cells; use a coarser resolution");
+  }
+  map.depth.assign(static_cast<size_t>(map.width) * map.height, 0.0f);
+
+  double halfAngle = params.toolAngle * M_PI / 360.0;
+  double cotHalfAngle = 1.0 / std::tan(halfAngle);
+  double toolRadius = params.toolDiameter > 0.0 ? params.toolDiameter / 2.0 : std::numeric_limits<double>::max();
+
+  // Bin segments by the tiles their reach overlaps; the cone is spent at depth * tan
+  TileGrid grid = makeTileGrid(map, params.tileSize);
+  std::vector<std::vector<size_t>> tileSegments(static_cast<size_t>(grid.tilesX) * grid.tilesY);
+  for (size_t i = 0; i < segments.size(); ++i) {
+    const CutSegment& s = segments[i];
+    double reach = std::min(toolRadius, std::max(s.depthA, s.depthB) * std::tan(halfAngle));
+    if (reach <= 0.0) {
+      continue;
+    }
+    Point2D min(std::min(s.a.x, s.b.x) - reach, std::min(s.a.y, s.b.y) - reach);
+    Point2D max(std::max(s.a.x, s.b.x) + reach, std::max(s.a.y, s.b.y) + reach);
+    int x0, y0, x1, y1;
+    if (!tileRange(map, grid, min, max, x0, y0, x1, y1)) {
+      continue;
+    }
+    for (int ty = y0; ty <= y1; ++ty) {
+      for (int tx = x0; tx <= x1; ++tx) {
+        tileSegments[static_cast<size_t>(ty) * grid.tilesX + tx].push_back(i);
+      }
+    }
+  }
+
+  if (params.backend == CarveSimulationBackend::GPU && carveSimulationGpuAvailable()) {
+    std::string error;
+    if (rasterizeCarveOnGpu(makeGpuJob(segments, tileSegments, map, grid, cotHalfAngle, toolRadius), map, error)) {
+      map.backend = CarveSimulationBackend::GPU;
+      return map;
+    }
+    // The device failed; the map is still untouched for the CPU tiles
+  }
+
+  // Tiles own disjoint cells, so workers write the map without locking
+  forEachTile(grid, params.workers, [&](int tx, int ty) {
+    const std::vector<size_t>& candidates = tileSegments[static_cast<size_t>(ty) * grid.tilesX + tx];
+    if (candidates.empty()) {
+      return;
+    }
+    int xEnd = std::min(map.width, (tx + 1) * grid.tileSize);
+    int yEnd = std::min(map.height, (ty + 1) * grid.tileSize);
+    for (int y = ty * grid.tileSize; y < yEnd; ++y) {
+      for (int x = tx * grid.tileSize; x < xEnd; ++x) {
+        Point2D center = map.cellCenter(x, y);
+        double deepest = 0.0;
+        for (size_t index : candidates) {
+          deepest = std::max(deepest, segmentCut(segments[index], center, cotHalfAngle, toolRadius));
+        }
+        map.depth[static_cast<size_t>(y) * map.width + x] = static_cast<float>(deepest);
+      }
+    }
+  });
+  return map;
+}
+
+void appendPath(const std::vector<Point2D>& points, const std::vector<double>& depths,
+                std::vector<CutSegment>& segments) {
+  if (points.size() == 1) {
+    segments.push_back({points[0], points[0], depths[0], depths[0]});
+  }
+  for (size_t i = 1; i < points.size(); ++i) {
+    segments.push_back({points[i - 1], points[i], depths[i - 1], depths[i]});
+  }
+}
+
+}  // namespace
+
+ShapeBounds simulationArea(const std::vector<const Shape*>& shapes, double margin) {
+  ShapeBounds area;
+  bool first = true;
+  for (const Shape* shape : shapes) {
+    if (!shape) {
+      continue;
+    }
+    ShapeBounds bounds = shape->getBounds();
+    area.min = first ? bounds.min : Point2D(std::min(area.min.x, bounds.min.x), std::min(area.min.y, bounds.min.y));
+    area.max = first ? bounds.max : Point2D(std::max(area.max.x, bounds.max.x), std::max(area.max.y, bounds.max.y));
+    first = false;
+  }
+  area.min = Point2D(area.min.x - margin, area.min.y - margin);
+  area.max = Point2D(area.max.x + margin, area.max.y + margin);
+  return area;
+}
+
+DepthMap simulateCarve(const VCarveResults& results, const ShapeBounds& area, const CarveSimulationParams& params) {
+  std::vector<CutSegment> segments;
+  std::vector<Point2D> points;
+  std::vector<double> depths;
+  for (const auto& path : results.paths) {
+    if (!path.isValid()) {
+      continue;
+    }
+    points.clear();
+    depths.clear();
+    for (const auto& point : path.points) {
+      points.push_back(point.position);
+      depths.push_back(point.depth);
+    }
+    appendPath(points, depths, segments);
+  }
+  return rasterize(segments, area, params);
+}
+
+DepthMap simulateCarve(const std::vector<std::vector<Point3D>>& toolpaths, const ShapeBounds& area,
+                       const CarveSimulationParams& params) {
+  std::vector<CutSegment> segments;
+  std::vector<Point2D> points;
+  std::vector<double> depths;
+  for (const auto& toolpath : toolpaths) {
+    points.clear();
+    depths.clear();
+    for (const auto& point : toolpath) {
+      points.emplace_back(point.x, point.y);
+      depths.push_back(-point.z);
+    }
+    appendPath(points, depths, segments);
+  }
+  return rasterize(segments, area, params);
+}
+
+}  // namespace Geometry
+}  // namespace ChipCarving
@@ -0,0 +1,149 @@
+/**
+ * CarveSimulationExport.cpp
+ *
+ * PNG export of carve verification rasters. The image is written with
+ * uncompressed deflate blocks, so no zlib dependency is needed.
+ */
+
+#include <algorithm>
+#include <array>
+#include <fstream>
+
+#include "geometry/CarveSimulation.h"
+
+namespace ChipCarving {
+namespace Geometry {
+
+namespace {
+
+constexpr size_t MAX_STORED_BLOCK = 65535;
+
+const std::array<uint32_t, 256>& crcTable() {
+  static const std::array<uint32_t, 256> table = [] {
+    std::array<uint32_t, 256> entries{};
+    for (uint32_t n = 0; n < 256; ++n) {
+      uint32_t c = n;
+      for (int k = 0; k < 8; ++k) {
+        c = (c & 1) ? 0xEDB88320u ^ (c >> 1) : c >> 1;
+      }
+      entries[n] = c;
+    }
+    return entries;
+  }();
+  return table;
+}
+
+uint32_t crc32(const std::vector<uint8_t>& bytes) {
+  uint32_t c = 0xFFFFFFFFu;
+  for (uint8_t byte : bytes) {
+    c = crcTable()[(c ^ byte) & 0xFF] ^ (c >> 8);
+  }
+  return c ^ 0xFFFFFFFFu;
+}
+
+void appendBigEndian(std::vector<uint8_t>& out, uint32_t value) {
+  out.push_back(static_cast<uint8_t>(value >> 24));
+  out.push_back(static_cast<uint8_t>(value >> 16));
+  out.push_back(static_cast<uint8_t>(value >> 8));
+  out.push_back(static_cast<uint8_t>(value));
+}
+
+void writeChunk(std::ofstream& file, const char* type, const std::vector<uint8_t>& data) {
+  std::vector<uint8_t> chunk(type, type + 4);
+  chunk.insert(chunk.end(), data.begin(), data.end());
+  std::vector<uint8_t> header;
+  appendBigEndian(header, static_cast<uint32_t>(data.size()));
+  std::vector<uint8_t> trailer;
+  appendBigEndian(trailer, crc32(chunk));
+  file.write(reinterpret_cast<const char*>(header.data()), header.size());
+  file.write(reinterpret_cast<const char*>(chunk.data()), chunk.size());
+  file.write(reinterpret_cast<const char*>(trailer.data()), trailer.size());
+}
+
+// zlib stream of stored (uncompressed) deflate blocks
+std::vector<uint8_t> storedZlib(const std::vector<uint8_t>& raw) {
+  std::vector<uint8_t> out = {0x78, 0x01};
+  size_t offset = 0;
+  do {
+    size_t length = std::min(MAX_STORED_BLOCK, raw.size() - offset);
+    bool last = offset + length == raw.size();
+    out.push_back(last ? 1 : 0);
+    out.push_back(static_cast<uint8_t>(length));
+    out.push_back(static_cast<uint8_t>(length >> 8));
+    out.push_back(static_cast<uint8_t>(~length));
+    out.push_back(static_cast<uint8_t>(~length >> 8));
+    out.insert(out.end(), raw.begin() + offset, raw.begin() + offset + length);
+    offset += length;
+  } while (offset < raw.size());
+
+  uint32_t a = 1;
+  uint32_t b = 0;
+  for (uint8_t byte : raw) {
+    a = (a + byte) % 65521;
+    b = (b + a) % 65521;
+  }
+  appendBigEndian(out, (b << 16) | a);
+  return out;
+}
+
+std::array<uint8_t, 3> cellColor(CarveCell cell, double depthFraction) {
+  switch (cell) {
+    case CarveCell::GOUGE:
+      return {220, 30, 30};
+    case CarveCell::MISSED:
+      return {30, 90, 230};
+    case CarveCell::CARVED: {
+      // Lighter wood for shallow cuts, darker for deep ones
+      double shade = 1.0 - 0.7 * std::min(1.0, depthFraction);
+      return {static_cast<uint8_t>(200 * shade), static_cast<uint8_t>(150 * shade),
+              static_cast<uint8_t>(90 * shade)};
+    }
+    case CarveCell::STOCK:
+    default:
+      return {240, 225, 195};
+  }
+}
+
+}  // namespace
+
+bool writeCarveVerificationPng(const std::string& path, const DepthMap& map, const CarveVerification& verification) {
+  if (map.width <= 0 || map.height <= 0 || verification.cells.size() != map.depth.size()) {
+    return false;
+  }
+  float deepest = 0.0f;
+  for (float depth : map.depth) {
+    deepest = std::max(deepest, depth);
+  }
+
+  // One filter byte (none) per row; row 0 of the image is the map's top row
+  std::vector<uint8_t> raw;
+  raw.reserve(static_cast<size_t>(map.height) * (1 + 3 * static_cast<size_t>(map.width)));
+  for (int y = map.height - 1; y >= 0; --y) {
+    raw.push_back(0);
+    for (int x = 0; x < map.width; ++x) {
+      size_t index = static_cast<size_t>(y) * map.width + x;
+      double fraction = deepest > 0.0f ? map.depth[index] / deepest : 0.0;
+      auto rgb = cellColor(verification.cells[index], fraction);
+      raw.insert(raw.end(), rgb.begin(), rgb.end());
+    }
+  }
+
+  std::ofstream file(path, std::ios::binary);
+  if (!file) {
+    return false;
+  }
+  static const uint8_t SIGNATURE[8] = {0x89, 'P', 'N', 'G', '\r', '\n', 0x1A, '\n'};
+  file.write(reinterpret_cast<const char*>(SIGNATURE), sizeof(SIGNATURE));
+
+  std::vector<uint8_t> header;
+  appendBigEndian(header, static_cast<uint32_t>(map.width));
+  appendBigEndian(header, static_cast<uint32_t>(map.height));
+  header.insert(header.end(), {8, 2, 0, 0, 0});  // 8-bit RGB, deflate, no filter, no interlace
+  writeChunk(file, "IHDR", header);
+  writeChunk(file, "IDAT", storedZlib(raw));
+  writeChunk(file, "IEND", {});
+  return static_cast<bool>(file);
+}
+
+}  // namespace Geometry
+}  // namespace ChipCarving
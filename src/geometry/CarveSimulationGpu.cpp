@@ -0,0 +1,27 @@
+/**
+ * CarveSimulationGpu.cpp
+ *
+ * GPU backend for builds without one: no device, so simulations always run
+ * on the CPU tiles. Metal builds compile CarveSimulationMetal.mm instead.
+ */
+
+#include "geometry/CarveSimulationGpu.h"
+
+#ifndef CHIP_CARVING_METAL
+
+namespace ChipCarving {
+namespace Geometry {
+
+bool carveSimulationGpuAvailable() {
+  return false;
+}
+
+bool rasterizeCarveOnGpu(const GpuCarveJob& /*job*/, DepthMap& /*map*/, std::string& error) {
+  error = "No GPU backend in this build";
+  return false;
+}
+
+}  // namespace Geometry
+}  // namespace ChipCarving
+
+#endif  // CHIP_CARVING_METAL
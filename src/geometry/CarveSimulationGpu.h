@@ -0,0 +1,49 @@
+/**
+ * CarveSimulationGpu.h
+ *
+ * Interface between the carve simulation and its GPU backend. The CPU side
+ * bins the segments by tile as for its own workers and flattens the bins, so
+ * the kernel runs one thread per cell over its tile's segments.
+ * CarveSimulationMetal.mm implements it on macOS builds with
+ * CHIP_CARVING_METAL; CarveSimulationGpu.cpp reports no device elsewhere.
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "geometry/CarveSimulation.h"
+
+namespace ChipCarving {
+namespace Geometry {
+
+// Cut segment relative to the map origin, laid out as the kernel reads it
+struct GpuCutSegment {
+  float ax;
+  float ay;
+  float bx;
+  float by;
+  float depthA;
+  float depthB;
+};
+
+struct GpuCarveJob {
+  std::vector<GpuCutSegment> segments{};
+  std::vector<uint32_t> tileOffsets{};   // Tile t's segments are tileSegments[tileOffsets[t], tileOffsets[t + 1])
+  std::vector<uint32_t> tileSegments{};  // Indices into segments
+  int tileSize = 0;
+  int tilesX = 0;
+  float cotHalfAngle = 0.0f;
+  float toolRadius = 0.0f;
+};
+
+/**
+ * Fill map.depth for the map's size and resolution
+ * @param error Set when the device fails; the caller falls back to the CPU tiles
+ */
+bool rasterizeCarveOnGpu(const GpuCarveJob& job, DepthMap& map, std::string& error);
+
+}  // namespace Geometry
+}  // namespace ChipCarving
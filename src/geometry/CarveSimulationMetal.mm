@@ -0,0 +1,236 @@
+/**
+ * CarveSimulationMetal.mm
+ *
+ * Metal compute backend for the carve simulation: one GPU thread per cell
+ * takes the deepest cut of the segments binned to its tile, with the cone
+ * evaluation of the CPU tiles in single precision. Rows are dispatched in
+ * bands, one command buffer each, so a full panel stays clear of the GPU
+ * watchdog. Built with ARC on macOS (see cmake/CarveSimulationGpu.cmake).
+ */
+
+#include "geometry/CarveSimulationGpu.h"
+
+#import <Foundation/Foundation.h>
+#import <Metal/Metal.h>
+
+#include <algorithm>
+#include <cstring>
+#include <vector>
+
+namespace ChipCarving {
+namespace Geometry {
+
+namespace {
+
+constexpr int ROWS_PER_COMMAND_BUFFER = 1024;
+
+// Mirrors segmentCut in CarveSimulation.cpp
+const char* const CARVE_KERNEL_SOURCE = R"METAL(
+#include <metal_stdlib>
+using namespace metal;
+
+struct Segment {
+  float ax;
+  float ay;
+  float bx;
+  float by;
+  float depthA;
+  float depthB;
+};
+
+struct CarveParams {
+  float resolution;
+  float cotHalfAngle;
+  float toolRadius;
+  uint width;
+  uint height;
+  uint firstRow;
+  uint tileSize;
+  uint tilesX;
+};
+
+float segmentCut(Segment s, float2 point, float cotHalfAngle, float toolRadius) {
+  float2 a = float2(s.ax, s.ay);
+  float2 d = float2(s.bx, s.by) - a;
+  float2 p = point - a;
+  float len = sqrt(dot(d, d));
+  if (len < 1e-6f) {
+    float dist = sqrt(dot(p, p));
+    return dist <= toolRadius ? max(s.depthA, s.depthB) - cotHalfAngle * dist : 0.0f;
+  }
+
+  float along = dot(p, d) / len;
+  float offset = fabs(p.x * d.y - p.y * d.x) / len;
+  float slope = (s.depthB - s.depthA) / len;
+  float ratio = slope / cotHalfAngle;
+  float u;
+  if (ratio >= 1.0f) {
+    u = len;
+  } else if (ratio <= -1.0f) {
+    u = 0.0f;
+  } else {
+    u = along + offset * ratio / sqrt(1.0f - ratio * ratio);
+  }
+  u = clamp(u, 0.0f, len);
+
+  float dist = sqrt((u - along) * (u - along) + offset * offset);
+  if (dist > toolRadius) {
+    u = clamp(along, 0.0f, len);
+    dist = sqrt((u - along) * (u - along) + offset * offset);
+    if (dist > toolRadius) {
+      return 0.0f;
+    }
+  }
+  return s.depthA + slope * u - cotHalfAngle * dist;
+}
+
+kernel void carveDepth(device const Segment* segments [[buffer(0)]],
+                       device const uint* tileOffsets [[buffer(1)]],
+                       device const uint* tileSegments [[buffer(2)]],
+                       constant CarveParams& params [[buffer(3)]],
+                       device float* depth [[buffer(4)]],
+                       uint2 position [[thread_position_in_grid]]) {
+  uint x = position.x;
+  uint y = position.y + params.firstRow;
+  if (x >= params.width || y >= params.height) {
+    return;
+  }
+  uint tile = (y / params.tileSize) * params.tilesX + x / params.tileSize;
+  float2 center = (float2(x, y) + 0.5f) * params.resolution;
+  float deepest = 0.0f;
+  for (uint k = tileOffsets[tile]; k < tileOffsets[tile + 1]; ++k) {
+    deepest = max(deepest, segmentCut(segments[tileSegments[k]], center, params.cotHalfAngle, params.toolRadius));
+  }
+  depth[y * params.width + x] = deepest;
+}
+)METAL";
+
+// Same layout as CarveParams in the kernel
+struct CarveParams {
+  float resolution;
+  float cotHalfAngle;
+  float toolRadius;
+  uint32_t width;
+  uint32_t height;
+  uint32_t firstRow;
+  uint32_t tileSize;
+  uint32_t tilesX;
+};
+
+// Device, queue and compiled kernel, created once per process
+struct MetalCarveContext {
+  id<MTLDevice> device = nil;
+  id<MTLCommandQueue> queue = nil;
+  id<MTLComputePipelineState> pipeline = nil;
+  std::string error{};
+};
+
+MetalCarveContext createContext() {
+  MetalCarveContext context;
+  @autoreleasepool {
+    id<MTLDevice> device = MTLCreateSystemDefaultDevice();
+    if (!device) {
+      context.error = "No Metal device";
+      return context;
+    }
+    NSError* error = nil;
+    id<MTLLibrary> library = [device newLibraryWithSource:@(CARVE_KERNEL_SOURCE) options:nil error:&error];
+    id<MTLFunction> function = library ? [library newFunctionWithName:@"carveDepth"] : nil;
+    id<MTLComputePipelineState> pipeline =
+        function ? [device newComputePipelineStateWithFunction:function error:&error] : nil;
+    if (!pipeline) {
+      context.error = std::string("Carve kernel failed to build: ") +
+                      (error ? error.localizedDescription.UTF8String : "unknown error");
+      return context;
+    }
+    context.device = device;
+    context.queue = [device newCommandQueue];
+    context.pipeline = pipeline;
+  }
+  return context;
+}
+
+const MetalCarveContext& carveContext() {
+  static const MetalCarveContext context = createContext();
+  return context;
+}
+
+// Metal rejects zero-length buffers, so empty inputs get one unused element
+template <typename T>
+id<MTLBuffer> makeBuffer(id<MTLDevice> device, const std::vector<T>& data) {
+  static const T placeholder{};
+  const T* bytes = data.empty() ? &placeholder : data.data();
+  size_t length = std::max<size_t>(1, data.size()) * sizeof(T);
+  return [device newBufferWithBytes:bytes length:length options:MTLResourceStorageModeShared];
+}
+
+}  // namespace
+
+bool carveSimulationGpuAvailable() {
+  return carveContext().pipeline != nil;
+}
+
+bool rasterizeCarveOnGpu(const GpuCarveJob& job, DepthMap& map, std::string& error) {
+  const MetalCarveContext& context = carveContext();
+  if (!context.pipeline) {
+    error = context.error;
+    return false;
+  }
+
+  @autoreleasepool {
+    size_t cellCount = static_cast<size_t>(map.width) * map.height;
+    id<MTLBuffer> segments = makeBuffer(context.device, job.segments);
+    id<MTLBuffer> tileOffsets = makeBuffer(context.device, job.tileOffsets);
+    id<MTLBuffer> tileSegments = makeBuffer(context.device, job.tileSegments);
+    id<MTLBuffer> depth = [context.device newBufferWithLength:cellCount * sizeof(float)
+                                                      options:MTLResourceStorageModeShared];
+    if (!segments || !tileOffsets || !tileSegments || !depth) {
+      error = "Metal buffer allocation failed";
+      return false;
+    }
+
+    NSUInteger groupWidth = context.pipeline.threadExecutionWidth;
+    NSUInteger groupHeight = std::max<NSUInteger>(1, context.pipeline.maxTotalThreadsPerThreadgroup / groupWidth);
+    CarveParams params{static_cast<float>(map.resolution),
+                       job.cotHalfAngle,
+                       job.toolRadius,
+                       static_cast<uint32_t>(map.width),
+                       static_cast<uint32_t>(map.height),
+                       0,
+                       static_cast<uint32_t>(job.tileSize),
+                       static_cast<uint32_t>(job.tilesX)};
+
+    std::vector<id<MTLCommandBuffer>> commands;
+    for (int firstRow = 0; firstRow < map.height; firstRow += ROWS_PER_COMMAND_BUFFER) {
+      params.firstRow = static_cast<uint32_t>(firstRow);
+      int rows = std::min(ROWS_PER_COMMAND_BUFFER, map.height - firstRow);
+      id<MTLCommandBuffer> command = [context.queue commandBuffer];
+      id<MTLComputeCommandEncoder> encoder = [command computeCommandEncoder];
+      [encoder setComputePipelineState:context.pipeline];
+      [encoder setBuffer:segments offset:0 atIndex:0];
+      [encoder setBuffer:tileOffsets offset:0 atIndex:1];
+      [encoder setBuffer:tileSegments offset:0 atIndex:2];
+      [encoder setBytes:&params length:sizeof(params) atIndex:3];
+      [encoder setBuffer:depth offset:0 atIndex:4];
+      [encoder dispatchThreads:MTLSizeMake(static_cast<NSUInteger>(map.width), static_cast<NSUInteger>(rows), 1)
+          threadsPerThreadgroup:MTLSizeMake(groupWidth, groupHeight, 1)];
+      [encoder endEncoding];
+      [command commit];
+      commands.push_back(command);
+    }
+    for (id<MTLCommandBuffer> command : commands) {
+      [command waitUntilCompleted];
+      if (command.status != MTLCommandBufferStatusCompleted) {
+        error = std::string("Carve kernel failed: ") +
+                (command.error ? command.error.localizedDescription.UTF8String : "unknown error");
+        return false;
+      }
+    }
+
+    std::memcpy(map.depth.data(), depth.contents, cellCount * sizeof(float));
+  }
+  return true;
+}
+
+}  // namespace Geometry
+}  // namespace ChipCarving
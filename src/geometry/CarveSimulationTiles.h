@@ -0,0 +1,34 @@
+/**
+ * CarveSimulationTiles.h
+ *
+ * Square tiles of depth map cells shared by the carve rasterizer and the
+ * shape mask verification (internal to src/geometry)
+ * Split from CarveSimulation.cpp for maintainability
+ */
+
+#pragma once
+
+#include <functional>
+
+#include "geometry/CarveSimulation.h"
+
+namespace ChipCarving {
+namespace Geometry {
+
+struct TileGrid {
+  int tileSize;
+  int tilesX;
+  int tilesY;
+};
+
+TileGrid makeTileGrid(const DepthMap& map, int tileSize);
+
+// Tiles whose cells overlap [min, max]; false if none do
+bool tileRange(const DepthMap& map, const TileGrid& grid, const Point2D& min, const Point2D& max, int& x0, int& y0,
+               int& x1, int& y1);
+
+// Run work(tile) for every tile; workers pull the next tile so dense tiles balance
+void forEachTile(const TileGrid& grid, int requestedWorkers, const std::function<void(int, int)>& work);
+
+}  // namespace Geometry
+}  // namespace ChipCarving
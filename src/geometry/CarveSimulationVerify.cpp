@@ -0,0 +1,141 @@
+/**
+ * CarveSimulationVerify.cpp
+ *
+ * Shape mask verification of simulated carves
+ * Split from CarveSimulation.cpp for maintainability
+ */
+
+#include "geometry/CarveSimulation.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <vector>
+
+#include "CarveSimulationTiles.h"
+#include "geometry/ShapeContainment.h"
+#include "geometry/ShapeStore.h"
+
+#ifndef M_PI
+#define M_PI 3.14159265358979323846
+#endif
+
+namespace ChipCarving {
+namespace Geometry {
+
+CarveVerification verifyCarve(const DepthMap& map, const std::vector<const Shape*>& shapes,
+                              const CarveSimulationParams& params) {
+  CarveVerification verification;
+  verification.width = map.width;
+  verification.height = map.height;
+  size_t cellCount = static_cast<size_t>(map.width) * map.height;
+  std::vector<uint8_t> inside(cellCount, 0);
+
+  // Shape masks, each tile testing only the shapes whose bounds reach it
+  TileGrid grid = makeTileGrid(map, params.tileSize);
+  std::vector<std::vector<const Shape*>> tileShapes(static_cast<size_t>(grid.tilesX) * grid.tilesY);
+  for (const Shape* shape : shapes) {
+    int x0, y0, x1, y1;
+    if (shape && tileRange(map, grid, shape->getBounds().min, shape->getBounds().max, x0, y0, x1, y1)) {
+      for (int ty = y0; ty <= y1; ++ty) {
+        for (int tx = x0; tx <= x1; ++tx) {
+          tileShapes[static_cast<size_t>(ty) * grid.tilesX + tx].push_back(shape);
+        }
+      }
+    }
+  }
+
+  // Leaves and tri-arcs are tested a tile of cell centers at a time by the batch index; any other shape one by one
+  ShapeStore store;
+  bool batched = true;
+  for (const Shape* shape : shapes) {
+    batched = batched && (!shape || store.add(*shape));
+  }
+  ShapeContainmentIndex index = batched ? ShapeContainmentIndex(store) : ShapeContainmentIndex();
+
+  forEachTile(grid, params.workers, [&](int tx, int ty) {
+    const std::vector<const Shape*>& candidates = tileShapes[static_cast<size_t>(ty) * grid.tilesX + tx];
+    int xEnd = std::min(map.width, (tx + 1) * grid.tileSize);
+    int yEnd = std::min(map.height, (ty + 1) * grid.tileSize);
+    if (batched) {
+      if (candidates.empty()) {
+        return;
+      }
+      std::vector<Point2D> centers;
+      for (int y = ty * grid.tileSize; y < yEnd; ++y) {
+        for (int x = tx * grid.tileSize; x < xEnd; ++x) {
+          centers.push_back(map.cellCenter(x, y));
+        }
+      }
+      std::vector<uint8_t> mask(centers.size());
+      index.containsBatch(centers.data(), centers.size(), mask.data(), 1);
+      size_t width = static_cast<size_t>(xEnd - tx * grid.tileSize);
+      for (int y = ty * grid.tileSize; y < yEnd; ++y) {
+        std::copy_n(mask.begin() + static_cast<size_t>(y - ty * grid.tileSize) * width, width,
+                    inside.begin() + static_cast<size_t>(y) * map.width + tx * grid.tileSize);
+      }
+      return;
+    }
+    for (int y = ty * grid.tileSize; y < yEnd && !candidates.empty(); ++y) {
+      for (int x = tx * grid.tileSize; x < xEnd; ++x) {
+        Point2D center = map.cellCenter(x, y);
+        inside[static_cast<size_t>(y) * map.width + x] = std::any_of(
+            candidates.begin(), candidates.end(), [&center](const Shape* shape) { return shape->contains(center); });
+      }
+    }
+  });
+
+  // A correct V-carve is shallower than the tolerance within depthTolerance * tan
+  // of a boundary; a summed-area table tells whether a cell's band crosses one
+  double tanHalfAngle = std::tan(params.toolAngle * M_PI / 360.0);
+  int band = static_cast<int>(std::ceil(params.depthTolerance * tanHalfAngle / map.resolution)) + 1;
+  int stride = map.width + 1;
+  std::vector<uint32_t> sums(static_cast<size_t>(stride) * (map.height + 1), 0);
+  for (int y = 0; y < map.height; ++y) {
+    for (int x = 0; x < map.width; ++x) {
+      sums[static_cast<size_t>(y + 1) * stride + x + 1] = inside[static_cast<size_t>(y) * map.width + x] +
+                                                          sums[static_cast<size_t>(y) * stride + x + 1] +
+                                                          sums[static_cast<size_t>(y + 1) * stride + x] -
+                                                          sums[static_cast<size_t>(y) * stride + x];
+    }
+  }
+  auto insideInWindow = [&](int x, int y) {
+    int x0 = std::max(0, x - band);
+    int y0 = std::max(0, y - band);
+    int x1 = std::min(map.width, x + band + 1);
+    int y1 = std::min(map.height, y + band + 1);
+    return sums[static_cast<size_t>(y1) * stride + x1] - sums[static_cast<size_t>(y0) * stride + x1] -
+           sums[static_cast<size_t>(y1) * stride + x0] + sums[static_cast<size_t>(y0) * stride + x0];
+  };
+  const uint32_t fullWindow = static_cast<uint32_t>((2 * band + 1) * (2 * band + 1));
+
+  verification.cells.assign(cellCount, CarveCell::STOCK);
+  for (int y = 0; y < map.height; ++y) {
+    for (int x = 0; x < map.width; ++x) {
+      size_t index = static_cast<size_t>(y) * map.width + x;
+      bool cut = map.depth[index] > params.depthTolerance;
+      if (inside[index]) {
+        verification.insideCells++;
+        if (cut) {
+          verification.cells[index] = CarveCell::CARVED;
+          verification.carvedCells++;
+        } else if (insideInWindow(x, y) == fullWindow) {
+          verification.cells[index] = CarveCell::MISSED;
+          verification.missedCells++;
+        }
+      } else if (cut) {
+        if (insideInWindow(x, y) == 0) {
+          verification.cells[index] = CarveCell::GOUGE;
+          verification.gougeCells++;
+          verification.maxGougeDepth = std::max(verification.maxGougeDepth, static_cast<double>(map.depth[index]));
+        } else {
+          verification.cells[index] = CarveCell::CARVED;  // Boundary rasterization, not a gouge
+        }
+      }
+    }
+  }
+  return verification;
+}
+
+}  // namespace Geometry
+}  // namespace ChipCarving
@@ -0,0 +1,140 @@
+/**
+ * CompactPaths.cpp
+ *
+ * Float32 structure-of-arrays storage for computed toolpaths
+ */
+
+#include "geometry/CompactPaths.h"
+
+#include <algorithm>
+
+#include "geometry/MedialAxisUtilities.h"
+#include "geometry/VCarvePath.h"
+
+namespace ChipCarving {
+namespace Geometry {
+
+namespace {
+
+template <typename T>
+size_t vectorBytes(const std::vector<T>& values) {
+  return values.capacity() * sizeof(T);
+}
+
+}  // namespace
+
+size_t CompactVCarvePaths::bytes() const {
+  return vectorBytes(x) + vectorBytes(y) + vectorBytes(depth) + vectorBytes(clearance) + vectorBytes(surfaceZ) +
+         vectorBytes(surfaceProjected) + vectorBytes(pathStarts) + vectorBytes(pathLengths) + vectorBytes(pathClosed);
+}
+
+size_t CompactSampledMedialPaths::bytes() const {
+  return vectorBytes(x) + vectorBytes(y) + vectorBytes(clearance) + vectorBytes(pathStarts) + vectorBytes(pathLengths);
+}
+
+CompactVCarvePaths compactVCarvePaths(const std::vector<VCarvePath>& paths) {
+  CompactVCarvePaths compact;
+  size_t count = 0;
+  for (const auto& path : paths) {
+    if (count == 0 && !path.points.empty()) {
+      compact.origin = path.points.front().position;
+    }
+    count += path.points.size();
+  }
+
+  compact.x.reserve(count);
+  compact.y.reserve(count);
+  compact.depth.reserve(count);
+  compact.clearance.reserve(count);
+  compact.surfaceZ.reserve(count);
+  compact.surfaceProjected.reserve(count);
+  compact.pathStarts.reserve(paths.size() + 1);
+  compact.pathLengths.reserve(paths.size());
+  compact.pathClosed.reserve(paths.size());
+
+  for (const auto& path : paths) {
+    compact.pathStarts.push_back(static_cast<uint32_t>(compact.x.size()));
+    compact.pathLengths.push_back(path.totalLength);
+    compact.pathClosed.push_back(path.isClosed ? 1 : 0);
+    for (const auto& point : path.points) {
+      compact.x.push_back(static_cast<float>(point.position.x - compact.origin.x));
+      compact.y.push_back(static_cast<float>(point.position.y - compact.origin.y));
+      compact.depth.push_back(static_cast<float>(point.depth));
+      compact.clearance.push_back(static_cast<float>(point.clearanceRadius));
+      compact.surfaceZ.push_back(static_cast<float>(point.surfaceZ));
+      compact.surfaceProjected.push_back(point.surfaceProjected ? 1 : 0);
+    }
+  }
+  if (!paths.empty()) {
+    compact.pathStarts.push_back(static_cast<uint32_t>(compact.x.size()));
+  }
+  return compact;
+}
+
+void expandVCarvePaths(const CompactVCarvePaths& compact, std::vector<VCarvePath>& paths) {
+  paths.assign(compact.pathCount(), VCarvePath());
+  for (size_t p = 0; p < paths.size(); ++p) {
+    VCarvePath& path = paths[p];
+    path.totalLength = compact.pathLengths[p];
+    path.isClosed = compact.pathClosed[p] != 0;
+    path.points.reserve(compact.pathStarts[p + 1] - compact.pathStarts[p]);
+    for (size_t i = compact.pathStarts[p]; i < compact.pathStarts[p + 1]; ++i) {
+      Point2D position(compact.origin.x + compact.x[i], compact.origin.y + compact.y[i]);
+      path.points.emplace_back(position, compact.depth[i], compact.clearance[i]);
+      path.points.back().surfaceZ = compact.surfaceZ[i];
+      path.points.back().surfaceProjected = compact.surfaceProjected[i] != 0;
+      // The stored length stands; the depth range is rebuilt on the way
+      double depth = compact.depth[i];
+      path.minDepth = i == compact.pathStarts[p] ? depth : std::min(path.minDepth, depth);
+      path.maxDepth = i == compact.pathStarts[p] ? depth : std::max(path.maxDepth, depth);
+    }
+    path.measuredPoints = path.points.size();
+  }
+}
+
+CompactSampledMedialPaths compactSampledMedialPaths(const std::vector<SampledMedialPath>& paths) {
+  CompactSampledMedialPaths compact;
+  size_t count = 0;
+  for (const auto& path : paths) {
+    if (count == 0 && !path.points.empty()) {
+      compact.origin = path.points.front().position;
+    }
+    count += path.points.size();
+  }
+
+  compact.x.reserve(count);
+  compact.y.reserve(count);
+  compact.clearance.reserve(count);
+  compact.pathStarts.reserve(paths.size() + 1);
+  compact.pathLengths.reserve(paths.size());
+
+  for (const auto& path : paths) {
+    compact.pathStarts.push_back(static_cast<uint32_t>(compact.x.size()));
+    compact.pathLengths.push_back(path.totalLength);
+    for (const auto& point : path.points) {
+      compact.x.push_back(static_cast<float>(point.position.x - compact.origin.x));
+      compact.y.push_back(static_cast<float>(point.position.y - compact.origin.y));
+      compact.clearance.push_back(static_cast<float>(point.clearanceRadius));
+    }
+  }
+  if (!paths.empty()) {
+    compact.pathStarts.push_back(static_cast<uint32_t>(compact.x.size()));
+  }
+  return compact;
+}
+
+void expandSampledMedialPaths(const CompactSampledMedialPaths& compact, std::vector<SampledMedialPath>& paths) {
+  paths.assign(compact.pathCount(), SampledMedialPath());
+  for (size_t p = 0; p < paths.size(); ++p) {
+    SampledMedialPath& path = paths[p];
+    path.totalLength = compact.pathLengths[p];
+    path.points.reserve(compact.pathStarts[p + 1] - compact.pathStarts[p]);
+    for (size_t i = compact.pathStarts[p]; i < compact.pathStarts[p + 1]; ++i) {
+      path.points.emplace_back(Point2D(compact.origin.x + compact.x[i], compact.origin.y + compact.y[i]),
+                               compact.clearance[i]);
+    }
+  }
+}
+
+}  // namespace Geometry
+}  // namespace ChipCarving
@@ -0,0 +1,132 @@
+/**
+ * CurveChaining.cpp
+ *
+ * Spatial-hash endpoint matching for profile curve chaining
+ */
+
+#include "geometry/CurveChaining.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <unordered_map>
+
+namespace ChipCarving {
+namespace Geometry {
+
+namespace {
+
+struct Cell {
+  int64_t x;
+  int64_t y;
+  int64_t z;
+
+  bool operator==(const Cell& other) const {
+    return x == other.x && y == other.y && z == other.z;
+  }
+};
+
+struct CellHash {
+  size_t operator()(const Cell& cell) const {
+    // Large odd multipliers spread neighbouring cells across buckets
+    uint64_t h = static_cast<uint64_t>(cell.x) * 0x9E3779B97F4A7C15ULL;
+    h ^= static_cast<uint64_t>(cell.y) * 0xC2B2AE3D27D4EB4FULL + (h << 6) + (h >> 2);
+    h ^= static_cast<uint64_t>(cell.z) * 0x165667B19E3779F9ULL + (h << 6) + (h >> 2);
+    return static_cast<size_t>(h);
+  }
+};
+
+double squaredDistance(const Point3D& a, const Point3D& b) {
+  double dx = a.x - b.x;
+  double dy = a.y - b.y;
+  double dz = a.z - b.z;
+  return dx * dx + dy * dy + dz * dz;
+}
+
+// Endpoints keyed by cell; entry 2 * curve is the start of curve, 2 * curve + 1 its end
+class EndpointHash {
+ public:
+  EndpointHash(const std::vector<Point3D>& starts, const std::vector<Point3D>& ends, double cellSize)
+      : starts_(starts), ends_(ends), inverseCell_(1.0 / cellSize) {
+    cells_.reserve(starts.size() * 2);
+    for (size_t i = 0; i < starts.size(); ++i) {
+      cells_[cellOf(starts[i])].push_back(2 * i);
+      cells_[cellOf(ends[i])].push_back(2 * i + 1);
+    }
+  }
+
+  // Lowest-index unused curve with an endpoint within tolerance of point, or SIZE_MAX
+  size_t findNext(const Point3D& point, double toleranceSq, const std::vector<bool>& used) const {
+    size_t best = std::numeric_limits<size_t>::max();
+    Cell center = cellOf(point);
+    for (int64_t dx = -1; dx <= 1; ++dx) {
+      for (int64_t dy = -1; dy <= 1; ++dy) {
+        for (int64_t dz = -1; dz <= 1; ++dz) {
+          auto bucket = cells_.find(Cell{center.x + dx, center.y + dy, center.z + dz});
+          if (bucket == cells_.end()) {
+            continue;
+          }
+          for (size_t endpoint : bucket->second) {
+            size_t curve = endpoint / 2;
+            const Point3D& candidate = (endpoint % 2 == 0) ? starts_[curve] : ends_[curve];
+            if (curve < best && !used[curve] && squaredDistance(point, candidate) < toleranceSq) {
+              best = curve;
+            }
+          }
+        }
+      }
+    }
+    return best;
+  }
+
+ private:
+  Cell cellOf(const Point3D& point) const {
+    return Cell{static_cast<int64_t>(std::floor(point.x * inverseCell_)),
+                static_cast<int64_t>(std::floor(point.y * inverseCell_)),
+                static_cast<int64_t>(std::floor(point.z * inverseCell_))};
+  }
+
+  const std::vector<Point3D>& starts_;
+  const std::vector<Point3D>& ends_;
+  double inverseCell_;
+  std::unordered_map<Cell, std::vector<size_t>, CellHash> cells_{};
+};
+
+}  // namespace
+
+std::vector<ChainedCurve> chainCurveEndpoints(const std::vector<Point3D>& starts, const std::vector<Point3D>& ends,
+                                              double tolerance) {
+  std::vector<ChainedCurve> chain;
+  size_t count = std::min(starts.size(), ends.size());
+  if (count == 0) {
+    return chain;
+  }
+
+  // With cells one tolerance wide, any endpoint within tolerance lies in a neighbouring cell
+  EndpointHash hash(starts, ends, tolerance);
+  const double toleranceSq = tolerance * tolerance;
+  std::vector<bool> used(count, false);
+
+  chain.reserve(count);
+  chain.push_back(ChainedCurve{0, false});
+  used[0] = true;
+  Point3D currentEnd = ends[0];
+
+  while (chain.size() < count) {
+    size_t next = hash.findNext(currentEnd, toleranceSq, used);
+    if (next == std::numeric_limits<size_t>::max()) {
+      break;
+    }
+
+    // A curve whose start connects keeps its own direction
+    bool reversed = squaredDistance(currentEnd, starts[next]) >= toleranceSq;
+    chain.push_back(ChainedCurve{next, reversed});
+    used[next] = true;
+    currentEnd = reversed ? starts[next] : ends[next];
+  }
+  return chain;
+}
+
+}  // namespace Geometry
+}  // namespace ChipCarving
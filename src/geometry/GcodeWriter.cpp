@@ -0,0 +1,134 @@
+/**
+ * GcodeWriter.cpp
+ *
+ * Streaming G-code emission with helical arc fitting
+ */
+
+#include "geometry/GcodeWriter.h"
+
+#include <cmath>
+#include <cstdio>
+
+namespace ChipCarving {
+namespace Geometry {
+
+GcodePost gcodePostFromParameters(const Adapters::MedialAxisParameters& params) {
+  GcodePost post;
+  post.safeZ = params.gcodeSafeZ;
+  post.feedRate = params.gcodeFeedRate;
+  post.plungeRate = params.gcodePlungeRate;
+  post.spindleRpm = params.gcodeSpindleRpm;
+  post.arcTolerance = params.gcodeArcTolerance;
+  return post;
+}
+
+GcodeWriter::GcodeWriter(std::ostream& out, const GcodePost& post) : out_(out), post_(post) {}
+
+void GcodeWriter::begin(const std::string& title) {
+  // '(' and ')' would end the comment early on most controllers
+  std::string comment = title;
+  for (char& c : comment) {
+    if (c == '(' || c == ')') {
+      c = '_';
+    }
+  }
+  out_ << "(" << comment << ")\n";
+  out_ << "G21 G90 G17\n";
+  out_ << "G0";
+  writeAxis('Z', post_.safeZ);
+  out_ << "\n";
+  if (post_.spindleRpm > 0) {
+    out_ << "M3 S" << post_.spindleRpm << "\n";
+  }
+}
+
+void GcodeWriter::writePath(const std::vector<Point3D>& points) {
+  if (points.size() < 2) {
+    return;
+  }
+
+  out_ << "G0";
+  writeAxis('X', points[0].x);
+  writeAxis('Y', points[0].y);
+  out_ << "\nG1";
+  writeAxis('Z', points[0].z);
+  writeAxis('F', post_.plungeRate);
+  out_ << "\n";
+
+  // The first cutting move carries the feed; it stays modal for the rest of the path
+  bool withFeed = true;
+  for (const auto& span : fitHelicalArcSpans(points, post_.arcTolerance)) {
+    if (span.isArc) {
+      writeArc(points, span, withFeed);
+      withFeed = false;
+      continue;
+    }
+    for (size_t i = span.first + 1; i <= span.last; ++i) {
+      out_ << "G1";
+      writeAxis('X', points[i].x);
+      writeAxis('Y', points[i].y);
+      writeAxis('Z', points[i].z);
+      if (withFeed) {
+        writeAxis('F', post_.feedRate);
+        withFeed = false;
+      }
+      out_ << "\n";
+      lineCount_++;
+    }
+  }
+
+  out_ << "G0";
+  writeAxis('Z', post_.safeZ);
+  out_ << "\n";
+  pathCount_++;
+}
+
+void GcodeWriter::writePath(const VCarvePath& path) {
+  scratch_.clear();
+  scratch_.reserve(path.points.size());
+  for (const auto& point : path.points) {
+    scratch_.emplace_back(point.position, -point.depth);
+  }
+  writePath(scratch_);
+}
+
+void GcodeWriter::end() {
+  if (post_.spindleRpm > 0) {
+    out_ << "M5\n";
+  }
+  out_ << "M2\n";
+  out_.flush();
+}
+
+void GcodeWriter::writeAxis(char axis, double value) {
+  // Values that round to zero print as 0, never -0
+  if (std::abs(value) < 0.5 * std::pow(10.0, -post_.decimals)) {
+    value = 0.0;
+  }
+  char buffer[48];
+  std::snprintf(buffer, sizeof(buffer), " %c%.*f", axis, post_.decimals, value);
+  out_ << buffer;
+}
+
+void GcodeWriter::writeArc(const std::vector<Point3D>& points, const PolylineSpan& span, bool withFeed) {
+  const Point3D& start = points[span.first];
+  const Point3D& end = points[span.last];
+  HelicalArc arc;
+  helicalArcThrough(start, points[span.mid()], end, arc);
+
+  // I and J are the center offset from the arc start (incremental arc mode)
+  out_ << (arc.counterClockwise ? "G3" : "G2");
+  writeAxis('X', end.x);
+  writeAxis('Y', end.y);
+  writeAxis('Z', end.z);
+  writeAxis('I', arc.center.x - start.x);
+  writeAxis('J', arc.center.y - start.y);
+  if (withFeed) {
+    writeAxis('F', post_.feedRate);
+  }
+  out_ << "\n";
+  arcCount_++;
+}
+
+}  // namespace Geometry
+}  // namespace ChipCarving
@@ -0,0 +1,39 @@
+/**
+ * InteriorMedialAxisFilter.h
+ *
+ * OpenVoronoi's polygon interior and medial axis filters in one pass over the
+ * diagram's edges instead of two. Neither filter reads the valid flags the
+ * other writes, so an edge is kept exactly when both passes would keep it, and
+ * edges outside the polygon (about half the diagram) skip the medial test.
+ * Use the two filters separately when something must see the diagram between
+ * them (clearing offsets trace the whole interior).
+ */
+
+#pragma once
+
+#include <medial_axis_filter.hpp>
+#include <polygon_interior_filter.hpp>
+#include <voronoidiagram.hpp>
+
+namespace ChipCarving {
+namespace Geometry {
+
+class InteriorMedialAxisFilter : public ovd::Filter {
+ public:
+  InteriorMedialAxisFilter(bool interiorSide, double medialThreshold)
+      : interior_(interiorSide), medial_(medialThreshold) {}
+
+  bool operator()(const ovd::HEEdge& e) const override {
+    // VoronoiDiagram::filter() hands its graph to this filter only
+    interior_.set_graph(g);
+    medial_.set_graph(g);
+    return interior_(e) && medial_(e);
+  }
+
+ private:
+  mutable ovd::polygon_interior_filter interior_;
+  mutable ovd::medial_axis_filter medial_;
+};
+
+}  // namespace Geometry
+}  // namespace ChipCarving
@@ -12,20 +12,59 @@
 
 using ChipCarving::Geometry::Leaf;
 using ChipCarving::Geometry::Point2D;
+using ChipCarving::Geometry::ShapeBounds;
+using ChipCarving::Geometry::ShapeEdge;
+
+constexpr double Leaf::CONTAINS_TOLERANCE;
+
+namespace {
+
+// Grow bounds by a minor arc: its end points plus every axis extreme inside its sweep
+void includeArc(ShapeBounds& bounds, const Leaf::ArcParams& arc, const Point2D& start, const Point2D& end) {
+  auto include = [&bounds](const Point2D& p) {
+    bounds.min = Point2D(std::min(bounds.min.x, p.x), std::min(bounds.min.y, p.y));
+    bounds.max = Point2D(std::max(bounds.max.x, p.x), std::max(bounds.max.y, p.y));
+  };
+  include(start);
+  include(end);
+
+  double sweep = std::remainder(arc.endAngle - arc.startAngle, 2 * M_PI);
+  for (int quadrant = 0; quadrant < 4; ++quadrant) {
+    double angle = quadrant * M_PI / 2;
+    double offset = std::remainder(angle - arc.startAngle, 2 * M_PI);
+    if (sweep >= 0 ? (offset >= 0 && offset <= sweep) : (offset <= 0 && offset >= sweep)) {
+      include(Point2D(arc.center.x + arc.radius * std::cos(angle), arc.center.y + arc.radius * std::sin(angle)));
+    }
+  }
+}
 
-std::pair<Point2D, Point2D> Leaf::getArcCenters() const {
-  const Point2D mid = midpoint(focus1_, focus2_);
-  const Point2D perpVec = perpendicular(focus1_, focus2_);
-  const double d_center = getChordCenterToArcCenterDistance();
+}  // namespace
 
-  // Two arc centers: one offset in each direction from chord midpoint
-  Point2D center1(mid.x + d_center * perpVec.x, mid.y + d_center * perpVec.y);
-  Point2D center2(mid.x - d_center * perpVec.x, mid.y - d_center * perpVec.y);
+void Leaf::computeDerivedGeometry() {
+  const double dist = distance(focus1_, focus2_);
+  validGeometry_ = dist >= 1e-9 && dist <= 2 * radius_;
+  if (validGeometry_) {
+    const double halfChord = dist / 2.0;
+    centerDistance_ = std::sqrt(std::max(0.0, radius_ * radius_ - halfChord * halfChord));
+    sagitta_ = radius_ - centerDistance_;
+  }
 
-  return std::make_pair(center1, center2);
+  // Two arc centers: one offset in each direction from chord midpoint
+  const Point2D mid = midpoint(focus1_, focus2_);
+  const Point2D perpVec = perpendicular(focus1_, focus2_);
+  arcCenters_ = std::make_pair(Point2D(mid.x + centerDistance_ * perpVec.x, mid.y + centerDistance_ * perpVec.y),
+                               Point2D(mid.x - centerDistance_ * perpVec.x, mid.y - centerDistance_ * perpVec.y));
+  arcParams_ = computeArcParameters();
+
+  bounds_.min = Point2D(std::min(focus1_.x, focus2_.x), std::min(focus1_.y, focus2_.y));
+  bounds_.max = Point2D(std::max(focus1_.x, focus2_.x), std::max(focus1_.y, focus2_.y));
+  if (validGeometry_) {
+    includeArc(bounds_, arcParams_.first, focus1_, focus2_);
+    includeArc(bounds_, arcParams_.second, focus2_, focus1_);
+  }
 }
 
-std::pair<Leaf::ArcParams, Leaf::ArcParams> Leaf::getArcParameters() const {
+std::pair<Leaf::ArcParams, Leaf::ArcParams> Leaf::computeArcParameters() const {
   if (!isValidGeometry()) {
     // Return degenerate arcs for invalid geometry
     Point2D mid = midpoint(focus1_, focus2_);
@@ -71,120 +110,54 @@ std::pair<Leaf::ArcParams, Leaf::ArcParams> Leaf::getArcParameters() const {
   return std::make_pair(arc1, arc2);
 }
 
-double Leaf::getSagitta() const {
-  const double dist = distance(focus1_, focus2_);
-  if (dist < 1e-9 || dist > 2 * radius_) {
-    return 0.0;
+std::vector<ShapeEdge> Leaf::getBoundaryEdges() const {
+  if (!isValidGeometry()) {
+    return {};
   }
 
-  const double halfChord = dist / 2.0;
-  const double d_center = std::sqrt(std::max(0.0, radius_ * radius_ - halfChord * halfChord));
-  return radius_ - d_center;
-}
-
-bool Leaf::isValidGeometry() const {
-  const double dist = distance(focus1_, focus2_);
-  return dist >= 1e-9 && dist <= 2 * radius_;
+  // Each arc through its midpoint on the shorter way round. This fixes the
+  // issue where some leaf shapes appeared as crescents instead of footballs
+  auto arcParams = getArcParameters();
+  auto midpoint = [](const ArcParams& arc) {
+    double angleDiff = arc.endAngle - arc.startAngle;
+    while (angleDiff > M_PI)
+      angleDiff -= 2 * M_PI;
+    while (angleDiff < -M_PI)
+      angleDiff += 2 * M_PI;
+    double midAngle = arc.startAngle + angleDiff / 2.0;
+    return Point2D(arc.center.x + arc.radius * cos(midAngle), arc.center.y + arc.radius * sin(midAngle));
+  };
+
+  // focus1 -> midpoint1 -> focus2, then focus2 -> midpoint2 -> focus1
+  return {ShapeEdge{focus1_, focus2_, true, midpoint(arcParams.first)},
+          ShapeEdge{focus2_, focus1_, true, midpoint(arcParams.second)}};
 }
 
 void Leaf::drawToSketch(Adapters::ISketch* sketch, Adapters::ILogger* logger) const {
   (void)logger;  // Suppress unused parameter warning
-  if (!sketch || !isValidGeometry()) {
+  std::vector<ShapeEdge> edges = getBoundaryEdges();
+  if (!sketch || edges.empty()) {
     return;
   }
 
-  // Debug logging disabled for performance
-  // if (logger) {
-  //     logger->logDebug("Leaf::drawToSketch called");
-  // }
-
   // First, add the two focus points as sketch points
   int focus1Idx = sketch->addPointToSketch(focus1_.x, focus1_.y);
   int focus2Idx = sketch->addPointToSketch(focus2_.x, focus2_.y);
-
   if (focus1Idx < 0 || focus2Idx < 0) {
-    // Error logging disabled for performance
-    // if (logger) {
-    //     logger->logError("Failed to add focus points to sketch");
-    // }
     return;
   }
 
-  auto arcParams = getArcParameters();
-
-  // For each arc, calculate midpoint and draw using three points
-  const auto& arc1 = arcParams.first;
-  const auto& arc2 = arcParams.second;
-
-  std::vector<int> midpointsToDelete;  // Track midpoints for cleanup
-
-  // Calculate midpoint for first arc - ensure we get the shorter arc
-  // This fixes the issue where some leaf shapes appeared as crescents instead
-  // of footballs
-  double angleDiff1 = arc1.endAngle - arc1.startAngle;
-  while (angleDiff1 > M_PI)
-    angleDiff1 -= 2 * M_PI;
-  while (angleDiff1 < -M_PI)
-    angleDiff1 += 2 * M_PI;
-
-  double midAngle1;
-  if (std::abs(angleDiff1) <= M_PI) {
-    // Normal case: shortest path is direct
-    midAngle1 = arc1.startAngle + angleDiff1 / 2.0;
-  } else {
-    // Wrapping case: go the other way around
-    if (angleDiff1 > 0) {
-      midAngle1 = arc1.startAngle + (angleDiff1 - 2 * M_PI) / 2.0;
-    } else {
-      midAngle1 = arc1.startAngle + (angleDiff1 + 2 * M_PI) / 2.0;
-    }
-  }
-
-  double midX1 = arc1.center.x + arc1.radius * cos(midAngle1);
-  double midY1 = arc1.center.y + arc1.radius * sin(midAngle1);
-  int mid1Idx = sketch->addPointToSketch(midX1, midY1);
-
-  // Calculate midpoint for second arc - ensure we get the shorter arc
-  double angleDiff2 = arc2.endAngle - arc2.startAngle;
-  while (angleDiff2 > M_PI)
-    angleDiff2 -= 2 * M_PI;
-  while (angleDiff2 < -M_PI)
-    angleDiff2 += 2 * M_PI;
-
-  double midAngle2;
-  if (std::abs(angleDiff2) <= M_PI) {
-    // Normal case: shortest path is direct
-    midAngle2 = arc2.startAngle + angleDiff2 / 2.0;
-  } else {
-    // Wrapping case: go the other way around
-    if (angleDiff2 > 0) {
-      midAngle2 = arc2.startAngle + (angleDiff2 - 2 * M_PI) / 2.0;
-    } else {
-      midAngle2 = arc2.startAngle + (angleDiff2 + 2 * M_PI) / 2.0;
-    }
-  }
-
-  double midX2 = arc2.center.x + arc2.radius * cos(midAngle2);
-  double midY2 = arc2.center.y + arc2.radius * sin(midAngle2);
-  int mid2Idx = sketch->addPointToSketch(midX2, midY2);
-
+  int mid1Idx = sketch->addPointToSketch(edges[0].mid.x, edges[0].mid.y);
+  int mid2Idx = sketch->addPointToSketch(edges[1].mid.x, edges[1].mid.y);
   if (mid1Idx < 0 || mid2Idx < 0) {
-    // Error logging disabled for performance
-    // if (logger) {
-    //     logger->logError("Failed to add arc midpoints to sketch");
-    // }
     return;
   }
 
-  // Draw first arc: focus1 -> midpoint1 -> focus2
-  bool arc1Created = sketch->addArcByThreePointsToSketch(focus1Idx, mid1Idx, focus2Idx);
-  if (arc1Created) {
+  std::vector<int> midpointsToDelete;  // Track midpoints for cleanup
+  if (sketch->addArcByThreePointsToSketch(focus1Idx, mid1Idx, focus2Idx)) {
     midpointsToDelete.push_back(mid1Idx);
   }
-
-  // Draw second arc: focus2 -> midpoint2 -> focus1
-  bool arc2Created = sketch->addArcByThreePointsToSketch(focus2Idx, mid2Idx, focus1Idx);
-  if (arc2Created) {
+  if (sketch->addArcByThreePointsToSketch(focus2Idx, mid2Idx, focus1Idx)) {
     midpointsToDelete.push_back(mid2Idx);
   }
 
@@ -196,15 +169,22 @@ void Leaf::drawToSketch(Adapters::ISketch* sketch, Adapters::ILogger* logger) co
 }
 
 bool Leaf::contains(const Point2D& point) const {
-  if (!isValidGeometry()) {
+  if (!validGeometry_) {
+    return false;
+  }
+
+  // Reject points outside the lens box before any distance is taken; most
+  // points of bulk queries end here
+  if (!bounds_.contains(point, CONTAINS_TOLERANCE)) {
     return false;
   }
 
-  // Point is inside vesica piscis if it's inside BOTH circles
-  double dist1 = distance(point, focus1_);
-  double dist2 = distance(point, focus2_);
+  // The drawn lens is the intersection of the two arc circles; its tips are
+  // the foci, which lie on both circles
+  double dist1 = distance(point, arcCenters_.first);
+  double dist2 = distance(point, arcCenters_.second);
 
-  return (dist1 <= radius_) && (dist2 <= radius_);
+  return (dist1 <= radius_ + CONTAINS_TOLERANCE) && (dist2 <= radius_ + CONTAINS_TOLERANCE);
 }
 
 Point2D Leaf::getCentroid() const {
@@ -212,16 +192,6 @@ Point2D Leaf::getCentroid() const {
   return midpoint(focus1_, focus2_);
 }
 
-double Leaf::getChordCenterToArcCenterDistance() const {
-  const double dist = distance(focus1_, focus2_);
-  if (dist < 1e-9 || dist > 2 * radius_) {
-    return 0.0;
-  }
-
-  const double halfChord = dist / 2.0;
-  return std::sqrt(std::max(0.0, radius_ * radius_ - halfChord * halfChord));
-}
-
 // NOTE: Polygon vertices are now extracted directly from Fusion geometry using
 // strokes This method has been removed because it incorrectly used original
 // shape parameters instead of actual Fusion geometry. The polygonization is now
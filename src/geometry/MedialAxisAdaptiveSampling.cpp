@@ -0,0 +1,82 @@
+/**
+ * MedialAxisAdaptiveSampling.cpp
+ *
+ * Error-driven medial axis sampling: samples are kept only where linear
+ * interpolation of position and V-carve depth would miss the chain by more
+ * than a chord tolerance.
+ * Split from MedialAxisUtilities.cpp for maintainability
+ */
+
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+#include "geometry/MedialAxisUtilities.h"
+#include "geometry/PolylineSimplifier.h"
+
+namespace ChipCarving {
+namespace Geometry {
+
+void sampleMedialAxisChainsAdaptive(const MedialAxisChains& chains, double unitScale,
+                                    const AdaptiveSamplingOptions& options,
+                                    std::vector<SampledMedialPath>& sampledPaths) {
+  sampledPaths.reserve(sampledPaths.size() + chains.size());
+
+  PolylineSimplifier simplifier;
+  std::vector<Point3D> points;
+  std::vector<bool> keep;
+  for (size_t c = 0; c < chains.size(); ++c) {
+    auto chain = chains[c];
+    if (chain.empty()) {
+      continue;
+    }
+
+    // Chain vertices in output units, lifted to 3D by their V-carve depth
+    points.clear();
+    points.reserve(chain.size());
+    for (size_t i = 0; i < chain.size(); ++i) {
+      double depth = chain.clearance(i) * unitScale * options.depthPerClearance;
+      if (options.maxDepth > 0.0) {
+        depth = std::min(depth, options.maxDepth);
+      }
+      points.emplace_back(chain[i].x * unitScale, chain[i].y * unitScale, depth);
+    }
+
+    sampledPaths.emplace_back();
+    SampledMedialPath& sampledPath = sampledPaths.back();
+    sampledPath.chain = static_cast<int>(c);
+    for (size_t i = 1; i < points.size(); ++i) {
+      sampledPath.totalLength += std::hypot(points[i].x - points[i - 1].x, points[i].y - points[i - 1].y);
+    }
+
+    simplifier.markRequired(points, options.chordTolerance, keep);
+
+    size_t previous = 0;
+    sampledPath.points.emplace_back(Point2D(points[0].x, points[0].y), chain.clearance(0) * unitScale);
+    for (size_t i = 1; i < points.size(); ++i) {
+      if (!keep[i]) {
+        continue;
+      }
+
+      // Split long chords evenly so no gap exceeds the spacing cap
+      double chordLength = std::hypot(points[i].x - points[previous].x, points[i].y - points[previous].y);
+      int pieces = 1;
+      if (options.maxSpacing > 0.0 && chordLength > options.maxSpacing) {
+        pieces = static_cast<int>(std::ceil(chordLength / options.maxSpacing));
+      }
+      double startClearance = chain.clearance(previous) * unitScale;
+      double endClearance = chain.clearance(i) * unitScale;
+      for (int piece = 1; piece < pieces; ++piece) {
+        double t = static_cast<double>(piece) / pieces;
+        sampledPath.points.emplace_back(Point2D(points[previous].x + t * (points[i].x - points[previous].x),
+                                                points[previous].y + t * (points[i].y - points[previous].y)),
+                                        startClearance + t * (endClearance - startClearance));
+      }
+      sampledPath.points.emplace_back(Point2D(points[i].x, points[i].y), endClearance);
+      previous = i;
+    }
+  }
+}
+
+}  // namespace Geometry
+}  // namespace ChipCarving
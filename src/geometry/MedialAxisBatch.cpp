@@ -0,0 +1,239 @@
+/**
+ * MedialAxisBatch.cpp
+ *
+ * Worker-pool medial axis computation for independent profile polygons
+ */
+
+#include "geometry/MedialAxisBatch.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <exception>
+#include <memory>
+#include <string>
+#include <thread>
+#include <unordered_map>
+
+#include "geometry/CanonicalShape.h"
+#include "geometry/MedialAxisEngine.h"
+#include "utils/TaskScheduler.h"
+#include "utils/TraceSpan.h"
+#include "utils/logging.h"
+
+namespace ChipCarving {
+namespace Geometry {
+
+namespace {
+
+const std::vector<std::vector<Point2D>> NO_HOLES;
+constexpr double SAME_SCALE_TOLERANCE = 1e-9;  // Relative scale difference of copies that share clearing offsets
+
+// The processor's standard engines without the analytic one (batches get no source shapes); exceptions become
+// failed results
+MedialAxisResults computeUntimed(MedialAxisProcessor& processor, const std::vector<Point2D>& polygon,
+                                 const std::vector<std::vector<Point2D>>& holes) {
+  try {
+    MedialAxisEngineSet engines = MedialAxisEngineSet::standard(processor, false);
+    MedialAxisProfile profile;
+    profile.polygon = &polygon;
+    profile.holes = &holes;
+    MedialAxisResults results;
+    engines.compute(profile, results);
+    return results;
+  } catch (const std::exception& e) {
+    MedialAxisResults failed;
+    failed.errorMessage = "Exception during medial axis processing: " + std::string(e.what());
+    return failed;
+  } catch (...) {
+    MedialAxisResults failed;
+    failed.errorMessage = "Unknown exception during medial axis processing";
+    return failed;
+  }
+}
+
+// computeMedialAxisProfile with progress reporting; polygons are skipped once the job is cancelled
+MedialAxisResults computeTracked(MedialAxisProcessor& processor, const std::vector<Point2D>& polygon,
+                                 const std::vector<std::vector<Point2D>>& holes, Utils::JobProgress* progress) {
+  if (!progress) {
+    return computeMedialAxisProfile(processor, polygon, holes);
+  }
+  if (progress->isCancelled()) {
+    MedialAxisResults cancelled;
+    cancelled.errorMessage = "Cancelled";
+    return cancelled;
+  }
+
+  MedialAxisResults results = computeMedialAxisProfile(processor, polygon, holes);
+  progress->advance();
+  return results;
+}
+
+// Measured time per cost unit and the slowest task, for refitting estimateMedialAxisCost()
+void logCostCalibration(const std::vector<Utils::TaskScheduler::TaskTiming>& timings, int workers) {
+  size_t subtasks = 0;
+  double longest = 0.0;
+  for (const auto& timing : timings) {
+    subtasks += timing.spawned ? 1 : 0;
+    longest = std::max(longest, timing.seconds);
+  }
+  LOG_INFO("Medial axis batch: " << timings.size() - subtasks << " polygons and " << subtasks << " tiles on "
+                                 << workers << " workers, "
+                                 << Utils::TaskScheduler::fitSecondsPerCost(timings) * 1.0e9
+                                 << " ns per cost unit, longest task " << longest * 1000.0 << " ms");
+}
+
+}  // namespace
+
+double estimateMedialAxisCost(size_t vertexCount) {
+  double n = static_cast<double>(std::max<size_t>(vertexCount, 2));
+  return n * std::log2(n);
+}
+
+MedialAxisResults computeMedialAxisProfile(MedialAxisProcessor& processor, const std::vector<Point2D>& polygon,
+                                           const std::vector<std::vector<Point2D>>& holes) {
+  Utils::TraceSpan span("medialAxisProfile");
+  auto start = std::chrono::steady_clock::now();
+  MedialAxisResults results = computeUntimed(processor, polygon, holes);
+  results.computeMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+  return results;
+}
+
+int resolveMedialAxisWorkerCount(int requestedWorkers, size_t jobCount) {
+  if (jobCount == 0) {
+    return 1;
+  }
+
+  int workers = requestedWorkers;
+  if (workers <= 0) {
+    workers = static_cast<int>(std::thread::hardware_concurrency());
+    if (workers <= 0) {
+      workers = 1;  // hardware_concurrency() may return 0 when unknown
+    }
+  }
+
+  return std::max(1, std::min(workers, static_cast<int>(jobCount)));
+}
+
+std::vector<MedialAxisResults> computeMedialAxisBatch(const std::vector<std::vector<Point2D>>& polygons,
+                                                      const MedialAxisProcessor& prototype, int requestedWorkers,
+                                                      Utils::JobProgress* progress,
+                                                      const std::vector<std::vector<std::vector<Point2D>>>* holes) {
+  auto holesOf = [holes](size_t i) -> const std::vector<std::vector<Point2D>>& {
+    return holes && i < holes->size() ? (*holes)[i] : NO_HOLES;
+  };
+  std::vector<MedialAxisResults> results(polygons.size());
+  int workers = resolveMedialAxisWorkerCount(requestedWorkers, polygons.size());
+
+  if (workers == 1) {
+    // Sequential mode keeps the original behavior, including console logging
+    MedialAxisProcessor processor(prototype);
+    for (size_t i = 0; i < polygons.size(); ++i) {
+      results[i] = computeTracked(processor, polygons[i], holesOf(i), progress);
+    }
+    return results;
+  }
+
+  // Largest polygons first; results land in their input slot so output order is deterministic
+  Utils::TaskScheduler scheduler(workers);
+  std::vector<std::unique_ptr<MedialAxisProcessor>> processors(static_cast<size_t>(workers));
+  for (size_t i = 0; i < polygons.size(); ++i) {
+    size_t vertexCount = polygons[i].size();
+    for (const auto& hole : holesOf(i)) {
+      vertexCount += hole.size();
+    }
+    scheduler.submit(estimateMedialAxisCost(vertexCount), [&, i]() {
+      // Created on first use by its worker; a waiting task only runs its own tiles, never another polygon
+      std::unique_ptr<MedialAxisProcessor>& processor = processors[Utils::TaskScheduler::currentWorkerIndex()];
+      if (!processor) {
+        processor = std::make_unique<MedialAxisProcessor>(prototype);
+        processor->setVerbose(false);
+      }
+      results[i] = computeTracked(*processor, polygons[i], holesOf(i), progress);
+    });
+  }
+  scheduler.run();
+  logCostCalibration(scheduler.timings(), workers);
+
+  return results;
+}
+
+std::vector<MedialAxisResults> computeDeduplicatedMedialAxisBatch(
+    const std::vector<std::vector<Point2D>>& polygons, const MedialAxisProcessor& prototype, int requestedWorkers,
+    Utils::JobProgress* progress, const std::vector<std::vector<std::vector<Point2D>>>* holes, size_t* sharedCount) {
+  // Group copies of one outline; the key only narrows the vertex-by-vertex comparison
+  std::vector<CanonicalShape> shapes(polygons.size());
+  std::vector<std::vector<size_t>> groups;
+  std::unordered_map<uint64_t, std::vector<size_t>> groupsByKey;
+  for (size_t i = 0; i < polygons.size(); ++i) {
+    bool hasHoles = holes && i < holes->size() && !(*holes)[i].empty();
+    if (hasHoles || !canonicalizeShape(polygons[i], shapes[i])) {
+      groups.push_back({i});
+      continue;
+    }
+    std::vector<size_t>& candidates = groupsByKey[shapes[i].key];
+    auto match = std::find_if(candidates.begin(), candidates.end(),
+                              [&](size_t g) { return sameCanonicalShape(shapes[groups[g][0]], shapes[i]); });
+    if (match == candidates.end()) {
+      candidates.push_back(groups.size());
+      groups.push_back({i});
+    } else {
+      groups[*match].push_back(i);
+    }
+  }
+
+  // The largest copy is computed, so mapped results are never coarser than a direct computation
+  std::vector<std::vector<Point2D>> sourcePolygons;
+  std::vector<std::vector<std::vector<Point2D>>> sourceHoles;
+  for (auto& group : groups) {
+    std::iter_swap(group.begin(), std::max_element(group.begin(), group.end(), [&shapes](size_t a, size_t b) {
+                     return shapes[a].scale < shapes[b].scale;
+                   }));
+    sourcePolygons.push_back(polygons[group[0]]);
+    sourceHoles.push_back(holes && group[0] < holes->size() ? (*holes)[group[0]] : NO_HOLES);
+  }
+  std::vector<MedialAxisResults> sourceResults =
+      computeMedialAxisBatch(sourcePolygons, prototype, requestedWorkers, progress, &sourceHoles);
+
+  std::vector<MedialAxisResults> results(polygons.size());
+  std::vector<size_t> retryIndices;
+  size_t shared = 0;
+  for (size_t g = 0; g < groups.size(); ++g) {
+    const std::vector<size_t>& group = groups[g];
+    for (size_t k = 1; k < group.size(); ++k) {
+      // Clearing offsets lie at fixed distances from the boundary, so a resized copy computes its own
+      bool resized = std::abs(shapes[group[k]].scale / shapes[group[0]].scale - 1.0) > SAME_SCALE_TOLERANCE;
+      if (!sourceResults[g].success || (resized && prototype.getClearingOffsets().enabled())) {
+        retryIndices.push_back(group[k]);
+        continue;
+      }
+      results[group[k]] = transformMedialAxis(sourceResults[g], shapes[group[0]], shapes[group[k]]);
+      ++shared;
+      if (progress) {
+        progress->advance();
+      }
+    }
+    results[group[0]] = std::move(sourceResults[g]);
+  }
+
+  // A failed computation may still succeed on a copy with different rounding; resized copies go here too
+  if (!retryIndices.empty()) {
+    std::vector<std::vector<Point2D>> retryPolygons;
+    for (size_t i : retryIndices) {
+      retryPolygons.push_back(polygons[i]);
+    }
+    std::vector<MedialAxisResults> retried =
+        computeMedialAxisBatch(retryPolygons, prototype, requestedWorkers, progress);
+    for (size_t k = 0; k < retryIndices.size(); ++k) {
+      results[retryIndices[k]] = std::move(retried[k]);
+    }
+  }
+
+  if (sharedCount) {
+    *sharedCount = shared;
+  }
+  return results;
+}
+
+}  // namespace Geometry
+}  // namespace ChipCarving
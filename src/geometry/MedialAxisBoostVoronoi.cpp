@@ -0,0 +1,337 @@
+/**
+ * MedialAxisBoostVoronoi.cpp
+ *
+ * Boost.Polygon segment Voronoi medial axis engine
+ */
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <vector>
+
+#include <boost/polygon/point_data.hpp>
+#include <boost/polygon/segment_data.hpp>
+#include <boost/polygon/voronoi.hpp>
+
+#include "geometry/MedialAxisEngine.h"
+#include "utils/TraceSpan.h"
+
+namespace ChipCarving {
+namespace Geometry {
+
+namespace {
+
+namespace bp = boost::polygon;
+
+using GridPoint = bp::point_data<int32_t>;
+using GridSegment = bp::segment_data<int32_t>;
+using VoronoiDiagram = bp::voronoi_diagram<double>;
+using VoronoiEdge = VoronoiDiagram::edge_type;
+using VoronoiCell = VoronoiDiagram::cell_type;
+using VoronoiVertex = VoronoiDiagram::vertex_type;
+
+constexpr double GRID_SCALE = 1073741824.0;  // 2^30 grid steps per unit; |x| < 0.43 * 2^30
+constexpr std::size_t KEPT = 1;              // Edge colors
+constexpr std::size_t WALKED = 2;
+
+struct Direction {
+  double x = 0.0;
+  double y = 0.0;
+};
+
+Direction unitDirection(double x, double y) {
+  double length = std::hypot(x, y);
+  return length > 0 ? Direction{x / length, y / length} : Direction{};
+}
+
+/**
+ * All loops snapped to the grid, outer loop counter-clockwise and holes
+ * clockwise so the interior is left of every edge. Edge k runs from vertex k
+ * to next(k), and is input segment k of the diagram.
+ */
+class GridLoops {
+ public:
+  bool build(const MedialAxisProfile& profile, const TransformParams& transform) {
+    size_t loopCount = 1 + (profile.holes ? profile.holes->size() : 0);
+    double gridScale = transform.scale * GRID_SCALE;
+    for (size_t loop = 0; loop < loopCount; ++loop) {
+      const std::vector<Point2D>& vertices = loop == 0 ? *profile.polygon : (*profile.holes)[loop - 1];
+      size_t start = points_.size();
+      for (const auto& vertex : vertices) {
+        GridPoint point(static_cast<int32_t>(std::lround((vertex.x - transform.offset.x) * gridScale)),
+                        static_cast<int32_t>(std::lround((vertex.y - transform.offset.y) * gridScale)));
+        // Snapping can merge neighbours; the closing duplicate goes too
+        if (points_.size() == start || points_.back() != point) {
+          points_.push_back(point);
+        }
+      }
+      if (points_.size() > start + 1 && points_.back() == points_[start]) {
+        points_.pop_back();
+      }
+      if (points_.size() < start + 3) {
+        return false;
+      }
+      double area = 0.0;
+      for (size_t i = start; i < points_.size(); ++i) {
+        const GridPoint& a = points_[i];
+        const GridPoint& b = points_[i + 1 == points_.size() ? start : i + 1];
+        area += static_cast<double>(a.x()) * b.y() - static_cast<double>(b.x()) * a.y();
+      }
+      if (area == 0.0) {
+        return false;
+      }
+      if ((loop == 0) != (area > 0.0)) {
+        std::reverse(points_.begin() + static_cast<std::ptrdiff_t>(start), points_.end());
+      }
+      starts_.push_back(start);
+    }
+    starts_.push_back(points_.size());
+
+    loopOf_.resize(points_.size());
+    for (size_t loop = 0; loop + 1 < starts_.size(); ++loop) {
+      std::fill(loopOf_.begin() + static_cast<std::ptrdiff_t>(starts_[loop]),
+                loopOf_.begin() + static_cast<std::ptrdiff_t>(starts_[loop + 1]), loop);
+    }
+    segments_.reserve(points_.size());
+    reflex_.resize(points_.size());
+    tangents_.resize(points_.size());
+    for (size_t k = 0; k < points_.size(); ++k) {
+      segments_.emplace_back(points_[k], points_[next(k)]);
+      Direction in = edgeDirection(previous(k));
+      Direction out = edgeDirection(k);
+      reflex_[k] = in.x * out.y - in.y * out.x < 0.0;
+      tangents_[k] = unitDirection(in.x + out.x, in.y + out.y);
+    }
+    return true;
+  }
+
+  const std::vector<GridSegment>& segments() const {
+    return segments_;
+  }
+  const GridPoint& point(size_t k) const {
+    return points_[k];
+  }
+
+  size_t next(size_t k) const {
+    return k + 1 == starts_[loopOf_[k] + 1] ? starts_[loopOf_[k]] : k + 1;
+  }
+  size_t previous(size_t k) const {
+    return k == starts_[loopOf_[k]] ? starts_[loopOf_[k] + 1] - 1 : k - 1;
+  }
+
+  Direction edgeDirection(size_t k) const {
+    const GridPoint& a = points_[k];
+    const GridPoint& b = points_[next(k)];
+    return unitDirection(static_cast<double>(b.x()) - a.x(), static_cast<double>(b.y()) - a.y());
+  }
+
+  // Boundary vertex a point cell was built for
+  size_t cellVertex(const VoronoiCell& cell) const {
+    size_t k = cell.source_index();
+    return cell.source_category() == bp::SOURCE_CATEGORY_SEGMENT_END_POINT ? next(k) : k;
+  }
+
+  // Direction of the boundary at a cell's site: its edge, or the tangent at its vertex
+  Direction cellDirection(const VoronoiCell& cell) const {
+    return cell.contains_segment() ? edgeDirection(cell.source_index()) : tangents_[cellVertex(cell)];
+  }
+
+  /**
+   * Whether a finite edge lies inside the polygon. A point cell sits on the
+   * inside exactly when its vertex is reflex; a segment cell's edges lie on
+   * one side of the segment, so the side of the edge's chord midpoint decides.
+   */
+  bool inside(const VoronoiEdge& edge) const {
+    const VoronoiCell& cell = *edge.cell();
+    if (cell.contains_point()) {
+      return reflex_[cellVertex(cell)];
+    }
+    const GridPoint& a = points_[cell.source_index()];
+    const GridPoint& b = points_[next(cell.source_index())];
+    double mx = (edge.vertex0()->x() + edge.vertex1()->x()) / 2.0 - a.x();
+    double my = (edge.vertex0()->y() + edge.vertex1()->y()) / 2.0 - a.y();
+    return (static_cast<double>(b.x()) - a.x()) * my - (static_cast<double>(b.y()) - a.y()) * mx > 0.0;
+  }
+
+  // Distance from a grid position to the site of a cell
+  double clearance(const VoronoiCell& cell, double x, double y) const {
+    if (cell.contains_point()) {
+      const GridPoint& p = points_[cellVertex(cell)];
+      return std::hypot(x - p.x(), y - p.y());
+    }
+    const GridPoint& a = points_[cell.source_index()];
+    const GridPoint& b = points_[next(cell.source_index())];
+    double dx = static_cast<double>(b.x()) - a.x();
+    double dy = static_cast<double>(b.y()) - a.y();
+    double t = std::max(0.0, std::min(1.0, ((x - a.x()) * dx + (y - a.y()) * dy) / (dx * dx + dy * dy)));
+    return std::hypot(x - (a.x() + t * dx), y - (a.y() + t * dy));
+  }
+
+ private:
+  std::vector<GridPoint> points_{};
+  std::vector<size_t> starts_{};
+  std::vector<size_t> loopOf_{};
+  std::vector<GridSegment> segments_{};
+  std::vector<bool> reflex_{};
+  std::vector<Direction> tangents_{};
+};
+
+// Same test as OpenVoronoi's medial_axis_filter: a bisector of nearly parallel boundary runs is not medial
+bool medial(const VoronoiEdge& edge, const GridLoops& loops, double threshold) {
+  Direction a = loops.cellDirection(*edge.cell());
+  Direction b = loops.cellDirection(*edge.twin()->cell());
+  return a.x * b.x + a.y * b.y <= threshold;
+}
+
+size_t keptDegree(const VoronoiVertex& vertex) {
+  size_t degree = 0;
+  const VoronoiEdge* edge = vertex.incident_edge();
+  do {
+    degree += edge->color() & KEPT ? 1 : 0;
+    edge = edge->rot_next();
+  } while (edge != vertex.incident_edge());
+  return degree;
+}
+
+class ChainWriter {
+ public:
+  ChainWriter(const GridLoops& loops, const TransformParams& transform, int curvedPoints, MedialAxisResults& results)
+      : loops_(loops), transform_(transform), curvedPoints_(curvedPoints), results_(results) {}
+
+  // Walk kept edges from start until a vertex that is not a plain chain vertex
+  void walk(const VoronoiEdge* start) {
+    results_.chains.beginChain();
+    ++results_.numChains;
+    add(*start->cell(), start->vertex0()->x(), start->vertex0()->y());
+    const VoronoiEdge* edge = start;
+    while (edge && !(edge->color() & WALKED)) {
+      edge->color(edge->color() | WALKED);
+      edge->twin()->color(edge->twin()->color() | WALKED);
+      addEdge(*edge);
+      const VoronoiVertex& end = *edge->vertex1();
+      edge = keptDegree(end) == 2 ? otherKeptEdge(end, edge->twin()) : nullptr;
+    }
+  }
+
+ private:
+  // Points after the first on edge, sampling parabolic arcs between a point and a segment site
+  void addEdge(const VoronoiEdge& edge) {
+    const VoronoiCell& cell = *edge.cell();
+    if (edge.is_curved() && curvedPoints_ > 0) {
+      const VoronoiCell& segmentCell = cell.contains_segment() ? cell : *edge.twin()->cell();
+      const VoronoiCell& pointCell = cell.contains_segment() ? *edge.twin()->cell() : cell;
+      const GridPoint& a = loops_.point(segmentCell.source_index());
+      Direction along = loops_.edgeDirection(segmentCell.source_index());
+      const GridPoint& focus = loops_.point(loops_.cellVertex(pointCell));
+      double focusU = (focus.x() - a.x()) * along.x + (focus.y() - a.y()) * along.y;
+      double focusV = -(focus.x() - a.x()) * along.y + (focus.y() - a.y()) * along.x;
+      double u0 = (edge.vertex0()->x() - a.x()) * along.x + (edge.vertex0()->y() - a.y()) * along.y;
+      double u1 = (edge.vertex1()->x() - a.x()) * along.x + (edge.vertex1()->y() - a.y()) * along.y;
+      for (int i = 1; i <= curvedPoints_; ++i) {
+        double u = u0 + (u1 - u0) * i / (curvedPoints_ + 1);
+        double v = ((u - focusU) * (u - focusU) + focusV * focusV) / (2.0 * focusV);
+        add(cell, a.x() + u * along.x - v * along.y, a.y() + u * along.y + v * along.x);
+      }
+    }
+    add(cell, edge.vertex1()->x(), edge.vertex1()->y());
+  }
+
+  void add(const VoronoiCell& cell, double x, double y) {
+    double toWorld = 1.0 / (GRID_SCALE * transform_.scale);
+    Point2D point(x * toWorld + transform_.offset.x, y * toWorld + transform_.offset.y);
+    double clearance = loops_.clearance(cell, x, y) * toWorld;
+    if (!results_.chains.back().empty()) {
+      results_.totalLength += distance(previous_, point);
+    }
+    results_.chains.addPoint(point, clearance);
+    results_.totalPoints++;
+    results_.minClearance = std::min(results_.minClearance, clearance);
+    results_.maxClearance = std::max(results_.maxClearance, clearance);
+    previous_ = point;
+  }
+
+  static const VoronoiEdge* otherKeptEdge(const VoronoiVertex& vertex, const VoronoiEdge* arrival) {
+    const VoronoiEdge* edge = vertex.incident_edge();
+    do {
+      if (edge != arrival && (edge->color() & KEPT)) {
+        return edge;
+      }
+      edge = edge->rot_next();
+    } while (edge != vertex.incident_edge());
+    return nullptr;
+  }
+
+  const GridLoops& loops_;
+  const TransformParams& transform_;
+  int curvedPoints_;
+  MedialAxisResults& results_;
+  Point2D previous_{};
+};
+
+}  // namespace
+
+bool BoostVoronoiMedialAxisEngine::accepts(const MedialAxisProfile& profile) const {
+  return profile.polygon && profile.polygon->size() >= 3;
+}
+
+bool BoostVoronoiMedialAxisEngine::compute(const MedialAxisProfile& profile, MedialAxisResults& results) {
+  Utils::TraceSpan span("boostVoronoi");
+  results = MedialAxisResults();
+
+  TransformParams& transform = results.transform;
+  fitUnitCircleTransform(*profile.polygon, transform);
+
+  GridLoops loops;
+  if (!loops.build(profile, transform)) {
+    results.errorMessage = "Polygon collapses on the Boost.Polygon integer grid";
+    return false;
+  }
+
+  VoronoiDiagram diagram;
+  bp::construct_voronoi(loops.segments().begin(), loops.segments().end(), &diagram);
+  Utils::traceCount("voronoiSegmentsInserted", static_cast<double>(loops.segments().size()));
+
+  // Keep the interior medial edges, both halves of each
+  double threshold = processor_.getMedialThreshold();
+  for (const auto& edge : diagram.edges()) {
+    if (&edge < edge.twin() && edge.is_primary() && edge.is_finite() && loops.inside(edge) &&
+        loops.inside(*edge.twin()) && medial(edge, loops, threshold)) {
+      edge.color(KEPT);
+      edge.twin()->color(KEPT);
+    }
+  }
+
+  // Chains run between vertices that are not plain chain vertices, then round closed loops
+  results.minClearance = std::numeric_limits<double>::max();
+  ChainWriter writer(loops, transform, processor_.getMedialAxisWalkPoints(), results);
+  for (const auto& vertex : diagram.vertices()) {
+    if (keptDegree(vertex) == 2) {
+      continue;
+    }
+    const VoronoiEdge* edge = vertex.incident_edge();
+    do {
+      if (edge->color() == KEPT) {
+        writer.walk(edge);
+      }
+      edge = edge->rot_next();
+    } while (edge != vertex.incident_edge());
+  }
+  for (const auto& edge : diagram.edges()) {
+    if (edge.color() == KEPT) {
+      writer.walk(&edge);
+    }
+  }
+
+  if (results.chains.empty()) {
+    results.errorMessage = "Boost.Polygon Voronoi diagram has no interior medial edges";
+    return false;
+  }
+  results.graph = MedialAxisGraph::fromChains(results.chains);
+  results.success = true;
+  pruneMedialAxisSpurs(results, processor_.getSpurPruning());
+  return true;
+}
+
+}  // namespace Geometry
+}  // namespace ChipCarving
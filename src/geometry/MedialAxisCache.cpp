@@ -0,0 +1,144 @@
+/**
+ * MedialAxisCache.cpp
+ *
+ * Content-addressed LRU cache of medial axis results
+ */
+
+#include "geometry/MedialAxisCache.h"
+
+#include <cstring>
+
+namespace ChipCarving {
+namespace Geometry {
+
+namespace {
+
+constexpr uint64_t FNV_OFFSET_BASIS = 14695981039346656037ULL;
+constexpr uint64_t FNV_PRIME = 1099511628211ULL;
+
+void hashBytes(uint64_t& hash, const void* data, size_t size) {
+  const auto* bytes = static_cast<const unsigned char*>(data);
+  for (size_t i = 0; i < size; ++i) {
+    hash ^= bytes[i];
+    hash *= FNV_PRIME;
+  }
+}
+
+void hashDouble(uint64_t& hash, double value) {
+  // -0.0 and 0.0 describe the same geometry
+  if (value == 0.0) {
+    value = 0.0;
+  }
+  uint64_t bits = 0;
+  std::memcpy(&bits, &value, sizeof(bits));
+  hashBytes(hash, &bits, sizeof(bits));
+}
+
+}  // namespace
+
+constexpr size_t MedialAxisCache::DEFAULT_MAX_BYTES;
+
+MedialAxisCache::MedialAxisCache(size_t maxBytes) : maxBytes_(maxBytes) {}
+
+uint64_t MedialAxisCache::computeKey(const std::vector<Point2D>& polygon, const MedialAxisProcessor& processor) {
+  uint64_t hash = FNV_OFFSET_BASIS;
+
+  uint64_t count = polygon.size();
+  hashBytes(hash, &count, sizeof(count));
+  for (const auto& point : polygon) {
+    hashDouble(hash, point.x);
+    hashDouble(hash, point.y);
+  }
+
+  hashDouble(hash, processor.getPolygonTolerance());
+  hashDouble(hash, processor.getMedialThreshold());
+  int32_t walkPoints = processor.getMedialAxisWalkPoints();
+  hashBytes(hash, &walkPoints, sizeof(walkPoints));
+  if (processor.getSpurPruning().enabled()) {
+    hashDouble(hash, processor.getSpurPruning().minLength);
+    hashDouble(hash, processor.getSpurPruning().minClearanceChange);
+  }
+  if (processor.getStraightSkeleton()) {
+    hashBytes(hash, "skeleton", 8);
+  }
+  if (processor.getSymmetryDetection()) {
+    hashBytes(hash, "symmetry", 8);
+  }
+  // Tiled diagrams are stitched, so their axes differ from one diagram's near the tile seams
+  uint64_t partitionMinVertices = processor.getPartitionMinVertices();
+  if (partitionMinVertices > 0) {
+    hashBytes(hash, &partitionMinVertices, sizeof(partitionMinVertices));
+  }
+  if (processor.getClearingOffsets().enabled()) {
+    hashDouble(hash, processor.getClearingOffsets().firstOffset);
+    hashDouble(hash, processor.getClearingOffsets().stepover);
+  }
+
+  return hash;
+}
+
+size_t MedialAxisCache::estimateBytes(const MedialAxisResults& results) {
+  size_t bytes = sizeof(Entry) + results.errorMessage.capacity() + results.chains.capacityBytes() +
+                 results.graph.capacityBytes();
+  for (const auto& loop : results.clearingLoops) {
+    bytes += sizeof(ClearingLoop) + loop.points.capacity() * sizeof(Point2D);
+  }
+  return bytes;
+}
+
+bool MedialAxisCache::lookup(uint64_t key, MedialAxisResults& results) {
+  auto it = index_.find(key);
+  if (it == index_.end()) {
+    misses_++;
+    return false;
+  }
+
+  entries_.splice(entries_.begin(), entries_, it->second);
+  results = it->second->results;
+  hits_++;
+  return true;
+}
+
+void MedialAxisCache::insert(uint64_t key, const MedialAxisResults& results) {
+  auto existing = index_.find(key);
+  if (existing != index_.end()) {
+    bytesUsed_ -= existing->second->bytes;
+    entries_.erase(existing->second);
+    index_.erase(existing);
+  }
+
+  size_t bytes = estimateBytes(results);
+  if (bytes > maxBytes_) {
+    return;
+  }
+
+  evictToFit(bytes);
+  entries_.push_front(Entry{key, results, bytes});
+  index_[key] = entries_.begin();
+  bytesUsed_ += bytes;
+}
+
+void MedialAxisCache::clear() {
+  entries_.clear();
+  index_.clear();
+  bytesUsed_ = 0;
+  hits_ = 0;
+  misses_ = 0;
+}
+
+void MedialAxisCache::setMaxBytes(size_t maxBytes) {
+  maxBytes_ = maxBytes;
+  evictToFit(0);
+}
+
+void MedialAxisCache::evictToFit(size_t incomingBytes) {
+  while (!entries_.empty() && bytesUsed_ + incomingBytes > maxBytes_) {
+    const Entry& oldest = entries_.back();
+    bytesUsed_ -= oldest.bytes;
+    index_.erase(oldest.key);
+    entries_.pop_back();
+  }
+}
+
+}  // namespace Geometry
+}  // namespace ChipCarving
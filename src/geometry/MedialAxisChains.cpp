@@ -0,0 +1,104 @@
+/**
+ * MedialAxisChains.cpp
+ *
+ * Structure-of-arrays storage for medial axis chains
+ */
+
+#include "geometry/MedialAxisChains.h"
+
+#include <utility>
+
+namespace ChipCarving {
+namespace Geometry {
+
+std::vector<Point2D> MedialAxisChains::ChainView::points() const {
+  std::vector<Point2D> result;
+  result.reserve(size_);
+  for (size_t i = 0; i < size_; ++i) {
+    result.emplace_back(x_[i], y_[i]);
+  }
+  return result;
+}
+
+std::vector<double> MedialAxisChains::ChainView::clearances() const {
+  return std::vector<double>(radii_, radii_ + size_);
+}
+
+bool MedialAxisChains::addChain(const std::vector<Point2D>& points, const std::vector<double>& clearances) {
+  if (points.size() != clearances.size()) {
+    return false;
+  }
+
+  for (const auto& point : points) {
+    x_.push_back(point.x);
+    y_.push_back(point.y);
+  }
+  radii_.insert(radii_.end(), clearances.begin(), clearances.end());
+  offsets_.push_back(x_.size());
+  return true;
+}
+
+void MedialAxisChains::beginChain() {
+  offsets_.push_back(x_.size());
+}
+
+void MedialAxisChains::addPoint(const Point2D& point, double clearance) {
+  if (offsets_.size() < 2) {
+    beginChain();
+  }
+  x_.push_back(point.x);
+  y_.push_back(point.y);
+  radii_.push_back(clearance);
+  offsets_.back() = x_.size();
+}
+
+bool MedialAxisChains::assign(std::vector<double> x, std::vector<double> y, std::vector<double> radii,
+                              std::vector<size_t> offsets) {
+  if (x.size() != y.size() || x.size() != radii.size() || offsets.empty() || offsets.front() != 0 ||
+      offsets.back() != x.size()) {
+    return false;
+  }
+  for (size_t i = 1; i < offsets.size(); ++i) {
+    if (offsets[i] < offsets[i - 1]) {
+      return false;
+    }
+  }
+
+  x_ = std::move(x);
+  y_ = std::move(y);
+  radii_ = std::move(radii);
+  offsets_ = std::move(offsets);
+  return true;
+}
+
+void MedialAxisChains::reserve(size_t chainCount, size_t pointCount) {
+  x_.reserve(pointCount);
+  y_.reserve(pointCount);
+  radii_.reserve(pointCount);
+  offsets_.reserve(chainCount + 1);
+}
+
+void MedialAxisChains::clear() {
+  x_.clear();
+  y_.clear();
+  radii_.clear();
+  offsets_.assign(1, 0);
+}
+
+MedialAxisChains MedialAxisChains::fromNested(const std::vector<std::vector<Point2D>>& chains,
+                                              const std::vector<std::vector<double>>& clearances) {
+  MedialAxisChains result;
+  size_t pointCount = 0;
+  for (const auto& chain : chains) {
+    pointCount += chain.size();
+  }
+  result.reserve(chains.size(), pointCount);
+
+  for (size_t i = 0; i < chains.size() && i < clearances.size(); ++i) {
+    result.addChain(chains[i], clearances[i]);
+  }
+  return result;
+}
+
+}  // namespace Geometry
+}  // namespace ChipCarving
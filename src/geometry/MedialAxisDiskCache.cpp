@@ -0,0 +1,323 @@
+/**
+ * MedialAxisDiskCache.cpp
+ *
+ * Persistent on-disk store for medial axis results
+ *
+ * File layout (native byte order, one file per entry):
+ *   FileHeader
+ *   uint32_t chainSizes[numChains]
+ *   double   x[totalPoints]            (all chains, concatenated)
+ *   double   y[totalPoints]            (same order as x)
+ *   double   clearances[totalPoints]   (same order as x)
+ *
+ * The index of shared caches and trim() are in MedialAxisDiskCacheIndex.cpp.
+ */
+
+#include "geometry/MedialAxisDiskCache.h"
+
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <atomic>
+#include <cctype>
+#include <cerrno>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <utility>
+#include <vector>
+
+#include "utils/MappedFile.h"
+
+// OpenVoronoi includes
+#include <version.hpp>
+
+namespace ChipCarving {
+namespace Geometry {
+
+namespace {
+
+constexpr char FILE_MAGIC[4] = {'M', 'A', 'X', 'C'};
+constexpr uint32_t FORMAT_VERSION = 3;
+
+constexpr uint64_t FNV_OFFSET_BASIS = 14695981039346656037ULL;
+constexpr uint64_t FNV_PRIME = 1099511628211ULL;
+
+struct FileHeader {
+  char magic[4];
+  uint32_t formatVersion;
+  uint64_t key;
+  uint64_t engineHash;
+  uint64_t payloadHash;  // FNV-1a of everything after the header
+  uint32_t numChains;
+  uint32_t totalPoints;
+  double totalLength;
+  double minClearance;
+  double maxClearance;
+  double transformOffsetX;
+  double transformOffsetY;
+  double transformScale;
+  double originalMinX;
+  double originalMinY;
+  double originalMaxX;
+  double originalMaxY;
+};
+
+void hashBytes(uint64_t& hash, const void* data, size_t bytes) {
+  const unsigned char* cursor = static_cast<const unsigned char*>(data);
+  for (size_t i = 0; i < bytes; ++i) {
+    hash ^= cursor[i];
+    hash *= FNV_PRIME;
+  }
+}
+
+uint64_t hashString(const std::string& text) {
+  uint64_t hash = FNV_OFFSET_BASIS;
+  hashBytes(hash, text.data(), text.size());
+  return hash;
+}
+
+// Host name reduced to file name characters, naming this machine's temporaries and index file
+std::string machineName() {
+  char host[256] = {};
+  if (::gethostname(host, sizeof(host) - 1) != 0 || host[0] == '\0') {
+    return "seat";
+  }
+  std::string name;
+  for (const char* c = host; *c; ++c) {
+    bool plain = std::isalnum(static_cast<unsigned char>(*c)) || *c == '-' || *c == '_';
+    name.push_back(plain ? *c : '_');
+  }
+  return name;
+}
+
+/**
+ * Publish a complete temporary file under its entry name. link() never replaces
+ * an entry another writer published first; where links are unsupported (some
+ * SMB shares) rename() replaces it with the same content at worst.
+ */
+bool publish(const std::string& tempPath, const std::string& path) {
+  bool published = ::link(tempPath.c_str(), path.c_str()) == 0 || errno == EEXIST ||
+                   std::rename(tempPath.c_str(), path.c_str()) == 0;
+  std::remove(tempPath.c_str());
+  return published;
+}
+
+size_t payloadBytes(uint32_t numChains, uint32_t totalPoints) {
+  return sizeof(FileHeader) + numChains * sizeof(uint32_t) + totalPoints * 3 * sizeof(double);
+}
+
+bool createDirectories(const std::string& directory) {
+  for (size_t pos = 1; pos <= directory.size(); ++pos) {
+    if (pos == directory.size() || directory[pos] == '/') {
+      std::string prefix = directory.substr(0, pos);
+      if (::mkdir(prefix.c_str(), 0755) != 0 && errno != EEXIST) {
+        return false;
+      }
+    }
+  }
+
+  struct stat info {};
+  return ::stat(directory.c_str(), &info) == 0 && S_ISDIR(info.st_mode);
+}
+
+}  // namespace
+
+constexpr double MedialAxisDiskCache::INDEX_REFRESH_SECONDS;
+constexpr long MedialAxisDiskCache::STALE_TEMP_SECONDS;
+
+MedialAxisDiskCache::MedialAxisDiskCache(const std::string& directory, const std::string& engineVersion, bool shared)
+    : directory_(directory),
+      engineHash_(hashString(engineVersion + "/" + std::to_string(FORMAT_VERSION))),
+      shared_(shared) {
+  while (directory_.size() > 1 && directory_.back() == '/') {
+    directory_.pop_back();
+  }
+  enabled_ = !directory_.empty() && createDirectories(directory_);
+  if (enabled_ && shared_) {
+    enabled_ = createDirectories(directory_ + "/index");
+    indexPath_ = directory_ + "/index/" + machineName() + ".idx";
+    std::lock_guard<std::mutex> lock(indexMutex_);
+    refreshIndex();
+  }
+}
+
+std::string MedialAxisDiskCache::currentEngineVersion() {
+  return std::string(ovd::version());
+}
+
+std::string MedialAxisDiskCache::pathForKey(uint64_t key) const {
+  char name[48];
+  std::snprintf(name, sizeof(name), "/%016llx_%016llx.mab", static_cast<unsigned long long>(key),
+                static_cast<unsigned long long>(engineHash_));
+  return directory_ + name;
+}
+
+std::string MedialAxisDiskCache::temporaryPath(const std::string& path) {
+  static std::atomic<unsigned> counter{0};
+  return path + ".tmp." + machineName() + "." + std::to_string(::getpid()) + "." + std::to_string(counter++);
+}
+
+bool MedialAxisDiskCache::load(uint64_t key, MedialAxisResults& results) const {
+  if (!enabled_ || (shared_ && !isIndexed(key))) {
+    return false;
+  }
+
+  std::string path = pathForKey(key);
+  Utils::MappedFile file(path, !shared_);
+  if (!file.data() || file.size() < sizeof(FileHeader)) {
+    return false;
+  }
+
+  FileHeader header;
+  std::memcpy(&header, file.data(), sizeof(header));
+  if (std::memcmp(header.magic, FILE_MAGIC, sizeof(FILE_MAGIC)) != 0 || header.formatVersion != FORMAT_VERSION ||
+      header.key != key || header.engineHash != engineHash_) {
+    return false;
+  }
+
+  // Published entries are complete, so a short or altered payload was damaged after the fact. Other
+  // machines may be reading a shared entry, so only trim() deletes it
+  const unsigned char* cursor = file.data() + sizeof(FileHeader);
+  uint64_t payloadHash = FNV_OFFSET_BASIS;
+  hashBytes(payloadHash, cursor, file.size() - sizeof(FileHeader));
+  if (file.size() != payloadBytes(header.numChains, header.totalPoints) || payloadHash != header.payloadHash) {
+    if (shared_) {
+      std::lock_guard<std::mutex> lock(indexMutex_);
+      damagedKeys_.insert(key);
+    } else {
+      std::remove(path.c_str());
+    }
+    return false;
+  }
+  if (header.numChains == 0) {
+    return false;
+  }
+
+  std::vector<uint32_t> chainSizes(header.numChains);
+  std::memcpy(chainSizes.data(), cursor, chainSizes.size() * sizeof(uint32_t));
+  cursor += chainSizes.size() * sizeof(uint32_t);
+
+  uint64_t sizeSum = 0;
+  for (uint32_t size : chainSizes) {
+    sizeSum += size;
+  }
+  if (sizeSum != header.totalPoints) {
+    return false;
+  }
+
+  // Each flat array is a single copy out of the mapping
+  size_t arrayBytes = header.totalPoints * sizeof(double);
+  std::vector<double> x(header.totalPoints);
+  std::vector<double> y(header.totalPoints);
+  std::vector<double> radii(header.totalPoints);
+  std::memcpy(x.data(), cursor, arrayBytes);
+  std::memcpy(y.data(), cursor + arrayBytes, arrayBytes);
+  std::memcpy(radii.data(), cursor + 2 * arrayBytes, arrayBytes);
+
+  std::vector<size_t> offsets(1, 0);
+  offsets.reserve(chainSizes.size() + 1);
+  for (uint32_t size : chainSizes) {
+    offsets.push_back(offsets.back() + size);
+  }
+
+  MedialAxisResults loaded;
+  if (!loaded.chains.assign(std::move(x), std::move(y), std::move(radii), std::move(offsets))) {
+    return false;
+  }
+  loaded.graph = MedialAxisGraph::fromChains(loaded.chains);
+
+  loaded.numChains = static_cast<int>(header.numChains);
+  loaded.totalPoints = static_cast<int>(header.totalPoints);
+  loaded.totalLength = header.totalLength;
+  loaded.minClearance = header.minClearance;
+  loaded.maxClearance = header.maxClearance;
+  loaded.transform.offset = Point2D(header.transformOffsetX, header.transformOffsetY);
+  loaded.transform.scale = header.transformScale;
+  loaded.transform.originalMin = Point2D(header.originalMinX, header.originalMinY);
+  loaded.transform.originalMax = Point2D(header.originalMaxX, header.originalMaxY);
+  loaded.success = true;
+
+  results = std::move(loaded);
+  return true;
+}
+
+bool MedialAxisDiskCache::store(uint64_t key, const MedialAxisResults& results) const {
+  // The file format holds the chains only; results with clearing loops stay in the memory cache
+  if (!enabled_ || !results.success || results.chains.empty() || !results.clearingLoops.empty()) {
+    return false;
+  }
+
+  FileHeader header{};
+  std::memcpy(header.magic, FILE_MAGIC, sizeof(FILE_MAGIC));
+  header.formatVersion = FORMAT_VERSION;
+  header.key = key;
+  header.engineHash = engineHash_;
+  header.numChains = static_cast<uint32_t>(results.chains.size());
+  header.totalLength = results.totalLength;
+  header.minClearance = results.minClearance;
+  header.maxClearance = results.maxClearance;
+  header.transformOffsetX = results.transform.offset.x;
+  header.transformOffsetY = results.transform.offset.y;
+  header.transformScale = results.transform.scale;
+  header.originalMinX = results.transform.originalMin.x;
+  header.originalMinY = results.transform.originalMin.y;
+  header.originalMaxX = results.transform.originalMax.x;
+  header.originalMaxY = results.transform.originalMax.y;
+
+  std::vector<uint32_t> chainSizes;
+  chainSizes.reserve(results.chains.size());
+  for (const auto& chain : results.chains) {
+    chainSizes.push_back(static_cast<uint32_t>(chain.size()));
+  }
+  header.totalPoints = static_cast<uint32_t>(results.chains.pointCount());
+  header.payloadHash = FNV_OFFSET_BASIS;
+  hashBytes(header.payloadHash, chainSizes.data(), chainSizes.size() * sizeof(uint32_t));
+  for (const auto* array : {&results.chains.xs(), &results.chains.ys(), &results.chains.radii()}) {
+    hashBytes(header.payloadHash, array->data(), array->size() * sizeof(double));
+  }
+
+  // Entries are immutable: one already published, here or by another machine, holds this result
+  std::string path = pathForKey(key);
+  struct stat published {};
+  if (::stat(path.c_str(), &published) == 0) {
+    if (shared_) {
+      appendToIndex(key);  // Lookups here missed it; the index it is in may not have been read yet
+    }
+    return true;
+  }
+
+  std::string tempPath = temporaryPath(path);
+  {
+    std::ofstream out(tempPath, std::ios::binary | std::ios::trunc);
+    if (!out) {
+      return false;
+    }
+
+    out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    out.write(reinterpret_cast<const char*>(chainSizes.data()),
+              static_cast<std::streamsize>(chainSizes.size() * sizeof(uint32_t)));
+    for (const auto* array : {&results.chains.xs(), &results.chains.ys(), &results.chains.radii()}) {
+      out.write(reinterpret_cast<const char*>(array->data()),
+                static_cast<std::streamsize>(array->size() * sizeof(double)));
+    }
+
+    if (!out) {
+      out.close();
+      std::remove(tempPath.c_str());
+      return false;
+    }
+  }
+
+  if (!publish(tempPath, path)) {
+    return false;
+  }
+  if (shared_) {
+    appendToIndex(key);
+  }
+  return true;
+}
+
+}  // namespace Geometry
+}  // namespace ChipCarving
@@ -0,0 +1,253 @@
+/**
+ * MedialAxisDiskCacheIndex.cpp
+ *
+ * Key index of shared medial axis caches, and trimming the cache directory
+ * Split from MedialAxisDiskCache.cpp for maintainability
+ *
+ * Index file layout (shared caches, index/<machine>.idx, appended to, and
+ * rewritten by this machine's trim()):
+ *   IndexRecord records[]
+ */
+
+#include "geometry/MedialAxisDiskCache.h"
+
+#include <dirent.h>
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <ctime>
+#include <fstream>
+#include <utility>
+#include <vector>
+
+namespace ChipCarving {
+namespace Geometry {
+
+namespace {
+
+// One published entry of a shared cache's index
+struct IndexRecord {
+  uint64_t key;
+  uint64_t engineHash;
+};
+
+bool endsWith(const std::string& text, const char* suffix) {
+  size_t length = std::strlen(suffix);
+  return text.size() >= length && text.compare(text.size() - length, length, suffix) == 0;
+}
+
+// Key and engine hash of an entry named by pathForKey()
+IndexRecord recordForName(const std::string& name) {
+  IndexRecord record{0, 0};
+  if (name.size() >= 33 && name[16] == '_') {
+    record.key = std::strtoull(name.substr(0, 16).c_str(), nullptr, 16);
+    record.engineHash = std::strtoull(name.substr(17, 16).c_str(), nullptr, 16);
+  }
+  return record;
+}
+
+}  // namespace
+
+bool MedialAxisDiskCache::isIndexed(uint64_t key) const {
+  std::lock_guard<std::mutex> lock(indexMutex_);
+  if (indexedKeys_.count(key) != 0) {
+    return true;
+  }
+  double age = std::chrono::duration<double>(std::chrono::steady_clock::now() - indexReadAt_).count();
+  if (age < INDEX_REFRESH_SECONDS) {
+    return false;
+  }
+  refreshIndex();
+  return indexedKeys_.count(key) != 0;
+}
+
+void MedialAxisDiskCache::refreshIndex() const {
+  indexReadAt_ = std::chrono::steady_clock::now();
+  std::string indexDirectory = directory_ + "/index";
+  DIR* dir = ::opendir(indexDirectory.c_str());
+  if (!dir) {
+    return;
+  }
+  std::vector<std::string> names;
+  while (dirent* entry = ::readdir(dir)) {
+    std::string name = entry->d_name;
+    if (endsWith(name, ".idx")) {
+      names.push_back(std::move(name));
+    }
+  }
+  ::closedir(dir);
+
+  // Files grow between trims; read each from the last whole record read before, or from the start if a
+  // trim rewrote it shorter
+  std::vector<IndexRecord> records;
+  for (const auto& name : names) {
+    uint64_t& offset = indexOffsets_[name];
+    std::ifstream in(indexDirectory + "/" + name, std::ios::binary | std::ios::ate);
+    std::streamoff size = in ? static_cast<std::streamoff>(in.tellg()) : 0;
+    if (size < static_cast<std::streamoff>(offset)) {
+      offset = 0;
+    }
+    if (size <= static_cast<std::streamoff>(offset)) {
+      continue;
+    }
+    records.resize(static_cast<size_t>(size - static_cast<std::streamoff>(offset)) / sizeof(IndexRecord));
+    in.seekg(static_cast<std::streamoff>(offset));
+    if (records.empty() ||
+        !in.read(reinterpret_cast<char*>(records.data()),
+                 static_cast<std::streamsize>(records.size() * sizeof(IndexRecord)))) {
+      continue;
+    }
+    offset += records.size() * sizeof(IndexRecord);
+    for (const auto& record : records) {
+      if (record.engineHash == engineHash_) {
+        indexedKeys_.insert(record.key);
+      }
+    }
+  }
+}
+
+void MedialAxisDiskCache::appendToIndex(uint64_t key) const {
+  std::lock_guard<std::mutex> lock(indexMutex_);
+  if (!indexedKeys_.insert(key).second) {
+    return;
+  }
+  // One small O_APPEND write per record, so records of this machine's processes never interleave
+  IndexRecord record{key, engineHash_};
+  int fd = ::open(indexPath_.c_str(), O_WRONLY | O_APPEND | O_CREAT, 0644);
+  if (fd >= 0) {
+    ssize_t written = ::write(fd, &record, sizeof(record));
+    (void)written;  // An unindexed entry is only found again by this process
+    ::close(fd);
+  }
+}
+
+void MedialAxisDiskCache::removeFromIndex(const std::vector<std::pair<uint64_t, uint64_t>>& removed) const {
+  auto isRemoved = [&removed](const IndexRecord& record) {
+    return std::find(removed.begin(), removed.end(), std::make_pair(record.key, record.engineHash)) != removed.end();
+  };
+
+  std::lock_guard<std::mutex> lock(indexMutex_);
+  for (const auto& entry : removed) {
+    if (entry.second == engineHash_) {
+      indexedKeys_.erase(entry.first);
+      damagedKeys_.erase(entry.first);
+    }
+  }
+
+  std::vector<IndexRecord> records;
+  {
+    std::ifstream in(indexPath_, std::ios::binary | std::ios::ate);
+    if (!in) {
+      return;
+    }
+    records.resize(static_cast<size_t>(in.tellg()) / sizeof(IndexRecord));
+    in.seekg(0);
+    if (!in.read(reinterpret_cast<char*>(records.data()),
+                 static_cast<std::streamsize>(records.size() * sizeof(IndexRecord)))) {
+      return;
+    }
+  }
+  size_t kept = static_cast<size_t>(std::remove_if(records.begin(), records.end(), isRemoved) - records.begin());
+  if (kept == records.size()) {
+    return;
+  }
+
+  // Readers see the old index or the new one, never a partial file. A record another process here
+  // appends meanwhile is lost, which only hides its entry until it is stored again
+  std::string tempPath = temporaryPath(indexPath_);
+  {
+    std::ofstream out(tempPath, std::ios::binary | std::ios::trunc);
+    out.write(reinterpret_cast<const char*>(records.data()), static_cast<std::streamsize>(kept * sizeof(IndexRecord)));
+    if (!out) {
+      out.close();
+      std::remove(tempPath.c_str());
+      return;
+    }
+  }
+  if (std::rename(tempPath.c_str(), indexPath_.c_str()) != 0) {
+    std::remove(tempPath.c_str());
+  }
+}
+
+uint64_t MedialAxisDiskCache::trim(uint64_t maxBytes) const {
+  struct CacheFile {
+    std::string path;
+    IndexRecord record;
+    bool damaged = false;
+    bool stale = false;
+    time_t written = 0;
+    uint64_t bytes = 0;
+  };
+  if (!enabled_) {
+    return 0;
+  }
+
+  DIR* dir = ::opendir(directory_.c_str());
+  if (!dir) {
+    return 0;
+  }
+  char engineSuffix[24];
+  std::snprintf(engineSuffix, sizeof(engineSuffix), "_%016llx.mab", static_cast<unsigned long long>(engineHash_));
+  std::vector<CacheFile> files;
+  uint64_t totalBytes = 0;
+  time_t abandoned = std::time(nullptr) - STALE_TEMP_SECONDS;
+  while (dirent* entry = ::readdir(dir)) {
+    std::string name = entry->d_name;
+    struct stat info {};
+    CacheFile file;
+    file.path = directory_ + "/" + name;
+    if (name.find(".mab.tmp.") != std::string::npos) {
+      if (::stat(file.path.c_str(), &info) == 0 && info.st_mtime < abandoned) {
+        std::remove(file.path.c_str());
+      }
+      continue;
+    }
+    if (!endsWith(name, ".mab") || ::stat(file.path.c_str(), &info) != 0 || !S_ISREG(info.st_mode)) {
+      continue;
+    }
+    file.record = recordForName(name);
+    file.stale = !endsWith(name, engineSuffix);
+    file.written = info.st_mtime;
+    file.bytes = static_cast<uint64_t>(info.st_size);
+    totalBytes += file.bytes;
+    files.push_back(std::move(file));
+  }
+  ::closedir(dir);
+  if (shared_) {
+    std::lock_guard<std::mutex> lock(indexMutex_);
+    for (auto& file : files) {
+      file.damaged = !file.stale && damagedKeys_.count(file.record.key) != 0;
+    }
+  }
+
+  // Damaged entries go whatever the budget, so a later store() can publish them again
+  std::sort(files.begin(), files.end(), [](const CacheFile& a, const CacheFile& b) {
+    if (a.damaged != b.damaged) {
+      return a.damaged;
+    }
+    return a.stale != b.stale ? a.stale : a.written < b.written;
+  });
+  std::vector<std::pair<uint64_t, uint64_t>> removed;
+  for (const auto& file : files) {
+    if (totalBytes <= maxBytes && !file.damaged) {
+      break;
+    }
+    if (std::remove(file.path.c_str()) == 0) {
+      totalBytes -= file.bytes;
+      removed.emplace_back(file.record.key, file.record.engineHash);
+    }
+  }
+  if (shared_ && !removed.empty()) {
+    removeFromIndex(removed);
+  }
+  return totalBytes;
+}
+
+}  // namespace Geometry
+}  // namespace ChipCarving
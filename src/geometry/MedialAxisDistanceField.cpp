@@ -0,0 +1,276 @@
+/**
+ * MedialAxisDistanceField.cpp
+ *
+ * Distance-field medial axis engine: even-odd rasterization, outline points
+ * snapped to the outside pixels along it, a jump flooding distance transform
+ * to those points, the integer medial axis ridge test of Hesselink and
+ * Roerdink, Zhang-Suen thinning and chain tracing
+ */
+
+#include "geometry/MedialAxisDistanceField.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <cstdint>
+#include <functional>
+#include <limits>
+#include <thread>
+
+#include "MedialAxisDistanceFieldGrid.h"
+#include "geometry/MedialAxisBatch.h"
+#include "utils/TaskScheduler.h"
+#include "utils/TraceSpan.h"
+
+namespace ChipCarving {
+namespace Geometry {
+
+namespace {
+
+constexpr size_t BAND_LINES = 64;  // Rows per thread or subtask
+
+/**
+ * Run pass over [0, lines) in bands: as subtasks inside a scheduler task, else
+ * on up to requestedWorkers threads
+ */
+void forEachBand(size_t lines, size_t lineCost, int requestedWorkers,
+                 const std::function<void(size_t, size_t)>& pass) {
+  size_t bands = (lines + BAND_LINES - 1) / BAND_LINES;
+  auto runBand = [&](size_t band) { pass(band * BAND_LINES, std::min(lines, (band + 1) * BAND_LINES)); };
+
+  if (bands > 1 && Utils::TaskScheduler::currentWorkerIndex() >= 0) {
+    Utils::TaskScheduler::TaskGroup group;
+    for (size_t band = 0; band < bands; ++band) {
+      group.spawn(static_cast<double>(BAND_LINES * lineCost), [&runBand, band]() { runBand(band); });
+    }
+    group.wait();
+    return;
+  }
+
+  int workerCount = resolveMedialAxisWorkerCount(requestedWorkers, bands);
+  if (workerCount == 1) {
+    for (size_t band = 0; band < bands; ++band) {
+      runBand(band);
+    }
+    return;
+  }
+  std::atomic<size_t> nextBand{0};
+  auto worker = [&]() {
+    for (size_t band = nextBand.fetch_add(1); band < bands; band = nextBand.fetch_add(1)) {
+      runBand(band);
+    }
+  };
+  std::vector<std::thread> threads;
+  for (int w = 1; w < workerCount; ++w) {
+    threads.emplace_back(worker);
+  }
+  worker();
+  for (auto& thread : threads) {
+    thread.join();
+  }
+}
+
+/**
+ * Nearest outline point of every pixel by jump flooding: the snapped outside
+ * pixels are the seeds, and each pass offers every pixel the seeds of its
+ * eight neighbours at a halving step, then once more at step 1. A seed is a
+ * point on the outline, so neighbouring pixels near a curve see nearly the
+ * same point instead of jumping between stair steps as nearest outside pixels
+ * do. Each pass reads the previous one only, so its rows are split over threads.
+ * @param seed Per pixel, the pixel whose outline point is nearest (NO_PIXEL if unreached)
+ */
+void floodOutlinePoints(const PixelGrid& grid, const std::vector<uint8_t>& edgePixel,
+                        const std::vector<Point2D>& outlinePoint, int workers, std::vector<size_t>& seed) {
+  const long width = static_cast<long>(grid.width);
+  const long height = static_cast<long>(grid.height);
+  for (size_t p = 0; p < seed.size(); ++p) {
+    seed[p] = edgePixel[p] ? p : NO_PIXEL;
+  }
+
+  std::vector<long> steps;
+  long step = 1;
+  while (step * 2 < std::max(width, height)) {
+    step *= 2;
+  }
+  for (; step >= 1; step /= 2) {
+    steps.push_back(step);
+  }
+  steps.push_back(1);
+
+  std::vector<size_t> next(seed.size());
+  for (long jump : steps) {
+    forEachBand(grid.height, grid.width * 9, workers, [&](size_t begin, size_t end) {
+      for (long y = static_cast<long>(begin); y < static_cast<long>(end); ++y) {
+        for (long x = 0; x < width; ++x) {
+          Point2D here(static_cast<double>(x), static_cast<double>(y));
+          size_t best = seed[static_cast<size_t>(y * width + x)];
+          double bestDistance2 = std::numeric_limits<double>::infinity();
+          if (best != NO_PIXEL) {
+            Point2D offset = outlinePoint[best] - here;
+            bestDistance2 = offset.x * offset.x + offset.y * offset.y;
+          }
+          for (long dy = -jump; dy <= jump; dy += jump) {
+            long ny = y + dy;
+            if (ny < 0 || ny >= height) {
+              continue;
+            }
+            for (long dx = -jump; dx <= jump; dx += jump) {
+              long nx = x + dx;
+              if (nx < 0 || nx >= width || (dx == 0 && dy == 0)) {
+                continue;
+              }
+              size_t candidate = seed[static_cast<size_t>(ny * width + nx)];
+              if (candidate == NO_PIXEL || candidate == best) {
+                continue;
+              }
+              Point2D offset = outlinePoint[candidate] - here;
+              double distance2 = offset.x * offset.x + offset.y * offset.y;
+              if (distance2 < bestDistance2) {
+                bestDistance2 = distance2;
+                best = candidate;
+              }
+            }
+          }
+          next[static_cast<size_t>(y * width + x)] = best;
+        }
+      }
+    });
+    seed.swap(next);
+  }
+}
+
+/**
+ * Integer medial axis: of two neighbouring inside pixels whose nearest
+ * outline points are far apart, mark the one nearer their bisector. Using the
+ * outline rather than the outside pixels keeps the raster staircase from
+ * growing a branch at every step. As in
+ * OpenVoronoi's medial axis filter, the two points must also subtend an angle
+ * of at least acos(medialThreshold), which drops ridges between nearly
+ * parallel runs of the outline.
+ */
+void markRidges(const PixelGrid& grid, const std::vector<uint8_t>& inside, const std::vector<size_t>& feature,
+                const std::vector<Point2D>& outlinePoint, const DistanceFieldOptions& options,
+                std::vector<uint8_t>& ridge) {
+  const double minSeparation2 = options.minFeatureSeparation * options.minFeatureSeparation;
+  // Chord over radius of that angle, squared
+  const double minChord2 = 2.0 * (1.0 - options.medialThreshold);
+  auto length2 = [](const Point2D& v) { return v.x * v.x + v.y * v.y; };
+  auto test = [&](size_t p, size_t q) {
+    if (feature[p] == NO_PIXEL || feature[q] == NO_PIXEL) {
+      return;
+    }
+    const Point2D& fp = outlinePoint[feature[p]];
+    const Point2D& fq = outlinePoint[feature[q]];
+    Point2D chord = fq - fp;
+    double separation2 = length2(chord);
+    Point2D cp = grid.cell(p), cq = grid.cell(q);
+    if (separation2 <= minSeparation2 ||
+        separation2 < minChord2 * std::max(length2(fp - cp), length2(fq - cq))) {
+      return;
+    }
+    // Signed offsets from the bisector; p's is negative, q's positive
+    Point2D middle = (fp + fq) * 0.5;
+    Point2D fromP = cp - middle, fromQ = cq - middle;
+    double sp = chord.x * fromP.x + chord.y * fromP.y;
+    double sq = chord.x * fromQ.x + chord.y * fromQ.y;
+    ridge[-sp <= sq ? p : q] = 1;
+  };
+  for (size_t p = 0; p < inside.size(); ++p) {
+    if (!inside[p]) {
+      continue;
+    }
+    if (inside[p + 1]) {
+      test(p, p + 1);
+    }
+    if (inside[p + grid.width]) {
+      test(p, p + grid.width);
+    }
+  }
+}
+
+}  // namespace
+
+bool computeDistanceFieldMedialAxis(const std::vector<Point2D>& polygon,
+                                    const std::vector<std::vector<Point2D>>& holes,
+                                    const DistanceFieldOptions& options, MedialAxisResults& results) {
+  Utils::TraceSpan span("distanceFieldMedialAxis");
+  results = MedialAxisResults();
+  PixelGrid grid;
+  if (!grid.fit(polygon, options)) {
+    results.errorMessage = "Polygon is degenerate";
+    return false;
+  }
+  fitUnitCircleTransform(polygon, results.transform);
+
+  std::vector<const std::vector<Point2D>*> loops = {&polygon};
+  for (const auto& hole : holes) {
+    loops.push_back(&hole);
+  }
+  const size_t pixelCount = grid.width * grid.height;
+  std::vector<uint8_t> inside(pixelCount, 0);
+  rasterizeLoops(loops, grid, inside);
+  Utils::traceCount("distanceFieldPixels", static_cast<double>(pixelCount));
+
+  std::vector<uint8_t> edgePixel(pixelCount, 0);
+  std::vector<Point2D> outlinePoint(pixelCount);
+  snapOutlinePixels(loops, grid, inside, edgePixel, outlinePoint);
+  std::vector<size_t> feature(pixelCount);
+  floodOutlinePoints(grid, edgePixel, outlinePoint, options.workers, feature);
+
+  std::vector<uint8_t> ridge(pixelCount, 0);
+  markRidges(grid, inside, feature, outlinePoint, options, ridge);
+  std::vector<size_t> pixels;
+  for (size_t p = 0; p < pixelCount; ++p) {
+    if (ridge[p]) {
+      pixels.push_back(p);
+    }
+  }
+  thinRidges(grid, ridge, pixels);
+
+  // Clearance is measured to the outline point of the nearest outside pixel
+  results.minClearance = std::numeric_limits<double>::max();
+  std::vector<Point2D> points;
+  std::vector<double> clearances;
+  for (const auto& chain : traceRidges(grid, ridge, pixels)) {
+    points.clear();
+    clearances.clear();
+    for (size_t p : chain) {
+      points.push_back(grid.centre(p));
+      clearances.push_back(distance(grid.cell(p), outlinePoint[feature[p]]) * grid.pixel);
+    }
+    // One 1-2-1 pass takes the edge off the pixel staircase; ends stay put so chains still meet
+    for (size_t i = 1; i + 1 < chain.size(); ++i) {
+      Point2D before = grid.centre(chain[i - 1]);
+      Point2D after = grid.centre(chain[i + 1]);
+      points[i] = (before + points[i] * 2.0 + after) * 0.25;
+    }
+
+    results.chains.beginChain();
+    results.numChains++;
+    for (size_t i = 0; i < points.size(); ++i) {
+      if (i > 0) {
+        results.totalLength += distance(points[i - 1], points[i]);
+      }
+      results.chains.addPoint(points[i], clearances[i]);
+      results.totalPoints++;
+      results.minClearance = std::min(results.minClearance, clearances[i]);
+      results.maxClearance = std::max(results.maxClearance, clearances[i]);
+    }
+  }
+
+  if (results.chains.empty()) {
+    results.minClearance = 0.0;
+    results.errorMessage = "Distance field has no ridges at this resolution";
+    return false;
+  }
+  results.graph = MedialAxisGraph::fromChains(results.chains);
+  results.success = true;
+
+  SpurPruningOptions pruning = options.spurPruning;
+  pruning.minLength = std::max(pruning.minLength, options.minSpurPixels * grid.pixel);
+  pruneMedialAxisSpurs(results, pruning);
+  return true;
+}
+
+}  // namespace Geometry
+}  // namespace ChipCarving
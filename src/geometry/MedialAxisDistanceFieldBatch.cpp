@@ -0,0 +1,89 @@
+/**
+ * MedialAxisDistanceFieldBatch.cpp
+ *
+ * Batches of distance-field medial axes on a work-stealing pool, and the
+ * engine that exposes the distance field to MedialAxisEngineSet
+ * Split from MedialAxisDistanceField.cpp for maintainability
+ */
+
+#include <chrono>
+#include <exception>
+#include <string>
+#include <vector>
+
+#include "MedialAxisDistanceFieldGrid.h"
+#include "geometry/MedialAxisBatch.h"
+#include "geometry/MedialAxisEngine.h"
+#include "utils/TaskScheduler.h"
+
+namespace ChipCarving {
+namespace Geometry {
+
+DistanceFieldOptions distanceFieldOptions(const MedialAxisProcessor& processor, int workers) {
+  DistanceFieldOptions options;
+  options.pixelSize = processor.getPolygonTolerance();
+  options.medialThreshold = processor.getMedialThreshold();
+  options.spurPruning = processor.getSpurPruning();
+  options.workers = workers;
+  return options;
+}
+
+double estimateDistanceFieldCost(const std::vector<Point2D>& polygon, const DistanceFieldOptions& options) {
+  PixelGrid grid;
+  return grid.fit(polygon, options) ? static_cast<double>(grid.width * grid.height) : 1.0;
+}
+
+std::vector<MedialAxisResults> computeDistanceFieldMedialAxisBatch(
+    const std::vector<std::vector<Point2D>>& polygons, const DistanceFieldOptions& options, int requestedWorkers,
+    Utils::JobProgress* progress, const std::vector<std::vector<std::vector<Point2D>>>* holes) {
+  std::vector<MedialAxisResults> results(polygons.size());
+  auto computeAt = [&](size_t i) {
+    if (progress && progress->isCancelled()) {
+      results[i].errorMessage = "Cancelled";
+      return;
+    }
+    auto start = std::chrono::steady_clock::now();
+    try {
+      MedialAxisProfile profile;
+      profile.polygon = &polygons[i];
+      profile.holes = holes && i < holes->size() ? &(*holes)[i] : nullptr;
+      MedialAxisEngineSet::distanceField(options).compute(profile, results[i]);
+    } catch (const std::exception& e) {
+      results[i] = MedialAxisResults();
+      results[i].errorMessage = "Exception during distance field medial axis: " + std::string(e.what());
+    }
+    results[i].computeMs =
+        std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+    if (progress) {
+      progress->advance();
+    }
+  };
+
+  int workers = resolveMedialAxisWorkerCount(requestedWorkers, polygons.size());
+  if (workers == 1) {
+    for (size_t i = 0; i < polygons.size(); ++i) {
+      computeAt(i);
+    }
+    return results;
+  }
+
+  Utils::TaskScheduler scheduler(workers);
+  for (size_t i = 0; i < polygons.size(); ++i) {
+    scheduler.submit(estimateDistanceFieldCost(polygons[i], options), [&computeAt, i]() { computeAt(i); });
+  }
+  scheduler.run();
+  return results;
+}
+
+bool DistanceFieldMedialAxisEngine::accepts(const MedialAxisProfile& profile) const {
+  return profile.polygon && profile.polygon->size() >= 3;
+}
+
+bool DistanceFieldMedialAxisEngine::compute(const MedialAxisProfile& profile, MedialAxisResults& results) {
+  static const std::vector<std::vector<Point2D>> NO_HOLES;
+  return computeDistanceFieldMedialAxis(*profile.polygon, profile.hasHoles() ? *profile.holes : NO_HOLES, options_,
+                                        results);
+}
+
+}  // namespace Geometry
+}  // namespace ChipCarving
@@ -0,0 +1,92 @@
+/**
+ * MedialAxisDistanceFieldGrid.h
+ *
+ * Pixel grid and raster stages shared by the distance-field medial axis
+ * engine's files (internal to src/geometry)
+ * Split from MedialAxisDistanceField.cpp for maintainability
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <vector>
+
+#include "geometry/MedialAxisDistanceField.h"
+#include "geometry/Point2D.h"
+
+namespace ChipCarving {
+namespace Geometry {
+
+constexpr double GRID_MARGIN = 1.5;  // Pixels of outside border, so every inside pixel has all 8 neighbours
+constexpr size_t NO_PIXEL = std::numeric_limits<size_t>::max();
+
+struct PixelGrid {
+  Point2D origin{0, 0};  // Corner of pixel (0, 0)
+  double pixel = 0.0;
+  size_t width = 0;
+  size_t height = 0;
+
+  // Fit the polygon's bounding box with the margin; false if it is degenerate
+  bool fit(const std::vector<Point2D>& polygon, const DistanceFieldOptions& options) {
+    if (polygon.size() < 3) {
+      return false;
+    }
+    Point2D low = polygon[0];
+    Point2D high = polygon[0];
+    for (const auto& point : polygon) {
+      low = Point2D(std::min(low.x, point.x), std::min(low.y, point.y));
+      high = Point2D(std::max(high.x, point.x), std::max(high.y, point.y));
+    }
+    double spanX = high.x - low.x;
+    double spanY = high.y - low.y;
+    // The budget over the area, or over the length for slivers the margin rows would swell
+    double budget = static_cast<double>(std::max<size_t>(options.maxPixels, 16));
+    pixel = std::max({options.pixelSize, std::sqrt(spanX * spanY / budget), 4.0 * std::max(spanX, spanY) / budget});
+    if (!(pixel > 0.0) || !std::isfinite(pixel)) {
+      return false;
+    }
+    origin = low - Point2D(GRID_MARGIN * pixel, GRID_MARGIN * pixel);
+    width = static_cast<size_t>(std::ceil(spanX / pixel)) + 3;
+    height = static_cast<size_t>(std::ceil(spanY / pixel)) + 3;
+    return true;
+  }
+
+  // Pixel coordinates: pixel centres on integers
+  Point2D cell(size_t index) const {
+    return Point2D(static_cast<double>(index % width), static_cast<double>(index / width));
+  }
+  Point2D toCells(const Point2D& point) const {
+    return Point2D((point.x - origin.x) / pixel - 0.5, (point.y - origin.y) / pixel - 0.5);
+  }
+  Point2D centre(size_t index) const {
+    return origin + (cell(index) + Point2D(0.5, 0.5)) * pixel;
+  }
+
+  // First pixel whose centre is at or beyond coordinate (along an axis starting at start)
+  static long firstAtOrBeyond(double coordinate, double start, double pixel) {
+    return static_cast<long>(std::ceil((coordinate - start) / pixel - 0.5));
+  }
+};
+
+// Even-odd fill of pixel centres over every loop, so holes come out
+void rasterizeLoops(const std::vector<const std::vector<Point2D>*>& loops, const PixelGrid& grid,
+                    std::vector<uint8_t>& inside);
+
+// For every outside pixel next to an inside one, the closest point of the outline (in pixel coordinates)
+void snapOutlinePixels(const std::vector<const std::vector<Point2D>*>& loops, const PixelGrid& grid,
+                       const std::vector<uint8_t>& inside, std::vector<uint8_t>& edgePixel,
+                       std::vector<Point2D>& outlinePoint);
+
+// Zhang-Suen thinning of the ridge pixels (pixels lists them, and loses the removed ones)
+void thinRidges(const PixelGrid& grid, std::vector<uint8_t>& ridge, std::vector<size_t>& pixels);
+
+// Chains of pixels along the thinned ridges
+std::vector<std::vector<size_t>> traceRidges(const PixelGrid& grid, const std::vector<uint8_t>& ridge,
+                                             const std::vector<size_t>& pixels);
+
+}  // namespace Geometry
+}  // namespace ChipCarving
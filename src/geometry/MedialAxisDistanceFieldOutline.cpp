@@ -0,0 +1,135 @@
+/**
+ * MedialAxisDistanceFieldOutline.cpp
+ *
+ * Rasterization of the profile and the outline points of the pixels along it
+ * Split from MedialAxisDistanceField.cpp for maintainability
+ */
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <vector>
+
+#include "MedialAxisDistanceFieldGrid.h"
+
+namespace ChipCarving {
+namespace Geometry {
+
+namespace {
+
+// Closest point of segment ab to point
+Point2D closestOnSegment(const Point2D& point, const Point2D& a, const Point2D& b) {
+  Point2D ab = b - a;
+  double length2 = ab.x * ab.x + ab.y * ab.y;
+  double t = length2 > 0.0 ? ((point.x - a.x) * ab.x + (point.y - a.y) * ab.y) / length2 : 0.0;
+  t = std::min(1.0, std::max(0.0, t));
+  return a + ab * t;
+}
+
+}  // namespace
+
+// A closing duplicate vertex is a horizontal edge, and adds no crossing
+void rasterizeLoops(const std::vector<const std::vector<Point2D>*>& loops, const PixelGrid& grid,
+                    std::vector<uint8_t>& inside) {
+  std::vector<std::vector<double>> crossings(grid.height);
+  long lastRow = static_cast<long>(grid.height) - 1;
+  for (const auto* loop : loops) {
+    size_t n = loop->size();
+    for (size_t k = 0; k < n; ++k) {
+      const Point2D& a = (*loop)[k];
+      const Point2D& b = (*loop)[(k + 1) % n];
+      if (a.y == b.y) {
+        continue;
+      }
+      // Rows whose centre y is in [low, high)
+      long first = std::max(0L, PixelGrid::firstAtOrBeyond(std::min(a.y, b.y), grid.origin.y, grid.pixel));
+      long last = std::min(lastRow, PixelGrid::firstAtOrBeyond(std::max(a.y, b.y), grid.origin.y, grid.pixel) - 1);
+      for (long row = first; row <= last; ++row) {
+        double y = grid.origin.y + (static_cast<double>(row) + 0.5) * grid.pixel;
+        crossings[row].push_back(a.x + (y - a.y) * (b.x - a.x) / (b.y - a.y));
+      }
+    }
+  }
+
+  long lastColumn = static_cast<long>(grid.width) - 1;
+  for (size_t row = 0; row < grid.height; ++row) {
+    std::vector<double>& xs = crossings[row];
+    std::sort(xs.begin(), xs.end());
+    for (size_t k = 0; k + 1 < xs.size(); k += 2) {
+      long first = std::max(0L, PixelGrid::firstAtOrBeyond(xs[k], grid.origin.x, grid.pixel));
+      long last = std::min(lastColumn, PixelGrid::firstAtOrBeyond(xs[k + 1], grid.origin.x, grid.pixel) - 1);
+      for (long column = first; column <= last; ++column) {
+        inside[row * grid.width + static_cast<size_t>(column)] = 1;
+      }
+    }
+  }
+}
+
+/**
+ * For every outside pixel next to an inside one, the closest point of the
+ * outline (in pixel coordinates, pixel centres on integers). Such a pixel is
+ * within 1.5 pixels of the outline, so sampling each edge every pixel and
+ * searching 5x5 pixels around each sample finds its closest edge.
+ */
+void snapOutlinePixels(const std::vector<const std::vector<Point2D>*>& loops, const PixelGrid& grid,
+                       const std::vector<uint8_t>& inside, std::vector<uint8_t>& edgePixel,
+                       std::vector<Point2D>& outlinePoint) {
+  const long width = static_cast<long>(grid.width);
+  const long height = static_cast<long>(grid.height);
+  std::vector<double> best(inside.size(), std::numeric_limits<double>::infinity());
+  for (long y = 1; y + 1 < height; ++y) {
+    for (long x = 1; x + 1 < width; ++x) {
+      size_t p = static_cast<size_t>(y * width + x);
+      if (inside[p]) {
+        for (long dy = -1; dy <= 1; ++dy) {
+          for (long dx = -1; dx <= 1; ++dx) {
+            size_t q = static_cast<size_t>((y + dy) * width + x + dx);
+            if (!inside[q]) {
+              edgePixel[q] = 1;
+            }
+          }
+        }
+      }
+    }
+  }
+
+  for (const auto* loop : loops) {
+    size_t n = loop->size();
+    for (size_t k = 0; k < n; ++k) {
+      Point2D a = grid.toCells((*loop)[k]);
+      Point2D b = grid.toCells((*loop)[(k + 1) % n]);
+      size_t samples = static_cast<size_t>(std::ceil(distance(a, b))) + 1;
+      for (size_t i = 0; i < samples; ++i) {
+        Point2D sample = a + (b - a) * (samples > 1 ? static_cast<double>(i) / static_cast<double>(samples - 1) : 0.0);
+        long cx = std::lround(sample.x), cy = std::lround(sample.y);
+        for (long y = std::max(0L, cy - 2); y <= std::min(height - 1, cy + 2); ++y) {
+          for (long x = std::max(0L, cx - 2); x <= std::min(width - 1, cx + 2); ++x) {
+            size_t p = static_cast<size_t>(y * width + x);
+            if (!edgePixel[p]) {
+              continue;
+            }
+            Point2D centre(static_cast<double>(x), static_cast<double>(y));
+            Point2D closest = closestOnSegment(centre, a, b);
+            Point2D offset = closest - centre;
+            double distance2 = offset.x * offset.x + offset.y * offset.y;
+            if (distance2 < best[p]) {
+              best[p] = distance2;
+              outlinePoint[p] = closest;
+            }
+          }
+        }
+      }
+    }
+  }
+
+  // Unreached pixels (none, barring rounding) fall back to their centre
+  for (size_t p = 0; p < inside.size(); ++p) {
+    if (edgePixel[p] && best[p] == std::numeric_limits<double>::infinity()) {
+      outlinePoint[p] = grid.cell(p);
+    }
+  }
+}
+
+}  // namespace Geometry
+}  // namespace ChipCarving
@@ -0,0 +1,159 @@
+/**
+ * MedialAxisDistanceFieldRidges.cpp
+ *
+ * Thinning of the distance field's ridge pixels and tracing them into chains
+ * Split from MedialAxisDistanceField.cpp for maintainability
+ */
+
+#include <algorithm>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+#include "MedialAxisDistanceFieldGrid.h"
+
+namespace ChipCarving {
+namespace Geometry {
+
+namespace {
+
+/**
+ * Ridge neighbours of a ridge pixel: the four edge neighbours, and a diagonal
+ * one only when neither pixel between them is on the ridge, so a curve's
+ * pixels form a path without little triangles
+ */
+int ridgeNeighbours(const PixelGrid& grid, const std::vector<uint8_t>& ridge, size_t p, size_t out[8]) {
+  const long w = static_cast<long>(grid.width);
+  const long sides[4] = {1, -w, -1, w};
+  int count = 0;
+  for (int k = 0; k < 4; ++k) {
+    size_t q = static_cast<size_t>(static_cast<long>(p) + sides[k]);
+    if (ridge[q]) {
+      out[count++] = q;
+    }
+  }
+  for (int k = 0; k < 4; ++k) {
+    long a = sides[k], b = sides[(k + 1) % 4];
+    size_t q = static_cast<size_t>(static_cast<long>(p) + a + b);
+    if (ridge[q] && !ridge[static_cast<size_t>(static_cast<long>(p) + a)] &&
+        !ridge[static_cast<size_t>(static_cast<long>(p) + b)]) {
+      out[count++] = q;
+    }
+  }
+  return count;
+}
+
+}  // namespace
+
+// Zhang-Suen thinning of the ridge pixels to 8-connected curves one pixel wide
+void thinRidges(const PixelGrid& grid, std::vector<uint8_t>& ridge, std::vector<size_t>& pixels) {
+  const long w = static_cast<long>(grid.width);
+  // P2..P9: north, north-east, east, ... clockwise
+  const long ring[8] = {-w, -w + 1, 1, w + 1, w, w - 1, -1, -w - 1};
+  std::vector<size_t> removed;
+  bool changed = true;
+  while (changed) {
+    changed = false;
+    for (int step = 0; step < 2; ++step) {
+      removed.clear();
+      for (size_t p : pixels) {
+        uint8_t n[8];
+        int count = 0;
+        for (int k = 0; k < 8; ++k) {
+          n[k] = ridge[static_cast<size_t>(static_cast<long>(p) + ring[k])];
+          count += n[k];
+        }
+        int transitions = 0;
+        for (int k = 0; k < 8; ++k) {
+          transitions += !n[k] && n[(k + 1) % 8];
+        }
+        bool clear = step == 0 ? !(n[0] && n[2] && n[4]) && !(n[2] && n[4] && n[6])
+                               : !(n[0] && n[2] && n[6]) && !(n[0] && n[4] && n[6]);
+        if (count >= 2 && count <= 6 && transitions == 1 && clear) {
+          removed.push_back(p);
+        }
+      }
+      for (size_t p : removed) {
+        ridge[p] = 0;
+      }
+      if (!removed.empty()) {
+        changed = true;
+        pixels.erase(std::remove_if(pixels.begin(), pixels.end(), [&ridge](size_t p) { return !ridge[p]; }),
+                     pixels.end());
+      }
+    }
+  }
+}
+
+// Chains between ridge pixels that are not plain path pixels, then round closed loops
+std::vector<std::vector<size_t>> traceRidges(const PixelGrid& grid, const std::vector<uint8_t>& ridge,
+                                             const std::vector<size_t>& pixels) {
+  std::vector<uint8_t> degree(ridge.size(), 0);
+  size_t neighbours[8];
+  for (size_t p : pixels) {
+    degree[p] = static_cast<uint8_t>(ridgeNeighbours(grid, ridge, p, neighbours));
+  }
+  auto nextAlong = [&](size_t current, size_t previous) {
+    size_t around[8];
+    ridgeNeighbours(grid, ridge, current, around);
+    return around[0] == previous ? around[1] : around[0];
+  };
+
+  std::vector<std::vector<size_t>> chains;
+  std::vector<uint8_t> visited(ridge.size(), 0);
+  for (size_t start : pixels) {
+    if (degree[start] == 2 || degree[start] == 0) {
+      continue;
+    }
+    int count = ridgeNeighbours(grid, ridge, start, neighbours);
+    for (int k = 0; k < count; ++k) {
+      size_t first = neighbours[k];
+      if (degree[first] != 2) {
+        if (start < first) {
+          chains.push_back({start, first});
+        }
+        continue;
+      }
+      if (visited[first]) {
+        continue;
+      }
+      std::vector<size_t> chain = {start};
+      size_t previous = start;
+      size_t current = first;
+      while (true) {
+        chain.push_back(current);
+        if (degree[current] != 2) {
+          break;
+        }
+        visited[current] = 1;
+        size_t next = nextAlong(current, previous);
+        previous = current;
+        current = next;
+      }
+      chains.push_back(std::move(chain));
+    }
+  }
+
+  for (size_t start : pixels) {
+    if (degree[start] != 2 || visited[start]) {
+      continue;
+    }
+    std::vector<size_t> chain = {start};
+    visited[start] = 1;
+    size_t previous = start;
+    size_t current = nextAlong(start, NO_PIXEL);
+    while (current != start) {
+      chain.push_back(current);
+      visited[current] = 1;
+      size_t next = nextAlong(current, previous);
+      previous = current;
+      current = next;
+    }
+    chain.push_back(start);
+    chains.push_back(std::move(chain));
+  }
+  return chains;
+}
+
+}  // namespace Geometry
+}  // namespace ChipCarving
@@ -0,0 +1,113 @@
+/**
+ * MedialAxisEngine.cpp
+ *
+ * Analytic and OpenVoronoi medial axis engines and their ordered selection
+ */
+
+#include "geometry/MedialAxisEngine.h"
+
+#include <utility>
+
+#include "geometry/AnalyticMedialAxis.h"
+#include "geometry/Leaf.h"
+#include "geometry/StraightSkeleton.h"
+#include "geometry/TriArc.h"
+
+namespace ChipCarving {
+namespace Geometry {
+
+constexpr size_t MedialAxisEngineSet::NO_ENGINE;
+constexpr size_t StraightSkeletonMedialAxisEngine::MAX_VERTICES;
+
+size_t MedialAxisProfile::vertexCount() const {
+  size_t count = polygon ? polygon->size() : 0;
+  if (holes) {
+    for (const auto& hole : *holes) {
+      count += hole.size();
+    }
+  }
+  return count;
+}
+
+bool AnalyticMedialAxisEngine::accepts(const MedialAxisProfile& profile) const {
+  // The closed forms describe the outer loop only
+  return profile.polygon && profile.sourceShape && !profile.hasHoles() &&
+         (dynamic_cast<const Leaf*>(profile.sourceShape) || dynamic_cast<const TriArc*>(profile.sourceShape));
+}
+
+bool AnalyticMedialAxisEngine::compute(const MedialAxisProfile& profile, MedialAxisResults& results) {
+  return computeAnalyticMedialAxis(*profile.sourceShape, profile.shapeScale, *profile.polygon, profile.matchTolerance,
+                                   results);
+}
+
+bool StraightSkeletonMedialAxisEngine::accepts(const MedialAxisProfile& profile) const {
+  return profile.polygon && !profile.hasHoles() && profile.polygon->size() <= MAX_VERTICES &&
+         polygonHasOnlyStraightEdges(*profile.polygon);
+}
+
+bool StraightSkeletonMedialAxisEngine::compute(const MedialAxisProfile& profile, MedialAxisResults& results) {
+  return computeStraightSkeleton(*profile.polygon, results);
+}
+
+bool OpenVoronoiMedialAxisEngine::accepts(const MedialAxisProfile& profile) const {
+  // The processor validates the loops itself and says what is wrong with them
+  return profile.polygon != nullptr;
+}
+
+bool OpenVoronoiMedialAxisEngine::compute(const MedialAxisProfile& profile, MedialAxisResults& results) {
+  results = profile.hasHoles() ? processor_.computeMedialAxis(*profile.polygon, *profile.holes)
+                               : processor_.computeMedialAxis(*profile.polygon);
+  return results.success;
+}
+
+void MedialAxisEngineSet::add(std::unique_ptr<IMedialAxisEngine> engine, size_t minVertices, size_t maxVertices) {
+  entries_.push_back(Entry{std::move(engine), minVertices, maxVertices});
+}
+
+size_t MedialAxisEngineSet::compute(const MedialAxisProfile& profile, MedialAxisResults& results) {
+  size_t vertices = profile.vertexCount();
+  bool attempted = false;
+  for (size_t i = 0; i < entries_.size(); ++i) {
+    Entry& entry = entries_[i];
+    if (vertices < entry.minVertices || vertices > entry.maxVertices || !entry.engine->accepts(profile)) {
+      continue;
+    }
+    attempted = true;
+    if (entry.engine->compute(profile, results)) {
+      return i;
+    }
+  }
+  if (!attempted) {
+    results = MedialAxisResults();
+    results.errorMessage = "No medial axis engine accepts this profile";
+  }
+  return NO_ENGINE;
+}
+
+MedialAxisEngineSet MedialAxisEngineSet::analytic(const MedialAxisProcessor& processor) {
+  MedialAxisEngineSet engines;
+  if (!processor.getClearingOffsets().enabled()) {
+    engines.add(std::make_unique<AnalyticMedialAxisEngine>());
+  }
+  return engines;
+}
+
+MedialAxisEngineSet MedialAxisEngineSet::standard(MedialAxisProcessor& processor, bool useAnalytic) {
+  // Only OpenVoronoi traces clearing offsets
+  bool clearing = processor.getClearingOffsets().enabled();
+  MedialAxisEngineSet engines = useAnalytic ? analytic(processor) : MedialAxisEngineSet();
+  if (processor.getStraightSkeleton() && !clearing) {
+    engines.add(std::make_unique<StraightSkeletonMedialAxisEngine>());
+  }
+  engines.add(std::make_unique<OpenVoronoiMedialAxisEngine>(processor));
+  return engines;
+}
+
+MedialAxisEngineSet MedialAxisEngineSet::distanceField(const DistanceFieldOptions& options) {
+  MedialAxisEngineSet engines;
+  engines.add(std::make_unique<DistanceFieldMedialAxisEngine>(options));
+  return engines;
+}
+
+}  // namespace Geometry
+}  // namespace ChipCarving
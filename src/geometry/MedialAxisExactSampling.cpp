@@ -0,0 +1,242 @@
+/**
+ * MedialAxisExactSampling.cpp
+ *
+ * Fixed-distance medial axis sampling evaluated straight from each chain's
+ * arc-length parameterization, with clearance measured to the profile's loops.
+ * Split from MedialAxisUtilities.cpp for maintainability
+ */
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <vector>
+
+#include "geometry/ArcLengthChain.h"
+#include "geometry/MedialAxisUtilities.h"
+#include "geometry/PointKernels.h"
+
+namespace ChipCarving {
+namespace Geometry {
+
+namespace {
+
+// As in sampleMedialAxisChains (output units)
+constexpr double MIN_SAMPLE_SEPARATION = 0.1;
+constexpr double MIN_SAMPLED_LENGTH = 0.2;
+
+// Grid cells per side at most, however many edges the loops have
+constexpr size_t MAX_GRID_SIDE = 1024;
+
+double segmentDistance(const Point2D& p, const Point2D& a, const Point2D& b) {
+  Point2D direction = b - a;
+  double lengthSquared = direction.x * direction.x + direction.y * direction.y;
+  if (lengthSquared <= 0.0) {
+    return distance(p, a);
+  }
+  Point2D offset = p - a;
+  double t = std::max(0.0, std::min(1.0, (offset.x * direction.x + offset.y * direction.y) / lengthSquared));
+  return distance(p, a + direction * t);
+}
+
+/**
+ * Distance to the nearest edge of a set of closed loops. Edges are bucketed in
+ * a uniform grid of about one edge per cell; a query searches rings of cells
+ * outward from its own until no unsearched cell can hold a nearer edge.
+ */
+class BoundaryDistance {
+ public:
+  BoundaryDistance(const std::vector<const std::vector<Point2D>*>& loops, double unitScale) {
+    std::vector<Point2D> vertices;
+    for (const auto* loop : loops) {
+      if (!loop || loop->size() < 2) {
+        continue;
+      }
+      for (size_t i = 0; i < loop->size(); ++i) {
+        const Point2D& a = (*loop)[i];
+        const Point2D& b = (*loop)[(i + 1) % loop->size()];
+        edges_.push_back({a * unitScale, b * unitScale});
+        vertices.push_back(a * unitScale);
+      }
+    }
+    if (edges_.empty()) {
+      return;
+    }
+
+    PointBounds bounds = pointBounds(vertices.data(), vertices.size());
+    origin_ = bounds.min;
+    double extent = std::max(bounds.max.x - bounds.min.x, bounds.max.y - bounds.min.y);
+    size_t side = std::min(MAX_GRID_SIDE, static_cast<size_t>(std::ceil(std::sqrt(edges_.size()))));
+    cellSize_ = extent > 0.0 ? extent / static_cast<double>(side) : 1.0;
+    columns_ = cellIndex(bounds.max.x - origin_.x) + 1;
+    rows_ = cellIndex(bounds.max.y - origin_.y) + 1;
+
+    // Each edge goes in every cell its bounding box touches: count, then fill
+    cellStarts_.assign(columns_ * rows_ + 1, 0);
+    forEachEdgeCell([this](size_t cell, uint32_t) { ++cellStarts_[cell + 1]; });
+    for (size_t cell = 0; cell < columns_ * rows_; ++cell) {
+      cellStarts_[cell + 1] += cellStarts_[cell];
+    }
+    cellEdges_.resize(cellStarts_.back());
+    std::vector<uint32_t> fill(cellStarts_.begin(), cellStarts_.end() - 1);
+    forEachEdgeCell([&](size_t cell, uint32_t edge) { cellEdges_[fill[cell]++] = edge; });
+  }
+
+  bool empty() const {
+    return edges_.empty();
+  }
+
+  double distanceFrom(const Point2D& p) const {
+    size_t column = std::min(cellIndex(p.x - origin_.x), columns_ - 1);
+    size_t row = std::min(cellIndex(p.y - origin_.y), rows_ - 1);
+    double nearest = std::numeric_limits<double>::infinity();
+    size_t maxRing = std::max(columns_, rows_);
+    for (size_t ring = 0; ring <= maxRing; ++ring) {
+      forEachRingCell(column, row, ring, [&](size_t cell) {
+        for (uint32_t k = cellStarts_[cell]; k < cellStarts_[cell + 1]; ++k) {
+          const Edge& edge = edges_[cellEdges_[k]];
+          nearest = std::min(nearest, segmentDistance(p, edge.a, edge.b));
+        }
+      });
+      // Cells past this ring are at least ring cell widths from p's own cell
+      if (nearest <= static_cast<double>(ring) * cellSize_) {
+        break;
+      }
+    }
+    return nearest;
+  }
+
+ private:
+  struct Edge {
+    Point2D a;
+    Point2D b;
+  };
+
+  size_t cellIndex(double offset) const {
+    return offset > 0.0 ? static_cast<size_t>(offset / cellSize_) : 0;
+  }
+
+  template <typename Visit>
+  void forEachEdgeCell(Visit&& visit) const {
+    for (size_t e = 0; e < edges_.size(); ++e) {
+      const Edge& edge = edges_[e];
+      size_t firstColumn = cellIndex(std::min(edge.a.x, edge.b.x) - origin_.x);
+      size_t lastColumn = std::min(cellIndex(std::max(edge.a.x, edge.b.x) - origin_.x), columns_ - 1);
+      size_t firstRow = cellIndex(std::min(edge.a.y, edge.b.y) - origin_.y);
+      size_t lastRow = std::min(cellIndex(std::max(edge.a.y, edge.b.y) - origin_.y), rows_ - 1);
+      for (size_t row = firstRow; row <= lastRow; ++row) {
+        for (size_t column = firstColumn; column <= lastColumn; ++column) {
+          visit(row * columns_ + column, static_cast<uint32_t>(e));
+        }
+      }
+    }
+  }
+
+  // Cells exactly ring steps (Chebyshev) from (column, row), within the grid
+  template <typename Visit>
+  void forEachRingCell(size_t column, size_t row, size_t ring, Visit&& visit) const {
+    auto inGrid = [this](long long c, long long r) {
+      return c >= 0 && r >= 0 && c < static_cast<long long>(columns_) && r < static_cast<long long>(rows_);
+    };
+    long long c0 = static_cast<long long>(column);
+    long long r0 = static_cast<long long>(row);
+    long long k = static_cast<long long>(ring);
+    for (long long r = r0 - k; r <= r0 + k; ++r) {
+      bool edgeRow = r == r0 - k || r == r0 + k;
+      for (long long c = c0 - k; c <= c0 + k; c += (edgeRow || k == 0) ? 1 : 2 * k) {
+        if (inGrid(c, r)) {
+          visit(static_cast<size_t>(r) * columns_ + static_cast<size_t>(c));
+        }
+      }
+    }
+  }
+
+  std::vector<Edge> edges_{};
+  Point2D origin_{};
+  double cellSize_ = 1.0;
+  size_t columns_ = 1;
+  size_t rows_ = 1;
+  std::vector<uint32_t> cellStarts_{};
+  std::vector<uint32_t> cellEdges_{};
+};
+
+// Evenly spaced distances along a chain of the given length, forced ones merged in
+void samplePositions(double length, double targetSpacing, const std::vector<double>* forced,
+                     std::vector<double>& positions) {
+  positions.clear();
+  int count = std::max(2, static_cast<int>(length / targetSpacing) + 1);
+  if (length <= MIN_SAMPLED_LENGTH) {
+    count = 2;
+  }
+  for (int k = 0; k < count; ++k) {
+    positions.push_back(k + 1 == count ? length : length * k / (count - 1));
+  }
+  if (!forced || forced->empty()) {
+    return;
+  }
+
+  // Regular samples near a forced one give way to it, apart from the chain's ends
+  auto nearForced = [&](double s) {
+    auto next = std::lower_bound(forced->begin(), forced->end(), s);
+    return (next != forced->end() && *next - s < MIN_SAMPLE_SEPARATION) ||
+           (next != forced->begin() && s - *(next - 1) < MIN_SAMPLE_SEPARATION);
+  };
+  size_t kept = 1;
+  for (size_t k = 1; k + 1 < positions.size(); ++k) {
+    if (!nearForced(positions[k])) {
+      positions[kept++] = positions[k];
+    }
+  }
+  positions[kept++] = length;
+  positions.resize(kept);
+  for (double s : *forced) {
+    if (s > 0.0 && s < length) {
+      positions.push_back(s);
+    }
+  }
+  std::sort(positions.begin(), positions.end());
+}
+
+}  // namespace
+
+void sampleMedialAxisChainsExact(const MedialAxisChains& chains, double unitScale, double targetSpacing,
+                                 const std::vector<const std::vector<Point2D>*>& boundaries,
+                                 std::vector<SampledMedialPath>& sampledPaths,
+                                 const std::vector<std::vector<double>>* forcedPositions) {
+  sampledPaths.reserve(sampledPaths.size() + chains.size());
+  BoundaryDistance boundary(boundaries, unitScale);
+
+  ArcLengthChain arc;
+  std::vector<double> positions;
+  for (size_t c = 0; c < chains.size(); ++c) {
+    auto chain = chains[c];
+    if (chain.empty()) {
+      continue;
+    }
+
+    sampledPaths.emplace_back();
+    SampledMedialPath& sampledPath = sampledPaths.back();
+    sampledPath.chain = static_cast<int>(c);
+    if (chain.size() == 1) {
+      sampledPath.points.emplace_back(chain[0] * unitScale, chain.clearance(0) * unitScale);
+      continue;
+    }
+
+    arc.assign(chain, unitScale);
+    sampledPath.totalLength = arc.totalLength();
+    const std::vector<double>* forced =
+        forcedPositions && c < forcedPositions->size() ? &(*forcedPositions)[c] : nullptr;
+    samplePositions(arc.totalLength(), targetSpacing, forced, positions);
+
+    sampledPath.points.reserve(positions.size());
+    for (double s : positions) {
+      Point2D position = arc.pointAt(s);
+      double clearance = boundary.empty() ? arc.clearanceAt(s) : boundary.distanceFrom(position);
+      bool isForced = forced && std::binary_search(forced->begin(), forced->end(), s);
+      sampledPath.points.emplace_back(position, clearance, isForced);
+    }
+  }
+}
+
+}  // namespace Geometry
+}  // namespace ChipCarving
@@ -0,0 +1,122 @@
+/**
+ * MedialAxisGraph.cpp
+ *
+ * Junction graph built from medial axis chain endpoints
+ */
+
+#include "geometry/MedialAxisGraph.h"
+
+#include <algorithm>
+
+namespace ChipCarving {
+namespace Geometry {
+
+constexpr uint32_t MedialAxisGraph::NO_NODE;
+
+namespace {
+
+struct Endpoint {
+  Point2D position;
+  uint32_t slot;  // 2 * chain + (0 at the chain's start, 1 at its end)
+};
+
+}  // namespace
+
+MedialAxisGraph MedialAxisGraph::fromChains(const MedialAxisChains& chains, double tolerance) {
+  MedialAxisGraph graph;
+  graph.edges_.resize(chains.size());
+
+  std::vector<Endpoint> endpoints;
+  endpoints.reserve(2 * chains.size());
+  for (size_t i = 0; i < chains.size(); ++i) {
+    auto chain = chains[i];
+    if (!chain.empty()) {
+      endpoints.push_back(Endpoint{chain.front(), static_cast<uint32_t>(2 * i)});
+      endpoints.push_back(Endpoint{chain.back(), static_cast<uint32_t>(2 * i + 1)});
+    }
+  }
+
+  // Sweep endpoints in x order, joining each to the earlier ones within
+  // tolerance; every group is rooted at its lowest slot
+  std::sort(endpoints.begin(), endpoints.end(), [](const Endpoint& a, const Endpoint& b) {
+    if (a.position.x != b.position.x) {
+      return a.position.x < b.position.x;
+    }
+    return a.position.y != b.position.y ? a.position.y < b.position.y : a.slot < b.slot;
+  });
+  std::vector<uint32_t> parent(2 * chains.size(), NO_NODE);
+  for (const auto& point : endpoints) {
+    parent[point.slot] = point.slot;
+  }
+  auto root = [&parent](uint32_t slot) {
+    while (parent[slot] != slot) {
+      slot = parent[slot] = parent[parent[slot]];
+    }
+    return slot;
+  };
+  for (size_t k = 0; k < endpoints.size(); ++k) {
+    const Endpoint& point = endpoints[k];
+    for (size_t j = k; j-- > 0 && point.position.x - endpoints[j].position.x <= tolerance;) {
+      if (distance(endpoints[j].position, point.position) <= tolerance) {
+        uint32_t a = root(point.slot);
+        uint32_t b = root(endpoints[j].slot);
+        parent[std::max(a, b)] = std::min(a, b);
+      } else if (tolerance <= 0.0) {
+        break;  // Equal points are adjacent after sorting
+      }
+    }
+  }
+
+  // Node IDs in slot order; a group's root is its lowest slot, so it is numbered first
+  uint32_t nodeCount = 0;
+  std::vector<uint32_t> nodeOf(parent.size(), NO_NODE);
+  for (uint32_t slot = 0; slot < parent.size(); ++slot) {
+    if (parent[slot] != NO_NODE) {
+      uint32_t groupRoot = root(slot);
+      nodeOf[slot] = groupRoot == slot ? nodeCount++ : nodeOf[groupRoot];
+    }
+  }
+  for (size_t i = 0; i < graph.edges_.size(); ++i) {
+    graph.edges_[i].start = nodeOf[2 * i];
+    graph.edges_[i].end = nodeOf[2 * i + 1];
+  }
+
+  // Incident chain lists, filled in chain order
+  graph.nodeOffsets_.assign(nodeCount + 1, 0);
+  for (uint32_t node : nodeOf) {
+    if (node != NO_NODE) {
+      ++graph.nodeOffsets_[node + 1];
+    }
+  }
+  for (uint32_t n = 0; n < nodeCount; ++n) {
+    graph.nodeOffsets_[n + 1] += graph.nodeOffsets_[n];
+  }
+  graph.nodeEdges_.resize(graph.nodeOffsets_.back());
+  std::vector<uint32_t> fill(graph.nodeOffsets_.begin(), graph.nodeOffsets_.end() - 1);
+  for (size_t slot = 0; slot < nodeOf.size(); ++slot) {
+    if (nodeOf[slot] != NO_NODE) {
+      graph.nodeEdges_[fill[nodeOf[slot]]++] = static_cast<uint32_t>(slot / 2);
+    }
+  }
+  return graph;
+}
+
+uint32_t MedialAxisGraph::sharedNode(size_t chainA, size_t chainB) const {
+  const Edge& a = edges_[chainA];
+  const Edge& b = edges_[chainB];
+  if (a.end != NO_NODE && (a.end == b.start || a.end == b.end)) {
+    return a.end;
+  }
+  if (a.start != NO_NODE && (a.start == b.start || a.start == b.end)) {
+    return a.start;
+  }
+  return NO_NODE;
+}
+
+Point2D MedialAxisGraph::position(const MedialAxisChains& chains, uint32_t node) const {
+  uint32_t chain = *incidentBegin(node);
+  return edges_[chain].start == node ? chains[chain].front() : chains[chain].back();
+}
+
+}  // namespace Geometry
+}  // namespace ChipCarving
@@ -0,0 +1,308 @@
+/**
+ * MedialAxisPartition.cpp
+ *
+ * Tiled OpenVoronoi medial axis with seam stitching
+ */
+
+#include "geometry/MedialAxisPartition.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <exception>
+#include <limits>
+#include <memory>
+#include <thread>
+#include <utility>
+
+#include "InteriorMedialAxisFilter.h"
+#include "MedialAxisPartitionPieces.h"
+#include "geometry/MedialAxisBatch.h"
+#include "geometry/VoronoiSiteOrder.h"
+#include "utils/TaskScheduler.h"
+#include "utils/TraceSpan.h"
+#include "utils/logging.h"
+
+// OpenVoronoi includes
+#include <medial_axis_walk.hpp>
+#include <voronoidiagram.hpp>
+
+namespace ChipCarving {
+namespace Geometry {
+
+namespace {
+
+constexpr double UNIT_CIRCLE_MARGIN = 0.85;         // Same fit as MedialAxisProcessor::fitUnitCircle
+constexpr double SEAM_TOLERANCE_FRACTION = 1.0e-7;  // Seam end match distance relative to the polygon extent
+constexpr double INF = std::numeric_limits<double>::infinity();
+
+struct TileResult {
+  std::vector<ChainPiece> pieces{};
+  bool valid = false;
+};
+
+// Edges that come near the tile box
+std::vector<bool> edgesNearBox(const std::vector<Point2D>& polygon, const TileBox& box, double halo) {
+  size_t n = polygon.size();
+  std::vector<bool> near(n);
+  for (size_t i = 0; i < n; ++i) {
+    const Point2D& a = polygon[i];
+    const Point2D& b = polygon[(i + 1) % n];
+    near[i] = std::max(a.x, b.x) >= box.minX - halo && std::min(a.x, b.x) <= box.maxX + halo &&
+              std::max(a.y, b.y) >= box.minY - halo && std::min(a.y, b.y) <= box.maxY + halo;
+  }
+  return near;
+}
+
+// One tile's diagram from the boundary runs near it, keeping chains inside its box
+void computeTile(const MedialAxisProcessor& prototype, const std::vector<Point2D>& polygon,
+                 const std::vector<BoundaryRun>& runs, bool interiorSide, const TileBox& box, double halo,
+                 TileResult& result) {
+  walkBoundaryRuns(prototype, polygon, runs, interiorSide,
+                   [&box, &result](const std::vector<Point2D>& points, const std::vector<double>& clearances) {
+                     clipChain(points, clearances, box, result.pieces);
+                   });
+
+  // Anything this tile keeps must be closer to the boundary than the halo is wide
+  for (const auto& piece : result.pieces) {
+    for (double clearance : piece.clearances) {
+      if (clearance >= halo) {
+        return;
+      }
+    }
+  }
+  result.valid = true;
+}
+
+}  // namespace
+
+std::vector<BoundaryRun> collectBoundaryRuns(const std::vector<bool>& keep) {
+  size_t n = keep.size();
+  bool allKept = std::all_of(keep.begin(), keep.end(), [](bool k) { return k; });
+  bool anyKept = std::any_of(keep.begin(), keep.end(), [](bool k) { return k; });
+
+  std::vector<BoundaryRun> runs;
+  if (allKept) {
+    runs.emplace_back();
+    for (size_t i = 0; i < n; ++i) {
+      runs.back().vertices.push_back(i);
+    }
+    runs.back().closed = true;
+    return runs;
+  }
+  if (!anyKept) {
+    return runs;
+  }
+
+  // Start right after an excluded edge so no run wraps around the index origin
+  size_t start = 0;
+  while (keep[start]) {
+    ++start;
+  }
+  for (size_t k = 1; k <= n; ++k) {
+    size_t edge = (start + k) % n;
+    if (!keep[edge]) {
+      continue;
+    }
+    bool continues = !runs.empty() && keep[(edge + n - 1) % n] && k > 1;
+    if (!continues) {
+      runs.emplace_back();
+      runs.back().vertices.push_back(edge);
+    }
+    runs.back().vertices.push_back((edge + 1) % n);
+  }
+  return runs;
+}
+
+bool polygonInteriorSide(const std::vector<Point2D>& polygon) {
+  // Same orientation test as computeOpenVoronoi, for the whole polygon
+  double signedArea = 0.0;
+  for (size_t i = 0; i < polygon.size(); ++i) {
+    const Point2D& a = polygon[i];
+    const Point2D& b = polygon[(i + 1) % polygon.size()];
+    signedArea += (b.x - a.x) * (b.y + a.y);
+  }
+  return !(signedArea > 0.0);
+}
+
+void walkBoundaryRuns(const MedialAxisProcessor& prototype, const std::vector<Point2D>& polygon,
+                      const std::vector<BoundaryRun>& runs, bool interiorSide, const ChainVisitor& visit) {
+  // Fit the runs' sites into OpenVoronoi's unit circle
+  double minX = INF, minY = INF, maxX = -INF, maxY = -INF;
+  size_t siteCount = 0;
+  for (const auto& run : runs) {
+    for (size_t v : run.vertices) {
+      minX = std::min(minX, polygon[v].x);
+      minY = std::min(minY, polygon[v].y);
+      maxX = std::max(maxX, polygon[v].x);
+      maxY = std::max(maxY, polygon[v].y);
+    }
+    siteCount += run.vertices.size();
+  }
+  Point2D center((minX + maxX) / 2.0, (minY + maxY) / 2.0);
+  double maxDimension = std::max(maxX - minX, maxY - minY);
+  double scale = maxDimension > 0.0 ? UNIT_CIRCLE_MARGIN / maxDimension : 1.0;
+
+  std::vector<Point2D> sites;
+  sites.reserve(siteCount);
+  for (const auto& run : runs) {
+    for (size_t v : run.vertices) {
+      sites.emplace_back((polygon[v].x - center.x) * scale, (polygon[v].y - center.y) * scale);
+    }
+  }
+
+  auto vd = std::make_unique<ovd::VoronoiDiagram>(1.0, openVoronoiBinCount(sites));
+  std::vector<int> flatIds(sites.size());
+  for (size_t i : siteInsertionOrder(sites, prototype.getSiteInsertionOrder())) {
+    flatIds[i] = vd->insert_point_site(ovd::Point(sites[i].x, sites[i].y));
+  }
+  std::vector<std::vector<int>> siteIds(runs.size());
+  size_t next = 0;
+  for (size_t r = 0; r < runs.size(); ++r) {
+    siteIds[r].assign(flatIds.begin() + next, flatIds.begin() + next + runs[r].vertices.size());
+    next += runs[r].vertices.size();
+  }
+  for (size_t r = 0; r < runs.size(); ++r) {
+    const auto& ids = siteIds[r];
+    for (size_t i = 0; i + 1 < ids.size(); ++i) {
+      vd->insert_line_site(ids[i], ids[i + 1]);
+    }
+    if (runs[r].closed) {
+      vd->insert_line_site(ids.back(), ids.front());
+    }
+  }
+
+  InteriorMedialAxisFilter filter(interiorSide, prototype.getMedialThreshold());
+  vd->filter(&filter);
+  ovd::MedialAxisWalk walker(vd->get_graph_reference(), prototype.getMedialAxisWalkPoints());
+  ovd::MedialChainList chainList = walker.walk();
+
+  std::vector<Point2D> points;
+  std::vector<double> clearances;
+  for (const auto& chain : chainList) {
+    points.clear();
+    clearances.clear();
+    for (const auto& pointList : chain) {
+      for (const auto& medialPoint : pointList) {
+        points.emplace_back(medialPoint.p.x / scale + center.x, medialPoint.p.y / scale + center.y);
+        clearances.push_back(medialPoint.clearance_radius / scale);
+      }
+    }
+    visit(points, clearances);
+  }
+}
+
+bool computePartitionedMedialAxis(const MedialAxisProcessor& prototype, const std::vector<Point2D>& polygon,
+                                  const MedialAxisPartitionOptions& options, MedialAxisResults& results) {
+  std::vector<Point2D> vertices = polygon;
+  if (vertices.size() > 3 && distance(vertices.front(), vertices.back()) < 1e-10) {
+    vertices.pop_back();
+  }
+  size_t perTile = std::max<size_t>(options.verticesPerTile, 1);
+  size_t tileCount = (vertices.size() + perTile - 1) / perTile;
+  if (tileCount < 2) {
+    return false;
+  }
+
+  double minX = INF, minY = INF, maxX = -INF, maxY = -INF;
+  for (const auto& p : vertices) {
+    minX = std::min(minX, p.x);
+    minY = std::min(minY, p.y);
+    maxX = std::max(maxX, p.x);
+    maxY = std::max(maxY, p.y);
+  }
+  double width = maxX - minX;
+  double height = maxY - minY;
+  if (width <= 0.0 || height <= 0.0) {
+    return false;
+  }
+
+  // Roughly square tiles: columns follow the aspect ratio
+  int columns = static_cast<int>(std::lround(std::sqrt(static_cast<double>(tileCount) * width / height)));
+  columns = std::max(1, std::min(columns, static_cast<int>(tileCount)));
+  int rows = static_cast<int>((tileCount + columns - 1) / columns);
+  double tileWidth = width / columns;
+  double tileHeight = height / rows;
+  double halo = options.haloFraction * std::max(tileWidth, tileHeight);
+
+  std::vector<TileBox> boxes;
+  for (int row = 0; row < rows; ++row) {
+    for (int column = 0; column < columns; ++column) {
+      TileBox box;
+      box.minX = column == 0 ? -INF : minX + column * tileWidth;
+      box.maxX = column == columns - 1 ? INF : minX + (column + 1) * tileWidth;
+      box.minY = row == 0 ? -INF : minY + row * tileHeight;
+      box.maxY = row == rows - 1 ? INF : minY + (row + 1) * tileHeight;
+      boxes.push_back(box);
+    }
+  }
+
+  bool interiorSide = polygonInteriorSide(vertices);
+
+  std::vector<TileResult> tiles(boxes.size());
+  auto computeTileAt = [&](size_t t) {
+    Utils::TraceSpan tileSpan("medialAxisTile");
+    std::vector<BoundaryRun> runs = collectBoundaryRuns(edgesNearBox(vertices, boxes[t], halo));
+    if (runs.empty()) {
+      tiles[t].valid = true;
+      return;
+    }
+    try {
+      computeTile(prototype, vertices, runs, interiorSide, boxes[t], halo, tiles[t]);
+    } catch (const std::exception& e) {
+      LOG_WARNING("Medial axis tile " << t << " failed: " << e.what());
+      tiles[t].valid = false;
+    } catch (...) {
+      tiles[t].valid = false;
+    }
+  };
+  std::atomic<size_t> nextTile{0};
+  Utils::TraceRecorder* recorder = Utils::currentTraceRecorder();
+  auto worker = [&](bool suppressLogging) {
+    SetThreadConsoleLoggingSuppressed(suppressLogging);
+    Utils::ScopedTraceRecorder trace(recorder);
+    for (size_t t = nextTile.fetch_add(1); t < boxes.size(); t = nextTile.fetch_add(1)) {
+      computeTileAt(t);
+    }
+  };
+
+  int workerCount = resolveMedialAxisWorkerCount(options.workers, boxes.size());
+  if (Utils::TaskScheduler::currentWorkerIndex() >= 0) {
+    // Inside a batch: the tiles become subtasks that the batch's idle workers steal
+    Utils::TaskScheduler::TaskGroup group;
+    double tileCost = estimateMedialAxisCost(perTile);
+    for (size_t t = 0; t < boxes.size(); ++t) {
+      group.spawn(tileCost, [&computeTileAt, t]() { computeTileAt(t); });
+    }
+    group.wait();
+  } else if (workerCount == 1) {
+    worker(false);
+  } else {
+    std::vector<std::thread> threads;
+    for (int w = 0; w < workerCount; ++w) {
+      threads.emplace_back(worker, true);
+    }
+    for (auto& thread : threads) {
+      thread.join();
+    }
+  }
+
+  std::vector<ChainPiece> pieces;
+  for (auto& tile : tiles) {
+    if (!tile.valid) {
+      return false;
+    }
+    for (auto& piece : tile.pieces) {
+      pieces.push_back(std::move(piece));
+    }
+  }
+
+  stitchPieces(pieces, SEAM_TOLERANCE_FRACTION * std::max(width, height), results);
+  LOG_DEBUG("Partitioned medial axis: " << boxes.size() << " tiles (" << columns << "x" << rows << "), "
+                                        << pieces.size() << " pieces stitched into " << results.numChains
+                                        << " chains");
+  return true;
+}
+
+}  // namespace Geometry
+}  // namespace ChipCarving
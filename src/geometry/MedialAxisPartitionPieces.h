@@ -0,0 +1,75 @@
+/**
+ * MedialAxisPartitionPieces.h
+ *
+ * Tile boxes, chain pieces and partial diagrams shared by the tiled and
+ * symmetric medial axis stages
+ * Split from MedialAxisPartition.cpp for maintainability
+ */
+
+#pragma once
+
+#include <functional>
+#include <limits>
+#include <vector>
+
+#include "geometry/MedialAxisProcessor.h"
+#include "geometry/Point2D.h"
+
+namespace ChipCarving {
+namespace Geometry {
+
+// Core area of a tile, half-open on its max sides; outer tiles extend to infinity
+struct TileBox {
+  double minX = -std::numeric_limits<double>::infinity();
+  double minY = -std::numeric_limits<double>::infinity();
+  double maxX = std::numeric_limits<double>::infinity();
+  double maxY = std::numeric_limits<double>::infinity();
+
+  bool owns(const Point2D& p) const {
+    return p.x >= minX && p.x < maxX && p.y >= minY && p.y < maxY;
+  }
+};
+
+// Part of a medial chain inside one tile; seam ends were cut by the tile box
+struct ChainPiece {
+  std::vector<Point2D> points{};
+  std::vector<double> clearances{};
+  bool seamStart = false;
+  bool seamEnd = false;
+};
+
+// Consecutive polygon vertices whose edges all go into one partial diagram
+struct BoundaryRun {
+  std::vector<size_t> vertices{};
+  bool closed = false;  // The whole polygon
+};
+
+// Runs of the polygon edges flagged in keep (edge i joins vertex i to vertex i + 1)
+std::vector<BoundaryRun> collectBoundaryRuns(const std::vector<bool>& keep);
+
+// OpenVoronoi's interior side for polygon, by the orientation test computeOpenVoronoi uses
+bool polygonInteriorSide(const std::vector<Point2D>& polygon);
+
+// Receives one world-space medial chain: its points and their clearances
+using ChainVisitor = std::function<void(const std::vector<Point2D>&, const std::vector<double>&)>;
+
+/**
+ * Build one OpenVoronoi diagram from the boundary runs of polygon and walk its
+ * medial chains, with the threshold and walk points of prototype
+ * @param interiorSide From polygonInteriorSide of the whole polygon
+ */
+void walkBoundaryRuns(const MedialAxisProcessor& prototype, const std::vector<Point2D>& polygon,
+                      const std::vector<BoundaryRun>& runs, bool interiorSide, const ChainVisitor& visit);
+
+// Append the parts of one world-space medial chain that box owns to pieces
+void clipChain(const std::vector<Point2D>& points, const std::vector<double>& clearances, const TileBox& box,
+               std::vector<ChainPiece>& pieces);
+
+/**
+ * Join pieces whose seam ends meet within tolerance, then write the chains and
+ * statistics to results (the transform is left alone)
+ */
+void stitchPieces(std::vector<ChainPiece>& pieces, double tolerance, MedialAxisResults& results);
+
+}  // namespace Geometry
+}  // namespace ChipCarving
@@ -0,0 +1,208 @@
+/**
+ * MedialAxisPartitionStitch.cpp
+ *
+ * Clipping medial chains to tile boxes and stitching them across seams
+ * Split from MedialAxisPartition.cpp for maintainability
+ */
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <unordered_map>
+#include <utility>
+
+#include "MedialAxisPartitionPieces.h"
+
+namespace ChipCarving {
+namespace Geometry {
+
+namespace {
+
+// Liang-Barsky clip of a -> b to the closed box; false if they do not meet
+bool clipSegment(const Point2D& a, const Point2D& b, const TileBox& box, double& t0, double& t1) {
+  t0 = 0.0;
+  t1 = 1.0;
+  const double p[4] = {-(b.x - a.x), b.x - a.x, -(b.y - a.y), b.y - a.y};
+  const double q[4] = {a.x - box.minX, box.maxX - a.x, a.y - box.minY, box.maxY - a.y};
+  for (int k = 0; k < 4; ++k) {
+    if (p[k] == 0.0) {
+      if (q[k] < 0.0) {
+        return false;
+      }
+      continue;
+    }
+    double t = q[k] / p[k];
+    if (p[k] < 0.0) {
+      t0 = std::max(t0, t);
+    } else {
+      t1 = std::min(t1, t);
+    }
+  }
+  return t0 <= t1;
+}
+
+Point2D lerp(const Point2D& a, const Point2D& b, double t) {
+  return Point2D(a.x + (b.x - a.x) * t, a.y + (b.y - a.y) * t);
+}
+
+}  // namespace
+
+void clipChain(const std::vector<Point2D>& points, const std::vector<double>& clearances, const TileBox& box,
+               std::vector<ChainPiece>& pieces) {
+  bool open = false;
+  bool atChainEnd = false;
+  for (size_t i = 0; i + 1 < points.size(); ++i) {
+    const Point2D& a = points[i];
+    const Point2D& b = points[i + 1];
+    double t0 = 0.0;
+    double t1 = 0.0;
+    // Segments on a seam line belong to the tile that owns their midpoint
+    bool owned = clipSegment(a, b, box, t0, t1) && t1 > t0 && box.owns(lerp(a, b, (t0 + t1) / 2.0));
+    if (!owned || (open && t0 > 0.0)) {
+      if (open) {
+        pieces.back().seamEnd = true;
+      }
+      open = false;
+      if (!owned) {
+        continue;
+      }
+    }
+
+    double r0 = clearances[i] + (clearances[i + 1] - clearances[i]) * t0;
+    double r1 = clearances[i] + (clearances[i + 1] - clearances[i]) * t1;
+    if (!open) {
+      pieces.emplace_back();
+      pieces.back().seamStart = i > 0 || t0 > 0.0;
+      pieces.back().points.push_back(lerp(a, b, t0));
+      pieces.back().clearances.push_back(r0);
+      open = true;
+    }
+    pieces.back().points.push_back(t1 < 1.0 ? lerp(a, b, t1) : b);
+    pieces.back().clearances.push_back(r1);
+    atChainEnd = i + 2 == points.size() && t1 >= 1.0;
+    if (t1 < 1.0) {
+      pieces.back().seamEnd = true;
+      open = false;
+    }
+  }
+  if (open) {
+    pieces.back().seamEnd = !atChainEnd;
+  }
+}
+
+void stitchPieces(std::vector<ChainPiece>& pieces, double tolerance, MedialAxisResults& results) {
+  const size_t UNLINKED = std::numeric_limits<size_t>::max();
+  // link[2 * piece + (atStart ? 0 : 1)] = the other end's slot
+  std::vector<size_t> link(pieces.size() * 2, UNLINKED);
+  auto endPoint = [&pieces](size_t slot) {
+    const ChainPiece& piece = pieces[slot / 2];
+    return slot % 2 == 0 ? piece.points.front() : piece.points.back();
+  };
+  auto cellOf = [tolerance](const Point2D& p) {
+    return std::make_pair(static_cast<int64_t>(std::floor(p.x / tolerance)),
+                          static_cast<int64_t>(std::floor(p.y / tolerance)));
+  };
+  auto cellKey = [](int64_t cx, int64_t cy) {
+    return static_cast<uint64_t>(cx) * 0x9E3779B97F4A7C15ULL ^ static_cast<uint64_t>(cy);
+  };
+
+  std::unordered_map<uint64_t, std::vector<size_t>> cells;
+  std::vector<size_t> seamSlots;
+  for (size_t i = 0; i < pieces.size(); ++i) {
+    if (pieces[i].seamStart) {
+      seamSlots.push_back(2 * i);
+    }
+    if (pieces[i].seamEnd) {
+      seamSlots.push_back(2 * i + 1);
+    }
+  }
+  for (size_t slot : seamSlots) {
+    auto cell = cellOf(endPoint(slot));
+    cells[cellKey(cell.first, cell.second)].push_back(slot);
+  }
+
+  // Link ends that have exactly one partner; anything ambiguous stays split
+  for (size_t slot : seamSlots) {
+    if (link[slot] != UNLINKED) {
+      continue;
+    }
+    Point2D p = endPoint(slot);
+    auto cell = cellOf(p);
+    size_t partner = UNLINKED;
+    int matches = 0;
+    for (int64_t dx = -1; dx <= 1; ++dx) {
+      for (int64_t dy = -1; dy <= 1; ++dy) {
+        auto found = cells.find(cellKey(cell.first + dx, cell.second + dy));
+        if (found == cells.end()) {
+          continue;
+        }
+        for (size_t other : found->second) {
+          if (other / 2 != slot / 2 && link[other] == UNLINKED && distance(p, endPoint(other)) <= tolerance) {
+            partner = other;
+            ++matches;
+          }
+        }
+      }
+    }
+    if (matches == 1) {
+      link[slot] = partner;
+      link[partner] = slot;
+    }
+  }
+
+  results.chains.clear();
+  results.numChains = 0;
+  results.totalPoints = 0;
+  results.totalLength = 0.0;
+  results.minClearance = std::numeric_limits<double>::infinity();
+  results.maxClearance = 0.0;
+
+  std::vector<bool> used(pieces.size(), false);
+  auto emitFrom = [&](size_t slot) {
+    // slot is the free (or arbitrary, for loops) end the chain starts at
+    results.chains.beginChain();
+    ++results.numChains;
+    bool first = true;
+    Point2D previous;
+    while (slot != UNLINKED && !used[slot / 2]) {
+      const ChainPiece& piece = pieces[slot / 2];
+      used[slot / 2] = true;
+      bool forward = slot % 2 == 0;
+      size_t count = piece.points.size();
+      for (size_t k = first ? 0 : 1; k < count; ++k) {
+        size_t index = forward ? k : count - 1 - k;
+        if (!first) {
+          results.totalLength += distance(previous, piece.points[index]);
+        }
+        results.chains.addPoint(piece.points[index], piece.clearances[index]);
+        results.minClearance = std::min(results.minClearance, piece.clearances[index]);
+        results.maxClearance = std::max(results.maxClearance, piece.clearances[index]);
+        previous = piece.points[index];
+        ++results.totalPoints;
+        first = false;
+      }
+      size_t exitSlot = forward ? slot + 1 : slot - 1;
+      slot = link[exitSlot];
+    }
+  };
+  for (size_t i = 0; i < pieces.size(); ++i) {
+    if (!used[i] && link[2 * i] == UNLINKED) {
+      emitFrom(2 * i);
+    } else if (!used[i] && link[2 * i + 1] == UNLINKED) {
+      emitFrom(2 * i + 1);
+    }
+  }
+  for (size_t i = 0; i < pieces.size(); ++i) {
+    if (!used[i]) {
+      emitFrom(2 * i);
+    }
+  }
+  if (results.totalPoints == 0) {
+    results.minClearance = 0.0;
+  }
+  results.graph = MedialAxisGraph::fromChains(results.chains, tolerance);
+}
+
+}  // namespace Geometry
+}  // namespace ChipCarving
@@ -4,19 +4,46 @@
  * Core functionality for MedialAxisProcessor
  * Split from MedialAxisProcessor.cpp for maintainability
  *
- * Note: validatePolygonForOpenVoronoi() is in MedialAxisProcessorValidation.cpp
+ * Note: fitUnitCircle() and prepareUnitPolygon() are in MedialAxisProcessorValidation.cpp
  */
 
 #include <algorithm>
 #include <cmath>
+#include <string>
 
 #include "geometry/MedialAxisProcessor.h"
+#include "MedialAxisProcessorLogging.h"
+#include "geometry/MedialAxisPartition.h"
+#include "geometry/MedialAxisSymmetry.h"
+#include "geometry/PolygonSimplification.h"
 #include "geometry/Shape.h"
-#include "utils/logging.h"
+#include "utils/TraceSpan.h"
 
 namespace ChipCarving {
 namespace Geometry {
 
+namespace {
+
+constexpr double CORNER_ANGLE = 20.0 * 3.14159265358979323846 / 180.0;  // Input simplification keeps sharper turns
+
+// First vertex repeated by the next one, allowing a closing duplicate of vertex 0; size() if none
+size_t duplicateVertexIndex(const std::vector<Point2D>& polygon) {
+  for (size_t i = 0; i + 1 < polygon.size(); ++i) {
+    size_t next = i + 1;
+
+    // Special case: Allow last vertex to match first vertex (closed polygon)
+    if (next == polygon.size() - 1 && distance(polygon[next], polygon[0]) < 1e-10) {
+      continue;
+    }
+    if (distance(polygon[i], polygon[next]) < 1e-10) {
+      return i;
+    }
+  }
+  return polygon.size();
+}
+
+}  // namespace
+
 MedialAxisProcessor::MedialAxisProcessor()
     : polygonTolerance_(0.25), medialThreshold_(0.8), verbose_(false), medialAxisWalkPoints_(0) {}
 
@@ -28,9 +55,9 @@ MedialAxisProcessor::MedialAxisProcessor(double polygonTolerance, double medialT
 
 MedialAxisResults MedialAxisProcessor::computeMedialAxis(const Shape& shape) {
   (void)shape;  // Suppress unused parameter warning - this function is deprecated
-  log("ERROR: Shape-based medial axis computation is deprecated!");
-  log("Polygonization must be done via FusionAPIAdapter::extractProfileVertices()");
-  log("This ensures geometry comes from actual Fusion profiles, not original shape parameters");
+  MEDIAL_AXIS_LOG_ERROR("ERROR: Shape-based medial axis computation is deprecated!");
+  MEDIAL_AXIS_LOG("Polygonization must be done via FusionAPIAdapter::extractProfileVertices()");
+  MEDIAL_AXIS_LOG("This ensures geometry comes from actual Fusion profiles, not original shape parameters");
 
   MedialAxisResults results;
   results.success = false;
@@ -39,125 +66,175 @@ MedialAxisResults MedialAxisProcessor::computeMedialAxis(const Shape& shape) {
 }
 
 MedialAxisResults MedialAxisProcessor::computeMedialAxis(const std::vector<Point2D>& polygon) {
+  return computeMedialAxis(polygon, {});
+}
+
+MedialAxisResults MedialAxisProcessor::computeMedialAxis(const std::vector<Point2D>& polygon,
+                                                         const std::vector<std::vector<Point2D>>& holes) {
   // Debug output to verify function is called
-  LOG_DEBUG("computeMedialAxis called with " << polygon.size() << " vertices");
+  LOG_DEBUG("computeMedialAxis called with " << polygon.size() << " vertices and " << holes.size() << " holes");
 
-  log("[MedialAxisProcessor] computeMedialAxis called with " + std::to_string(polygon.size()) + " vertices");
+  MEDIAL_AXIS_LOG("[MedialAxisProcessor] computeMedialAxis called with " << polygon.size() << " vertices");
   MedialAxisResults results;
 
   if (polygon.size() < 3) {
     results.errorMessage = "Polygon must have at least 3 vertices";
-    log("Error: " + results.errorMessage);
+    MEDIAL_AXIS_LOG_ERROR("Error: " << results.errorMessage);
     return results;
   }
-
-  // Validate polygon doesn't have duplicate consecutive vertices
-  for (size_t i = 0; i < polygon.size() - 1; ++i) {
-    size_t next = i + 1;
-
-    // Special case: Allow last vertex to match first vertex (closed polygon)
-    if (i == polygon.size() - 2 && next == polygon.size() - 1) {
-      // Check if last vertex matches first vertex
-      double distToFirst =
-          std::sqrt(std::pow(polygon[next].x - polygon[0].x, 2) + std::pow(polygon[next].y - polygon[0].y, 2));
-      if (distToFirst < 1e-10) {
-        // This is a properly closed polygon, skip this check
-        continue;
-      }
+  for (const auto& hole : holes) {
+    if (hole.size() < 3) {
+      results.errorMessage = "Hole must have at least 3 vertices";
+      MEDIAL_AXIS_LOG_ERROR("Error: " << results.errorMessage);
+      return results;
     }
+  }
 
-    double dist = std::sqrt(std::pow(polygon[i].x - polygon[next].x, 2) + std::pow(polygon[i].y - polygon[next].y, 2));
-    if (dist < 1e-10) {
-      results.errorMessage = "Polygon has duplicate consecutive vertices at index " + std::to_string(i);
-      log("Error: " + results.errorMessage);
+  // Validate loops don't have duplicate consecutive vertices
+  for (size_t loop = 0; loop <= holes.size(); ++loop) {
+    const std::vector<Point2D>& vertices = loop == 0 ? polygon : holes[loop - 1];
+    size_t index = duplicateVertexIndex(vertices);
+    if (index < vertices.size()) {
+      results.errorMessage = (loop == 0 ? "Polygon" : "Hole " + std::to_string(loop)) +
+                             " has duplicate consecutive vertices at index " + std::to_string(index);
+      MEDIAL_AXIS_LOG_ERROR("Error: " << results.errorMessage);
       return results;
     }
   }
 
-  log("Computing medial axis for polygon with " + std::to_string(polygon.size()) + " vertices");
+  // Profile strokes are tessellated far finer than polygonTolerance_; every
+  // vertex dropped here is a site OpenVoronoi does not have to insert. All
+  // loops go into one buffer, outer loop first
+  std::vector<Point2D>& sites = workspace_.loopPolygon;
+  std::vector<size_t>& loopStarts = workspace_.loopStarts;
+  sites.clear();
+  loopStarts.assign(1, 0);
+  size_t inputVertices = 0;
+  for (size_t loop = 0; loop <= holes.size(); ++loop) {
+    const std::vector<Point2D>& vertices = loop == 0 ? polygon : holes[loop - 1];
+    if (simplifyInput_) {
+      std::vector<Point2D> simplified = simplifyPolygon(vertices, polygonTolerance_, CORNER_ANGLE);
+      sites.insert(sites.end(), simplified.begin(), simplified.end());
+    } else {
+      sites.insert(sites.end(), vertices.begin(), vertices.end());
+    }
+    loopStarts.push_back(sites.size());
+    inputVertices += vertices.size();
+  }
+  if (simplifyInput_) {
+    Utils::traceCount("medialAxisSitesSimplified", static_cast<double>(inputVertices - sites.size()));
+  }
 
-  // Transform to unit circle
-  std::vector<Point2D> transformedPolygon = transformToUnitCircle(polygon, results.transform);
+  MEDIAL_AXIS_LOG("Computing medial axis for polygon with " << sites.size() << " of " << inputVertices
+                  << " vertices");
 
+  // Fit into the unit circle, then transform and validate in one pass
+  fitUnitCircle(sites, results.transform);
   if (verbose_) {
-    log("Original bounds: (" + std::to_string(results.transform.originalMin.x) + ", " +
-        std::to_string(results.transform.originalMin.y) + ") to (" + std::to_string(results.transform.originalMax.x) +
-        ", " + std::to_string(results.transform.originalMax.y) + ")");
-    log("Scale factor: " + std::to_string(results.transform.scale));
-    log("Offset: (" + std::to_string(results.transform.offset.x) + ", " + std::to_string(results.transform.offset.y) +
-        ")");
+    MEDIAL_AXIS_LOG("Original bounds: (" << results.transform.originalMin.x << ", " << results.transform.originalMin.y
+                    << ") to (" << results.transform.originalMax.x << ", " << results.transform.originalMax.y << ")");
+    MEDIAL_AXIS_LOG("Scale factor: " << results.transform.scale);
+    MEDIAL_AXIS_LOG("Offset: (" << results.transform.offset.x << ", " << results.transform.offset.y << ")");
   }
 
-  // Validate for OpenVoronoi
-  if (!validatePolygonForOpenVoronoi(transformedPolygon)) {
+  bool interiorSide = false;
+  std::vector<Point2D>& unitPolygon = workspace_.unitPolygon;
+  if (!prepareUnitPolygon(sites, loopStarts, results.transform.offset, results.transform.scale, unitPolygon,
+                          interiorSide)) {
     results.errorMessage = "Polygon failed validation for OpenVoronoi computation";
-    log("Error: " + results.errorMessage);
+    MEDIAL_AXIS_LOG_ERROR("Error: " << results.errorMessage);
     return results;
   }
 
-  // Compute medial axis using OpenVoronoi
-  if (!computeOpenVoronoi(transformedPolygon, results)) {
-    // Error already logged in computeOpenVoronoi
-    return results;
+  // Mirror-symmetric polygons are computed over one wedge when that saves enough edges. Simplified
+  // sites need not pair up across an axis, so they may be off by the simplification tolerance.
+  // Neither this nor tiling builds the full diagram the clearing offsets come from
+  if (symmetryDetection_ && holes.empty() && !clearingOffsets_.enabled()) {
+    MedialAxisSymmetryOptions options;
+    options.tolerance = simplifyInput_ ? polygonTolerance_ : 0.0;
+    if (computeSymmetricMedialAxis(*this, sites, options, results)) {
+      results.success = true;
+      pruneSpurs(results);
+      MEDIAL_AXIS_LOG("Symmetric medial axis computation successful");
+      return results;
+    }
   }
 
-  results.success = true;
-  log("Medial axis computation successful");
-
-  return results;
-}
-
-std::vector<Point2D> MedialAxisProcessor::transformToUnitCircle(const std::vector<Point2D>& polygon,
-                                                                TransformParams& transform) {
-  if (polygon.empty()) {
-    log("Warning: transformToUnitCircle called with empty polygon");
-    return polygon;
+  // Very large polygons are computed tile by tile when the partition holds
+  if (partitionMinVertices_ > 0 && holes.empty() && sites.size() >= partitionMinVertices_ &&
+      !clearingOffsets_.enabled()) {
+    MedialAxisPartitionOptions options;
+    options.workers = partitionWorkers_;
+    if (computePartitionedMedialAxis(*this, sites, options, results)) {
+      results.success = true;
+      pruneSpurs(results);
+      MEDIAL_AXIS_LOG("Partitioned medial axis computation successful");
+      return results;
+    }
+    MEDIAL_AXIS_LOG("Partitioned medial axis rejected, computing the full diagram");
   }
 
-  // Find bounding box
-  transform.originalMin = polygon[0];
-  transform.originalMax = polygon[0];
-
-  for (const auto& point : polygon) {
-    transform.originalMin.x = std::min(transform.originalMin.x, point.x);
-    transform.originalMin.y = std::min(transform.originalMin.y, point.y);
-    transform.originalMax.x = std::max(transform.originalMax.x, point.x);
-    transform.originalMax.y = std::max(transform.originalMax.y, point.y);
+  // Compute medial axis using OpenVoronoi, reworking the polygon down the
+  // retry ladder if the diagram cannot be built
+  std::vector<MedialAxisRetry> rungs = {MedialAxisRetry::NONE};
+  if (retryOnFailure_) {
+    const auto& ladder = medialAxisRetryLadder();
+    rungs.insert(rungs.end(), ladder.begin(), ladder.end());
   }
-
-  // Calculate center and max dimension
-  double centerX = (transform.originalMin.x + transform.originalMax.x) / 2.0;
-  double centerY = (transform.originalMin.y + transform.originalMax.y) / 2.0;
-  double width = transform.originalMax.x - transform.originalMin.x;
-  double height = transform.originalMax.y - transform.originalMin.y;
-  double maxDimension = std::max(width, height);
-
-  // Apply safety margin to ensure we stay within unit circle
-  const double SAFETY_MARGIN = 0.85;  // Use 85% of unit circle
-  transform.scale = (maxDimension > 0) ? SAFETY_MARGIN / maxDimension : 1.0;
-  transform.offset.x = centerX;
-  transform.offset.y = centerY;
-
-  // Transform each point
-  std::vector<Point2D> transformed;
-  transformed.reserve(polygon.size());
-
-  for (const auto& point : polygon) {
-    Point2D transformedPoint;
-    transformedPoint.x = (point.x - centerX) * transform.scale;
-    transformedPoint.y = (point.y - centerY) * transform.scale;
-    transformed.push_back(transformedPoint);
+  double baseScale = results.transform.scale;
+  std::vector<Point2D>& attemptPolygon = workspace_.attemptPolygon;
+  std::vector<size_t>& attemptStarts = workspace_.attemptLoopStarts;
+  for (MedialAxisRetry retry : rungs) {
+    results.transform.scale = baseScale;
+    bool attemptInterior = interiorSide;
+    if (retry != MedialAxisRetry::NONE) {
+      // Reworked outlines are checked again: perturbing or thinning can break them
+      std::vector<Point2D> reworked =
+          retryPolygon(unitPolygon, loopStarts, retry, results.transform.scale, attemptStarts);
+      if (reworked.empty() ||
+          !prepareUnitPolygon(reworked, attemptStarts, Point2D(0, 0), 1.0, attemptPolygon, attemptInterior)) {
+        continue;
+      }
+    }
+    bool plain = retry == MedialAxisRetry::NONE;
+    const std::vector<Point2D>& sitesToInsert = plain ? unitPolygon : attemptPolygon;
+
+    results.chains.clear();
+    results.clearingLoops.clear();
+    results.numChains = 0;
+    results.totalPoints = 0;
+    results.totalLength = 0.0;
+    results.errorMessage.clear();
+    MedialAxisAttempt attempt;
+    attempt.retry = retry;
+    // Errors are already logged in computeOpenVoronoi
+    attempt.success = computeOpenVoronoi(sitesToInsert, plain ? loopStarts : attemptStarts, attemptInterior, results);
+    attempt.errorMessage = results.errorMessage;
+    results.attempts.push_back(attempt);
+    if (attempt.success) {
+      results.success = true;
+      if (retry != MedialAxisRetry::NONE) {
+        LOG_WARNING("Medial axis succeeded after retry (" << medialAxisRetryName(retry) << ")");
+      }
+      pruneSpurs(results);
+      MEDIAL_AXIS_LOG("Medial axis computation successful");
+      return results;
+    }
   }
 
-  // Verify all points are within unit circle
-  for (const auto& point : transformed) {
-    double distance = std::sqrt(point.x * point.x + point.y * point.y);
-    if (distance > 1.0) {
-      log("Warning: Transformed point distance " + std::to_string(distance) + " exceeds unit circle");
-    }
+  results.errorMessage = results.attempts.front().errorMessage;
+  if (results.attempts.size() > 1) {
+    results.errorMessage += " (" + std::to_string(results.attempts.size() - 1) + " retries also failed)";
   }
+  return results;
+}
 
-  return transformed;
+void MedialAxisProcessor::pruneSpurs(MedialAxisResults& results) const {
+  size_t pruned = pruneMedialAxisSpurs(results, spurPruning_);
+  if (pruned > 0) {
+    Utils::traceCount("medialAxisSpursPruned", static_cast<double>(pruned));
+    MEDIAL_AXIS_LOG("Pruned " << pruned << " medial axis spurs");
+  }
 }
 
 Point2D MedialAxisProcessor::transformFromUnitCircle(const Point2D& unitPoint, const TransformParams& transform) {
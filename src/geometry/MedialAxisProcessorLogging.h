@@ -0,0 +1,15 @@
+/**
+ * MedialAxisProcessorLogging.h
+ *
+ * Tagged, level-checked logging for the MedialAxisProcessor sources
+ * Messages are stream expressions evaluated only when the level is enabled, so
+ * disabled per-vertex and per-site logging costs one branch.
+ */
+
+#pragma once
+
+#include "utils/logging.h"
+
+#define MEDIAL_AXIS_LOG(msg) LOG_INFO("[MedialAxisProcessor] " << msg)
+
+#define MEDIAL_AXIS_LOG_ERROR(msg) LOG_ERROR("[MedialAxisProcessor] " << msg)
@@ -1,19 +1,30 @@
 /**
  * MedialAxisProcessorValidation.cpp
  *
- * Polygon validation for MedialAxisProcessor
+ * Polygon preparation for MedialAxisProcessor: the unit circle transform and
+ * the edge, circle, area and winding checks run as one pass over a reused
+ * buffer, followed by a sweep-line self-intersection test over all loops
  * Split from MedialAxisProcessorCore.cpp for maintainability
  */
 
+#include <algorithm>
 #include <cmath>
 #include <string>
 
+#include "MedialAxisProcessorLogging.h"
 #include "geometry/MedialAxisProcessor.h"
+#include "geometry/PointKernels.h"
 
 namespace ChipCarving {
 namespace Geometry {
 namespace {
 
+constexpr double SAFETY_MARGIN = 0.85;    // Use 85% of unit circle
+constexpr double DEGENERATE_EDGE = 1e-10;  // Shortest edge accepted (unit circle units)
+constexpr double MIN_AREA = 1e-10;         // Smallest polygon area accepted (unit circle units)
+constexpr double SWEEP_TOLERANCE = 1e-9;   // Bounding box slack so near-touching edges are still tested
+constexpr int MAX_PROBLEMS_TO_LOG = 5;
+
 // Helper function to check if two line segments intersect
 // Based on the orientation method
 bool doSegmentsIntersect(const Point2D& p1, const Point2D& q1, const Point2D& p2, const Point2D& q2) {
@@ -45,149 +56,191 @@ bool doSegmentsIntersect(const Point2D& p1, const Point2D& q1, const Point2D& p2
          (o4 == 0 && onSegment(p2, q1, q2));    // q1 lies on p2q2
 }
 
-}  // namespace
-
-bool MedialAxisProcessor::validatePolygonForOpenVoronoi(const std::vector<Point2D>& polygon) {
-  log("=== POLYGON VALIDATION START ===");
-  log("Validating polygon with " + std::to_string(polygon.size()) + " vertices for OpenVoronoi");
-
-  if (polygon.size() < 3) {
-    log("ERROR: Polygon must have at least 3 vertices, got " + std::to_string(polygon.size()));
-    return false;
-  }
-
-  // Check if polygon is closed (last vertex should NOT equal first for our algorithm)
-  // Fusion gives us properly closed polygons without duplicate vertices
-  bool lastEqualsFirst = false;
-  if (polygon.size() > 3) {
-    double dist = std::sqrt(std::pow(polygon.back().x - polygon.front().x, 2) +
-                            std::pow(polygon.back().y - polygon.front().y, 2));
-    lastEqualsFirst = (dist < 1e-10);
-  }
-
-  if (lastEqualsFirst) {
-    log("Warning: Last vertex equals first vertex - polygon appears to have duplicate closing vertex");
-    log("This may indicate improper polygon construction");
+/**
+ * Number of intersecting non-adjacent edge pairs over all loops. Edges are
+ * swept in order of their left end and only tested against edges whose x range
+ * is still open, so profiles cost O(n log n) plus the overlapping pairs
+ * instead of all pairs.
+ */
+int countSelfIntersections(const std::vector<Point2D>& polygon, const std::vector<size_t>& loopStarts,
+                           MedialAxisWorkspace& workspace) {
+  size_t n = polygon.size();
+  std::vector<size_t>& order = workspace.edgeOrder;
+  std::vector<EdgeBounds>& bounds = workspace.edgeBounds;
+  order.resize(n);
+  bounds.resize(n);
+  for (size_t loop = 0; loop + 1 < loopStarts.size(); ++loop) {
+    for (size_t i = loopStarts[loop]; i < loopStarts[loop + 1]; ++i) {
+      size_t next = i + 1 < loopStarts[loop + 1] ? i + 1 : loopStarts[loop];
+      const Point2D& a = polygon[i];
+      const Point2D& b = polygon[next];
+      bounds[i].minX = std::min(a.x, b.x) - SWEEP_TOLERANCE;
+      bounds[i].maxX = std::max(a.x, b.x) + SWEEP_TOLERANCE;
+      bounds[i].minY = std::min(a.y, b.y) - SWEEP_TOLERANCE;
+      bounds[i].maxY = std::max(a.y, b.y) + SWEEP_TOLERANCE;
+      bounds[i].next = next;
+      order[i] = i;
+    }
   }
+  std::sort(order.begin(), order.end(), [&bounds](size_t a, size_t b) { return bounds[a].minX < bounds[b].minX; });
 
-  // Check for self-intersections
-  // We need to test each edge against every non-adjacent edge
-  log("Checking for self-intersections...");
-  size_t numEdges = polygon.size();
   int intersectionCount = 0;
-  const int MAX_INTERSECTIONS_TO_LOG = 5;
-
-  for (size_t i = 0; i < numEdges; ++i) {
-    Point2D p1 = polygon[i];
-    Point2D q1 = polygon[(i + 1) % numEdges];
-
-    // Test against all non-adjacent edges
-    for (size_t j = i + 2; j < numEdges; ++j) {
-      // Special case: don't test edge i against edge (numEdges-1) when i = 0
-      // since they are adjacent in a closed polygon
-      if (i == 0 && j == numEdges - 1) {
-        continue;
+  std::vector<size_t>& active = workspace.activeEdges;
+  active.clear();
+  for (size_t i : order) {
+    size_t kept = 0;
+    for (size_t j : active) {
+      if (bounds[j].maxX < bounds[i].minX) {
+        continue;  // Closed before this edge starts
       }
+      active[kept++] = j;
 
-      Point2D p2 = polygon[j];
-      Point2D q2 = polygon[(j + 1) % numEdges];
-
+      if (bounds[i].next == j || bounds[j].next == i || bounds[j].maxY < bounds[i].minY ||
+          bounds[i].maxY < bounds[j].minY) {
+        continue;  // Adjacent edges share a vertex; disjoint y ranges cannot meet
+      }
+      size_t first = std::min(i, j);
+      size_t second = std::max(i, j);
+      const Point2D& p1 = polygon[first];
+      const Point2D& q1 = polygon[bounds[first].next];
+      const Point2D& p2 = polygon[second];
+      const Point2D& q2 = polygon[bounds[second].next];
       if (doSegmentsIntersect(p1, q1, p2, q2)) {
         intersectionCount++;
-        if (intersectionCount <= MAX_INTERSECTIONS_TO_LOG) {
-          log("Self-intersection detected: Edge " + std::to_string(i) + "-" + std::to_string((i + 1) % numEdges) +
-              " intersects edge " + std::to_string(j) + "-" + std::to_string((j + 1) % numEdges));
-          log("  Edge 1: (" + std::to_string(p1.x) + ", " + std::to_string(p1.y) + ") to (" + std::to_string(q1.x) +
-              ", " + std::to_string(q1.y) + ")");
-          log("  Edge 2: (" + std::to_string(p2.x) + ", " + std::to_string(p2.y) + ") to (" + std::to_string(q2.x) +
-              ", " + std::to_string(q2.y) + ")");
-        } else if (intersectionCount == MAX_INTERSECTIONS_TO_LOG + 1) {
-          log("... (additional self-intersections not logged)");
+        if (intersectionCount <= MAX_PROBLEMS_TO_LOG) {
+          MEDIAL_AXIS_LOG("Self-intersection detected: Edge " << first << "-" << bounds[first].next
+                          << " intersects edge " << second << "-" << bounds[second].next);
+          MEDIAL_AXIS_LOG("  Edge 1: (" << p1.x << ", " << p1.y << ") to (" << q1.x << ", " << q1.y << ")");
+          MEDIAL_AXIS_LOG("  Edge 2: (" << p2.x << ", " << p2.y << ") to (" << q2.x << ", " << q2.y << ")");
+        } else if (intersectionCount == MAX_PROBLEMS_TO_LOG + 1) {
+          MEDIAL_AXIS_LOG("... (additional self-intersections not logged)");
         }
       }
     }
+    active.resize(kept);
+    active.push_back(i);
   }
+  return intersectionCount;
+}
 
-  if (intersectionCount > 0) {
-    log("ERROR: Polygon has " + std::to_string(intersectionCount) +
-        " self-intersections - OpenVoronoi requires simple polygons");
-    return false;
+// Even-odd test of point against loop [first, last) of polygon
+bool insideLoop(const Point2D& point, const std::vector<Point2D>& polygon, size_t first, size_t last) {
+  bool inside = false;
+  for (size_t i = first, j = last - 1; i < last; j = i++) {
+    const Point2D& a = polygon[i];
+    const Point2D& b = polygon[j];
+    if ((a.y > point.y) != (b.y > point.y) && point.x < (b.x - a.x) * (point.y - a.y) / (b.y - a.y) + a.x) {
+      inside = !inside;
+    }
   }
+  return inside;
+}
 
-  log("Self-intersection check passed - no self-intersections detected");
+}  // namespace
 
-  // Check for degenerate edges (zero length)
-  log("Checking for degenerate edges...");
-  int degenerateCount = 0;
-  for (size_t i = 0; i < numEdges; ++i) {
-    Point2D p1 = polygon[i];
-    Point2D p2 = polygon[(i + 1) % numEdges];
-    double edgeLength = std::sqrt(std::pow(p2.x - p1.x, 2) + std::pow(p2.y - p1.y, 2));
-
-    if (edgeLength < 1e-10) {
-      log("ERROR: Degenerate edge " + std::to_string(i) + " between (" + std::to_string(p1.x) + ", " +
-          std::to_string(p1.y) + ") and (" + std::to_string(p2.x) + ", " + std::to_string(p2.y) +
-          ") length: " + std::to_string(edgeLength));
-      degenerateCount++;
-      if (degenerateCount >= 3) {
-        log("... (additional degenerate edges not logged)");
-        return false;
-      }
-    }
-  }
+void MedialAxisProcessor::fitUnitCircle(const std::vector<Point2D>& polygon, TransformParams& transform) {
+  fitUnitCircleTransform(polygon, transform);
+}
 
-  if (degenerateCount > 0) {
-    log("ERROR: " + std::to_string(degenerateCount) + " degenerate edges detected");
-    return false;
-  }
+void fitUnitCircleTransform(const std::vector<Point2D>& polygon, TransformParams& transform) {
+  PointBounds bounds = pointBounds(polygon.data(), polygon.size());
+  transform.originalMin = bounds.min;
+  transform.originalMax = bounds.max;
+
+  double width = transform.originalMax.x - transform.originalMin.x;
+  double height = transform.originalMax.y - transform.originalMin.y;
+  double maxDimension = std::max(width, height);
+  transform.scale = (maxDimension > 0) ? SAFETY_MARGIN / maxDimension : 1.0;
+  transform.offset.x = (transform.originalMin.x + transform.originalMax.x) / 2.0;
+  transform.offset.y = (transform.originalMin.y + transform.originalMax.y) / 2.0;
+}
 
-  log("Degenerate edge check passed - all edges have sufficient length");
+bool MedialAxisProcessor::prepareUnitPolygon(const std::vector<Point2D>& polygon, const std::vector<size_t>& loopStarts,
+                                             const Point2D& offset, double scale, std::vector<Point2D>& unitPolygon,
+                                             bool& interiorSide) {
+  size_t n = polygon.size();
+  size_t loopCount = loopStarts.size() - 1;
+  MEDIAL_AXIS_LOG("Preparing polygon with " << n << " vertices in " << loopCount << " loop(s) for OpenVoronoi");
 
-  // Check if all points are within unit circle
-  log("Checking if all points are within unit circle...");
+  int degenerateCount = 0;
   int outsideCount = 0;
-  for (size_t i = 0; i < polygon.size(); ++i) {
-    double distance = std::sqrt(polygon[i].x * polygon[i].x + polygon[i].y * polygon[i].y);
-    if (distance > 1.0) {
-      log("ERROR: Point " + std::to_string(i) + " at (" + std::to_string(polygon[i].x) + ", " +
-          std::to_string(polygon[i].y) + ") is outside unit circle (distance: " + std::to_string(distance) + ")");
-      outsideCount++;
-      if (outsideCount >= 3) {
-        log("... (additional points outside unit circle not logged)");
-        return false;
+  auto checkEdge = [&](size_t index, const Point2D& a, const Point2D& b, double& shoelace) {
+    shoelace += a.x * b.y - b.x * a.y;
+    double edgeLength = distance(a, b);
+    if (edgeLength < DEGENERATE_EDGE && ++degenerateCount <= MAX_PROBLEMS_TO_LOG) {
+      MEDIAL_AXIS_LOG_ERROR("ERROR: Degenerate edge " << index << " between (" << a.x << ", " << a.y << ") and ("
+                            << b.x << ", " << b.y << ") length: " << edgeLength);
+    }
+  };
+
+  // Transform all vertices at once, then check each, the edge ending at it and its shoelace term in one pass
+  unitPolygon.resize(n);
+  transformPoints(polygon.data(), n, offset, scale, unitPolygon.data());
+  double outerShoelace = 0.0;
+  for (size_t loop = 0; loop < loopCount; ++loop) {
+    size_t first = loopStarts[loop];
+    size_t last = loopStarts[loop + 1];
+    if (last - first < 3) {
+      MEDIAL_AXIS_LOG_ERROR("ERROR: Loop " << loop << " must have at least 3 vertices, got " << last - first);
+      return false;
+    }
+
+    double shoelace = 0.0;
+    for (size_t i = first; i < last; ++i) {
+      const Point2D& point = unitPolygon[i];
+      double radius = std::sqrt(point.x * point.x + point.y * point.y);
+      if (radius > 1.0 && ++outsideCount <= MAX_PROBLEMS_TO_LOG) {
+        MEDIAL_AXIS_LOG_ERROR("ERROR: Point " << i << " at (" << point.x << ", " << point.y
+                              << ") is outside unit circle (distance: " << radius << ")");
+      }
+      if (i > first) {
+        checkEdge(i - 1, unitPolygon[i - 1], point, shoelace);
       }
     }
+    checkEdge(last - 1, unitPolygon[last - 1], unitPolygon[first], shoelace);
+
+    double area = std::abs(shoelace) / 2.0;
+    if (area < MIN_AREA) {
+      MEDIAL_AXIS_LOG_ERROR("ERROR: Loop " << loop << " has near-zero area (" << area
+                            << ") - points may be collinear or nearly collinear");
+      return false;
+    }
+    if (loop == 0) {
+      outerShoelace = shoelace;
+    } else if ((shoelace < 0.0) == (outerShoelace < 0.0)) {
+      // Holes must wind against the outer loop so the interior filter keeps the same side of every line site
+      std::reverse(unitPolygon.begin() + first, unitPolygon.begin() + last);
+    }
   }
 
+  if (degenerateCount > 0) {
+    MEDIAL_AXIS_LOG_ERROR("ERROR: " << degenerateCount << " degenerate edges detected");
+    return false;
+  }
   if (outsideCount > 0) {
-    log("ERROR: " + std::to_string(outsideCount) + " points are outside unit circle");
+    MEDIAL_AXIS_LOG_ERROR("ERROR: " << outsideCount << " points are outside unit circle");
     return false;
   }
 
-  log("Unit circle check passed - all points within circle");
-
-  // Check for zero-area polygon (collinear points)
-  // Use the shoelace formula to compute signed area
-  log("Checking for degenerate (zero-area) polygon...");
-  double signedArea = 0.0;
-  for (size_t i = 0; i < polygon.size(); ++i) {
-    size_t j = (i + 1) % polygon.size();
-    signedArea += polygon[i].x * polygon[j].y;
-    signedArea -= polygon[j].x * polygon[i].y;
-  }
-  signedArea = std::abs(signedArea) / 2.0;
-
-  // For a polygon scaled to unit circle, a reasonable minimum area threshold
-  // is based on the minimum edge length squared
-  double minArea = 1e-10;
-  if (signedArea < minArea) {
-    log("ERROR: Polygon has near-zero area (" + std::to_string(signedArea) +
-        ") - points may be collinear or nearly collinear");
+  int intersectionCount = countSelfIntersections(unitPolygon, loopStarts, workspace_);
+  if (intersectionCount > 0) {
+    MEDIAL_AXIS_LOG_ERROR("ERROR: Polygon has " << intersectionCount
+                          << " self-intersections - OpenVoronoi requires simple polygons");
     return false;
   }
-  log("Area check passed - polygon has sufficient area: " + std::to_string(signedArea));
 
-  log("=== POLYGON VALIDATION PASSED ===");
+  // With no crossings, one vertex tells whether a whole hole lies inside the outer loop
+  for (size_t loop = 1; loop < loopCount; ++loop) {
+    if (!insideLoop(unitPolygon[loopStarts[loop]], unitPolygon, 0, loopStarts[1])) {
+      MEDIAL_AXIS_LOG_ERROR("ERROR: Hole " << loop << " lies outside the outer loop");
+      return false;
+    }
+  }
+
+  // A negative shoelace sum is a clockwise outline; its interior is on the other side
+  interiorSide = !(outerShoelace < 0.0);
+  MEDIAL_AXIS_LOG("Polygon prepared: " << (outerShoelace < 0.0 ? "clockwise" : "counter-clockwise")
+                  << " outer loop, " << loopCount - 1 << " hole(s)");
   return true;
 }
 
@@ -9,13 +9,20 @@
 #include <cmath>
 #include <limits>
 #include <memory>
+#include <utility>
+#include <vector>
 
+#include "InteriorMedialAxisFilter.h"
+#include "MedialAxisProcessorLogging.h"
 #include "geometry/MedialAxisProcessor.h"
-#include "utils/logging.h"
+#include "geometry/VoronoiSiteOrder.h"
+#include "utils/TraceSpan.h"
+#include "utils/UnitConversion.h"
 
 // OpenVoronoi includes
 #include <medial_axis_filter.hpp>
 #include <medial_axis_walk.hpp>
+#include <offset.hpp>
 #include <polygon_interior_filter.hpp>
 #include <version.hpp>
 #include <voronoidiagram.hpp>
@@ -23,75 +30,124 @@
 namespace ChipCarving {
 namespace Geometry {
 
-std::vector<SampledMedialPath> MedialAxisProcessor::getSampledPaths(const MedialAxisResults& results, double spacing) {
-  if (!results.success) {
-    log("Warning: Cannot sample paths from failed medial axis computation");
-    return {};
+namespace {
+
+constexpr double PI = 3.14159265358979323846;
+constexpr int MAX_CLEARING_OFFSETS = 1000;  // Offset distances traced per diagram at most
+
+// Arc from `from` (not appended) to `to` about center, as chords within tolerance of it
+void appendArc(const Point2D& from, const Point2D& to, const Point2D& center, double radius, bool clockwise,
+               double tolerance, std::vector<Point2D>& points) {
+  double start = std::atan2(from.y - center.y, from.x - center.x);
+  double end = std::atan2(to.y - center.y, to.x - center.x);
+  double sweep = clockwise ? start - end : end - start;
+  if (sweep <= 0.0) {
+    sweep += 2.0 * PI;  // Also a whole circle, which starts and ends on the same point
+  }
+  double step = tolerance < radius ? 2.0 * std::acos(1.0 - tolerance / radius) : PI / 2.0;
+  int segments = std::max(1, static_cast<int>(std::ceil(sweep / step)));
+  double direction = clockwise ? -1.0 : 1.0;
+  for (int k = 1; k < segments; ++k) {
+    double angle = start + direction * sweep * k / segments;
+    points.emplace_back(center.x + radius * std::cos(angle), center.y + radius * std::sin(angle));
   }
+  points.push_back(to);
+}
 
-  // The chains in results are already in world coordinates (cm from
-  // computeMedialAxisFromProfile) We just need to convert from cm to mm for the
-  // sampling function
-  std::vector<std::vector<Point2D>> worldChains;
-  std::vector<std::vector<double>> worldClearances;
-
-  log("Converting " + std::to_string(results.chains.size()) + " chains from world cm to world mm");
-
-  for (size_t i = 0; i < results.chains.size(); ++i) {
-    std::vector<Point2D> worldChain;
-    std::vector<double> worldClearance;
-
-    for (size_t j = 0; j < results.chains[i].size(); ++j) {
-      // Results are already in world coordinates (cm), just convert to mm
-      Point2D worldPointMm(results.chains[i][j].x * 10.0, results.chains[i][j].y * 10.0);
-      worldChain.push_back(worldPointMm);
-
-      // Clearance radius is also in world coordinates (cm), convert to mm
-      double worldRadiusMm = results.clearanceRadii[i][j] * 10.0;
-      worldClearance.push_back(worldRadiusMm);
-
-      // Log first few points for debugging
-      if (i == 0 && j < 3) {
-        log("Chain 0, point " + std::to_string(j) + ": world cm (" + std::to_string(results.chains[i][j].x) + ", " +
-            std::to_string(results.chains[i][j].y) + ") -> world mm (" + std::to_string(worldPointMm.x) + ", " +
-            std::to_string(worldPointMm.y) + "), clearance " + std::to_string(worldRadiusMm) + " mm");
+/**
+ * Offset loops of an interior-filtered diagram, from offsets.firstOffset in by
+ * offsets.stepover until a distance has none left, converted to world coordinates
+ * @param tolerance Arc tessellation error (world units)
+ */
+void traceClearingLoops(ovd::HEGraph& graph, const ClearingOffsets& offsets, double tolerance,
+                        const TransformParams& transform, std::vector<ClearingLoop>& loops) {
+  ovd::Offset offsetter(graph);
+  double unitTolerance = tolerance * transform.scale;
+  std::vector<Point2D> unitPoints;
+  for (int k = 0; k < MAX_CLEARING_OFFSETS; ++k) {
+    double offset = offsets.firstOffset + offsets.stepover * k;
+    ovd::OffsetLoops offsetLoops = offsetter.offset(offset * transform.scale);
+    if (offsetLoops.empty()) {
+      return;
+    }
+
+    for (const auto& offsetLoop : offsetLoops) {
+      // The first vertex only places the start; every later one ends a line (r < 0) or an arc
+      unitPoints.clear();
+      for (const auto& vertex : offsetLoop.vertices) {
+        Point2D point(vertex.p.x, vertex.p.y);
+        if (unitPoints.empty() || vertex.r <= 0.0) {
+          unitPoints.push_back(point);
+        } else {
+          appendArc(unitPoints.back(), point, Point2D(vertex.c.x, vertex.c.y), vertex.r, vertex.cw, unitTolerance,
+                    unitPoints);
+        }
       }
+      if (unitPoints.size() > 1 && distance(unitPoints.front(), unitPoints.back()) < 1e-10) {
+        unitPoints.pop_back();
+      }
+      if (unitPoints.size() < 2) {
+        continue;
+      }
+
+      ClearingLoop loop;
+      loop.offset = offset;
+      loop.points.reserve(unitPoints.size());
+      for (const auto& unitPoint : unitPoints) {
+        loop.points.emplace_back(unitPoint.x / transform.scale + transform.offset.x,
+                                 unitPoint.y / transform.scale + transform.offset.y);
+      }
+      loops.push_back(std::move(loop));
     }
+  }
+  MEDIAL_AXIS_LOG("Clearing offsets stopped after " << MAX_CLEARING_OFFSETS << " distances");
+}
 
-    worldChains.push_back(worldChain);
-    worldClearances.push_back(worldClearance);
+}  // namespace
+
+std::vector<SampledMedialPath> MedialAxisProcessor::getSampledPaths(const MedialAxisResults& results, double spacing) {
+  std::vector<SampledMedialPath> sampledPaths;
+  getSampledPaths(results, spacing, sampledPaths);
+  return sampledPaths;
+}
+
+void MedialAxisProcessor::getSampledPaths(const MedialAxisResults& results, double spacing,
+                                          std::vector<SampledMedialPath>& sampledPaths) {
+  if (!results.success) {
+    MEDIAL_AXIS_LOG("Warning: Cannot sample paths from failed medial axis computation");
+    return;
   }
 
-  return sampleMedialAxisPaths(worldChains, worldClearances, spacing);
+  // The chains in results are already in world coordinates (cm from
+  // computeMedialAxisFromProfile); the sampler scales them to mm as it reads them
+  MEDIAL_AXIS_LOG("Sampling " << results.chains.size() << " chains from world cm to world mm");
+  sampleMedialAxisChains(results.chains, Utils::fusionLengthToMm(1.0), spacing, sampledPaths);
 }
 
 bool MedialAxisProcessor::computeOpenVoronoi(const std::vector<Point2D>& transformedPolygon,
+                                             const std::vector<size_t>& loopStarts, bool interiorSide,
                                              MedialAxisResults& results) {
   try {
-    // Validate polygon before processing
-    if (!validatePolygonForOpenVoronoi(transformedPolygon)) {
-      results.errorMessage = "Invalid polygon for OpenVoronoi processing";
-      return false;
-    }
-
     // Create VoronoiDiagram using smart pointer for automatic cleanup
     int numSites = static_cast<int>(transformedPolygon.size());
-    int bins = std::max(10, static_cast<int>(std::sqrt(numSites)));
+    int bins = openVoronoiBinCount(transformedPolygon);
     auto vd = std::make_unique<ovd::VoronoiDiagram>(1.0, bins);
 
     // Don't enable debug mode - it's too verbose
     // vd->debug_on();
 
-    log("OpenVoronoi version: " + std::string(ovd::version()));
-    log("Processing polygon with " + std::to_string(numSites) + " vertices, using " + std::to_string(bins) + " bins");
+    MEDIAL_AXIS_LOG("OpenVoronoi version: " << ovd::version());
+    MEDIAL_AXIS_LOG("Processing polygon with " << numSites << " vertices, using " << bins << " bins");
 
-    // Insert point sites
+    // Insert point sites, in siteOrder_ rather than boundary order; pointIds
+    // stays indexed by polygon vertex for the line sites
     // Following Fusion convention: polygons are implicitly closed, no duplicate
     // vertices
-    std::vector<int> pointIds;
-    pointIds.reserve(numSites);
+    std::vector<int>& pointIds = workspace_.pointIds;
+    pointIds.resize(transformedPolygon.size());
+    siteInsertionOrder(transformedPolygon, siteOrder_, workspace_.insertionOrder, workspace_.hilbertKeys);
 
-    for (size_t i = 0; i < transformedPolygon.size(); ++i) {
+    for (size_t i : workspace_.insertionOrder) {
       const auto& point = transformedPolygon[i];
       ovd::Point ovdPoint(point.x, point.y);
 
@@ -107,28 +163,29 @@ bool MedialAxisProcessor::computeOpenVoronoi(const std::vector<Point2D>& transfo
         LOG_DEBUG("Successfully inserted point " << i << " with ID " << id);
       }
 
-      pointIds.push_back(id);
+      pointIds[i] = id;
 
       if (verbose_) {
-        log("Added point " + std::to_string(id) + ": (" + std::to_string(point.x) + ", " + std::to_string(point.y) +
-            ")");
+        MEDIAL_AXIS_LOG("Added point " << id << ": (" << point.x << ", " << point.y << ")");
       }
     }
 
-    // Insert line sites (connecting consecutive points)
-    // Following Fusion convention: all polygons are implicitly closed
+    // Insert line sites (connecting consecutive points of each loop)
+    // Following Fusion convention: all loops are implicitly closed
     size_t numLines = pointIds.size();
-    log("Will insert " + std::to_string(numLines) + " line sites to form closed polygon");
+    MEDIAL_AXIS_LOG("Will insert " << numLines << " line sites to form " << loopStarts.size() - 1 << " closed loop(s)");
 
-    log("About to insert " + std::to_string(numLines) + " line sites");
+    MEDIAL_AXIS_LOG("About to insert " << numLines << " line sites");
 
+    size_t loop = 0;
     for (size_t i = 0; i < numLines; ++i) {
       int startId = pointIds[i];
       int endId;
 
-      if (i == numLines - 1) {
-        // Last line connects back to first
-        endId = pointIds[0];
+      if (i + 1 == loopStarts[loop + 1]) {
+        // Last line of a loop connects back to its first point
+        endId = pointIds[loopStarts[loop]];
+        ++loop;
       } else {
         // Normal case: connect to next point
         endId = pointIds[i + 1];
@@ -139,7 +196,7 @@ bool MedialAxisProcessor::computeOpenVoronoi(const std::vector<Point2D>& transfo
         LOG_DEBUG("About to insert line site " << i << ": " << startId << " -> " << endId);
       }
 
-      log("Inserting line site " + std::to_string(i) + ": " + std::to_string(startId) + " -> " + std::to_string(endId));
+      MEDIAL_AXIS_LOG("Inserting line site " << i << ": " << startId << " -> " << endId);
 
       try {
         vd->insert_line_site(startId, endId);
@@ -149,49 +206,53 @@ bool MedialAxisProcessor::computeOpenVoronoi(const std::vector<Point2D>& transfo
           LOG_DEBUG("Successfully inserted line site " << i);
         }
 
-        log("Successfully inserted line site " + std::to_string(i));
+        MEDIAL_AXIS_LOG("Successfully inserted line site " << i);
       } catch (const std::exception& e) {
-        log("ERROR inserting line site " + std::to_string(i) + ": " + e.what());
+        MEDIAL_AXIS_LOG_ERROR("ERROR inserting line site " << i << ": " << e.what());
         throw;
       } catch (...) {
-        log("ERROR inserting line site " + std::to_string(i) + ": unknown exception");
+        MEDIAL_AXIS_LOG_ERROR("ERROR inserting line site " << i << ": unknown exception");
         throw;
       }
     }
 
-    log("All line sites inserted successfully");
-
-    // Validate the diagram
-    log("About to validate Voronoi diagram...");
-    bool isValid = vd->check();
-    if (!isValid) {
-      log("Warning: Voronoi diagram validation failed");
-    } else {
-      log("Voronoi diagram validated successfully");
-    }
-
-    // Apply filters - need to check polygon orientation first
-    // Calculate signed area to determine winding order
-    double signedArea = 0.0;
-    size_t n = transformedPolygon.size();
-    for (size_t i = 0; i < n; ++i) {
-      size_t j = (i + 1) % n;
-      signedArea +=
-          (transformedPolygon[j].x - transformedPolygon[i].x) * (transformedPolygon[j].y + transformedPolygon[i].y);
+    MEDIAL_AXIS_LOG("All line sites inserted successfully");
+    Utils::traceCount("voronoiPointsInserted", static_cast<double>(pointIds.size()));
+
+    // Validate the diagram; check() walks the whole graph, so it is skipped unless requested
+    DiagramValidation validation = getDiagramValidation();
+    bool validate = validation == DiagramValidation::FULL ||
+                    (validation == DiagramValidation::SAMPLED && diagramsComputed_ % VALIDATION_SAMPLE_INTERVAL == 0);
+    ++diagramsComputed_;
+    if (validate) {
+      MEDIAL_AXIS_LOG("About to validate Voronoi diagram...");
+      Utils::TraceSpan checkSpan("voronoiCheck");
+      bool isValid = vd->check();
+      if (!isValid) {
+        MEDIAL_AXIS_LOG("Warning: Voronoi diagram validation failed");
+      } else {
+        MEDIAL_AXIS_LOG("Voronoi diagram validated successfully");
+      }
     }
-    signedArea /= 2.0;
 
-    bool isCounterClockwise = signedArea > 0;
-    log("Polygon winding order: " + std::string(isCounterClockwise ? "Counter-clockwise" : "Clockwise") +
-        " (signed area: " + std::to_string(signedArea) + ")");
+    // Keep the polygon interior (holes wind the other way, so they are cut out);
+    // prepareUnitPolygon worked out which side that is
+    if (clearingOffsets_.enabled()) {
+      ovd::polygon_interior_filter interiorFilter(interiorSide);
+      vd->filter(&interiorFilter);
 
-    // For CCW polygons, we want the interior (inside the polygon)
-    // For CW polygons, we want the exterior to be filtered out
-    ovd::polygon_interior_filter interiorFilter(!isCounterClockwise);
-    vd->filter(&interiorFilter);
+      // Clearing offsets fill the whole interior, so they are traced before the medial axis filter
+      Utils::TraceSpan offsetSpan("voronoiClearingOffsets");
+      traceClearingLoops(vd->get_graph_reference(), clearingOffsets_, polygonTolerance_, results.transform,
+                         results.clearingLoops);
+      MEDIAL_AXIS_LOG("Traced " << results.clearingLoops.size() << " clearing offset loops");
 
-    ovd::medial_axis_filter medialFilter(medialThreshold_);
-    vd->filter(&medialFilter);
+      ovd::medial_axis_filter medialFilter(medialThreshold_);
+      vd->filter(&medialFilter);
+    } else {
+      InteriorMedialAxisFilter filter(interiorSide, medialThreshold_);
+      vd->filter(&filter);
+    }
 
     // Extract medial axis with configurable interpolation
     ovd::HEGraph& graph = vd->get_graph_reference();
@@ -202,27 +263,42 @@ bool MedialAxisProcessor::computeOpenVoronoi(const std::vector<Point2D>& transfo
     // OpenVoronoi vertices to avoid double interpolation. Fusion will handle
     // spline fitting through the raw vertices.
 
-    log("Found " + std::to_string(chainList.size()) + " medial axis chains");
+    MEDIAL_AXIS_LOG("Found " << chainList.size() << " medial axis chains");
 
-    // Convert results back to world coordinates
+    // Convert results back to world coordinates, sizing the chain storage once
+    size_t chainPointCount = 0;
+    for (const auto& chain : chainList) {
+      for (const auto& pointList : chain) {
+        chainPointCount += pointList.size();
+      }
+    }
+    results.chains.reserve(chainList.size(), chainPointCount);
     results.numChains = static_cast<int>(chainList.size());
     results.minClearance = std::numeric_limits<double>::max();
     results.maxClearance = 0.0;
 
     for (const auto& chain : chainList) {
-      std::vector<Point2D> worldChain;
-      std::vector<double> worldClearances;
+      // Points are appended straight into the flat chain storage
+      size_t chainPoints = 0;
+      Point2D previousPoint;
 
       for (const auto& pointList : chain) {
         for (const auto& medialPoint : pointList) {
           // Convert point back to world coordinates
           Point2D unitPoint(medialPoint.p.x, medialPoint.p.y);
           Point2D worldPoint = transformFromUnitCircle(unitPoint, results.transform);
-          worldChain.push_back(worldPoint);
 
           // Convert clearance radius back to world scale
           double worldClearance = medialPoint.clearance_radius / results.transform.scale;
-          worldClearances.push_back(worldClearance);
+
+          if (chainPoints == 0) {
+            results.chains.beginChain();
+          } else {
+            results.totalLength += distance(previousPoint, worldPoint);
+          }
+          results.chains.addPoint(worldPoint, worldClearance);
+          previousPoint = worldPoint;
+          chainPoints++;
 
           // Update statistics
           results.totalPoints++;
@@ -231,23 +307,12 @@ bool MedialAxisProcessor::computeOpenVoronoi(const std::vector<Point2D>& transfo
 
           // Debug output for first few points only
           if (verbose_ && results.totalPoints <= 3) {
-            log("Medial point: (" + std::to_string(worldPoint.x) + ", " + std::to_string(worldPoint.y) +
-                "), clearance: " + std::to_string(worldClearance));
+            MEDIAL_AXIS_LOG("Medial point: (" << worldPoint.x << ", " << worldPoint.y << "), clearance: "
+                            << worldClearance);
           }
         }
       }
 
-      if (!worldChain.empty()) {
-        results.chains.push_back(worldChain);
-        results.clearanceRadii.push_back(worldClearances);
-
-        // Calculate chain length
-        double chainLength = 0.0;
-        for (size_t i = 1; i < worldChain.size(); ++i) {
-          chainLength += distance(worldChain[i - 1], worldChain[i]);
-        }
-        results.totalLength += chainLength;
-      }
     }
 
     // Smart pointer automatically cleans up - no manual delete needed
@@ -256,26 +321,19 @@ bool MedialAxisProcessor::computeOpenVoronoi(const std::vector<Point2D>& transfo
       results.minClearance = 0.0;
     }
 
+    // Chains meeting at a medial vertex end on the same converted point
+    results.graph = MedialAxisGraph::fromChains(results.chains);
     return true;
   } catch (const std::exception& e) {
     results.errorMessage = "OpenVoronoi computation failed: " + std::string(e.what());
-    Geometry::MedialAxisProcessor::log("Error: " + results.errorMessage);
+    MEDIAL_AXIS_LOG_ERROR("Error: " << results.errorMessage);
     return false;
   } catch (...) {
     results.errorMessage = "OpenVoronoi computation failed with unknown error";
-    Geometry::MedialAxisProcessor::log("Error: " + results.errorMessage);
+    MEDIAL_AXIS_LOG_ERROR("Error: " << results.errorMessage);
     return false;
   }
 }
 
-void MedialAxisProcessor::log(const std::string& message) {
-  // Use ERROR level for error messages, INFO level for other messages
-  if (message.find("ERROR") == 0 || message.find("Error") == 0) {
-    LOG_ERROR("[MedialAxisProcessor] " << message);
-  } else {
-    LOG_INFO("[MedialAxisProcessor] " << message);
-  }
-}
-
 }  // namespace Geometry
 }  // namespace ChipCarving
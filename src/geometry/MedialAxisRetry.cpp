@@ -0,0 +1,101 @@
+/**
+ * MedialAxisRetry.cpp
+ *
+ * Polygon rework for the OpenVoronoi fallback ladder
+ */
+
+#include "geometry/MedialAxisRetry.h"
+
+#include <random>
+
+#include "geometry/PolygonSimplification.h"
+
+namespace ChipCarving {
+namespace Geometry {
+
+namespace {
+
+constexpr double PERTURBATION = 1.0e-7;                          // Largest vertex offset (unit circle units)
+constexpr double SIMPLIFY_TOLERANCE = 1.0e-4;                    // Douglas-Peucker tolerance (unit circle units)
+constexpr double SIMPLIFY_CORNER_ANGLE = 3.14159265358979323846;  // No corner protection
+constexpr double RESCALE_FACTOR = 0.7;                           // Not a power of two, so coordinates round differently
+constexpr unsigned PERTURBATION_SEED = 0x0fd5eed;
+
+std::vector<Point2D> perturb(const std::vector<Point2D>& polygon) {
+  std::mt19937 generator(PERTURBATION_SEED);
+  std::uniform_real_distribution<double> offset(-PERTURBATION, PERTURBATION);
+  std::vector<Point2D> perturbed;
+  perturbed.reserve(polygon.size());
+  for (const auto& point : polygon) {
+    double dx = offset(generator);
+    double dy = offset(generator);
+    perturbed.emplace_back(point.x + dx, point.y + dy);
+  }
+  return perturbed;
+}
+
+}  // namespace
+
+const char* medialAxisRetryName(MedialAxisRetry retry) {
+  switch (retry) {
+    case MedialAxisRetry::NONE:
+      return "none";
+    case MedialAxisRetry::PERTURBED:
+      return "perturbed";
+    case MedialAxisRetry::SIMPLIFIED:
+      return "simplified";
+    case MedialAxisRetry::RESCALED:
+      return "rescaled";
+  }
+  return "unknown";
+}
+
+const std::vector<MedialAxisRetry>& medialAxisRetryLadder() {
+  static const std::vector<MedialAxisRetry> ladder = {MedialAxisRetry::PERTURBED, MedialAxisRetry::SIMPLIFIED,
+                                                      MedialAxisRetry::RESCALED};
+  return ladder;
+}
+
+std::vector<Point2D> retryPolygon(const std::vector<Point2D>& unitPolygon, MedialAxisRetry retry, double& scale) {
+  switch (retry) {
+    case MedialAxisRetry::NONE:
+      return unitPolygon;
+    case MedialAxisRetry::PERTURBED:
+      return perturb(unitPolygon);
+    case MedialAxisRetry::SIMPLIFIED: {
+      std::vector<Point2D> simplified = simplifyPolygon(unitPolygon, SIMPLIFY_TOLERANCE, SIMPLIFY_CORNER_ANGLE);
+      return simplified.size() < unitPolygon.size() ? simplified : std::vector<Point2D>{};
+    }
+    case MedialAxisRetry::RESCALED: {
+      std::vector<Point2D> rescaled;
+      rescaled.reserve(unitPolygon.size());
+      for (const auto& point : unitPolygon) {
+        rescaled.emplace_back(point.x * RESCALE_FACTOR, point.y * RESCALE_FACTOR);
+      }
+      scale *= RESCALE_FACTOR;
+      return rescaled;
+    }
+  }
+  return {};
+}
+
+std::vector<Point2D> retryPolygon(const std::vector<Point2D>& unitPolygon, const std::vector<size_t>& loopStarts,
+                                  MedialAxisRetry retry, double& scale, std::vector<size_t>& reworkedStarts) {
+  if (retry != MedialAxisRetry::SIMPLIFIED) {
+    reworkedStarts = loopStarts;
+    return retryPolygon(unitPolygon, retry, scale);
+  }
+
+  std::vector<Point2D> simplified;
+  reworkedStarts.assign(1, 0);
+  for (size_t loop = 0; loop + 1 < loopStarts.size(); ++loop) {
+    std::vector<Point2D> points(unitPolygon.begin() + loopStarts[loop], unitPolygon.begin() + loopStarts[loop + 1]);
+    std::vector<Point2D> thinned = simplifyPolygon(points, SIMPLIFY_TOLERANCE, SIMPLIFY_CORNER_ANGLE);
+    simplified.insert(simplified.end(), thinned.begin(), thinned.end());
+    reworkedStarts.push_back(simplified.size());
+  }
+  return simplified.size() < unitPolygon.size() ? simplified : std::vector<Point2D>{};
+}
+
+}  // namespace Geometry
+}  // namespace ChipCarving
@@ -0,0 +1,111 @@
+/**
+ * MedialAxisSpurs.cpp
+ *
+ * Removal of short or flat medial axis branches between a free end and a junction
+ */
+
+#include "geometry/MedialAxisSpurs.h"
+
+#include <algorithm>
+#include <limits>
+#include <utility>
+#include <vector>
+
+#include "geometry/ArcLengthChain.h"
+#include "geometry/MedialAxisProcessor.h"
+
+namespace ChipCarving {
+namespace Geometry {
+
+namespace {
+
+double clearanceChange(const MedialAxisChains::ChainView& chain) {
+  auto range = std::minmax_element(chain.clearanceData(), chain.clearanceData() + chain.size());
+  return *range.second - *range.first;
+}
+
+}  // namespace
+
+size_t pruneMedialAxisSpurs(MedialAxisResults& results, const SpurPruningOptions& options) {
+  const MedialAxisGraph& graph = results.graph;
+  const MedialAxisChains& chains = results.chains;
+  if (!options.enabled() || !results.success || graph.edgeCount() != chains.size()) {
+    return 0;
+  }
+
+  // Spurs that fail either test, as (length, chain)
+  std::vector<std::pair<double, size_t>> candidates;
+  ArcLengthChain arc;
+  for (size_t i = 0; i < chains.size(); ++i) {
+    const MedialAxisGraph::Edge& edge = graph.edge(i);
+    if (edge.start == MedialAxisGraph::NO_NODE || edge.start == edge.end) {
+      continue;
+    }
+    bool freeStart = graph.degree(edge.start) == 1;
+    bool freeEnd = graph.degree(edge.end) == 1;
+    if (freeStart == freeEnd || !graph.isJunction(freeStart ? edge.end : edge.start)) {
+      continue;
+    }
+    arc.assign(chains[i]);
+    double length = arc.totalLength();
+    if ((options.minLength > 0.0 && length < options.minLength) ||
+        (options.minClearanceChange > 0.0 && clearanceChange(chains[i]) < options.minClearanceChange)) {
+      candidates.emplace_back(length, i);
+    }
+  }
+  if (candidates.empty()) {
+    return 0;
+  }
+
+  std::sort(candidates.begin(), candidates.end());
+  std::vector<size_t> remaining(graph.nodeCount());
+  for (uint32_t n = 0; n < graph.nodeCount(); ++n) {
+    remaining[n] = graph.degree(n);
+  }
+  std::vector<bool> pruned(chains.size(), false);
+  size_t prunedCount = 0;
+  for (const auto& candidate : candidates) {
+    const MedialAxisGraph::Edge& edge = graph.edge(candidate.second);
+    uint32_t junction = graph.degree(edge.start) == 1 ? edge.end : edge.start;
+    if (remaining[junction] > 2) {
+      --remaining[junction];
+      pruned[candidate.second] = true;
+      ++prunedCount;
+    }
+  }
+  if (prunedCount == 0) {
+    return 0;
+  }
+
+  MedialAxisChains kept;
+  kept.reserve(chains.size() - prunedCount, chains.pointCount());
+  results.totalPoints = 0;
+  results.totalLength = 0.0;
+  results.minClearance = std::numeric_limits<double>::max();
+  results.maxClearance = 0.0;
+  for (size_t i = 0; i < chains.size(); ++i) {
+    if (pruned[i]) {
+      continue;
+    }
+    auto chain = chains[i];
+    kept.beginChain();
+    for (size_t p = 0; p < chain.size(); ++p) {
+      kept.addPoint(chain[p], chain.clearance(p));
+      results.minClearance = std::min(results.minClearance, chain.clearance(p));
+      results.maxClearance = std::max(results.maxClearance, chain.clearance(p));
+    }
+    results.totalPoints += static_cast<int>(chain.size());
+    arc.assign(chain);
+    results.totalLength += arc.totalLength();
+  }
+  if (results.totalPoints == 0) {
+    results.minClearance = 0.0;
+  }
+  results.chains = std::move(kept);
+  results.numChains = static_cast<int>(results.chains.size());
+  results.graph = MedialAxisGraph::fromChains(results.chains);
+  return prunedCount;
+}
+
+}  // namespace Geometry
+}  // namespace ChipCarving
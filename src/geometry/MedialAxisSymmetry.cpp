@@ -0,0 +1,219 @@
+/**
+ * MedialAxisSymmetry.cpp
+ *
+ * Mirror axis detection
+ */
+
+#include "geometry/MedialAxisSymmetry.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <vector>
+
+#include "MedialAxisSymmetryGeometry.h"
+
+namespace ChipCarving {
+namespace Geometry {
+
+namespace {
+
+constexpr double PI = 3.14159265358979323846;
+constexpr size_t MAX_AXIS_CANDIDATES = 256;  // Mirror images of the farthest vertex tried
+constexpr double INF = std::numeric_limits<double>::infinity();
+
+// Axis angles are directions of lines, so they live in [0, π)
+double normalizeAxis(double angle) {
+  angle = std::fmod(angle, PI);
+  return angle < 0.0 ? angle + PI : angle;
+}
+
+double axisDifference(double a, double b) {
+  double d = std::fabs(a - b);
+  return std::min(d, PI - d);
+}
+
+// Polygon edges bucketed on a grid, for "is this point on the boundary" queries
+class EdgeGrid {
+ public:
+  EdgeGrid(const std::vector<Point2D>& polygon, double tolerance) : polygon_(polygon) {
+    double minX = INF, minY = INF, maxX = -INF, maxY = -INF;
+    for (const auto& p : polygon) {
+      minX = std::min(minX, p.x);
+      minY = std::min(minY, p.y);
+      maxX = std::max(maxX, p.x);
+      maxY = std::max(maxY, p.y);
+    }
+    // About one edge per cell; a cell is never narrower than the query tolerance
+    double extent = std::max(maxX - minX, maxY - minY);
+    cellSize_ = std::max(tolerance, 2.0 * extent / std::sqrt(static_cast<double>(polygon.size())));
+    if (!(cellSize_ > 0.0)) {
+      cellSize_ = 1.0;
+    }
+    origin_ = Point2D(minX - cellSize_, minY - cellSize_);
+    columns_ = static_cast<long>((maxX - origin_.x) / cellSize_) + 2;
+    rows_ = static_cast<long>((maxY - origin_.y) / cellSize_) + 2;
+    cells_.resize(static_cast<size_t>(columns_ * rows_));
+
+    for (size_t i = 0; i < polygon.size(); ++i) {
+      const Point2D& a = polygon[i];
+      const Point2D& b = polygon[(i + 1) % polygon.size()];
+      long c0 = column(std::min(a.x, b.x)), c1 = column(std::max(a.x, b.x));
+      long r0 = row(std::min(a.y, b.y)), r1 = row(std::max(a.y, b.y));
+      for (long r = r0; r <= r1; ++r) {
+        for (long c = c0; c <= c1; ++c) {
+          cells_[static_cast<size_t>(r * columns_ + c)].push_back(i);
+        }
+      }
+    }
+  }
+
+  // An edge within tolerance (at most the cell size) is in p's cell or a neighbouring one
+  bool nearBoundary(const Point2D& p, double tolerance) const {
+    long pc = column(p.x);
+    long pr = row(p.y);
+    for (long r = std::max(0L, pr - 1); r <= std::min(rows_ - 1, pr + 1); ++r) {
+      for (long c = std::max(0L, pc - 1); c <= std::min(columns_ - 1, pc + 1); ++c) {
+        for (size_t edge : cells_[static_cast<size_t>(r * columns_ + c)]) {
+          const Point2D& a = polygon_[edge];
+          const Point2D& b = polygon_[(edge + 1) % polygon_.size()];
+          if (pointSegmentDistance(p, a, b) <= tolerance) {
+            return true;
+          }
+        }
+      }
+    }
+    return false;
+  }
+
+ private:
+  long column(double x) const {
+    return std::max(0L, std::min(columns_ - 1, static_cast<long>(std::floor((x - origin_.x) / cellSize_))));
+  }
+  long row(double y) const {
+    return std::max(0L, std::min(rows_ - 1, static_cast<long>(std::floor((y - origin_.y) / cellSize_))));
+  }
+
+  const std::vector<Point2D>& polygon_;
+  Point2D origin_{};
+  double cellSize_ = 1.0;
+  long columns_ = 1;
+  long rows_ = 1;
+  std::vector<std::vector<size_t>> cells_{};
+};
+
+}  // namespace
+
+bool detectPolygonSymmetry(const std::vector<Point2D>& polygon, double tolerance, PolygonSymmetry& symmetry) {
+  std::vector<Point2D> vertices = openVertices(polygon);
+  size_t n = vertices.size();
+  if (n < 3) {
+    return false;
+  }
+
+  // Every mirror axis passes through the area centroid
+  double area2 = 0.0, cx = 0.0, cy = 0.0;
+  for (size_t i = 0; i < n; ++i) {
+    const Point2D& a = vertices[i];
+    const Point2D& b = vertices[(i + 1) % n];
+    double c = cross(a, b);
+    area2 += c;
+    cx += (a.x + b.x) * c;
+    cy += (a.y + b.y) * c;
+  }
+  if (std::fabs(area2) <= tolerance * tolerance) {
+    return false;
+  }
+  Point2D centre(cx / (3.0 * area2), cy / (3.0 * area2));
+
+  size_t far = 0;
+  double radius = 0.0;
+  for (size_t i = 0; i < n; ++i) {
+    double r = distance(vertices[i], centre);
+    if (r > radius) {
+      radius = r;
+      far = i;
+    }
+  }
+  if (radius <= tolerance) {
+    return false;
+  }
+
+  EdgeGrid grid(vertices, tolerance);
+  auto mirrors = [&](double angle) {
+    Point2D d = direction(angle);
+    for (const auto& v : vertices) {
+      Point2D q = v - centre;
+      if (!grid.nearBoundary(centre + d * (2.0 * dot(q, d)) - q, tolerance)) {
+        return false;
+      }
+    }
+    return true;
+  };
+
+  // A mirror maps the farthest vertex onto a boundary point just as far out: a vertex
+  // that far out, or where the circle through it crosses an edge next to such a vertex
+  const double farAngle = std::atan2(vertices[far].y - centre.y, vertices[far].x - centre.x);
+  const double angleTolerance = tolerance / radius;
+  std::vector<double> axes;
+  std::vector<double> tried;
+  auto tryImage = [&](const Point2D& image) {
+    if (tried.size() >= MAX_AXIS_CANDIDATES || std::fabs(distance(image, centre) - radius) > tolerance) {
+      return;
+    }
+    double angle = normalizeAxis(0.5 * (farAngle + std::atan2(image.y - centre.y, image.x - centre.x)));
+    for (double t : tried) {
+      if (axisDifference(t, angle) <= angleTolerance) {
+        return;
+      }
+    }
+    tried.push_back(angle);
+    if (mirrors(angle)) {
+      axes.push_back(angle);
+    }
+  };
+  auto tryEdge = [&](const Point2D& a, const Point2D& b) {
+    Point2D ab = b - a;
+    Point2D ac = a - centre;
+    double qa = dot(ab, ab);
+    double qb = 2.0 * dot(ab, ac);
+    double qc = dot(ac, ac) - radius * radius;
+    double discriminant = qb * qb - 4.0 * qa * qc;
+    if (qa <= 0.0 || discriminant < 0.0) {
+      return;
+    }
+    for (double sign : {-1.0, 1.0}) {
+      double t = (-qb + sign * std::sqrt(discriminant)) / (2.0 * qa);
+      if (t >= 0.0 && t <= 1.0) {
+        tryImage(a + ab * t);
+      }
+    }
+  };
+  for (size_t i = 0; i < n; ++i) {
+    if (distance(vertices[i], centre) < radius - tolerance) {
+      continue;
+    }
+    tryImage(vertices[i]);
+    tryEdge(vertices[(i + n - 1) % n], vertices[i]);
+    tryEdge(vertices[i], vertices[(i + 1) % n]);
+  }
+  if (axes.empty()) {
+    return false;
+  }
+
+  // k axes of a symmetric outline are π/k apart; anything else keeps the first axis alone
+  std::sort(axes.begin(), axes.end());
+  int count = static_cast<int>(axes.size());
+  bool even = true;
+  for (int i = 1; i < count; ++i) {
+    even = even && axisDifference(axes[i], axes[0] + i * PI / count) <= 4.0 * angleTolerance;
+  }
+
+  symmetry.centre = centre;
+  symmetry.axisAngle = axes[0];
+  symmetry.mirrorAxes = even ? count : 1;
+  return true;
+}
+
+}  // namespace Geometry
+}  // namespace ChipCarving
@@ -0,0 +1,49 @@
+/**
+ * MedialAxisSymmetryGeometry.h
+ *
+ * Vector helpers shared by mirror axis detection and the wedge medial axis
+ * (internal to src/geometry)
+ * Split from MedialAxisSymmetry.cpp for maintainability
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+#include "geometry/Point2D.h"
+
+namespace ChipCarving {
+namespace Geometry {
+
+inline double dot(const Point2D& a, const Point2D& b) {
+  return a.x * b.x + a.y * b.y;
+}
+
+inline double cross(const Point2D& a, const Point2D& b) {
+  return a.x * b.y - a.y * b.x;
+}
+
+inline Point2D direction(double angle) {
+  return Point2D(std::cos(angle), std::sin(angle));
+}
+
+inline double pointSegmentDistance(const Point2D& p, const Point2D& a, const Point2D& b) {
+  Point2D ab = b - a;
+  double lengthSquared = dot(ab, ab);
+  double t = lengthSquared > 0.0 ? std::max(0.0, std::min(1.0, dot(p - a, ab) / lengthSquared)) : 0.0;
+  return distance(p, a + ab * t);
+}
+
+// The polygon without a closing duplicate of its first vertex
+inline std::vector<Point2D> openVertices(const std::vector<Point2D>& polygon) {
+  std::vector<Point2D> vertices = polygon;
+  if (vertices.size() > 3 && distance(vertices.front(), vertices.back()) < 1e-10) {
+    vertices.pop_back();
+  }
+  return vertices;
+}
+
+}  // namespace Geometry
+}  // namespace ChipCarving
@@ -0,0 +1,255 @@
+/**
+ * MedialAxisSymmetryWedge.cpp
+ *
+ * The fundamental wedge medial axis of a symmetric polygon, and its copies
+ * stitched into the whole polygon's axis
+ * Split from MedialAxisSymmetry.cpp for maintainability
+ */
+
+#include <algorithm>
+#include <cmath>
+#include <exception>
+#include <limits>
+#include <utility>
+#include <vector>
+
+#include "MedialAxisPartitionPieces.h"
+#include "MedialAxisSymmetryGeometry.h"
+#include "geometry/MedialAxisSymmetry.h"
+#include "utils/TraceSpan.h"
+#include "utils/logging.h"
+
+namespace ChipCarving {
+namespace Geometry {
+
+namespace {
+
+constexpr double PI = 3.14159265358979323846;
+constexpr double RELATIVE_TOLERANCE = 1.0e-6;       // Default mirror mismatch relative to the polygon extent
+constexpr double SEAM_TOLERANCE_FRACTION = 1.0e-7;  // Seam end match distance relative to the polygon extent
+constexpr double HALO_GROWTH = 1.05;                // Second halo, just past the largest clearance the first kept
+constexpr double INF = std::numeric_limits<double>::infinity();
+
+double segmentDistance(const Point2D& a, const Point2D& b, const Point2D& c, const Point2D& d) {
+  double o1 = cross(b - a, c - a);
+  double o2 = cross(b - a, d - a);
+  double o3 = cross(d - c, a - c);
+  double o4 = cross(d - c, b - c);
+  if (((o1 < 0.0 && o2 > 0.0) || (o1 > 0.0 && o2 < 0.0)) && ((o3 < 0.0 && o4 > 0.0) || (o3 > 0.0 && o4 < 0.0))) {
+    return 0.0;
+  }
+  return std::min(std::min(pointSegmentDistance(a, c, d), pointSegmentDistance(b, c, d)),
+                  std::min(pointSegmentDistance(c, a, b), pointSegmentDistance(d, a, b)));
+}
+
+double polygonExtent(const std::vector<Point2D>& vertices) {
+  double minX = INF, minY = INF, maxX = -INF, maxY = -INF;
+  for (const auto& p : vertices) {
+    minX = std::min(minX, p.x);
+    minY = std::min(minY, p.y);
+    maxX = std::max(maxX, p.x);
+    maxY = std::max(maxY, p.y);
+  }
+  return vertices.empty() ? 0.0 : std::max(maxX - minX, maxY - minY);
+}
+
+// Fundamental wedge between two neighbouring mirror axes (a half-plane for one axis).
+// Frame coordinates measure along its two sides, so the wedge is the box x >= 0, y >= 0
+struct WedgeFrame {
+  Point2D centre{};
+  Point2D side1{};  // Unit direction of the first side (a mirror axis)
+  Point2D side2{};  // Second side, or the normal of side1 for a half-plane
+  double det = 1.0;
+  bool halfPlane = true;
+  double reach = 0.0;  // Side length that clears the polygon
+  TileBox box{};
+
+  WedgeFrame(const PolygonSymmetry& symmetry, double radius)
+      : centre(symmetry.centre), side1(direction(symmetry.axisAngle)), halfPlane(symmetry.mirrorAxes == 1) {
+    if (halfPlane) {
+      side2 = Point2D(-side1.y, side1.x);
+    } else {
+      side2 = direction(symmetry.axisAngle + PI / symmetry.mirrorAxes);
+      det = cross(side1, side2);
+      box.minX = 0.0;
+    }
+    box.minY = 0.0;
+    reach = 4.0 * radius;
+  }
+
+  Point2D toFrame(const Point2D& p) const {
+    Point2D q = p - centre;
+    return Point2D(cross(q, side2) / det, cross(side1, q) / det);
+  }
+  Point2D toWorld(const Point2D& f) const {
+    return centre + side1 * f.x + side2 * f.y;
+  }
+
+  bool contains(const Point2D& p) const {
+    Point2D f = toFrame(p);
+    return f.y >= 0.0 && (halfPlane || f.x >= 0.0);
+  }
+
+  double distanceTo(const Point2D& a, const Point2D& b) const {
+    if (contains(a) || contains(b)) {
+      return 0.0;
+    }
+    if (halfPlane) {
+      return segmentDistance(a, b, centre - side1 * reach, centre + side1 * reach);
+    }
+    return std::min(segmentDistance(a, b, centre, centre + side1 * reach),
+                    segmentDistance(a, b, centre, centre + side2 * reach));
+  }
+};
+
+// One copy of the wedge: turn by angle after reflecting in the first axis, if reflect
+Point2D mapToCopy(const Point2D& p, const WedgeFrame& frame, double angle, bool reflect) {
+  Point2D q = p - frame.centre;
+  if (reflect) {
+    q = frame.side1 * (2.0 * dot(q, frame.side1)) - q;
+  }
+  return rotatePoint(frame.centre + q, angle, frame.centre);
+}
+
+bool samePiece(const ChainPiece& a, const ChainPiece& b, double tolerance) {
+  if (a.points.size() != b.points.size()) {
+    return false;
+  }
+  bool forward = distance(a.points.front(), b.points.front()) <= tolerance &&
+                 distance(a.points.back(), b.points.back()) <= tolerance;
+  bool backward = distance(a.points.front(), b.points.back()) <= tolerance &&
+                  distance(a.points.back(), b.points.front()) <= tolerance;
+  return forward || backward;
+}
+
+}  // namespace
+
+bool computeSymmetricMedialAxis(const MedialAxisProcessor& prototype, const std::vector<Point2D>& polygon,
+                                const MedialAxisSymmetryOptions& options, MedialAxisResults& results) {
+  std::vector<Point2D> vertices = openVertices(polygon);
+  size_t n = vertices.size();
+  if (n < std::max<size_t>(options.minVertices, 3)) {
+    return false;
+  }
+
+  double extent = polygonExtent(vertices);
+  double tolerance = options.tolerance > 0.0 ? options.tolerance : RELATIVE_TOLERANCE * extent;
+  PolygonSymmetry symmetry;
+  {
+    Utils::TraceSpan detectSpan("medialAxisSymmetry");
+    if (!detectPolygonSymmetry(vertices, tolerance, symmetry) || symmetry.mirrorAxes > options.maxMirrorAxes) {
+      return false;
+    }
+  }
+
+  double radius = 0.0;
+  for (const auto& v : vertices) {
+    radius = std::max(radius, distance(v, symmetry.centre));
+  }
+  WedgeFrame frame(symmetry, radius);
+  bool interiorSide = polygonInteriorSide(vertices);
+
+  // The first halo is a guess; if a kept clearance reaches it, the second clears the largest one
+  double halo = options.haloFraction * radius;
+  std::vector<ChainPiece> pieces;
+  bool accepted = false;
+  size_t siteEdges = 0;
+  for (int attempt = 0; attempt < 2 && !accepted; ++attempt) {
+    std::vector<bool> near(n);
+    siteEdges = 0;
+    for (size_t i = 0; i < n; ++i) {
+      near[i] = frame.distanceTo(vertices[i], vertices[(i + 1) % n]) <= halo;
+      siteEdges += near[i] ? 1 : 0;
+    }
+    if (static_cast<double>(siteEdges) > options.maxSiteFraction * static_cast<double>(n)) {
+      LOG_DEBUG("Symmetric medial axis skipped: the wedge's diagram needs " << siteEdges << " of " << n << " edges");
+      return false;
+    }
+
+    pieces.clear();
+    std::vector<Point2D> framePoints;
+    try {
+      Utils::TraceSpan wedgeSpan("medialAxisWedge");
+      walkBoundaryRuns(prototype, vertices, collectBoundaryRuns(near), interiorSide,
+                       [&](const std::vector<Point2D>& points, const std::vector<double>& clearances) {
+                         // Points within tolerance of an axis are put on it, so the axis owns them exactly
+                         framePoints.clear();
+                         for (const auto& p : points) {
+                           Point2D f = frame.toFrame(p);
+                           if (std::fabs(f.y) <= tolerance) {
+                             f.y = 0.0;
+                           }
+                           if (!frame.halfPlane && std::fabs(f.x) <= tolerance) {
+                             f.x = 0.0;
+                           }
+                           framePoints.push_back(f);
+                         }
+                         clipChain(framePoints, clearances, frame.box, pieces);
+                       });
+    } catch (const std::exception& e) {
+      LOG_WARNING("Symmetric medial axis wedge failed: " << e.what());
+      return false;
+    } catch (...) {
+      return false;
+    }
+
+    double maxClearance = 0.0;
+    for (const auto& piece : pieces) {
+      for (double clearance : piece.clearances) {
+        maxClearance = std::max(maxClearance, clearance);
+      }
+    }
+    accepted = maxClearance < halo;
+    halo = maxClearance * HALO_GROWTH;
+  }
+  if (!accepted) {
+    return false;
+  }
+
+  // Pieces lying on an axis are their own mirror image, so each copy of them is kept once
+  std::vector<bool> onAxis(pieces.size());
+  for (size_t i = 0; i < pieces.size(); ++i) {
+    const auto& points = pieces[i].points;
+    bool onSide1 = std::all_of(points.begin(), points.end(), [](const Point2D& f) { return f.y == 0.0; });
+    bool onSide2 = !frame.halfPlane &&
+                   std::all_of(points.begin(), points.end(), [](const Point2D& f) { return f.x == 0.0; });
+    onAxis[i] = onSide1 || onSide2;
+    for (auto& point : pieces[i].points) {
+      point = frame.toWorld(point);
+    }
+  }
+
+  double seamTolerance = SEAM_TOLERANCE_FRACTION * extent;
+  std::vector<ChainPiece> copies;
+  std::vector<size_t> axisCopies;
+  for (int turn = 0; turn < symmetry.mirrorAxes; ++turn) {
+    double angle = 2.0 * PI * turn / symmetry.mirrorAxes;
+    for (bool reflect : {false, true}) {
+      for (size_t i = 0; i < pieces.size(); ++i) {
+        ChainPiece copy = pieces[i];
+        for (auto& point : copy.points) {
+          point = mapToCopy(point, frame, angle, reflect);
+        }
+        if (onAxis[i]) {
+          bool duplicate = std::any_of(axisCopies.begin(), axisCopies.end(), [&](size_t k) {
+            return samePiece(copies[k], copy, seamTolerance);
+          });
+          if (duplicate) {
+            continue;
+          }
+          axisCopies.push_back(copies.size());
+        }
+        copies.push_back(std::move(copy));
+      }
+    }
+  }
+
+  stitchPieces(copies, seamTolerance, results);
+  LOG_DEBUG("Symmetric medial axis: " << symmetry.mirrorAxes << " mirror axes, " << siteEdges << " of " << n
+                                      << " edges in the wedge's diagram, " << copies.size()
+                                      << " pieces stitched into " << results.numChains << " chains");
+  return true;
+}
+
+}  // namespace Geometry
+}  // namespace ChipCarving
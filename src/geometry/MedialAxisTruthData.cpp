@@ -0,0 +1,194 @@
+/**
+ * MedialAxisTruthData.cpp
+ *
+ * Text and binary medial axis truth files and their comparison
+ */
+
+#include "geometry/MedialAxisTruthData.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <utility>
+#include <vector>
+
+#include "MedialAxisTruthDataText.h"
+#include "utils/MappedFile.h"
+
+namespace ChipCarving {
+namespace Geometry {
+
+namespace {
+
+constexpr char FILE_MAGIC[4] = {'M', 'A', 'T', 'B'};
+constexpr uint32_t FORMAT_VERSION = 2;  // 2: engine version, input polygon and processor parameters
+
+struct TruthHeader {
+  char magic[4];
+  uint32_t formatVersion;
+  uint32_t numChains;
+  uint32_t totalPoints;
+  uint32_t polygonPoints;
+  uint32_t engineVersionBytes;
+  double polygonTolerance;
+  double medialThreshold;
+};
+
+size_t payloadBytes(const TruthHeader& header) {
+  return sizeof(TruthHeader) + header.engineVersionBytes + header.polygonPoints * 2 * sizeof(double) +
+         header.numChains * sizeof(uint32_t) + header.totalPoints * 3 * sizeof(double);
+}
+
+bool loadBinary(const Utils::MappedFile& file, TruthFixture& fixture) {
+  TruthHeader header;
+  std::memcpy(&header, file.data(), sizeof(header));
+  if (header.formatVersion != FORMAT_VERSION || file.size() != payloadBytes(header)) {
+    return false;
+  }
+
+  TruthFixture loaded;
+  loaded.polygonTolerance = header.polygonTolerance;
+  loaded.medialThreshold = header.medialThreshold;
+  const unsigned char* cursor = file.data() + sizeof(TruthHeader);
+  loaded.engineVersion.assign(reinterpret_cast<const char*>(cursor), header.engineVersionBytes);
+  cursor += header.engineVersionBytes;
+
+  loaded.polygon.resize(header.polygonPoints);
+  for (auto& vertex : loaded.polygon) {
+    double xy[2];
+    std::memcpy(xy, cursor, sizeof(xy));
+    vertex = Point2D(xy[0], xy[1]);
+    cursor += sizeof(xy);
+  }
+
+  std::vector<uint32_t> chainSizes(header.numChains);
+  std::memcpy(chainSizes.data(), cursor, chainSizes.size() * sizeof(uint32_t));
+  cursor += chainSizes.size() * sizeof(uint32_t);
+
+  std::vector<size_t> offsets(1, 0);
+  offsets.reserve(chainSizes.size() + 1);
+  for (uint32_t size : chainSizes) {
+    offsets.push_back(offsets.back() + size);
+  }
+
+  // Each flat array is a single copy out of the mapping
+  size_t arrayBytes = header.totalPoints * sizeof(double);
+  std::vector<double> x(header.totalPoints);
+  std::vector<double> y(header.totalPoints);
+  std::vector<double> radii(header.totalPoints);
+  std::memcpy(x.data(), cursor, arrayBytes);
+  std::memcpy(y.data(), cursor + arrayBytes, arrayBytes);
+  std::memcpy(radii.data(), cursor + 2 * arrayBytes, arrayBytes);
+  if (!loaded.chains.assign(std::move(x), std::move(y), std::move(radii), std::move(offsets))) {
+    return false;
+  }
+  fixture = std::move(loaded);
+  return true;
+}
+
+}  // namespace
+
+bool loadTruthFixture(const std::string& path, TruthFixture& fixture) {
+  Utils::MappedFile file(path);
+  if (!file.isOpen()) {
+    return false;
+  }
+  if (file.size() >= sizeof(TruthHeader) && std::memcmp(file.data(), FILE_MAGIC, sizeof(FILE_MAGIC)) == 0) {
+    return loadBinary(file, fixture);
+  }
+  return parseTextTruthFixture(file.chars(), file.size(), fixture);
+}
+
+bool loadTruthFile(const std::string& path, MedialAxisChains& chains) {
+  TruthFixture fixture;
+  if (!loadTruthFixture(path, fixture)) {
+    return false;
+  }
+  chains = std::move(fixture.chains);
+  return true;
+}
+
+bool storeBinaryTruthFixture(const std::string& path, const TruthFixture& fixture) {
+  const MedialAxisChains& chains = fixture.chains;
+  TruthHeader header{};
+  std::memcpy(header.magic, FILE_MAGIC, sizeof(FILE_MAGIC));
+  header.formatVersion = FORMAT_VERSION;
+  header.numChains = static_cast<uint32_t>(chains.size());
+  header.totalPoints = static_cast<uint32_t>(chains.pointCount());
+  header.polygonPoints = static_cast<uint32_t>(fixture.polygon.size());
+  header.engineVersionBytes = static_cast<uint32_t>(fixture.engineVersion.size());
+  header.polygonTolerance = fixture.polygonTolerance;
+  header.medialThreshold = fixture.medialThreshold;
+
+  std::vector<double> polygon;
+  polygon.reserve(fixture.polygon.size() * 2);
+  for (const auto& vertex : fixture.polygon) {
+    polygon.push_back(vertex.x);
+    polygon.push_back(vertex.y);
+  }
+  std::vector<uint32_t> chainSizes;
+  chainSizes.reserve(chains.size());
+  for (const auto& chain : chains) {
+    chainSizes.push_back(static_cast<uint32_t>(chain.size()));
+  }
+
+  std::ofstream out(path, std::ios::binary | std::ios::trunc);
+  if (!out) {
+    return false;
+  }
+  out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+  out.write(fixture.engineVersion.data(), static_cast<std::streamsize>(fixture.engineVersion.size()));
+  out.write(reinterpret_cast<const char*>(polygon.data()),
+            static_cast<std::streamsize>(polygon.size() * sizeof(double)));
+  out.write(reinterpret_cast<const char*>(chainSizes.data()),
+            static_cast<std::streamsize>(chainSizes.size() * sizeof(uint32_t)));
+  for (const auto* array : {&chains.xs(), &chains.ys(), &chains.radii()}) {
+    out.write(reinterpret_cast<const char*>(array->data()),
+              static_cast<std::streamsize>(array->size() * sizeof(double)));
+  }
+  return static_cast<bool>(out);
+}
+
+bool storeBinaryTruthFile(const std::string& path, const MedialAxisChains& chains) {
+  TruthFixture fixture;
+  fixture.chains = chains;
+  return storeBinaryTruthFixture(path, fixture);
+}
+
+bool compareTruthChains(const MedialAxisChains& expected, const MedialAxisChains& actual, double tolerance,
+                        TruthMismatch* mismatch) {
+  auto fail = [mismatch](size_t chain, size_t point, const char* reason) {
+    if (mismatch) {
+      mismatch->chain = chain;
+      mismatch->point = point;
+      mismatch->reason = reason;
+    }
+    return false;
+  };
+
+  if (expected.size() != actual.size()) {
+    return fail(std::min(expected.size(), actual.size()), 0, "chain count");
+  }
+  for (size_t i = 0; i < expected.size(); ++i) {
+    auto want = expected[i];
+    auto got = actual[i];
+    if (want.size() != got.size()) {
+      return fail(i, std::min(want.size(), got.size()), "chain size");
+    }
+    for (size_t j = 0; j < want.size(); ++j) {
+      if (std::abs(want.xData()[j] - got.xData()[j]) > tolerance ||
+          std::abs(want.yData()[j] - got.yData()[j]) > tolerance) {
+        return fail(i, j, "position");
+      }
+      if (std::abs(want.clearance(j) - got.clearance(j)) > tolerance) {
+        return fail(i, j, "clearance");
+      }
+    }
+  }
+  return true;
+}
+
+}  // namespace Geometry
+}  // namespace ChipCarving
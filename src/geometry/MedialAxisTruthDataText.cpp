@@ -0,0 +1,154 @@
+/**
+ * MedialAxisTruthDataText.cpp
+ *
+ * Reading and writing the text truth format
+ * Split from MedialAxisTruthData.cpp for maintainability
+ */
+
+#include "MedialAxisTruthDataText.h"
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <utility>
+
+#include "geometry/NumberScanner.h"
+
+namespace ChipCarving {
+namespace Geometry {
+
+namespace {
+
+// Keyword at the start of a line ("path", "point", "points", ...), after indentation
+size_t keywordLength(const char* line, const char* end) {
+  const char* p = line;
+  while (p < end && ((*p >= 'a' && *p <= 'z') || (*p >= 'A' && *p <= 'Z'))) {
+    ++p;
+  }
+  return static_cast<size_t>(p - line);
+}
+
+bool isKeyword(const char* line, size_t length, const char* keyword) {
+  return length == std::strlen(keyword) && std::strncmp(line, keyword, length) == 0;
+}
+
+// Read count numbers following the keyword, true only if all are present
+bool scanNumbers(const char* field, const char* lineEnd, double* values, int count) {
+  for (int i = 0; i < count; ++i) {
+    if (!scanNumber(field, lineEnd, values[i])) {
+      return false;
+    }
+  }
+  return true;
+}
+
+// Text after "keyword:", without surrounding blanks or a trailing carriage return
+std::string fieldText(const char* field, const char* lineEnd) {
+  const char* colon = static_cast<const char*>(std::memchr(field, ':', static_cast<size_t>(lineEnd - field)));
+  const char* begin = colon ? colon + 1 : field;
+  while (begin < lineEnd && (*begin == ' ' || *begin == '\t')) {
+    ++begin;
+  }
+  const char* end = lineEnd;
+  while (end > begin && (end[-1] == ' ' || end[-1] == '\t' || end[-1] == '\r')) {
+    --end;
+  }
+  return std::string(begin, end);
+}
+
+// Shortest of %.15g and %.17g that reads back as the same double
+const char* formatExact(double value, char (&text)[32]) {
+  std::snprintf(text, sizeof(text), "%.15g", value);
+  if (std::strtod(text, nullptr) != value) {
+    std::snprintf(text, sizeof(text), "%.17g", value);
+  }
+  return text;
+}
+
+}  // namespace
+
+bool parseTextTruthFixture(const char* text, size_t size, TruthFixture& fixture) {
+  TruthFixture loaded;
+  const char* cursor = text;
+  const char* end = text + size;
+  while (cursor < end) {
+    const char* lineEnd = static_cast<const char*>(std::memchr(cursor, '\n', static_cast<size_t>(end - cursor)));
+    if (!lineEnd) {
+      lineEnd = end;
+    }
+    while (cursor < lineEnd && (*cursor == ' ' || *cursor == '\t')) {
+      ++cursor;
+    }
+
+    size_t length = keywordLength(cursor, lineEnd);
+    const char* field = cursor + length;
+    double values[4];
+    if (isKeyword(cursor, length, "path")) {
+      loaded.chains.beginChain();
+    } else if (isKeyword(cursor, length, "point")) {
+      // "point j: x y clearance"
+      if (!scanNumbers(field, lineEnd, values, 4) || loaded.chains.empty()) {
+        return false;
+      }
+      loaded.chains.addPoint(Point2D(values[1], values[2]), values[3]);
+    } else if (isKeyword(cursor, length, "vertex")) {
+      // "vertex i: x y"
+      if (!scanNumbers(field, lineEnd, values, 3)) {
+        return false;
+      }
+      loaded.polygon.emplace_back(values[1], values[2]);
+    } else if (isKeyword(cursor, length, "engine")) {
+      loaded.engineVersion = fieldText(field, lineEnd);
+    } else if (isKeyword(cursor, length, "tolerance")) {
+      if (!scanNumbers(field, lineEnd, &loaded.polygonTolerance, 1)) {
+        return false;
+      }
+    } else if (isKeyword(cursor, length, "threshold")) {
+      if (!scanNumbers(field, lineEnd, &loaded.medialThreshold, 1)) {
+        return false;
+      }
+    }
+    cursor = lineEnd + 1;
+  }
+  fixture = std::move(loaded);
+  return true;
+}
+
+bool storeTextTruthFixture(const std::string& path, const TruthFixture& fixture) {
+  std::FILE* file = std::fopen(path.c_str(), "w");
+  if (!file) {
+    return false;
+  }
+  // Every value round-trips, so a text fixture converts to binary exactly
+  char a[32];
+  char b[32];
+  char c[32];
+  std::fprintf(file, "# Medial Axis Truth File\n");
+  if (!fixture.engineVersion.empty()) {
+    std::fprintf(file, "engine: %s\n", fixture.engineVersion.c_str());
+  }
+  std::fprintf(file, "tolerance: %s\nthreshold: %s\n", formatExact(fixture.polygonTolerance, a),
+               formatExact(fixture.medialThreshold, b));
+  if (!fixture.polygon.empty()) {
+    std::fprintf(file, "polygon: %zu\n", fixture.polygon.size());
+    for (size_t i = 0; i < fixture.polygon.size(); ++i) {
+      const Point2D& vertex = fixture.polygon[i];
+      std::fprintf(file, "  vertex %zu: %s %s\n", i, formatExact(vertex.x, a), formatExact(vertex.y, b));
+    }
+  }
+  std::fprintf(file, "paths: %zu\n", fixture.chains.size());
+  for (size_t i = 0; i < fixture.chains.size(); ++i) {
+    auto chain = fixture.chains[i];
+    std::fprintf(file, "\npath %zu:\n  points: %zu\n", i, chain.size());
+    for (size_t j = 0; j < chain.size(); ++j) {
+      std::fprintf(file, "  point %zu: %s %s %s\n", j, formatExact(chain.xData()[j], a),
+                   formatExact(chain.yData()[j], b), formatExact(chain.clearance(j), c));
+    }
+  }
+  bool written = std::ferror(file) == 0;
+  return std::fclose(file) == 0 && written;
+}
+
+}  // namespace Geometry
+}  // namespace ChipCarving
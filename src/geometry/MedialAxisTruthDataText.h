@@ -0,0 +1,24 @@
+/**
+ * MedialAxisTruthDataText.h
+ *
+ * Text truth file parser shared by the truth file loader
+ * Split from MedialAxisTruthData.cpp for maintainability
+ */
+
+#pragma once
+
+#include <cstddef>
+
+#include "geometry/MedialAxisTruthData.h"
+
+namespace ChipCarving {
+namespace Geometry {
+
+/**
+ * Parse a text truth file held in [text, text + size)
+ * @return false if malformed; fixture is then unchanged
+ */
+bool parseTextTruthFixture(const char* text, size_t size, TruthFixture& fixture);
+
+}  // namespace Geometry
+}  // namespace ChipCarving
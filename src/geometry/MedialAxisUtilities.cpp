@@ -8,151 +8,340 @@
 
 #include <algorithm>
 #include <cmath>
-#include <set>
+#include <utility>
+
+#include "geometry/ArcLengthChain.h"
+#include "geometry/PointKernels.h"
+#include "geometry/SegmentIntersections.h"
 
 namespace ChipCarving {
 namespace Geometry {
 
-std::vector<SampledMedialPath> sampleMedialAxisPaths(const std::vector<std::vector<Point2D>>& chains,
-                                                     const std::vector<std::vector<double>>& clearanceRadii,
-                                                     double targetSpacing) {
-  std::vector<SampledMedialPath> sampledPaths;
+namespace {
 
-  // Validate input
-  if (chains.size() != clearanceRadii.size()) {
-    // Input mismatch - return empty result
-    return sampledPaths;
+// Segments longer than this are densified before spacing-based selection (mm)
+constexpr double INTERPOLATION_THRESHOLD = 1.5;
+
+// Safety limit to prevent excessive interpolation
+constexpr int MAX_INTERMEDIATE_POINTS = 50;
+
+// Intermediate samples closer than this to a selected point are dropped (mm)
+constexpr double MIN_SAMPLE_SEPARATION = 0.1;
+
+// Paths shorter than this keep only their endpoints (mm)
+constexpr double MIN_SAMPLED_LENGTH = 0.2;
+
+int intermediatePointCount(double segmentLength) {
+  if (segmentLength <= INTERPOLATION_THRESHOLD) {
+    return 0;
   }
+  return std::min(static_cast<int>(segmentLength / 1.0) - 1, MAX_INTERMEDIATE_POINTS);
+}
 
-  // Process each chain independently
-  for (size_t chainIdx = 0; chainIdx < chains.size(); ++chainIdx) {
-    const auto& chain = chains[chainIdx];
-    const auto& clearances = clearanceRadii[chainIdx];
+/**
+ * Picks, for each target distance along the densified chain, the densified
+ * point whose cumulative distance is closest (first one on ties). Densified
+ * points are fed in order as they are generated, so neither the densified
+ * chain nor its cumulative distances are ever stored: cumulative distance and
+ * target distance both increase, so each target's best point is final as soon
+ * as a point past the target fails to beat it.
+ */
+class ChainSampler {
+ public:
+  // distances, if given, receives each sample's distance along the chain
+  ChainSampler(SampledMedialPath& path, const Point2D& endPoint, size_t lastIndex, double totalLength,
+               double targetSpacing, std::vector<double>* distances = nullptr)
+      : path_(path), endPoint_(endPoint), lastIndex_(lastIndex), totalLength_(totalLength), distances_(distances) {
+    targetCount_ = std::max(2, static_cast<int>(totalLength / targetSpacing) + 1);
+    lastTarget_ = (targetCount_ > 2 && totalLength > MIN_SAMPLED_LENGTH) ? targetCount_ - 1 : 1;
+    path_.points.reserve(static_cast<size_t>(targetCount_));
+  }
 
-    // Skip empty or mismatched chains
-    if (chain.empty() || chain.size() != clearances.size()) {
-      continue;
+  void start(const Point2D& position, double clearance) {
+    path_.points.emplace_back(position, clearance);
+    record(0.0);
+    setBest(position, clearance, 0, 0.0);
+    bestDifference_ = std::abs(bestDistance_ - targetDistance());
+  }
+
+  void visit(const Point2D& position, double clearance, size_t index, double cumulativeDistance) {
+    while (target_ < lastTarget_) {
+      double targetDist = targetDistance();
+      double difference = std::abs(cumulativeDistance - targetDist);
+      if (difference < bestDifference_) {
+        setBest(position, clearance, index, cumulativeDistance);
+        bestDifference_ = difference;
+        return;
+      }
+      if (cumulativeDistance <= targetDist) {
+        return;
+      }
+      selectBest();
     }
+  }
 
-    SampledMedialPath sampledPath;
+  void finish(double endClearance) {
+    while (target_ < lastTarget_) {
+      selectBest();
+    }
+    path_.points.emplace_back(endPoint_, endClearance);
+    record(totalLength_);
+  }
 
-    // Single point chain - just add it
-    if (chain.size() == 1) {
-      sampledPath.points.emplace_back(chain[0], clearances[0]);
-      sampledPath.totalLength = 0.0;
-      sampledPaths.push_back(sampledPath);
-      continue;
+ private:
+  void record(double cumulativeDistance) {
+    if (distances_) {
+      distances_->push_back(cumulativeDistance);
+    }
+  }
+
+  double targetDistance() const {
+    return (totalLength_ * target_) / (targetCount_ - 1);
+  }
+
+  void setBest(const Point2D& position, double clearance, size_t index, double cumulativeDistance) {
+    bestPosition_ = position;
+    bestClearance_ = clearance;
+    bestIndex_ = index;
+    bestDistance_ = cumulativeDistance;
+  }
+
+  // Commit the current target's best point and move on to the next target
+  void selectBest() {
+    bool alreadySelected = bestIndex_ == 0 || bestIndex_ == lastIndex_ || bestIndex_ == lastSelectedIndex_;
+    if (!alreadySelected) {
+      bool tooClose = distance(endPoint_, bestPosition_) < MIN_SAMPLE_SEPARATION ||
+                      std::any_of(path_.points.begin(), path_.points.end(), [&](const SampledMedialPoint& point) {
+                        return distance(point.position, bestPosition_) < MIN_SAMPLE_SEPARATION;
+                      });
+      if (!tooClose) {
+        path_.points.emplace_back(bestPosition_, bestClearance_);
+        record(bestDistance_);
+        lastSelectedIndex_ = bestIndex_;
+      }
     }
 
-    // Calculate total chain length
-    double totalLength = 0.0;
-    for (size_t i = 1; i < chain.size(); ++i) {
-      totalLength += distance(chain[i - 1], chain[i]);
+    target_++;
+    if (target_ < lastTarget_) {
+      bestDifference_ = std::abs(bestDistance_ - targetDistance());
     }
-    sampledPath.totalLength = totalLength;
+  }
 
-    // Build enhanced chain by interpolating long segments
-    std::vector<Point2D> enhancedChain;
-    std::vector<double> enhancedClearances;
+  SampledMedialPath& path_;
+  Point2D endPoint_;
+  size_t lastIndex_;
+  double totalLength_;
+  std::vector<double>* distances_;
+  int targetCount_ = 2;
+  int target_ = 1;
+  int lastTarget_ = 1;
+
+  Point2D bestPosition_{};
+  double bestClearance_ = 0.0;
+  size_t bestIndex_ = 0;
+  double bestDistance_ = 0.0;
+  double bestDifference_ = 0.0;
+  size_t lastSelectedIndex_ = 0;
+};
 
-    for (size_t i = 0; i < chain.size(); ++i) {
-      // Always add the current point
-      enhancedChain.push_back(chain[i]);
-      enhancedClearances.push_back(clearances[i]);
+/**
+ * Put a sample at each forced distance along the chain, interpolated exactly
+ * on its segment. Regular samples closer than MIN_SAMPLE_SEPARATION to one
+ * give way, apart from the chain's ends.
+ * @param distances Distance along the chain of each of sampledPath's points
+ */
+void insertForcedSamples(const MedialAxisChains::ChainView& chain, double unitScale,
+                         const std::vector<double>& forced, const std::vector<double>& distances,
+                         SampledMedialPath& sampledPath) {
+  ArcLengthChain arcLength(chain, unitScale);
+  double totalLength = distances.back();
+  std::vector<SampledMedialPoint> regular;
+  regular.swap(sampledPath.points);
+  sampledPath.points.reserve(regular.size() + forced.size());
+
+  size_t next = 0;  // First forced distance not yet placed
+  double lastForced = -MIN_SAMPLE_SEPARATION;
+  auto nearForced = [&](double s) {
+    return s - lastForced < MIN_SAMPLE_SEPARATION ||
+           (next < forced.size() && forced[next] - s < MIN_SAMPLE_SEPARATION);
+  };
+  for (size_t k = 0; k < regular.size(); ++k) {
+    for (; next < forced.size() && forced[next] < distances[k]; ++next) {
+      double s = forced[next];
+      bool placeable = s >= MIN_SAMPLE_SEPARATION && totalLength - s >= MIN_SAMPLE_SEPARATION &&
+                       s - lastForced >= MIN_SAMPLE_SEPARATION;
+      if (placeable) {
+        sampledPath.points.emplace_back(arcLength.pointAt(s), arcLength.clearanceAt(s), true);
+        lastForced = s;
+      }
+    }
+    bool chainEnd = k == 0 || k + 1 == regular.size();
+    if (chainEnd || !nearForced(distances[k])) {
+      sampledPath.points.push_back(regular[k]);
+    }
+  }
+}
 
-      // If not the last point, check if interpolation is needed
-      if (i < chain.size() - 1) {
-        double segmentLength = distance(chain[i], chain[i + 1]);
+// lengths is scratch space, reused across chains
+void sampleChain(const MedialAxisChains::ChainView& chain, double unitScale, double targetSpacing,
+                 SampledMedialPath& sampledPath, const std::vector<double>* forced, std::vector<double>& lengths) {
+  auto pointAt = [&](size_t i) { return Point2D(chain[i].x * unitScale, chain[i].y * unitScale); };
+  auto clearanceAt = [&](size_t i) { return chain.clearance(i) * unitScale; };
+
+  // Single point chain - just add it
+  if (chain.size() == 1) {
+    sampledPath.points.emplace_back(pointAt(0), clearanceAt(0));
+    sampledPath.totalLength = 0.0;
+    return;
+  }
 
-        // Interpolate if segment is longer than 1.5mm
-        if (segmentLength > 1.5) {
-          int numIntermediatePoints = static_cast<int>(segmentLength / 1.0) - 1;
+  // First pass: segment lengths, chain length and densified point count
+  lengths.resize(chain.size() - 1);
+  segmentLengths(chain.xData(), chain.yData(), chain.size(), unitScale, lengths.data());
+  double totalLength = 0.0;
+  size_t densifiedCount = chain.size();
+  for (double segmentLength : lengths) {
+    totalLength += segmentLength;
+    densifiedCount += static_cast<size_t>(intermediatePointCount(segmentLength));
+  }
+  sampledPath.totalLength = totalLength;
+
+  // Second pass: generate the densified chain and select samples on the fly
+  bool forcing = forced && !forced->empty();
+  std::vector<double> distances;
+  ChainSampler sampler(sampledPath, pointAt(chain.size() - 1), densifiedCount - 1, totalLength, targetSpacing,
+                       forcing ? &distances : nullptr);
+  Point2D current = pointAt(0);
+  double currentClearance = clearanceAt(0);
+  sampler.start(current, currentClearance);
+
+  Point2D previous = current;
+  double cumulativeDistance = 0.0;
+  size_t index = 0;
+  auto emit = [&](const Point2D& position, double clearance) {
+    cumulativeDistance += distance(previous, position);
+    previous = position;
+    sampler.visit(position, clearance, ++index, cumulativeDistance);
+  };
+
+  for (size_t i = 0; i + 1 < chain.size(); ++i) {
+    Point2D next = pointAt(i + 1);
+    double nextClearance = clearanceAt(i + 1);
+
+    int numIntermediatePoints = intermediatePointCount(lengths[i]);
+    for (int j = 1; j <= numIntermediatePoints; ++j) {
+      double t = static_cast<double>(j) / static_cast<double>(numIntermediatePoints + 1);
+
+      // Linear interpolation of position and clearance
+      emit(Point2D(current.x + t * (next.x - current.x), current.y + t * (next.y - current.y)),
+           currentClearance + t * (nextClearance - currentClearance));
+    }
+    emit(next, nextClearance);
 
-          // Safety limit to prevent excessive interpolation
-          const int MAX_INTERMEDIATE_POINTS = 50;
-          numIntermediatePoints = std::min(numIntermediatePoints, MAX_INTERMEDIATE_POINTS);
+    current = next;
+    currentClearance = nextClearance;
+  }
 
-          for (int j = 1; j <= numIntermediatePoints; ++j) {
-            double t = static_cast<double>(j) / static_cast<double>(numIntermediatePoints + 1);
+  sampler.finish(currentClearance);
+  if (forcing) {
+    insertForcedSamples(chain, unitScale, *forced, distances, sampledPath);
+  }
+}
 
-            // Linear interpolation of position
-            Point2D interpolatedPoint(chain[i].x + t * (chain[i + 1].x - chain[i].x),
-                                      chain[i].y + t * (chain[i + 1].y - chain[i].y));
+}  // namespace
 
-            // Linear interpolation of clearance
-            double interpolatedClearance = clearances[i] + t * (clearances[i + 1] - clearances[i]);
+void sampleMedialAxisChains(const MedialAxisChains& chains, double unitScale, double targetSpacing,
+                            std::vector<SampledMedialPath>& sampledPaths,
+                            const std::vector<std::vector<double>>* forcedPositions) {
+  sampledPaths.reserve(sampledPaths.size() + chains.size());
+  std::vector<double> lengths;
 
-            enhancedChain.push_back(interpolatedPoint);
-            enhancedClearances.push_back(interpolatedClearance);
-          }
-        }
-      }
+  for (size_t c = 0; c < chains.size(); ++c) {
+    // Skip empty chains
+    auto chain = chains[c];
+    if (chain.empty()) {
+      continue;
     }
 
-    // Build cumulative distance array for enhanced chain
-    std::vector<double> cumulativeDistances(enhancedChain.size(), 0.0);
-    for (size_t i = 1; i < enhancedChain.size(); ++i) {
-      double segmentLength = distance(enhancedChain[i - 1], enhancedChain[i]);
-      cumulativeDistances[i] = cumulativeDistances[i - 1] + segmentLength;
+    sampledPaths.emplace_back();
+    sampledPaths.back().chain = static_cast<int>(c);
+    const std::vector<double>* forced =
+        forcedPositions && c < forcedPositions->size() ? &(*forcedPositions)[c] : nullptr;
+    sampleChain(chain, unitScale, targetSpacing, sampledPaths.back(), forced, lengths);
+  }
+}
+
+void findChainBoundaryCrossings(const MedialAxisChains& chains,
+                                const std::vector<const std::vector<Point2D>*>& boundaries, double unitScale,
+                                std::vector<std::vector<double>>& positions) {
+  positions.assign(chains.size(), {});
+
+  // Chain segments first (group 0, by chain and start point), then the loops' edges (group 1)
+  std::vector<SweepSegment> segments;
+  std::vector<std::pair<size_t, size_t>> chainSegments;  // Chain and start point of each chain segment
+  for (size_t c = 0; c < chains.size(); ++c) {
+    auto chain = chains[c];
+    for (size_t i = 0; i + 1 < chain.size(); ++i) {
+      segments.push_back(SweepSegment{chain[i], chain[i + 1], 0});
+      chainSegments.emplace_back(c, i);
     }
+  }
+  if (segments.empty()) {
+    return;
+  }
+  for (const auto* loop : boundaries) {
+    if (!loop || loop->size() < 2) {
+      continue;
+    }
+    for (size_t i = 0; i < loop->size(); ++i) {
+      segments.push_back(SweepSegment{(*loop)[i], (*loop)[(i + 1) % loop->size()], 1});
+    }
+  }
 
-    // Select points at evenly spaced distances
-    std::vector<size_t> selectedIndices;
-    std::set<size_t> selectedSet;
+  std::vector<SegmentCrossing> crossings;
+  findSegmentCrossings(segments, crossings);
+  if (crossings.empty()) {
+    return;
+  }
 
-    // Always include start and end points
-    selectedIndices.push_back(0);
-    selectedSet.insert(0);
-    if (enhancedChain.size() > 1) {
-      selectedIndices.push_back(enhancedChain.size() - 1);
-      selectedSet.insert(enhancedChain.size() - 1);
+  std::vector<ArcLengthChain> arcLengths(chains.size());
+  std::vector<bool> parameterized(chains.size(), false);
+  for (const auto& crossing : crossings) {
+    // Chain segments come first, so first is the chain segment of a chain-edge pair
+    size_t c = chainSegments[crossing.first].first;
+    size_t i = chainSegments[crossing.first].second;
+    if (!parameterized[c]) {
+      arcLengths[c].assign(chains[c], unitScale);
+      parameterized[c] = true;
     }
-
-    // Calculate number of target points based on path length
-    int targetCount = std::max(2, static_cast<int>(totalLength / targetSpacing) + 1);
-
-    if (targetCount > 2 && totalLength > 0.2) {
-      // Add intermediate points at regular intervals
-      for (int target = 1; target < targetCount - 1; ++target) {
-        double targetDistance = (totalLength * target) / (targetCount - 1);
-
-        // Find the point closest to this target distance
-        size_t bestIndex = 0;
-        double bestDifference = std::abs(cumulativeDistances[0] - targetDistance);
-
-        for (size_t i = 1; i < enhancedChain.size(); ++i) {
-          double difference = std::abs(cumulativeDistances[i] - targetDistance);
-          if (difference < bestDifference) {
-            bestDifference = difference;
-            bestIndex = i;
-          }
-        }
-
-        // Add if not already selected and not too close to existing points
-        if (selectedSet.find(bestIndex) == selectedSet.end()) {
-          bool tooClose = std::any_of(selectedSet.begin(), selectedSet.end(), [&](size_t selected) {
-            return distance(enhancedChain[selected], enhancedChain[bestIndex]) < 0.1;
-          });
-
-          if (!tooClose) {
-            selectedIndices.push_back(bestIndex);
-            selectedSet.insert(bestIndex);
-          }
-        }
-      }
+    double s = arcLengths[c].arcLength(i) + distance(chains[c][i], crossing.point) * unitScale;
+    if (s >= MIN_SAMPLE_SEPARATION && arcLengths[c].totalLength() - s >= MIN_SAMPLE_SEPARATION) {
+      positions[c].push_back(s);
     }
+  }
 
-    // Sort selected indices
-    std::sort(selectedIndices.begin(), selectedIndices.end());
+  // An edge crossed at a chain vertex is found on both segments that meet there
+  for (auto& chainPositions : positions) {
+    std::sort(chainPositions.begin(), chainPositions.end());
+    chainPositions.erase(std::unique(chainPositions.begin(), chainPositions.end(),
+                                     [](double a, double b) { return b - a < MIN_SAMPLE_SEPARATION; }),
+                         chainPositions.end());
+  }
+}
 
-    // Build the sampled path from selected points
-    for (size_t idx : selectedIndices) {
-      sampledPath.points.emplace_back(enhancedChain[idx], enhancedClearances[idx]);
-    }
+std::vector<SampledMedialPath> sampleMedialAxisPaths(const std::vector<std::vector<Point2D>>& chains,
+                                                     const std::vector<std::vector<double>>& clearanceRadii,
+                                                     double targetSpacing) {
+  std::vector<SampledMedialPath> sampledPaths;
 
-    sampledPaths.push_back(sampledPath);
+  // Validate input
+  if (chains.size() != clearanceRadii.size()) {
+    // Input mismatch - return empty result
+    return sampledPaths;
   }
 
+  // Mismatched chains are skipped by fromNested
+  sampleMedialAxisChains(MedialAxisChains::fromNested(chains, clearanceRadii), 1.0, targetSpacing, sampledPaths);
   return sampledPaths;
 }
 
@@ -0,0 +1,149 @@
+/**
+ * NumberScanner.cpp
+ *
+ * Tokenizer and fast decimal conversion for embedded numbers
+ */
+
+#include "geometry/NumberScanner.h"
+
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+
+namespace ChipCarving {
+namespace Geometry {
+
+namespace {
+
+constexpr int MAX_FAST_DIGITS = 15;  // Any 15-digit integer is exact in a double
+constexpr int MAX_FAST_EXPONENT = 22;  // 10^22 is the largest exact power of ten
+constexpr size_t MAX_FALLBACK_LENGTH = 128;
+
+const double EXACT_POWERS[MAX_FAST_EXPONENT + 1] = {1e0,  1e1,  1e2,  1e3,  1e4,  1e5,  1e6,  1e7,
+                                                    1e8,  1e9,  1e10, 1e11, 1e12, 1e13, 1e14, 1e15,
+                                                    1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22};
+
+bool isDigit(char c) {
+  return c >= '0' && c <= '9';
+}
+
+// Length of the number starting at begin, 0 if none starts there
+size_t matchNumber(const char* begin, const char* end) {
+  const char* p = begin;
+  if (p < end && (*p == '-' || *p == '+')) {
+    ++p;
+  }
+  const char* digits = p;
+  while (p < end && isDigit(*p)) {
+    ++p;
+  }
+  if (p + 1 < end && *p == '.' && isDigit(p[1])) {
+    p += 2;
+    while (p < end && isDigit(*p)) {
+      ++p;
+    }
+  } else if (p == digits) {
+    return 0;
+  }
+  if (p < end && (*p == 'e' || *p == 'E')) {
+    const char* exponent = p + 1;
+    if (exponent < end && (*exponent == '-' || *exponent == '+')) {
+      ++exponent;
+    }
+    if (exponent < end && isDigit(*exponent)) {
+      p = exponent;
+      while (p < end && isDigit(*p)) {
+        ++p;
+      }
+    }
+  }
+  return static_cast<size_t>(p - begin);
+}
+
+// Exact conversion when the mantissa and the power of ten are both exact
+// doubles (one correctly rounded multiply or divide); false otherwise
+bool convertFast(const char* p, const char* end, double& value) {
+  bool negative = *p == '-';
+  if (*p == '-' || *p == '+') {
+    ++p;
+  }
+  uint64_t mantissa = 0;
+  int significant = 0;
+  int exponent = 0;
+  bool fraction = false;
+  for (; p < end && *p != 'e' && *p != 'E'; ++p) {
+    if (*p == '.') {
+      fraction = true;
+      continue;
+    }
+    if (mantissa == 0 && *p == '0') {
+      exponent -= fraction ? 1 : 0;  // Leading zeros are not significant
+      continue;
+    }
+    if (++significant > MAX_FAST_DIGITS) {
+      return false;
+    }
+    mantissa = mantissa * 10 + static_cast<uint64_t>(*p - '0');
+    exponent -= fraction ? 1 : 0;
+  }
+  if (p < end) {
+    ++p;
+    bool negativeExponent = *p == '-';
+    if (*p == '-' || *p == '+') {
+      ++p;
+    }
+    int written = 0;
+    for (; p < end; ++p) {
+      written = written * 10 + (*p - '0');
+      if (written > 1000) {
+        return false;
+      }
+    }
+    exponent += negativeExponent ? -written : written;
+  }
+
+  double result = static_cast<double>(mantissa);
+  if (exponent < -MAX_FAST_EXPONENT || exponent > MAX_FAST_EXPONENT) {
+    if (mantissa != 0) {
+      return false;
+    }
+  } else if (exponent < 0) {
+    result /= EXACT_POWERS[-exponent];
+  } else {
+    result *= EXACT_POWERS[exponent];
+  }
+  value = negative ? -result : result;
+  return true;
+}
+
+}  // namespace
+
+bool scanNumber(const char*& cursor, const char* end, double& value) {
+  for (; cursor < end; ++cursor) {
+    char c = *cursor;
+    if (!isDigit(c) && c != '-' && c != '+' && c != '.') {
+      continue;
+    }
+    size_t length = matchNumber(cursor, end);
+    if (length == 0) {
+      continue;
+    }
+    const char* number = cursor;
+    cursor += length;
+    if (convertFast(number, cursor, value)) {
+      return true;
+    }
+
+    // Copy out so strtod cannot run past the end of a non-terminated buffer
+    char buffer[MAX_FALLBACK_LENGTH];
+    size_t copied = length < MAX_FALLBACK_LENGTH ? length : MAX_FALLBACK_LENGTH - 1;
+    std::memcpy(buffer, number, copied);
+    buffer[copied] = '\0';
+    value = std::strtod(buffer, nullptr);
+    return true;
+  }
+  return false;
+}
+
+}  // namespace Geometry
+}  // namespace ChipCarving
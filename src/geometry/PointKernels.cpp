@@ -0,0 +1,192 @@
+/**
+ * PointKernels.cpp
+ *
+ * The kernels are written once against Lanes (see PointKernelsLanes.h), a few
+ * packed double operations picked at compile time from the instruction sets
+ * the compiler targets.
+ *
+ * Note: pointDistances() and linearForms() are in PointKernelsContainment.cpp
+ */
+
+#include "geometry/PointKernels.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+#include "PointKernelsLanes.h"
+
+namespace ChipCarving {
+namespace Geometry {
+
+namespace {
+
+// Squared distances are found a block at a time, then scanned in order
+constexpr size_t NEAREST_BLOCK = 64;
+
+}  // namespace
+
+PointBounds pointBounds(const Point2D* points, size_t count) {
+  PointBounds bounds;
+  if (count == 0) {
+    return bounds;
+  }
+
+  const double* data = reinterpret_cast<const double*>(points);
+  size_t n = 2 * count;
+  Lanes::Reg low = Lanes::pairs(points[0].x, points[0].y);
+  Lanes::Reg high = low;
+  size_t i = 0;
+  for (; i + WIDTH <= n; i += WIDTH) {
+    Lanes::Reg v = Lanes::load(data + i);
+    low = Lanes::min(low, v);
+    high = Lanes::max(high, v);
+  }
+
+  double lows[WIDTH];
+  double highs[WIDTH];
+  Lanes::store(lows, low);
+  Lanes::store(highs, high);
+  bounds.min = bounds.max = points[0];
+  for (size_t lane = 0; lane < WIDTH; lane += 2) {
+    bounds.min.x = std::min(bounds.min.x, lows[lane]);
+    bounds.min.y = std::min(bounds.min.y, lows[lane + 1]);
+    bounds.max.x = std::max(bounds.max.x, highs[lane]);
+    bounds.max.y = std::max(bounds.max.y, highs[lane + 1]);
+  }
+  for (size_t point = i / 2; point < count; ++point) {
+    bounds.min.x = std::min(bounds.min.x, points[point].x);
+    bounds.min.y = std::min(bounds.min.y, points[point].y);
+    bounds.max.x = std::max(bounds.max.x, points[point].x);
+    bounds.max.y = std::max(bounds.max.y, points[point].y);
+  }
+  return bounds;
+}
+
+PointBounds pointBounds(const double* x, const double* y, size_t count) {
+  PointBounds bounds;
+  if (count == 0) {
+    return bounds;
+  }
+
+  Lanes::Reg lowX = Lanes::broadcast(x[0]);
+  Lanes::Reg lowY = Lanes::broadcast(y[0]);
+  Lanes::Reg highX = lowX;
+  Lanes::Reg highY = lowY;
+  size_t i = 0;
+  for (; i + WIDTH <= count; i += WIDTH) {
+    Lanes::Reg vx = Lanes::load(x + i);
+    Lanes::Reg vy = Lanes::load(y + i);
+    lowX = Lanes::min(lowX, vx);
+    lowY = Lanes::min(lowY, vy);
+    highX = Lanes::max(highX, vx);
+    highY = Lanes::max(highY, vy);
+  }
+
+  double lanes[4][WIDTH];
+  Lanes::store(lanes[0], lowX);
+  Lanes::store(lanes[1], lowY);
+  Lanes::store(lanes[2], highX);
+  Lanes::store(lanes[3], highY);
+  bounds.min = bounds.max = Point2D(x[0], y[0]);
+  for (size_t lane = 0; lane < WIDTH; ++lane) {
+    bounds.min.x = std::min(bounds.min.x, lanes[0][lane]);
+    bounds.min.y = std::min(bounds.min.y, lanes[1][lane]);
+    bounds.max.x = std::max(bounds.max.x, lanes[2][lane]);
+    bounds.max.y = std::max(bounds.max.y, lanes[3][lane]);
+  }
+  for (; i < count; ++i) {
+    bounds.min.x = std::min(bounds.min.x, x[i]);
+    bounds.min.y = std::min(bounds.min.y, y[i]);
+    bounds.max.x = std::max(bounds.max.x, x[i]);
+    bounds.max.y = std::max(bounds.max.y, y[i]);
+  }
+  return bounds;
+}
+
+void transformPoints(const Point2D* points, size_t count, const Point2D& offset, double scale, Point2D* out) {
+  const double* in = reinterpret_cast<const double*>(points);
+  double* result = reinterpret_cast<double*>(out);
+  size_t n = 2 * count;
+  Lanes::Reg shift = Lanes::pairs(offset.x, offset.y);
+  Lanes::Reg factor = Lanes::broadcast(scale);
+  size_t i = 0;
+  for (; i + WIDTH <= n; i += WIDTH) {
+    Lanes::store(result + i, Lanes::mul(Lanes::sub(Lanes::load(in + i), shift), factor));
+  }
+  for (size_t point = i / 2; point < count; ++point) {
+    out[point] = Point2D((points[point].x - offset.x) * scale, (points[point].y - offset.y) * scale);
+  }
+}
+
+void segmentLengths(const double* x, const double* y, size_t count, double scale, double* lengths) {
+  if (count < 2) {
+    return;
+  }
+
+  size_t segments = count - 1;
+  Lanes::Reg factor = Lanes::broadcast(scale);
+  size_t i = 0;
+  for (; i + WIDTH <= segments; i += WIDTH) {
+    Lanes::Reg dx = Lanes::sub(Lanes::mul(Lanes::load(x + i + 1), factor), Lanes::mul(Lanes::load(x + i), factor));
+    Lanes::Reg dy = Lanes::sub(Lanes::mul(Lanes::load(y + i + 1), factor), Lanes::mul(Lanes::load(y + i), factor));
+    Lanes::store(lengths + i, Lanes::sqrt(Lanes::add(Lanes::mul(dx, dx), Lanes::mul(dy, dy))));
+  }
+  for (; i < segments; ++i) {
+    lengths[i] = distance(Point2D(x[i] * scale, y[i] * scale), Point2D(x[i + 1] * scale, y[i + 1] * scale));
+  }
+}
+
+double cumulativeLengths(const double* x, const double* y, size_t count, double scale, double* lengths) {
+  if (count == 0) {
+    return 0.0;
+  }
+
+  // Segment lengths in parallel, then the running sum in order
+  lengths[0] = 0.0;
+  segmentLengths(x, y, count, scale, lengths + 1);
+  for (size_t i = 1; i < count; ++i) {
+    lengths[i] += lengths[i - 1];
+  }
+  return lengths[count - 1];
+}
+
+size_t nearestPoint(const double* x, const double* y, size_t count, const Point2D& query, double& distanceSquared) {
+  Lanes::Reg queryX = Lanes::broadcast(query.x);
+  Lanes::Reg queryY = Lanes::broadcast(query.y);
+  double block[NEAREST_BLOCK];
+  size_t nearest = 0;
+  distanceSquared = std::numeric_limits<double>::infinity();
+
+  for (size_t start = 0; start < count; start += NEAREST_BLOCK) {
+    size_t size = std::min(NEAREST_BLOCK, count - start);
+    const double* blockX = x + start;
+    const double* blockY = y + start;
+    size_t i = 0;
+    for (; i + WIDTH <= size; i += WIDTH) {
+      Lanes::Reg dx = Lanes::sub(Lanes::load(blockX + i), queryX);
+      Lanes::Reg dy = Lanes::sub(Lanes::load(blockY + i), queryY);
+      Lanes::store(block + i, Lanes::add(Lanes::mul(dx, dx), Lanes::mul(dy, dy)));
+    }
+    for (; i < size; ++i) {
+      double dx = blockX[i] - query.x;
+      double dy = blockY[i] - query.y;
+      block[i] = dx * dx + dy * dy;
+    }
+
+    for (i = 0; i < size; ++i) {
+      if (block[i] < distanceSquared) {
+        distanceSquared = block[i];
+        nearest = start + i;
+      }
+    }
+  }
+  return nearest;
+}
+
+const char* pointKernelInstructionSet() {
+  return Lanes::NAME;
+}
+
+}  // namespace Geometry
+}  // namespace ChipCarving
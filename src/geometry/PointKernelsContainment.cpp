@@ -0,0 +1,50 @@
+/**
+ * PointKernelsContainment.cpp
+ *
+ * Point kernels of the batch point-in-shape query (see ShapeContainment.h):
+ * distances to a circle's center and the linear forms of barycentric
+ * coordinates
+ * Split from PointKernels.cpp for maintainability
+ */
+
+#include "geometry/PointKernels.h"
+
+#include "PointKernelsLanes.h"
+
+namespace ChipCarving {
+namespace Geometry {
+
+void pointDistances(const double* x, const double* y, size_t count, const Point2D& center, double* distances) {
+  Lanes::Reg centerX = Lanes::broadcast(center.x);
+  Lanes::Reg centerY = Lanes::broadcast(center.y);
+  size_t i = 0;
+  for (; i + WIDTH <= count; i += WIDTH) {
+    Lanes::Reg dx = Lanes::sub(centerX, Lanes::load(x + i));
+    Lanes::Reg dy = Lanes::sub(centerY, Lanes::load(y + i));
+    Lanes::store(distances + i, Lanes::sqrt(Lanes::add(Lanes::mul(dx, dx), Lanes::mul(dy, dy))));
+  }
+  for (; i < count; ++i) {
+    distances[i] = distance(Point2D(x[i], y[i]), center);
+  }
+}
+
+void linearForms(const double* x, const double* y, size_t count, const Point2D& origin, const Point2D& coefficients,
+                 double divisor, double* values) {
+  Lanes::Reg originX = Lanes::broadcast(origin.x);
+  Lanes::Reg originY = Lanes::broadcast(origin.y);
+  Lanes::Reg a = Lanes::broadcast(coefficients.x);
+  Lanes::Reg b = Lanes::broadcast(coefficients.y);
+  Lanes::Reg d = Lanes::broadcast(divisor);
+  size_t i = 0;
+  for (; i + WIDTH <= count; i += WIDTH) {
+    Lanes::Reg ax = Lanes::mul(a, Lanes::sub(Lanes::load(x + i), originX));
+    Lanes::Reg by = Lanes::mul(b, Lanes::sub(Lanes::load(y + i), originY));
+    Lanes::store(values + i, Lanes::div(Lanes::add(ax, by), d));
+  }
+  for (; i < count; ++i) {
+    values[i] = (coefficients.x * (x[i] - origin.x) + coefficients.y * (y[i] - origin.y)) / divisor;
+  }
+}
+
+}  // namespace Geometry
+}  // namespace ChipCarving
@@ -0,0 +1,217 @@
+/**
+ * PointKernelsLanes.h
+ *
+ * Lanes, the few packed double operations the point kernels are written
+ * against, picked at compile time from the instruction sets the compiler
+ * targets (internal to src/geometry). WIDTH is even on every path, so an
+ * interleaved Point2D array loads as whole points: x in the even lanes, y in
+ * the odd ones.
+ * Split from PointKernels.cpp for maintainability
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <type_traits>
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#define POINT_KERNELS_AVX2
+#elif defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define POINT_KERNELS_SSE2
+#elif defined(__aarch64__) && defined(__ARM_NEON)
+#include <arm_neon.h>
+#define POINT_KERNELS_NEON
+#endif
+
+#include "geometry/Point2D.h"
+
+namespace ChipCarving {
+namespace Geometry {
+
+static_assert(std::is_standard_layout<Point2D>::value && sizeof(Point2D) == 2 * sizeof(double),
+              "Point2D arrays are read as interleaved x, y doubles");
+
+#if defined(POINT_KERNELS_AVX2)
+
+struct Lanes {
+  using Reg = __m256d;
+  static constexpr size_t WIDTH = 4;
+  static constexpr const char* NAME = "avx2";
+
+  static Reg load(const double* p) {
+    return _mm256_loadu_pd(p);
+  }
+  static void store(double* p, Reg v) {
+    _mm256_storeu_pd(p, v);
+  }
+  static Reg broadcast(double a) {
+    return _mm256_set1_pd(a);
+  }
+  // a in the even lanes, b in the odd ones
+  static Reg pairs(double a, double b) {
+    return _mm256_setr_pd(a, b, a, b);
+  }
+  static Reg add(Reg a, Reg b) {
+    return _mm256_add_pd(a, b);
+  }
+  static Reg sub(Reg a, Reg b) {
+    return _mm256_sub_pd(a, b);
+  }
+  static Reg mul(Reg a, Reg b) {
+    return _mm256_mul_pd(a, b);
+  }
+  static Reg div(Reg a, Reg b) {
+    return _mm256_div_pd(a, b);
+  }
+  static Reg min(Reg a, Reg b) {
+    return _mm256_min_pd(a, b);
+  }
+  static Reg max(Reg a, Reg b) {
+    return _mm256_max_pd(a, b);
+  }
+  static Reg sqrt(Reg a) {
+    return _mm256_sqrt_pd(a);
+  }
+};
+
+#elif defined(POINT_KERNELS_SSE2)
+
+struct Lanes {
+  using Reg = __m128d;
+  static constexpr size_t WIDTH = 2;
+  static constexpr const char* NAME = "sse2";
+
+  static Reg load(const double* p) {
+    return _mm_loadu_pd(p);
+  }
+  static void store(double* p, Reg v) {
+    _mm_storeu_pd(p, v);
+  }
+  static Reg broadcast(double a) {
+    return _mm_set1_pd(a);
+  }
+  static Reg pairs(double a, double b) {
+    return _mm_setr_pd(a, b);
+  }
+  static Reg add(Reg a, Reg b) {
+    return _mm_add_pd(a, b);
+  }
+  static Reg sub(Reg a, Reg b) {
+    return _mm_sub_pd(a, b);
+  }
+  static Reg mul(Reg a, Reg b) {
+    return _mm_mul_pd(a, b);
+  }
+  static Reg div(Reg a, Reg b) {
+    return _mm_div_pd(a, b);
+  }
+  static Reg min(Reg a, Reg b) {
+    return _mm_min_pd(a, b);
+  }
+  static Reg max(Reg a, Reg b) {
+    return _mm_max_pd(a, b);
+  }
+  static Reg sqrt(Reg a) {
+    return _mm_sqrt_pd(a);
+  }
+};
+
+#elif defined(POINT_KERNELS_NEON)
+
+struct Lanes {
+  using Reg = float64x2_t;
+  static constexpr size_t WIDTH = 2;
+  static constexpr const char* NAME = "neon";
+
+  static Reg load(const double* p) {
+    return vld1q_f64(p);
+  }
+  static void store(double* p, Reg v) {
+    vst1q_f64(p, v);
+  }
+  static Reg broadcast(double a) {
+    return vdupq_n_f64(a);
+  }
+  static Reg pairs(double a, double b) {
+    return vsetq_lane_f64(b, vdupq_n_f64(a), 1);
+  }
+  static Reg add(Reg a, Reg b) {
+    return vaddq_f64(a, b);
+  }
+  static Reg sub(Reg a, Reg b) {
+    return vsubq_f64(a, b);
+  }
+  static Reg mul(Reg a, Reg b) {
+    return vmulq_f64(a, b);
+  }
+  static Reg div(Reg a, Reg b) {
+    return vdivq_f64(a, b);
+  }
+  static Reg min(Reg a, Reg b) {
+    return vminq_f64(a, b);
+  }
+  static Reg max(Reg a, Reg b) {
+    return vmaxq_f64(a, b);
+  }
+  static Reg sqrt(Reg a) {
+    return vsqrtq_f64(a);
+  }
+};
+
+#else
+
+// Two plain doubles; the compiler is free to vectorize them itself
+struct Lanes {
+  struct Reg {
+    double lane[2];
+  };
+  static constexpr size_t WIDTH = 2;
+  static constexpr const char* NAME = "scalar";
+
+  static Reg load(const double* p) {
+    return Reg{{p[0], p[1]}};
+  }
+  static void store(double* p, Reg v) {
+    p[0] = v.lane[0];
+    p[1] = v.lane[1];
+  }
+  static Reg broadcast(double a) {
+    return Reg{{a, a}};
+  }
+  static Reg pairs(double a, double b) {
+    return Reg{{a, b}};
+  }
+  static Reg add(Reg a, Reg b) {
+    return Reg{{a.lane[0] + b.lane[0], a.lane[1] + b.lane[1]}};
+  }
+  static Reg sub(Reg a, Reg b) {
+    return Reg{{a.lane[0] - b.lane[0], a.lane[1] - b.lane[1]}};
+  }
+  static Reg mul(Reg a, Reg b) {
+    return Reg{{a.lane[0] * b.lane[0], a.lane[1] * b.lane[1]}};
+  }
+  static Reg div(Reg a, Reg b) {
+    return Reg{{a.lane[0] / b.lane[0], a.lane[1] / b.lane[1]}};
+  }
+  static Reg min(Reg a, Reg b) {
+    return Reg{{std::min(a.lane[0], b.lane[0]), std::min(a.lane[1], b.lane[1])}};
+  }
+  static Reg max(Reg a, Reg b) {
+    return Reg{{std::max(a.lane[0], b.lane[0]), std::max(a.lane[1], b.lane[1])}};
+  }
+  static Reg sqrt(Reg a) {
+    return Reg{{std::sqrt(a.lane[0]), std::sqrt(a.lane[1])}};
+  }
+};
+
+#endif
+
+constexpr size_t WIDTH = Lanes::WIDTH;
+static_assert(WIDTH % 2 == 0, "interleaved points need an even lane count");
+
+}  // namespace Geometry
+}  // namespace ChipCarving
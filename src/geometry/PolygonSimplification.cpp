@@ -0,0 +1,99 @@
+/**
+ * PolygonSimplification.cpp
+ *
+ * Corner-preserving Douglas-Peucker for closed polygons
+ */
+
+#include "geometry/PolygonSimplification.h"
+
+#include <cmath>
+
+#include "geometry/Point3D.h"
+#include "geometry/PolylineSimplifier.h"
+
+namespace ChipCarving {
+namespace Geometry {
+
+namespace {
+
+// Turning angle at b between edges a -> b and b -> c
+double turnAngle(const Point2D& a, const Point2D& b, const Point2D& c) {
+  double ux = b.x - a.x;
+  double uy = b.y - a.y;
+  double vx = c.x - b.x;
+  double vy = c.y - b.y;
+  return std::abs(std::atan2(ux * vy - uy * vx, ux * vx + uy * vy));
+}
+
+}  // namespace
+
+std::vector<Point2D> simplifyPolygon(const std::vector<Point2D>& polygon, double tolerance, double cornerAngle) {
+  std::vector<Point2D> ring = polygon;
+  bool closingDuplicate = ring.size() > 3 && distance(ring.front(), ring.back()) < 1e-10;
+  if (closingDuplicate) {
+    ring.pop_back();
+  }
+  size_t n = ring.size();
+  if (n <= 3 || !(tolerance > 0.0)) {
+    return polygon;
+  }
+
+  // Span boundaries: every sharp corner, or vertex 0 and the vertex farthest from it
+  std::vector<size_t> anchors;
+  for (size_t i = 0; i < n; ++i) {
+    if (turnAngle(ring[(i + n - 1) % n], ring[i], ring[(i + 1) % n]) > cornerAngle) {
+      anchors.push_back(i);
+    }
+  }
+  if (anchors.size() < 2) {
+    size_t start = anchors.empty() ? 0 : anchors.front();
+    size_t farthest = start;
+    for (size_t i = 0; i < n; ++i) {
+      if (distance(ring[i], ring[start]) > distance(ring[farthest], ring[start])) {
+        farthest = i;
+      }
+    }
+    anchors = {start};
+    if (farthest != start) {
+      anchors.push_back(farthest);
+    }
+  }
+
+  std::vector<bool> keep(n, false);
+  PolylineSimplifier simplifier;
+  std::vector<Point3D> span;
+  std::vector<bool> spanKeep;
+  for (size_t a = 0; a < anchors.size(); ++a) {
+    size_t first = anchors[a];
+    size_t last = anchors[(a + 1) % anchors.size()];
+    size_t length = (last + n - first) % n;
+    if (length == 0) {
+      length = n;  // Single anchor: the span goes all the way round
+    }
+    span.clear();
+    for (size_t k = 0; k <= length; ++k) {
+      span.emplace_back(ring[(first + k) % n], 0.0);
+    }
+    simplifier.markRequired(span, tolerance, spanKeep);
+    for (size_t k = 0; k < length; ++k) {
+      keep[(first + k) % n] = keep[(first + k) % n] || spanKeep[k];
+    }
+  }
+
+  std::vector<Point2D> simplified;
+  for (size_t i = 0; i < n; ++i) {
+    if (keep[i]) {
+      simplified.push_back(ring[i]);
+    }
+  }
+  if (simplified.size() < 3) {
+    return polygon;
+  }
+  if (closingDuplicate) {
+    simplified.push_back(simplified.front());
+  }
+  return simplified;
+}
+
+}  // namespace Geometry
+}  // namespace ChipCarving
@@ -0,0 +1,250 @@
+/**
+ * PolylineArcFitter.cpp
+ *
+ * Line/arc span fitting for 3D toolpath polylines
+ */
+
+#include "geometry/PolylineArcFitter.h"
+
+#include <algorithm>
+#include <cmath>
+
+namespace ChipCarving {
+namespace Geometry {
+
+namespace {
+
+constexpr double TWO_PI = 2.0 * M_PI;
+
+// Cross product magnitude (squared, relative to edge lengths) below which three points are collinear
+constexpr double MIN_RELATIVE_AREA = 1e-12;
+
+double dot(const Point3D& a, const Point3D& b) {
+  return a.x * b.x + a.y * b.y + a.z * b.z;
+}
+
+Point3D cross(const Point3D& a, const Point3D& b) {
+  return Point3D(a.y * b.z - a.z * b.y, a.z * b.x - a.x * b.z, a.x * b.y - a.y * b.x);
+}
+
+// Circle through three points, with an in-plane frame so that a -> b -> c runs
+// counter-clockwise (increasing angle) from a at angle 0
+struct Circle3D {
+  Point3D center;
+  Point3D axisU;
+  Point3D axisV;
+  Point3D normal;
+  double radius = 0.0;
+
+  bool fromPoints(const Point3D& a, const Point3D& b, const Point3D& c) {
+    Point3D u = b - a;
+    Point3D v = c - a;
+    Point3D w = cross(u, v);
+    double w2 = dot(w, w);
+    if (w2 <= MIN_RELATIVE_AREA * dot(u, u) * dot(v, v)) {
+      return false;
+    }
+    Point3D offset = cross(v * dot(u, u) - u * dot(v, v), w) * (1.0 / (2.0 * w2));
+    center = a + offset;
+    radius = offset.magnitude();
+    normal = w.normalize();
+    axisU = (a - center).normalize();
+    axisV = cross(normal, axisU);
+    return true;
+  }
+
+  double angleOf(const Point3D& p) const {
+    Point3D d = p - center;
+    double angle = std::atan2(dot(d, axisV), dot(d, axisU));
+    return angle < 0.0 ? angle + TWO_PI : angle;
+  }
+
+  double distanceTo(const Point3D& p) const {
+    Point3D d = p - center;
+    double alongNormal = dot(d, normal);
+    Point3D inPlane = d - normal * alongNormal;
+    double radial = inPlane.magnitude() - radius;
+    return std::sqrt(radial * radial + alongNormal * alongNormal);
+  }
+};
+
+// Whether points [first, last] form an arc within tolerance
+bool fitsArc(const std::vector<Point3D>& points, size_t first, size_t last, double tolerance) {
+  Circle3D circle;
+  size_t mid = (first + last) / 2;
+  if (!circle.fromPoints(points[first], points[mid], points[last])) {
+    return false;
+  }
+
+  // Too flat: a straight segment is within tolerance of the arc
+  double endAngle = circle.angleOf(points[last]);
+  double halfChord = 0.5 * points[first].distance(points[last]);
+  double sagitta = circle.radius - std::sqrt(std::max(0.0, circle.radius * circle.radius - halfChord * halfChord));
+  if (endAngle < M_PI && sagitta <= tolerance) {
+    return false;
+  }
+
+  double previousAngle = 0.0;
+  for (size_t i = first + 1; i <= last; ++i) {
+    if (circle.distanceTo(points[i]) > tolerance) {
+      return false;
+    }
+    double angle = i == last ? endAngle : circle.angleOf(points[i]);
+    if (angle <= previousAngle || angle > endAngle) {
+      return false;
+    }
+    previousAngle = angle;
+  }
+  return true;
+}
+
+// Whether points [first, last] form a helical arc within tolerance
+bool fitsHelicalArc(const std::vector<Point3D>& points, size_t first, size_t last, double tolerance) {
+  HelicalArc arc;
+  const Point3D& start = points[first];
+  const Point3D& end = points[last];
+  if (!helicalArcThrough(start, points[(first + last) / 2], end, arc)) {
+    return false;
+  }
+
+  double direction = arc.counterClockwise ? 1.0 : -1.0;
+  double startAngle = std::atan2(start.y - arc.center.y, start.x - arc.center.x);
+  auto sweepTo = [&](const Point3D& p) {
+    double sweep = direction * (std::atan2(p.y - arc.center.y, p.x - arc.center.x) - startAngle);
+    while (sweep < 0.0) sweep += TWO_PI;
+    while (sweep >= TWO_PI) sweep -= TWO_PI;
+    return sweep;
+  };
+
+  // Too flat: a straight segment is within tolerance of the arc
+  double endSweep = sweepTo(end);
+  double halfChord = 0.5 * std::hypot(end.x - start.x, end.y - start.y);
+  double sagitta = arc.radius - std::sqrt(std::max(0.0, arc.radius * arc.radius - halfChord * halfChord));
+  if (endSweep < M_PI && sagitta <= tolerance) {
+    return false;
+  }
+
+  double previousSweep = 0.0;
+  for (size_t i = first + 1; i <= last; ++i) {
+    const Point3D& p = points[i];
+    if (std::abs(std::hypot(p.x - arc.center.x, p.y - arc.center.y) - arc.radius) > tolerance) {
+      return false;
+    }
+    double sweep = i == last ? endSweep : sweepTo(p);
+    if (sweep <= previousSweep || sweep > endSweep) {
+      return false;
+    }
+    double z = start.z + (end.z - start.z) * (sweep / endSweep);
+    if (std::abs(p.z - z) > tolerance) {
+      return false;
+    }
+    previousSweep = sweep;
+  }
+  return true;
+}
+
+/**
+ * Last point of the longest arc from first that fits() accepts, or first if
+ * none does. Each fits() call checks every point of the arc, so growing one
+ * point at a time costs quadratic time on long smooth curves; the arc length
+ * doubles until it stops fitting and the boundary is then bisected instead.
+ */
+template <typename Fits>
+size_t longestArc(const std::vector<Point3D>& points, size_t first, double tolerance, Fits fits) {
+  size_t good = first + MIN_ARC_POINTS - 1;
+  if (good >= points.size() || !fits(points, first, good, tolerance)) {
+    return first;
+  }
+  size_t bad = points.size();  // Shortest arc known not to fit (none yet)
+  for (size_t step = 1; good + 1 < bad; step *= 2) {
+    size_t next = std::min(good + step, points.size() - 1);
+    if (!fits(points, first, next, tolerance)) {
+      bad = next;
+      break;
+    }
+    good = next;
+    if (good == points.size() - 1) {
+      return good;
+    }
+  }
+  while (good + 1 < bad) {
+    size_t mid = good + (bad - good) / 2;
+    if (fits(points, first, mid, tolerance)) {
+      good = mid;
+    } else {
+      bad = mid;
+    }
+  }
+  return good;
+}
+
+// Greedy cover: take the longest arc that fits(), else one line segment
+template <typename Fits>
+std::vector<PolylineSpan> coverWithSpans(const std::vector<Point3D>& points, double tolerance, Fits fits) {
+  std::vector<PolylineSpan> spans;
+  if (points.size() < 2) {
+    return spans;
+  }
+
+  auto addLine = [&spans](size_t first, size_t last) {
+    if (!spans.empty() && !spans.back().isArc) {
+      spans.back().last = last;  // Extend the current line run
+      return;
+    }
+    PolylineSpan span;
+    span.first = first;
+    span.last = last;
+    spans.push_back(span);
+  };
+
+  size_t first = 0;
+  while (first + 1 < points.size()) {
+    size_t arcLast = tolerance > 0.0 ? longestArc(points, first, tolerance, fits) : first;
+
+    if (arcLast > first) {
+      PolylineSpan span;
+      span.isArc = true;
+      span.first = first;
+      span.last = arcLast;
+      spans.push_back(span);
+      first = arcLast;
+    } else {
+      addLine(first, first + 1);
+      first++;
+    }
+  }
+  return spans;
+}
+
+}  // namespace
+
+std::vector<PolylineSpan> fitPolylineSpans(const std::vector<Point3D>& points, double tolerance) {
+  return coverWithSpans(points, tolerance, fitsArc);
+}
+
+bool helicalArcThrough(const Point3D& a, const Point3D& b, const Point3D& c, HelicalArc& arc) {
+  double bx = b.x - a.x;
+  double by = b.y - a.y;
+  double cx = c.x - a.x;
+  double cy = c.y - a.y;
+  double cross = bx * cy - by * cx;
+  double b2 = bx * bx + by * by;
+  double c2 = cx * cx + cy * cy;
+  if (cross * cross <= MIN_RELATIVE_AREA * b2 * c2) {
+    return false;
+  }
+
+  double ux = (cy * b2 - by * c2) / (2.0 * cross);
+  double uy = (bx * c2 - cx * b2) / (2.0 * cross);
+  arc.center = Point2D(a.x + ux, a.y + uy);
+  arc.radius = std::hypot(ux, uy);
+  arc.counterClockwise = cross > 0.0;
+  return true;
+}
+
+std::vector<PolylineSpan> fitHelicalArcSpans(const std::vector<Point3D>& points, double tolerance) {
+  return coverWithSpans(points, tolerance, fitsHelicalArc);
+}
+
+}  // namespace Geometry
+}  // namespace ChipCarving
@@ -0,0 +1,97 @@
+/**
+ * PolylineSimplifier.cpp
+ *
+ * Douglas-Peucker simplification of 3D polylines
+ */
+
+#include "geometry/PolylineSimplifier.h"
+
+#include <algorithm>
+
+namespace ChipCarving {
+namespace Geometry {
+
+void PolylineSimplifier::computeChordDistances(size_t first, size_t last) {
+  const double ax = x_[first];
+  const double ay = y_[first];
+  const double az = z_[first];
+  const double dx = x_[last] - ax;
+  const double dy = y_[last] - ay;
+  const double dz = z_[last] - az;
+  const double len2 = dx * dx + dy * dy + dz * dz;
+  const double invLen2 = len2 > 0.0 ? 1.0 / len2 : 0.0;
+
+  const double* x = x_.data();
+  const double* y = y_.data();
+  const double* z = z_.data();
+  double* distance2 = distance2_.data();
+  for (size_t i = first + 1; i < last; ++i) {
+    double px = x[i] - ax;
+    double py = y[i] - ay;
+    double pz = z[i] - az;
+    double t = std::min(1.0, std::max(0.0, (px * dx + py * dy + pz * dz) * invLen2));
+    double ex = px - t * dx;
+    double ey = py - t * dy;
+    double ez = pz - t * dz;
+    distance2[i] = ex * ex + ey * ey + ez * ez;
+  }
+}
+
+void PolylineSimplifier::markRequired(const std::vector<Point3D>& points, double tolerance,
+                                      std::vector<bool>& keep) {
+  size_t n = points.size();
+  keep.assign(n, n <= 2);
+  if (n <= 2) {
+    return;
+  }
+  keep.front() = true;
+  keep.back() = true;
+
+  x_.resize(n);
+  y_.resize(n);
+  z_.resize(n);
+  distance2_.resize(n);
+  for (size_t i = 0; i < n; ++i) {
+    x_[i] = points[i].x;
+    y_[i] = points[i].y;
+    z_[i] = points[i].z;
+  }
+
+  double tolerance2 = tolerance * tolerance;
+  spans_.clear();
+  spans_.emplace_back(0, n - 1);
+  while (!spans_.empty()) {
+    size_t first = spans_.back().first;
+    size_t last = spans_.back().second;
+    spans_.pop_back();
+    if (last - first < 2) {
+      continue;
+    }
+
+    computeChordDistances(first, last);
+    auto farthest = std::max_element(distance2_.begin() + first + 1, distance2_.begin() + last);
+    if (*farthest > tolerance2) {
+      size_t split = static_cast<size_t>(farthest - distance2_.begin());
+      keep[split] = true;
+      spans_.emplace_back(first, split);
+      spans_.emplace_back(split, last);
+    }
+  }
+}
+
+size_t PolylineSimplifier::simplify(std::vector<Point3D>& points, double tolerance) {
+  markRequired(points, tolerance, keep_);
+
+  size_t kept = 0;
+  for (size_t i = 0; i < points.size(); ++i) {
+    if (keep_[i]) {
+      points[kept++] = points[i];
+    }
+  }
+  size_t removed = points.size() - kept;
+  points.resize(kept);
+  return removed;
+}
+
+}  // namespace Geometry
+}  // namespace ChipCarving
@@ -0,0 +1,208 @@
+/**
+ * ProfileCurve.cpp
+ *
+ * Chord-error polygonization of profile lines, arcs and NURBS splines
+ */
+
+#include "geometry/ProfileCurve.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <utility>
+
+#include "geometry/Shape.h"
+#include "geometry/ShapePolygonizer.h"
+
+namespace ChipCarving {
+namespace Geometry {
+
+namespace {
+
+const int MAX_SPLINE_DEGREE = 15;
+const int MAX_ARC_SEGMENTS = 512;   // Same cap as the shape polygonizer
+const int SPLINE_SPAN_SAMPLES = 4;  // Pieces per knot span before bisection, so no inflection is skipped
+const int MAX_SPLINE_DEPTH = 10;    // Bisections per piece
+
+double distanceToSegment(const Point2D& point, const Point2D& a, const Point2D& b) {
+  Point2D ab = b - a;
+  double lengthSquared = ab.x * ab.x + ab.y * ab.y;
+  if (lengthSquared <= 0.0) {
+    return distance(point, a);
+  }
+  double t = ((point.x - a.x) * ab.x + (point.y - a.y) * ab.y) / lengthSquared;
+  t = std::max(0.0, std::min(1.0, t));
+  return distance(point, a + ab * t);
+}
+
+Point2D arcPoint(const ProfileCurve& arc, double angle) {
+  return Point2D(arc.center.x + arc.radius * std::cos(angle), arc.center.y + arc.radius * std::sin(angle));
+}
+
+// Arc points from start to end inclusive
+void appendArcPoints(const ProfileCurve& arc, double maxError, std::vector<Point2D>& polygon) {
+  double sweep = std::abs(arc.sweep);
+  int steps = arcSegmentCount(arc.radius, sweep, maxError);
+  if (sweep >= 2.0 * M_PI - 1e-9) {
+    steps = std::max(steps, 3);  // A full circle must still enclose an area
+  }
+  // The sagitta bound is exact in theory; measure the first chord to catch rounding
+  while (steps < MAX_ARC_SEGMENTS &&
+         calculateChordToArcError(arcPoint(arc, arc.startAngle), arcPoint(arc, arc.startAngle + arc.sweep / steps),
+                                  arc.center, arc.radius) > maxError) {
+    ++steps;
+  }
+
+  polygon.push_back(arc.start);
+  for (int i = 1; i < steps; ++i) {
+    polygon.push_back(arcPoint(arc, arc.startAngle + arc.sweep * i / steps));
+  }
+  polygon.push_back(arc.end);
+}
+
+// Bisect [t0, t1] until the chord midpoint is within maxError; appends the points after p0
+void appendSplinePiece(const ProfileCurve& spline, double t0, const Point2D& p0, double t1, const Point2D& p1,
+                       double maxError, int depth, std::vector<Point2D>& polygon) {
+  double tm = 0.5 * (t0 + t1);
+  Point2D pm = evaluateSplineCurve(spline, tm);
+  if (depth < MAX_SPLINE_DEPTH && distanceToSegment(pm, p0, p1) > maxError) {
+    appendSplinePiece(spline, t0, p0, tm, pm, maxError, depth + 1, polygon);
+    appendSplinePiece(spline, tm, pm, t1, p1, maxError, depth + 1, polygon);
+    return;
+  }
+  polygon.push_back(p1);
+}
+
+// Spline points from start to end inclusive
+void appendSplinePoints(const ProfileCurve& spline, double maxError, std::vector<Point2D>& polygon) {
+  size_t count = spline.controlPoints.size();
+  size_t degree = static_cast<size_t>(spline.degree);
+  polygon.push_back(evaluateSplineCurve(spline, spline.knots[degree]));
+  for (size_t span = degree; span < count; ++span) {
+    double spanStart = spline.knots[span];
+    double spanEnd = spline.knots[span + 1];
+    if (spanEnd <= spanStart) {
+      continue;
+    }
+    double t0 = spanStart;
+    Point2D p0 = polygon.back();
+    for (int i = 1; i <= SPLINE_SPAN_SAMPLES; ++i) {
+      double t1 = spanStart + (spanEnd - spanStart) * i / SPLINE_SPAN_SAMPLES;
+      Point2D p1 = evaluateSplineCurve(spline, t1);
+      appendSplinePiece(spline, t0, p0, t1, p1, maxError, 0, polygon);
+      t0 = t1;
+      p0 = p1;
+    }
+  }
+}
+
+}  // namespace
+
+ProfileCurve makeLineCurve(const Point2D& start, const Point2D& end) {
+  ProfileCurve curve;
+  curve.start = start;
+  curve.end = end;
+  return curve;
+}
+
+ProfileCurve makeArcCurve(const Point2D& center, double radius, double startAngle, double sweep) {
+  ProfileCurve curve;
+  curve.type = ProfileCurve::Type::ARC;
+  curve.center = center;
+  curve.radius = radius;
+  curve.startAngle = startAngle;
+  curve.sweep = sweep;
+  curve.start = arcPoint(curve, startAngle);
+  curve.end = arcPoint(curve, startAngle + sweep);
+  return curve;
+}
+
+ProfileCurve makeSplineCurve(int degree, std::vector<Point2D> controlPoints, std::vector<double> weights,
+                             std::vector<double> knots) {
+  if (controlPoints.empty()) {
+    return ProfileCurve();
+  }
+  size_t count = controlPoints.size();
+  size_t order = static_cast<size_t>(degree) + 1;
+  bool valid = degree >= 1 && degree <= MAX_SPLINE_DEGREE && count >= order && knots.size() == count + order &&
+               (weights.empty() || weights.size() == count) && std::is_sorted(knots.begin(), knots.end()) &&
+               knots[degree] < knots[count];
+  if (!valid) {
+    return makeLineCurve(controlPoints.front(), controlPoints.back());
+  }
+
+  ProfileCurve curve;
+  curve.type = ProfileCurve::Type::SPLINE;
+  curve.degree = degree;
+  curve.controlPoints = std::move(controlPoints);
+  curve.weights = std::move(weights);
+  curve.knots = std::move(knots);
+  curve.start = evaluateSplineCurve(curve, curve.knots[degree]);
+  curve.end = evaluateSplineCurve(curve, curve.knots[count]);
+  return curve;
+}
+
+Point2D evaluateSplineCurve(const ProfileCurve& curve, double t) {
+  // de Boor's algorithm in homogeneous coordinates
+  const std::vector<double>& knots = curve.knots;
+  size_t p = static_cast<size_t>(curve.degree);
+  size_t count = curve.controlPoints.size();
+  t = std::max(knots[p], std::min(knots[count], t));
+  size_t k = p;
+  while (k + 1 < count && knots[k + 1] <= t) {
+    ++k;
+  }
+
+  double x[MAX_SPLINE_DEGREE + 1];
+  double y[MAX_SPLINE_DEGREE + 1];
+  double w[MAX_SPLINE_DEGREE + 1];
+  for (size_t j = 0; j <= p; ++j) {
+    const Point2D& control = curve.controlPoints[k - p + j];
+    w[j] = curve.weights.empty() ? 1.0 : curve.weights[k - p + j];
+    x[j] = control.x * w[j];
+    y[j] = control.y * w[j];
+  }
+  for (size_t r = 1; r <= p; ++r) {
+    for (size_t j = p; j >= r; --j) {
+      double left = knots[j + k - p];
+      double span = knots[j + 1 + k - r] - left;
+      double alpha = span > 0.0 ? (t - left) / span : 0.0;
+      x[j] = (1.0 - alpha) * x[j - 1] + alpha * x[j];
+      y[j] = (1.0 - alpha) * y[j - 1] + alpha * y[j];
+      w[j] = (1.0 - alpha) * w[j - 1] + alpha * w[j];
+    }
+  }
+  return w[p] != 0.0 ? Point2D(x[p] / w[p], y[p] / w[p]) : Point2D(x[p], y[p]);
+}
+
+void appendCurvePolygon(const ProfileCurve& curve, double maxError, std::vector<Point2D>& polygon) {
+  size_t first = polygon.size();
+  switch (curve.type) {
+    case ProfileCurve::Type::ARC:
+      appendArcPoints(curve, maxError, polygon);
+      break;
+    case ProfileCurve::Type::SPLINE:
+      appendSplinePoints(curve, maxError, polygon);
+      break;
+    default:
+      polygon.push_back(curve.start);
+      polygon.push_back(curve.end);
+      break;
+  }
+  // Points run start to end; the final one is the next curve's first
+  if (curve.reversed) {
+    std::reverse(polygon.begin() + static_cast<std::ptrdiff_t>(first), polygon.end());
+  }
+  polygon.pop_back();
+}
+
+std::vector<Point2D> polygonizeProfileLoop(const std::vector<ProfileCurve>& loop, double maxError) {
+  std::vector<Point2D> polygon;
+  for (const auto& curve : loop) {
+    appendCurvePolygon(curve, maxError, polygon);
+  }
+  return polygon;
+}
+
+}  // namespace Geometry
+}  // namespace ChipCarving
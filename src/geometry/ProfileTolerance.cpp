@@ -0,0 +1,100 @@
+/**
+ * ProfileTolerance.cpp
+ *
+ * Per-profile polygon tolerance and sampling distance from the outline's
+ * size, its tightest curve and the V-bit's depth sensitivity
+ */
+
+#include "geometry/ProfileTolerance.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+namespace ChipCarving {
+namespace Geometry {
+
+namespace {
+
+constexpr double PI = 3.14159265358979323846;
+// Sharper turns are corners, which simplification keeps; they are not curves to preserve
+constexpr double CORNER_ANGLE = 20.0 * PI / 180.0;
+// Below this turn a vertex is on a straight run
+constexpr double STRAIGHT_ANGLE = 1e-6;
+// Tolerance at most this share of the tightest curve radius and of the half width
+constexpr double FEATURE_FRACTION = 0.1;
+constexpr double WIDTH_FRACTION = 0.05;
+
+// Loop without a duplicate closing vertex
+size_t ringSize(const std::vector<Point2D>& loop) {
+  size_t n = loop.size();
+  return n > 3 && distance(loop.front(), loop.back()) < 1e-12 ? n - 1 : n;
+}
+
+// Smallest radius of the circles through each smooth vertex and its neighbours
+double tightestCurveRadius(const std::vector<Point2D>& loop) {
+  double radius = std::numeric_limits<double>::infinity();
+  size_t n = ringSize(loop);
+  if (n < 3) {
+    return radius;
+  }
+  for (size_t i = 0; i < n; ++i) {
+    const Point2D& a = loop[(i + n - 1) % n];
+    const Point2D& b = loop[i];
+    const Point2D& c = loop[(i + 1) % n];
+    Point2D u = b - a;
+    Point2D v = c - b;
+    double turn = std::abs(std::atan2(u.x * v.y - u.y * v.x, u.x * v.x + u.y * v.y));
+    if (turn > STRAIGHT_ANGLE && turn <= CORNER_ANGLE) {
+      radius = std::min(radius, distance(a, c) / (2.0 * std::sin(turn)));
+    }
+  }
+  return radius;
+}
+
+void addLoopMeasures(const std::vector<Point2D>& loop, double& area, double& perimeter) {
+  size_t n = ringSize(loop);
+  double twiceArea = 0.0;
+  for (size_t i = 0; i < n; ++i) {
+    const Point2D& p = loop[i];
+    const Point2D& q = loop[(i + 1) % n];
+    twiceArea += p.x * q.y - q.x * p.y;
+    perimeter += distance(p, q);
+  }
+  area += std::abs(twiceArea) / 2.0;
+}
+
+}  // namespace
+
+ProfileTolerance chooseProfileTolerance(const std::vector<Point2D>& outline,
+                                        const std::vector<std::vector<Point2D>>& holes, double unitsToMm,
+                                        const AutoToleranceOptions& options) {
+  double area = 0.0;
+  double perimeter = 0.0;
+  addLoopMeasures(outline, area, perimeter);
+  double curveRadius = tightestCurveRadius(outline);
+  for (const auto& hole : holes) {
+    double holeArea = 0.0;
+    addLoopMeasures(hole, holeArea, perimeter);
+    area -= holeArea;
+    curveRadius = std::min(curveRadius, tightestCurveRadius(hole));
+  }
+
+  // 2A/P is the radius of a disc and half the width of a long strip
+  double halfWidth = perimeter > 0.0 ? 2.0 * std::max(area, 0.0) / perimeter * unitsToMm : 0.0;
+  curveRadius *= unitsToMm;
+
+  ProfileTolerance chosen;
+  chosen.minFeatureRadius = std::min(curveRadius, halfWidth);
+  double depthTolerance = options.depthError * std::tan(options.toolAngle * PI / 360.0);
+  double tolerance = std::min({depthTolerance, FEATURE_FRACTION * curveRadius, WIDTH_FRACTION * halfWidth});
+  chosen.polygonTolerance = std::max(options.minTolerance, std::min(options.maxTolerance, tolerance));
+
+  // A chord of length s strays s²/8R from an arc of radius R
+  double sampling = std::sqrt(8.0 * chosen.minFeatureRadius * depthTolerance);
+  chosen.samplingDistance = std::max(options.minSampling, std::min(options.maxSampling, sampling));
+  return chosen;
+}
+
+}  // namespace Geometry
+}  // namespace ChipCarving
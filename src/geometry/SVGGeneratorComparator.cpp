@@ -6,47 +6,57 @@
  */
 
 #include <cmath>
-#include <fstream>
-#include <regex>
 
+#include "geometry/NumberScanner.h"
 #include "geometry/SVGGenerator.h"
+#include "utils/MappedFile.h"
 
 using ChipCarving::Geometry::SVGComparator;
 
 // SVGComparator implementation
 bool SVGComparator::compare(const std::string& file1, const std::string& file2, double tolerance) {
-  std::ifstream f1(file1);
-  std::ifstream f2(file2);
-  if (!f1.is_open() || !f2.is_open()) {
+  ChipCarving::Utils::MappedFile f1(file1);
+  ChipCarving::Utils::MappedFile f2(file2);
+  if (!f1.isOpen() || !f2.isOpen()) {
     return false;
   }
 
-  std::string content1((std::istreambuf_iterator<char>(f1)), std::istreambuf_iterator<char>());
-  std::string content2((std::istreambuf_iterator<char>(f2)), std::istreambuf_iterator<char>());
+  return compareContent(f1.chars(), f1.size(), f2.chars(), f2.size(), tolerance);
+}
 
-  auto numbers1 = extractNumbers(content1);
-  auto numbers2 = extractNumbers(content2);
+bool SVGComparator::compareContent(const char* content1, size_t size1, const char* content2, size_t size2,
+                                   double tolerance) {
+  const char* cursor1 = content1;
+  const char* cursor2 = content2;
+  const char* end1 = content1 + size1;
+  const char* end2 = content2 + size2;
 
-  return compareNumbers(numbers1, numbers2, tolerance);
+  // Both texts are scanned in step, so the first difference ends the comparison
+  double value1 = 0.0;
+  double value2 = 0.0;
+  while (true) {
+    bool more1 = scanNumber(cursor1, end1, value1);
+    bool more2 = scanNumber(cursor2, end2, value2);
+    if (more1 != more2) {
+      return false;
+    }
+    if (!more1) {
+      return true;
+    }
+    if (std::abs(value1 - value2) > tolerance) {
+      return false;
+    }
+  }
 }
 
 std::vector<double> SVGComparator::extractNumbers(const std::string& svgContent) {
   std::vector<double> numbers;
-
-  // Regex to find floating point numbers in the SVG
-  std::regex numberRegex(R"([-+]?[0-9]*\.?[0-9]+([eE][-+]?[0-9]+)?)");
-  std::sregex_iterator iter(svgContent.begin(), svgContent.end(), numberRegex);
-  std::sregex_iterator end;
-
-  for (; iter != end; ++iter) {
-    try {
-      double value = std::stod(iter->str());
-      numbers.push_back(value);
-    } catch (const std::exception& e) {
-      (void)e;  // Skip invalid numbers
-    }
+  const char* cursor = svgContent.data();
+  const char* end = cursor + svgContent.size();
+  double value = 0.0;
+  while (scanNumber(cursor, end, value)) {
+    numbers.push_back(value);
   }
-
   return numbers;
 }
 
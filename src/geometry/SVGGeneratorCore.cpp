@@ -8,7 +8,6 @@
 #include <algorithm>
 #include <cmath>
 #include <fstream>
-#include <iomanip>
 
 #include "geometry/SVGGenerator.h"
 
@@ -17,8 +16,6 @@ using ChipCarving::Geometry::SVGGenerator;
 
 SVGGenerator::SVGGenerator(double width, double height, double scale)
     : width_(width), height_(height), scale_(scale), offset_(0.0, 0.0) {
-  svg_ << std::fixed << std::setprecision(3);
-
   // SVG header
   svg_ << "<?xml version=\"1.0\" encoding=\"UTF-8\"?>\n";
   svg_ << "<svg width=\"" << width_ << "\" height=\"" << height_ << "\" viewBox=\"0 0 " << width_ << " " << height_
@@ -107,6 +104,17 @@ void SVGGenerator::addArc(const Point2D& center, double radius, double startAngl
        << "\" stroke=\"" << color << "\" stroke-width=\"" << strokeWidth << "\" fill=\"none\"/>\n";
 }
 
+void SVGGenerator::addPolyline(const std::vector<Point2D>& points, const std::string& color, double strokeWidth,
+                               bool closed) {
+  svg_ << (closed ? "  <polygon points=\"" : "  <polyline points=\"");
+  for (size_t i = 0; i < points.size(); ++i) {
+    Point2D point_svg = worldToSVG(points[i]);
+    svg_ << (i > 0 ? " " : "") << point_svg.x << "," << point_svg.y;
+  }
+  svg_ << "\" stroke=\"" << color << "\" stroke-width=\"" << strokeWidth
+       << "\" stroke-linejoin=\"round\" fill=\"none\"/>\n";
+}
+
 void SVGGenerator::addCircle(const Point2D& center, double radius, const std::string& color, double strokeWidth) {
   Point2D center_svg = worldToSVG(center);
   double radius_svg = worldToSVG(radius);
@@ -115,6 +123,14 @@ void SVGGenerator::addCircle(const Point2D& center, double radius, const std::st
        << color << "\" stroke-width=\"" << strokeWidth << "\" fill=\"none\"/>\n";
 }
 
+void SVGGenerator::addRect(const Point2D& min, const Point2D& max, const std::string& fill, double opacity) {
+  // World Y points up and SVG Y down, so the top-left corner is (min.x, max.y)
+  Point2D corner = worldToSVG(Point2D(min.x, max.y));
+  svg_ << "  <rect x=\"" << corner.x << "\" y=\"" << corner.y << "\" width=\"" << worldToSVG(max.x - min.x)
+       << "\" height=\"" << worldToSVG(max.y - min.y) << "\" fill=\"" << fill << "\" fill-opacity=\"" << opacity
+       << "\" stroke=\"none\"/>\n";
+}
+
 void SVGGenerator::addText(const Point2D& position, const std::string& text, const std::string& color,
                            double fontSize) {
   Point2D svg_pos = worldToSVG(position);
@@ -123,13 +139,16 @@ void SVGGenerator::addText(const Point2D& position, const std::string& text, con
 }
 
 std::string SVGGenerator::generate() const {
-  std::stringstream result;
-  result << svg_.str();
-  result << "</svg>\n";
-  return result.str();
+  if (svg_.isStreaming()) {
+    return std::string();
+  }
+  return svg_.buffered() + "</svg>\n";
 }
 
 bool SVGGenerator::saveToFile(const std::string& filename) const {
+  if (svg_.isStreaming()) {
+    return false;
+  }
   std::ofstream file(filename);
   if (!file.is_open()) {
     return false;
@@ -139,6 +158,18 @@ bool SVGGenerator::saveToFile(const std::string& filename) const {
   return file.good();
 }
 
+bool SVGGenerator::streamToFile(const std::string& filename) {
+  return svg_.openStream(filename);
+}
+
+bool SVGGenerator::finishStream() {
+  if (!svg_.isStreaming()) {
+    return false;
+  }
+  svg_ << "</svg>\n";
+  return svg_.closeStream();
+}
+
 Point2D SVGGenerator::worldToSVG(const Point2D& world) const {
   return Point2D(offset_.x + world.x * scale_,
                  offset_.y - world.y * scale_);  // Y is flipped in SVG
@@ -8,6 +8,9 @@
 #include "geometry/SVGGenerator.h"
 
 using ChipCarving::Geometry::ArcParams;
+using ChipCarving::Geometry::CarveCell;
+using ChipCarving::Geometry::CarveVerification;
+using ChipCarving::Geometry::DepthMap;
 using ChipCarving::Geometry::Leaf;
 using ChipCarving::Geometry::Point2D;
 using ChipCarving::Geometry::SVGGenerator;
@@ -166,3 +169,25 @@ void SVGGenerator::addDebugMarkers(const Leaf& leaf) {
   addLine(centers.second, leaf.getFocus1(), "lightblue", 0.5, "stroke-dasharray=\"1,1\"");
   addLine(centers.second, leaf.getFocus2(), "lightblue", 0.5, "stroke-dasharray=\"1,1\"");
 }
+
+void SVGGenerator::addCarveVerification(const DepthMap& map, const CarveVerification& verification) {
+  if (verification.cells.size() != static_cast<size_t>(map.width) * map.height) {
+    return;
+  }
+  for (int y = 0; y < map.height; ++y) {
+    int x = 0;
+    while (x < map.width) {
+      CarveCell cell = verification.cells[static_cast<size_t>(y) * map.width + x];
+      int runEnd = x + 1;
+      while (runEnd < map.width && verification.cells[static_cast<size_t>(y) * map.width + runEnd] == cell) {
+        ++runEnd;
+      }
+      if (cell == CarveCell::GOUGE || cell == CarveCell::MISSED) {
+        Point2D min(map.origin.x + x * map.resolution, map.origin.y + y * map.resolution);
+        Point2D max(map.origin.x + runEnd * map.resolution, min.y + map.resolution);
+        addRect(min, max, cell == CarveCell::GOUGE ? "red" : "blue", 0.6);
+      }
+      x = runEnd;
+    }
+  }
+}
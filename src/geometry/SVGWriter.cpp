@@ -0,0 +1,89 @@
+/**
+ * SVGWriter.cpp
+ *
+ * Fixed-precision number formatting and file streaming for SVG output
+ */
+
+#include "geometry/SVGWriter.h"
+
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+
+using ChipCarving::Geometry::SVGWriter;
+
+namespace {
+
+constexpr double FIXED_SCALE = 1000.0;  // Three decimals
+constexpr double MAX_FAST_MAGNITUDE = 1e15;
+
+}  // namespace
+
+void SVGWriter::appendFixed(std::string& out, double value) {
+  double magnitude = std::abs(value);
+  if (!std::isfinite(value) || magnitude >= MAX_FAST_MAGNITUDE) {
+    char text[64];
+    std::snprintf(text, sizeof(text), "%.3f", value);
+    out += text;
+    return;
+  }
+
+  // printf rounds the exact binary value. The scaled product can only land on
+  // the wrong side of a rounding tie when it rounds to the tie itself, so fma
+  // resolves those; a true tie rounds to even
+  double product = magnitude * FIXED_SCALE;
+  double lower = std::floor(product);
+  double rounded = std::nearbyint(product);
+  if (product - lower == 0.5) {
+    double residual = std::fma(magnitude, FIXED_SCALE, -product);
+    if (residual != 0.0) {
+      rounded = residual > 0.0 ? lower + 1.0 : lower;
+    }
+  }
+  uint64_t scaled = static_cast<uint64_t>(rounded);
+  uint64_t whole = scaled / 1000;
+  unsigned fraction = static_cast<unsigned>(scaled % 1000);
+
+  if (std::signbit(value)) {
+    out += '-';
+  }
+  char digits[24];
+  int count = 0;
+  do {
+    digits[count++] = static_cast<char>('0' + whole % 10);
+    whole /= 10;
+  } while (whole != 0);
+  while (count > 0) {
+    out += digits[--count];
+  }
+  out += '.';
+  out += static_cast<char>('0' + fraction / 100);
+  out += static_cast<char>('0' + fraction / 10 % 10);
+  out += static_cast<char>('0' + fraction % 10);
+}
+
+bool SVGWriter::openStream(const std::string& filename) {
+  if (stream_.is_open()) {
+    closeStream();
+  }
+  stream_.open(filename, std::ios::binary | std::ios::trunc);
+  if (!stream_.is_open()) {
+    return false;
+  }
+  flush();
+  return true;
+}
+
+bool SVGWriter::closeStream() {
+  if (!stream_.is_open()) {
+    return false;
+  }
+  flush();
+  stream_.close();
+  return !stream_.fail();
+}
+
+void SVGWriter::flush() {
+  stream_.write(buffer_.data(), static_cast<std::streamsize>(buffer_.size()));
+  buffer_.clear();
+}
@@ -0,0 +1,258 @@
+/**
+ * ScannedSurface.cpp
+ *
+ * Scan loading, tile-cached heightmap sampling and the scan cache
+ */
+
+#include "geometry/ScannedSurface.h"
+
+#include <sys/stat.h>
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <fstream>
+#include <limits>
+#include <utility>
+
+#include "ScannedSurfaceReaders.h"
+#include "utils/MappedFile.h"
+
+namespace ChipCarving {
+namespace Geometry {
+
+namespace {
+
+constexpr char GRID_MAGIC[4] = {'C', 'C', 'H', 'G'};
+constexpr uint32_t GRID_FORMAT_VERSION = 1;
+
+bool isHeightGrid(const Utils::MappedFile& file) {
+  return file.size() >= sizeof(HeightGridHeader) && std::memcmp(file.data(), GRID_MAGIC, sizeof(GRID_MAGIC)) == 0;
+}
+
+}  // namespace
+
+constexpr size_t ScannedSurface::TILE_CELLS;
+constexpr size_t ScannedSurface::MAX_CACHED_TILES;
+
+ScannedSurface::ScannedSurface() {
+  tiles_.reserve(MAX_CACHED_TILES);
+}
+
+std::shared_ptr<const ScannedSurface> ScannedSurface::load(const std::string& path, const ScanPlacement& placement,
+                                                           std::string& error) {
+  auto file = std::make_shared<const Utils::MappedFile>(path);
+  if (!file->isOpen()) {
+    error = "cannot open " + path;
+    return nullptr;
+  }
+
+  std::shared_ptr<ScannedSurface> surface(new ScannedSurface());
+  surface->zOffset_ = placement.zOffset;
+  if (isHeightGrid(*file) || isPngData(file->data(), file->size())) {
+    if (!surface->loadRaster(*file, placement, error)) {
+      return nullptr;
+    }
+    // Height grids are read in place, so the mapping lives as long as the surface
+    if (surface->mappedHeights_) {
+      surface->file_ = file;
+    }
+    return surface;
+  }
+
+  std::vector<double> coords;
+  std::vector<int> indices;
+  if (!readScanMesh(file->data(), file->size(), coords, indices, error)) {
+    return nullptr;
+  }
+  for (size_t i = 0; i + 2 < coords.size(); i += 3) {
+    coords[i] += placement.originX;
+    coords[i + 1] += placement.originY;
+    coords[i + 2] += placement.zOffset;
+  }
+  surface->format_ = Format::MESH;
+  surface->mesh_.reset(new SurfaceMeshBVH(coords, indices));
+  if (surface->mesh_->empty()) {
+    error = "scan mesh has no triangles facing up or down";
+    return nullptr;
+  }
+  return surface;
+}
+
+bool ScannedSurface::loadRaster(const Utils::MappedFile& file, const ScanPlacement& placement, std::string& error) {
+  if (isHeightGrid(file)) {
+    HeightGridHeader header;
+    std::memcpy(&header, file.data(), sizeof(header));
+    size_t nodes = static_cast<size_t>(header.columns) * header.rows;
+    if (header.formatVersion != GRID_FORMAT_VERSION) {
+      error = "unsupported height grid version " + std::to_string(header.formatVersion);
+      return false;
+    }
+    if (header.columns < 2 || header.rows < 2 || !(header.spacing > 0.0) ||
+        file.size() != sizeof(HeightGridHeader) + nodes * sizeof(float)) {
+      error = "height grid header does not match the file size";
+      return false;
+    }
+    format_ = Format::HEIGHT_GRID;
+    mappedHeights_ = file.data() + sizeof(HeightGridHeader);
+    columns_ = header.columns;
+    rows_ = header.rows;
+    origin_ = Point2D(header.originX + placement.originX, header.originY + placement.originY);
+    spacing_ = header.spacing;
+    return true;
+  }
+
+  if (!(placement.pixelSize > 0.0)) {
+    error = "heightmap pixel size must be positive";
+    return false;
+  }
+  if (!decodeHeightmapPng(file.data(), file.size(), placement.heightRange, columns_, rows_, ownedHeights_, error)) {
+    return false;
+  }
+  if (columns_ < 2 || rows_ < 2) {
+    error = "heightmap must be at least 2 x 2 pixels";
+    return false;
+  }
+  format_ = Format::PNG;
+  origin_ = Point2D(placement.originX, placement.originY);
+  spacing_ = placement.pixelSize;
+  return true;
+}
+
+double ScannedSurface::nodeHeight(size_t column, size_t row) const {
+  size_t index = row * columns_ + column;
+  float height = 0.0f;
+  if (mappedHeights_) {
+    std::memcpy(&height, mappedHeights_ + index * sizeof(float), sizeof(float));
+  } else {
+    height = ownedHeights_[index];
+  }
+  return static_cast<double>(height) + zOffset_;
+}
+
+const SurfaceHeightfield& ScannedSurface::tile(size_t tileColumn, size_t tileRow) const {
+  size_t key = tileRow * ((columns_ - 2) / TILE_CELLS + 1) + tileColumn;
+  ++useClock_;
+  auto cached = tileSlots_.find(key);
+  if (cached != tileSlots_.end()) {
+    tiles_[cached->second].lastUse = useClock_;
+    return tiles_[cached->second].heights;
+  }
+
+  size_t slot = tiles_.size();
+  if (slot < MAX_CACHED_TILES) {
+    tiles_.emplace_back();
+  } else {
+    auto oldest = std::min_element(tiles_.begin(), tiles_.end(),
+                                   [](const Tile& a, const Tile& b) { return a.lastUse < b.lastUse; });
+    slot = static_cast<size_t>(oldest - tiles_.begin());
+    tileSlots_.erase(oldest->key);
+  }
+
+  // Tiles share their edge nodes, so every cell lies wholly inside one tile
+  size_t firstColumn = tileColumn * TILE_CELLS;
+  size_t firstRow = tileRow * TILE_CELLS;
+  size_t nodeColumns = std::min(TILE_CELLS, columns_ - 1 - firstColumn) + 1;
+  size_t nodeRows = std::min(TILE_CELLS, rows_ - 1 - firstRow) + 1;
+  std::vector<double> heights;
+  heights.reserve(nodeColumns * nodeRows);
+  for (size_t r = 0; r < nodeRows; ++r) {
+    for (size_t c = 0; c < nodeColumns; ++c) {
+      heights.push_back(nodeHeight(firstColumn + c, firstRow + r));
+    }
+  }
+  Tile& entry = tiles_[slot];
+  entry.key = key;
+  entry.lastUse = useClock_;
+  entry.heights = SurfaceHeightfield(
+      Point2D(origin_.x + firstColumn * spacing_, origin_.y + firstRow * spacing_), spacing_, nodeColumns, nodeRows);
+  entry.heights.setHeights(std::move(heights));
+  tileSlots_[key] = slot;
+  return entry.heights;
+}
+
+std::vector<double> ScannedSurface::sampleHeights(const std::vector<Point2D>& points) const {
+  std::vector<double> heights(points.size(), std::numeric_limits<double>::quiet_NaN());
+  if (mesh_) {
+    mesh_->raiseTopZ(points, heights);
+    return heights;
+  }
+
+  // Same edge slack as SurfaceHeightfield::sample
+  const double EDGE_SLACK = 1e-9;
+  double maxColumn = static_cast<double>(columns_ - 1);
+  double maxRow = static_cast<double>(rows_ - 1);
+  // Neighboring points mostly fall in the tile of the previous one
+  size_t currentColumn = SIZE_MAX;
+  size_t currentRow = SIZE_MAX;
+  const SurfaceHeightfield* current = nullptr;
+  std::lock_guard<std::mutex> lock(tileMutex_);
+  for (size_t i = 0; i < points.size(); ++i) {
+    double gx = (points[i].x - origin_.x) / spacing_;
+    double gy = (points[i].y - origin_.y) / spacing_;
+    if (!(gx >= -EDGE_SLACK && gx <= maxColumn + EDGE_SLACK && gy >= -EDGE_SLACK && gy <= maxRow + EDGE_SLACK)) {
+      continue;
+    }
+    size_t tileColumn = std::min(static_cast<size_t>(std::max(gx, 0.0)), columns_ - 2) / TILE_CELLS;
+    size_t tileRow = std::min(static_cast<size_t>(std::max(gy, 0.0)), rows_ - 2) / TILE_CELLS;
+    if (tileColumn != currentColumn || tileRow != currentRow) {
+      current = &tile(tileColumn, tileRow);
+      currentColumn = tileColumn;
+      currentRow = tileRow;
+    }
+    heights[i] = current->sample(points[i].x, points[i].y);
+  }
+  return heights;
+}
+
+size_t ScannedSurface::cachedTileCount() const {
+  std::lock_guard<std::mutex> lock(tileMutex_);
+  return tiles_.size();
+}
+
+std::shared_ptr<const ScannedSurface> ScannedSurfaceCache::get(const std::string& path,
+                                                               const ScanPlacement& placement, std::string& error) {
+  struct stat info {};
+  bool exists = ::stat(path.c_str(), &info) == 0;
+  int64_t fileSize = exists ? static_cast<int64_t>(info.st_size) : -1;
+  int64_t modifiedTime = exists ? static_cast<int64_t>(info.st_mtime) : 0;
+
+  std::lock_guard<std::mutex> lock(mutex_);
+  if (loaded_ && path == path_ && placement == placement_ && fileSize == fileSize_ && modifiedTime == modifiedTime_) {
+    return surface_;
+  }
+  surface_ = exists ? ScannedSurface::load(path, placement, error) : nullptr;
+  if (!exists) {
+    error = "cannot open " + path;
+  }
+  loaded_ = true;
+  path_ = path;
+  placement_ = placement;
+  fileSize_ = fileSize;
+  modifiedTime_ = modifiedTime;
+  return surface_;
+}
+
+bool writeHeightGrid(const std::string& path, const Point2D& origin, double spacing, size_t columns, size_t rows,
+                     const std::vector<float>& heights) {
+  if (heights.size() != columns * rows || columns > UINT32_MAX || rows > UINT32_MAX) {
+    return false;
+  }
+  HeightGridHeader header{};
+  std::memcpy(header.magic, GRID_MAGIC, sizeof(GRID_MAGIC));
+  header.formatVersion = GRID_FORMAT_VERSION;
+  header.columns = static_cast<uint32_t>(columns);
+  header.rows = static_cast<uint32_t>(rows);
+  header.originX = origin.x;
+  header.originY = origin.y;
+  header.spacing = spacing;
+
+  std::ofstream file(path, std::ios::binary | std::ios::trunc);
+  file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+  file.write(reinterpret_cast<const char*>(heights.data()),
+             static_cast<std::streamsize>(heights.size() * sizeof(float)));
+  return static_cast<bool>(file);
+}
+
+}  // namespace Geometry
+}  // namespace ChipCarving
@@ -0,0 +1,321 @@
+/**
+ * ScannedSurfaceMesh.cpp
+ *
+ * PLY and STL scan mesh reading for scanned surfaces
+ * Split from ScannedSurface.cpp for maintainability
+ */
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "ScannedSurfaceReaders.h"
+#include "geometry/NumberScanner.h"
+
+namespace ChipCarving {
+namespace Geometry {
+
+namespace {
+
+constexpr size_t STL_HEADER_BYTES = 84;
+constexpr size_t STL_TRIANGLE_BYTES = 50;
+
+// Binary STL: 80-byte header, triangle count, then normal, 3 vertices and attribute per triangle
+bool readBinaryStl(const unsigned char* data, size_t size, std::vector<double>& coords, std::vector<int>& indices) {
+  uint32_t count = 0;
+  std::memcpy(&count, data + 80, sizeof(count));
+  if (size != STL_HEADER_BYTES + static_cast<size_t>(count) * STL_TRIANGLE_BYTES) {
+    return false;
+  }
+  coords.reserve(static_cast<size_t>(count) * 9);
+  indices.reserve(static_cast<size_t>(count) * 3);
+  for (size_t t = 0; t < count; ++t) {
+    const unsigned char* vertex = data + STL_HEADER_BYTES + t * STL_TRIANGLE_BYTES + 12;
+    for (int k = 0; k < 9; ++k) {
+      float value = 0.0f;
+      std::memcpy(&value, vertex + 4 * k, sizeof(value));
+      coords.push_back(value);
+    }
+    for (int k = 0; k < 3; ++k) {
+      indices.push_back(static_cast<int>(t * 3 + k));
+    }
+  }
+  return true;
+}
+
+// ASCII STL: three numbers after every "vertex" keyword
+bool readAsciiStl(const char* text, const char* end, std::vector<double>& coords, std::vector<int>& indices) {
+  static const char KEYWORD[] = "vertex";
+  const char* cursor = text;
+  for (;;) {
+    cursor = std::search(cursor, end, KEYWORD, KEYWORD + sizeof(KEYWORD) - 1);
+    if (cursor == end) {
+      break;
+    }
+    cursor += sizeof(KEYWORD) - 1;
+    for (int k = 0; k < 3; ++k) {
+      double value = 0.0;
+      if (!scanNumber(cursor, end, value)) {
+        return false;
+      }
+      coords.push_back(value);
+    }
+  }
+  size_t triangles = coords.size() / 9;
+  coords.resize(triangles * 9);
+  for (size_t i = 0; i < triangles * 3; ++i) {
+    indices.push_back(static_cast<int>(i));
+  }
+  return triangles > 0;
+}
+
+enum class PlyEncoding { ASCII, BINARY_LITTLE, BINARY_BIG };
+
+struct PlyProperty {
+  std::string name{};
+  int bytes = 0;  // Value size (list items for a list)
+  bool isFloat = false;
+  bool isSigned = false;
+  int countBytes = 0;  // Size of a list's count, 0 for a scalar
+};
+
+struct PlyElement {
+  std::string name{};
+  size_t count = 0;
+  std::vector<PlyProperty> properties{};
+};
+
+bool plyType(const std::string& name, PlyProperty& property) {
+  static const struct {
+    const char* names[2];
+    int bytes;
+    bool isFloat;
+    bool isSigned;
+  } TYPES[] = {{{"char", "int8"}, 1, false, true},     {{"uchar", "uint8"}, 1, false, false},
+               {{"short", "int16"}, 2, false, true},   {{"ushort", "uint16"}, 2, false, false},
+               {{"int", "int32"}, 4, false, true},     {{"uint", "uint32"}, 4, false, false},
+               {{"float", "float32"}, 4, true, true},  {{"double", "float64"}, 8, true, true}};
+  for (const auto& type : TYPES) {
+    if (name == type.names[0] || name == type.names[1]) {
+      property.bytes = type.bytes;
+      property.isFloat = type.isFloat;
+      property.isSigned = type.isSigned;
+      return true;
+    }
+  }
+  return false;
+}
+
+// One value of bytes size at cursor, advancing it; false past the end
+bool readPlyValue(const unsigned char*& cursor, const unsigned char* end, int bytes, bool isFloat, bool isSigned,
+                  PlyEncoding encoding, double& value) {
+  if (encoding == PlyEncoding::ASCII) {
+    const char* text = reinterpret_cast<const char*>(cursor);
+    bool found = scanNumber(text, reinterpret_cast<const char*>(end), value);
+    cursor = reinterpret_cast<const unsigned char*>(text);
+    return found;
+  }
+  if (end - cursor < bytes) {
+    return false;
+  }
+  unsigned char raw[8] = {};
+  std::memcpy(raw, cursor, static_cast<size_t>(bytes));
+  cursor += bytes;
+  static const bool hostLittle = [] {
+    uint16_t probe = 1;
+    unsigned char first = 0;
+    std::memcpy(&first, &probe, 1);
+    return first == 1;
+  }();
+  if ((encoding == PlyEncoding::BINARY_LITTLE) != hostLittle) {
+    std::reverse(raw, raw + bytes);
+  }
+  if (isFloat) {
+    if (bytes == 4) {
+      float f = 0.0f;
+      std::memcpy(&f, raw, 4);
+      value = f;
+    } else {
+      std::memcpy(&value, raw, 8);
+    }
+    return true;
+  }
+  uint64_t bits = 0;
+  std::memcpy(&bits, raw, static_cast<size_t>(bytes));
+  if (!hostLittle) {
+    bits >>= 8 * (8 - bytes);
+  }
+  int64_t signedValue = static_cast<int64_t>(bits);
+  if (isSigned && bytes < 8 && (bits >> (8 * bytes - 1)) != 0) {
+    signedValue -= int64_t(1) << (8 * bytes);
+  }
+  value = static_cast<double>(signedValue);
+  return true;
+}
+
+bool readPlyHeader(const char* text, size_t size, PlyEncoding& encoding, std::vector<PlyElement>& elements,
+                   size_t& bodyOffset, std::string& error) {
+  static const char END_HEADER[] = "end_header";
+  const char* headerEnd = std::search(text, text + size, END_HEADER, END_HEADER + sizeof(END_HEADER) - 1);
+  const char* bodyStart = headerEnd == text + size ? headerEnd : std::find(headerEnd, text + size, '\n');
+  if (bodyStart == text + size) {
+    error = "PLY header is incomplete";
+    return false;
+  }
+  bodyOffset = static_cast<size_t>(bodyStart + 1 - text);
+
+  std::istringstream header(std::string(text, headerEnd));
+  std::string line;
+  bool hasFormat = false;
+  while (std::getline(header, line)) {
+    std::istringstream words(line);
+    std::string keyword;
+    words >> keyword;
+    if (keyword == "format") {
+      std::string format;
+      words >> format;
+      hasFormat = true;
+      if (format == "ascii") {
+        encoding = PlyEncoding::ASCII;
+      } else if (format == "binary_little_endian") {
+        encoding = PlyEncoding::BINARY_LITTLE;
+      } else if (format == "binary_big_endian") {
+        encoding = PlyEncoding::BINARY_BIG;
+      } else {
+        hasFormat = false;
+      }
+    } else if (keyword == "element") {
+      PlyElement element;
+      words >> element.name >> element.count;
+      elements.push_back(element);
+    } else if (keyword == "property" && !elements.empty()) {
+      PlyProperty property;
+      std::string type;
+      words >> type;
+      if (type == "list") {
+        std::string countType;
+        words >> countType >> type;
+        PlyProperty count;
+        if (!plyType(countType, count) || count.isFloat) {
+          error = "PLY list count type '" + countType + "' is not supported";
+          return false;
+        }
+        property.countBytes = count.bytes;
+      }
+      words >> property.name;
+      if (!plyType(type, property)) {
+        error = "PLY property type '" + type + "' is not supported";
+        return false;
+      }
+      elements.back().properties.push_back(property);
+    }
+  }
+  if (!hasFormat) {
+    error = "PLY format is missing or not supported";
+    return false;
+  }
+  return true;
+}
+
+bool readPly(const unsigned char* data, size_t size, std::vector<double>& coords, std::vector<int>& indices,
+             std::string& error) {
+  PlyEncoding encoding = PlyEncoding::ASCII;
+  std::vector<PlyElement> elements;
+  size_t bodyOffset = 0;
+  if (!readPlyHeader(reinterpret_cast<const char*>(data), size, encoding, elements, bodyOffset, error)) {
+    return false;
+  }
+
+  const unsigned char* cursor = data + bodyOffset;
+  const unsigned char* end = data + size;
+  size_t vertexCount = 0;
+  std::vector<double> values;
+  std::vector<double> polygon;
+  for (const PlyElement& element : elements) {
+    bool isVertex = element.name == "vertex";
+    bool isFace = element.name == "face";
+    values.assign(element.properties.size(), 0.0);
+    for (size_t item = 0; item < element.count; ++item) {
+      for (size_t p = 0; p < element.properties.size(); ++p) {
+        const PlyProperty& property = element.properties[p];
+        if (property.countBytes == 0) {
+          if (!readPlyValue(cursor, end, property.bytes, property.isFloat, property.isSigned, encoding, values[p])) {
+            error = "PLY " + element.name + " data is truncated";
+            return false;
+          }
+          continue;
+        }
+        double listSize = 0.0;
+        if (!readPlyValue(cursor, end, property.countBytes, false, false, encoding, listSize) || listSize < 0.0) {
+          error = "PLY " + element.name + " data is truncated";
+          return false;
+        }
+        polygon.resize(static_cast<size_t>(listSize));
+        for (double& index : polygon) {
+          if (!readPlyValue(cursor, end, property.bytes, property.isFloat, property.isSigned, encoding, index)) {
+            error = "PLY " + element.name + " data is truncated";
+            return false;
+          }
+        }
+        // Faces become triangle fans; out-of-range indices are dropped by the BVH
+        bool isIndices = property.name == "vertex_indices" || property.name == "vertex_index";
+        for (size_t k = 2; isFace && isIndices && k < polygon.size(); ++k) {
+          indices.insert(indices.end(), {static_cast<int>(polygon[0]), static_cast<int>(polygon[k - 1]),
+                                         static_cast<int>(polygon[k])});
+        }
+      }
+      if (isVertex) {
+        double xyz[3] = {0.0, 0.0, 0.0};
+        for (size_t p = 0; p < element.properties.size(); ++p) {
+          const std::string& name = element.properties[p].name;
+          if (name.size() == 1 && name[0] >= 'x' && name[0] <= 'z') {
+            xyz[name[0] - 'x'] = values[p];
+          }
+        }
+        coords.insert(coords.end(), xyz, xyz + 3);
+      }
+    }
+    if (isVertex) {
+      vertexCount = element.count;
+    }
+  }
+  if (vertexCount == 0 || indices.empty()) {
+    error = "PLY scan has no faces";
+    return false;
+  }
+  return true;
+}
+
+}  // namespace
+
+bool readScanMesh(const unsigned char* data, size_t size, std::vector<double>& coords, std::vector<int>& indices,
+                  std::string& error) {
+  coords.clear();
+  indices.clear();
+  if (!data || size == 0) {
+    error = "scan file is empty";
+    return false;
+  }
+  if (size >= 4 && std::memcmp(data, "ply", 3) == 0 && (data[3] == '\n' || data[3] == '\r')) {
+    return readPly(data, size, coords, indices, error);
+  }
+
+  // Binary STL headers may start with "solid" too, so the size decides first
+  if (size >= STL_HEADER_BYTES && readBinaryStl(data, size, coords, indices)) {
+    return true;
+  }
+  coords.clear();
+  indices.clear();
+  const char* text = reinterpret_cast<const char*>(data);
+  if (size >= 5 && std::memcmp(text, "solid", 5) == 0 && readAsciiStl(text, text + size, coords, indices)) {
+    return true;
+  }
+  error = "not a PNG, height grid, PLY or STL file";
+  return false;
+}
+
+}  // namespace Geometry
+}  // namespace ChipCarving
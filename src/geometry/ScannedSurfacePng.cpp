@@ -0,0 +1,185 @@
+/**
+ * ScannedSurfacePng.cpp
+ *
+ * Grayscale heightmap PNG decoding for scanned surfaces
+ * Split from ScannedSurface.cpp for maintainability
+ */
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <limits>
+#include <string>
+#include <vector>
+
+#include "ScannedSurfaceReaders.h"
+#include "utils/Inflate.h"
+
+namespace ChipCarving {
+namespace Geometry {
+
+namespace {
+
+constexpr unsigned char PNG_SIGNATURE[8] = {137, 80, 78, 71, 13, 10, 26, 10};
+constexpr uint32_t MAX_DIMENSION = 1u << 16;  // Pixels per side; keeps the decoded heights below 16 GB
+constexpr size_t MAX_DEFLATE_RATIO = 1032;    // Most bytes deflate can decode from one compressed byte
+
+enum ColorType : uint8_t { GRAY = 0, GRAY_ALPHA = 4 };
+
+uint32_t readBigEndian32(const unsigned char* bytes) {
+  return (static_cast<uint32_t>(bytes[0]) << 24) | (static_cast<uint32_t>(bytes[1]) << 16) |
+         (static_cast<uint32_t>(bytes[2]) << 8) | bytes[3];
+}
+
+uint32_t sampleAt(const unsigned char* row, size_t index, int bitDepth) {
+  return bitDepth == 16 ? (static_cast<uint32_t>(row[2 * index]) << 8) | row[2 * index + 1] : row[index];
+}
+
+int paethPredictor(int left, int above, int upperLeft) {
+  int estimate = left + above - upperLeft;
+  int toLeft = std::abs(estimate - left);
+  int toAbove = std::abs(estimate - above);
+  int toUpperLeft = std::abs(estimate - upperLeft);
+  if (toLeft <= toAbove && toLeft <= toUpperLeft) {
+    return left;
+  }
+  return toAbove <= toUpperLeft ? above : upperLeft;
+}
+
+// Undo one scanline filter in place; previous is the unfiltered row above (zeros for the first row)
+bool unfilterRow(uint8_t filter, unsigned char* row, const unsigned char* previous, size_t length, size_t stride) {
+  for (size_t i = 0; i < length; ++i) {
+    int left = i >= stride ? row[i - stride] : 0;
+    int above = previous[i];
+    int upperLeft = i >= stride ? previous[i - stride] : 0;
+    int predicted = 0;
+    switch (filter) {
+      case 0:
+        return true;
+      case 1:
+        predicted = left;
+        break;
+      case 2:
+        predicted = above;
+        break;
+      case 3:
+        predicted = (left + above) / 2;
+        break;
+      case 4:
+        predicted = paethPredictor(left, above, upperLeft);
+        break;
+      default:
+        return false;
+    }
+    row[i] = static_cast<unsigned char>(row[i] + predicted);
+  }
+  return true;
+}
+
+}  // namespace
+
+bool isPngData(const unsigned char* data, size_t size) {
+  return data && size >= sizeof(PNG_SIGNATURE) && std::memcmp(data, PNG_SIGNATURE, sizeof(PNG_SIGNATURE)) == 0;
+}
+
+bool decodeHeightmapPng(const unsigned char* data, size_t size, double heightRange, size_t& columns, size_t& rows,
+                        std::vector<float>& heights, std::string& error) {
+  if (!isPngData(data, size)) {
+    error = "not a PNG file";
+    return false;
+  }
+
+  // Chunks: IHDR first, optional tRNS gray key, image data split over IDATs
+  uint32_t width = 0;
+  uint32_t height = 0;
+  int bitDepth = 0;
+  uint8_t colorType = 0;
+  bool hasTransparentGray = false;
+  uint32_t transparentGray = 0;
+  std::vector<unsigned char> compressed;
+  size_t offset = sizeof(PNG_SIGNATURE);
+  for (;;) {
+    if (size - offset < 12) {
+      error = "PNG is truncated";
+      return false;
+    }
+    uint32_t length = readBigEndian32(data + offset);
+    const unsigned char* type = data + offset + 4;
+    const unsigned char* body = data + offset + 8;
+    if (length > size - offset - 12) {
+      error = "PNG is truncated";
+      return false;
+    }
+    offset += 12 + static_cast<size_t>(length);
+
+    if (std::memcmp(type, "IHDR", 4) == 0 && length >= 13) {
+      width = readBigEndian32(body);
+      height = readBigEndian32(body + 4);
+      bitDepth = body[8];
+      colorType = body[9];
+      if (body[12] != 0) {
+        error = "interlaced PNG heightmaps are not supported";
+        return false;
+      }
+    } else if (std::memcmp(type, "tRNS", 4) == 0 && length >= 2) {
+      hasTransparentGray = true;
+      transparentGray = (static_cast<uint32_t>(body[0]) << 8) | body[1];
+    } else if (std::memcmp(type, "IDAT", 4) == 0) {
+      compressed.insert(compressed.end(), body, body + length);
+    } else if (std::memcmp(type, "IEND", 4) == 0) {
+      break;
+    }
+  }
+  if (width == 0 || height == 0 || width > MAX_DIMENSION || height > MAX_DIMENSION) {
+    error = "PNG heightmap size is out of range";
+    return false;
+  }
+  if ((colorType != GRAY && colorType != GRAY_ALPHA) || (bitDepth != 8 && bitDepth != 16)) {
+    error = "heightmap PNG must be 8- or 16-bit grayscale";
+    return false;
+  }
+
+  size_t channels = colorType == GRAY_ALPHA ? 2 : 1;
+  size_t stride = channels * static_cast<size_t>(bitDepth / 8);
+  size_t rowBytes = stride * width;
+  size_t rawBytes = (rowBytes + 1) * height;
+  // The header alone must not size the buffer: a huge image with little data fails in the decoder instead
+  std::vector<unsigned char> raw;
+  raw.reserve(std::min(rawBytes, compressed.size() * MAX_DEFLATE_RATIO));
+  if (!Utils::inflateZlib(compressed.data(), compressed.size(), raw, rawBytes) || raw.size() != rawBytes) {
+    error = "PNG image data is corrupt";
+    return false;
+  }
+  compressed.clear();
+  compressed.shrink_to_fit();
+
+  // Image row 0 is the top, so it becomes the last height row
+  double scale = heightRange / (bitDepth == 16 ? 65535.0 : 255.0);
+  columns = width;
+  rows = height;
+  heights.assign(static_cast<size_t>(width) * height, 0.0f);
+  std::vector<unsigned char> zeros(rowBytes, 0);
+  const unsigned char* previous = zeros.data();
+  for (size_t y = 0; y < height; ++y) {
+    unsigned char* line = raw.data() + y * (rowBytes + 1);
+    unsigned char* row = line + 1;
+    if (!unfilterRow(line[0], row, previous, rowBytes, stride)) {
+      error = "PNG row filter is invalid";
+      return false;
+    }
+    float* out = heights.data() + (height - 1 - y) * width;
+    for (size_t x = 0; x < width; ++x) {
+      uint32_t gray = sampleAt(row, x * channels, bitDepth);
+      bool transparent = (hasTransparentGray && gray == transparentGray) ||
+                         (channels == 2 && sampleAt(row, x * channels + 1, bitDepth) == 0);
+      out[x] = transparent ? std::numeric_limits<float>::quiet_NaN() : static_cast<float>(gray * scale);
+    }
+    previous = row;
+  }
+  return true;
+}
+
+}  // namespace Geometry
+}  // namespace ChipCarving
@@ -0,0 +1,39 @@
+/**
+ * ScannedSurfaceReaders.h
+ *
+ * Decoders for the scan file formats ScannedSurface reads
+ * Split from ScannedSurface.cpp for maintainability
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <string>
+#include <vector>
+
+namespace ChipCarving {
+namespace Geometry {
+
+// True if data starts with the PNG signature
+bool isPngData(const unsigned char* data, size_t size);
+
+/**
+ * Decode a non-interlaced grayscale (optionally with alpha) PNG of 8 or 16 bits
+ * @param heightRange Height of full-scale white (mm)
+ * @param heights Output, columns * rows heights (mm) with row 0 at the bottom of
+ *                the image; transparent pixels are NaN
+ */
+bool decodeHeightmapPng(const unsigned char* data, size_t size, double heightRange, size_t& columns, size_t& rows,
+                        std::vector<float>& heights, std::string& error);
+
+/**
+ * Read the triangles of a PLY (ASCII or binary) or STL (ASCII or binary) mesh
+ * Polygon faces are split into triangle fans
+ * @param coords Output x, y, z triples (file units)
+ * @param indices Output, three coords entries per triangle
+ */
+bool readScanMesh(const unsigned char* data, size_t size, std::vector<double>& coords, std::vector<int>& indices,
+                  std::string& error);
+
+}  // namespace Geometry
+}  // namespace ChipCarving
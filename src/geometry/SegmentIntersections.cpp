@@ -0,0 +1,260 @@
+/**
+ * SegmentIntersections.cpp
+ *
+ * Bentley-Ottmann sweep: a vertical line sweeps left to right (bottom to top
+ * along a vertical), stopping at segment ends and at crossings found between
+ * segments that become neighbours in the status, the segments the line cuts
+ * ordered by height. All segments through an event point leave the status and
+ * those continuing past it re-enter in their order just after it, so only
+ * neighbours are ever tested.
+ */
+
+#include "geometry/SegmentIntersections.h"
+
+#include <algorithm>
+#include <cmath>
+#include <iterator>
+#include <limits>
+#include <map>
+#include <set>
+#include <utility>
+
+namespace ChipCarving {
+namespace Geometry {
+
+namespace {
+
+// Points and heights this close (relative to the coordinates' magnitude) are the same
+constexpr double RELATIVE_TOLERANCE = 1e-9;
+
+bool sweepsBefore(const Point2D& p, const Point2D& q) {
+  return p.x < q.x || (p.x == q.x && p.y < q.y);
+}
+
+struct SweepOrder {
+  bool operator()(const Point2D& p, const Point2D& q) const {
+    return sweepsBefore(p, q);
+  }
+};
+
+double cross(const Point2D& a, const Point2D& b) {
+  return a.x * b.y - a.y * b.x;
+}
+
+class Sweep {
+ public:
+  Sweep(const std::vector<SweepSegment>& input, std::vector<SegmentCrossing>& crossings)
+      : crossings_(crossings), status_(StatusOrder{this}) {
+    double extent = 1.0;
+    for (const auto& segment : input) {
+      extent = std::max({extent, std::abs(segment.a.x), std::abs(segment.a.y), std::abs(segment.b.x),
+                         std::abs(segment.b.y)});
+    }
+    tolerance_ = RELATIVE_TOLERANCE * extent;
+
+    segments_.reserve(input.size());
+    for (size_t i = 0; i < input.size(); ++i) {
+      const SweepSegment& segment = input[i];
+      if (segment.a.equals(segment.b, tolerance_)) {
+        continue;
+      }
+      Segment swept;
+      swept.index = i;
+      swept.group = segment.group;
+      swept.start = sweepsBefore(segment.a, segment.b) ? segment.a : segment.b;
+      swept.end = sweepsBefore(segment.a, segment.b) ? segment.b : segment.a;
+      double dx = swept.end.x - swept.start.x;
+      swept.vertical = std::abs(dx) <= tolerance_;
+      swept.slope = swept.vertical ? std::numeric_limits<double>::infinity() : (swept.end.y - swept.start.y) / dx;
+      events_[swept.start].push_back(segments_.size());
+      events_[swept.end];
+      segments_.push_back(swept);
+    }
+  }
+
+  void run() {
+    while (!events_.empty()) {
+      auto event = events_.begin();
+      Point2D point = event->first;
+      std::vector<size_t> starting = std::move(event->second);
+      events_.erase(event);
+      handle(point, starting);
+    }
+  }
+
+ private:
+  static constexpr size_t PROBE = std::numeric_limits<size_t>::max();
+
+  struct Segment {
+    Point2D start{};  // First in sweep order
+    Point2D end{};
+    size_t index = 0;  // In the input
+    int group = 0;
+    bool vertical = false;
+    double slope = 0.0;  // Infinite for vertical segments
+  };
+
+  // Bottom to top where the sweep line is; segments through the sweep point by slope, as just after it
+  struct StatusOrder {
+    const Sweep* sweep;
+    bool operator()(size_t i, size_t j) const {
+      double yi = sweep->heightAt(i);
+      double yj = sweep->heightAt(j);
+      if (i == PROBE || j == PROBE) {
+        return yi < yj;
+      }
+      if (std::abs(yi - yj) > sweep->tolerance_) {
+        return yi < yj;
+      }
+      const Segment& a = sweep->segments_[i];
+      const Segment& b = sweep->segments_[j];
+      if (a.slope != b.slope) {
+        return a.slope < b.slope;
+      }
+      return i < j;
+    }
+  };
+  using Status = std::set<size_t, StatusOrder>;
+
+  double heightAt(size_t i) const {
+    if (i == PROBE) {
+      return probeHeight_;
+    }
+    const Segment& segment = segments_[i];
+    if (segment.vertical) {
+      return std::max(segment.start.y, std::min(sweepPoint_.y, segment.end.y));
+    }
+    if (sweepPoint_.x <= segment.start.x) {
+      return segment.start.y;
+    }
+    if (sweepPoint_.x >= segment.end.x) {
+      return segment.end.y;
+    }
+    return segment.start.y + (sweepPoint_.x - segment.start.x) * segment.slope;
+  }
+
+  // Distance from point to the segment within tolerance
+  bool contains(const Segment& segment, const Point2D& point) const {
+    Point2D direction = segment.end - segment.start;
+    double lengthSquared = direction.x * direction.x + direction.y * direction.y;
+    Point2D offset = point - segment.start;
+    double t = std::max(0.0, std::min(1.0, (offset.x * direction.x + offset.y * direction.y) / lengthSquared));
+    return distance(point, segment.start + direction * t) <= tolerance_;
+  }
+
+  Status::iterator firstAtOrAbove(double height) {
+    probeHeight_ = height;
+    return status_.lower_bound(PROBE);
+  }
+
+  void handle(const Point2D& point, const std::vector<size_t>& starting) {
+    sweepPoint_ = point;
+
+    // Segments in the status through point: ending there or passing through it
+    std::vector<size_t> through;
+    std::vector<Status::iterator> leaving;
+    std::vector<size_t> continuing;
+    for (auto it = firstAtOrAbove(point.y - tolerance_); it != status_.end() && heightAt(*it) <= point.y + tolerance_;
+         ++it) {
+      const Segment& segment = segments_[*it];
+      if (contains(segment, point)) {
+        through.push_back(*it);
+        leaving.push_back(it);
+        if (!segment.end.equals(point, tolerance_)) {
+          continuing.push_back(*it);
+        }
+      }
+    }
+
+    std::vector<size_t> meeting = through;
+    meeting.insert(meeting.end(), starting.begin(), starting.end());
+    report(meeting, point);
+
+    for (auto it : leaving) {
+      status_.erase(it);
+    }
+    continuing.insert(continuing.end(), starting.begin(), starting.end());
+    if (continuing.empty()) {
+      auto above = firstAtOrAbove(point.y);
+      if (above != status_.begin() && above != status_.end()) {
+        findEvent(*std::prev(above), *above, point);
+      }
+      return;
+    }
+
+    for (size_t segment : continuing) {
+      status_.insert(segment);
+    }
+    auto lowest = status_.find(*std::min_element(continuing.begin(), continuing.end(), status_.key_comp()));
+    auto highest = status_.find(*std::max_element(continuing.begin(), continuing.end(), status_.key_comp()));
+    if (lowest != status_.begin()) {
+      findEvent(*std::prev(lowest), *lowest, point);
+    }
+    if (std::next(highest) != status_.end()) {
+      findEvent(*highest, *std::next(highest), point);
+    }
+  }
+
+  void report(const std::vector<size_t>& meeting, const Point2D& point) {
+    for (size_t i = 0; i < meeting.size(); ++i) {
+      for (size_t j = i + 1; j < meeting.size(); ++j) {
+        const Segment& a = segments_[meeting[i]];
+        const Segment& b = segments_[meeting[j]];
+        if (a.group == b.group) {
+          continue;
+        }
+        auto pair = std::minmax(a.index, b.index);
+        if (reported_.insert(pair).second) {
+          crossings_.push_back(SegmentCrossing{pair.first, pair.second, point});
+        }
+      }
+    }
+  }
+
+  // Queue the crossing of two neighbours if the sweep has yet to reach it
+  void findEvent(size_t i, size_t j, const Point2D& point) {
+    const Segment& a = segments_[i];
+    const Segment& b = segments_[j];
+    Point2D r = a.end - a.start;
+    Point2D s = b.end - b.start;
+    double denominator = cross(r, s);
+    double lengths = std::sqrt((r.x * r.x + r.y * r.y) * (s.x * s.x + s.y * s.y));
+    if (std::abs(denominator) <= RELATIVE_TOLERANCE * lengths) {
+      return;  // Parallel; overlaps meet at segment ends, which are events already
+    }
+    Point2D offset = b.start - a.start;
+    double t = cross(offset, s) / denominator;
+    double u = cross(offset, r) / denominator;
+    double slackT = tolerance_ / std::sqrt(r.x * r.x + r.y * r.y);
+    double slackU = tolerance_ / std::sqrt(s.x * s.x + s.y * s.y);
+    if (t < -slackT || t > 1.0 + slackT || u < -slackU || u > 1.0 + slackU) {
+      return;
+    }
+    Point2D crossing = a.start + r * std::max(0.0, std::min(1.0, t));
+    if (sweepsBefore(point, crossing) && !crossing.equals(point, tolerance_)) {
+      events_[crossing];
+    }
+  }
+
+  std::vector<Segment> segments_{};
+  std::map<Point2D, std::vector<size_t>, SweepOrder> events_{};  // Segments starting at each point
+  std::vector<SegmentCrossing>& crossings_;
+  std::set<std::pair<size_t, size_t>> reported_{};
+  Point2D sweepPoint_{};
+  double probeHeight_ = 0.0;
+  double tolerance_ = RELATIVE_TOLERANCE;
+  Status status_;
+};
+
+constexpr size_t Sweep::PROBE;
+
+}  // namespace
+
+void findSegmentCrossings(const std::vector<SweepSegment>& segments, std::vector<SegmentCrossing>& crossings) {
+  crossings.clear();
+  Sweep sweep(segments, crossings);
+  sweep.run();
+}
+
+}  // namespace Geometry
+}  // namespace ChipCarving
@@ -0,0 +1,260 @@
+/**
+ * ShapeContainment.cpp
+ *
+ * Shape box grid and the tile-parallel batch containment query
+ */
+
+#include "geometry/ShapeContainment.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <thread>
+
+#include "geometry/PointKernels.h"
+
+namespace ChipCarving {
+namespace Geometry {
+
+constexpr size_t ShapeContainmentIndex::NO_SHAPE;
+constexpr size_t ShapeContainmentIndex::MAX_GRID_CELLS;
+constexpr size_t ShapeContainmentIndex::PARALLEL_MIN_POINTS;
+
+namespace {
+
+// Cells per shape on average; enough that a point meets few shapes it misses
+constexpr size_t CELLS_PER_SHAPE = 4;
+
+// Points of one cell are tested in tiles of at most this many, the unit of work a thread takes
+constexpr size_t TILE_POINTS = 4096;
+
+constexpr uint32_t NO_CELL = static_cast<uint32_t>(-1);
+
+ShapeBounds grown(const ShapeBounds& bounds, double tolerance) {
+  ShapeBounds box;
+  box.min = Point2D(bounds.min.x - tolerance, bounds.min.y - tolerance);
+  box.max = Point2D(bounds.max.x + tolerance, bounds.max.y + tolerance);
+  return box;
+}
+
+bool inBox(const ShapeBounds& box, double x, double y) {
+  return x >= box.min.x && x <= box.max.x && y >= box.min.y && y <= box.max.y;
+}
+
+size_t axisCells(double extent, size_t cellsPerAxis) {
+  return extent > 0.0 ? cellsPerAxis : 1;
+}
+
+struct Tile {
+  size_t cell;
+  size_t begin;  // Into the cell-sorted point order
+  size_t end;
+};
+
+}  // namespace
+
+ShapeContainmentIndex::ShapeContainmentIndex(const ShapeStore& shapes) : shapeCount_(shapes.size()) {
+  // Tests in import order, so every cell list below is too
+  std::vector<Candidate> candidates;
+  std::vector<ShapeBounds> boxes;
+  for (size_t i = 0; i < shapes.size(); ++i) {
+    ShapeHandle handle = shapes.handle(i);
+    if (handle.kind == ShapeKind::LEAF) {
+      const Leaf& leaf = shapes.leaves()[handle.index];
+      if (!leaf.isValidGeometry()) {
+        continue;
+      }
+      LeafTest test;
+      test.box = grown(leaf.getBounds(), Leaf::CONTAINS_TOLERANCE);
+      test.center1 = leaf.getArcCenters().first;
+      test.center2 = leaf.getArcCenters().second;
+      test.limit = leaf.getRadius() + Leaf::CONTAINS_TOLERANCE;
+      candidates.push_back({ShapeKind::LEAF, static_cast<uint32_t>(leaves_.size()), i});
+      boxes.push_back(test.box);
+      leaves_.push_back(test);
+    } else {
+      const TriArc& triArc = shapes.triArcs()[handle.index];
+      Point2D v0 = triArc.getVertex(0);
+      Point2D v1 = triArc.getVertex(1);
+      Point2D v2 = triArc.getVertex(2);
+      TriArcTest test;
+      test.denominator = (v1.y - v2.y) * (v0.x - v2.x) + (v2.x - v1.x) * (v0.y - v2.y);
+      if (std::abs(test.denominator) < TriArc::DEGENERATE_DENOMINATOR) {
+        continue;
+      }
+      test.box = grown(triArc.getBounds(), TriArc::BOUNDS_TOLERANCE);
+      test.origin = v2;
+      test.coefficientsA = Point2D(v1.y - v2.y, v2.x - v1.x);
+      test.coefficientsB = Point2D(v2.y - v0.y, v0.x - v2.x);
+      candidates.push_back({ShapeKind::TRI_ARC, static_cast<uint32_t>(triArcs_.size()), i});
+      boxes.push_back(test.box);
+      triArcs_.push_back(test);
+    }
+  }
+  if (candidates.empty()) {
+    return;
+  }
+
+  area_ = boxes[0];
+  for (const auto& box : boxes) {
+    area_.min = Point2D(std::min(area_.min.x, box.min.x), std::min(area_.min.y, box.min.y));
+    area_.max = Point2D(std::max(area_.max.x, box.max.x), std::max(area_.max.y, box.max.y));
+  }
+  size_t cellBudget = std::min(candidates.size() * CELLS_PER_SHAPE, MAX_GRID_CELLS);
+  size_t cellsPerAxis = std::max<size_t>(1, static_cast<size_t>(std::sqrt(static_cast<double>(cellBudget))));
+  columns_ = axisCells(area_.max.x - area_.min.x, cellsPerAxis);
+  rows_ = axisCells(area_.max.y - area_.min.y, cellsPerAxis);
+  cellWidth_ = columns_ > 1 ? (area_.max.x - area_.min.x) / columns_ : 1.0;
+  cellHeight_ = rows_ > 1 ? (area_.max.y - area_.min.y) / rows_ : 1.0;
+  cells_.assign(columns_ * rows_, {});
+
+  for (size_t c = 0; c < candidates.size(); ++c) {
+    size_t first = cellIndex(boxes[c].min.x, boxes[c].min.y);
+    size_t last = cellIndex(boxes[c].max.x, boxes[c].max.y);
+    for (size_t row = first / columns_; row <= last / columns_; ++row) {
+      for (size_t col = first % columns_; col <= last % columns_; ++col) {
+        cells_[row * columns_ + col].push_back(candidates[c]);
+      }
+    }
+  }
+}
+
+size_t ShapeContainmentIndex::cellIndex(double x, double y) const {
+  double gx = std::floor((x - area_.min.x) / cellWidth_);
+  double gy = std::floor((y - area_.min.y) / cellHeight_);
+  size_t col = static_cast<size_t>(std::min(std::max(gx, 0.0), static_cast<double>(columns_ - 1)));
+  size_t row = static_cast<size_t>(std::min(std::max(gy, 0.0), static_cast<double>(rows_ - 1)));
+  return row * columns_ + col;
+}
+
+void ShapeContainmentIndex::testTile(const std::vector<Candidate>& candidates, const double* x, const double* y,
+                                     size_t count, double* scratch, size_t* first) const {
+  double* u = scratch;
+  double* v = scratch + count;
+  size_t remaining = count;
+  for (const Candidate& candidate : candidates) {
+    if (candidate.kind == ShapeKind::LEAF) {
+      const LeafTest& test = leaves_[candidate.test];
+      pointDistances(x, y, count, test.center1, u);
+      pointDistances(x, y, count, test.center2, v);
+      for (size_t i = 0; i < count; ++i) {
+        bool hit = inBox(test.box, x[i], y[i]) && u[i] <= test.limit && v[i] <= test.limit;
+        if (hit && first[i] == NO_SHAPE) {
+          first[i] = candidate.shape;
+          --remaining;
+        }
+      }
+    } else {
+      const TriArcTest& test = triArcs_[candidate.test];
+      linearForms(x, y, count, test.origin, test.coefficientsA, test.denominator, u);
+      linearForms(x, y, count, test.origin, test.coefficientsB, test.denominator, v);
+      for (size_t i = 0; i < count; ++i) {
+        double w = 1 - u[i] - v[i];
+        bool hit = inBox(test.box, x[i], y[i]) && u[i] >= 0 && v[i] >= 0 && w >= 0;
+        if (hit && first[i] == NO_SHAPE) {
+          first[i] = candidate.shape;
+          --remaining;
+        }
+      }
+    }
+    if (remaining == 0) {
+      break;
+    }
+  }
+}
+
+void ShapeContainmentIndex::containingShapes(const Point2D* points, size_t count, size_t* shapes,
+                                             int workers) const {
+  std::fill(shapes, shapes + count, NO_SHAPE);
+  if (cells_.empty() || count == 0) {
+    return;
+  }
+
+  // Bucket the points by grid cell; points outside every box stay in no shape
+  std::vector<uint32_t> pointCells(count);
+  std::vector<size_t> starts(cells_.size() + 1, 0);
+  for (size_t i = 0; i < count; ++i) {
+    const Point2D& point = points[i];
+    pointCells[i] = inBox(area_, point.x, point.y) ? static_cast<uint32_t>(cellIndex(point.x, point.y)) : NO_CELL;
+    if (pointCells[i] != NO_CELL) {
+      starts[pointCells[i] + 1]++;
+    }
+  }
+  for (size_t cell = 0; cell < cells_.size(); ++cell) {
+    starts[cell + 1] += starts[cell];
+  }
+  std::vector<size_t> order(starts.back());
+  std::vector<size_t> next(starts.begin(), starts.end() - 1);
+  for (size_t i = 0; i < count; ++i) {
+    if (pointCells[i] != NO_CELL) {
+      order[next[pointCells[i]]++] = i;
+    }
+  }
+
+  std::vector<Tile> tiles;
+  for (size_t cell = 0; cell < cells_.size(); ++cell) {
+    if (cells_[cell].empty()) {
+      continue;
+    }
+    for (size_t begin = starts[cell]; begin < starts[cell + 1]; begin += TILE_POINTS) {
+      tiles.push_back({cell, begin, std::min(starts[cell + 1], begin + TILE_POINTS)});
+    }
+  }
+
+  // Workers pull the next tile, so cells crowded with points or shapes balance
+  std::atomic<size_t> nextTile{0};
+  auto worker = [&]() {
+    std::vector<double> x, y, scratch;
+    std::vector<size_t> first;
+    for (size_t t = nextTile.fetch_add(1); t < tiles.size(); t = nextTile.fetch_add(1)) {
+      const Tile& tile = tiles[t];
+      size_t size = tile.end - tile.begin;
+      x.resize(size);
+      y.resize(size);
+      scratch.resize(2 * size);
+      first.assign(size, NO_SHAPE);
+      for (size_t k = 0; k < size; ++k) {
+        const Point2D& point = points[order[tile.begin + k]];
+        x[k] = point.x;
+        y[k] = point.y;
+      }
+      testTile(cells_[tile.cell], x.data(), y.data(), size, scratch.data(), first.data());
+      for (size_t k = 0; k < size; ++k) {
+        shapes[order[tile.begin + k]] = first[k];
+      }
+    }
+  };
+
+  int threads = workers > 0 ? workers : static_cast<int>(std::thread::hardware_concurrency());
+  if (count < PARALLEL_MIN_POINTS) {
+    threads = 1;
+  }
+  threads = std::max(1, std::min(threads, static_cast<int>(tiles.size())));
+  if (threads == 1) {
+    worker();
+    return;
+  }
+  std::vector<std::thread> pool;
+  pool.reserve(static_cast<size_t>(threads));
+  for (int t = 0; t < threads; ++t) {
+    pool.emplace_back(worker);
+  }
+  for (auto& thread : pool) {
+    thread.join();
+  }
+}
+
+void ShapeContainmentIndex::containsBatch(const Point2D* points, size_t count, uint8_t* inside, int workers) const {
+  std::vector<size_t> shapes(count);
+  containingShapes(points, count, shapes.data(), workers);
+  for (size_t i = 0; i < count; ++i) {
+    inside[i] = shapes[i] != NO_SHAPE;
+  }
+}
+
+void containsBatch(const ShapeStore& shapes, const Point2D* points, size_t count, uint8_t* inside, int workers) {
+  ShapeContainmentIndex(shapes).containsBatch(points, count, inside, workers);
+}
+
+}  // namespace Geometry
+}  // namespace ChipCarving
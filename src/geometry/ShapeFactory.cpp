@@ -4,155 +4,205 @@
 
 #include "geometry/ShapeFactory.h"
 
-#include <regex>
+#include <algorithm>
+#include <array>
+#include <atomic>
 #include <stdexcept>
+#include <thread>
 
 #include "adapters/IFusionInterface.h"
 #include "geometry/Leaf.h"
 #include "geometry/TriArc.h"
+#include "parsers/JsonReader.h"
+#include "utils/MonotonicArena.h"
 
 using ChipCarving::Geometry::Leaf;
 using ChipCarving::Geometry::Point2D;
 using ChipCarving::Geometry::Shape;
 using ChipCarving::Geometry::ShapeFactory;
+using ChipCarving::Geometry::ShapeSpec;
 using ChipCarving::Geometry::TriArc;
+using ChipCarving::Parsers::JsonReader;
 
-std::unique_ptr<Shape> ShapeFactory::createFromJson(const std::string& shapeJson, const Adapters::ILogger* logger) {
-  std::string shapeType = extractShapeType(shapeJson);
-  // Debug logging disabled for performance
-  // if (logger) {
-  //     logger->logDebug("ShapeFactory: Creating shape of type: " + shapeType);
-  // }
-
-  if (shapeType == "LEAF") {
-    std::vector<Point2D> vertices = extractVertices(shapeJson);
-    double radius = extractRadius(shapeJson);
-    // Debug logging disabled for performance
-    // if (logger) {
-    //     logger->logDebug("ShapeFactory: Creating LEAF with " +
-    //     std::to_string(vertices.size()) +
-    //                      " vertices");
-    // }
-    return createLeaf(vertices, radius, logger);
-  }
-  if (shapeType == "TRI_ARC") {
-    std::vector<Point2D> vertices = extractVertices(shapeJson);
-    std::vector<double> curvatures = extractCurvatures(shapeJson);
-    // Debug logging disabled for performance
-    // if (logger) {
-    //     logger->logDebug("ShapeFactory: Creating TRI_ARC with " +
-    //                      std::to_string(vertices.size()) + " vertices and " +
-    //                      std::to_string(curvatures.size()) + " curvatures");
-    // }
-    return createTriArc(vertices, curvatures, logger);
-  }
-  throw std::runtime_error("Unknown shape type: " + shapeType);
-}
-
-std::unique_ptr<Shape> ShapeFactory::createLeaf(const std::vector<Point2D>& vertices, double radius,
-                                                const Adapters::ILogger* logger) {
-  (void)logger;  // Suppress unused parameter warning
-  validateLeafParameters(vertices, radius);
-  return std::make_unique<Leaf>(vertices[0], vertices[1], radius);
-}
+namespace {
 
-std::unique_ptr<Shape> ShapeFactory::createTriArc(const std::vector<Point2D>& vertices,
-                                                  const std::vector<double>& curvatures,
-                                                  const Adapters::ILogger* logger) {
-  (void)logger;  // Suppress unused parameter warning
-  validateTriArcParameters(vertices, curvatures);
+constexpr size_t MIN_SHAPES_PER_WORKER = 256;
 
-  // Convert curvatures to bulge factors (schema uses curvatures, TriArc uses
-  // bulge factors)
-  std::array<double, 3> bulgeFactors;
-  for (size_t i = 0; i < 3; ++i) {
-    bulgeFactors[i] = curvatures[i];  // Direct mapping for now
-  }
-
-  return std::make_unique<TriArc>(vertices[0], vertices[1], vertices[2], bulgeFactors);
+// Schema curvatures map directly to TriArc bulge factors
+std::array<double, 3> bulgeFactors(const std::vector<double>& curvatures) {
+  return {curvatures[0], curvatures[1], curvatures[2]};
 }
 
-std::string ShapeFactory::extractShapeType(const std::string& shapeJson) {
-  // Extract "type": "LEAF" or "type": "TRI_ARC"
-  std::regex typeRegex("\"type\"\\s*:\\s*\"([^\"]+)\"");
-  std::smatch match;
+}  // namespace
 
-  if (std::regex_search(shapeJson, match, typeRegex)) {
-    return match[1].str();
-  }
+std::unique_ptr<Shape> ShapeFactory::createFromJson(const std::string& shapeJson, const Adapters::ILogger* logger) {
+  JsonReader reader(shapeJson);
+  auto shape = createFromJson(reader, logger);
+  reader.expectEnd();
+  return shape;
+}
 
-  throw std::runtime_error("No shape type found in JSON");
+std::unique_ptr<Shape> ShapeFactory::createFromJson(JsonReader& reader, const Adapters::ILogger* logger) {
+  return createFromSpec(readSpec(reader), logger);
 }
 
-std::vector<Point2D> ShapeFactory::extractVertices(const std::string& shapeJson) {
-  // Extract "vertices": [{"x": 1.0, "y": 2.0}, ...]
-  std::regex verticesRegex("\"vertices\"\\s*:\\s*\\[([^\\]]+)\\]");
-  std::smatch match;
+ShapeSpec ShapeFactory::readSpec(JsonReader& reader) {
+  ShapeSpec spec;
+  readSpec(reader, spec);
+  return spec;
+}
 
-  if (!std::regex_search(shapeJson, match, verticesRegex)) {
+void ShapeFactory::readSpec(JsonReader& reader, ShapeSpec& spec) {
+  // Read every member in one pass; which ones are required depends on the type
+  spec.type.clear();
+  spec.vertices.clear();
+  spec.curvatures.clear();
+  spec.radius = 0.0;
+  bool hasVertices = false;
+  bool hasRadius = false;
+  bool hasCurvatures = false;
+
+  std::string key;
+  reader.beginObject();
+  while (reader.nextMember(key)) {
+    if (key == "type") {
+      reader.readString(spec.type);
+    } else if (key == "vertices") {
+      hasVertices = true;
+      reader.beginArray();
+      while (reader.nextElement()) {
+        spec.vertices.push_back(Parsers::readPoint(reader));
+      }
+    } else if (key == "radius") {
+      hasRadius = true;
+      spec.radius = reader.readNumber();
+    } else if (key == "curvatures") {
+      hasCurvatures = true;
+      reader.beginArray();
+      while (reader.nextElement()) {
+        spec.curvatures.push_back(reader.readNumber());
+      }
+    } else {
+      reader.skipValue();
+    }
+  }
+
+  if (spec.type.empty()) {
+    throw std::runtime_error("No shape type found in JSON");
+  }
+  if (spec.type != "LEAF" && spec.type != "TRI_ARC") {
+    throw std::runtime_error("Unknown shape type: " + spec.type);
+  }
+  if (!hasVertices) {
     throw std::runtime_error("No vertices found in JSON");
   }
-
-  std::string verticesArray = match[1].str();
-  std::vector<Point2D> vertices;
-
-  // Extract individual points: {"x": 1.0, "y": 2.0}
-  std::regex pointRegex("\\{\\s*\"x\"\\s*:\\s*([-+]?[0-9]*\\.?[0-9]+)\\s*,\\s*\"y\"\\s*:\\s*([-+]"
-                        "?[0-9]*\\.?[0-9]+)\\s*\\}");
-  std::sregex_iterator iter(verticesArray.begin(), verticesArray.end(), pointRegex);
-  std::sregex_iterator end;
-
-  for (; iter != end; ++iter) {
-    double x = std::stod((*iter)[1].str());
-    double y = std::stod((*iter)[2].str());
-    vertices.emplace_back(x, y);
+  if (spec.vertices.empty()) {
+    throw std::runtime_error("No valid vertices found in JSON");
   }
 
-  if (vertices.empty()) {
-    throw std::runtime_error("No valid vertices found in JSON");
+  if (spec.type == "LEAF") {
+    if (!hasRadius) {
+      throw std::runtime_error("No radius found in JSON");
+    }
+    return;
   }
 
-  return vertices;
+  if (!hasCurvatures) {
+    throw std::runtime_error("No curvatures found in JSON");
+  }
+  if (spec.curvatures.empty()) {
+    throw std::runtime_error("No valid curvatures found in JSON");
+  }
 }
 
-double ShapeFactory::extractRadius(const std::string& shapeJson) {
-  // Extract "radius": 5.0
-  std::regex radiusRegex("\"radius\"\\s*:\\s*([-+]?[0-9]*\\.?[0-9]+)");
-  std::smatch match;
-
-  if (std::regex_search(shapeJson, match, radiusRegex)) {
-    return std::stod(match[1].str());
+std::unique_ptr<Shape> ShapeFactory::createFromSpec(const ShapeSpec& spec, const Adapters::ILogger* logger) {
+  if (spec.type == "LEAF") {
+    return createLeaf(spec.vertices, spec.radius, logger);
   }
-
-  throw std::runtime_error("No radius found in JSON");
+  if (spec.type == "TRI_ARC") {
+    return createTriArc(spec.vertices, spec.curvatures, logger);
+  }
+  throw std::runtime_error("Unknown shape type: " + spec.type);
 }
 
-std::vector<double> ShapeFactory::extractCurvatures(const std::string& shapeJson) {
-  // Extract "curvatures": [-0.125, -0.125, -0.125]
-  std::regex curvaturesRegex("\"curvatures\"\\s*:\\s*\\[([^\\]]+)\\]");
-  std::smatch match;
-
-  if (!std::regex_search(shapeJson, match, curvaturesRegex)) {
-    throw std::runtime_error("No curvatures found in JSON");
+Shape* ShapeFactory::createFromSpec(const ShapeSpec& spec, Utils::MonotonicArena& arena,
+                                    const Adapters::ILogger* logger) {
+  (void)logger;  // Suppress unused parameter warning
+  if (spec.type == "LEAF") {
+    validateLeafParameters(spec.vertices, spec.radius);
+    return arena.create<Leaf>(spec.vertices[0], spec.vertices[1], spec.radius);
   }
-
-  std::string curvaturesArray = match[1].str();
-  std::vector<double> curvatures;
-
-  // Extract individual numbers
-  std::regex numberRegex("[-+]?[0-9]*\\.?[0-9]+");
-  std::sregex_iterator iter(curvaturesArray.begin(), curvaturesArray.end(), numberRegex);
-  std::sregex_iterator end;
-
-  for (; iter != end; ++iter) {
-    curvatures.push_back(std::stod(iter->str()));
+  if (spec.type == "TRI_ARC") {
+    validateTriArcParameters(spec.vertices, spec.curvatures);
+    return arena.create<TriArc>(spec.vertices[0], spec.vertices[1], spec.vertices[2], bulgeFactors(spec.curvatures));
   }
+  throw std::runtime_error("Unknown shape type: " + spec.type);
+}
 
-  if (curvatures.empty()) {
-    throw std::runtime_error("No valid curvatures found in JSON");
-  }
+std::vector<std::unique_ptr<Shape>> ShapeFactory::createShapes(const std::vector<ShapeSpec>& specs,
+                                                               int requestedWorkers,
+                                                               const Adapters::ILogger* logger) {
+  std::vector<std::unique_ptr<Shape>> shapes(specs.size());
+  std::vector<std::string> errors(specs.size());
+  auto build = [&](size_t i) {
+    try {
+      shapes[i] = createFromSpec(specs[i], logger);
+    } catch (const std::exception& e) {
+      errors[i] = e.what();
+    }
+  };
+
+  int workers = requestedWorkers;
+  if (workers <= 0) {
+    workers = static_cast<int>(std::thread::hardware_concurrency());
+  }
+  // A shape takes microseconds; threads only pay off for large designs
+  size_t maxWorkers = std::max<size_t>(1, specs.size() / MIN_SHAPES_PER_WORKER);
+  workers = std::max(1, std::min(workers, static_cast<int>(maxWorkers)));
+
+  if (workers == 1) {
+    for (size_t i = 0; i < specs.size(); ++i) {
+      build(i);
+    }
+  } else {
+    // Workers pull the next index; shapes land in their spec's slot
+    std::atomic<size_t> nextIndex{0};
+    auto worker = [&]() {
+      for (size_t i = nextIndex.fetch_add(1); i < specs.size(); i = nextIndex.fetch_add(1)) {
+        build(i);
+      }
+    };
+    std::vector<std::thread> threads;
+    threads.reserve(static_cast<size_t>(workers));
+    for (int t = 0; t < workers; ++t) {
+      threads.emplace_back(worker);
+    }
+    for (auto& thread : threads) {
+      thread.join();
+    }
+  }
+
+  for (size_t i = 0; i < specs.size(); ++i) {
+    if (!shapes[i]) {
+      throw std::runtime_error("Shape " + std::to_string(i) + ": " + errors[i]);
+    }
+  }
+  return shapes;
+}
 
-  return curvatures;
+std::unique_ptr<Shape> ShapeFactory::createLeaf(const std::vector<Point2D>& vertices, double radius,
+                                                const Adapters::ILogger* logger) {
+  (void)logger;  // Suppress unused parameter warning
+  validateLeafParameters(vertices, radius);
+  return std::make_unique<Leaf>(vertices[0], vertices[1], radius);
+}
+
+std::unique_ptr<Shape> ShapeFactory::createTriArc(const std::vector<Point2D>& vertices,
+                                                  const std::vector<double>& curvatures,
+                                                  const Adapters::ILogger* logger) {
+  (void)logger;  // Suppress unused parameter warning
+  validateTriArcParameters(vertices, curvatures);
+  return std::make_unique<TriArc>(vertices[0], vertices[1], vertices[2], bulgeFactors(curvatures));
 }
 
 void ShapeFactory::validateLeafParameters(const std::vector<Point2D>& vertices, double radius) {
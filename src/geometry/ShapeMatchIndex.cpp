@@ -0,0 +1,143 @@
+/**
+ * ShapeMatchIndex.cpp
+ *
+ * Centroid hash grid over imported shapes with area and bounds filters
+ */
+
+#include "geometry/ShapeMatchIndex.h"
+
+#include <algorithm>
+#include <cmath>
+#include <utility>
+
+#include "geometry/ShapePolygonizer.h"
+
+namespace ChipCarving {
+namespace Geometry {
+
+namespace {
+
+// Shape outlines are tessellated this finely relative to their size
+constexpr double TESSELLATION_ERROR = 1.0e-3;
+
+// Keys of one outline from two tessellations agree to within these fractions
+constexpr double POSITION_SLACK = 0.02;  // Of the bounding box diagonal
+constexpr double AREA_SLACK = 0.10;      // Of the larger area; chords cut off up to 7% of a small leaf
+
+double diagonal(const ShapeBounds& bounds) {
+  return distance(bounds.min, bounds.max);
+}
+
+}  // namespace
+
+ShapeMatchIndex::ShapeMatchIndex(const ShapeStore& shapes, double scale) {
+  keys_.resize(shapes.size());
+  double diagonalSum = 0.0;
+  size_t indexed = 0;
+  for (size_t i = 0; i < shapes.size(); ++i) {
+    const Shape& shape = shapes.at(i);
+    std::vector<Point2D> outline = polygonizeShape(shape, TESSELLATION_ERROR * diagonal(shape.getBounds()));
+    for (auto& point : outline) {
+      point = point * scale;
+    }
+    if (polygonKey(outline, keys_[i])) {
+      diagonalSum += diagonal(keys_[i].bounds);
+      ++indexed;
+    }
+  }
+  if (indexed == 0) {
+    return;
+  }
+
+  // About one shape per cell for a design of similar shapes side by side
+  cellSize_ = std::max(diagonalSum / static_cast<double>(indexed), 1.0e-9);
+  for (size_t i = 0; i < keys_.size(); ++i) {
+    if (keys_[i].area > 0.0) {
+      cells_[cellKey(cellOf(keys_[i].centroid.x), cellOf(keys_[i].centroid.y))].push_back(i);
+    }
+  }
+}
+
+bool ShapeMatchIndex::polygonKey(const std::vector<Point2D>& polygon, Key& key) {
+  size_t n = polygon.size();
+  if (n > 3 && distance(polygon.front(), polygon.back()) < 1e-10) {
+    --n;
+  }
+  if (n < 3) {
+    return false;
+  }
+
+  // Shoelace sums relative to the first vertex for precision far from the origin
+  const Point2D origin = polygon[0];
+  double area = 0.0;
+  double sx = 0.0;
+  double sy = 0.0;
+  ShapeBounds bounds{polygon[0], polygon[0]};
+  for (size_t i = 0; i < n; ++i) {
+    Point2D a = polygon[i] - origin;
+    Point2D b = polygon[(i + 1) % n] - origin;
+    double cross = a.x * b.y - b.x * a.y;
+    area += cross;
+    sx += (a.x + b.x) * cross;
+    sy += (a.y + b.y) * cross;
+    bounds.min = Point2D(std::min(bounds.min.x, polygon[i].x), std::min(bounds.min.y, polygon[i].y));
+    bounds.max = Point2D(std::max(bounds.max.x, polygon[i].x), std::max(bounds.max.y, polygon[i].y));
+  }
+  area /= 2.0;
+  if (!(std::abs(area) > 0.0)) {
+    return false;
+  }
+
+  key.centroid = Point2D(sx / (6.0 * area), sy / (6.0 * area)) + origin;
+  key.area = std::abs(area);
+  key.bounds = bounds;
+  return true;
+}
+
+void ShapeMatchIndex::candidates(const Key& key, double tolerance, std::vector<size_t>& candidates) const {
+  candidates.clear();
+  if (cells_.empty() || !(key.area > 0.0)) {
+    return;
+  }
+
+  double slack = tolerance + POSITION_SLACK * diagonal(key.bounds);
+  std::vector<std::pair<double, size_t>> matches;
+  for (int64_t row = cellOf(key.centroid.y - slack); row <= cellOf(key.centroid.y + slack); ++row) {
+    for (int64_t column = cellOf(key.centroid.x - slack); column <= cellOf(key.centroid.x + slack); ++column) {
+      auto cell = cells_.find(cellKey(column, row));
+      if (cell == cells_.end()) {
+        continue;
+      }
+      for (size_t index : cell->second) {
+        const Key& other = keys_[index];
+        double offset = distance(other.centroid, key.centroid);
+        if (offset > slack || std::abs(other.area - key.area) > AREA_SLACK * std::max(other.area, key.area)) {
+          continue;
+        }
+        if (std::abs(other.bounds.min.x - key.bounds.min.x) > slack ||
+            std::abs(other.bounds.min.y - key.bounds.min.y) > slack ||
+            std::abs(other.bounds.max.x - key.bounds.max.x) > slack ||
+            std::abs(other.bounds.max.y - key.bounds.max.y) > slack) {
+          continue;
+        }
+        matches.emplace_back(offset, index);
+      }
+    }
+  }
+
+  std::sort(matches.begin(), matches.end());
+  for (const auto& match : matches) {
+    candidates.push_back(match.second);
+  }
+}
+
+int64_t ShapeMatchIndex::cellOf(double value) const {
+  return static_cast<int64_t>(std::floor(value / cellSize_));
+}
+
+uint64_t ShapeMatchIndex::cellKey(int64_t column, int64_t row) {
+  return (static_cast<uint64_t>(column) << 32) ^ (static_cast<uint64_t>(row) & 0xffffffffu);
+}
+
+}  // namespace Geometry
+}  // namespace ChipCarving
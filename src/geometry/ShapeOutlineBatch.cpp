@@ -0,0 +1,80 @@
+/**
+ * ShapeOutlineBatch.cpp
+ *
+ * Vertex merging for batched design outlines
+ */
+
+#include "geometry/ShapeOutlineBatch.h"
+
+#include <cmath>
+
+namespace ChipCarving {
+namespace Geometry {
+
+namespace {
+
+uint64_t cellKey(int64_t x, int64_t y) {
+  // Large odd multipliers spread neighbouring cells across buckets
+  uint64_t h = static_cast<uint64_t>(x) * 0x9E3779B97F4A7C15ULL;
+  h ^= static_cast<uint64_t>(y) * 0xC2B2AE3D27D4EB4FULL + (h << 6) + (h >> 2);
+  return h;
+}
+
+}  // namespace
+
+constexpr double ShapeOutlineBatch::DEFAULT_MERGE_TOLERANCE;
+
+ShapeOutlineBatch::ShapeOutlineBatch(double mergeTolerance)
+    : tolerance_(mergeTolerance), inverseCell_(1.0 / mergeTolerance) {}
+
+bool ShapeOutlineBatch::addShape(const Shape& shape, const std::string& tag) {
+  std::vector<ShapeEdge> boundary = shape.getBoundaryEdges();
+  if (boundary.empty()) {
+    return false;
+  }
+  size_t tagIndex = 0;
+  if (!tag.empty()) {
+    if (tags_.back() != tag) {
+      tags_.push_back(tag);
+    }
+    tagIndex = tags_.size() - 1;
+  }
+  for (const auto& edge : boundary) {
+    OutlineEdge outline;
+    outline.start = vertexIndex(edge.start);
+    outline.end = vertexIndex(edge.end);
+    outline.isArc = edge.isArc;
+    outline.mid = edge.mid;
+    outline.tag = tagIndex;
+    edges_.push_back(outline);
+  }
+  return true;
+}
+
+size_t ShapeOutlineBatch::vertexIndex(const Point2D& point) {
+  int64_t cx = static_cast<int64_t>(std::floor(point.x * inverseCell_));
+  int64_t cy = static_cast<int64_t>(std::floor(point.y * inverseCell_));
+  double toleranceSq = tolerance_ * tolerance_;
+  for (int64_t dx = -1; dx <= 1; ++dx) {
+    for (int64_t dy = -1; dy <= 1; ++dy) {
+      auto bucket = cells_.find(cellKey(cx + dx, cy + dy));
+      if (bucket == cells_.end()) {
+        continue;
+      }
+      for (size_t index : bucket->second) {
+        double ex = vertices_[index].x - point.x;
+        double ey = vertices_[index].y - point.y;
+        if (ex * ex + ey * ey <= toleranceSq) {
+          ++sharedVertices_;
+          return index;
+        }
+      }
+    }
+  }
+  cells_[cellKey(cx, cy)].push_back(vertices_.size());
+  vertices_.push_back(point);
+  return vertices_.size() - 1;
+}
+
+}  // namespace Geometry
+}  // namespace ChipCarving
@@ -0,0 +1,84 @@
+/**
+ * ShapePolygonizer.cpp
+ *
+ * Arc sampling for Leaf and TriArc polygons
+ */
+
+#include "geometry/ShapePolygonizer.h"
+
+#include <algorithm>
+#include <cmath>
+
+namespace ChipCarving {
+namespace Geometry {
+
+namespace {
+
+const int MIN_ARC_SEGMENTS = 2;
+const int MAX_ARC_SEGMENTS = 512;
+
+// Sample the short arc from start to end around center, excluding the end point
+void appendArc(std::vector<Point2D>& polygon, const Point2D& center, double radius, const Point2D& start,
+               const Point2D& end, double maxError) {
+  double startAngle = std::atan2(start.y - center.y, start.x - center.x);
+  double endAngle = std::atan2(end.y - center.y, end.x - center.x);
+  double sweep = endAngle - startAngle;
+  while (sweep > M_PI) sweep -= 2 * M_PI;
+  while (sweep < -M_PI) sweep += 2 * M_PI;
+
+  int steps = arcSegmentCount(radius, std::abs(sweep), maxError);
+  polygon.push_back(start);
+  for (int i = 1; i < steps; ++i) {
+    double angle = startAngle + sweep * i / steps;
+    polygon.emplace_back(center.x + radius * std::cos(angle), center.y + radius * std::sin(angle));
+  }
+}
+
+}  // namespace
+
+int arcSegmentCount(double radius, double sweep, double maxError) {
+  if (radius <= 0.0 || maxError <= 0.0 || maxError >= radius) {
+    return MIN_ARC_SEGMENTS;
+  }
+
+  // A chord spanning angle a deviates from its arc by r * (1 - cos(a / 2))
+  double maxStep = 2.0 * std::acos(1.0 - maxError / radius);
+  int steps = static_cast<int>(std::ceil(sweep / maxStep));
+  return std::max(MIN_ARC_SEGMENTS, std::min(MAX_ARC_SEGMENTS, steps));
+}
+
+std::vector<Point2D> polygonizeLeaf(const Leaf& leaf, double maxError) {
+  auto centers = leaf.getArcCenters();
+  std::vector<Point2D> polygon;
+  appendArc(polygon, centers.first, leaf.getRadius(), leaf.getFocus1(), leaf.getFocus2(), maxError);
+  appendArc(polygon, centers.second, leaf.getRadius(), leaf.getFocus2(), leaf.getFocus1(), maxError);
+  return polygon;
+}
+
+std::vector<Point2D> polygonizeTriArc(const TriArc& triArc, double maxError) {
+  std::vector<Point2D> polygon;
+  for (int i = 0; i < 3; ++i) {
+    Point2D start = triArc.getVertex(i);
+    if (triArc.isEdgeStraight(i)) {
+      polygon.push_back(start);
+      continue;
+    }
+
+    ArcParams arc = triArc.getArcParameters(i);
+    appendArc(polygon, arc.center, arc.radius, start, triArc.getVertex((i + 1) % 3), maxError);
+  }
+  return polygon;
+}
+
+std::vector<Point2D> polygonizeShape(const Shape& shape, double maxError) {
+  if (const auto* leaf = dynamic_cast<const Leaf*>(&shape)) {
+    return polygonizeLeaf(*leaf, maxError);
+  }
+  if (const auto* triArc = dynamic_cast<const TriArc*>(&shape)) {
+    return polygonizeTriArc(*triArc, maxError);
+  }
+  return {};
+}
+
+}  // namespace Geometry
+}  // namespace ChipCarving
@@ -0,0 +1,64 @@
+/**
+ * ShapeStore.cpp
+ *
+ * Per-type shape arrays and their batch passes
+ */
+
+#include "geometry/ShapeStore.h"
+
+#include <algorithm>
+
+namespace ChipCarving {
+namespace Geometry {
+
+bool ShapeStore::add(const Shape& shape) {
+  if (const auto* leaf = dynamic_cast<const Leaf*>(&shape)) {
+    add(*leaf);
+    return true;
+  }
+  if (const auto* triArc = dynamic_cast<const TriArc*>(&shape)) {
+    add(*triArc);
+    return true;
+  }
+  return false;
+}
+
+void ShapeStore::add(const Leaf& leaf) {
+  handles_.push_back({ShapeKind::LEAF, static_cast<uint32_t>(leaves_.size())});
+  leafOrder_.push_back(handles_.size() - 1);
+  leaves_.push_back(leaf);
+}
+
+void ShapeStore::add(const TriArc& triArc) {
+  handles_.push_back({ShapeKind::TRI_ARC, static_cast<uint32_t>(triArcs_.size())});
+  triArcOrder_.push_back(handles_.size() - 1);
+  triArcs_.push_back(triArc);
+}
+
+void ShapeStore::clear() {
+  leaves_.clear();
+  triArcs_.clear();
+  leafOrder_.clear();
+  triArcOrder_.clear();
+  handles_.clear();
+}
+
+ShapeBounds ShapeStore::bounds() const {
+  ShapeBounds box;
+  bool first = true;
+  forEachByType([&](const auto& shape, size_t) {
+    ShapeBounds b = shape.getBounds();
+    box.min = first ? b.min : Point2D(std::min(box.min.x, b.min.x), std::min(box.min.y, b.min.y));
+    box.max = first ? b.max : Point2D(std::max(box.max.x, b.max.x), std::max(box.max.y, b.max.y));
+    first = false;
+  });
+  return box;
+}
+
+size_t ShapeStore::vertexCount() const {
+  // A leaf is defined by its two foci, a tri-arc by its three corners
+  return 2 * leaves_.size() + 3 * triArcs_.size();
+}
+
+}  // namespace Geometry
+}  // namespace ChipCarving
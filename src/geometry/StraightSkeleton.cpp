@@ -0,0 +1,149 @@
+/**
+ * StraightSkeleton.cpp
+ *
+ * Straight skeleton chains of polygonal profiles: corner filtering, the unit
+ * circle transform and the walk from wavefront arcs to medial chains
+ */
+
+#include "geometry/StraightSkeleton.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+#include "StraightSkeletonWavefront.h"
+#include "geometry/PointKernels.h"
+#include "utils/TraceSpan.h"
+
+namespace ChipCarving {
+namespace Geometry {
+
+namespace {
+
+constexpr double EPSILON = SKELETON_EPSILON;
+constexpr double COLLINEAR_TURN = 1e-4;  // Radians; smaller turns are redundant vertices
+constexpr size_t NO_ARC = std::numeric_limits<size_t>::max();
+
+// Polygon without its closing duplicate and collinear vertices; empty if an edge has no length
+std::vector<Point2D> cornerVertices(const std::vector<Point2D>& polygon) {
+  std::vector<Point2D> loop(polygon);
+  if (loop.size() > 1 && distance(loop.front(), loop.back()) < EPSILON) {
+    loop.pop_back();
+  }
+  std::vector<Point2D> corners;
+  for (size_t i = 0; i < loop.size(); ++i) {
+    const Point2D& previous = loop[(i + loop.size() - 1) % loop.size()];
+    const Point2D& next = loop[(i + 1) % loop.size()];
+    Point2D in = loop[i] - previous;
+    Point2D out = next - loop[i];
+    if (std::hypot(in.x, in.y) < EPSILON || std::hypot(out.x, out.y) < EPSILON) {
+      return {};
+    }
+    if (std::abs(std::atan2(skeletonCross(in, out), skeletonDot(in, out))) >= COLLINEAR_TURN) {
+      corners.push_back(loop[i]);
+    }
+  }
+  return corners;
+}
+
+}  // namespace
+
+bool polygonHasOnlyStraightEdges(const std::vector<Point2D>& polygon, double minTurn) {
+  std::vector<Point2D> corners = cornerVertices(polygon);
+  if (corners.size() < 3) {
+    return false;
+  }
+  for (size_t i = 0; i < corners.size(); ++i) {
+    Point2D in = corners[i] - corners[(i + corners.size() - 1) % corners.size()];
+    Point2D out = corners[(i + 1) % corners.size()] - corners[i];
+    if (std::abs(std::atan2(skeletonCross(in, out), skeletonDot(in, out))) < minTurn) {
+      return false;
+    }
+  }
+  return true;
+}
+
+bool computeStraightSkeleton(const std::vector<Point2D>& polygon, MedialAxisResults& results) {
+  Utils::TraceSpan span("straightSkeleton");
+  results = MedialAxisResults();
+  std::vector<Point2D> corners = cornerVertices(polygon);
+  if (corners.size() < 3) {
+    results.errorMessage = "Polygon needs at least 3 corners and no zero-length edges for a straight skeleton";
+    return false;
+  }
+
+  // Unit circle coordinates, counter-clockwise
+  fitUnitCircleTransform(corners, results.transform);
+  const TransformParams& transform = results.transform;
+  double area = 0.0;
+  transformPoints(corners.data(), corners.size(), transform.offset, transform.scale, corners.data());
+  for (size_t i = 0; i < corners.size(); ++i) {
+    area += skeletonCross(corners[i], corners[(i + 1) % corners.size()]);
+  }
+  if (std::abs(area) < EPSILON) {
+    results.errorMessage = "Polygon has no area";
+    return false;
+  }
+  if (area < 0.0) {
+    std::reverse(corners.begin(), corners.end());
+  }
+
+  Wavefront wavefront(corners);
+  if (!wavefront.run(4 * corners.size() + 16)) {
+    results.errorMessage = "Straight skeleton wavefront did not collapse";
+    return false;
+  }
+
+  // Chains run between nodes that are not plain chain nodes; the skeleton is a tree
+  const std::vector<Point2D>& nodes = wavefront.nodes();
+  const auto& arcs = wavefront.arcs();
+  std::vector<std::vector<size_t>> incident(nodes.size());
+  for (size_t a = 0; a < arcs.size(); ++a) {
+    incident[arcs[a].first].push_back(a);
+    incident[arcs[a].second].push_back(a);
+  }
+  std::vector<bool> walked(arcs.size(), false);
+  results.minClearance = std::numeric_limits<double>::max();
+  auto addPoint = [&](size_t node, bool first) {
+    Point2D point = nodes[node] * (1.0 / transform.scale) + transform.offset;
+    double clearance = wavefront.times()[node] / transform.scale;
+    if (!first) {
+      results.totalLength += distance(results.chains.back().back(), point);
+    }
+    results.chains.addPoint(point, clearance);
+    results.totalPoints++;
+    results.minClearance = std::min(results.minClearance, clearance);
+    results.maxClearance = std::max(results.maxClearance, clearance);
+  };
+  for (size_t start = 0; start < nodes.size(); ++start) {
+    for (size_t arc : incident[start]) {
+      if (incident[start].size() == 2 || walked[arc]) {
+        continue;
+      }
+      results.chains.beginChain();
+      results.numChains++;
+      addPoint(start, true);
+      size_t node = start;
+      while (arc != NO_ARC) {
+        walked[arc] = true;
+        node = arcs[arc].first == node ? arcs[arc].second : arcs[arc].first;
+        addPoint(node, false);
+        size_t next = NO_ARC;
+        if (incident[node].size() == 2) {
+          next = incident[node][0] == arc ? incident[node][1] : incident[node][0];
+        }
+        arc = next != NO_ARC && !walked[next] ? next : NO_ARC;
+      }
+    }
+  }
+  if (results.chains.empty()) {
+    results.errorMessage = "Straight skeleton has no arcs";
+    return false;
+  }
+  results.graph = MedialAxisGraph::fromChains(results.chains);
+  results.success = true;
+  return true;
+}
+
+}  // namespace Geometry
+}  // namespace ChipCarving
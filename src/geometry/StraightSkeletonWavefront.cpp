@@ -0,0 +1,203 @@
+/**
+ * StraightSkeletonWavefront.cpp
+ *
+ * Edge and split events of the straight skeleton wavefront
+ * Split from StraightSkeleton.cpp for maintainability
+ */
+
+#include "StraightSkeletonWavefront.h"
+
+#include <algorithm>
+#include <cmath>
+
+namespace ChipCarving {
+namespace Geometry {
+
+Wavefront::Wavefront(const std::vector<Point2D>& polygon) {
+  size_t n = polygon.size();
+  for (size_t i = 0; i < n; ++i) {
+    Point2D edge = polygon[(i + 1) % n] - polygon[i];
+    Point2D direction = edge * (1.0 / std::hypot(edge.x, edge.y));
+    directions_.push_back(direction);
+    normals_.push_back(Point2D(-direction.y, direction.x));  // Inward for counter-clockwise
+    offsets_.push_back(skeletonDot(normals_.back(), polygon[i]));
+    addNode(polygon[i]);
+  }
+  for (size_t i = 0; i < n; ++i) {
+    vertices_.push_back(makeVertex(polygon[i], (i + n - 1) % n, i, i, (i + n - 1) % n, (i + 1) % n));
+  }
+}
+
+bool Wavefront::run(size_t maxEvents) {
+  for (size_t events = 0; events < maxEvents; ++events) {
+    size_t vertex = NO_VERTEX;
+    size_t splitEdgeOwner = NO_VERTEX;
+    double step = std::numeric_limits<double>::max();
+    findNextEvent(vertex, splitEdgeOwner, step);
+    if (vertex == NO_VERTEX) {
+      return std::none_of(vertices_.begin(), vertices_.end(), [](const WavefrontVertex& v) { return v.active; });
+    }
+    for (auto& v : vertices_) {
+      if (v.active) {
+        v.position = v.position + v.velocity * step;
+      }
+    }
+    time_ += step;
+    if (splitEdgeOwner == NO_VERTEX) {
+      edgeEvent(vertex);
+    } else {
+      splitEvent(vertex, splitEdgeOwner);
+    }
+  }
+  return false;
+}
+
+void Wavefront::findNextEvent(size_t& vertex, size_t& splitEdgeOwner, double& step) const {
+  for (size_t i = 0; i < vertices_.size(); ++i) {
+    const WavefrontVertex& v = vertices_[i];
+    if (!v.active) {
+      continue;
+    }
+    // Edge event: v and its successor meet, shrinking their shared edge to nothing
+    const WavefrontVertex& w = vertices_[v.next];
+    const Point2D& direction = directions_[v.outEdge];
+    double rate = skeletonDot(direction, w.velocity - v.velocity);
+    double collapse = step;
+    if (v.collapsing) {
+      collapse = 0.0;
+    } else if (rate < -SKELETON_EPSILON) {
+      collapse = -skeletonDot(direction, w.position - v.position) / rate;
+    }
+    if (collapse < step) {
+      vertex = i;
+      splitEdgeOwner = NO_VERTEX;
+      step = std::max(0.0, collapse);
+    }
+    if (!v.reflex) {
+      continue;
+    }
+    // Split event: a reflex vertex runs into an edge of its own wavefront
+    for (size_t a = v.next; vertices_[a].next != i; a = vertices_[a].next) {
+      const WavefrontVertex& start = vertices_[a];
+      const WavefrontVertex& end = vertices_[start.next];
+      size_t edge = start.outEdge;
+      if (edge == v.inEdge || edge == v.outEdge) {
+        continue;
+      }
+      double closing = skeletonDot(normals_[edge], v.velocity) - 1.0;
+      if (closing > -SKELETON_EPSILON) {
+        continue;
+      }
+      double hit = (offsets_[edge] + time_ - skeletonDot(normals_[edge], v.position)) / closing;
+      if (hit < -SKELETON_EPSILON || hit >= step - SKELETON_EPSILON) {
+        continue;
+      }
+      hit = std::max(0.0, hit);
+      Point2D point = v.position + v.velocity * hit;
+      Point2D edgeStart = start.position + start.velocity * hit;
+      double along = skeletonDot(directions_[edge], point - edgeStart);
+      double length = skeletonDot(directions_[edge], end.position + end.velocity * hit - edgeStart);
+      if (along > SKELETON_EPSILON && along < length - SKELETON_EPSILON) {
+        vertex = i;
+        splitEdgeOwner = a;
+        step = hit;
+      }
+    }
+  }
+}
+
+void Wavefront::edgeEvent(size_t index) {
+  WavefrontVertex v = vertices_[index];
+  WavefrontVertex w = vertices_[v.next];
+  size_t node = addNode(v.collapsing ? w.position : (v.position + w.position) * 0.5);
+  addArc(v.node, node);
+  addArc(w.node, node);
+  vertices_[index].active = false;
+  vertices_[v.next].active = false;
+  if (w.next == v.previous) {
+    // The last triangle of this wavefront closes on one point
+    addArc(vertices_[w.next].node, node);
+    vertices_[w.next].active = false;
+    return;
+  }
+  insertVertex(makeVertex(nodes_[node], v.inEdge, w.outEdge, node, v.previous, w.next));
+}
+
+void Wavefront::splitEvent(size_t index, size_t owner) {
+  WavefrontVertex v = vertices_[index];
+  size_t edge = vertices_[owner].outEdge;
+  size_t ownerNext = vertices_[owner].next;
+  size_t node = addNode(v.position);
+  addArc(v.node, node);
+  vertices_[index].active = false;
+  // One wavefront continues from the hit edge's start, the other towards its end
+  size_t first = insertVertex(makeVertex(v.position, edge, v.outEdge, node, owner, v.next));
+  size_t second = insertVertex(makeVertex(v.position, v.inEdge, edge, node, v.previous, ownerNext));
+  closeIfDegenerate(first);
+  closeIfDegenerate(second);
+}
+
+void Wavefront::closeIfDegenerate(size_t index) {
+  WavefrontVertex& u = vertices_[index];
+  WavefrontVertex& other = vertices_[u.next];
+  if (u.active && other.next == index) {
+    size_t end = addNode(other.position);
+    addArc(u.node, end);
+    addArc(other.node, end);
+    u.active = false;
+    other.active = false;
+  }
+}
+
+WavefrontVertex Wavefront::makeVertex(const Point2D& position, size_t inEdge, size_t outEdge, size_t node,
+                                      size_t previous, size_t next) const {
+  WavefrontVertex vertex;
+  vertex.position = position;
+  vertex.inEdge = inEdge;
+  vertex.outEdge = outEdge;
+  vertex.node = node;
+  vertex.previous = previous;
+  vertex.next = next;
+  const Point2D& a = normals_[inEdge];
+  const Point2D& b = normals_[outEdge];
+  double determinant = skeletonCross(a, b);
+  vertex.reflex = skeletonCross(directions_[inEdge], directions_[outEdge]) < -SKELETON_EPSILON;
+  if (std::abs(determinant) > SKELETON_EPSILON) {
+    // Moves so that both edge lines advance at unit speed
+    vertex.velocity = Point2D((b.y - a.y) / determinant, (a.x - b.x) / determinant);
+  } else if (skeletonDot(a, b) > 0.0) {
+    vertex.velocity = a;
+  } else {
+    vertex.collapsing = true;
+    vertex.reflex = false;
+  }
+  return vertex;
+}
+
+size_t Wavefront::insertVertex(const WavefrontVertex& vertex) {
+  size_t index = vertices_.size();
+  vertices_.push_back(vertex);
+  vertices_[vertex.previous].next = index;
+  vertices_[vertex.next].previous = index;
+  return index;
+}
+
+size_t Wavefront::addNode(const Point2D& point) {
+  for (size_t i = nodes_.size(); i > 0 && times_[i - 1] > time_ - SKELETON_EPSILON; --i) {
+    if (distance(nodes_[i - 1], point) < 10.0 * SKELETON_EPSILON) {
+      return i - 1;
+    }
+  }
+  nodes_.push_back(point);
+  times_.push_back(time_);
+  return nodes_.size() - 1;
+}
+
+void Wavefront::addArc(size_t from, size_t to) {
+  if (from != to) {
+    arcs_.emplace_back(from, to);
+  }
+}
+
+}  // namespace Geometry
+}  // namespace ChipCarving
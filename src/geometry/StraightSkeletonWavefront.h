@@ -0,0 +1,91 @@
+/**
+ * StraightSkeletonWavefront.h
+ *
+ * Shrinking wavefront behind the straight skeleton
+ * Split from StraightSkeleton.cpp for maintainability
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <limits>
+#include <utility>
+#include <vector>
+
+#include "geometry/Point2D.h"
+
+namespace ChipCarving {
+namespace Geometry {
+
+constexpr double SKELETON_EPSILON = 1e-9;  // Unit circle lengths and times
+
+inline double skeletonCross(const Point2D& a, const Point2D& b) {
+  return a.x * b.y - a.y * b.x;
+}
+inline double skeletonDot(const Point2D& a, const Point2D& b) {
+  return a.x * b.x + a.y * b.y;
+}
+
+struct WavefrontVertex {
+  Point2D position{};  // At the current time
+  Point2D velocity{};
+  size_t inEdge = 0;   // Polygon edges meeting here
+  size_t outEdge = 0;
+  size_t node = 0;     // Skeleton node the vertex set out from
+  size_t previous = 0;
+  size_t next = 0;
+  bool reflex = false;
+  bool collapsing = false;  // Its edges run back along each other, so it sweeps its next edge at once
+  bool active = true;
+};
+
+// Edge and split events of a counter-clockwise polygon in unit circle coordinates
+class Wavefront {
+ public:
+  explicit Wavefront(const std::vector<Point2D>& polygon);
+
+  // Run until every wavefront has collapsed; false on a configuration left unresolved
+  bool run(size_t maxEvents);
+
+  // Skeleton nodes, the time the wavefront reached each, and the arcs between them
+  const std::vector<Point2D>& nodes() const {
+    return nodes_;
+  }
+  const std::vector<double>& times() const {
+    return times_;
+  }
+  const std::vector<std::pair<size_t, size_t>>& arcs() const {
+    return arcs_;
+  }
+
+ private:
+  static constexpr size_t NO_VERTEX = std::numeric_limits<size_t>::max();
+
+  void findNextEvent(size_t& vertex, size_t& splitEdgeOwner, double& step) const;
+  void edgeEvent(size_t index);
+  void splitEvent(size_t index, size_t owner);
+
+  // A wavefront of two vertices has no area left: both run to the other's current position
+  void closeIfDegenerate(size_t index);
+
+  // Vertex between inEdge and outEdge at the current time, to sit between previous and next
+  WavefrontVertex makeVertex(const Point2D& position, size_t inEdge, size_t outEdge, size_t node, size_t previous,
+                             size_t next) const;
+  size_t insertVertex(const WavefrontVertex& vertex);
+
+  // Node at point for the current time, reusing one placed by a simultaneous event
+  size_t addNode(const Point2D& point);
+  void addArc(size_t from, size_t to);
+
+  std::vector<Point2D> directions_{};
+  std::vector<Point2D> normals_{};
+  std::vector<double> offsets_{};  // Edge i's line is dot(normal, x) = offset + time
+  std::vector<WavefrontVertex> vertices_{};
+  std::vector<Point2D> nodes_{};
+  std::vector<double> times_{};
+  std::vector<std::pair<size_t, size_t>> arcs_{};
+  double time_ = 0.0;
+};
+
+}  // namespace Geometry
+}  // namespace ChipCarving
@@ -0,0 +1,98 @@
+/**
+ * SurfaceBoundsIndex.cpp
+ *
+ * Uniform XY grid of body bounding boxes for surface ray casting
+ */
+
+#include "geometry/SurfaceBoundsIndex.h"
+
+#include <algorithm>
+#include <cmath>
+#include <numeric>
+
+namespace ChipCarving {
+namespace Geometry {
+
+constexpr size_t SurfaceBoundsIndex::MAX_GRID_CELLS;
+
+namespace {
+
+// Cells per box on average; enough that a query touches few boxes it misses
+constexpr size_t CELLS_PER_BOX = 4;
+
+size_t axisCells(double extent, size_t cellsPerAxis) {
+  return extent > 0.0 ? cellsPerAxis : 1;
+}
+
+}  // namespace
+
+SurfaceBoundsIndex::SurfaceBoundsIndex(const std::vector<Box>& boxes, double margin) : boxes_(boxes) {
+  if (boxes_.empty()) {
+    return;
+  }
+
+  double maxX = boxes_[0].maxX + margin;
+  double maxY = boxes_[0].maxY + margin;
+  originX_ = boxes_[0].minX - margin;
+  originY_ = boxes_[0].minY - margin;
+  for (auto& box : boxes_) {
+    box.minX -= margin;
+    box.minY -= margin;
+    box.maxX += margin;
+    box.maxY += margin;
+    originX_ = std::min(originX_, box.minX);
+    originY_ = std::min(originY_, box.minY);
+    maxX = std::max(maxX, box.maxX);
+    maxY = std::max(maxY, box.maxY);
+  }
+
+  size_t cellBudget = std::min(boxes_.size() * CELLS_PER_BOX, MAX_GRID_CELLS);
+  size_t cellsPerAxis = std::max<size_t>(1, static_cast<size_t>(std::sqrt(static_cast<double>(cellBudget))));
+  columns_ = axisCells(maxX - originX_, cellsPerAxis);
+  rows_ = axisCells(maxY - originY_, cellsPerAxis);
+  cellWidth_ = columns_ > 1 ? (maxX - originX_) / columns_ : 1.0;
+  cellHeight_ = rows_ > 1 ? (maxY - originY_) / rows_ : 1.0;
+  cells_.assign(columns_ * rows_, {});
+
+  // Inserting tallest first leaves every cell list in descending maxZ order
+  std::vector<size_t> order(boxes_.size());
+  std::iota(order.begin(), order.end(), 0);
+  std::stable_sort(order.begin(), order.end(),
+                   [this](size_t a, size_t b) { return boxes_[a].maxZ > boxes_[b].maxZ; });
+
+  for (size_t id : order) {
+    const Box& box = boxes_[id];
+    size_t first = cellIndex(box.minX, box.minY);
+    size_t last = cellIndex(box.maxX, box.maxY);
+    for (size_t row = first / columns_; row <= last / columns_; ++row) {
+      for (size_t col = first % columns_; col <= last % columns_; ++col) {
+        cells_[row * columns_ + col].push_back(id);
+      }
+    }
+  }
+}
+
+size_t SurfaceBoundsIndex::cellIndex(double x, double y) const {
+  double gx = std::floor((x - originX_) / cellWidth_);
+  double gy = std::floor((y - originY_) / cellHeight_);
+  size_t col = static_cast<size_t>(std::min(std::max(gx, 0.0), static_cast<double>(columns_ - 1)));
+  size_t row = static_cast<size_t>(std::min(std::max(gy, 0.0), static_cast<double>(rows_ - 1)));
+  return row * columns_ + col;
+}
+
+void SurfaceBoundsIndex::candidates(double x, double y, std::vector<size_t>& candidates) const {
+  candidates.clear();
+  if (cells_.empty() || !std::isfinite(x) || !std::isfinite(y)) {
+    return;
+  }
+
+  for (size_t id : cells_[cellIndex(x, y)]) {
+    const Box& box = boxes_[id];
+    if (x >= box.minX && x <= box.maxX && y >= box.minY && y <= box.maxY) {
+      candidates.push_back(id);
+    }
+  }
+}
+
+}  // namespace Geometry
+}  // namespace ChipCarving
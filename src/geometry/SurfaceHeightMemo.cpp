@@ -0,0 +1,77 @@
+/**
+ * SurfaceHeightMemo.cpp
+ *
+ * Quantized XY memo table for surface Z queries
+ */
+
+#include "geometry/SurfaceHeightMemo.h"
+
+#include <cmath>
+#include <limits>
+
+namespace ChipCarving {
+namespace Geometry {
+
+constexpr double SurfaceHeightMemo::DEFAULT_QUANTUM;
+
+SurfaceHeightMemo::SurfaceHeightMemo(double quantum)
+    : inverseQuantum_(quantum > 0.0 ? 1.0 / quantum : 1.0 / DEFAULT_QUANTUM) {}
+
+SurfaceHeightMemo::Key SurfaceHeightMemo::keyOf(const Point2D& point) const {
+  return Key{static_cast<int64_t>(std::llround(point.x * inverseQuantum_)),
+             static_cast<int64_t>(std::llround(point.y * inverseQuantum_))};
+}
+
+bool SurfaceHeightMemo::lookup(const Point2D& point, double& z) const {
+  auto found = heights_.find(keyOf(point));
+  if (found == heights_.end()) {
+    return false;
+  }
+  z = found->second;
+  ++hits_;
+  return true;
+}
+
+void SurfaceHeightMemo::store(const Point2D& point, double z) {
+  heights_[keyOf(point)] = z;
+}
+
+std::vector<double> SurfaceHeightMemo::resolve(
+    const std::vector<Point2D>& points, const std::function<std::vector<double>(const std::vector<Point2D>&)>& query) {
+  const size_t NOT_QUERIED = std::numeric_limits<size_t>::max();
+  std::vector<double> heights(points.size(), std::numeric_limits<double>::quiet_NaN());
+  std::vector<size_t> queryIndex(points.size(), NOT_QUERIED);
+  std::vector<Point2D> unseen;
+  std::unordered_map<Key, size_t, KeyHash> unseenCells;
+
+  for (size_t i = 0; i < points.size(); ++i) {
+    if (lookup(points[i], heights[i])) {
+      continue;
+    }
+    auto inserted = unseenCells.emplace(keyOf(points[i]), unseen.size());
+    if (inserted.second) {
+      unseen.push_back(points[i]);
+    } else {
+      ++hits_;
+    }
+    queryIndex[i] = inserted.first->second;
+  }
+  if (unseen.empty()) {
+    return heights;
+  }
+
+  std::vector<double> found = query(unseen);
+  found.resize(unseen.size(), std::numeric_limits<double>::quiet_NaN());
+  for (size_t k = 0; k < unseen.size(); ++k) {
+    store(unseen[k], found[k]);
+  }
+  for (size_t i = 0; i < points.size(); ++i) {
+    if (queryIndex[i] != NOT_QUERIED) {
+      heights[i] = found[queryIndex[i]];
+    }
+  }
+  return heights;
+}
+
+}  // namespace Geometry
+}  // namespace ChipCarving
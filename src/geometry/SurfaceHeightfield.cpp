@@ -0,0 +1,126 @@
+/**
+ * SurfaceHeightfield.cpp
+ *
+ * Regular XY height grid with bilinear interpolation
+ */
+
+#include "geometry/SurfaceHeightfield.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <utility>
+
+namespace ChipCarving {
+namespace Geometry {
+
+constexpr size_t SurfaceHeightfield::MAX_GRID_NODES;
+
+SurfaceHeightfield::SurfaceHeightfield(const Point2D& minCorner, const Point2D& maxCorner, double spacing)
+    : origin_(minCorner) {
+  double width = std::max(maxCorner.x - minCorner.x, 0.0);
+  double height = std::max(maxCorner.y - minCorner.y, 0.0);
+  if (!(spacing > 0.0) || !std::isfinite(width) || !std::isfinite(height)) {
+    return;
+  }
+
+  // Grow the spacing until the node count fits the budget
+  spacing_ = spacing;
+  for (;;) {
+    columns_ = static_cast<size_t>(std::ceil(width / spacing_)) + 1;
+    rows_ = static_cast<size_t>(std::ceil(height / spacing_)) + 1;
+    if (columns_ * rows_ <= MAX_GRID_NODES) {
+      break;
+    }
+    spacing_ *= std::sqrt(static_cast<double>(columns_ * rows_) / MAX_GRID_NODES) * 1.01;
+  }
+}
+
+SurfaceHeightfield::SurfaceHeightfield(const Point2D& origin, double spacing, size_t columns, size_t rows)
+    : origin_(origin) {
+  if (spacing > 0.0 && columns > 0 && rows > 0) {
+    spacing_ = spacing;
+    columns_ = columns;
+    rows_ = rows;
+  }
+}
+
+std::vector<Point2D> SurfaceHeightfield::getNodePositions() const {
+  std::vector<Point2D> positions;
+  positions.reserve(columns_ * rows_);
+  for (size_t row = 0; row < rows_; ++row) {
+    for (size_t col = 0; col < columns_; ++col) {
+      positions.emplace_back(origin_.x + col * spacing_, origin_.y + row * spacing_);
+    }
+  }
+  return positions;
+}
+
+bool SurfaceHeightfield::setHeights(std::vector<double> heights) {
+  if (columns_ == 0 || rows_ == 0 || heights.size() != columns_ * rows_) {
+    return false;
+  }
+  heights_ = std::move(heights);
+  return true;
+}
+
+double SurfaceHeightfield::sample(double x, double y) const {
+  double dzdx = 0.0;
+  double dzdy = 0.0;
+  return sample(x, y, dzdx, dzdy);
+}
+
+double SurfaceHeightfield::sample(double x, double y, double& dzdx, double& dzdy) const {
+  dzdx = std::numeric_limits<double>::quiet_NaN();
+  dzdy = std::numeric_limits<double>::quiet_NaN();
+  if (!isValid()) {
+    return std::numeric_limits<double>::quiet_NaN();
+  }
+
+  double gx = (x - origin_.x) / spacing_;
+  double gy = (y - origin_.y) / spacing_;
+
+  // Allow points a hair outside the grid due to floating point round-off
+  const double EDGE_SLACK = 1e-9;
+  double maxX = static_cast<double>(columns_ - 1);
+  double maxY = static_cast<double>(rows_ - 1);
+  if (!(gx >= -EDGE_SLACK && gx <= maxX + EDGE_SLACK && gy >= -EDGE_SLACK && gy <= maxY + EDGE_SLACK)) {
+    return std::numeric_limits<double>::quiet_NaN();
+  }
+  gx = std::min(std::max(gx, 0.0), maxX);
+  gy = std::min(std::max(gy, 0.0), maxY);
+
+  // Degenerate (single row/column) grids interpolate along the remaining axis
+  size_t col = std::min(static_cast<size_t>(gx), columns_ > 1 ? columns_ - 2 : 0);
+  size_t row = std::min(static_cast<size_t>(gy), rows_ > 1 ? rows_ - 2 : 0);
+  size_t nextCol = columns_ > 1 ? col + 1 : col;
+  size_t nextRow = rows_ > 1 ? row + 1 : row;
+  double fx = gx - col;
+  double fy = gy - row;
+
+  double z00 = heights_[row * columns_ + col];
+  double z10 = heights_[row * columns_ + nextCol];
+  double z01 = heights_[nextRow * columns_ + col];
+  double z11 = heights_[nextRow * columns_ + nextCol];
+
+  // NaN corners propagate through the arithmetic
+  double bottom = z00 + (z10 - z00) * fx;
+  double top = z01 + (z11 - z01) * fx;
+  double z = bottom + (top - bottom) * fy;
+  if (std::isnan(z)) {
+    return z;
+  }
+
+  // Derivatives of the bilinear patch; a degenerate axis has no slope
+  dzdx = ((z10 - z00) * (1.0 - fy) + (z11 - z01) * fy) / spacing_;
+  dzdy = (top - bottom) / spacing_;
+  return z;
+}
+
+double slopeDepthScale(double dzdx, double dzdy) {
+  double scale = std::sqrt(1.0 + dzdx * dzdx + dzdy * dzdy);
+  return std::isnan(scale) ? 1.0 : std::min(scale, MAX_SLOPE_DEPTH_SCALE);
+}
+
+}  // namespace Geometry
+}  // namespace ChipCarving
@@ -0,0 +1,251 @@
+/**
+ * SurfaceMeshBVH.cpp
+ *
+ * Binned SAH build and downward ray queries over a triangle mesh
+ */
+
+#include "geometry/SurfaceMeshBVH.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <limits>
+#include <thread>
+
+namespace ChipCarving {
+namespace Geometry {
+
+namespace {
+
+constexpr double EDGE_TOLERANCE = 1e-12;  // Barycentric slack so rays on a shared edge hit one of its triangles
+constexpr size_t QUERY_CHUNK = 256;        // Points a worker takes at a time
+
+struct Bounds {
+  double minX = std::numeric_limits<double>::max();
+  double minY = std::numeric_limits<double>::max();
+  double maxX = std::numeric_limits<double>::lowest();
+  double maxY = std::numeric_limits<double>::lowest();
+
+  void grow(double x, double y) {
+    minX = std::min(minX, x);
+    minY = std::min(minY, y);
+    maxX = std::max(maxX, x);
+    maxY = std::max(maxY, y);
+  }
+  void grow(const Bounds& other) {
+    grow(other.minX, other.minY);
+    grow(other.maxX, other.maxY);
+  }
+  // Chance weight of a vertical ray; empty bounds weigh nothing
+  double area() const {
+    return maxX < minX ? 0.0 : (maxX - minX) * (maxY - minY);
+  }
+};
+
+}  // namespace
+
+SurfaceMeshBVH::SurfaceMeshBVH(const std::vector<double>& coords, const std::vector<int>& indices) {
+  size_t nodeCount = coords.size() / 3;
+  for (size_t t = 0; t + 2 < indices.size(); t += 3) {
+    const int* corner = &indices[t];
+    if (std::any_of(corner, corner + 3, [nodeCount](int i) { return i < 0 || static_cast<size_t>(i) >= nodeCount; })) {
+      continue;
+    }
+    const double* a = &coords[static_cast<size_t>(corner[0]) * 3];
+    const double* b = &coords[static_cast<size_t>(corner[1]) * 3];
+    const double* c = &coords[static_cast<size_t>(corner[2]) * 3];
+    Triangle triangle{a[0], a[1], a[2], b[0], b[1], b[2], c[0], c[1], c[2]};
+    double area = (b[0] - a[0]) * (c[1] - a[1]) - (c[0] - a[0]) * (b[1] - a[1]);
+    if (std::isfinite(area) && std::isfinite(a[2] + b[2] + c[2]) && std::abs(area) > EDGE_TOLERANCE) {
+      triangles_.push_back(triangle);
+    }
+  }
+  if (triangles_.empty()) {
+    return;
+  }
+
+  std::vector<double> centroids(triangles_.size() * 2);
+  for (size_t i = 0; i < triangles_.size(); ++i) {
+    const Triangle& t = triangles_[i];
+    centroids[2 * i] = (t.ax + t.bx + t.cx) / 3.0;
+    centroids[2 * i + 1] = (t.ay + t.by + t.cy) / 3.0;
+  }
+  nodes_.reserve(2 * triangles_.size() / MAX_LEAF_TRIANGLES + 1);
+  build(centroids, 0, triangles_.size());
+}
+
+uint32_t SurfaceMeshBVH::build(std::vector<double>& centroids, size_t begin, size_t end) {
+  uint32_t index = static_cast<uint32_t>(nodes_.size());
+  nodes_.push_back(Node{});
+  Bounds bounds;
+  Bounds centroidBounds;
+  double maxZ = std::numeric_limits<double>::lowest();
+  for (size_t i = begin; i < end; ++i) {
+    const Triangle& t = triangles_[i];
+    bounds.grow(std::min({t.ax, t.bx, t.cx}), std::min({t.ay, t.by, t.cy}));
+    bounds.grow(std::max({t.ax, t.bx, t.cx}), std::max({t.ay, t.by, t.cy}));
+    centroidBounds.grow(centroids[2 * i], centroids[2 * i + 1]);
+    maxZ = std::max({maxZ, t.az, t.bz, t.cz});
+  }
+  nodes_[index] = Node{bounds.minX, bounds.minY, bounds.maxX, bounds.maxY, maxZ, static_cast<uint32_t>(begin),
+                       static_cast<uint32_t>(end - begin)};
+  size_t count = end - begin;
+  if (count <= MAX_LEAF_TRIANGLES) {
+    return index;
+  }
+
+  // Binned SAH along X and Y; a split must beat testing every triangle here
+  double bestCost = static_cast<double>(count) * bounds.area();
+  int bestAxis = -1;
+  double bestPlane = 0.0;
+  for (int axis = 0; axis < 2; ++axis) {
+    double low = axis == 0 ? centroidBounds.minX : centroidBounds.minY;
+    double high = axis == 0 ? centroidBounds.maxX : centroidBounds.maxY;
+    if (high - low <= 0.0) {
+      continue;
+    }
+    Bounds bins[SAH_BINS];
+    size_t binCounts[SAH_BINS] = {};
+    double scale = SAH_BINS / (high - low);
+    for (size_t i = begin; i < end; ++i) {
+      int bin = std::min(SAH_BINS - 1, static_cast<int>((centroids[2 * i + axis] - low) * scale));
+      const Triangle& t = triangles_[i];
+      bins[bin].grow(std::min({t.ax, t.bx, t.cx}), std::min({t.ay, t.by, t.cy}));
+      bins[bin].grow(std::max({t.ax, t.bx, t.cx}), std::max({t.ay, t.by, t.cy}));
+      binCounts[bin]++;
+    }
+    // Costs of splitting after each bin, from running bounds in both directions
+    double rightCost[SAH_BINS] = {};
+    Bounds right;
+    size_t rightCount = 0;
+    for (int b = SAH_BINS - 1; b > 0; --b) {
+      right.grow(bins[b]);
+      rightCount += binCounts[b];
+      rightCost[b] = static_cast<double>(rightCount) * right.area();
+    }
+    Bounds left;
+    size_t leftCount = 0;
+    for (int b = 0; b + 1 < SAH_BINS; ++b) {
+      left.grow(bins[b]);
+      leftCount += binCounts[b];
+      double cost = static_cast<double>(leftCount) * left.area() + rightCost[b + 1];
+      if (leftCount > 0 && leftCount < count && cost < bestCost) {
+        bestCost = cost;
+        bestAxis = axis;
+        bestPlane = low + (b + 1) / scale;
+      }
+    }
+  }
+  if (bestAxis < 0) {
+    return index;
+  }
+
+  // Partition triangles and their centroids together
+  size_t middle = begin;
+  for (size_t i = begin; i < end; ++i) {
+    if (centroids[2 * i + bestAxis] < bestPlane) {
+      std::swap(triangles_[i], triangles_[middle]);
+      std::swap(centroids[2 * i], centroids[2 * middle]);
+      std::swap(centroids[2 * i + 1], centroids[2 * middle + 1]);
+      middle++;
+    }
+  }
+  if (middle == begin || middle == end) {
+    return index;
+  }
+  build(centroids, begin, middle);
+  uint32_t rightChild = build(centroids, middle, end);
+  nodes_[index].first = rightChild;
+  nodes_[index].count = 0;
+  return index;
+}
+
+void SurfaceMeshBVH::intersect(const Triangle& t, double x, double y, double& bestZ, bool& found) {
+  double determinant = (t.by - t.cy) * (t.ax - t.cx) + (t.cx - t.bx) * (t.ay - t.cy);
+  double wa = ((t.by - t.cy) * (x - t.cx) + (t.cx - t.bx) * (y - t.cy)) / determinant;
+  double wb = ((t.cy - t.ay) * (x - t.cx) + (t.ax - t.cx) * (y - t.cy)) / determinant;
+  double wc = 1.0 - wa - wb;
+  if (wa < -EDGE_TOLERANCE || wb < -EDGE_TOLERANCE || wc < -EDGE_TOLERANCE) {
+    return;
+  }
+  double z = wa * t.az + wb * t.bz + wc * t.cz;
+  if (!found || z > bestZ) {
+    bestZ = z;
+    found = true;
+  }
+}
+
+double SurfaceMeshBVH::topZ(double x, double y) const {
+  double bestZ = std::numeric_limits<double>::quiet_NaN();
+  bool found = false;
+  if (nodes_.empty()) {
+    return bestZ;
+  }
+  uint32_t stack[64];
+  size_t depth = 0;
+  stack[depth++] = 0;
+  while (depth > 0) {
+    const Node& node = nodes_[stack[--depth]];
+    if ((found && node.maxZ <= bestZ) || x < node.minX || x > node.maxX || y < node.minY || y > node.maxY) {
+      continue;
+    }
+    if (node.count > 0) {
+      for (uint32_t i = node.first; i < node.first + node.count; ++i) {
+        intersect(triangles_[i], x, y, bestZ, found);
+      }
+      continue;
+    }
+    // Higher child on top of the stack, so its hit can prune the other
+    uint32_t left = static_cast<uint32_t>(&node - nodes_.data()) + 1;
+    uint32_t right = node.first;
+    bool leftHigher = nodes_[left].maxZ >= nodes_[right].maxZ;
+    if (depth + 2 > sizeof(stack) / sizeof(stack[0])) {
+      // Deeper than any SAH split of a real mesh; test every triangle instead
+      for (const Triangle& triangle : triangles_) {
+        intersect(triangle, x, y, bestZ, found);
+      }
+      return bestZ;
+    }
+    stack[depth++] = leftHigher ? right : left;
+    stack[depth++] = leftHigher ? left : right;
+  }
+  return bestZ;
+}
+
+void SurfaceMeshBVH::raiseTopZ(const std::vector<Point2D>& points, std::vector<double>& heights, int workers) const {
+  heights.resize(points.size(), std::numeric_limits<double>::quiet_NaN());
+  if (nodes_.empty() || points.empty()) {
+    return;
+  }
+  size_t chunks = (points.size() + QUERY_CHUNK - 1) / QUERY_CHUNK;
+  int threads = workers > 0 ? workers : static_cast<int>(std::thread::hardware_concurrency());
+  threads = std::max(1, std::min(threads, static_cast<int>(chunks)));
+
+  std::atomic<size_t> nextChunk{0};
+  auto worker = [&]() {
+    for (size_t chunk = nextChunk.fetch_add(1); chunk < chunks; chunk = nextChunk.fetch_add(1)) {
+      size_t end = std::min(points.size(), (chunk + 1) * QUERY_CHUNK);
+      for (size_t i = chunk * QUERY_CHUNK; i < end; ++i) {
+        double z = topZ(points[i].x, points[i].y);
+        if (!std::isnan(z) && (std::isnan(heights[i]) || z > heights[i])) {
+          heights[i] = z;
+        }
+      }
+    }
+  };
+  if (threads == 1) {
+    worker();
+    return;
+  }
+  std::vector<std::thread> pool;
+  pool.reserve(static_cast<size_t>(threads));
+  for (int t = 0; t < threads; ++t) {
+    pool.emplace_back(worker);
+  }
+  for (auto& thread : pool) {
+    thread.join();
+  }
+}
+
+}  // namespace Geometry
+}  // namespace ChipCarving
@@ -0,0 +1,92 @@
+/**
+ * ToolModel.cpp
+ *
+ * Tool profile constants and the per-family depth dispatch
+ */
+
+#include "geometry/ToolModel.h"
+
+namespace ChipCarving {
+namespace Geometry {
+
+ToolModel ToolModel::fromParameters(const Adapters::MedialAxisParameters& params) {
+  ToolModel tool = vBit(params.toolAngle, params.maxVCarveDepth);
+  tool.shape = params.toolShape;
+  if (params.toolDiameter > 0.0) {
+    tool.maxRadius = params.toolDiameter / 2.0;
+  }
+  if (params.toolShape == Adapters::ToolShape::V_BIT) {
+    return tool;
+  }
+
+  tool.tipRadius = std::max(0.0, params.toolTipDiameter / 2.0);
+  tool.valid = tool.valid && tool.tipRadius < tool.maxRadius;
+  if (params.toolShape == Adapters::ToolShape::TAPERED_BALL) {
+    // The cone is tangent to the ball where the ball's normal is perpendicular to the flank
+    double halfAngle = (params.toolAngle * M_PI / 180.0) / 2.0;
+    tool.flankRadius = tool.tipRadius * std::cos(halfAngle);
+    tool.flankDepth = tool.tipRadius * (1.0 - std::sin(halfAngle));
+  }
+  return tool;
+}
+
+ToolModel ToolModel::vBit(double toolAngle, double maxDepth) {
+  ToolModel tool;
+  tool.valid = toolAngle > 0.0 && toolAngle < 180.0;
+  if (tool.valid) {
+    tool.cotHalfAngle = 1.0 / std::tan((toolAngle * M_PI / 180.0) / 2.0);
+  }
+  tool.maxDepth = maxDepth;
+  return tool;
+}
+
+double ToolModel::depth(double clearanceRadius) const {
+  double result = 0.0;
+  calculateToolDepths(*this, &clearanceRadius, 1, &result);
+  return result;
+}
+
+double ToolModel::radiusAtDepth(double depth) const {
+  if (!valid || !(depth > 0.0)) {
+    return 0.0;
+  }
+  double radius = 0.0;
+  switch (shape) {
+    case Adapters::ToolShape::V_BIT:
+      radius = depth / cotHalfAngle;
+      break;
+    case Adapters::ToolShape::FLAT_TIP_V_BIT:
+      radius = tipRadius + depth / cotHalfAngle;
+      break;
+    case Adapters::ToolShape::TAPERED_BALL:
+      if (depth < flankDepth) {
+        double aboveCenter = tipRadius - depth;
+        radius = std::sqrt(std::max(0.0, tipRadius * tipRadius - aboveCenter * aboveCenter));
+      } else {
+        radius = flankRadius + (depth - flankDepth) / cotHalfAngle;
+      }
+      break;
+  }
+  return std::min(radius, maxRadius);
+}
+
+void calculateToolDepths(const ToolModel& tool, const double* clearanceRadii, size_t count, double* depths) {
+  if (!tool.valid) {
+    std::fill(depths, depths + count, 0.0);
+    return;
+  }
+  switch (tool.shape) {
+    case Adapters::ToolShape::V_BIT:
+      calculateToolDepths<Adapters::ToolShape::V_BIT>(tool, clearanceRadii, count, depths);
+      break;
+    case Adapters::ToolShape::FLAT_TIP_V_BIT:
+      calculateToolDepths<Adapters::ToolShape::FLAT_TIP_V_BIT>(tool, clearanceRadii, count, depths);
+      break;
+    case Adapters::ToolShape::TAPERED_BALL:
+      calculateToolDepths<Adapters::ToolShape::TAPERED_BALL>(tool, clearanceRadii, count, depths);
+      break;
+  }
+}
+
+}  // namespace Geometry
+}  // namespace ChipCarving
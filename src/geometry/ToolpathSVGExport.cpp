@@ -0,0 +1,128 @@
+/**
+ * ToolpathSVGExport.cpp
+ *
+ * SVG review export of profiles, medial axes and V-carve toolpaths
+ */
+
+#include "geometry/ToolpathSVGExport.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+
+namespace ChipCarving {
+namespace Geometry {
+
+namespace {
+
+constexpr double CANVAS_MARGIN = 20.0;  // SVG units SVGGenerator::setBounds keeps on each side
+constexpr double OUTLINE_STROKE = 0.75;
+constexpr double MEDIAL_STROKE = 1.0;
+constexpr double TOOLPATH_STROKE = 1.5;
+constexpr double BLUE_HUE = 240.0;  // Degrees; zero clearance or depth
+
+}  // namespace
+
+std::string toolpathRampColor(double fraction) {
+  double t = std::max(0.0, std::min(1.0, fraction));
+  // Fully saturated hue from blue through cyan, green and yellow to red
+  double hue = BLUE_HUE * (1.0 - t) / 60.0;
+  double x = 1.0 - std::abs(std::fmod(hue, 2.0) - 1.0);
+  double r = hue < 1.0 ? 1.0 : (hue < 2.0 ? x : 0.0);
+  double g = hue < 3.0 ? (hue < 1.0 ? x : 1.0) : x;
+  double b = hue < 2.0 ? 0.0 : (hue < 3.0 ? x : 1.0);
+  char color[8];
+  std::snprintf(color, sizeof(color), "#%02x%02x%02x", static_cast<int>(std::lround(255 * r)),
+                static_cast<int>(std::lround(255 * g)), static_cast<int>(std::lround(255 * b)));
+  return color;
+}
+
+ToolpathSVGExporter::ToolpathSVGExporter(const ShapeBounds& bounds, const ToolpathSVGStyle& style) : style_(style) {
+  double worldWidth = std::max(bounds.max.x - bounds.min.x, 1e-6);
+  double worldHeight = std::max(bounds.max.y - bounds.min.y, 1e-6);
+  double drawWidth = style_.canvasWidth - 2 * CANVAS_MARGIN;
+  double height = std::ceil(drawWidth * worldHeight / worldWidth) + 2 * CANVAS_MARGIN;
+  svg_ = std::make_unique<SVGGenerator>(style_.canvasWidth, height);
+  svg_->setBounds(bounds.min, bounds.max, 0.0);
+}
+
+bool ToolpathSVGExporter::open(const std::string& path) {
+  return svg_->streamToFile(path);
+}
+
+void ToolpathSVGExporter::addOutline(const std::vector<Point2D>& loop, double unitScale) {
+  if (loop.size() < 2) {
+    return;
+  }
+  std::vector<Point2D> points;
+  points.reserve(loop.size());
+  for (const auto& point : loop) {
+    points.emplace_back(point.x * unitScale, point.y * unitScale);
+  }
+  svg_->addPolyline(points, "black", OUTLINE_STROKE, true);
+  ++polylineCount_;
+}
+
+void ToolpathSVGExporter::addMedialAxis(const MedialAxisChains& chains, double unitScale) {
+  std::vector<Point2D> points;
+  std::vector<double> clearances;
+  for (const auto& chain : chains) {
+    points.clear();
+    clearances.clear();
+    for (size_t i = 0; i < chain.size(); ++i) {
+      points.emplace_back(chain[i].x * unitScale, chain[i].y * unitScale);
+      clearances.push_back(chain.clearance(i) * unitScale);
+    }
+    addColoredRuns(points, clearances, style_.maxClearance, MEDIAL_STROKE);
+  }
+}
+
+void ToolpathSVGExporter::addToolpaths(const VCarveResults& results) {
+  std::vector<Point2D> points;
+  std::vector<double> depths;
+  for (const auto& path : results.paths) {
+    points.clear();
+    depths.clear();
+    for (const auto& point : path.points) {
+      points.push_back(point.position);
+      depths.push_back(point.depth);
+    }
+    addColoredRuns(points, depths, style_.maxDepth, TOOLPATH_STROKE);
+  }
+}
+
+bool ToolpathSVGExporter::finish() {
+  return svg_->finishStream();
+}
+
+void ToolpathSVGExporter::addColoredRuns(const std::vector<Point2D>& points, const std::vector<double>& values,
+                                         double maxValue, double strokeWidth) {
+  if (points.size() < 2) {
+    return;
+  }
+  // Each segment takes the level of its mean value; a run ends where the level changes
+  size_t runStart = 0;
+  int runLevel = colorLevel((values[0] + values[1]) / 2.0, maxValue);
+  for (size_t i = 1; i < points.size(); ++i) {
+    int level = i + 1 < points.size() ? colorLevel((values[i] + values[i + 1]) / 2.0, maxValue) : -1;
+    if (level != runLevel) {
+      std::vector<Point2D> run(points.begin() + runStart, points.begin() + i + 1);
+      double fraction = style_.colorLevels > 1 ? runLevel / static_cast<double>(style_.colorLevels - 1) : 1.0;
+      svg_->addPolyline(run, toolpathRampColor(fraction), strokeWidth);
+      ++polylineCount_;
+      runStart = i;
+      runLevel = level;
+    }
+  }
+}
+
+int ToolpathSVGExporter::colorLevel(double value, double maxValue) const {
+  if (style_.colorLevels <= 1 || maxValue <= 0.0) {
+    return 0;
+  }
+  int level = static_cast<int>(value / maxValue * (style_.colorLevels - 1) + 0.5);
+  return std::max(0, std::min(style_.colorLevels - 1, level));
+}
+
+}  // namespace Geometry
+}  // namespace ChipCarving
@@ -5,6 +5,7 @@
  * centroid Split from TriArc.cpp for maintainability
  */
 
+#include <algorithm>
 #include <cmath>
 #include <stdexcept>
 
@@ -18,6 +19,8 @@ using ChipCarving::Geometry::Point2D;
 using ChipCarving::Geometry::TriArc;
 
 // Definition for static constexpr members (required for C++14)
+constexpr double TriArc::BOUNDS_TOLERANCE;
+constexpr double TriArc::DEGENERATE_DENOMINATOR;
 constexpr double TriArc::MAX_BULGE;
 constexpr double TriArc::MIN_BULGE;
 
@@ -32,6 +35,9 @@ TriArc::TriArc(const Point2D& v1, const Point2D& v2, const Point2D& v3, const st
 
   // Clamp to valid range
   clampBulgeFactors();
+
+  bounds_.min = Point2D(std::min({v1.x, v2.x, v3.x}), std::min({v1.y, v2.y, v3.y}));
+  bounds_.max = Point2D(std::max({v1.x, v2.x, v3.x}), std::max({v1.y, v2.y, v3.y}));
 }
 
 std::vector<Point2D> TriArc::getVertices() const {
@@ -43,11 +49,16 @@ bool TriArc::contains(const Point2D& point) const {
   // This is an approximation - a full implementation would need to handle
   // curved edges
 
+  // Most points of bulk queries fall outside the box and skip the barycentric math
+  if (!bounds_.contains(point, BOUNDS_TOLERANCE)) {
+    return false;
+  }
+
   // Use barycentric coordinates to test triangle containment
   double denom = (vertices_[1].y - vertices_[2].y) * (vertices_[0].x - vertices_[2].x) +
                  (vertices_[2].x - vertices_[1].x) * (vertices_[0].y - vertices_[2].y);
 
-  if (std::abs(denom) < 1e-10) {
+  if (std::abs(denom) < DEGENERATE_DENOMINATOR) {
     return false;  // Degenerate triangle
   }
 
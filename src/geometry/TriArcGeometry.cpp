@@ -20,19 +20,14 @@ using ChipCarving::Geometry::ArcParams;
 using ChipCarving::Geometry::Point2D;
 using ChipCarving::Geometry::TriArc;
 
-std::array<ArcParams, 3> TriArc::getArcParameters() const {
-  std::array<ArcParams, 3> arcs;
-  for (int i = 0; i < 3; ++i) {
-    arcs[i] = getArcParameters(i);
-  }
-  return arcs;
-}
-
 ArcParams TriArc::getArcParameters(int arcIndex) const {
   if (arcIndex < 0 || arcIndex >= 3) {
     throw std::out_of_range("Arc index must be 0, 1, or 2");
   }
+  return arcParams_[arcIndex];
+}
 
+ArcParams TriArc::computeArcParameters(int arcIndex) const {
   // Get edge vertices
   Point2D p1 = vertices_[arcIndex];
   Point2D p2 = vertices_[(arcIndex + 1) % 3];
@@ -137,8 +132,7 @@ Point2D TriArc::getPerpendicularNormal(int arcIndex) const {
 }
 
 bool TriArc::hasValidBulgeFactors() const {
-  return std::all_of(bulgeFactors_.begin(), bulgeFactors_.end(),
-                     [](double bulge) { return bulge <= 0 && bulge >= MIN_BULGE && bulge <= MAX_BULGE; });
+  return validBulgeFactors_;
 }
 
 void TriArc::clampBulgeFactors() {
@@ -150,6 +144,13 @@ void TriArc::clampBulgeFactors() {
     }
     bulge = std::max(MIN_BULGE, std::min(MAX_BULGE, bulge));
   }
+
+  // Everything derived from the bulges is computed here once, not per draw or query
+  validBulgeFactors_ = std::all_of(bulgeFactors_.begin(), bulgeFactors_.end(),
+                                   [](double bulge) { return bulge <= 0 && bulge >= MIN_BULGE && bulge <= MAX_BULGE; });
+  for (int i = 0; i < 3; ++i) {
+    arcParams_[i] = computeArcParameters(i);
+  }
 }
 
 bool TriArc::isEdgeStraight(int arcIndex) const {
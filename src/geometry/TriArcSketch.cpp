@@ -15,29 +15,56 @@
 #endif
 
 using ChipCarving::Geometry::Point2D;
+using ChipCarving::Geometry::ShapeEdge;
 using ChipCarving::Geometry::TriArc;
 
+std::vector<ShapeEdge> TriArc::getBoundaryEdges() const {
+  std::vector<ShapeEdge> edges;
+  for (int i = 0; i < 3; ++i) {
+    ShapeEdge edge;
+    edge.start = vertices_[i];
+    edge.end = vertices_[(i + 1) % 3];
+    edge.isArc = !isEdgeStraight(i);
+    if (edge.isArc) {
+      // Arc midpoint directly from the bulge factor: the sagitta off the chord midpoint
+      Point2D p1 = edge.start;
+      Point2D p2 = edge.end;
+      Point2D chordMid = Point2D((p1.x + p2.x) / 2.0, (p1.y + p2.y) / 2.0);
+      double chordLength = distance(p1, p2);
+      double sagitta = std::abs(bulgeFactors_[i] * chordLength) / 2.0;
+
+      Point2D chordDir = Point2D(p2.x - p1.x, p2.y - p1.y);
+      if (chordLength > 1e-9) {
+        chordDir.x /= chordLength;
+        chordDir.y /= chordLength;
+      }
+
+      // Concave arcs curve toward the triangle center
+      Point2D perpDir = Point2D(-chordDir.y, chordDir.x);
+      Point2D triangleCenter = getCenter();
+      Point2D toCenter = Point2D(triangleCenter.x - chordMid.x, triangleCenter.y - chordMid.y);
+      if (perpDir.x * toCenter.x + perpDir.y * toCenter.y < 0) {
+        perpDir.x = -perpDir.x;
+        perpDir.y = -perpDir.y;
+      }
+      edge.mid = Point2D(chordMid.x + perpDir.x * sagitta, chordMid.y + perpDir.y * sagitta);
+    }
+    edges.push_back(edge);
+  }
+  return edges;
+}
+
 void TriArc::drawToSketch(Adapters::ISketch* sketch, Adapters::ILogger* logger) const {
   (void)logger;  // Suppress unused parameter warning
   if (!sketch) {
     return;
   }
 
-  // Debug logging disabled for performance
-  // if (logger) {
-  //     logger->logDebug("TriArc::drawToSketch called");
-  // }
-
   // First, add the three vertices as sketch points
   std::vector<int> vertexIndices;
   for (int i = 0; i < 3; ++i) {
     int pointIndex = sketch->addPointToSketch(vertices_[i].x, vertices_[i].y);
     if (pointIndex < 0) {
-      // Error logging disabled for performance
-      // if (logger) {
-      //     logger->logError("Failed to add vertex point " +
-      //     std::to_string(i));
-      // }
       return;  // Exit if point creation fails
     }
     vertexIndices.push_back(pointIndex);  // Store the actual point index
@@ -45,80 +72,22 @@ void TriArc::drawToSketch(Adapters::ISketch* sketch, Adapters::ILogger* logger)
 
   // Draw each edge using the vertex points
   std::vector<int> midpointsToDelete;  // Track midpoints for cleanup
-
+  std::vector<ShapeEdge> edges = getBoundaryEdges();
   for (int i = 0; i < 3; ++i) {
     int startIdx = vertexIndices[i];
     int endIdx = vertexIndices[(i + 1) % 3];
-
-    bool isStraight = isEdgeStraight(i);
-    // Edge processing for TriArc shape
-
-    if (isStraight) {
-      // Draw as straight line between vertex points
+    if (!edges[i].isArc) {
       sketch->addLineByTwoPointsToSketch(startIdx, endIdx);
-    } else {
-      // For curved edges, calculate arc midpoint directly from bulge factor
-      Point2D p1 = vertices_[i];
-      Point2D p2 = vertices_[(i + 1) % 3];
-      double bulgeFactor = bulgeFactors_[i];
-
-      // Calculate chord midpoint
-      Point2D chordMid = Point2D((p1.x + p2.x) / 2.0, (p1.y + p2.y) / 2.0);
-
-      // Calculate chord length and sagitta (arc height)
-      double chordLength = distance(p1, p2);
-      double sagitta = std::abs(bulgeFactor * chordLength) / 2.0;
-
-      // Calculate perpendicular direction from chord midpoint
-      // For concave arcs (negative bulge), the arc curves toward the triangle
-      // center
-      Point2D chordDir = Point2D(p2.x - p1.x, p2.y - p1.y);
-      double chordLen = std::sqrt(chordDir.x * chordDir.x + chordDir.y * chordDir.y);
-      if (chordLen > 1e-9) {
-        chordDir.x /= chordLen;
-        chordDir.y /= chordLen;
-      }
-
-      // Perpendicular vector (rotate 90 degrees)
-      Point2D perpDir = Point2D(-chordDir.y, chordDir.x);
-
-      // For concave arcs, determine which direction curves toward triangle
-      // center
-      Point2D triangleCenter = getCenter();
-      Point2D toCenter = Point2D(triangleCenter.x - chordMid.x, triangleCenter.y - chordMid.y);
-
-      // Choose perpendicular direction that points toward triangle center for
-      // concave arcs
-      double dot = perpDir.x * toCenter.x + perpDir.y * toCenter.y;
-      if (dot < 0) {
-        perpDir.x = -perpDir.x;
-        perpDir.y = -perpDir.y;
-      }
-
-      // Calculate arc midpoint
-      double midX = chordMid.x + perpDir.x * sagitta;
-      double midY = chordMid.y + perpDir.y * sagitta;
-
-      // Arc midpoint calculated for three-point construction
-
-      // Add midpoint to sketch
-      int midIdx = sketch->addPointToSketch(midX, midY);
-      if (midIdx < 0) {
-        // Error logging disabled for performance
-        // if (logger) {
-        //     logger->logError("Failed to add midpoint for edge " +
-        //     std::to_string(i));
-        // }
-        continue;  // Skip this edge if midpoint creation fails
-      }
-
-      // Draw arc using three points: start vertex, midpoint, end vertex
-      bool arcCreated = sketch->addArcByThreePointsToSketch(startIdx, midIdx, endIdx);
+      continue;
+    }
 
-      if (arcCreated) {
-        // Track midpoint for deletion (only if arc was successfully created)
-        midpointsToDelete.push_back(midIdx);
-      }
+    int midIdx = sketch->addPointToSketch(edges[i].mid.x, edges[i].mid.y);
+    if (midIdx < 0) {
+      continue;  // Skip this edge if midpoint creation fails
+    }
+    // Track midpoint for deletion (only if arc was successfully created)
+    if (sketch->addArcByThreePointsToSketch(startIdx, midIdx, endIdx)) {
+      midpointsToDelete.push_back(midIdx);
     }
   }
 
@@ -0,0 +1,74 @@
+/**
+ * VCarveCalculatorClearing.cpp
+ *
+ * Flat-bottom clearing: where the clearance is wider than the cutter reaches
+ * within maxVCarveDepth, the V-carve leaves the middle of the region standing.
+ * MedialAxisProcessor traces offset loops for it from the same OpenVoronoi
+ * diagram as the medial axis; here they become closed paths at the depth limit.
+ */
+
+#include <iterator>
+#include <utility>
+#include <vector>
+
+#include "geometry/ToolModel.h"
+#include "geometry/VCarveCalculator.h"
+
+namespace ChipCarving {
+namespace Geometry {
+
+ClearingOffsets VCarveCalculator::clearingOffsets(const Adapters::MedialAxisParameters& params) {
+  ClearingOffsets offsets;
+  ToolModel tool = ToolModel::fromParameters(params);
+  if (!(params.clearingStepover > 0.0) || !tool.valid) {
+    return offsets;
+  }
+  offsets.firstOffset = Utils::mmToFusionLength(tool.radiusAtDepth(params.maxVCarveDepth));
+  offsets.stepover = Utils::mmToFusionLength(params.clearingStepover);
+  return offsets;
+}
+
+std::vector<VCarvePath> VCarveCalculator::clearingPaths(const std::vector<ClearingLoop>& loops,
+                                                        const Adapters::MedialAxisParameters& params) {
+  std::vector<VCarvePath> paths;
+  ToolModel tool = ToolModel::fromParameters(params);
+  if (!tool.valid) {
+    return paths;
+  }
+
+  // Every loop is cut where the V-carve bottoms out, which the diameter cap may keep above maxVCarveDepth
+  double depth = tool.depth(tool.radiusAtDepth(params.maxVCarveDepth));
+  paths.reserve(loops.size());
+  for (const auto& loop : loops) {
+    if (loop.points.size() < 2) {
+      continue;
+    }
+    double clearanceMm = Utils::fusionLengthToMm(loop.offset);
+    VCarvePath path;
+    path.points.reserve(loop.points.size() + 1);
+    for (const auto& point : loop.points) {
+      Point2D positionMm(Utils::fusionLengthToMm(point.x), Utils::fusionLengthToMm(point.y));
+      path.append(VCarvePoint(positionMm, depth, clearanceMm));
+    }
+    VCarvePoint start = path.points.front();
+    path.append(start);  // Back to the start, so the whole loop is cut
+    path.isClosed = true;
+    if (path.isValid()) {
+      paths.push_back(std::move(path));
+    }
+  }
+  return paths;
+}
+
+void VCarveCalculator::addClearingPaths(VCarveResults& results, const std::vector<ClearingLoop>& loops,
+                                        const Adapters::MedialAxisParameters& params) {
+  if (loops.empty()) {
+    return;
+  }
+  std::vector<VCarvePath> paths = clearingPaths(loops, params);
+  results.paths.reserve(results.paths.size() + paths.size());
+  std::move(paths.begin(), paths.end(), std::back_inserter(results.paths));
+}
+
+}  // namespace Geometry
+}  // namespace ChipCarving
@@ -7,7 +7,10 @@
 
 #include <algorithm>
 #include <cmath>
+#include <utility>
+#include <vector>
 
+#include "geometry/ToolModel.h"
 #include "geometry/VCarveCalculator.h"
 
 namespace ChipCarving {
@@ -31,41 +34,50 @@ VCarveResults VCarveCalculator::generateVCarvePaths(const MedialAxisResults& med
   }
 
   try {
+    ToolModel tool = ToolModel::fromParameters(params);
+
     // Convert each medial axis chain directly to V-carve path
     // This preserves the exact vertices from OpenVoronoi without additional
     // interpolation
     std::vector<VCarvePath> vcarvePathsRaw;
 
     for (size_t i = 0; i < medialResults.chains.size(); ++i) {
-      const auto& chain = medialResults.chains[i];
-      const auto& clearances = medialResults.clearanceRadii[i];
-
-      if (chain.empty() || chain.size() != clearances.size()) {
+      auto chain = medialResults.chains[i];
+      if (chain.empty()) {
         continue;  // Skip invalid chains
       }
 
       VCarvePath vcarvePath;
+      vcarvePath.points.reserve(chain.size());
+
+      // Exact clearance radii from OpenVoronoi are in cm, convert to mm for
+      // the depth calculation, then compute every depth in one batch
+      std::vector<double> clearancesMm(chain.size());
+      for (size_t j = 0; j < chain.size(); ++j) {
+        clearancesMm[j] = Utils::fusionLengthToMm(chain.clearance(j));
+      }
+      std::vector<double> depths(chain.size());
+      calculateToolDepths(tool, clearancesMm.data(), clearancesMm.size(), depths.data());
 
       // Convert each point in the chain
       for (size_t j = 0; j < chain.size(); ++j) {
-        // Calculate V-carve depth using the exact clearance radius from
-        // OpenVoronoi clearances[j] is in cm, convert to mm for depth
-        // calculation
-        double clearanceMm = clearances[j] * 10.0;
-        double depth = calculateVCarveDepth(clearanceMm, params.toolAngle, params.maxVCarveDepth);
+        double clearanceMm = clearancesMm[j];
+        double depth = depths[j];
 
         // Create V-carve point - chain points are already in world coordinates
         // (cm) Convert to mm for consistency with the rest of the system
-        Point2D positionMm(chain[j].x * 10.0, chain[j].y * 10.0);
+        Point2D positionMm(Utils::fusionLengthToMm(chain[j].x), Utils::fusionLengthToMm(chain[j].y));
 
-        VCarvePoint vcarvePoint(positionMm, depth, clearanceMm);
-        vcarvePath.points.push_back(vcarvePoint);
+        // append() extends the length and depth range as it goes
+        vcarvePath.append(VCarvePoint(positionMm, depth, clearanceMm));
       }
 
-      // Update path properties
-      vcarvePath.totalLength = vcarvePath.calculateLength();
       vcarvePath.isClosed = false;  // For now, treat all paths as open
 
+      if (medialResults.graph.edgeCount() == medialResults.chains.size()) {
+        vcarvePath.startNode = medialResults.graph.edge(i).start;
+        vcarvePath.endNode = medialResults.graph.edge(i).end;
+      }
       if (vcarvePath.isValid()) {
         vcarvePathsRaw.push_back(vcarvePath);
       }
@@ -77,7 +89,14 @@ VCarveResults VCarveCalculator::generateVCarvePaths(const MedialAxisResults& med
     }
 
     // Apply path optimization and merging
-    results.paths = optimizePaths(vcarvePathsRaw, params);
+    results.paths = params.minimizeRetracts ? planContinuousPaths(std::move(vcarvePathsRaw), params)
+                                            : optimizePaths(std::move(vcarvePathsRaw), params);
+
+    addClearingPaths(results, medialResults.clearingLoops, params);
+
+    // Order paths to minimize rapid travel between cuts, then cut each in its depth passes
+    orderPaths(results, params);
+    applyStepDown(results, params);
 
     // Update statistics
     results.updateStatistics();
@@ -91,7 +110,9 @@ VCarveResults VCarveCalculator::generateVCarvePaths(const MedialAxisResults& med
 }
 
 VCarveResults VCarveCalculator::generateVCarvePaths(const std::vector<SampledMedialPath>& sampledPaths,
-                                                    const Adapters::MedialAxisParameters& params) {
+                                                    const Adapters::MedialAxisParameters& params,
+                                                    const MedialAxisGraph* graph,
+                                                    const std::vector<ClearingLoop>* clearingLoops) {
   VCarveResults results;
 
   // Validate inputs
@@ -115,6 +136,10 @@ VCarveResults VCarveCalculator::generateVCarvePaths(const std::vector<SampledMed
       }
 
       VCarvePath vcarvePath = convertSampledPath(sampledPath, params);
+      if (graph && sampledPath.chain >= 0 && static_cast<size_t>(sampledPath.chain) < graph->edgeCount()) {
+        vcarvePath.startNode = graph->edge(sampledPath.chain).start;
+        vcarvePath.endNode = graph->edge(sampledPath.chain).end;
+      }
       if (vcarvePath.isValid()) {
         vcarvePathsRaw.push_back(vcarvePath);
       }
@@ -126,7 +151,16 @@ VCarveResults VCarveCalculator::generateVCarvePaths(const std::vector<SampledMed
     }
 
     // Apply path optimization and merging
-    results.paths = optimizePaths(vcarvePathsRaw, params);
+    results.paths = params.minimizeRetracts ? planContinuousPaths(std::move(vcarvePathsRaw), params)
+                                            : optimizePaths(std::move(vcarvePathsRaw), params);
+
+    if (clearingLoops) {
+      addClearingPaths(results, *clearingLoops, params);
+    }
+
+    // Order paths to minimize rapid travel between cuts, then cut each in its depth passes
+    orderPaths(results, params);
+    applyStepDown(results, params);
 
     // Update statistics
     results.updateStatistics();
@@ -140,23 +174,19 @@ VCarveResults VCarveCalculator::generateVCarvePaths(const std::vector<SampledMed
 }
 
 double VCarveCalculator::calculateVCarveDepth(double clearanceRadius, double toolAngle, double maxDepth) {
-  if (clearanceRadius <= 0.0 || toolAngle <= 0.0 || toolAngle >= 180.0) {
-    return 0.0;
-  }
-
-  // Convert angle to radians and use half-angle for V-bit geometry
-  double halfAngleRad = (toolAngle * M_PI / 180.0) / 2.0;
-
-  // Calculate depth using trigonometry: depth = radius / tan(half_angle)
-  double depth = clearanceRadius / std::tan(halfAngleRad);
+  double depth = 0.0;
+  calculateVCarveDepths(&clearanceRadius, 1, toolAngle, maxDepth, &depth);
+  return depth;
+}
 
-  // Apply safety limit
-  return std::min(depth, maxDepth);
+void VCarveCalculator::calculateVCarveDepths(const double* clearanceRadii, size_t count, double toolAngle,
+                                             double maxDepth, double* depths) {
+  calculateToolDepths(ToolModel::vBit(toolAngle, maxDepth), clearanceRadii, count, depths);
 }
 
 bool VCarveCalculator::validateParameters(const Adapters::MedialAxisParameters& params) {
-  // Check tool angle is reasonable
-  if (params.toolAngle <= 0.0 || params.toolAngle >= 180.0) {
+  // Check tool angle is reasonable and the tip fits inside the tool
+  if (!ToolModel::fromParameters(params).valid) {
     return false;
   }
 
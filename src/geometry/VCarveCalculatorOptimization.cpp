@@ -7,12 +7,85 @@
 
 #include <algorithm>
 #include <cmath>
+#include <cstdint>
+#include <iterator>
+#include <unordered_map>
+#include <utility>
+#include <vector>
 
+#include "geometry/PointKernels.h"
+#include "geometry/ToolModel.h"
 #include "geometry/VCarveCalculator.h"
 
 namespace ChipCarving {
 namespace Geometry {
 
+namespace {
+
+constexpr double MIN_CELL_SIZE = 1e-6;  // mm, keeps zero tolerance well defined
+
+double endpointDistance(const Point2D& a, const Point2D& b) {
+  double dx = a.x - b.x;
+  double dy = a.y - b.y;
+  return std::sqrt(dx * dx + dy * dy);
+}
+
+bool hasNodes(const VCarvePath& path) {
+  return path.startNode != MedialAxisGraph::NO_NODE && path.endNode != MedialAxisGraph::NO_NODE;
+}
+
+// Uniform grid of path endpoints with tolerance-sized cells, so all endpoints
+// within tolerance of a point are found in the 3x3 neighbouring cells
+class EndpointIndex {
+ public:
+  explicit EndpointIndex(double tolerance) : cellSize_(std::max(tolerance, MIN_CELL_SIZE)) {}
+
+  void insert(const Point2D& point, size_t pathIndex) {
+    cells_[cellKey(cellCoord(point.x), cellCoord(point.y))].push_back(pathIndex);
+  }
+
+  template <typename Visitor>
+  void forEachNear(const Point2D& point, Visitor&& visit) const {
+    int64_t cx = cellCoord(point.x);
+    int64_t cy = cellCoord(point.y);
+    for (int64_t dx = -1; dx <= 1; ++dx) {
+      for (int64_t dy = -1; dy <= 1; ++dy) {
+        auto it = cells_.find(cellKey(cx + dx, cy + dy));
+        if (it == cells_.end()) {
+          continue;
+        }
+        for (size_t pathIndex : it->second) {
+          visit(pathIndex);
+        }
+      }
+    }
+  }
+
+ private:
+  int64_t cellCoord(double value) const {
+    return static_cast<int64_t>(std::floor(value / cellSize_));
+  }
+
+  static uint64_t cellKey(int64_t cx, int64_t cy) {
+    return (static_cast<uint64_t>(cx) * 0x9E3779B97F4A7C15ULL) ^ static_cast<uint64_t>(cy);
+  }
+
+  double cellSize_;
+  std::unordered_map<uint64_t, std::vector<size_t>> cells_{};
+};
+
+}  // namespace
+
+std::vector<double> VCarveCalculator::sampledPathDepths(const SampledMedialPath& sampledPath,
+                                                        const Adapters::MedialAxisParameters& params) {
+  std::vector<double> depths(sampledPath.points.size());
+  for (size_t i = 0; i < sampledPath.points.size(); ++i) {
+    depths[i] = sampledPath.points[i].clearanceRadius;
+  }
+  calculateToolDepths(ToolModel::fromParameters(params), depths.data(), depths.size(), depths.data());
+  return depths;
+}
+
 VCarvePath VCarveCalculator::convertSampledPath(const SampledMedialPath& sampledPath,
                                                 const Adapters::MedialAxisParameters& params) {
   VCarvePath vcarvePath;
@@ -21,57 +94,138 @@ VCarvePath VCarveCalculator::convertSampledPath(const SampledMedialPath& sampled
     return vcarvePath;
   }
 
-  // Convert each sampled point to V-carve point with depth calculation
-  for (const auto& sampledPoint : sampledPath.points) {
-    // Calculate V-carve depth for all clearance radii (including 0.0 for sharp
-    // corners)
-    double depth = calculateVCarveDepth(sampledPoint.clearanceRadius, params.toolAngle, params.maxVCarveDepth);
+  // Calculate V-carve depth for all clearance radii (including 0.0 for sharp
+  // corners) in one batch
+  std::vector<double> depths = sampledPathDepths(sampledPath, params);
 
+  // Convert each sampled point to V-carve point
+  vcarvePath.points.reserve(sampledPath.points.size());
+  for (size_t i = 0; i < sampledPath.points.size(); ++i) {
+    const auto& sampledPoint = sampledPath.points[i];
     // Always add points - even zero clearance points are important for corners
-    VCarvePoint vcarvePoint(sampledPoint.position, depth, sampledPoint.clearanceRadius);
-    vcarvePath.points.push_back(vcarvePoint);
+    vcarvePath.append(VCarvePoint(sampledPoint.position, depths[i], sampledPoint.clearanceRadius));
+  }
+
+  // Flat runs need their points only where a target surface is queried under them
+  if (!Adapters::projectsOntoSurface(params)) {
+    compressPlateaus(vcarvePath, sampledPath, params.pathSimplifyTolerance);
   }
 
-  // Update path properties
-  vcarvePath.totalLength = vcarvePath.calculateLength();
   vcarvePath.isClosed = false;  // For now, treat all paths as open
 
   return vcarvePath;
 }
 
-std::vector<VCarvePath> VCarveCalculator::optimizePaths(const std::vector<VCarvePath>& paths,
-                                                        const Adapters::MedialAxisParameters& /* params */) {
-  if (paths.empty()) {
+std::vector<VCarvePath> VCarveCalculator::optimizePaths(std::vector<VCarvePath> paths,
+                                                        const Adapters::MedialAxisParameters& params) {
+  if (paths.size() < 2) {
     return paths;
   }
 
-  // For now, implement basic optimization: merge paths that can be connected
-  std::vector<VCarvePath> optimizedPaths = paths;
+  double tolerance = params.pathMergeTolerance;
 
   // Sort paths by length (longest first) to prioritize keeping long paths
-  std::sort(optimizedPaths.begin(), optimizedPaths.end(),
-            [](const VCarvePath& a, const VCarvePath& b) { return a.totalLength > b.totalLength; });
-
-  // Attempt to merge connectable paths
-  bool mergedAny = true;
-  while (mergedAny && optimizedPaths.size() > 1) {
-    mergedAny = false;
-
-    for (size_t i = 0; i < optimizedPaths.size() && !mergedAny; ++i) {
-      for (size_t j = i + 1; j < optimizedPaths.size() && !mergedAny; ++j) {
-        if (canConnectPaths(optimizedPaths[i], optimizedPaths[j])) {
-          // Merge paths j into i
-          VCarvePath merged = mergePaths(optimizedPaths[i], optimizedPaths[j]);
-
-          // Replace path i with merged, remove path j
-          optimizedPaths[i] = merged;
-          optimizedPaths.erase(optimizedPaths.begin() + static_cast<std::ptrdiff_t>(j));
-          mergedAny = true;
+  std::stable_sort(paths.begin(), paths.end(),
+                   [](const VCarvePath& a, const VCarvePath& b) { return a.totalLength > b.totalLength; });
+
+  // Paths that follow medial graph chains meet exactly at shared nodes, so
+  // candidates come from a per-node table of the paths' original ends instead
+  // of the endpoint grid; a merged path is reached through the paths it absorbed
+  bool byNode = std::all_of(paths.begin(), paths.end(), hasNodes);
+  EndpointIndex index(tolerance);
+  std::vector<uint32_t> nodeStarts;
+  std::vector<uint32_t> nodePaths;
+  std::vector<size_t> owner;
+  if (byNode) {
+    uint32_t nodeCount = 0;
+    for (const auto& path : paths) {
+      nodeCount = std::max({nodeCount, path.startNode + 1, path.endNode + 1});
+    }
+    nodeStarts.assign(nodeCount + 1, 0);
+    for (const auto& path : paths) {
+      ++nodeStarts[path.startNode + 1];
+      ++nodeStarts[path.endNode + 1];
+    }
+    for (uint32_t n = 0; n < nodeCount; ++n) {
+      nodeStarts[n + 1] += nodeStarts[n];
+    }
+    nodePaths.resize(nodeStarts.back());
+    std::vector<uint32_t> fill(nodeStarts.begin(), nodeStarts.end() - 1);
+    for (size_t i = 0; i < paths.size(); ++i) {
+      nodePaths[fill[paths[i].startNode]++] = static_cast<uint32_t>(i);
+      nodePaths[fill[paths[i].endNode]++] = static_cast<uint32_t>(i);
+    }
+    owner.resize(paths.size());
+    for (size_t i = 0; i < paths.size(); ++i) {
+      owner[i] = i;
+    }
+  } else {
+    for (size_t i = 0; i < paths.size(); ++i) {
+      if (paths[i].isValid()) {
+        index.insert(paths[i].points.front().position, i);
+        index.insert(paths[i].points.back().position, i);
+      }
+    }
+  }
+  auto ownerOf = [&owner](size_t j) {
+    while (owner[j] != j) {
+      j = owner[j] = owner[owner[j]];
+    }
+    return j;
+  };
+  auto forEachCandidate = [&](size_t i, auto&& visit) {
+    if (!byNode) {
+      index.forEachNear(paths[i].points.front().position, visit);
+      index.forEachNear(paths[i].points.back().position, visit);
+      return;
+    }
+    for (uint32_t node : {paths[i].startNode, paths[i].endNode}) {
+      for (uint32_t k = nodeStarts[node]; k < nodeStarts[node + 1]; ++k) {
+        visit(ownerOf(nodePaths[k]));
+      }
+    }
+  };
+
+  // Each path absorbs connectable paths until none remain, always taking the
+  // lowest-index (longest) candidate first. Stale index entries are harmless:
+  // every candidate is re-checked against the current endpoints.
+  std::vector<bool> absorbed(paths.size(), false);
+  const size_t NO_CANDIDATE = paths.size();
+  for (size_t i = 0; i < paths.size(); ++i) {
+    if (absorbed[i] || !paths[i].isValid()) {
+      continue;
+    }
+
+    for (;;) {
+      size_t best = NO_CANDIDATE;
+      auto consider = [&](size_t j) {
+        if (j != i && j < best && !absorbed[j] && canConnectPaths(paths[i], paths[j], tolerance)) {
+          best = j;
         }
+      };
+      forEachCandidate(i, consider);
+      if (best == NO_CANDIDATE || !splicePaths(paths[i], std::move(paths[best]), tolerance)) {
+        break;
+      }
+
+      absorbed[best] = true;
+      if (byNode) {
+        owner[best] = i;
+      } else {
+        index.insert(paths[i].points.front().position, i);
+        index.insert(paths[i].points.back().position, i);
       }
     }
   }
 
+  std::vector<VCarvePath> optimizedPaths;
+  optimizedPaths.reserve(paths.size());
+  for (size_t i = 0; i < paths.size(); ++i) {
+    if (!absorbed[i]) {
+      optimizedPaths.push_back(std::move(paths[i]));
+    }
+  }
+
   return optimizedPaths;
 }
 
@@ -79,82 +233,91 @@ bool VCarveCalculator::canConnectPaths(const VCarvePath& path1, const VCarvePath
   if (!path1.isValid() || !path2.isValid()) {
     return false;
   }
+  if (hasNodes(path1) && hasNodes(path2)) {
+    return path1.endNode == path2.startNode || path1.endNode == path2.endNode || path1.startNode == path2.startNode ||
+           path1.startNode == path2.endNode;
+  }
 
-  // Get endpoints of both paths
-  const Point2D& p1_start = path1.points.front().position;
-  const Point2D& p1_end = path1.points.back().position;
+  // Either end of path1 within tolerance of the nearer end of path2
   const Point2D& p2_start = path2.points.front().position;
   const Point2D& p2_end = path2.points.back().position;
-
-  // Check all possible connections
-  double dist1 = std::sqrt(std::pow(p1_end.x - p2_start.x, 2) + std::pow(p1_end.y - p2_start.y, 2));
-  double dist2 = std::sqrt(std::pow(p1_end.x - p2_end.x, 2) + std::pow(p1_end.y - p2_end.y, 2));
-  double dist3 = std::sqrt(std::pow(p1_start.x - p2_start.x, 2) + std::pow(p1_start.y - p2_start.y, 2));
-  double dist4 = std::sqrt(std::pow(p1_start.x - p2_end.x, 2) + std::pow(p1_start.y - p2_end.y, 2));
-
-  return (dist1 <= tolerance || dist2 <= tolerance || dist3 <= tolerance || dist4 <= tolerance);
+  const double xs[2] = {p2_start.x, p2_end.x};
+  const double ys[2] = {p2_start.y, p2_end.y};
+  for (const Point2D* end : {&path1.points.back().position, &path1.points.front().position}) {
+    double distanceSquared = 0.0;
+    nearestPoint(xs, ys, 2, *end, distanceSquared);
+    if (std::sqrt(distanceSquared) <= tolerance) {
+      return true;
+    }
+  }
+  return false;
 }
 
-VCarvePath VCarveCalculator::mergePaths(const VCarvePath& path1, const VCarvePath& path2) {
-  VCarvePath merged;
-
+VCarvePath VCarveCalculator::mergePaths(const VCarvePath& path1, const VCarvePath& path2, double tolerance) {
   if (!path1.isValid() || !path2.isValid()) {
-    return merged;
+    return VCarvePath();
   }
 
-  // Get endpoints for connection analysis
-  const Point2D& p1_start = path1.points.front().position;
-  const Point2D& p1_end = path1.points.back().position;
-  const Point2D& p2_start = path2.points.front().position;
-  const Point2D& p2_end = path2.points.back().position;
-
-  // Find best connection strategy
-  double tolerance = 0.1;  // Connection tolerance
-
-  // Case 1: path1.end -> path2.start
-  double dist1 = std::sqrt(std::pow(p1_end.x - p2_start.x, 2) + std::pow(p1_end.y - p2_start.y, 2));
-  if (dist1 <= tolerance) {
-    merged.points = path1.points;
-    merged.points.insert(merged.points.end(), path2.points.begin(), path2.points.end());
-    merged.totalLength = merged.calculateLength();
-    return merged;
-  }
-
-  // Case 2: path1.end -> path2.end (reverse path2)
-  double dist2 = std::sqrt(std::pow(p1_end.x - p2_end.x, 2) + std::pow(p1_end.y - p2_end.y, 2));
-  if (dist2 <= tolerance) {
-    merged.points = path1.points;
-    // Add path2 in reverse order
-    for (auto it = path2.points.rbegin(); it != path2.points.rend(); ++it) {
-      merged.points.push_back(*it);
-    }
-    merged.totalLength = merged.calculateLength();
-    return merged;
+  VCarvePath merged = path1;
+  if (!splicePaths(merged, VCarvePath(path2), tolerance)) {
+    // No valid connection found, return empty path
+    return VCarvePath();
   }
+  return merged;
+}
 
-  // Case 3: path2.end -> path1.start (reverse path1)
-  double dist3 = std::sqrt(std::pow(p1_start.x - p2_end.x, 2) + std::pow(p1_start.y - p2_end.y, 2));
-  if (dist3 <= tolerance) {
-    merged.points = path2.points;
-    merged.points.insert(merged.points.end(), path1.points.begin(), path1.points.end());
-    merged.totalLength = merged.calculateLength();
-    return merged;
+bool VCarveCalculator::splicePaths(VCarvePath& target, VCarvePath&& source, double tolerance) {
+  if (!target.isValid() || !source.isValid()) {
+    return false;
   }
 
-  // Case 4: path2.start -> path1.start (reverse both)
-  double dist4 = std::sqrt(std::pow(p1_start.x - p2_start.x, 2) + std::pow(p1_start.y - p2_start.y, 2));
-  if (dist4 <= tolerance) {
-    // Add path2 in reverse order
-    for (auto it = path2.points.rbegin(); it != path2.points.rend(); ++it) {
-      merged.points.push_back(*it);
-    }
-    merged.points.insert(merged.points.end(), path1.points.begin(), path1.points.end());
-    merged.totalLength = merged.calculateLength();
-    return merged;
+  const Point2D& p1_start = target.points.front().position;
+  const Point2D& p1_end = target.points.back().position;
+  const Point2D& p2_start = source.points.front().position;
+  const Point2D& p2_end = source.points.back().position;
+
+  // Graph paths join only at a shared node, whatever their endpoint distance
+  bool byNode = hasNodes(target) && hasNodes(source);
+  double gap = 0.0;
+  auto meets = [&](uint32_t a, uint32_t b, const Point2D& pa, const Point2D& pb) {
+    gap = endpointDistance(pa, pb);
+    return byNode ? a == b : gap <= tolerance;
+  };
+
+  if (meets(target.endNode, source.startNode, p1_end, p2_start)) {
+    // Case 1: target.end -> source.start
+    target.joinStatistics(source, gap);
+    target.points.insert(target.points.end(), std::make_move_iterator(source.points.begin()),
+                         std::make_move_iterator(source.points.end()));
+    target.endNode = source.endNode;
+  } else if (meets(target.endNode, source.endNode, p1_end, p2_end)) {
+    // Case 2: target.end -> source.end (reverse source)
+    target.joinStatistics(source, gap);
+    target.points.insert(target.points.end(), std::make_move_iterator(source.points.rbegin()),
+                         std::make_move_iterator(source.points.rend()));
+    target.endNode = source.startNode;
+  } else if (meets(target.startNode, source.endNode, p1_start, p2_end)) {
+    // Case 3: source.end -> target.start (source first)
+    target.joinStatistics(source, gap);
+    source.points.insert(source.points.end(), std::make_move_iterator(target.points.begin()),
+                         std::make_move_iterator(target.points.end()));
+    target.points = std::move(source.points);
+    target.startNode = source.startNode;
+  } else if (meets(target.startNode, source.startNode, p1_start, p2_start)) {
+    // Case 4: source.start -> target.start (reversed source first)
+    target.joinStatistics(source, gap);
+    target.startNode = source.endNode;
+    std::reverse(source.points.begin(), source.points.end());
+    source.points.insert(source.points.end(), std::make_move_iterator(target.points.begin()),
+                         std::make_move_iterator(target.points.end()));
+    target.points = std::move(source.points);
+  } else {
+    return false;
   }
 
-  // No valid connection found, return empty path
-  return merged;
+  // Lengths and depth ranges were combined before the points moved, so merging stays linear
+  target.isClosed = false;
+  return true;
 }
 
 }  // namespace Geometry
@@ -0,0 +1,167 @@
+/**
+ * VCarveCalculatorOrdering.cpp
+ *
+ * Toolpath ordering to minimize rapid travel between V-carve cuts.
+ * Split from VCarveCalculatorOptimization.cpp for maintainability
+ */
+
+#include <algorithm>
+#include <limits>
+#include <utility>
+#include <vector>
+
+#include "geometry/VCarveCalculator.h"
+
+namespace ChipCarving {
+namespace Geometry {
+
+namespace {
+
+// 2-opt is O(n^2) per pass; larger sets keep the nearest-neighbor order
+constexpr size_t TWO_OPT_MAX_PATHS = 2000;
+constexpr int TWO_OPT_MAX_PASSES = 20;
+constexpr double TWO_OPT_MIN_GAIN = 1e-9;  // mm
+
+// Visiting order over paths, each cut forward or reversed
+class PathTour {
+ public:
+  explicit PathTour(const std::vector<VCarvePath>& paths) : paths_(paths) {}
+
+  const Point2D& entry(size_t k) const {
+    const auto& points = paths_[order_[k]].points;
+    return reversed_[k] ? points.back().position : points.front().position;
+  }
+  const Point2D& exit(size_t k) const {
+    const auto& points = paths_[order_[k]].points;
+    return reversed_[k] ? points.front().position : points.back().position;
+  }
+
+  // Greedy tour: always cut the path whose nearest endpoint is closest next
+  void buildNearestNeighbor(bool allowReversal) {
+    size_t n = paths_.size();
+    std::vector<bool> visited(n, false);
+    order_.assign(1, 0);
+    reversed_.assign(1, false);
+    visited[0] = true;
+
+    for (size_t step = 1; step < n; ++step) {
+      const Point2D& position = exit(step - 1);
+      size_t best = n;
+      bool bestReversed = false;
+      double bestDistance = std::numeric_limits<double>::max();
+      for (size_t i = 0; i < n; ++i) {
+        if (visited[i]) {
+          continue;
+        }
+        double toStart = distance(position, paths_[i].points.front().position);
+        if (toStart < bestDistance) {
+          best = i;
+          bestReversed = false;
+          bestDistance = toStart;
+        }
+        double toEnd = allowReversal ? distance(position, paths_[i].points.back().position) : bestDistance;
+        if (toEnd < bestDistance) {
+          best = i;
+          bestReversed = true;
+          bestDistance = toEnd;
+        }
+      }
+      visited[best] = true;
+      order_.push_back(best);
+      reversed_.push_back(bestReversed);
+    }
+  }
+
+  // Segment-reversal 2-opt on the open tour: reversing cuts i..j flips their
+  // order and direction, replacing rapids (i-1 -> i) and (j -> j+1)
+  void refineTwoOpt() {
+    size_t n = order_.size();
+    for (int pass = 0; pass < TWO_OPT_MAX_PASSES; ++pass) {
+      bool improved = false;
+      for (size_t i = 0; i + 1 < n; ++i) {
+        for (size_t j = i + 1; j < n; ++j) {
+          double before = 0.0;
+          double after = 0.0;
+          if (i > 0) {
+            before += distance(exit(i - 1), entry(i));
+            after += distance(exit(i - 1), exit(j));
+          }
+          if (j + 1 < n) {
+            before += distance(exit(j), entry(j + 1));
+            after += distance(entry(i), entry(j + 1));
+          }
+          if (after + TWO_OPT_MIN_GAIN < before) {
+            std::reverse(order_.begin() + i, order_.begin() + j + 1);
+            std::reverse(reversed_.begin() + i, reversed_.begin() + j + 1);
+            for (size_t k = i; k <= j; ++k) {
+              reversed_[k] = !reversed_[k];
+            }
+            improved = true;
+          }
+        }
+      }
+      if (!improved) {
+        break;
+      }
+    }
+  }
+
+  double rapidDistance() const {
+    double total = 0.0;
+    for (size_t k = 1; k < order_.size(); ++k) {
+      total += distance(exit(k - 1), entry(k));
+    }
+    return total;
+  }
+
+  std::vector<size_t> order_{};
+  std::vector<bool> reversed_{};
+
+ private:
+  const std::vector<VCarvePath>& paths_;
+};
+
+}  // namespace
+
+void VCarveCalculator::orderPaths(VCarveResults& results, const Adapters::MedialAxisParameters& params) {
+  if (!params.orderToolpaths) {
+    return;
+  }
+
+  results.unorderedRapidDistance = calculateRapidDistance(results.paths);
+  results.pathsOrdered = true;
+
+  auto& paths = results.paths;
+  bool allOrderable =
+      std::all_of(paths.begin(), paths.end(), [](const VCarvePath& path) { return !path.points.empty(); });
+  if (paths.size() < 2 || !allOrderable) {
+    return;
+  }
+
+  // Depth is stored per point, so a reversed V-carve path cuts the same groove.
+  // 2-opt flips segment directions and so only runs when reversal is allowed.
+  PathTour tour(paths);
+  tour.buildNearestNeighbor(params.allowPathReversal);
+  if (params.allowPathReversal && paths.size() <= TWO_OPT_MAX_PATHS) {
+    tour.refineTwoOpt();
+  }
+
+  // Keep the input order in the rare case the heuristic does not beat it
+  if (tour.rapidDistance() >= results.unorderedRapidDistance) {
+    return;
+  }
+
+  std::vector<VCarvePath> ordered;
+  ordered.reserve(paths.size());
+  for (size_t k = 0; k < tour.order_.size(); ++k) {
+    ordered.push_back(std::move(paths[tour.order_[k]]));
+    if (tour.reversed_[k]) {
+      std::reverse(ordered.back().points.begin(), ordered.back().points.end());
+      std::swap(ordered.back().startNode, ordered.back().endNode);
+    }
+  }
+  paths = std::move(ordered);
+}
+
+}  // namespace Geometry
+}  // namespace ChipCarving
@@ -0,0 +1,76 @@
+/**
+ * VCarveCalculatorPlateaus.cpp
+ *
+ * Plateau compression: where the clearance implies a depth beyond
+ * maxVCarveDepth, or a straight medial axis run keeps one clearance, a path
+ * carries many points at one depth that the line between the run's ends
+ * already describes. They are dropped before the path reaches sketch points
+ * and G-code, unless the path is projected onto a surface
+ * (Adapters::projectsOntoSurface): the surface need not be flat under the
+ * run, so its points are all kept for the surface queries.
+ */
+
+#include <algorithm>
+#include <cmath>
+#include <utility>
+#include <vector>
+
+#include "geometry/VCarveCalculator.h"
+
+namespace ChipCarving {
+namespace Geometry {
+
+namespace {
+
+double distanceToSegment(const Point2D& point, const Point2D& a, const Point2D& b) {
+  Point2D ab = b - a;
+  double lengthSquared = ab.x * ab.x + ab.y * ab.y;
+  if (lengthSquared <= 0.0) {
+    return distance(point, a);
+  }
+  Point2D ap = point - a;
+  double t = std::max(0.0, std::min(1.0, (ap.x * ab.x + ap.y * ab.y) / lengthSquared));
+  return distance(point, a + ab * t);
+}
+
+}  // namespace
+
+size_t VCarveCalculator::compressPlateaus(VCarvePath& path, const SampledMedialPath& sampledPath,
+                                          double mergeTolerance) {
+  std::vector<VCarvePoint>& points = path.points;
+  if (!(mergeTolerance > 0.0) || points.size() < 3 || points.size() != sampledPath.points.size()) {
+    return 0;
+  }
+  auto level = [&](size_t a, size_t b) {
+    return std::abs(points[a].depth - points[b].depth) <= PLATEAU_DEPTH_TOLERANCE;
+  };
+
+  std::vector<VCarvePoint> compressed;
+  compressed.reserve(points.size());
+  size_t kept = 0;  // Index in points of the last point kept
+  for (size_t i = 0; i < points.size(); ++i) {
+    bool interior = i > 0 && i + 1 < points.size();
+    if (interior && !sampledPath.points[i].forced && level(kept, i) && level(kept, i + 1)) {
+      // Merge i if the line from the last kept point to i + 1 still covers every point skipped since
+      bool covered = true;
+      for (size_t j = kept + 1; j <= i && covered; ++j) {
+        covered = distanceToSegment(points[j].position, points[kept].position, points[i + 1].position) <=
+                  mergeTolerance;
+      }
+      if (covered) {
+        continue;
+      }
+    }
+    compressed.push_back(points[i]);
+    kept = i;
+  }
+  size_t removed = points.size() - compressed.size();
+  if (removed > 0) {
+    points = std::move(compressed);
+    path.updateStatistics();
+  }
+  return removed;
+}
+
+}  // namespace Geometry
+}  // namespace ChipCarving
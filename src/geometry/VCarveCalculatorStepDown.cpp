@@ -0,0 +1,119 @@
+/**
+ * VCarveCalculatorStepDown.cpp
+ *
+ * Step-down depth passes: each V-carve path is cut several times, every pass
+ * at most stepDownDepth deeper than the one before, so hard woods never see a
+ * full-depth cut. The passes come from the one computed path, without another
+ * medial axis or sampling run.
+ */
+
+#include <algorithm>
+#include <cmath>
+#include <iterator>
+#include <utility>
+#include <vector>
+
+#include "geometry/VCarveCalculator.h"
+
+namespace ChipCarving {
+namespace Geometry {
+
+namespace {
+
+// Depths this close to a pass depth count as clamped to it (mm)
+constexpr double PLATEAU_DEPTH_TOLERANCE = 1e-9;
+
+double distanceToSegment(const Point2D& point, const Point2D& a, const Point2D& b) {
+  Point2D ab = b - a;
+  double lengthSquared = ab.x * ab.x + ab.y * ab.y;
+  if (lengthSquared <= 0.0) {
+    return distance(point, a);
+  }
+  Point2D ap = point - a;
+  double t = std::max(0.0, std::min(1.0, (ap.x * ab.x + ap.y * ab.y) / lengthSquared));
+  return distance(point, a + ab * t);
+}
+
+// path clamped to passDepth, with the plateau points the line between their kept neighbours covers dropped
+VCarvePath clampedPass(const VCarvePath& path, double passDepth, double mergeTolerance) {
+  const auto& points = path.points;
+  auto onPlateau = [&](size_t i) { return points[i].depth >= passDepth - PLATEAU_DEPTH_TOLERANCE; };
+
+  VCarvePath pass;
+  pass.isClosed = path.isClosed;
+  pass.startNode = path.startNode;
+  pass.endNode = path.endNode;
+  pass.points.reserve(points.size());
+
+  size_t kept = 0;  // Index in points of the last point appended
+  for (size_t i = 0; i < points.size(); ++i) {
+    bool interior = i > 0 && i + 1 < points.size();
+    if (interior && onPlateau(i) && onPlateau(kept) && onPlateau(i + 1)) {
+      // Merge i if the line from the last kept point to i + 1 still covers every point skipped since
+      bool covered = true;
+      for (size_t j = kept + 1; j <= i && covered; ++j) {
+        covered = distanceToSegment(points[j].position, points[kept].position, points[i + 1].position) <=
+                  mergeTolerance;
+      }
+      if (covered) {
+        continue;
+      }
+    }
+    VCarvePoint point = points[i];
+    point.depth = std::min(point.depth, passDepth);
+    pass.append(point);
+    kept = i;
+  }
+  return pass;
+}
+
+}  // namespace
+
+std::vector<VCarvePath> VCarveCalculator::stepDownPasses(const VCarvePath& path, double stepDown, bool alternate,
+                                                         double mergeTolerance) {
+  std::vector<VCarvePath> passes;
+  double deepest = path.getMaxDepth();
+  if (!(stepDown > 0.0) || path.points.size() < 2 || deepest <= stepDown) {
+    passes.push_back(path);
+    return passes;
+  }
+
+  // The last pass is the path itself; a depth of a whole number of steps gets no empty extra pass
+  size_t count = static_cast<size_t>(std::ceil(deepest / stepDown - PLATEAU_DEPTH_TOLERANCE));
+  passes.reserve(count);
+  for (size_t k = 1; k < count; ++k) {
+    passes.push_back(clampedPass(path, stepDown * static_cast<double>(k), mergeTolerance));
+  }
+  passes.push_back(path);
+
+  // Counting back from the last pass, every other one runs backwards
+  if (alternate) {
+    for (size_t k = 0; k + 1 < passes.size(); ++k) {
+      if ((passes.size() - 1 - k) % 2 == 1) {
+        std::reverse(passes[k].points.begin(), passes[k].points.end());
+        std::swap(passes[k].startNode, passes[k].endNode);
+      }
+    }
+  }
+  return passes;
+}
+
+void VCarveCalculator::applyStepDown(VCarveResults& results, const Adapters::MedialAxisParameters& params) {
+  if (!(params.stepDownDepth > 0.0)) {
+    return;
+  }
+
+  // A chip's passes stay together in the order the paths were given; its last pass keeps
+  // the ordered direction, so the tool leaves every chip where the ordering planned
+  std::vector<VCarvePath> passes;
+  passes.reserve(results.paths.size());
+  for (const auto& path : results.paths) {
+    std::vector<VCarvePath> pathPasses =
+        stepDownPasses(path, params.stepDownDepth, params.allowPathReversal, params.pathSimplifyTolerance);
+    std::move(pathPasses.begin(), pathPasses.end(), std::back_inserter(passes));
+  }
+  results.paths = std::move(passes);
+}
+
+}  // namespace Geometry
+}  // namespace ChipCarving
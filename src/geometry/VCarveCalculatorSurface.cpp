@@ -5,8 +5,12 @@
  * Split from VCarveCalculator.cpp for maintainability
  */
 
+#include <algorithm>
 #include <cmath>
+#include <utility>
+#include <vector>
 
+#include "geometry/SurfaceHeightfield.h"
 #include "geometry/VCarveCalculator.h"
 #include "utils/logging.h"
 
@@ -17,6 +21,7 @@ VCarveResults VCarveCalculator::generateVCarvePathsWithSurface(const std::vector
                                                                const Adapters::MedialAxisParameters& params,
                                                                double sketchPlaneZ,
                                                                const SurfaceQueryFunction& surfaceQuery) {
+  LOG_DEBUG("Surface-projected V-carve on sketch plane Z " << sketchPlaneZ << " mm");
   (void)sketchPlaneZ;  // Used only in LOG_DEBUG which may be compiled out
   VCarveResults results;
 
@@ -34,6 +39,8 @@ VCarveResults VCarveCalculator::generateVCarvePathsWithSurface(const std::vector
   try {
     // Convert each sampled path to V-carve path with surface projection
     std::vector<VCarvePath> vcarvePathsRaw;
+    // The query is the surface; projected paths keep their flat runs, as in convertSampledPath()
+    const bool projected = Adapters::projectsOntoSurface(params, true);
 
     for (const auto& sampledPath : sampledPaths) {
       if (sampledPath.points.empty()) {
@@ -41,58 +48,30 @@ VCarveResults VCarveCalculator::generateVCarvePathsWithSurface(const std::vector
       }
 
       VCarvePath vcarvePath;
-
-      // Convert each sampled point to V-carve point with surface-adjusted depth
-      for (const auto& sampledPoint : sampledPath.points) {
-        // Calculate base V-carve depth from clearance radius
-        double baseDepth = calculateVCarveDepth(sampledPoint.clearanceRadius, params.toolAngle, params.maxVCarveDepth);
-
-        // Get position in mm
-        Point2D positionMm = sampledPoint.position;
-
-        // Query surface Z at this XY position (units: cm for Fusion API)
-        double surfaceZ = surfaceQuery(positionMm.x / 10.0, positionMm.y / 10.0);  // Convert mm to cm
-
-        // Calculate final depth based on surface projection
-        double finalDepth;
-        if (params.projectToSurface && !std::isnan(surfaceZ)) {
-          // Surface found - calculate proper depth
-          // REVISED APPROACH - Much simpler:
-          // - surfaceZ is the Z coordinate of the surface (in cm)
-          // - baseDepth is the desired cutting depth below surface (in cm)
-          // - finalDepth should be in the VCarvePoint coordinate system (cm)
-
-          // For surface projection, we want to cut baseDepth below the surface
-          // So the final depth is simply baseDepth (the same as non-surface
-          // case) The surface projection will be handled by the sketch creation
-          // later
-          finalDepth = baseDepth;
-
-          // Debug logging
-          static bool loggedOnce = false;
-          if (!loggedOnce) {
-            LOG_DEBUG("=== V-CARVE DEPTH CALCULATION DEBUG ===");
-            LOG_DEBUG("  XY position (mm): (" << positionMm.x << ", " << positionMm.y << ")");
-            LOG_DEBUG("  XY position (cm): (" << positionMm.x / 10.0 << ", " << positionMm.y / 10.0 << ")");
-            LOG_DEBUG("  surfaceZ (cm): " << surfaceZ);
-            LOG_DEBUG("  baseDepth (cm): " << baseDepth);
-            LOG_DEBUG("  sketchPlaneZ (cm): " << sketchPlaneZ);
-            LOG_DEBUG("  finalDepth (cm): " << finalDepth);
-            LOG_DEBUG("  clearanceRadius (mm): " << sampledPoint.clearanceRadius);
-            loggedOnce = true;
+      vcarvePath.points.reserve(sampledPath.points.size());
+
+      // Carve depth below the surface (or the sketch plane) from the clearance radii
+      std::vector<double> depths = sampledPathDepths(sampledPath, params);
+
+      // One pass: each point carries its surface Z, so sketchRelativeZ() gives the final Z
+      for (size_t i = 0; i < sampledPath.points.size(); ++i) {
+        const auto& sampledPoint = sampledPath.points[i];
+        VCarvePoint vcarvePoint(sampledPoint.position, depths[i], sampledPoint.clearanceRadius);
+
+        if (projected) {
+          double surfaceZ =
+              surfaceQuery(Utils::Millimeters(sampledPoint.position.x), Utils::Millimeters(sampledPoint.position.y))
+                  .value();
+          if (!std::isnan(surfaceZ)) {
+            vcarvePoint.projectToSurface(surfaceZ);
           }
-        } else {
-          // No surface or projection disabled - use base depth
-          finalDepth = baseDepth;
         }
-
-        // Create V-carve point with adjusted depth
-        VCarvePoint vcarvePoint(positionMm, finalDepth, sampledPoint.clearanceRadius);
-        vcarvePath.points.push_back(vcarvePoint);
+        vcarvePath.append(vcarvePoint);
+      }
+      if (!projected) {
+        compressPlateaus(vcarvePath, sampledPath, params.pathSimplifyTolerance);
       }
 
-      // Update path properties
-      vcarvePath.totalLength = vcarvePath.calculateLength();
       vcarvePath.isClosed = false;  // For now, treat all paths as open
 
       if (vcarvePath.isValid()) {
@@ -106,7 +85,12 @@ VCarveResults VCarveCalculator::generateVCarvePathsWithSurface(const std::vector
     }
 
     // Apply path optimization and merging
-    results.paths = optimizePaths(vcarvePathsRaw, params);
+    results.paths = params.minimizeRetracts ? planContinuousPaths(std::move(vcarvePathsRaw), params)
+                                            : optimizePaths(std::move(vcarvePathsRaw), params);
+
+    // Order paths to minimize rapid travel between cuts, then cut each in its depth passes
+    orderPaths(results, params);
+    applyStepDown(results, params);
 
     // Update statistics
     results.updateStatistics();
@@ -119,5 +103,31 @@ VCarveResults VCarveCalculator::generateVCarvePathsWithSurface(const std::vector
   return results;
 }
 
+void VCarveCalculator::compensateSurfaceSlope(VCarvePath& path, const Point2D* gradients, double maxDepth) {
+  std::vector<VCarvePoint>& points = path.points;
+  for (size_t i = 0; i < points.size(); ++i) {
+    if (!points[i].surfaceProjected) {
+      continue;
+    }
+    double scale = 1.0;
+    if (!std::isnan(gradients[i].x) && !std::isnan(gradients[i].y)) {
+      scale = slopeDepthScale(gradients[i].x, gradients[i].y);
+    } else {
+      // Directly queried points: central difference of the neighbouring surface Z
+      size_t before = i > 0 && points[i - 1].surfaceProjected ? i - 1 : i;
+      size_t after = i + 1 < points.size() && points[i + 1].surfaceProjected ? i + 1 : i;
+      double run = distance(points[before].position, points[after].position);
+      if (run > 1e-9) {
+        scale = slopeDepthScale((points[after].surfaceZ - points[before].surfaceZ) / run, 0.0);
+      }
+    }
+    if (scale > 1.0) {
+      points[i].depth = std::max(points[i].depth, std::min(points[i].depth * scale, maxDepth));
+    }
+  }
+  // Deeper points can move either end of the depth range
+  path.updateStatistics();
+}
+
 }  // namespace Geometry
 }  // namespace ChipCarving
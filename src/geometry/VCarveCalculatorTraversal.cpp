@@ -0,0 +1,207 @@
+/**
+ * VCarveCalculatorTraversal.cpp
+ *
+ * Continuous traversal of the medial axis graph with the fewest tool lifts.
+ * Split from VCarveCalculatorOptimization.cpp for maintainability
+ */
+
+#include <algorithm>
+#include <utility>
+#include <vector>
+
+#include "geometry/VCarveCalculator.h"
+
+namespace ChipCarving {
+namespace Geometry {
+
+namespace {
+
+constexpr size_t NO_PATH = static_cast<size_t>(-1);
+
+// A chain to cut (path set) or a lift between two odd nodes (path unset)
+struct TraversalEdge {
+  uint32_t a;
+  uint32_t b;
+  size_t path;
+};
+
+struct Step {
+  size_t edge;
+  bool forward;  // From the edge's a to its b
+};
+
+bool samePoint(const Point2D& a, const Point2D& b) {
+  return a.x == b.x && a.y == b.y;
+}
+
+bool constantDepth(const VCarvePath& path) {
+  return path.getMaxDepth() - path.getMinDepth() <= VCarveCalculator::RETRACE_DEPTH_TOLERANCE;
+}
+
+size_t findRoot(std::vector<size_t>& parent, size_t node) {
+  while (parent[node] != node) {
+    node = parent[node] = parent[parent[node]];
+  }
+  return node;
+}
+
+// Euler circuit of every edge reachable from start (Hierholzer), marking edges used
+std::vector<Step> eulerCircuit(const std::vector<TraversalEdge>& edges, const std::vector<size_t>& nodeStarts,
+                               const std::vector<size_t>& nodeEdges, std::vector<size_t>& nextEdge,
+                               std::vector<bool>& used, uint32_t start) {
+  std::vector<Step> circuit;
+  std::vector<std::pair<uint32_t, Step>> stack;
+  stack.push_back({start, Step{NO_PATH, true}});
+  while (!stack.empty()) {
+    uint32_t node = stack.back().first;
+    size_t& next = nextEdge[node];
+    while (next < nodeStarts[node + 1] && used[nodeEdges[next]]) {
+      ++next;
+    }
+    if (next == nodeStarts[node + 1]) {
+      if (stack.back().second.edge != NO_PATH) {
+        circuit.push_back(stack.back().second);
+      }
+      stack.pop_back();
+      continue;
+    }
+    size_t e = nodeEdges[next];
+    used[e] = true;
+    bool forward = edges[e].a == node;
+    stack.push_back({forward ? edges[e].b : edges[e].a, Step{e, forward}});
+  }
+  std::reverse(circuit.begin(), circuit.end());
+  return circuit;
+}
+
+}  // namespace
+
+constexpr double VCarveCalculator::RETRACE_DEPTH_TOLERANCE;
+
+std::vector<VCarvePath> VCarveCalculator::planContinuousPaths(std::vector<VCarvePath> paths,
+                                                              const Adapters::MedialAxisParameters& params) {
+  uint32_t nodeCount = 0;
+  for (const auto& path : paths) {
+    if (path.startNode == MedialAxisGraph::NO_NODE || path.endNode == MedialAxisGraph::NO_NODE) {
+      return optimizePaths(std::move(paths), params);
+    }
+    nodeCount = std::max({nodeCount, path.startNode + 1, path.endNode + 1});
+  }
+  if (paths.size() < 2) {
+    return paths;
+  }
+
+  std::vector<TraversalEdge> edges;
+  edges.reserve(paths.size() * 3 / 2);
+  std::vector<size_t> degree(nodeCount, 0);
+  std::vector<size_t> parent(nodeCount);
+  for (uint32_t n = 0; n < nodeCount; ++n) {
+    parent[n] = n;
+  }
+  for (size_t i = 0; i < paths.size(); ++i) {
+    edges.push_back(TraversalEdge{paths[i].startNode, paths[i].endNode, i});
+    ++degree[paths[i].startNode];
+    ++degree[paths[i].endNode];
+    size_t a = findRoot(parent, paths[i].startNode);
+    size_t b = findRoot(parent, paths[i].endNode);
+    parent[std::max(a, b)] = std::min(a, b);
+  }
+
+  // Cutting a flat-bottomed chain twice removes no extra material, so it may
+  // link two odd nodes in place of a lift; the shortest ones go first
+  std::vector<size_t> retrace;
+  for (size_t i = 0; i < paths.size(); ++i) {
+    if (paths[i].startNode != paths[i].endNode && constantDepth(paths[i])) {
+      retrace.push_back(i);
+    }
+  }
+  std::stable_sort(retrace.begin(), retrace.end(),
+                   [&paths](size_t a, size_t b) { return paths[a].totalLength < paths[b].totalLength; });
+  for (size_t i : retrace) {
+    if (degree[paths[i].startNode] % 2 == 1 && degree[paths[i].endNode] % 2 == 1) {
+      edges.push_back(TraversalEdge{paths[i].startNode, paths[i].endNode, i});
+      ++degree[paths[i].startNode];
+      ++degree[paths[i].endNode];
+    }
+  }
+
+  // Every remaining pair of odd nodes in a component costs one lift
+  std::vector<uint32_t> unpaired(nodeCount, MedialAxisGraph::NO_NODE);
+  for (uint32_t n = 0; n < nodeCount; ++n) {
+    if (degree[n] % 2 == 0) {
+      continue;
+    }
+    size_t component = findRoot(parent, n);
+    if (unpaired[component] == MedialAxisGraph::NO_NODE) {
+      unpaired[component] = n;
+    } else {
+      edges.push_back(TraversalEdge{unpaired[component], n, NO_PATH});
+      ++degree[unpaired[component]];
+      ++degree[n];
+      unpaired[component] = MedialAxisGraph::NO_NODE;
+    }
+  }
+
+  std::vector<size_t> nodeStarts(nodeCount + 1, 0);
+  for (uint32_t n = 0; n < nodeCount; ++n) {
+    nodeStarts[n + 1] = nodeStarts[n] + degree[n];
+  }
+  std::vector<size_t> nodeEdges(nodeStarts.back());
+  std::vector<size_t> nextEdge(nodeStarts.begin(), nodeStarts.end() - 1);
+  for (size_t e = 0; e < edges.size(); ++e) {
+    nodeEdges[nextEdge[edges[e].a]++] = e;
+    nodeEdges[nextEdge[edges[e].b]++] = e;
+  }
+  nextEdge.assign(nodeStarts.begin(), nodeStarts.end() - 1);
+
+  std::vector<VCarvePath> planned;
+  std::vector<bool> used(edges.size(), false);
+  auto emit = [&](const std::vector<Step>& circuit, size_t begin, size_t end) {
+    VCarvePath trail;
+    for (size_t k = begin; k < end; ++k) {
+      const Step& step = circuit[k % circuit.size()];
+      const VCarvePath& source = paths[edges[step.edge].path];
+      // Consecutive chains repeat their shared node's point
+      const Point2D& entry = (step.forward ? source.points.front() : source.points.back()).position;
+      bool skip = !trail.points.empty() && samePoint(trail.points.back().position, entry);
+      if (trail.points.empty()) {
+        trail.startNode = step.forward ? source.startNode : source.endNode;
+      }
+      trail.appendPath(source, !step.forward, skip);
+      trail.endNode = step.forward ? source.endNode : source.startNode;
+    }
+    planned.push_back(std::move(trail));
+  };
+
+  for (size_t e = 0; e < edges.size(); ++e) {
+    if (used[e]) {
+      continue;
+    }
+    std::vector<Step> circuit = eulerCircuit(edges, nodeStarts, nodeEdges, nextEdge, used, edges[e].a);
+
+    // Lifts split the circuit into trails; start just after one so none wraps
+    size_t offset = 0;
+    for (size_t k = 0; k < circuit.size(); ++k) {
+      if (edges[circuit[k].edge].path == NO_PATH) {
+        offset = k + 1;
+        break;
+      }
+    }
+    size_t trailBegin = offset;
+    for (size_t k = offset; k < offset + circuit.size(); ++k) {
+      if (edges[circuit[k % circuit.size()].edge].path == NO_PATH) {
+        if (k > trailBegin) {
+          emit(circuit, trailBegin, k);
+        }
+        trailBegin = k + 1;
+      }
+    }
+    if (offset + circuit.size() > trailBegin) {
+      emit(circuit, trailBegin, offset + circuit.size());
+    }
+  }
+  return planned;
+}
+
+}  // namespace Geometry
+}  // namespace ChipCarving
@@ -0,0 +1,219 @@
+/**
+ * VCarveCheckpoints.cpp
+ *
+ * Crash checkpoints of computed V-carve paths
+ *
+ * File layout (native byte order, one file per profile):
+ *   FileHeader
+ *   PathRecord  paths[numPaths]
+ *   PointRecord points[totalPoints]   (all paths, concatenated)
+ */
+
+#include "geometry/VCarveCheckpoints.h"
+
+#include <sys/stat.h>
+
+#include <algorithm>
+#include <cerrno>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <functional>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "utils/MappedFile.h"
+
+namespace ChipCarving {
+namespace Geometry {
+
+namespace {
+
+constexpr char FILE_MAGIC[4] = {'V', 'C', 'C', 'P'};
+constexpr uint32_t FORMAT_VERSION = 1;
+
+struct FileHeader {
+  char magic[4];
+  uint32_t formatVersion;
+  uint64_t key;
+  uint32_t numPaths;
+  uint32_t pathsOrdered;
+  uint64_t totalPoints;
+  double totalLength;
+  double maxDepth;
+  double minDepth;
+  double rapidDistance;
+  double unorderedRapidDistance;
+};
+
+struct PathRecord {
+  uint32_t pointCount;
+  uint32_t isClosed;
+  uint32_t startNode;
+  uint32_t endNode;
+  double totalLength;
+};
+
+struct PointRecord {
+  double x;
+  double y;
+  double depth;
+  double clearanceRadius;
+};
+
+size_t payloadBytes(uint64_t numPaths, uint64_t totalPoints) {
+  return sizeof(FileHeader) + numPaths * sizeof(PathRecord) + totalPoints * sizeof(PointRecord);
+}
+
+}  // namespace
+
+VCarveCheckpoints::VCarveCheckpoints(const std::string& directory) : directory_(directory) {
+  while (directory_.size() > 1 && directory_.back() == '/') {
+    directory_.pop_back();
+  }
+  struct stat info {};
+  enabled_ = !directory_.empty() && (::mkdir(directory_.c_str(), 0755) == 0 || errno == EEXIST) &&
+             ::stat(directory_.c_str(), &info) == 0 && S_ISDIR(info.st_mode);
+}
+
+std::string VCarveCheckpoints::pathForKey(uint64_t key) const {
+  char name[32];
+  std::snprintf(name, sizeof(name), "/%016llx.vcc", static_cast<unsigned long long>(key));
+  return directory_ + name;
+}
+
+bool VCarveCheckpoints::load(uint64_t key, VCarveResults& results) const {
+  if (!enabled_) {
+    return false;
+  }
+
+  Utils::MappedFile file(pathForKey(key));
+  if (!file.data() || file.size() < sizeof(FileHeader)) {
+    return false;
+  }
+
+  FileHeader header;
+  std::memcpy(&header, file.data(), sizeof(header));
+  if (std::memcmp(header.magic, FILE_MAGIC, sizeof(FILE_MAGIC)) != 0 || header.formatVersion != FORMAT_VERSION ||
+      header.key != key || file.size() != payloadBytes(header.numPaths, header.totalPoints)) {
+    return false;
+  }
+
+  std::vector<PathRecord> pathRecords(header.numPaths);
+  const unsigned char* cursor = file.data() + sizeof(FileHeader);
+  std::memcpy(pathRecords.data(), cursor, pathRecords.size() * sizeof(PathRecord));
+  cursor += pathRecords.size() * sizeof(PathRecord);
+
+  uint64_t pointSum = 0;
+  for (const auto& record : pathRecords) {
+    pointSum += record.pointCount;
+  }
+  if (pointSum != header.totalPoints) {
+    return false;
+  }
+
+  VCarveResults loaded;
+  loaded.paths.resize(header.numPaths);
+  for (size_t p = 0; p < pathRecords.size(); ++p) {
+    const PathRecord& record = pathRecords[p];
+    VCarvePath& path = loaded.paths[p];
+    path.totalLength = record.totalLength;
+    path.isClosed = record.isClosed != 0;
+    path.startNode = record.startNode;
+    path.endNode = record.endNode;
+    path.points.reserve(record.pointCount);
+    for (uint32_t i = 0; i < record.pointCount; ++i) {
+      PointRecord point;
+      std::memcpy(&point, cursor, sizeof(point));
+      cursor += sizeof(point);
+      path.points.emplace_back(Point2D(point.x, point.y), point.depth, point.clearanceRadius);
+      path.minDepth = i == 0 ? point.depth : std::min(path.minDepth, point.depth);
+      path.maxDepth = i == 0 ? point.depth : std::max(path.maxDepth, point.depth);
+    }
+    path.measuredPoints = path.points.size();
+  }
+
+  loaded.totalPaths = static_cast<int>(header.numPaths);
+  loaded.totalPoints = static_cast<int>(header.totalPoints);
+  loaded.totalLength = header.totalLength;
+  loaded.maxDepth = header.maxDepth;
+  loaded.minDepth = header.minDepth;
+  loaded.rapidDistance = header.rapidDistance;
+  loaded.unorderedRapidDistance = header.unorderedRapidDistance;
+  loaded.pathsOrdered = header.pathsOrdered != 0;
+  loaded.success = true;
+
+  results = std::move(loaded);
+  return true;
+}
+
+bool VCarveCheckpoints::store(uint64_t key, const VCarveResults& results) const {
+  if (!enabled_ || !results.success || results.compacted) {
+    return false;
+  }
+
+  FileHeader header{};
+  std::memcpy(header.magic, FILE_MAGIC, sizeof(FILE_MAGIC));
+  header.formatVersion = FORMAT_VERSION;
+  header.key = key;
+  header.numPaths = static_cast<uint32_t>(results.paths.size());
+  header.pathsOrdered = results.pathsOrdered ? 1 : 0;
+  header.totalLength = results.totalLength;
+  header.maxDepth = results.maxDepth;
+  header.minDepth = results.minDepth;
+  header.rapidDistance = results.rapidDistance;
+  header.unorderedRapidDistance = results.unorderedRapidDistance;
+
+  std::vector<PathRecord> pathRecords;
+  pathRecords.reserve(results.paths.size());
+  for (const auto& path : results.paths) {
+    pathRecords.push_back(PathRecord{static_cast<uint32_t>(path.points.size()), path.isClosed ? 1u : 0u,
+                                     path.startNode, path.endNode, path.totalLength});
+    header.totalPoints += path.points.size();
+  }
+
+  // Workers store concurrently; a per-thread temporary name keeps their writes apart
+  std::string path = pathForKey(key);
+  std::string tempPath = path + "." + std::to_string(std::hash<std::thread::id>()(std::this_thread::get_id())) + ".tmp";
+  {
+    std::ofstream out(tempPath, std::ios::binary | std::ios::trunc);
+    if (!out) {
+      return false;
+    }
+
+    out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    out.write(reinterpret_cast<const char*>(pathRecords.data()),
+              static_cast<std::streamsize>(pathRecords.size() * sizeof(PathRecord)));
+    std::vector<PointRecord> points;
+    for (const auto& vcarvePath : results.paths) {
+      points.clear();
+      for (const auto& point : vcarvePath.points) {
+        points.push_back(PointRecord{point.position.x, point.position.y, point.depth, point.clearanceRadius});
+      }
+      out.write(reinterpret_cast<const char*>(points.data()),
+                static_cast<std::streamsize>(points.size() * sizeof(PointRecord)));
+    }
+
+    if (!out) {
+      out.close();
+      std::remove(tempPath.c_str());
+      return false;
+    }
+  }
+
+  if (std::rename(tempPath.c_str(), path.c_str()) != 0) {
+    std::remove(tempPath.c_str());
+    return false;
+  }
+  return true;
+}
+
+void VCarveCheckpoints::remove(uint64_t key) const {
+  if (enabled_) {
+    std::remove(pathForKey(key).c_str());
+  }
+}
+
+}  // namespace Geometry
+}  // namespace ChipCarving
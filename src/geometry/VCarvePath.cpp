@@ -13,6 +13,70 @@
 namespace ChipCarving {
 namespace Geometry {
 
+void VCarvePath::append(const VCarvePoint& point) {
+  bool current = statisticsCurrent();
+  if (current && !points.empty()) {
+    totalLength += distance(points.back().position, point.position);
+    minDepth = std::min(minDepth, point.depth);
+    maxDepth = std::max(maxDepth, point.depth);
+  } else if (current) {
+    minDepth = maxDepth = point.depth;
+  }
+  points.push_back(point);
+  if (current) {
+    measuredPoints = points.size();
+  }
+}
+
+void VCarvePath::appendPath(const VCarvePath& source, bool reversed, bool skipFirst) {
+  size_t skip = skipFirst && !source.points.empty() ? 1 : 0;
+  if (source.points.size() <= skip) {
+    return;
+  }
+  if (points.empty() || skip) {
+    // The skipped point repeats this path's last one, so no move bridges the two
+    joinStatistics(source, 0.0);
+  } else {
+    const VCarvePoint& entry = reversed ? source.points.back() : source.points.front();
+    joinStatistics(source, distance(points.back().position, entry.position));
+  }
+  if (reversed) {
+    points.insert(points.end(), source.points.rbegin() + skip, source.points.rend());
+  } else {
+    points.insert(points.end(), source.points.begin() + skip, source.points.end());
+  }
+  if (measuredPoints != 0) {
+    measuredPoints = points.size();
+  }
+}
+
+void VCarvePath::joinStatistics(const VCarvePath& source, double gap) {
+  bool current = statisticsCurrent() && source.statisticsCurrent();
+  if (points.empty()) {
+    minDepth = source.minDepth;
+    maxDepth = source.maxDepth;
+  } else {
+    minDepth = std::min(minDepth, source.minDepth);
+    maxDepth = std::max(maxDepth, source.maxDepth);
+  }
+  totalLength += source.totalLength + gap;
+  measuredPoints = current ? points.size() + source.points.size() : 0;
+}
+
+void VCarvePath::updateStatistics() {
+  totalLength = 0.0;
+  minDepth = points.empty() ? 0.0 : points[0].depth;
+  maxDepth = minDepth;
+  for (size_t i = 0; i < points.size(); ++i) {
+    if (i > 0) {
+      totalLength += distance(points[i - 1].position, points[i].position);
+    }
+    minDepth = std::min(minDepth, points[i].depth);
+    maxDepth = std::max(maxDepth, points[i].depth);
+  }
+  measuredPoints = points.size();
+}
+
 double VCarvePath::calculateLength() const {
   if (points.size() < 2) {
     return 0.0;
@@ -35,6 +99,9 @@ double VCarvePath::getMaxDepth() const {
   if (points.empty()) {
     return 0.0;
   }
+  if (statisticsCurrent()) {
+    return maxDepth;
+  }
 
   double maxDepth = points[0].depth;
   for (const auto& point : points) {
@@ -48,6 +115,9 @@ double VCarvePath::getMinDepth() const {
   if (points.empty()) {
     return 0.0;
   }
+  if (statisticsCurrent()) {
+    return minDepth;
+  }
 
   double minDepth = points[0].depth;
   for (const auto& point : points) {
@@ -61,12 +131,31 @@ bool VCarvePath::isValid() const {
   return points.size() >= 2;
 }
 
+void VCarveResults::compact() {
+  if (compacted) {
+    return;
+  }
+  compactStorage = compactVCarvePaths(paths);
+  std::vector<VCarvePath>().swap(paths);
+  compacted = true;
+}
+
+void VCarveResults::expand() {
+  if (!compacted) {
+    return;
+  }
+  expandVCarvePaths(compactStorage, paths);
+  compactStorage = CompactVCarvePaths();
+  compacted = false;
+}
+
 void VCarveResults::updateStatistics() {
   totalPaths = static_cast<int>(paths.size());
   totalPoints = 0;
   totalLength = 0.0;
   maxDepth = 0.0;
   minDepth = 0.0;
+  rapidDistance = calculateRapidDistance(paths);
 
   if (paths.empty()) {
     return;
@@ -76,23 +165,22 @@ void VCarveResults::updateStatistics() {
   bool firstPath = true;
 
   for (auto& path : paths) {
-    // Update path's own length
-    path.totalLength = path.calculateLength();
+    // Paths built by append() or spliced already know their statistics
+    if (!path.statisticsCurrent()) {
+      path.updateStatistics();
+    }
 
     totalPoints += static_cast<int>(path.points.size());
     totalLength += path.totalLength;
 
     if (!path.points.empty()) {
-      double pathMax = path.getMaxDepth();
-      double pathMin = path.getMinDepth();
-
       if (firstPath) {
-        maxDepth = pathMax;
-        minDepth = pathMin;
+        maxDepth = path.maxDepth;
+        minDepth = path.minDepth;
         firstPath = false;
       } else {
-        maxDepth = std::max(maxDepth, pathMax);
-        minDepth = std::min(minDepth, pathMin);
+        maxDepth = std::max(maxDepth, path.maxDepth);
+        minDepth = std::min(minDepth, path.minDepth);
       }
     }
   }
@@ -103,8 +191,27 @@ std::string VCarveResults::getSummary() const {
   oss << "V-Carve Results: " << totalPaths << " paths, " << totalPoints << " points, " << static_cast<int>(totalLength)
       << "mm length, "
       << "depths " << static_cast<int>(minDepth * 10) / 10.0 << "-" << static_cast<int>(maxDepth * 10) / 10.0 << "mm";
+  if (pathsOrdered) {
+    oss << ", rapids " << static_cast<int>(unorderedRapidDistance) << "mm -> " << static_cast<int>(rapidDistance)
+        << "mm";
+  }
   return oss.str();
 }
 
+double calculateRapidDistance(const std::vector<VCarvePath>& paths) {
+  double distance = 0.0;
+  for (size_t i = 1; i < paths.size(); ++i) {
+    if (paths[i - 1].points.empty() || paths[i].points.empty()) {
+      continue;
+    }
+    const auto& from = paths[i - 1].points.back().position;
+    const auto& to = paths[i].points.front().position;
+    double dx = to.x - from.x;
+    double dy = to.y - from.y;
+    distance += std::sqrt(dx * dx + dy * dy);
+  }
+  return distance;
+}
+
 }  // namespace Geometry
 }  // namespace ChipCarving
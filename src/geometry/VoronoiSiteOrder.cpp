@@ -0,0 +1,112 @@
+/**
+ * VoronoiSiteOrder.cpp
+ *
+ * Hilbert and shuffled point site ordering, and density-based bin counts
+ */
+
+#include "geometry/VoronoiSiteOrder.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <numeric>
+#include <random>
+
+namespace ChipCarving {
+namespace Geometry {
+
+namespace {
+
+constexpr int HILBERT_BITS = 16;                // Cells per side = 2^16
+constexpr uint32_t SHUFFLE_SEED = 0x5eed;       // Fixed so diagrams are reproducible
+constexpr int MIN_BINS = 10;                    // The previous fixed floor
+constexpr double MAX_BINS_PER_SQRT_SITE = 3.0;  // Caps grid memory for thin outlines
+
+// Distance along the Hilbert curve of cell (x, y) on a 2^HILBERT_BITS grid
+uint64_t hilbertIndex(uint32_t x, uint32_t y) {
+  uint64_t index = 0;
+  for (uint32_t s = 1u << (HILBERT_BITS - 1); s > 0; s >>= 1) {
+    uint32_t rx = (x & s) > 0 ? 1 : 0;
+    uint32_t ry = (y & s) > 0 ? 1 : 0;
+    index += static_cast<uint64_t>(s) * s * ((3 * rx) ^ ry);
+    // Rotate the quadrant so the curve stays continuous
+    if (ry == 0) {
+      if (rx == 1) {
+        x = s - 1 - (x & (s - 1));
+        y = s - 1 - (y & (s - 1));
+      }
+      std::swap(x, y);
+    }
+    x &= s - 1;
+    y &= s - 1;
+  }
+  return index;
+}
+
+}  // namespace
+
+std::vector<size_t> siteInsertionOrder(const std::vector<Point2D>& points, SiteInsertionOrder order) {
+  std::vector<size_t> indices;
+  std::vector<uint64_t> keys;
+  siteInsertionOrder(points, order, indices, keys);
+  return indices;
+}
+
+void siteInsertionOrder(const std::vector<Point2D>& points, SiteInsertionOrder order, std::vector<size_t>& indices,
+                        std::vector<uint64_t>& keys) {
+  indices.resize(points.size());
+  std::iota(indices.begin(), indices.end(), 0);
+  if (points.size() < 3 || order == SiteInsertionOrder::POLYGON) {
+    return;
+  }
+
+  if (order == SiteInsertionOrder::SHUFFLED) {
+    std::mt19937 rng(SHUFFLE_SEED);
+    std::shuffle(indices.begin(), indices.end(), rng);
+    return;
+  }
+
+  double minX = points[0].x, minY = points[0].y, maxX = points[0].x, maxY = points[0].y;
+  for (const auto& p : points) {
+    minX = std::min(minX, p.x);
+    minY = std::min(minY, p.y);
+    maxX = std::max(maxX, p.x);
+    maxY = std::max(maxY, p.y);
+  }
+  // One square cell size keeps the curve's locality in both directions
+  double extent = std::max(maxX - minX, maxY - minY);
+  double cellsPerUnit = extent > 0.0 ? ((1u << HILBERT_BITS) - 1) / extent : 0.0;
+
+  keys.resize(points.size());
+  for (size_t i = 0; i < points.size(); ++i) {
+    keys[i] = hilbertIndex(static_cast<uint32_t>((points[i].x - minX) * cellsPerUnit),
+                           static_cast<uint32_t>((points[i].y - minY) * cellsPerUnit));
+  }
+  // Ties broken by index: the stable order, without stable_sort's temporary buffer
+  std::sort(indices.begin(), indices.end(),
+            [&keys](size_t a, size_t b) { return keys[a] < keys[b] || (keys[a] == keys[b] && a < b); });
+}
+
+int openVoronoiBinCount(const std::vector<Point2D>& unitPoints) {
+  if (unitPoints.empty()) {
+    return MIN_BINS;
+  }
+
+  double minX = unitPoints[0].x, minY = unitPoints[0].y, maxX = unitPoints[0].x, maxY = unitPoints[0].y;
+  for (const auto& p : unitPoints) {
+    minX = std::min(minX, p.x);
+    minY = std::min(minY, p.y);
+    maxX = std::max(maxX, p.x);
+    maxY = std::max(maxY, p.y);
+  }
+
+  // The grid spans [-1, 1]^2 (area 4); only the bins under the bounding box see sites
+  double sites = static_cast<double>(unitPoints.size());
+  double occupiedFraction = std::max((maxX - minX) * (maxY - minY) / 4.0, 1e-6);
+  double bins = std::sqrt(sites / occupiedFraction);
+  bins = std::min(bins, MAX_BINS_PER_SQRT_SITE * std::sqrt(sites));
+  return std::max(MIN_BINS, static_cast<int>(bins));
+}
+
+}  // namespace Geometry
+}  // namespace ChipCarving
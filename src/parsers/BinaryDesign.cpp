@@ -0,0 +1,207 @@
+/**
+ * BinaryDesign.cpp
+ *
+ * Reader for memory-mapped binary design files
+ */
+
+#include "parsers/BinaryDesign.h"
+
+#include <cstring>
+#include <iterator>
+#include <memory>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+#include "adapters/IFusionInterface.h"
+#include "geometry/ShapeFactory.h"
+#include "utils/MappedFile.h"
+
+namespace ChipCarving {
+namespace Parsers {
+
+namespace {
+
+std::shared_ptr<const Utils::MappedFile> openMapped(const std::string& path) {
+  auto file = std::make_shared<const Utils::MappedFile>(path);
+  if (!file->isOpen()) {
+    throw std::runtime_error("Failed to open file: " + path);
+  }
+  return file;
+}
+
+bool validRef(const BinaryStringRef& ref, uint64_t stringBytes) {
+  return ref.offset <= stringBytes && ref.length <= stringBytes - ref.offset;
+}
+
+const char* shapeTypeName(uint32_t type) {
+  if (type == static_cast<uint32_t>(BinaryShapeType::Leaf)) {
+    return "LEAF";
+  }
+  if (type == static_cast<uint32_t>(BinaryShapeType::TriArc)) {
+    return "TRI_ARC";
+  }
+  return "";
+}
+
+Geometry::ShapeSpec shapeSpec(const BinaryShapeRecord& record) {
+  Geometry::ShapeSpec spec;
+  spec.type = shapeTypeName(record.type);
+  if (spec.type.empty()) {
+    throw std::runtime_error("Unknown binary shape type: " + std::to_string(record.type));
+  }
+  size_t vertexCount = record.type == static_cast<uint32_t>(BinaryShapeType::Leaf) ? 2 : 3;
+  for (size_t i = 0; i < vertexCount; ++i) {
+    spec.vertices.emplace_back(record.vertices[i][0], record.vertices[i][1]);
+  }
+  if (vertexCount == 3) {
+    spec.curvatures.assign(record.curvatures, record.curvatures + 3);
+  }
+  spec.radius = record.radius;
+  return spec;
+}
+
+}  // namespace
+
+BinaryDesignReader::BinaryDesignReader(const std::string& path) : BinaryDesignReader(openMapped(path)) {}
+
+BinaryDesignReader::BinaryDesignReader(std::shared_ptr<const Utils::MappedFile> file) : file_(std::move(file)) {
+  if (!file_ || !file_->isOpen()) {
+    throw std::runtime_error("Failed to open binary design file");
+  }
+  if (!isBinaryDesign(*file_) || file_->size() < sizeof(BinaryDesignHeader)) {
+    throw std::runtime_error("Not a binary design file");
+  }
+
+  std::memcpy(&header_, file_->data(), sizeof(header_));
+  if (header_.formatVersion != BINARY_DESIGN_VERSION) {
+    throw std::runtime_error("Unsupported binary design version: " + std::to_string(header_.formatVersion));
+  }
+
+  // Every table and the string section must fill the file exactly
+  stringsOffset_ = sizeof(BinaryDesignHeader) + header_.shapeCount * sizeof(BinaryShapeRecord) +
+                   header_.imageCount * sizeof(BinaryImageRecord);
+  if (header_.stringBytes > file_->size() || file_->size() - header_.stringBytes != stringsOffset_) {
+    throw std::runtime_error("Binary design file is truncated or corrupt");
+  }
+  for (size_t i = 0; i < BINARY_DESIGN_METADATA_FIELDS; ++i) {
+    if (!validRef(header_.metadata[i], header_.stringBytes)) {
+      throw std::runtime_error("Binary design metadata is out of range");
+    }
+  }
+  const unsigned char* images = file_->data() + sizeof(BinaryDesignHeader) +
+                                header_.shapeCount * sizeof(BinaryShapeRecord);
+  for (size_t i = 0; i < header_.imageCount; ++i) {
+    BinaryImageRecord record;
+    std::memcpy(&record, images + i * sizeof(BinaryImageRecord), sizeof(record));
+    if (!validRef(record.id, header_.stringBytes) || !validRef(record.data, header_.stringBytes)) {
+      throw std::runtime_error("Binary design image " + std::to_string(i) + " is out of range");
+    }
+  }
+}
+
+bool BinaryDesignReader::isBinaryDesign(const Utils::MappedFile& file) {
+  return file.size() >= sizeof(BINARY_DESIGN_MAGIC) &&
+         std::memcmp(file.data(), BINARY_DESIGN_MAGIC, sizeof(BINARY_DESIGN_MAGIC)) == 0;
+}
+
+BinaryShapeRecord BinaryDesignReader::shapeRecord(size_t index) const {
+  if (index >= shapeCount()) {
+    throw std::out_of_range("Binary design shape index out of range");
+  }
+  BinaryShapeRecord record;
+  std::memcpy(&record, file_->data() + sizeof(BinaryDesignHeader) + index * sizeof(BinaryShapeRecord),
+              sizeof(record));
+  return record;
+}
+
+BackgroundImage BinaryDesignReader::image(size_t index) const {
+  if (index >= imageCount()) {
+    throw std::out_of_range("Binary design image index out of range");
+  }
+  BinaryImageRecord record;
+  std::memcpy(&record,
+              file_->data() + sizeof(BinaryDesignHeader) + shapeCount() * sizeof(BinaryShapeRecord) +
+                  index * sizeof(BinaryImageRecord),
+              sizeof(record));
+
+  BackgroundImage image;
+  image.id = readString(record.id);
+  image.position = Geometry::Point2D(record.positionX, record.positionY);
+  image.rotation = record.rotation;
+  image.scale = record.scale;
+  image.opacity = record.opacity;
+  image.naturalWidth = record.naturalWidth;
+  image.naturalHeight = record.naturalHeight;
+  image.imageSource = file_;
+  image.imageDataOffset = static_cast<size_t>(stringsOffset_ + record.data.offset);
+  image.imageDataLength = static_cast<size_t>(record.data.length);
+  image.imageDataIsJson = false;
+  return image;
+}
+
+DesignMetadata BinaryDesignReader::metadata() const {
+  DesignMetadata metadata;
+  Optional<std::string>* fields[BINARY_DESIGN_METADATA_FIELDS] = {&metadata.name, &metadata.author, &metadata.created,
+                                                                  &metadata.modified, &metadata.description};
+  for (size_t i = 0; i < BINARY_DESIGN_METADATA_FIELDS; ++i) {
+    if (header_.metadataPresent & (1u << i)) {
+      *fields[i] = readString(header_.metadata[i]);
+    }
+  }
+  return metadata;
+}
+
+std::unique_ptr<Geometry::Shape> BinaryDesignReader::createShape(size_t index, const Adapters::ILogger* logger) const {
+  try {
+    return Geometry::ShapeFactory::createFromSpec(shapeSpec(shapeRecord(index)), logger);
+  } catch (const std::exception& e) {
+    throw std::runtime_error("Failed to read shape: Shape " + std::to_string(index) + ": " + e.what());
+  }
+}
+
+void BinaryDesignReader::read(DesignParseHandler& handler, const Adapters::ILogger* logger) const {
+  handler.onMetadata(metadata());
+  for (size_t i = 0; i < shapeCount(); ++i) {
+    // The type field is read alone so rejected shapes are never built
+    if (handler.acceptsShape(shapeTypeName(shapeRecord(i).type))) {
+      handler.onShape(createShape(i, logger), i);
+    }
+  }
+  for (size_t i = 0; i < imageCount(); ++i) {
+    handler.onBackgroundImage(image(i));
+  }
+}
+
+DesignFile BinaryDesignReader::readAll(const Adapters::ILogger* logger) const {
+  DesignFile design;
+  design.version = "2.0";
+  design.metadata = metadata();
+
+  std::vector<Geometry::ShapeSpec> specs;
+  specs.reserve(shapeCount());
+  for (size_t i = 0; i < shapeCount(); ++i) {
+    specs.push_back(shapeSpec(shapeRecord(i)));
+  }
+  try {
+    std::vector<std::unique_ptr<Geometry::Shape>> shapes = Geometry::ShapeFactory::createShapes(specs, 0, logger);
+    design.shapes.assign(std::make_move_iterator(shapes.begin()), std::make_move_iterator(shapes.end()));
+  } catch (const std::exception& e) {
+    throw std::runtime_error("Failed to read shape: " + std::string(e.what()));
+  }
+  if (design.shapes.empty()) {
+    throw std::runtime_error("Design file must contain at least one shape");
+  }
+
+  for (size_t i = 0; i < imageCount(); ++i) {
+    design.backgroundImages.push_back(image(i));
+  }
+  return design;
+}
+
+std::string BinaryDesignReader::readString(const BinaryStringRef& ref) const {
+  return std::string(file_->chars() + stringsOffset_ + ref.offset, static_cast<size_t>(ref.length));
+}
+
+}  // namespace Parsers
+}  // namespace ChipCarving
@@ -0,0 +1,202 @@
+/**
+ * BinaryDesignWriter.cpp
+ *
+ * Writing binary design files, JSON conversion and the binary design cache
+ * Split from BinaryDesign.cpp for maintainability
+ */
+
+#include <sys/stat.h>
+
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <stdexcept>
+#include <vector>
+
+#include "geometry/Leaf.h"
+#include "geometry/TriArc.h"
+#include "parsers/BinaryDesign.h"
+#include "utils/MappedFile.h"
+
+namespace ChipCarving {
+namespace Parsers {
+
+namespace {
+
+uint64_t hashString(const std::string& text) {
+  uint64_t hash = 14695981039346656037ULL;
+  for (unsigned char c : text) {
+    hash ^= c;
+    hash *= 1099511628211ULL;
+  }
+  return hash;
+}
+
+bool statSource(const std::string& path, uint64_t& size, int64_t& modified) {
+  struct stat info {};
+  if (::stat(path.c_str(), &info) != 0) {
+    return false;
+  }
+  size = static_cast<uint64_t>(info.st_size);
+  modified = static_cast<int64_t>(info.st_mtime);
+  return true;
+}
+
+// Appends strings to the string section and returns their ranges
+class StringSection {
+ public:
+  BinaryStringRef add(const std::string& text) {
+    BinaryStringRef ref{bytes_.size(), text.size()};
+    bytes_ += text;
+    return ref;
+  }
+
+  const std::string& bytes() const {
+    return bytes_;
+  }
+
+ private:
+  std::string bytes_{};
+};
+
+BinaryShapeRecord shapeRecord(const Geometry::Shape& shape, size_t index) {
+  BinaryShapeRecord record{};
+  if (const auto* leaf = dynamic_cast<const Geometry::Leaf*>(&shape)) {
+    record.type = static_cast<uint32_t>(BinaryShapeType::Leaf);
+    record.vertices[0][0] = leaf->getFocus1().x;
+    record.vertices[0][1] = leaf->getFocus1().y;
+    record.vertices[1][0] = leaf->getFocus2().x;
+    record.vertices[1][1] = leaf->getFocus2().y;
+    record.radius = leaf->getRadius();
+    return record;
+  }
+  if (const auto* triArc = dynamic_cast<const Geometry::TriArc*>(&shape)) {
+    record.type = static_cast<uint32_t>(BinaryShapeType::TriArc);
+    std::vector<Geometry::Point2D> corners = triArc->getVertices();
+    for (size_t i = 0; i < 3 && i < corners.size(); ++i) {
+      record.vertices[i][0] = corners[i].x;
+      record.vertices[i][1] = corners[i].y;
+      record.curvatures[i] = triArc->getBulgeFactors()[i];
+    }
+    return record;
+  }
+  throw std::runtime_error("Shape " + std::to_string(index) + " cannot be stored in a binary design");
+}
+
+}  // namespace
+
+bool writeBinaryDesign(const DesignFile& design, const std::string& path, const std::string& sourcePath) {
+  BinaryDesignHeader header{};
+  std::memcpy(header.magic, BINARY_DESIGN_MAGIC, sizeof(BINARY_DESIGN_MAGIC));
+  header.formatVersion = BINARY_DESIGN_VERSION;
+  if (!sourcePath.empty() && !statSource(sourcePath, header.sourceSize, header.sourceModified)) {
+    return false;
+  }
+
+  StringSection strings;
+  const Optional<std::string>* fields[BINARY_DESIGN_METADATA_FIELDS] = {
+      &design.metadata.name, &design.metadata.author, &design.metadata.created, &design.metadata.modified,
+      &design.metadata.description};
+  for (size_t i = 0; i < BINARY_DESIGN_METADATA_FIELDS; ++i) {
+    if (fields[i]->has_value()) {
+      header.metadataPresent |= 1u << i;
+      header.metadata[i] = strings.add(fields[i]->value());
+    }
+  }
+
+  std::vector<BinaryShapeRecord> shapes;
+  shapes.reserve(design.shapes.size());
+  for (size_t i = 0; i < design.shapes.size(); ++i) {
+    if (design.shapes[i]) {
+      shapes.push_back(shapeRecord(*design.shapes[i], i));
+    }
+  }
+
+  std::vector<BinaryImageRecord> images;
+  for (const auto& image : design.backgroundImages) {
+    BinaryImageRecord record{};
+    record.id = strings.add(image.id);
+    record.data = strings.add(image.loadImageData());
+    record.positionX = image.position.x;
+    record.positionY = image.position.y;
+    record.rotation = image.rotation;
+    record.scale = image.scale;
+    record.opacity = image.opacity;
+    record.naturalWidth = image.naturalWidth;
+    record.naturalHeight = image.naturalHeight;
+    images.push_back(record);
+  }
+
+  header.shapeCount = static_cast<uint32_t>(shapes.size());
+  header.imageCount = static_cast<uint32_t>(images.size());
+  header.stringBytes = strings.bytes().size();
+
+  std::string tempPath = path + ".tmp";
+  {
+    std::ofstream out(tempPath, std::ios::binary | std::ios::trunc);
+    if (!out) {
+      return false;
+    }
+
+    out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    out.write(reinterpret_cast<const char*>(shapes.data()),
+              static_cast<std::streamsize>(shapes.size() * sizeof(BinaryShapeRecord)));
+    out.write(reinterpret_cast<const char*>(images.data()),
+              static_cast<std::streamsize>(images.size() * sizeof(BinaryImageRecord)));
+    out.write(strings.bytes().data(), static_cast<std::streamsize>(strings.bytes().size()));
+
+    if (!out) {
+      out.close();
+      std::remove(tempPath.c_str());
+      return false;
+    }
+  }
+
+  // rename() does not replace an existing file on Windows
+  std::remove(path.c_str());
+  if (std::rename(tempPath.c_str(), path.c_str()) != 0) {
+    std::remove(tempPath.c_str());
+    return false;
+  }
+  return true;
+}
+
+bool convertDesignToBinary(const std::string& jsonPath, const std::string& binaryPath) {
+  DesignParseOptions options;
+  options.deferBackgroundImageData = true;
+  return writeBinaryDesign(DesignParser::parseFromFile(jsonPath, options), binaryPath, jsonPath);
+}
+
+std::string binaryDesignCachePath(const std::string& directory, const std::string& jsonPath) {
+  char name[32];
+  std::snprintf(name, sizeof(name), "%016llx.ccdb", static_cast<unsigned long long>(hashString(jsonPath)));
+  if (directory.empty() || directory.back() == '/' || directory.back() == '\\') {
+    return directory + name;
+  }
+  return directory + "/" + name;
+}
+
+std::unique_ptr<BinaryDesignReader> openFreshBinaryDesign(const std::string& cachePath, const std::string& jsonPath) {
+  uint64_t size = 0;
+  int64_t modified = 0;
+  if (!statSource(jsonPath, size, modified)) {
+    return nullptr;
+  }
+
+  auto file = std::make_shared<const Utils::MappedFile>(cachePath);
+  if (!file->isOpen() || !BinaryDesignReader::isBinaryDesign(*file)) {
+    return nullptr;
+  }
+  try {
+    auto reader = std::make_unique<BinaryDesignReader>(file);
+    if (reader->sourceSize() != size || reader->sourceModified() != modified) {
+      return nullptr;
+    }
+    return reader;
+  } catch (const std::exception&) {
+    return nullptr;  // Stale format or corrupt entry; the caller parses the JSON again
+  }
+}
+
+}  // namespace Parsers
+}  // namespace ChipCarving
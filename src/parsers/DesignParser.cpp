@@ -4,259 +4,337 @@
 
 #include "parsers/DesignParser.h"
 
-#include <fstream>
-#include <regex>
-#include <sstream>
+#include <iterator>
+#include <memory>
 #include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
 
 #include "adapters/IFusionInterface.h"
 #include "geometry/ShapeFactory.h"
+#include "parsers/BinaryDesign.h"
+#include "parsers/JsonReader.h"
+#include "utils/MappedFile.h"
+#include "utils/MonotonicArena.h"
 
-using ChipCarving::Geometry::Point2D;
 using ChipCarving::Geometry::Shape;
 using ChipCarving::Geometry::ShapeFactory;
 using ChipCarving::Parsers::BackgroundImage;
+using ChipCarving::Parsers::BinaryDesignReader;
 using ChipCarving::Parsers::DesignFile;
 using ChipCarving::Parsers::DesignMetadata;
+using ChipCarving::Parsers::DesignParseHandler;
+using ChipCarving::Parsers::DesignParseOptions;
 using ChipCarving::Parsers::DesignParser;
-
-DesignFile DesignParser::parseFromFile(const std::string& filePath, const Adapters::ILogger* logger) {
-  std::ifstream file(filePath);
-  if (!file.is_open()) {
-    throw std::runtime_error("Failed to open file: " + filePath);
+using ChipCarving::Parsers::DesignShape;
+using ChipCarving::Parsers::JsonReader;
+using ChipCarving::Parsers::ShapeDeleter;
+using ChipCarving::Utils::MappedFile;
+using ChipCarving::Utils::MonotonicArena;
+
+namespace {
+
+constexpr const char* SUPPORTED_VERSION = "2.0";
+
+// Optional fields of the wrong type are skipped rather than rejected, as before
+void readOptionalString(JsonReader& reader, ChipCarving::Optional<std::string>& field) {
+  if (reader.peekType() == JsonReader::ValueType::String) {
+    field = reader.readString();
+  } else {
+    reader.skipValue();
   }
+}
 
-  std::stringstream buffer;
-  buffer << file.rdbuf();
-  std::string jsonContent = buffer.str();
+void readOptionalString(JsonReader& reader, std::string& field) {
+  if (reader.peekType() == JsonReader::ValueType::String) {
+    reader.readString(field);
+  } else {
+    reader.skipValue();
+  }
+}
 
-  // Debug logging disabled for performance
-  // if (logger) {
-  //     logger->logDebug("Loaded " + std::to_string(jsonContent.length()) +
-  //                      " characters from file");
-  // }
+void readOptionalNumber(JsonReader& reader, double& field) {
+  if (reader.peekType() == JsonReader::ValueType::Number) {
+    field = reader.readNumber();
+  } else {
+    reader.skipValue();
+  }
+}
 
-  return parseFromString(jsonContent, logger);
+void checkVersion(const std::string& version) {
+  if (version != SUPPORTED_VERSION) {
+    throw std::runtime_error("Unsupported schema version: " + version + ". Expected version 2.0");
+  }
 }
 
-DesignFile DesignParser::parseFromString(const std::string& jsonContent, const Adapters::ILogger* logger) {
-  DesignFile design;
+// Collects a document's members into a DesignFile
+class DesignFileBuilder : public DesignParseHandler {
+ public:
+  explicit DesignFileBuilder(DesignFile& design) : design_(design) {}
 
-  // Parse version
-  design.version = extractString(jsonContent, "version");
-  if (design.version != "2.0") {
-    throw std::runtime_error("Unsupported schema version: " + design.version + ". Expected version 2.0");
+  void onMetadata(const DesignMetadata& metadata) override {
+    design_.metadata = metadata;
   }
 
-  // Parse metadata (optional)
-  try {
-    design.metadata = parseMetadata(jsonContent);
-  } catch (const std::exception& e) {
-    (void)e;  // Metadata is optional, continue if not found
+  void onShape(std::unique_ptr<Shape> shape, size_t index) override {
+    (void)index;
+    design_.shapes.push_back(std::move(shape));
   }
 
-  // Parse shapes (required)
-  design.shapes = parseShapes(jsonContent, logger);
-  if (design.shapes.empty()) {
-    throw std::runtime_error("Design file must contain at least one shape");
+  void onBackgroundImage(BackgroundImage image) override {
+    design_.backgroundImages.push_back(std::move(image));
   }
 
-  // Parse background images (optional)
-  try {
-    design.backgroundImages = parseBackgroundImages(jsonContent);
-  } catch (const std::exception& e) {
-    (void)e;  // Background images are optional, continue if not found
-  }
+ private:
+  DesignFile& design_;
+};
 
-  return design;
+}  // namespace
+
+DesignFile DesignParser::parseFromFile(const std::string& filePath, const Adapters::ILogger* logger) {
+  return parseFromFile(filePath, DesignParseOptions(), logger);
 }
 
-bool DesignParser::validateSchema(const std::string& jsonContent) {
-  try {
-    // Basic validation - check for required fields
-    std::string version = extractString(jsonContent, "version");
-    if (version != "2.0") {
-      return false;
-    }
+DesignFile DesignParser::parseFromFile(const std::string& filePath, const DesignParseOptions& options,
+                                       const Adapters::ILogger* logger) {
+  // Parse straight out of the mapping; no copy of the file contents is made
+  auto file = std::make_shared<const MappedFile>(filePath);
+  if (!file->isOpen()) {
+    throw std::runtime_error("Failed to open file: " + filePath);
+  }
+  if (BinaryDesignReader::isBinaryDesign(*file)) {
+    return BinaryDesignReader(file).readAll(logger);
+  }
 
-    // Try to parse shapes array
-    std::string shapesArray = extractArray(jsonContent, "shapes");
-    if (shapesArray.empty()) {
-      return false;
+  // An unchanged JSON file is read from its binary copy
+  std::string cachePath;
+  if (!options.binaryCacheDirectory.empty()) {
+    cachePath = binaryDesignCachePath(options.binaryCacheDirectory, filePath);
+    if (auto cached = openFreshBinaryDesign(cachePath, filePath)) {
+      return cached->readAll(logger);
     }
+  }
 
-    return true;
-  } catch (const std::exception&) {
-    return false;
+  std::unique_ptr<JsonInput> compressed = openCompressedInput(file, filePath);
+  std::unique_ptr<JsonReader> reader = compressed ? std::make_unique<JsonReader>(*compressed)
+                                                  : std::make_unique<JsonReader>(file->chars(), file->size());
+  DesignFile design = parse(*reader, options.deferBackgroundImageData && !compressed ? file : nullptr,
+                            options.arenaAllocation, logger);
+  if (!cachePath.empty() && !writeBinaryDesign(design, cachePath, filePath) && logger) {
+    logger->logWarning("Could not write binary design cache " + cachePath);
   }
+  return design;
 }
 
-DesignMetadata DesignParser::parseMetadata(const std::string& jsonContent) {
-  DesignMetadata metadata;
+DesignFile DesignParser::parseFromString(const std::string& jsonContent, const Adapters::ILogger* logger) {
+  return parseFromString(jsonContent, DesignParseOptions(), logger);
+}
 
-  try {
-    std::string metadataJson = extractObject(jsonContent, "metadata");
+DesignFile DesignParser::parseFromString(const std::string& jsonContent, const DesignParseOptions& options,
+                                         const Adapters::ILogger* logger) {
+  JsonReader reader(jsonContent);
+  return parse(reader, nullptr, options.arenaAllocation, logger);
+}
 
-    try {
-      metadata.name = extractString(metadataJson, "name");
-    } catch (const std::exception& e) {
-      (void)e;  // Optional field - continue without logging
-    }
-    try {
-      metadata.author = extractString(metadataJson, "author");
-    } catch (const std::exception& e) {
-      (void)e;  // Optional field - continue without logging
-    }
-    try {
-      metadata.created = extractString(metadataJson, "created");
-    } catch (const std::exception& e) {
-      (void)e;  // Optional field - continue without logging
-    }
-    try {
-      metadata.modified = extractString(metadataJson, "modified");
-    } catch (const std::exception& e) {
-      (void)e;  // Optional field - continue without logging
-    }
-    try {
-      metadata.description = extractString(metadataJson, "description");
-    } catch (const std::exception& e) {
-      (void)e;  // Optional field - continue without logging
+DesignFile DesignParser::parse(JsonReader& reader, const std::shared_ptr<const MappedFile>& source,
+                               bool arenaAllocation, const Adapters::ILogger* logger) {
+  // Whole-file parses build every shape at once, in parallel for large designs unless into an arena
+  DesignFile design;
+  DesignFileBuilder builder(design);
+  parseDocument(reader, source, builder, logger, &design.shapes,
+                arenaAllocation ? std::make_shared<MonotonicArena>() : nullptr);
+  design.version = SUPPORTED_VERSION;
+  return design;
+}
+
+void DesignParser::parseDocument(JsonReader& reader, const std::shared_ptr<const MappedFile>& source,
+                                 DesignParseHandler& handler, const Adapters::ILogger* logger,
+                                 std::vector<DesignShape>* batchShapes,
+                                 const std::shared_ptr<MonotonicArena>& arena) {
+  bool hasVersion = false;
+  size_t shapeCount = 0;
+
+  std::string key;
+  std::string version;
+  reader.beginObject();
+  while (reader.nextMember(key)) {
+    if (key == "version") {
+      // Checked as soon as it is seen so unsupported files fail before shape parsing
+      reader.readString(version);
+      checkVersion(version);
+      hasVersion = true;
+    } else if (key == "metadata") {
+      handler.onMetadata(parseMetadata(reader));
+    } else if (key == "shapes" && batchShapes) {
+      *batchShapes = arena ? parseShapes(reader, arena, logger) : parseShapes(reader, logger);
+      shapeCount = batchShapes->size();
+    } else if (key == "shapes") {
+      shapeCount = streamShapes(reader, handler, logger);
+    } else if (key == "backgroundImages") {
+      parseBackgroundImages(reader, source, handler);
+    } else {
+      reader.skipValue();
     }
-  } catch (const std::exception& e) {
-    (void)e;  // Metadata section not found or invalid
   }
+  reader.expectEnd();
 
-  return metadata;
+  if (!hasVersion) {
+    throw std::runtime_error("Design file has no schema version. Expected version 2.0");
+  }
+  if (shapeCount == 0) {
+    throw std::runtime_error("Design file must contain at least one shape");
+  }
 }
 
-std::vector<std::unique_ptr<Shape>> DesignParser::parseShapes(const std::string& jsonContent,
-                                                              const Adapters::ILogger* logger) {
-  std::vector<std::unique_ptr<Shape>> shapes;
+bool DesignParser::validateSchema(const std::string& jsonContent) {
+  try {
+    // Basic validation - version and a non-empty shapes array, without building shapes
+    std::string version;
+    size_t shapeCount = 0;
+
+    JsonReader reader(jsonContent);
+    std::string key;
+    reader.beginObject();
+    while (reader.nextMember(key)) {
+      if (key == "version") {
+        reader.readString(version);
+      } else if (key == "shapes") {
+        reader.beginArray();
+        while (reader.nextElement()) {
+          reader.skipValue();
+          ++shapeCount;
+        }
+      } else {
+        reader.skipValue();
+      }
+    }
+    reader.expectEnd();
 
-  std::string shapesArray = extractArray(jsonContent, "shapes");
+    return version == SUPPORTED_VERSION && shapeCount > 0;
+  } catch (const std::exception&) {
+    return false;
+  }
+}
 
-  // Extract individual shape objects from array
-  std::regex shapeRegex(R"(\{[^\{\}]*(?:\{[^\{\}]*\}[^\{\}]*)*\})");
-  std::sregex_iterator iter(shapesArray.begin(), shapesArray.end(), shapeRegex);
-  std::sregex_iterator end;
+DesignMetadata DesignParser::parseMetadata(JsonReader& reader) {
+  DesignMetadata metadata;
+  if (reader.peekType() != JsonReader::ValueType::Object) {
+    reader.skipValue();  // Metadata is optional
+    return metadata;
+  }
 
-  for (; iter != end; ++iter) {
-    std::string shapeJson = iter->str();
-    try {
-      auto shape = ShapeFactory::createFromJson(shapeJson, logger);
-      shapes.push_back(std::move(shape));
-    } catch (const std::exception& e) {
-      throw std::runtime_error("Failed to parse shape: " + std::string(e.what()));
+  std::string key;
+  reader.beginObject();
+  while (reader.nextMember(key)) {
+    if (key == "name") {
+      readOptionalString(reader, metadata.name);
+    } else if (key == "author") {
+      readOptionalString(reader, metadata.author);
+    } else if (key == "created") {
+      readOptionalString(reader, metadata.created);
+    } else if (key == "modified") {
+      readOptionalString(reader, metadata.modified);
+    } else if (key == "description") {
+      readOptionalString(reader, metadata.description);
+    } else {
+      reader.skipValue();
     }
   }
 
-  return shapes;
+  return metadata;
 }
 
-std::vector<BackgroundImage> DesignParser::parseBackgroundImages(const std::string& jsonContent) {
-  std::vector<BackgroundImage> images;
-
+std::vector<DesignShape> DesignParser::parseShapes(JsonReader& reader, const Adapters::ILogger* logger) {
+  // The reader is sequential; validation and arc geometry run in parallel afterwards
+  std::vector<Geometry::ShapeSpec> specs;
+  std::vector<std::unique_ptr<Shape>> shapes;
+  reader.beginArray();
   try {
-    std::string imagesArray = extractArray(jsonContent, "backgroundImages");
-
-    // Extract individual image objects from array
-    std::regex imageRegex(R"(\{[^\{\}]*(?:\{[^\{\}]*\}[^\{\}]*)*\})");
-    std::sregex_iterator iter(imagesArray.begin(), imagesArray.end(), imageRegex);
-    std::sregex_iterator end;
-
-    for (; iter != end; ++iter) {
-      std::string imageJson = iter->str();
-      BackgroundImage image;
-
-      image.id = extractString(imageJson, "id");
-      image.imageData = extractString(imageJson, "imageData");
-      image.rotation = extractNumber(imageJson, "rotation");
-      image.scale = extractNumber(imageJson, "scale");
-      image.opacity = extractNumber(imageJson, "opacity");
-      image.naturalWidth = extractNumber(imageJson, "naturalWidth");
-      image.naturalHeight = extractNumber(imageJson, "naturalHeight");
-
-      // Parse position point
-      std::string positionJson = extractObject(imageJson, "position");
-      image.position = parsePoint(positionJson);
-
-      images.push_back(image);
+    while (reader.nextElement()) {
+      specs.push_back(ShapeFactory::readSpec(reader));
     }
+    shapes = ShapeFactory::createShapes(specs, 0, logger);
   } catch (const std::exception& e) {
-    (void)e;  // Background images are optional
+    throw std::runtime_error("Failed to parse shape: " + std::string(e.what()));
   }
-
-  return images;
+  return std::vector<DesignShape>(std::make_move_iterator(shapes.begin()), std::make_move_iterator(shapes.end()));
 }
 
-Point2D DesignParser::parsePoint(const std::string& pointJson) {
-  double x = extractNumber(pointJson, "x");
-  double y = extractNumber(pointJson, "y");
-  return Point2D(x, y);
-}
-
-std::string DesignParser::extractString(const std::string& json, const std::string& key) {
-  std::regex regex("\"" + key + "\"\\s*:\\s*\"([^\"]+)\"");
-  std::smatch match;
-
-  if (std::regex_search(json, match, regex)) {
-    return match[1].str();
+std::vector<DesignShape> DesignParser::parseShapes(JsonReader& reader,
+                                                   const std::shared_ptr<MonotonicArena>& arena,
+                                                   const Adapters::ILogger* logger) {
+  // One spec is reused and every shape lands in the arena, so only the arena's blocks and the
+  // shape vector's growth allocate
+  Geometry::ShapeSpec spec;
+  std::vector<DesignShape> shapes;
+  reader.beginArray();
+  while (reader.nextElement()) {
+    try {
+      ShapeFactory::readSpec(reader, spec);
+      shapes.emplace_back(ShapeFactory::createFromSpec(spec, *arena, logger), ShapeDeleter(arena));
+    } catch (const std::exception& e) {
+      throw std::runtime_error("Failed to parse shape: Shape " + std::to_string(shapes.size()) + ": " + e.what());
+    }
   }
-
-  throw std::runtime_error("String key '" + key + "' not found in JSON");
+  return shapes;
 }
 
-double DesignParser::extractNumber(const std::string& json, const std::string& key) {
-  std::regex regex("\"" + key + "\"\\s*:\\s*([-+]?[0-9]*\\.?[0-9]+)");
-  std::smatch match;
-
-  if (std::regex_search(json, match, regex)) {
-    return std::stod(match[1].str());
+void DesignParser::parseBackgroundImages(JsonReader& reader, const std::shared_ptr<const MappedFile>& source,
+                                         DesignParseHandler& handler) {
+  if (reader.peekType() != JsonReader::ValueType::Array) {
+    reader.skipValue();  // Background images are optional
+    return;
   }
 
-  throw std::runtime_error("Number key '" + key + "' not found in JSON");
-}
-
-std::string DesignParser::extractArray(const std::string& json, const std::string& key) {
-  std::regex regex("\"" + key + "\"\\s*:\\s*\\[([^\\[\\]]*(?:\\[[^\\[\\]]*\\][^\\[\\]]*)*)\\]");
-  std::smatch match;
+  std::string key;
+  reader.beginArray();
+  while (reader.nextElement()) {
+    if (reader.peekType() != JsonReader::ValueType::Object) {
+      reader.skipValue();
+      continue;
+    }
 
-  if (std::regex_search(json, match, regex)) {
-    return match[1].str();
+    BackgroundImage image;
+    reader.beginObject();
+    while (reader.nextMember(key)) {
+      if (key == "id") {
+        readOptionalString(reader, image.id);
+      } else if (key == "imageData" && source && reader.peekType() == JsonReader::ValueType::String) {
+        // Only the token bounds are recorded; loadImageData() decodes on demand
+        reader.skipString(image.imageDataOffset, image.imageDataLength);
+        image.imageSource = source;
+      } else if (key == "imageData") {
+        readOptionalString(reader, image.imageData);
+      } else if (key == "rotation") {
+        readOptionalNumber(reader, image.rotation);
+      } else if (key == "scale") {
+        readOptionalNumber(reader, image.scale);
+      } else if (key == "opacity") {
+        readOptionalNumber(reader, image.opacity);
+      } else if (key == "naturalWidth") {
+        readOptionalNumber(reader, image.naturalWidth);
+      } else if (key == "naturalHeight") {
+        readOptionalNumber(reader, image.naturalHeight);
+      } else if (key == "position" && reader.peekType() == JsonReader::ValueType::Object) {
+        image.position = Parsers::readPoint(reader);
+      } else {
+        reader.skipValue();
+      }
+    }
+    handler.onBackgroundImage(std::move(image));
   }
-
-  throw std::runtime_error("Array key '" + key + "' not found in JSON");
 }
 
-std::string DesignParser::extractObject(const std::string& json, const std::string& key) {
-  // Find the key and then extract the matching braces
-  std::string pattern = "\"" + key + "\"\\s*:\\s*\\{";
-  std::regex startRegex(pattern);
-  std::smatch match;
-
-  if (!std::regex_search(json, match, startRegex)) {
-    throw std::runtime_error("Object key '" + key + "' not found in JSON");
+std::string BackgroundImage::loadImageData() const {
+  if (!imageSource) {
+    return imageData;
   }
-
-  // Find the start of the object
-  size_t start = match.position() + match.length() - 1;  // Position of opening brace
-  size_t braceCount = 1;
-  size_t pos = start + 1;
-
-  // Find matching closing brace
-  while (pos < json.length() && braceCount > 0) {
-    if (json[pos] == '{') {
-      braceCount++;
-    } else if (json[pos] == '}') {
-      braceCount--;
-    }
-    pos++;
+  if (!imageDataIsJson) {
+    return std::string(imageSource->chars() + imageDataOffset, imageDataLength);
   }
-
-  if (braceCount != 0) {
-    throw std::runtime_error("Malformed JSON object for key '" + key + "'");
-  }
-
-  // Extract the object content (without outer braces)
-  return json.substr(start + 1, pos - start - 2);
+  JsonReader reader(imageSource->chars() + imageDataOffset, imageDataLength);
+  std::string data = reader.readString();
+  reader.expectEnd();
+  return data;
 }
@@ -0,0 +1,129 @@
+/**
+ * DesignParserStream.cpp
+ *
+ * Streaming DesignParser entry points that hand each member to a DesignParseHandler,
+ * and decompressing input for gzip-compressed design files
+ * Split from DesignParser.cpp for maintainability
+ */
+
+#include <cstring>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <utility>
+
+#include "geometry/ShapeFactory.h"
+#include "parsers/BinaryDesign.h"
+#include "parsers/DesignParser.h"
+#include "parsers/JsonReader.h"
+#include "utils/Inflate.h"
+#include "utils/MappedFile.h"
+
+namespace ChipCarving {
+namespace Parsers {
+
+namespace {
+
+// Largest decoded deflate block accepted; real encoders emit blocks of well under a megabyte
+constexpr size_t MAX_DECOMPRESSED_BLOCK = 64 * 1024 * 1024;
+
+constexpr unsigned char ZSTD_MAGIC[4] = {0x28, 0xB5, 0x2F, 0xFD};
+
+// Feeds a JsonReader a gzip-compressed mapped file one deflate block at a time
+class GzipJsonInput : public JsonInput {
+ public:
+  GzipJsonInput(std::shared_ptr<const Utils::MappedFile> file, std::string filePath)
+      : file_(std::move(file)),
+        filePath_(std::move(filePath)),
+        gzip_(file_->data(), file_->size(), MAX_DECOMPRESSED_BLOCK) {}
+
+  bool next(const char*& data, size_t& size) override {
+    const unsigned char* block = nullptr;
+    if (!gzip_.next(block, size)) {
+      if (gzip_.failed()) {
+        throw std::runtime_error("Corrupt gzip data in " + filePath_);
+      }
+      return false;
+    }
+    data = reinterpret_cast<const char*>(block);
+    return true;
+  }
+
+ private:
+  std::shared_ptr<const Utils::MappedFile> file_;
+  std::string filePath_;
+  Utils::GzipReader gzip_;
+};
+
+}  // namespace
+
+void DesignParser::parseFromString(const std::string& jsonContent, DesignParseHandler& handler,
+                                   const Adapters::ILogger* logger) {
+  JsonReader reader(jsonContent);
+  parseDocument(reader, nullptr, handler, logger, nullptr);
+}
+
+void DesignParser::parseFromFile(const std::string& filePath, const DesignParseOptions& options,
+                                 DesignParseHandler& handler, const Adapters::ILogger* logger) {
+  auto file = std::make_shared<const Utils::MappedFile>(filePath);
+  if (!file->isOpen()) {
+    throw std::runtime_error("Failed to open file: " + filePath);
+  }
+  if (BinaryDesignReader::isBinaryDesign(*file)) {
+    BinaryDesignReader(file).read(handler, logger);
+    return;
+  }
+  if (!options.binaryCacheDirectory.empty()) {
+    auto cached = openFreshBinaryDesign(binaryDesignCachePath(options.binaryCacheDirectory, filePath), filePath);
+    if (cached) {
+      cached->read(handler, logger);
+      return;
+    }
+  }
+
+  if (auto compressed = openCompressedInput(file, filePath)) {
+    JsonReader reader(*compressed);
+    parseDocument(reader, nullptr, handler, logger, nullptr);
+    return;
+  }
+  JsonReader reader(file->chars(), file->size());
+  parseDocument(reader, options.deferBackgroundImageData ? file : nullptr, handler, logger, nullptr);
+}
+
+std::unique_ptr<JsonInput> DesignParser::openCompressedInput(const std::shared_ptr<const Utils::MappedFile>& file,
+                                                             const std::string& filePath) {
+  if (Utils::GzipReader::isGzip(file->data(), file->size())) {
+    return std::make_unique<GzipJsonInput>(file, filePath);
+  }
+  if (file->size() >= sizeof(ZSTD_MAGIC) && std::memcmp(file->data(), ZSTD_MAGIC, sizeof(ZSTD_MAGIC)) == 0) {
+    throw std::runtime_error("Zstandard-compressed design files are not supported; recompress " + filePath +
+                             " with gzip");
+  }
+  return nullptr;
+}
+
+size_t DesignParser::streamShapes(JsonReader& reader, DesignParseHandler& handler, const Adapters::ILogger* logger) {
+  // One spec is reused for every shape, so rejected types cost no allocations
+  Geometry::ShapeSpec spec;
+  size_t index = 0;
+  reader.beginArray();
+  while (reader.nextElement()) {
+    std::unique_ptr<Geometry::Shape> shape;
+    try {
+      Geometry::ShapeFactory::readSpec(reader, spec);
+      if (handler.acceptsShape(spec.type)) {
+        shape = Geometry::ShapeFactory::createFromSpec(spec, logger);
+      }
+    } catch (const std::exception& e) {
+      throw std::runtime_error("Failed to parse shape: Shape " + std::to_string(index) + ": " + e.what());
+    }
+    if (shape) {
+      handler.onShape(std::move(shape), index);
+    }
+    ++index;
+  }
+  return index;
+}
+
+}  // namespace Parsers
+}  // namespace ChipCarving
@@ -0,0 +1,288 @@
+/**
+ * JsonReader.cpp
+ *
+ * Single-pass JSON tokenizer used by DesignParser and ShapeFactory
+ * String decoding lives in JsonReaderStrings.cpp
+ */
+
+#include "parsers/JsonReader.h"
+
+#include <cstdlib>
+#include <cstring>
+#include <stdexcept>
+
+using ChipCarving::Geometry::Point2D;
+using ChipCarving::Parsers::JsonReader;
+
+namespace {
+
+// Longest numeric literal accepted (doubles need at most ~25 significant characters)
+constexpr size_t MAX_NUMBER_LENGTH = 64;
+
+bool isNumberChar(char c) {
+  return (c >= '0' && c <= '9') || c == '-' || c == '+' || c == '.' || c == 'e' || c == 'E';
+}
+
+void advanceLineColumn(const char* data, size_t count, size_t& line, size_t& column) {
+  for (size_t i = 0; i < count; ++i) {
+    if (data[i] == '\n') {
+      ++line;
+      column = 1;
+    } else {
+      ++column;
+    }
+  }
+}
+
+}  // namespace
+
+JsonReader::JsonReader(const char* data, size_t size) : data_(data), size_(size) {}
+
+JsonReader::JsonReader(JsonInput& input) : data_(nullptr), size_(0), input_(&input) {
+  data_ = window_.data();
+}
+
+bool JsonReader::refill(size_t* keepFrom) {
+  if (!input_) {
+    return false;
+  }
+  const char* chunk = nullptr;
+  size_t chunkSize = 0;
+  do {
+    if (!input_->next(chunk, chunkSize)) {
+      return false;
+    }
+  } while (chunkSize == 0);
+
+  // Drop what has been read, remembering the line and column it ends at for fail()
+  size_t keep = keepFrom ? *keepFrom : pos_;
+  advanceLineColumn(data_, keep, baseLine_, baseColumn_);
+  window_.erase(0, keep);
+  window_.append(chunk, chunkSize);
+  base_ += keep;
+  pos_ -= keep;
+  if (keepFrom) {
+    *keepFrom = 0;
+  }
+  data_ = window_.data();
+  size_ = window_.size();
+  return true;
+}
+
+bool JsonReader::ensure(size_t count) {
+  while (size_ - pos_ < count) {
+    if (!refill()) {
+      return false;
+    }
+  }
+  return true;
+}
+
+void JsonReader::fail(const std::string& message) const {
+  size_t line = baseLine_;
+  size_t column = baseColumn_;
+  advanceLineColumn(data_, pos_ < size_ ? pos_ : size_, line, column);
+  throw std::runtime_error("JSON error at line " + std::to_string(line) + ", column " + std::to_string(column) + ": " +
+                           message);
+}
+
+void JsonReader::skipWhitespace() {
+  while (pos_ < size_ || refill()) {
+    char c = data_[pos_];
+    if (c != ' ' && c != '\n' && c != '\r' && c != '\t') {
+      return;
+    }
+    ++pos_;
+  }
+}
+
+void JsonReader::expect(char c, const char* what) {
+  skipWhitespace();
+  if (pos_ >= size_ || data_[pos_] != c) {
+    fail(std::string("expected ") + what);
+  }
+  ++pos_;
+}
+
+void JsonReader::expectLiteral(const char* literal) {
+  size_t length = std::strlen(literal);
+  if (!ensure(length) || std::memcmp(data_ + pos_, literal, length) != 0) {
+    fail(std::string("expected '") + literal + "'");
+  }
+  pos_ += length;
+  previous_ = 'v';
+}
+
+JsonReader::ValueType JsonReader::peekType() {
+  skipWhitespace();
+  if (pos_ >= size_) {
+    fail("unexpected end of input");
+  }
+  char c = data_[pos_];
+  switch (c) {
+    case '{':
+      return ValueType::Object;
+    case '[':
+      return ValueType::Array;
+    case '"':
+      return ValueType::String;
+    case 't':
+    case 'f':
+      return ValueType::Boolean;
+    case 'n':
+      return ValueType::Null;
+    default:
+      if (c == '-' || (c >= '0' && c <= '9')) {
+        return ValueType::Number;
+      }
+      fail(std::string("unexpected character '") + c + "'");
+  }
+}
+
+void JsonReader::beginObject() {
+  expect('{', "'{'");
+  previous_ = '{';
+}
+
+bool JsonReader::nextMember(std::string& key) {
+  skipWhitespace();
+  if (pos_ < size_ && data_[pos_] == '}') {
+    ++pos_;
+    previous_ = 'v';
+    return false;
+  }
+  if (previous_ != '{') {
+    expect(',', "',' or '}'");
+    skipWhitespace();
+  }
+  if (pos_ >= size_ || data_[pos_] != '"') {
+    fail("expected member name");
+  }
+  readString(key);
+  expect(':', "':'");
+  return true;
+}
+
+void JsonReader::beginArray() {
+  expect('[', "'['");
+  previous_ = '[';
+}
+
+bool JsonReader::nextElement() {
+  skipWhitespace();
+  if (pos_ < size_ && data_[pos_] == ']') {
+    ++pos_;
+    previous_ = 'v';
+    return false;
+  }
+  if (previous_ != '[') {
+    expect(',', "',' or ']'");
+  }
+  return true;
+}
+
+double JsonReader::readNumber() {
+  if (peekType() != ValueType::Number) {
+    fail("expected number");
+  }
+  size_t start = pos_;
+  while ((pos_ < size_ || refill(&start)) && isNumberChar(data_[pos_])) {
+    ++pos_;
+  }
+  size_t length = pos_ - start;
+  if (length >= MAX_NUMBER_LENGTH) {
+    pos_ = start;
+    fail("number too long");
+  }
+
+  // Copy out so strtod cannot run past the end of a non-terminated buffer
+  char buffer[MAX_NUMBER_LENGTH];
+  std::memcpy(buffer, data_ + start, length);
+  buffer[length] = '\0';
+  char* end = nullptr;
+  double value = std::strtod(buffer, &end);
+  if (end != buffer + length) {
+    pos_ = start;
+    fail("invalid number");
+  }
+  previous_ = 'v';
+  return value;
+}
+
+bool JsonReader::readBoolean() {
+  if (peekType() != ValueType::Boolean) {
+    fail("expected boolean");
+  }
+  bool value = data_[pos_] == 't';
+  expectLiteral(value ? "true" : "false");
+  return value;
+}
+
+void JsonReader::readNull() {
+  if (peekType() != ValueType::Null) {
+    fail("expected null");
+  }
+  expectLiteral("null");
+}
+
+void JsonReader::skipValue() {
+  std::string scratch;
+  size_t tokenOffset = 0;
+  size_t tokenLength = 0;
+  switch (peekType()) {
+    case ValueType::Object:
+      beginObject();
+      while (nextMember(scratch)) {
+        skipValue();
+      }
+      break;
+    case ValueType::Array:
+      beginArray();
+      while (nextElement()) {
+        skipValue();
+      }
+      break;
+    case ValueType::String:
+      skipString(tokenOffset, tokenLength);
+      break;
+    case ValueType::Number:
+      readNumber();
+      break;
+    case ValueType::Boolean:
+      readBoolean();
+      break;
+    case ValueType::Null:
+      readNull();
+      break;
+  }
+}
+
+void JsonReader::expectEnd() {
+  skipWhitespace();
+  if (pos_ < size_) {
+    fail("unexpected content after end of document");
+  }
+}
+
+Point2D ChipCarving::Parsers::readPoint(JsonReader& reader) {
+  bool hasX = false;
+  bool hasY = false;
+  Point2D point;
+  std::string key;
+  reader.beginObject();
+  while (reader.nextMember(key)) {
+    if (key == "x") {
+      point.x = reader.readNumber();
+      hasX = true;
+    } else if (key == "y") {
+      point.y = reader.readNumber();
+      hasY = true;
+    } else {
+      reader.skipValue();
+    }
+  }
+  if (!hasX || !hasY) {
+    reader.fail("point requires both x and y");
+  }
+  return point;
+}
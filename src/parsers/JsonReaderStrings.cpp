@@ -0,0 +1,164 @@
+/**
+ * JsonReaderStrings.cpp
+ *
+ * String token decoding and skipping for JsonReader
+ * Split from JsonReader.cpp for maintainability
+ */
+
+#include <cstring>
+
+#include "parsers/JsonReader.h"
+
+using ChipCarving::Parsers::JsonReader;
+
+namespace {
+
+// Character for one of the \b \f \n \r \t escapes
+char controlEscape(char escape) {
+  return escape == 'b' ? '\b' : escape == 'f' ? '\f' : escape == 'n' ? '\n' : escape == 'r' ? '\r' : '\t';
+}
+
+void appendUtf8(unsigned int codePoint, std::string& out) {
+  if (codePoint < 0x80) {
+    out.push_back(static_cast<char>(codePoint));
+    return;
+  }
+  // Lead byte encodes the sequence length; continuation bytes carry 6 bits each
+  static const unsigned int LEAD_BYTES[] = {0x00, 0xC0, 0xE0, 0xF0};
+  int continuation = codePoint < 0x800 ? 1 : codePoint < 0x10000 ? 2 : 3;
+  out.push_back(static_cast<char>(LEAD_BYTES[continuation] | (codePoint >> (6 * continuation))));
+  for (int shift = 6 * (continuation - 1); shift >= 0; shift -= 6) {
+    out.push_back(static_cast<char>(0x80 | ((codePoint >> shift) & 0x3F)));
+  }
+}
+
+}  // namespace
+
+std::string JsonReader::readString() {
+  std::string out;
+  readString(out);
+  return out;
+}
+
+void JsonReader::readString(std::string& out) {
+  expect('"', "string");
+  out.clear();
+  while (true) {
+    // Copy the run up to the next quote or escape in one append
+    size_t runStart = pos_;
+    while (pos_ < size_ && data_[pos_] != '"' && data_[pos_] != '\\') {
+      if (static_cast<unsigned char>(data_[pos_]) < 0x20) {
+        fail("control character in string");
+      }
+      ++pos_;
+    }
+    out.append(data_ + runStart, pos_ - runStart);
+    if (pos_ >= size_) {
+      if (refill()) {
+        continue;
+      }
+      fail("unterminated string");
+    }
+    if (data_[pos_++] == '"') {
+      break;
+    }
+
+    if (pos_ >= size_ && !refill()) {
+      fail("unterminated string");
+    }
+    char escape = data_[pos_++];
+    switch (escape) {
+      case '"':
+      case '\\':
+      case '/':
+        out.push_back(escape);
+        break;
+      case 'b':
+      case 'f':
+      case 'n':
+      case 'r':
+      case 't':
+        out.push_back(controlEscape(escape));
+        break;
+      case 'u': {
+        unsigned int codePoint = readHex4();
+        if (codePoint >= 0xD800 && codePoint <= 0xDBFF) {
+          // High surrogate; combine with the low surrogate that must follow
+          if (!ensure(2) || data_[pos_] != '\\' || data_[pos_ + 1] != 'u') {
+            fail("unpaired surrogate in string");
+          }
+          pos_ += 2;
+          unsigned int low = readHex4();
+          if (low < 0xDC00 || low > 0xDFFF) {
+            fail("unpaired surrogate in string");
+          }
+          codePoint = 0x10000 + ((codePoint - 0xD800) << 10) + (low - 0xDC00);
+        }
+        appendUtf8(codePoint, out);
+        break;
+      }
+      default:
+        --pos_;
+        fail(std::string("invalid escape '\\") + escape + "'");
+    }
+  }
+  previous_ = 'v';
+}
+
+unsigned int JsonReader::readHex4() {
+  if (!ensure(4)) {
+    fail("truncated unicode escape");
+  }
+  unsigned int value = 0;
+  for (int i = 0; i < 4; ++i) {
+    char c = data_[pos_];
+    value <<= 4;
+    if (c >= '0' && c <= '9') {
+      value |= static_cast<unsigned int>(c - '0');
+    } else if (c >= 'a' && c <= 'f') {
+      value |= static_cast<unsigned int>(c - 'a' + 10);
+    } else if (c >= 'A' && c <= 'F') {
+      value |= static_cast<unsigned int>(c - 'A' + 10);
+    } else {
+      fail("invalid unicode escape");
+    }
+    ++pos_;
+  }
+  return value;
+}
+
+void JsonReader::skipString(size_t& tokenOffset, size_t& tokenLength) {
+  expect('"', "string");
+  tokenOffset = base_ + pos_ - 1;
+  size_t contentStart = pos_;  // Backslashes before a quote are counted back to here
+  while (true) {
+    const void* quote = std::memchr(data_ + pos_, '"', size_ - pos_);
+    if (!quote) {
+      // Chunked input: keep only the trailing backslashes, which may escape the next chunk's first quote
+      size_t keep = size_;
+      while (keep > contentStart && data_[keep - 1] == '\\') {
+        --keep;
+      }
+      pos_ = size_;
+      if (!refill(&keep)) {
+        pos_ = tokenOffset >= base_ ? tokenOffset - base_ : 0;
+        fail("unterminated string");
+      }
+      contentStart = keep;
+      continue;
+    }
+    size_t end = static_cast<size_t>(static_cast<const char*>(quote) - data_);
+    pos_ = end + 1;
+
+    // An odd run of backslashes before the quote escapes it
+    size_t backslashes = 0;
+    while (end - backslashes > contentStart && data_[end - 1 - backslashes] == '\\') {
+      ++backslashes;
+    }
+    if (backslashes % 2 == 0) {
+      break;
+    }
+  }
+  tokenLength = base_ + pos_ - tokenOffset;
+  previous_ = 'v';
+}
@@ -0,0 +1,178 @@
+/**
+ * AllocationTracking.cpp
+ *
+ * Counting replacements for the global allocation functions, compiled in
+ * only with CHIP_CARVING_ALLOCATION_TRACKING
+ */
+
+#include "utils/AllocationTracking.h"
+
+#ifdef CHIP_CARVING_ALLOCATION_TRACKING
+#include <atomic>
+#include <cstddef>
+#include <cstdlib>
+#include <new>
+#endif
+
+namespace ChipCarving {
+namespace Utils {
+
+#ifdef CHIP_CARVING_ALLOCATION_TRACKING
+
+namespace {
+
+// Constant-initialized, so operator new may use them before main and on any thread
+thread_local uint64_t t_allocations = 0;
+thread_local uint64_t t_allocatedBytes = 0;
+std::atomic<uint64_t> g_allocations{0};
+std::atomic<uint64_t> g_allocatedBytes{0};
+std::atomic<uint64_t> g_liveBytes{0};
+std::atomic<uint64_t> g_peakLiveBytes{0};
+
+// Each block is preceded by its requested size, padded to keep the block aligned for any type
+constexpr std::size_t SIZE_HEADER = alignof(std::max_align_t);
+
+void raisePeak(uint64_t bytes) {
+  uint64_t peak = g_peakLiveBytes.load(std::memory_order_relaxed);
+  while (bytes > peak && !g_peakLiveBytes.compare_exchange_weak(peak, bytes, std::memory_order_relaxed)) {
+  }
+}
+
+void* countedAllocate(std::size_t size) {
+  ++t_allocations;
+  t_allocatedBytes += size;
+  g_allocations.fetch_add(1, std::memory_order_relaxed);
+  g_allocatedBytes.fetch_add(size, std::memory_order_relaxed);
+  void* raw = std::malloc(SIZE_HEADER + size);
+  if (!raw) {
+    return nullptr;
+  }
+  *static_cast<std::size_t*>(raw) = size;
+  raisePeak(g_liveBytes.fetch_add(size, std::memory_order_relaxed) + size);
+  return static_cast<char*>(raw) + SIZE_HEADER;
+}
+
+void countedFree(void* block) {
+  if (!block) {
+    return;
+  }
+  void* raw = static_cast<char*>(block) - SIZE_HEADER;
+  g_liveBytes.fetch_sub(*static_cast<std::size_t*>(raw), std::memory_order_relaxed);
+  std::free(raw);
+}
+
+}  // namespace
+
+bool allocationTrackingEnabled() {
+  return true;
+}
+
+AllocationTotals threadAllocationTotals() {
+  AllocationTotals totals;
+  totals.count = t_allocations;
+  totals.bytes = t_allocatedBytes;
+  return totals;
+}
+
+AllocationTotals processAllocationTotals() {
+  AllocationTotals totals;
+  totals.count = g_allocations.load(std::memory_order_relaxed);
+  totals.bytes = g_allocatedBytes.load(std::memory_order_relaxed);
+  return totals;
+}
+
+uint64_t liveAllocatedBytes() {
+  return g_liveBytes.load(std::memory_order_relaxed);
+}
+
+uint64_t peakLiveAllocatedBytes() {
+  return g_peakLiveBytes.load(std::memory_order_relaxed);
+}
+
+uint64_t resetPeakLiveAllocatedBytes() {
+  return g_peakLiveBytes.exchange(g_liveBytes.load(std::memory_order_relaxed), std::memory_order_relaxed);
+}
+
+void raisePeakLiveAllocatedBytes(uint64_t bytes) {
+  raisePeak(bytes);
+}
+
+#else
+
+bool allocationTrackingEnabled() {
+  return false;
+}
+
+AllocationTotals threadAllocationTotals() {
+  return AllocationTotals();
+}
+
+AllocationTotals processAllocationTotals() {
+  return AllocationTotals();
+}
+
+uint64_t liveAllocatedBytes() {
+  return 0;
+}
+
+uint64_t peakLiveAllocatedBytes() {
+  return 0;
+}
+
+uint64_t resetPeakLiveAllocatedBytes() {
+  return 0;
+}
+
+void raisePeakLiveAllocatedBytes(uint64_t) {}
+
+#endif
+
+}  // namespace Utils
+}  // namespace ChipCarving
+
+#ifdef CHIP_CARVING_ALLOCATION_TRACKING
+
+void* operator new(std::size_t size) {
+  if (void* block = ChipCarving::Utils::countedAllocate(size)) {
+    return block;
+  }
+  throw std::bad_alloc();
+}
+
+void* operator new[](std::size_t size) {
+  return operator new(size);
+}
+
+void* operator new(std::size_t size, const std::nothrow_t&) noexcept {
+  return ChipCarving::Utils::countedAllocate(size);
+}
+
+void* operator new[](std::size_t size, const std::nothrow_t&) noexcept {
+  return ChipCarving::Utils::countedAllocate(size);
+}
+
+void operator delete(void* block) noexcept {
+  ChipCarving::Utils::countedFree(block);
+}
+
+void operator delete[](void* block) noexcept {
+  ChipCarving::Utils::countedFree(block);
+}
+
+void operator delete(void* block, std::size_t) noexcept {
+  ChipCarving::Utils::countedFree(block);
+}
+
+void operator delete[](void* block, std::size_t) noexcept {
+  ChipCarving::Utils::countedFree(block);
+}
+
+void operator delete(void* block, const std::nothrow_t&) noexcept {
+  ChipCarving::Utils::countedFree(block);
+}
+
+void operator delete[](void* block, const std::nothrow_t&) noexcept {
+  ChipCarving::Utils::countedFree(block);
+}
+
+#endif
@@ -0,0 +1,119 @@
+/**
+ * ApiCallTimer.cpp
+ *
+ * Fusion API call totals of RunMetrics and the timer that feeds them
+ */
+
+#include "utils/ApiCallTimer.h"
+
+#include <algorithm>
+
+#include "TraceJson.h"
+#include "utils/TraceSpan.h"
+
+namespace ChipCarving {
+namespace Utils {
+
+namespace {
+
+// Trace counters need names that outlive the run
+const char* const KIND_NAMES[API_CALL_KIND_COUNT] = {"calls", "objectsCreated", "rayCasts", "sketchEntities"};
+const char* const COUNTER_NAMES[API_CALL_KIND_COUNT] = {"fusion.calls", "fusion.objectsCreated", "fusion.rayCasts",
+                                                        "fusion.sketchEntities"};
+const char* const TIME_COUNTER_NAMES[API_CALL_KIND_COUNT] = {"fusion.callsMs", "fusion.objectsCreatedMs",
+                                                             "fusion.rayCastsMs", "fusion.sketchEntitiesMs"};
+
+}  // namespace
+
+const char* apiCallKindName(ApiCallKind kind) {
+  return KIND_NAMES[static_cast<size_t>(kind)];
+}
+
+ApiCallTimer::ApiCallTimer(ApiCallKind kind, uint64_t count)
+    : kind_(kind), count_(count), metrics_(currentRunMetrics()), recorder_(currentTraceRecorder()) {
+  if (metrics_ || recorder_) {
+    start_ = std::chrono::steady_clock::now();
+  }
+}
+
+ApiCallTimer::~ApiCallTimer() {
+  if (!metrics_ && !recorder_) {
+    return;
+  }
+  double elapsedMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start_).count();
+  if (metrics_) {
+    metrics_->addApiCalls(kind_, count_, elapsedMs);
+  }
+  if (recorder_) {
+    size_t index = static_cast<size_t>(kind_);
+    recorder_->addToCounter(COUNTER_NAMES[index], static_cast<double>(count_));
+    recorder_->addToCounter(TIME_COUNTER_NAMES[index], elapsedMs);
+  }
+}
+
+void RunMetrics::addApiCalls(ApiCallKind kind, uint64_t count, double elapsedMs) {
+  auto calls = std::find_if(apiCalls_.begin(), apiCalls_.end(),
+                            [this, kind](const ApiCalls& c) { return c.span == current_ && c.kind == kind; });
+  if (calls == apiCalls_.end()) {
+    ApiCalls added;
+    added.span = current_;
+    added.kind = kind;
+    apiCalls_.push_back(added);
+    calls = apiCalls_.end() - 1;
+  }
+  calls->totals.count += count;
+  calls->totals.totalMs += elapsedMs;
+}
+
+ApiCallTotals RunMetrics::apiCallTotals(ApiCallKind kind) const {
+  ApiCallTotals totals;
+  for (const ApiCalls& calls : apiCalls_) {
+    if (calls.kind == kind) {
+      totals.count += calls.totals.count;
+      totals.totalMs += calls.totals.totalMs;
+    }
+  }
+  return totals;
+}
+
+std::string RunMetrics::apiCallsJson() const {
+  std::string json = "[";
+  for (size_t i = 0; i < apiCalls_.size(); ++i) {
+    const ApiCalls& calls = apiCalls_[i];
+    if (i > 0) {
+      json.push_back(',');
+    }
+    json += "{\"path\":";
+    appendJsonString(json, calls.span == NO_PARENT ? std::string() : pathOf(calls.span));
+    json += ",\"kind\":\"" + std::string(apiCallKindName(calls.kind)) +
+            "\",\"count\":" + std::to_string(calls.totals.count) + ",\"totalMs\":" + formatFixed(calls.totals.totalMs) +
+            "}";
+  }
+  json.push_back(']');
+  return json;
+}
+
+std::string RunMetrics::apiCallsSummary() const {
+  if (apiCalls_.empty()) {
+    return std::string();
+  }
+  std::string text = "Fusion API calls:\n";
+  for (size_t kind = 0; kind < API_CALL_KIND_COUNT; ++kind) {
+    ApiCallTotals totals = apiCallTotals(static_cast<ApiCallKind>(kind));
+    if (totals.count == 0) {
+      continue;
+    }
+    text += std::string("  ") + KIND_NAMES[kind] + ": " + std::to_string(totals.count) + " in " +
+            formatFixed(totals.totalMs) + "ms\n";
+    for (const ApiCalls& calls : apiCalls_) {
+      if (static_cast<size_t>(calls.kind) == kind) {
+        text += "    " + (calls.span == NO_PARENT ? std::string("(outside spans)") : pathOf(calls.span)) + ": " +
+                std::to_string(calls.totals.count) + " in " + formatFixed(calls.totals.totalMs) + "ms\n";
+      }
+    }
+  }
+  return text;
+}
+
+}  // namespace Utils
+}  // namespace ChipCarving
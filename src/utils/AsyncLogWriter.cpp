@@ -0,0 +1,157 @@
+/**
+ * AsyncLogWriter.cpp
+ *
+ * Bounded multi-producer ring (per-slot sequence numbers) drained by one writer
+ * thread. Producers only notify the writer for flush records and every quarter
+ * ring; otherwise it polls, so a normal log call is a CAS and a string move.
+ */
+
+#include "utils/AsyncLogWriter.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <utility>
+
+namespace ChipCarving {
+namespace Utils {
+
+namespace {
+
+// Writer poll period; bounds how stale the log file can be between flushes
+constexpr std::chrono::milliseconds WRITER_INTERVAL(50);
+
+constexpr size_t MIN_CAPACITY = 4;
+
+size_t roundUpToPowerOfTwo(size_t value) {
+  size_t rounded = MIN_CAPACITY;
+  while (rounded < value) {
+    rounded <<= 1;
+  }
+  return rounded;
+}
+
+}  // namespace
+
+constexpr size_t AsyncLogWriter::DEFAULT_CAPACITY;
+
+AsyncLogWriter::AsyncLogWriter(RecordSink write, FlushSink flush, size_t capacity)
+    : write_(std::move(write)), flushSink_(std::move(flush)) {
+  size_t slotCount = roundUpToPowerOfTwo(capacity);
+  slots_.reset(new Slot[slotCount]);
+  for (size_t i = 0; i < slotCount; ++i) {
+    slots_[i].sequence.store(i, std::memory_order_relaxed);
+  }
+  mask_ = slotCount - 1;
+  writer_ = std::thread(&AsyncLogWriter::run, this);
+}
+
+AsyncLogWriter::~AsyncLogWriter() {
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    stopping_ = true;
+  }
+  wake_.notify_one();
+  writer_.join();
+}
+
+bool AsyncLogWriter::push(std::string record, bool flushAfter) {
+  size_t pos = enqueuePos_.load(std::memory_order_relaxed);
+  Slot* slot = nullptr;
+  while (true) {
+    slot = &slots_[pos & mask_];
+    size_t sequence = slot->sequence.load(std::memory_order_acquire);
+    auto lag = static_cast<std::ptrdiff_t>(sequence - pos);
+    if (lag == 0) {
+      if (enqueuePos_.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+        break;
+      }
+    } else if (lag < 0) {
+      // Writer is a full ring behind; never block the caller
+      dropped_.fetch_add(1, std::memory_order_relaxed);
+      return false;
+    } else {
+      pos = enqueuePos_.load(std::memory_order_relaxed);
+    }
+  }
+
+  slot->record = std::move(record);
+  slot->flushAfter = flushAfter;
+  slot->sequence.store(pos + 1, std::memory_order_release);
+
+  if (flushAfter) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    flushRequested_ = true;
+    wake_.notify_one();
+  } else if (((pos + 1) & (mask_ >> 2)) == 0) {
+    wake_.notify_one();  // A lost wakeup only costs one poll period
+  }
+  return true;
+}
+
+void AsyncLogWriter::flush() {
+  std::unique_lock<std::mutex> lock(mutex_);
+  size_t target = enqueuePos_.load(std::memory_order_acquire);
+  // A record claimed but not yet published is picked up on a later pass
+  while (flushedPos_ < target) {
+    flushRequested_ = true;
+    wake_.notify_one();
+    flushed_.wait_for(lock, WRITER_INTERVAL);
+  }
+}
+
+void AsyncLogWriter::run() {
+  std::unique_lock<std::mutex> lock(mutex_);
+  while (true) {
+    bool stopping = stopping_;
+    bool flushNeeded = flushRequested_ || stopping;
+    flushRequested_ = false;
+    lock.unlock();
+
+    flushNeeded = drain() || flushNeeded;
+    reportDropped();
+    if (flushNeeded) {
+      flushSink_();
+    }
+
+    lock.lock();
+    if (flushNeeded) {
+      flushedPos_ = dequeuePos_;
+      flushed_.notify_all();
+    }
+    if (stopping && dequeuePos_ == enqueuePos_.load(std::memory_order_acquire)) {
+      break;
+    }
+    if (!stopping_ && !flushRequested_) {
+      wake_.wait_for(lock, WRITER_INTERVAL);
+    }
+  }
+}
+
+bool AsyncLogWriter::drain() {
+  bool flushNeeded = false;
+  while (true) {
+    Slot& slot = slots_[dequeuePos_ & mask_];
+    if (slot.sequence.load(std::memory_order_acquire) != dequeuePos_ + 1) {
+      return flushNeeded;
+    }
+    write_(slot.record);
+    flushNeeded = flushNeeded || slot.flushAfter;
+
+    // Release the buffer here rather than on the producer's next move-assign
+    std::string().swap(slot.record);
+    slot.sequence.store(dequeuePos_ + mask_ + 1, std::memory_order_release);
+    ++dequeuePos_;
+  }
+}
+
+void AsyncLogWriter::reportDropped() {
+  size_t dropped = dropped_.load(std::memory_order_relaxed);
+  if (dropped != droppedReported_) {
+    write_("[WARNING] Log buffer full, dropped " + std::to_string(dropped - droppedReported_) + " records");
+    droppedReported_ = dropped;
+  }
+}
+
+}  // namespace Utils
+}  // namespace ChipCarving
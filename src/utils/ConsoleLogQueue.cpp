@@ -0,0 +1,59 @@
+/**
+ * ConsoleLogQueue.cpp
+ *
+ * Worker-thread console lines waiting for the main thread
+ */
+
+#include "utils/ConsoleLogQueue.h"
+
+#include <utility>
+
+namespace ChipCarving {
+namespace Utils {
+
+constexpr size_t ConsoleLogQueue::DEFAULT_CAPACITY;
+
+ConsoleLogQueue::ConsoleLogQueue(size_t capacity) : capacity_(capacity > 0 ? capacity : 1) {}
+
+bool ConsoleLogQueue::push(std::string line) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  // A pending drain already covers this line, dropped or not
+  bool wasEmpty = lines_.empty() && dropped_ == 0;
+  if (lines_.size() >= capacity_) {
+    ++dropped_;
+    ++totalDropped_;
+  } else {
+    lines_.push_back(std::move(line));
+  }
+  return wasEmpty;
+}
+
+size_t ConsoleLogQueue::drain(const LineSink& sink) {
+  std::vector<std::string> lines;
+  size_t dropped = 0;
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    lines.swap(lines_);
+    std::swap(dropped, dropped_);
+  }
+  for (const auto& line : lines) {
+    sink(line);
+  }
+  if (dropped > 0) {
+    sink("[WARN] " + std::to_string(dropped) + " worker log messages dropped");
+  }
+  return lines.size();
+}
+
+size_t ConsoleLogQueue::size() const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return lines_.size();
+}
+
+size_t ConsoleLogQueue::droppedCount() const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return totalDropped_;
+}
+
+}  // namespace Utils
+}  // namespace ChipCarving
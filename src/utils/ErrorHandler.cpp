@@ -13,10 +13,11 @@ namespace ChipCarving {
 namespace Utils {
 
 // Static member initialization
+std::mutex ErrorHandler::callbackMutex_;
 ErrorCallback ErrorHandler::globalErrorCallback_ = nullptr;
-bool ErrorHandler::consoleLoggingEnabled_ = true;
-bool ErrorHandler::userMessagesEnabled_ = false;
-Adapters::IUserInterface* ErrorHandler::userInterface_ = nullptr;
+std::atomic<bool> ErrorHandler::consoleLoggingEnabled_{true};
+std::atomic<bool> ErrorHandler::userMessagesEnabled_{false};
+std::atomic<Adapters::IUserInterface*> ErrorHandler::userInterface_{nullptr};
 
 bool ErrorHandler::executeFusionOperation(const std::string& operation, const std::function<bool()>& func,
                                           bool showMessageToUser) {
@@ -34,26 +35,24 @@ bool ErrorHandler::executeFusionOperation(const std::string& operation, const st
     std::string errorMsg = "Exception in " + operation + ": " + e.what();
     LOG_ERROR(errorMsg);
 
-    if (showMessageToUser && userMessagesEnabled_ && userInterface_) {
-      userInterface_->showMessageBox("Error", errorMsg);
+    Adapters::IUserInterface* ui = userInterface_;
+    if (showMessageToUser && userMessagesEnabled_ && ui) {
+      ui->showMessageBox("Error", errorMsg);
     }
 
-    if (globalErrorCallback_) {
-      globalErrorCallback_(errorMsg, operation);
-    }
+    notifyGlobalCallback(errorMsg, operation);
 
     return false;
   } catch (...) {
     std::string errorMsg = "Unknown exception in " + operation;
     LOG_ERROR(errorMsg);
 
-    if (showMessageToUser && userMessagesEnabled_ && userInterface_) {
-      userInterface_->showMessageBox("Error", errorMsg);
+    Adapters::IUserInterface* ui = userInterface_;
+    if (showMessageToUser && userMessagesEnabled_ && ui) {
+      ui->showMessageBox("Error", errorMsg);
     }
 
-    if (globalErrorCallback_) {
-      globalErrorCallback_(errorMsg, operation);
-    }
+    notifyGlobalCallback(errorMsg, operation);
 
     return false;
   }
@@ -73,7 +72,10 @@ void ErrorHandler::executeWithLogging(const std::string& operation, const std::f
 }
 
 void ErrorHandler::setGlobalErrorCallback(const ErrorCallback& callback) {
-  globalErrorCallback_ = callback;
+  {
+    std::lock_guard<std::mutex> lock(callbackMutex_);
+    globalErrorCallback_ = callback;
+  }
 
   if (callback) {
     LOG_DEBUG("Global error callback registered");
@@ -98,17 +100,24 @@ void ErrorHandler::handleStandardException(const std::string& operation, const s
   std::string errorMsg = "Exception in " + operation + ": " + e.what();
   logError(operation, errorMsg);
 
-  if (globalErrorCallback_) {
-    globalErrorCallback_(errorMsg, operation);
-  }
+  notifyGlobalCallback(errorMsg, operation);
 }
 
 void ErrorHandler::handleUnknownException(const std::string& operation) {
   std::string errorMsg = "Unknown exception in " + operation;
   logError(operation, errorMsg);
 
-  if (globalErrorCallback_) {
-    globalErrorCallback_(errorMsg, operation);
+  notifyGlobalCallback(errorMsg, operation);
+}
+
+void ErrorHandler::notifyGlobalCallback(const std::string& errorMsg, const std::string& operation) {
+  ErrorCallback callback;
+  {
+    std::lock_guard<std::mutex> lock(callbackMutex_);
+    callback = globalErrorCallback_;
+  }
+  if (callback) {
+    callback(errorMsg, operation);
   }
 }
 
@@ -7,8 +7,10 @@
 
 #pragma once
 
+#include <atomic>
 #include <exception>
 #include <functional>
+#include <mutex>
 #include <string>
 
 namespace ChipCarving {
@@ -71,6 +73,10 @@ class Result {
  *   if (result.hasError()) {
  *       // Handle error
  *   }
+ *
+ * The configuration may be changed from any thread, but message boxes are only
+ * shown from the main thread's executeFusionOperation(). Worker loops collect
+ * their errors in a RunErrorContext instead (utils/RunErrorContext.h).
  */
 class ErrorHandler {
  public:
@@ -99,10 +105,14 @@ class ErrorHandler {
   static void setUserInterface(Adapters::IUserInterface* ui);
 
  private:
+  static std::mutex callbackMutex_;  // Guards globalErrorCallback_
   static ErrorCallback globalErrorCallback_;
-  static bool consoleLoggingEnabled_;
-  static bool userMessagesEnabled_;
-  static Adapters::IUserInterface* userInterface_;
+  static std::atomic<bool> consoleLoggingEnabled_;
+  static std::atomic<bool> userMessagesEnabled_;
+  static std::atomic<Adapters::IUserInterface*> userInterface_;
+
+  // Call the global callback, if any, outside the lock
+  static void notifyGlobalCallback(const std::string& errorMsg, const std::string& operation);
 
   static void handleStandardException(const std::string& operation, const std::exception& e);
   static void handleUnknownException(const std::string& operation);
@@ -122,8 +132,8 @@ Result<T> ErrorHandler::executeWithHandling(const std::string& operation, std::f
 
     if (errorCallback) {
       errorCallback(errorMsg, operation);
-    } else if (globalErrorCallback_) {
-      globalErrorCallback_(errorMsg, operation);
+    } else {
+      notifyGlobalCallback(errorMsg, operation);
     }
 
     return Result<T>::failure(errorMsg);
@@ -133,8 +143,8 @@ Result<T> ErrorHandler::executeWithHandling(const std::string& operation, std::f
 
     if (errorCallback) {
       errorCallback(errorMsg, operation);
-    } else if (globalErrorCallback_) {
-      globalErrorCallback_(errorMsg, operation);
+    } else {
+      notifyGlobalCallback(errorMsg, operation);
     }
 
     return Result<T>::failure(errorMsg);
@@ -6,12 +6,158 @@
 
 #include "FusionComponentTraverser.h"
 
+#include <algorithm>
+#include <string>
+#include <unordered_map>
+
 #include "utils/logging.h"
 
+using adsk::core::Ptr;
+
 namespace ChipCarving {
 namespace Utils {
 
-FusionComponentTraverser::FusionComponentTraverser(const adsk::core::Ptr<adsk::fusion::Component>& rootComponent)
+namespace {
+
+// What has to match for a snapshot to still describe the design
+struct ModificationState {
+  Ptr<adsk::fusion::Design> design{};
+  size_t timelineCount = 0;
+  int markerPosition = 0;
+  size_t occurrenceCount = 0;
+
+  bool operator==(const ModificationState& other) const {
+    return design.get() == other.design.get() && timelineCount == other.timelineCount &&
+           markerPosition == other.markerPosition && occurrenceCount == other.occurrenceCount;
+  }
+};
+
+struct CachedSnapshot {
+  ModificationState state{};
+  std::shared_ptr<const ComponentSnapshot> snapshot{};
+};
+
+CachedSnapshot cachedSnapshot;
+
+// False for designs without a timeline (direct modeling), which are never cached
+bool readModificationState(const Ptr<adsk::fusion::Design>& design, const Ptr<adsk::fusion::Component>& rootComp,
+                           ModificationState& state) {
+  Ptr<adsk::fusion::Timeline> timeline = design->timeline();
+  if (!timeline) {
+    return false;
+  }
+  state.design = design;
+  state.timelineCount = timeline->count();
+  state.markerPosition = timeline->markerPosition();
+  auto occurrences = rootComp->allOccurrences();
+  state.occurrenceCount = occurrences ? occurrences->count() : 0;
+  return true;
+}
+
+void addBodyBounds(const Ptr<adsk::fusion::BRepBodies>& bodies, WorldBounds& bounds) {
+  if (!bodies) {
+    return;
+  }
+  for (size_t i = 0; i < bodies->count(); ++i) {
+    Ptr<adsk::fusion::BRepBody> body = bodies->item(i);
+    if (body) {
+      bounds.add(body->boundingBox());
+    }
+  }
+}
+
+std::shared_ptr<const ComponentSnapshot> buildSnapshot(const Ptr<adsk::fusion::Component>& rootComp) {
+  auto snapshot = std::make_shared<ComponentSnapshot>();
+  std::unordered_map<std::string, size_t> bodyComponentIndex;
+
+  // Native boxes and, for occurrences, the world-space proxy boxes: a
+  // component's box covers its bodies wherever they are placed
+  auto addComponent = [&snapshot, &bodyComponentIndex](const Ptr<adsk::fusion::Component>& component,
+                                                       const Ptr<adsk::fusion::BRepBodies>& placedBodies) {
+    snapshot->components.push_back(component);
+    Ptr<adsk::fusion::BRepBodies> bodies = component->bRepBodies();
+    if (!bodies || bodies->count() == 0) {
+      return;
+    }
+
+    auto inserted = bodyComponentIndex.emplace(component->id(), snapshot->bodyComponents.size());
+    if (inserted.second) {
+      snapshot->bodyComponents.push_back(BodyComponent{component, WorldBounds()});
+      addBodyBounds(bodies, snapshot->bodyComponents.back().bounds);
+    }
+    addBodyBounds(placedBodies, snapshot->bodyComponents[inserted.first->second].bounds);
+  };
+
+  addComponent(rootComp, Ptr<adsk::fusion::BRepBodies>());
+  auto occurrences = rootComp->allOccurrences();
+  if (occurrences) {
+    for (size_t i = 0; i < occurrences->count(); ++i) {
+      auto occurrence = occurrences->item(i);
+      if (!occurrence || !occurrence->isValid() || !occurrence->component()) {
+        LOG_WARNING("Skipping invalid occurrence at index " << i);
+        continue;
+      }
+      addComponent(occurrence->component(), occurrence->bRepBodies());
+    }
+  }
+
+  LOG_DEBUG("Component snapshot: " << snapshot->components.size() << " components, "
+                                   << snapshot->bodyComponents.size() << " with B-Rep bodies");
+  return snapshot;
+}
+
+}  // namespace
+
+void WorldBounds::add(const Ptr<adsk::core::BoundingBox3D>& box) {
+  if (!box || !box->minPoint() || !box->maxPoint()) {
+    return;
+  }
+  Ptr<adsk::core::Point3D> low = box->minPoint();
+  Ptr<adsk::core::Point3D> high = box->maxPoint();
+  if (empty) {
+    minX = low->x();
+    minY = low->y();
+    minZ = low->z();
+    maxX = high->x();
+    maxY = high->y();
+    maxZ = high->z();
+    empty = false;
+    return;
+  }
+  minX = std::min(minX, low->x());
+  minY = std::min(minY, low->y());
+  minZ = std::min(minZ, low->z());
+  maxX = std::max(maxX, high->x());
+  maxY = std::max(maxY, high->y());
+  maxZ = std::max(maxZ, high->z());
+}
+
+std::shared_ptr<const ComponentSnapshot> FusionComponentTraverser::snapshot(
+    const Ptr<adsk::fusion::Design>& design) {
+  if (!design) {
+    return nullptr;
+  }
+  Ptr<adsk::fusion::Component> rootComp = design->rootComponent();
+  if (!rootComp) {
+    return nullptr;
+  }
+
+  ModificationState state;
+  if (!readModificationState(design, rootComp, state)) {
+    return buildSnapshot(rootComp);
+  }
+  if (!cachedSnapshot.snapshot || !(cachedSnapshot.state == state)) {
+    cachedSnapshot.state = state;
+    cachedSnapshot.snapshot = buildSnapshot(rootComp);
+  }
+  return cachedSnapshot.snapshot;
+}
+
+void FusionComponentTraverser::clearSnapshot() {
+  cachedSnapshot = CachedSnapshot();
+}
+
+FusionComponentTraverser::FusionComponentTraverser(const Ptr<adsk::fusion::Component>& rootComponent)
     : rootComponent_(rootComponent) {
   if (!rootComponent_) {
     LOG_ERROR("FusionComponentTraverser initialized with null root component");
@@ -20,13 +166,27 @@ FusionComponentTraverser::FusionComponentTraverser(const adsk::core::Ptr<adsk::f
   }
 }
 
-std::vector<adsk::core::Ptr<adsk::fusion::Component>> FusionComponentTraverser::getAllComponents() {
-  std::vector<adsk::core::Ptr<adsk::fusion::Component>> components;
-  collectComponents(components);
+std::shared_ptr<const ComponentSnapshot> FusionComponentTraverser::currentSnapshot() const {
+  if (!rootComponent_) {
+    LOG_ERROR("Cannot collect components - root component is null");
+    return nullptr;
+  }
+  return snapshot(rootComponent_->parentDesign());
+}
 
-  LOG_DEBUG("Found " << components.size() << " total components");
+std::vector<Ptr<adsk::fusion::Component>> FusionComponentTraverser::getAllComponents() {
+  auto current = currentSnapshot();
+  if (!current) {
+    return {};
+  }
 
-  return components;
+  LOG_DEBUG("Found " << current->components.size() << " total components");
+  return current->components;
+}
+
+std::vector<BodyComponent> FusionComponentTraverser::getBodyComponents() {
+  auto current = currentSnapshot();
+  return current ? current->bodyComponents : std::vector<BodyComponent>();
 }
 
 void FusionComponentTraverser::forEachComponent(const ComponentCallback& callback) {
@@ -34,10 +194,13 @@ void FusionComponentTraverser::forEachComponent(const ComponentCallback& callbac
     return;
   }
 
-  auto components = getAllComponents();
+  auto current = currentSnapshot();
+  if (!current) {
+    return;
+  }
 
-  for (size_t i = 0; i < components.size(); ++i) {
-    if (!callback(components[i], i)) {
+  for (size_t i = 0; i < current->components.size(); ++i) {
+    if (!callback(current->components[i], i)) {
       // Callback returned false, stop traversal
       break;
     }
@@ -45,29 +208,22 @@ void FusionComponentTraverser::forEachComponent(const ComponentCallback& callbac
 }
 
 size_t FusionComponentTraverser::getComponentCount() {
-  if (!rootComponent_) {
-    return 0;
-  }
-
-  size_t count = 1;  // Root component
-
-  auto occurrences = rootComponent_->allOccurrences();
-  if (occurrences) {
-    count += occurrences->count();
-  }
-
-  return count;
+  auto current = currentSnapshot();
+  return current ? current->components.size() : 0;
 }
 
-adsk::core::Ptr<adsk::fusion::Component> FusionComponentTraverser::findComponent(
-    const std::function<bool(adsk::core::Ptr<adsk::fusion::Component>)>& predicate) {
+Ptr<adsk::fusion::Component> FusionComponentTraverser::findComponent(
+    const std::function<bool(Ptr<adsk::fusion::Component>)>& predicate) {
   if (!predicate) {
     return nullptr;
   }
 
-  auto components = getAllComponents();
+  auto current = currentSnapshot();
+  if (!current) {
+    return nullptr;
+  }
 
-  for (const auto& component : components) {
+  for (const auto& component : current->components) {
     if (component && predicate(component)) {
       return component;
     }
@@ -76,33 +232,6 @@ adsk::core::Ptr<adsk::fusion::Component> FusionComponentTraverser::findComponent
   return nullptr;
 }
 
-void FusionComponentTraverser::collectComponents(std::vector<adsk::core::Ptr<adsk::fusion::Component>>& components) {
-  if (!rootComponent_) {
-    LOG_ERROR("Cannot collect components - root component is null");
-    return;
-  }
-
-  // Add root component first
-  components.push_back(rootComponent_);
-
-  // Add all occurrences (sub-components)
-  auto occurrences = rootComponent_->allOccurrences();
-  if (occurrences) {
-    LOG_DEBUG("Found " << occurrences->count() << " component occurrences");
-
-    for (size_t i = 0; i < occurrences->count(); ++i) {
-      auto occurrence = occurrences->item(i);
-      if (occurrence && occurrence->component()) {
-        components.push_back(occurrence->component());
-      } else {
-        LOG_WARNING("Skipping invalid occurrence at index " << i);
-      }
-    }
-  } else {
-    LOG_DEBUG("No component occurrences found");
-  }
-}
-
 // Template specialization for Sketches
 template <>
 std::vector<adsk::core::Ptr<adsk::fusion::Component>>
@@ -124,24 +253,14 @@ FusionComponentTraverser::getComponentsContaining<adsk::fusion::Sketches>() {
   return result;
 }
 
-// Template specialization for BRepBodies
+// Template specialization for BRepBodies: answered from the snapshot
 template <>
 std::vector<adsk::core::Ptr<adsk::fusion::Component>>
 FusionComponentTraverser::getComponentsContaining<adsk::fusion::BRepBodies>() {
   std::vector<adsk::core::Ptr<adsk::fusion::Component>> result;
-
-  forEachComponent([&result](const auto& component, size_t index) {
-    (void)index;  // Suppress unused parameter warning
-
-    if (component) {
-      auto bodies = component->bRepBodies();
-      if (bodies && bodies->count() > 0) {
-        result.push_back(component);
-      }
-    }
-    return true;  // Continue traversal
-  });
-
+  for (const auto& bodyComponent : getBodyComponents()) {
+    result.push_back(bodyComponent.component);
+  }
   return result;
 }
 
@@ -11,6 +11,7 @@
 #include <Fusion/FusionAll.h>
 
 #include <functional>
+#include <memory>
 #include <vector>
 
 namespace ChipCarving {
@@ -23,9 +24,39 @@ namespace Utils {
  */
 using ComponentCallback = std::function<bool(adsk::core::Ptr<adsk::fusion::Component>, size_t)>;
 
+// World-space axis-aligned box (cm)
+struct WorldBounds {
+  double minX = 0.0;
+  double minY = 0.0;
+  double minZ = 0.0;
+  double maxX = 0.0;
+  double maxY = 0.0;
+  double maxZ = 0.0;
+  bool empty = true;
+
+  void add(const adsk::core::Ptr<adsk::core::BoundingBox3D>& box);
+};
+
+// A component owning B-Rep bodies, bounded by every occurrence of those bodies
+struct BodyComponent {
+  adsk::core::Ptr<adsk::fusion::Component> component{};
+  WorldBounds bounds{};
+};
+
+// Traversal of one design at one modification state
+struct ComponentSnapshot {
+  std::vector<adsk::core::Ptr<adsk::fusion::Component>> components{};  // Root, then one per occurrence
+  std::vector<BodyComponent> bodyComponents{};                          // Each component once
+};
+
 /**
  * Utility class to abstract common Fusion 360 component traversal patterns
  *
+ * The occurrence tree is walked once per design modification state (timeline
+ * length and marker position, occurrence count) and the snapshot is shared by
+ * every traverser until the design changes. Designs without a timeline are
+ * walked on every call, since nothing cheap tells when they were edited.
+ *
  * Usage:
  *   auto traverser = FusionComponentTraverser(rootComponent);
  *   auto allComponents = traverser.getAllComponents();
@@ -57,10 +88,19 @@ class FusionComponentTraverser {
   template <typename T>
   std::vector<adsk::core::Ptr<adsk::fusion::Component>> getComponentsContaining();
 
+  // Components owning B-Rep bodies, with their world-space bounds
+  std::vector<BodyComponent> getBodyComponents();
+
+  // Shared snapshot of the design's current state (main thread only; null without a root component)
+  static std::shared_ptr<const ComponentSnapshot> snapshot(const adsk::core::Ptr<adsk::fusion::Design>& design);
+
+  // Forget the shared snapshot, e.g. when the active document changes
+  static void clearSnapshot();
+
  private:
   adsk::core::Ptr<adsk::fusion::Component> rootComponent_{};
 
-  void collectComponents(std::vector<adsk::core::Ptr<adsk::fusion::Component>>& components);
+  std::shared_ptr<const ComponentSnapshot> currentSnapshot() const;
 };
 
 // Template specializations for common entity types
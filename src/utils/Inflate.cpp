@@ -0,0 +1,308 @@
+/**
+ * Inflate.cpp
+ *
+ * Canonical Huffman decoding of deflate blocks, one code bit at a time
+ */
+
+#include "utils/Inflate.h"
+
+#include <algorithm>
+#include <cstdint>
+
+#include "InflateBits.h"
+
+namespace ChipCarving {
+namespace Utils {
+
+namespace {
+
+constexpr int MAX_CODE_BITS = 15;
+constexpr int LITERAL_CODES = 288;
+constexpr int DISTANCE_CODES = 30;
+constexpr int END_OF_BLOCK = 256;
+
+constexpr uint16_t LENGTH_BASE[29] = {3,  4,  5,  6,  7,  8,  9,  10, 11,  13,  15,  17,  19,  23, 27,
+                                      31, 35, 43, 51, 59, 67, 83, 99, 115, 131, 163, 195, 227, 258};
+constexpr uint8_t LENGTH_EXTRA[29] = {0, 0, 0, 0, 0, 0, 0, 0, 1, 1, 1, 1, 2, 2, 2,
+                                      2, 3, 3, 3, 3, 4, 4, 4, 4, 5, 5, 5, 5, 0};
+constexpr uint16_t DISTANCE_BASE[30] = {1,    2,    3,    4,    5,    7,    9,     13,    17,    25,
+                                        33,   49,   65,   97,   129,  193,  257,   385,   513,   769,
+                                        1025, 1537, 2049, 3073, 4097, 6145, 8193,  12289, 16385, 24577};
+constexpr uint8_t DISTANCE_EXTRA[30] = {0, 0, 0, 0, 1, 1, 2, 2,  3,  3,  4,  4,  5,  5,  6,
+                                        6, 7, 7, 8, 8, 9, 9, 10, 10, 11, 11, 12, 12, 13, 13};
+
+// Order the code length code lengths are sent in
+constexpr uint8_t CODE_LENGTH_ORDER[19] = {16, 17, 18, 0, 8, 7, 9, 6, 10, 5, 11, 4, 12, 3, 13, 2, 14, 1, 15};
+
+constexpr uint32_t ADLER_MODULUS = 65521;
+constexpr size_t ADLER_RUN = 5552;  // Longest run whose sums cannot overflow 32 bits before reduction
+
+// Adler-32 (RFC 1950 section 8.2)
+uint32_t adler32(const unsigned char* data, size_t size) {
+  uint32_t a = 1;
+  uint32_t b = 0;
+  while (size > 0) {
+    size_t run = std::min(size, ADLER_RUN);
+    for (size_t i = 0; i < run; ++i) {
+      a += data[i];
+      b += a;
+    }
+    a %= ADLER_MODULUS;
+    b %= ADLER_MODULUS;
+    data += run;
+    size -= run;
+  }
+  return (b << 16) | a;
+}
+
+// Symbols by code, from per-symbol code lengths (0 = unused)
+struct Huffman {
+  uint16_t counts[MAX_CODE_BITS + 1] = {};
+  uint16_t symbols[LITERAL_CODES] = {};
+
+  // False for an over-subscribed code; incomplete codes are allowed
+  bool build(const uint8_t* lengths, int symbolCount) {
+    for (int i = 0; i < symbolCount; ++i) {
+      counts[lengths[i]]++;
+    }
+    counts[0] = 0;
+    int left = 1;
+    for (int length = 1; length <= MAX_CODE_BITS; ++length) {
+      left = (left << 1) - counts[length];
+      if (left < 0) {
+        return false;
+      }
+    }
+    uint16_t offsets[MAX_CODE_BITS + 2] = {};
+    for (int length = 1; length <= MAX_CODE_BITS; ++length) {
+      offsets[length + 1] = offsets[length] + counts[length];
+    }
+    for (int i = 0; i < symbolCount; ++i) {
+      if (lengths[i] != 0) {
+        symbols[offsets[lengths[i]]++] = static_cast<uint16_t>(i);
+      }
+    }
+    return true;
+  }
+
+  // Next symbol, or -1 for an unused code or the end of the input
+  int decode(BitReader& in) const {
+    int code = 0;
+    int first = 0;
+    int index = 0;
+    for (int length = 1; length <= MAX_CODE_BITS; ++length) {
+      uint32_t bit = 0;
+      if (!in.bits(1, bit)) {
+        return -1;
+      }
+      code |= static_cast<int>(bit);
+      int count = counts[length];
+      if (code - count < first) {
+        return symbols[index + (code - first)];
+      }
+      index += count;
+      first = (first + count) << 1;
+      code <<= 1;
+    }
+    return -1;
+  }
+};
+
+bool inflateStored(BitReader& in, std::vector<unsigned char>& out, size_t limit) {
+  const unsigned char* header = nullptr;
+  if (!in.bytes(4, header)) {
+    return false;
+  }
+  size_t length = header[0] | (header[1] << 8);
+  size_t complement = header[2] | (header[3] << 8);
+  const unsigned char* start = nullptr;
+  if (length != (~complement & 0xFFFF) || out.size() + length > limit || !in.bytes(length, start)) {
+    return false;
+  }
+  out.insert(out.end(), start, start + length);
+  return true;
+}
+
+bool inflateCodes(BitReader& in, const Huffman& literals, const Huffman& distances, std::vector<unsigned char>& out,
+                  size_t streamStart, size_t limit) {
+  for (;;) {
+    int symbol = literals.decode(in);
+    if (symbol < 0) {
+      return false;
+    }
+    if (symbol < END_OF_BLOCK) {
+      if (out.size() >= limit) {
+        return false;
+      }
+      out.push_back(static_cast<unsigned char>(symbol));
+      continue;
+    }
+    if (symbol == END_OF_BLOCK) {
+      return true;
+    }
+
+    symbol -= END_OF_BLOCK + 1;
+    uint32_t extra = 0;
+    if (symbol >= 29 || !in.bits(LENGTH_EXTRA[symbol], extra)) {
+      return false;
+    }
+    size_t length = LENGTH_BASE[symbol] + extra;
+    int distanceSymbol = distances.decode(in);
+    if (distanceSymbol < 0 || distanceSymbol >= DISTANCE_CODES || !in.bits(DISTANCE_EXTRA[distanceSymbol], extra)) {
+      return false;
+    }
+    size_t distance = DISTANCE_BASE[distanceSymbol] + extra;
+    if (distance > out.size() - streamStart || out.size() + length > limit) {
+      return false;
+    }
+    // Byte by byte: the copy may overlap what it produces
+    size_t from = out.size() - distance;
+    for (size_t i = 0; i < length; ++i) {
+      out.push_back(out[from + i]);
+    }
+  }
+}
+
+bool inflateFixed(BitReader& in, std::vector<unsigned char>& out, size_t streamStart, size_t limit) {
+  static const struct FixedCodes {
+    Huffman literals;
+    Huffman distances;
+    FixedCodes() {
+      uint8_t lengths[LITERAL_CODES];
+      for (int i = 0; i < LITERAL_CODES; ++i) {
+        lengths[i] = i < 144 ? 8 : i < 256 ? 9 : i < 280 ? 7 : 8;
+      }
+      literals.build(lengths, LITERAL_CODES);
+      for (int i = 0; i < DISTANCE_CODES; ++i) {
+        lengths[i] = 5;
+      }
+      distances.build(lengths, DISTANCE_CODES);
+    }
+  } fixed;
+  return inflateCodes(in, fixed.literals, fixed.distances, out, streamStart, limit);
+}
+
+bool inflateDynamic(BitReader& in, std::vector<unsigned char>& out, size_t streamStart, size_t limit) {
+  uint32_t literalCount = 0;
+  uint32_t distanceCount = 0;
+  uint32_t codeLengthCount = 0;
+  if (!in.bits(5, literalCount) || !in.bits(5, distanceCount) || !in.bits(4, codeLengthCount)) {
+    return false;
+  }
+  literalCount += 257;
+  distanceCount += 1;
+  codeLengthCount += 4;
+  if (literalCount > 286 || distanceCount > DISTANCE_CODES) {
+    return false;
+  }
+
+  uint8_t lengths[LITERAL_CODES + DISTANCE_CODES] = {};
+  for (uint32_t i = 0; i < codeLengthCount; ++i) {
+    uint32_t length = 0;
+    if (!in.bits(3, length)) {
+      return false;
+    }
+    lengths[CODE_LENGTH_ORDER[i]] = static_cast<uint8_t>(length);
+  }
+  Huffman codeLengths;
+  if (!codeLengths.build(lengths, 19)) {
+    return false;
+  }
+
+  // Literal/length and distance code lengths, run-length coded as one sequence
+  uint32_t total = literalCount + distanceCount;
+  for (uint32_t index = 0; index < total;) {
+    int symbol = codeLengths.decode(in);
+    if (symbol < 0) {
+      return false;
+    }
+    if (symbol < 16) {
+      lengths[index++] = static_cast<uint8_t>(symbol);
+      continue;
+    }
+    uint8_t repeated = 0;
+    uint32_t repeat = 0;
+    if (symbol == 16) {
+      if (index == 0 || !in.bits(2, repeat)) {
+        return false;
+      }
+      repeated = lengths[index - 1];
+      repeat += 3;
+    } else if (symbol == 17) {
+      if (!in.bits(3, repeat)) {
+        return false;
+      }
+      repeat += 3;
+    } else {
+      if (!in.bits(7, repeat)) {
+        return false;
+      }
+      repeat += 11;
+    }
+    if (index + repeat > total) {
+      return false;
+    }
+    while (repeat-- > 0) {
+      lengths[index++] = repeated;
+    }
+  }
+  if (lengths[END_OF_BLOCK] == 0) {
+    return false;
+  }
+
+  Huffman literals;
+  Huffman distances;
+  if (!literals.build(lengths, static_cast<int>(literalCount)) ||
+      !distances.build(lengths + literalCount, static_cast<int>(distanceCount))) {
+    return false;
+  }
+  return inflateCodes(in, literals, distances, out, streamStart, limit);
+}
+
+}  // namespace
+
+bool inflateBlock(BitReader& in, std::vector<unsigned char>& out, size_t streamStart, size_t limit, bool& last) {
+  uint32_t final = 0;
+  uint32_t type = 0;
+  if (!in.bits(1, final) || !in.bits(2, type)) {
+    return false;
+  }
+  last = final != 0;
+  if (type == 0) {
+    return inflateStored(in, out, limit);
+  }
+  if (type == 1) {
+    return inflateFixed(in, out, streamStart, limit);
+  }
+  return type == 2 && inflateDynamic(in, out, streamStart, limit);
+}
+
+bool inflateZlib(const unsigned char* data, size_t size, std::vector<unsigned char>& out, size_t maxOutput) {
+  // CMF/FLG: deflate with a window of at most 32K, no preset dictionary
+  if (!data || size < 2 || (data[0] & 0x0F) != 8 || (data[0] >> 4) > 7 || (data[1] & 0x20) != 0 ||
+      ((data[0] << 8) | data[1]) % 31 != 0) {
+    return false;
+  }
+
+  BitReader in(data + 2, size - 2);
+  size_t streamStart = out.size();
+  size_t limit = streamStart + maxOutput;
+  bool last = false;
+  while (!last) {
+    if (!inflateBlock(in, out, streamStart, limit, last)) {
+      return false;
+    }
+  }
+
+  // Adler-32 of the output, big-endian, from the next whole byte
+  const unsigned char* trailer = nullptr;
+  if (!in.bytes(4, trailer)) {
+    return false;
+  }
+  uint32_t expected = (static_cast<uint32_t>(trailer[0]) << 24) | (static_cast<uint32_t>(trailer[1]) << 16) |
+                      (static_cast<uint32_t>(trailer[2]) << 8) | static_cast<uint32_t>(trailer[3]);
+  return adler32(out.data() + streamStart, out.size() - streamStart) == expected;
+}
+
+}  // namespace Utils
+}  // namespace ChipCarving
@@ -0,0 +1,69 @@
+/**
+ * InflateBits.h
+ *
+ * Bit reader and block decoder shared by the whole-buffer and streaming
+ * deflate decoders (internal to src/utils)
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace ChipCarving {
+namespace Utils {
+
+// Least significant bit first, as deflate packs everything but Huffman codes
+class BitReader {
+ public:
+  BitReader(const unsigned char* data, size_t size) : data_(data), size_(size) {}
+
+  bool bits(int count, uint32_t& value) {
+    while (bitCount_ < count) {
+      if (position_ >= size_) {
+        return false;
+      }
+      buffer_ |= static_cast<uint32_t>(data_[position_++]) << bitCount_;
+      bitCount_ += 8;
+    }
+    value = buffer_ & ((1u << count) - 1);
+    buffer_ >>= count;
+    bitCount_ -= count;
+    return true;
+  }
+
+  size_t position() const {
+    return position_;
+  }
+
+  // Drop the rest of the current byte and read whole bytes (stored blocks)
+  bool bytes(size_t count, const unsigned char*& start) {
+    buffer_ = 0;
+    bitCount_ = 0;
+    if (size_ - position_ < count) {
+      return false;
+    }
+    start = data_ + position_;
+    position_ += count;
+    return true;
+  }
+
+ private:
+  const unsigned char* data_;
+  size_t size_;
+  size_t position_ = 0;
+  uint32_t buffer_ = 0;
+  int bitCount_ = 0;
+};
+
+/**
+ * Decode one deflate block of any type, appending it to out
+ * @param streamStart Where this stream's output starts in out; matches cannot reach before it
+ * @param limit Fail rather than let out grow beyond this size
+ * @param last Set if this was the stream's final block
+ */
+bool inflateBlock(BitReader& in, std::vector<unsigned char>& out, size_t streamStart, size_t limit, bool& last);
+
+}  // namespace Utils
+}  // namespace ChipCarving
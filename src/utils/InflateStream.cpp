@@ -0,0 +1,217 @@
+/**
+ * InflateStream.cpp
+ *
+ * Block-at-a-time deflate decoding with a sliding 32K window, and gzip files
+ * Split from Inflate.cpp for maintainability
+ */
+
+#include <array>
+#include <cstring>
+#include <initializer_list>
+#include <limits>
+
+#include "InflateBits.h"
+#include "utils/Inflate.h"
+
+namespace ChipCarving {
+namespace Utils {
+
+namespace {
+
+constexpr size_t WINDOW_SIZE = 32768;
+
+// Gzip header flags (RFC 1952 section 2.3.1)
+constexpr unsigned char GZIP_HEADER_CRC = 0x02;
+constexpr unsigned char GZIP_EXTRA = 0x04;
+constexpr unsigned char GZIP_NAME = 0x08;
+constexpr unsigned char GZIP_COMMENT = 0x10;
+constexpr unsigned char GZIP_RESERVED = 0xE0;
+
+const std::array<uint32_t, 256>& crcTable() {
+  static const std::array<uint32_t, 256> table = [] {
+    std::array<uint32_t, 256> entries{};
+    for (uint32_t n = 0; n < 256; ++n) {
+      uint32_t c = n;
+      for (int k = 0; k < 8; ++k) {
+        c = (c & 1) ? 0xEDB88320u ^ (c >> 1) : c >> 1;
+      }
+      entries[n] = c;
+    }
+    return entries;
+  }();
+  return table;
+}
+
+// CRC-32 (RFC 1952 section 8) of crc's bytes followed by size more
+uint32_t crc32(uint32_t crc, const unsigned char* data, size_t size) {
+  const auto& table = crcTable();
+  uint32_t c = crc ^ 0xFFFFFFFFu;
+  for (size_t i = 0; i < size; ++i) {
+    c = table[(c ^ data[i]) & 0xFF] ^ (c >> 8);
+  }
+  return c ^ 0xFFFFFFFFu;
+}
+
+uint32_t readLittleEndian32(const unsigned char* bytes) {
+  return static_cast<uint32_t>(bytes[0]) | (static_cast<uint32_t>(bytes[1]) << 8) |
+         (static_cast<uint32_t>(bytes[2]) << 16) | (static_cast<uint32_t>(bytes[3]) << 24);
+}
+
+}  // namespace
+
+struct InflateStream::State {
+  State(const unsigned char* data, size_t size) : in(data, size) {}
+
+  BitReader in;
+  std::vector<unsigned char> window{};  // Up to 32K of history, then the last block
+  size_t blockStart = 0;
+  size_t maxBlockOutput = 0;
+  bool done = false;
+  bool failed = false;
+};
+
+InflateStream::InflateStream(const unsigned char* data, size_t size, size_t maxBlockOutput)
+    : state_(new State(data, size)) {
+  state_->maxBlockOutput = maxBlockOutput;
+}
+
+InflateStream::~InflateStream() = default;
+
+bool InflateStream::nextBlock() {
+  State& s = *state_;
+  if (s.done) {
+    return false;
+  }
+
+  // Keep only the window later matches can reach
+  if (s.window.size() > WINDOW_SIZE) {
+    s.window.erase(s.window.begin(), s.window.end() - WINDOW_SIZE);
+  }
+  s.blockStart = s.window.size();
+  size_t limit = s.maxBlockOutput > std::numeric_limits<size_t>::max() - s.blockStart
+                     ? std::numeric_limits<size_t>::max()
+                     : s.blockStart + s.maxBlockOutput;
+  bool last = false;
+  if (!inflateBlock(s.in, s.window, 0, limit, last)) {
+    s.done = true;
+    s.failed = true;
+    return false;
+  }
+  s.done = last;
+  return true;
+}
+
+const unsigned char* InflateStream::block() const {
+  return state_->window.data() + state_->blockStart;
+}
+
+size_t InflateStream::blockSize() const {
+  return state_->window.size() - state_->blockStart;
+}
+
+bool InflateStream::failed() const {
+  return state_->failed;
+}
+
+size_t InflateStream::inputUsed() const {
+  return state_->in.position();
+}
+
+GzipReader::GzipReader(const unsigned char* data, size_t size, size_t maxBlockOutput)
+    : data_(data), size_(size), maxBlockOutput_(maxBlockOutput) {}
+
+GzipReader::~GzipReader() = default;
+
+bool GzipReader::isGzip(const unsigned char* data, size_t size) {
+  return data && size >= 2 && data[0] == 0x1F && data[1] == 0x8B;
+}
+
+bool GzipReader::next(const unsigned char*& data, size_t& size) {
+  while (!failed_) {
+    if (!inflate_) {
+      if (memberStart_ >= size_) {
+        return false;
+      }
+      if (!beginMember()) {
+        failed_ = true;
+        return false;
+      }
+    }
+    if (inflate_->nextBlock()) {
+      if (inflate_->blockSize() == 0) {
+        continue;
+      }
+      data = inflate_->block();
+      size = inflate_->blockSize();
+      memberLength_ += static_cast<uint32_t>(size);
+      memberCrc_ = crc32(memberCrc_, data, size);
+      return true;
+    }
+    if (inflate_->failed() || !endMember()) {
+      failed_ = true;
+    }
+  }
+  return false;
+}
+
+bool GzipReader::beginMember() {
+  const unsigned char* member = data_ + memberStart_;
+  size_t available = size_ - memberStart_;
+  if (!isGzip(member, available) || available < 10 || member[2] != 8 || (member[3] & GZIP_RESERVED) != 0) {
+    return false;
+  }
+
+  // Fixed 10-byte header, then the optional fields its flags announce
+  unsigned char flags = member[3];
+  size_t position = 10;
+  if (flags & GZIP_EXTRA) {
+    if (available - position < 2) {
+      return false;
+    }
+    size_t extraLength = member[position] | (member[position + 1] << 8);
+    position += 2;
+    if (available - position < extraLength) {
+      return false;
+    }
+    position += extraLength;
+  }
+  for (unsigned char field : {GZIP_NAME, GZIP_COMMENT}) {
+    if (flags & field) {
+      const void* terminator = std::memchr(member + position, 0, available - position);
+      if (!terminator) {
+        return false;
+      }
+      position = static_cast<size_t>(static_cast<const unsigned char*>(terminator) - member) + 1;
+    }
+  }
+  if (flags & GZIP_HEADER_CRC) {
+    if (available - position < 2) {
+      return false;
+    }
+    position += 2;
+  }
+
+  headerSize_ = position;
+  memberLength_ = 0;
+  memberCrc_ = 0;
+  inflate_.reset(new InflateStream(member + position, available - position, maxBlockOutput_));
+  return true;
+}
+
+bool GzipReader::endMember() {
+  // CRC-32 then the decoded length modulo 2^32
+  size_t trailer = memberStart_ + headerSize_ + inflate_->inputUsed();
+  if (size_ - trailer < 8 || readLittleEndian32(data_ + trailer) != memberCrc_ ||
+      readLittleEndian32(data_ + trailer + 4) != memberLength_) {
+    return false;
+  }
+  inflate_.reset();
+  memberStart_ = trailer + 8;
+  if (!isGzip(data_ + memberStart_, size_ - memberStart_)) {
+    memberStart_ = size_;  // Trailing padding after the last member is ignored, as gzip does
+  }
+  return true;
+}
+
+}  // namespace Utils
+}  // namespace ChipCarving
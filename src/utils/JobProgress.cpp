@@ -0,0 +1,81 @@
+/**
+ * JobProgress.cpp
+ *
+ * Background job progress counters with throttled listener notification
+ */
+
+#include "utils/JobProgress.h"
+
+#include <thread>
+#include <utility>
+
+namespace ChipCarving {
+namespace Utils {
+
+constexpr int JobProgress::DEFAULT_NOTIFY_INTERVAL_MS;
+constexpr int JobProgress::CANCEL_POLL_MS;
+
+void JobProgress::setListener(Listener listener, int intervalMs) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  listener_ = std::move(listener);
+  interval_ = std::chrono::milliseconds(intervalMs);
+}
+
+void JobProgress::beginStage(const char* stage, size_t total) {
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    stage_ = stage;
+    total_ = total;
+    completed_.store(0, std::memory_order_relaxed);
+  }
+  notify(true);
+}
+
+void JobProgress::advance(size_t count) {
+  completed_.fetch_add(count, std::memory_order_relaxed);
+  notify(false);
+}
+
+void JobProgress::finish() {
+  finished_.store(true, std::memory_order_release);
+  notify(true);
+}
+
+bool JobProgress::waitUnlessCancelled(int delayMs) const {
+  auto deadline = std::chrono::steady_clock::now() + std::chrono::milliseconds(delayMs);
+  while (std::chrono::steady_clock::now() < deadline) {
+    if (isCancelled()) {
+      return false;
+    }
+    std::this_thread::sleep_for(std::chrono::milliseconds(CANCEL_POLL_MS));
+  }
+  return !isCancelled();
+}
+
+JobProgress::Snapshot JobProgress::snapshot() const {
+  Snapshot snapshot;
+  std::lock_guard<std::mutex> lock(mutex_);
+  snapshot.stage = stage_;
+  snapshot.total = total_;
+  snapshot.completed = completed_.load(std::memory_order_relaxed);
+  snapshot.cancelled = isCancelled();
+  return snapshot;
+}
+
+void JobProgress::notify(bool force) {
+  Listener listener;
+  {
+    // Worker threads of a stage race here; only one of them notifies per interval
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto now = std::chrono::steady_clock::now();
+    if (!listener_ || (!force && now - lastNotify_ < interval_)) {
+      return;
+    }
+    lastNotify_ = now;
+    listener = listener_;
+  }
+  listener();
+}
+
+}  // namespace Utils
+}  // namespace ChipCarving
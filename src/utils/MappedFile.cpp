@@ -0,0 +1,149 @@
+/**
+ * MappedFile.cpp
+ *
+ * Read-only memory mapping of a whole file
+ * Split from MedialAxisDiskCache.cpp so the design parser can share it
+ */
+
+#include "utils/MappedFile.h"
+
+#include <fstream>
+
+#ifdef _WIN32
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace ChipCarving {
+namespace Utils {
+
+#ifdef _WIN32
+
+namespace {
+
+std::wstring widenPath(const std::string& path) {
+  int length = ::MultiByteToWideChar(CP_UTF8, 0, path.c_str(), -1, nullptr, 0);
+  if (length <= 0) {
+    return std::wstring();
+  }
+  std::wstring wide(static_cast<size_t>(length), L'\0');
+  ::MultiByteToWideChar(CP_UTF8, 0, path.c_str(), -1, &wide[0], length);
+  wide.resize(static_cast<size_t>(length - 1));
+  return wide;
+}
+
+}  // namespace
+
+bool MappedFile::map(const std::string& path) {
+  HANDLE file = ::CreateFileW(widenPath(path).c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING,
+                              FILE_ATTRIBUTE_NORMAL, nullptr);
+  if (file == INVALID_HANDLE_VALUE) {
+    return false;
+  }
+
+  LARGE_INTEGER fileSize{};
+  bool mapped = false;
+  if (::GetFileSizeEx(file, &fileSize)) {
+    open_ = true;
+    if (fileSize.QuadPart == 0) {
+      mapped = true;  // Nothing to map
+    } else {
+      HANDLE mapping = ::CreateFileMappingW(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+      if (mapping) {
+        void* view = ::MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+        ::CloseHandle(mapping);  // The view keeps the mapping alive
+        if (view) {
+          data_ = static_cast<const unsigned char*>(view);
+          size_ = static_cast<size_t>(fileSize.QuadPart);
+          mapped_ = true;
+          mapped = true;
+        }
+      }
+    }
+  }
+  ::CloseHandle(file);
+  return mapped;
+}
+
+void MappedFile::unmap() {
+  ::UnmapViewOfFile(data_);
+}
+
+#else
+
+bool MappedFile::map(const std::string& path) {
+  int fd = ::open(path.c_str(), O_RDONLY);
+  if (fd < 0) {
+    return false;
+  }
+
+  bool mapped = false;
+  struct stat info {};
+  if (::fstat(fd, &info) == 0) {
+    open_ = true;
+    if (info.st_size == 0) {
+      mapped = true;  // Nothing to map
+    } else {
+      void* view = ::mmap(nullptr, static_cast<size_t>(info.st_size), PROT_READ, MAP_PRIVATE, fd, 0);
+      if (view != MAP_FAILED) {
+        data_ = static_cast<const unsigned char*>(view);
+        size_ = static_cast<size_t>(info.st_size);
+        mapped_ = true;
+        mapped = true;
+      }
+    }
+  }
+  ::close(fd);
+  return mapped;
+}
+
+void MappedFile::unmap() {
+  ::munmap(const_cast<unsigned char*>(data_), size_);
+}
+
+#endif
+
+MappedFile::MappedFile(const std::string& path, bool mapFile) {
+  if (mapFile && map(path)) {
+    return;
+  }
+
+  // Mapping can fail where reading works (some network and FUSE file systems);
+  // fall back to a single read into an owned buffer
+  std::ifstream file(path, std::ios::binary | std::ios::ate);
+  if (!file.is_open()) {
+    open_ = false;
+    return;
+  }
+  std::streamoff length = file.tellg();
+  if (length < 0) {
+    open_ = false;
+    return;
+  }
+  buffer_.resize(static_cast<size_t>(length));
+  file.seekg(0);
+  if (length > 0 && !file.read(&buffer_[0], length)) {
+    buffer_.clear();
+    open_ = false;
+    return;
+  }
+  open_ = true;
+  data_ = buffer_.empty() ? nullptr : reinterpret_cast<const unsigned char*>(buffer_.data());
+  size_ = buffer_.size();
+}
+
+MappedFile::~MappedFile() {
+  if (mapped_) {
+    unmap();
+  }
+}
+
+}  // namespace Utils
+}  // namespace ChipCarving
@@ -0,0 +1,152 @@
+/**
+ * MemoryUsage.cpp
+ *
+ * OS resident set size counters, the sampler thread and nested peak windows
+ */
+
+#include "utils/MemoryUsage.h"
+
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+
+#include "utils/AllocationTracking.h"
+
+#ifdef _WIN32
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+// clang-format off
+#include <windows.h>
+#include <psapi.h>
+// clang-format on
+#else
+#include <sys/resource.h>
+#include <unistd.h>
+#ifdef __APPLE__
+#include <mach/mach.h>
+#endif
+#endif
+
+namespace ChipCarving {
+namespace Utils {
+
+namespace {
+
+std::atomic<uint64_t> g_residentBytes{0};  // Latest sample; zero while no sampler runs
+std::atomic<uint64_t> g_peakResidentBytes{0};
+std::atomic<int> g_samplers{0};
+
+void raiseResidentPeak(uint64_t bytes) {
+  uint64_t peak = g_peakResidentBytes.load(std::memory_order_relaxed);
+  while (bytes > peak && !g_peakResidentBytes.compare_exchange_weak(peak, bytes, std::memory_order_relaxed)) {
+  }
+}
+
+void sampleResident() {
+  uint64_t bytes = currentResidentBytes();
+  g_residentBytes.store(bytes, std::memory_order_relaxed);
+  raiseResidentPeak(bytes);
+}
+
+}  // namespace
+
+constexpr int MemorySampler::DEFAULT_INTERVAL_MS;
+
+uint64_t currentResidentBytes() {
+#if defined(_WIN32)
+  PROCESS_MEMORY_COUNTERS counters;
+  if (!GetProcessMemoryInfo(GetCurrentProcess(), &counters, sizeof(counters))) {
+    return 0;
+  }
+  return counters.WorkingSetSize;
+#elif defined(__APPLE__)
+  mach_task_basic_info_data_t info;
+  mach_msg_type_number_t count = MACH_TASK_BASIC_INFO_COUNT;
+  if (task_info(mach_task_self(), MACH_TASK_BASIC_INFO, reinterpret_cast<task_info_t>(&info), &count) !=
+      KERN_SUCCESS) {
+    return 0;
+  }
+  return info.resident_size;
+#else
+  std::FILE* statm = std::fopen("/proc/self/statm", "r");
+  if (!statm) {
+    return 0;
+  }
+  unsigned long long sizePages = 0;
+  unsigned long long residentPages = 0;
+  int fields = std::fscanf(statm, "%llu %llu", &sizePages, &residentPages);
+  std::fclose(statm);
+  long pageSize = sysconf(_SC_PAGESIZE);
+  return fields == 2 && pageSize > 0 ? residentPages * static_cast<uint64_t>(pageSize) : 0;
+#endif
+}
+
+uint64_t processPeakResidentBytes() {
+#if defined(_WIN32)
+  PROCESS_MEMORY_COUNTERS counters;
+  if (!GetProcessMemoryInfo(GetCurrentProcess(), &counters, sizeof(counters))) {
+    return 0;
+  }
+  return counters.PeakWorkingSetSize;
+#else
+  struct rusage usage;
+  if (getrusage(RUSAGE_SELF, &usage) != 0 || usage.ru_maxrss < 0) {
+    return 0;
+  }
+#ifdef __APPLE__
+  return static_cast<uint64_t>(usage.ru_maxrss);  // Bytes on macOS
+#else
+  return static_cast<uint64_t>(usage.ru_maxrss) * 1024;  // Kilobytes on Linux
+#endif
+#endif
+}
+
+MemoryPeaks openMemoryWindow() {
+  MemoryPeaks enclosing;
+  enclosing.residentBytes = g_peakResidentBytes.exchange(g_residentBytes.load(std::memory_order_relaxed),
+                                                         std::memory_order_relaxed);
+  enclosing.liveBytes = resetPeakLiveAllocatedBytes();
+  return enclosing;
+}
+
+MemoryPeaks closeMemoryWindow(const MemoryPeaks& enclosing) {
+  MemoryPeaks peaks;
+  peaks.residentBytes = g_peakResidentBytes.load(std::memory_order_relaxed);
+  peaks.liveBytes = peakLiveAllocatedBytes();
+  raiseResidentPeak(enclosing.residentBytes);
+  raisePeakLiveAllocatedBytes(enclosing.liveBytes);
+  return peaks;
+}
+
+MemorySampler::MemorySampler(int intervalMs) {
+  if (g_samplers.fetch_add(1) > 0) {
+    return;
+  }
+  sampleResident();
+  thread_ = std::thread([this, intervalMs]() { run(intervalMs); });
+}
+
+MemorySampler::~MemorySampler() {
+  if (thread_.joinable()) {
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      stopping_ = true;
+    }
+    wake_.notify_one();
+    thread_.join();
+    sampleResident();
+    g_residentBytes.store(0, std::memory_order_relaxed);
+  }
+  g_samplers.fetch_sub(1);
+}
+
+void MemorySampler::run(int intervalMs) {
+  std::unique_lock<std::mutex> lock(mutex_);
+  while (!wake_.wait_for(lock, std::chrono::milliseconds(intervalMs), [this] { return stopping_; })) {
+    sampleResident();
+  }
+}
+
+}  // namespace Utils
+}  // namespace ChipCarving
@@ -0,0 +1,52 @@
+/**
+ * MonotonicArena.cpp
+ */
+
+#include "utils/MonotonicArena.h"
+
+#include <algorithm>
+
+namespace ChipCarving {
+namespace Utils {
+
+namespace {
+
+// Block headers take a whole max_align_t so the memory after them is aligned for anything
+constexpr size_t HEADER_SIZE = (sizeof(void*) + alignof(std::max_align_t) - 1) / alignof(std::max_align_t) *
+                               alignof(std::max_align_t);
+
+}  // namespace
+
+constexpr size_t MonotonicArena::DEFAULT_BLOCK_SIZE;
+constexpr size_t MonotonicArena::MAX_BLOCK_SIZE;
+
+MonotonicArena::MonotonicArena(size_t initialBlockSize)
+    : nextBlockSize_(std::max<size_t>(initialBlockSize, HEADER_SIZE * 2)) {}
+
+MonotonicArena::~MonotonicArena() {
+  while (head_) {
+    Block* previous = head_->previous;
+    ::operator delete(head_);
+    head_ = previous;
+  }
+}
+
+void* MonotonicArena::allocateFromNewBlock(size_t bytes) {
+  // Oversized requests get a block of their own; the growth sequence carries on regardless
+  size_t blockSize = std::max(nextBlockSize_, HEADER_SIZE + bytes);
+  nextBlockSize_ = std::min(nextBlockSize_ * 2, MAX_BLOCK_SIZE);
+
+  Block* block = static_cast<Block*>(::operator new(blockSize));
+  block->previous = head_;
+  head_ = block;
+  ++blockCount_;
+
+  char* memory = reinterpret_cast<char*>(block) + HEADER_SIZE;
+  cursor_ = memory + bytes;
+  end_ = reinterpret_cast<char*>(block) + blockSize;
+  bytesUsed_ += bytes;
+  return memory;
+}
+
+}  // namespace Utils
+}  // namespace ChipCarving
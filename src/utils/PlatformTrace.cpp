@@ -0,0 +1,153 @@
+/**
+ * PlatformTrace.cpp
+ *
+ * Native profiler backends behind PlatformTrace.h; one is chosen at compile time
+ */
+
+#include "utils/PlatformTrace.h"
+
+#include <atomic>
+
+#if defined(CHIP_CARVING_ITT)
+#include <ittnotify.h>
+
+#include <mutex>
+#include <unordered_map>
+#elif defined(__APPLE__)
+#include <os/log.h>
+#include <os/signpost.h>
+#elif defined(_WIN32)
+// clang-format off
+#include <windows.h>
+#include <TraceLoggingProvider.h>
+// clang-format on
+#endif
+
+namespace ChipCarving {
+namespace Utils {
+
+namespace {
+
+std::atomic<bool> g_enabled{false};
+
+#if defined(CHIP_CARVING_ITT)
+
+constexpr const char* BACKEND = "ITT";
+
+__itt_domain* domain() {
+  static __itt_domain* const itt = __itt_domain_create("ChipCarving");
+  return itt;
+}
+
+// Span names are literals, so handles are cached by address
+__itt_string_handle* nameHandle(const char* name) {
+  static std::mutex mutex;
+  static std::unordered_map<const char*, __itt_string_handle*> handles;
+  std::lock_guard<std::mutex> lock(mutex);
+  __itt_string_handle*& handle = handles[name];
+  if (!handle) {
+    handle = __itt_string_handle_create(name);
+  }
+  return handle;
+}
+
+void registerBackend() {}
+
+#elif defined(__APPLE__)
+
+constexpr const char* BACKEND = "os_signpost";
+
+os_log_t signpostLog() {
+  static const os_log_t log = os_log_create("com.chipcarving.paths", "Stages");
+  return log;
+}
+
+void registerBackend() {}
+
+#elif defined(_WIN32)
+
+constexpr const char* BACKEND = "ETW";
+
+// {6B1F2C64-93A5-4E0B-9C1D-5E7A2F40B8D3}
+TRACELOGGING_DEFINE_PROVIDER(g_provider, "ChipCarving.Paths",
+                             (0x6b1f2c64, 0x93a5, 0x4e0b, 0x9c, 0x1d, 0x5e, 0x7a, 0x2f, 0x40, 0xb8, 0xd3));
+
+// Unregisters when the add-in unloads, as ETW requires
+struct ProviderRegistration {
+  ProviderRegistration() {
+    TraceLoggingRegister(g_provider);
+  }
+  ~ProviderRegistration() {
+    TraceLoggingUnregister(g_provider);
+  }
+};
+
+void registerBackend() {
+  static ProviderRegistration registration;
+}
+
+#else
+
+constexpr const char* BACKEND = "none";
+
+#endif
+
+}  // namespace
+
+const char* platformTraceBackend() {
+  return BACKEND;
+}
+
+void setPlatformTraceEnabled(bool enabled) {
+#if defined(CHIP_CARVING_ITT) || defined(__APPLE__) || defined(_WIN32)
+  if (enabled) {
+    registerBackend();
+  }
+  g_enabled.store(enabled, std::memory_order_relaxed);
+#else
+  (void)enabled;
+#endif
+}
+
+bool platformTraceEnabled() {
+  return g_enabled.load(std::memory_order_relaxed);
+}
+
+uint64_t beginPlatformSpan(const char* name) {
+#if defined(CHIP_CARVING_ITT)
+  __itt_task_begin(domain(), __itt_null, __itt_null, nameHandle(name));
+  return 0;
+#elif defined(__APPLE__)
+  os_log_t log = signpostLog();
+  os_signpost_id_t id = os_signpost_id_generate(log);
+  os_signpost_interval_begin(log, id, "TraceSpan", "%{public}s", name);
+  return id;
+#elif defined(_WIN32)
+  TraceLoggingWrite(g_provider, "TraceSpan", TraceLoggingOpcode(WINEVENT_OPCODE_START),
+                    TraceLoggingString(name, "Name"));
+  return 0;
+#else
+  (void)name;
+  return 0;
+#endif
+}
+
+void endPlatformSpan(const char* name, uint64_t token) {
+#if defined(CHIP_CARVING_ITT)
+  (void)name;
+  (void)token;
+  __itt_task_end(domain());
+#elif defined(__APPLE__)
+  os_signpost_interval_end(signpostLog(), static_cast<os_signpost_id_t>(token), "TraceSpan", "%{public}s", name);
+#elif defined(_WIN32)
+  (void)token;
+  TraceLoggingWrite(g_provider, "TraceSpan", TraceLoggingOpcode(WINEVENT_OPCODE_STOP),
+                    TraceLoggingString(name, "Name"));
+#else
+  (void)name;
+  (void)token;
+#endif
+}
+
+}  // namespace Utils
+}  // namespace ChipCarving
@@ -0,0 +1,73 @@
+/**
+ * RunErrorContext.cpp
+ *
+ * Per-run error collection across worker threads
+ */
+
+#include "utils/RunErrorContext.h"
+
+#include <algorithm>
+#include <iterator>
+
+#include "adapters/IFusionInterface.h"
+#include "utils/logging.h"
+
+namespace ChipCarving {
+namespace Utils {
+
+constexpr size_t RunErrorContext::NO_PROFILE;
+
+void RunErrorContext::record(size_t profile, const char* operation, std::string message) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  errors_.push_back(Error{profile, operation, std::move(message)});
+}
+
+void RunErrorContext::merge(std::vector<Error>& errors) {
+  if (errors.empty()) {
+    return;
+  }
+  std::lock_guard<std::mutex> lock(mutex_);
+  errors_.insert(errors_.end(), std::make_move_iterator(errors.begin()), std::make_move_iterator(errors.end()));
+  errors.clear();
+}
+
+size_t RunErrorContext::errorCount() const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return errors_.size();
+}
+
+std::vector<RunErrorContext::Error> RunErrorContext::takeErrors() {
+  std::vector<Error> errors;
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    errors.swap(errors_);
+  }
+  // Workers merge in whatever order they finish; run-wide errors sort last
+  std::stable_sort(errors.begin(), errors.end(),
+                   [](const Error& a, const Error& b) { return a.profile < b.profile; });
+  return errors;
+}
+
+size_t RunErrorContext::report(const Adapters::ILogger* logger) {
+  std::vector<Error> errors = takeErrors();
+  for (const auto& error : errors) {
+    std::string message = describe(error);
+    LOG_WARNING(message);
+    if (logger) {
+      logger->logWarning(message);
+    }
+  }
+  return errors.size();
+}
+
+std::string RunErrorContext::describe(const Error& error) {
+  std::string text = "Exception in ";
+  text += error.operation;
+  if (error.profile != NO_PROFILE) {
+    text += " for profile " + std::to_string(error.profile);
+  }
+  return text + ": " + error.message;
+}
+
+}  // namespace Utils
+}  // namespace ChipCarving
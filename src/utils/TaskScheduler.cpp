@@ -0,0 +1,194 @@
+/**
+ * TaskScheduler.cpp
+ *
+ * Cost-ordered work-stealing pool with nested task groups
+ */
+
+#include "utils/TaskScheduler.h"
+
+#include <algorithm>
+#include <chrono>
+#include <stdexcept>
+#include <thread>
+#include <utility>
+
+#include "utils/TraceSpan.h"
+#include "utils/logging.h"
+
+namespace ChipCarving {
+namespace Utils {
+
+namespace {
+
+// Idle workers recheck the queues this often in case a wakeup raced their wait
+constexpr auto IDLE_POLL = std::chrono::milliseconds(2);
+
+thread_local TaskScheduler* t_scheduler = nullptr;
+thread_local int t_workerIndex = -1;
+thread_local double t_nestedSeconds = 0.0;  // Time the current task spent running other tasks
+
+TaskScheduler& runningScheduler() {
+  if (!t_scheduler) {
+    throw std::logic_error("TaskGroup created outside a scheduler task");
+  }
+  return *t_scheduler;
+}
+
+}  // namespace
+
+TaskScheduler::TaskGroup::TaskGroup()
+    : scheduler_(runningScheduler()), worker_(static_cast<size_t>(t_workerIndex)) {}
+
+TaskScheduler::TaskGroup::~TaskGroup() {
+  wait();
+}
+
+void TaskScheduler::TaskGroup::spawn(double cost, Task task) {
+  remaining_.fetch_add(1);
+  scheduler_.unfinished_.fetch_add(1);
+  scheduler_.push(worker_, Entry{cost, std::move(task), this});
+  std::lock_guard<std::mutex> lock(scheduler_.wakeMutex_);
+  scheduler_.wake_.notify_all();
+}
+
+void TaskScheduler::TaskGroup::wait() {
+  while (remaining_.load() > 0) {
+    Entry entry;
+    if (scheduler_.take(worker_, this, entry)) {
+      scheduler_.execute(worker_, entry);
+      continue;
+    }
+    // Other workers hold the rest of the group
+    std::unique_lock<std::mutex> lock(scheduler_.wakeMutex_);
+    scheduler_.wake_.wait_for(lock, IDLE_POLL, [this] { return remaining_.load() == 0; });
+  }
+}
+
+TaskScheduler::TaskScheduler(int workers) {
+  for (int w = 0; w < std::max(1, workers); ++w) {
+    workers_.push_back(std::make_unique<Worker>());
+  }
+}
+
+TaskScheduler::~TaskScheduler() = default;
+
+void TaskScheduler::submit(double cost, Task task) {
+  submitted_.push_back(Entry{cost, std::move(task), nullptr});
+}
+
+void TaskScheduler::push(size_t worker, Entry entry) {
+  Worker& target = *workers_[worker];
+  std::lock_guard<std::mutex> lock(target.mutex);
+  auto position = std::upper_bound(target.tasks.begin(), target.tasks.end(), entry.cost,
+                                   [](double cost, const Entry& queued) { return cost > queued.cost; });
+  target.tasks.insert(position, std::move(entry));
+}
+
+bool TaskScheduler::take(size_t worker, const TaskGroup* group, Entry& entry) {
+  for (size_t k = 0; k < workers_.size(); ++k) {
+    Worker& victim = *workers_[(worker + k) % workers_.size()];
+    std::lock_guard<std::mutex> lock(victim.mutex);
+    auto found = group ? std::find_if(victim.tasks.begin(), victim.tasks.end(),
+                                      [group](const Entry& queued) { return queued.group == group; })
+                       : victim.tasks.begin();
+    if (found != victim.tasks.end()) {
+      entry = std::move(*found);
+      victim.tasks.erase(found);
+      return true;
+    }
+  }
+  return false;
+}
+
+void TaskScheduler::execute(size_t worker, Entry& entry) {
+  double outerNested = t_nestedSeconds;
+  t_nestedSeconds = 0.0;
+  auto start = std::chrono::steady_clock::now();
+  try {
+    entry.task();
+  } catch (...) {
+    std::lock_guard<std::mutex> lock(errorMutex_);
+    if (!firstError_) {
+      firstError_ = std::current_exception();
+    }
+  }
+  double elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+  workers_[worker]->timings.push_back(TaskTiming{entry.cost, elapsed - t_nestedSeconds, entry.group != nullptr});
+  t_nestedSeconds = outerNested + elapsed;
+
+  bool groupDone = entry.group && entry.group->remaining_.fetch_sub(1) == 1;
+  bool allDone = unfinished_.fetch_sub(1) == 1;
+  if (groupDone || allDone) {
+    // Lock so a waiter between its check and its wait cannot miss this
+    std::lock_guard<std::mutex> lock(wakeMutex_);
+    wake_.notify_all();
+  }
+}
+
+void TaskScheduler::workerLoop(size_t worker) {
+  while (unfinished_.load() > 0) {
+    Entry entry;
+    if (take(worker, nullptr, entry)) {
+      execute(worker, entry);
+      continue;
+    }
+    std::unique_lock<std::mutex> lock(wakeMutex_);
+    wake_.wait_for(lock, IDLE_POLL, [this] { return unfinished_.load() == 0; });
+  }
+}
+
+void TaskScheduler::run() {
+  timings_.clear();
+  firstError_ = nullptr;
+  std::stable_sort(submitted_.begin(), submitted_.end(),
+                   [](const Entry& a, const Entry& b) { return a.cost > b.cost; });
+  unfinished_ = submitted_.size();
+  for (size_t i = 0; i < submitted_.size(); ++i) {
+    push(i % workers_.size(), std::move(submitted_[i]));
+  }
+  submitted_.clear();
+
+  TraceRecorder* recorder = currentTraceRecorder();
+  std::vector<std::thread> threads;
+  for (size_t w = 0; w < workers_.size(); ++w) {
+    threads.emplace_back([this, w, recorder]() {
+      SetThreadConsoleLoggingSuppressed(true);
+      ScopedTraceRecorder trace(recorder);
+      t_scheduler = this;
+      t_workerIndex = static_cast<int>(w);
+      workerLoop(w);
+      t_scheduler = nullptr;
+      t_workerIndex = -1;
+    });
+  }
+  for (auto& thread : threads) {
+    thread.join();
+  }
+
+  for (auto& worker : workers_) {
+    timings_.insert(timings_.end(), worker->timings.begin(), worker->timings.end());
+    worker->timings.clear();
+  }
+  if (firstError_) {
+    std::rethrow_exception(firstError_);
+  }
+}
+
+int TaskScheduler::currentWorkerIndex() {
+  return t_workerIndex;
+}
+
+double TaskScheduler::fitSecondsPerCost(const std::vector<TaskTiming>& timings) {
+  double costSeconds = 0.0;
+  double costSquared = 0.0;
+  for (const auto& timing : timings) {
+    if (timing.cost > 0.0) {
+      costSeconds += timing.cost * timing.seconds;
+      costSquared += timing.cost * timing.cost;
+    }
+  }
+  return costSquared > 0.0 ? costSeconds / costSquared : 0.0;
+}
+
+}  // namespace Utils
+}  // namespace ChipCarving
@@ -0,0 +1,48 @@
+/**
+ * TraceJson.h
+ *
+ * Number and string formatting shared by the run metrics, trace and run
+ * history JSON writers (internal to src)
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <cstdio>
+#include <string>
+
+namespace ChipCarving {
+namespace Utils {
+
+inline std::string formatFixed(double value) {
+  char buffer[32];
+  std::snprintf(buffer, sizeof(buffer), "%.3f", value);
+  return buffer;
+}
+
+inline std::string formatMegabytes(uint64_t bytes) {
+  char buffer[32];
+  std::snprintf(buffer, sizeof(buffer), "%.1f MB", static_cast<double>(bytes) / (1024.0 * 1024.0));
+  return buffer;
+}
+
+// Span names are literals, but keep the JSON valid whatever they contain
+inline void appendJsonString(std::string& out, const std::string& text) {
+  out.push_back('"');
+  for (char c : text) {
+    if (c == '"' || c == '\\') {
+      out.push_back('\\');
+      out.push_back(c);
+    } else if (static_cast<unsigned char>(c) < 0x20) {
+      char escaped[8];
+      std::snprintf(escaped, sizeof(escaped), "\\u%04x", static_cast<unsigned int>(c));
+      out += escaped;
+    } else {
+      out.push_back(c);
+    }
+  }
+  out.push_back('"');
+}
+
+}  // namespace Utils
+}  // namespace ChipCarving
@@ -0,0 +1,324 @@
+/**
+ * TraceSpan.cpp
+ *
+ * Per-run span tree and Chrome trace recorder behind TraceSpan
+ */
+
+#include "utils/TraceSpan.h"
+
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+
+#include "TraceJson.h"
+#include "utils/PlatformTrace.h"
+
+namespace ChipCarving {
+namespace Utils {
+
+namespace {
+
+thread_local RunMetrics* t_currentMetrics = nullptr;
+thread_local TraceRecorder* t_currentRecorder = nullptr;
+
+// Chrome trace events all belong to one process
+constexpr int TRACE_PID = 1;
+
+}  // namespace
+
+constexpr size_t RunMetrics::NO_PARENT;
+
+size_t RunMetrics::open(const char* name) {
+  if (spans_.empty()) {
+    unixTime_ = std::chrono::duration_cast<std::chrono::seconds>(std::chrono::system_clock::now().time_since_epoch())
+                    .count();
+  }
+
+  // Merge with an existing sibling of the same name
+  for (size_t i = 0; i < spans_.size(); ++i) {
+    const Span& span = spans_[i];
+    if (span.parent == current_ && (span.name == name || std::strcmp(span.name, name) == 0)) {
+      current_ = i;
+      return i;
+    }
+  }
+
+  Span span;
+  span.name = name;
+  span.parent = current_;
+  spans_.push_back(span);
+  current_ = spans_.size() - 1;
+  return current_;
+}
+
+void RunMetrics::close(size_t index, double elapsedMs, const AllocationTotals& allocated, const MemoryPeaks& memory) {
+  Span& span = spans_[index];
+  ++span.count;
+  span.totalMs += elapsedMs;
+  span.allocations += allocated.count;
+  span.allocatedBytes += allocated.bytes;
+  span.peakResidentBytes = std::max(span.peakResidentBytes, memory.residentBytes);
+  span.peakLiveBytes = std::max(span.peakLiveBytes, memory.liveBytes);
+  if (elapsedMs > span.maxMs) {
+    span.maxMs = elapsedMs;
+  }
+  current_ = span.parent;
+}
+
+std::string RunMetrics::pathOf(size_t index) const {
+  std::string path = spans_[index].name;
+  for (size_t parent = spans_[index].parent; parent != NO_PARENT; parent = spans_[parent].parent) {
+    path = std::string(spans_[parent].name) + "/" + path;
+  }
+  return path;
+}
+
+const RunMetrics::Span* RunMetrics::find(const std::string& path) const {
+  for (size_t i = 0; i < spans_.size(); ++i) {
+    if (pathOf(i) == path) {
+      return &spans_[i];
+    }
+  }
+  return nullptr;
+}
+
+std::string RunMetrics::toJson() const {
+  std::string json = "{\"unixTime\":" + std::to_string(unixTime_) + ",\"spans\":[";
+  for (size_t i = 0; i < spans_.size(); ++i) {
+    const Span& span = spans_[i];
+    if (i > 0) {
+      json.push_back(',');
+    }
+    json += "{\"path\":";
+    appendJsonString(json, pathOf(i));
+    json += ",\"count\":" + std::to_string(span.count) + ",\"totalMs\":" + formatFixed(span.totalMs) +
+            ",\"maxMs\":" + formatFixed(span.maxMs);
+    if (allocationTrackingEnabled()) {
+      json += ",\"allocations\":" + std::to_string(span.allocations) +
+              ",\"allocatedBytes\":" + std::to_string(span.allocatedBytes) +
+              ",\"peakLiveBytes\":" + std::to_string(span.peakLiveBytes);
+    }
+    if (span.peakResidentBytes > 0) {
+      json += ",\"peakResidentBytes\":" + std::to_string(span.peakResidentBytes);
+    }
+    json.push_back('}');
+  }
+  json.push_back(']');
+  if (!apiCalls_.empty()) {
+    json += ",\"apiCalls\":" + apiCallsJson();
+  }
+  json.push_back('}');
+  return json;
+}
+
+std::string RunMetrics::summary() const {
+  std::string text;
+  for (size_t i = 0; i < spans_.size(); ++i) {
+    const Span& span = spans_[i];
+    size_t depth = 0;
+    for (size_t parent = span.parent; parent != NO_PARENT; parent = spans_[parent].parent) {
+      ++depth;
+    }
+    text += std::string(2 * depth, ' ') + span.name + ": " + formatFixed(span.totalMs) + "ms";
+    if (span.count > 1) {
+      text += " (" + std::to_string(span.count) + " calls, max " + formatFixed(span.maxMs) + "ms)";
+    }
+    if (allocationTrackingEnabled()) {
+      text += " [" + std::to_string(span.allocations) + " allocs, " + std::to_string(span.allocatedBytes) +
+              " bytes, peak live " + formatMegabytes(span.peakLiveBytes) + "]";
+    }
+    if (span.peakResidentBytes > 0) {
+      text += " [peak RSS " + formatMegabytes(span.peakResidentBytes) + "]";
+    }
+    text.push_back('\n');
+  }
+  return text + apiCallsSummary();
+}
+
+bool RunMetrics::appendTo(const std::string& filePath) const {
+  std::ofstream out(filePath, std::ios::out | std::ios::app);
+  if (!out.is_open()) {
+    return false;
+  }
+  out << toJson() << '\n';
+  return static_cast<bool>(out);
+}
+
+void RunMetrics::clear() {
+  spans_.clear();
+  apiCalls_.clear();
+  current_ = NO_PARENT;
+  unixTime_ = 0;
+}
+
+constexpr size_t TraceRecorder::MAX_EVENTS;
+
+TraceRecorder::TraceRecorder() : origin_(std::chrono::steady_clock::now()) {
+  threads_.push_back(std::this_thread::get_id());
+}
+
+size_t TraceRecorder::threadIndex() {
+  std::thread::id id = std::this_thread::get_id();
+  for (size_t i = 0; i < threads_.size(); ++i) {
+    if (threads_[i] == id) {
+      return i;
+    }
+  }
+  threads_.push_back(id);
+  return threads_.size() - 1;
+}
+
+double TraceRecorder::sinceOrigin(std::chrono::steady_clock::time_point time) const {
+  return std::chrono::duration<double, std::micro>(time - origin_).count();
+}
+
+void TraceRecorder::append(const Event& event) {
+  if (events_.size() >= MAX_EVENTS) {
+    ++dropped_;
+    return;
+  }
+  events_.push_back(event);
+}
+
+void TraceRecorder::recordSpan(const char* name, std::chrono::steady_clock::time_point start,
+                               std::chrono::steady_clock::time_point end) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  append(Event{name, 'X', threadIndex(), sinceOrigin(start), sinceOrigin(end) - sinceOrigin(start)});
+}
+
+void TraceRecorder::addToCounter(const char* name, double delta) {
+  double timestamp = sinceOrigin(std::chrono::steady_clock::now());
+  std::lock_guard<std::mutex> lock(mutex_);
+  auto counter = std::find_if(counters_.begin(), counters_.end(), [name](const std::pair<const char*, double>& c) {
+    return c.first == name || std::strcmp(c.first, name) == 0;
+  });
+  if (counter == counters_.end()) {
+    counters_.emplace_back(name, 0.0);
+    counter = counters_.end() - 1;
+  }
+  counter->second += delta;
+  append(Event{counter->first, 'C', threadIndex(), timestamp, counter->second});
+}
+
+size_t TraceRecorder::eventCount() const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return events_.size();
+}
+
+size_t TraceRecorder::droppedCount() const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return dropped_;
+}
+
+std::string TraceRecorder::toJson() const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  std::string json = "{\"displayTimeUnit\":\"ms\",\"otherData\":{\"droppedEvents\":" + std::to_string(dropped_) +
+                     "},\"traceEvents\":[";
+  const std::string common = ",\"pid\":" + std::to_string(TRACE_PID) + ",\"tid\":";
+
+  // Thread names first so viewers label the tracks
+  for (size_t i = 0; i < threads_.size(); ++i) {
+    std::string threadName = i == 0 ? "command" : "worker " + std::to_string(i);
+    if (i > 0) {
+      json.push_back(',');
+    }
+    json += "\n{\"name\":\"thread_name\",\"ph\":\"M\"" + common + std::to_string(i) + ",\"args\":{\"name\":";
+    appendJsonString(json, threadName);
+    json += "}}";
+  }
+
+  for (const Event& event : events_) {
+    json += ",\n{\"name\":";
+    appendJsonString(json, event.name);
+    json += ",\"ph\":\"";
+    json.push_back(event.phase);
+    json += "\"" + common + std::to_string(event.thread) + ",\"ts\":" + formatFixed(event.timestampUs);
+    if (event.phase == 'X') {
+      json += ",\"dur\":" + formatFixed(event.value) + "}";
+    } else {
+      json += ",\"args\":{\"value\":" + formatFixed(event.value) + "}}";
+    }
+  }
+  json += "\n]}\n";
+  return json;
+}
+
+bool TraceRecorder::writeTo(const std::string& filePath) const {
+  std::ofstream out(filePath, std::ios::out | std::ios::trunc);
+  if (!out.is_open()) {
+    return false;
+  }
+  out << toJson();
+  return static_cast<bool>(out);
+}
+
+ScopedRunMetrics::ScopedRunMetrics(RunMetrics& metrics, TraceRecorder* recorder)
+    : previousMetrics_(t_currentMetrics), previousRecorder_(t_currentRecorder) {
+  t_currentMetrics = &metrics;
+  t_currentRecorder = recorder;
+}
+
+ScopedRunMetrics::~ScopedRunMetrics() {
+  t_currentMetrics = previousMetrics_;
+  t_currentRecorder = previousRecorder_;
+}
+
+ScopedTraceRecorder::ScopedTraceRecorder(TraceRecorder* recorder) : previous_(t_currentRecorder) {
+  t_currentRecorder = recorder;
+}
+
+ScopedTraceRecorder::~ScopedTraceRecorder() {
+  t_currentRecorder = previous_;
+}
+
+RunMetrics* currentRunMetrics() {
+  return t_currentMetrics;
+}
+
+TraceRecorder* currentTraceRecorder() {
+  return t_currentRecorder;
+}
+
+void traceCount(const char* name, double delta) {
+  if (t_currentRecorder) {
+    t_currentRecorder->addToCounter(name, delta);
+  }
+}
+
+TraceSpan::TraceSpan(const char* name)
+    : name_(name), metrics_(t_currentMetrics), recorder_(t_currentRecorder), platform_(platformTraceEnabled()) {
+  if (metrics_) {
+    index_ = metrics_->open(name);
+    startAllocations_ = threadAllocationTotals();
+    enclosingMemory_ = openMemoryWindow();
+  }
+  if (metrics_ || recorder_) {
+    start_ = std::chrono::steady_clock::now();
+  }
+  if (platform_) {
+    platformToken_ = beginPlatformSpan(name);
+  }
+}
+
+TraceSpan::~TraceSpan() {
+  if (platform_) {
+    endPlatformSpan(name_, platformToken_);
+  }
+  if (!metrics_ && !recorder_) {
+    return;
+  }
+  auto end = std::chrono::steady_clock::now();
+  if (metrics_) {
+    AllocationTotals allocated = threadAllocationTotals();
+    allocated.count -= startAllocations_.count;
+    allocated.bytes -= startAllocations_.bytes;
+    MemoryPeaks memory = closeMemoryWindow(enclosingMemory_);
+    metrics_->close(index_, std::chrono::duration<double, std::milli>(end - start_).count(), allocated, memory);
+  }
+  if (recorder_) {
+    recorder_->recordSpan(name_, start_, end);
+  }
+}
+
+}  // namespace Utils
+}  // namespace ChipCarving
@@ -11,6 +11,8 @@
 
 #pragma once
 
+#include <type_traits>
+
 namespace ChipCarving {
 namespace Utils {
 
@@ -31,13 +33,91 @@ constexpr double RAY_CASTING = 0.001;
 
 }  // namespace Tolerance
 
+// Length units, each with the millimeters in one of it
+struct MillimeterUnit {
+  static constexpr double MM_PER_UNIT = 1.0;
+};
+struct FusionLengthUnit {
+  static constexpr double MM_PER_UNIT = 10.0;  // Fusion database length (cm)
+};
+
+/**
+ * A length in Unit: a double carrying its unit in the type, so lengths in
+ * different units do not mix and a conversion is always an explicit
+ * lengthCast. Everything is constexpr and inlines to the bare double.
+ */
+template <typename Unit>
+class Length {
+ public:
+  constexpr Length() = default;
+  constexpr explicit Length(double value) : value_(value) {}
+
+  constexpr double value() const {
+    return value_;
+  }
+
+  constexpr Length operator+(Length other) const {
+    return Length(value_ + other.value_);
+  }
+  constexpr Length operator-(Length other) const {
+    return Length(value_ - other.value_);
+  }
+  constexpr Length operator-() const {
+    return Length(-value_);
+  }
+  constexpr Length operator*(double factor) const {
+    return Length(value_ * factor);
+  }
+  constexpr Length operator/(double divisor) const {
+    return Length(value_ / divisor);
+  }
+  constexpr double operator/(Length other) const {
+    return value_ / other.value_;
+  }
+  constexpr bool operator<(Length other) const {
+    return value_ < other.value_;
+  }
+  constexpr bool operator==(Length other) const {
+    return value_ == other.value_;
+  }
+
+ private:
+  double value_ = 0.0;
+};
+
+using Millimeters = Length<MillimeterUnit>;
+using FusionLength = Length<FusionLengthUnit>;
+
+static_assert(sizeof(Millimeters) == sizeof(double) && std::is_trivially_copyable<Millimeters>::value,
+              "Length must cost no more than a double");
+
+/**
+ * Same length in another unit
+ * Scales up by multiplying and down by dividing, so mm <-> cm round trips are
+ * exact wherever the plain * 10 and / 10 were
+ */
+template <typename To, typename From>
+constexpr Length<To> lengthCast(Length<From> length) {
+  return Length<To>(From::MM_PER_UNIT >= To::MM_PER_UNIT
+                        ? length.value() * (From::MM_PER_UNIT / To::MM_PER_UNIT)
+                        : length.value() / (To::MM_PER_UNIT / From::MM_PER_UNIT));
+}
+
+constexpr Millimeters toMillimeters(FusionLength length) {
+  return lengthCast<MillimeterUnit>(length);
+}
+
+constexpr FusionLength toFusionLength(Millimeters length) {
+  return lengthCast<FusionLengthUnit>(length);
+}
+
 /**
  * Convert length from Fusion's database units (cm) to millimeters
  * @param lengthInCm Length value in centimeters (from Fusion API)
  * @return Length value in millimeters
  */
-inline double fusionLengthToMm(double lengthInCm) {
-  return lengthInCm * 10.0;
+constexpr double fusionLengthToMm(double lengthInCm) {
+  return toMillimeters(FusionLength(lengthInCm)).value();
 }
 
 /**
@@ -45,8 +125,8 @@ inline double fusionLengthToMm(double lengthInCm) {
  * @param lengthInMm Length value in millimeters
  * @return Length value in centimeters (for Fusion API)
  */
-inline double mmToFusionLength(double lengthInMm) {
-  return lengthInMm / 10.0;
+constexpr double mmToFusionLength(double lengthInMm) {
+  return toFusionLength(Millimeters(lengthInMm)).value();
 }
 
 /**
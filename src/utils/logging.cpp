@@ -2,9 +2,16 @@
 
 #include <Core/CoreAll.h>
 
+#include <atomic>
 #include <chrono>
+#include <ctime>
 #include <iomanip>
+#include <mutex>
 #include <sstream>
+#include <thread>
+#include <utility>
+
+#include "utils/ConsoleLogQueue.h"
 
 using adsk::core::Application;
 using adsk::core::Palette;
@@ -13,7 +20,58 @@ using adsk::core::TextCommandPalette;
 using adsk::core::UserInterface;
 
 // Global minimum log level (default to WARNING for cleaner output)
-static LogLevel g_minLogLevel = LogLevel::WARNING;
+static std::atomic<LogLevel> g_minLogLevel{LogLevel::WARNING};
+
+// Per-thread suppression flag (set by worker threads that keep their output out of the palette)
+static thread_local bool t_consoleLoggingSuppressed = false;
+
+// Palette writes are main-thread only; other threads' lines wait here
+static ChipCarving::Utils::ConsoleLogQueue g_queuedLines;
+static std::mutex g_mainThreadMutex;
+static std::thread::id g_mainThread;  // Default id: not queueing
+static std::function<void()> g_wakeMainThread;
+
+static void WriteToPalette(const std::string& logMessage) {
+  try {
+    // Get the application and UI
+    Ptr<Application> app = Application::get();
+    if (!app)
+      return;
+
+    Ptr<UserInterface> ui = app->userInterface();
+    if (!ui)
+      return;
+
+    // Try to write to Text Commands palette
+    Ptr<Palette> textPalette = ui->palettes()->itemById("TextCommands");
+    if (textPalette) {
+      Ptr<TextCommandPalette> textCommandPalette = textPalette;
+      textCommandPalette->writeText(logMessage);
+    }
+  } catch (...) {
+    (void)0;  // Silently fail if logging doesn't work
+  }
+}
+
+// Queue logMessage if this is not the main thread; returns false if the caller should write it
+static bool QueueOffMainThread(std::string& logMessage) {
+  std::function<void()> wake;
+  {
+    std::lock_guard<std::mutex> lock(g_mainThreadMutex);
+    if (g_mainThread == std::thread::id() || g_mainThread == std::this_thread::get_id()) {
+      return false;
+    }
+    wake = g_wakeMainThread;
+  }
+  if (g_queuedLines.push(std::move(logMessage)) && wake) {
+    try {
+      wake();
+    } catch (...) {
+      (void)0;  // The next wakeup writes the line instead
+    }
+  }
+  return true;
+}
 
 void LogToConsole(const std::string& message) {
   LogToConsole(LogLevel::INFO, message);
@@ -22,17 +80,23 @@ void LogToConsole(const std::string& message) {
 void LogToConsole(LogLevel level, const std::string& message) {
   try {
     // Check if message should be logged based on level
-    if (static_cast<int>(level) < static_cast<int>(g_minLogLevel)) {
+    if (t_consoleLoggingSuppressed || static_cast<int>(level) < static_cast<int>(g_minLogLevel.load())) {
       return;
     }
 
     // Get current time
     auto now = std::chrono::system_clock::now();
     auto time_t = std::chrono::system_clock::to_time_t(now);
+    std::tm local{};
+#ifdef _WIN32
+    localtime_s(&local, &time_t);
+#else
+    localtime_r(&time_t, &local);
+#endif
 
     // Format timestamp
     std::stringstream ss;
-    ss << std::put_time(std::localtime(&time_t), "%Y-%m-%d %H:%M:%S");
+    ss << std::put_time(&local, "%Y-%m-%d %H:%M:%S");
 
     // Get level prefix
     std::string levelPrefix;
@@ -54,20 +118,8 @@ void LogToConsole(LogLevel level, const std::string& message) {
     // Create log message
     std::string logMessage = "[" + ss.str() + "] " + levelPrefix + " " + message;
 
-    // Get the application and UI
-    Ptr<Application> app = Application::get();
-    if (!app)
-      return;
-
-    Ptr<UserInterface> ui = app->userInterface();
-    if (!ui)
-      return;
-
-    // Try to write to Text Commands palette
-    Ptr<Palette> textPalette = ui->palettes()->itemById("TextCommands");
-    if (textPalette) {
-      Ptr<TextCommandPalette> textCommandPalette = textPalette;
-      textCommandPalette->writeText(logMessage);
+    if (!QueueOffMainThread(logMessage)) {
+      WriteToPalette(logMessage);
     }
   } catch (...) {
     (void)0;  // Silently fail if logging doesn't work
@@ -81,3 +133,23 @@ void SetMinLogLevel(LogLevel level) {
 LogLevel GetMinLogLevel() {
   return g_minLogLevel;
 }
+
+void SetThreadConsoleLoggingSuppressed(bool suppressed) {
+  t_consoleLoggingSuppressed = suppressed;
+}
+
+void SetConsoleLogMainThread(std::function<void()> wakeMainThread) {
+  bool stopping = !wakeMainThread;
+  {
+    std::lock_guard<std::mutex> lock(g_mainThreadMutex);
+    g_mainThread = stopping ? std::thread::id() : std::this_thread::get_id();
+    g_wakeMainThread = std::move(wakeMainThread);
+  }
+  if (stopping) {
+    FlushQueuedConsoleLog();
+  }
+}
+
+void FlushQueuedConsoleLog() {
+  g_queuedLines.drain(WriteToPalette);
+}
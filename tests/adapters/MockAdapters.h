@@ -6,6 +6,7 @@
 
 #pragma once
 
+#include "MockCustomGraphics.h"
 #include "MockFactory.h"
 #include "MockLogger.h"
 #include "MockSketch.h"
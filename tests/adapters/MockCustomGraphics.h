@@ -0,0 +1,48 @@
+/**
+ * MockCustomGraphics.h
+ * Mock custom graphics for testing - captures uploaded buffers for verification
+ */
+
+#pragma once
+
+#include <memory>
+#include <utility>
+#include <vector>
+
+#include "adapters/ICustomGraphics.h"
+#include "geometry/Point3D.h"
+
+using namespace ChipCarving::Adapters;
+
+// Buffers of one custom graphics group; outlives the MockCustomGraphics that filled it
+struct MockCustomGraphicsGroup {
+  struct LineBuffer {
+    std::vector<std::vector<ChipCarving::Geometry::Point3D>> strips;
+    ICustomGraphics::Role role;
+  };
+  struct PointBuffer {
+    std::vector<ChipCarving::Geometry::Point3D> points;
+    ICustomGraphics::Role role;
+  };
+
+  std::vector<LineBuffer> lineBuffers;
+  std::vector<PointBuffer> pointBuffers;
+};
+
+class MockCustomGraphics : public ICustomGraphics {
+ public:
+  explicit MockCustomGraphics(std::shared_ptr<MockCustomGraphicsGroup> group) : group_(std::move(group)) {}
+
+  bool addLineStrips(const std::vector<std::vector<ChipCarving::Geometry::Point3D>>& strips, Role role) override {
+    group_->lineBuffers.push_back({strips, role});
+    return true;
+  }
+
+  bool addPointSet(const std::vector<ChipCarving::Geometry::Point3D>& points, Role role) override {
+    group_->pointBuffers.push_back({points, role});
+    return true;
+  }
+
+ private:
+  std::shared_ptr<MockCustomGraphicsGroup> group_;
+};
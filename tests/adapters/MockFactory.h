@@ -40,16 +40,21 @@ class MockFactory : public IFusionFactory {
 
   std::unique_ptr<IUserInterface> createUserInterface() override {
     auto ui = std::make_unique<MockUserInterface>();
+    ui->latency = latency;
     lastCreatedUI_ = ui.get();
     return ui;
   }
 
   std::unique_ptr<IWorkspace> createWorkspace() override {
     auto workspace = std::make_unique<MockWorkspace>();
+    workspace->latency = latency;
     lastCreatedWorkspace_ = workspace.get();
     return workspace;
   }
 
+  // Fusion call costs for the user interfaces and workspaces created from now on, or none
+  std::shared_ptr<MockLatency> latency;
+
   // Access to mock objects for test verification
   MockLogger* getLastCreatedLogger() { return lastCreatedLogger_; }
   MockUserInterface* getLastCreatedUI() { return lastCreatedUI_; }
@@ -0,0 +1,160 @@
+/**
+ * MockLatency.h
+ * Simulated Fusion API call costs for the mock adapters. A mock with a latency
+ * model attached spends, per operation, the time of the Fusion calls its real
+ * adapter makes (see utils/ApiCallTimer.h for the kinds), inside ApiCallTimers
+ * so run metrics account for it as they would in Fusion. Costs default to
+ * typical Fusion timings and can be loaded from a measured run's metrics.
+ */
+
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+#include <fstream>
+#include <memory>
+#include <mutex>
+#include <random>
+#include <string>
+
+#include "parsers/JsonReader.h"
+#include "utils/ApiCallTimer.h"
+
+using ChipCarving::Utils::API_CALL_KIND_COUNT;
+using ChipCarving::Utils::ApiCallKind;
+
+class MockLatency {
+ public:
+  MockLatency() {
+    setCost(ApiCallKind::Call, 100.0);
+    setCost(ApiCallKind::ObjectCreate, 50.0);
+    setCost(ApiCallKind::RayCast, 500.0);
+    setCost(ApiCallKind::SketchEntity, 200.0);
+  }
+
+  // Mean microseconds per call of one kind
+  void setCost(ApiCallKind kind, double meanUs) { costUs_[static_cast<size_t>(kind)] = meanUs; }
+  double cost(ApiCallKind kind) const { return costUs_[static_cast<size_t>(kind)]; }
+
+  // Each spend varies uniformly by up to this fraction of its mean, from a fixed seed
+  double jitterFraction = 0.0;
+
+  /**
+   * Per-call means from a metrics line written by RunMetrics::appendTo; kinds
+   * the line did not make keep their cost
+   * @return false if the line has no API call totals
+   * @throws std::runtime_error if the line is not valid JSON
+   */
+  bool loadMeasuredCosts(const std::string& metricsJson) {
+    uint64_t counts[API_CALL_KIND_COUNT] = {};
+    double totalMs[API_CALL_KIND_COUNT] = {};
+    ChipCarving::Parsers::JsonReader reader(metricsJson);
+    std::string key;
+    reader.beginObject();
+    while (reader.nextMember(key)) {
+      if (key != "apiCalls") {
+        reader.skipValue();
+        continue;
+      }
+      reader.beginArray();
+      while (reader.nextElement()) {
+        size_t kind = API_CALL_KIND_COUNT;
+        uint64_t count = 0;
+        double ms = 0.0;
+        reader.beginObject();
+        while (reader.nextMember(key)) {
+          if (key == "kind") {
+            kind = kindIndex(reader.readString());
+          } else if (key == "count") {
+            count = static_cast<uint64_t>(reader.readNumber());
+          } else if (key == "totalMs") {
+            ms = reader.readNumber();
+          } else {
+            reader.skipValue();
+          }
+        }
+        if (kind < API_CALL_KIND_COUNT) {
+          counts[kind] += count;
+          totalMs[kind] += ms;
+        }
+      }
+    }
+
+    bool loaded = false;
+    for (size_t kind = 0; kind < API_CALL_KIND_COUNT; ++kind) {
+      if (counts[kind] > 0) {
+        costUs_[kind] = totalMs[kind] * 1000.0 / static_cast<double>(counts[kind]);
+        loaded = true;
+      }
+    }
+    return loaded;
+  }
+
+  /**
+   * Costs from the last line of a metrics file that has API call totals
+   * @return false if the file cannot be read or no line has totals
+   */
+  bool loadMeasuredCostsFile(const std::string& path) {
+    std::ifstream file(path);
+    std::string line;
+    std::string measured;
+    while (std::getline(file, line)) {
+      if (line.find("\"apiCalls\"") != std::string::npos) {
+        measured = line;
+      }
+    }
+    return !measured.empty() && loadMeasuredCosts(measured);
+  }
+
+  // Busy-wait the cost of count calls of one kind; sleeps cannot resolve tens of microseconds
+  void spend(ApiCallKind kind, uint64_t count = 1) {
+    double us = cost(kind) * static_cast<double>(count);
+    if (jitterFraction > 0.0) {
+      std::lock_guard<std::mutex> lock(mutex_);
+      us *= 1.0 + jitterFraction * std::uniform_real_distribution<double>(-1.0, 1.0)(random_);
+    }
+    if (us <= 0.0) {
+      return;
+    }
+    ChipCarving::Utils::ApiCallTimer timer(kind, count);
+    auto until = std::chrono::steady_clock::now() + std::chrono::duration<double, std::micro>(us);
+    while (std::chrono::steady_clock::now() < until) {
+    }
+    std::lock_guard<std::mutex> lock(mutex_);
+    spentUs_ += us;
+    calls_[static_cast<size_t>(kind)] += count;
+  }
+
+  // Simulated time and calls so far, over all threads
+  double spentMs() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return spentUs_ / 1000.0;
+  }
+  uint64_t calls(ApiCallKind kind) const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return calls_[static_cast<size_t>(kind)];
+  }
+
+ private:
+  static size_t kindIndex(const std::string& name) {
+    for (size_t kind = 0; kind < API_CALL_KIND_COUNT; ++kind) {
+      if (name == ChipCarving::Utils::apiCallKindName(static_cast<ApiCallKind>(kind))) {
+        return kind;
+      }
+    }
+    return API_CALL_KIND_COUNT;
+  }
+
+  double costUs_[API_CALL_KIND_COUNT] = {};
+  mutable std::mutex mutex_;
+  std::mt19937 random_{7};
+  double spentUs_ = 0.0;
+  uint64_t calls_[API_CALL_KIND_COUNT] = {};
+};
+
+// Spend count calls of one kind when a mock has a latency model attached
+inline void spendApiCalls(const std::shared_ptr<MockLatency>& latency, ApiCallKind kind, uint64_t count = 1) {
+  if (latency && count > 0) {
+    latency->spend(kind, count);
+  }
+}
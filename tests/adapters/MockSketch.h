@@ -1,17 +1,25 @@
 /**
  * MockSketch.h
  * Mock sketch for testing - captures sketch operations for verification
+ * With a latency model attached, each operation spends the Fusion API calls
+ * FusionSketch makes for it.
  */
 
 #pragma once
 
+#include <algorithm>
+#include <memory>
+#include <set>
 #include <string>
 #include <utility>
 #include <vector>
 
+#include "MockLatency.h"
 #include "adapters/IFusionInterface.h"
 #include "geometry/Point3D.h"
+#include "geometry/PolylineArcFitter.h"
 #include "geometry/Shape.h"
+#include "geometry/ShapeOutlineBatch.h"
 
 using namespace ChipCarving::Adapters;
 
@@ -31,17 +39,25 @@ class MockSketch : public ISketch {
   std::string getName() const override { return name_; }
 
   bool addLineToSketch(double x1, double y1, double x2, double y2) override {
+    spendApiCalls(latency, ApiCallKind::ObjectCreate, 2);
+    spendApiCalls(latency, ApiCallKind::SketchEntity);
     lines.push_back({x1, y1, x2, y2});
+    curveTags->push_back(curveTag);
     return mockAddLineResult;
   }
 
   bool addArcToSketch(double centerX, double centerY, double radius, double startAngle,
                       double endAngle) override {
+    spendApiCalls(latency, ApiCallKind::ObjectCreate, 3);
+    spendApiCalls(latency, ApiCallKind::SketchEntity);
     arcs.push_back({centerX, centerY, radius, startAngle, endAngle});
+    curveTags->push_back(curveTag);
     return mockAddArcResult;
   }
 
   int addPointToSketch(double x, double y) override {
+    spendApiCalls(latency, ApiCallKind::ObjectCreate);
+    spendApiCalls(latency, ApiCallKind::SketchEntity);
     if (mockAddPointResult) {
       points.push_back({x, y});
       return static_cast<int>(points.size()) - 1;
@@ -51,12 +67,16 @@ class MockSketch : public ISketch {
 
   bool addArcByThreePointsToSketch(int startPointIndex, int midPointIndex,
                                    int endPointIndex) override {
+    spendApiCalls(latency, ApiCallKind::SketchEntity);
     threePointArcs.push_back({startPointIndex, midPointIndex, endPointIndex});
+    curveTags->push_back(curveTag);
     return mockAddThreePointArcResult;
   }
 
   bool addLineByTwoPointsToSketch(int startPointIndex, int endPointIndex) override {
+    spendApiCalls(latency, ApiCallKind::SketchEntity);
     twoPointLines.push_back({startPointIndex, endPointIndex});
+    curveTags->push_back(curveTag);
     return mockAddTwoPointLineResult;
   }
 
@@ -68,20 +88,51 @@ class MockSketch : public ISketch {
     return false;
   }
 
+  int addOutlineBatch(const ChipCarving::Geometry::ShapeOutlineBatch& batch) override {
+    addOutlineBatchCallCount++;
+    size_t arcEdges = static_cast<size_t>(
+        std::count_if(batch.edges().begin(), batch.edges().end(), [](const auto& edge) { return edge.isArc; }));
+    spendApiCalls(latency, ApiCallKind::ObjectCreate, batch.vertices().size() + arcEdges);
+    spendApiCalls(latency, ApiCallKind::SketchEntity, batch.vertices().size() + batch.edges().size());
+    outlineVertices.insert(outlineVertices.end(), batch.vertices().begin(), batch.vertices().end());
+    outlineEdges.insert(outlineEdges.end(), batch.edges().begin(), batch.edges().end());
+    for (const auto& edge : batch.edges()) {
+      const std::string& tag = batch.tags()[edge.tag];
+      curveTags->push_back(tag.empty() ? curveTag : tag);
+    }
+    return static_cast<int>(batch.edges().size());
+  }
+
   void finishSketch() override { finishSketchCallCount++; }
 
+  void beginBulkEdit() override {
+    bulkEditDepth++;
+    beginBulkEditCallCount++;
+  }
+
+  void endBulkEdit() override {
+    bulkEditDepth--;
+    endBulkEditCallCount++;
+  }
+
   // Construction geometry methods
   bool addConstructionLine(double x1, double y1, double x2, double y2) override {
+    spendApiCalls(latency, ApiCallKind::ObjectCreate, 2);
+    spendApiCalls(latency, ApiCallKind::SketchEntity);
     constructionLines.push_back({x1, y1, x2, y2});
     return mockAddConstructionLineResult;
   }
 
   bool addConstructionCircle(double centerX, double centerY, double radius) override {
+    spendApiCalls(latency, ApiCallKind::ObjectCreate);
+    spendApiCalls(latency, ApiCallKind::SketchEntity);
     constructionCircles.push_back({centerX, centerY, radius});
     return mockAddConstructionCircleResult;
   }
 
   bool addConstructionPoint(double x, double y) override {
+    spendApiCalls(latency, ApiCallKind::ObjectCreate);
+    spendApiCalls(latency, ApiCallKind::SketchEntity);
     constructionPoints.push_back({x, y});
     return mockAddConstructionPointResult;
   }
@@ -98,23 +149,100 @@ class MockSketch : public ISketch {
     if (pts.size() < 2) {
       return false;
     }
-    splines3D.push_back(pts);
+    spendApiCalls(latency, ApiCallKind::ObjectCreate);  // Fit point collection
+    return recordSpline3D(pts);
+  }
+
+  bool addPolyline3D(const std::vector<ChipCarving::Geometry::Point3D>& pts,
+                     const std::vector<ChipCarving::Geometry::PolylineSpan>& spans) override {
+    if (pts.size() < 2 || spans.empty()) {
+      return false;
+    }
+    // A point per vertex plus one per arc midpoint, a sketch entity per arc or line segment
+    size_t arcSpans = 0;
+    size_t lineSegments = 0;
+    for (const auto& span : spans) {
+      arcSpans += span.isArc ? 1 : 0;
+      lineSegments += span.isArc ? 0 : span.last - span.first;
+    }
+    spendApiCalls(latency, ApiCallKind::ObjectCreate, 1 + 2 * arcSpans + lineSegments);
+    spendApiCalls(latency, ApiCallKind::SketchEntity, arcSpans + lineSegments);
+    polylines3D.push_back({pts, spans});
+    *curvePointCount += pts.size();
+    curveTags->push_back(curveTag);
     return true;
   }
 
+  std::vector<bool> addSplines3D(
+      const std::vector<std::vector<ChipCarving::Geometry::Point3D>>& paths) override {
+    splineBatchCallCount++;
+    spendApiCalls(latency, ApiCallKind::ObjectCreate);  // One fit point collection for the batch
+    std::vector<bool> created(paths.size(), false);
+    for (size_t i = 0; i < paths.size(); ++i) {
+      created[i] = paths[i].size() >= 2 && recordSpline3D(paths[i]);
+    }
+    return created;
+  }
+
+  std::vector<bool> addPolylines3D(
+      const std::vector<std::vector<ChipCarving::Geometry::Point3D>>& paths,
+      const std::vector<std::vector<ChipCarving::Geometry::PolylineSpan>>& spans) override {
+    polylineBatchCallCount++;
+    std::vector<bool> created(paths.size(), false);
+    for (size_t i = 0; i < paths.size() && i < spans.size(); ++i) {
+      created[i] = addPolyline3D(paths[i], spans[i]);
+    }
+    return created;
+  }
+
   bool addLine3D(double x1, double y1, double z1, double x2, double y2, double z2) override {
+    spendApiCalls(latency, ApiCallKind::ObjectCreate, 2);
+    spendApiCalls(latency, ApiCallKind::SketchEntity);
     lines3D.push_back({ChipCarving::Geometry::Point3D(x1, y1, z1),
                        ChipCarving::Geometry::Point3D(x2, y2, z2)});
+    *curvePointCount += 2;
+    curveTags->push_back(curveTag);
     return true;
   }
 
   bool addPoint3D(double x, double y, double z) override {
+    spendApiCalls(latency, ApiCallKind::ObjectCreate);
+    spendApiCalls(latency, ApiCallKind::SketchEntity);
     points3D.push_back(ChipCarving::Geometry::Point3D(x, y, z));
     return true;
   }
 
   std::vector<std::string> getSketchCurveEntityIds() override { return mockCurveEntityIds; }
 
+  // Tags are recorded per curve, which a 3D polyline counts as one of
+  void setCurveTag(const std::string& tag, const std::string& sourceToken) override {
+    curveTag = tag;
+    curveSourceToken = sourceToken;
+  }
+
+  std::vector<std::string> getCurveTags() override {
+    std::set<std::string> tags(curveTags->begin(), curveTags->end());
+    return std::vector<std::string>(tags.begin(), tags.end());
+  }
+
+  int deleteCurvesWithTag(const std::string& tag) override {
+    size_t before = curveTags->size();
+    curveTags->erase(std::remove(curveTags->begin(), curveTags->end(), tag), curveTags->end());
+    deletedCurveTags.push_back(tag);
+    return static_cast<int>(before - curveTags->size());
+  }
+
+  // Fit points, each created and added to the collection, then the spline itself
+  bool recordSpline3D(const std::vector<ChipCarving::Geometry::Point3D>& pts) {
+    spendApiCalls(latency, ApiCallKind::ObjectCreate, pts.size());
+    spendApiCalls(latency, ApiCallKind::Call, pts.size());
+    spendApiCalls(latency, ApiCallKind::SketchEntity);
+    splines3D.push_back(pts);
+    *curvePointCount += pts.size();
+    curveTags->push_back(curveTag);
+    return true;
+  }
+
   // Test helper structs
   struct Line {
     double x1, y1, x2, y2;
@@ -134,6 +262,10 @@ class MockSketch : public ISketch {
   struct TwoPointLine {
     int startIdx, endIdx;
   };
+  struct Polyline3D {
+    std::vector<ChipCarving::Geometry::Point3D> points;
+    std::vector<ChipCarving::Geometry::PolylineSpan> spans;
+  };
 
   // Test state
   std::string name_;
@@ -145,7 +277,13 @@ class MockSketch : public ISketch {
   std::vector<ThreePointArc> threePointArcs;
   std::vector<TwoPointLine> twoPointLines;
   std::vector<int> deletedPointIndices;
+  int addOutlineBatchCallCount = 0;
+  std::vector<ChipCarving::Geometry::Point2D> outlineVertices;
+  std::vector<ChipCarving::Geometry::OutlineEdge> outlineEdges;
   int finishSketchCallCount = 0;
+  int bulkEditDepth = 0;
+  int beginBulkEditCallCount = 0;
+  int endBulkEditCallCount = 0;
 
   std::vector<Line> constructionLines;
   std::vector<Circle> constructionCircles;
@@ -153,11 +291,21 @@ class MockSketch : public ISketch {
   int clearConstructionGeometryCallCount = 0;
 
   std::vector<std::vector<ChipCarving::Geometry::Point3D>> splines3D;
+  std::vector<Polyline3D> polylines3D;
+  int splineBatchCallCount = 0;
+  int polylineBatchCallCount = 0;
   std::vector<std::pair<ChipCarving::Geometry::Point3D, ChipCarving::Geometry::Point3D>> lines3D;
   std::vector<ChipCarving::Geometry::Point3D> points3D;
 
   std::vector<std::string> mockCurveEntityIds;
 
+  std::string curveTag;
+  std::string curveSourceToken;
+  std::shared_ptr<std::vector<std::string>> curveTags = std::make_shared<std::vector<std::string>>();
+  std::shared_ptr<size_t> curvePointCount = std::make_shared<size_t>(0);  // Points of every 3D curve added
+  std::vector<std::string> deletedCurveTags;
+  std::shared_ptr<MockLatency> latency;  // Fusion call costs to spend, or none
+
   bool mockAddLineResult = true;
   bool mockAddArcResult = true;
   bool mockAddPointResult = true;
@@ -177,7 +325,13 @@ class MockSketch : public ISketch {
     threePointArcs.clear();
     twoPointLines.clear();
     deletedPointIndices.clear();
+    addOutlineBatchCallCount = 0;
+    outlineVertices.clear();
+    outlineEdges.clear();
     finishSketchCallCount = 0;
+    bulkEditDepth = 0;
+    beginBulkEditCallCount = 0;
+    endBulkEditCallCount = 0;
 
     constructionLines.clear();
     constructionCircles.clear();
@@ -185,9 +339,16 @@ class MockSketch : public ISketch {
     clearConstructionGeometryCallCount = 0;
 
     splines3D.clear();
+    polylines3D.clear();
+    splineBatchCallCount = 0;
+    polylineBatchCallCount = 0;
     lines3D.clear();
     points3D.clear();
     mockCurveEntityIds.clear();
+    curveTag.clear();
+    curveSourceToken.clear();
+    curveTags->clear();
+    deletedCurveTags.clear();
 
     mockAddLineResult = true;
     mockAddArcResult = true;
@@ -1,12 +1,17 @@
 /**
  * MockUserInterface.h
  * Mock user interface for testing - captures UI interactions for verification
+ * With a latency model attached, progress updates spend the Fusion API calls
+ * FusionUserInterface makes for them.
  */
 
 #pragma once
 
+#include <atomic>
+#include <memory>
 #include <string>
 
+#include "MockLatency.h"
 #include "adapters/IFusionInterface.h"
 
 using namespace ChipCarving::Adapters;
@@ -25,6 +30,12 @@ class MockUserInterface : public IUserInterface {
     return mockFileDialogPath;
   }
 
+  std::vector<std::string> showMultiFileDialog(const std::string& title, const std::string& filter) override {
+    lastFileDialogTitle = title;
+    lastFileDialogFilter = filter;
+    return mockMultiFileDialogPaths;
+  }
+
   std::string selectJsonFile() override { return mockJsonFilePath; }
 
   bool confirmAction(const std::string& message) override {
@@ -55,6 +66,35 @@ class MockUserInterface : public IUserInterface {
     updateSelectionCountCallCount++;
   }
 
+  void showProgress(const std::string& title, const std::string& message, int maximum) override {
+    lastProgressTitle = title;
+    lastProgressMessage = message;
+    lastProgressMaximum = maximum;
+    progressVisible = true;
+    spendApiCalls(latency, ApiCallKind::Call, 4);
+  }
+
+  void updateProgress(const std::string& message, int value, int maximum) override {
+    lastProgressMessage = message;
+    lastProgressValue = value;
+    lastProgressMaximum = maximum;
+    updateProgressCallCount++;
+    spendApiCalls(latency, ApiCallKind::Call, 3);
+  }
+
+  bool wasProgressCancelled() override { return mockProgressCancelled; }
+
+  void hideProgress() override { progressVisible = false; }
+
+  void showRunReport(const std::string& report) override {
+    lastRunReport = report;
+    showRunReportCallCount++;
+    spendApiCalls(latency, ApiCallKind::Call, 4);
+  }
+
+  // Called from worker threads
+  void notifyMainThread() override { notifyMainThreadCallCount++; }
+
   // Test helpers
   std::string lastMessageBoxTitle;
   std::string lastMessageBoxMessage;
@@ -63,6 +103,7 @@ class MockUserInterface : public IUserInterface {
   std::string lastFileDialogTitle;
   std::string lastFileDialogFilter;
   std::string mockFileDialogPath = "/test/path/design.json";
+  std::vector<std::string> mockMultiFileDialogPaths{"/test/path/design.json"};
 
   std::string lastConfirmMessage;
   bool mockConfirmResult = true;
@@ -82,6 +123,18 @@ class MockUserInterface : public IUserInterface {
   int lastSelectionCount = 0;
   int updateSelectionCountCallCount = 0;
 
+  std::string lastProgressTitle;
+  std::string lastProgressMessage;
+  int lastProgressValue = 0;
+  int lastProgressMaximum = 0;
+  int updateProgressCallCount = 0;
+  bool progressVisible = false;
+  bool mockProgressCancelled = false;
+  std::atomic<int> notifyMainThreadCallCount{0};
+  std::string lastRunReport;
+  int showRunReportCallCount = 0;
+  std::shared_ptr<MockLatency> latency;  // Fusion call costs to spend, or none
+
   void reset() {
     lastMessageBoxTitle.clear();
     lastMessageBoxMessage.clear();
@@ -89,6 +142,7 @@ class MockUserInterface : public IUserInterface {
     lastFileDialogTitle.clear();
     lastFileDialogFilter.clear();
     mockFileDialogPath = "/test/path/design.json";
+    mockMultiFileDialogPaths = {"/test/path/design.json"};
     lastConfirmMessage.clear();
     mockConfirmResult = true;
     mockJsonFilePath = "/test/path/design.json";
@@ -102,5 +156,15 @@ class MockUserInterface : public IUserInterface {
     mockSketchSelection = SketchSelection{};
     lastSelectionCount = 0;
     updateSelectionCountCallCount = 0;
+    lastProgressTitle.clear();
+    lastProgressMessage.clear();
+    lastProgressValue = 0;
+    lastProgressMaximum = 0;
+    updateProgressCallCount = 0;
+    progressVisible = false;
+    mockProgressCancelled = false;
+    notifyMainThreadCallCount = 0;
+    lastRunReport.clear();
+    showRunReportCallCount = 0;
   }
 };
@@ -1,18 +1,26 @@
 /**
  * MockWorkspace.h
  * Mock workspace for testing - captures workspace operations for verification
+ * With a latency model attached, sketch creation, profile extraction and
+ * surface queries spend the Fusion API calls FusionWorkspace makes for them;
+ * the sketches it creates share the model.
  */
 
 #pragma once
 
+#include <algorithm>
 #include <limits>
+#include <map>
 #include <memory>
 #include <string>
 #include <utility>
 #include <vector>
 
+#include "MockCustomGraphics.h"
+#include "MockLatency.h"
 #include "MockSketch.h"
 #include "adapters/IFusionInterface.h"
+#include "geometry/Point2D.h"
 
 using namespace ChipCarving::Adapters;
 
@@ -20,10 +28,14 @@ class MockWorkspace : public IWorkspace {
  public:
   std::unique_ptr<ISketch> createSketch(const std::string& name) override {
     lastSketchName = name;
+    createdSketchNames.push_back(name);
+    sketchesInOutputSession += outputSessionDepth > 0 ? 1 : 0;
     createSketchCallCount++;
+    spendApiCalls(latency, ApiCallKind::Call);
 
     if (mockCreateSketchResult) {
       auto sketch = std::make_unique<MockSketch>(name);
+      attachSharedCurveState(*sketch);
       lastCreatedSketch = sketch.get();
       return sketch;
     }
@@ -33,11 +45,15 @@ class MockWorkspace : public IWorkspace {
   std::unique_ptr<ISketch> createSketchOnPlane(const std::string& name,
                                                 const std::string& planeEntityId) override {
     lastSketchName = name;
+    createdSketchNames.push_back(name);
+    sketchesInOutputSession += outputSessionDepth > 0 ? 1 : 0;
     lastPlaneEntityId = planeEntityId;
     createSketchOnPlaneCallCount++;
+    spendApiCalls(latency, ApiCallKind::Call);
 
     if (mockCreateSketchOnPlaneResult) {
       auto sketch = std::make_unique<MockSketch>(name);
+      attachSharedCurveState(*sketch);
       lastCreatedSketch = sketch.get();
       return sketch;
     }
@@ -47,11 +63,15 @@ class MockWorkspace : public IWorkspace {
   std::unique_ptr<ISketch> createSketchInTargetComponent(
       const std::string& name, const std::string& surfaceEntityId) override {
     lastSketchName = name;
+    createdSketchNames.push_back(name);
+    sketchesInOutputSession += outputSessionDepth > 0 ? 1 : 0;
     lastTargetSurfaceEntityId = surfaceEntityId;
     createSketchInTargetComponentCallCount++;
+    spendApiCalls(latency, ApiCallKind::Call);
 
     if (mockCreateSketchInTargetComponentResult) {
       auto sketch = std::make_unique<MockSketch>(name);
+      attachSharedCurveState(*sketch);
       lastCreatedSketch = sketch.get();
       return sketch;
     }
@@ -61,22 +81,75 @@ class MockWorkspace : public IWorkspace {
   std::unique_ptr<ISketch> findSketch(const std::string& name) override {
     lastFindSketchName = name;
     findSketchCallCount++;
+    spendApiCalls(latency, ApiCallKind::Call);
 
-    if (mockFindSketchResult) {
+    if (mockFindSketchResult || (keepSketchCurveTags && keptCurveTags.count(name) > 0)) {
       auto sketch = std::make_unique<MockSketch>(name);
+      attachSharedCurveState(*sketch);
       lastFoundSketch = sketch.get();
       return sketch;
     }
     return nullptr;
   }
 
+  std::unique_ptr<ISketch> resetSketch(std::unique_ptr<ISketch> sketch, const std::string& planeEntityId,
+                                       size_t recreateAbove) override {
+    lastResetPlaneEntityId = planeEntityId;
+    lastResetRecreateAbove = recreateAbove;
+    resetSketchCallCount++;
+    spendApiCalls(latency, ApiCallKind::Call);
+
+    auto* mockSketch = dynamic_cast<MockSketch*>(sketch.get());
+    if (!mockResetSketchResult || !mockSketch) {
+      return nullptr;
+    }
+    if (mockSketch->curveTags) {
+      mockSketch->curveTags->clear();
+    }
+    return sketch;
+  }
+
+  // Succeeds for a name in mockSketchNames, which it removes
+  bool deleteSketch(const std::string& name, const std::string& planeEntityId) override {
+    lastDeletePlaneEntityId = planeEntityId;
+    deleteSketchCallCount++;
+    spendApiCalls(latency, ApiCallKind::Call);
+
+    auto found = std::find(mockSketchNames.begin(), mockSketchNames.end(), name);
+    if (found == mockSketchNames.end()) {
+      return false;
+    }
+    mockSketchNames.erase(found);
+    deletedSketchNames.push_back(name);
+    return true;
+  }
+
+  // Every sketch adds its 3D curve points to sketchCurvePointCount and spends the workspace's
+  // latency; with keepSketchCurveTags, sketches of one name share their curve tags like a design's sketch would
+  void attachSharedCurveState(MockSketch& sketch) {
+    sketch.curvePointCount = sketchCurvePointCount;
+    sketch.latency = latency;
+    if (!keepSketchCurveTags) {
+      return;
+    }
+    auto& tags = keptCurveTags[sketch.getName()];
+    if (!tags) {
+      tags = std::make_shared<std::vector<std::string>>();
+    }
+    sketch.curveTags = tags;
+  }
+
   bool extractProfileVertices(const std::string& entityId,
-                              std::vector<std::pair<double, double>>& vertices,
+                              std::vector<ChipCarving::Geometry::Point2D>& vertices,
                               TransformParams& transform) override {
     lastExtractedEntityId = entityId;
     extractProfileVerticesCallCount++;
+    if (entityLookupSessionDepth == 0) {
+      lookupsOutsideSessionCount++;
+    }
 
     if (mockExtractProfileVerticesResult) {
+      spendApiCalls(latency, ApiCallKind::Call, mockProfileVertices.size());  // A geometry read per vertex
       vertices = mockProfileVertices;
       transform.centerX = 0.0;
       transform.centerY = 0.0;
@@ -91,6 +164,9 @@ class MockWorkspace : public IWorkspace {
   std::string extractPlaneEntityIdFromProfile(const std::string& profileEntityId) override {
     lastExtractedPlaneProfileId = profileEntityId;
     extractPlaneCallCount++;
+    if (entityLookupSessionDepth == 0) {
+      lookupsOutsideSessionCount++;
+    }
     return mockPlaneEntityId;
   }
 
@@ -99,6 +175,8 @@ class MockWorkspace : public IWorkspace {
     lastQueriedX = x;
     lastQueriedY = y;
     getSurfaceZCallCount++;
+    spendApiCalls(latency, ApiCallKind::ObjectCreate);
+    spendApiCalls(latency, ApiCallKind::RayCast);
 
     if (mockSurfaceZResult) {
       return mockSurfaceZ;
@@ -106,11 +184,72 @@ class MockWorkspace : public IWorkspace {
     return std::numeric_limits<double>::quiet_NaN();
   }
 
+  std::vector<double> getSurfaceZBatch(const std::string& surfaceId,
+                                       const std::vector<ChipCarving::Geometry::Point2D>& points,
+                                       bool useFaceEvaluator) override {
+    lastQueriedSurfaceId = surfaceId;
+    lastUsedFaceEvaluator = useFaceEvaluator;
+    lastBatchSize = points.size();
+    getSurfaceZBatchCallCount++;
+    // A ray origin and one cast per point, as for a single-component B-Rep target
+    spendApiCalls(latency, ApiCallKind::ObjectCreate, points.size());
+    spendApiCalls(latency, ApiCallKind::RayCast, points.size());
+
+    std::vector<double> heights;
+    heights.reserve(points.size());
+    for (const auto& point : points) {
+      lastQueriedX = point.x;
+      lastQueriedY = point.y;
+      heights.push_back(mockSurfaceZResult ? mockSurfaceZ : std::numeric_limits<double>::quiet_NaN());
+    }
+    return heights;
+  }
+
   std::vector<std::string> getAllSketchNames() override {
     getAllSketchNamesCallCount++;
     return mockSketchNames;
   }
 
+  SketchSelection getSketchProfiles(const std::string& sketchName) override {
+    sketchProfileRequests.push_back(sketchName);
+    auto found = mockSketchProfiles.find(sketchName);
+    return found == mockSketchProfiles.end() ? SketchSelection() : found->second;
+  }
+
+  void beginEntityLookupSession() override {
+    entityLookupSessionDepth++;
+    beginEntityLookupSessionCallCount++;
+  }
+
+  void endEntityLookupSession() override {
+    entityLookupSessionDepth--;
+  }
+
+  void invalidateEntityLookups() override {
+    invalidateEntityLookupsCallCount++;
+  }
+
+  void beginOutputSession(const std::string& name, bool directEdit) override {
+    outputSessionDepth++;
+    outputSessionNames.push_back(name);
+    lastOutputSessionDirectEdit = directEdit;
+  }
+
+  void endOutputSession() override {
+    outputSessionDepth--;
+  }
+
+  std::unique_ptr<ICustomGraphics> createCustomGraphics(const std::string& name) override {
+    createCustomGraphicsCallCount++;
+    auto group = std::make_shared<MockCustomGraphicsGroup>();
+    customGraphicsGroups[name] = group;
+    return std::make_unique<MockCustomGraphics>(group);
+  }
+
+  void removeCustomGraphics(const std::string& name) override {
+    customGraphicsGroups.erase(name);
+  }
+
   // Additional solid modeling methods (not in interface but used by some tests)
   std::string createVBitSolid(double toolAngle, double toolDiameter, double height) {
     lastVBitToolAngle = toolAngle;
@@ -149,6 +288,7 @@ class MockWorkspace : public IWorkspace {
 
   // Test state - createSketch
   std::string lastSketchName;
+  std::vector<std::string> createdSketchNames;  // Every create* call, in order
   int createSketchCallCount = 0;
   MockSketch* lastCreatedSketch = nullptr;
   bool mockCreateSketchResult = true;
@@ -168,12 +308,27 @@ class MockWorkspace : public IWorkspace {
   int findSketchCallCount = 0;
   MockSketch* lastFoundSketch = nullptr;
   bool mockFindSketchResult = false;
+  bool keepSketchCurveTags = false;
+  std::map<std::string, std::shared_ptr<std::vector<std::string>>> keptCurveTags;
+  std::shared_ptr<size_t> sketchCurvePointCount = std::make_shared<size_t>(0);  // Outlives the sketches
+  std::shared_ptr<MockLatency> latency;  // Fusion call costs to spend, or none
+
+  // resetSketch (declines by default, so output sketches are created afresh)
+  std::string lastResetPlaneEntityId;
+  size_t lastResetRecreateAbove = 0;
+  int resetSketchCallCount = 0;
+  bool mockResetSketchResult = false;
+
+  // deleteSketch
+  std::string lastDeletePlaneEntityId;
+  int deleteSketchCallCount = 0;
+  std::vector<std::string> deletedSketchNames;
 
   // extractProfileVertices
   std::string lastExtractedEntityId;
   int extractProfileVerticesCallCount = 0;
   bool mockExtractProfileVerticesResult = true;
-  std::vector<std::pair<double, double>> mockProfileVertices;
+  std::vector<ChipCarving::Geometry::Point2D> mockProfileVertices;
   double mockSketchPlaneZ = 0.0;
 
   // extractPlaneEntityIdFromProfile
@@ -189,6 +344,31 @@ class MockWorkspace : public IWorkspace {
   bool mockSurfaceZResult = false;
   double mockSurfaceZ = 0.0;
 
+  // getSurfaceZBatch (shares the mock surface result above)
+  int getSurfaceZBatchCallCount = 0;
+  size_t lastBatchSize = 0;
+  bool lastUsedFaceEvaluator = true;
+
+  // Entity lookup sessions; profile and plane lookups count against the open session
+  int entityLookupSessionDepth = 0;
+  int beginEntityLookupSessionCallCount = 0;
+  int invalidateEntityLookupsCallCount = 0;
+  int lookupsOutsideSessionCount = 0;
+
+  // Output sessions; sketches created while one is open are counted
+  int outputSessionDepth = 0;
+  std::vector<std::string> outputSessionNames;  // Every beginOutputSession call, in order
+  bool lastOutputSessionDirectEdit = false;
+  int sketchesInOutputSession = 0;
+
+  // Custom graphics groups shown, by name
+  std::map<std::string, std::shared_ptr<MockCustomGraphicsGroup>> customGraphicsGroups;
+  int createCustomGraphicsCallCount = 0;
+
+  // getSketchProfiles
+  std::vector<std::string> sketchProfileRequests;
+  std::map<std::string, SketchSelection> mockSketchProfiles;
+
   // getAllSketchNames
   int getAllSketchNamesCallCount = 0;
   std::vector<std::string> mockSketchNames = {"Imported Design", "V-Carve Toolpaths - 90° V-bit",
@@ -238,6 +418,18 @@ class MockWorkspace : public IWorkspace {
     findSketchCallCount = 0;
     lastFoundSketch = nullptr;
     mockFindSketchResult = false;
+    keepSketchCurveTags = false;
+    keptCurveTags.clear();
+    *sketchCurvePointCount = 0;
+
+    lastResetPlaneEntityId.clear();
+    lastResetRecreateAbove = 0;
+    resetSketchCallCount = 0;
+    mockResetSketchResult = false;
+
+    lastDeletePlaneEntityId.clear();
+    deleteSketchCallCount = 0;
+    deletedSketchNames.clear();
 
     lastExtractedEntityId.clear();
     extractProfileVerticesCallCount = 0;
@@ -256,6 +448,16 @@ class MockWorkspace : public IWorkspace {
     mockSurfaceZResult = false;
     mockSurfaceZ = 0.0;
 
+    customGraphicsGroups.clear();
+    createCustomGraphicsCallCount = 0;
+
+    outputSessionDepth = 0;
+    outputSessionNames.clear();
+    lastOutputSessionDirectEdit = false;
+    sketchesInOutputSession = 0;
+
+    sketchProfileRequests.clear();
+    mockSketchProfiles.clear();
     getAllSketchNamesCallCount = 0;
     mockSketchNames = {"Imported Design", "V-Carve Toolpaths - 90° V-bit", "Test Sketch"};
 
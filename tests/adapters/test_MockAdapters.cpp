@@ -5,6 +5,9 @@
 
 #include <gtest/gtest.h>
 
+#include <cmath>
+#include <vector>
+
 #include "MockAdapters.h"
 
 // Basic mock tests
@@ -49,6 +52,29 @@ TEST(MockAdaptersTest, MockWorkspaceTracksSketchOperations) {
     EXPECT_EQ(mockSketch->finishSketchCallCount, 1);
 }
 
+TEST(MockAdaptersTest, MockWorkspaceAnswersSurfaceZBatch) {
+    MockWorkspace workspace;
+    workspace.mockSurfaceZResult = true;
+    workspace.mockSurfaceZ = 1.25;
+
+    std::vector<ChipCarving::Geometry::Point2D> points = {{0.0, 0.0}, {1.0, 2.0}, {3.0, 4.0}};
+    auto heights = workspace.getSurfaceZBatch("surface-1", points, true);
+
+    ASSERT_EQ(heights.size(), points.size());
+    for (double z : heights) {
+        EXPECT_DOUBLE_EQ(z, 1.25);
+    }
+    EXPECT_EQ(workspace.getSurfaceZBatchCallCount, 1);
+    EXPECT_EQ(workspace.getSurfaceZCallCount, 0);
+    EXPECT_EQ(workspace.lastBatchSize, 3u);
+    EXPECT_EQ(workspace.lastQueriedSurfaceId, "surface-1");
+
+    workspace.mockSurfaceZResult = false;
+    heights = workspace.getSurfaceZBatch("surface-1", points, true);
+    ASSERT_EQ(heights.size(), points.size());
+    EXPECT_TRUE(std::isnan(heights[1]));
+}
+
 TEST(MockAdaptersTest, MockFactoryCreatesValidObjects) {
     MockFactory factory;
 
@@ -81,4 +107,78 @@ TEST(MockAdaptersTest, MockSketchGetSketchCurveEntityIds) {
     sketch.reset();
     entityIds = sketch.getSketchCurveEntityIds();
     EXPECT_TRUE(entityIds.empty());
-}
\ No newline at end of file
+}
+
+TEST(MockAdaptersTest, SketchBulkEditScopesPairAndNest) {
+    MockSketch sketch("Test Sketch");
+    {
+        SketchBulkEdit outer(&sketch);
+        EXPECT_EQ(sketch.bulkEditDepth, 1);
+        {
+            SketchBulkEdit inner(&sketch);
+            EXPECT_EQ(sketch.bulkEditDepth, 2);
+        }
+        EXPECT_EQ(sketch.bulkEditDepth, 1);
+    }
+    EXPECT_EQ(sketch.bulkEditDepth, 0);
+    EXPECT_EQ(sketch.beginBulkEditCallCount, 2);
+    EXPECT_EQ(sketch.endBulkEditCallCount, 2);
+
+    // A null sketch is a no-op
+    SketchBulkEdit none(nullptr);
+}
+
+TEST(MockAdaptersTest, MockSketchBatchesReportEachPath) {
+    using ChipCarving::Geometry::Point3D;
+    using ChipCarving::Geometry::PolylineSpan;
+    MockSketch sketch("Test Sketch");
+    std::vector<std::vector<Point3D>> paths = {
+        {Point3D(0, 0, 0), Point3D(1, 0, -1)}, {Point3D(2, 0, 0)}, {Point3D(0, 1, 0), Point3D(1, 1, -1)}};
+
+    std::vector<bool> splines = sketch.addSplines3D(paths);
+    EXPECT_EQ(splines, std::vector<bool>({true, false, true}));
+    EXPECT_EQ(sketch.splines3D.size(), 2u);
+    EXPECT_EQ(sketch.splineBatchCallCount, 1);
+
+    // Paths without spans are reported as failed
+    PolylineSpan line;
+    line.first = 0;
+    line.last = 1;
+    std::vector<bool> polylines = sketch.addPolylines3D(paths, {{line}, {line}});
+    EXPECT_EQ(polylines, std::vector<bool>({true, false, false}));
+    EXPECT_EQ(sketch.polylines3D.size(), 1u);
+    EXPECT_EQ(sketch.polylineBatchCallCount, 1);
+}
+
+TEST(MockAdaptersTest, MockLatencySpendsTheCallsOfEachOperation) {
+    using ChipCarving::Geometry::Point3D;
+    MockFactory factory;
+    factory.latency = std::make_shared<MockLatency>();
+    for (size_t kind = 0; kind < ChipCarving::Utils::API_CALL_KIND_COUNT; ++kind) {
+        factory.latency->setCost(static_cast<ApiCallKind>(kind), 1.0);
+    }
+
+    auto workspace = factory.createWorkspace();
+    auto sketch = workspace->createSketch("Test Sketch");
+    ASSERT_NE(sketch, nullptr);
+    sketch->addLineToSketch(0, 0, 1, 1);
+    sketch->addSplines3D({{Point3D(0, 0, 0), Point3D(1, 0, -1), Point3D(2, 0, 0)}});
+    workspace->getSurfaceZBatch("surface", {{0, 0}, {1, 1}}, false);
+
+    // Sketch: one; line: two points and a sketch line; batch: a collection, three points added, a spline
+    EXPECT_EQ(factory.latency->calls(ApiCallKind::Call), 4u);
+    EXPECT_EQ(factory.latency->calls(ApiCallKind::ObjectCreate), 2u + 4u + 2u);
+    EXPECT_EQ(factory.latency->calls(ApiCallKind::SketchEntity), 2u);
+    EXPECT_EQ(factory.latency->calls(ApiCallKind::RayCast), 2u);
+    EXPECT_GE(factory.latency->spentMs(), 0.016);
+
+    // Measured per-call means replace the kinds a run made
+    MockLatency measured;
+    EXPECT_TRUE(measured.loadMeasuredCosts(
+        "{\"unixTime\":1,\"spans\":[],\"apiCalls\":["
+        "{\"path\":\"a\",\"kind\":\"rayCasts\",\"count\":4,\"totalMs\":2.000},"
+        "{\"path\":\"b\",\"kind\":\"rayCasts\",\"count\":6,\"totalMs\":3.000}]}"));
+    EXPECT_DOUBLE_EQ(measured.cost(ApiCallKind::RayCast), 500.0);
+    EXPECT_DOUBLE_EQ(measured.cost(ApiCallKind::ObjectCreate), 50.0);
+    EXPECT_FALSE(measured.loadMeasuredCosts("{\"unixTime\":1,\"spans\":[]}"));
+}
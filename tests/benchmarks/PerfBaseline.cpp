@@ -0,0 +1,171 @@
+/**
+ * PerfBaseline.cpp
+ *
+ * Result collection, baseline files and tolerance checks for the perf gate
+ */
+
+#include "PerfBaseline.h"
+
+#include <cmath>
+#include <cstdio>
+#include <fstream>
+#include <sstream>
+#include <stdexcept>
+
+#include "parsers/JsonReader.h"
+
+namespace ChipCarving {
+namespace Testing {
+
+namespace {
+
+bool isTiming(const std::string& key) {
+    return key.size() > 2 && key.compare(key.size() - 2, 2, "Ms") == 0;
+}
+
+std::string formatValue(double value) {
+    char text[32];
+    std::snprintf(text, sizeof(text), "%.6g", value);
+    return text;
+}
+
+const PerfMeasurement* findMeasurement(const std::vector<PerfMeasurement>& measurements, const std::string& name) {
+    for (const auto& measurement : measurements) {
+        if (measurement.name == name) {
+            return &measurement;
+        }
+    }
+    return nullptr;
+}
+
+// Google Benchmark 1.8 replaced Run::error_occurred with Run::skipped
+template <typename Run>
+auto runFailed(const Run& run, int) -> decltype(static_cast<bool>(run.skipped)) {
+    return static_cast<bool>(run.skipped);
+}
+
+template <typename Run>
+auto runFailed(const Run& run, long) -> decltype(static_cast<bool>(run.error_occurred)) {
+    return run.error_occurred;
+}
+
+}  // namespace
+
+void PerfCollector::ReportRuns(const std::vector<Run>& runs) {
+    benchmark::ConsoleReporter::ReportRuns(runs);
+    for (const auto& run : runs) {
+        // Repetition aggregates repeat the iteration runs; a failed run has no results
+        if (run.run_type != Run::RT_Iteration || runFailed(run, 0)) {
+            continue;
+        }
+        PerfMeasurement measurement;
+        measurement.name = run.benchmark_name();
+        measurement.values["realTimeMs"] =
+            run.GetAdjustedRealTime() * 1e3 / benchmark::GetTimeUnitMultiplier(run.time_unit);
+        for (const auto& counter : run.counters) {
+            if (counter.second.flags & benchmark::Counter::kIsRate) {
+                continue;  // Rates restate realTimeMs
+            }
+            measurement.values[counter.first] = counter.second.value;
+        }
+        measurements_.push_back(std::move(measurement));
+    }
+}
+
+std::vector<PerfMeasurement> loadPerfBaseline(const std::string& path, PerfTolerances& tolerances) {
+    std::ifstream in(path);
+    if (!in) {
+        throw std::runtime_error("Cannot read perf baseline " + path);
+    }
+    std::stringstream contents;
+    contents << in.rdbuf();
+    std::string text = contents.str();
+
+    Parsers::JsonReader reader(text);
+    std::vector<PerfMeasurement> baseline;
+    std::string key;
+    reader.beginObject();
+    while (reader.nextMember(key)) {
+        if (key == "timeRatio") {
+            tolerances.timeRatio = reader.readNumber();
+        } else if (key == "timeSlackMs") {
+            tolerances.timeSlackMs = reader.readNumber();
+        } else if (key == "countFraction") {
+            tolerances.countFraction = reader.readNumber();
+        } else if (key == "benchmarks") {
+            reader.beginArray();
+            while (reader.nextElement()) {
+                PerfMeasurement measurement;
+                reader.beginObject();
+                while (reader.nextMember(key)) {
+                    if (key == "name") {
+                        measurement.name = reader.readString();
+                    } else {
+                        measurement.values[key] = reader.readNumber();
+                    }
+                }
+                baseline.push_back(std::move(measurement));
+            }
+        } else {
+            reader.skipValue();
+        }
+    }
+    reader.expectEnd();
+    return baseline;
+}
+
+bool storePerfBaseline(const std::string& path, const std::vector<PerfMeasurement>& measurements,
+                       const PerfTolerances& tolerances) {
+    std::ofstream out(path);
+    if (!out) {
+        return false;
+    }
+    out << "{\n  \"timeRatio\": " << formatValue(tolerances.timeRatio) << ",\n  \"timeSlackMs\": "
+        << formatValue(tolerances.timeSlackMs) << ",\n  \"countFraction\": " << formatValue(tolerances.countFraction)
+        << ",\n  \"benchmarks\": [";
+    for (size_t i = 0; i < measurements.size(); ++i) {
+        out << (i > 0 ? "," : "") << "\n    {\n      \"name\": \"" << measurements[i].name << "\"";
+        for (const auto& value : measurements[i].values) {
+            out << ",\n      \"" << value.first << "\": " << formatValue(value.second);
+        }
+        out << "\n    }";
+    }
+    out << "\n  ]\n}\n";
+    return static_cast<bool>(out);
+}
+
+std::vector<std::string> comparePerfBaseline(const std::vector<PerfMeasurement>& baseline,
+                                             const std::vector<PerfMeasurement>& measured,
+                                             const PerfTolerances& tolerances) {
+    std::vector<std::string> regressions;
+    for (const auto& expected : baseline) {
+        const PerfMeasurement* actual = findMeasurement(measured, expected.name);
+        if (!actual) {
+            regressions.push_back(expected.name + ": did not run");
+            continue;
+        }
+        for (const auto& value : expected.values) {
+            auto found = actual->values.find(value.first);
+            if (found == actual->values.end()) {
+                regressions.push_back(expected.name + ": no " + value.first + " counter");
+                continue;
+            }
+            double want = value.second;
+            double got = found->second;
+            bool regressed = false;
+            if (!isTiming(value.first)) {
+                regressed = std::abs(got - want) > tolerances.countFraction * std::abs(want);
+            } else if (tolerances.timeRatio > 0.0) {
+                regressed = got > want * tolerances.timeRatio + tolerances.timeSlackMs;
+            }
+            if (regressed) {
+                regressions.push_back(expected.name + ": " + value.first + " " + formatValue(got) + " vs baseline " +
+                                      formatValue(want));
+            }
+        }
+    }
+    return regressions;
+}
+
+}  // namespace Testing
+}  // namespace ChipCarving
@@ -0,0 +1,68 @@
+/**
+ * PerfBaseline.h
+ *
+ * Stored benchmark baselines for the perf regression gate. A baseline holds,
+ * per benchmark, the real time and every counter of a reference run; values
+ * named "...Ms" are timings, everything else (points, curves, allocations)
+ * is a count. The gate fails a timing that grows beyond a ratio of its
+ * baseline and a count that moves out of a band around it in either
+ * direction, since fewer points is as much a behavior change as more.
+ */
+
+#pragma once
+
+#include <benchmark/benchmark.h>
+
+#include <map>
+#include <string>
+#include <vector>
+
+namespace ChipCarving {
+namespace Testing {
+
+struct PerfMeasurement {
+    std::string name;                      // Benchmark name with arguments, e.g. "BM_PluginPipeline/100"
+    std::map<std::string, double> values;  // "realTimeMs" and the benchmark's counters, per iteration
+};
+
+struct PerfTolerances {
+    double timeRatio = 2.0;       // Largest accepted measured/baseline timing; 0 = timings not checked
+    double timeSlackMs = 0.5;     // Added to every timing limit so sub-millisecond stages do not flap
+    double countFraction = 0.05;  // Largest accepted relative change of a count
+};
+
+/**
+ * Console reporter that also keeps each benchmark's results for the gate
+ */
+class PerfCollector : public benchmark::ConsoleReporter {
+   public:
+    void ReportRuns(const std::vector<Run>& runs) override;
+
+    const std::vector<PerfMeasurement>& measurements() const {
+        return measurements_;
+    }
+
+   private:
+    std::vector<PerfMeasurement> measurements_;
+};
+
+/**
+ * @throws std::runtime_error if the file cannot be read or is malformed
+ */
+std::vector<PerfMeasurement> loadPerfBaseline(const std::string& path, PerfTolerances& tolerances);
+
+/**
+ * @return false if the file could not be written
+ */
+bool storePerfBaseline(const std::string& path, const std::vector<PerfMeasurement>& measurements,
+                       const PerfTolerances& tolerances);
+
+/**
+ * One message per regression; baseline benchmarks that did not run count as regressions
+ */
+std::vector<std::string> comparePerfBaseline(const std::vector<PerfMeasurement>& baseline,
+                                             const std::vector<PerfMeasurement>& measured,
+                                             const PerfTolerances& tolerances);
+
+}  // namespace Testing
+}  // namespace ChipCarving
@@ -0,0 +1,67 @@
+/**
+ * bench_DesignParser.cpp
+ *
+ * Benchmarks for design file parsing on synthetic designs of mixed LEAF and
+ * TRI_ARC shapes from the load-testing generator, as JSON and as binary designs.
+ */
+
+#include <benchmark/benchmark.h>
+
+#include <cstdio>
+#include <string>
+
+#include "../tools/DesignGenerator.h"
+#include "parsers/BinaryDesign.h"
+#include "parsers/DesignParser.h"
+
+using namespace ChipCarving::Parsers;
+
+namespace {
+
+void BM_ParseFromString(benchmark::State& state) {
+    ChipCarving::Testing::DesignGeneratorOptions options;
+    options.shapeCount = static_cast<int>(state.range(0));
+    std::string json = ChipCarving::Testing::generateDesign(options);
+    for (auto _ : state) {
+        DesignFile design = DesignParser::parseFromString(json);
+        benchmark::DoNotOptimize(design);
+    }
+    state.SetBytesProcessed(state.iterations() * static_cast<int64_t>(json.size()));
+    state.counters["shapes"] = static_cast<double>(state.range(0));
+}
+BENCHMARK(BM_ParseFromString)->RangeMultiplier(10)->Range(10, 100000)->Unit(benchmark::kMillisecond);
+
+void BM_ParseFromStringIntoArena(benchmark::State& state) {
+    ChipCarving::Testing::DesignGeneratorOptions options;
+    options.shapeCount = static_cast<int>(state.range(0));
+    std::string json = ChipCarving::Testing::generateDesign(options);
+    DesignParseOptions parseOptions;
+    parseOptions.arenaAllocation = true;
+    for (auto _ : state) {
+        DesignFile design = DesignParser::parseFromString(json, parseOptions);
+        benchmark::DoNotOptimize(design);
+    }
+    state.SetBytesProcessed(state.iterations() * static_cast<int64_t>(json.size()));
+    state.counters["shapes"] = static_cast<double>(state.range(0));
+}
+BENCHMARK(BM_ParseFromStringIntoArena)->RangeMultiplier(10)->Range(10, 100000)->Unit(benchmark::kMillisecond);
+
+void BM_ReadBinaryDesign(benchmark::State& state) {
+    ChipCarving::Testing::DesignGeneratorOptions options;
+    options.shapeCount = static_cast<int>(state.range(0));
+    DesignFile source = DesignParser::parseFromString(ChipCarving::Testing::generateDesign(options));
+    std::string path = "bench_design_" + std::to_string(state.range(0)) + ".ccdb";
+    if (!writeBinaryDesign(source, path)) {
+        state.SkipWithError("Could not write the binary design");
+        return;
+    }
+    for (auto _ : state) {
+        DesignFile design = DesignParser::parseFromFile(path);
+        benchmark::DoNotOptimize(design);
+    }
+    std::remove(path.c_str());
+    state.counters["shapes"] = static_cast<double>(state.range(0));
+}
+BENCHMARK(BM_ReadBinaryDesign)->RangeMultiplier(10)->Range(10, 100000)->Unit(benchmark::kMillisecond);
+
+}  // namespace
@@ -0,0 +1,151 @@
+/**
+ * bench_MedialAxis.cpp
+ *
+ * Benchmarks for OpenVoronoi medial axis computation (including point site
+ * insertion order and runs of many small profiles), A/B runs of the medial
+ * axis engines, and path sampling over tessellated Leaf and TriArc profiles.
+ */
+
+#include <benchmark/benchmark.h>
+
+#include <memory>
+#include <vector>
+
+#include "../geometry/ShapeTessellation.h"
+#include "geometry/Leaf.h"
+#include "geometry/MedialAxisEngine.h"
+#include "geometry/MedialAxisProcessor.h"
+#include "geometry/MedialAxisUtilities.h"
+#include "geometry/TriArc.h"
+#include "geometry/VoronoiSiteOrder.h"
+
+using namespace ChipCarving::Geometry;
+using namespace ChipCarving::Testing;
+
+namespace {
+
+// Largest profile benchmarked. Above about 5k vertices the self-intersection
+// check's absolute collinearity tolerance rejects tessellated arcs, so those
+// rows report the validation error instead of a time.
+constexpr int MAX_VERTICES = 10000;
+
+// Polygons in cm, the units computeMedialAxis receives from Fusion
+std::vector<Point2D> leafPolygon(int vertexCount) {
+    Leaf leaf(Point2D(0.0, 0.0), Point2D(3.0, 0.0));
+    return tessellateLeaf(leaf, vertexCount / 2);
+}
+
+std::vector<Point2D> triArcPolygon(int vertexCount) {
+    TriArc triArc(Point2D(0.0, 0.0), Point2D(3.0, 0.0), Point2D(1.5, 2.6));
+    return tessellateTriArc(triArc, vertexCount / 3);
+}
+
+void computeMedialAxisBenchmark(benchmark::State& state, const std::vector<Point2D>& polygon,
+                                SiteInsertionOrder order = SiteInsertionOrder::HILBERT) {
+    MedialAxisProcessor processor;
+    processor.setVerbose(false);
+    processor.setSiteInsertionOrder(order);
+    for (auto _ : state) {
+        MedialAxisResults results = processor.computeMedialAxis(polygon);
+        benchmark::DoNotOptimize(results);
+        if (!results.success) {
+            state.SkipWithError(results.errorMessage.c_str());
+            break;
+        }
+    }
+    state.counters["vertices"] = static_cast<double>(polygon.size());
+    state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(polygon.size()));
+}
+
+void BM_ComputeMedialAxisLeaf(benchmark::State& state) {
+    computeMedialAxisBenchmark(state, leafPolygon(static_cast<int>(state.range(0))));
+}
+BENCHMARK(BM_ComputeMedialAxisLeaf)->RangeMultiplier(4)->Range(50, MAX_VERTICES)->Unit(benchmark::kMillisecond);
+
+void BM_ComputeMedialAxisTriArc(benchmark::State& state) {
+    computeMedialAxisBenchmark(state, triArcPolygon(static_cast<int>(state.range(0))));
+}
+BENCHMARK(BM_ComputeMedialAxisTriArc)->RangeMultiplier(4)->Range(50, MAX_VERTICES)->Unit(benchmark::kMillisecond);
+
+// Point site insertion order (0 = polygon, 1 = Hilbert, 2 = shuffled) on a 4k-vertex leaf
+void BM_ComputeMedialAxisSiteOrder(benchmark::State& state) {
+    computeMedialAxisBenchmark(state, leafPolygon(4000), static_cast<SiteInsertionOrder>(state.range(0)));
+}
+BENCHMARK(BM_ComputeMedialAxisSiteOrder)->DenseRange(0, 2)->Unit(benchmark::kMillisecond);
+
+// 800 small leaves through one processor, as a plugin run over a dense design
+// does; once its workspace has grown, each profile should allocate very little
+void BM_ComputeMedialAxisSmallLeafRun(benchmark::State& state) {
+    std::vector<std::vector<Point2D>> leaves;
+    for (int i = 0; i < 800; ++i) {
+        Leaf leaf(Point2D(0.0, 0.0), Point2D(0.5 + 0.001 * i, 0.0));
+        leaves.push_back(tessellateLeaf(leaf, 40));
+    }
+    MedialAxisProcessor processor;
+    processor.setVerbose(false);
+    for (auto _ : state) {
+        for (const auto& polygon : leaves) {
+            MedialAxisResults results = processor.computeMedialAxis(polygon);
+            benchmark::DoNotOptimize(results);
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(leaves.size()));
+}
+BENCHMARK(BM_ComputeMedialAxisSmallLeafRun)->Unit(benchmark::kMillisecond);
+
+// One engine per run on the same 400-vertex unedited leaf (0 = OpenVoronoi, 1 = analytic, 2 = Boost.Polygon)
+void BM_MedialAxisEngine(benchmark::State& state) {
+    Leaf leaf(Point2D(0.0, 0.0), Point2D(3.0, 0.0));
+    std::vector<Point2D> polygon = leafPolygon(400);
+    MedialAxisProfile profile;
+    profile.polygon = &polygon;
+    profile.sourceShape = &leaf;
+
+    MedialAxisProcessor processor;
+    processor.setVerbose(false);
+    MedialAxisEngineSet engines;
+    if (state.range(0) == 0) {
+        engines.add(std::make_unique<OpenVoronoiMedialAxisEngine>(processor));
+    } else if (state.range(0) == 1) {
+        engines.add(std::make_unique<AnalyticMedialAxisEngine>());
+    } else {
+        engines.add(std::make_unique<BoostVoronoiMedialAxisEngine>(processor));
+    }
+    state.SetLabel(engines.engine(0).name());
+    for (auto _ : state) {
+        MedialAxisResults results;
+        if (engines.compute(profile, results) == MedialAxisEngineSet::NO_ENGINE) {
+            state.SkipWithError(results.errorMessage.c_str());
+            break;
+        }
+        benchmark::DoNotOptimize(results);
+    }
+}
+BENCHMARK(BM_MedialAxisEngine)->DenseRange(0, 2)->Unit(benchmark::kMillisecond);
+
+// Samples the medial axis of a leaf profile; chains are computed once outside the timed loop
+void BM_SampleMedialAxisPaths(benchmark::State& state) {
+    MedialAxisProcessor processor;
+    processor.setVerbose(false);
+    MedialAxisResults results = processor.computeMedialAxis(leafPolygon(static_cast<int>(state.range(0))));
+    if (!results.success) {
+        state.SkipWithError(results.errorMessage.c_str());
+        return;
+    }
+
+    std::vector<std::vector<Point2D>> chains;
+    std::vector<std::vector<double>> clearances;
+    for (const auto& chain : results.chains) {
+        chains.emplace_back(chain.begin(), chain.end());
+        clearances.emplace_back(chain.clearanceData(), chain.clearanceData() + chain.size());
+    }
+
+    for (auto _ : state) {
+        auto sampled = sampleMedialAxisPaths(chains, clearances, 0.05);
+        benchmark::DoNotOptimize(sampled);
+    }
+    state.counters["chainPoints"] = static_cast<double>(results.chains.pointCount());
+}
+BENCHMARK(BM_SampleMedialAxisPaths)->RangeMultiplier(4)->Range(50, MAX_VERTICES);
+
+}  // namespace
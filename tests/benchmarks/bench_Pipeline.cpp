@@ -0,0 +1,193 @@
+/**
+ * bench_Pipeline.cpp
+ *
+ * End-to-end benchmark of the plugin pipeline on fixed synthetic designs:
+ * design import (parse and sketch), then medial axis, sampling, V-carve,
+ * path optimization and 3D sketch output, all through the mock adapters.
+ * Reports the time, allocations and allocated bytes of the stages on the
+ * calling thread (parse, profile extraction with the analytic medial axis,
+ * toolpath writes), 3D curve points written and heap allocations of the
+ * whole run per iteration; the perf gate (ctest -L perf) compares them to
+ * perf_baseline.json. Sampling and V-carve run on the pipeline worker and
+ * show in the totals only.
+ *
+ * BM_PipelineWithApiLatency runs the same pipeline with the mocks spending
+ * simulated Fusion API call costs (tests/adapters/MockLatency.h), so batching
+ * and caching changes show in wall time as they would in Fusion. Costs come
+ * from the metrics file named by CHIP_CARVING_API_COSTS when set (a run's
+ * RunMetrics::appendTo output), else typical Fusion timings.
+ */
+
+#include <benchmark/benchmark.h>
+
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <memory>
+#include <string>
+
+#include "../adapters/MockAdapters.h"
+#include "../tools/DesignGenerator.h"
+#include "core/PluginManager.h"
+#include "geometry/ShapePolygonizer.h"
+#include "parsers/DesignParser.h"
+#include "utils/AllocationTracking.h"
+#include "utils/UnitConversion.h"
+
+using namespace ChipCarving::Adapters;
+using namespace ChipCarving::Core;
+using namespace ChipCarving::Testing;
+
+namespace {
+
+// Outline tolerance (mm) for the selected profiles, near what Fusion strokes arcs with
+constexpr double PROFILE_TOLERANCE = 0.01;
+
+struct PipelineDesign {
+    std::string path;
+    SketchSelection selection;
+};
+
+// Fixed-seed design written to disk for import, with its outlines selected as profiles (cm)
+PipelineDesign makePipelineDesign(int shapeCount) {
+    DesignGeneratorOptions options;
+    options.shapeCount = shapeCount;
+    options.pattern = DesignPattern::Rosette;
+    options.seed = 7;
+    std::string json = generateDesign(options);
+
+    PipelineDesign design;
+    design.path = "bench_pipeline_" + std::to_string(shapeCount) + ".json";
+    std::ofstream(design.path) << json;
+
+    ChipCarving::Parsers::DesignFile parsed = ChipCarving::Parsers::DesignParser::parseFromString(json);
+    for (size_t i = 0; i < parsed.shapes.size(); ++i) {
+        ProfileGeometry profile;
+        for (const auto& point : ChipCarving::Geometry::polygonizeShape(*parsed.shapes[i], PROFILE_TOLERANCE)) {
+            profile.vertices.emplace_back(ChipCarving::Utils::mmToFusionLength(point.x),
+                                          ChipCarving::Utils::mmToFusionLength(point.y));
+        }
+        design.selection.selectedEntityIds.push_back("profile-" + std::to_string(i));
+        design.selection.selectedProfiles.push_back(std::move(profile));
+    }
+    design.selection.closedPathCount = static_cast<int>(parsed.shapes.size());
+    design.selection.isValid = true;
+    return design;
+}
+
+// Per-iteration sums of one stage's spans, wherever they nest
+struct StageTotals {
+    double ms = 0.0;
+    double allocations = 0.0;
+    double bytes = 0.0;
+
+    void add(const ChipCarving::Utils::RunMetrics& metrics, const char* name) {
+        for (const auto& span : metrics.spans()) {
+            if (std::string(span.name) == name) {
+                ms += span.totalMs;
+                allocations += static_cast<double>(span.allocations);
+                bytes += static_cast<double>(span.allocatedBytes);
+            }
+        }
+    }
+
+    void report(benchmark::State& state, const std::string& stage) const {
+        auto perIteration = benchmark::Counter::kAvgIterations;
+        state.counters[stage + "Ms"] = benchmark::Counter(ms, perIteration);
+        state.counters[stage + "Allocs"] = benchmark::Counter(allocations, perIteration);
+        state.counters[stage + "Bytes"] = benchmark::Counter(bytes, perIteration);
+    }
+};
+
+void BM_PluginPipeline(benchmark::State& state) {
+    PipelineDesign design = makePipelineDesign(static_cast<int>(state.range(0)));
+    MedialAxisParameters params;
+    params.generateVCarveToolpaths = true;
+    params.medialAxisWorkers = 1;  // Single-threaded, so timings and allocations are repeatable
+
+    StageTotals parse;
+    StageTotals extract;
+    StageTotals write;
+    double curvePoints = 0.0;
+    double allocations = 0.0;
+    for (auto _ : state) {
+        state.PauseTiming();
+        auto* factory = new MockFactory();
+        PluginManager manager{std::unique_ptr<IFusionFactory>(factory)};
+        manager.initialize();
+        uint64_t allocationsBefore = ChipCarving::Utils::processAllocationTotals().count;
+        state.ResumeTiming();
+
+        bool imported = manager.executeImportDesign(design.path);
+        parse.add(manager.getLastRunMetrics(), "parse");
+        bool generated = imported && manager.executeMedialAxisGeneration(design.selection, params);
+
+        state.PauseTiming();
+        allocations += static_cast<double>(ChipCarving::Utils::processAllocationTotals().count - allocationsBefore);
+        if (!generated) {
+            state.SkipWithError("Pipeline run failed");
+            break;
+        }
+        extract.add(manager.getLastRunMetrics(), "extractProfiles");
+        write.add(manager.getLastRunMetrics(), "write");
+        curvePoints += static_cast<double>(*factory->getLastCreatedWorkspace()->sketchCurvePointCount);
+        state.ResumeTiming();
+    }
+
+    auto perIteration = benchmark::Counter::kAvgIterations;
+    parse.report(state, "parse");
+    extract.report(state, "extract");
+    write.report(state, "write");
+    state.counters["curvePoints"] = benchmark::Counter(curvePoints, perIteration);
+    state.counters["allocations"] = benchmark::Counter(allocations, perIteration);
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+    std::remove(design.path.c_str());
+}
+BENCHMARK(BM_PluginPipeline)->Arg(20)->Arg(200)->Unit(benchmark::kMillisecond);
+
+// Simulated call costs, measured ones when CHIP_CARVING_API_COSTS names a metrics file
+std::shared_ptr<MockLatency> makeApiLatency() {
+    auto latency = std::make_shared<MockLatency>();
+    const char* measured = std::getenv("CHIP_CARVING_API_COSTS");
+    if (measured && !latency->loadMeasuredCostsFile(measured)) {
+        std::fprintf(stderr, "No API call totals in %s; using default costs\n", measured);
+    }
+    return latency;
+}
+
+void BM_PipelineWithApiLatency(benchmark::State& state) {
+    PipelineDesign design = makePipelineDesign(static_cast<int>(state.range(0)));
+    MedialAxisParameters params;
+    params.generateVCarveToolpaths = true;
+    params.medialAxisWorkers = 1;
+
+    std::shared_ptr<MockLatency> latency = makeApiLatency();
+    for (auto _ : state) {
+        state.PauseTiming();
+        auto* factory = new MockFactory();
+        factory->latency = latency;
+        PluginManager manager{std::unique_ptr<IFusionFactory>(factory)};
+        manager.initialize();
+        state.ResumeTiming();
+
+        bool imported = manager.executeImportDesign(design.path);
+        if (!imported || !manager.executeMedialAxisGeneration(design.selection, params)) {
+            state.SkipWithError("Pipeline run failed");
+            break;
+        }
+    }
+
+    // Simulated Fusion time and calls per iteration, against the measured wall time
+    auto perIteration = benchmark::Counter::kAvgIterations;
+    state.counters["apiMs"] = benchmark::Counter(latency->spentMs(), perIteration);
+    for (size_t kind = 0; kind < ChipCarving::Utils::API_CALL_KIND_COUNT; ++kind) {
+        auto apiKind = static_cast<ApiCallKind>(kind);
+        state.counters[ChipCarving::Utils::apiCallKindName(apiKind)] =
+            benchmark::Counter(static_cast<double>(latency->calls(apiKind)), perIteration);
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+    std::remove(design.path.c_str());
+}
+BENCHMARK(BM_PipelineWithApiLatency)->Arg(20)->Arg(200)->Unit(benchmark::kMillisecond)->UseRealTime();
+
+}  // namespace
@@ -0,0 +1,124 @@
+/**
+ * bench_VCarve.cpp
+ *
+ * Benchmarks for V-carve path generation and path merging on synthetic
+ * chain sets (zig-zag medial paths with varying clearance).
+ */
+
+#include <benchmark/benchmark.h>
+
+#include <algorithm>
+#include <cmath>
+#include <random>
+#include <vector>
+
+#include "geometry/ToolModel.h"
+#include "geometry/VCarveCalculator.h"
+
+using namespace ChipCarving::Geometry;
+using namespace ChipCarving::Adapters;
+
+namespace {
+
+constexpr int POINTS_PER_PATH = 200;
+
+MedialAxisParameters vcarveParameters() {
+    MedialAxisParameters params;
+    params.toolAngle = 90.0;
+    params.maxVCarveDepth = 10.0;
+    params.samplingDistance = 1.0;
+    params.generateVCarveToolpaths = true;
+    return params;
+}
+
+// pathCount open paths of 1mm-spaced points, laid out in rows
+std::vector<SampledMedialPath> syntheticSampledPaths(int pathCount) {
+    std::vector<SampledMedialPath> paths(static_cast<size_t>(pathCount));
+    for (int p = 0; p < pathCount; ++p) {
+        SampledMedialPath& path = paths[static_cast<size_t>(p)];
+        double rowY = 10.0 * p;
+        for (int i = 0; i < POINTS_PER_PATH; ++i) {
+            double clearance = 1.0 + 0.5 * std::sin(0.1 * i);
+            path.points.emplace_back(Point2D(static_cast<double>(i), rowY + 0.5 * std::sin(0.3 * i)), clearance);
+        }
+        path.totalLength = POINTS_PER_PATH - 1.0;
+    }
+    return paths;
+}
+
+// Chains split into short segments whose endpoints meet, shuffled so merging must search
+std::vector<VCarvePath> syntheticSegmentedPaths(int segmentCount) {
+    const int pointsPerSegment = 8;
+    const int segmentsPerChain = 50;
+    std::vector<VCarvePath> segments;
+    segments.reserve(static_cast<size_t>(segmentCount));
+    for (int s = 0; s < segmentCount; ++s) {
+        int chain = s / segmentsPerChain;
+        int start = (s % segmentsPerChain) * (pointsPerSegment - 1);
+        VCarvePath segment;
+        for (int i = 0; i < pointsPerSegment; ++i) {
+            double x = static_cast<double>(start + i);
+            segment.points.emplace_back(Point2D(x, 10.0 * chain), 1.0, 1.0);
+        }
+        segment.totalLength = segment.calculateLength();
+        segments.push_back(std::move(segment));
+    }
+
+    std::mt19937 rng(12345);
+    std::shuffle(segments.begin(), segments.end(), rng);
+    return segments;
+}
+
+void BM_GenerateVCarvePaths(benchmark::State& state) {
+    VCarveCalculator calculator;
+    MedialAxisParameters params = vcarveParameters();
+    auto sampledPaths = syntheticSampledPaths(static_cast<int>(state.range(0)));
+
+    for (auto _ : state) {
+        VCarveResults results = calculator.generateVCarvePaths(sampledPaths, params);
+        benchmark::DoNotOptimize(results);
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0) * POINTS_PER_PATH);
+}
+BENCHMARK(BM_GenerateVCarvePaths)->RangeMultiplier(4)->Range(4, 1024)->Unit(benchmark::kMillisecond);
+
+// Depth kernel of each tool family over one batch of clearances: 0 V-bit, 1 flat-tip V-bit, 2 tapered ball
+void BM_ToolDepths(benchmark::State& state) {
+    const ToolShape shapes[] = {ToolShape::V_BIT, ToolShape::FLAT_TIP_V_BIT, ToolShape::TAPERED_BALL};
+    MedialAxisParameters params = vcarveParameters();
+    params.toolShape = shapes[state.range(0)];
+    params.toolAngle = 30.0;
+    params.toolTipDiameter = 0.5;
+    ToolModel tool = ToolModel::fromParameters(params);
+    std::vector<double> radii(4096);
+    for (size_t i = 0; i < radii.size(); ++i) {
+        radii[i] = 0.001 * static_cast<double>(i);
+    }
+    std::vector<double> depths(radii.size());
+
+    for (auto _ : state) {
+        calculateToolDepths(tool, radii.data(), radii.size(), depths.data());
+        benchmark::DoNotOptimize(depths.data());
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(radii.size()));
+}
+BENCHMARK(BM_ToolDepths)->DenseRange(0, 2);
+
+void BM_OptimizePaths(benchmark::State& state) {
+    VCarveCalculator calculator;
+    MedialAxisParameters params = vcarveParameters();
+    auto segments = syntheticSegmentedPaths(static_cast<int>(state.range(0)));
+
+    for (auto _ : state) {
+        state.PauseTiming();
+        std::vector<VCarvePath> input = segments;
+        state.ResumeTiming();
+        auto merged = calculator.optimizePaths(std::move(input), params);
+        benchmark::DoNotOptimize(merged);
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_OptimizePaths)->RangeMultiplier(4)->Range(64, 16384)->Unit(benchmark::kMillisecond);
+
+}  // namespace
@@ -0,0 +1,90 @@
+/**
+ * bench_main.cpp
+ *
+ * Entry point for chip_carving_benchmarks
+ * Quiets the mock logger so console output does not dominate the timings.
+ *
+ * Perf gate options, on top of Google Benchmark's own:
+ *   --perf_baseline=FILE   Fail (exit 1) if a result leaves FILE's tolerance bands
+ *   --perf_record=FILE     Write the results as a new baseline
+ *   --perf_counts_only     Check counts only; for builds whose timings are not comparable
+ */
+
+#include <benchmark/benchmark.h>
+
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include "PerfBaseline.h"
+#include "utils/logging.h"
+
+using namespace ChipCarving::Testing;
+
+namespace {
+
+// Remove "--name=value" from argv, returning value, or "" if absent
+std::string takeOption(int& argc, char** argv, const std::string& name) {
+    std::string prefix = name + "=";
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        if (arg == name || arg.rfind(prefix, 0) == 0) {
+            for (int j = i; j + 1 < argc; ++j) {
+                argv[j] = argv[j + 1];
+            }
+            --argc;
+            return arg == name ? "1" : arg.substr(prefix.size());
+        }
+    }
+    return "";
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+    SetMinLogLevel(LogLevel::WARNING);
+
+    std::string baselinePath = takeOption(argc, argv, "--perf_baseline");
+    std::string recordPath = takeOption(argc, argv, "--perf_record");
+    bool countsOnly = !takeOption(argc, argv, "--perf_counts_only").empty();
+
+    benchmark::Initialize(&argc, argv);
+    if (benchmark::ReportUnrecognizedArguments(argc, argv)) {
+        return 1;
+    }
+    if (baselinePath.empty() && recordPath.empty()) {
+        benchmark::RunSpecifiedBenchmarks();
+        benchmark::Shutdown();
+        return 0;
+    }
+
+    PerfCollector collector;
+    benchmark::RunSpecifiedBenchmarks(&collector);
+    benchmark::Shutdown();
+
+    int status = 0;
+    try {
+        PerfTolerances tolerances;
+        if (!baselinePath.empty()) {
+            std::vector<PerfMeasurement> baseline = loadPerfBaseline(baselinePath, tolerances);
+            if (countsOnly) {
+                tolerances.timeRatio = 0.0;
+            }
+            std::vector<std::string> regressions = comparePerfBaseline(baseline, collector.measurements(), tolerances);
+            for (const auto& regression : regressions) {
+                std::cerr << "PERF REGRESSION " << regression << "\n";
+            }
+            std::cerr << (regressions.empty() ? "Perf gate passed against " : "Perf gate failed against ")
+                      << baselinePath << "\n";
+            status = regressions.empty() ? 0 : 1;
+        }
+        if (!recordPath.empty() && !storePerfBaseline(recordPath, collector.measurements(), PerfTolerances())) {
+            std::cerr << "Failed to write " << recordPath << "\n";
+            status = 1;
+        }
+    } catch (const std::exception& e) {
+        std::cerr << "perf gate: " << e.what() << "\n";
+        status = 1;
+    }
+    return status;
+}
@@ -0,0 +1,168 @@
+/**
+ * Unit tests for the headless carve-cli pipeline and toolpath writers
+ */
+
+#include <gtest/gtest.h>
+
+#include <cstdio>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "../tools/DesignGenerator.h"
+#include "cli/CarveJob.h"
+#include "cli/ToolpathWriter.h"
+#include "parsers/JsonReader.h"
+
+using namespace ChipCarving::Cli;
+using ChipCarving::Parsers::JsonReader;
+
+namespace {
+
+std::string generatedDesign(int shapeCount, uint32_t seed = 1) {
+    ChipCarving::Testing::DesignGeneratorOptions options;
+    options.shapeCount = shapeCount;
+    options.seed = seed;
+    return ChipCarving::Testing::generateDesign(options);
+}
+
+size_t countOccurrences(const std::string& text, const std::string& needle) {
+    size_t count = 0;
+    for (size_t pos = text.find(needle); pos != std::string::npos; pos = text.find(needle, pos + 1)) {
+        ++count;
+    }
+    return count;
+}
+
+}  // namespace
+
+TEST(CarveJobTest, CarvesGeneratedDesignAnalytically) {
+    CarveOptions options;
+    options.params.maxVCarveDepth = 3.0;
+    CarveJobResult result = runCarveJobFromString("generated", generatedDesign(20), options);
+
+    ASSERT_TRUE(result.success) << result.errorMessage;
+    EXPECT_EQ(result.shapeCount, 20);
+    EXPECT_EQ(result.analyticShapes, 20);
+    EXPECT_EQ(result.failedShapes, 0);
+    EXPECT_EQ(result.outlines.size(), 20u);
+    ASSERT_GE(result.toolpaths.size(), 20u);
+
+    for (const auto& toolpath : result.toolpaths) {
+        ASSERT_GE(toolpath.size(), 2u);
+        for (const auto& point : toolpath) {
+            EXPECT_LE(point.z, 0.0);
+            EXPECT_GE(point.z, -options.params.maxVCarveDepth - 1e-9);
+        }
+    }
+}
+
+TEST(CarveJobTest, SimulationFindsNoGougesInAnalyticToolpaths) {
+    CarveOptions options;
+    options.simulationResolution = 0.2;
+    options.params.toolDiameter = 50.0;  // Only the cone limits the cut
+    CarveJobResult result = runCarveJobFromString("generated", generatedDesign(6), options);
+
+    ASSERT_TRUE(result.success) << result.errorMessage;
+    ASSERT_TRUE(result.simulated);
+    const auto& verification = result.verification;
+    EXPECT_EQ(verification.cells.size(), result.simulation.depth.size());
+    EXPECT_GT(verification.insideCells, 0u);
+    EXPECT_EQ(verification.gougeCells, 0u);
+    // Cells along the boundaries are cut shallower than the depth tolerance
+    EXPECT_GT(verification.carvedCells, verification.insideCells * 8 / 10);
+}
+
+TEST(CarveJobTest, WorkerCountDoesNotChangeAnyBit) {
+    CarveOptions options;
+    options.simulationResolution = 0.5;
+    std::string design = generatedDesign(12, 7);
+    CarveJobResult one = runCarveJobFromString("generated", design, options, 1);
+    CarveJobResult four = runCarveJobFromString("generated", design, options, 4);
+
+    ASSERT_TRUE(one.success) << one.errorMessage;
+    ASSERT_TRUE(four.success) << four.errorMessage;
+    ASSERT_EQ(one.toolpaths.size(), four.toolpaths.size());
+    for (size_t i = 0; i < one.toolpaths.size(); ++i) {
+        ASSERT_EQ(one.toolpaths[i].size(), four.toolpaths[i].size()) << "toolpath " << i;
+        for (size_t j = 0; j < one.toolpaths[i].size(); ++j) {
+            EXPECT_EQ(one.toolpaths[i][j].x, four.toolpaths[i][j].x);
+            EXPECT_EQ(one.toolpaths[i][j].y, four.toolpaths[i][j].y);
+            EXPECT_EQ(one.toolpaths[i][j].z, four.toolpaths[i][j].z);
+        }
+    }
+    EXPECT_EQ(one.simulation.depth, four.simulation.depth);
+}
+
+TEST(CarveJobTest, ReportsParseErrorsWithoutThrowing) {
+    CarveJobResult result = runCarveJobFromString("broken", "{\"version\": \"2.0\", \"shapes\": [", CarveOptions());
+    EXPECT_FALSE(result.success);
+    EXPECT_FALSE(result.errorMessage.empty());
+    EXPECT_EQ(result.designPath, "broken");
+}
+
+TEST(CarveJobTest, BatchKeepsInputOrderAcrossWorkers) {
+    std::vector<std::string> paths;
+    for (int i = 0; i < 4; ++i) {
+        std::string path = ::testing::TempDir() + "carve_job_" + std::to_string(i) + ".json";
+        std::ofstream(path) << generatedDesign(5 + i, static_cast<uint32_t>(i + 1));
+        paths.push_back(path);
+    }
+    paths.insert(paths.begin() + 2, ::testing::TempDir() + "carve_job_missing.json");
+
+    CarveOptions options;
+    options.workers = 3;
+    std::vector<CarveJobResult> results = runCarveJobs(paths, options);
+
+    ASSERT_EQ(results.size(), paths.size());
+    for (size_t i = 0; i < paths.size(); ++i) {
+        EXPECT_EQ(results[i].designPath, paths[i]);
+    }
+    EXPECT_FALSE(results[2].success);
+    EXPECT_TRUE(results[0].success);
+    EXPECT_EQ(results[0].shapeCount, 5);
+    EXPECT_EQ(results[4].shapeCount, 8);
+
+    for (const auto& path : paths) {
+        std::remove(path.c_str());
+    }
+}
+
+TEST(ToolpathWriterTest, WritesEveryFormat) {
+    CarveOptions options;
+    CarveJobResult result = runCarveJobFromString("design \"a\"", generatedDesign(6), options);
+    ASSERT_TRUE(result.success) << result.errorMessage;
+
+    std::ostringstream json;
+    writeToolpathJson(json, result, options.params);
+    std::string jsonText = json.str();
+    JsonReader reader(jsonText);
+    EXPECT_NO_THROW({
+        reader.skipValue();
+        reader.expectEnd();
+    }) << jsonText;
+    EXPECT_NE(jsonText.find("\"design\": \"design \\\"a\\\"\""), std::string::npos);
+
+    std::ostringstream svg;
+    writeToolpathSvg(svg, result);
+    EXPECT_EQ(countOccurrences(svg.str(), "<polygon "), result.outlines.size());
+    EXPECT_EQ(countOccurrences(svg.str(), "<polyline "), result.toolpaths.size());
+
+    ChipCarving::Geometry::GcodePost gcode;
+    std::ostringstream nc;
+    writeToolpathGcode(nc, result, options.params, gcode);
+    std::string program = nc.str();
+    EXPECT_EQ(program.find("G21 G90 G17\n"), program.find('\n') + 1) << program;
+    // One plunge feed and one retract per toolpath, plus the initial rapid to safe Z
+    EXPECT_EQ(countOccurrences(program, " F300.0000\n"), result.toolpaths.size());
+    EXPECT_EQ(countOccurrences(program, "G0 Z5.0000\n"), result.toolpaths.size() + 1);
+    EXPECT_NE(program.find("M3 S18000\n"), std::string::npos);
+    EXPECT_EQ(program.substr(program.size() - 6), "M5\nM2\n");
+
+    ToolpathFormat format;
+    EXPECT_TRUE(parseToolpathFormat("gcode", format));
+    EXPECT_EQ(format, ToolpathFormat::Gcode);
+    EXPECT_STREQ(toolpathFormatExtension(format), ".nc");
+    EXPECT_FALSE(parseToolpathFormat("dxf", format));
+}
@@ -0,0 +1,90 @@
+/**
+ * test_DesignWatch.cpp
+ *
+ * Unit tests for the watch mode's design file watcher
+ */
+
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <cstdio>
+#include <fstream>
+#include <string>
+#include <thread>
+
+#include "../adapters/MockUserInterface.h"
+#include "core/DesignWatch.h"
+
+using namespace ChipCarving::Core;
+using namespace ChipCarving::Adapters;
+using namespace ChipCarving::Parsers;
+
+namespace {
+
+void writeDesign(const std::string& path, const std::string& text) {
+    std::ofstream out(path, std::ios::trunc);
+    out << text;
+}
+
+// Wait up to two seconds for the watcher's next change
+bool waitForChange(DesignWatch& watch, DesignFile& design, std::string& errorMessage) {
+    for (int i = 0; i < 200; ++i) {
+        if (watch.takeChange(design, errorMessage)) {
+            return true;
+        }
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    }
+    return false;
+}
+
+const char* ONE_LEAF = R"({"version": "2.0", "shapes": [)"
+                       R"({"type": "LEAF", "vertices": [{"x": 0, "y": 0}, {"x": 10, "y": 0}], "radius": 6.5}]})";
+
+}  // namespace
+
+TEST(DesignWatchTest, SettledSavesAreParsedOnTheWatcherThread) {
+    std::string path = ::testing::TempDir() + "design_watch.json";
+    writeDesign(path, ONE_LEAF);
+    MockUserInterface ui;
+    DesignWatch watch(path, &ui, 10);
+    EXPECT_EQ(watch.filePath(), path);
+
+    // The file as it was when the watch started is not a change
+    DesignFile design;
+    std::string errorMessage;
+    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+    EXPECT_FALSE(watch.takeChange(design, errorMessage));
+
+    writeDesign(path, R"({"version": "2.0", "shapes": [)"
+                      R"({"type": "LEAF", "vertices": [{"x": 0, "y": 0}, {"x": 10, "y": 0}], "radius": 6.5},)"
+                      R"({"type": "LEAF", "vertices": [{"x": 20, "y": 0}, {"x": 30, "y": 0}], "radius": 6.5}]})");
+    ASSERT_TRUE(waitForChange(watch, design, errorMessage));
+    EXPECT_TRUE(errorMessage.empty());
+    EXPECT_EQ(design.shapes.size(), 2u);
+    EXPECT_GT(ui.notifyMainThreadCallCount.load(), 0);
+    EXPECT_FALSE(watch.takeChange(design, errorMessage));
+
+    // A save that does not parse is reported instead of a design
+    writeDesign(path, R"({"version": "2.0", "shapes": [)");
+    ASSERT_TRUE(waitForChange(watch, design, errorMessage));
+    EXPECT_FALSE(errorMessage.empty());
+    EXPECT_TRUE(design.shapes.empty());
+
+    std::remove(path.c_str());
+}
+
+TEST(DesignWatchTest, RecordedGenerationListsEachSketchOnce) {
+    SketchSelection selection;
+    for (const char* sketchName : {"Imported Design", "Border", "Imported Design", ""}) {
+        ProfileGeometry profile;
+        profile.sketchName = sketchName;
+        selection.selectedProfiles.push_back(profile);
+    }
+    MedialAxisParameters params;
+    params.toolName = "60 degree V-bit";
+
+    WatchedGeneration generation;
+    recordWatchedGeneration(generation, selection, params);
+    EXPECT_EQ(generation.sketchNames, (std::vector<std::string>{"Imported Design", "Border"}));
+    EXPECT_EQ(generation.params.toolName, "60 degree V-bit");
+}
@@ -0,0 +1,54 @@
+/**
+ * test_ImportDiff.cpp
+ *
+ * Unit tests for the shape tags and update plans of updating re-imports
+ */
+
+#include <gtest/gtest.h>
+
+#include <string>
+#include <vector>
+
+#include "core/ImportDiff.h"
+#include "geometry/ShapeStore.h"
+
+using namespace ChipCarving::Core;
+using namespace ChipCarving::Geometry;
+
+namespace {
+
+Leaf leaf(double x, double radius = 6.5) {
+    return Leaf(Point2D(x, 0.0), Point2D(x + 10.0, 0.0), radius);
+}
+
+}  // namespace
+
+TEST(ImportDiffTest, TagsFollowGeometryAndNumberRepeats) {
+    ShapeStore shapes;
+    shapes.add(leaf(0.0));
+    shapes.add(leaf(20.0));
+    shapes.add(leaf(0.0));
+    shapes.add(leaf(0.0, 7.0));
+
+    std::vector<std::string> tags = importedShapeTags(shapes, 0, shapes.size());
+    ASSERT_EQ(tags.size(), 4u);
+    EXPECT_EQ(tags[0].size(), 16u);
+    EXPECT_NE(tags[0], tags[1]);
+    EXPECT_EQ(tags[2], tags[0] + "-2");
+    EXPECT_NE(tags[3], tags[0]);
+
+    // A range is tagged on its own, so its repeats count from its first shape
+    EXPECT_EQ(importedShapeTags(shapes, 1, 3), (std::vector<std::string>{tags[1], tags[0]}));
+}
+
+TEST(ImportDiffTest, PlanDrawsNewShapesAndDeletesStaleAndUntaggedCurves) {
+    std::vector<std::string> shapeTags = {"a", "b", "c"};
+    ImportUpdate update = planImportUpdate(shapeTags, {"", "a", "c", "old"});
+    EXPECT_EQ(update.keptShapes, 2u);
+    EXPECT_EQ(update.drawShapes, std::vector<size_t>{1});
+    EXPECT_EQ(update.staleTags, (std::vector<std::string>{"", "old"}));
+
+    ImportUpdate fresh = planImportUpdate(shapeTags, {});
+    EXPECT_EQ(fresh.drawShapes, (std::vector<size_t>{0, 1, 2}));
+    EXPECT_TRUE(fresh.staleTags.empty());
+}
@@ -0,0 +1,145 @@
+/**
+ * test_IncrementalRegeneration.cpp
+ *
+ * Unit tests for the profile tags of incremental Generate Paths
+ */
+
+#include <gtest/gtest.h>
+
+#include <vector>
+
+#include "core/IncrementalRegeneration.h"
+
+using namespace ChipCarving::Adapters;
+using namespace ChipCarving::Core;
+using namespace ChipCarving::Geometry;
+
+namespace {
+
+std::vector<Point2D> square() {
+    return {Point2D(0, 0), Point2D(2, 0), Point2D(2, 2), Point2D(0, 2)};
+}
+
+}  // namespace
+
+TEST(IncrementalRegenerationTest, TagFollowsGeometryAndToolpathParameters) {
+    MedialAxisParameters params;
+    IWorkspace::TransformParams transform;
+    std::string tag = profileToolpathTag(square(), {}, transform, params);
+    EXPECT_EQ(tag.size(), 16u);
+    EXPECT_EQ(profileToolpathTag(square(), {}, transform, params), tag);
+
+    std::vector<Point2D> moved = square();
+    moved[2].x += 0.01;
+    EXPECT_NE(profileToolpathTag(moved, {}, transform, params), tag);
+    EXPECT_NE(profileToolpathTag(square(), {{Point2D(0.5, 0.5), Point2D(1, 0.5), Point2D(1, 1)}}, transform, params),
+              tag);
+    IWorkspace::TransformParams raised;
+    raised.sketchPlaneZ = 1.0;
+    EXPECT_NE(profileToolpathTag(square(), {}, raised, params), tag);
+
+    MedialAxisParameters deeper = params;
+    deeper.maxVCarveDepth = 5.0;
+    EXPECT_NE(profileToolpathTag(square(), {}, transform, deeper), tag);
+    MedialAxisParameters automatic = params;
+    automatic.autoTolerance = true;
+    EXPECT_NE(profileToolpathTag(square(), {}, transform, automatic), tag);
+
+    // Settings outside the toolpath sketch leave the tag alone
+    MedialAxisParameters other = params;
+    other.gcodeFeedRate = 500.0;
+    other.medialAxisWorkers = 4;
+    other.runInBackground = !params.runInBackground;
+    EXPECT_EQ(profileToolpathTag(square(), {}, transform, other), tag);
+}
+
+TEST(IncrementalRegenerationTest, ToolpathShardsExtendTheSketchName) {
+    MedialAxisParameters params;
+    params.toolName = "60° V-bit";
+    EXPECT_EQ(toolpathSketchName(params), "V-Carve Toolpaths - 60° V-bit");
+    EXPECT_EQ(toolpathSketchName(params, 0), toolpathSketchName(params));
+    EXPECT_EQ(toolpathSketchName(params, 1), "V-Carve Toolpaths - 60° V-bit (2)");
+    EXPECT_EQ(toolpathSketchName(params, 9), "V-Carve Toolpaths - 60° V-bit (10)");
+}
+
+TEST(IncrementalRegenerationTest, OnlyTheToolpathSketchIsIncremental) {
+    MedialAxisParameters params;
+    params.incrementalRegeneration = true;
+    params.generateVCarveToolpaths = true;
+    EXPECT_TRUE(canRegenerateIncrementally(params));
+
+    params.gcodeExportPath = "paths.nc";
+    EXPECT_FALSE(canRegenerateIncrementally(params));
+    params.gcodeExportPath.clear();
+    params.generateVisualization = true;
+    EXPECT_FALSE(canRegenerateIncrementally(params));
+    params.generateVisualization = false;
+    params.toolpathSketchPathLimit = 500;
+    EXPECT_FALSE(canRegenerateIncrementally(params));
+    params.toolpathSketchPathLimit = 0;
+    params.outputToBaseFeature = true;
+    EXPECT_FALSE(canRegenerateIncrementally(params));
+    params.outputToBaseFeature = false;
+    params.incrementalRegeneration = false;
+    EXPECT_FALSE(canRegenerateIncrementally(params));
+}
+
+TEST(IncrementalRegenerationTest, ProgressivePassesKeepWhatTheOtherPassWrote) {
+    MedialAxisParameters params;
+    params.generateVCarveToolpaths = true;
+    params.incrementalRegeneration = true;
+    params.progressiveRefinement = true;
+    EXPECT_TRUE(canRefineProgressively(params));
+    params.incrementalRegeneration = false;  // Implied by the progressive run
+    EXPECT_TRUE(canRefineProgressively(params));
+    params.incrementalRegeneration = true;
+
+    MedialAxisParameters coarse = coarseToolpathParameters(params);
+    EXPECT_GT(coarse.polygonTolerance, params.polygonTolerance);
+    EXPECT_GT(coarse.samplingDistance, params.samplingDistance);
+    EXPECT_FALSE(coarse.adaptiveSampling);
+
+    IWorkspace::TransformParams transform;
+    std::vector<std::vector<Point2D>> profiles;
+    for (int i = 0; i < 3; ++i) {
+        std::vector<Point2D> profile = square();
+        for (auto& vertex : profile) {
+            vertex.x += 3.0 * i;
+        }
+        profiles.push_back(profile);
+    }
+
+    // A refinement batch of one replaces the first coarse profile; the others keep their coarse tags
+    GenerationJob refine;
+    refine.params = params;
+    refine.incremental.enabled = true;
+    refine.incremental.pass = ProgressivePass::REFINE;
+    refine.incremental.otherPassParams = coarse;
+    refine.incremental.refineLimit = 1;
+    for (const auto& profile : profiles) {
+        refine.incremental.existingTags.insert(profileToolpathTag(profile, {}, transform, coarse));
+    }
+    int admitted = 0;
+    for (const auto& profile : profiles) {
+        admitted += admitIncrementalProfile(refine, profile, {}, transform, "") ? 1 : 0;
+    }
+    EXPECT_EQ(admitted, 1);
+    EXPECT_EQ(refine.incremental.coarseProfiles, 2u);
+    EXPECT_EQ(refine.incremental.keptTags.count(profileToolpathTag(profiles[0], {}, transform, coarse)), 0u);
+    EXPECT_EQ(refine.incremental.keptTags.count(profileToolpathTag(profiles[2], {}, transform, coarse)), 1u);
+
+    // A coarse pass over a sketch already refined keeps the exact toolpaths
+    GenerationJob rerun;
+    rerun.params = coarse;
+    rerun.incremental.enabled = true;
+    rerun.incremental.pass = ProgressivePass::COARSE;
+    rerun.incremental.otherPassParams = params;
+    rerun.incremental.existingTags.insert(profileToolpathTag(profiles[0], {}, transform, params));
+    admitted = 0;
+    for (const auto& profile : profiles) {
+        admitted += admitIncrementalProfile(rerun, profile, {}, transform, "") ? 1 : 0;
+    }
+    EXPECT_EQ(admitted, 2);
+    EXPECT_EQ(rerun.incremental.coarseProfiles, 2u);
+    EXPECT_EQ(rerun.incremental.keptTags.count(profileToolpathTag(profiles[0], {}, transform, params)), 1u);
+}
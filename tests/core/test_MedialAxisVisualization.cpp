@@ -0,0 +1,107 @@
+/**
+ * test_MedialAxisVisualization.cpp
+ *
+ * Unit tests for the custom graphics buffers of the medial axis visualization
+ */
+
+#include <gtest/gtest.h>
+
+#include <vector>
+
+#include "../adapters/MockCustomGraphics.h"
+#include "core/MedialAxisVisualization.h"
+
+using namespace ChipCarving::Core;
+using namespace ChipCarving::Geometry;
+
+namespace {
+
+MedialAxisResults twoChainResults() {
+    MedialAxisResults results;
+    results.success = true;
+    results.chains.addChain({Point2D(1.0, 1.0), Point2D(2.0, 1.0), Point2D(3.0, 1.5)}, {0.5, 0.8, 0.0});
+    results.chains.addChain({Point2D(2.0, 1.0), Point2D(2.0, 2.0)}, {0.8, 0.3});
+    return results;
+}
+
+}  // namespace
+
+TEST(MedialAxisVisualizationTest, BuffersFollowTheDisplayOptions) {
+    MedialAxisProcessor processor;
+    MedialAxisParameters params;
+    params.showPolygonizedShape = true;
+    std::vector<Point2D> polygon = {Point2D(0, 0), Point2D(4, 0), Point2D(4, 3), Point2D(0, 3)};
+
+    VisualizationBuffers buffers = buildVisualizationBuffers(processor, twoChainResults(), params, 1.5, polygon);
+
+    // A circle per vertex with clearance and two cross strokes per vertex
+    EXPECT_EQ(buffers.centers.size(), 5u);
+    EXPECT_EQ(buffers.clearance.size(), 4u + 2u * 5u);
+    const auto& circle = buffers.clearance.front();
+    ASSERT_GT(circle.size(), 2u);
+    EXPECT_NEAR(circle.front().x, circle.back().x, 1e-12);
+    EXPECT_NEAR(circle.front().y, circle.back().y, 1e-12);
+    EXPECT_NEAR(circle.front().x, 1.5, 1e-12);  // Center (1, 1), clearance 0.5
+
+    // The outline is closed and everything lies on the sketch plane
+    ASSERT_EQ(buffers.outline.size(), 1u);
+    EXPECT_EQ(buffers.outline[0].size(), polygon.size() + 1);
+    for (const auto& strip : buffers.clearance) {
+        for (const auto& point : strip) {
+            EXPECT_DOUBLE_EQ(point.z, 1.5);
+        }
+    }
+
+    params.showClearanceCircles = false;
+    params.showPolygonizedShape = false;
+    buffers = buildVisualizationBuffers(processor, twoChainResults(), params, 1.5, polygon);
+    EXPECT_TRUE(buffers.clearance.empty());
+    EXPECT_TRUE(buffers.centers.empty());
+    EXPECT_TRUE(buffers.outline.empty());
+
+    MedialAxisResults failed;
+    buffers = buildVisualizationBuffers(processor, failed, params, 1.5, polygon);
+    EXPECT_TRUE(buffers.medialLines.empty());
+}
+
+TEST(MedialAxisVisualizationTest, DrawsTheVCarveStageSamplesWhenGiven) {
+    MedialAxisProcessor processor;
+    MedialAxisParameters params;
+    params.showClearanceCircles = false;
+    std::vector<Point2D> polygon;
+    MedialAxisResults results = twoChainResults();
+
+    std::vector<SampledMedialPath> sampledPaths = processor.getSampledPaths(results, params.samplingDistance);
+    VisualizationBuffers resampled = buildVisualizationBuffers(processor, results, params, 0.0, polygon);
+    VisualizationBuffers shared = buildVisualizationBuffers(processor, results, params, 0.0, polygon, &sampledPaths);
+    ASSERT_EQ(shared.medialLines.size(), resampled.medialLines.size());
+    ASSERT_GT(sampledPaths[0].points.size(), 2u);
+    for (size_t i = 0; i < shared.medialLines.size(); ++i) {
+        EXPECT_EQ(shared.medialLines[i].size(), resampled.medialLines[i].size());
+    }
+
+    // The given samples are drawn as they are
+    sampledPaths.resize(1);
+    sampledPaths[0].points.erase(sampledPaths[0].points.begin() + 2, sampledPaths[0].points.end());
+    shared = buildVisualizationBuffers(processor, results, params, 0.0, polygon, &sampledPaths);
+    ASSERT_EQ(shared.medialLines.size(), 1u);
+    EXPECT_EQ(shared.medialLines[0].size(), 2u);
+}
+
+TEST(MedialAxisVisualizationTest, UploadsOneBufferPerRole) {
+    VisualizationBuffers buffers;
+    buffers.clearance.push_back({Point3D(0, 0, 0), Point3D(1, 0, 0)});
+    buffers.centers.emplace_back(0, 0, 0);
+    buffers.outline.push_back({Point3D(0, 0, 0), Point3D(1, 1, 0), Point3D(0, 0, 0)});
+
+    auto group = std::make_shared<MockCustomGraphicsGroup>();
+    MockCustomGraphics graphics(group);
+    uploadVisualizationBuffers(buffers, graphics);
+
+    // Empty medial lines are skipped
+    ASSERT_EQ(group->lineBuffers.size(), 2u);
+    EXPECT_EQ(group->lineBuffers[0].role, ICustomGraphics::Role::CLEARANCE);
+    EXPECT_EQ(group->lineBuffers[1].role, ICustomGraphics::Role::OUTLINE);
+    ASSERT_EQ(group->pointBuffers.size(), 1u);
+    EXPECT_EQ(group->pointBuffers[0].role, ICustomGraphics::Role::CLEARANCE);
+}
@@ -63,7 +63,7 @@ TEST_F(PathGenerationTest, ClearanceRadiusProperties) {
     for (size_t i = 0; i < result.chains.size(); ++i) {
         const auto& chain = result.chains[i];
         (void)chain; // Suppress unused variable warning
-        const auto& clearances = result.clearanceRadii[i];
+        const auto& clearances = result.chains[i].clearances();
         
         for (size_t j = 0; j < clearances.size(); ++j) {
             if (clearances[j] > maxClearance) {
@@ -0,0 +1,157 @@
+/**
+ * test_PerformanceSettings.cpp
+ *
+ * Unit tests for persisted performance settings and their effect on runs
+ */
+
+#include <gtest/gtest.h>
+
+#include <filesystem>
+#include <fstream>
+#include <memory>
+#include <string>
+
+#include "../adapters/MockAdapters.h"
+#include "core/PerformanceSettings.h"
+#include "core/PluginManager.h"
+
+using namespace ChipCarving::Adapters;
+using namespace ChipCarving::Core;
+
+class PerformanceSettingsTest : public ::testing::Test {
+   protected:
+    void SetUp() override {
+        directory = std::filesystem::path(::testing::TempDir()) / "performance_settings_test";
+        std::filesystem::remove_all(directory);
+        std::filesystem::create_directories(directory);
+        filePath = (directory / "settings.json").string();
+    }
+
+    void TearDown() override {
+        std::filesystem::remove_all(directory);
+    }
+
+    void writeFile(const std::string& text) const {
+        std::ofstream out(filePath, std::ios::trunc);
+        out << text;
+    }
+
+    std::filesystem::path directory;
+    std::string filePath;
+};
+
+TEST_F(PerformanceSettingsTest, SaveAndLoadRoundTrip) {
+    PerformanceSettings settings;
+    settings.medialAxisWorkers = 6;
+    settings.medialCacheMb = 256;
+    settings.diskCacheDirectory = "C:\\Cache \"carving\"";
+    settings.diskCacheMb = 2048;
+    settings.diskCacheShared = true;
+    settings.surfaceQuery = PerformanceSettings::SurfaceQuery::HEIGHTFIELD;
+    settings.heightfieldResolution = 0.125;
+    settings.outputPolylines = true;
+    settings.writeChromeTrace = true;
+    settings.platformTrace = true;
+    ASSERT_TRUE(savePerformanceSettings(filePath, settings));
+
+    PerformanceSettings loaded;
+    ASSERT_TRUE(loadPerformanceSettings(filePath, loaded));
+    EXPECT_EQ(loaded.medialAxisWorkers, 6);
+    EXPECT_EQ(loaded.medialCacheMb, 256);
+    EXPECT_EQ(loaded.diskCacheDirectory, settings.diskCacheDirectory);
+    EXPECT_EQ(loaded.diskCacheMb, 2048);
+    EXPECT_TRUE(loaded.diskCacheShared);
+    EXPECT_EQ(loaded.surfaceQuery, PerformanceSettings::SurfaceQuery::HEIGHTFIELD);
+    EXPECT_DOUBLE_EQ(loaded.heightfieldResolution, 0.125);
+    EXPECT_TRUE(loaded.outputPolylines);
+    EXPECT_TRUE(loaded.writeChromeTrace);
+    EXPECT_TRUE(loaded.platformTrace);
+}
+
+TEST_F(PerformanceSettingsTest, PartialAndDamagedFilesKeepDefaults) {
+    // Older files lack members and newer ones may add some
+    writeFile("{\"medialAxisWorkers\": 3, \"futureOption\": [1, 2], \"surfaceQuery\": \"ray\", \"diskCacheMb\": -5}");
+    PerformanceSettings settings;
+    ASSERT_TRUE(loadPerformanceSettings(filePath, settings));
+    EXPECT_EQ(settings.medialAxisWorkers, 3);
+    EXPECT_EQ(settings.surfaceQuery, PerformanceSettings::SurfaceQuery::RAY);
+    EXPECT_EQ(settings.medialCacheMb, PerformanceSettings().medialCacheMb);
+    EXPECT_EQ(settings.diskCacheMb, PerformanceSettings().diskCacheMb);
+
+    writeFile("{\"medialAxisWorkers\": 9,");
+    EXPECT_FALSE(loadPerformanceSettings(filePath, settings));
+    EXPECT_EQ(settings.medialAxisWorkers, 3);
+
+    std::filesystem::remove(filePath);
+    EXPECT_FALSE(loadPerformanceSettings(filePath, settings));
+}
+
+TEST_F(PerformanceSettingsTest, SurfaceQueryAndOutputModeReachRunParameters) {
+    PerformanceSettings settings;
+    settings.medialAxisWorkers = 2;
+    settings.heightfieldResolution = 0.75;
+
+    MedialAxisParameters params;
+    settings.applyTo(params);
+    EXPECT_EQ(params.medialAxisWorkers, 2);
+    EXPECT_TRUE(params.useFaceEvaluator);
+    EXPECT_DOUBLE_EQ(params.surfaceGridResolution, 0.0);
+    EXPECT_FALSE(params.outputPolylines);
+
+    settings.surfaceQuery = PerformanceSettings::SurfaceQuery::HEIGHTFIELD;
+    settings.outputPolylines = true;
+    settings.applyTo(params);
+    EXPECT_DOUBLE_EQ(params.surfaceGridResolution, 0.75);
+    EXPECT_TRUE(params.outputPolylines);
+
+    settings.surfaceQuery = PerformanceSettings::SurfaceQuery::RAY;
+    settings.applyTo(params);
+    EXPECT_FALSE(params.useFaceEvaluator);
+    EXPECT_DOUBLE_EQ(params.surfaceGridResolution, 0.0);
+}
+
+TEST_F(PerformanceSettingsTest, PluginManagerAppliesAndSavesSettings) {
+    writeFile("{\"medialCacheMb\": 8, \"writeChromeTrace\": true, \"diskCacheDirectory\": \"" +
+              (directory / "cache").string() + "\"}");
+
+    PluginManager manager{std::unique_ptr<IFusionFactory>(new MockFactory())};
+    ASSERT_TRUE(manager.initialize());
+    manager.setChromeTraceDirectory(directory.string());
+    manager.setPerformanceSettingsFile(filePath);
+    EXPECT_EQ(manager.getPerformanceSettings().medialCacheMb, 8);
+    EXPECT_TRUE(manager.isChromeTraceEnabled());
+    EXPECT_TRUE(std::filesystem::is_directory(directory / "cache"));
+
+    PerformanceSettings changed = manager.getPerformanceSettings();
+    changed.writeChromeTrace = false;
+    changed.medialAxisWorkers = 4;
+    ASSERT_TRUE(manager.setPerformanceSettings(changed));
+    EXPECT_FALSE(manager.isChromeTraceEnabled());
+
+    // The next session starts from what was applied
+    PerformanceSettings saved;
+    ASSERT_TRUE(loadPerformanceSettings(filePath, saved));
+    EXPECT_EQ(saved.medialAxisWorkers, 4);
+    EXPECT_EQ(saved.medialCacheMb, 8);
+    EXPECT_FALSE(saved.writeChromeTrace);
+    manager.shutdown();
+}
+
+TEST_F(PerformanceSettingsTest, SettingsFileIsReadWhenThePluginManagerInitializes) {
+    writeFile("{\"medialCacheMb\": 8, \"diskCacheDirectory\": \"" + (directory / "deferred").string() + "\"}");
+
+    // The add-in sets the file at load but creates nothing until the first command
+    auto* factory = new MockFactory();
+    PluginManager manager{std::unique_ptr<IFusionFactory>(factory)};
+    manager.setPerformanceSettingsFile(filePath);
+    EXPECT_FALSE(manager.isInitialized());
+    EXPECT_EQ(factory->getLastCreatedUI(), nullptr);
+    EXPECT_NE(manager.getPerformanceSettings().medialCacheMb, 8);
+    EXPECT_FALSE(std::filesystem::exists(directory / "deferred"));
+
+    ASSERT_TRUE(manager.initialize());
+    EXPECT_NE(factory->getLastCreatedUI(), nullptr);
+    EXPECT_EQ(manager.getPerformanceSettings().medialCacheMb, 8);
+    EXPECT_TRUE(std::filesystem::is_directory(directory / "deferred"));
+    manager.shutdown();
+}
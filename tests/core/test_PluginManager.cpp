@@ -5,12 +5,28 @@
 
 #include <gtest/gtest.h>
 
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <fstream>
 #include <memory>
+#include <set>
+#include <sstream>
+#include <string>
+#include <thread>
 
 #include "../adapters/MockAdapters.h"
+#include "../geometry/ShapeTessellation.h"
 #include "core/PluginManager.h"
+#include "core/GenerationJob.h"
+#include "core/SpeculativeMedialAxis.h"
+#include "geometry/MedialAxisCache.h"
 #include "geometry/MedialAxisProcessor.h"
 #include "geometry/Point2D.h"
+#include "geometry/ProfileCurve.h"
+#include "geometry/ShapePolygonizer.h"
+#include "utils/AllocationTracking.h"
 
 using namespace ChipCarving::Core;
 using namespace ChipCarving::Adapters;
@@ -64,6 +80,42 @@ TEST_F(PluginManagerTest, ShutdownCleansUp) {
     EXPECT_NO_THROW(pluginManager->shutdown());
 }
 
+TEST_F(PluginManagerTest, ImportRecordsStageMetrics) {
+    ASSERT_TRUE(pluginManager->initialize());
+
+    std::string designPath = ::testing::TempDir() + "plugin_manager_metrics_design.json";
+    std::string metricsPath = ::testing::TempDir() + "plugin_manager_metrics.jsonl";
+    std::remove(metricsPath.c_str());
+    {
+        std::ofstream design(designPath);
+        design << R"({"version": "2.0", "shapes": [)"
+               << R"({"type": "LEAF", "vertices": [{"x": 0, "y": 0}, {"x": 10, "y": 0}], "radius": 6.5},)"
+               << R"({"type": "LEAF", "vertices": [{"x": 0, "y": 5}, {"x": 10, "y": 5}], "radius": 6.5}]})";
+    }
+
+    pluginManager->setRunMetricsFile(metricsPath);
+    ASSERT_TRUE(pluginManager->executeImportDesign(designPath));
+
+    const auto& metrics = pluginManager->getLastRunMetrics();
+    const auto* parse = metrics.find("importDesign/parse");
+    ASSERT_NE(parse, nullptr);
+    if (ChipCarving::Utils::allocationTrackingEnabled()) {
+        EXPECT_GT(parse->allocations, 0u);
+        EXPECT_GE(metrics.find("importDesign")->allocatedBytes, parse->allocatedBytes);
+    }
+    const auto* addShape = metrics.find("importDesign/sketch/addShape");
+    ASSERT_NE(addShape, nullptr);
+    EXPECT_EQ(addShape->count, 2u);
+
+    std::ifstream metricsFile(metricsPath);
+    std::string line;
+    ASSERT_TRUE(static_cast<bool>(std::getline(metricsFile, line)));
+    EXPECT_EQ(line, metrics.toJson());
+
+    std::remove(designPath.c_str());
+    std::remove(metricsPath.c_str());
+}
+
 /**
  * Test clearance circle visualization count matches medial axis data
  * Validates that every medial axis vertex gets exactly one clearance circle
@@ -89,10 +141,8 @@ TEST_F(PluginManagerTest, ClearanceCircleCountMatchesMedialAxis) {
     };
     std::vector<double> clearances2 = {0.08, 0.25, 0.18, 0.03};
     
-    mockResults.chains.push_back(chain1);
-    mockResults.chains.push_back(chain2);
-    mockResults.clearanceRadii.push_back(clearances1);
-    mockResults.clearanceRadii.push_back(clearances2);
+    mockResults.chains.addChain(chain1, clearances1);
+    mockResults.chains.addChain(chain2, clearances2);
     
     // Get mock workspace from factory and create sketch
     auto workspacePtr = mockFactory->createWorkspace();
@@ -117,7 +167,7 @@ TEST_F(PluginManagerTest, ClearanceCircleCountMatchesMedialAxis) {
     size_t totalCirclesDrawn = 0;
     for (size_t chainIdx = 0; chainIdx < mockResults.chains.size(); ++chainIdx) {
         const auto& chain = mockResults.chains[chainIdx];
-        const auto& clearances = mockResults.clearanceRadii[chainIdx];
+        const auto& clearances = mockResults.chains[chainIdx].clearances();
         
         for (size_t i = 0; i < chain.size(); ++i) {
             // Convert from cm to mm (as done in PluginManager)
@@ -156,4 +206,1154 @@ TEST_F(PluginManagerTest, ClearanceCircleCountMatchesMedialAxis) {
         EXPECT_NEAR(mockSketch->constructionCircles[1].centerY, 15.0, 0.01);
         EXPECT_NEAR(mockSketch->constructionCircles[1].radius, 2.0, 0.01);
     }
-}
\ No newline at end of file
+}
+namespace {
+
+SketchSelection makeSquareSelection() {
+    ProfileGeometry profile;
+    profile.vertices = {{0.0, 0.0}, {2.0, 0.0}, {2.0, 2.0}, {0.0, 2.0}};
+    profile.sketchName = "Design";
+
+    SketchSelection selection;
+    selection.selectedEntityIds = {"profile-1"};
+    selection.selectedProfiles = {profile};
+    selection.closedPathCount = 1;
+    selection.isValid = true;
+    return selection;
+}
+
+}  // namespace
+
+TEST(PluginManagerBackgroundTest, BackgroundGenerationFinishesOnMainThreadPump) {
+    auto* factory = new MockFactory();
+    PluginManager manager{std::unique_ptr<IFusionFactory>(factory)};
+    ASSERT_TRUE(manager.initialize());
+    MockUserInterface* ui = factory->getLastCreatedUI();
+    MockWorkspace* workspace = factory->getLastCreatedWorkspace();
+    ASSERT_NE(ui, nullptr);
+    ASSERT_NE(workspace, nullptr);
+
+    MedialAxisParameters params;
+    params.generateVisualization = true;
+    params.visualizeAsCustomGraphics = false;  // The sketch backend looks its sketch up
+    ASSERT_TRUE(manager.startMedialAxisGeneration(makeSquareSelection(), params));
+    EXPECT_TRUE(manager.isBackgroundGenerationRunning());
+    EXPECT_TRUE(ui->progressVisible);
+    EXPECT_EQ(ui->lastProgressTitle, "Generate Paths");
+
+    // Other commands wait for the job instead of racing the worker
+    EXPECT_FALSE(manager.executeMedialAxisGeneration(makeSquareSelection(), params));
+
+    while (manager.pumpBackgroundGeneration()) {
+        std::this_thread::yield();
+    }
+
+    EXPECT_FALSE(manager.isBackgroundGenerationRunning());
+    EXPECT_FALSE(ui->progressVisible);
+    EXPECT_GT(ui->notifyMainThreadCallCount.load(), 0);
+    EXPECT_GT(workspace->findSketchCallCount, 0);
+    EXPECT_NE(manager.getLastRunMetrics().find("generatePaths/medialAxis/compute"), nullptr);
+}
+
+TEST(PluginManagerBackgroundTest, CancelledGenerationLeavesSketchesUntouched) {
+    auto* factory = new MockFactory();
+    PluginManager manager{std::unique_ptr<IFusionFactory>(factory)};
+    ASSERT_TRUE(manager.initialize());
+    MockUserInterface* ui = factory->getLastCreatedUI();
+    MockWorkspace* workspace = factory->getLastCreatedWorkspace();
+
+    MedialAxisParameters params;
+    params.generateVisualization = true;
+    ASSERT_TRUE(manager.startMedialAxisGeneration(makeSquareSelection(), params));
+    ui->mockProgressCancelled = true;
+
+    while (manager.pumpBackgroundGeneration()) {
+        std::this_thread::yield();
+    }
+
+    EXPECT_FALSE(ui->progressVisible);
+    EXPECT_EQ(workspace->findSketchCallCount, 0);
+    EXPECT_EQ(workspace->createSketchOnPlaneCallCount, 0);
+    EXPECT_EQ(workspace->createSketchCallCount, 0);
+}
+
+namespace {
+
+std::string readFile(const std::string& path) {
+    std::ifstream in(path);
+    std::stringstream contents;
+    contents << in.rdbuf();
+    return contents.str();
+}
+
+// Imports three leaves and selects their tessellated profiles (cm), so the
+// analytic medial axis gives real toolpaths without OpenVoronoi
+SketchSelection importLeafRow(PluginManager& manager, const std::string& designPath) {
+    {
+        std::ofstream design(designPath);
+        design << R"({"version": "2.0", "shapes": [)";
+        for (int i = 0; i < 3; ++i) {
+            design << (i > 0 ? "," : "") << R"({"type": "LEAF", "vertices": [{"x": )" << i * 20
+                   << R"(, "y": 0}, {"x": )" << i * 20 + 10 << R"(, "y": 0}], "radius": 6.5})";
+        }
+        design << "]}";
+    }
+    EXPECT_TRUE(manager.executeImportDesign(designPath));
+    std::remove(designPath.c_str());
+
+    SketchSelection selection;
+    for (int i = 0; i < 3; ++i) {
+        Leaf leaf(Point2D(i * 20.0, 0.0), Point2D(i * 20.0 + 10.0, 0.0), 6.5);
+        ProfileGeometry profile;
+        for (const auto& point : ChipCarving::Testing::tessellateLeaf(leaf)) {
+            profile.vertices.emplace_back(point.x * 0.1, point.y * 0.1);
+        }
+        selection.selectedEntityIds.push_back("profile-" + std::to_string(i));
+        selection.selectedProfiles.push_back(profile);
+    }
+    selection.closedPathCount = 3;
+    selection.isValid = true;
+    return selection;
+}
+
+}  // namespace
+
+TEST(PluginManagerPipelineTest, PipelinedGcodeMatchesStagedGeneration) {
+    auto* factory = new MockFactory();
+    PluginManager manager{std::unique_ptr<IFusionFactory>(factory)};
+    ASSERT_TRUE(manager.initialize());
+    SketchSelection selection = importLeafRow(manager, ::testing::TempDir() + "pipeline_leaf_row.json");
+
+    MedialAxisParameters params;
+    params.generateVCarveToolpaths = true;
+    params.medialAxisWorkers = 2;
+    params.gcodeSkipSketch = true;
+
+    // Synchronous generation runs the extract / compute / write pipeline
+    params.gcodeExportPath = ::testing::TempDir() + "pipeline_paths.nc";
+    ASSERT_TRUE(manager.executeMedialAxisGeneration(selection, params));
+    const auto& metrics = manager.getLastRunMetrics();
+    ASSERT_NE(metrics.find("generatePaths/extractProfiles"), nullptr);
+    EXPECT_EQ(metrics.find("generatePaths/extractProfiles")->count, 3u);
+    ASSERT_NE(metrics.find("generatePaths/write"), nullptr);
+    EXPECT_EQ(metrics.find("generatePaths/write")->count, 3u);
+    EXPECT_NE(metrics.find("generatePaths/write/vcarve"), nullptr);
+    std::string pipelined = readFile(params.gcodeExportPath);
+    EXPECT_EQ(manager.getLastRunReport().profiles, 3u);
+    MockUserInterface* ui = factory->getLastCreatedUI();
+    EXPECT_EQ(ui->showRunReportCallCount, 1);
+    EXPECT_NE(ui->lastRunReport.find("Run report: 3 profiles"), std::string::npos) << ui->lastRunReport;
+
+    // Background generation still computes every profile before writing any
+    params.gcodeExportPath = ::testing::TempDir() + "staged_paths.nc";
+    ASSERT_TRUE(manager.startMedialAxisGeneration(selection, params));
+    while (manager.pumpBackgroundGeneration()) {
+        std::this_thread::yield();
+    }
+    std::string staged = readFile(params.gcodeExportPath);
+    EXPECT_EQ(manager.getLastRunReport().profiles, 3u);  // Not added to the previous run's
+    EXPECT_EQ(ui->showRunReportCallCount, 2);
+
+    EXPECT_NE(pipelined.find("G1 "), std::string::npos);
+    EXPECT_EQ(pipelined, staged);
+    std::remove((::testing::TempDir() + "pipeline_paths.nc").c_str());
+    std::remove(params.gcodeExportPath.c_str());
+}
+
+TEST(PluginManagerPipelineTest, StreamingWritesTheSameToolpaths) {
+    auto* factory = new MockFactory();
+    PluginManager manager{std::unique_ptr<IFusionFactory>(factory)};
+    ASSERT_TRUE(manager.initialize());
+    SketchSelection selection = importLeafRow(manager, ::testing::TempDir() + "pipeline_stream_row.json");
+
+    // Identical leaves: the first one's medial axis must outlive its write for the copies
+    MedialAxisParameters params;
+    params.generateVCarveToolpaths = true;
+    params.medialAxisWorkers = 1;
+    params.gcodeSkipSketch = true;
+    params.svgExportPath = ::testing::TempDir() + "pipeline_stream.svg";
+
+    std::string outputs[2];
+    for (bool stream : {false, true}) {
+        params.streamProfiles = stream;
+        params.gcodeExportPath = ::testing::TempDir() + "pipeline_stream.nc";
+        ASSERT_TRUE(manager.executeMedialAxisGeneration(selection, params));
+        EXPECT_EQ(manager.getLastRunMetrics().find("generatePaths/write")->count, 3u);
+        outputs[stream ? 1 : 0] = readFile(params.gcodeExportPath) + readFile(params.svgExportPath);
+    }
+    EXPECT_NE(outputs[0].find("G1 "), std::string::npos);
+    EXPECT_EQ(outputs[0], outputs[1]);
+    std::remove(params.gcodeExportPath.c_str());
+    std::remove(params.svgExportPath.c_str());
+}
+
+TEST(PluginManagerPipelineTest, StrictRunsMatchAcrossWorkerCounts) {
+    auto* factory = new MockFactory();
+    PluginManager manager{std::unique_ptr<IFusionFactory>(factory)};
+    ASSERT_TRUE(manager.initialize());
+    SketchSelection selection = importLeafRow(manager, ::testing::TempDir() + "pipeline_strict_row.json");
+
+    MedialAxisParameters params;
+    params.generateVCarveToolpaths = true;
+    params.strictDeterminism = true;
+    params.gcodeSkipSketch = true;
+    params.gcodeExportPath = ::testing::TempDir() + "pipeline_strict.nc";
+    params.svgExportPath = ::testing::TempDir() + "pipeline_strict.svg";
+
+    // Byte-identical G-code and SVG, so every coordinate matches to the last bit it is written with
+    std::string outputs[2];
+    long long points[2] = {0, 0};
+    for (int run = 0; run < 2; ++run) {
+        params.medialAxisWorkers = run == 0 ? 1 : 4;
+        ASSERT_TRUE(manager.executeMedialAxisGeneration(selection, params));
+        EXPECT_EQ(manager.getLastRunMetrics().find("generatePaths/write")->count, 3u);
+        outputs[run] = readFile(params.gcodeExportPath) + readFile(params.svgExportPath);
+        points[run] = manager.getLastRunReport().points;
+    }
+    EXPECT_NE(outputs[0].find("G1 "), std::string::npos);
+    EXPECT_EQ(outputs[0], outputs[1]);
+    EXPECT_EQ(points[0], points[1]);
+    std::remove(params.gcodeExportPath.c_str());
+    std::remove(params.svgExportPath.c_str());
+}
+
+TEST(PluginManagerPipelineTest, SkippedProfilesKeepWriteOrder) {
+    auto* factory = new MockFactory();
+    PluginManager manager{std::unique_ptr<IFusionFactory>(factory)};
+    ASSERT_TRUE(manager.initialize());
+    SketchSelection selection = importLeafRow(manager, ::testing::TempDir() + "pipeline_skip_row.json");
+
+    // A degenerate profile in the middle is dropped by the extract stage
+    ProfileGeometry degenerate;
+    degenerate.vertices = {{0.0, 0.0}, {1.0, 0.0}};
+    selection.selectedProfiles.insert(selection.selectedProfiles.begin() + 1, degenerate);
+    selection.selectedEntityIds.push_back("profile-degenerate");
+
+    MockWorkspace* workspace = factory->getLastCreatedWorkspace();
+    int sketchesBefore = workspace->createSketchOnPlaneCallCount + workspace->createSketchCallCount;
+
+    MedialAxisParameters params;
+    params.generateVCarveToolpaths = true;
+    params.medialAxisWorkers = 3;
+    ASSERT_TRUE(manager.executeMedialAxisGeneration(selection, params));
+
+    const auto& metrics = manager.getLastRunMetrics();
+    EXPECT_EQ(metrics.find("generatePaths/extractProfiles")->count, 4u);
+    EXPECT_EQ(metrics.find("generatePaths/write")->count, 3u);
+
+    // One V-carve sketch, created by the first profile that produced toolpaths
+    EXPECT_EQ(workspace->createSketchOnPlaneCallCount + workspace->createSketchCallCount - sketchesBefore, 1);
+}
+
+TEST(PluginManagerPipelineTest, ReviewSvgShowsEveryProfile) {
+    auto* factory = new MockFactory();
+    PluginManager manager{std::unique_ptr<IFusionFactory>(factory)};
+    ASSERT_TRUE(manager.initialize());
+    SketchSelection selection = importLeafRow(manager, ::testing::TempDir() + "review_leaf_row.json");
+
+    MedialAxisParameters params;
+    params.generateVCarveToolpaths = true;
+    params.gcodeSkipSketch = true;
+    params.gcodeExportPath = ::testing::TempDir() + "review_paths.nc";
+    params.svgExportPath = ::testing::TempDir() + "review_paths.svg";
+    ASSERT_TRUE(manager.executeMedialAxisGeneration(selection, params));
+
+    // Three closed outlines, then colored medial axis and toolpath runs
+    std::string svg = readFile(params.svgExportPath);
+    ASSERT_FALSE(svg.empty());
+    EXPECT_EQ(svg.find("<?xml"), 0u);
+    EXPECT_EQ(svg.substr(svg.size() - 7), "</svg>\n");
+    size_t polygons = 0;
+    for (size_t pos = svg.find("<polygon"); pos != std::string::npos; pos = svg.find("<polygon", pos + 1)) {
+        ++polygons;
+    }
+    EXPECT_EQ(polygons, 3u);
+    EXPECT_NE(svg.find("<polyline"), std::string::npos);
+    std::remove(params.gcodeExportPath.c_str());
+    std::remove(params.svgExportPath.c_str());
+}
+
+TEST(PluginManagerPipelineTest, EntityLookupsShareOneSessionPerRun) {
+    auto* factory = new MockFactory();
+    PluginManager manager{std::unique_ptr<IFusionFactory>(factory)};
+    ASSERT_TRUE(manager.initialize());
+    MockWorkspace* workspace = factory->getLastCreatedWorkspace();
+
+    MedialAxisParameters params;
+    params.generateVisualization = true;
+    ASSERT_TRUE(manager.executeMedialAxisGeneration(makeSquareSelection(), params));
+    EXPECT_GT(workspace->extractPlaneCallCount, 0);
+    EXPECT_EQ(workspace->beginEntityLookupSessionCallCount, 1);
+
+    ASSERT_TRUE(manager.startMedialAxisGeneration(makeSquareSelection(), params));
+    while (manager.pumpBackgroundGeneration()) {
+        std::this_thread::yield();
+    }
+
+    // Extraction and the final writes each open a session; none is left open
+    EXPECT_EQ(workspace->beginEntityLookupSessionCallCount, 3);
+    EXPECT_EQ(workspace->entityLookupSessionDepth, 0);
+    EXPECT_EQ(workspace->lookupsOutsideSessionCount, 0);
+
+    manager.invalidateEntityLookups();
+    EXPECT_EQ(workspace->invalidateEntityLookupsCallCount, 1);
+}
+
+TEST(PluginManagerPipelineTest, EntityIdSelectionsReadOutlinesFromTheWorkspace) {
+    auto* factory = new MockFactory();
+    PluginManager manager{std::unique_ptr<IFusionFactory>(factory)};
+    ASSERT_TRUE(manager.initialize());
+    MockWorkspace* workspace = factory->getLastCreatedWorkspace();
+    workspace->mockProfileVertices = {{0.0, 0.0}, {2.0, 0.0}, {2.0, 2.0}, {0.0, 2.0}};
+
+    // Without cached geometry each profile's outline is extracted by entity ID
+    SketchSelection selection = makeSquareSelection();
+    selection.selectedProfiles.clear();
+    MedialAxisParameters params;
+    params.generateVCarveToolpaths = true;
+    ASSERT_TRUE(manager.executeMedialAxisGeneration(selection, params));
+    EXPECT_EQ(workspace->extractProfileVerticesCallCount, 1);
+    EXPECT_EQ(workspace->lastExtractedEntityId, "profile-1");
+    EXPECT_EQ(manager.getLastRunReport().profiles, 1u);
+    EXPECT_EQ(manager.getLastRunReport().vertices, 4);
+}
+
+TEST(PluginManagerPipelineTest, MultiToolRunSharesOneMedialAxisComputation) {
+    auto* factory = new MockFactory();
+    PluginManager manager{std::unique_ptr<IFusionFactory>(factory)};
+    ASSERT_TRUE(manager.initialize());
+    SketchSelection selection = importLeafRow(manager, ::testing::TempDir() + "multi_tool_leaf_row.json");
+    MockWorkspace* workspace = factory->getLastCreatedWorkspace();
+    workspace->createdSketchNames.clear();
+
+    std::vector<ToolDefinition> tools(2);
+    tools[0].toolName = "60° V-bit";
+    tools[0].toolAngle = 60.0;
+    tools[1].toolName = "90° V-bit";
+    tools[1].toolAngle = 90.0;
+
+    MedialAxisParameters params;
+    params.medialAxisWorkers = 2;
+    params.gcodeExportPath = ::testing::TempDir() + "multi_tool.nc";
+    ASSERT_TRUE(manager.executeMultiToolGeneration(selection, params, tools));
+
+    const auto& metrics = manager.getLastRunMetrics();
+    ASSERT_NE(metrics.find("generatePaths/medialAxis"), nullptr);
+    EXPECT_EQ(metrics.find("generatePaths/medialAxis")->count, 1u);
+    EXPECT_EQ(metrics.find("generatePaths/extractProfiles")->count, 1u);
+
+    // One toolpath sketch and one G-code file per tool
+    std::vector<std::string> expected = {"V-Carve Toolpaths - 60° V-bit", "V-Carve Toolpaths - 90° V-bit"};
+    EXPECT_EQ(workspace->createdSketchNames, expected);
+    std::string narrow = readFile(::testing::TempDir() + "multi_tool-60_V-bit.nc");
+    std::string wide = readFile(::testing::TempDir() + "multi_tool-90_V-bit.nc");
+    EXPECT_NE(narrow.find("G1 "), std::string::npos);
+    EXPECT_NE(wide.find("G1 "), std::string::npos);
+    EXPECT_NE(narrow, wide);  // A narrower bit cuts deeper for the same clearance
+    std::remove((::testing::TempDir() + "multi_tool-60_V-bit.nc").c_str());
+    std::remove((::testing::TempDir() + "multi_tool-90_V-bit.nc").c_str());
+
+    EXPECT_FALSE(manager.executeMultiToolGeneration(selection, params, {}));
+}
+
+TEST(PluginManagerPipelineTest, SelectionsGroupByPlaneAndComponent) {
+    SketchSelection selection;
+    const char* targets[][3] = {{"plane-a", "root", "Top"},
+                                {"plane-b", "root", "Side"},
+                                {"plane-a", "root", "Top"},
+                                {"plane-a", "lid", "Top"}};
+    for (int i = 0; i < 4; ++i) {
+        ProfileGeometry profile;
+        profile.planeEntityId = targets[i][0];
+        profile.componentEntityId = targets[i][1];
+        profile.sketchName = targets[i][2];
+        selection.selectedProfiles.push_back(profile);
+        selection.selectedEntityIds.push_back("profile-" + std::to_string(i));
+    }
+    selection.closedPathCount = 4;
+    selection.isValid = true;
+
+    std::vector<SketchSelection> groups = groupSelectionByOutput(selection);
+    ASSERT_EQ(groups.size(), 3u);
+    EXPECT_EQ(groups[0].selectedEntityIds, (std::vector<std::string>{"profile-0", "profile-2"}));
+    EXPECT_EQ(groups[0].closedPathCount, 2);
+    EXPECT_EQ(groups[1].selectedEntityIds, std::vector<std::string>{"profile-1"});
+    EXPECT_EQ(groups[2].selectedEntityIds, std::vector<std::string>{"profile-3"});
+    EXPECT_TRUE(groups[2].isValid);
+
+    // Entity IDs alone carry no plane to group by
+    selection.selectedProfiles.clear();
+    EXPECT_EQ(groupSelectionByOutput(selection).size(), 1u);
+}
+
+TEST(PluginManagerPipelineTest, BatchRunComputesAllGroupsAndWritesASketchPerGroup) {
+    auto* factory = new MockFactory();
+    PluginManager manager{std::unique_ptr<IFusionFactory>(factory)};
+    ASSERT_TRUE(manager.initialize());
+    SketchSelection selection = importLeafRow(manager, ::testing::TempDir() + "batch_leaf_row.json");
+    MockWorkspace* workspace = factory->getLastCreatedWorkspace();
+    workspace->createdSketchNames.clear();
+    workspace->extractPlaneCallCount = 0;
+    for (size_t i = 0; i < selection.selectedProfiles.size(); ++i) {
+        selection.selectedProfiles[i].planeEntityId = i == 1 ? "plane-side" : "plane-top";
+        selection.selectedProfiles[i].sketchName = i == 1 ? "Side" : "Top";
+    }
+
+    MedialAxisParameters params;
+    params.generateVCarveToolpaths = true;
+    params.medialAxisWorkers = 2;
+    params.gcodeExportPath = ::testing::TempDir() + "batch.nc";
+    ASSERT_TRUE(manager.executeMedialAxisGeneration(selection, params));
+
+    // One extraction per group, one medial axis pass for all of them
+    const auto& metrics = manager.getLastRunMetrics();
+    EXPECT_EQ(metrics.find("generatePaths/medialAxis")->count, 1u);
+    EXPECT_EQ(metrics.find("generatePaths/extractProfiles")->count, 2u);
+    EXPECT_EQ(workspace->extractPlaneCallCount, 2);
+    EXPECT_EQ(workspace->lastExtractedPlaneProfileId, "profile-1");
+    EXPECT_EQ(workspace->lookupsOutsideSessionCount, 0);
+
+    std::vector<std::string> expected = {"V-Carve Toolpaths - " + params.toolName + " - Top",
+                                         "V-Carve Toolpaths - " + params.toolName + " - Side"};
+    EXPECT_EQ(workspace->createdSketchNames, expected);
+    std::string top = readFile(::testing::TempDir() + "batch-Top.nc");
+    std::string side = readFile(::testing::TempDir() + "batch-Side.nc");
+    EXPECT_NE(top.find("G1 "), std::string::npos);
+    EXPECT_NE(side.find("G1 "), std::string::npos);
+    EXPECT_GT(top.size(), side.size());  // Two leaves against one
+    std::remove((::testing::TempDir() + "batch-Top.nc").c_str());
+    std::remove((::testing::TempDir() + "batch-Side.nc").c_str());
+}
+
+TEST(PluginManagerPipelineTest, CompactToolpathStorageWritesTheSamePaths) {
+    auto* factory = new MockFactory();
+    PluginManager manager{std::unique_ptr<IFusionFactory>(factory)};
+    ASSERT_TRUE(manager.initialize());
+    SketchSelection selection = importLeafRow(manager, ::testing::TempDir() + "compact_leaf_row.json");
+
+    std::vector<ToolDefinition> tools(1);
+    tools[0].toolName = "60° V-bit";
+    tools[0].toolAngle = 60.0;
+
+    MedialAxisParameters params;
+    params.medialAxisWorkers = 1;
+    params.gcodeSkipSketch = true;
+    params.gcodeExportPath = ::testing::TempDir() + "compact.nc";
+    std::string outputs[2];
+    for (bool compact : {false, true}) {
+        params.compactToolpathStorage = compact;
+        ASSERT_TRUE(manager.executeMultiToolGeneration(selection, params, tools));
+        outputs[compact ? 1 : 0] = readFile(params.gcodeExportPath);
+    }
+    EXPECT_NE(outputs[0].find("G1 "), std::string::npos);
+
+    // Float32 offsets only move coordinates far below the G-code's printed precision
+    EXPECT_EQ(std::count(outputs[0].begin(), outputs[0].end(), '\n'),
+              std::count(outputs[1].begin(), outputs[1].end(), '\n'));
+    EXPECT_EQ(outputs[0], outputs[1]);
+    std::remove(params.gcodeExportPath.c_str());
+}
+
+TEST(PluginManagerPipelineTest, ToolpathsShardAcrossSketchesByPathLimit) {
+    auto* factory = new MockFactory();
+    PluginManager manager{std::unique_ptr<IFusionFactory>(factory)};
+    ASSERT_TRUE(manager.initialize());
+    SketchSelection selection = importLeafRow(manager, ::testing::TempDir() + "sharded_leaf_row.json");
+    MockWorkspace* workspace = factory->getLastCreatedWorkspace();
+
+    MedialAxisParameters params;
+    params.generateVCarveToolpaths = true;
+    workspace->createdSketchNames.clear();
+    *workspace->sketchCurvePointCount = 0;
+    ASSERT_TRUE(manager.executeMedialAxisGeneration(selection, params));
+    const std::string sketchName = "V-Carve Toolpaths - " + params.toolName;
+    EXPECT_EQ(workspace->createdSketchNames, std::vector<std::string>{sketchName});
+    size_t unshardedPoints = *workspace->sketchCurvePointCount;
+    ASSERT_GT(unshardedPoints, 0u);
+
+    // Every leaf fills its sketch, so each later leaf starts the next one
+    params.toolpathSketchPathLimit = 1;
+    workspace->createdSketchNames.clear();
+    *workspace->sketchCurvePointCount = 0;
+    ASSERT_TRUE(manager.executeMedialAxisGeneration(selection, params));
+    std::vector<std::string> expected = {sketchName, sketchName + " (2)", sketchName + " (3)"};
+    EXPECT_EQ(workspace->createdSketchNames, expected);
+    EXPECT_EQ(*workspace->sketchCurvePointCount, unshardedPoints);
+
+    // A limit no sketch reaches leaves the single sketch
+    params.toolpathSketchPathLimit = 100000;
+    workspace->createdSketchNames.clear();
+    ASSERT_TRUE(manager.executeMedialAxisGeneration(selection, params));
+    EXPECT_EQ(workspace->createdSketchNames, std::vector<std::string>{sketchName});
+}
+
+TEST(PluginManagerPipelineTest, FewerShardsDeleteTheEarlierRunsLaterSketches) {
+    auto* factory = new MockFactory();
+    PluginManager manager{std::unique_ptr<IFusionFactory>(factory)};
+    ASSERT_TRUE(manager.initialize());
+    SketchSelection selection = importLeafRow(manager, ::testing::TempDir() + "shrinking_leaf_row.json");
+    MockWorkspace* workspace = factory->getLastCreatedWorkspace();
+
+    MedialAxisParameters params;
+    params.generateVCarveToolpaths = true;
+    params.toolpathSketchPathLimit = 1;
+    const std::string sketchName = "V-Carve Toolpaths - " + params.toolName;
+    workspace->createdSketchNames.clear();
+    ASSERT_TRUE(manager.executeMedialAxisGeneration(selection, params));
+    ASSERT_EQ(workspace->createdSketchNames.size(), 3u);
+    EXPECT_TRUE(workspace->deletedSketchNames.empty());
+    workspace->mockSketchNames = workspace->createdSketchNames;
+
+    // Two leaves per sketch: the third sketch holds only stale toolpaths
+    params.toolpathSketchPathLimit = 2;
+    workspace->createdSketchNames.clear();
+    ASSERT_TRUE(manager.executeMedialAxisGeneration(selection, params));
+    std::vector<std::string> expected = {sketchName, sketchName + " (2)"};
+    EXPECT_EQ(workspace->createdSketchNames, expected);
+    EXPECT_EQ(workspace->deletedSketchNames, std::vector<std::string>{sketchName + " (3)"});
+
+    // Unsharded, only the first sketch is left
+    params.toolpathSketchPathLimit = 0;
+    workspace->deletedSketchNames.clear();
+    ASSERT_TRUE(manager.executeMedialAxisGeneration(selection, params));
+    EXPECT_EQ(workspace->deletedSketchNames, std::vector<std::string>{sketchName + " (2)"});
+    EXPECT_EQ(workspace->mockSketchNames, std::vector<std::string>{sketchName});
+}
+
+TEST(PluginManagerPipelineTest, TiledRunWritesEachTileAndResumesFromItsJournal) {
+    auto* factory = new MockFactory();
+    PluginManager manager{std::unique_ptr<IFusionFactory>(factory)};
+    ASSERT_TRUE(manager.initialize());
+    SketchSelection selection = importLeafRow(manager, ::testing::TempDir() + "tiled_leaf_row.json");
+    MockWorkspace* workspace = factory->getLastCreatedWorkspace();
+
+    // Leaves centred at x = 5, 25 and 45 mm fall in three 15 mm columns
+    MedialAxisParameters params;
+    params.generateVCarveToolpaths = true;
+    params.spatialTileSize = 15.0;
+    params.tileJournalPath = ::testing::TempDir() + "tiled_run.journal";
+    workspace->createdSketchNames.clear();
+    ASSERT_TRUE(manager.executeMedialAxisGeneration(selection, params));
+    ASSERT_EQ(workspace->createdSketchNames.size(), 3u);
+    for (const auto& name : workspace->createdSketchNames) {
+        EXPECT_EQ(name.rfind("V-Carve Toolpaths - " + params.toolName + " - Tile ", 0), 0u) << name;
+    }
+
+    // Every tile is journaled as finished, so resuming writes nothing
+    params.resumeTiledRun = true;
+    workspace->createdSketchNames.clear();
+    ASSERT_TRUE(manager.executeMedialAxisGeneration(selection, params));
+    EXPECT_TRUE(workspace->createdSketchNames.empty());
+
+    // A run that does not resume starts the journal over
+    params.resumeTiledRun = false;
+    ASSERT_TRUE(manager.executeMedialAxisGeneration(selection, params));
+    EXPECT_EQ(workspace->createdSketchNames.size(), 3u);
+    std::remove(params.tileJournalPath.c_str());
+}
+
+TEST(PluginManagerPipelineTest, ImportsSeveralDesignFilesIntoOneSketchEach) {
+    auto* factory = new MockFactory();
+    PluginManager manager{std::unique_ptr<IFusionFactory>(factory)};
+    ASSERT_TRUE(manager.initialize());
+    MockWorkspace* workspace = factory->getLastCreatedWorkspace();
+
+    std::vector<std::string> paths;
+    for (int f = 0; f < 3; ++f) {
+        paths.push_back(::testing::TempDir() + "batch_import_" + std::to_string(f) + ".json");
+        std::ofstream design(paths.back());
+        design << R"({"version": "2.0", "shapes": [)";
+        for (int i = 0; i <= f; ++i) {
+            design << (i > 0 ? "," : "") << R"({"type": "LEAF", "vertices": [{"x": )" << i * 20
+                   << R"(, "y": 0}, {"x": )" << i * 20 + 10 << R"(, "y": 0}], "radius": 6.5})";
+        }
+        design << "]}";
+    }
+
+    workspace->createdSketchNames.clear();
+    ASSERT_TRUE(manager.executeImportDesigns(paths, "plane-1"));
+    std::vector<std::string> expected = {"Imported Design - batch_import_0", "Imported Design - batch_import_1",
+                                         "Imported Design - batch_import_2"};
+    EXPECT_EQ(workspace->createdSketchNames, expected);
+    EXPECT_EQ(workspace->createSketchOnPlaneCallCount, 3);
+    EXPECT_EQ(workspace->lastPlaneEntityId, "plane-1");
+    EXPECT_EQ(workspace->lastCreatedSketch->beginBulkEditCallCount, 1);
+    EXPECT_TRUE(manager.hasImportedShapes());
+    EXPECT_EQ(manager.getLastRunMetrics().find("importDesign/sketch")->count, 3u);
+    EXPECT_EQ(manager.getLastRunMetrics().find("importDesign/sketch/addShape")->count, 6u);
+
+    // One unreadable file fails the whole import before any sketch is made
+    std::string badPath = ::testing::TempDir() + "batch_import_bad.json";
+    {
+        std::ofstream design(badPath);
+        design << R"({"version": "1.0", "shapes": []})";
+    }
+    workspace->createdSketchNames.clear();
+    EXPECT_FALSE(manager.executeImportDesigns({paths[0], badPath}));
+    EXPECT_TRUE(workspace->createdSketchNames.empty());
+    EXPECT_NE(factory->getLastCreatedUI()->lastMessageBoxMessage.find("batch_import_bad.json"), std::string::npos);
+    EXPECT_TRUE(manager.hasImportedShapes());
+
+    for (const auto& path : paths) {
+        std::remove(path.c_str());
+    }
+    std::remove(badPath.c_str());
+}
+
+TEST(PluginManagerPipelineTest, ReimportRedrawsOnlyChangedShapes) {
+    auto* factory = new MockFactory();
+    PluginManager manager{std::unique_ptr<IFusionFactory>(factory)};
+    ASSERT_TRUE(manager.initialize());
+    MockWorkspace* workspace = factory->getLastCreatedWorkspace();
+    workspace->keepSketchCurveTags = true;
+
+    std::string path = ::testing::TempDir() + "reimport_design.json";
+    auto writeDesign = [&](double lastRadius) {
+        std::ofstream design(path, std::ios::trunc);
+        design << R"({"version": "2.0", "shapes": [)";
+        for (int i = 0; i < 3; ++i) {
+            design << (i > 0 ? "," : "") << R"({"type": "LEAF", "vertices": [{"x": )" << i * 20
+                   << R"(, "y": 0}, {"x": )" << i * 20 + 10 << R"(, "y": 0}], "radius": )"
+                   << (i == 2 ? lastRadius : 6.5) << "}";
+        }
+        design << "]}";
+    };
+
+    // Curve tags of the sketch, one per curve, kept across the sketches of that name
+    auto sketchTags = [&]() { return *workspace->keptCurveTags["Imported Design"]; };
+    auto distinct = [](std::vector<std::string> tags) {
+        std::sort(tags.begin(), tags.end());
+        tags.erase(std::unique(tags.begin(), tags.end()), tags.end());
+        return tags;
+    };
+
+    writeDesign(6.5);
+    ASSERT_TRUE(manager.executeImportDesigns({path}, "plane-1", true));
+    EXPECT_EQ(workspace->createSketchOnPlaneCallCount, 1);
+    std::vector<std::string> firstTags = sketchTags();
+    ASSERT_EQ(distinct(firstTags).size(), 3u);
+    EXPECT_EQ(firstTags.size(), 6u);
+
+    // Editing one shape redraws just that shape in the earlier sketch
+    writeDesign(7.5);
+    ASSERT_TRUE(manager.executeImportDesigns({path}, "plane-1", true));
+    EXPECT_EQ(workspace->createSketchOnPlaneCallCount, 1);
+    EXPECT_EQ(workspace->lastFindSketchName, "Imported Design");
+    std::vector<std::string> secondTags = sketchTags();
+    EXPECT_EQ(secondTags.size(), 6u);
+    EXPECT_EQ(std::vector<std::string>(secondTags.begin(), secondTags.begin() + 4),
+              std::vector<std::string>(firstTags.begin(), firstTags.begin() + 4));
+    EXPECT_NE(secondTags[5], firstTags[5]);
+    EXPECT_EQ(distinct(secondTags).size(), 3u);
+
+    // An unchanged file draws nothing; another plane or a plain import makes a new sketch
+    ASSERT_TRUE(manager.executeImportDesigns({path}, "plane-1", true));
+    EXPECT_EQ(sketchTags(), secondTags);
+    ASSERT_TRUE(manager.executeImportDesigns({path}, "plane-2", true));
+    EXPECT_EQ(workspace->createSketchOnPlaneCallCount, 2);
+    ASSERT_TRUE(manager.executeImportDesigns({path}, "plane-2"));
+    EXPECT_EQ(workspace->createSketchOnPlaneCallCount, 3);
+
+    std::remove(path.c_str());
+}
+
+TEST(PluginManagerPipelineTest, ExactProfileCurvesArePolygonizedAtPolygonTolerance) {
+    auto* factory = new MockFactory();
+    PluginManager manager{std::unique_ptr<IFusionFactory>(factory)};
+    ASSERT_TRUE(manager.initialize());
+    MockWorkspace* workspace = factory->getLastCreatedWorkspace();
+
+    // A round profile with a square hole, as exact curves the way the dialog caches them
+    SketchSelection selection = makeSquareSelection();
+    ProfileGeometry& profile = selection.selectedProfiles[0];
+    profile.vertices.clear();
+    profile.curves = {makeArcCurve(Point2D(1, 1), 2.0, 0.0, 2.0 * M_PI)};
+    profile.holeCurves = {{makeLineCurve(Point2D(0.5, 0.5), Point2D(1.5, 0.5)),
+                           makeLineCurve(Point2D(1.5, 1.5), Point2D(1.5, 0.5)),
+                           makeLineCurve(Point2D(1.5, 1.5), Point2D(0.5, 1.5)),
+                           makeLineCurve(Point2D(0.5, 1.5), Point2D(0.5, 0.5))}};
+    profile.holeCurves[0][1].reversed = true;
+
+    // The drawn outline is the polygon the medial axis was computed from
+    MedialAxisParameters params;
+    params.generateVisualization = true;
+    params.showPolygonizedShape = true;
+    size_t previous = 0;
+    for (double polygonTolerance : {0.01, 0.25}) {
+        params.polygonTolerance = polygonTolerance;
+        workspace->customGraphicsGroups.clear();
+        ASSERT_TRUE(manager.executeMedialAxisGeneration(selection, params));
+        const auto& group = *workspace->customGraphicsGroups["Medial Axis - " + params.toolName];
+        auto outline = std::find_if(group.lineBuffers.begin(), group.lineBuffers.end(),
+                                    [](const auto& buffer) { return buffer.role == ICustomGraphics::Role::OUTLINE; });
+        ASSERT_NE(outline, group.lineBuffers.end());
+        ASSERT_EQ(outline->strips.size(), 1u);
+        // Closed strip: one chord per vertex
+        size_t vertices = outline->strips[0].size() - 1;
+        EXPECT_EQ(vertices, static_cast<size_t>(arcSegmentCount(2.0, 2.0 * M_PI, polygonTolerance * 0.1)));
+        if (previous > 0) {
+            EXPECT_LT(vertices, previous);
+        }
+        previous = vertices;
+    }
+}
+
+TEST(PluginManagerPipelineTest, OutputSketchesShareOneOutputSession) {
+    auto* factory = new MockFactory();
+    PluginManager manager{std::unique_ptr<IFusionFactory>(factory)};
+    ASSERT_TRUE(manager.initialize());
+    SketchSelection selection = importLeafRow(manager, ::testing::TempDir() + "base_feature_leaf_row.json");
+    MockWorkspace* workspace = factory->getLastCreatedWorkspace();
+    workspace->createdSketchNames.clear();
+
+    MedialAxisParameters params;
+    params.generateVCarveToolpaths = true;
+    params.generateVisualization = true;
+    params.visualizeAsCustomGraphics = false;
+    params.toolpathSketchPathLimit = 1;
+    params.outputToBaseFeature = true;
+    ASSERT_TRUE(manager.executeMedialAxisGeneration(selection, params));
+
+    // The visualization sketch and every toolpath shard are created inside one session
+    EXPECT_EQ(workspace->outputSessionNames, std::vector<std::string>{"Chip Carving - " + params.toolName});
+    EXPECT_TRUE(workspace->lastOutputSessionDirectEdit);
+    EXPECT_EQ(workspace->outputSessionDepth, 0);
+    EXPECT_GT(workspace->createdSketchNames.size(), 2u);
+    EXPECT_EQ(workspace->sketchesInOutputSession, static_cast<int>(workspace->createdSketchNames.size()));
+
+    // Parametric output still groups the run, and a run without sketches opens no session
+    workspace->outputSessionNames.clear();
+    params.outputToBaseFeature = false;
+    ASSERT_TRUE(manager.executeMedialAxisGeneration(selection, params));
+    EXPECT_EQ(workspace->outputSessionNames.size(), 1u);
+    EXPECT_FALSE(workspace->lastOutputSessionDirectEdit);
+
+    workspace->outputSessionNames.clear();
+    params.generateVCarveToolpaths = false;
+    params.generateVisualization = false;
+    ASSERT_TRUE(manager.executeMedialAxisGeneration(selection, params));
+    EXPECT_TRUE(workspace->outputSessionNames.empty());
+}
+
+TEST(PluginManagerPipelineTest, RegenerationResetsTheEarlierSketch) {
+    auto* factory = new MockFactory();
+    PluginManager manager{std::unique_ptr<IFusionFactory>(factory)};
+    ASSERT_TRUE(manager.initialize());
+    SketchSelection selection = importLeafRow(manager, ::testing::TempDir() + "reset_leaf_row.json");
+    MockWorkspace* workspace = factory->getLastCreatedWorkspace();
+    workspace->createdSketchNames.clear();
+    workspace->mockFindSketchResult = true;
+    workspace->mockResetSketchResult = true;
+
+    MedialAxisParameters params;
+    params.generateVisualization = true;
+    params.visualizeAsCustomGraphics = false;
+    ASSERT_TRUE(manager.executeMedialAxisGeneration(selection, params));
+
+    // The found sketch is emptied and written again instead of a new one being made
+    EXPECT_GT(workspace->resetSketchCallCount, 0);
+    EXPECT_GT(workspace->lastResetRecreateAbove, 0u);
+    EXPECT_TRUE(workspace->createdSketchNames.empty());
+
+    // Output into a target surface's component always gets a new sketch
+    workspace->resetSketchCallCount = 0;
+    params.targetSurfaceId = "mock_target_surface";
+    ASSERT_TRUE(manager.executeMedialAxisGeneration(selection, params));
+    EXPECT_EQ(workspace->resetSketchCallCount, 0);
+    EXPECT_GT(workspace->createSketchInTargetComponentCallCount, 0);
+}
+
+TEST(PluginManagerPipelineTest, VisualizationIsDrawnAsCustomGraphics) {
+    auto* factory = new MockFactory();
+    PluginManager manager{std::unique_ptr<IFusionFactory>(factory)};
+    ASSERT_TRUE(manager.initialize());
+    SketchSelection selection = importLeafRow(manager, ::testing::TempDir() + "graphics_leaf_row.json");
+    MockWorkspace* workspace = factory->getLastCreatedWorkspace();
+    workspace->createdSketchNames.clear();
+
+    MedialAxisParameters params;
+    params.generateVisualization = true;
+    ASSERT_TRUE(manager.executeMedialAxisGeneration(selection, params));
+
+    // One group per tool, a few buffers per profile and no construction sketch
+    EXPECT_TRUE(workspace->createdSketchNames.empty());
+    ASSERT_EQ(workspace->customGraphicsGroups.count("Medial Axis - " + params.toolName), 1u);
+    const auto& group = *workspace->customGraphicsGroups["Medial Axis - " + params.toolName];
+    EXPECT_LE(group.lineBuffers.size(), 3u * selection.selectedProfiles.size());
+    EXPECT_LE(group.pointBuffers.size(), selection.selectedProfiles.size());
+    bool drewMedialAxis = false;
+    for (const auto& buffer : group.lineBuffers) {
+        drewMedialAxis |= buffer.role == ICustomGraphics::Role::MEDIAL_AXIS && !buffer.strips.empty();
+    }
+    EXPECT_TRUE(drewMedialAxis);
+
+    // The sketch backend is still available
+    workspace->createdSketchNames.clear();
+    params.visualizeAsCustomGraphics = false;
+    ASSERT_TRUE(manager.executeMedialAxisGeneration(selection, params));
+    EXPECT_FALSE(workspace->createdSketchNames.empty());
+}
+
+TEST(PluginManagerPipelineTest, IncrementalRunRewritesOnlyChangedProfiles) {
+    auto* factory = new MockFactory();
+    PluginManager manager{std::unique_ptr<IFusionFactory>(factory)};
+    ASSERT_TRUE(manager.initialize());
+    SketchSelection selection = importLeafRow(manager, ::testing::TempDir() + "incremental_leaf_row.json");
+    MockWorkspace* workspace = factory->getLastCreatedWorkspace();
+    workspace->keepSketchCurveTags = true;
+
+    MedialAxisParameters params;
+    params.generateVCarveToolpaths = true;
+    params.incrementalRegeneration = true;
+    ASSERT_TRUE(manager.executeMedialAxisGeneration(selection, params));
+    const std::string sketchName = "V-Carve Toolpaths - " + params.toolName;
+    ASSERT_EQ(workspace->keptCurveTags.count(sketchName), 1u);
+    std::vector<std::string> firstTags = *workspace->keptCurveTags[sketchName];
+    std::set<std::string> firstRun(firstTags.begin(), firstTags.end());
+    ASSERT_EQ(firstRun.size(), 3u);
+    EXPECT_EQ(firstRun.count(""), 0u);
+
+    // Move one leaf: the earlier sketch is reused and only that leaf's curves are replaced
+    for (auto& vertex : selection.selectedProfiles[1].vertices) {
+        vertex.x += 0.5;
+    }
+    workspace->createdSketchNames.clear();
+    ASSERT_TRUE(manager.executeMedialAxisGeneration(selection, params));
+    EXPECT_TRUE(workspace->createdSketchNames.empty());
+    const auto& secondTags = *workspace->keptCurveTags[sketchName];
+    int replaced = 0;
+    for (const auto& tag : firstRun) {
+        auto count = std::count(secondTags.begin(), secondTags.end(), tag);
+        if (count == 0) {
+            ++replaced;
+        } else {
+            EXPECT_EQ(count, std::count(firstTags.begin(), firstTags.end(), tag));
+        }
+    }
+    EXPECT_EQ(replaced, 1);
+
+    // Nothing left to compute is still a successful run
+    selection.selectedProfiles.erase(selection.selectedProfiles.begin() + 1);
+    selection.selectedEntityIds.erase(selection.selectedEntityIds.begin() + 1);
+    EXPECT_TRUE(manager.executeMedialAxisGeneration(selection, params));
+}
+
+TEST(PluginManagerBackgroundTest, ProgressiveRunReplacesCoarseToolpathsBatchByBatch) {
+    auto* factory = new MockFactory();
+    PluginManager manager{std::unique_ptr<IFusionFactory>(factory)};
+    ASSERT_TRUE(manager.initialize());
+    SketchSelection selection = importLeafRow(manager, ::testing::TempDir() + "progressive_leaf_row.json");
+    MockWorkspace* workspace = factory->getLastCreatedWorkspace();
+    workspace->keepSketchCurveTags = true;
+
+    MedialAxisParameters params;
+    params.generateVCarveToolpaths = true;
+    params.progressiveRefinement = true;
+    ASSERT_TRUE(manager.startMedialAxisGeneration(selection, params));
+    ASSERT_NE(manager.getProgressiveRefinement(), nullptr);
+
+    // Every written pass leaves the sketch with one tag per leaf; the coarse ones are replaced one batch at a time
+    const std::string sketchName = "V-Carve Toolpaths - " + params.toolName;
+    std::vector<size_t> coarseAfterPass;
+    while (manager.pumpBackgroundGeneration()) {
+        const ProgressiveRefinement* refinement = manager.getProgressiveRefinement();
+        if (refinement && refinement->coarseProfiles > 0 &&
+            (coarseAfterPass.empty() || coarseAfterPass.back() != refinement->coarseProfiles)) {
+            coarseAfterPass.push_back(refinement->coarseProfiles);
+            ASSERT_EQ(workspace->keptCurveTags.count(sketchName), 1u);
+            const auto& tags = *workspace->keptCurveTags[sketchName];
+            EXPECT_EQ(std::set<std::string>(tags.begin(), tags.end()).size(), 3u);
+        }
+        std::this_thread::yield();
+    }
+    EXPECT_EQ(manager.getProgressiveRefinement(), nullptr);
+    EXPECT_EQ(coarseAfterPass, (std::vector<size_t>{3, 2, 1}));
+    std::vector<std::string> progressiveTags = *workspace->keptCurveTags[sketchName];
+
+    // The result is what an exact incremental run writes: rerunning one keeps every curve
+    params.progressiveRefinement = false;
+    params.incrementalRegeneration = true;
+    ASSERT_TRUE(manager.executeMedialAxisGeneration(selection, params));
+    EXPECT_EQ(*workspace->keptCurveTags[sketchName], progressiveTags);
+}
+
+TEST(PluginManagerPipelineTest, TimeBudgetLeavesProfilesCoarseOnlyWhenItRunsOut) {
+    auto* factory = new MockFactory();
+    PluginManager manager{std::unique_ptr<IFusionFactory>(factory)};
+    ASSERT_TRUE(manager.initialize());
+    SketchSelection selection = importLeafRow(manager, ::testing::TempDir() + "anytime_leaf_row.json");
+
+    MedialAxisParameters params;
+    params.generateVCarveToolpaths = true;
+    params.gcodeSkipSketch = true;
+    params.gcodeExportPath = ::testing::TempDir() + "anytime_paths.nc";
+    ASSERT_TRUE(manager.executeMedialAxisGeneration(selection, params));
+    std::string unbudgeted = readFile(params.gcodeExportPath);
+
+    // Ample time: every profile is exact, as without a budget
+    params.generationTimeBudget = 3600.0;
+    ASSERT_TRUE(manager.executeMedialAxisGeneration(selection, params));
+    EXPECT_TRUE(manager.getLastRunReport().reducedPrecisionProfiles.empty());
+    EXPECT_EQ(readFile(params.gcodeExportPath), unbudgeted);
+
+    // No time: nothing to resolve without OpenVoronoi, so every profile keeps its coarse toolpaths
+    params.generationTimeBudget = 1.0e-9;
+    params.useAnalyticMedialAxis = false;
+    params.useMedialAxisCache = false;
+    ASSERT_TRUE(manager.executeMedialAxisGeneration(selection, params));
+    EXPECT_EQ(manager.getLastRunReport().profiles, 3u);
+    EXPECT_EQ(manager.getLastRunReport().reducedPrecisionProfiles,
+              (std::vector<std::string>{"profile-0", "profile-1", "profile-2"}));
+    std::string coarse = readFile(params.gcodeExportPath);
+    EXPECT_NE(coarse.find("G1 "), std::string::npos);
+    EXPECT_NE(coarse, unbudgeted);
+    std::string shown = factory->getLastCreatedUI()->lastRunReport;
+    EXPECT_NE(shown.find("Reduced precision (time budget ran out): 3 profiles"), std::string::npos) << shown;
+    std::remove(params.gcodeExportPath.c_str());
+}
+
+TEST(PluginManagerWatchTest, SavedDesignUpdatesImportAndToolpathsInTheBackground) {
+    auto* factory = new MockFactory();
+    PluginManager manager{std::unique_ptr<IFusionFactory>(factory)};
+    ASSERT_TRUE(manager.initialize());
+    MockWorkspace* workspace = factory->getLastCreatedWorkspace();
+    workspace->keepSketchCurveTags = true;
+    EXPECT_FALSE(manager.setDesignWatchEnabled(true));  // Nothing imported yet
+
+    // Three leaves; the Fusion sketch's profiles are their tessellations (cm)
+    std::string path = ::testing::TempDir() + "watched_design.json";
+    auto writeDesign = [&](double middleRadius) {
+        std::ofstream design(path, std::ios::trunc);
+        design << R"({"version": "2.0", "shapes": [)";
+        for (int i = 0; i < 3; ++i) {
+            design << (i > 0 ? "," : "") << R"({"type": "LEAF", "vertices": [{"x": )" << i * 20
+                   << R"(, "y": 0}, {"x": )" << i * 20 + 10 << R"(, "y": 0}], "radius": )"
+                   << (i == 1 ? middleRadius : 6.5) << "}";
+        }
+        design << "]}";
+    };
+    auto sketchProfiles = [](double middleRadius) {
+        SketchSelection selection;
+        for (int i = 0; i < 3; ++i) {
+            Leaf leaf(Point2D(i * 20.0, 0.0), Point2D(i * 20.0 + 10.0, 0.0), i == 1 ? middleRadius : 6.5);
+            ProfileGeometry profile;
+            for (const auto& point : ChipCarving::Testing::tessellateLeaf(leaf)) {
+                profile.vertices.emplace_back(point.x * 0.1, point.y * 0.1);
+            }
+            profile.sketchName = "Imported Design";
+            selection.selectedEntityIds.push_back("profile-" + std::to_string(i));
+            selection.selectedProfiles.push_back(profile);
+        }
+        selection.closedPathCount = 3;
+        selection.isValid = true;
+        return selection;
+    };
+
+    writeDesign(6.5);
+    ASSERT_TRUE(manager.executeImportDesigns({path}, "", true));
+    MedialAxisParameters params;
+    params.generateVCarveToolpaths = true;
+    params.incrementalRegeneration = true;
+    ASSERT_TRUE(manager.executeMedialAxisGeneration(sketchProfiles(6.5), params));
+    const std::string toolpathSketch = "V-Carve Toolpaths - " + params.toolName;
+    std::vector<std::string> firstToolpathTags = *workspace->keptCurveTags[toolpathSketch];
+    std::vector<std::string> firstImportTags = *workspace->keptCurveTags["Imported Design"];
+
+    ASSERT_TRUE(manager.setDesignWatchEnabled(true, 10));
+    EXPECT_TRUE(manager.isDesignWatchEnabled());
+
+    // Saving the design changes the sketch's middle profile; the watch re-reads it without a dialog
+    workspace->mockSketchProfiles["Imported Design"] = sketchProfiles(7.25);
+    writeDesign(7.25);
+    for (int i = 0; i < 500; ++i) {
+        bool running = manager.pumpBackgroundGeneration();
+        if (!running && !workspace->sketchProfileRequests.empty()) {
+            break;
+        }
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    }
+    EXPECT_EQ(workspace->sketchProfileRequests, std::vector<std::string>{"Imported Design"});
+    EXPECT_FALSE(manager.isBackgroundGenerationRunning());
+    EXPECT_NE(*workspace->keptCurveTags["Imported Design"], firstImportTags);
+
+    // Only the middle leaf's toolpaths were replaced
+    const auto& secondToolpathTags = *workspace->keptCurveTags[toolpathSketch];
+    std::set<std::string> firstRun(firstToolpathTags.begin(), firstToolpathTags.end());
+    std::set<std::string> secondRun(secondToolpathTags.begin(), secondToolpathTags.end());
+    ASSERT_EQ(secondRun.size(), 3u);
+    int kept = 0;
+    for (const auto& tag : secondRun) {
+        kept += static_cast<int>(firstRun.count(tag));
+    }
+    EXPECT_EQ(kept, 2);
+
+    EXPECT_TRUE(manager.setDesignWatchEnabled(false));
+    EXPECT_FALSE(manager.isDesignWatchEnabled());
+    std::remove(path.c_str());
+}
+
+TEST(PluginManagerPreviewTest, PreviewDrawsGraphicsWithoutTouchingSketches) {
+    auto* factory = new MockFactory();
+    PluginManager manager{std::unique_ptr<IFusionFactory>(factory)};
+    ASSERT_TRUE(manager.initialize());
+    MockUserInterface* ui = factory->getLastCreatedUI();
+    MockWorkspace* workspace = factory->getLastCreatedWorkspace();
+    PreviewGeneration* preview = manager.getPreview();
+    ASSERT_NE(preview, nullptr);
+    preview->setDebounceMs(0);
+
+    MedialAxisParameters params;
+    params.generateVCarveToolpaths = true;
+    params.adaptiveSampling = true;
+    MedialAxisParameters coarse = PreviewGeneration::coarseParameters(params);
+    EXPECT_DOUBLE_EQ(coarse.polygonTolerance, params.polygonTolerance * PreviewGeneration::COARSENING);
+    EXPECT_DOUBLE_EQ(coarse.samplingDistance, params.samplingDistance * PreviewGeneration::COARSENING);
+    EXPECT_FALSE(coarse.adaptiveSampling);
+    EXPECT_FALSE(coarse.projectToSurface);
+
+    ASSERT_TRUE(preview->start(makeSquareSelection(), params));
+    while (preview->pump()) {
+        std::this_thread::yield();
+    }
+
+    EXPECT_EQ(workspace->createCustomGraphicsCallCount, 1);
+    ASSERT_EQ(workspace->customGraphicsGroups.count("Generate Paths Preview"), 1u);
+    const auto& buffers = workspace->customGraphicsGroups["Generate Paths Preview"]->lineBuffers;
+    ASSERT_EQ(buffers.size(), 1u);
+    EXPECT_EQ(buffers[0].role, ICustomGraphics::Role::PREVIEW);
+    EXPECT_GT(ui->notifyMainThreadCallCount.load(), 0);
+    EXPECT_EQ(workspace->findSketchCallCount, 0);
+    EXPECT_EQ(workspace->createSketchCallCount, 0);
+    EXPECT_EQ(workspace->createSketchOnPlaneCallCount, 0);
+
+    preview->clear();
+    EXPECT_TRUE(workspace->customGraphicsGroups.empty());
+
+    // Nothing to preview without cached profile geometry
+    EXPECT_FALSE(preview->start(SketchSelection(), params));
+    EXPECT_FALSE(preview->isRunning());
+}
+
+TEST(PluginManagerPreviewTest, RestartingPreviewCancelsTheStaleJob) {
+    auto* factory = new MockFactory();
+    PluginManager manager{std::unique_ptr<IFusionFactory>(factory)};
+    ASSERT_TRUE(manager.initialize());
+    MockWorkspace* workspace = factory->getLastCreatedWorkspace();
+    PreviewGeneration* preview = manager.getPreview();
+    ASSERT_NE(preview, nullptr);
+
+    // A burst of input changes inside the debounce delay computes only the last one
+    MedialAxisParameters params;
+    for (int i = 0; i < 3; ++i) {
+        params.polygonTolerance = 0.1 * (i + 1);
+        ASSERT_TRUE(preview->start(makeSquareSelection(), params));
+    }
+    while (preview->pump()) {
+        std::this_thread::yield();
+    }
+    EXPECT_EQ(workspace->createCustomGraphicsCallCount, 1);
+
+    // A preview still waiting when the dialog closes never draws
+    ASSERT_TRUE(preview->start(makeSquareSelection(), params));
+    preview->clear();
+    EXPECT_FALSE(preview->isRunning());
+    EXPECT_FALSE(preview->pump());
+    EXPECT_EQ(workspace->createCustomGraphicsCallCount, 1);
+}
+
+TEST(PluginManagerSpeculationTest, SpeculatedMedialAxesAreKeyedForTheRunsProcessor) {
+    MockUserInterface ui;
+    SpeculativeMedialAxis speculation(&ui);
+    speculation.setDebounceMs(0);
+    MedialAxisProcessor prototype(0.25, 0.8);
+    MedialAxisParameters params;
+    SketchSelection selection = makeSquareSelection();
+    ASSERT_TRUE(speculation.start(selection, params, prototype));
+    EXPECT_TRUE(speculation.isRunning());
+
+    // Generate Paths configures its own processor the same way
+    MedialAxisProcessor processor(prototype);
+    configureGenerationProcessor(processor, params);
+    std::vector<SpeculativeMedialAxis::Result> taken = speculation.take(processor);
+    ASSERT_EQ(taken.size(), 1u);
+    std::vector<Point2D> outline = cachedProfileOutline(selection.selectedProfiles[0], processor.getPolygonTolerance());
+    EXPECT_EQ(taken[0].key, MedialAxisCache::computeKey(outline, processor));
+    EXPECT_TRUE(taken[0].results.success);
+    EXPECT_FALSE(speculation.isRunning());
+    EXPECT_TRUE(speculation.take(processor).empty());
+    EXPECT_GT(ui.notifyMainThreadCallCount.load(), 0);
+}
+
+TEST(PluginManagerSpeculationTest, ChangedParametersDiscardTheSpeculation) {
+    MockUserInterface ui;
+    SpeculativeMedialAxis speculation(&ui);
+    MedialAxisProcessor prototype(0.25, 0.8);
+    MedialAxisParameters params;
+    ASSERT_TRUE(speculation.start(makeSquareSelection(), params, prototype));
+
+    // The dialog's tolerance changed after the last restart, so nothing matches
+    params.polygonTolerance *= 2.0;
+    MedialAxisProcessor processor(prototype);
+    configureGenerationProcessor(processor, params);
+    EXPECT_TRUE(speculation.take(processor).empty());
+    EXPECT_FALSE(speculation.isRunning());
+    speculation.pump();
+
+    // Only outer loops are cached, so profiles with holes are left to the run
+    SketchSelection withHole = makeSquareSelection();
+    withHole.selectedProfiles[0].holes = {{{0.5, 0.5}, {1.0, 0.5}, {1.0, 1.0}}};
+    EXPECT_FALSE(speculation.start(withHole, params, prototype));
+    EXPECT_FALSE(speculation.isRunning());
+}
+
+TEST(PluginManagerSpeculationTest, GenerationUsesOnlyPermittedSpeculation) {
+    auto* factory = new MockFactory();
+    PluginManager manager{std::unique_ptr<IFusionFactory>(factory)};
+    MedialAxisParameters params;
+    EXPECT_FALSE(manager.speculateMedialAxes(makeSquareSelection(), params));
+    ASSERT_TRUE(manager.initialize());
+
+    ASSERT_TRUE(manager.speculateMedialAxes(makeSquareSelection(), params));
+    EXPECT_TRUE(manager.executeMedialAxisGeneration(makeSquareSelection(), params));
+
+    // Nothing could take the results with the cache off
+    MedialAxisParameters uncached = params;
+    uncached.useMedialAxisCache = false;
+    EXPECT_FALSE(manager.speculateMedialAxes(makeSquareSelection(), uncached));
+
+    // A background run's worker owns the medial processor
+    ASSERT_TRUE(manager.startMedialAxisGeneration(makeSquareSelection(), params));
+    EXPECT_FALSE(manager.speculateMedialAxes(makeSquareSelection(), params));
+    while (manager.pumpBackgroundGeneration()) {
+        std::this_thread::yield();
+    }
+    EXPECT_TRUE(manager.speculateMedialAxes(makeSquareSelection(), params));
+    manager.shutdown();
+}
+
+TEST(PluginManagerSelectionTest, SelectionCountShowsAtMostOncePerInterval) {
+    auto* factory = new MockFactory();
+    PluginManager manager{std::unique_ptr<IFusionFactory>(factory)};
+    ASSERT_TRUE(manager.initialize());
+    MockUserInterface* ui = factory->getLastCreatedUI();
+    manager.setSelectionCountIntervalMs(60 * 60 * 1000);
+
+    // A window selection: the first count shows, the rest wait for the flush
+    for (int count = 1; count <= 1000; ++count) {
+        manager.reportSelectionCount(count);
+    }
+    EXPECT_EQ(ui->updateSelectionCountCallCount, 1);
+    EXPECT_EQ(ui->lastSelectionCount, 1);
+    manager.flushSelectionCount();
+    EXPECT_EQ(ui->updateSelectionCountCallCount, 2);
+    EXPECT_EQ(ui->lastSelectionCount, 1000);
+
+    // Nothing held, or the count already shown: no update
+    manager.flushSelectionCount();
+    manager.setSelectionCountIntervalMs(0);
+    manager.reportSelectionCount(1000);
+    EXPECT_EQ(ui->updateSelectionCountCallCount, 2);
+    manager.reportSelectionCount(999);
+    EXPECT_EQ(ui->updateSelectionCountCallCount, 3);
+    EXPECT_EQ(ui->lastSelectionCount, 999);
+}
@@ -0,0 +1,134 @@
+/**
+ * test_RunHistory.cpp
+ *
+ * Unit tests for the append-only run history
+ */
+
+#include <gtest/gtest.h>
+
+#include <cstdio>
+#include <fstream>
+#include <string>
+#include <vector>
+
+#include "core/RunHistory.h"
+#include "geometry/ShapeStore.h"
+
+using namespace ChipCarving::Core;
+using ChipCarving::Geometry::Leaf;
+using ChipCarving::Geometry::Point2D;
+using ChipCarving::Geometry::ShapeStore;
+
+namespace {
+
+ChipCarving::Utils::RunMetrics generationMetrics() {
+    ChipCarving::Utils::RunMetrics metrics;
+    ChipCarving::Utils::ScopedRunMetrics bound(metrics);
+    ChipCarving::Utils::TraceSpan run("generatePaths");
+    {
+        ChipCarving::Utils::TraceSpan extract("extractProfiles");
+        ChipCarving::Utils::TraceSpan deeper("fusion.profileLoops");
+    }
+    ChipCarving::Utils::TraceSpan write("write");
+    return metrics;
+}
+
+ShapeStore leaves(double offset) {
+    ShapeStore shapes;
+    shapes.add(Leaf(Point2D(0.0, 0.0), Point2D(10.0, 0.0), 6.5));
+    shapes.add(Leaf(Point2D(offset, 0.0), Point2D(offset + 10.0, 0.0), 6.5));
+    return shapes;
+}
+
+}  // namespace
+
+TEST(RunHistoryTest, GenerationLineHasVersionsCountsStagesAndCacheSettings) {
+    RunHistoryEntry entry;
+    entry.pluginVersion = "1.2.3-dev+abc1234";
+    entry.engineVersion = "19.01";
+    entry.designHash = "0123456789abcdef";
+    entry.profiles = 3;
+    entry.vertices = 120;
+    entry.points = 45;
+    entry.generation = true;
+    entry.threads = 4;
+    entry.analyticMedialAxis = true;
+    entry.memoryCache = true;
+    entry.memoryCacheHits = 2;
+
+    std::string json = runHistoryJson(entry, generationMetrics());
+    EXPECT_EQ(json.find('\n'), std::string::npos);
+    EXPECT_NE(json.find("\"command\":\"generatePaths\""), std::string::npos) << json;
+    EXPECT_NE(json.find("\"pluginVersion\":\"1.2.3-dev+abc1234\",\"engineVersion\":\"19.01\""), std::string::npos)
+        << json;
+    EXPECT_NE(json.find("\"designHash\":\"0123456789abcdef\""), std::string::npos) << json;
+    EXPECT_NE(json.find("\"profiles\":3,\"vertices\":120,\"points\":45"), std::string::npos) << json;
+    EXPECT_NE(json.find("\"generatePaths/extractProfiles\":"), std::string::npos) << json;
+    EXPECT_NE(json.find("\"generatePaths/write\":"), std::string::npos) << json;
+    EXPECT_EQ(json.find("fusion.profileLoops"), std::string::npos) << json;  // Only two levels
+    EXPECT_NE(json.find("\"threads\":4"), std::string::npos) << json;
+    EXPECT_NE(json.find("\"cache\":{\"analytic\":true,\"memory\":true,\"disk\":false"), std::string::npos) << json;
+    EXPECT_NE(json.find("\"memoryHits\":2,\"diskHits\":0}"), std::string::npos) << json;
+    EXPECT_EQ(json.back(), '}');
+}
+
+TEST(RunHistoryTest, ImportLineHasNoGenerationSettings) {
+    RunHistoryEntry entry;
+    entry.profiles = 2;
+    ChipCarving::Utils::RunMetrics metrics;
+    {
+        ChipCarving::Utils::ScopedRunMetrics bound(metrics);
+        ChipCarving::Utils::TraceSpan run("importDesign");
+    }
+
+    std::string json = runHistoryJson(entry, metrics);
+    EXPECT_NE(json.find("\"command\":\"importDesign\""), std::string::npos) << json;
+    EXPECT_EQ(json.find("\"threads\""), std::string::npos) << json;
+    EXPECT_EQ(json.find("\"cache\""), std::string::npos) << json;
+    EXPECT_EQ(json.find("\"peakResidentBytes\""), std::string::npos) << json;  // Memory was not sampled
+}
+
+TEST(RunHistoryTest, SampledRunsListStagePeakMemory) {
+    if (ChipCarving::Utils::currentResidentBytes() == 0) {
+        return;  // No resident set size on this platform
+    }
+    ChipCarving::Utils::RunMetrics metrics;
+    {
+        ChipCarving::Utils::MemorySampler sampler;
+        ChipCarving::Utils::ScopedRunMetrics bound(metrics);
+        ChipCarving::Utils::TraceSpan run("generatePaths");
+        ChipCarving::Utils::TraceSpan write("write");
+    }
+
+    std::string json = runHistoryJson(RunHistoryEntry(), metrics);
+    EXPECT_NE(json.find("\"peakResidentBytes\":{\"generatePaths\":"), std::string::npos) << json;
+    EXPECT_NE(json.find(",\"generatePaths/write\":"), std::string::npos) << json;
+}
+
+TEST(RunHistoryTest, AppendsOneLinePerRun) {
+    std::string path = ::testing::TempDir() + "run_history_test.jsonl";
+    std::remove(path.c_str());
+    RunHistoryEntry entry;
+    ChipCarving::Utils::RunMetrics metrics = generationMetrics();
+    ASSERT_TRUE(appendRunHistory(path, entry, metrics));
+    ASSERT_TRUE(appendRunHistory(path, entry, metrics));
+
+    std::ifstream file(path);
+    std::string line;
+    int lines = 0;
+    while (std::getline(file, line)) {
+        EXPECT_EQ(line.front(), '{');
+        ++lines;
+    }
+    EXPECT_EQ(lines, 2);
+    std::remove(path.c_str());
+
+    EXPECT_FALSE(appendRunHistory("/nonexistent-directory/history.jsonl", entry, metrics));
+}
+
+TEST(RunHistoryTest, DesignHashFollowsTheShapes) {
+    std::string hash = importedDesignHash(leaves(20.0));
+    EXPECT_EQ(hash.size(), 16u);
+    EXPECT_EQ(hash, importedDesignHash(leaves(20.0)));
+    EXPECT_NE(hash, importedDesignHash(leaves(30.0)));
+}
@@ -0,0 +1,148 @@
+/**
+ * test_RunReport.cpp
+ *
+ * Unit tests for the per-run performance report of Generate Paths
+ */
+
+#include <gtest/gtest.h>
+
+#include <string>
+
+#include "core/RunReport.h"
+#include "utils/ApiCallTimer.h"
+#include "utils/TraceSpan.h"
+
+using namespace ChipCarving::Core;
+using ChipCarving::Geometry::MedialAxisResults;
+
+namespace {
+
+MedialAxisResults computedResults(double computeMs, int points, size_t attempts = 1, bool success = true) {
+    MedialAxisResults results;
+    results.success = success;
+    results.totalPoints = points;
+    results.computeMs = computeMs;
+    results.attempts.resize(attempts);
+    return results;
+}
+
+}  // namespace
+
+TEST(RunReportTest, CountsProfilesPointsAndRetries) {
+    RunReport report;
+    EXPECT_TRUE(report.empty());
+
+    report.addProfile("a", computedResults(2.0, 10));
+    report.addProfile("b", computedResults(3.0, 20, 3));
+    report.addProfile("c", computedResults(1.0, 30, 2, false));
+
+    EXPECT_FALSE(report.empty());
+    EXPECT_EQ(report.profiles, 3u);
+    EXPECT_EQ(report.failedProfiles, 1u);
+    EXPECT_EQ(report.points, 30);  // Failed profiles' points are not counted
+    EXPECT_EQ(report.medialAxisRetries, 3u);
+}
+
+TEST(RunReportTest, KeepsTheSlowestComputedProfilesSlowestFirst) {
+    RunReport report;
+    for (int i = 1; i <= 8; ++i) {
+        report.addProfile("profile" + std::to_string(i), computedResults(i, 1));
+    }
+    report.addProfile("cached", computedResults(0.0, 1));  // Resolved without computing
+
+    ASSERT_EQ(report.slowestProfiles.size(), RunReport::SLOWEST_PROFILE_COUNT);
+    EXPECT_EQ(report.slowestProfiles.front().entityToken, "profile8");
+    EXPECT_DOUBLE_EQ(report.slowestProfiles.front().medialAxisMs, 8.0);
+    EXPECT_EQ(report.slowestProfiles.back().entityToken, "profile4");
+}
+
+TEST(RunReportTest, MergeAddsCountsAndSlowestProfiles) {
+    RunReport first;
+    first.addProfile("a", computedResults(5.0, 10));
+    first.memoryCacheHits = 1;
+    RunReport second;
+    second.addProfile("b", computedResults(9.0, 5));
+    second.diskCacheHits = 2;
+    second.analyticMedialAxes = 1;
+
+    first.merge(second);
+    EXPECT_EQ(first.profiles, 2u);
+    EXPECT_EQ(first.points, 15);
+    EXPECT_EQ(first.memoryCacheHits, 1u);
+    EXPECT_EQ(first.diskCacheHits, 2u);
+    EXPECT_EQ(first.analyticMedialAxes, 1u);
+    ASSERT_EQ(first.slowestProfiles.size(), 2u);
+    EXPECT_EQ(first.slowestProfiles[0].entityToken, "b");
+    EXPECT_EQ(first.slowestProfiles[1].entityToken, "a");
+}
+
+TEST(RunReportTest, FormatsStagesApiCallsCachesAndSlowestProfiles) {
+    ChipCarving::Utils::RunMetrics metrics;
+    {
+        ChipCarving::Utils::ScopedRunMetrics bound(metrics);
+        ChipCarving::Utils::TraceSpan run("generatePaths");
+        {
+            ChipCarving::Utils::TraceSpan extract("extractProfiles");
+            ChipCarving::Utils::ApiCallTimer calls(ChipCarving::Utils::ApiCallKind::SketchEntity, 3);
+        }
+        ChipCarving::Utils::TraceSpan write("write");
+    }
+
+    RunReport report;
+    report.addProfile("token-1", computedResults(4.0, 12, 2));
+    report.addProfile("", computedResults(0.0, 8));
+    report.addProfile("token-3", computedResults(0.0, 6));
+    report.analyticMedialAxes = 1;
+    report.memoryCacheHits = 1;
+
+    std::string text = report.format(metrics);
+    EXPECT_NE(text.find("Run report: 3 profiles in "), std::string::npos) << text;
+    EXPECT_NE(text.find("26 medial axis points"), std::string::npos) << text;
+    EXPECT_NE(text.find("Stages: extractProfiles "), std::string::npos) << text;
+    EXPECT_NE(text.find(", write "), std::string::npos) << text;
+    EXPECT_NE(text.find("Fusion API: 3 sketchEntities "), std::string::npos) << text;
+    EXPECT_NE(text.find("1 analytic, 1 cached (1 memory, 0 disk), cache hit rate 50%, 1 retries"), std::string::npos)
+        << text;
+    EXPECT_NE(text.find("4.0 ms  token-1, 1 retry"), std::string::npos) << text;
+    if (!ChipCarving::Utils::allocationTrackingEnabled()) {
+        EXPECT_EQ(text.find("Peak memory"), std::string::npos) << text;  // Memory was not sampled
+    }
+}
+
+TEST(RunReportTest, FormatsPeakMemoryPerStage) {
+    if (ChipCarving::Utils::currentResidentBytes() == 0) {
+        return;  // No resident set size on this platform
+    }
+    ChipCarving::Utils::RunMetrics metrics;
+    {
+        ChipCarving::Utils::MemorySampler sampler;
+        ChipCarving::Utils::ScopedRunMetrics bound(metrics);
+        ChipCarving::Utils::TraceSpan run("generatePaths");
+        ChipCarving::Utils::TraceSpan write("write");
+    }
+
+    RunReport report;
+    report.addProfile("token-1", computedResults(4.0, 12));
+    std::string text = report.format(metrics);
+    EXPECT_NE(text.find("  Peak memory: "), std::string::npos) << text;
+    EXPECT_NE(text.find(" MB resident (write "), std::string::npos) << text;
+}
+
+TEST(RunReportTest, ListsReducedPrecisionProfilesAfterMerge) {
+    RunReport report;
+    report.addProfile("token-1", computedResults(1.0, 4));
+    EXPECT_EQ(report.format(ChipCarving::Utils::RunMetrics()).find("Reduced precision"), std::string::npos);
+
+    RunReport other;
+    for (size_t i = 0; i < RunReport::LISTED_REDUCED_PRECISION_COUNT + 2; ++i) {
+        other.reducedPrecisionProfiles.push_back(i == 0 ? "" : "coarse-" + std::to_string(i));
+    }
+    report.merge(other);
+    ASSERT_EQ(report.reducedPrecisionProfiles.size(), RunReport::LISTED_REDUCED_PRECISION_COUNT + 2);
+
+    std::string text = report.format(ChipCarving::Utils::RunMetrics());
+    EXPECT_NE(text.find("Reduced precision (time budget ran out): 12 profiles\n"), std::string::npos) << text;
+    EXPECT_NE(text.find("    (no entity token)\n    coarse-1\n"), std::string::npos) << text;
+    EXPECT_NE(text.find("    coarse-9\n    and 2 more\n"), std::string::npos) << text;
+    EXPECT_EQ(text.find("coarse-10"), std::string::npos) << text;
+}
@@ -0,0 +1,108 @@
+/**
+ * test_SpatialTiling.cpp
+ *
+ * Unit tests for the grid tiles of tiled Generate Paths and their journal
+ */
+
+#include <gtest/gtest.h>
+
+#include <cstdio>
+#include <string>
+
+#include "core/SpatialTiling.h"
+
+using namespace ChipCarving::Adapters;
+using namespace ChipCarving::Core;
+
+namespace {
+
+// A 1 cm square profile with its lower left corner at (x, y) cm
+ProfileGeometry squareAt(double x, double y, const std::string& plane = "plane-1") {
+    ProfileGeometry profile;
+    profile.vertices = {{x, y}, {x + 1.0, y}, {x + 1.0, y + 1.0}, {x, y + 1.0}};
+    profile.planeEntityId = plane;
+    return profile;
+}
+
+SketchSelection selectionOf(const std::vector<ProfileGeometry>& profiles) {
+    SketchSelection selection;
+    for (size_t i = 0; i < profiles.size(); ++i) {
+        selection.selectedProfiles.push_back(profiles[i]);
+        selection.selectedEntityIds.push_back("profile-" + std::to_string(i));
+    }
+    selection.closedPathCount = static_cast<int>(profiles.size());
+    selection.isValid = true;
+    return selection;
+}
+
+}  // namespace
+
+TEST(SpatialTilingTest, GroupsProfilesByTheCellOfTheirCentre) {
+    // Centres at x = 0.5, 2.5, 10.5 and 12.5 cm, two rows apart for the last one
+    SketchSelection selection =
+        selectionOf({squareAt(0.0, 0.0), squareAt(2.0, 0.0), squareAt(10.0, 0.0), squareAt(12.0, 20.0)});
+    std::vector<SelectionTile> tiles = splitSelectionIntoTiles(selection, 10.0);
+
+    ASSERT_EQ(tiles.size(), 3u);
+    EXPECT_EQ(tiles[0].label, "Tile 0,0");
+    EXPECT_EQ(tiles[0].selection.closedPathCount, 2);
+    EXPECT_EQ(tiles[0].selection.selectedEntityIds, (std::vector<std::string>{"profile-0", "profile-1"}));
+    EXPECT_EQ(tiles[1].label, "Tile 1,0");
+    EXPECT_EQ(tiles[2].label, "Tile 1,2");
+    EXPECT_EQ(tiles[2].selection.selectedEntityIds, std::vector<std::string>{"profile-3"});
+    for (const auto& tile : tiles) {
+        EXPECT_TRUE(tile.selection.isValid);
+    }
+}
+
+TEST(SpatialTilingTest, ProfilesOnDifferentPlanesNeverShareATile) {
+    SketchSelection selection = selectionOf({squareAt(0.0, 0.0, "top"), squareAt(2.0, 0.0, "lid")});
+    std::vector<SelectionTile> tiles = splitSelectionIntoTiles(selection, 10.0);
+
+    ASSERT_EQ(tiles.size(), 2u);
+    EXPECT_NE(tiles[0].label, tiles[1].label);
+}
+
+TEST(SpatialTilingTest, SelectionWithoutGeometryIsOneTile) {
+    SketchSelection selection;
+    selection.selectedEntityIds = {"a", "b"};
+    selection.closedPathCount = 2;
+    selection.isValid = true;
+    std::vector<SelectionTile> tiles = splitSelectionIntoTiles(selection, 10.0);
+
+    ASSERT_EQ(tiles.size(), 1u);
+    EXPECT_EQ(tiles[0].selection.selectedEntityIds, selection.selectedEntityIds);
+}
+
+TEST(SpatialTilingTest, JournalKeysFollowTheTileProfilesAndTool) {
+    SketchSelection selection = selectionOf({squareAt(0.0, 0.0), squareAt(12.0, 0.0)});
+    std::vector<SelectionTile> tiles = splitSelectionIntoTiles(selection, 10.0);
+    ASSERT_EQ(tiles.size(), 2u);
+
+    MedialAxisParameters params;
+    params.spatialTileSize = 100.0;
+    std::string key = tileJournalKey(tiles[0], params);
+    EXPECT_EQ(key.rfind("Tile 0,0 ", 0), 0u);
+    EXPECT_EQ(key, tileJournalKey(tiles[0], params));
+    EXPECT_NE(key, tileJournalKey(tiles[1], params));
+
+    MedialAxisParameters otherTool = params;
+    otherTool.toolName = "30° V-bit";
+    EXPECT_NE(key, tileJournalKey(tiles[0], otherTool));
+}
+
+TEST(SpatialTilingTest, JournalRecordsFinishedTiles) {
+    std::string path = ::testing::TempDir() + "spatial_tiling_journal.txt";
+    std::remove(path.c_str());
+    EXPECT_TRUE(loadTileJournal(path).empty());
+
+    ASSERT_TRUE(appendTileJournal(path, "Tile 0,0 0123456789abcdef"));
+    ASSERT_TRUE(appendTileJournal(path, "Tile 1,0 fedcba9876543210"));
+    auto keys = loadTileJournal(path);
+    EXPECT_EQ(keys.size(), 2u);
+    EXPECT_EQ(keys.count("Tile 1,0 fedcba9876543210"), 1u);
+
+    ASSERT_TRUE(clearTileJournal(path));
+    EXPECT_TRUE(loadTileJournal(path).empty());
+    std::remove(path.c_str());
+}
@@ -0,0 +1,79 @@
+/**
+ * ShapeTessellation.h
+ *
+ * Leaf and TriArc polygon generators shared by the geometry tests and the
+ * benchmarks. Polygons follow the Fusion stroke convention: points along each
+ * boundary arc, implicitly closed, no duplicate end vertex.
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <vector>
+
+#include "geometry/Leaf.h"
+#include "geometry/Point2D.h"
+#include "geometry/TriArc.h"
+
+namespace ChipCarving {
+namespace Testing {
+
+// Sample one arc from start to end around center, excluding the end point
+inline void appendArc(std::vector<Geometry::Point2D>& polygon, const Geometry::Point2D& center, double radius,
+                      const Geometry::Point2D& start, const Geometry::Point2D& end, int steps) {
+    double startAngle = std::atan2(start.y - center.y, start.x - center.x);
+    double endAngle = std::atan2(end.y - center.y, end.x - center.x);
+    double sweep = endAngle - startAngle;
+    while (sweep > M_PI) sweep -= 2 * M_PI;
+    while (sweep < -M_PI) sweep += 2 * M_PI;
+
+    for (int i = 0; i < steps; ++i) {
+        double angle = startAngle + sweep * i / steps;
+        polygon.emplace_back(center.x + radius * std::cos(angle), center.y + radius * std::sin(angle));
+    }
+}
+
+// Tessellate a leaf the way Fusion strokes would: points on both boundary arcs
+inline std::vector<Geometry::Point2D> tessellateLeaf(const Geometry::Leaf& leaf, int stepsPerArc = 24) {
+    auto centers = leaf.getArcCenters();
+    std::vector<Geometry::Point2D> polygon;
+    appendArc(polygon, centers.first, leaf.getRadius(), leaf.getFocus1(), leaf.getFocus2(), stepsPerArc);
+    appendArc(polygon, centers.second, leaf.getRadius(), leaf.getFocus2(), leaf.getFocus1(), stepsPerArc);
+    return polygon;
+}
+
+// Tessellate a TriArc the way Fusion strokes would: points along each edge
+inline std::vector<Geometry::Point2D> tessellateTriArc(const Geometry::TriArc& triArc, int stepsPerEdge = 24) {
+    std::vector<Geometry::Point2D> polygon;
+    for (int i = 0; i < 3; ++i) {
+        Geometry::Point2D start = triArc.getVertex(i);
+        Geometry::Point2D end = triArc.getVertex((i + 1) % 3);
+        if (triArc.isEdgeStraight(i)) {
+            polygon.push_back(start);
+            continue;
+        }
+
+        Geometry::ArcParams arc = triArc.getArcParameters(i);
+        appendArc(polygon, arc.center, arc.radius, start, end, stepsPerEdge);
+    }
+    return polygon;
+}
+
+inline double distanceToPolygon(const Geometry::Point2D& p, const std::vector<Geometry::Point2D>& polygon) {
+    double best = std::numeric_limits<double>::max();
+    for (size_t i = 0; i < polygon.size(); ++i) {
+        const Geometry::Point2D& a = polygon[i];
+        const Geometry::Point2D& b = polygon[(i + 1) % polygon.size()];
+        double dx = b.x - a.x;
+        double dy = b.y - a.y;
+        double len2 = dx * dx + dy * dy;
+        double t = len2 > 0 ? std::max(0.0, std::min(1.0, ((p.x - a.x) * dx + (p.y - a.y) * dy) / len2)) : 0.0;
+        best = std::min(best, Geometry::distance(p, Geometry::Point2D(a.x + t * dx, a.y + t * dy)));
+    }
+    return best;
+}
+
+}  // namespace Testing
+}  // namespace ChipCarving
@@ -0,0 +1,96 @@
+/**
+ * test_AnalyticMedialAxis.cpp
+ *
+ * Unit tests for closed-form medial axis generation of imported shapes.
+ * Verifies shape matching, clearance values, and unit scaling.
+ */
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <vector>
+
+#include "ShapeTessellation.h"
+#include "geometry/AnalyticMedialAxis.h"
+#include "geometry/Leaf.h"
+
+using namespace ChipCarving::Geometry;
+using namespace ChipCarving::Testing;
+
+TEST(AnalyticMedialAxisTest, TessellatedLeafMatches) {
+    Leaf leaf(Point2D(10, 20), Point2D(40, 35));
+    EXPECT_TRUE(polygonMatchesLeaf(tessellateLeaf(leaf), leaf, 1e-6));
+}
+
+TEST(AnalyticMedialAxisTest, EditedLeafDoesNotMatch) {
+    Leaf leaf(Point2D(0, 0), Point2D(30, 0));
+    auto polygon = tessellateLeaf(leaf);
+    polygon[5].y += 0.5;  // User dragged part of an arc
+    EXPECT_FALSE(polygonMatchesLeaf(polygon, leaf, 1e-3));
+}
+
+TEST(AnalyticMedialAxisTest, DifferentLeafDoesNotMatch) {
+    Leaf leaf(Point2D(0, 0), Point2D(30, 0));
+    Leaf other(Point2D(0, 0), Point2D(30, 0), 25.0);
+    EXPECT_FALSE(polygonMatchesLeaf(tessellateLeaf(other), leaf, 1e-3));
+}
+
+TEST(AnalyticMedialAxisTest, HalfLeafDoesNotMatch) {
+    Leaf leaf(Point2D(0, 0), Point2D(30, 0));
+    auto centers = leaf.getArcCenters();
+    std::vector<Point2D> polygon;
+    appendArc(polygon, centers.first, leaf.getRadius(), leaf.getFocus1(), leaf.getFocus2(), 24);
+    polygon.push_back(leaf.getFocus2());
+    EXPECT_FALSE(polygonMatchesLeaf(polygon, leaf, 1e-3));
+}
+
+TEST(AnalyticMedialAxisTest, ChordWithClosedFormClearance) {
+    Leaf leaf(Point2D(0, 0), Point2D(30, 0));
+    auto results = computeLeafMedialAxis(leaf, 10);
+
+    ASSERT_TRUE(results.success);
+    ASSERT_EQ(results.chains.size(), 1u);
+    ASSERT_EQ(results.chains[0].size(), 11u);
+    ASSERT_EQ(results.chains[0].clearances().size(), 11u);
+    EXPECT_EQ(results.numChains, 1);
+    EXPECT_EQ(results.totalPoints, 11);
+    EXPECT_NEAR(results.totalLength, 30.0, 1e-9);
+
+    EXPECT_TRUE(results.chains[0].front().equals(leaf.getFocus1()));
+    EXPECT_TRUE(results.chains[0].back().equals(leaf.getFocus2()));
+    EXPECT_NEAR(results.chains[0].clearance(0), 0.0, 1e-9);
+    EXPECT_NEAR(results.chains[0].clearances().back(), 0.0, 1e-9);
+    EXPECT_NEAR(results.chains[0].clearance(5), leaf.getSagitta(), 1e-9);
+    EXPECT_NEAR(results.maxClearance, leaf.getSagitta(), 1e-9);
+}
+
+TEST(AnalyticMedialAxisTest, ClearanceMatchesDistanceToBoundary) {
+    Leaf leaf(Point2D(5, -3), Point2D(25, 12));
+    auto polygon = tessellateLeaf(leaf, 400);
+    auto results = computeLeafMedialAxis(leaf, 16);
+    ASSERT_TRUE(results.success);
+
+    for (size_t i = 0; i < results.chains[0].size(); ++i) {
+        EXPECT_NEAR(results.chains[0].clearance(i), distanceToPolygon(results.chains[0][i], polygon), 1e-3)
+            << "point " << i;
+    }
+}
+
+TEST(AnalyticMedialAxisTest, ScalesShapeUnitsToPolygonUnits) {
+    // Shape in mm, profile polygon in cm
+    Leaf leafMm(Point2D(100, 50), Point2D(160, 80));
+    Leaf leafCm(Point2D(10, 5), Point2D(16, 8), leafMm.getRadius() / 10.0);
+    auto polygonCm = tessellateLeaf(leafCm);
+
+    MedialAxisResults results;
+    ASSERT_TRUE(computeAnalyticMedialAxis(leafMm, 0.1, polygonCm, 1e-6, results));
+    EXPECT_NEAR(results.totalLength, distance(leafCm.getFocus1(), leafCm.getFocus2()), 1e-9);
+    EXPECT_NEAR(results.maxClearance, leafCm.getSagitta(), 1e-9);
+    EXPECT_GT(results.transform.scale, 0.0);
+
+    MedialAxisResults unscaled;
+    EXPECT_FALSE(computeAnalyticMedialAxis(leafMm, 1.0, polygonCm, 1e-6, unscaled));
+    EXPECT_FALSE(unscaled.success);
+}
@@ -0,0 +1,78 @@
+/**
+ * test_ArcLengthChain.cpp
+ *
+ * Unit tests for arc-length evaluation along medial axis chains
+ */
+
+#include <gtest/gtest.h>
+
+#include "geometry/ArcLengthChain.h"
+
+using namespace ChipCarving::Geometry;
+
+namespace {
+
+// An L of lengths 3 and 4 with a zero-length step at its corner
+MedialAxisChains makeLChain() {
+    MedialAxisChains chains;
+    chains.addChain({Point2D(0, 0), Point2D(3, 0), Point2D(3, 0), Point2D(3, 4)}, {1.0, 2.5, 2.5, 0.5});
+    return chains;
+}
+
+}  // namespace
+
+TEST(ArcLengthChainTest, CumulativeLengthsFollowTheChain) {
+    MedialAxisChains chains = makeLChain();
+    ArcLengthChain arc(chains[0]);
+    ASSERT_EQ(arc.size(), 4u);
+    EXPECT_DOUBLE_EQ(arc.arcLength(0), 0.0);
+    EXPECT_DOUBLE_EQ(arc.arcLength(1), 3.0);
+    EXPECT_DOUBLE_EQ(arc.arcLength(2), 3.0);
+    EXPECT_DOUBLE_EQ(arc.totalLength(), 7.0);
+
+    arc.assign(chains[0], 10.0);
+    EXPECT_DOUBLE_EQ(arc.totalLength(), 70.0);
+    EXPECT_DOUBLE_EQ(arc.pointAt(35.0).y, 5.0);
+    EXPECT_DOUBLE_EQ(arc.clearanceAt(0.0), 10.0);
+}
+
+TEST(ArcLengthChainTest, EvaluatesAnyDistanceByInterpolation) {
+    MedialAxisChains chains = makeLChain();
+    ArcLengthChain arc(chains[0]);
+
+    ArcLengthChain::Location location = arc.locate(1.5);
+    EXPECT_EQ(location.segment, 0u);
+    EXPECT_DOUBLE_EQ(location.t, 0.5);
+    EXPECT_DOUBLE_EQ(arc.pointAt(1.5).x, 1.5);
+    EXPECT_DOUBLE_EQ(arc.clearanceAt(1.5), 1.75);
+
+    // The corner lands past the zero-length segment
+    location = arc.locate(3.0);
+    EXPECT_EQ(location.segment, 2u);
+    EXPECT_DOUBLE_EQ(location.t, 0.0);
+
+    Point2D onSecondLeg = arc.pointAt(5.0);
+    EXPECT_DOUBLE_EQ(onSecondLeg.x, 3.0);
+    EXPECT_DOUBLE_EQ(onSecondLeg.y, 2.0);
+    EXPECT_DOUBLE_EQ(arc.clearanceAt(5.0), 1.5);
+}
+
+TEST(ArcLengthChainTest, ClampsToTheChainEnds) {
+    MedialAxisChains chains = makeLChain();
+    ArcLengthChain arc(chains[0]);
+    EXPECT_DOUBLE_EQ(arc.pointAt(-2.0).x, 0.0);
+    EXPECT_DOUBLE_EQ(arc.pointAt(100.0).y, 4.0);
+    EXPECT_EQ(arc.locate(100.0).segment, 2u);
+    EXPECT_DOUBLE_EQ(arc.locate(100.0).t, 1.0);
+
+    MedialAxisChains single;
+    single.addChain({Point2D(2, 5)}, {0.3});
+    arc.assign(single[0]);
+    EXPECT_DOUBLE_EQ(arc.totalLength(), 0.0);
+    EXPECT_DOUBLE_EQ(arc.pointAt(1.0).y, 5.0);
+    EXPECT_DOUBLE_EQ(arc.clearanceAt(1.0), 0.3);
+
+    ArcLengthChain empty;
+    EXPECT_TRUE(empty.empty());
+    EXPECT_DOUBLE_EQ(empty.totalLength(), 0.0);
+}
@@ -0,0 +1,110 @@
+/**
+ * test_CanonicalShape.cpp
+ *
+ * Unit tests for similarity-invariant outline fingerprints and the mapping of
+ * medial axes between copies of one shape
+ */
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+#include "geometry/CanonicalShape.h"
+
+using namespace ChipCarving::Geometry;
+
+namespace {
+
+constexpr double PI = 3.14159265358979323846;
+
+// Irregular pentagon: no symmetry, so only one normalization fits it
+std::vector<Point2D> pentagon() {
+    return {Point2D(0.0, 0.0), Point2D(4.0, 0.5), Point2D(5.0, 3.0), Point2D(2.0, 4.5), Point2D(-0.5, 2.0)};
+}
+
+std::vector<Point2D> similar(const std::vector<Point2D>& polygon, double angle, double scale, const Point2D& shift) {
+    std::vector<Point2D> copy;
+    for (const auto& p : polygon) {
+        copy.emplace_back(shift.x + scale * (p.x * std::cos(angle) - p.y * std::sin(angle)),
+                          shift.y + scale * (p.x * std::sin(angle) + p.y * std::cos(angle)));
+    }
+    return copy;
+}
+
+}  // namespace
+
+TEST(CanonicalShapeTest, CopiesShareTheirCanonicalShape) {
+    CanonicalShape original;
+    ASSERT_TRUE(canonicalizeShape(pentagon(), original));
+    EXPECT_NEAR(original.scale, std::sqrt(16.125), 1e-12);
+
+    // Rotated, scaled, moved, starting at another vertex and wound the other way
+    std::vector<Point2D> copy = similar(pentagon(), 0.7, 2.5, Point2D(30.0, -12.0));
+    std::rotate(copy.begin(), copy.begin() + 2, copy.end());
+    std::reverse(copy.begin(), copy.end());
+    CanonicalShape moved;
+    ASSERT_TRUE(canonicalizeShape(copy, moved));
+    EXPECT_EQ(moved.key, original.key);
+    EXPECT_TRUE(sameCanonicalShape(original, moved));
+    EXPECT_NEAR(moved.scale / original.scale, 2.5, 1e-12);
+    EXPECT_NEAR(std::remainder(moved.angle - original.angle - 0.7, 2.0 * PI), 0.0, 1e-12);
+
+    // One vertex off by a fraction of a percent is another shape
+    std::vector<Point2D> edited = pentagon();
+    edited[2].x += 0.02;
+    CanonicalShape other;
+    ASSERT_TRUE(canonicalizeShape(edited, other));
+    EXPECT_FALSE(sameCanonicalShape(original, other));
+
+    // Degenerate outlines have no canonical form
+    EXPECT_FALSE(canonicalizeShape({Point2D(0, 0), Point2D(1, 0), Point2D(2, 0)}, other));
+    EXPECT_FALSE(canonicalizeShape({Point2D(0, 0), Point2D(1, 0)}, other));
+}
+
+TEST(CanonicalShapeTest, SymmetricShapesMatchAtAnyRotation) {
+    // Equal inertia in every direction: the furthest vertex sets the rotation
+    std::vector<Point2D> square = {Point2D(0, 0), Point2D(2, 0), Point2D(2, 2), Point2D(0, 2)};
+    std::vector<Point2D> triangle = {Point2D(0, 0), Point2D(2, 0), Point2D(1, std::sqrt(3.0))};
+    for (const auto& outline : {square, triangle}) {
+        CanonicalShape original;
+        ASSERT_TRUE(canonicalizeShape(outline, original));
+        for (double angle : {0.3, 1.1, 2.9, -2.0}) {
+            CanonicalShape turned;
+            ASSERT_TRUE(canonicalizeShape(similar(outline, angle, 0.4, Point2D(-7.0, 3.0)), turned));
+            EXPECT_TRUE(sameCanonicalShape(original, turned)) << "angle " << angle;
+        }
+    }
+}
+
+TEST(CanonicalShapeTest, MedialAxisFollowsTheCopy) {
+    std::vector<Point2D> outline = pentagon();
+    std::vector<Point2D> copy = similar(outline, -1.2, 0.5, Point2D(10.0, 10.0));
+    CanonicalShape from;
+    CanonicalShape to;
+    ASSERT_TRUE(canonicalizeShape(outline, from));
+    ASSERT_TRUE(canonicalizeShape(copy, to));
+
+    MedialAxisResults results;
+    results.success = true;
+    results.chains.addChain({Point2D(1.0, 1.0), Point2D(2.0, 2.0), Point2D(3.0, 2.0)}, {0.8, 1.2, 0.9});
+    results.chains.addChain({Point2D(2.0, 2.0), Point2D(2.0, 3.5)}, {1.2, 0.4});
+    results.totalLength = 2.5;
+    results.minClearance = 0.4;
+    results.maxClearance = 1.2;
+
+    MedialAxisResults mapped = transformMedialAxis(results, from, to);
+    ASSERT_EQ(mapped.chains.size(), 2u);
+    ASSERT_EQ(mapped.chains.pointCount(), 5u);
+    std::vector<Point2D> expected =
+        similar({Point2D(1.0, 1.0), Point2D(2.0, 2.0), Point2D(3.0, 2.0)}, -1.2, 0.5, Point2D(10.0, 10.0));
+    for (size_t i = 0; i < expected.size(); ++i) {
+        EXPECT_NEAR(mapped.chains[0][i].x, expected[i].x, 1e-9);
+        EXPECT_NEAR(mapped.chains[0][i].y, expected[i].y, 1e-9);
+    }
+    EXPECT_NEAR(mapped.chains[1].clearance(1), 0.2, 1e-12);
+    EXPECT_NEAR(mapped.totalLength, 1.25, 1e-12);
+    EXPECT_NEAR(mapped.maxClearance, 0.6, 1e-12);
+    EXPECT_TRUE(mapped.success);
+}
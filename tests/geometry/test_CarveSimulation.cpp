@@ -0,0 +1,196 @@
+/**
+ * Unit tests for the raster stock-removal simulation and its shape mask verification
+ */
+
+#include <gtest/gtest.h>
+
+#include <cmath>
+#include <cstdio>
+#include <fstream>
+#include <iterator>
+#include <string>
+#include <vector>
+
+#include "geometry/CarveSimulation.h"
+#include "geometry/Leaf.h"
+#include "geometry/SVGGenerator.h"
+
+using namespace ChipCarving::Geometry;
+
+namespace {
+
+VCarveResults straightCut(const Point2D& start, const Point2D& end, double startDepth, double endDepth) {
+    VCarveResults results;
+    VCarvePath path;
+    path.points.emplace_back(start, startDepth, 0.0);
+    path.points.emplace_back(end, endDepth, 0.0);
+    results.paths.push_back(path);
+    results.success = true;
+    return results;
+}
+
+ShapeBounds area(double minX, double minY, double maxX, double maxY) {
+    ShapeBounds bounds;
+    bounds.min = Point2D(minX, minY);
+    bounds.max = Point2D(maxX, maxY);
+    return bounds;
+}
+
+// Cell whose center is nearest to point
+float depthAt(const DepthMap& map, const Point2D& point) {
+    int x = static_cast<int>((point.x - map.origin.x) / map.resolution);
+    int y = static_cast<int>((point.y - map.origin.y) / map.resolution);
+    return map.at(x, y);
+}
+
+}  // namespace
+
+TEST(CarveSimulationTest, LevelCutFollowsTheVBitProfile) {
+    CarveSimulationParams params;
+    params.resolution = 0.1;
+    params.toolAngle = 90.0;  // Cut depth falls by 1 mm per mm from the path
+
+    DepthMap map = simulateCarve(straightCut(Point2D(0, 0), Point2D(10, 0), 1.0, 1.0), area(-2, -2, 12, 2), params);
+
+    EXPECT_EQ(map.width, 140);
+    EXPECT_EQ(map.height, 40);
+    EXPECT_NEAR(depthAt(map, Point2D(5.0, 0.05)), 0.95, 1e-5);
+    EXPECT_NEAR(depthAt(map, Point2D(5.0, 0.55)), 0.45, 1e-5);
+    EXPECT_FLOAT_EQ(depthAt(map, Point2D(5.0, 1.25)), 0.0f);
+    EXPECT_NEAR(depthAt(map, Point2D(-0.45, 0.05)), 1.0 - std::hypot(0.45, 0.05), 1e-5);  // Round end
+}
+
+TEST(CarveSimulationTest, SlopedCutMatchesDenseSampling) {
+    CarveSimulationParams params;
+    params.resolution = 0.25;
+    params.toolAngle = 60.0;
+    params.toolDiameter = 3.0;
+    VCarveResults results = straightCut(Point2D(0, 0), Point2D(6, 2), 0.2, 2.0);
+
+    DepthMap map = simulateCarve(results, area(-3, -3, 9, 5), params);
+
+    // Deepest cut by brute force over the swept cone
+    double cot = 1.0 / std::tan(30.0 * M_PI / 180.0);
+    for (int y = 0; y < map.height; y += 3) {
+        for (int x = 0; x < map.width; x += 3) {
+            Point2D center = map.cellCenter(x, y);
+            double expected = 0.0;
+            for (int i = 0; i <= 20000; ++i) {
+                double t = i / 20000.0;
+                Point2D tip(6.0 * t, 2.0 * t);
+                double dist = distance(center, tip);
+                if (dist <= 1.5) {
+                    expected = std::max(expected, 0.2 + 1.8 * t - cot * dist);
+                }
+            }
+            EXPECT_NEAR(map.at(x, y), expected, 1e-3) << "cell " << x << ", " << y;
+        }
+    }
+}
+
+TEST(CarveSimulationTest, TileWorkersDoNotChangeTheMap) {
+    VCarveResults results = straightCut(Point2D(0, 0), Point2D(20, 5), 0.5, 3.0);
+    results.paths.push_back(straightCut(Point2D(0, 5), Point2D(20, 0), 2.0, 0.1).paths[0]);
+    CarveSimulationParams params;
+    params.tileSize = 16;
+
+    params.workers = 1;
+    DepthMap sequential = simulateCarve(results, area(-4, -4, 24, 9), params);
+    params.workers = 4;
+    DepthMap parallel = simulateCarve(results, area(-4, -4, 24, 9), params);
+
+    EXPECT_EQ(sequential.depth, parallel.depth);
+}
+
+TEST(CarveSimulationTest, GpuBackendMatchesCpuTilesOrFallsBack) {
+    VCarveResults results = straightCut(Point2D(0, 0), Point2D(20, 5), 0.5, 3.0);
+    results.paths.push_back(straightCut(Point2D(0, 5), Point2D(20, 0), 2.0, 0.1).paths[0]);
+    CarveSimulationParams params;
+    params.tileSize = 16;
+    DepthMap cpu = simulateCarve(results, area(-4, -4, 24, 9), params);
+    EXPECT_EQ(cpu.backend, CarveSimulationBackend::CPU);
+
+    params.backend = CarveSimulationBackend::GPU;
+    DepthMap gpu = simulateCarve(results, area(-4, -4, 24, 9), params);
+    if (!carveSimulationGpuAvailable()) {
+        EXPECT_EQ(gpu.backend, CarveSimulationBackend::CPU);
+        EXPECT_EQ(gpu.depth, cpu.depth);
+        return;
+    }
+    EXPECT_EQ(gpu.backend, CarveSimulationBackend::GPU);
+    ASSERT_EQ(gpu.depth.size(), cpu.depth.size());
+    for (size_t i = 0; i < cpu.depth.size(); ++i) {
+        EXPECT_NEAR(gpu.depth[i], cpu.depth[i], 1e-4) << "cell " << i;
+    }
+}
+
+TEST(CarveSimulationTest, RejectsInvalidParameters) {
+    VCarveResults results = straightCut(Point2D(0, 0), Point2D(1, 0), 1.0, 1.0);
+    CarveSimulationParams params;
+    params.resolution = 0.0;
+    EXPECT_THROW(simulateCarve(results, area(0, 0, 1, 1), params), std::invalid_argument);
+
+    params.resolution = 1e-4;
+    params.maxCells = 1000;
+    EXPECT_THROW(simulateCarve(results, area(0, 0, 1, 1), params), std::invalid_argument);
+}
+
+TEST(CarveSimulationTest, VerificationFindsGougesAndMissedAreas) {
+    Leaf leaf(Point2D(0, 0), Point2D(10, 0), 6.5);
+    std::vector<const Shape*> shapes = {&leaf};
+    CarveSimulationParams params;
+    params.resolution = 0.1;
+
+    // Cut exactly the leaf: nothing to report
+    DepthMap map;
+    map.origin = Point2D(-2, -5);
+    map.resolution = params.resolution;
+    map.width = 140;
+    map.height = 100;
+    map.depth.assign(static_cast<size_t>(map.width) * map.height, 0.0f);
+    for (int y = 0; y < map.height; ++y) {
+        for (int x = 0; x < map.width; ++x) {
+            if (leaf.contains(map.cellCenter(x, y))) {
+                map.depth[static_cast<size_t>(y) * map.width + x] = 1.0f;
+            }
+        }
+    }
+    CarveVerification clean = verifyCarve(map, shapes, params);
+    EXPECT_TRUE(clean.passed());
+    EXPECT_GT(clean.insideCells, 0u);
+    EXPECT_EQ(clean.carvedCells, clean.insideCells);
+
+    // An uncut patch in the middle and a cut well outside the leaf
+    for (int y = 48; y < 52; ++y) {
+        for (int x = 68; x < 72; ++x) {
+            map.depth[static_cast<size_t>(y) * map.width + x] = 0.0f;
+        }
+    }
+    map.depth[static_cast<size_t>(95) * map.width + 5] = 0.8f;
+    CarveVerification flawed = verifyCarve(map, shapes, params);
+    EXPECT_FALSE(flawed.passed());
+    EXPECT_EQ(flawed.missedCells, 16u);
+    EXPECT_EQ(flawed.gougeCells, 1u);
+    EXPECT_FLOAT_EQ(static_cast<float>(flawed.maxGougeDepth), 0.8f);
+    EXPECT_EQ(flawed.cells[static_cast<size_t>(95) * map.width + 5], CarveCell::GOUGE);
+
+    // Exports: one SVG rectangle per run of flagged cells, and a PNG of the right size
+    SVGGenerator svg;
+    svg.addCarveVerification(map, flawed);
+    std::string content = svg.generate();
+    size_t rects = 0;
+    for (size_t pos = content.find("<rect"); pos != std::string::npos; pos = content.find("<rect", pos + 1)) {
+        ++rects;
+    }
+    EXPECT_EQ(rects, 4u + 1u);
+
+    std::string path = ::testing::TempDir() + "carve_verification.png";
+    ASSERT_TRUE(writeCarveVerificationPng(path, map, flawed));
+    std::ifstream file(path, std::ios::binary);
+    std::vector<unsigned char> bytes((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+    ASSERT_GT(bytes.size(), 24u + static_cast<size_t>(map.width) * map.height * 3);
+    EXPECT_EQ(bytes[1], 'P');
+    EXPECT_EQ((bytes[16] << 24) | (bytes[17] << 16) | (bytes[18] << 8) | bytes[19], map.width);
+    EXPECT_EQ((bytes[20] << 24) | (bytes[21] << 16) | (bytes[22] << 8) | bytes[23], map.height);
+    std::remove(path.c_str());
+}
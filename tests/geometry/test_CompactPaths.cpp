@@ -0,0 +1,112 @@
+/**
+ * test_CompactPaths.cpp
+ *
+ * Unit tests for float32 toolpath storage
+ */
+
+#include <gtest/gtest.h>
+
+#include <vector>
+
+#include "geometry/CompactPaths.h"
+#include "geometry/MedialAxisUtilities.h"
+#include "geometry/VCarvePath.h"
+
+using namespace ChipCarving::Geometry;
+
+namespace {
+
+// Two paths far from the origin, as on a large sheet of stock
+std::vector<VCarvePath> makeStockPaths() {
+    std::vector<VCarvePath> paths(2);
+    for (int i = 0; i < 100; ++i) {
+        paths[0].points.emplace_back(Point2D(1200.0 + i * 0.137, 800.0 - i * 0.071), 0.5 + i * 0.01, 0.3 + i * 0.005);
+    }
+    paths[0].totalLength = paths[0].calculateLength();
+    paths[1].points.emplace_back(Point2D(1190.25, 795.5), 1.25, 0.75);
+    paths[1].points.emplace_back(Point2D(1191.0, 796.0), 1.5, 0.8);
+    paths[1].points.back().projectToSurface(12.375);
+    paths[1].isClosed = true;
+    paths[1].totalLength = paths[1].calculateLength();
+    return paths;
+}
+
+}  // namespace
+
+TEST(CompactPathsTest, VCarveRoundTripKeepsSubMicronPrecision) {
+    std::vector<VCarvePath> paths = makeStockPaths();
+    CompactVCarvePaths compact = compactVCarvePaths(paths);
+    EXPECT_EQ(compact.pathCount(), 2u);
+    EXPECT_EQ(compact.pointCount(), 102u);
+
+    std::vector<VCarvePath> expanded;
+    expandVCarvePaths(compact, expanded);
+    ASSERT_EQ(expanded.size(), paths.size());
+    for (size_t p = 0; p < paths.size(); ++p) {
+        ASSERT_EQ(expanded[p].points.size(), paths[p].points.size());
+        EXPECT_DOUBLE_EQ(expanded[p].totalLength, paths[p].totalLength);
+        EXPECT_EQ(expanded[p].isClosed, paths[p].isClosed);
+        for (size_t i = 0; i < paths[p].points.size(); ++i) {
+            const VCarvePoint& a = paths[p].points[i];
+            const VCarvePoint& b = expanded[p].points[i];
+            EXPECT_NEAR(a.position.x, b.position.x, 1e-4);
+            EXPECT_NEAR(a.position.y, b.position.y, 1e-4);
+            EXPECT_NEAR(a.depth, b.depth, 1e-6);
+            EXPECT_NEAR(a.clearanceRadius, b.clearanceRadius, 1e-6);
+            EXPECT_NEAR(a.surfaceZ, b.surfaceZ, 1e-5);
+            EXPECT_EQ(a.surfaceProjected, b.surfaceProjected);
+        }
+    }
+}
+
+TEST(CompactPathsTest, CompactStorageIsAtMostHalfThePointStructs) {
+    std::vector<VCarvePath> paths = makeStockPaths();
+    CompactVCarvePaths compact = compactVCarvePaths(paths);
+    EXPECT_LE(compact.bytes(), sizeof(VCarvePoint) * compact.pointCount() / 2 + 64);
+}
+
+TEST(CompactPathsTest, ResultsCompactAndExpandInPlace) {
+    VCarveResults results;
+    results.paths = makeStockPaths();
+    results.success = true;
+    results.updateStatistics();
+    int points = results.totalPoints;
+
+    results.compact();
+    EXPECT_TRUE(results.compacted);
+    EXPECT_TRUE(results.paths.empty());
+    EXPECT_EQ(results.totalPoints, points);
+
+    results.expand();
+    results.expand();
+    EXPECT_FALSE(results.compacted);
+    ASSERT_EQ(results.paths.size(), 2u);
+    EXPECT_EQ(results.paths[1].points.size(), 2u);
+    EXPECT_TRUE(results.paths[1].points[1].surfaceProjected);
+}
+
+TEST(CompactPathsTest, EmptyPathsRoundTrip) {
+    std::vector<VCarvePath> expanded(3);
+    expandVCarvePaths(compactVCarvePaths({}), expanded);
+    EXPECT_TRUE(expanded.empty());
+}
+
+TEST(CompactPathsTest, SampledMedialRoundTrip) {
+    std::vector<SampledMedialPath> paths(2);
+    paths[0].points.emplace_back(Point2D(-450.5, 310.25), 2.0);
+    paths[0].points.emplace_back(Point2D(-449.5, 311.0), 2.125);
+    paths[0].totalLength = 1.25;
+    paths[1].points.emplace_back(Point2D(-440.0, 300.0), 0.5);
+
+    CompactSampledMedialPaths compact = compactSampledMedialPaths(paths);
+    EXPECT_EQ(compact.pathCount(), 2u);
+
+    std::vector<SampledMedialPath> expanded;
+    expandSampledMedialPaths(compact, expanded);
+    ASSERT_EQ(expanded.size(), 2u);
+    ASSERT_EQ(expanded[0].points.size(), 2u);
+    EXPECT_DOUBLE_EQ(expanded[0].totalLength, 1.25);
+    EXPECT_NEAR(expanded[0].points[1].position.x, -449.5, 1e-4);
+    EXPECT_NEAR(expanded[0].points[1].clearanceRadius, 2.125, 1e-6);
+    EXPECT_NEAR(expanded[1].points[0].position.y, 300.0, 1e-4);
+}
@@ -0,0 +1,132 @@
+/**
+ * test_CurveChaining.cpp
+ *
+ * Unit tests for spatial-hash profile curve chaining
+ */
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <cmath>
+#include <random>
+#include <vector>
+
+#include "geometry/CurveChaining.h"
+
+using namespace ChipCarving::Geometry;
+
+namespace {
+
+const double TOLERANCE = 0.001;
+
+// Linear-scan chaining the spatial hash replaces, as the reference ordering
+std::vector<ChainedCurve> chainByScan(const std::vector<Point3D>& starts, const std::vector<Point3D>& ends,
+                                      double tolerance) {
+    std::vector<ChainedCurve> chain{{0, false}};
+    std::vector<bool> used(starts.size(), false);
+    used[0] = true;
+    Point3D current = ends[0];
+    while (chain.size() < starts.size()) {
+        bool found = false;
+        for (size_t i = 0; i < starts.size() && !found; ++i) {
+            if (used[i]) {
+                continue;
+            }
+            if (current.distance(starts[i]) < tolerance) {
+                chain.push_back({i, false});
+                current = ends[i];
+                found = true;
+            } else if (current.distance(ends[i]) < tolerance) {
+                chain.push_back({i, true});
+                current = starts[i];
+                found = true;
+            }
+            used[i] = used[i] || found;
+        }
+        if (!found) {
+            break;
+        }
+    }
+    return chain;
+}
+
+// Segments of a regular polygon, shuffled, with every other one reversed
+void makeShuffledRing(size_t segments, std::vector<Point3D>& starts, std::vector<Point3D>& ends) {
+    std::vector<size_t> order(segments);
+    for (size_t i = 0; i < segments; ++i) {
+        order[i] = i;
+    }
+    std::mt19937 rng(42);
+    std::shuffle(order.begin() + 1, order.end(), rng);
+
+    for (size_t k = 0; k < segments; ++k) {
+        size_t i = order[k];
+        double a0 = 2.0 * M_PI * i / segments;
+        double a1 = 2.0 * M_PI * (i + 1) / segments;
+        // Tessellation noise well below the tolerance
+        Point3D p0(10.0 * std::cos(a0), 10.0 * std::sin(a0) + 1e-5, 0.0);
+        Point3D p1(10.0 * std::cos(a1), 10.0 * std::sin(a1) - 1e-5, 0.0);
+        bool flip = (k % 2 == 1);
+        starts.push_back(flip ? p1 : p0);
+        ends.push_back(flip ? p0 : p1);
+    }
+}
+
+}  // namespace
+
+TEST(CurveChainingTest, EmptyInputGivesEmptyChain) {
+    EXPECT_TRUE(chainCurveEndpoints({}, {}, TOLERANCE).empty());
+}
+
+TEST(CurveChainingTest, ChainsUnorderedSquareWithReversals) {
+    // Bottom, top (reversed), right, left
+    std::vector<Point3D> starts = {Point3D(0, 0, 0), Point3D(0, 1, 0), Point3D(1, 0, 0), Point3D(0, 1, 0)};
+    std::vector<Point3D> ends = {Point3D(1, 0, 0), Point3D(1, 1, 0), Point3D(1, 1, 0), Point3D(0, 0, 0)};
+
+    auto chain = chainCurveEndpoints(starts, ends, TOLERANCE);
+
+    ASSERT_EQ(chain.size(), 4u);
+    EXPECT_EQ(chain[1].index, 2u);
+    EXPECT_FALSE(chain[1].reversed);
+    EXPECT_EQ(chain[2].index, 1u);
+    EXPECT_TRUE(chain[2].reversed);
+    EXPECT_EQ(chain[3].index, 3u);
+    EXPECT_FALSE(chain[3].reversed);
+}
+
+TEST(CurveChainingTest, StopsAtFirstGap) {
+    std::vector<Point3D> starts = {Point3D(0, 0, 0), Point3D(1, 0, 0), Point3D(5, 5, 0)};
+    std::vector<Point3D> ends = {Point3D(1, 0, 0), Point3D(2, 0, 0), Point3D(6, 5, 0)};
+
+    auto chain = chainCurveEndpoints(starts, ends, TOLERANCE);
+
+    ASSERT_EQ(chain.size(), 2u);
+    EXPECT_EQ(chain[1].index, 1u);
+}
+
+TEST(CurveChainingTest, MatchesAcrossCellBoundaries) {
+    // Endpoints just under the tolerance apart straddle a hash cell edge
+    std::vector<Point3D> starts = {Point3D(0, 0, 0), Point3D(0.0010005 - 0.0009, 0.0019995, 0)};
+    std::vector<Point3D> ends = {Point3D(0.0010005, 0.0020005, 0), Point3D(3, 3, 0)};
+
+    auto chain = chainCurveEndpoints(starts, ends, TOLERANCE);
+
+    ASSERT_EQ(chain.size(), 2u);
+    EXPECT_FALSE(chain[1].reversed);
+}
+
+TEST(CurveChainingTest, MatchesLinearScanOnLargeShuffledProfile) {
+    std::vector<Point3D> starts;
+    std::vector<Point3D> ends;
+    makeShuffledRing(600, starts, ends);
+
+    auto chain = chainCurveEndpoints(starts, ends, TOLERANCE);
+    auto reference = chainByScan(starts, ends, TOLERANCE);
+
+    ASSERT_EQ(chain.size(), starts.size());
+    ASSERT_EQ(chain.size(), reference.size());
+    for (size_t i = 0; i < chain.size(); ++i) {
+        EXPECT_EQ(chain[i].index, reference[i].index) << "position " << i;
+        EXPECT_EQ(chain[i].reversed, reference[i].reversed) << "position " << i;
+    }
+}
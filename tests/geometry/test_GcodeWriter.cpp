@@ -0,0 +1,158 @@
+/**
+ * test_GcodeWriter.cpp
+ *
+ * Unit tests for streaming G-code output and helical arc fitting.
+ * Verifies the program frame, the feed placement, G2/G3 center offsets, and
+ * that paths whose Z does not follow the sweep stay G1 moves.
+ */
+
+#include <gtest/gtest.h>
+
+#include <cmath>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "geometry/GcodeWriter.h"
+
+using namespace ChipCarving::Geometry;
+
+namespace {
+
+// Quarter circle around the origin, Z from z0 to z1 linearly in the sweep
+std::vector<Point3D> helix(double radius, int count, double z0, double z1) {
+    std::vector<Point3D> points;
+    for (int i = 0; i < count; ++i) {
+        double t = static_cast<double>(i) / (count - 1);
+        double angle = 0.5 * M_PI * t;
+        points.emplace_back(radius * std::cos(angle), radius * std::sin(angle), z0 + (z1 - z0) * t);
+    }
+    return points;
+}
+
+size_t countOccurrences(const std::string& text, const std::string& needle) {
+    size_t count = 0;
+    for (size_t pos = text.find(needle); pos != std::string::npos; pos = text.find(needle, pos + needle.size())) {
+        ++count;
+    }
+    return count;
+}
+
+}  // namespace
+
+TEST(GcodeWriterTest, WritesProgramFrame) {
+    GcodePost post;
+    post.decimals = 3;
+    std::ostringstream out;
+    GcodeWriter writer(out, post);
+    writer.begin("V-carve (60 deg)");
+    writer.end();
+
+    EXPECT_EQ(out.str(), "(V-carve _60 deg_)\nG21 G90 G17\nG0 Z5.000\nM3 S18000\nM5\nM2\n");
+    EXPECT_EQ(writer.pathCount(), 0u);
+}
+
+TEST(GcodeWriterTest, NoSpindleCommandsWhenRpmIsZero) {
+    GcodePost post;
+    post.spindleRpm = 0;
+    std::ostringstream out;
+    GcodeWriter writer(out, post);
+    writer.begin("job");
+    writer.end();
+
+    EXPECT_EQ(out.str().find("M3"), std::string::npos);
+    EXPECT_EQ(out.str().find("M5"), std::string::npos);
+}
+
+TEST(GcodeWriterTest, LinesCarryFeedOnFirstCut) {
+    GcodePost post;
+    post.decimals = 2;
+    post.feedRate = 800;
+    post.plungeRate = 200;
+    std::ostringstream out;
+    GcodeWriter writer(out, post);
+    writer.writePath({Point3D(0, 0, -0.5), Point3D(10, 0, -1), Point3D(10, 5, -0.25)});
+
+    EXPECT_EQ(out.str(),
+              "G0 X0.00 Y0.00\n"
+              "G1 Z-0.50 F200.00\n"
+              "G1 X10.00 Y0.00 Z-1.00 F800.00\n"
+              "G1 X10.00 Y5.00 Z-0.25\n"
+              "G0 Z5.00\n");
+    EXPECT_EQ(writer.pathCount(), 1u);
+    EXPECT_EQ(writer.lineCount(), 2u);
+    EXPECT_EQ(writer.arcCount(), 0u);
+}
+
+TEST(GcodeWriterTest, HelicalQuarterArcBecomesG3) {
+    GcodePost post;
+    post.decimals = 3;
+    std::ostringstream out;
+    GcodeWriter writer(out, post);
+    writer.writePath(helix(5.0, 30, -0.5, -1.5));
+
+    // Counterclockwise from (5, 0) to (0, 5) around the origin
+    EXPECT_NE(out.str().find("G3 X0.000 Y5.000 Z-1.500 I-5.000 J0.000 F1000.000\n"), std::string::npos) << out.str();
+    EXPECT_EQ(writer.arcCount(), 1u);
+    EXPECT_EQ(writer.lineCount(), 0u);
+}
+
+TEST(GcodeWriterTest, ClockwiseArcBecomesG2) {
+    auto points = helix(5.0, 30, -1.0, -1.0);
+    std::vector<Point3D> reversed(points.rbegin(), points.rend());
+    std::ostringstream out;
+    GcodeWriter writer(out, GcodePost());
+    writer.writePath(reversed);
+
+    EXPECT_NE(out.str().find("G2 X5.0000 Y0.0000 Z-1.0000 I0.0000 J-5.0000"), std::string::npos) << out.str();
+}
+
+TEST(GcodeWriterTest, NonLinearDepthIsSplit) {
+    // V-carve depth bulging in the middle of a circular run cannot be one helix;
+    // it is followed by shorter arcs and lines instead
+    auto points = helix(5.0, 30, -1.0, -1.0);
+    for (size_t i = 0; i < points.size(); ++i) {
+        double t = static_cast<double>(i) / (points.size() - 1);
+        points[i].z = -1.0 - std::sin(M_PI * t);
+    }
+    std::ostringstream out;
+    GcodeWriter writer(out, GcodePost());
+    writer.writePath(points);
+
+    EXPECT_GT(writer.arcCount() + writer.lineCount(), 2u);
+    EXPECT_LT(writer.lineCount(), points.size() - 1);
+    EXPECT_NE(out.str().find(" X0.0000 Y5.0000 Z-1.0000"), std::string::npos) << out.str();
+    EXPECT_EQ(countOccurrences(out.str(), " F1000.0000\n"), 1u);
+}
+
+TEST(GcodeWriterTest, ZeroToleranceWritesLinesOnly) {
+    GcodePost post;
+    post.arcTolerance = 0.0;
+    std::ostringstream out;
+    GcodeWriter writer(out, post);
+    writer.writePath(helix(5.0, 30, -0.5, -1.5));
+
+    EXPECT_EQ(writer.arcCount(), 0u);
+    EXPECT_EQ(writer.lineCount(), 29u);
+}
+
+TEST(GcodeWriterTest, VCarvePathUsesNegativeDepth) {
+    VCarvePath path;
+    path.points.emplace_back(Point2D(1, 2), 0.5, 0.0);
+    path.points.emplace_back(Point2D(3, 2), 0.25, 0.0);
+    std::ostringstream out;
+    GcodeWriter writer(out, GcodePost());
+    writer.writePath(path);
+
+    EXPECT_NE(out.str().find("G1 Z-0.5000 F300.0000\n"), std::string::npos) << out.str();
+    EXPECT_NE(out.str().find("G1 X3.0000 Y2.0000 Z-0.2500 F1000.0000\n"), std::string::npos) << out.str();
+}
+
+TEST(GcodeWriterTest, PathsShorterThanTwoPointsAreSkipped) {
+    std::ostringstream out;
+    GcodeWriter writer(out, GcodePost());
+    writer.writePath(std::vector<Point3D>{Point3D(1, 1, -1)});
+
+    EXPECT_TRUE(out.str().empty());
+    EXPECT_EQ(writer.pathCount(), 0u);
+}
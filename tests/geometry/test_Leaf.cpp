@@ -155,6 +155,16 @@ TEST_F(LeafTest, Contains) {
     EXPECT_FALSE(leafCustom->contains(insideOne));
 }
 
+TEST_F(LeafTest, ContainsMatchesTheDrawnArcs) {
+    // Arc midpoints are on the boundary; just beyond them is outside
+    Point2D centroid = leafCustom->getCentroid();
+    for (const auto& edge : leafCustom->getBoundaryEdges()) {
+        EXPECT_TRUE(leafCustom->contains(edge.mid));
+        Point2D beyond(edge.mid.x + 0.01 * (edge.mid.x - centroid.x), edge.mid.y + 0.01 * (edge.mid.y - centroid.y));
+        EXPECT_FALSE(leafCustom->contains(beyond));
+    }
+}
+
 
 TEST_F(LeafTest, InvalidGeometryHandling) {
     // Create leaf with invalid geometry (radius too small)
@@ -195,4 +205,26 @@ TEST_F(LeafTest, DiagonalOrientation) {
     EXPECT_NEAR(distance(centers.first, d2), 8.0, TOLERANCE);
     EXPECT_NEAR(distance(centers.second, d1), 8.0, TOLERANCE);
     EXPECT_NEAR(distance(centers.second, d2), 8.0, TOLERANCE);
-}
\ No newline at end of file
+}
+
+TEST_F(LeafTest, BoundsCoverBothArcs) {
+    // Horizontal foci: the arcs bulge by the sagitta above and below the chord
+    ShapeBounds bounds = leaf->getBounds();
+    double sagitta = leaf->getSagitta();
+    EXPECT_NEAR(bounds.min.x, 0.0, TOLERANCE);
+    EXPECT_NEAR(bounds.max.x, 10.0, TOLERANCE);
+    EXPECT_NEAR(bounds.min.y, -sagitta, TOLERANCE);
+    EXPECT_NEAR(bounds.max.y, sagitta, TOLERANCE);
+
+    // Rotated a quarter turn the box rotates with it
+    Leaf vertical(Point2D(0.0, 0.0), Point2D(0.0, 10.0), defaultRadius);
+    bounds = vertical.getBounds();
+    EXPECT_NEAR(bounds.min.x, -sagitta, TOLERANCE);
+    EXPECT_NEAR(bounds.max.x, sagitta, TOLERANCE);
+    EXPECT_NEAR(bounds.max.y, 10.0, TOLERANCE);
+
+    // Every boundary edge midpoint lies inside the box
+    for (const auto& edge : leaf->getBoundaryEdges()) {
+        EXPECT_TRUE(leaf->getBounds().contains(edge.mid, TOLERANCE));
+    }
+}
@@ -0,0 +1,163 @@
+/**
+ * test_MedialAxisBatch.cpp
+ *
+ * Unit tests for the worker-pool medial axis batch computation.
+ * Verifies ordering, parity with sequential processing, per-profile failure isolation,
+ * progress reporting and cancellation, and engine choice through the standard engine set.
+ */
+
+#include <gtest/gtest.h>
+
+#include <vector>
+
+#include "geometry/MedialAxisBatch.h"
+#include "geometry/MedialAxisEngine.h"
+#include "geometry/MedialAxisProcessor.h"
+#include "geometry/Point2D.h"
+#include "utils/JobProgress.h"
+
+using namespace ChipCarving::Geometry;
+
+namespace {
+
+std::vector<Point2D> makeSquare(double x, double y, double size) {
+    return {Point2D(x, y), Point2D(x + size, y), Point2D(x + size, y + size), Point2D(x, y + size)};
+}
+
+std::vector<std::vector<Point2D>> makeMixedBatch() {
+    std::vector<std::vector<Point2D>> polygons;
+    for (int i = 0; i < 8; ++i) {
+        polygons.push_back(makeSquare(i * 5.0, 0.0, 1.0 + i * 0.5));
+    }
+    // Degenerate polygon in the middle of the batch
+    polygons.insert(polygons.begin() + 3, std::vector<Point2D>{Point2D(0, 0), Point2D(1, 0)});
+    return polygons;
+}
+
+}  // namespace
+
+TEST(MedialAxisBatchTest, ResolveWorkerCountClampsToJobCount) {
+    EXPECT_EQ(resolveMedialAxisWorkerCount(8, 3), 3);
+    EXPECT_EQ(resolveMedialAxisWorkerCount(2, 10), 2);
+    EXPECT_EQ(resolveMedialAxisWorkerCount(1, 10), 1);
+    EXPECT_EQ(resolveMedialAxisWorkerCount(4, 0), 1);
+    EXPECT_EQ(resolveMedialAxisWorkerCount(-3, 1), 1);
+
+    int automatic = resolveMedialAxisWorkerCount(0, 1000);
+    EXPECT_GE(automatic, 1);
+    EXPECT_LE(automatic, 1000);
+}
+
+TEST(MedialAxisBatchTest, EmptyBatchReturnsNoResults) {
+    MedialAxisProcessor prototype;
+    EXPECT_TRUE(computeMedialAxisBatch({}, prototype, 4).empty());
+}
+
+TEST(MedialAxisBatchTest, FailedProfileStaysAtItsIndex) {
+    MedialAxisProcessor prototype;
+    auto polygons = makeMixedBatch();
+
+    auto results = computeMedialAxisBatch(polygons, prototype, 4);
+
+    ASSERT_EQ(results.size(), polygons.size());
+    EXPECT_FALSE(results[3].success);
+    EXPECT_FALSE(results[3].errorMessage.empty());
+}
+
+TEST(MedialAxisBatchTest, ProfilesGoThroughTheStandardEngines) {
+    MedialAxisProcessor processor(0.25, 0.8);
+    processor.setStraightSkeleton(true);
+    MedialAxisEngineSet engines = MedialAxisEngineSet::standard(processor, false);
+    std::vector<Point2D> triangle = {Point2D(0, 0), Point2D(6, 0), Point2D(3, 4)};
+    MedialAxisProfile profile;
+    profile.polygon = &triangle;
+    MedialAxisResults expected;
+    ASSERT_EQ(engines.compute(profile, expected), 0u);  // The straight skeleton
+
+    MedialAxisResults results = computeMedialAxisProfile(processor, triangle);
+    ASSERT_TRUE(results.success);
+    EXPECT_EQ(results.chains.size(), expected.chains.size());
+    EXPECT_DOUBLE_EQ(results.totalLength, expected.totalLength);
+
+    // OpenVoronoi's own message for what it cannot take
+    MedialAxisResults degenerate = computeMedialAxisProfile(processor, {Point2D(0, 0), Point2D(1, 0)});
+    EXPECT_FALSE(degenerate.success);
+    EXPECT_EQ(degenerate.errorMessage, "Polygon must have at least 3 vertices");
+}
+
+TEST(MedialAxisBatchTest, ParallelMatchesSequential) {
+    MedialAxisProcessor prototype(0.25, 0.8);
+    auto polygons = makeMixedBatch();
+
+    auto sequential = computeMedialAxisBatch(polygons, prototype, 1);
+    auto parallel = computeMedialAxisBatch(polygons, prototype, 4);
+
+    ASSERT_EQ(sequential.size(), parallel.size());
+    for (size_t i = 0; i < sequential.size(); ++i) {
+        EXPECT_EQ(sequential[i].success, parallel[i].success) << "profile " << i;
+        EXPECT_EQ(sequential[i].errorMessage, parallel[i].errorMessage) << "profile " << i;
+        EXPECT_EQ(sequential[i].chains.size(), parallel[i].chains.size()) << "profile " << i;
+        EXPECT_EQ(sequential[i].totalPoints, parallel[i].totalPoints) << "profile " << i;
+        EXPECT_DOUBLE_EQ(sequential[i].totalLength, parallel[i].totalLength) << "profile " << i;
+    }
+}
+
+TEST(MedialAxisBatchTest, AdvancesProgressPerProfile) {
+    MedialAxisProcessor prototype;
+    auto polygons = makeMixedBatch();
+    ChipCarving::Utils::JobProgress progress;
+    progress.beginStage("medial", polygons.size());
+
+    auto results = computeMedialAxisBatch(polygons, prototype, 4, &progress);
+
+    ASSERT_EQ(results.size(), polygons.size());
+    EXPECT_EQ(progress.snapshot().completed, polygons.size());
+}
+
+TEST(MedialAxisBatchTest, CancelledBatchSkipsRemainingProfiles) {
+    MedialAxisProcessor prototype;
+    auto polygons = makeMixedBatch();
+    ChipCarving::Utils::JobProgress progress;
+    progress.cancel();
+
+    for (int workers : {1, 4}) {
+        auto results = computeMedialAxisBatch(polygons, prototype, workers, &progress);
+
+        ASSERT_EQ(results.size(), polygons.size());
+        for (size_t i = 0; i < results.size(); ++i) {
+            EXPECT_FALSE(results[i].success) << "profile " << i;
+            EXPECT_EQ(results[i].errorMessage, "Cancelled") << "profile " << i;
+        }
+    }
+    EXPECT_EQ(progress.snapshot().completed, 0u);
+}
+
+TEST(MedialAxisBatchTest, RepeatedShapesAreComputedOnce) {
+    MedialAxisProcessor prototype;
+    auto polygons = makeMixedBatch();
+    ChipCarving::Utils::JobProgress progress;
+    progress.beginStage("medial", polygons.size());
+
+    // The eight squares differ only in position and size
+    size_t sharedCount = 0;
+    auto results = computeDeduplicatedMedialAxisBatch(polygons, prototype, 4, &progress, nullptr, &sharedCount);
+
+    ASSERT_EQ(results.size(), polygons.size());
+    EXPECT_EQ(sharedCount, 7u);
+    EXPECT_FALSE(results[3].success);
+    for (size_t i = 0; i < results.size(); ++i) {
+        if (i != 3) {
+            EXPECT_TRUE(results[i].success) << "profile " << i;
+        }
+    }
+    EXPECT_EQ(progress.snapshot().completed, polygons.size());
+
+    // Holes keep a profile out of the sharing
+    std::vector<std::vector<std::vector<Point2D>>> holes(polygons.size());
+    holes[0] = {makeSquare(0.25, 0.25, 0.5)};
+    computeDeduplicatedMedialAxisBatch(polygons, prototype, 4, nullptr, &holes, &sharedCount);
+    EXPECT_EQ(sharedCount, 6u);
+    holes[1] = {makeSquare(5.25, 0.25, 0.5)};
+    computeDeduplicatedMedialAxisBatch(polygons, prototype, 4, nullptr, &holes, &sharedCount);
+    EXPECT_EQ(sharedCount, 5u);
+}
@@ -0,0 +1,153 @@
+/**
+ * test_MedialAxisCache.cpp
+ *
+ * Unit tests for the content-addressed medial axis LRU cache.
+ * Verifies key hashing, hit/miss behavior, and memory budget eviction.
+ */
+
+#include <gtest/gtest.h>
+
+#include <vector>
+
+#include "geometry/MedialAxisCache.h"
+#include "geometry/MedialAxisProcessor.h"
+
+using namespace ChipCarving::Geometry;
+
+namespace {
+
+std::vector<Point2D> makeSquare(double size) {
+    return {Point2D(0, 0), Point2D(size, 0), Point2D(size, size), Point2D(0, size)};
+}
+
+MedialAxisResults makeResults(size_t points, double clearance = 1.0) {
+    MedialAxisResults results;
+    results.chains.addChain(std::vector<Point2D>(points, Point2D(1.0, 2.0)), std::vector<double>(points, clearance));
+    results.numChains = 1;
+    results.totalPoints = static_cast<int>(points);
+    results.success = true;
+    return results;
+}
+
+}  // namespace
+
+TEST(MedialAxisCacheTest, KeyDependsOnGeometryAndParameters) {
+    MedialAxisProcessor processor(0.25, 0.8);
+    uint64_t key = MedialAxisCache::computeKey(makeSquare(1.0), processor);
+
+    EXPECT_EQ(key, MedialAxisCache::computeKey(makeSquare(1.0), processor));
+    EXPECT_NE(key, MedialAxisCache::computeKey(makeSquare(1.001), processor));
+
+    MedialAxisProcessor otherTolerance(0.1, 0.8);
+    EXPECT_NE(key, MedialAxisCache::computeKey(makeSquare(1.0), otherTolerance));
+
+    MedialAxisProcessor otherThreshold(0.25, 0.7);
+    EXPECT_NE(key, MedialAxisCache::computeKey(makeSquare(1.0), otherThreshold));
+
+    MedialAxisProcessor otherWalk(0.25, 0.8);
+    otherWalk.setMedialAxisWalkPoints(5);
+    EXPECT_NE(key, MedialAxisCache::computeKey(makeSquare(1.0), otherWalk));
+
+    MedialAxisProcessor skeleton(0.25, 0.8);
+    skeleton.setStraightSkeleton(true);
+    EXPECT_NE(key, MedialAxisCache::computeKey(makeSquare(1.0), skeleton));
+
+    MedialAxisProcessor partitioned(0.25, 0.8);
+    partitioned.setPartitioning(2000);
+    uint64_t partitionedKey = MedialAxisCache::computeKey(makeSquare(1.0), partitioned);
+    EXPECT_NE(key, partitionedKey);
+    partitioned.setPartitioning(4000);
+    EXPECT_NE(partitionedKey, MedialAxisCache::computeKey(makeSquare(1.0), partitioned));
+    partitioned.setPartitioning(0, 4);  // Off again, whatever the worker count
+    EXPECT_EQ(key, MedialAxisCache::computeKey(makeSquare(1.0), partitioned));
+
+    MedialAxisProcessor clearing(0.25, 0.8);
+    ClearingOffsets offsets;
+    offsets.firstOffset = 0.3;
+    offsets.stepover = 0.1;
+    clearing.setClearingOffsets(offsets);
+    uint64_t clearingKey = MedialAxisCache::computeKey(makeSquare(1.0), clearing);
+    EXPECT_NE(key, clearingKey);
+    offsets.stepover = 0.2;
+    clearing.setClearingOffsets(offsets);
+    EXPECT_NE(clearingKey, MedialAxisCache::computeKey(makeSquare(1.0), clearing));
+}
+
+TEST(MedialAxisCacheTest, LookupHitAndMiss) {
+    MedialAxisCache cache;
+    MedialAxisResults out;
+
+    EXPECT_FALSE(cache.lookup(42, out));
+    cache.insert(42, makeResults(10, 0.5));
+
+    ASSERT_TRUE(cache.lookup(42, out));
+    EXPECT_TRUE(out.success);
+    ASSERT_EQ(out.chains.size(), 1u);
+    EXPECT_EQ(out.chains[0].size(), 10u);
+    EXPECT_DOUBLE_EQ(out.chains[0].clearance(3), 0.5);
+    EXPECT_EQ(cache.getHits(), 1u);
+    EXPECT_EQ(cache.getMisses(), 1u);
+}
+
+TEST(MedialAxisCacheTest, InsertReplacesExistingKey) {
+    MedialAxisCache cache;
+    cache.insert(7, makeResults(10));
+    size_t bytesBefore = cache.getBytesUsed();
+    cache.insert(7, makeResults(1000));
+
+    EXPECT_EQ(cache.size(), 1u);
+    EXPECT_GT(cache.getBytesUsed(), bytesBefore);
+
+    MedialAxisResults out;
+    ASSERT_TRUE(cache.lookup(7, out));
+    EXPECT_EQ(out.chains[0].size(), 1000u);
+}
+
+TEST(MedialAxisCacheTest, EvictsLeastRecentlyUsed) {
+    size_t entryBytes = MedialAxisCache::estimateBytes(makeResults(100));
+    MedialAxisCache cache(entryBytes * 3);
+
+    cache.insert(1, makeResults(100));
+    cache.insert(2, makeResults(100));
+    cache.insert(3, makeResults(100));
+
+    MedialAxisResults out;
+    ASSERT_TRUE(cache.lookup(1, out));  // 2 is now least recently used
+
+    cache.insert(4, makeResults(100));
+    EXPECT_EQ(cache.size(), 3u);
+    EXPECT_LE(cache.getBytesUsed(), cache.getMaxBytes());
+    EXPECT_FALSE(cache.lookup(2, out));
+    EXPECT_TRUE(cache.lookup(1, out));
+    EXPECT_TRUE(cache.lookup(3, out));
+    EXPECT_TRUE(cache.lookup(4, out));
+}
+
+TEST(MedialAxisCacheTest, OversizedResultsAreNotCached) {
+    MedialAxisCache cache(1024);
+    cache.insert(1, makeResults(10000));
+
+    MedialAxisResults out;
+    EXPECT_FALSE(cache.lookup(1, out));
+    EXPECT_EQ(cache.getBytesUsed(), 0u);
+}
+
+TEST(MedialAxisCacheTest, ShrinkingBudgetEvicts) {
+    MedialAxisCache cache;
+    for (uint64_t key = 0; key < 10; ++key) {
+        cache.insert(key, makeResults(100));
+    }
+    ASSERT_EQ(cache.size(), 10u);
+
+    cache.setMaxBytes(MedialAxisCache::estimateBytes(makeResults(100)) * 2);
+    EXPECT_EQ(cache.size(), 2u);
+
+    MedialAxisResults out;
+    EXPECT_TRUE(cache.lookup(9, out));
+    EXPECT_TRUE(cache.lookup(8, out));
+
+    cache.clear();
+    EXPECT_EQ(cache.size(), 0u);
+    EXPECT_EQ(cache.getBytesUsed(), 0u);
+    EXPECT_EQ(cache.getHits(), 0u);
+}
@@ -0,0 +1,81 @@
+/**
+ * test_MedialAxisChains.cpp
+ *
+ * Unit tests for the flat structure-of-arrays medial axis chain storage.
+ * Verifies chain views, incremental construction, and bulk assignment.
+ */
+
+#include <gtest/gtest.h>
+
+#include <vector>
+
+#include "geometry/MedialAxisChains.h"
+
+using namespace ChipCarving::Geometry;
+
+TEST(MedialAxisChainsTest, ChainsShareFlatStorage) {
+    MedialAxisChains chains;
+    ASSERT_TRUE(chains.addChain({Point2D(0, 0), Point2D(1, 0.5), Point2D(2, 0)}, {0.0, 0.75, 0.0}));
+    ASSERT_TRUE(chains.addChain({Point2D(1, 0.5), Point2D(1, 3)}, {0.75, 0.1}));
+
+    ASSERT_EQ(chains.size(), 2u);
+    EXPECT_EQ(chains.pointCount(), 5u);
+    EXPECT_EQ(chains.xs().size(), 5u);
+    EXPECT_EQ(chains.offsets(), (std::vector<size_t>{0, 3, 5}));
+
+    auto second = chains[1];
+    ASSERT_EQ(second.size(), 2u);
+    EXPECT_DOUBLE_EQ(second.front().x, 1.0);
+    EXPECT_DOUBLE_EQ(second.back().y, 3.0);
+    EXPECT_DOUBLE_EQ(second.clearance(0), 0.75);
+    EXPECT_EQ(second.xData(), chains.xs().data() + 3);
+}
+
+TEST(MedialAxisChainsTest, IteratesChainsThenPoints) {
+    auto chains = MedialAxisChains::fromNested({{Point2D(0, 0), Point2D(1, 0)}, {Point2D(2, 2)}}, {{0.1, 0.2}, {0.3}});
+
+    size_t chainCount = 0;
+    double sumX = 0.0;
+    for (const auto& chain : chains) {
+        for (const auto& point : chain) {
+            sumX += point.x;
+        }
+        chainCount++;
+    }
+    EXPECT_EQ(chainCount, 2u);
+    EXPECT_DOUBLE_EQ(sumX, 3.0);
+    EXPECT_EQ(chains[0].clearances(), (std::vector<double>{0.1, 0.2}));
+    EXPECT_EQ(chains[1].points().size(), 1u);
+}
+
+TEST(MedialAxisChainsTest, AppendsPointsToCurrentChain) {
+    MedialAxisChains chains;
+    chains.beginChain();
+    chains.addPoint(Point2D(0, 0), 0.0);
+    chains.addPoint(Point2D(1, 1), 0.5);
+    chains.beginChain();
+    chains.addPoint(Point2D(2, 2), 0.25);
+
+    ASSERT_EQ(chains.size(), 2u);
+    EXPECT_EQ(chains[0].size(), 2u);
+    EXPECT_EQ(chains[1].size(), 1u);
+    EXPECT_DOUBLE_EQ(chains[1].clearance(0), 0.25);
+
+    chains.clear();
+    EXPECT_TRUE(chains.empty());
+    EXPECT_EQ(chains.pointCount(), 0u);
+}
+
+TEST(MedialAxisChainsTest, RejectsInconsistentInput) {
+    MedialAxisChains chains;
+    EXPECT_FALSE(chains.addChain({Point2D(0, 0), Point2D(1, 0)}, {0.1}));
+    EXPECT_TRUE(chains.empty());
+
+    EXPECT_FALSE(chains.assign({0.0, 1.0}, {0.0, 1.0}, {0.1, 0.2}, {0, 3}));
+    EXPECT_FALSE(chains.assign({0.0, 1.0}, {0.0}, {0.1, 0.2}, {0, 2}));
+    EXPECT_TRUE(chains.empty());
+
+    ASSERT_TRUE(chains.assign({0.0, 1.0, 2.0}, {0.0, 1.0, 2.0}, {0.1, 0.2, 0.3}, {0, 1, 3}));
+    ASSERT_EQ(chains.size(), 2u);
+    EXPECT_DOUBLE_EQ(chains[1][1].x, 2.0);
+}
@@ -0,0 +1,310 @@
+/**
+ * test_MedialAxisDiskCache.cpp
+ *
+ * Unit tests for the persistent on-disk medial axis cache.
+ * Verifies round-tripping, engine version isolation, rejection of damaged files,
+ * and immutable publication and the key index of a cache shared between machines.
+ */
+
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "geometry/MedialAxisDiskCache.h"
+
+using namespace ChipCarving::Geometry;
+
+class MedialAxisDiskCacheTest : public ::testing::Test {
+   protected:
+    void SetUp() override {
+        directory = (std::filesystem::path(::testing::TempDir()) / "medial_axis_disk_cache_test").string();
+        std::filesystem::remove_all(directory);
+    }
+
+    void TearDown() override {
+        std::filesystem::remove_all(directory);
+    }
+
+    static MedialAxisResults makeResults() {
+        MedialAxisResults results;
+        results.chains = MedialAxisChains::fromNested(
+            {{Point2D(0, 0), Point2D(1, 0.5), Point2D(2, 0)}, {Point2D(1, 0.5), Point2D(1, 3)}},
+            {{0.0, 0.75, 0.0}, {0.75, 0.1}});
+        results.numChains = 2;
+        results.totalPoints = 5;
+        results.totalLength = 4.736;
+        results.minClearance = 0.0;
+        results.maxClearance = 0.75;
+        results.transform.offset = Point2D(1.0, 1.5);
+        results.transform.scale = 0.283;
+        results.transform.originalMin = Point2D(0, 0);
+        results.transform.originalMax = Point2D(2, 3);
+        results.success = true;
+        return results;
+    }
+
+    std::string directory;
+};
+
+TEST_F(MedialAxisDiskCacheTest, StoreAndLoadRoundTrip) {
+    MedialAxisDiskCache cache(directory, "test-engine");
+    ASSERT_TRUE(cache.isEnabled());
+
+    MedialAxisResults original = makeResults();
+    ASSERT_TRUE(cache.store(0x1234, original));
+
+    MedialAxisResults loaded;
+    ASSERT_TRUE(cache.load(0x1234, loaded));
+    EXPECT_TRUE(loaded.success);
+    ASSERT_EQ(loaded.chains.size(), original.chains.size());
+    for (size_t i = 0; i < original.chains.size(); ++i) {
+        ASSERT_EQ(loaded.chains[i].size(), original.chains[i].size());
+        for (size_t j = 0; j < original.chains[i].size(); ++j) {
+            EXPECT_DOUBLE_EQ(loaded.chains[i][j].x, original.chains[i][j].x);
+            EXPECT_DOUBLE_EQ(loaded.chains[i][j].y, original.chains[i][j].y);
+            EXPECT_DOUBLE_EQ(loaded.chains[i].clearance(j), original.chains[i].clearance(j));
+        }
+    }
+    EXPECT_EQ(loaded.numChains, 2);
+    EXPECT_EQ(loaded.totalPoints, 5);
+    EXPECT_DOUBLE_EQ(loaded.totalLength, original.totalLength);
+    EXPECT_DOUBLE_EQ(loaded.maxClearance, original.maxClearance);
+    EXPECT_DOUBLE_EQ(loaded.transform.scale, original.transform.scale);
+    EXPECT_DOUBLE_EQ(loaded.transform.originalMax.y, original.transform.originalMax.y);
+}
+
+TEST_F(MedialAxisDiskCacheTest, PersistsAcrossInstances) {
+    {
+        MedialAxisDiskCache writer(directory, "test-engine");
+        ASSERT_TRUE(writer.store(99, makeResults()));
+    }
+
+    MedialAxisDiskCache reader(directory, "test-engine");
+    MedialAxisResults loaded;
+    EXPECT_TRUE(reader.load(99, loaded));
+    EXPECT_FALSE(reader.load(100, loaded));
+}
+
+TEST_F(MedialAxisDiskCacheTest, EngineVersionIsolatesEntries) {
+    MedialAxisDiskCache oldEngine(directory, "engine-1.0");
+    ASSERT_TRUE(oldEngine.store(7, makeResults()));
+
+    MedialAxisDiskCache newEngine(directory, "engine-2.0");
+    MedialAxisResults loaded;
+    EXPECT_FALSE(newEngine.load(7, loaded));
+    EXPECT_NE(oldEngine.pathForKey(7), newEngine.pathForKey(7));
+}
+
+TEST_F(MedialAxisDiskCacheTest, RejectsTruncatedFile) {
+    MedialAxisDiskCache cache(directory, "test-engine");
+    ASSERT_TRUE(cache.store(5, makeResults()));
+
+    std::string path = cache.pathForKey(5);
+    auto size = std::filesystem::file_size(path);
+    std::filesystem::resize_file(path, size - 8);
+
+    MedialAxisResults loaded;
+    EXPECT_FALSE(cache.load(5, loaded));
+    EXPECT_FALSE(loaded.success);
+}
+
+TEST_F(MedialAxisDiskCacheTest, RejectsForeignFile) {
+    MedialAxisDiskCache cache(directory, "test-engine");
+    {
+        std::ofstream out(cache.pathForKey(11), std::ios::binary);
+        out << "this is not a medial axis cache entry, just some text that is long enough";
+    }
+
+    MedialAxisResults loaded;
+    EXPECT_FALSE(cache.load(11, loaded));
+}
+
+TEST_F(MedialAxisDiskCacheTest, FailedResultsAreNotStored) {
+    MedialAxisDiskCache cache(directory, "test-engine");
+    MedialAxisResults failed;
+    failed.errorMessage = "OpenVoronoi computation failed";
+
+    EXPECT_FALSE(cache.store(3, failed));
+    EXPECT_FALSE(std::filesystem::exists(cache.pathForKey(3)));
+}
+
+TEST_F(MedialAxisDiskCacheTest, EmptyDirectoryDisablesCache) {
+    MedialAxisDiskCache cache("", "test-engine");
+    EXPECT_FALSE(cache.isEnabled());
+    EXPECT_FALSE(cache.store(1, makeResults()));
+}
+
+TEST_F(MedialAxisDiskCacheTest, TrimDropsStaleThenOldestEntries) {
+    MedialAxisDiskCache oldEngine(directory, "old-engine");
+    ASSERT_TRUE(oldEngine.store(1, makeResults()));
+    MedialAxisDiskCache cache(directory, "test-engine");
+    ASSERT_TRUE(cache.store(2, makeResults()));
+    ASSERT_TRUE(cache.store(3, makeResults()));
+    uint64_t entryBytes = std::filesystem::file_size(cache.pathForKey(2));
+
+    // Key 2 is written first
+    auto now = std::filesystem::file_time_type::clock::now();
+    std::filesystem::last_write_time(cache.pathForKey(2), now - std::chrono::hours(1));
+    std::filesystem::last_write_time(cache.pathForKey(3), now);
+    std::filesystem::last_write_time(oldEngine.pathForKey(1), now);
+
+    EXPECT_EQ(cache.trim(3 * entryBytes), 3 * entryBytes);
+    EXPECT_EQ(cache.trim(2 * entryBytes), 2 * entryBytes);
+    EXPECT_FALSE(std::filesystem::exists(oldEngine.pathForKey(1)));
+    EXPECT_EQ(cache.trim(entryBytes), entryBytes);
+    EXPECT_FALSE(std::filesystem::exists(cache.pathForKey(2)));
+
+    MedialAxisResults loaded;
+    EXPECT_TRUE(cache.load(3, loaded));
+    EXPECT_EQ(cache.trim(0), 0u);
+    EXPECT_FALSE(cache.load(3, loaded));
+}
+
+TEST_F(MedialAxisDiskCacheTest, PublishedEntriesAreNeverRewritten) {
+    MedialAxisDiskCache cache(directory, "test-engine");
+    ASSERT_TRUE(cache.store(8, makeResults()));
+    std::string path = cache.pathForKey(8);
+    auto written = std::filesystem::file_size(path);
+
+    MedialAxisResults other = makeResults();
+    other.totalLength = 1.0;
+    EXPECT_TRUE(cache.store(8, other));
+    MedialAxisResults loaded;
+    ASSERT_TRUE(cache.load(8, loaded));
+    EXPECT_DOUBLE_EQ(loaded.totalLength, makeResults().totalLength);
+    EXPECT_EQ(std::filesystem::file_size(path), written);
+}
+
+TEST_F(MedialAxisDiskCacheTest, ConcurrentWritersPublishOneCompleteEntry) {
+    std::vector<std::thread> writers;
+    std::vector<int> stored(8, 0);
+    for (size_t i = 0; i < stored.size(); ++i) {
+        writers.emplace_back([this, i, &stored]() {
+            MedialAxisDiskCache seat(directory, "test-engine", i % 2 == 0);
+            stored[i] = seat.store(21, makeResults()) ? 1 : 0;
+        });
+    }
+    for (auto& writer : writers) {
+        writer.join();
+    }
+    EXPECT_EQ(stored, std::vector<int>(stored.size(), 1));
+
+    MedialAxisDiskCache reader(directory, "test-engine", true);
+    MedialAxisResults loaded;
+    EXPECT_TRUE(reader.load(21, loaded));
+    for (const auto& entry : std::filesystem::directory_iterator(directory)) {
+        EXPECT_EQ(entry.path().string().find(".tmp."), std::string::npos) << entry.path();
+    }
+}
+
+TEST_F(MedialAxisDiskCacheTest, SharedCacheFindsEntriesThroughTheIndex) {
+    MedialAxisDiskCache seatA(directory, "test-engine", true);
+    MedialAxisDiskCache seatB(directory, "test-engine", true);
+    ASSERT_TRUE(seatA.isShared());
+    ASSERT_TRUE(seatA.store(31, makeResults()));
+    EXPECT_TRUE(std::filesystem::exists(std::filesystem::path(directory) / "index"));
+
+    // Seat B read the index before A published, and reads it again only after the refresh interval
+    MedialAxisResults loaded;
+    EXPECT_FALSE(seatB.load(31, loaded));
+    EXPECT_TRUE(seatB.store(31, makeResults()));  // Already published: indexed, not written again
+    EXPECT_TRUE(seatB.load(31, loaded));
+
+    MedialAxisDiskCache seatC(directory, "test-engine", true);
+    EXPECT_TRUE(seatC.load(31, loaded));
+    EXPECT_FALSE(seatC.load(32, loaded));
+
+    // An entry copied in without being indexed is not looked for
+    MedialAxisDiskCache local(directory, "test-engine");
+    std::filesystem::copy_file(local.pathForKey(31), local.pathForKey(33));
+    EXPECT_FALSE(seatC.load(33, loaded));
+}
+
+TEST_F(MedialAxisDiskCacheTest, DamagedPayloadIsDeletedAndStoredAgain) {
+    MedialAxisDiskCache cache(directory, "test-engine");
+    ASSERT_TRUE(cache.store(13, makeResults()));
+    std::string path = cache.pathForKey(13);
+    {
+        std::fstream file(path, std::ios::binary | std::ios::in | std::ios::out);
+        file.seekp(-3, std::ios::end);
+        file.put('\x7f');
+    }
+
+    MedialAxisResults loaded;
+    EXPECT_FALSE(cache.load(13, loaded));
+    EXPECT_FALSE(std::filesystem::exists(path));
+    ASSERT_TRUE(cache.store(13, makeResults()));
+    EXPECT_TRUE(cache.load(13, loaded));
+}
+
+TEST_F(MedialAxisDiskCacheTest, SharedDamagedPayloadIsLeftForTrim) {
+    MedialAxisDiskCache cache(directory, "test-engine", true);
+    ASSERT_TRUE(cache.store(14, makeResults()));
+    ASSERT_TRUE(cache.store(15, makeResults()));
+    std::string path = cache.pathForKey(14);
+    {
+        std::fstream file(path, std::ios::binary | std::ios::in | std::ios::out);
+        file.seekp(-3, std::ios::end);
+        file.put('\x7f');
+    }
+
+    MedialAxisResults loaded;
+    EXPECT_FALSE(cache.load(14, loaded));
+    EXPECT_TRUE(std::filesystem::exists(path));
+
+    // Trim deletes it within budget, and the key can be published again
+    uint64_t entryBytes = std::filesystem::file_size(cache.pathForKey(15));
+    EXPECT_EQ(cache.trim(2 * entryBytes), entryBytes);
+    EXPECT_FALSE(std::filesystem::exists(path));
+    EXPECT_TRUE(cache.load(15, loaded));
+    ASSERT_TRUE(cache.store(14, makeResults()));
+    EXPECT_TRUE(cache.load(14, loaded));
+}
+
+TEST_F(MedialAxisDiskCacheTest, TrimRewritesThisMachinesIndex) {
+    MedialAxisDiskCache cache(directory, "test-engine", true);
+    ASSERT_TRUE(cache.store(41, makeResults()));
+    ASSERT_TRUE(cache.store(42, makeResults()));
+    std::filesystem::path indexDirectory = std::filesystem::path(directory) / "index";
+    std::vector<std::filesystem::path> indexFiles;
+    for (const auto& entry : std::filesystem::directory_iterator(indexDirectory)) {
+        indexFiles.push_back(entry.path());
+    }
+    ASSERT_EQ(indexFiles.size(), 1u);
+    uint64_t recordBytes = std::filesystem::file_size(indexFiles[0]) / 2;
+
+    auto now = std::filesystem::file_time_type::clock::now();
+    std::filesystem::last_write_time(cache.pathForKey(41), now - std::chrono::hours(1));
+    uint64_t entryBytes = std::filesystem::file_size(cache.pathForKey(42));
+    EXPECT_EQ(cache.trim(entryBytes), entryBytes);
+    EXPECT_EQ(std::filesystem::file_size(indexFiles[0]), recordBytes);
+    for (const auto& entry : std::filesystem::directory_iterator(indexDirectory)) {
+        EXPECT_EQ(entry.path().string().find(".tmp."), std::string::npos) << entry.path();
+    }
+
+    MedialAxisResults loaded;
+    EXPECT_FALSE(cache.load(41, loaded));
+    MedialAxisDiskCache other(directory, "test-engine", true);
+    EXPECT_TRUE(other.load(42, loaded));
+}
+
+TEST_F(MedialAxisDiskCacheTest, TrimDeletesAbandonedTemporaries) {
+    MedialAxisDiskCache cache(directory, "test-engine");
+    ASSERT_TRUE(cache.store(4, makeResults()));
+    std::string abandoned = cache.pathForKey(5) + ".tmp.seat.1.0";
+    std::string inProgress = cache.pathForKey(6) + ".tmp.seat.1.1";
+    std::ofstream(abandoned) << "partial";
+    std::ofstream(inProgress) << "partial";
+    std::filesystem::last_write_time(abandoned, std::filesystem::file_time_type::clock::now() - std::chrono::hours(2));
+
+    uint64_t entryBytes = std::filesystem::file_size(cache.pathForKey(4));
+    EXPECT_EQ(cache.trim(entryBytes), entryBytes);
+    EXPECT_FALSE(std::filesystem::exists(abandoned));
+    EXPECT_TRUE(std::filesystem::exists(inProgress));
+}
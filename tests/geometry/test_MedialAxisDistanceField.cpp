@@ -0,0 +1,190 @@
+/**
+ * test_MedialAxisDistanceField.cpp
+ *
+ * Unit tests for the distance-field preview engine: ridge positions and
+ * clearances to about a pixel, holes, the pixel budget, threaded passes and
+ * the batch
+ */
+
+#include <gtest/gtest.h>
+
+#include <cmath>
+#include <vector>
+
+#include "geometry/MedialAxisDistanceField.h"
+#include "geometry/MedialAxisEngine.h"
+#include "geometry/Point2D.h"
+
+using namespace ChipCarving::Geometry;
+
+namespace {
+
+std::vector<Point2D> makeEllipse(double radiusX, double radiusY, int sides, bool clockwise = false) {
+    std::vector<Point2D> ellipse;
+    for (int i = 0; i < sides; ++i) {
+        double t = 2.0 * M_PI * i / sides * (clockwise ? -1.0 : 1.0);
+        ellipse.emplace_back(radiusX * std::cos(t), radiusY * std::sin(t));
+    }
+    return ellipse;
+}
+
+std::vector<Point2D> makeCircle(double radius, int sides, bool clockwise = false) {
+    return makeEllipse(radius, radius, sides, clockwise);
+}
+
+double pixelOf(const std::vector<Point2D>& polygon, const DistanceFieldOptions& options) {
+    double cost = estimateDistanceFieldCost(polygon, options);
+    Point2D low = polygon[0], high = polygon[0];
+    for (const auto& point : polygon) {
+        low = Point2D(std::min(low.x, point.x), std::min(low.y, point.y));
+        high = Point2D(std::max(high.x, point.x), std::max(high.y, point.y));
+    }
+    return std::sqrt((high.x - low.x) * (high.y - low.y) / cost);
+}
+
+}  // namespace
+
+TEST(MedialAxisDistanceFieldTest, RectangleRidgeAndClearance) {
+    std::vector<Point2D> rectangle = {Point2D(0, 0), Point2D(20, 0), Point2D(20, 4), Point2D(0, 4)};
+    DistanceFieldOptions options;
+    options.pixelSize = 0.1;
+    MedialAxisResults results;
+    ASSERT_TRUE(computeDistanceFieldMedialAxis(rectangle, {}, options, results)) << results.errorMessage;
+    EXPECT_TRUE(results.success);
+    EXPECT_EQ(static_cast<int>(results.chains.size()), results.numChains);
+    EXPECT_EQ(static_cast<int>(results.chains.pointCount()), results.totalPoints);
+    EXPECT_NEAR(results.maxClearance, 2.0, 0.15);
+
+    // The long middle run lies on y = 2 with clearance 2
+    int middle = 0;
+    for (size_t c = 0; c < results.chains.size(); ++c) {
+        auto chain = results.chains[c];
+        for (size_t i = 0; i < chain.size(); ++i) {
+            if (chain[i].x > 3.0 && chain[i].x < 17.0) {
+                EXPECT_NEAR(chain[i].y, 2.0, 0.1);
+                EXPECT_NEAR(chain.clearance(i), 2.0, 0.1);
+                ++middle;
+            }
+        }
+    }
+    EXPECT_GT(middle, 100);
+    // Plus the four corner branches, to within a few pixels of the corners
+    EXPECT_GT(results.totalLength, 16.0 + 4.0 * 2.0 * std::sqrt(2.0) - 1.0);
+}
+
+TEST(MedialAxisDistanceFieldTest, AnnulusGivesOneClosedRidge) {
+    std::vector<std::vector<Point2D>> holes = {makeCircle(6.0, 200, true)};
+    DistanceFieldOptions options;
+    MedialAxisResults results;
+    ASSERT_TRUE(computeDistanceFieldMedialAxis(makeCircle(10.0, 400), holes, options, results));
+    ASSERT_EQ(results.chains.size(), 1u);
+    auto loop = results.chains[0];
+    EXPECT_EQ(distance(loop.front(), loop.back()), 0.0);
+    double pixel = pixelOf(makeCircle(10.0, 400), options);
+    for (size_t i = 0; i < loop.size(); ++i) {
+        EXPECT_NEAR(std::hypot(loop[i].x, loop[i].y), 8.0, pixel);
+        EXPECT_NEAR(loop.clearance(i), 2.0, pixel);
+    }
+    EXPECT_NEAR(results.totalLength, 2.0 * M_PI * 8.0, 0.1 * 2.0 * M_PI * 8.0);
+}
+
+TEST(MedialAxisDistanceFieldTest, PixelBudgetBoundsTheGridWhateverTheVertexCount) {
+    // A 100k-vertex outline with a sawtooth costs what a plain ellipse does
+    std::vector<Point2D> jagged = makeEllipse(10.0, 5.0, 100000);
+    for (size_t i = 0; i < jagged.size(); i += 2) {
+        jagged[i] = jagged[i] * 0.999;
+    }
+    DistanceFieldOptions options;
+    options.maxPixels = 20000;
+    EXPECT_LT(estimateDistanceFieldCost(jagged, options), 1.1 * options.maxPixels);
+    EXPECT_DOUBLE_EQ(estimateDistanceFieldCost(jagged, options), estimateDistanceFieldCost(makeEllipse(10.0, 5.0, 64),
+                                                                                           options));
+    MedialAxisResults results;
+    ASSERT_TRUE(computeDistanceFieldMedialAxis(jagged, {}, options, results));
+    EXPECT_NEAR(results.maxClearance, 5.0, 2.0 * pixelOf(jagged, options));
+
+    // A coarser floor on the pixel size wins over the budget
+    options.pixelSize = 1.0;
+    EXPECT_LT(estimateDistanceFieldCost(jagged, options), 30.0 * 20.0);
+}
+
+TEST(MedialAxisDistanceFieldTest, ThreadedPassesMatchSequential) {
+    std::vector<Point2D> outline = {Point2D(0, 0), Point2D(30, 0), Point2D(30, 3), Point2D(12, 3), Point2D(12, 20),
+                                    Point2D(0, 20)};
+    DistanceFieldOptions options;
+    options.maxPixels = 200000;
+    MedialAxisResults sequential, threaded;
+    ASSERT_TRUE(computeDistanceFieldMedialAxis(outline, {}, options, sequential));
+    options.workers = 4;
+    ASSERT_TRUE(computeDistanceFieldMedialAxis(outline, {}, options, threaded));
+    EXPECT_EQ(threaded.totalPoints, sequential.totalPoints);
+    EXPECT_DOUBLE_EQ(threaded.totalLength, sequential.totalLength);
+    EXPECT_DOUBLE_EQ(threaded.maxClearance, sequential.maxClearance);
+}
+
+TEST(MedialAxisDistanceFieldTest, BatchKeepsOrderAndHonoursCancellation) {
+    std::vector<std::vector<Point2D>> polygons = {makeEllipse(8.0, 5.0, 200), makeEllipse(3.0, 1.0, 200),
+                                                  makeEllipse(6.0, 3.0, 200)};
+    DistanceFieldOptions options;
+    options.pixelSize = 0.05;
+    std::vector<MedialAxisResults> results = computeDistanceFieldMedialAxisBatch(polygons, options, 3);
+    ASSERT_EQ(results.size(), 3u);
+    const double radii[3] = {5.0, 1.0, 3.0};
+    for (size_t i = 0; i < results.size(); ++i) {
+        ASSERT_TRUE(results[i].success) << results[i].errorMessage;
+        EXPECT_NEAR(results[i].maxClearance, radii[i], 0.15);
+    }
+
+    ChipCarving::Utils::JobProgress progress;
+    progress.cancel();
+    results = computeDistanceFieldMedialAxisBatch(polygons, options, 1, &progress);
+    for (const auto& result : results) {
+        EXPECT_FALSE(result.success);
+        EXPECT_EQ(result.errorMessage, "Cancelled");
+    }
+}
+
+TEST(MedialAxisDistanceFieldTest, EngineAcceptsAnyPolygonAndRejectsDegenerateOnes) {
+    DistanceFieldMedialAxisEngine engine;
+    EXPECT_STREQ(engine.name(), "distance-field");
+
+    std::vector<Point2D> square = {Point2D(0, 0), Point2D(2, 0), Point2D(2, 2), Point2D(0, 2)};
+    MedialAxisProfile profile;
+    profile.polygon = &square;
+    MedialAxisResults results;
+    ASSERT_TRUE(engine.accepts(profile));
+    ASSERT_TRUE(engine.compute(profile, results));
+    EXPECT_NEAR(results.maxClearance, 1.0, 0.05);
+
+    std::vector<Point2D> flat = {Point2D(0, 0), Point2D(1, 0), Point2D(2, 0)};
+    profile.polygon = &flat;
+    EXPECT_FALSE(engine.compute(profile, results));
+    EXPECT_FALSE(results.success);
+}
+
+TEST(MedialAxisDistanceFieldTest, OptionsFollowTheProcessorAndSelectTheEngine) {
+    MedialAxisProcessor processor(0.05, 0.7);
+    SpurPruningOptions pruning;
+    pruning.minLength = 0.4;
+    processor.setSpurPruning(pruning);
+    DistanceFieldOptions options = distanceFieldOptions(processor, 3);
+    EXPECT_DOUBLE_EQ(options.pixelSize, 0.05);
+    EXPECT_DOUBLE_EQ(options.medialThreshold, 0.7);
+    EXPECT_DOUBLE_EQ(options.spurPruning.minLength, 0.4);
+    EXPECT_EQ(options.workers, 3);
+
+    MedialAxisEngineSet engines = MedialAxisEngineSet::distanceField(options);
+    ASSERT_EQ(engines.size(), 1u);
+    EXPECT_STREQ(engines.engine(0).name(), "distance-field");
+
+    // The batch computes through the same engine
+    std::vector<Point2D> ellipse = makeEllipse(8.0, 5.0, 200);
+    MedialAxisProfile profile;
+    profile.polygon = &ellipse;
+    MedialAxisResults single;
+    ASSERT_EQ(engines.compute(profile, single), 0u);
+    std::vector<MedialAxisResults> batch = computeDistanceFieldMedialAxisBatch({ellipse}, options, 1);
+    ASSERT_EQ(batch.size(), 1u);
+    EXPECT_EQ(batch[0].totalPoints, single.totalPoints);
+    EXPECT_DOUBLE_EQ(batch[0].totalLength, single.totalLength);
+}
@@ -0,0 +1,231 @@
+/**
+ * test_MedialAxisEngine.cpp
+ *
+ * Unit tests for medial axis engine selection by shape type and size
+ */
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <limits>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "ShapeTessellation.h"
+#include "geometry/Leaf.h"
+#include "geometry/MedialAxisEngine.h"
+#include "geometry/MedialAxisTruthData.h"
+#include "geometry/TriArc.h"
+
+using namespace ChipCarving::Geometry;
+using namespace ChipCarving::Testing;
+
+namespace {
+
+// Succeeds with a one-chain result, or fails, and counts its calls
+class FakeEngine : public IMedialAxisEngine {
+ public:
+    explicit FakeEngine(bool succeeds, int* calls) : succeeds_(succeeds), calls_(calls) {}
+
+    const char* name() const override {
+        return "fake";
+    }
+    bool accepts(const MedialAxisProfile& profile) const override {
+        return profile.polygon != nullptr;
+    }
+    bool compute(const MedialAxisProfile& /* profile */, MedialAxisResults& results) override {
+        ++*calls_;
+        results = MedialAxisResults();
+        results.success = succeeds_;
+        results.errorMessage = succeeds_ ? "" : "fake failure";
+        return succeeds_;
+    }
+
+ private:
+    bool succeeds_;
+    int* calls_;
+};
+
+double distanceToChains(const Point2D& p, const MedialAxisChains& chains) {
+    double best = std::numeric_limits<double>::max();
+    for (const auto& chain : chains) {
+        for (size_t i = 1; i < chain.size(); ++i) {
+            Point2D a = chain[i - 1];
+            Point2D b = chain[i];
+            double dx = b.x - a.x;
+            double dy = b.y - a.y;
+            double len2 = dx * dx + dy * dy;
+            double t = len2 > 0 ? std::max(0.0, std::min(1.0, ((p.x - a.x) * dx + (p.y - a.y) * dy) / len2)) : 0.0;
+            best = std::min(best, distance(p, Point2D(a.x + t * dx, a.y + t * dy)));
+        }
+    }
+    return best;
+}
+
+// Boost.Polygon chains follow the truth paths (the triangle's junction splits its first one) and their
+// clearances are the distance to the outline
+void expectBoostMatchesTruth(const std::string& truthFile, const std::vector<Point2D>& polygon, double threshold,
+                             double tolerance, size_t chainCount) {
+    MedialAxisChains truth;
+    ASSERT_TRUE(loadTruthFile(std::string(MEDIAL_AXIS_TRUTH_DIR) + "/" + truthFile, truth));
+
+    MedialAxisProcessor processor;
+    processor.setMedialThreshold(threshold);
+    BoostVoronoiMedialAxisEngine engine(processor);
+    MedialAxisProfile profile;
+    profile.polygon = &polygon;
+    MedialAxisResults results;
+    ASSERT_TRUE(engine.compute(profile, results)) << results.errorMessage;
+    EXPECT_EQ(results.chains.size(), chainCount) << truthFile;
+    EXPECT_EQ(results.numChains, static_cast<int>(results.chains.size()));
+    EXPECT_EQ(results.graph.edgeCount(), results.chains.size());
+
+    for (size_t i = 0; i < truth.size(); ++i) {
+        for (const auto& point : truth[i]) {
+            EXPECT_LT(distanceToChains(point, results.chains), tolerance) << truthFile << " path " << i;
+        }
+    }
+    for (const auto& chain : results.chains) {
+        for (size_t j = 0; j < chain.size(); ++j) {
+            EXPECT_NEAR(chain.clearance(j), distanceToPolygon(chain[j], polygon), 1e-6) << truthFile;
+        }
+    }
+}
+
+}  // namespace
+
+TEST(MedialAxisEngineTest, AnalyticEngineTakesUneditedLeaves) {
+    Leaf leaf(Point2D(0, 0), Point2D(30, 0));
+    std::vector<Point2D> polygon = tessellateLeaf(leaf);
+    MedialAxisProfile profile;
+    profile.polygon = &polygon;
+
+    AnalyticMedialAxisEngine analytic;
+    EXPECT_FALSE(analytic.accepts(profile));  // No source shape
+
+    profile.sourceShape = &leaf;
+    ASSERT_TRUE(analytic.accepts(profile));
+    MedialAxisResults results;
+    ASSERT_TRUE(analytic.compute(profile, results));
+    EXPECT_EQ(results.chains.size(), 1u);
+
+    std::vector<std::vector<Point2D>> holes = {{Point2D(14, -1), Point2D(16, -1), Point2D(15, 1)}};
+    profile.holes = &holes;
+    EXPECT_FALSE(analytic.accepts(profile));
+    EXPECT_EQ(profile.vertexCount(), polygon.size() + 3);
+}
+
+TEST(MedialAxisEngineTest, EditedShapesFallThroughToTheNextEngine) {
+    Leaf leaf(Point2D(0, 0), Point2D(30, 0));
+    std::vector<Point2D> polygon = tessellateLeaf(leaf);
+    polygon[5].y += 0.5;
+    MedialAxisProfile profile;
+    profile.polygon = &polygon;
+    profile.sourceShape = &leaf;
+
+    int calls = 0;
+    MedialAxisEngineSet engines;
+    engines.add(std::make_unique<AnalyticMedialAxisEngine>());
+    engines.add(std::make_unique<FakeEngine>(true, &calls));
+    MedialAxisResults results;
+    EXPECT_EQ(engines.compute(profile, results), 1u);
+    EXPECT_EQ(calls, 1);
+    EXPECT_TRUE(results.success);
+    EXPECT_STREQ(engines.engine(1).name(), "fake");
+
+    // The unedited leaf stops at the analytic engine
+    std::vector<Point2D> unedited = tessellateLeaf(leaf);
+    profile.polygon = &unedited;
+    EXPECT_EQ(engines.compute(profile, results), 0u);
+    EXPECT_EQ(calls, 1);
+}
+
+TEST(MedialAxisEngineTest, VertexRangesSelectTheEngine) {
+    std::vector<Point2D> small(10, Point2D(0, 0));
+    std::vector<Point2D> large(500, Point2D(0, 0));
+    int smallCalls = 0;
+    int largeCalls = 0;
+    MedialAxisEngineSet engines;
+    engines.add(std::make_unique<FakeEngine>(true, &smallCalls), 0, 99);
+    engines.add(std::make_unique<FakeEngine>(true, &largeCalls), 100);
+
+    MedialAxisProfile profile;
+    MedialAxisResults results;
+    profile.polygon = &small;
+    EXPECT_EQ(engines.compute(profile, results), 0u);
+    profile.polygon = &large;
+    EXPECT_EQ(engines.compute(profile, results), 1u);
+    EXPECT_EQ(smallCalls, 1);
+    EXPECT_EQ(largeCalls, 1);
+}
+
+TEST(MedialAxisEngineTest, ReportsWhenNoEngineSucceeds) {
+    std::vector<Point2D> polygon(4, Point2D(0, 0));
+    MedialAxisProfile profile;
+    profile.polygon = &polygon;
+    MedialAxisResults results;
+
+    MedialAxisEngineSet none;
+    none.add(std::make_unique<AnalyticMedialAxisEngine>());
+    EXPECT_EQ(none.compute(profile, results), MedialAxisEngineSet::NO_ENGINE);
+    EXPECT_FALSE(results.success);
+    EXPECT_FALSE(results.errorMessage.empty());
+
+    int calls = 0;
+    MedialAxisEngineSet failing;
+    failing.add(std::make_unique<FakeEngine>(false, &calls));
+    EXPECT_EQ(failing.compute(profile, results), MedialAxisEngineSet::NO_ENGINE);
+    EXPECT_EQ(results.errorMessage, "fake failure");
+
+    MedialAxisProcessor processor;
+    MedialAxisEngineSet standard = MedialAxisEngineSet::standard(processor);
+    ASSERT_EQ(standard.size(), 2u);
+    EXPECT_STREQ(standard.engine(0).name(), "analytic");
+    EXPECT_STREQ(standard.engine(1).name(), "openvoronoi");
+    EXPECT_EQ(MedialAxisEngineSet::standard(processor, false).size(), 1u);
+
+    // Clearing offsets need the diagram, so the closed forms step aside
+    MedialAxisEngineSet analytic = MedialAxisEngineSet::analytic(processor);
+    ASSERT_EQ(analytic.size(), 1u);
+    EXPECT_STREQ(analytic.engine(0).name(), "analytic");
+    ClearingOffsets offsets;
+    offsets.firstOffset = 0.3;
+    offsets.stepover = 0.1;
+    processor.setClearingOffsets(offsets);
+    EXPECT_EQ(MedialAxisEngineSet::analytic(processor).size(), 0u);
+    EXPECT_EQ(MedialAxisEngineSet::standard(processor).size(), 1u);
+}
+
+TEST(MedialAxisEngineTest, BoostVoronoiCrossValidatesAgainstTruthFiles) {
+    expectBoostMatchesTruth("leaf_horizontal.truth", tessellateLeaf(Leaf(Point2D(0, 0), Point2D(10, 0), 6.5), 48),
+                            0.8, 0.01, 1);
+    expectBoostMatchesTruth("leaf_fine_tolerance.truth", tessellateLeaf(Leaf(Point2D(0, 0), Point2D(10, 0), 8.0), 48),
+                            0.8, 0.01, 1);
+    TriArc triArc(Point2D(0, 0), Point2D(10, 0), Point2D(5, 8.66));
+    expectBoostMatchesTruth("triangle_curved.truth", tessellateTriArc(triArc, 48), 0.6, 0.02, 3);
+}
+
+TEST(MedialAxisEngineTest, StraightSkeletonTakesPolygonalProfilesWhenEnabled) {
+    std::vector<Point2D> triangle = {Point2D(0, 0), Point2D(6, 0), Point2D(3, 4)};
+    std::vector<Point2D> leaf = tessellateLeaf(Leaf(Point2D(0, 0), Point2D(10, 0)));
+    MedialAxisProfile profile;
+    MedialAxisResults results;
+
+    MedialAxisProcessor processor;
+    processor.setStraightSkeleton(true);
+    MedialAxisEngineSet engines = MedialAxisEngineSet::standard(processor, false);
+    ASSERT_EQ(engines.size(), 2u);
+    EXPECT_STREQ(engines.engine(0).name(), "straight-skeleton");
+
+    profile.polygon = &triangle;
+    EXPECT_EQ(engines.compute(profile, results), 0u);
+    EXPECT_EQ(results.chains.size(), 3u);
+    profile.polygon = &leaf;
+    EXPECT_FALSE(engines.engine(0).accepts(profile));
+
+    std::vector<std::vector<Point2D>> holes = {{Point2D(2, 1), Point2D(4, 1), Point2D(3, 2)}};
+    profile.polygon = &triangle;
+    profile.holes = &holes;
+    EXPECT_FALSE(engines.engine(0).accepts(profile));
+}
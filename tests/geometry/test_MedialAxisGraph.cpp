@@ -0,0 +1,99 @@
+/**
+ * test_MedialAxisGraph.cpp
+ *
+ * Unit tests for the medial axis junction graph and graph-based path merging
+ */
+
+#include <gtest/gtest.h>
+
+#include <vector>
+
+#include "geometry/MedialAxisGraph.h"
+#include "geometry/VCarveCalculator.h"
+
+using namespace ChipCarving::Geometry;
+
+namespace {
+
+// Three chains meeting at (1, 1) plus a separate chain ending near one of the free ends
+MedialAxisChains makeJunctionChains() {
+    MedialAxisChains chains;
+    chains.addChain({Point2D(0, 0), Point2D(0.5, 0.5), Point2D(1, 1)}, {0.0, 0.3, 0.6});
+    chains.addChain({Point2D(1, 1), Point2D(2, 1)}, {0.6, 0.0});
+    chains.addChain({Point2D(1, 2), Point2D(1, 1)}, {0.0, 0.6});
+    chains.addChain({Point2D(2.01, 1), Point2D(3, 1)}, {0.0, 0.2});
+    return chains;
+}
+
+}  // namespace
+
+TEST(MedialAxisGraphTest, SharedEndpointsBecomeOneNode) {
+    MedialAxisChains chains = makeJunctionChains();
+    MedialAxisGraph graph = MedialAxisGraph::fromChains(chains);
+
+    ASSERT_EQ(graph.edgeCount(), 4u);
+    EXPECT_EQ(graph.nodeCount(), 6u);
+
+    // IDs follow first appearance: chain 0 start, chain 0 end, ...
+    EXPECT_EQ(graph.edge(0).start, 0u);
+    EXPECT_EQ(graph.edge(0).end, 1u);
+    EXPECT_EQ(graph.edge(1).start, 1u);
+    EXPECT_EQ(graph.edge(1).end, 2u);
+    EXPECT_EQ(graph.edge(2).start, 3u);
+    EXPECT_EQ(graph.edge(2).end, 1u);
+
+    EXPECT_TRUE(graph.isJunction(1));
+    EXPECT_EQ(graph.degree(0), 1u);
+    EXPECT_EQ(std::vector<uint32_t>(graph.incidentBegin(1), graph.incidentEnd(1)), (std::vector<uint32_t>{0, 1, 2}));
+    EXPECT_EQ(graph.sharedNode(1, 2), 1u);
+    EXPECT_EQ(graph.sharedNode(0, 3), MedialAxisGraph::NO_NODE);
+    EXPECT_DOUBLE_EQ(graph.position(chains, 1).x, 1.0);
+    EXPECT_DOUBLE_EQ(graph.position(chains, 3).y, 2.0);
+}
+
+TEST(MedialAxisGraphTest, ToleranceJoinsNearbyEndpoints) {
+    MedialAxisChains chains = makeJunctionChains();
+    MedialAxisGraph graph = MedialAxisGraph::fromChains(chains, 0.02);
+    EXPECT_EQ(graph.nodeCount(), 5u);
+    EXPECT_EQ(graph.sharedNode(1, 3), 2u);
+}
+
+TEST(MedialAxisGraphTest, LoopsAndEmptyChains) {
+    MedialAxisChains chains;
+    chains.addChain({Point2D(0, 0), Point2D(1, 0), Point2D(0, 0)}, {0.0, 0.1, 0.0});
+    chains.beginChain();
+    MedialAxisGraph graph = MedialAxisGraph::fromChains(chains);
+
+    EXPECT_EQ(graph.nodeCount(), 1u);
+    EXPECT_EQ(graph.edge(0).start, graph.edge(0).end);
+    EXPECT_EQ(graph.degree(0), 2u);
+    EXPECT_EQ(graph.edge(1).start, MedialAxisGraph::NO_NODE);
+    EXPECT_TRUE(MedialAxisGraph::fromChains(MedialAxisChains()).empty());
+}
+
+TEST(MedialAxisGraphTest, GraphPathsMergeOnlyWhereChainsMeet) {
+    MedialAxisChains chains = makeJunctionChains();
+    MedialAxisGraph graph = MedialAxisGraph::fromChains(chains);
+    std::vector<SampledMedialPath> sampledPaths;
+    sampleMedialAxisChains(chains, 1.0, 0.25, sampledPaths);
+
+    ChipCarving::Adapters::MedialAxisParameters params;
+    params.pathMergeTolerance = 0.1;
+    params.orderToolpaths = false;
+    VCarveCalculator calculator;
+
+    // By distance the detached chain joins chain 1 across the 0.01 gap
+    VCarveResults byDistance = calculator.generateVCarvePaths(sampledPaths, params);
+    ASSERT_TRUE(byDistance.success);
+    EXPECT_EQ(byDistance.totalPaths, 2);
+
+    // The graph only joins chains through the junction: two of its three chains merge
+    VCarveResults byNode = calculator.generateVCarvePaths(sampledPaths, params, &graph);
+    ASSERT_TRUE(byNode.success);
+    EXPECT_EQ(byNode.totalPaths, 3);
+    for (const auto& path : byNode.paths) {
+        EXPECT_NE(path.startNode, MedialAxisGraph::NO_NODE);
+        EXPECT_NE(path.endNode, MedialAxisGraph::NO_NODE);
+    }
+    EXPECT_EQ(byNode.totalPoints, byDistance.totalPoints);
+}
@@ -0,0 +1,104 @@
+/**
+ * test_MedialAxisHoles.cpp
+ *
+ * Unit tests for profiles with inner loops computed in a single diagram
+ */
+
+#include <gtest/gtest.h>
+
+#include <vector>
+
+#include "geometry/MedialAxisBatch.h"
+#include "geometry/MedialAxisProcessor.h"
+#include "geometry/MedialAxisRetry.h"
+
+using namespace ChipCarving::Geometry;
+
+namespace {
+
+// Counter-clockwise axis-aligned square
+std::vector<Point2D> square(double cx, double cy, double half) {
+    return {Point2D(cx - half, cy - half), Point2D(cx + half, cy - half), Point2D(cx + half, cy + half),
+            Point2D(cx - half, cy + half)};
+}
+
+MedialAxisProcessor makeProcessor() {
+    MedialAxisProcessor processor;
+    processor.setDiagramValidation(DiagramValidation::FULL);
+    return processor;
+}
+
+}  // namespace
+
+TEST(MedialAxisHolesTest, HoleInsideOuterLoopSucceeds) {
+    MedialAxisProcessor processor = makeProcessor();
+    std::vector<Point2D> outer = square(0.0, 0.0, 5.0);
+
+    // Either winding is accepted for the hole
+    std::vector<Point2D> hole = square(1.0, -1.0, 2.0);
+    std::vector<Point2D> reversedHole(hole.rbegin(), hole.rend());
+    for (const auto& inner : {hole, reversedHole}) {
+        MedialAxisResults results = processor.computeMedialAxis(outer, {inner});
+        EXPECT_TRUE(results.success) << results.errorMessage;
+        EXPECT_EQ(results.attempts.size(), 1u);
+    }
+
+    MedialAxisResults twoHoles = processor.computeMedialAxis(outer, {square(-3.0, 0.0, 1.0), square(3.0, 0.0, 1.0)});
+    EXPECT_TRUE(twoHoles.success) << twoHoles.errorMessage;
+}
+
+TEST(MedialAxisHolesTest, HoleCrossingOuterLoopFails) {
+    MedialAxisProcessor processor = makeProcessor();
+    MedialAxisResults results = processor.computeMedialAxis(square(0.0, 0.0, 5.0), {square(5.0, 0.0, 1.0)});
+    EXPECT_FALSE(results.success);
+    EXPECT_TRUE(results.attempts.empty());
+}
+
+TEST(MedialAxisHolesTest, HoleOutsideOuterLoopFails) {
+    MedialAxisProcessor processor = makeProcessor();
+    EXPECT_FALSE(processor.computeMedialAxis(square(0.0, 0.0, 5.0), {square(8.0, 0.0, 1.0)}).success);
+
+    // Overlapping holes cross each other
+    EXPECT_FALSE(
+        processor.computeMedialAxis(square(0.0, 0.0, 5.0), {square(0.0, 0.0, 2.0), square(1.0, 1.0, 2.0)}).success);
+
+    // A hole needs three vertices like any loop
+    EXPECT_FALSE(processor.computeMedialAxis(square(0.0, 0.0, 5.0), {{Point2D(0, 0), Point2D(1, 0)}}).success);
+}
+
+TEST(MedialAxisHolesTest, SimplifiedRetryKeepsLoopsApart) {
+    // Two unit circle squares with an almost collinear extra vertex on one side each
+    std::vector<Point2D> polygon = {Point2D(-0.8, -0.8), Point2D(0.0, -0.8 + 1.0e-6), Point2D(0.8, -0.8),
+                                    Point2D(0.8, 0.8),   Point2D(-0.8, 0.8),          Point2D(-0.2, -0.2),
+                                    Point2D(-0.2, 0.2),  Point2D(0.2, 0.2),           Point2D(0.2 + 1.0e-6, 0.0),
+                                    Point2D(0.2, -0.2)};
+    std::vector<size_t> loopStarts = {0, 5, 10};
+
+    double scale = 1.0;
+    std::vector<size_t> reworkedStarts;
+    std::vector<Point2D> simplified =
+        retryPolygon(polygon, loopStarts, MedialAxisRetry::SIMPLIFIED, scale, reworkedStarts);
+    EXPECT_EQ(simplified.size(), 8u);
+    EXPECT_EQ(reworkedStarts, (std::vector<size_t>{0, 4, 8}));
+
+    std::vector<Point2D> perturbed =
+        retryPolygon(polygon, loopStarts, MedialAxisRetry::PERTURBED, scale, reworkedStarts);
+    EXPECT_EQ(perturbed.size(), polygon.size());
+    EXPECT_EQ(reworkedStarts, loopStarts);
+}
+
+TEST(MedialAxisHolesTest, BatchPassesHolesPerPolygon) {
+    std::vector<std::vector<Point2D>> polygons = {square(0.0, 0.0, 5.0), square(20.0, 0.0, 5.0)};
+    std::vector<std::vector<std::vector<Point2D>>> holes = {{square(0.0, 0.0, 1.0)}, {square(0.0, 0.0, 1.0)}};
+
+    // The second hole is given in world coordinates far from its polygon
+    std::vector<MedialAxisResults> results = computeMedialAxisBatch(polygons, makeProcessor(), 2, nullptr, &holes);
+    ASSERT_EQ(results.size(), 2u);
+    EXPECT_TRUE(results[0].success) << results[0].errorMessage;
+    EXPECT_FALSE(results[1].success);
+
+    // Without holes both outlines succeed
+    results = computeMedialAxisBatch(polygons, makeProcessor(), 2);
+    EXPECT_TRUE(results[0].success);
+    EXPECT_TRUE(results[1].success);
+}
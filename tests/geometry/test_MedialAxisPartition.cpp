@@ -0,0 +1,138 @@
+/**
+ * test_MedialAxisPartition.cpp
+ *
+ * Unit tests for the tiled medial axis: seam clipping and stitching, parity
+ * with the full diagram on a long thin outline, and rejection when clearances
+ * exceed the tile halo
+ */
+
+#include <gtest/gtest.h>
+
+#include <cmath>
+#include <vector>
+
+#include "geometry/MedialAxisPartition.h"
+#include "geometry/MedialAxisPartitionPieces.h"
+#include "geometry/MedialAxisProcessor.h"
+#include "geometry/Point2D.h"
+
+using namespace ChipCarving::Geometry;
+
+namespace {
+
+// Closed band of half-width halfWidth around y = sin(x), x in [0, length]
+std::vector<Point2D> makeWavyBand(double length, double halfWidth, int samplesPerSide) {
+    std::vector<Point2D> top;
+    std::vector<Point2D> bottom;
+    for (int i = 0; i <= samplesPerSide; ++i) {
+        double x = length * i / samplesPerSide;
+        double slope = std::cos(x);
+        double norm = std::sqrt(1.0 + slope * slope);
+        top.emplace_back(x - halfWidth * slope / norm, std::sin(x) + halfWidth / norm);
+        bottom.emplace_back(x + halfWidth * slope / norm, std::sin(x) - halfWidth / norm);
+    }
+    std::vector<Point2D> polygon(bottom.begin(), bottom.end());
+    polygon.insert(polygon.end(), top.rbegin(), top.rend());
+    return polygon;
+}
+
+std::vector<Point2D> makeEllipse(double radiusX, double radiusY, int sides) {
+    std::vector<Point2D> polygon;
+    for (int i = 0; i < sides; ++i) {
+        double angle = 2.0 * M_PI * i / sides;
+        polygon.emplace_back(radiusX * std::cos(angle), radiusY * std::sin(angle));
+    }
+    return polygon;
+}
+
+}  // namespace
+
+TEST(MedialAxisPartitionTest, SeamCutChainsStitchBackTogether) {
+    // A zigzag chain crossing the seam x = 5 three times, split between two tiles
+    std::vector<Point2D> points = {Point2D(0, 0), Point2D(4, 1), Point2D(6, 2), Point2D(4, 3), Point2D(8, 4)};
+    std::vector<double> clearances = {0.1, 0.2, 0.3, 0.4, 0.5};
+    TileBox left;
+    left.maxX = 5.0;
+    TileBox right;
+    right.minX = 5.0;
+
+    std::vector<ChainPiece> pieces;
+    clipChain(points, clearances, left, pieces);
+    clipChain(points, clearances, right, pieces);
+    ASSERT_EQ(pieces.size(), 4u);
+    EXPECT_FALSE(pieces[0].seamStart);
+    EXPECT_TRUE(pieces[0].seamEnd);
+    EXPECT_DOUBLE_EQ(pieces[0].points.back().x, 5.0);
+    EXPECT_DOUBLE_EQ(pieces[0].clearances.back(), 0.25);
+
+    MedialAxisResults results;
+    stitchPieces(pieces, 1e-9, results);
+    ASSERT_EQ(results.numChains, 1);
+    ASSERT_EQ(results.chains.size(), 1u);
+    auto chain = results.chains[0];
+    // Original five points plus one cut point per seam crossing
+    ASSERT_EQ(chain.size(), 8u);
+    EXPECT_DOUBLE_EQ(distance(chain.front(), Point2D(0, 0)), 0.0);
+    EXPECT_DOUBLE_EQ(distance(chain.back(), Point2D(8, 4)), 0.0);
+    double length = 0.0;
+    for (size_t i = 0; i + 1 < points.size(); ++i) {
+        length += distance(points[i], points[i + 1]);
+    }
+    EXPECT_NEAR(results.totalLength, length, 1e-12);
+    EXPECT_DOUBLE_EQ(results.minClearance, 0.1);
+    EXPECT_DOUBLE_EQ(results.maxClearance, 0.5);
+}
+
+TEST(MedialAxisPartitionTest, MatchesFullDiagramOnThinOutline) {
+    std::vector<Point2D> band = makeWavyBand(30.0, 0.25, 1500);
+    MedialAxisProcessor processor;
+    MedialAxisResults full = processor.computeMedialAxis(band);
+    ASSERT_TRUE(full.success) << full.errorMessage;
+    ASSERT_GT(full.totalPoints, 0);
+
+    MedialAxisPartitionOptions options;
+    options.verticesPerTile = 500;
+    options.workers = 3;
+    MedialAxisResults tiled;
+    ASSERT_TRUE(computePartitionedMedialAxis(processor, band, options, tiled));
+
+    // Seam cuts add points on existing segments, so the geometry is unchanged
+    EXPECT_NEAR(tiled.totalLength, full.totalLength, 1e-6 * full.totalLength);
+    EXPECT_NEAR(tiled.maxClearance, full.maxClearance, 1e-9);
+    EXPECT_NEAR(tiled.minClearance, full.minClearance, 1e-9);
+    EXPECT_GE(tiled.totalPoints, full.totalPoints);
+    EXPECT_GE(tiled.numChains, full.numChains);  // Ambiguous seam ends may stay split
+    EXPECT_EQ(static_cast<int>(tiled.chains.size()), tiled.numChains);
+    EXPECT_EQ(static_cast<int>(tiled.chains.pointCount()), tiled.totalPoints);
+}
+
+TEST(MedialAxisPartitionTest, RejectsClearanceBeyondTheHalo) {
+    // An ellipse's medial axis runs up to its minor radius from the boundary, far outside the halo
+    std::vector<Point2D> ellipse = makeEllipse(10.0, 3.0, 1200);
+    MedialAxisProcessor processor;
+    MedialAxisPartitionOptions options;
+    options.verticesPerTile = 100;
+    options.haloFraction = 0.1;
+    MedialAxisResults tiled;
+    EXPECT_FALSE(computePartitionedMedialAxis(processor, ellipse, options, tiled));
+    EXPECT_FALSE(tiled.success);
+    EXPECT_TRUE(tiled.chains.empty());
+}
+
+TEST(MedialAxisPartitionTest, ProcessorFallsBackToFullDiagram) {
+    std::vector<Point2D> ellipse = makeEllipse(10.0, 3.0, 600);
+    MedialAxisProcessor full;
+    MedialAxisProcessor partitioned;
+    partitioned.setPartitioning(100, 2);
+
+    MedialAxisResults expected = full.computeMedialAxis(ellipse);
+    MedialAxisResults results = partitioned.computeMedialAxis(ellipse);
+    ASSERT_TRUE(results.success);
+    EXPECT_GT(results.totalPoints, 0);
+    EXPECT_EQ(results.totalPoints, expected.totalPoints);
+    EXPECT_DOUBLE_EQ(results.totalLength, expected.totalLength);
+
+    // Polygons below the threshold never try the partition
+    MedialAxisPartitionOptions options;
+    EXPECT_FALSE(computePartitionedMedialAxis(full, makeEllipse(1.0, 1.0, 8), options, results));
+}
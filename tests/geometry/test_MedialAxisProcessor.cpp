@@ -25,6 +25,8 @@ class MedialAxisProcessorTest : public ::testing::Test {
    protected:
     void SetUp() override {
         processor = std::make_unique<MedialAxisProcessor>();
+        // Tests keep the full graph check even in Release builds
+        processor->setDiagramValidation(DiagramValidation::FULL);
         // Enable verbose logging for debugging if needed
         // processor->setVerbose(true);
     }
@@ -57,6 +59,30 @@ TEST_F(MedialAxisProcessorTest, ConstructorAndParameters) {
     EXPECT_EQ(processor->getMedialThreshold(), 0.9);
 }
 
+/**
+ * Test diagram validation levels and the verbose override
+ */
+TEST_F(MedialAxisProcessorTest, DiagramValidationLevels) {
+    MedialAxisProcessor defaultProcessor;
+    EXPECT_EQ(defaultProcessor.getDiagramValidation(), MedialAxisProcessor::DEFAULT_VALIDATION);
+
+    defaultProcessor.setDiagramValidation(DiagramValidation::OFF);
+    EXPECT_EQ(defaultProcessor.getDiagramValidation(), DiagramValidation::OFF);
+    defaultProcessor.setVerbose(true);
+    EXPECT_EQ(defaultProcessor.getDiagramValidation(), DiagramValidation::FULL);
+    defaultProcessor.setVerbose(false);
+    EXPECT_EQ(defaultProcessor.getDiagramValidation(), DiagramValidation::OFF);
+
+    // Skipping the check does not change the result
+    std::vector<Point2D> polygon = {Point2D(0.0, 0.0), Point2D(8.0, 0.0), Point2D(8.0, 3.0), Point2D(0.0, 3.0)};
+    processor->setDiagramValidation(DiagramValidation::OFF);
+    MedialAxisResults unchecked = processor->computeMedialAxis(polygon);
+    processor->setDiagramValidation(DiagramValidation::SAMPLED);
+    MedialAxisResults sampled = processor->computeMedialAxis(polygon);
+    EXPECT_EQ(unchecked.success, sampled.success);
+    EXPECT_EQ(unchecked.totalPoints, sampled.totalPoints);
+}
+
 /**
  * Test error handling for invalid polygons
  */
@@ -258,8 +284,8 @@ TEST_F(MedialAxisProcessorTest, PreservesBoundaryPoints) {
     int boundaryPointCount = 0;
     double boundaryTolerance = 0.01;  // 0.01 cm = 0.1mm tolerance
 
-    for (const auto& clearanceChain : results.clearanceRadii) {
-        for (double clearance : clearanceChain) {
+    for (const auto& chain : results.chains) {
+        for (double clearance : chain.clearances()) {
             if (clearance < boundaryTolerance) {
                 boundaryPointCount++;
             }
@@ -270,16 +296,16 @@ TEST_F(MedialAxisProcessorTest, PreservesBoundaryPoints) {
     EXPECT_GT(boundaryPointCount, 0) << "No boundary points with zero clearance found";
 
     // Verify boundary points exist in each chain
-    for (size_t i = 0; i < results.clearanceRadii.size(); ++i) {
+    for (size_t i = 0; i < results.chains.size(); ++i) {
         bool chainHasBoundaryPoint = false;
-        for (double clearance : results.clearanceRadii[i]) {
+        for (double clearance : results.chains[i].clearances()) {
             if (clearance < boundaryTolerance) {
                 chainHasBoundaryPoint = true;
                 break;
             }
         }
         // At least some chains should have boundary points
-        if (results.clearanceRadii[i].size() > 2) {  // Only check substantial chains
+        if (results.chains[i].clearances().size() > 2) {  // Only check substantial chains
             EXPECT_TRUE(chainHasBoundaryPoint) 
                 << "Chain " << i << " has no boundary points (may indicate missing sharp corners)";
         }
@@ -0,0 +1,79 @@
+/**
+ * test_MedialAxisRetry.cpp
+ *
+ * Unit tests for the OpenVoronoi fallback ladder
+ */
+
+#include <gtest/gtest.h>
+
+#include <cmath>
+#include <vector>
+
+#include "geometry/MedialAxisProcessor.h"
+#include "geometry/MedialAxisRetry.h"
+
+using namespace ChipCarving::Geometry;
+
+namespace {
+
+// Unit circle square with an extra, almost collinear vertex on every side
+std::vector<Point2D> noisySquare() {
+    return {Point2D(-0.5, -0.5), Point2D(0.0, -0.5 + 1.0e-6), Point2D(0.5, -0.5), Point2D(0.5 + 1.0e-6, 0.0),
+            Point2D(0.5, 0.5),   Point2D(0.0, 0.5),            Point2D(-0.5, 0.5), Point2D(-0.5, 0.0)};
+}
+
+}  // namespace
+
+TEST(MedialAxisRetryTest, LadderStepsInOrder) {
+    const auto& ladder = medialAxisRetryLadder();
+    ASSERT_EQ(ladder.size(), 3u);
+    EXPECT_EQ(ladder[0], MedialAxisRetry::PERTURBED);
+    EXPECT_EQ(ladder[1], MedialAxisRetry::SIMPLIFIED);
+    EXPECT_EQ(ladder[2], MedialAxisRetry::RESCALED);
+    EXPECT_STREQ(medialAxisRetryName(MedialAxisRetry::SIMPLIFIED), "simplified");
+}
+
+TEST(MedialAxisRetryTest, ReworksThePolygonPerRung) {
+    std::vector<Point2D> polygon = noisySquare();
+
+    double scale = 2.0;
+    std::vector<Point2D> perturbed = retryPolygon(polygon, MedialAxisRetry::PERTURBED, scale);
+    ASSERT_EQ(perturbed.size(), polygon.size());
+    bool moved = false;
+    for (size_t i = 0; i < polygon.size(); ++i) {
+        EXPECT_LE(distance(perturbed[i], polygon[i]), 1.0e-6);
+        moved = moved || distance(perturbed[i], polygon[i]) > 0.0;
+    }
+    EXPECT_TRUE(moved);
+    EXPECT_DOUBLE_EQ(scale, 2.0);
+    // Fixed seed: the same jitter every time
+    EXPECT_EQ(distance(retryPolygon(polygon, MedialAxisRetry::PERTURBED, scale)[3], perturbed[3]), 0.0);
+
+    std::vector<Point2D> simplified = retryPolygon(polygon, MedialAxisRetry::SIMPLIFIED, scale);
+    EXPECT_EQ(simplified.size(), 4u);
+    EXPECT_DOUBLE_EQ(scale, 2.0);
+
+    std::vector<Point2D> rescaled = retryPolygon(polygon, MedialAxisRetry::RESCALED, scale);
+    ASSERT_EQ(rescaled.size(), polygon.size());
+    double factor = scale / 2.0;
+    EXPECT_LT(factor, 1.0);
+    EXPECT_NEAR(rescaled[2].x, polygon[2].x * factor, 1e-15);
+    EXPECT_NEAR(rescaled[2].y, polygon[2].y * factor, 1e-15);
+}
+
+TEST(MedialAxisRetryTest, SimplifyingAwayThePolygonSkipsTheRung) {
+    double scale = 1.0;
+    std::vector<Point2D> sliver = {Point2D(0.0, 0.0), Point2D(0.5, 1.0e-6), Point2D(1.0, 0.0)};
+    EXPECT_TRUE(retryPolygon(sliver, MedialAxisRetry::SIMPLIFIED, scale).empty());
+}
+
+TEST(MedialAxisRetryTest, SuccessfulComputationRecordsOneAttempt) {
+    MedialAxisProcessor processor;
+    EXPECT_TRUE(processor.getRetryOnFailure());
+    std::vector<Point2D> polygon = {Point2D(0.0, 0.0), Point2D(8.0, 0.0), Point2D(8.0, 3.0), Point2D(0.0, 3.0)};
+    MedialAxisResults results = processor.computeMedialAxis(polygon);
+    ASSERT_TRUE(results.success);
+    ASSERT_EQ(results.attempts.size(), 1u);
+    EXPECT_EQ(results.attempts[0].retry, MedialAxisRetry::NONE);
+    EXPECT_TRUE(results.attempts[0].success);
+}
@@ -299,3 +299,23 @@ TEST_F(MedialAxisRobustnessTest, DeterministicResults) {
   EXPECT_DOUBLE_EQ(results1.totalLength, results2.totalLength);
   EXPECT_DOUBLE_EQ(results1.totalLength, results3.totalLength);
 }
+
+/**
+ * Test self-intersection detection on a polygon too large for all-pairs checks
+ */
+TEST_F(MedialAxisRobustnessTest, SelfIntersectionInLargePolygon) {
+  const int vertexCount = 4000;
+  std::vector<Point2D> circle;
+  for (int i = 0; i < vertexCount; ++i) {
+    double angle = 2.0 * M_PI * i / vertexCount;
+    circle.emplace_back(10.0 * std::cos(angle), 10.0 * std::sin(angle));
+  }
+  EXPECT_TRUE(processor()->computeMedialAxis(circle).success);
+
+  // Swapping two neighbours makes the edges around them cross
+  std::vector<Point2D> crossed = circle;
+  std::swap(crossed[1234], crossed[1235]);
+  MedialAxisResults results = processor()->computeMedialAxis(crossed);
+  EXPECT_FALSE(results.success);
+  EXPECT_FALSE(results.errorMessage.empty());
+}
@@ -0,0 +1,93 @@
+/**
+ * test_MedialAxisSpurs.cpp
+ *
+ * Unit tests for pruning short and flat medial axis spurs
+ */
+
+#include <gtest/gtest.h>
+
+#include "geometry/MedialAxisProcessor.h"
+#include "geometry/MedialAxisSpurs.h"
+
+using namespace ChipCarving::Geometry;
+
+namespace {
+
+// A trunk from (0, 0) to (10, 0) with a long and a short branch off its end junction
+MedialAxisResults makeForkResults() {
+    MedialAxisResults results;
+    results.success = true;
+    results.chains.addChain({Point2D(0, 0), Point2D(5, 0), Point2D(10, 0)}, {0.5, 1.5, 3.0});
+    results.chains.addChain({Point2D(10, 0), Point2D(14, 3)}, {3.0, 0.5});
+    results.chains.addChain({Point2D(10, 0), Point2D(10, -0.4)}, {3.0, 2.8});
+    results.graph = MedialAxisGraph::fromChains(results.chains);
+    results.numChains = 3;
+    results.totalPoints = 7;
+    return results;
+}
+
+}  // namespace
+
+TEST(MedialAxisSpursTest, ShortSpurIsRemovedAndTheGraphRebuilt) {
+    MedialAxisResults results = makeForkResults();
+    SpurPruningOptions options;
+    options.minLength = 1.0;
+
+    EXPECT_EQ(pruneMedialAxisSpurs(results, options), 1u);
+    ASSERT_EQ(results.chains.size(), 2u);
+    EXPECT_EQ(results.numChains, 2);
+    EXPECT_EQ(results.totalPoints, 5);
+    EXPECT_DOUBLE_EQ(results.totalLength, 15.0);
+    EXPECT_DOUBLE_EQ(results.minClearance, 0.5);
+    EXPECT_DOUBLE_EQ(results.maxClearance, 3.0);
+    EXPECT_DOUBLE_EQ(results.chains[1][1].x, 14.0);
+    EXPECT_EQ(results.graph.edgeCount(), 2u);
+    EXPECT_FALSE(results.graph.isJunction(results.graph.sharedNode(0, 1)));
+}
+
+TEST(MedialAxisSpursTest, FlatSpurIsRemovedByClearanceChange) {
+    MedialAxisResults results = makeForkResults();
+    SpurPruningOptions options;
+    options.minClearanceChange = 1.0;
+
+    // The trunk and the long branch change clearance by 2.5; the short spur only by 0.2
+    EXPECT_EQ(pruneMedialAxisSpurs(results, options), 1u);
+    ASSERT_EQ(results.chains.size(), 2u);
+    EXPECT_DOUBLE_EQ(results.chains[1][1].y, 3.0);
+}
+
+TEST(MedialAxisSpursTest, JunctionKeepsTwoChains) {
+    MedialAxisResults results = makeForkResults();
+    SpurPruningOptions options;
+    options.minLength = 100.0;
+
+    // All three are spurs of the one junction; only the shortest may go
+    EXPECT_EQ(pruneMedialAxisSpurs(results, options), 1u);
+    ASSERT_EQ(results.chains.size(), 2u);
+    EXPECT_DOUBLE_EQ(results.totalLength, 15.0);
+}
+
+TEST(MedialAxisSpursTest, DisabledOptionsAndIsolatedChainsAreLeftAlone) {
+    MedialAxisResults results = makeForkResults();
+    EXPECT_EQ(pruneMedialAxisSpurs(results, SpurPruningOptions{}), 0u);
+    EXPECT_EQ(results.chains.size(), 3u);
+
+    // A lone chain has no junction, however short it is
+    MedialAxisResults lone;
+    lone.success = true;
+    lone.chains.addChain({Point2D(0, 0), Point2D(0.1, 0)}, {0.1, 0.1});
+    lone.graph = MedialAxisGraph::fromChains(lone.chains);
+    SpurPruningOptions options;
+    options.minLength = 1.0;
+    EXPECT_EQ(pruneMedialAxisSpurs(lone, options), 0u);
+    EXPECT_EQ(lone.chains.size(), 1u);
+}
+
+TEST(MedialAxisSpursTest, ProcessorPrunesWhenConfigured) {
+    MedialAxisProcessor processor;
+    EXPECT_FALSE(processor.getSpurPruning().enabled());
+    SpurPruningOptions options;
+    options.minLength = 0.5;
+    processor.setSpurPruning(options);
+    EXPECT_DOUBLE_EQ(processor.getSpurPruning().minLength, 0.5);
+}
@@ -0,0 +1,136 @@
+/**
+ * test_MedialAxisSymmetry.cpp
+ *
+ * Unit tests for mirror axis detection and the medial axis computed from one
+ * fundamental wedge: parity with the full diagram and fallback for outlines
+ * that are not symmetric
+ */
+
+#include <gtest/gtest.h>
+
+#include <cmath>
+#include <vector>
+
+#include "geometry/MedialAxisProcessor.h"
+#include "geometry/MedialAxisSymmetry.h"
+#include "geometry/Point2D.h"
+
+using namespace ChipCarving::Geometry;
+
+namespace {
+
+std::vector<Point2D> makeEllipse(double radiusX, double radiusY, int sides, double angle = 0.0,
+                                 Point2D centre = Point2D(0, 0)) {
+    std::vector<Point2D> polygon;
+    for (int i = 0; i < sides; ++i) {
+        double t = 2.0 * M_PI * i / sides;
+        polygon.push_back(rotatePoint(Point2D(radiusX * std::cos(t), radiusY * std::sin(t)), angle, Point2D(0, 0)) +
+                          centre);
+    }
+    return polygon;
+}
+
+double axisDistance(double a, double b) {
+    double d = std::fabs(std::fmod(a - b, M_PI));
+    return std::min(d, M_PI - d);
+}
+
+}  // namespace
+
+TEST(MedialAxisSymmetryTest, DetectsTheAxesOfRegularOutlines) {
+    PolygonSymmetry symmetry;
+    ASSERT_TRUE(detectPolygonSymmetry({Point2D(0, 0), Point2D(4, 0), Point2D(4, 2), Point2D(0, 2)}, 1e-9, symmetry));
+    EXPECT_EQ(symmetry.mirrorAxes, 2);
+    EXPECT_NEAR(symmetry.centre.x, 2.0, 1e-12);
+    EXPECT_NEAR(symmetry.centre.y, 1.0, 1e-12);
+
+    ASSERT_TRUE(detectPolygonSymmetry({Point2D(0, 0), Point2D(1, 0), Point2D(1, 1), Point2D(0, 1)}, 1e-9, symmetry));
+    EXPECT_EQ(symmetry.mirrorAxes, 4);
+    EXPECT_EQ(symmetry.order(), 8);
+
+    std::vector<Point2D> triangle = {Point2D(1, 0), rotatePoint(Point2D(1, 0), 2.0 * M_PI / 3.0, Point2D(0, 0)),
+                                     rotatePoint(Point2D(1, 0), 4.0 * M_PI / 3.0, Point2D(0, 0))};
+    ASSERT_TRUE(detectPolygonSymmetry(triangle, 1e-9, symmetry));
+    EXPECT_EQ(symmetry.mirrorAxes, 3);
+}
+
+TEST(MedialAxisSymmetryTest, FindsTurnedAndMovedAxes) {
+    const double angle = M_PI / 6.0;
+    PolygonSymmetry symmetry;
+    ASSERT_TRUE(detectPolygonSymmetry(makeEllipse(5.0, 2.0, 400, angle, Point2D(3, -7)), 1e-7, symmetry));
+    EXPECT_EQ(symmetry.mirrorAxes, 2);
+    EXPECT_NEAR(symmetry.centre.x, 3.0, 1e-9);
+    EXPECT_NEAR(symmetry.centre.y, -7.0, 1e-9);
+    EXPECT_LT(std::min(axisDistance(symmetry.axisAngle, angle), axisDistance(symmetry.axisAngle, angle + M_PI / 2)),
+              1e-6);
+}
+
+TEST(MedialAxisSymmetryTest, VerticesNeedNotPairUpAcrossTheAxis) {
+    // An extra vertex halfway along the top edge mirrors onto the middle of the bottom edge
+    std::vector<Point2D> rectangle = {Point2D(0, 0), Point2D(4, 0), Point2D(4, 2), Point2D(2, 2), Point2D(0, 2)};
+    PolygonSymmetry symmetry;
+    ASSERT_TRUE(detectPolygonSymmetry(rectangle, 1e-9, symmetry));
+    EXPECT_EQ(symmetry.mirrorAxes, 2);
+}
+
+TEST(MedialAxisSymmetryTest, RejectsAsymmetricOutlines) {
+    PolygonSymmetry symmetry;
+    EXPECT_FALSE(
+        detectPolygonSymmetry({Point2D(0, 0), Point2D(5, 0), Point2D(4, 3), Point2D(1, 2), Point2D(-1, 1)}, 1e-6,
+                              symmetry));
+
+    // Symmetric only to about 0.01: found at that tolerance, not at a finer one
+    std::vector<Point2D> nearlySquare = {Point2D(0, 0), Point2D(1, 0), Point2D(1, 1.01), Point2D(0, 1)};
+    EXPECT_FALSE(detectPolygonSymmetry(nearlySquare, 1e-6, symmetry));
+    EXPECT_TRUE(detectPolygonSymmetry(nearlySquare, 0.02, symmetry));
+}
+
+TEST(MedialAxisSymmetryTest, MatchesFullDiagramOnThinEllipse) {
+    std::vector<Point2D> ellipse = makeEllipse(10.0, 2.0, 1200);
+    MedialAxisProcessor processor;
+    MedialAxisResults full = processor.computeMedialAxis(ellipse);
+    ASSERT_TRUE(full.success) << full.errorMessage;
+    ASSERT_GT(full.totalPoints, 0);
+
+    MedialAxisResults symmetric;
+    ASSERT_TRUE(computeSymmetricMedialAxis(processor, ellipse, MedialAxisSymmetryOptions(), symmetric));
+    EXPECT_NEAR(symmetric.totalLength, full.totalLength, 1e-6 * full.totalLength);
+    EXPECT_NEAR(symmetric.maxClearance, full.maxClearance, 1e-9);
+    EXPECT_NEAR(symmetric.minClearance, full.minClearance, 1e-9);
+    EXPECT_EQ(static_cast<int>(symmetric.chains.size()), symmetric.numChains);
+    EXPECT_EQ(static_cast<int>(symmetric.chains.pointCount()), symmetric.totalPoints);
+
+    // Every medial point has its mirror images in the result
+    for (size_t c = 0; c < symmetric.chains.size(); ++c) {
+        for (const auto& point : symmetric.chains[c]) {
+            Point2D mirrored(point.x, -point.y);
+            bool found = false;
+            for (size_t d = 0; d < symmetric.chains.size() && !found; ++d) {
+                for (const auto& other : symmetric.chains[d]) {
+                    if (distance(other, mirrored) < 1e-9) {
+                        found = true;
+                        break;
+                    }
+                }
+            }
+            EXPECT_TRUE(found);
+        }
+    }
+}
+
+TEST(MedialAxisSymmetryTest, ProcessorFallsBackForAsymmetricOutlines) {
+    std::vector<Point2D> outline = makeEllipse(10.0, 3.0, 600);
+    outline[17] = outline[17] * 1.05;  // One bump breaks both axes
+    MedialAxisProcessor full;
+    MedialAxisProcessor symmetric;
+    symmetric.setSymmetryDetection(true);
+
+    MedialAxisResults expected = full.computeMedialAxis(outline);
+    MedialAxisResults results = symmetric.computeMedialAxis(outline);
+    ASSERT_TRUE(results.success);
+    EXPECT_EQ(results.totalPoints, expected.totalPoints);
+    EXPECT_DOUBLE_EQ(results.totalLength, expected.totalLength);
+
+    // Polygons below the vertex threshold never try the wedge
+    EXPECT_FALSE(computeSymmetricMedialAxis(full, makeEllipse(2.0, 1.0, 16), MedialAxisSymmetryOptions(), results));
+}
@@ -0,0 +1,114 @@
+/**
+ * Unit tests for text and binary medial axis truth files
+ */
+
+#include <gtest/gtest.h>
+
+#include <cstdio>
+#include <fstream>
+#include <string>
+
+#include "geometry/MedialAxisTruthData.h"
+
+using namespace ChipCarving::Geometry;
+
+namespace {
+
+MedialAxisChains sampleChains() {
+    MedialAxisChains chains;
+    chains.addChain({Point2D(0.0, 0.0), Point2D(1.0, 0.5), Point2D(2.0, 0.0)}, {0.0, 0.5, 0.0});
+    chains.addChain({Point2D(1.0, 0.5), Point2D(1.0, 2.0)}, {0.5, 0.0});
+    return chains;
+}
+
+}  // namespace
+
+TEST(MedialAxisTruthDataTest, ReadsTheTextFormat) {
+    MedialAxisChains truth;
+    ASSERT_TRUE(loadTruthFile(std::string(MEDIAL_AXIS_TRUTH_DIR) + "/triangle_curved.truth", truth));
+    ASSERT_EQ(truth.size(), 2u);
+    EXPECT_EQ(truth[0].size(), 11u);
+    EXPECT_EQ(truth[1].size(), 6u);
+    EXPECT_TRUE(truth[0][1].equals(Point2D(1.0, 0.578)));
+    EXPECT_DOUBLE_EQ(truth[0].clearance(5), 1.5);
+}
+
+TEST(MedialAxisTruthDataTest, BinaryRoundTripIsExact) {
+    MedialAxisChains text;
+    ASSERT_TRUE(loadTruthFile(std::string(MEDIAL_AXIS_TRUTH_DIR) + "/leaf_horizontal.truth", text));
+    std::string path = ::testing::TempDir() + "leaf_horizontal.truthb";
+    ASSERT_TRUE(storeBinaryTruthFile(path, text));
+
+    MedialAxisChains binary;
+    ASSERT_TRUE(loadTruthFile(path, binary));
+    EXPECT_EQ(binary.xs(), text.xs());
+    EXPECT_EQ(binary.ys(), text.ys());
+    EXPECT_EQ(binary.radii(), text.radii());
+    EXPECT_EQ(binary.offsets(), text.offsets());
+    std::remove(path.c_str());
+}
+
+TEST(MedialAxisTruthDataTest, RejectsTruncatedBinaryFiles) {
+    std::string path = ::testing::TempDir() + "truncated.truthb";
+    ASSERT_TRUE(storeBinaryTruthFile(path, sampleChains()));
+    std::string bytes;
+    {
+        std::ifstream in(path, std::ios::binary);
+        bytes.assign((std::istreambuf_iterator<char>(in)), std::istreambuf_iterator<char>());
+    }
+    {
+        std::ofstream out(path, std::ios::binary | std::ios::trunc);
+        out.write(bytes.data(), static_cast<std::streamsize>(bytes.size() - 8));
+    }
+
+    MedialAxisChains chains = sampleChains();
+    EXPECT_FALSE(loadTruthFile(path, chains));
+    EXPECT_EQ(chains.size(), 2u);  // Unchanged
+    EXPECT_FALSE(loadTruthFile(::testing::TempDir() + "missing.truthb", chains));
+    std::remove(path.c_str());
+}
+
+TEST(MedialAxisTruthDataTest, ComparisonReportsTheFirstDifference) {
+    MedialAxisChains expected = sampleChains();
+    EXPECT_TRUE(compareTruthChains(expected, sampleChains(), 0.0));
+
+    MedialAxisChains moved;
+    moved.addChain({Point2D(0.0, 0.0), Point2D(1.0, 0.5), Point2D(2.0, 0.0)}, {0.0, 0.5, 0.0});
+    moved.addChain({Point2D(1.0, 0.5), Point2D(1.0, 2.1)}, {0.5, 0.2});
+    TruthMismatch mismatch;
+    EXPECT_TRUE(compareTruthChains(expected, moved, 0.25));
+    EXPECT_FALSE(compareTruthChains(expected, moved, 0.05, &mismatch));
+    EXPECT_EQ(mismatch.chain, 1u);
+    EXPECT_EQ(mismatch.point, 1u);
+    EXPECT_EQ(mismatch.reason, "position");
+
+    MedialAxisChains shorter;
+    shorter.addChain({Point2D(0.0, 0.0), Point2D(1.0, 0.5), Point2D(2.0, 0.0)}, {0.0, 0.5, 0.0});
+    EXPECT_FALSE(compareTruthChains(expected, shorter, 1.0, &mismatch));
+    EXPECT_EQ(mismatch.reason, "chain count");
+}
+
+TEST(MedialAxisTruthDataTest, FixtureMetadataRoundTripsInBothFormats) {
+    TruthFixture fixture;
+    fixture.engineVersion = "ovd-test 1.2";
+    fixture.polygon = {Point2D(0.0, 0.0), Point2D(2.0, 0.0), Point2D(1.0, 1.0 / 3.0)};
+    fixture.polygonTolerance = 0.01;
+    fixture.medialThreshold = 0.7;
+    fixture.chains = sampleChains();
+
+    for (const char* name : {"fixture.truthb", "fixture.truth"}) {
+        std::string path = ::testing::TempDir() + name;
+        bool binary = std::string(name).back() == 'b';
+        ASSERT_TRUE(binary ? storeBinaryTruthFixture(path, fixture) : storeTextTruthFixture(path, fixture));
+
+        TruthFixture loaded;
+        ASSERT_TRUE(loadTruthFixture(path, loaded)) << name;
+        EXPECT_EQ(loaded.engineVersion, fixture.engineVersion) << name;
+        ASSERT_EQ(loaded.polygon.size(), 3u) << name;
+        EXPECT_EQ(loaded.polygon[2].y, 1.0 / 3.0) << name;  // Exact in both formats
+        EXPECT_EQ(loaded.polygonTolerance, 0.01) << name;
+        EXPECT_EQ(loaded.medialThreshold, 0.7) << name;
+        EXPECT_TRUE(compareTruthChains(fixture.chains, loaded.chains, 0.0)) << name;
+        std::remove(path.c_str());
+    }
+}
@@ -6,7 +6,9 @@
 
 #include <gtest/gtest.h>
 
+#include <algorithm>
 #include <cmath>
+#include <limits>
 
 #include "geometry/MedialAxisUtilities.h"
 
@@ -174,4 +176,231 @@ TEST_F(MedialAxisUtilitiesTest, VeryShortPath) {
     // Should only have endpoints (no interpolation for short segments)
     EXPECT_EQ(result[0].points.size(), 2);
     EXPECT_DOUBLE_EQ(result[0].totalLength, 0.5);
-}
\ No newline at end of file
+}
+// Test in-place sampling of flat chain storage with unit conversion
+TEST_F(MedialAxisUtilitiesTest, ChainStorageSamplingScalesUnits) {
+    // Same geometry in cm (flat storage) and mm (nested vectors)
+    std::vector<std::vector<Point2D>> chainsCm = {{Point2D(0, 0), Point2D(0.4, 0.3), Point2D(1.2, 0.3)},
+                                                  {Point2D(1.2, 0.3), Point2D(1.2, 2.0)}};
+    std::vector<std::vector<double>> clearancesCm = {{0.0, 0.2, 0.1}, {0.1, 0.0}};
+    std::vector<std::vector<Point2D>> chainsMm = {{Point2D(0, 0), Point2D(4, 3), Point2D(12, 3)},
+                                                  {Point2D(12, 3), Point2D(12, 20)}};
+    std::vector<std::vector<double>> clearancesMm = {{0.0, 2.0, 1.0}, {1.0, 0.0}};
+
+    auto expected = sampleMedialAxisPaths(chainsMm, clearancesMm, 1.5);
+
+    std::vector<SampledMedialPath> result;
+    sampleMedialAxisChains(MedialAxisChains::fromNested(chainsCm, clearancesCm), 10.0, 1.5, result);
+
+    ASSERT_EQ(result.size(), expected.size());
+    for (size_t i = 0; i < expected.size(); ++i) {
+        EXPECT_NEAR(result[i].totalLength, expected[i].totalLength, 1e-9);
+        ASSERT_EQ(result[i].points.size(), expected[i].points.size());
+        for (size_t j = 0; j < expected[i].points.size(); ++j) {
+            EXPECT_TRUE(pointsEqual(result[i].points[j].position, expected[i].points[j].position, 1e-9));
+            EXPECT_NEAR(result[i].points[j].clearanceRadius, expected[i].points[j].clearanceRadius, 1e-9);
+        }
+    }
+}
+
+// Test that sampled paths are appended to caller storage
+TEST_F(MedialAxisUtilitiesTest, ChainStorageSamplingAppends) {
+    MedialAxisChains chains;
+    chains.addChain({Point2D(0, 0), Point2D(10, 0)}, {0.0, 0.0});
+    chains.beginChain();  // Empty chains produce no path
+    chains.addChain({Point2D(5, 5)}, {1.0});
+
+    std::vector<SampledMedialPath> result(1);
+    sampleMedialAxisChains(chains, 1.0, 1.0, result);
+
+    ASSERT_EQ(result.size(), 3u);
+    EXPECT_TRUE(result[0].points.empty());
+    EXPECT_EQ(result[1].points.size(), 11u);
+    EXPECT_DOUBLE_EQ(result[1].totalLength, 10.0);
+    ASSERT_EQ(result[2].points.size(), 1u);
+    EXPECT_DOUBLE_EQ(result[2].points[0].clearanceRadius, 1.0);
+}
+
+// Test that boundary crossings are found and sampled exactly
+TEST_F(MedialAxisUtilitiesTest, BoundaryCrossingsAreSampledExactly) {
+    // A chain from (0, 0) to (10, 0) crossing the hole's left and right edges at x = 3.25 and 6.75
+    MedialAxisChains chains;
+    chains.addChain({Point2D(0, 0), Point2D(10, 0)}, {1.0, 2.0});
+    std::vector<Point2D> hole = {Point2D(3.25, -1), Point2D(6.75, -1), Point2D(6.75, 1), Point2D(3.25, 1)};
+
+    std::vector<std::vector<double>> crossings;
+    findChainBoundaryCrossings(chains, {&hole}, 1.0, crossings);
+    ASSERT_EQ(crossings.size(), 1u);
+    ASSERT_EQ(crossings[0].size(), 2u);
+    EXPECT_NEAR(crossings[0][0], 3.25, 1e-9);
+    EXPECT_NEAR(crossings[0][1], 6.75, 1e-9);
+
+    std::vector<SampledMedialPath> result;
+    sampleMedialAxisChains(chains, 1.0, 1.0, result, &crossings);
+    ASSERT_EQ(result.size(), 1u);
+    const auto& points = result[0].points;
+    EXPECT_TRUE(pointsEqual(points.front().position, Point2D(0, 0), 1e-9));
+    EXPECT_TRUE(pointsEqual(points.back().position, Point2D(10, 0), 1e-9));
+    for (double x : {3.25, 6.75}) {
+        auto at = std::find_if(points.begin(), points.end(), [&](const SampledMedialPoint& point) {
+            return pointsEqual(point.position, Point2D(x, 0), 1e-9);
+        });
+        ASSERT_NE(at, points.end()) << "no sample at x = " << x;
+        EXPECT_NEAR(at->clearanceRadius, 1.0 + x / 10.0, 1e-9);
+    }
+    for (size_t i = 1; i < points.size(); ++i) {
+        EXPECT_GT(points[i].position.x, points[i - 1].position.x);
+        EXPECT_GE(distance(points[i].position, points[i - 1].position), 0.1 - 1e-9);
+    }
+
+    // Without crossings the fixed spacing stays as it was
+    std::vector<SampledMedialPath> regular;
+    sampleMedialAxisChains(chains, 1.0, 1.0, regular);
+    ASSERT_EQ(regular.size(), 1u);
+    EXPECT_EQ(regular[0].points.size(), 11u);
+}
+
+// Test that adaptive sampling collapses straight constant-clearance runs
+TEST_F(MedialAxisUtilitiesTest, AdaptiveSamplingSparsifiesStraightRuns) {
+    MedialAxisChains chains;
+    std::vector<Point2D> points;
+    for (int i = 0; i <= 50; ++i) {
+        points.emplace_back(i * 0.5, 2.0);
+    }
+    chains.addChain(points, std::vector<double>(points.size(), 1.5));
+
+    std::vector<SampledMedialPath> result;
+    sampleMedialAxisChainsAdaptive(chains, 1.0, AdaptiveSamplingOptions(), result);
+
+    ASSERT_EQ(result.size(), 1u);
+    ASSERT_EQ(result[0].points.size(), 2u);
+    EXPECT_TRUE(pointsEqual(result[0].points.front().position, Point2D(0.0, 2.0)));
+    EXPECT_TRUE(pointsEqual(result[0].points.back().position, Point2D(25.0, 2.0)));
+    EXPECT_DOUBLE_EQ(result[0].totalLength, 25.0);
+}
+
+// Test that corners and clearance changes keep their vertices
+TEST_F(MedialAxisUtilitiesTest, AdaptiveSamplingKeepsCornersAndDepthChanges) {
+    // L-shaped chain with constant clearance, then a straight run whose clearance ramps up and back
+    MedialAxisChains chains;
+    chains.addChain({Point2D(0, 0), Point2D(5, 0), Point2D(10, 0), Point2D(10, 5), Point2D(10, 10)},
+                    {1.0, 1.0, 1.0, 1.0, 1.0});
+    chains.addChain({Point2D(0, 20), Point2D(5, 20), Point2D(10, 20)}, {0.0, 2.0, 0.0});
+
+    AdaptiveSamplingOptions options;
+    options.chordTolerance = 0.05;
+    std::vector<SampledMedialPath> result;
+    sampleMedialAxisChainsAdaptive(chains, 1.0, options, result);
+
+    ASSERT_EQ(result.size(), 2u);
+    ASSERT_EQ(result[0].points.size(), 3u);
+    EXPECT_TRUE(pointsEqual(result[0].points[1].position, Point2D(10, 0)));
+    ASSERT_EQ(result[1].points.size(), 3u);
+    EXPECT_DOUBLE_EQ(result[1].points[1].clearanceRadius, 2.0);
+
+    // A depth clamp flattens the peak below 1 mm of deviation
+    options.chordTolerance = 1.0;
+    options.maxDepth = 0.5;
+    result.clear();
+    sampleMedialAxisChainsAdaptive(chains, 1.0, options, result);
+    EXPECT_EQ(result[1].points.size(), 2u);
+}
+
+// Test the spacing cap and unit scale of adaptive sampling
+TEST_F(MedialAxisUtilitiesTest, AdaptiveSamplingHonoursMaxSpacing) {
+    MedialAxisChains chains;
+    chains.addChain({Point2D(0, 0), Point2D(1, 0)}, {0.1, 0.3});  // cm
+
+    AdaptiveSamplingOptions options;
+    options.maxSpacing = 2.5;  // mm
+    std::vector<SampledMedialPath> result;
+    sampleMedialAxisChainsAdaptive(chains, 10.0, options, result);
+
+    ASSERT_EQ(result.size(), 1u);
+    ASSERT_EQ(result[0].points.size(), 5u);
+    EXPECT_DOUBLE_EQ(result[0].totalLength, 10.0);
+    for (size_t i = 0; i < result[0].points.size(); ++i) {
+        EXPECT_NEAR(result[0].points[i].position.x, 2.5 * i, 1e-9);
+        EXPECT_NEAR(result[0].points[i].clearanceRadius, 1.0 + 0.5 * i, 1e-9);
+    }
+}
+
+// Test that exact sampling evaluates the chain at evenly spaced distances
+TEST_F(MedialAxisUtilitiesTest, ExactSamplingEvaluatesEvenDistances) {
+    MedialAxisChains chains;
+    chains.addChain({Point2D(0, 0), Point2D(0.3, 0), Point2D(0.3, 0.4)}, {0.1, 0.4, 0.0});  // cm
+
+    std::vector<SampledMedialPath> result;
+    sampleMedialAxisChainsExact(chains, 10.0, 1.0, {}, result);
+
+    ASSERT_EQ(result.size(), 1u);
+    EXPECT_DOUBLE_EQ(result[0].totalLength, 7.0);
+    const auto& points = result[0].points;
+    ASSERT_EQ(points.size(), 8u);
+    for (size_t i = 0; i < points.size(); ++i) {
+        double s = static_cast<double>(i);
+        Point2D expected = s <= 3.0 ? Point2D(s, 0) : Point2D(3, s - 3.0);
+        EXPECT_TRUE(pointsEqual(points[i].position, expected, 1e-9)) << i;
+        double clearance = s <= 3.0 ? 1.0 + s : 7.0 - s;
+        EXPECT_NEAR(points[i].clearanceRadius, clearance, 1e-9) << i;
+    }
+}
+
+// Test that exact sampling measures clearance to the boundary and keeps forced samples
+TEST_F(MedialAxisUtilitiesTest, ExactSamplingMeasuresClearanceToTheBoundary) {
+    std::vector<Point2D> square = {Point2D(0, 0), Point2D(1, 0), Point2D(1, 1), Point2D(0, 1)};  // cm
+    MedialAxisChains chains;
+    chains.addChain({Point2D(0.2, 0.5), Point2D(0.8, 0.5)}, {0.9, 0.9});  // Deliberately wrong clearances
+    std::vector<std::vector<double>> forced = {{2.5}};
+
+    std::vector<SampledMedialPath> result;
+    sampleMedialAxisChainsExact(chains, 10.0, 1.0, {&square}, result, &forced);
+
+    ASSERT_EQ(result.size(), 1u);
+    const auto& points = result[0].points;
+    std::vector<double> xs;
+    for (const auto& point : points) {
+        xs.push_back(point.position.x);
+        double x = point.position.x;
+        EXPECT_NEAR(point.clearanceRadius, std::min({x, 10.0 - x, 5.0}), 1e-9) << x;
+    }
+    std::vector<double> expected = {2.0, 3.0, 4.0, 4.5, 5.0, 6.0, 7.0, 8.0};
+    ASSERT_EQ(xs.size(), expected.size());
+    for (size_t i = 0; i < xs.size(); ++i) {
+        EXPECT_NEAR(xs[i], expected[i], 1e-9);
+        EXPECT_EQ(points[i].forced, i == 3) << xs[i];
+    }
+}
+
+// Test the boundary distance search against every edge on a many-sided profile
+TEST_F(MedialAxisUtilitiesTest, ExactSamplingClearanceMatchesEveryEdgeTested) {
+    // A 400-sided star with a hole, so nearest edges lie in many different grid cells
+    std::vector<Point2D> star;
+    for (int i = 0; i < 400; ++i) {
+        double angle = 2.0 * M_PI * i / 400.0;
+        double radius = (i % 2 == 0) ? 10.0 : 9.0;
+        star.emplace_back(radius * std::cos(angle), radius * std::sin(angle));
+    }
+    std::vector<Point2D> hole = {Point2D(-1, -1), Point2D(-1, 1), Point2D(1, 1), Point2D(1, -1)};
+    MedialAxisChains chains;
+    chains.addChain({Point2D(-8, -3), Point2D(-2, 4), Point2D(5, 6), Point2D(7.5, -2)}, {1, 1, 1, 1});
+
+    std::vector<SampledMedialPath> result;
+    sampleMedialAxisChainsExact(chains, 1.0, 0.37, {&star, &hole}, result);
+
+    ASSERT_EQ(result.size(), 1u);
+    EXPECT_GT(result[0].points.size(), 50u);
+    for (const auto& point : result[0].points) {
+        double nearest = std::numeric_limits<double>::infinity();
+        for (const auto* loop : {&star, &hole}) {
+            for (size_t i = 0; i < loop->size(); ++i) {
+                Point2D a = (*loop)[i];
+                Point2D b = (*loop)[(i + 1) % loop->size()];
+                Point2D d = b - a;
+                double t = ((point.position.x - a.x) * d.x + (point.position.y - a.y) * d.y) / (d.x * d.x + d.y * d.y);
+                nearest = std::min(nearest, distance(point.position, a + d * std::max(0.0, std::min(1.0, t))));
+            }
+        }
+        EXPECT_NEAR(point.clearanceRadius, nearest, 1e-12);
+    }
+}
@@ -0,0 +1,167 @@
+/**
+ * test_PointKernels.cpp
+ *
+ * Unit tests for the batch point kernels, checked against the scalar Point2D
+ * helpers at every length around the vector width
+ */
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <cstring>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "geometry/PointKernels.h"
+
+using namespace ChipCarving::Geometry;
+
+namespace {
+
+constexpr size_t MAX_COUNT = 40;
+
+std::vector<Point2D> randomPoints(size_t count, unsigned seed) {
+    std::mt19937 random(seed);
+    std::uniform_real_distribution<double> coordinate(-50.0, 50.0);
+    std::vector<Point2D> points;
+    for (size_t i = 0; i < count; ++i) {
+        points.emplace_back(coordinate(random), coordinate(random));
+    }
+    return points;
+}
+
+void split(const std::vector<Point2D>& points, std::vector<double>& x, std::vector<double>& y) {
+    x.clear();
+    y.clear();
+    for (const auto& point : points) {
+        x.push_back(point.x);
+        y.push_back(point.y);
+    }
+}
+
+}  // namespace
+
+TEST(PointKernelsTest, ReportsTheInstructionSetBuiltFor) {
+    std::string name = pointKernelInstructionSet();
+    EXPECT_TRUE(name == "avx2" || name == "sse2" || name == "neon" || name == "scalar") << name;
+}
+
+TEST(PointKernelsTest, BoundsMatchAScalarScan) {
+    for (size_t count = 1; count <= MAX_COUNT; ++count) {
+        std::vector<Point2D> points = randomPoints(count, static_cast<unsigned>(count));
+        std::vector<double> x, y;
+        split(points, x, y);
+
+        Point2D low = points[0];
+        Point2D high = points[0];
+        for (const auto& point : points) {
+            low = Point2D(std::min(low.x, point.x), std::min(low.y, point.y));
+            high = Point2D(std::max(high.x, point.x), std::max(high.y, point.y));
+        }
+
+        for (const PointBounds& bounds : {pointBounds(points.data(), count), pointBounds(x.data(), y.data(), count)}) {
+            EXPECT_EQ(bounds.min.x, low.x) << count;
+            EXPECT_EQ(bounds.min.y, low.y) << count;
+            EXPECT_EQ(bounds.max.x, high.x) << count;
+            EXPECT_EQ(bounds.max.y, high.y) << count;
+        }
+    }
+
+    PointBounds empty = pointBounds(static_cast<const Point2D*>(nullptr), 0);
+    EXPECT_EQ(empty.min.x, 0.0);
+    EXPECT_EQ(empty.max.y, 0.0);
+}
+
+TEST(PointKernelsTest, TransformMatchesPointArithmeticInPlaceOrNot) {
+    Point2D offset(3.25, -1.5);
+    double scale = 0.0173;
+    for (size_t count = 0; count <= MAX_COUNT; ++count) {
+        std::vector<Point2D> points = randomPoints(count, 100 + static_cast<unsigned>(count));
+        std::vector<Point2D> out(count);
+        transformPoints(points.data(), count, offset, scale, out.data());
+        for (size_t i = 0; i < count; ++i) {
+            Point2D expected = (points[i] - offset) * scale;
+            EXPECT_EQ(out[i].x, expected.x) << count << " " << i;
+            EXPECT_EQ(out[i].y, expected.y) << count << " " << i;
+        }
+
+        transformPoints(points.data(), count, offset, scale, points.data());
+        EXPECT_EQ(0, count == 0 ? 0 : std::memcmp(points.data(), out.data(), count * sizeof(Point2D))) << count;
+    }
+}
+
+TEST(PointKernelsTest, SegmentLengthsMatchDistanceBetweenScaledPoints) {
+    double scale = 10.0;
+    for (size_t count = 0; count <= MAX_COUNT; ++count) {
+        std::vector<Point2D> points = randomPoints(count, 200 + static_cast<unsigned>(count));
+        std::vector<double> x, y;
+        split(points, x, y);
+
+        std::vector<double> lengths(count, -1.0);
+        segmentLengths(x.data(), y.data(), count, scale, lengths.data());
+        std::vector<double> prefix(count);
+        double total = cumulativeLengths(x.data(), y.data(), count, scale, prefix.data());
+
+        double expectedTotal = 0.0;
+        for (size_t i = 0; i + 1 < count; ++i) {
+            double expected = distance(points[i] * scale, points[i + 1] * scale);
+            EXPECT_EQ(lengths[i], expected) << count << " " << i;
+            expectedTotal += expected;
+            EXPECT_EQ(prefix[i + 1], expectedTotal) << count << " " << i;
+        }
+        if (count > 0) {
+            EXPECT_EQ(prefix[0], 0.0);
+            EXPECT_EQ(lengths[count - 1], -1.0) << "wrote past count - 1 lengths";
+        }
+        EXPECT_EQ(total, expectedTotal) << count;
+    }
+}
+
+TEST(PointKernelsTest, NearestPointMatchesALinearSearchAndKeepsTheFirstTie) {
+    Point2D query(1.0, -2.0);
+    for (size_t count : {size_t(1), size_t(2), size_t(7), size_t(64), size_t(65), size_t(200)}) {
+        std::vector<Point2D> points = randomPoints(count, 300 + static_cast<unsigned>(count));
+        std::vector<double> x, y;
+        split(points, x, y);
+
+        size_t expected = 0;
+        for (size_t i = 1; i < count; ++i) {
+            if (distance(points[i], query) < distance(points[expected], query)) {
+                expected = i;
+            }
+        }
+        double distanceSquared = -1.0;
+        EXPECT_EQ(nearestPoint(x.data(), y.data(), count, query, distanceSquared), expected) << count;
+        EXPECT_DOUBLE_EQ(distanceSquared, distance(points[expected], query) * distance(points[expected], query));
+    }
+
+    // Equally near points on either side of a block boundary
+    std::vector<double> x(130, 10.0), y(130, 10.0);
+    x[70] = x[3] = 1.0;
+    y[70] = y[3] = -2.0;
+    double distanceSquared = -1.0;
+    EXPECT_EQ(nearestPoint(x.data(), y.data(), x.size(), query, distanceSquared), 3u);
+    EXPECT_EQ(distanceSquared, 0.0);
+}
+
+TEST(PointKernelsTest, DistancesAndLinearFormsMatchScalarArithmetic) {
+    Point2D center(3.5, -2.25);
+    Point2D origin(1.0, 2.0);
+    Point2D coefficients(0.75, -1.5);
+    for (size_t count = 0; count <= MAX_COUNT; ++count) {
+        std::vector<Point2D> points = randomPoints(count, 400 + static_cast<unsigned>(count));
+        std::vector<double> x, y;
+        split(points, x, y);
+
+        std::vector<double> distances(count);
+        std::vector<double> forms(count);
+        pointDistances(x.data(), y.data(), count, center, distances.data());
+        linearForms(x.data(), y.data(), count, origin, coefficients, 3.0, forms.data());
+        for (size_t i = 0; i < count; ++i) {
+            EXPECT_EQ(distances[i], distance(points[i], center)) << count << " " << i;
+            EXPECT_EQ(forms[i], (coefficients.x * (x[i] - origin.x) + coefficients.y * (y[i] - origin.y)) / 3.0)
+                << count << " " << i;
+        }
+    }
+}
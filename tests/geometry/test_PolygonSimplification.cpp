@@ -0,0 +1,109 @@
+/**
+ * test_PolygonSimplification.cpp
+ *
+ * Unit tests for corner-preserving polygon simplification
+ */
+
+#include <gtest/gtest.h>
+
+#include <cmath>
+#include <vector>
+
+#include "geometry/MedialAxisProcessor.h"
+#include "geometry/PolygonSimplification.h"
+
+using namespace ChipCarving::Geometry;
+
+namespace {
+
+constexpr double PI = 3.14159265358979323846;
+constexpr double CORNER_ANGLE = 20.0 * PI / 180.0;
+
+// 4 x 2 rectangle with every side tessellated at the given step
+std::vector<Point2D> denseRectangle(double step) {
+    std::vector<Point2D> polygon;
+    const Point2D corners[] = {Point2D(0.0, 0.0), Point2D(4.0, 0.0), Point2D(4.0, 2.0), Point2D(0.0, 2.0)};
+    for (int side = 0; side < 4; ++side) {
+        const Point2D& a = corners[side];
+        const Point2D& b = corners[(side + 1) % 4];
+        int steps = static_cast<int>(std::lround(distance(a, b) / step));
+        for (int k = 0; k < steps; ++k) {
+            double t = static_cast<double>(k) / steps;
+            polygon.emplace_back(a.x + (b.x - a.x) * t, a.y + (b.y - a.y) * t);
+        }
+    }
+    return polygon;
+}
+
+// Shortest distance from point to the closed outline
+double distanceToOutline(const Point2D& point, const std::vector<Point2D>& outline) {
+    double best = INFINITY;
+    for (size_t i = 0; i < outline.size(); ++i) {
+        const Point2D& a = outline[i];
+        const Point2D& b = outline[(i + 1) % outline.size()];
+        double dx = b.x - a.x;
+        double dy = b.y - a.y;
+        double t = std::max(0.0, std::min(1.0, ((point.x - a.x) * dx + (point.y - a.y) * dy) / (dx * dx + dy * dy)));
+        best = std::min(best, distance(point, Point2D(a.x + t * dx, a.y + t * dy)));
+    }
+    return best;
+}
+
+}  // namespace
+
+TEST(PolygonSimplificationTest, CollinearVerticesCollapseToCorners) {
+    std::vector<Point2D> polygon = denseRectangle(0.001);
+    ASSERT_EQ(polygon.size(), 12000u);
+
+    std::vector<Point2D> simplified = simplifyPolygon(polygon, 0.01, CORNER_ANGLE);
+    ASSERT_EQ(simplified.size(), 4u);
+    EXPECT_EQ(distance(simplified[0], Point2D(0.0, 0.0)), 0.0);
+    EXPECT_EQ(distance(simplified[2], Point2D(4.0, 2.0)), 0.0);
+}
+
+TEST(PolygonSimplificationTest, ArcsStayWithinTolerance) {
+    // Disc with a notch: the arc is smooth, the notch has sharp corners
+    std::vector<Point2D> polygon;
+    for (int i = 0; i < 2000; ++i) {
+        double angle = 2.0 * PI * i / 2000.0;
+        polygon.emplace_back(std::cos(angle), std::sin(angle));
+    }
+    polygon.emplace_back(0.2, -0.05);
+
+    const double tolerance = 1.0e-3;
+    std::vector<Point2D> simplified = simplifyPolygon(polygon, tolerance, CORNER_ANGLE);
+    EXPECT_LT(simplified.size(), polygon.size() / 10);
+    for (const auto& point : polygon) {
+        EXPECT_LE(distanceToOutline(point, simplified), tolerance * (1.0 + 1e-9));
+    }
+    // The notch tip is a corner
+    bool keptNotch = false;
+    for (const auto& point : simplified) {
+        keptNotch = keptNotch || distance(point, Point2D(0.2, -0.05)) == 0.0;
+    }
+    EXPECT_TRUE(keptNotch);
+}
+
+TEST(PolygonSimplificationTest, KeepsClosingDuplicateAndSmallPolygons) {
+    std::vector<Point2D> closed = denseRectangle(0.5);
+    closed.push_back(closed.front());
+    std::vector<Point2D> simplified = simplifyPolygon(closed, 0.01, CORNER_ANGLE);
+    ASSERT_EQ(simplified.size(), 5u);
+    EXPECT_EQ(distance(simplified.front(), simplified.back()), 0.0);
+
+    std::vector<Point2D> triangle = {Point2D(0.0, 0.0), Point2D(1.0, 0.0), Point2D(0.5, 1.0)};
+    EXPECT_EQ(simplifyPolygon(triangle, 10.0, CORNER_ANGLE).size(), 3u);
+    EXPECT_EQ(simplifyPolygon(closed, 0.0, CORNER_ANGLE).size(), closed.size());
+}
+
+TEST(PolygonSimplificationTest, ProcessorSimplifiesInputWhenEnabled) {
+    MedialAxisProcessor processor;
+    EXPECT_FALSE(processor.getSimplifyInput());
+    processor.setPolygonTolerance(0.01);
+    processor.setSimplifyInput(true);
+    MedialAxisResults simplified = processor.computeMedialAxis(denseRectangle(0.01));
+    processor.setSimplifyInput(false);
+    MedialAxisResults full = processor.computeMedialAxis(denseRectangle(0.01));
+    EXPECT_TRUE(simplified.success);
+    EXPECT_TRUE(full.success);
+}
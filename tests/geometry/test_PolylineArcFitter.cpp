@@ -0,0 +1,152 @@
+/**
+ * test_PolylineArcFitter.cpp
+ *
+ * Unit tests for splitting 3D toolpath polylines into line and arc spans.
+ * Verifies arc detection on circular runs, line runs elsewhere, and that spans
+ * always chain end to end.
+ */
+
+#include <gtest/gtest.h>
+
+#include <cmath>
+#include <vector>
+
+#include "geometry/PolylineArcFitter.h"
+
+using namespace ChipCarving::Geometry;
+
+namespace {
+
+std::vector<Point3D> arcPoints(double radius, double startAngle, double endAngle, int count, double z) {
+    std::vector<Point3D> points;
+    for (int i = 0; i < count; ++i) {
+        double angle = startAngle + (endAngle - startAngle) * i / (count - 1);
+        points.emplace_back(radius * std::cos(angle), radius * std::sin(angle), z);
+    }
+    return points;
+}
+
+void expectChained(const std::vector<PolylineSpan>& spans, size_t pointCount) {
+    ASSERT_FALSE(spans.empty());
+    EXPECT_EQ(spans.front().first, 0u);
+    EXPECT_EQ(spans.back().last, pointCount - 1);
+    for (size_t i = 1; i < spans.size(); ++i) {
+        EXPECT_EQ(spans[i].first, spans[i - 1].last);
+    }
+}
+
+}  // namespace
+
+TEST(PolylineArcFitterTest, CircularRunBecomesOneArc) {
+    auto points = arcPoints(5.0, 0.0, 1.5 * M_PI, 40, -1.0);
+
+    auto spans = fitPolylineSpans(points, 0.01);
+
+    ASSERT_EQ(spans.size(), 1u);
+    EXPECT_TRUE(spans[0].isArc);
+    EXPECT_EQ(spans[0].first, 0u);
+    EXPECT_EQ(spans[0].last, points.size() - 1);
+}
+
+TEST(PolylineArcFitterTest, TiltedArcIsDetected) {
+    // Circle in a plane tilted about the X axis
+    std::vector<Point3D> points;
+    for (const auto& p : arcPoints(3.0, 0.2, 2.0, 12, 0.0)) {
+        points.emplace_back(p.x, p.y * std::cos(0.4), p.y * std::sin(0.4));
+    }
+
+    auto spans = fitPolylineSpans(points, 0.001);
+    ASSERT_EQ(spans.size(), 1u);
+    EXPECT_TRUE(spans[0].isArc);
+}
+
+TEST(PolylineArcFitterTest, CornersStayLines) {
+    std::vector<Point3D> points = {Point3D(0, 0, 0), Point3D(4, 0, -1), Point3D(4, 4, -0.5), Point3D(0, 4, 0),
+                                   Point3D(0, 8, -2)};
+
+    auto spans = fitPolylineSpans(points, 0.01);
+
+    ASSERT_EQ(spans.size(), 1u);
+    EXPECT_FALSE(spans[0].isArc);
+    expectChained(spans, points.size());
+}
+
+TEST(PolylineArcFitterTest, MixedLinesAndArcsChain) {
+    // Straight lead-in, a half circle, then a straight lead-out
+    std::vector<Point3D> points = {Point3D(-5, -10, 0), Point3D(-5, -6, 0), Point3D(-5, -3, 0)};
+    auto arc = arcPoints(5.0, M_PI, 2.0 * M_PI, 20, 0.0);
+    for (auto& p : arc) {
+        points.emplace_back(p.x, p.y - 3.0, p.z);
+    }
+    points.emplace_back(5, -1, 0);
+    points.emplace_back(5, 2, -0.5);
+
+    auto spans = fitPolylineSpans(points, 0.01);
+
+    expectChained(spans, points.size());
+    size_t arcSpans = 0;
+    for (const auto& span : spans) {
+        if (span.isArc) {
+            arcSpans++;
+            EXPECT_GE(span.last - span.first + 1, MIN_ARC_POINTS);
+        }
+    }
+    EXPECT_EQ(arcSpans, 1u);
+}
+
+TEST(PolylineArcFitterTest, ArcEndsAtTheLastPointOnItsCircle) {
+    // A long arc, then a step straight out from the center
+    auto points = arcPoints(50.0, 0.0, 0.75 * M_PI, 200, 0.0);
+    Point3D last = points.back();
+    points.emplace_back(last.x * 1.1, last.y * 1.1, 0.0);
+    points.emplace_back(last.x * 1.2, last.y * 1.2, 0.0);
+
+    auto spans = fitPolylineSpans(points, 0.001);
+    expectChained(spans, points.size());
+    ASSERT_EQ(spans.size(), 2u);
+    EXPECT_TRUE(spans[0].isArc);
+    EXPECT_EQ(spans[0].last, 199u);
+    EXPECT_FALSE(spans[1].isArc);
+
+    auto helical = fitHelicalArcSpans(points, 0.001);
+    ASSERT_EQ(helical.size(), 2u);
+    EXPECT_EQ(helical[0].last, 199u);
+}
+
+TEST(PolylineArcFitterTest, ZeroToleranceGivesLinesOnly) {
+    auto points = arcPoints(5.0, 0.0, M_PI, 10, 0.0);
+    auto spans = fitPolylineSpans(points, 0.0);
+
+    ASSERT_EQ(spans.size(), 1u);
+    EXPECT_FALSE(spans[0].isArc);
+    expectChained(spans, points.size());
+
+    EXPECT_TRUE(fitPolylineSpans({Point3D(0, 0, 0)}, 0.01).empty());
+}
+
+TEST(PolylineArcFitterTest, HelicalSpansRequireZLinearInSweep) {
+    // Ramp down along a 3/4 circle: not planar, but a single XY helix
+    auto points = arcPoints(5.0, 0.0, 1.5 * M_PI, 40, 0.0);
+    for (size_t i = 0; i < points.size(); ++i) {
+        points[i].z = -0.05 * static_cast<double>(i);
+    }
+
+    auto helical = fitHelicalArcSpans(points, 0.01);
+    ASSERT_EQ(helical.size(), 1u);
+    EXPECT_TRUE(helical[0].isArc);
+
+    HelicalArc arc;
+    ASSERT_TRUE(helicalArcThrough(points.front(), points[20], points.back(), arc));
+    EXPECT_NEAR(arc.center.x, 0.0, 1e-9);
+    EXPECT_NEAR(arc.center.y, 0.0, 1e-9);
+    EXPECT_NEAR(arc.radius, 5.0, 1e-9);
+    EXPECT_TRUE(arc.counterClockwise);
+
+    // Z that is faster at the start than the end breaks the helix into pieces
+    for (size_t i = 0; i < points.size(); ++i) {
+        points[i].z = -2.0 * std::sqrt(static_cast<double>(i) / (points.size() - 1));
+    }
+    auto bent = fitHelicalArcSpans(points, 0.01);
+    expectChained(bent, points.size());
+    EXPECT_GT(bent.size(), 1u);
+}
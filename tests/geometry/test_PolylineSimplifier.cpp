@@ -0,0 +1,96 @@
+/**
+ * test_PolylineSimplifier.cpp
+ *
+ * Unit tests for Douglas-Peucker simplification of 3D toolpath polylines.
+ * Verifies that collinear points are removed, features above tolerance are kept,
+ * and the simplified curve stays within tolerance of the original.
+ */
+
+#include <gtest/gtest.h>
+
+#include <cmath>
+#include <vector>
+
+#include "geometry/PolylineSimplifier.h"
+
+using namespace ChipCarving::Geometry;
+
+namespace {
+
+// Distance from p to segment ab
+double distanceToSegment(const Point3D& p, const Point3D& a, const Point3D& b) {
+    Point3D d = b - a;
+    double len2 = d.x * d.x + d.y * d.y + d.z * d.z;
+    double t = len2 > 0 ? ((p.x - a.x) * d.x + (p.y - a.y) * d.y + (p.z - a.z) * d.z) / len2 : 0.0;
+    t = std::max(0.0, std::min(1.0, t));
+    return p.distance(a + d * t);
+}
+
+}  // namespace
+
+TEST(PolylineSimplifierTest, CollinearPointsAreRemoved) {
+    std::vector<Point3D> points;
+    for (int i = 0; i <= 100; ++i) {
+        points.emplace_back(i * 0.1, i * 0.05, -i * 0.02);
+    }
+
+    PolylineSimplifier simplifier;
+    EXPECT_EQ(simplifier.simplify(points, 0.001), 99u);
+    ASSERT_EQ(points.size(), 2u);
+    EXPECT_EQ(points.front(), Point3D(0, 0, 0));
+    EXPECT_EQ(points.back(), Point3D(10.0, 5.0, -2.0));
+}
+
+TEST(PolylineSimplifierTest, DepthChangesAreKept) {
+    // Straight in XY, but the depth dips in the middle
+    std::vector<Point3D> points = {Point3D(0, 0, 0), Point3D(1, 0, 0), Point3D(2, 0, -0.5), Point3D(3, 0, 0),
+                                   Point3D(4, 0, 0)};
+
+    PolylineSimplifier simplifier;
+    std::vector<bool> keep;
+    simplifier.markRequired(points, 0.3, keep);
+    EXPECT_EQ(keep, (std::vector<bool>{true, false, true, false, true}));
+
+    simplifier.simplify(points, 1.0);
+    EXPECT_EQ(points.size(), 2u);
+}
+
+TEST(PolylineSimplifierTest, SimplifiedCurveStaysWithinTolerance) {
+    std::vector<Point3D> original;
+    for (int i = 0; i <= 400; ++i) {
+        double t = i * 0.02;
+        original.emplace_back(10.0 * std::cos(t), 10.0 * std::sin(t), -1.0 - 0.5 * std::sin(3.0 * t));
+    }
+
+    const double tolerance = 0.01;
+    auto simplified = original;
+    PolylineSimplifier simplifier;
+    simplifier.simplify(simplified, tolerance);
+
+    EXPECT_LT(simplified.size(), original.size() / 2);
+    EXPECT_EQ(simplified.front(), original.front());
+    EXPECT_EQ(simplified.back(), original.back());
+
+    // Every original point lies within tolerance of the simplified polyline
+    for (const auto& point : original) {
+        double best = 1e9;
+        for (size_t i = 1; i < simplified.size(); ++i) {
+            best = std::min(best, distanceToSegment(point, simplified[i - 1], simplified[i]));
+        }
+        EXPECT_LE(best, tolerance + 1e-12);
+    }
+}
+
+TEST(PolylineSimplifierTest, ShortAndClosedPolylines) {
+    PolylineSimplifier simplifier;
+
+    std::vector<Point3D> pair = {Point3D(0, 0, 0), Point3D(1, 1, 1)};
+    EXPECT_EQ(simplifier.simplify(pair, 10.0), 0u);
+    EXPECT_EQ(pair.size(), 2u);
+
+    // Closed loop: chord is degenerate, so the farthest point is kept
+    std::vector<Point3D> loop = {Point3D(0, 0, 0), Point3D(1, 0, 0), Point3D(1, 1, 0), Point3D(0, 1, 0),
+                                 Point3D(0, 0, 0)};
+    simplifier.simplify(loop, 0.01);
+    EXPECT_EQ(loop.size(), 5u);
+}
@@ -0,0 +1,152 @@
+/**
+ * test_ProfileCurve.cpp
+ *
+ * Unit tests for chord-error polygonization of exact profile curves
+ */
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+#include "geometry/ProfileCurve.h"
+#include "geometry/Shape.h"
+#include "geometry/ShapePolygonizer.h"
+
+using namespace ChipCarving::Geometry;
+
+namespace {
+
+double signedArea(const std::vector<Point2D>& polygon) {
+    double area = 0.0;
+    for (size_t i = 0; i < polygon.size(); ++i) {
+        const Point2D& a = polygon[i];
+        const Point2D& b = polygon[(i + 1) % polygon.size()];
+        area += a.x * b.y - b.x * a.y;
+    }
+    return 0.5 * area;
+}
+
+double distanceToPolyline(const Point2D& point, const std::vector<Point2D>& polyline) {
+    double best = distance(point, polyline.front());
+    for (size_t i = 0; i + 1 < polyline.size(); ++i) {
+        Point2D ab = polyline[i + 1] - polyline[i];
+        double lengthSquared = ab.x * ab.x + ab.y * ab.y;
+        double t = lengthSquared > 0.0
+                       ? ((point.x - polyline[i].x) * ab.x + (point.y - polyline[i].y) * ab.y) / lengthSquared
+                       : 0.0;
+        t = std::max(0.0, std::min(1.0, t));
+        best = std::min(best, distance(point, polyline[i] + ab * t));
+    }
+    return best;
+}
+
+// Quarter of the unit circle as a rational quadratic
+ProfileCurve quarterCircleSpline() {
+    return makeSplineCurve(2, {Point2D(1, 0), Point2D(1, 1), Point2D(0, 1)}, {1.0, std::sqrt(0.5), 1.0},
+                           {0, 0, 0, 1, 1, 1});
+}
+
+}  // namespace
+
+TEST(ProfileCurveTest, ArcChordsStayWithinTolerance) {
+    ProfileCurve arc = makeArcCurve(Point2D(0, 0), 10.0, 0.0, M_PI / 2.0);
+    size_t previous = 0;
+    for (double maxError : {0.01, 0.1, 0.5}) {
+        std::vector<Point2D> polygon;
+        appendCurvePolygon(arc, maxError, polygon);
+        // The end point belongs to the next curve in the loop
+        EXPECT_EQ(polygon.size(), static_cast<size_t>(arcSegmentCount(10.0, M_PI / 2.0, maxError))) << maxError;
+        EXPECT_DOUBLE_EQ(distance(polygon.front(), arc.start), 0.0);
+        polygon.push_back(arc.end);
+        for (size_t i = 0; i + 1 < polygon.size(); ++i) {
+            EXPECT_LE(calculateChordToArcError(polygon[i], polygon[i + 1], arc.center, arc.radius), maxError + 1e-12);
+        }
+        // Looser tolerances give fewer vertices
+        if (previous > 0) {
+            EXPECT_LT(polygon.size(), previous);
+        }
+        previous = polygon.size();
+    }
+}
+
+TEST(ProfileCurveTest, FullCircleEnclosesItsArea) {
+    std::vector<Point2D> polygon =
+        polygonizeProfileLoop({makeArcCurve(Point2D(2, 3), 5.0, 0.0, 2.0 * M_PI)}, 0.001);
+    ASSERT_GE(polygon.size(), 3u);
+    for (const auto& point : polygon) {
+        EXPECT_NEAR(distance(point, Point2D(2, 3)), 5.0, 1e-9);
+    }
+    EXPECT_NEAR(signedArea(polygon), M_PI * 25.0, 0.05);
+
+    // Even a tolerance larger than the radius keeps a polygon
+    EXPECT_EQ(polygonizeProfileLoop({makeArcCurve(Point2D(0, 0), 1.0, 0.0, 2.0 * M_PI)}, 5.0).size(), 3u);
+}
+
+TEST(ProfileCurveTest, LoopFollowsReversedCurves) {
+    // Slot: bottom line, right half circle, top line drawn right to left, left half circle drawn backwards
+    std::vector<ProfileCurve> loop;
+    loop.push_back(makeLineCurve(Point2D(0, 0), Point2D(10, 0)));
+    loop.push_back(makeArcCurve(Point2D(10, 2), 2.0, -M_PI / 2.0, M_PI));
+    loop.push_back(makeLineCurve(Point2D(10, 4), Point2D(0, 4)));
+    loop.push_back(makeArcCurve(Point2D(0, 2), 2.0, -M_PI / 2.0, -M_PI));
+    loop.back().reversed = true;
+
+    std::vector<Point2D> polygon = polygonizeProfileLoop(loop, 0.01);
+    ASSERT_GT(polygon.size(), 8u);
+    EXPECT_DOUBLE_EQ(distance(polygon.front(), Point2D(0, 0)), 0.0);
+    for (size_t i = 0; i < polygon.size(); ++i) {
+        // Consecutive vertices are distinct and no longer apart than the straight sides
+        double step = distance(polygon[i], polygon[(i + 1) % polygon.size()]);
+        EXPECT_GT(step, 1e-9) << i;
+        EXPECT_LE(step, 10.0 + 1e-9) << i;
+    }
+    EXPECT_NEAR(signedArea(polygon), 40.0 + M_PI * 4.0, 0.1);
+}
+
+TEST(ProfileCurveTest, RationalSplineTracesItsCircle) {
+    ProfileCurve spline = quarterCircleSpline();
+    ASSERT_EQ(spline.type, ProfileCurve::Type::SPLINE);
+    EXPECT_NEAR(distance(spline.start, Point2D(1, 0)), 0.0, 1e-12);
+    EXPECT_NEAR(distance(spline.end, Point2D(0, 1)), 0.0, 1e-12);
+    for (double t = 0.0; t <= 1.0; t += 0.125) {
+        EXPECT_NEAR(distance(evaluateSplineCurve(spline, t), Point2D(0, 0)), 1.0, 1e-12) << t;
+    }
+
+    const double maxError = 0.001;
+    std::vector<Point2D> polyline;
+    appendCurvePolygon(spline, maxError, polyline);
+    polyline.push_back(spline.end);
+    EXPECT_LT(polyline.size(), 64u);
+    for (double t = 0.0; t <= 1.0; t += 1.0 / 256.0) {
+        EXPECT_LE(distanceToPolyline(evaluateSplineCurve(spline, t), polyline), maxError * 1.5) << t;
+    }
+}
+
+TEST(ProfileCurveTest, CubicSplineAcrossSeveralSpans) {
+    // Clamped cubic with two interior knots, one of them doubled
+    ProfileCurve spline = makeSplineCurve(
+        3, {Point2D(0, 0), Point2D(1, 3), Point2D(3, -2), Point2D(5, 4), Point2D(7, -1), Point2D(8, 0)}, {},
+        {0, 0, 0, 0, 0.4, 0.4, 1, 1, 1, 1});
+    ASSERT_EQ(spline.type, ProfileCurve::Type::SPLINE);
+    EXPECT_DOUBLE_EQ(distance(spline.start, Point2D(0, 0)), 0.0);
+    EXPECT_DOUBLE_EQ(distance(spline.end, Point2D(8, 0)), 0.0);
+
+    const double maxError = 0.005;
+    std::vector<Point2D> polyline;
+    spline.reversed = true;
+    appendCurvePolygon(spline, maxError, polyline);
+    EXPECT_DOUBLE_EQ(distance(polyline.front(), Point2D(8, 0)), 0.0);
+    polyline.push_back(spline.start);
+    for (double t = 0.0; t <= 1.0; t += 1.0 / 512.0) {
+        EXPECT_LE(distanceToPolyline(evaluateSplineCurve(spline, t), polyline), maxError * 1.5) << t;
+    }
+}
+
+TEST(ProfileCurveTest, MalformedSplineFallsBackToLine) {
+    ProfileCurve curve = makeSplineCurve(3, {Point2D(0, 0), Point2D(1, 1), Point2D(2, 0)}, {}, {0, 0, 1, 1});
+    EXPECT_EQ(curve.type, ProfileCurve::Type::LINE);
+    EXPECT_DOUBLE_EQ(distance(curve.start, Point2D(0, 0)), 0.0);
+    EXPECT_DOUBLE_EQ(distance(curve.end, Point2D(2, 0)), 0.0);
+}
@@ -0,0 +1,93 @@
+/**
+ * test_ProfileTolerance.cpp
+ *
+ * Unit tests for the per-profile automatic tolerance choice
+ */
+
+#include <gtest/gtest.h>
+
+#include <cmath>
+#include <vector>
+
+#include "geometry/ProfileTolerance.h"
+
+using namespace ChipCarving::Geometry;
+
+namespace {
+
+constexpr double PI = 3.14159265358979323846;
+
+std::vector<Point2D> circle(double radius, int segments, double cx = 0.0, double cy = 0.0) {
+    std::vector<Point2D> polygon;
+    for (int i = 0; i < segments; ++i) {
+        double angle = 2.0 * PI * i / segments;
+        polygon.emplace_back(cx + radius * std::cos(angle), cy + radius * std::sin(angle));
+    }
+    return polygon;
+}
+
+std::vector<Point2D> square(double side) {
+    return {Point2D(0, 0), Point2D(side, 0), Point2D(side, side), Point2D(0, side)};
+}
+
+}  // namespace
+
+TEST(ProfileToleranceTest, SmallChipsGetFinerTolerancesThanLargeOutlines) {
+    AutoToleranceOptions options;
+    ProfileTolerance chip = chooseProfileTolerance(circle(1.5, 720), {}, 1.0, options);
+    ProfileTolerance outline = chooseProfileTolerance(circle(150.0, 7200), {}, 1.0, options);
+
+    EXPECT_NEAR(chip.minFeatureRadius, 1.5, 0.01);
+    EXPECT_LT(chip.polygonTolerance, outline.polygonTolerance);
+    EXPECT_LT(chip.samplingDistance, outline.samplingDistance);
+
+    // A large outline is held by the depth error alone: e·cot(θ/2) stays within the target
+    double depthTolerance = options.depthError * std::tan(options.toolAngle * PI / 360.0);
+    EXPECT_NEAR(outline.polygonTolerance, depthTolerance, 1e-12);
+    EXPECT_NEAR(outline.samplingDistance, options.maxSampling, 1e-12);
+}
+
+TEST(ProfileToleranceTest, WiderBitsAllowCoarserOutlines) {
+    AutoToleranceOptions sharp;
+    sharp.toolAngle = 30.0;
+    AutoToleranceOptions wide;
+    wide.toolAngle = 120.0;
+    std::vector<Point2D> outline = circle(150.0, 7200);
+    EXPECT_LT(chooseProfileTolerance(outline, {}, 1.0, sharp).polygonTolerance,
+              chooseProfileTolerance(outline, {}, 1.0, wide).polygonTolerance);
+}
+
+TEST(ProfileToleranceTest, ChoicesStayWithinTheBounds) {
+    AutoToleranceOptions options;
+    options.minTolerance = 0.05;
+    options.maxTolerance = 0.1;
+    options.minSampling = 0.5;
+    options.maxSampling = 1.0;
+    for (double radius : {0.2, 2.0, 20.0, 200.0}) {
+        ProfileTolerance chosen = chooseProfileTolerance(circle(radius, 720), {}, 1.0, options);
+        EXPECT_GE(chosen.polygonTolerance, options.minTolerance);
+        EXPECT_LE(chosen.polygonTolerance, options.maxTolerance);
+        EXPECT_GE(chosen.samplingDistance, options.minSampling);
+        EXPECT_LE(chosen.samplingDistance, options.maxSampling);
+    }
+}
+
+TEST(ProfileToleranceTest, StraightOutlinesAreSizedByTheirHalfWidth) {
+    AutoToleranceOptions options;
+    ProfileTolerance mm = chooseProfileTolerance(square(4.0), {}, 1.0, options);
+    EXPECT_NEAR(mm.minFeatureRadius, 2.0, 1e-12);  // Corners are not curves
+
+    // Fusion's cm give the same choice
+    ProfileTolerance cm = chooseProfileTolerance(square(0.4), {}, 10.0, options);
+    EXPECT_NEAR(cm.polygonTolerance, mm.polygonTolerance, 1e-12);
+    EXPECT_NEAR(cm.samplingDistance, mm.samplingDistance, 1e-12);
+}
+
+TEST(ProfileToleranceTest, TightHolesTightenTheWholeProfile) {
+    AutoToleranceOptions options;
+    std::vector<Point2D> outline = circle(100.0, 7200);
+    ProfileTolerance plain = chooseProfileTolerance(outline, {}, 1.0, options);
+    ProfileTolerance holed = chooseProfileTolerance(outline, {circle(0.5, 360, 20.0, 0.0)}, 1.0, options);
+    EXPECT_NEAR(holed.minFeatureRadius, 0.5, 0.01);
+    EXPECT_LT(holed.polygonTolerance, plain.polygonTolerance);
+}
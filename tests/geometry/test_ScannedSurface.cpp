@@ -0,0 +1,357 @@
+/**
+ * test_ScannedSurface.cpp
+ *
+ * Unit tests for projection surfaces read from scanned blank files
+ */
+
+#include <gtest/gtest.h>
+
+#include <cmath>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <vector>
+
+#include "geometry/ScannedSurface.h"
+
+using namespace ChipCarving::Geometry;
+
+namespace {
+
+std::string tempPath(const std::string& name) {
+    return (std::filesystem::path(::testing::TempDir()) / name).string();
+}
+
+void writeBytes(const std::string& path, const std::string& bytes) {
+    std::ofstream out(path, std::ios::binary | std::ios::trunc);
+    out.write(bytes.data(), static_cast<std::streamsize>(bytes.size()));
+}
+
+void appendBigEndian(std::string& out, uint32_t value) {
+    for (int shift = 24; shift >= 0; shift -= 8) {
+        out.push_back(static_cast<char>((value >> shift) & 0xFF));
+    }
+}
+
+void appendChunk(std::string& png, const char* type, const std::string& body) {
+    appendBigEndian(png, static_cast<uint32_t>(body.size()));
+    png.append(type, 4);
+    png += body;
+    appendBigEndian(png, 0);  // CRCs are not checked by the reader
+}
+
+int paeth(int left, int above, int upperLeft) {
+    int estimate = left + above - upperLeft;
+    int toLeft = std::abs(estimate - left);
+    int toAbove = std::abs(estimate - above);
+    int toUpperLeft = std::abs(estimate - upperLeft);
+    return toLeft <= toAbove && toLeft <= toUpperLeft ? left : toAbove <= toUpperLeft ? above : upperLeft;
+}
+
+/**
+ * Grayscale PNG of rows of samples (top row first), each row with the next of
+ * the five filter types, in stored deflate blocks
+ */
+std::string grayPng(const std::vector<std::vector<uint16_t>>& image, int bitDepth, bool alpha) {
+    uint32_t width = static_cast<uint32_t>(image[0].size() / (alpha ? 2 : 1));
+    size_t bytesPerSample = bitDepth / 8;
+    size_t stride = bytesPerSample * (alpha ? 2 : 1);
+    std::string raw;
+    std::vector<unsigned char> previous(image[0].size() * bytesPerSample, 0);
+    for (size_t y = 0; y < image.size(); ++y) {
+        std::vector<unsigned char> row;
+        for (uint16_t sample : image[y]) {
+            if (bitDepth == 16) {
+                row.push_back(static_cast<unsigned char>(sample >> 8));
+            }
+            row.push_back(static_cast<unsigned char>(sample & 0xFF));
+        }
+        int filter = static_cast<int>(y % 5);
+        raw.push_back(static_cast<char>(filter));
+        for (size_t i = 0; i < row.size(); ++i) {
+            int left = i >= stride ? row[i - stride] : 0;
+            int above = previous[i];
+            int upperLeft = i >= stride ? previous[i - stride] : 0;
+            int predicted = filter == 1 ? left : filter == 2 ? above : filter == 3 ? (left + above) / 2
+                            : filter == 4 ? paeth(left, above, upperLeft) : 0;
+            raw.push_back(static_cast<char>(row[i] - predicted));
+        }
+        previous = row;
+    }
+
+    std::string zlib = {0x78, 0x01};
+    zlib.push_back(0x01);
+    uint16_t length = static_cast<uint16_t>(raw.size());
+    zlib.push_back(static_cast<char>(length & 0xFF));
+    zlib.push_back(static_cast<char>(length >> 8));
+    zlib.push_back(static_cast<char>(~length & 0xFF));
+    zlib.push_back(static_cast<char>((~length >> 8) & 0xFF));
+    zlib += raw;
+    uint32_t a = 1;
+    uint32_t b = 0;
+    for (char byte : raw) {
+        a = (a + static_cast<unsigned char>(byte)) % 65521;
+        b = (b + a) % 65521;
+    }
+    appendBigEndian(zlib, (b << 16) | a);
+
+    std::string header;
+    appendBigEndian(header, width);
+    appendBigEndian(header, static_cast<uint32_t>(image.size()));
+    header += {static_cast<char>(bitDepth), static_cast<char>(alpha ? 4 : 0), 0, 0, 0};
+    std::string png = "\x89PNG\r\n\x1a\n";
+    appendChunk(png, "IHDR", header);
+    appendChunk(png, "IDAT", zlib);
+    appendChunk(png, "IEND", "");
+    return png;
+}
+
+// Square [0, 10]^2 of two triangles at z = 2, as x, y, z triples
+const std::vector<float> SQUARE = {0, 0, 2, 10, 0, 2, 10, 10, 2, 0, 0, 2, 10, 10, 2, 0, 10, 2};
+
+double sampleOne(const ScannedSurface& surface, double x, double y) {
+    return surface.sampleHeights({Point2D(x, y)})[0];
+}
+
+}  // namespace
+
+TEST(ScannedSurfaceTest, HeightGridIsReadInPlaceAcrossTiles) {
+    // A plane interpolates exactly, so any tile seam would show
+    size_t columns = 300;
+    size_t rows = 200;
+    std::vector<float> heights(columns * rows);
+    for (size_t r = 0; r < rows; ++r) {
+        for (size_t c = 0; c < columns; ++c) {
+            heights[r * columns + c] = static_cast<float>(0.25 * c - 0.125 * r);
+        }
+    }
+    std::string path = tempPath("scan_grid.chg");
+    ASSERT_TRUE(writeHeightGrid(path, Point2D(5.0, -3.0), 0.5, columns, rows, heights));
+
+    ScanPlacement placement;
+    placement.originX = 1.0;
+    placement.zOffset = 2.0;
+    std::string error;
+    auto surface = ScannedSurface::load(path, placement, error);
+    ASSERT_TRUE(surface) << error;
+    EXPECT_EQ(surface->format(), ScannedSurface::Format::HEIGHT_GRID);
+    EXPECT_TRUE(surface->isMapped());
+    EXPECT_EQ(surface->columns(), columns);
+
+    for (double x : {6.0, 69.9, 70.0, 70.1, 134.0, 155.5}) {
+        for (double y : {-3.0, 60.9, 61.0, 61.2, 96.5}) {
+            double column = (x - 6.0) / 0.5;
+            double row = (y + 3.0) / 0.5;
+            EXPECT_NEAR(sampleOne(*surface, x, y), 0.25 * column - 0.125 * row + 2.0, 1e-4) << x << ", " << y;
+        }
+    }
+    EXPECT_TRUE(std::isnan(sampleOne(*surface, 5.9, 10.0)));
+    EXPECT_TRUE(std::isnan(sampleOne(*surface, 20.0, 97.0)));
+    EXPECT_GT(surface->cachedTileCount(), 1u);
+    surface.reset();
+    std::filesystem::remove(path);
+}
+
+TEST(ScannedSurfaceTest, TileCacheEvictsAndRebuildsTiles) {
+    size_t side = 9 * ScannedSurface::TILE_CELLS + 1;
+    std::vector<float> heights(side * side);
+    for (size_t i = 0; i < heights.size(); ++i) {
+        heights[i] = static_cast<float>(i % side + 2 * (i / side));
+    }
+    heights[5 * side + 7] = std::nanf("");
+    std::string path = tempPath("scan_tiles.chg");
+    ASSERT_TRUE(writeHeightGrid(path, Point2D(0.0, 0.0), 1.0, side, side, heights));
+    std::string error;
+    auto surface = ScannedSurface::load(path, ScanPlacement(), error);
+    ASSERT_TRUE(surface) << error;
+
+    // Visit all 81 tiles twice; the second pass rebuilds evicted ones
+    std::vector<Point2D> points;
+    for (int pass = 0; pass < 2; ++pass) {
+        for (size_t ty = 0; ty < 9; ++ty) {
+            for (size_t tx = 0; tx < 9; ++tx) {
+                points.emplace_back(tx * 128.0 + 20.5, ty * 128.0 + 30.25);
+            }
+        }
+    }
+    std::vector<double> sampled = surface->sampleHeights(points);
+    for (size_t i = 0; i < points.size(); ++i) {
+        EXPECT_NEAR(sampled[i], points[i].x + 2 * points[i].y, 1e-9) << i;
+    }
+    EXPECT_EQ(surface->cachedTileCount(), ScannedSurface::MAX_CACHED_TILES);
+
+    // Cells touching a missing node have no surface
+    EXPECT_TRUE(std::isnan(sampleOne(*surface, 6.5, 4.5)));
+    EXPECT_FALSE(std::isnan(sampleOne(*surface, 9.5, 4.5)));
+    surface.reset();
+    std::filesystem::remove(path);
+}
+
+TEST(ScannedSurfaceTest, SixteenBitPngMapsPixelsToHeights) {
+    // 6 x 6 pixels, every filter type used; row 0 of the image is the top
+    std::vector<std::vector<uint16_t>> image(6, std::vector<uint16_t>(6));
+    for (size_t y = 0; y < 6; ++y) {
+        for (size_t x = 0; x < 6; ++x) {
+            image[y][x] = static_cast<uint16_t>((x * 7919 + y * 104729) % 65536);
+        }
+    }
+    std::string path = tempPath("scan_heightmap.png");
+    writeBytes(path, grayPng(image, 16, false));
+
+    ScanPlacement placement;
+    placement.originX = 10.0;
+    placement.originY = 20.0;
+    placement.pixelSize = 0.5;
+    placement.heightRange = 6.5535;
+    std::string error;
+    auto surface = ScannedSurface::load(path, placement, error);
+    ASSERT_TRUE(surface) << error;
+    EXPECT_EQ(surface->format(), ScannedSurface::Format::PNG);
+    EXPECT_FALSE(surface->isMapped());
+    for (size_t y = 0; y < 6; ++y) {
+        for (size_t x = 0; x < 6; ++x) {
+            double expected = image[5 - y][x] * 1e-4;
+            EXPECT_NEAR(sampleOne(*surface, 10.0 + 0.5 * x, 20.0 + 0.5 * y), expected, 1e-6) << x << ", " << y;
+        }
+    }
+    std::filesystem::remove(path);
+}
+
+TEST(ScannedSurfaceTest, TransparentPngPixelsHaveNoSurface) {
+    // 8-bit gray with alpha: the top-left pixel is transparent
+    std::vector<std::vector<uint16_t>> image = {{100, 0, 100, 255, 100, 255}, {200, 255, 200, 255, 200, 255}};
+    std::string path = tempPath("scan_alpha.png");
+    writeBytes(path, grayPng(image, 8, true));
+    ScanPlacement placement;
+    placement.pixelSize = 1.0;
+    placement.heightRange = 255.0;
+    std::string error;
+    auto surface = ScannedSurface::load(path, placement, error);
+    ASSERT_TRUE(surface) << error;
+    EXPECT_TRUE(std::isnan(sampleOne(*surface, 0.5, 0.5)));
+    EXPECT_NEAR(sampleOne(*surface, 1.5, 0.5), 150.0, 1e-9);
+    std::filesystem::remove(path);
+}
+
+TEST(ScannedSurfaceTest, ReadsStlAndPlyMeshes) {
+    std::string binaryStl(80, ' ');
+    uint32_t count = 2;
+    binaryStl.append(reinterpret_cast<const char*>(&count), 4);
+    for (int t = 0; t < 2; ++t) {
+        binaryStl.append(12, '\0');
+        binaryStl.append(reinterpret_cast<const char*>(&SQUARE[9 * t]), 36);
+        binaryStl.append(2, '\0');
+    }
+    std::string asciiStl = "solid square\n";
+    for (int t = 0; t < 2; ++t) {
+        asciiStl += "facet normal 0 0 1\nouter loop\n";
+        for (int k = 0; k < 3; ++k) {
+            const float* v = &SQUARE[9 * t + 3 * k];
+            asciiStl += "vertex " + std::to_string(v[0]) + " " + std::to_string(v[1]) + " " +
+                        std::to_string(v[2]) + "\n";
+        }
+        asciiStl += "endloop\nendfacet\n";
+    }
+    asciiStl += "endsolid square\n";
+    std::string asciiPly =
+        "ply\nformat ascii 1.0\ncomment quad\nelement vertex 4\nproperty float x\nproperty float y\n"
+        "property float z\nproperty uchar red\nelement face 1\nproperty list uchar int vertex_indices\nend_header\n"
+        "0 0 2 9\n10 0 2 9\n10 10 2 9\n0 10 2 9\n4 0 1 2 3\n";
+    std::string binaryPly =
+        "ply\nformat binary_little_endian 1.0\nelement vertex 4\nproperty double x\nproperty double y\n"
+        "property double z\nelement face 1\nproperty list uchar uint vertex_indices\nend_header\n";
+    for (double v : {0.0, 0.0, 2.0, 10.0, 0.0, 2.0, 10.0, 10.0, 2.0, 0.0, 10.0, 2.0}) {
+        binaryPly.append(reinterpret_cast<const char*>(&v), sizeof(v));
+    }
+    binaryPly.push_back(4);
+    for (uint32_t index : {0u, 1u, 2u, 3u}) {
+        binaryPly.append(reinterpret_cast<const char*>(&index), sizeof(index));
+    }
+
+    ScanPlacement placement;
+    placement.originX = 100.0;
+    placement.zOffset = -0.5;
+    int file = 0;
+    for (const std::string& contents : {binaryStl, asciiStl, asciiPly, binaryPly}) {
+        std::string path = tempPath("scan_mesh_" + std::to_string(file++));
+        writeBytes(path, contents);
+        std::string error;
+        auto surface = ScannedSurface::load(path, placement, error);
+        ASSERT_TRUE(surface) << "mesh " << file << ": " << error;
+        EXPECT_EQ(surface->format(), ScannedSurface::Format::MESH);
+        EXPECT_NEAR(sampleOne(*surface, 103.0, 7.0), 1.5, 1e-6) << "mesh " << file;
+        EXPECT_TRUE(std::isnan(sampleOne(*surface, 3.0, 7.0))) << "mesh " << file;
+        std::filesystem::remove(path);
+    }
+}
+
+TEST(ScannedSurfaceTest, UnreadableFilesReportWhy) {
+    std::string error;
+    EXPECT_FALSE(ScannedSurface::load(tempPath("scan_missing.png"), ScanPlacement(), error));
+    EXPECT_NE(error.find("cannot open"), std::string::npos);
+
+    std::string path = tempPath("scan_garbage.bin");
+    writeBytes(path, "not a scan at all");
+    error.clear();
+    EXPECT_FALSE(ScannedSurface::load(path, ScanPlacement(), error));
+    EXPECT_FALSE(error.empty());
+
+    std::string rgb = grayPng({{1, 2, 3}, {4, 5, 6}}, 8, false);
+    rgb[8 + 8 + 9] = 2;  // IHDR color type: RGB
+    writeBytes(path, rgb);
+    error.clear();
+    EXPECT_FALSE(ScannedSurface::load(path, ScanPlacement(), error));
+    EXPECT_NE(error.find("grayscale"), std::string::npos);
+    std::filesystem::remove(path);
+}
+
+TEST(ScannedSurfaceTest, HugePngHeaderWithLittleDataFailsCleanly) {
+    // 65536 x 65536 16-bit gray with alpha would need 32 GB, but the data holds two rows
+    std::string png = grayPng({{1, 2, 3, 4}, {5, 6, 7, 8}}, 16, true);
+    for (size_t field : {16, 20}) {
+        png.replace(field, 4, std::string{0, 1, 0, 0});
+    }
+    std::string path = tempPath("scan_huge_header.png");
+    writeBytes(path, png);
+    std::string error;
+    EXPECT_FALSE(ScannedSurface::load(path, ScanPlacement(), error));
+    EXPECT_NE(error.find("corrupt"), std::string::npos) << error;
+    std::filesystem::remove(path);
+}
+
+TEST(ScannedSurfaceTest, CacheReloadsOnlyWhenTheScanChanges) {
+    std::string path = tempPath("scan_cached.chg");
+    std::vector<float> heights(4, 1.0f);
+    ASSERT_TRUE(writeHeightGrid(path, Point2D(0.0, 0.0), 1.0, 2, 2, heights));
+
+    ScannedSurfaceCache cache;
+    std::string error;
+    auto first = cache.get(path, ScanPlacement(), error);
+    ASSERT_TRUE(first) << error;
+    EXPECT_EQ(cache.get(path, ScanPlacement(), error), first);
+
+    ScanPlacement raised;
+    raised.zOffset = 1.0;
+    auto moved = cache.get(path, raised, error);
+    ASSERT_TRUE(moved);
+    EXPECT_NE(moved, first);
+    EXPECT_NEAR(sampleOne(*moved, 0.5, 0.5), 2.0, 1e-9);
+
+    heights.assign(6, 3.0f);
+    ASSERT_TRUE(writeHeightGrid(path, Point2D(0.0, 0.0), 1.0, 3, 2, heights));
+    auto rewritten = cache.get(path, raised, error);
+    ASSERT_TRUE(rewritten);
+    EXPECT_NEAR(sampleOne(*rewritten, 1.5, 0.5), 4.0, 1e-9);
+
+    // A failing scan is reported by the first lookup only
+    std::filesystem::remove(path);
+    error.clear();
+    EXPECT_FALSE(cache.get(path, raised, error));
+    EXPECT_FALSE(error.empty());
+    error.clear();
+    EXPECT_FALSE(cache.get(path, raised, error));
+    EXPECT_TRUE(error.empty());
+}
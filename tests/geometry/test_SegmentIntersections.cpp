@@ -0,0 +1,117 @@
+/**
+ * test_SegmentIntersections.cpp
+ *
+ * Unit tests for the Bentley-Ottmann segment crossing sweep
+ */
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <random>
+#include <set>
+#include <utility>
+
+#include "geometry/SegmentIntersections.h"
+
+using namespace ChipCarving::Geometry;
+
+namespace {
+
+double cross(const Point2D& a, const Point2D& b) {
+    return a.x * b.y - a.y * b.x;
+}
+
+bool onSegment(const Point2D& p, const Point2D& a, const Point2D& b) {
+    return std::min(a.x, b.x) <= p.x && p.x <= std::max(a.x, b.x) && std::min(a.y, b.y) <= p.y &&
+           p.y <= std::max(a.y, b.y);
+}
+
+// Exact for integer coordinates
+bool touches(const SweepSegment& s, const SweepSegment& t) {
+    double d1 = cross(t.b - t.a, s.a - t.a);
+    double d2 = cross(t.b - t.a, s.b - t.a);
+    double d3 = cross(s.b - s.a, t.a - s.a);
+    double d4 = cross(s.b - s.a, t.b - s.a);
+    if (((d1 > 0 && d2 < 0) || (d1 < 0 && d2 > 0)) && ((d3 > 0 && d4 < 0) || (d3 < 0 && d4 > 0))) {
+        return true;
+    }
+    return (d1 == 0 && onSegment(s.a, t.a, t.b)) || (d2 == 0 && onSegment(s.b, t.a, t.b)) ||
+           (d3 == 0 && onSegment(t.a, s.a, s.b)) || (d4 == 0 && onSegment(t.b, s.a, s.b));
+}
+
+std::set<std::pair<size_t, size_t>> pairsOf(const std::vector<SegmentCrossing>& crossings) {
+    std::set<std::pair<size_t, size_t>> pairs;
+    for (const auto& crossing : crossings) {
+        pairs.insert({crossing.first, crossing.second});
+    }
+    return pairs;
+}
+
+}  // namespace
+
+TEST(SegmentIntersectionsTest, FindsACrossingBetweenGroups) {
+    std::vector<SweepSegment> segments = {{Point2D(0, 0), Point2D(4, 4), 0}, {Point2D(0, 4), Point2D(4, 0), 1}};
+    std::vector<SegmentCrossing> crossings;
+    findSegmentCrossings(segments, crossings);
+    ASSERT_EQ(crossings.size(), 1u);
+    EXPECT_EQ(crossings[0].first, 0u);
+    EXPECT_EQ(crossings[0].second, 1u);
+    EXPECT_NEAR(crossings[0].point.x, 2.0, 1e-12);
+    EXPECT_NEAR(crossings[0].point.y, 2.0, 1e-12);
+}
+
+TEST(SegmentIntersectionsTest, IgnoresCrossingsWithinAGroup) {
+    std::vector<SweepSegment> segments = {{Point2D(0, 0), Point2D(4, 4), 0}, {Point2D(0, 4), Point2D(4, 0), 0}};
+    std::vector<SegmentCrossing> crossings;
+    findSegmentCrossings(segments, crossings);
+    EXPECT_TRUE(crossings.empty());
+}
+
+TEST(SegmentIntersectionsTest, ReportsTouchingEndsVerticalsAndOverlapsOnce) {
+    std::vector<SweepSegment> segments = {
+        {Point2D(0, 0), Point2D(2, 0), 0},  // Ends on the vertical below
+        {Point2D(2, -1), Point2D(2, 3), 1},
+        {Point2D(1, 2), Point2D(5, 2), 0},  // Crosses the vertical
+        {Point2D(3, 2), Point2D(7, 2), 1},  // Overlaps the one above
+    };
+    std::vector<SegmentCrossing> crossings;
+    findSegmentCrossings(segments, crossings);
+    std::set<std::pair<size_t, size_t>> expected = {{0, 1}, {1, 2}, {2, 3}};
+    EXPECT_EQ(pairsOf(crossings), expected);
+    EXPECT_EQ(crossings.size(), expected.size());
+
+    for (const auto& crossing : crossings) {
+        if (crossing.first == 1 && crossing.second == 2) {
+            EXPECT_NEAR(crossing.point.x, 2.0, 1e-12);
+            EXPECT_NEAR(crossing.point.y, 2.0, 1e-12);
+        }
+    }
+}
+
+TEST(SegmentIntersectionsTest, MatchesEveryPairTestedDirectly) {
+    // A small integer grid forces shared ends, collinear runs and many segments through one point
+    std::mt19937 random(7);
+    std::uniform_int_distribution<int> coordinate(0, 12);
+    std::vector<SweepSegment> segments;
+    for (int i = 0; i < 300; ++i) {
+        SweepSegment segment{Point2D(coordinate(random), coordinate(random)),
+                             Point2D(coordinate(random), coordinate(random)), i % 2};
+        if (segment.a.x != segment.b.x || segment.a.y != segment.b.y) {
+            segments.push_back(segment);
+        }
+    }
+
+    std::vector<SegmentCrossing> crossings;
+    findSegmentCrossings(segments, crossings);
+
+    std::set<std::pair<size_t, size_t>> expected;
+    for (size_t i = 0; i < segments.size(); ++i) {
+        for (size_t j = i + 1; j < segments.size(); ++j) {
+            if (segments[i].group != segments[j].group && touches(segments[i], segments[j])) {
+                expected.insert({i, j});
+            }
+        }
+    }
+    EXPECT_EQ(crossings.size(), expected.size());
+    EXPECT_EQ(pairsOf(crossings), expected);
+}
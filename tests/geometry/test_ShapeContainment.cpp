@@ -0,0 +1,124 @@
+/**
+ * test_ShapeContainment.cpp
+ *
+ * Unit tests for batch point-in-shape queries, checked point for point
+ * against Shape::contains
+ */
+
+#include <gtest/gtest.h>
+
+#include <random>
+#include <vector>
+
+#include "geometry/ShapeContainment.h"
+#include "geometry/ShapeStore.h"
+
+using namespace ChipCarving::Geometry;
+
+namespace {
+
+TriArc triArc(double x, double y) {
+    return TriArc(Point2D(x, y), Point2D(x + 10.0, y), Point2D(x + 5.0, y + 8.66), {-0.125, -0.125, -0.125});
+}
+
+// Overlapping leaves and tri-arcs over a 100 mm square, in alternating import order
+ShapeStore scatteredShapes(unsigned seed) {
+    std::mt19937 random(seed);
+    std::uniform_real_distribution<double> coordinate(0.0, 90.0);
+    ShapeStore store;
+    for (int i = 0; i < 60; ++i) {
+        double x = coordinate(random);
+        double y = coordinate(random);
+        if (i % 2 == 0) {
+            store.add(Leaf(Point2D(x, y), Point2D(x + 8.0, y + 3.0), 6.0));
+        } else {
+            store.add(triArc(x, y));
+        }
+    }
+    return store;
+}
+
+std::vector<Point2D> randomPoints(size_t count, unsigned seed) {
+    std::mt19937 random(seed);
+    std::uniform_real_distribution<double> coordinate(-10.0, 110.0);
+    std::vector<Point2D> points;
+    for (size_t i = 0; i < count; ++i) {
+        points.emplace_back(coordinate(random), coordinate(random));
+    }
+    return points;
+}
+
+size_t firstContaining(const ShapeStore& store, const Point2D& point) {
+    for (size_t i = 0; i < store.size(); ++i) {
+        if (store.at(i).contains(point)) {
+            return i;
+        }
+    }
+    return ShapeContainmentIndex::NO_SHAPE;
+}
+
+}  // namespace
+
+TEST(ShapeContainmentTest, AgreesWithContainsPointForPoint) {
+    ShapeStore store = scatteredShapes(7);
+    ShapeContainmentIndex index(store);
+    ASSERT_EQ(index.size(), store.size());
+
+    std::vector<Point2D> points = randomPoints(20000, 11);
+    std::vector<size_t> shapes(points.size());
+    std::vector<uint8_t> inside(points.size());
+    index.containingShapes(points.data(), points.size(), shapes.data(), 1);
+    index.containsBatch(points.data(), points.size(), inside.data(), 1);
+
+    size_t insideCount = 0;
+    for (size_t i = 0; i < points.size(); ++i) {
+        size_t expected = firstContaining(store, points[i]);
+        ASSERT_EQ(shapes[i], expected) << i;
+        ASSERT_EQ(inside[i] != 0, expected != ShapeContainmentIndex::NO_SHAPE) << i;
+        insideCount += inside[i];
+    }
+    EXPECT_GT(insideCount, 0u);
+    EXPECT_LT(insideCount, points.size());
+}
+
+TEST(ShapeContainmentTest, WorkersGiveTheSameAnswer) {
+    ShapeStore store = scatteredShapes(3);
+    ShapeContainmentIndex index(store);
+    std::vector<Point2D> points = randomPoints(3 * ShapeContainmentIndex::PARALLEL_MIN_POINTS, 5);
+
+    std::vector<size_t> sequential(points.size());
+    std::vector<size_t> parallel(points.size());
+    index.containingShapes(points.data(), points.size(), sequential.data(), 1);
+    index.containingShapes(points.data(), points.size(), parallel.data(), 4);
+    EXPECT_EQ(parallel, sequential);
+}
+
+TEST(ShapeContainmentTest, BoundaryPointsAndDegenerateShapes) {
+    ShapeStore store;
+    Leaf leaf(Point2D(0.0, 0.0), Point2D(10.0, 0.0), 6.5);
+    store.add(leaf);
+    store.add(Leaf(Point2D(50.0, 0.0), Point2D(80.0, 0.0), 1.0));  // Radius too small for its foci
+    store.add(TriArc(Point2D(20.0, 0.0), Point2D(25.0, 0.0), Point2D(30.0, 0.0), {-0.1, -0.1, -0.1}));
+    ShapeContainmentIndex index(store);
+
+    std::vector<Point2D> points = {leaf.getFocus1(), leaf.getFocus2(), leaf.getCentroid(), Point2D(25.0, 0.0),
+                                   Point2D(65.0, 0.0), Point2D(-1.0, 0.0)};
+    std::vector<size_t> shapes(points.size());
+    index.containingShapes(points.data(), points.size(), shapes.data());
+    for (size_t i = 0; i < points.size(); ++i) {
+        EXPECT_EQ(shapes[i], firstContaining(store, points[i])) << i;
+    }
+    EXPECT_EQ(shapes[0], 0u);
+    EXPECT_EQ(shapes[1], 0u);
+    EXPECT_EQ(shapes[3], ShapeContainmentIndex::NO_SHAPE);
+}
+
+TEST(ShapeContainmentTest, EmptySetContainsNothing) {
+    ShapeStore store;
+    std::vector<Point2D> points = randomPoints(10, 2);
+    std::vector<uint8_t> inside(points.size(), 1);
+    containsBatch(store, points.data(), points.size(), inside.data());
+    for (uint8_t flag : inside) {
+        EXPECT_EQ(flag, 0);
+    }
+}
@@ -0,0 +1,82 @@
+/**
+ * test_ShapeMatchIndex.cpp
+ *
+ * Unit tests for matching profile outlines to imported shapes
+ */
+
+#include <gtest/gtest.h>
+
+#include <vector>
+
+#include "geometry/ShapeMatchIndex.h"
+#include "geometry/ShapePolygonizer.h"
+
+using namespace ChipCarving::Geometry;
+
+namespace {
+
+constexpr double MM_TO_CM = 0.1;
+
+// Outline of shape as Fusion would hand it over: coarsely tessellated, in cm
+std::vector<Point2D> profileOf(const Shape& shape) {
+    std::vector<Point2D> polygon = polygonizeShape(shape, 0.25);
+    for (auto& point : polygon) {
+        point = point * MM_TO_CM;
+    }
+    return polygon;
+}
+
+ShapeStore design() {
+    ShapeStore shapes;
+    for (int i = 0; i < 10; ++i) {
+        shapes.add(Leaf(Point2D(i * 30.0, 0.0), Point2D(i * 30.0 + 20.0, 0.0), 13.0));
+        shapes.add(TriArc(Point2D(i * 30.0, 40.0), Point2D(i * 30.0 + 20.0, 40.0), Point2D(i * 30.0 + 10.0, 57.3),
+                          {-0.125, -0.125, -0.125}));
+    }
+    // A smaller leaf sharing the first leaf's centroid
+    shapes.add(Leaf(Point2D(5.0, 0.0), Point2D(15.0, 0.0), 6.5));
+    return shapes;
+}
+
+}  // namespace
+
+TEST(ShapeMatchIndexTest, EveryShapeFindsItselfFirst) {
+    ShapeStore shapes = design();
+    ShapeMatchIndex index(shapes, MM_TO_CM);
+    ASSERT_EQ(index.size(), shapes.size());
+
+    std::vector<size_t> candidates;
+    for (size_t i = 0; i < shapes.size(); ++i) {
+        ShapeMatchIndex::Key key;
+        ASSERT_TRUE(ShapeMatchIndex::polygonKey(profileOf(shapes.at(i)), key));
+        index.candidates(key, 1e-6, candidates);
+        ASSERT_FALSE(candidates.empty()) << "shape " << i;
+        EXPECT_EQ(candidates.front(), i);
+    }
+}
+
+TEST(ShapeMatchIndexTest, AreaAndBoundsSeparateConcentricShapes) {
+    ShapeStore shapes = design();
+    ShapeMatchIndex index(shapes, MM_TO_CM);
+
+    ShapeMatchIndex::Key key;
+    ASSERT_TRUE(ShapeMatchIndex::polygonKey(profileOf(shapes.at(0)), key));
+    std::vector<size_t> candidates;
+    index.candidates(key, 1e-6, candidates);
+    EXPECT_EQ(candidates, (std::vector<size_t>{0}));
+}
+
+TEST(ShapeMatchIndexTest, UnknownOutlinesMatchNothing) {
+    ShapeStore shapes = design();
+    ShapeMatchIndex index(shapes, MM_TO_CM);
+
+    std::vector<size_t> candidates;
+    ShapeMatchIndex::Key key;
+    Leaf elsewhere(Point2D(500.0, 500.0), Point2D(520.0, 500.0), 13.0);
+    ASSERT_TRUE(ShapeMatchIndex::polygonKey(profileOf(elsewhere), key));
+    index.candidates(key, 1e-6, candidates);
+    EXPECT_TRUE(candidates.empty());
+
+    EXPECT_FALSE(ShapeMatchIndex::polygonKey({Point2D(0.0, 0.0), Point2D(1.0, 0.0)}, key));
+    EXPECT_TRUE(ShapeMatchIndex().empty());
+}
@@ -0,0 +1,90 @@
+/**
+ * Unit tests for batched design outlines: shared vertex merging and edge
+ * buffers of Leaf and TriArc shapes
+ */
+
+#include <gtest/gtest.h>
+
+#include <cmath>
+
+#include "geometry/Leaf.h"
+#include "geometry/ShapeOutlineBatch.h"
+#include "geometry/TriArc.h"
+
+using namespace ChipCarving::Geometry;
+
+namespace {
+
+// A shape without boundary edges, drawn only through drawToSketch
+class PointShape : public Shape {
+   public:
+    std::vector<Point2D> getVertices() const override { return {Point2D(0.0, 0.0)}; }
+    void drawToSketch(ChipCarving::Adapters::ISketch*, ChipCarving::Adapters::ILogger*) const override {}
+    ShapeBounds getBounds() const override { return ShapeBounds(); }
+    bool contains(const Point2D&) const override { return false; }
+    Point2D getCentroid() const override { return Point2D(0.0, 0.0); }
+};
+
+}  // namespace
+
+TEST(ShapeOutlineBatchTest, LeavesSharingAFocusShareItsVertex) {
+    ShapeOutlineBatch batch;
+    EXPECT_TRUE(batch.addShape(Leaf(Point2D(0.0, 0.0), Point2D(10.0, 0.0), 6.5)));
+    EXPECT_TRUE(batch.addShape(Leaf(Point2D(10.0, 0.0), Point2D(20.0, 0.0), 6.5)));
+
+    // Two arcs per leaf on three distinct foci
+    ASSERT_EQ(batch.edges().size(), 4u);
+    EXPECT_EQ(batch.vertices().size(), 3u);
+    EXPECT_EQ(batch.edges()[0].end, batch.edges()[2].start);
+
+    // Each arc bulges to its own side of the focus line
+    for (const auto& edge : batch.edges()) {
+        EXPECT_TRUE(edge.isArc);
+    }
+    EXPECT_LT(batch.edges()[0].mid.y * batch.edges()[1].mid.y, 0.0);
+}
+
+TEST(ShapeOutlineBatchTest, TriArcsSharingAnEdgeShareBothEnds) {
+    ShapeOutlineBatch batch;
+    TriArc first(Point2D(0.0, 0.0), Point2D(10.0, 0.0), Point2D(5.0, 8.0));
+    TriArc second(Point2D(10.0, 0.0), Point2D(15.0, 8.0), Point2D(5.0, 8.0 + 1e-6));
+    ASSERT_TRUE(batch.addShape(first));
+    ASSERT_TRUE(batch.addShape(second));
+
+    EXPECT_EQ(batch.edges().size(), 6u);
+    EXPECT_EQ(batch.vertices().size(), 4u);  // The near-coincident vertex merges
+    EXPECT_EQ(batch.sharedVertexCount(), 12u - 4u);
+}
+
+TEST(ShapeOutlineBatchTest, CurvedTriArcEdgeMidpointLiesOnTheSagitta) {
+    ShapeOutlineBatch batch;
+    TriArc triArc(Point2D(0.0, 0.0), Point2D(10.0, 0.0), Point2D(5.0, 8.0), {-0.2, 0.0, -0.2});
+    ASSERT_TRUE(batch.addShape(triArc));
+    ASSERT_EQ(batch.edges().size(), 3u);
+
+    // Concave: the first edge's midpoint is bulge * chord / 2 inside the triangle
+    const OutlineEdge& edge = batch.edges()[0];
+    ASSERT_TRUE(edge.isArc);
+    EXPECT_NEAR(edge.mid.x, 5.0, 1e-9);
+    EXPECT_NEAR(edge.mid.y, 1.0, 1e-9);
+    EXPECT_FALSE(batch.edges()[1].isArc);
+}
+
+TEST(ShapeOutlineBatchTest, ShapeWithoutBoundaryEdgesIsRejected) {
+    ShapeOutlineBatch batch;
+    EXPECT_FALSE(batch.addShape(PointShape()));
+    EXPECT_TRUE(batch.edges().empty());
+    EXPECT_TRUE(batch.vertices().empty());
+}
+
+TEST(ShapeOutlineBatchTest, EdgesCarryTheirShapesTag) {
+    ShapeOutlineBatch batch;
+    EXPECT_TRUE(batch.addShape(Leaf(Point2D(0.0, 0.0), Point2D(10.0, 0.0), 6.5), "first"));
+    EXPECT_TRUE(batch.addShape(Leaf(Point2D(10.0, 0.0), Point2D(20.0, 0.0), 6.5)));
+    EXPECT_TRUE(batch.addShape(Leaf(Point2D(20.0, 0.0), Point2D(30.0, 0.0), 6.5), "third"));
+
+    ASSERT_EQ(batch.edges().size(), 6u);
+    EXPECT_EQ(batch.tags()[batch.edges()[1].tag], "first");
+    EXPECT_EQ(batch.tags()[batch.edges()[2].tag], "");
+    EXPECT_EQ(batch.tags()[batch.edges()[5].tag], "third");
+}
@@ -0,0 +1,50 @@
+/**
+ * Unit tests for the headless Leaf/TriArc polygonizer
+ */
+
+#include <gtest/gtest.h>
+
+#include <cmath>
+
+#include "geometry/AnalyticMedialAxis.h"
+#include "geometry/Leaf.h"
+#include "geometry/ShapePolygonizer.h"
+#include "geometry/TriArc.h"
+
+using namespace ChipCarving::Geometry;
+
+TEST(ShapePolygonizerTest, SegmentCountMeetsChordError) {
+    double radius = 10.0;
+    double sweep = M_PI / 2.0;
+    for (double maxError : {0.5, 0.1, 0.01}) {
+        int steps = arcSegmentCount(radius, sweep, maxError);
+        double error = radius * (1.0 - std::cos(sweep / steps / 2.0));
+        EXPECT_LE(error, maxError) << maxError;
+        // One segment fewer would exceed the tolerance
+        if (steps > 2) {
+            EXPECT_GT(radius * (1.0 - std::cos(sweep / (steps - 1) / 2.0)), maxError) << maxError;
+        }
+    }
+    EXPECT_EQ(arcSegmentCount(radius, sweep, 0.0), 2);
+    EXPECT_EQ(arcSegmentCount(radius, sweep, 20.0), 2);
+}
+
+TEST(ShapePolygonizerTest, PolygonsTraceTheirShapes) {
+    // The analytic medial axis only accepts polygons whose vertices lie on the
+    // shape boundary, the same check the plugin applies to Fusion profiles
+    Leaf leaf(Point2D(10, 20), Point2D(40, 35));
+    auto leafPolygon = polygonizeShape(leaf, 0.05);
+    EXPECT_GT(leafPolygon.size(), 8u);
+    EXPECT_TRUE(polygonMatchesLeaf(leafPolygon, leaf, 1e-6));
+    EXPECT_DOUBLE_EQ(distance(leafPolygon.front(), leaf.getFocus1()), 0.0);
+
+    TriArc triArc(Point2D(0, 0), Point2D(30, 0), Point2D(15, 25), {-0.125, -0.01, -0.2});
+    auto triArcPolygon = polygonizeShape(triArc, 0.05);
+    EXPECT_TRUE(polygonMatchesTriArc(triArcPolygon, triArc, 1e-6));
+    EXPECT_GT(triArcPolygon.size(), 6u);
+}
+
+TEST(ShapePolygonizerTest, TighterToleranceAddsVertices) {
+    Leaf leaf(Point2D(0, 0), Point2D(30, 0));
+    EXPECT_LT(polygonizeLeaf(leaf, 0.25).size(), polygonizeLeaf(leaf, 0.01).size());
+}
@@ -0,0 +1,78 @@
+/**
+ * test_ShapeStore.cpp
+ *
+ * Unit tests for the per-type storage of imported shapes
+ */
+
+#include <gtest/gtest.h>
+
+#include <array>
+#include <vector>
+
+#include "geometry/ShapeStore.h"
+
+using namespace ChipCarving::Geometry;
+
+namespace {
+
+TriArc triArc(double x) {
+    return TriArc(Point2D(x, 0.0), Point2D(x + 10.0, 0.0), Point2D(x + 5.0, 8.66), {-0.125, -0.125, -0.125});
+}
+
+}  // namespace
+
+TEST(ShapeStoreTest, KeepsImportOrderAcrossTypes) {
+    ShapeStore store;
+    store.add(Leaf(Point2D(0.0, 0.0), Point2D(10.0, 0.0), 6.5));
+    store.add(triArc(20.0));
+    store.add(Leaf(Point2D(40.0, 0.0), Point2D(50.0, 0.0), 6.5));
+
+    ASSERT_EQ(store.size(), 3u);
+    EXPECT_EQ(store.leaves().size(), 2u);
+    EXPECT_EQ(store.triArcs().size(), 1u);
+    EXPECT_EQ(store.handle(1).kind, ShapeKind::TRI_ARC);
+    EXPECT_EQ(store.handle(2).index, 1u);
+
+    EXPECT_NE(dynamic_cast<const Leaf*>(&store.at(0)), nullptr);
+    EXPECT_NE(dynamic_cast<const TriArc*>(&store.at(1)), nullptr);
+    EXPECT_NEAR(store.at(2).getCentroid().x, 45.0, 1e-9);
+}
+
+TEST(ShapeStoreTest, CopiesThroughTheShapeInterface) {
+    ShapeStore store;
+    Leaf leaf(Point2D(0.0, 0.0), Point2D(10.0, 0.0), 6.5);
+    const Shape& shape = leaf;
+    EXPECT_TRUE(store.add(shape));
+    EXPECT_EQ(store.leaves().size(), 1u);
+
+    store.clear();
+    EXPECT_TRUE(store.empty());
+    EXPECT_EQ(store.vertexCount(), 0u);
+}
+
+TEST(ShapeStoreTest, BatchPassesVisitEveryShapeByType) {
+    ShapeStore store;
+    store.add(triArc(20.0));
+    store.add(Leaf(Point2D(0.0, 0.0), Point2D(10.0, 0.0), 6.5));
+    store.add(triArc(40.0));
+
+    std::vector<size_t> order;
+    store.forEachByType([&](const auto&, size_t importIndex) { order.push_back(importIndex); });
+    EXPECT_EQ(order, (std::vector<size_t>{1, 0, 2}));
+
+    size_t vertices = 0;
+    for (size_t i = 0; i < store.size(); ++i) {
+        vertices += store.at(i).getVertices().size();
+    }
+    EXPECT_EQ(store.vertexCount(), vertices);
+
+    ShapeBounds box = store.bounds();
+    for (size_t i = 0; i < store.size(); ++i) {
+        ShapeBounds b = store.at(i).getBounds();
+        EXPECT_LE(box.min.x, b.min.x);
+        EXPECT_LE(box.min.y, b.min.y);
+        EXPECT_GE(box.max.x, b.max.x);
+        EXPECT_GE(box.max.y, b.max.y);
+    }
+    EXPECT_NEAR(box.max.x, store.at(2).getBounds().max.x, 1e-9);
+}
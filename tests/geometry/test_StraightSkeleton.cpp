@@ -0,0 +1,112 @@
+/**
+ * test_StraightSkeleton.cpp
+ *
+ * Unit tests for the straight skeleton of polygonal profiles
+ */
+
+#include <gtest/gtest.h>
+
+#include <cmath>
+#include <vector>
+
+#include "ShapeTessellation.h"
+#include "geometry/Leaf.h"
+#include "geometry/StraightSkeleton.h"
+
+using namespace ChipCarving::Geometry;
+using namespace ChipCarving::Testing;
+
+namespace {
+
+const double PI = 3.14159265358979323846;
+
+std::vector<Point2D> star(int points, double outer, double inner) {
+    std::vector<Point2D> polygon;
+    for (int i = 0; i < 2 * points; ++i) {
+        double angle = PI / 2.0 + PI * i / points;
+        double radius = i % 2 == 0 ? outer : inner;
+        polygon.push_back(Point2D(radius * std::cos(angle), radius * std::sin(angle)));
+    }
+    return polygon;
+}
+
+// Every corner starts a chain at zero clearance, and no clearance exceeds the distance to the outline
+void expectReachesCornersWithinClearance(const std::vector<Point2D>& polygon, const MedialAxisResults& results) {
+    ASSERT_TRUE(results.success) << results.errorMessage;
+    for (const auto& corner : polygon) {
+        bool reached = false;
+        for (const auto& chain : results.chains) {
+            reached = reached || (chain.front().equals(corner, 1e-9) && chain.clearance(0) < 1e-9);
+        }
+        EXPECT_TRUE(reached) << "corner (" << corner.x << ", " << corner.y << ")";
+    }
+    for (const auto& chain : results.chains) {
+        for (size_t j = 0; j < chain.size(); ++j) {
+            EXPECT_LE(chain.clearance(j), distanceToPolygon(chain[j], polygon) + 1e-9);
+        }
+    }
+    EXPECT_EQ(results.graph.edgeCount(), results.chains.size());
+    EXPECT_EQ(results.numChains, static_cast<int>(results.chains.size()));
+}
+
+}  // namespace
+
+TEST(StraightSkeletonTest, RectangleHasASpineBetweenCornerPairs) {
+    std::vector<Point2D> rectangle = {Point2D(0, 0), Point2D(3, 0), Point2D(3, 1), Point2D(0, 1)};
+    MedialAxisResults results;
+    ASSERT_TRUE(computeStraightSkeleton(rectangle, results)) << results.errorMessage;
+    expectReachesCornersWithinClearance(rectangle, results);
+
+    ASSERT_EQ(results.chains.size(), 5u);
+    EXPECT_NEAR(results.maxClearance, 0.5, 1e-9);
+    EXPECT_NEAR(results.totalLength, 2.0 + 4.0 * std::sqrt(0.5), 1e-9);
+    for (const auto& chain : results.chains) {
+        for (size_t j = 0; j < chain.size(); ++j) {
+            EXPECT_NEAR(chain.clearance(j), distanceToPolygon(chain[j], rectangle), 1e-9);
+        }
+    }
+}
+
+TEST(StraightSkeletonTest, StarArcsMeetAtTheCenter) {
+    std::vector<Point2D> polygon = star(5, 10.0, 4.0);
+    MedialAxisResults results;
+    ASSERT_TRUE(computeStraightSkeleton(polygon, results)) << results.errorMessage;
+    expectReachesCornersWithinClearance(polygon, results);
+
+    // Reversed winding gives the same skeleton
+    MedialAxisResults reversed;
+    ASSERT_TRUE(computeStraightSkeleton(std::vector<Point2D>(polygon.rbegin(), polygon.rend()), reversed));
+    EXPECT_EQ(reversed.chains.size(), results.chains.size());
+    EXPECT_NEAR(reversed.maxClearance, results.maxClearance, 1e-9);
+    EXPECT_NEAR(reversed.totalLength, results.totalLength, 1e-9);
+}
+
+TEST(StraightSkeletonTest, ReflexCornerSplitsTheWavefront) {
+    // A notch reaching almost to the bottom edge splits the bar into two halves
+    std::vector<Point2D> notched = {Point2D(0, 0),   Point2D(10, 0), Point2D(10, 2),
+                                    Point2D(5.5, 2), Point2D(5, 0.4), Point2D(4.5, 2), Point2D(0, 2)};
+    MedialAxisResults results;
+    ASSERT_TRUE(computeStraightSkeleton(notched, results)) << results.errorMessage;
+    expectReachesCornersWithinClearance(notched, results);
+    EXPECT_NEAR(results.maxClearance, 1.0, 1e-9);
+
+    std::vector<Point2D> lShape = {Point2D(0, 0), Point2D(4, 0), Point2D(4, 1),
+                                   Point2D(1, 1), Point2D(1, 3), Point2D(0, 3)};
+    ASSERT_TRUE(computeStraightSkeleton(lShape, results)) << results.errorMessage;
+    expectReachesCornersWithinClearance(lShape, results);
+}
+
+TEST(StraightSkeletonTest, OnlyStraightEdgedPolygonsQualify) {
+    EXPECT_TRUE(polygonHasOnlyStraightEdges(star(5, 10.0, 4.0)));
+
+    // Collinear vertices along an edge do not count as curvature
+    std::vector<Point2D> square = {Point2D(0, 0), Point2D(1, 0), Point2D(2, 0), Point2D(2, 2), Point2D(0, 2)};
+    EXPECT_TRUE(polygonHasOnlyStraightEdges(square));
+    MedialAxisResults results;
+    ASSERT_TRUE(computeStraightSkeleton(square, results));
+    EXPECT_EQ(results.chains.size(), 4u);
+
+    EXPECT_FALSE(polygonHasOnlyStraightEdges(tessellateLeaf(Leaf(Point2D(0, 0), Point2D(10, 0)))));
+    EXPECT_FALSE(polygonHasOnlyStraightEdges({Point2D(0, 0), Point2D(1, 0), Point2D(2, 0)}));
+    EXPECT_FALSE(computeStraightSkeleton({Point2D(0, 0), Point2D(1, 0), Point2D(2, 0)}, results));
+}
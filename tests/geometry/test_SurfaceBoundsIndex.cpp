@@ -0,0 +1,106 @@
+/**
+ * test_SurfaceBoundsIndex.cpp
+ *
+ * Unit tests for the XY bounding box grid used by surface ray casting
+ */
+
+#include <gtest/gtest.h>
+
+#include <random>
+#include <vector>
+
+#include "geometry/SurfaceBoundsIndex.h"
+
+using ChipCarving::Geometry::SurfaceBoundsIndex;
+
+namespace {
+
+SurfaceBoundsIndex::Box makeBox(double minX, double minY, double maxX, double maxY, double maxZ) {
+    SurfaceBoundsIndex::Box box;
+    box.minX = minX;
+    box.minY = minY;
+    box.maxX = maxX;
+    box.maxY = maxY;
+    box.maxZ = maxZ;
+    return box;
+}
+
+}  // namespace
+
+TEST(SurfaceBoundsIndexTest, EmptyIndexHasNoCandidates) {
+    SurfaceBoundsIndex index({}, 0.0);
+    std::vector<size_t> candidates{7};
+    index.candidates(0.0, 0.0, candidates);
+    EXPECT_TRUE(candidates.empty());
+}
+
+TEST(SurfaceBoundsIndexTest, ReturnsContainingBoxesTallestFirst) {
+    std::vector<SurfaceBoundsIndex::Box> boxes = {
+        makeBox(0, 0, 10, 10, 1.0),   // Base plate
+        makeBox(2, 2, 4, 4, 5.0),     // Tall boss
+        makeBox(3, 3, 8, 8, 2.0),     // Overlapping block
+        makeBox(20, 20, 30, 30, 9.0)  // Far away
+    };
+    SurfaceBoundsIndex index(boxes, 0.0);
+
+    std::vector<size_t> candidates;
+    index.candidates(3.5, 3.5, candidates);
+    ASSERT_EQ(candidates.size(), 3u);
+    EXPECT_EQ(candidates[0], 1u);
+    EXPECT_EQ(candidates[1], 2u);
+    EXPECT_EQ(candidates[2], 0u);
+    EXPECT_DOUBLE_EQ(index.maxZ(candidates[0]), 5.0);
+
+    index.candidates(25.0, 25.0, candidates);
+    ASSERT_EQ(candidates.size(), 1u);
+    EXPECT_EQ(candidates[0], 3u);
+
+    index.candidates(15.0, 15.0, candidates);
+    EXPECT_TRUE(candidates.empty());
+    index.candidates(-50.0, 3.0, candidates);
+    EXPECT_TRUE(candidates.empty());
+}
+
+TEST(SurfaceBoundsIndexTest, MarginKeepsEdgePointsAndFlatBoxes) {
+    // A flat face (zero height in Y) and a point just off the plate edge
+    std::vector<SurfaceBoundsIndex::Box> boxes = {makeBox(0, 0, 10, 10, 1.0), makeBox(0, 5, 10, 5, 3.0)};
+    SurfaceBoundsIndex index(boxes, 0.01);
+
+    std::vector<size_t> candidates;
+    index.candidates(10.005, 2.0, candidates);
+    ASSERT_EQ(candidates.size(), 1u);
+    EXPECT_EQ(candidates[0], 0u);
+
+    index.candidates(4.0, 5.0, candidates);
+    ASSERT_EQ(candidates.size(), 2u);
+    EXPECT_EQ(candidates[0], 1u);
+}
+
+TEST(SurfaceBoundsIndexTest, MatchesBruteForceOnRandomBoxes) {
+    std::mt19937 rng(7);
+    std::uniform_real_distribution<double> position(0.0, 100.0);
+    std::uniform_real_distribution<double> size(0.5, 15.0);
+    std::vector<SurfaceBoundsIndex::Box> boxes;
+    for (int i = 0; i < 300; ++i) {
+        double x = position(rng);
+        double y = position(rng);
+        boxes.push_back(makeBox(x, y, x + size(rng), y + size(rng), position(rng)));
+    }
+    SurfaceBoundsIndex index(boxes, 0.0);
+
+    std::vector<size_t> candidates;
+    for (int q = 0; q < 500; ++q) {
+        double x = position(rng);
+        double y = position(rng);
+        index.candidates(x, y, candidates);
+
+        size_t expected = 0;
+        for (const auto& box : boxes) {
+            expected += (x >= box.minX && x <= box.maxX && y >= box.minY && y <= box.maxY) ? 1 : 0;
+        }
+        ASSERT_EQ(candidates.size(), expected) << "query " << q;
+        for (size_t i = 1; i < candidates.size(); ++i) {
+            EXPECT_GE(index.maxZ(candidates[i - 1]), index.maxZ(candidates[i]));
+        }
+    }
+}
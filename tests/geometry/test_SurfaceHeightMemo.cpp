@@ -0,0 +1,90 @@
+/**
+ * test_SurfaceHeightMemo.cpp
+ *
+ * Unit tests for the quantized XY surface height memo
+ */
+
+#include <gtest/gtest.h>
+
+#include <cmath>
+#include <limits>
+#include <vector>
+
+#include "geometry/SurfaceHeightMemo.h"
+
+using ChipCarving::Geometry::Point2D;
+using ChipCarving::Geometry::SurfaceHeightMemo;
+
+namespace {
+
+// Surface query stand-in that records every batch it is sent
+struct CountingQuery {
+    std::vector<std::vector<Point2D>> batches;
+
+    std::vector<double> operator()(const std::vector<Point2D>& points) {
+        batches.push_back(points);
+        std::vector<double> heights;
+        for (const auto& point : points) {
+            heights.push_back(point.x < 0.0 ? std::numeric_limits<double>::quiet_NaN() : point.x + point.y);
+        }
+        return heights;
+    }
+};
+
+}  // namespace
+
+TEST(SurfaceHeightMemoTest, StoresByQuantizedLocation) {
+    SurfaceHeightMemo memo;
+    double z = 0.0;
+    EXPECT_FALSE(memo.lookup(Point2D(1.0, 2.0), z));
+
+    memo.store(Point2D(1.0, 2.0), 0.75);
+    // Well inside the same 1 µm cell (cm units)
+    ASSERT_TRUE(memo.lookup(Point2D(1.0 + 2.0e-6, 2.0 - 2.0e-6), z));
+    EXPECT_DOUBLE_EQ(z, 0.75);
+    // Next cell over
+    EXPECT_FALSE(memo.lookup(Point2D(1.0 + 1.0e-4, 2.0), z));
+    EXPECT_EQ(memo.size(), 1u);
+    EXPECT_EQ(memo.hitCount(), 1u);
+}
+
+TEST(SurfaceHeightMemoTest, ResolveQueriesEachLocationOnce) {
+    SurfaceHeightMemo memo;
+    CountingQuery query;
+    auto forward = [&query](const std::vector<Point2D>& points) { return query(points); };
+
+    std::vector<Point2D> first = {Point2D(1.0, 1.0), Point2D(2.0, 1.0), Point2D(1.0, 1.0), Point2D(-1.0, 0.0)};
+    std::vector<double> heights = memo.resolve(first, forward);
+    ASSERT_EQ(query.batches.size(), 1u);
+    EXPECT_EQ(query.batches[0].size(), 3u);
+    ASSERT_EQ(heights.size(), 4u);
+    EXPECT_DOUBLE_EQ(heights[0], 2.0);
+    EXPECT_DOUBLE_EQ(heights[1], 3.0);
+    EXPECT_DOUBLE_EQ(heights[2], 2.0);
+    EXPECT_TRUE(std::isnan(heights[3]));
+
+    // A later pass over overlapping points only sends the new one; misses stay remembered
+    std::vector<Point2D> second = {Point2D(2.0, 1.0), Point2D(-1.0, 0.0), Point2D(3.0, 1.0)};
+    heights = memo.resolve(second, forward);
+    ASSERT_EQ(query.batches.size(), 2u);
+    ASSERT_EQ(query.batches[1].size(), 1u);
+    EXPECT_DOUBLE_EQ(query.batches[1][0].x, 3.0);
+    EXPECT_DOUBLE_EQ(heights[0], 3.0);
+    EXPECT_TRUE(std::isnan(heights[1]));
+    EXPECT_DOUBLE_EQ(heights[2], 4.0);
+
+    // Fully memoized batches never reach the query
+    memo.resolve(second, forward);
+    EXPECT_EQ(query.batches.size(), 2u);
+    EXPECT_EQ(memo.size(), 4u);
+}
+
+TEST(SurfaceHeightMemoTest, ShortQueryResultsCountAsMisses) {
+    SurfaceHeightMemo memo;
+    auto shortQuery = [](const std::vector<Point2D>&) { return std::vector<double>{5.0}; };
+
+    std::vector<double> heights = memo.resolve({Point2D(0.0, 0.0), Point2D(1.0, 0.0)}, shortQuery);
+    ASSERT_EQ(heights.size(), 2u);
+    EXPECT_DOUBLE_EQ(heights[0], 5.0);
+    EXPECT_TRUE(std::isnan(heights[1]));
+}
@@ -0,0 +1,127 @@
+/**
+ * test_SurfaceHeightfield.cpp
+ *
+ * Unit tests for the precomputed surface height grid used by surface projection.
+ * Verifies grid layout, bilinear interpolation, and NaN handling at surface edges.
+ */
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+#include "geometry/SurfaceHeightfield.h"
+
+using namespace ChipCarving::Geometry;
+
+namespace {
+
+// Fill a heightfield from an analytic surface z = f(x, y)
+template <typename Surface>
+void fillHeights(SurfaceHeightfield& grid, Surface surface) {
+    std::vector<double> heights;
+    for (const auto& node : grid.getNodePositions()) {
+        heights.push_back(surface(node.x, node.y));
+    }
+    ASSERT_TRUE(grid.setHeights(heights));
+}
+
+}  // namespace
+
+TEST(SurfaceHeightfieldTest, GridCoversRequestedRegion) {
+    SurfaceHeightfield grid(Point2D(0.0, 0.0), Point2D(1.0, 0.5), 0.25);
+
+    EXPECT_EQ(grid.getColumns(), 5u);
+    EXPECT_EQ(grid.getRows(), 3u);
+
+    auto nodes = grid.getNodePositions();
+    ASSERT_EQ(nodes.size(), 15u);
+    EXPECT_DOUBLE_EQ(nodes.front().x, 0.0);
+    EXPECT_DOUBLE_EQ(nodes.back().x, 1.0);
+    EXPECT_DOUBLE_EQ(nodes.back().y, 0.5);
+    EXPECT_FALSE(grid.isValid());
+}
+
+TEST(SurfaceHeightfieldTest, PlanesAreInterpolatedExactly) {
+    SurfaceHeightfield grid(Point2D(-2.0, -1.0), Point2D(3.0, 4.0), 0.5);
+    fillHeights(grid, [](double x, double y) { return 0.3 * x - 0.2 * y + 1.5; });
+    ASSERT_TRUE(grid.isValid());
+
+    for (double x = -2.0; x <= 3.0; x += 0.37) {
+        for (double y = -1.0; y <= 4.0; y += 0.41) {
+            EXPECT_NEAR(grid.sample(x, y), 0.3 * x - 0.2 * y + 1.5, 1e-12);
+        }
+    }
+}
+
+TEST(SurfaceHeightfieldTest, CurvedSurfaceErrorShrinksWithSpacing) {
+    auto dome = [](double x, double y) { return 5.0 - 0.1 * (x * x + y * y); };
+
+    SurfaceHeightfield coarse(Point2D(-3.0, -3.0), Point2D(3.0, 3.0), 0.5);
+    SurfaceHeightfield fine(Point2D(-3.0, -3.0), Point2D(3.0, 3.0), 0.1);
+    fillHeights(coarse, dome);
+    fillHeights(fine, dome);
+
+    double coarseError = 0.0;
+    double fineError = 0.0;
+    for (double x = -2.9; x < 2.9; x += 0.13) {
+        for (double y = -2.9; y < 2.9; y += 0.17) {
+            coarseError = std::max(coarseError, std::abs(coarse.sample(x, y) - dome(x, y)));
+            fineError = std::max(fineError, std::abs(fine.sample(x, y) - dome(x, y)));
+        }
+    }
+    EXPECT_LT(coarseError, 0.02);
+    EXPECT_LT(fineError, coarseError);
+}
+
+TEST(SurfaceHeightfieldTest, GradientIsTheSlopeOfTheInterpolatedCell) {
+    SurfaceHeightfield grid(Point2D(0.0, 0.0), Point2D(4.0, 4.0), 0.5);
+    fillHeights(grid, [](double x, double y) { return 0.3 * x - 0.2 * y + 1.5; });
+    double dzdx = 0.0;
+    double dzdy = 0.0;
+    EXPECT_NEAR(grid.sample(1.3, 2.7, dzdx, dzdy), 0.3 * 1.3 - 0.2 * 2.7 + 1.5, 1e-12);
+    EXPECT_NEAR(dzdx, 0.3, 1e-12);
+    EXPECT_NEAR(dzdy, -0.2, 1e-12);
+
+    // Saddle z = xy: the bilinear patch has exactly its gradient (y, x)
+    fillHeights(grid, [](double x, double y) { return x * y; });
+    grid.sample(1.2, 3.1, dzdx, dzdy);
+    EXPECT_NEAR(dzdx, 3.1, 1e-12);
+    EXPECT_NEAR(dzdy, 1.2, 1e-12);
+
+    EXPECT_TRUE(std::isnan(grid.sample(5.0, 1.0, dzdx, dzdy)));
+    EXPECT_TRUE(std::isnan(dzdx) && std::isnan(dzdy));
+    EXPECT_NEAR(slopeDepthScale(std::nan(""), 0.0), 1.0, 0.0);
+    EXPECT_NEAR(slopeDepthScale(0.75, 0.0), 1.25, 1e-12);
+    EXPECT_DOUBLE_EQ(slopeDepthScale(10.0, 10.0), MAX_SLOPE_DEPTH_SCALE);
+}
+
+TEST(SurfaceHeightfieldTest, OutsideGridOrMissingSurfaceIsNaN) {
+    SurfaceHeightfield grid(Point2D(0.0, 0.0), Point2D(2.0, 2.0), 1.0);
+    // Surface only exists for x <= 1 (node at x = 2 has no hit)
+    fillHeights(grid, [](double x, double) { return x > 1.5 ? std::nan("") : 1.0; });
+
+    EXPECT_DOUBLE_EQ(grid.sample(0.5, 0.5), 1.0);
+    EXPECT_TRUE(std::isnan(grid.sample(1.5, 0.5)));
+    EXPECT_TRUE(std::isnan(grid.sample(-0.1, 0.5)));
+    EXPECT_TRUE(std::isnan(grid.sample(0.5, 2.1)));
+}
+
+TEST(SurfaceHeightfieldTest, LargeRegionsAreCoarsenedToNodeBudget) {
+    SurfaceHeightfield grid(Point2D(0.0, 0.0), Point2D(1000.0, 1000.0), 0.01);
+
+    EXPECT_LE(grid.getColumns() * grid.getRows(), SurfaceHeightfield::MAX_GRID_NODES);
+    EXPECT_GT(grid.getSpacing(), 0.01);
+    EXPECT_GE((grid.getColumns() - 1) * grid.getSpacing(), 1000.0);
+}
+
+TEST(SurfaceHeightfieldTest, RejectsMismatchedHeights) {
+    SurfaceHeightfield grid(Point2D(0.0, 0.0), Point2D(1.0, 1.0), 0.5);
+    EXPECT_FALSE(grid.setHeights(std::vector<double>(4, 0.0)));
+    EXPECT_TRUE(std::isnan(grid.sample(0.5, 0.5)));
+
+    SurfaceHeightfield empty;
+    EXPECT_FALSE(empty.isValid());
+    EXPECT_TRUE(std::isnan(empty.sample(0.0, 0.0)));
+}
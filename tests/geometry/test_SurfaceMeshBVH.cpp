@@ -0,0 +1,160 @@
+/**
+ * test_SurfaceMeshBVH.cpp
+ *
+ * Unit tests for downward ray queries against a mesh hierarchy
+ */
+
+#include <gtest/gtest.h>
+
+#include <cmath>
+#include <limits>
+#include <random>
+#include <vector>
+
+#include "geometry/SurfaceMeshBVH.h"
+
+using namespace ChipCarving::Geometry;
+
+namespace {
+
+struct Mesh {
+    std::vector<double> coords;
+    std::vector<int> indices;
+};
+
+// Grid of cells x cells squares over [0, size]^2, two triangles each, with z from height(x, y)
+template <typename Height>
+void appendGrid(Mesh& mesh, int cells, double size, Height height) {
+    int first = static_cast<int>(mesh.coords.size() / 3);
+    for (int j = 0; j <= cells; ++j) {
+        for (int i = 0; i <= cells; ++i) {
+            double x = size * i / cells;
+            double y = size * j / cells;
+            mesh.coords.insert(mesh.coords.end(), {x, y, height(x, y)});
+        }
+    }
+    for (int j = 0; j < cells; ++j) {
+        for (int i = 0; i < cells; ++i) {
+            int a = first + j * (cells + 1) + i;
+            int b = a + 1;
+            int c = a + cells + 1;
+            int d = c + 1;
+            mesh.indices.insert(mesh.indices.end(), {a, b, d, a, d, c});
+        }
+    }
+}
+
+// Reference answer: every triangle tested, no hierarchy
+double bruteForceTopZ(const Mesh& mesh, double x, double y) {
+    double best = std::numeric_limits<double>::quiet_NaN();
+    for (size_t t = 0; t + 2 < mesh.indices.size(); t += 3) {
+        const double* a = &mesh.coords[mesh.indices[t] * 3];
+        const double* b = &mesh.coords[mesh.indices[t + 1] * 3];
+        const double* c = &mesh.coords[mesh.indices[t + 2] * 3];
+        double det = (b[1] - c[1]) * (a[0] - c[0]) + (c[0] - b[0]) * (a[1] - c[1]);
+        double wa = ((b[1] - c[1]) * (x - c[0]) + (c[0] - b[0]) * (y - c[1])) / det;
+        double wb = ((c[1] - a[1]) * (x - c[0]) + (a[0] - c[0]) * (y - c[1])) / det;
+        double wc = 1.0 - wa - wb;
+        if (wa < 0 || wb < 0 || wc < 0) {
+            continue;
+        }
+        double z = wa * a[2] + wb * b[2] + wc * c[2];
+        if (std::isnan(best) || z > best) {
+            best = z;
+        }
+    }
+    return best;
+}
+
+}  // namespace
+
+TEST(SurfaceMeshBVHTest, FlatGridReturnsItsHeightAndMissesOutside) {
+    Mesh mesh;
+    appendGrid(mesh, 20, 10.0, [](double, double) { return 1.5; });
+    SurfaceMeshBVH bvh(mesh.coords, mesh.indices);
+    EXPECT_EQ(bvh.triangleCount(), 800u);
+    EXPECT_GT(bvh.nodeCount(), 1u);
+
+    EXPECT_NEAR(bvh.topZ(3.3, 7.1), 1.5, 1e-12);
+    EXPECT_NEAR(bvh.topZ(0.0, 0.0), 1.5, 1e-12);
+    EXPECT_NEAR(bvh.topZ(10.0, 10.0), 1.5, 1e-12);
+    EXPECT_TRUE(std::isnan(bvh.topZ(-0.1, 5.0)));
+    EXPECT_TRUE(std::isnan(bvh.topZ(5.0, 10.5)));
+}
+
+TEST(SurfaceMeshBVHTest, TopmostOfStackedLayersWins) {
+    Mesh mesh;
+    appendGrid(mesh, 8, 10.0, [](double, double) { return -2.0; });
+    appendGrid(mesh, 8, 10.0, [](double, double) { return 3.0; });
+    appendGrid(mesh, 8, 10.0, [](double, double) { return 0.5; });
+    SurfaceMeshBVH bvh(mesh.coords, mesh.indices);
+    EXPECT_NEAR(bvh.topZ(4.2, 6.9), 3.0, 1e-12);
+}
+
+TEST(SurfaceMeshBVHTest, SlopedPlaneInterpolates) {
+    Mesh mesh;
+    appendGrid(mesh, 5, 10.0, [](double x, double y) { return 0.2 * x - 0.1 * y + 1.0; });
+    SurfaceMeshBVH bvh(mesh.coords, mesh.indices);
+    EXPECT_NEAR(bvh.topZ(7.3, 2.9), 0.2 * 7.3 - 0.1 * 2.9 + 1.0, 1e-12);
+}
+
+TEST(SurfaceMeshBVHTest, SharedEdgesAndVerticesHit) {
+    Mesh mesh;
+    appendGrid(mesh, 4, 4.0, [](double, double) { return 2.0; });
+    SurfaceMeshBVH bvh(mesh.coords, mesh.indices);
+    EXPECT_NEAR(bvh.topZ(2.0, 2.0), 2.0, 1e-12);  // Vertex shared by six triangles
+    EXPECT_NEAR(bvh.topZ(1.0, 2.5), 2.0, 1e-12);  // Edge between two cells
+    EXPECT_NEAR(bvh.topZ(0.5, 0.5), 2.0, 1e-12);  // Diagonal inside a cell
+}
+
+TEST(SurfaceMeshBVHTest, BrokenTrianglesAreSkipped) {
+    double nan = std::numeric_limits<double>::quiet_NaN();
+    Mesh mesh;
+    mesh.coords = {0, 0, 1, 1, 0, 1, 0, 1, 1,  // Good triangle at z = 1
+                   0, 0, 5, 1, 0, 5, 1, 0, 9,  // Vertical wall: no XY area
+                   0, 0, nan};
+    mesh.indices = {0, 1, 2, 3, 4, 5, 0, 1, 6, 0, 1, 42, -1, 1, 2};
+    SurfaceMeshBVH bvh(mesh.coords, mesh.indices);
+    EXPECT_EQ(bvh.triangleCount(), 1u);
+    EXPECT_NEAR(bvh.topZ(0.2, 0.2), 1.0, 1e-12);
+
+    SurfaceMeshBVH empty(mesh.coords, {3, 4, 5});
+    EXPECT_TRUE(empty.empty());
+    EXPECT_TRUE(std::isnan(empty.topZ(0.2, 0.0)));
+}
+
+TEST(SurfaceMeshBVHTest, ParallelQueriesMatchBruteForceAndKeepHigherHeights) {
+    Mesh mesh;
+    appendGrid(mesh, 40, 20.0, [](double x, double y) { return std::sin(0.7 * x) * std::cos(0.5 * y); });
+    appendGrid(mesh, 10, 8.0, [](double x, double y) { return 0.3 + 0.05 * x * y; });
+    SurfaceMeshBVH bvh(mesh.coords, mesh.indices);
+
+    std::mt19937 rng(7);
+    std::uniform_real_distribution<double> coordinate(-1.0, 21.0);
+    std::vector<Point2D> points;
+    for (int i = 0; i < 2000; ++i) {
+        points.emplace_back(coordinate(rng), coordinate(rng));
+    }
+
+    std::vector<double> serial;
+    bvh.raiseTopZ(points, serial, 1);
+    std::vector<double> parallel;
+    bvh.raiseTopZ(points, parallel, 4);
+    ASSERT_EQ(serial.size(), points.size());
+    for (size_t i = 0; i < points.size(); ++i) {
+        double expected = bruteForceTopZ(mesh, points[i].x, points[i].y);
+        if (std::isnan(expected)) {
+            EXPECT_TRUE(std::isnan(serial[i])) << i;
+        } else {
+            EXPECT_NEAR(serial[i], expected, 1e-9) << i;
+        }
+        EXPECT_TRUE(std::isnan(serial[i]) ? std::isnan(parallel[i]) : serial[i] == parallel[i]) << i;
+    }
+
+    // A second mesh only raises heights it is above
+    std::vector<double> heights(points.size(), 0.5);
+    bvh.raiseTopZ(points, heights, 2);
+    for (size_t i = 0; i < points.size(); ++i) {
+        EXPECT_EQ(heights[i], std::isnan(serial[i]) ? 0.5 : std::max(0.5, serial[i])) << i;
+    }
+}
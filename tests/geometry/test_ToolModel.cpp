@@ -0,0 +1,112 @@
+/**
+ * test_ToolModel.cpp
+ *
+ * Unit tests for the per-family tool depth kernels
+ */
+
+#include <gtest/gtest.h>
+
+#include <cmath>
+#include <vector>
+
+#include "geometry/ToolModel.h"
+#include "geometry/VCarveCalculator.h"
+
+using namespace ChipCarving::Geometry;
+using ChipCarving::Adapters::MedialAxisParameters;
+using ChipCarving::Adapters::ToolShape;
+
+namespace {
+
+MedialAxisParameters toolParameters(ToolShape shape, double angle, double tipDiameter) {
+    MedialAxisParameters params;
+    params.toolShape = shape;
+    params.toolAngle = angle;
+    params.toolTipDiameter = tipDiameter;
+    params.toolDiameter = 6.0;
+    params.maxVCarveDepth = 25.0;
+    return params;
+}
+
+}  // namespace
+
+TEST(ToolModelTest, VBitMatchesTheConeAndStopsAtTheToolDiameter) {
+    ToolModel tool = ToolModel::fromParameters(toolParameters(ToolShape::V_BIT, 90.0, 0.0));
+    ASSERT_TRUE(tool.valid);
+    EXPECT_NEAR(tool.depth(2.0), VCarveCalculator::calculateVCarveDepth(2.0, 90.0, 25.0), 1e-12);
+    EXPECT_NEAR(tool.depth(5.0), 3.0, 1e-12);  // Clearance beyond the 3 mm tool radius is cut at full width
+    EXPECT_EQ(tool.depth(0.0), 0.0);
+    EXPECT_EQ(tool.depth(-1.0), 0.0);
+
+    MedialAxisParameters shallow = toolParameters(ToolShape::V_BIT, 90.0, 0.0);
+    shallow.maxVCarveDepth = 1.5;
+    EXPECT_NEAR(ToolModel::fromParameters(shallow).depth(2.0), 1.5, 1e-12);
+}
+
+TEST(ToolModelTest, FlatTipSkipsClearancesNarrowerThanItsFlat) {
+    ToolModel tool = ToolModel::fromParameters(toolParameters(ToolShape::FLAT_TIP_V_BIT, 90.0, 1.0));
+    ASSERT_TRUE(tool.valid);
+    EXPECT_EQ(tool.depth(0.4), 0.0);
+    EXPECT_NEAR(tool.depth(2.0), 1.5, 1e-12);
+    EXPECT_NEAR(tool.depth(10.0), 2.5, 1e-12);
+}
+
+TEST(ToolModelTest, TaperedBallRunsFromTheBallOntoTheCone) {
+    double halfAngle = 5.0 * M_PI / 180.0;
+    ToolModel tool = ToolModel::fromParameters(toolParameters(ToolShape::TAPERED_BALL, 10.0, 1.0));
+    ASSERT_TRUE(tool.valid);
+    EXPECT_NEAR(tool.depth(0.3), 0.5 - 0.4, 1e-12);
+    double onCone = 0.5 * (1.0 - std::sin(halfAngle)) + (2.0 - 0.5 * std::cos(halfAngle)) / std::tan(halfAngle);
+    EXPECT_NEAR(tool.depth(2.0), onCone, 1e-9);
+
+    // Continuous and increasing across the tangent point
+    double previous = 0.0;
+    for (double radius = 0.01; radius < 2.0; radius += 0.01) {
+        double depth = tool.depth(radius);
+        EXPECT_GT(depth, previous) << "radius " << radius;
+        EXPECT_LT(depth - previous, 0.01 / std::tan(halfAngle) + 1e-9) << "radius " << radius;
+        previous = depth;
+    }
+}
+
+TEST(ToolModelTest, BatchDispatchMatchesEachKernel) {
+    std::vector<double> radii;
+    for (int i = -5; i < 200; ++i) {
+        radii.push_back(i * 0.037);
+    }
+    for (ToolShape shape : {ToolShape::V_BIT, ToolShape::FLAT_TIP_V_BIT, ToolShape::TAPERED_BALL}) {
+        ToolModel tool = ToolModel::fromParameters(toolParameters(shape, 30.0, 0.8));
+        std::vector<double> depths(radii);
+        calculateToolDepths(tool, depths.data(), depths.size(), depths.data());
+        for (size_t i = 0; i < radii.size(); ++i) {
+            EXPECT_DOUBLE_EQ(depths[i], tool.depth(radii[i]));
+        }
+    }
+}
+
+TEST(ToolModelTest, RadiusAtDepthInvertsEachKernel) {
+    for (ToolShape shape : {ToolShape::V_BIT, ToolShape::FLAT_TIP_V_BIT, ToolShape::TAPERED_BALL}) {
+        ToolModel tool = ToolModel::fromParameters(toolParameters(shape, 30.0, 0.8));
+        // The flat tip cuts its whole flat at any depth, so its inverse starts at the flat's edge
+        double from = shape == ToolShape::FLAT_TIP_V_BIT ? tool.tipRadius + 0.01 : 0.01;
+        for (double radius = from; radius < 2.9; radius += 0.07) {
+            EXPECT_NEAR(tool.radiusAtDepth(tool.depth(radius)), radius, 1e-9) << "radius " << radius;
+        }
+        EXPECT_NEAR(tool.radiusAtDepth(25.0), 3.0, 1e-12);  // Capped at the tool radius
+        EXPECT_EQ(tool.radiusAtDepth(0.0), 0.0);
+    }
+}
+
+TEST(ToolModelTest, TipWiderThanTheToolIsInvalid) {
+    MedialAxisParameters params = toolParameters(ToolShape::FLAT_TIP_V_BIT, 60.0, 6.0);
+    ToolModel tool = ToolModel::fromParameters(params);
+    EXPECT_FALSE(tool.valid);
+    EXPECT_EQ(tool.depth(2.0), 0.0);
+    EXPECT_FALSE(ToolModel::fromParameters(toolParameters(ToolShape::V_BIT, 180.0, 0.0)).valid);
+
+    SampledMedialPath path;
+    path.points.push_back(SampledMedialPoint(Point2D(0, 0), 1.0));
+    path.points.push_back(SampledMedialPoint(Point2D(1, 0), 1.0));
+    VCarveCalculator calculator;
+    EXPECT_FALSE(calculator.generateVCarvePaths({path}, params).success);
+}
@@ -0,0 +1,97 @@
+/**
+ * Unit tests for the SVG review export of profiles, medial axes and toolpaths
+ */
+
+#include <gtest/gtest.h>
+
+#include <cstdio>
+#include <fstream>
+#include <iterator>
+#include <string>
+#include <vector>
+
+#include "geometry/ToolpathSVGExport.h"
+
+using namespace ChipCarving::Geometry;
+
+namespace {
+
+size_t countOccurrences(const std::string& text, const std::string& needle) {
+    size_t count = 0;
+    for (size_t pos = text.find(needle); pos != std::string::npos; pos = text.find(needle, pos + 1)) {
+        ++count;
+    }
+    return count;
+}
+
+std::string readFile(const std::string& path) {
+    std::ifstream file(path);
+    return std::string((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+}
+
+ShapeBounds bounds(double minX, double minY, double maxX, double maxY) {
+    ShapeBounds result;
+    result.min = Point2D(minX, minY);
+    result.max = Point2D(maxX, maxY);
+    return result;
+}
+
+}  // namespace
+
+TEST(ToolpathSVGExportTest, RampRunsFromBlueToRed) {
+    EXPECT_EQ(toolpathRampColor(0.0), "#0000ff");
+    EXPECT_EQ(toolpathRampColor(0.5), "#00ff00");
+    EXPECT_EQ(toolpathRampColor(1.0), "#ff0000");
+    EXPECT_EQ(toolpathRampColor(-1.0), "#0000ff");
+    EXPECT_EQ(toolpathRampColor(2.0), "#ff0000");
+}
+
+TEST(ToolpathSVGExportTest, ColorRunsSplitWhereTheLevelChanges) {
+    ToolpathSVGStyle style;
+    style.maxDepth = 2.0;
+    style.colorLevels = 3;  // 0, 1 and 2 mm
+    ToolpathSVGExporter exporter(bounds(0, 0, 10, 10), style);
+    std::string path = ::testing::TempDir() + "toolpath_runs.svg";
+    ASSERT_TRUE(exporter.open(path));
+
+    // Shallow, shallow, deep: two runs sharing the point where the depth jumps
+    VCarveResults results;
+    VCarvePath carve;
+    carve.points.emplace_back(Point2D(0, 0), 0.0, 0.0);
+    carve.points.emplace_back(Point2D(2, 0), 0.1, 0.1);
+    carve.points.emplace_back(Point2D(4, 0), 0.1, 0.1);
+    carve.points.emplace_back(Point2D(6, 0), 2.0, 2.0);
+    results.paths.push_back(carve);
+    exporter.addToolpaths(results);
+    EXPECT_EQ(exporter.polylineCount(), 2u);
+    ASSERT_TRUE(exporter.finish());
+
+    std::string svg = readFile(path);
+    EXPECT_EQ(countOccurrences(svg, "<polyline"), 2u);
+    EXPECT_EQ(countOccurrences(svg, "stroke=\"#0000ff\""), 1u);
+    EXPECT_EQ(countOccurrences(svg, "stroke=\"#00ff00\""), 1u);
+    std::remove(path.c_str());
+}
+
+TEST(ToolpathSVGExportTest, WritesOutlinesAndScaledMedialAxes) {
+    ToolpathSVGStyle style;
+    style.maxClearance = 5.0;
+    ToolpathSVGExporter exporter(bounds(0, 0, 20, 10), style);
+    std::string path = ::testing::TempDir() + "toolpath_review.svg";
+    ASSERT_TRUE(exporter.open(path));
+
+    // cm input, drawn in mm: a 2 x 1 cm rectangle with a centerline of 0.5 cm clearance
+    exporter.addOutline({Point2D(0, 0), Point2D(2, 0), Point2D(2, 1), Point2D(0, 1)}, 10.0);
+    MedialAxisChains chains;
+    chains.addChain({Point2D(0.5, 0.5), Point2D(1.5, 0.5)}, {0.5, 0.5});
+    exporter.addMedialAxis(chains, 10.0);
+    ASSERT_TRUE(exporter.finish());
+    EXPECT_FALSE(exporter.finish());
+
+    std::string svg = readFile(path);
+    EXPECT_EQ(countOccurrences(svg, "<polygon"), 1u);
+    EXPECT_EQ(countOccurrences(svg, "<polyline"), 1u);
+    EXPECT_EQ(countOccurrences(svg, "stroke=\"#ff0000\""), 1u);  // Full clearance
+    EXPECT_EQ(svg.substr(svg.size() - 7), "</svg>\n");
+    std::remove(path.c_str());
+}
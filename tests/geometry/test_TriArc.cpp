@@ -276,4 +276,21 @@ TEST_F(TriArcTest, DegenerateTriangle) {
     Point2D center = degenerateTri.getCenter();
     EXPECT_NEAR(center.x, 5.0, TOLERANCE);  // Should be at line midpoint
     EXPECT_NEAR(center.y, 0.0, TOLERANCE);
-}
\ No newline at end of file
+}
+
+TEST_F(TriArcTest, BoundsAreTheVertexBox) {
+    // Concave arcs never leave the triangle's box
+    ShapeBounds bounds = triArc->getBounds();
+    EXPECT_DOUBLE_EQ(bounds.min.x, 0.0);
+    EXPECT_DOUBLE_EQ(bounds.min.y, 0.0);
+    EXPECT_DOUBLE_EQ(bounds.max.x, 10.0);
+    EXPECT_DOUBLE_EQ(bounds.max.y, 8.66);
+
+    for (const auto& edge : triArc->getBoundaryEdges()) {
+        EXPECT_TRUE(bounds.contains(edge.mid));
+    }
+
+    // Vertices sit on the box edge and still count as inside
+    EXPECT_TRUE(triArc->contains(v3));
+    EXPECT_FALSE(triArc->contains(Point2D(-0.5, 4.0)));
+}
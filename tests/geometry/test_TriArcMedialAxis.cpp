@@ -0,0 +1,140 @@
+/**
+ * test_TriArcMedialAxis.cpp
+ *
+ * Unit tests for the semi-analytic TriArc medial axis solver.
+ * Verifies clearances against the exact boundary, shape matching, and the
+ * branch layout recorded in tests/medial_axis_truth_data.
+ */
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <string>
+#include <vector>
+
+#include "ShapeTessellation.h"
+#include "geometry/AnalyticMedialAxis.h"
+#include "geometry/MedialAxisTruthData.h"
+#include "geometry/TriArc.h"
+
+using namespace ChipCarving::Geometry;
+using namespace ChipCarving::Testing;
+
+namespace {
+
+double distanceToChains(const Point2D& p, const MedialAxisChains& chains) {
+    double best = std::numeric_limits<double>::max();
+    for (const auto& chain : chains) {
+        for (size_t i = 1; i < chain.size(); ++i) {
+            Point2D a = chain[i - 1];
+            Point2D b = chain[i];
+            double dx = b.x - a.x;
+            double dy = b.y - a.y;
+            double len2 = dx * dx + dy * dy;
+            double t = len2 > 0 ? std::max(0.0, std::min(1.0, ((p.x - a.x) * dx + (p.y - a.y) * dy) / len2)) : 0.0;
+            best = std::min(best, distance(p, Point2D(a.x + t * dx, a.y + t * dy)));
+        }
+    }
+    return best;
+}
+
+const Point2D V1(0.0, 0.0);
+const Point2D V2(10.0, 0.0);
+const Point2D V3(5.0, 8.66);
+
+}  // namespace
+
+TEST(TriArcMedialAxisTest, StraightTriangleJunctionIsIncenter) {
+    TriArc triangle(V1, V2, V3, {0.0, 0.0, 0.0});
+    auto results = computeTriArcMedialAxis(triangle);
+
+    ASSERT_TRUE(results.success) << results.errorMessage;
+    ASSERT_EQ(results.chains.size(), 2u);
+
+    // Incenter and inradius of the (nearly) equilateral triangle
+    double a = distance(V2, V3);
+    double b = distance(V3, V1);
+    double c = distance(V1, V2);
+    double perimeter = a + b + c;
+    Point2D incenter((a * V1.x + b * V2.x + c * V3.x) / perimeter, (a * V1.y + b * V2.y + c * V3.y) / perimeter);
+    double area = std::abs((V2.x - V1.x) * (V3.y - V1.y) - (V3.x - V1.x) * (V2.y - V1.y)) / 2.0;
+
+    EXPECT_NEAR(results.maxClearance, 2.0 * area / perimeter, 1e-6);
+    EXPECT_NEAR(results.chains[1].front().x, incenter.x, 1e-6);
+    EXPECT_NEAR(results.chains[1].front().y, incenter.y, 1e-6);
+}
+
+TEST(TriArcMedialAxisTest, ClearanceMatchesDistanceToBoundary) {
+    TriArc triArc(V1, V2, V3, {-0.2, -0.1, -0.15});
+    auto boundary = tessellateTriArc(triArc, 600);
+    auto results = computeTriArcMedialAxis(triArc);
+    ASSERT_TRUE(results.success) << results.errorMessage;
+
+    for (size_t i = 0; i < results.chains.size(); ++i) {
+        ASSERT_EQ(results.chains[i].size(), results.chains[i].clearances().size());
+        for (size_t j = 0; j < results.chains[i].size(); ++j) {
+            EXPECT_NEAR(results.chains[i].clearance(j), distanceToPolygon(results.chains[i][j], boundary), 1e-3)
+                << "chain " << i << " point " << j;
+        }
+    }
+}
+
+TEST(TriArcMedialAxisTest, BranchesEndAtVertices) {
+    TriArc triArc(V1, V2, V3);
+    auto results = computeTriArcMedialAxis(triArc, 16);
+    ASSERT_TRUE(results.success) << results.errorMessage;
+
+    EXPECT_TRUE(results.chains[0].front().equals(V1));
+    EXPECT_TRUE(results.chains[0].back().equals(V2));
+    EXPECT_TRUE(results.chains[1].back().equals(V3));
+    EXPECT_EQ(results.chains[0].size(), 33u);
+    EXPECT_EQ(results.chains[1].size(), 17u);
+    EXPECT_EQ(results.totalPoints, 50);
+    EXPECT_DOUBLE_EQ(results.chains[0].clearance(0), 0.0);
+    EXPECT_DOUBLE_EQ(results.chains[1].clearances().back(), 0.0);
+}
+
+TEST(TriArcMedialAxisTest, MatchesTruthDataLayout) {
+    MedialAxisChains truth;
+    ASSERT_TRUE(loadTruthFile(std::string(MEDIAL_AXIS_TRUTH_DIR) + "/triangle_curved.truth", truth));
+    ASSERT_EQ(truth.size(), 2u);
+
+    TriArc triArc(V1, V2, V3);
+    auto results = computeTriArcMedialAxis(triArc);
+    ASSERT_TRUE(results.success) << results.errorMessage;
+    ASSERT_EQ(results.chains.size(), truth.size());
+
+    // Truth clearances are linear placeholders, so only the geometry is compared
+    for (size_t i = 0; i < truth.size(); ++i) {
+        EXPECT_TRUE(results.chains[i].front().equals(truth[i].front(), 0.01)) << "path " << i;
+        EXPECT_TRUE(results.chains[i].back().equals(truth[i].back(), 0.01)) << "path " << i;
+        for (const auto& point : truth[i]) {
+            EXPECT_LT(distanceToChains(point, results.chains), 0.01) << "path " << i;
+        }
+    }
+}
+
+TEST(TriArcMedialAxisTest, TessellatedTriArcMatches) {
+    TriArc triArc(V1, V2, V3, {-0.2, -0.1, -0.15});
+    auto polygon = tessellateTriArc(triArc);
+    EXPECT_TRUE(polygonMatchesTriArc(polygon, triArc, 1e-6));
+
+    polygon[30].x += 0.3;  // User dragged part of an edge
+    EXPECT_FALSE(polygonMatchesTriArc(polygon, triArc, 1e-3));
+
+    TriArc other(V1, V2, V3, {-0.05, -0.1, -0.15});
+    EXPECT_FALSE(polygonMatchesTriArc(tessellateTriArc(other), triArc, 1e-3));
+}
+
+TEST(TriArcMedialAxisTest, AnalyticDispatchScalesUnits) {
+    TriArc triArcMm(Point2D(100, 100), Point2D(200, 100), Point2D(150, 186.6));
+    TriArc triArcCm(Point2D(10, 10), Point2D(20, 10), Point2D(15, 18.66));
+
+    MedialAxisResults results;
+    ASSERT_TRUE(computeAnalyticMedialAxis(triArcMm, 0.1, tessellateTriArc(triArcCm), 1e-6, results));
+    EXPECT_EQ(results.numChains, 2);
+    EXPECT_TRUE(results.chains[0].front().equals(triArcCm.getVertex(0), 1e-9));
+    EXPECT_NEAR(results.maxClearance, computeTriArcMedialAxis(triArcCm).maxClearance, 1e-9);
+}
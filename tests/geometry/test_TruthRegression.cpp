@@ -0,0 +1,106 @@
+/**
+ * Unit tests for the parallel truth regression runner
+ */
+
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <cstdio>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "../tools/TruthRegression.h"
+
+using namespace ChipCarving::Geometry;
+using namespace ChipCarving::Testing;
+
+namespace {
+
+TruthFixture squareFixture(double clearance) {
+    TruthFixture fixture;
+    fixture.engineVersion = "recorded";
+    fixture.polygon = {Point2D(0.0, 0.0), Point2D(2.0, 0.0), Point2D(2.0, 2.0), Point2D(0.0, 2.0)};
+    fixture.chains.addChain({Point2D(0.0, 0.0), Point2D(1.0, 1.0)}, {0.0, clearance});
+    return fixture;
+}
+
+// Stands in for OpenVoronoi: the square's diagonal to its centre
+bool diagonalCompute(const TruthFixture&, MedialAxisChains& chains) {
+    chains.clear();
+    chains.addChain({Point2D(0.0, 0.0), Point2D(1.0, 1.0)}, {0.0, 1.0});
+    return true;
+}
+
+std::string storeFixture(const std::string& name, const TruthFixture& fixture) {
+    std::string path = ::testing::TempDir() + name;
+    EXPECT_TRUE(storeBinaryTruthFixture(path, fixture));
+    return path;
+}
+
+}  // namespace
+
+TEST(TruthRegressionTest, ReportsPassesAndMismatchesInInputOrder) {
+    std::vector<std::string> paths = {storeFixture("regression_pass.truthb", squareFixture(1.0)),
+                                      storeFixture("regression_fail.truthb", squareFixture(0.5)),
+                                      ::testing::TempDir() + "regression_missing.truthb"};
+    TruthRegressionOptions options;
+    options.workers = 3;
+    TruthRegressionReport report = runTruthRegression(paths, options, "recorded", diagonalCompute);
+
+    ASSERT_EQ(report.fixtures.size(), 3u);
+    EXPECT_TRUE(report.fixtures[0].passed);
+    EXPECT_TRUE(report.fixtures[0].recomputed);
+    EXPECT_FALSE(report.fixtures[0].engineChanged);
+    EXPECT_FALSE(report.fixtures[1].passed);
+    EXPECT_EQ(report.fixtures[1].error, "clearance differs at chain 0, point 1");
+    EXPECT_FALSE(report.fixtures[2].passed);
+    EXPECT_EQ(report.failedCount(), 2u);
+    EXPECT_FALSE(report.ok());
+    EXPECT_NE(report.summary().find("FAIL " + paths[1]), std::string::npos);
+    for (size_t i = 0; i < 2; ++i) {
+        std::remove(paths[i].c_str());
+    }
+}
+
+TEST(TruthRegressionTest, NamesTheEngineWhenARecordingGoesStale) {
+    std::string path = storeFixture("regression_stale.truthb", squareFixture(0.5));
+    TruthRegressionReport report = runTruthRegression({path}, TruthRegressionOptions(), "newer", diagonalCompute);
+
+    ASSERT_EQ(report.fixtures.size(), 1u);
+    EXPECT_TRUE(report.fixtures[0].engineChanged);
+    EXPECT_NE(report.fixtures[0].error.find("recorded with OpenVoronoi recorded, running newer"), std::string::npos);
+    std::remove(path.c_str());
+}
+
+TEST(TruthRegressionTest, FlagsFixturesOverTheirBudget) {
+    std::string path = storeFixture("regression_slow.truthb", squareFixture(1.0));
+    auto slowCompute = [](const TruthFixture& fixture, MedialAxisChains& chains) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(20));
+        return diagonalCompute(fixture, chains);
+    };
+    TruthRegressionOptions options;
+    options.budgetMs = 5.0;
+    TruthRegressionReport report = runTruthRegression({path}, options, "recorded", slowCompute);
+
+    ASSERT_EQ(report.fixtures.size(), 1u);
+    const TruthFixtureResult& result = report.fixtures[0];
+    EXPECT_TRUE(result.passed);
+    EXPECT_TRUE(result.overBudget);
+    EXPECT_GE(result.computeMs, 20.0);
+    EXPECT_GE(result.totalMs, result.loadMs + result.computeMs + result.compareMs);
+    EXPECT_EQ(report.overBudgetCount(), 1u);
+    EXPECT_FALSE(report.ok());
+    std::remove(path.c_str());
+}
+
+TEST(TruthRegressionTest, ValidatesTheCheckedInFixtures) {
+    std::vector<std::string> paths = findTruthFixtures(MEDIAL_AXIS_TRUTH_DIR);
+    ASSERT_EQ(paths.size(), 3u);
+    TruthRegressionReport report = runTruthRegression(paths, TruthRegressionOptions(), "any");
+
+    EXPECT_TRUE(report.ok()) << report.summary();
+    for (const auto& result : report.fixtures) {
+        EXPECT_FALSE(result.recomputed) << result.path;  // Chains only, no input polygon
+    }
+}
@@ -5,12 +5,15 @@
 
 #include <gtest/gtest.h>
 #include <cmath>
+#include <vector>
+#include "geometry/SurfaceHeightfield.h"
 #include "geometry/VCarveCalculator.h"
 #include "geometry/MedialAxisProcessor.h"
 #include "geometry/MedialAxisUtilities.h"
 
 using namespace ChipCarving::Geometry;
 using namespace ChipCarving::Adapters;
+using ChipCarving::Utils::Millimeters;
 
 class VCarveCalculatorTest : public ::testing::Test {
 protected:
@@ -101,6 +104,27 @@ TEST_F(VCarveCalculatorTest, CalculateVCarveDepthInvalidInputs) {
     EXPECT_EQ(calculator->calculateVCarveDepth(2.0, 200.0, 10.0), 0.0);    // > 180-degree angle
 }
 
+TEST_F(VCarveCalculatorTest, CalculateVCarveDepthsMatchesScalar) {
+    // Zero and negative radii, ordinary radii and radii past the depth clamp
+    std::vector<double> radii = {0.0, -1.0, 0.5, 1.0, 2.5, 4.0, 7.5, 100.0, 1e-9};
+    for (double toolAngle : {30.0, 60.0, 90.0, 120.0}) {
+        std::vector<double> depths(radii.size(), -1.0);
+        VCarveCalculator::calculateVCarveDepths(radii.data(), radii.size(), toolAngle, 5.0, depths.data());
+        for (size_t i = 0; i < radii.size(); ++i) {
+            EXPECT_DOUBLE_EQ(depths[i], VCarveCalculator::calculateVCarveDepth(radii[i], toolAngle, 5.0))
+                << "angle " << toolAngle << " radius " << radii[i];
+            EXPECT_LE(depths[i], 5.0);
+        }
+    }
+
+    // Invalid angles zero the whole batch; in-place use is allowed
+    std::vector<double> inPlace = radii;
+    VCarveCalculator::calculateVCarveDepths(inPlace.data(), inPlace.size(), 180.0, 5.0, inPlace.data());
+    for (double depth : inPlace) {
+        EXPECT_EQ(depth, 0.0);
+    }
+}
+
 // Parameter Validation Tests (via public interface)
 TEST_F(VCarveCalculatorTest, GenerateVCarvePathsValidatesParameters) {
     // Test parameter validation through the public interface
@@ -112,8 +136,7 @@ TEST_F(VCarveCalculatorTest, GenerateVCarvePathsValidatesParameters) {
     std::vector<double> clearances;
     chain.emplace_back(Point2D(0, 0));
     clearances.push_back(2.0);
-    medialResults.chains.push_back(chain);
-    medialResults.clearanceRadii.push_back(clearances);
+    medialResults.chains.addChain(chain, clearances);
     
     // Test with invalid tool angle
     MedialAxisParameters invalidParams = params;
@@ -155,8 +178,7 @@ TEST_F(VCarveCalculatorTest, GenerateVCarvePathsFromMedialResults) {
     clearances.push_back(2.0);
     clearances.push_back(1.5);
     clearances.push_back(1.0);
-    medialResults.chains.push_back(chain);
-    medialResults.clearanceRadii.push_back(clearances);
+    medialResults.chains.addChain(chain, clearances);
     
     VCarveResults results = calculator->generateVCarvePaths(medialResults, params);
     
@@ -210,8 +232,7 @@ TEST_F(VCarveCalculatorTest, RealWorldTriangularShape) {
     clearances.push_back(0.25);             // Center (2.5mm = 0.25cm)
     clearances.push_back(0.1);              // Partway (1.0mm = 0.1cm)
     clearances.push_back(0.01);             // Corner (0.1mm = 0.01cm)
-    medialResults.chains.push_back(chain);
-    medialResults.clearanceRadii.push_back(clearances);
+    medialResults.chains.addChain(chain, clearances);
     
     VCarveResults results = calculator->generateVCarvePaths(medialResults, params);
     
@@ -248,8 +269,7 @@ TEST_F(VCarveCalculatorTest, UsesRawMedialAxisData) {
     chain.emplace_back(Point2D(5.0, 0.0));   clearances.push_back(0.10);  // Point 6
     chain.emplace_back(Point2D(6.0, 0.0));   clearances.push_back(0.05);  // Point 7
     
-    medialResults.chains.push_back(chain);
-    medialResults.clearanceRadii.push_back(clearances);
+    medialResults.chains.addChain(chain, clearances);
     
     // Configure parameters for direct processing (no additional sampling)
     MedialAxisParameters params;
@@ -292,4 +312,386 @@ TEST_F(VCarveCalculatorTest, UsesRawMedialAxisData) {
     // Verify no sampling interpolation artifacts (depths in mm)
     EXPECT_NEAR(results.minDepth, 0.5, 0.1) << "Minimum depth should match smallest clearance (in mm)";
     EXPECT_NEAR(results.maxDepth, 3.0, 0.1) << "Maximum depth should match largest clearance (in mm)";
-}
\ No newline at end of file
+}
+// Path merging tests
+namespace {
+
+SampledMedialPath makeSegment(double x0, double x1) {
+    SampledMedialPath path;
+    path.points.emplace_back(Point2D(x0, 0.0), 1.0);
+    path.points.emplace_back(Point2D(x1, 0.0), 1.0);
+    path.totalLength = std::abs(x1 - x0);
+    return path;
+}
+
+}  // namespace
+
+TEST_F(VCarveCalculatorTest, MergesScatteredSegmentsIntoOnePath) {
+    // 200 unit segments along the X axis, in interleaved order and alternating direction
+    std::vector<SampledMedialPath> sampledPaths;
+    for (int k = 0; k < 200; ++k) {
+        int i = (k * 37) % 200;
+        sampledPaths.push_back(k % 2 ? makeSegment(i + 1.0, i) : makeSegment(i, i + 1.0));
+    }
+
+    VCarveResults results = calculator->generateVCarvePaths(sampledPaths, params);
+
+    ASSERT_TRUE(results.success);
+    ASSERT_EQ(results.paths.size(), 1u);
+    EXPECT_EQ(results.paths[0].points.size(), 400u);
+    EXPECT_NEAR(results.paths[0].totalLength, 200.0, 1e-9);
+    EXPECT_NEAR(results.paths[0].totalLength, results.paths[0].calculateLength(), 1e-9);
+}
+
+TEST_F(VCarveCalculatorTest, MergeToleranceComesFromParameters) {
+    // Two segments separated by a 0.5 mm gap
+    std::vector<SampledMedialPath> sampledPaths = {makeSegment(0.0, 10.0), makeSegment(10.5, 20.0)};
+
+    VCarveResults results = calculator->generateVCarvePaths(sampledPaths, params);
+    ASSERT_TRUE(results.success);
+    EXPECT_EQ(results.paths.size(), 2u);
+
+    params.pathMergeTolerance = 1.0;
+    results = calculator->generateVCarvePaths(sampledPaths, params);
+    ASSERT_TRUE(results.success);
+    ASSERT_EQ(results.paths.size(), 1u);
+    EXPECT_NEAR(results.paths[0].totalLength, 20.0, 1e-9);
+}
+
+// Path ordering tests
+TEST_F(VCarveCalculatorTest, OrderingReducesRapidTravel) {
+    // Short cuts scattered along two rows, listed in an order that zig-zags across the workpiece
+    std::vector<SampledMedialPath> sampledPaths;
+    for (int k = 0; k < 40; ++k) {
+        double x = ((k * 13) % 40) * 5.0;
+        double y = (k % 2) * 50.0;
+        SampledMedialPath path;
+        path.points.emplace_back(Point2D(x, y), 1.0);
+        path.points.emplace_back(Point2D(x + 1.0, y + 1.0), 1.0);
+        sampledPaths.push_back(path);
+    }
+
+    params.orderToolpaths = false;
+    VCarveResults unordered = calculator->generateVCarvePaths(sampledPaths, params);
+    params.orderToolpaths = true;
+    VCarveResults ordered = calculator->generateVCarvePaths(sampledPaths, params);
+
+    ASSERT_TRUE(unordered.success);
+    ASSERT_TRUE(ordered.success);
+    EXPECT_FALSE(unordered.pathsOrdered);
+    EXPECT_TRUE(ordered.pathsOrdered);
+    EXPECT_EQ(ordered.totalPaths, unordered.totalPaths);
+    EXPECT_EQ(ordered.totalPoints, unordered.totalPoints);
+    EXPECT_NEAR(ordered.totalLength, unordered.totalLength, 1e-9);
+
+    EXPECT_NEAR(ordered.unorderedRapidDistance, unordered.rapidDistance, 1e-9);
+    EXPECT_NEAR(ordered.rapidDistance, calculateRapidDistance(ordered.paths), 1e-9);
+    EXPECT_LT(ordered.rapidDistance, 0.5 * unordered.rapidDistance);
+    EXPECT_NE(ordered.getSummary().find("rapids"), std::string::npos);
+}
+
+TEST_F(VCarveCalculatorTest, OrderingCanReversePaths) {
+    // Second cut ends near where the first one finishes; reversing it removes the long rapid
+    std::vector<SampledMedialPath> sampledPaths = {makeSegment(0.0, 10.0), makeSegment(30.0, 12.0)};
+
+    params.allowPathReversal = false;
+    VCarveResults forwardOnly = calculator->generateVCarvePaths(sampledPaths, params);
+    params.allowPathReversal = true;
+    VCarveResults reversible = calculator->generateVCarvePaths(sampledPaths, params);
+
+    ASSERT_TRUE(forwardOnly.success);
+    ASSERT_TRUE(reversible.success);
+    EXPECT_NEAR(reversible.rapidDistance, 2.0, 1e-9);
+    EXPECT_GT(forwardOnly.rapidDistance, reversible.rapidDistance);
+}
+
+TEST_F(VCarveCalculatorTest, SurfaceProjectionMarksPointsOverTheSurface) {
+    // Surface covers x < 20 mm only, 5 mm above the sketch plane
+    std::vector<SampledMedialPath> sampledPaths(1);
+    sampledPaths[0].points.emplace_back(Point2D(5.0, 0.0), 1.0);
+    sampledPaths[0].points.emplace_back(Point2D(15.0, 0.0), 1.0);
+    sampledPaths[0].points.emplace_back(Point2D(25.0, 0.0), 1.0);
+    auto surface = [](Millimeters x, Millimeters) { return Millimeters(x.value() < 20.0 ? 5.0 : std::nan("")); };
+
+    params.projectToSurface = true;
+    params.pathMergeTolerance = 0.0;
+    VCarveResults results = calculator->generateVCarvePathsWithSurface(sampledPaths, params, 0.0, surface);
+
+    ASSERT_TRUE(results.success);
+    ASSERT_EQ(results.paths.size(), 1u);
+    const auto& points = results.paths[0].points;
+    ASSERT_EQ(points.size(), 3u);
+    double depth = VCarveCalculator::calculateVCarveDepth(1.0, params.toolAngle, params.maxVCarveDepth);
+    for (const auto& point : points) {
+        bool overSurface = point.position.x < 20.0;
+        EXPECT_EQ(point.surfaceProjected, overSurface);
+        EXPECT_DOUBLE_EQ(point.clearanceRadius, 1.0);
+        EXPECT_NEAR(point.sketchRelativeZ(2.0), overSurface ? 5.0 - 2.0 - depth : -depth, 1e-9);
+    }
+}
+
+TEST_F(VCarveCalculatorTest, SlopeCompensationDeepensCutsOnTiltedSurfaces) {
+    // Path along x over the plane z = x (45°) and z = 2x (63°, capped at 60°)
+    const double NaN = std::nan("");
+    VCarvePath path;
+    for (int i = 0; i < 5; ++i) {
+        path.points.emplace_back(Point2D(i, 0.0), 1.0, 1.0);
+        path.points.back().projectToSurface(static_cast<double>(i));
+    }
+    path.points.emplace_back(Point2D(5.0, 0.0), 1.0, 1.0);  // Off the surface
+    std::vector<Point2D> gradients = {Point2D(1.0, 0.0), Point2D(0.0, 2.0), Point2D(NaN, NaN),
+                                      Point2D(NaN, NaN), Point2D(NaN, NaN), Point2D(NaN, NaN)};
+    gradients[4] = Point2D(0.0, 0.0);
+
+    VCarveCalculator::compensateSurfaceSlope(path, gradients.data(), 25.0);
+    EXPECT_NEAR(path.points[0].depth, std::sqrt(2.0), 1e-12);
+    EXPECT_NEAR(path.points[1].depth, MAX_SLOPE_DEPTH_SCALE, 1e-12);
+    // No grid gradient: the slope along the path between neighbours
+    EXPECT_NEAR(path.points[2].depth, std::sqrt(2.0), 1e-12);
+    EXPECT_NEAR(path.points[3].depth, std::sqrt(2.0), 1e-12);
+    EXPECT_DOUBLE_EQ(path.points[4].depth, 1.0);
+    EXPECT_DOUBLE_EQ(path.points[5].depth, 1.0);
+
+    // Deepened cuts stop at the depth limit
+    VCarvePath limited;
+    limited.points.emplace_back(Point2D(0.0, 0.0), 1.0, 1.0);
+    limited.points.back().projectToSurface(0.0);
+    VCarveCalculator::compensateSurfaceSlope(limited, gradients.data(), 1.2);
+    EXPECT_DOUBLE_EQ(limited.points[0].depth, 1.2);
+}
+
+// H-shaped medial axis: two junctions joined by a flat-bottomed bar, two arms at each end
+static std::vector<SampledMedialPath> sampleHShape(MedialAxisGraph& graph) {
+    MedialAxisChains chains;
+    chains.addChain({Point2D(0, 0), Point2D(-1, 1)}, {1.0, 0.0});
+    chains.addChain({Point2D(0, 0), Point2D(-1, -1)}, {1.0, 0.0});
+    chains.addChain({Point2D(1, 0), Point2D(2, 1)}, {1.0, 0.0});
+    chains.addChain({Point2D(2, -1), Point2D(1, 0)}, {0.0, 1.0});
+    chains.addChain({Point2D(0, 0), Point2D(1, 0)}, {1.0, 1.0});
+    graph = MedialAxisGraph::fromChains(chains);
+    std::vector<SampledMedialPath> sampledPaths;
+    sampleMedialAxisChains(chains, 1.0, 0.25, sampledPaths);
+    return sampledPaths;
+}
+
+TEST_F(VCarveCalculatorTest, ContinuousTraversalRecutsFlatChainsInsteadOfLifting) {
+    MedialAxisGraph graph;
+    std::vector<SampledMedialPath> sampledPaths = sampleHShape(graph);
+    params.maxVCarveDepth = 0.5;  // The bar's clearance is past the depth limit, so it cuts flat
+    params.orderToolpaths = false;
+
+    VCarveResults merged = calculator->generateVCarvePaths(sampledPaths, params, &graph);
+    ASSERT_TRUE(merged.success);
+    EXPECT_EQ(merged.totalPaths, 3);
+
+    params.minimizeRetracts = true;
+    VCarveResults planned = calculator->generateVCarvePaths(sampledPaths, params, &graph);
+    ASSERT_TRUE(planned.success);
+    ASSERT_EQ(planned.totalPaths, 2);
+
+    // Every chain is cut once and the bar twice, each path running leaf to leaf
+    EXPECT_NEAR(planned.totalLength, 4.0 * std::sqrt(2.0) + 2.0, 1e-9);
+    for (const auto& path : planned.paths) {
+        EXPECT_EQ(graph.degree(path.startNode), 1u);
+        EXPECT_EQ(graph.degree(path.endNode), 1u);
+        EXPECT_DOUBLE_EQ(path.getMinDepth(), 0.0);
+    }
+}
+
+TEST_F(VCarveCalculatorTest, ContinuousTraversalLiftsWhereDepthChanges) {
+    MedialAxisGraph graph;
+    std::vector<SampledMedialPath> sampledPaths = sampleHShape(graph);
+    params.minimizeRetracts = true;
+
+    // Slope the bar so cutting it twice would deepen part of it
+    sampledPaths.back().points.front().clearanceRadius = 0.5;
+    VCarveResults planned = calculator->generateVCarvePaths(sampledPaths, params, &graph);
+    ASSERT_TRUE(planned.success);
+    EXPECT_EQ(planned.totalPaths, 3);
+    EXPECT_NEAR(planned.totalLength, 4.0 * std::sqrt(2.0) + 1.0, 1e-9);
+}
+
+TEST_F(VCarveCalculatorTest, ContinuousTraversalCutsALoopInOnePath) {
+    MedialAxisChains chains;
+    chains.addChain({Point2D(0, 0), Point2D(2, 0)}, {0.2, 0.3});
+    chains.addChain({Point2D(2, 0), Point2D(1, 2)}, {0.3, 0.1});
+    chains.addChain({Point2D(0, 0), Point2D(1, 2)}, {0.2, 0.1});
+    MedialAxisGraph graph = MedialAxisGraph::fromChains(chains);
+    std::vector<SampledMedialPath> sampledPaths;
+    sampleMedialAxisChains(chains, 1.0, 0.5, sampledPaths);
+
+    params.minimizeRetracts = true;
+    VCarveResults planned = calculator->generateVCarvePaths(sampledPaths, params, &graph);
+    ASSERT_TRUE(planned.success);
+    ASSERT_EQ(planned.totalPaths, 1);
+    EXPECT_EQ(planned.paths[0].startNode, planned.paths[0].endNode);
+
+    // Shared corner points are not repeated
+    size_t sampled = 0;
+    for (const auto& path : sampledPaths) {
+        sampled += path.points.size();
+    }
+    EXPECT_EQ(planned.paths[0].points.size(), sampled - 2);
+}
+
+// Plateau compression tests
+TEST_F(VCarveCalculatorTest, ClampedPlateausCollapseToTheirEnds) {
+    // Straight cut whose clearance climbs past maxVCarveDepth from x = 3 to x = 17
+    params.maxVCarveDepth = 3.0;
+    SampledMedialPath sampled;
+    for (int i = 0; i <= 20; ++i) {
+        sampled.points.emplace_back(Point2D(i, 0.0), std::min(i, 20 - i));
+    }
+    sampled.totalLength = 20.0;
+
+    VCarveResults results = calculator->generateVCarvePaths({sampled}, params);
+    ASSERT_TRUE(results.success);
+    ASSERT_EQ(results.paths.size(), 1u);
+    const VCarvePath& path = results.paths[0];
+
+    // The slopes keep every point; the plateau keeps only its ends
+    EXPECT_EQ(path.points.size(), 21u - 13u);
+    EXPECT_NEAR(path.totalLength, 20.0, 1e-12);
+    EXPECT_NEAR(path.getMaxDepth(), 3.0, 1e-12);
+
+    // A forced sample on the plateau stays
+    sampled.points[10].forced = true;
+    EXPECT_EQ(calculator->generateVCarvePaths({sampled}, params).paths[0].points.size(), 21u - 12u);
+
+    // Off at tolerance 0, and for paths projected onto a surface
+    params.pathSimplifyTolerance = 0.0;
+    EXPECT_EQ(calculator->generateVCarvePaths({sampled}, params).paths[0].points.size(), 21u);
+    params.pathSimplifyTolerance = 0.01;
+    params.projectToSurface = true;
+    params.targetSurfaceId = "surface";
+    EXPECT_EQ(calculator->generateVCarvePaths({sampled}, params).paths[0].points.size(), 21u);
+
+    // A caller's surface query decides the same way
+    auto surface = [](Millimeters, Millimeters) { return Millimeters(5.0); };
+    params.targetSurfaceId.clear();
+    EXPECT_EQ(calculator->generateVCarvePathsWithSurface({sampled}, params, 0.0, surface).paths[0].points.size(), 21u);
+    params.projectToSurface = false;
+    EXPECT_EQ(calculator->generateVCarvePathsWithSurface({sampled}, params, 0.0, surface).paths[0].points.size(),
+              21u - 12u);
+}
+
+TEST_F(VCarveCalculatorTest, PlateauCompressionKeepsCorners) {
+    // Constant clearance around a right angle: one plateau, but not one line
+    SampledMedialPath sampled;
+    for (int i = 0; i <= 5; ++i) {
+        sampled.points.emplace_back(Point2D(i, 0.0), 1.0);
+    }
+    for (int i = 1; i <= 5; ++i) {
+        sampled.points.emplace_back(Point2D(5.0, i), 1.0);
+    }
+    VCarvePath path;
+    for (const auto& point : sampled.points) {
+        path.append(VCarvePoint(point.position, 1.0, point.clearanceRadius));
+    }
+
+    EXPECT_EQ(VCarveCalculator::compressPlateaus(path, sampled, 0.01), 8u);
+    ASSERT_EQ(path.points.size(), 3u);
+    EXPECT_NEAR(path.points[1].position.x, 5.0, 1e-12);
+    EXPECT_NEAR(path.points[1].position.y, 0.0, 1e-12);
+    EXPECT_NEAR(path.totalLength, 10.0, 1e-12);
+}
+
+// Step-down tests
+TEST_F(VCarveCalculatorTest, StepDownPassesClampAndMergePlateaus) {
+    // Straight cut 5 mm deep in the middle, rising to the surface at both ends
+    VCarvePath path;
+    for (int i = 0; i <= 10; ++i) {
+        path.append(VCarvePoint(Point2D(i, 0.0), std::min(i, 10 - i), 1.0));
+    }
+
+    std::vector<VCarvePath> passes = VCarveCalculator::stepDownPasses(path, 2.0, true, 0.01);
+    ASSERT_EQ(passes.size(), 3u);
+    EXPECT_NEAR(passes[0].getMaxDepth(), 2.0, 1e-12);
+    EXPECT_NEAR(passes[1].getMaxDepth(), 4.0, 1e-12);
+    EXPECT_NEAR(passes[2].getMaxDepth(), 5.0, 1e-12);
+
+    // The collinear plateau between x = 2 and x = 8 is one segment
+    EXPECT_EQ(passes[0].points.size(), 6u);
+    EXPECT_NEAR(passes[0].totalLength, 10.0, 1e-12);
+
+    // Each pass starts where the one before ended; the last is the path itself
+    EXPECT_NEAR(passes[1].points.front().position.x, 10.0, 1e-12);
+    EXPECT_NEAR(passes[2].points.front().position.x, 0.0, 1e-12);
+    EXPECT_EQ(passes[2].points.size(), path.points.size());
+
+    // A cut no deeper than one step is a single pass
+    EXPECT_EQ(VCarveCalculator::stepDownPasses(path, 5.0, true, 0.01).size(), 1u);
+}
+
+TEST_F(VCarveCalculatorTest, StepDownKeepsEachChipsPassesTogether) {
+    // Two 3 mm deep cuts far apart
+    std::vector<SampledMedialPath> sampledPaths = {makeSegment(0.0, 10.0), makeSegment(50.0, 60.0)};
+    for (auto& sampled : sampledPaths) {
+        for (auto& point : sampled.points) {
+            point.clearanceRadius = 3.0;
+        }
+    }
+
+    VCarveResults single = calculator->generateVCarvePaths(sampledPaths, params);
+    params.stepDownDepth = 1.0;
+    VCarveResults stepped = calculator->generateVCarvePaths(sampledPaths, params);
+
+    ASSERT_TRUE(stepped.success);
+    ASSERT_EQ(stepped.totalPaths, 3 * single.totalPaths);
+    EXPECT_NEAR(stepped.maxDepth, single.maxDepth, 1e-12);
+    EXPECT_NEAR(stepped.totalLength, 3.0 * single.totalLength, 1e-9);
+
+    // Passes of one chip follow each other without travel; only the move between chips remains
+    EXPECT_NEAR(stepped.rapidDistance, single.rapidDistance, 1e-9);
+    for (int k = 0; k < 3; ++k) {
+        EXPECT_NEAR(stepped.paths[k].getMaxDepth(), k + 1.0, 1e-12);
+    }
+}
+
+TEST_F(VCarveCalculatorTest, ClearingOffsetsStartWhereTheDepthLimitStopsTheCutter) {
+    EXPECT_FALSE(VCarveCalculator::clearingOffsets(params).enabled());
+
+    params.clearingStepover = 2.0;
+    params.maxVCarveDepth = 3.0;
+    params.toolDiameter = 0.0;
+    ClearingOffsets offsets = VCarveCalculator::clearingOffsets(params);
+    ASSERT_TRUE(offsets.enabled());
+    EXPECT_NEAR(offsets.firstOffset, 0.3, 1e-12);  // 90° bit reaches 3 mm out at 3 mm deep, in cm
+    EXPECT_NEAR(offsets.stepover, 0.2, 1e-12);
+
+    // The diameter cap stops the cutter sooner
+    params.toolDiameter = 4.0;
+    EXPECT_NEAR(VCarveCalculator::clearingOffsets(params).firstOffset, 0.2, 1e-12);
+}
+
+TEST_F(VCarveCalculatorTest, ClearingLoopsBecomeClosedPathsAtTheDepthLimit) {
+    params.clearingStepover = 1.0;
+    params.maxVCarveDepth = 2.0;
+    params.toolDiameter = 0.0;
+
+    // Square loop 0.2 cm in from a 1 cm wide slot's walls
+    ClearingLoop loop;
+    loop.offset = 0.2;
+    loop.points = {Point2D(0.2, 0.2), Point2D(0.8, 0.2), Point2D(0.8, 0.8), Point2D(0.2, 0.8)};
+    std::vector<VCarvePath> paths = VCarveCalculator::clearingPaths({loop}, params);
+    ASSERT_EQ(paths.size(), 1u);
+    const VCarvePath& path = paths[0];
+    EXPECT_TRUE(path.isClosed);
+    ASSERT_EQ(path.points.size(), 5u);
+    EXPECT_NEAR(path.points.back().position.x, 2.0, 1e-12);
+    EXPECT_NEAR(path.points.back().position.y, 2.0, 1e-12);
+    EXPECT_NEAR(path.totalLength, 24.0, 1e-9);
+    for (const auto& point : path.points) {
+        EXPECT_NEAR(point.depth, 2.0, 1e-12);
+        EXPECT_NEAR(point.clearanceRadius, 2.0, 1e-12);
+    }
+
+    // Added to the V-carve, ordered with it but never merged into it
+    std::vector<SampledMedialPath> sampledPaths = {makeSegment(0.0, 10.0)};
+    VCarveResults plain = calculator->generateVCarvePaths(sampledPaths, params);
+    std::vector<ClearingLoop> loops = {loop};
+    VCarveResults cleared = calculator->generateVCarvePaths(sampledPaths, params, nullptr, &loops);
+    ASSERT_TRUE(cleared.success);
+    EXPECT_EQ(cleared.totalPaths, plain.totalPaths + 1);
+    EXPECT_NEAR(cleared.totalLength, plain.totalLength + 24.0, 1e-9);
+}
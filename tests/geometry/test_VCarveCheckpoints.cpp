@@ -0,0 +1,123 @@
+/**
+ * test_VCarveCheckpoints.cpp
+ *
+ * Unit tests for the crash checkpoints of computed V-carve paths.
+ * Verifies round-tripping, removal, and that unusable results are not saved.
+ */
+
+#include <gtest/gtest.h>
+
+#include <filesystem>
+#include <fstream>
+#include <string>
+
+#include "geometry/VCarveCheckpoints.h"
+
+using namespace ChipCarving::Geometry;
+
+class VCarveCheckpointsTest : public ::testing::Test {
+   protected:
+    void SetUp() override {
+        directory = (std::filesystem::path(::testing::TempDir()) / "vcarve_checkpoints_test").string();
+        std::filesystem::remove_all(directory);
+    }
+
+    void TearDown() override {
+        std::filesystem::remove_all(directory);
+    }
+
+    static VCarveResults makeResults() {
+        VCarveResults results;
+        VCarvePath open;
+        open.points = {VCarvePoint(Point2D(0, 0), 0.0, 0.0), VCarvePoint(Point2D(1, 0.5), 0.3, 0.5)};
+        open.totalLength = 1.118;
+        open.startNode = 4;
+        open.endNode = 7;
+        VCarvePath closed;
+        closed.points = {VCarvePoint(Point2D(2, 2), 0.1, 0.2), VCarvePoint(Point2D(3, 2), 0.2, 0.25),
+                         VCarvePoint(Point2D(2, 2), 0.1, 0.2)};
+        closed.totalLength = 2.0;
+        closed.isClosed = true;
+        results.paths = {open, closed};
+        results.totalPaths = 2;
+        results.totalPoints = 5;
+        results.totalLength = 3.118;
+        results.maxDepth = 0.3;
+        results.minDepth = 0.0;
+        results.rapidDistance = 1.5;
+        results.unorderedRapidDistance = 2.5;
+        results.pathsOrdered = true;
+        results.success = true;
+        return results;
+    }
+
+    std::string directory;
+};
+
+TEST_F(VCarveCheckpointsTest, StoreAndLoadRoundTrip) {
+    VCarveCheckpoints checkpoints(directory);
+    ASSERT_TRUE(checkpoints.isEnabled());
+
+    VCarveResults original = makeResults();
+    ASSERT_TRUE(checkpoints.store(0xabcdef, original));
+
+    VCarveResults loaded;
+    ASSERT_TRUE(checkpoints.load(0xabcdef, loaded));
+    EXPECT_TRUE(loaded.success);
+    EXPECT_TRUE(loaded.pathsOrdered);
+    EXPECT_EQ(loaded.totalPaths, 2);
+    EXPECT_EQ(loaded.totalPoints, 5);
+    EXPECT_DOUBLE_EQ(loaded.totalLength, original.totalLength);
+    EXPECT_DOUBLE_EQ(loaded.maxDepth, original.maxDepth);
+    EXPECT_DOUBLE_EQ(loaded.rapidDistance, original.rapidDistance);
+    EXPECT_DOUBLE_EQ(loaded.unorderedRapidDistance, original.unorderedRapidDistance);
+
+    ASSERT_EQ(loaded.paths.size(), 2u);
+    EXPECT_EQ(loaded.paths[0].startNode, 4u);
+    EXPECT_EQ(loaded.paths[0].endNode, 7u);
+    EXPECT_FALSE(loaded.paths[0].isClosed);
+    EXPECT_TRUE(loaded.paths[1].isClosed);
+    ASSERT_EQ(loaded.paths[1].points.size(), 3u);
+    EXPECT_DOUBLE_EQ(loaded.paths[1].points[1].position.x, 3.0);
+    EXPECT_DOUBLE_EQ(loaded.paths[1].points[1].depth, 0.2);
+    EXPECT_DOUBLE_EQ(loaded.paths[1].points[1].clearanceRadius, 0.25);
+}
+
+TEST_F(VCarveCheckpointsTest, MissingAndRemovedCheckpointsDoNotLoad) {
+    VCarveCheckpoints checkpoints(directory);
+    VCarveResults loaded;
+    EXPECT_FALSE(checkpoints.load(0x42, loaded));
+
+    ASSERT_TRUE(checkpoints.store(0x42, makeResults()));
+    checkpoints.remove(0x42);
+    EXPECT_FALSE(checkpoints.load(0x42, loaded));
+    EXPECT_FALSE(std::filesystem::exists(checkpoints.pathForKey(0x42)));
+}
+
+TEST_F(VCarveCheckpointsTest, FailedAndCompactedResultsAreNotStored) {
+    VCarveCheckpoints checkpoints(directory);
+
+    VCarveResults failed = makeResults();
+    failed.success = false;
+    EXPECT_FALSE(checkpoints.store(1, failed));
+
+    VCarveResults compacted = makeResults();
+    compacted.compact();
+    EXPECT_FALSE(checkpoints.store(2, compacted));
+}
+
+TEST_F(VCarveCheckpointsTest, TruncatedCheckpointIsRejected) {
+    VCarveCheckpoints checkpoints(directory);
+    ASSERT_TRUE(checkpoints.store(0x77, makeResults()));
+
+    std::string path = checkpoints.pathForKey(0x77);
+    std::filesystem::resize_file(path, std::filesystem::file_size(path) - 8);
+    VCarveResults loaded;
+    EXPECT_FALSE(checkpoints.load(0x77, loaded));
+}
+
+TEST(VCarveCheckpointsDisabledTest, EmptyDirectoryDisablesCheckpoints) {
+    VCarveCheckpoints checkpoints("");
+    EXPECT_FALSE(checkpoints.isEnabled());
+    EXPECT_FALSE(checkpoints.store(1, VCarveResults()));
+}
@@ -39,6 +39,19 @@ TEST_F(VCarvePathTest, VCarvePointDefaultConstruction) {
 }
 
 // VCarvePath Tests
+TEST_F(VCarvePathTest, VCarvePointSketchRelativeZ) {
+    VCarvePoint point(Point2D(1.0, 2.0), 1.5, 3.0);
+    EXPECT_FALSE(point.surfaceProjected);
+    EXPECT_DOUBLE_EQ(point.sketchRelativeZ(10.0), -1.5);
+
+    // Projected points cut below the surface, expressed relative to the sketch plane
+    point.projectToSurface(12.0);
+    EXPECT_TRUE(point.surfaceProjected);
+    EXPECT_DOUBLE_EQ(point.surfaceZ, 12.0);
+    EXPECT_DOUBLE_EQ(point.sketchRelativeZ(10.0), 0.5);
+    EXPECT_DOUBLE_EQ(point.clearanceRadius, 3.0);
+}
+
 TEST_F(VCarvePathTest, VCarvePathDefaultConstruction) {
     VCarvePath path;
     
@@ -195,6 +208,74 @@ TEST_F(VCarvePathTest, VCarveResultsGetSummary) {
     EXPECT_NE(summary.find("10"), std::string::npos);     // Total length
 }
 
+TEST_F(VCarvePathTest, AppendKeepsStatisticsCurrent) {
+    VCarvePath path;
+    path.append(VCarvePoint(Point2D(0, 0), 1.0, 1.0));
+    path.append(VCarvePoint(Point2D(3, 4), 2.5, 2.5));
+    path.append(VCarvePoint(Point2D(3, 0), 0.5, 0.5));
+
+    EXPECT_TRUE(path.statisticsCurrent());
+    EXPECT_DOUBLE_EQ(path.totalLength, 9.0);
+    EXPECT_DOUBLE_EQ(path.minDepth, 0.5);
+    EXPECT_DOUBLE_EQ(path.maxDepth, 2.5);
+    EXPECT_DOUBLE_EQ(path.totalLength, path.calculateLength());
+
+    // Points added directly leave the statistics to the next rescan
+    path.points.emplace_back(Point2D(3, -2), 4.0, 4.0);
+    EXPECT_FALSE(path.statisticsCurrent());
+    EXPECT_EQ(path.getMaxDepth(), 4.0);
+    path.updateStatistics();
+    EXPECT_TRUE(path.statisticsCurrent());
+    EXPECT_DOUBLE_EQ(path.totalLength, 11.0);
+    EXPECT_DOUBLE_EQ(path.maxDepth, 4.0);
+}
+
+TEST_F(VCarvePathTest, AppendPathCombinesStatistics) {
+    VCarvePath first;
+    first.append(VCarvePoint(Point2D(0, 0), 1.0, 1.0));
+    first.append(VCarvePoint(Point2D(2, 0), 2.0, 2.0));
+    VCarvePath second;
+    second.append(VCarvePoint(Point2D(2, 3), 3.0, 3.0));
+    second.append(VCarvePoint(Point2D(2, 0), 0.5, 0.5));
+
+    // Reversed, the second path starts on the first one's last point, which is skipped
+    VCarvePath trail;
+    trail.appendPath(first, false, false);
+    trail.appendPath(second, true, true);
+    ASSERT_EQ(trail.points.size(), 3u);
+    EXPECT_TRUE(trail.statisticsCurrent());
+    EXPECT_DOUBLE_EQ(trail.totalLength, 5.0);
+    EXPECT_DOUBLE_EQ(trail.totalLength, trail.calculateLength());
+    EXPECT_DOUBLE_EQ(trail.maxDepth, 3.0);
+
+    // Without the shared point the bridging move counts too
+    trail.appendPath(first, false, false);
+    EXPECT_DOUBLE_EQ(trail.totalLength, trail.calculateLength());
+    EXPECT_DOUBLE_EQ(trail.minDepth, 0.5);
+    EXPECT_TRUE(trail.statisticsCurrent());
+}
+
+TEST_F(VCarvePathTest, VCarveResultsUpdateStatisticsUsesPathStatistics) {
+    VCarveResults results;
+    VCarvePath path;
+    path.append(VCarvePoint(Point2D(0, 0), 1.0, 1.0));
+    path.append(VCarvePoint(Point2D(10, 0), 2.0, 2.0));
+    path.totalLength = 12.5;  // Kept as is while the statistics are current
+    results.paths.push_back(path);
+
+    results.updateStatistics();
+    EXPECT_EQ(results.totalPoints, 2);
+    EXPECT_DOUBLE_EQ(results.totalLength, 12.5);
+    EXPECT_DOUBLE_EQ(results.maxDepth, 2.0);
+
+    // An out-of-date path is rescanned
+    results.paths[0].points.emplace_back(Point2D(10, 5), 0.25, 0.25);
+    results.updateStatistics();
+    EXPECT_EQ(results.totalPoints, 3);
+    EXPECT_DOUBLE_EQ(results.totalLength, 15.0);
+    EXPECT_DOUBLE_EQ(results.minDepth, 0.25);
+}
+
 // Real-world scenario tests
 TEST_F(VCarvePathTest, RealWorldTriangularVCarve) {
     // Simulate a triangular V-carve path with varying depths
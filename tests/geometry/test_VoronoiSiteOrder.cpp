@@ -0,0 +1,109 @@
+/**
+ * test_VoronoiSiteOrder.cpp
+ *
+ * Unit tests for OpenVoronoi point site ordering and bin counts
+ */
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <vector>
+
+#include "geometry/VoronoiSiteOrder.h"
+
+using namespace ChipCarving::Geometry;
+
+namespace {
+
+std::vector<Point2D> makeCircle(double radius, int count) {
+    std::vector<Point2D> points;
+    for (int i = 0; i < count; ++i) {
+        double angle = 2.0 * M_PI * i / count;
+        points.emplace_back(radius * std::cos(angle), radius * std::sin(angle));
+    }
+    return points;
+}
+
+bool isPermutation(std::vector<size_t> order, size_t size) {
+    std::sort(order.begin(), order.end());
+    for (size_t i = 0; i < order.size(); ++i) {
+        if (order[i] != i) {
+            return false;
+        }
+    }
+    return order.size() == size;
+}
+
+}  // namespace
+
+TEST(VoronoiSiteOrderTest, EveryOrderIsAPermutation) {
+    std::vector<Point2D> points = makeCircle(0.8, 257);
+    for (auto order : {SiteInsertionOrder::POLYGON, SiteInsertionOrder::HILBERT, SiteInsertionOrder::SHUFFLED}) {
+        EXPECT_TRUE(isPermutation(siteInsertionOrder(points, order), points.size()));
+    }
+
+    std::vector<size_t> polygonOrder = siteInsertionOrder(points, SiteInsertionOrder::POLYGON);
+    EXPECT_EQ(polygonOrder[0], 0u);
+    EXPECT_EQ(polygonOrder[256], 256u);
+
+    // The shuffle is seeded, so diagrams come out the same every run
+    EXPECT_EQ(siteInsertionOrder(points, SiteInsertionOrder::SHUFFLED),
+              siteInsertionOrder(points, SiteInsertionOrder::SHUFFLED));
+    EXPECT_NE(siteInsertionOrder(points, SiteInsertionOrder::SHUFFLED), polygonOrder);
+}
+
+TEST(VoronoiSiteOrderTest, HilbertOrderVisitsGridCellsAdjacently) {
+    // On a full 2^k grid the Hilbert curve steps one cell at a time
+    std::vector<Point2D> grid;
+    for (int y = 0; y < 16; ++y) {
+        for (int x = 0; x < 16; ++x) {
+            grid.emplace_back(x, y);
+        }
+    }
+    std::vector<size_t> order = siteInsertionOrder(grid, SiteInsertionOrder::HILBERT);
+    ASSERT_TRUE(isPermutation(order, grid.size()));
+    for (size_t i = 0; i + 1 < order.size(); ++i) {
+        int dx = std::abs(static_cast<int>(order[i] % 16) - static_cast<int>(order[i + 1] % 16));
+        int dy = std::abs(static_cast<int>(order[i] / 16) - static_cast<int>(order[i + 1] / 16));
+        EXPECT_EQ(dx + dy, 1) << "step " << i;
+    }
+}
+
+TEST(VoronoiSiteOrderTest, BinCountFollowsSiteDensity) {
+    EXPECT_EQ(openVoronoiBinCount({}), 10);
+    EXPECT_EQ(openVoronoiBinCount(makeCircle(0.8, 20)), 10);
+
+    // More sites in the same box means more bins; a smaller box of the same sites too
+    int wide = openVoronoiBinCount(makeCircle(0.8, 4000));
+    EXPECT_GT(wide, static_cast<int>(std::sqrt(4000.0)));
+    EXPECT_GT(openVoronoiBinCount(makeCircle(0.4, 4000)), wide);
+
+    // Degenerate boxes are capped instead of exploding the grid
+    std::vector<Point2D> line;
+    for (int i = 0; i < 400; ++i) {
+        line.emplace_back(-0.8 + 1.6 * i / 399.0, 0.0);
+    }
+    EXPECT_LE(openVoronoiBinCount(line), 60);
+}
+
+TEST(VoronoiSiteOrderTest, BufferedOrderMatchesAndReusesStorage) {
+    std::vector<Point2D> points;
+    for (int i = 0; i < 500; ++i) {
+        double angle = 0.0125 * i;
+        points.emplace_back(0.8 * std::cos(angle), 0.5 * std::sin(3.0 * angle));
+    }
+
+    std::vector<size_t> indices;
+    std::vector<uint64_t> keys;
+    siteInsertionOrder(points, SiteInsertionOrder::HILBERT, indices, keys);
+    EXPECT_EQ(indices, siteInsertionOrder(points, SiteInsertionOrder::HILBERT));
+
+    // A smaller polygon fits in the grown buffers
+    const size_t* storage = indices.data();
+    points.resize(200);
+    siteInsertionOrder(points, SiteInsertionOrder::HILBERT, indices, keys);
+    EXPECT_EQ(indices.data(), storage);
+    EXPECT_EQ(indices, siteInsertionOrder(points, SiteInsertionOrder::HILBERT));
+}
@@ -6,19 +6,26 @@
  */
 
 #include "utils/logging.h"
+#include <atomic>
 #include <iostream>
 
 // Global minimum log level for tests
-static LogLevel g_minLogLevel = LogLevel::LOG_DEBUG;
+static std::atomic<LogLevel> g_minLogLevel{LogLevel::LOG_DEBUG};
+
+// Per-thread suppression flag (mirrors the plugin implementation)
+static thread_local bool t_consoleLoggingSuppressed = false;
 
 void LogToConsole(const std::string& message) {
+    if (t_consoleLoggingSuppressed) {
+        return;
+    }
     // In tests, just output to stdout
     std::cout << "[TEST] " << message << std::endl;
 }
 
 void LogToConsole(LogLevel level, const std::string& message) {
     // Check if message should be logged based on level
-    if (static_cast<int>(level) < static_cast<int>(g_minLogLevel)) {
+    if (t_consoleLoggingSuppressed || static_cast<int>(level) < static_cast<int>(g_minLogLevel.load())) {
         return;
     }
     
@@ -49,4 +56,13 @@ void SetMinLogLevel(LogLevel level) {
 
 LogLevel GetMinLogLevel() {
     return g_minLogLevel;
-}
\ No newline at end of file
+}
+
+void SetThreadConsoleLoggingSuppressed(bool suppressed) {
+    t_consoleLoggingSuppressed = suppressed;
+}
+
+// Tests write straight to stdout from every thread, so there is nothing to queue
+void SetConsoleLogMainThread(std::function<void()> /* wakeMainThread */) {}
+
+void FlushQueuedConsoleLog() {}
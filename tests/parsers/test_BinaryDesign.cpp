@@ -0,0 +1,143 @@
+/**
+ * Unit tests for binary design files and the binary design cache
+ */
+
+#include <gtest/gtest.h>
+
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <vector>
+
+#include "geometry/Leaf.h"
+#include "geometry/TriArc.h"
+#include "parsers/BinaryDesign.h"
+#include "parsers/DesignParser.h"
+
+using namespace ChipCarving::Parsers;
+using namespace ChipCarving::Geometry;
+
+namespace {
+
+std::string tempPath(const std::string& name) {
+    return (std::filesystem::path(::testing::TempDir()) / name).string();
+}
+
+void writeText(const std::string& path, const std::string& text) {
+    std::ofstream out(path, std::ios::binary | std::ios::trunc);
+    out << text;
+}
+
+const char* DESIGN_JSON =
+    R"({"version": "2.0", "metadata": {"name": "Rosette", "author": "Test Author"},)"
+    R"( "shapes": [{"type": "LEAF", "vertices": [{"x": 0, "y": 0}, {"x": 10, "y": 0}], "radius": 6.5},)"
+    R"( {"type": "TRI_ARC", "vertices": [{"x": 20, "y": 0}, {"x": 30, "y": 0}, {"x": 25, "y": 8.66}],)"
+    R"( "curvatures": [-0.1, -0.15, -0.2]}],)"
+    R"( "backgroundImages": [{"id": "photo", "imageData": "AB\/CD\"EF", "scale": 2, "rotation": 30}]})";
+
+class CountingHandler : public DesignParseHandler {
+   public:
+    bool acceptsShape(const std::string& type) const override {
+        return type == "TRI_ARC";
+    }
+
+    void onShape(std::unique_ptr<Shape> shape, size_t index) override {
+        EXPECT_NE(dynamic_cast<TriArc*>(shape.get()), nullptr);
+        indices.push_back(index);
+    }
+
+    std::vector<size_t> indices;
+};
+
+}  // namespace
+
+TEST(BinaryDesignTest, ConvertedDesignReadsBackWithoutParsing) {
+    std::string jsonPath = tempPath("binary_design_source.json");
+    std::string binaryPath = tempPath("binary_design_source.ccdb");
+    writeText(jsonPath, DESIGN_JSON);
+    ASSERT_TRUE(convertDesignToBinary(jsonPath, binaryPath));
+
+    BinaryDesignReader reader(binaryPath);
+    EXPECT_EQ(reader.shapeCount(), 2u);
+    EXPECT_EQ(reader.shapeRecord(0).type, static_cast<uint32_t>(BinaryShapeType::Leaf));
+    EXPECT_GT(reader.sourceSize(), 0u);
+
+    // parseFromFile recognises the binary file by its magic
+    DesignFile design = DesignParser::parseFromFile(binaryPath);
+    EXPECT_EQ(design.version, "2.0");
+    EXPECT_EQ(design.metadata.name.value(), "Rosette");
+    EXPECT_EQ(design.metadata.author.value(), "Test Author");
+    EXPECT_FALSE(design.metadata.description.has_value());
+    ASSERT_EQ(design.shapes.size(), 2u);
+
+    const auto* leaf = dynamic_cast<const Leaf*>(design.shapes[0].get());
+    ASSERT_NE(leaf, nullptr);
+    EXPECT_DOUBLE_EQ(leaf->getFocus2().x, 10.0);
+    EXPECT_DOUBLE_EQ(leaf->getRadius(), 6.5);
+    const auto* triArc = dynamic_cast<const TriArc*>(design.shapes[1].get());
+    ASSERT_NE(triArc, nullptr);
+    EXPECT_DOUBLE_EQ(triArc->getVertices()[2].y, 8.66);
+    EXPECT_DOUBLE_EQ(triArc->getBulgeFactors()[1], -0.15);
+
+    ASSERT_EQ(design.backgroundImages.size(), 1u);
+    const auto& image = design.backgroundImages[0];
+    EXPECT_EQ(image.id, "photo");
+    EXPECT_TRUE(image.hasDeferredImageData());
+    EXPECT_EQ(image.loadImageData(), "AB/CD\"EF");
+    EXPECT_DOUBLE_EQ(image.scale, 2.0);
+    EXPECT_DOUBLE_EQ(image.rotation, 30.0);
+
+    // Streaming skips rejected shapes but keeps their index
+    CountingHandler handler;
+    DesignParser::parseFromFile(binaryPath, DesignParseOptions(), handler);
+    EXPECT_EQ(handler.indices, std::vector<size_t>{1});
+
+    std::remove(jsonPath.c_str());
+    std::remove(binaryPath.c_str());
+}
+
+TEST(BinaryDesignTest, RejectsTruncatedAndForeignFiles) {
+    std::string jsonPath = tempPath("binary_design_truncated.json");
+    std::string binaryPath = tempPath("binary_design_truncated.ccdb");
+    writeText(jsonPath, DESIGN_JSON);
+    ASSERT_TRUE(convertDesignToBinary(jsonPath, binaryPath));
+
+    std::filesystem::resize_file(binaryPath, std::filesystem::file_size(binaryPath) - 3);
+    EXPECT_THROW(BinaryDesignReader reader(binaryPath), std::runtime_error);
+    EXPECT_THROW(DesignParser::parseFromFile(binaryPath), std::runtime_error);
+    EXPECT_THROW(BinaryDesignReader reader(jsonPath), std::runtime_error);
+    EXPECT_THROW(BinaryDesignReader reader(tempPath("binary_design_missing.ccdb")), std::runtime_error);
+
+    std::remove(jsonPath.c_str());
+    std::remove(binaryPath.c_str());
+}
+
+TEST(BinaryDesignTest, CacheIsReusedUntilTheJsonChanges) {
+    std::string cacheDir = tempPath("binary_design_cache");
+    std::filesystem::remove_all(cacheDir);
+    std::filesystem::create_directories(cacheDir);
+    std::string jsonPath = tempPath("binary_design_cached.json");
+    writeText(jsonPath, DESIGN_JSON);
+
+    DesignParseOptions options;
+    options.binaryCacheDirectory = cacheDir;
+    std::string cachePath = binaryDesignCachePath(cacheDir, jsonPath);
+    EXPECT_EQ(openFreshBinaryDesign(cachePath, jsonPath), nullptr);
+    EXPECT_EQ(DesignParser::parseFromFile(jsonPath, options).shapes.size(), 2u);
+    ASSERT_NE(openFreshBinaryDesign(cachePath, jsonPath), nullptr);
+    EXPECT_EQ(DesignParser::parseFromFile(jsonPath, options).metadata.name.value(), "Rosette");
+
+    // A changed design is parsed again and its cache entry replaced
+    writeText(jsonPath, R"({"version": "2.0", "shapes": [)"
+                        R"({"type": "LEAF", "vertices": [{"x": 0, "y": 0}, {"x": 4, "y": 0}], "radius": 3}]})");
+    EXPECT_EQ(openFreshBinaryDesign(cachePath, jsonPath), nullptr);
+    DesignFile changed = DesignParser::parseFromFile(jsonPath, options);
+    ASSERT_EQ(changed.shapes.size(), 1u);
+    EXPECT_FALSE(changed.metadata.name.has_value());
+    ASSERT_NE(openFreshBinaryDesign(cachePath, jsonPath), nullptr);
+    EXPECT_EQ(openFreshBinaryDesign(cachePath, jsonPath)->shapeCount(), 1u);
+
+    std::remove(jsonPath.c_str());
+    std::filesystem::remove_all(cacheDir);
+}
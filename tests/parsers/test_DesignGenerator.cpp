@@ -0,0 +1,78 @@
+/**
+ * Unit tests for the synthetic load-testing design generator
+ */
+
+#include <gtest/gtest.h>
+
+#include <cmath>
+#include <string>
+
+#include "../tools/DesignGenerator.h"
+#include "geometry/Leaf.h"
+#include "geometry/TriArc.h"
+#include "parsers/DesignParser.h"
+
+using namespace ChipCarving::Parsers;
+using namespace ChipCarving::Geometry;
+using namespace ChipCarving::Testing;
+
+namespace {
+
+const std::string CONSTANTS_PATH = std::string(CHIP_CARVING_SCHEMA_DIR) + "/constants.json";
+
+}  // namespace
+
+TEST(DesignGeneratorTest, LoadsRangesFromSchemaConstants) {
+    ShapeRanges ranges = loadShapeRanges(CONSTANTS_PATH);
+    EXPECT_DOUBLE_EQ(ranges.minSagittaRatio, 0.001);
+    EXPECT_DOUBLE_EQ(ranges.maxSagittaRatio, 0.5);
+    EXPECT_DOUBLE_EQ(ranges.bulgeMin, -0.2);
+    EXPECT_DOUBLE_EQ(ranges.bulgeMax, -0.001);
+
+    EXPECT_THROW(loadShapeRanges(CONSTANTS_PATH + ".missing"), std::runtime_error);
+}
+
+TEST(DesignGeneratorTest, EveryPatternParsesWithShapesInRange) {
+    for (const char* name : {"grid", "rosette", "border"}) {
+        DesignGeneratorOptions options;
+        ASSERT_TRUE(parseDesignPattern(name, options.pattern));
+        options.shapeCount = 500;
+        options.ranges = loadShapeRanges(CONSTANTS_PATH);
+
+        DesignFile design = DesignParser::parseFromString(generateDesign(options));
+        ASSERT_EQ(design.shapes.size(), 500u) << name;
+
+        int leaves = 0;
+        for (const auto& shape : design.shapes) {
+            if (const auto* leaf = dynamic_cast<const Leaf*>(shape.get())) {
+                ++leaves;
+                double ratio = leaf->getSagitta() / distance(leaf->getFocus1(), leaf->getFocus2());
+                EXPECT_GE(ratio, options.ranges.minSagittaRatio - 1e-9) << name;
+                EXPECT_LE(ratio, options.ranges.maxSagittaRatio + 1e-9) << name;
+            } else {
+                const auto* triArc = dynamic_cast<const TriArc*>(shape.get());
+                ASSERT_NE(triArc, nullptr) << name;
+                for (double bulge : triArc->getBulgeFactors()) {
+                    EXPECT_GE(bulge, options.ranges.bulgeMin) << name;
+                    EXPECT_LE(bulge, options.ranges.bulgeMax) << name;
+                }
+            }
+        }
+        // Both shape types appear in a 50/50 mix
+        EXPECT_GT(leaves, 150) << name;
+        EXPECT_LT(leaves, 350) << name;
+    }
+    DesignPattern pattern;
+    EXPECT_FALSE(parseDesignPattern("spiral", pattern));
+}
+
+TEST(DesignGeneratorTest, SameSeedGivesSameDesign) {
+    DesignGeneratorOptions options;
+    options.pattern = DesignPattern::Rosette;
+    options.shapeCount = 50;
+    std::string first = generateDesign(options);
+    EXPECT_EQ(generateDesign(options), first);
+
+    options.seed = 2;
+    EXPECT_NE(generateDesign(options), first);
+}
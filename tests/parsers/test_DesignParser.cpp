@@ -4,6 +4,10 @@
 
 #include <gtest/gtest.h>
 
+#include <algorithm>
+#include <filesystem>
+#include <fstream>
+
 #include "geometry/Leaf.h"
 #include "geometry/TriArc.h"
 #include "parsers/DesignParser.h"
@@ -266,4 +270,282 @@ TEST_F(DesignParserTest, TriArcValidation) {
         ]
     })";
     EXPECT_THROW(DesignParser::parseFromString(degenerateTriangle), std::runtime_error);
-}
\ No newline at end of file
+}
+TEST_F(DesignParserTest, ParsesBackgroundImagesAndIgnoresUnknownKeys) {
+    std::string json = R"({
+        "version": "2.0",
+        "editorState": {"zoom": 2, "selection": [1, 2]},
+        "shapes": [
+            {
+                "type": "LEAF",
+                "id": "leaf-1",
+                "vertices": [{"x": 0.0, "y": 0.0}, {"x": 10.0, "y": 0.0}],
+                "radius": 6.5
+            }
+        ],
+        "backgroundImages": [
+            {
+                "id": "img",
+                "imageData": "data:image/png;base64,AAAA",
+                "position": {"x": 1.5, "y": -2.0},
+                "rotation": 45,
+                "scale": 0.5,
+                "opacity": 0.8,
+                "naturalWidth": 640,
+                "naturalHeight": 480
+            }
+        ]
+    })";
+
+    auto design = DesignParser::parseFromString(json);
+    ASSERT_EQ(design.shapes.size(), 1);
+    ASSERT_EQ(design.backgroundImages.size(), 1);
+    const auto& image = design.backgroundImages[0];
+    EXPECT_EQ(image.id, "img");
+    EXPECT_EQ(image.imageData, "data:image/png;base64,AAAA");
+    EXPECT_NEAR(image.position.x, 1.5, 1e-9);
+    EXPECT_NEAR(image.position.y, -2.0, 1e-9);
+    EXPECT_NEAR(image.rotation, 45.0, 1e-9);
+    EXPECT_NEAR(image.naturalHeight, 480.0, 1e-9);
+}
+
+TEST_F(DesignParserTest, SyntaxErrorsReportLocation) {
+    std::string json = "{\n  \"version\": \"2.0\",\n  \"shapes\": [\n    {\"type\": \"LEAF\" \"radius\": 1}\n  ]\n}";
+    try {
+        DesignParser::parseFromString(json);
+        FAIL() << "Expected a parse error";
+    } catch (const std::runtime_error& e) {
+        EXPECT_NE(std::string(e.what()).find("line 4"), std::string::npos) << e.what();
+    }
+}
+
+TEST_F(DesignParserTest, DeferredBackgroundImagesDecodeOnDemand) {
+    std::string path = (std::filesystem::path(::testing::TempDir()) / "design_parser_deferred.json").string();
+    {
+        std::ofstream out(path, std::ios::binary | std::ios::trunc);
+        out << R"({"version": "2.0", "backgroundImages": [{"id": "photo", "imageData": "AB\/CD\"EF", "scale": 2}],)"
+            << R"( "shapes": [{"type": "LEAF", "vertices": [{"x": 0, "y": 0}, {"x": 10, "y": 0}], "radius": 6.5}]})";
+    }
+
+    auto eager = DesignParser::parseFromFile(path);
+    ASSERT_EQ(eager.backgroundImages.size(), 1);
+    EXPECT_FALSE(eager.backgroundImages[0].hasDeferredImageData());
+    EXPECT_EQ(eager.backgroundImages[0].imageData, "AB/CD\"EF");
+
+    DesignParseOptions options;
+    options.deferBackgroundImageData = true;
+    auto deferred = DesignParser::parseFromFile(path, options);
+    ASSERT_EQ(deferred.shapes.size(), 1);
+    ASSERT_EQ(deferred.backgroundImages.size(), 1);
+    const auto& image = deferred.backgroundImages[0];
+    EXPECT_TRUE(image.hasDeferredImageData());
+    EXPECT_TRUE(image.imageData.empty());
+    EXPECT_EQ(image.id, "photo");
+    EXPECT_NEAR(image.scale, 2.0, 1e-9);
+    EXPECT_EQ(image.loadImageData(), "AB/CD\"EF");
+
+    std::filesystem::remove(path);
+    EXPECT_THROW(DesignParser::parseFromFile(path, options), std::runtime_error);
+}
+
+namespace {
+
+// Records each event in the order the parser delivers it
+class RecordingHandler : public DesignParseHandler {
+   public:
+    void onMetadata(const DesignMetadata& metadata) override {
+        events.push_back("metadata " + metadata.name.value_or(""));
+    }
+
+    bool acceptsShape(const std::string& type) const override {
+        return type != rejectedType;
+    }
+
+    void onShape(std::unique_ptr<Shape> shape, size_t index) override {
+        std::string kind = dynamic_cast<Leaf*>(shape.get()) ? "leaf" : "triarc";
+        events.push_back("shape " + std::to_string(index) + " " + kind);
+    }
+
+    void onBackgroundImage(BackgroundImage image) override {
+        events.push_back("image " + image.id);
+    }
+
+    std::string rejectedType;
+    std::vector<std::string> events;
+};
+
+}  // namespace
+
+TEST_F(DesignParserTest, StreamsMembersInFileOrderAndSkipsRejectedShapes) {
+    std::string json = R"({"version": "2.0", "shapes": [)"
+                       R"({"type": "LEAF", "vertices": [{"x": 0, "y": 0}, {"x": 10, "y": 0}], "radius": 6.5},)"
+                       R"({"type": "TRI_ARC", "vertices": [{"x": 20, "y": 0}, {"x": 30, "y": 0},)"
+                       R"( {"x": 25, "y": 8.66}], "curvatures": [-0.1, -0.15, -0.2]},)"
+                       R"({"type": "LEAF", "vertices": [{"x": 0, "y": 5}, {"x": 10, "y": 5}], "radius": 6.5}],)"
+                       R"( "backgroundImages": [{"id": "photo", "imageData": "AAAA"}],)"
+                       R"( "metadata": {"name": "Streamed"}})";
+
+    RecordingHandler all;
+    DesignParser::parseFromString(json, all);
+    std::vector<std::string> expected = {"shape 0 leaf", "shape 1 triarc", "shape 2 leaf", "image photo",
+                                         "metadata Streamed"};
+    EXPECT_EQ(all.events, expected);
+
+    // Rejected shapes keep their place in the index count
+    RecordingHandler leavesOnly;
+    leavesOnly.rejectedType = "TRI_ARC";
+    DesignParser::parseFromString(json, leavesOnly);
+    expected = {"shape 0 leaf", "shape 2 leaf", "image photo", "metadata Streamed"};
+    EXPECT_EQ(leavesOnly.events, expected);
+
+    // Even an all-rejected file has shapes, so it still parses
+    RecordingHandler none;
+    none.rejectedType = "LEAF";
+    EXPECT_NO_THROW(DesignParser::parseFromString(validLeafJson, none));
+    EXPECT_EQ(none.events, std::vector<std::string>{"metadata Test Design"});
+}
+
+TEST_F(DesignParserTest, StreamingDeliversShapesReadBeforeAnError) {
+    std::string json = R"({"version": "2.0", "shapes": [)"
+                       R"({"type": "LEAF", "vertices": [{"x": 0, "y": 0}, {"x": 10, "y": 0}], "radius": 6.5},)"
+                       R"({"type": "LEAF", "vertices": [{"x": 0, "y": 0}, {"x": 10, "y": 0}], "radius": -1}]})";
+    RecordingHandler handler;
+    try {
+        DesignParser::parseFromString(json, handler);
+        FAIL() << "Expected a shape error";
+    } catch (const std::runtime_error& e) {
+        EXPECT_NE(std::string(e.what()).find("Shape 1"), std::string::npos) << e.what();
+    }
+    EXPECT_EQ(handler.events, std::vector<std::string>{"shape 0 leaf"});
+
+    RecordingHandler unversioned;
+    EXPECT_THROW(DesignParser::parseFromString(R"({"shapes": []})", unversioned), std::runtime_error);
+}
+
+namespace {
+
+// gzip file of text in stored deflate blocks of blockSize bytes
+std::string gzipStored(const std::string& text, size_t blockSize) {
+    std::string file = {'\x1f', '\x8b', '\x08', '\x00', 0, 0, 0, 0, 0, '\x03'};
+    for (size_t start = 0; start < text.size(); start += blockSize) {
+        size_t length = std::min(blockSize, text.size() - start);
+        bool last = start + length >= text.size();
+        file += static_cast<char>(last ? 1 : 0);
+        file += static_cast<char>(length & 0xFF);
+        file += static_cast<char>(length >> 8);
+        file += static_cast<char>(~length & 0xFF);
+        file += static_cast<char>((~length >> 8) & 0xFF);
+        file += text.substr(start, length);
+    }
+    uint32_t crc = 0xFFFFFFFFu;
+    for (char byte : text) {
+        crc ^= static_cast<unsigned char>(byte);
+        for (int k = 0; k < 8; ++k) {
+            crc = (crc & 1) ? 0xEDB88320u ^ (crc >> 1) : crc >> 1;
+        }
+    }
+    crc ^= 0xFFFFFFFFu;
+    for (uint64_t value : {uint64_t(crc), uint64_t(text.size())}) {
+        for (int shift = 0; shift < 32; shift += 8) {
+            file += static_cast<char>((value >> shift) & 0xFF);
+        }
+    }
+    return file;
+}
+
+}  // namespace
+
+TEST_F(DesignParserTest, ParsesGzipCompressedDesignFiles) {
+    std::string path = (std::filesystem::path(::testing::TempDir()) / "design_parser_compressed.json.gz").string();
+    std::string json = R"({"version": "2.0", "backgroundImages": [{"id": "photo", "imageData": "AB\/CD\"EF"}],)"
+                       R"( "metadata": {"name": "Packed"}, "shapes": [)"
+                       R"({"type": "LEAF", "vertices": [{"x": 0, "y": 0}, {"x": 10, "y": 0}], "radius": 6.5},)"
+                       R"({"type": "TRI_ARC", "vertices": [{"x": 20, "y": 0}, {"x": 30, "y": 0},)"
+                       R"( {"x": 25, "y": 8.66}], "curvatures": [-0.1, -0.15, -0.2]}]})";
+    {
+        std::ofstream out(path, std::ios::binary | std::ios::trunc);
+        out << gzipStored(json, 5);
+    }
+
+    // Image data is copied even when deferral is asked for: there is no decoded mapping to refer into
+    DesignParseOptions options;
+    options.deferBackgroundImageData = true;
+    DesignFile design = DesignParser::parseFromFile(path, options);
+    EXPECT_EQ(design.metadata.name.value(), "Packed");
+    ASSERT_EQ(design.shapes.size(), 2u);
+    EXPECT_NE(dynamic_cast<TriArc*>(design.shapes[1].get()), nullptr);
+    ASSERT_EQ(design.backgroundImages.size(), 1u);
+    EXPECT_FALSE(design.backgroundImages[0].hasDeferredImageData());
+    EXPECT_EQ(design.backgroundImages[0].imageData, "AB/CD\"EF");
+
+    RecordingHandler handler;
+    DesignParser::parseFromFile(path, DesignParseOptions(), handler);
+    std::vector<std::string> expected = {"image photo", "metadata Packed", "shape 0 leaf", "shape 1 triarc"};
+    EXPECT_EQ(handler.events, expected);
+
+    // A damaged stream and an unsupported compression format are reported as such
+    {
+        std::string corrupt = gzipStored(json, 5);
+        corrupt[corrupt.size() - 4] ^= 0x01;
+        std::ofstream out(path, std::ios::binary | std::ios::trunc);
+        out << corrupt;
+    }
+    try {
+        DesignParser::parseFromFile(path);
+        FAIL() << "Expected a gzip error";
+    } catch (const std::runtime_error& e) {
+        EXPECT_NE(std::string(e.what()).find("Corrupt gzip data"), std::string::npos) << e.what();
+    }
+    {
+        std::ofstream out(path, std::ios::binary | std::ios::trunc);
+        out << "\x28\xb5\x2f\xfd" << json;
+    }
+    try {
+        DesignParser::parseFromFile(path);
+        FAIL() << "Expected an unsupported format error";
+    } catch (const std::runtime_error& e) {
+        EXPECT_NE(std::string(e.what()).find("Zstandard"), std::string::npos) << e.what();
+    }
+    std::filesystem::remove(path);
+}
+
+TEST_F(DesignParserTest, ArenaAllocationBuildsTheSameShapes) {
+    DesignParseOptions options;
+    options.arenaAllocation = true;
+    DesignFile arenaDesign = DesignParser::parseFromString(mixedShapesJson, options);
+    DesignFile heapDesign = DesignParser::parseFromString(mixedShapesJson);
+
+    ASSERT_EQ(arenaDesign.shapes.size(), heapDesign.shapes.size());
+    ASSERT_NE(arenaDesign.shapes[0].get_deleter().arena, nullptr);
+    EXPECT_EQ(arenaDesign.shapes[0].get_deleter().arena, arenaDesign.shapes[1].get_deleter().arena);
+    EXPECT_EQ(arenaDesign.shapes[0].get_deleter().arena->blockCount(), 1u);
+    EXPECT_EQ(heapDesign.shapes[0].get_deleter().arena, nullptr);
+    for (size_t i = 0; i < heapDesign.shapes.size(); ++i) {
+        std::vector<Point2D> arenaVertices = arenaDesign.shapes[i]->getVertices();
+        std::vector<Point2D> heapVertices = heapDesign.shapes[i]->getVertices();
+        ASSERT_EQ(arenaVertices.size(), heapVertices.size());
+        for (size_t v = 0; v < heapVertices.size(); ++v) {
+            EXPECT_TRUE(arenaVertices[v].equals(heapVertices[v]));
+        }
+    }
+    EXPECT_NE(dynamic_cast<TriArc*>(arenaDesign.shapes[1].get()), nullptr);
+
+    // A shape taken out of the design keeps the arena alive after the design is gone
+    DesignShape kept = std::move(arenaDesign.shapes[1]);
+    arenaDesign = DesignFile();
+    EXPECT_NEAR(dynamic_cast<TriArc*>(kept.get())->getBulgeFactor(2), -0.2, 1e-9);
+}
+
+TEST_F(DesignParserTest, ArenaAllocationReportsTheInvalidShape) {
+    std::string json = R"({"version": "2.0", "shapes": [)"
+                       R"({"type": "LEAF", "vertices": [{"x": 0, "y": 0}, {"x": 10, "y": 0}], "radius": 6.5},)"
+                       R"({"type": "LEAF", "vertices": [{"x": 0, "y": 0}, {"x": 10, "y": 0}], "radius": -1}]})";
+    DesignParseOptions options;
+    options.arenaAllocation = true;
+    try {
+        DesignParser::parseFromString(json, options);
+        FAIL() << "Expected a shape error";
+    } catch (const std::runtime_error& e) {
+        EXPECT_NE(std::string(e.what()).find("Shape 1"), std::string::npos) << e.what();
+    }
+}
@@ -0,0 +1,237 @@
+/**
+ * Unit tests for JsonReader
+ */
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "parsers/JsonReader.h"
+
+using namespace ChipCarving::Parsers;
+
+namespace {
+
+// Message of the runtime_error thrown by fn, or "" if none
+template <typename Fn>
+std::string errorOf(Fn fn) {
+    try {
+        fn();
+    } catch (const std::runtime_error& e) {
+        return e.what();
+    }
+    return "";
+}
+
+// Hands out a document a few bytes at a time, so every token can straddle a chunk boundary
+class ChunkedInput : public JsonInput {
+   public:
+    ChunkedInput(std::string text, size_t chunkSize) : text_(std::move(text)), chunkSize_(chunkSize) {}
+
+    bool next(const char*& data, size_t& size) override {
+        if (position_ >= text_.size()) {
+            return false;
+        }
+        data = text_.data() + position_;
+        size = std::min(chunkSize_, text_.size() - position_);
+        position_ += size;
+        return true;
+    }
+
+   private:
+    std::string text_;
+    size_t chunkSize_;
+    size_t position_ = 0;
+};
+
+}  // namespace
+
+TEST(JsonReaderTest, WalksNestedObjectsAndArrays) {
+    std::string json = R"({"a": 1.5, "list": [1, -2e3, 0.25], "nested": {"flag": true, "none": null}})";
+    JsonReader reader(json);
+    std::string key;
+    std::vector<std::string> keys;
+    std::vector<double> list;
+    double a = 0.0;
+    bool flag = false;
+
+    reader.beginObject();
+    while (reader.nextMember(key)) {
+        keys.push_back(key);
+        if (key == "a") {
+            a = reader.readNumber();
+        } else if (key == "list") {
+            reader.beginArray();
+            while (reader.nextElement()) {
+                list.push_back(reader.readNumber());
+            }
+        } else {
+            reader.beginObject();
+            while (reader.nextMember(key)) {
+                if (key == "flag") {
+                    flag = reader.readBoolean();
+                } else {
+                    reader.readNull();
+                }
+            }
+        }
+    }
+    reader.expectEnd();
+
+    EXPECT_EQ(keys, (std::vector<std::string>{"a", "list", "nested"}));
+    EXPECT_DOUBLE_EQ(a, 1.5);
+    EXPECT_EQ(list, (std::vector<double>{1.0, -2000.0, 0.25}));
+    EXPECT_TRUE(flag);
+}
+
+TEST(JsonReaderTest, DecodesStringEscapes) {
+    std::string json = R"(["line\nbreak \"quoted\" \\ \/", "é€", "😀"])";
+    JsonReader reader(json);
+    reader.beginArray();
+    ASSERT_TRUE(reader.nextElement());
+    EXPECT_EQ(reader.readString(), "line\nbreak \"quoted\" \\ /");
+    ASSERT_TRUE(reader.nextElement());
+    EXPECT_EQ(reader.readString(), "\xC3\xA9\xE2\x82\xAC");
+    ASSERT_TRUE(reader.nextElement());
+    EXPECT_EQ(reader.readString(), "\xF0\x9F\x98\x80");
+    EXPECT_FALSE(reader.nextElement());
+}
+
+TEST(JsonReaderTest, SkipValueConsumesWholeSubtree) {
+    std::string json = R"({"skip": {"deep": [[1, 2], {"x": "}"}]}, "keep": 7})";
+    JsonReader reader(json);
+    std::string key;
+    double keep = 0.0;
+    reader.beginObject();
+    while (reader.nextMember(key)) {
+        if (key == "keep") {
+            keep = reader.readNumber();
+        } else {
+            reader.skipValue();
+        }
+    }
+    EXPECT_DOUBLE_EQ(keep, 7.0);
+}
+
+TEST(JsonReaderTest, ReadPointRequiresBothCoordinates) {
+    std::string validJson = R"({"y": 2, "z": 9, "x": -1})";
+    JsonReader valid(validJson);
+    auto point = readPoint(valid);
+    EXPECT_DOUBLE_EQ(point.x, -1.0);
+    EXPECT_DOUBLE_EQ(point.y, 2.0);
+
+    std::string missingYJson = R"({"x": 1})";
+    JsonReader missingY(missingYJson);
+    EXPECT_THROW(readPoint(missingY), std::runtime_error);
+}
+
+TEST(JsonReaderTest, ErrorsReportLineAndColumn) {
+    std::string message = errorOf([] {
+        std::string json = "{\n  \"a\": 1\n  \"b\": 2\n}";
+        JsonReader reader(json);
+        std::string key;
+        reader.beginObject();
+        while (reader.nextMember(key)) {
+            reader.readNumber();
+        }
+    });
+    EXPECT_NE(message.find("line 3, column 3"), std::string::npos) << message;
+    EXPECT_NE(message.find("expected ',' or '}'"), std::string::npos) << message;
+}
+
+TEST(JsonReaderTest, RejectsMalformedInput) {
+    auto skipAll = [](const std::string& text) {
+        JsonReader reader(text);
+        reader.skipValue();
+        reader.expectEnd();
+    };
+
+    EXPECT_THROW(skipAll("{type: 1}"), std::runtime_error);
+    EXPECT_THROW(skipAll(R"({"a": 1,})"), std::runtime_error);
+    EXPECT_THROW(skipAll("[1, 2"), std::runtime_error);
+    EXPECT_THROW(skipAll(R"("unterminated)"), std::runtime_error);
+    EXPECT_THROW(skipAll("1e"), std::runtime_error);
+    EXPECT_THROW(skipAll("tru"), std::runtime_error);
+    EXPECT_THROW(skipAll("{} extra"), std::runtime_error);
+    EXPECT_NO_THROW(skipAll(" [ ] "));
+}
+
+TEST(JsonReaderTest, DoesNotReadPastBufferEnd) {
+    // Only the first three characters belong to the document
+    std::string text = "123456";
+    JsonReader reader(text.data(), 3);
+    EXPECT_DOUBLE_EQ(reader.readNumber(), 123.0);
+    EXPECT_NO_THROW(reader.expectEnd());
+}
+
+TEST(JsonReaderTest, SkipStringReportsRawTokenBounds) {
+    std::string json = R"(["a\"b\\", "next"])";
+    JsonReader reader(json);
+    size_t offset = 0;
+    size_t length = 0;
+    reader.beginArray();
+    ASSERT_TRUE(reader.nextElement());
+    reader.skipString(offset, length);
+    EXPECT_EQ(json.substr(offset, length), R"("a\"b\\")");
+    ASSERT_TRUE(reader.nextElement());
+    EXPECT_EQ(reader.readString(), "next");
+    EXPECT_FALSE(reader.nextElement());
+
+    JsonReader token(json.data() + offset, length);
+    EXPECT_EQ(token.readString(), "a\"b\\");
+}
+
+TEST(JsonReaderTest, ReadsChunkedInputAcrossTokenBoundaries) {
+    std::string json = R"({"name": "a\"b\u00e9", "skip": "x\\\"y\\", "values": [12.5, -3e2, true, null]})";
+    for (size_t chunkSize : {1u, 2u, 3u, 7u}) {
+        ChunkedInput input(json, chunkSize);
+        JsonReader reader(input);
+        std::string key;
+        reader.beginObject();
+        ASSERT_TRUE(reader.nextMember(key));
+        EXPECT_EQ(reader.readString(), "a\"b\xc3\xa9");
+        ASSERT_TRUE(reader.nextMember(key));
+        size_t offset = 0;
+        size_t length = 0;
+        reader.skipString(offset, length);
+        EXPECT_EQ(json.substr(offset, length), R"("x\\\"y\\")") << "chunk size " << chunkSize;
+        ASSERT_TRUE(reader.nextMember(key));
+        EXPECT_EQ(key, "values");
+        reader.beginArray();
+        ASSERT_TRUE(reader.nextElement());
+        EXPECT_DOUBLE_EQ(reader.readNumber(), 12.5);
+        ASSERT_TRUE(reader.nextElement());
+        EXPECT_DOUBLE_EQ(reader.readNumber(), -300.0);
+        ASSERT_TRUE(reader.nextElement());
+        EXPECT_TRUE(reader.readBoolean());
+        ASSERT_TRUE(reader.nextElement());
+        reader.readNull();
+        EXPECT_FALSE(reader.nextElement());
+        EXPECT_FALSE(reader.nextMember(key));
+        EXPECT_NO_THROW(reader.expectEnd());
+        EXPECT_EQ(reader.offset(), json.size());
+    }
+}
+
+TEST(JsonReaderTest, ChunkedInputErrorsReportDocumentLineAndColumn) {
+    ChunkedInput input("{\n  \"a\": 1,\n  \"b\": x\n}", 2);
+    JsonReader reader(input);
+    std::string key;
+    reader.beginObject();
+    ASSERT_TRUE(reader.nextMember(key));
+    reader.readNumber();
+    ASSERT_TRUE(reader.nextMember(key));
+    EXPECT_EQ(errorOf([&] { reader.readNumber(); }), "JSON error at line 3, column 8: unexpected character 'x'");
+
+    ChunkedInput unterminated(R"(["abc)", 2);
+    JsonReader truncated(unterminated);
+    truncated.beginArray();
+    ASSERT_TRUE(truncated.nextElement());
+    size_t offset = 0;
+    size_t length = 0;
+    EXPECT_NE(errorOf([&] { truncated.skipString(offset, length); }).find("unterminated string"), std::string::npos);
+}
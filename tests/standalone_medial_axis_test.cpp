@@ -4,11 +4,19 @@
  *
  * This program verifies the medial axis computation outside of Fusion 360,
  * generating visual outputs for verification and truth file comparison.
+ *
+ * Usage: standalone_medial_axis_test [--bench [--warmup N] [--repeat N]]
+ *   --bench   Repeat each fixture after warm-up runs and print JSON with the
+ *             median and p95 time per stage instead of writing SVGs
  */
 
 #include <algorithm>
+#include <chrono>
 #include <cmath>
+#include <cstdlib>
+#include <cstring>
 #include <fstream>
+#include <functional>
 #include <iomanip>
 #include <iostream>
 #include <limits>
@@ -62,6 +70,22 @@ struct MedialAxisResults {
     double maxClearance = 0.0;
 };
 
+/**
+ * Wall-clock times of the stages inside computeMedialAxis
+ */
+struct StageTimes {
+    double voronoiMs = 0.0;     // Site insertion and diagram check
+    double medialAxisMs = 0.0;  // Filters, walk, edge subdivision and conversion to world coordinates
+};
+
+// Progress output of computeMedialAxis; --bench discards it so it stays out of the timings
+std::ostream nullStream(nullptr);
+std::ostream* progress = &std::cout;
+
+double millisecondsSince(std::chrono::steady_clock::time_point start) {
+    return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+}
+
 /**
  * Transform polygon from world coordinates to unit circle
  */
@@ -117,7 +141,8 @@ Point2D transformFromUnitCircle(const Point2D& unitPoint, const TransformParams&
 /**
  * Compute medial axis using OpenVoronoi
  */
-MedialAxisResults computeMedialAxis(const std::vector<Point2D>& polygon, double threshold = 0.8) {
+MedialAxisResults computeMedialAxis(const std::vector<Point2D>& polygon, double threshold = 0.8,
+                                    StageTimes* times = nullptr) {
     MedialAxisResults results;
 
     if (polygon.size() < 3) {
@@ -128,19 +153,20 @@ MedialAxisResults computeMedialAxis(const std::vector<Point2D>& polygon, double
     // Transform to unit circle
     std::vector<Point2D> transformedPolygon = transformToUnitCircle(polygon, results.transform);
 
-    std::cout << "Original bounds: (" << results.transform.originalMin.x << ", "
+    (*progress) << "Original bounds: (" << results.transform.originalMin.x << ", "
               << results.transform.originalMin.y << ") to (" << results.transform.originalMax.x
               << ", " << results.transform.originalMax.y << ")" << std::endl;
-    std::cout << "Transform: offset=(" << results.transform.offset.x << ", "
+    (*progress) << "Transform: offset=(" << results.transform.offset.x << ", "
               << results.transform.offset.y << "), scale=" << results.transform.scale << std::endl;
 
     // Create VoronoiDiagram
+    auto stageStart = std::chrono::steady_clock::now();
     int numSites = static_cast<int>(transformedPolygon.size());
     int bins = std::max(10, static_cast<int>(std::sqrt(numSites)));
     ovd::VoronoiDiagram* vd = new ovd::VoronoiDiagram(1.0, bins);
 
-    std::cout << "OpenVoronoi version: " << ovd::version() << std::endl;
-    std::cout << "Processing polygon with " << numSites << " vertices, using " << bins << " bins"
+    (*progress) << "OpenVoronoi version: " << ovd::version() << std::endl;
+    (*progress) << "Processing polygon with " << numSites << " vertices, using " << bins << " bins"
               << std::endl;
 
     // Insert point sites
@@ -151,7 +177,7 @@ MedialAxisResults computeMedialAxis(const std::vector<Point2D>& polygon, double
         ovd::Point ovdPoint(point.x, point.y);
         int id = vd->insert_point_site(ovdPoint);
         pointIds.push_back(id);
-        std::cout << "Added point " << id << ": (" << point.x << ", " << point.y << ")"
+        (*progress) << "Added point " << id << ": (" << point.x << ", " << point.y << ")"
                   << std::endl;
     }
 
@@ -160,7 +186,7 @@ MedialAxisResults computeMedialAxis(const std::vector<Point2D>& polygon, double
         int startId = pointIds[i];
         int endId = pointIds[(i + 1) % pointIds.size()];
         vd->insert_line_site(startId, endId);
-        std::cout << "Added line site: " << startId << " -> " << endId << std::endl;
+        (*progress) << "Added line site: " << startId << " -> " << endId << std::endl;
     }
 
     // Validate the diagram
@@ -169,6 +195,11 @@ MedialAxisResults computeMedialAxis(const std::vector<Point2D>& polygon, double
         std::cerr << "Warning: Voronoi diagram validation failed" << std::endl;
     }
 
+    if (times) {
+        times->voronoiMs = millisecondsSince(stageStart);
+    }
+    stageStart = std::chrono::steady_clock::now();
+
     // Apply filters
     ovd::polygon_interior_filter interiorFilter(true);
     vd->filter(&interiorFilter);
@@ -194,13 +225,13 @@ MedialAxisResults computeMedialAxis(const std::vector<Point2D>& polygon, double
                 // Calculate distance between endpoints
                 double edgeLength = sqrt(pow(p2.p.x - p1.p.x, 2) + pow(p2.p.y - p1.p.y, 2));
 
-                std::cout << "  Found 2-point edge: length=" << edgeLength << "mm from (" << p1.p.x
+                (*progress) << "  Found 2-point edge: length=" << edgeLength << "mm from (" << p1.p.x
                           << "," << p1.p.y << ") to (" << p2.p.x << "," << p2.p.y << ")"
                           << std::endl;
 
                 // If edge is long enough, subdivide it
                 if (edgeLength > 1.0) {  // More than 1mm, add intermediate points
-                    std::cout << "    Subdividing edge of length " << edgeLength << "mm"
+                    (*progress) << "    Subdividing edge of length " << edgeLength << "mm"
                               << std::endl;
                     std::list<ovd::MedialPoint> newPoints;
                     newPoints.push_back(p1);  // Keep start point
@@ -230,7 +261,7 @@ MedialAxisResults computeMedialAxis(const std::vector<Point2D>& polygon, double
         }
     }
 
-    std::cout << "Found " << chainList.size() << " medial axis chains" << std::endl;
+    (*progress) << "Found " << chainList.size() << " medial axis chains" << std::endl;
 
     // Convert results back to world coordinates
     results.numChains = static_cast<int>(chainList.size());
@@ -259,7 +290,7 @@ MedialAxisResults computeMedialAxis(const std::vector<Point2D>& polygon, double
 
                 // Debug output for first few points only
                 if (results.totalPoints <= 3) {
-                    std::cout << "Medial point: (" << worldPoint.x << ", " << worldPoint.y
+                    (*progress) << "Medial point: (" << worldPoint.x << ", " << worldPoint.y
                               << "), clearance: " << worldClearance << std::endl;
                 }
             }
@@ -281,11 +312,15 @@ MedialAxisResults computeMedialAxis(const std::vector<Point2D>& polygon, double
     // Clean up
     delete vd;
 
-    std::cout << "Medial axis computation complete:" << std::endl;
-    std::cout << "  Chains: " << results.numChains << std::endl;
-    std::cout << "  Total points: " << results.totalPoints << std::endl;
-    std::cout << "  Total length: " << results.totalLength << std::endl;
-    std::cout << "  Clearance range: [" << results.minClearance << ", " << results.maxClearance
+    if (times) {
+        times->medialAxisMs = millisecondsSince(stageStart);
+    }
+
+    (*progress) << "Medial axis computation complete:" << std::endl;
+    (*progress) << "  Chains: " << results.numChains << std::endl;
+    (*progress) << "  Total points: " << results.totalPoints << std::endl;
+    (*progress) << "  Total length: " << results.totalLength << std::endl;
+    (*progress) << "  Clearance range: [" << results.minClearance << ", " << results.maxClearance
               << "]" << std::endl;
 
     return results;
@@ -495,39 +530,152 @@ void testShape(const std::string& testName, std::unique_ptr<Shape> shape, double
     std::cout << "Test " << testName << " completed successfully" << std::endl;
 }
 
+/**
+ * A shape with the polygonization and filter settings it is tested at
+ */
+struct Fixture {
+    std::string name;
+    std::function<std::unique_ptr<Shape>()> makeShape;
+    double maxError;
+    double threshold;
+};
+
+std::vector<Fixture> fixtures() {
+    std::vector<Fixture> result;
+
+    // Test Case 1: Simple horizontal leaf
+    result.push_back({"leaf_horizontal",
+                      [] { return std::make_unique<Leaf>(Point2D(0.0, 0.0), Point2D(10.0, 0.0), 6.5); },
+                      0.25, 0.8});
+
+    // Test Case 2: Simple triangle (approximately equilateral); lower threshold for more branches
+    result.push_back({"triangle_curved",
+                      [] {
+                          std::array<double, 3> bulges = {-0.125, -0.125, -0.125};
+                          return std::make_unique<TriArc>(Point2D(0.0, 0.0), Point2D(10.0, 0.0),
+                                                          Point2D(5.0, 8.66), bulges);
+                      },
+                      0.25, 0.6});
+
+    // Test Case 3: Leaf with finer error tolerance
+    result.push_back({"leaf_fine_tolerance",
+                      [] { return std::make_unique<Leaf>(Point2D(-5.0, 0.0), Point2D(5.0, 0.0), 8.0); },
+                      0.1, 0.8});
+
+    return result;
+}
+
+/**
+ * Median and 95th percentile (nearest rank) of a stage's samples
+ */
+void writeStageJson(std::ostream& out, const char* stage, std::vector<double> samples, bool last) {
+    std::sort(samples.begin(), samples.end());
+    size_t n = samples.size();
+    double median = n % 2 ? samples[n / 2] : 0.5 * (samples[n / 2 - 1] + samples[n / 2]);
+    size_t rank = static_cast<size_t>(std::ceil(0.95 * static_cast<double>(n)));
+    double p95 = samples[std::max<size_t>(rank, 1) - 1];
+    out << "        \"" << stage << "\": {\"median_ms\": " << median << ", \"p95_ms\": " << p95 << "}"
+        << (last ? "\n" : ",\n");
+}
+
+/**
+ * Time every fixture and print the results as JSON on stdout
+ */
+int runBenchmark(int warmup, int repeat) {
+    progress = &nullStream;
+    std::ostream& out = std::cout;
+    out << std::setprecision(6);
+    out << "{\n  \"openvoronoi_version\": \"" << ovd::version() << "\",\n";
+    out << "  \"warmup\": " << warmup << ",\n  \"repeat\": " << repeat << ",\n";
+    out << "  \"fixtures\": [\n";
+
+    std::vector<Fixture> all = fixtures();
+    for (size_t f = 0; f < all.size(); ++f) {
+        const Fixture& fixture = all[f];
+        std::unique_ptr<Shape> shape = fixture.makeShape();
+        std::vector<double> polygonizeMs, voronoiMs, medialAxisMs, samplingMs, totalMs;
+        size_t vertices = 0;
+        size_t sampledPoints = 0;
+        MedialAxisResults results;
+
+        for (int run = 0; run < warmup + repeat; ++run) {
+            auto start = std::chrono::steady_clock::now();
+            std::vector<Point2D> polygon = shape->getPolygonVertices(fixture.maxError);
+            double polygonize = millisecondsSince(start);
+
+            StageTimes times;
+            results = computeMedialAxis(polygon, fixture.threshold, &times);
+
+            auto samplingStart = std::chrono::steady_clock::now();
+            std::vector<SampledMedialPath> sampledPaths =
+                sampleMedialAxisPaths(results.chains, results.clearanceRadii, 1.0);  // As the SVG uses
+            double sampling = millisecondsSince(samplingStart);
+            double total = millisecondsSince(start);
+
+            vertices = polygon.size();
+            sampledPoints = 0;
+            for (const auto& path : sampledPaths) {
+                sampledPoints += path.points.size();
+            }
+            if (run < warmup) {
+                continue;
+            }
+            polygonizeMs.push_back(polygonize);
+            voronoiMs.push_back(times.voronoiMs);
+            medialAxisMs.push_back(times.medialAxisMs);
+            samplingMs.push_back(sampling);
+            totalMs.push_back(total);
+        }
+
+        out << "    {\n      \"name\": \"" << fixture.name << "\",\n";
+        out << "      \"max_error\": " << fixture.maxError << ",\n";
+        out << "      \"threshold\": " << fixture.threshold << ",\n";
+        out << "      \"vertices\": " << vertices << ",\n";
+        out << "      \"chains\": " << results.numChains << ",\n";
+        out << "      \"medial_points\": " << results.totalPoints << ",\n";
+        out << "      \"sampled_points\": " << sampledPoints << ",\n";
+        out << "      \"stages\": {\n";
+        writeStageJson(out, "polygonize", polygonizeMs, false);
+        writeStageJson(out, "voronoi", voronoiMs, false);
+        writeStageJson(out, "medial_axis", medialAxisMs, false);
+        writeStageJson(out, "sampling", samplingMs, false);
+        writeStageJson(out, "total", totalMs, true);
+        out << "      }\n    }" << (f + 1 < all.size() ? ",\n" : "\n");
+    }
+    out << "  ]\n}" << std::endl;
+    return 0;
+}
+
 /**
  * Main test program
  */
-int main() {
-    std::cout << "Standalone Medial Axis Test Program" << std::endl;
-    std::cout << "====================================" << std::endl;
+int main(int argc, char** argv) {
+    bool bench = false;
+    int warmup = 3;
+    int repeat = 20;
+    for (int i = 1; i < argc; ++i) {
+        if (std::strcmp(argv[i], "--bench") == 0) {
+            bench = true;
+        } else if (std::strcmp(argv[i], "--warmup") == 0 && i + 1 < argc) {
+            warmup = std::max(0, std::atoi(argv[++i]));
+        } else if (std::strcmp(argv[i], "--repeat") == 0 && i + 1 < argc) {
+            repeat = std::max(1, std::atoi(argv[++i]));
+        } else {
+            std::cerr << "Usage: " << argv[0] << " [--bench [--warmup N] [--repeat N]]" << std::endl;
+            return 2;
+        }
+    }
 
     try {
-        // Test Case 1: Simple horizontal leaf
-        {
-            Point2D focus1(0.0, 0.0);
-            Point2D focus2(10.0, 0.0);
-            auto leaf = std::make_unique<Leaf>(focus1, focus2, 6.5);
-            testShape("leaf_horizontal", std::move(leaf));
+        if (bench) {
+            return runBenchmark(warmup, repeat);
         }
 
-        // Test Case 2: Simple triangle
-        {
-            Point2D v1(0.0, 0.0);
-            Point2D v2(10.0, 0.0);
-            Point2D v3(5.0, 8.66);  // Approximately equilateral triangle
-            std::array<double, 3> bulges = {-0.125, -0.125, -0.125};
-            auto triangle = std::make_unique<TriArc>(v1, v2, v3, bulges);
-            testShape("triangle_curved", std::move(triangle), 0.25,
-                      0.6);  // Lower threshold for more branches
-        }
+        std::cout << "Standalone Medial Axis Test Program" << std::endl;
+        std::cout << "====================================" << std::endl;
 
-        // Test Case 3: Leaf with different error tolerance
-        {
-            Point2D focus1(-5.0, 0.0);
-            Point2D focus2(5.0, 0.0);
-            auto leaf = std::make_unique<Leaf>(focus1, focus2, 8.0);
-            testShape("leaf_fine_tolerance", std::move(leaf), 0.1);  // Finer tolerance
+        for (const Fixture& fixture : fixtures()) {
+            testShape(fixture.name, fixture.makeShape(), fixture.maxError, fixture.threshold);
         }
 
         std::cout << "\nAll tests completed successfully!" << std::endl;
@@ -538,4 +686,4 @@ int main() {
     }
 
     return 0;
-}
\ No newline at end of file
+}
@@ -8,6 +8,7 @@
 
 #include <filesystem>
 #include <fstream>
+#include <regex>
 #include <sstream>
 
 #include "geometry/Leaf.h"
@@ -365,6 +366,50 @@ TEST_F(SVGGeneratorTest, SaveToFileOverwritesExistingFile) {
     EXPECT_FALSE(containsElement(content, "fill=\"red\""));
 }
 
+TEST_F(SVGGeneratorTest, StreamingWritesTheSameDocument) {
+    SVGGenerator buffered;
+    SVGGenerator streamed;
+    std::string filename = getTestFilePath("streamed.svg");
+    ASSERT_TRUE(streamed.streamToFile(filename));
+
+    // Enough elements to flush the stream buffer several times
+    for (SVGGenerator* generator : {&buffered, &streamed}) {
+        generator->setBounds(Point2D(-20, -20), Point2D(20, 20));
+        for (int i = 0; i < 2000; ++i) {
+            generator->addCircle(Point2D(i * 0.013, -i * 0.007), 0.5 + i * 1e-4, "blue", 0.25);
+            generator->addLeaf(*leafShape_);
+        }
+    }
+    EXPECT_TRUE(streamed.generate().empty());
+    EXPECT_FALSE(streamed.saveToFile(getTestFilePath("unused.svg")));
+    ASSERT_TRUE(streamed.finishStream());
+    EXPECT_FALSE(streamed.finishStream());
+
+    std::ifstream file(filename);
+    std::string content((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+    EXPECT_GT(content.size(), 4 * SVGWriter::STREAM_BUFFER_BYTES);
+    EXPECT_EQ(content, buffered.generate());
+}
+
+TEST_F(SVGGeneratorTest, StreamingToInvalidPathKeepsBuffering) {
+    SVGGenerator generator;
+    EXPECT_FALSE(generator.streamToFile("/nonexistent/directory/test.svg"));
+    generator.addPoint(Point2D(0, 0), "red");
+    EXPECT_TRUE(containsElement(generator.generate(), "fill=\"red\""));
+}
+
+TEST_F(SVGGeneratorTest, FixedFormattingMatchesPrintf) {
+    const double values[] = {0.0,     -0.0,     0.0625, 0.0015,   -0.0004,  1.0005,  123.4565,
+                             -99.9999, 400.0,   1e14,   -3.14159, 2.6745,   1e20,    0.1 + 0.2};
+    for (double value : values) {
+        std::string formatted;
+        SVGWriter::appendFixed(formatted, value);
+        char expected[64];
+        std::snprintf(expected, sizeof(expected), "%.3f", value);
+        EXPECT_EQ(formatted, expected) << value;
+    }
+}
+
 // ===============================
 // SVGComparator Tests
 // ===============================
@@ -436,6 +481,33 @@ TEST_F(SVGGeneratorTest, SVGComparatorCompareDifferentFiles) {
     EXPECT_FALSE(SVGComparator::compare(file1, file2));
 }
 
+TEST_F(SVGGeneratorTest, SVGComparatorTokenizesLikeTheNumberRegex) {
+    // Numbers glued to names, signs, bare dots and exponents without digits
+    std::string text = R"(<line x1="-.5" y1="+3" stroke="#f0f0f0"/> 5.e3 7e 1.5e-3 -x 2E+2 12.3.4 0.000001)";
+    std::vector<double> expected;
+    std::regex numberRegex(R"([-+]?[0-9]*\.?[0-9]+([eE][-+]?[0-9]+)?)");
+    for (std::sregex_iterator it(text.begin(), text.end(), numberRegex), end; it != end; ++it) {
+        expected.push_back(std::stod(it->str()));
+    }
+
+    std::vector<double> numbers = SVGComparator::extractNumbers(text);
+    ASSERT_EQ(numbers.size(), expected.size());
+    for (size_t i = 0; i < numbers.size(); ++i) {
+        EXPECT_EQ(numbers[i], expected[i]) << "number " << i;  // Exact, not just within tolerance
+    }
+}
+
+TEST_F(SVGGeneratorTest, SVGComparatorContentStopsAtFirstDifference) {
+    std::string first = "M 1.000 2.000 L 3.000 4.000";
+    std::string second = "M 1.0004 2.000 L 3.000 4.000";
+    EXPECT_TRUE(SVGComparator::compareContent(first.data(), first.size(), second.data(), second.size(), 1e-3));
+    EXPECT_FALSE(SVGComparator::compareContent(first.data(), first.size(), second.data(), second.size(), 1e-4));
+
+    // One text running out of numbers first is a difference
+    std::string shorter = "M 1.000 2.000 L 3.000";
+    EXPECT_FALSE(SVGComparator::compareContent(first.data(), first.size(), shorter.data(), shorter.size(), 1.0));
+}
+
 // ===============================
 // Edge Cases and Integration Tests
 // ===============================
@@ -8,10 +8,13 @@
 
 #include <memory>
 #include <stdexcept>
+#include <string>
+#include <vector>
 
 #include "geometry/Leaf.h"
 #include "geometry/ShapeFactory.h"
 #include "geometry/TriArc.h"
+#include "parsers/JsonReader.h"
 #include "adapters/MockAdapters.h"
 
 using namespace ChipCarving::Geometry;
@@ -389,3 +392,76 @@ TEST_F(ShapeFactoryTest, CreateShapeHandlesJsonWithExtraWhitespace) {
     EXPECT_DOUBLE_EQ(leaf->getRadius(), 7.5);
 }
 
+
+// ===============================
+// Bulk Construction Tests
+// ===============================
+
+TEST_F(ShapeFactoryTest, CreateShapesKeepsSpecOrderOnWorkerThreads) {
+    std::vector<ShapeSpec> specs;
+    for (int i = 0; i < 2000; ++i) {
+        ShapeSpec spec;
+        if (i % 2 == 0) {
+            spec.type = "LEAF";
+            spec.vertices = {Point2D(i, 0), Point2D(i + 10.0, 0)};
+            spec.radius = 6.5;
+        } else {
+            spec.type = "TRI_ARC";
+            spec.vertices = {Point2D(i, 0), Point2D(i + 10.0, 0), Point2D(i + 5.0, 8)};
+            spec.curvatures = {-0.1, -0.1, -0.1};
+        }
+        specs.push_back(spec);
+    }
+
+    auto shapes = ShapeFactory::createShapes(specs, 4, mockLogger.get());
+
+    ASSERT_EQ(shapes.size(), specs.size());
+    for (size_t i = 0; i < shapes.size(); ++i) {
+        ASSERT_NE(shapes[i], nullptr);
+        EXPECT_TRUE(shapes[i]->getVertices()[0].equals(specs[i].vertices[0]));
+    }
+
+    // Arc parameters are derived once at construction and match a fresh shape
+    auto* triArc = dynamic_cast<TriArc*>(shapes[1].get());
+    ASSERT_NE(triArc, nullptr);
+    TriArc fresh(specs[1].vertices[0], specs[1].vertices[1], specs[1].vertices[2], {-0.1, -0.1, -0.1});
+    for (int i = 0; i < 3; ++i) {
+        EXPECT_DOUBLE_EQ(triArc->getArcParameters(i).radius, fresh.getArcParameters()[i].radius);
+        EXPECT_DOUBLE_EQ(triArc->getArcParameters(i).startAngle, fresh.getArcParameters()[i].startAngle);
+    }
+    EXPECT_TRUE(triArc->hasValidBulgeFactors());
+}
+
+TEST_F(ShapeFactoryTest, CreateShapesReportsFirstInvalidSpec) {
+    std::vector<ShapeSpec> specs(600);
+    for (auto& spec : specs) {
+        spec.type = "LEAF";
+        spec.vertices = {Point2D(0, 0), Point2D(10, 0)};
+        spec.radius = 6.5;
+    }
+    specs[400].radius = 1.0;  // Below half the chord length
+    specs[500].vertices.pop_back();
+
+    try {
+        ShapeFactory::createShapes(specs, 3);
+        FAIL() << "Expected an invalid shape error";
+    } catch (const std::runtime_error& e) {
+        EXPECT_EQ(std::string(e.what()).rfind("Shape 400: Leaf radius", 0), 0u) << e.what();
+    }
+}
+
+TEST_F(ShapeFactoryTest, ReadSpecThenCreateMatchesCreateFromJson) {
+    std::string triArcJson =
+        R"({"type":"TRI_ARC","vertices":[{"x":0,"y":0},{"x":10,"y":0},{"x":5,"y":8}],"curvatures":[-0.1,0,-0.2]})";
+
+    ChipCarving::Parsers::JsonReader reader(triArcJson);
+    ShapeSpec spec = ShapeFactory::readSpec(reader);
+    EXPECT_EQ(spec.type, "TRI_ARC");
+    ASSERT_EQ(spec.curvatures.size(), 3u);
+
+    auto shape = ShapeFactory::createFromSpec(spec);
+    auto* triArc = dynamic_cast<TriArc*>(shape.get());
+    ASSERT_NE(triArc, nullptr);
+    EXPECT_TRUE(triArc->isEdgeStraight(1));
+    EXPECT_DOUBLE_EQ(triArc->getArcParameters(1).radius, 0.0);  // Straight edges keep default parameters
+}
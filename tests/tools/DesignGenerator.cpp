@@ -0,0 +1,226 @@
+/**
+ * DesignGenerator.cpp
+ *
+ * Pattern layouts and JSON emission for the synthetic design generator
+ */
+
+#include "DesignGenerator.h"
+
+#include <algorithm>
+#include <cmath>
+#include <fstream>
+#include <iomanip>
+#include <random>
+#include <sstream>
+#include <stdexcept>
+#include <vector>
+
+#include "parsers/JsonReader.h"
+
+namespace ChipCarving {
+namespace Testing {
+
+namespace {
+
+// Border pattern: at most this many concentric laps around the frame
+const int BORDER_MAX_LAPS = 4;
+
+const double LEAF_RADIUS_MARGIN = 1e-8;
+
+struct Placement {
+    double x;
+    double y;
+    double angle;  // Leaf axis / TriArc rotation (radians)
+};
+
+std::vector<Placement> gridPlacements(int count, double pitch) {
+    int columns = std::max(1, static_cast<int>(std::ceil(std::sqrt(static_cast<double>(count)))));
+    std::vector<Placement> placements;
+    placements.reserve(count);
+    for (int i = 0; i < count; ++i) {
+        placements.push_back({pitch * (i % columns), pitch * (i / columns), 0.0});
+    }
+    return placements;
+}
+
+// Concentric rings around the origin, shapes pointing outwards
+std::vector<Placement> rosettePlacements(int count, double pitch) {
+    std::vector<Placement> placements;
+    placements.reserve(count);
+    placements.push_back({0.0, 0.0, 0.0});
+    for (int ring = 1; static_cast<int>(placements.size()) < count; ++ring) {
+        double radius = ring * pitch;
+        int slots = static_cast<int>(std::floor(2.0 * M_PI * radius / pitch));
+        for (int i = 0; i < slots && static_cast<int>(placements.size()) < count; ++i) {
+            double theta = 2.0 * M_PI * i / slots;
+            placements.push_back({radius * std::cos(theta), radius * std::sin(theta), theta});
+        }
+    }
+    return placements;
+}
+
+// Cells of a square frame, outermost lap first, shapes aligned with the edge
+std::vector<Placement> borderPlacements(int count, double pitch) {
+    auto capacity = [](int side) {
+        int cells = 0;
+        for (int lap = 0; lap < BORDER_MAX_LAPS && side - 2 * lap >= 2; ++lap) {
+            cells += 4 * (side - 2 * lap - 1);
+        }
+        return cells;
+    };
+    int side = 2;
+    while (capacity(side) < count) {
+        ++side;
+    }
+
+    std::vector<Placement> placements;
+    placements.reserve(count);
+    for (int lap = 0; lap < BORDER_MAX_LAPS && static_cast<int>(placements.size()) < count; ++lap) {
+        int cells = side - 2 * lap - 1;  // Cells per edge, corners owned by the edge they start
+        double lo = lap * pitch;
+        double hi = (side - 1 - lap) * pitch;
+        const double starts[4][2] = {{lo, lo}, {hi, lo}, {hi, hi}, {lo, hi}};
+        for (int edge = 0; edge < 4; ++edge) {
+            double angle = edge * M_PI / 2.0;
+            for (int i = 0; i < cells && static_cast<int>(placements.size()) < count; ++i) {
+                placements.push_back({starts[edge][0] + i * pitch * std::cos(angle),
+                                      starts[edge][1] + i * pitch * std::sin(angle), angle});
+            }
+        }
+    }
+    return placements;
+}
+
+void writePoint(std::ostringstream& out, double x, double y) {
+    out << "{\"x\": " << x << ", \"y\": " << y << "}";
+}
+
+}  // namespace
+
+ShapeRanges loadShapeRanges(const std::string& constantsPath) {
+    std::ifstream in(constantsPath);
+    if (!in) {
+        throw std::runtime_error("Failed to open constants file: " + constantsPath);
+    }
+    std::stringstream buffer;
+    buffer << in.rdbuf();
+    std::string text = buffer.str();
+
+    ShapeRanges ranges;
+    Parsers::JsonReader reader(text);
+    std::string key;
+    reader.beginObject();
+    while (reader.nextMember(key)) {
+        if (key != "geometry") {
+            reader.skipValue();
+            continue;
+        }
+        std::string group;
+        reader.beginObject();
+        while (reader.nextMember(group)) {
+            if (group != "arc" && group != "triarc") {
+                reader.skipValue();
+                continue;
+            }
+            reader.beginObject();
+            while (reader.nextMember(key)) {
+                if (key == "minSagittaRatio") {
+                    ranges.minSagittaRatio = reader.readNumber();
+                } else if (key == "maxSagittaRatio") {
+                    ranges.maxSagittaRatio = reader.readNumber();
+                } else if (key == "bulgeRangeMin") {
+                    ranges.bulgeMin = reader.readNumber();
+                } else if (key == "bulgeRangeMax") {
+                    ranges.bulgeMax = reader.readNumber();
+                } else {
+                    reader.skipValue();
+                }
+            }
+        }
+    }
+    reader.expectEnd();
+
+    if (ranges.minSagittaRatio <= 0.0 || ranges.minSagittaRatio > ranges.maxSagittaRatio ||
+        ranges.maxSagittaRatio > 0.5 || ranges.bulgeMin > ranges.bulgeMax) {
+        throw std::runtime_error("Invalid shape ranges in constants file: " + constantsPath);
+    }
+    return ranges;
+}
+
+bool parseDesignPattern(const std::string& name, DesignPattern& pattern) {
+    if (name == "grid") {
+        pattern = DesignPattern::Grid;
+    } else if (name == "rosette") {
+        pattern = DesignPattern::Rosette;
+    } else if (name == "border") {
+        pattern = DesignPattern::Border;
+    } else {
+        return false;
+    }
+    return true;
+}
+
+std::string generateDesign(const DesignGeneratorOptions& options) {
+    int count = std::max(1, options.shapeCount);
+    double pitch = options.shapeSize + options.spacing;
+    std::vector<Placement> placements;
+    const char* patternName = "grid";
+    switch (options.pattern) {
+        case DesignPattern::Grid:
+            placements = gridPlacements(count, pitch);
+            break;
+        case DesignPattern::Rosette:
+            placements = rosettePlacements(count, pitch);
+            patternName = "rosette";
+            break;
+        case DesignPattern::Border:
+            placements = borderPlacements(count, pitch);
+            patternName = "border";
+            break;
+    }
+
+    std::mt19937 rng(options.seed);
+    std::uniform_real_distribution<double> kind(0.0, 1.0);
+    std::uniform_real_distribution<double> sagittaRatio(options.ranges.minSagittaRatio, options.ranges.maxSagittaRatio);
+    std::uniform_real_distribution<double> bulge(options.ranges.bulgeMin, options.ranges.bulgeMax);
+
+    std::ostringstream out;
+    out << std::setprecision(12);
+    out << "{\"version\": \"2.0\", \"metadata\": {\"name\": \"Generated " << patternName << " (" << count
+        << " shapes, seed " << options.seed << ")\"}, \"shapes\": [";
+    double half = options.shapeSize / 2.0;
+    for (int i = 0; i < count; ++i) {
+        const Placement& p = placements[i];
+        out << (i > 0 ? ",\n  " : "\n  ") << "{\"id\": \"shape-" << i << "\", ";
+        if (kind(rng) >= options.triArcFraction) {
+            // Radius whose arc over the focus chord has the drawn sagitta; kept a
+            // hair above half the chord so rounded vertices still fit a semicircle
+            double sagitta = sagittaRatio(rng) * options.shapeSize;
+            double radius = std::max((sagitta * sagitta + half * half) / (2.0 * sagitta),
+                                     half * (1.0 + LEAF_RADIUS_MARGIN));
+            double dx = half * std::cos(p.angle);
+            double dy = half * std::sin(p.angle);
+            out << "\"type\": \"LEAF\", \"vertices\": [";
+            writePoint(out, p.x - dx, p.y - dy);
+            out << ", ";
+            writePoint(out, p.x + dx, p.y + dy);
+            out << "], \"radius\": " << radius << "}";
+        } else {
+            out << "\"type\": \"TRI_ARC\", \"vertices\": [";
+            for (int v = 0; v < 3; ++v) {
+                double theta = p.angle + M_PI / 2.0 + v * 2.0 * M_PI / 3.0;
+                out << (v > 0 ? ", " : "");
+                writePoint(out, p.x + half * std::cos(theta), p.y + half * std::sin(theta));
+            }
+            double b0 = bulge(rng);
+            double b1 = bulge(rng);
+            double b2 = bulge(rng);
+            out << "], \"curvatures\": [" << b0 << ", " << b1 << ", " << b2 << "]}";
+        }
+    }
+    out << "\n]}\n";
+    return out.str();
+}
+
+}  // namespace Testing
+}  // namespace ChipCarving
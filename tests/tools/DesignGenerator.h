@@ -0,0 +1,56 @@
+/**
+ * DesignGenerator.h
+ *
+ * Synthetic design-schema-v2 generator for load testing. Lays out N LEAF and
+ * TRI_ARC shapes in a grid, rosette or border pattern with random arc
+ * parameters drawn from the ranges in schema/constants.json, so the
+ * benchmarks and the generate_design tool can reach production-sized designs.
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <string>
+
+namespace ChipCarving {
+namespace Testing {
+
+enum class DesignPattern { Grid, Rosette, Border };
+
+// Arc parameter ranges; defaults mirror schema/constants.json
+struct ShapeRanges {
+    double minSagittaRatio = 0.001;  // geometry.arc: leaf sagitta as a ratio of the focus distance
+    double maxSagittaRatio = 0.5;
+    double bulgeMin = -0.2;  // geometry.triarc: concave edge bulge
+    double bulgeMax = -0.001;
+};
+
+struct DesignGeneratorOptions {
+    int shapeCount = 100;
+    DesignPattern pattern = DesignPattern::Grid;
+    double shapeSize = 10.0;      // Leaf focus distance and TriArc circumscribed diameter (mm)
+    double spacing = 2.0;         // Gap between neighbouring shapes (mm)
+    double triArcFraction = 0.5;  // Probability that a shape is a TRI_ARC rather than a LEAF
+    uint32_t seed = 1;
+    ShapeRanges ranges;
+};
+
+/**
+ * Read the leaf sagitta and TriArc bulge ranges from a constants.json file
+ * @throws std::runtime_error if the file cannot be read or is malformed
+ */
+ShapeRanges loadShapeRanges(const std::string& constantsPath);
+
+/**
+ * @return false if name is not one of "grid", "rosette" or "border"
+ */
+bool parseDesignPattern(const std::string& name, DesignPattern& pattern);
+
+/**
+ * Generate a design-schema-v2 document; the same options always produce the
+ * same document
+ */
+std::string generateDesign(const DesignGeneratorOptions& options);
+
+}  // namespace Testing
+}  // namespace ChipCarving
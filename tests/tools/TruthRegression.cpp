@@ -0,0 +1,221 @@
+/**
+ * TruthRegression.cpp
+ *
+ * Fixture evaluation, worker pool and report for the truth regression runner
+ */
+
+#include "TruthRegression.h"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <filesystem>
+#include <thread>
+#include <utility>
+
+#include "geometry/MedialAxisBatch.h"
+#include "geometry/MedialAxisProcessor.h"
+#include "utils/TraceSpan.h"
+#include "utils/logging.h"
+
+namespace ChipCarving {
+namespace Testing {
+
+namespace {
+
+// Slowest fixtures listed by the summary
+const size_t SLOWEST_LISTED = 5;
+
+double spanMs(const Utils::RunMetrics& metrics, const char* path) {
+    const Utils::RunMetrics::Span* span = metrics.find(path);
+    return span ? span->totalMs : 0.0;
+}
+
+std::string formatMs(double ms) {
+    char text[32];
+    std::snprintf(text, sizeof(text), "%.2fms", ms);
+    return text;
+}
+
+std::string describeMismatch(const Geometry::TruthMismatch& mismatch) {
+    return mismatch.reason + " differs at chain " + std::to_string(mismatch.chain) + ", point " +
+           std::to_string(mismatch.point);
+}
+
+TruthFixtureResult evaluateFixture(const std::string& path, const TruthRegressionOptions& options,
+                                   const std::string& engineVersion, const TruthComputeFunction& compute) {
+    TruthFixtureResult result;
+    result.path = path;
+
+    // Stage spans land in a per-fixture RunMetrics so workers never share one
+    Utils::RunMetrics metrics;
+    {
+        Utils::ScopedRunMetrics bind(metrics);
+        Utils::TraceSpan fixtureSpan("fixture");
+        Geometry::TruthFixture fixture;
+        bool loaded;
+        {
+            Utils::TraceSpan span("load");
+            loaded = Geometry::loadTruthFixture(path, fixture);
+        }
+
+        if (!loaded) {
+            result.error = "cannot load fixture";
+        } else if (fixture.polygon.empty()) {
+            // Chains-only fixture: loading validated the chain layout
+            result.passed = true;
+        } else {
+            result.recomputed = true;
+            result.engineChanged = !fixture.engineVersion.empty() && fixture.engineVersion != engineVersion;
+            Geometry::MedialAxisChains actual;
+            bool computed;
+            {
+                Utils::TraceSpan span("compute");
+                computed = compute(fixture, actual);
+            }
+            Geometry::TruthMismatch mismatch;
+            if (!computed) {
+                result.error = "medial axis computation failed";
+            } else {
+                Utils::TraceSpan span("compare");
+                result.passed = Geometry::compareTruthChains(fixture.chains, actual, options.tolerance, &mismatch);
+                if (!result.passed) {
+                    result.error = describeMismatch(mismatch);
+                }
+            }
+            if (!result.passed && result.engineChanged) {
+                result.error += " (recorded with OpenVoronoi " + fixture.engineVersion + ", running " + engineVersion +
+                                "; re-record with convert_truth --record if the change is expected)";
+            }
+        }
+    }
+
+    result.loadMs = spanMs(metrics, "fixture/load");
+    result.computeMs = spanMs(metrics, "fixture/compute");
+    result.compareMs = spanMs(metrics, "fixture/compare");
+    result.totalMs = spanMs(metrics, "fixture");
+    result.overBudget = options.budgetMs > 0.0 && result.totalMs > options.budgetMs;
+    return result;
+}
+
+}  // namespace
+
+size_t TruthRegressionReport::failedCount() const {
+    return static_cast<size_t>(
+        std::count_if(fixtures.begin(), fixtures.end(), [](const TruthFixtureResult& r) { return !r.passed; }));
+}
+
+size_t TruthRegressionReport::overBudgetCount() const {
+    return static_cast<size_t>(
+        std::count_if(fixtures.begin(), fixtures.end(), [](const TruthFixtureResult& r) { return r.overBudget; }));
+}
+
+bool TruthRegressionReport::ok() const {
+    return failedCount() == 0 && overBudgetCount() == 0;
+}
+
+std::string TruthRegressionReport::summary() const {
+    double loadMs = 0.0;
+    double computeMs = 0.0;
+    double compareMs = 0.0;
+    size_t recomputed = 0;
+    for (const auto& result : fixtures) {
+        loadMs += result.loadMs;
+        computeMs += result.computeMs;
+        compareMs += result.compareMs;
+        recomputed += result.recomputed ? 1 : 0;
+    }
+
+    std::string text = std::to_string(fixtures.size()) + " fixtures (" + std::to_string(recomputed) +
+                       " recomputed), " + std::to_string(failedCount()) + " failed, " +
+                       std::to_string(overBudgetCount()) + " over budget, wall " + formatMs(wallMs) + "\n";
+    text += "  load: " + formatMs(loadMs) + "\n  compute: " + formatMs(computeMs) + "\n  compare: " +
+            formatMs(compareMs) + "\n";
+
+    std::vector<const TruthFixtureResult*> slowest;
+    for (const auto& result : fixtures) {
+        slowest.push_back(&result);
+    }
+    size_t listed = std::min(SLOWEST_LISTED, slowest.size());
+    std::partial_sort(slowest.begin(), slowest.begin() + listed, slowest.end(),
+                      [](const TruthFixtureResult* a, const TruthFixtureResult* b) { return a->totalMs > b->totalMs; });
+    if (listed > 0) {
+        text += "slowest:\n";
+    }
+    for (size_t i = 0; i < listed; ++i) {
+        text += "  " + slowest[i]->path + ": " + formatMs(slowest[i]->totalMs) + "\n";
+    }
+
+    for (const auto& result : fixtures) {
+        if (!result.passed) {
+            text += "FAIL " + result.path + ": " + result.error + "\n";
+        }
+        if (result.overBudget) {
+            text += "SLOW " + result.path + ": " + formatMs(result.totalMs) + "\n";
+        }
+    }
+    return text;
+}
+
+bool computeFixtureMedialAxis(const Geometry::TruthFixture& fixture, Geometry::MedialAxisChains& chains) {
+    Geometry::MedialAxisProcessor processor(fixture.polygonTolerance, fixture.medialThreshold);
+    processor.setVerbose(false);
+    Geometry::MedialAxisResults results = processor.computeMedialAxis(fixture.polygon);
+    if (!results.success) {
+        return false;
+    }
+    chains = std::move(results.chains);
+    return true;
+}
+
+std::vector<std::string> findTruthFixtures(const std::string& directory) {
+    std::vector<std::string> paths;
+    std::error_code error;
+    for (const auto& entry : std::filesystem::directory_iterator(directory, error)) {
+        std::string extension = entry.path().extension().string();
+        if (entry.is_regular_file() && (extension == ".truth" || extension == ".truthb")) {
+            paths.push_back(entry.path().string());
+        }
+    }
+    std::sort(paths.begin(), paths.end());
+    return paths;
+}
+
+TruthRegressionReport runTruthRegression(const std::vector<std::string>& paths, const TruthRegressionOptions& options,
+                                         const std::string& engineVersion, const TruthComputeFunction& compute) {
+    TruthRegressionReport report;
+    report.fixtures.resize(paths.size());
+    auto start = std::chrono::steady_clock::now();
+
+    // Each worker pulls the next fixture; results land in their input slot
+    std::atomic<size_t> nextIndex{0};
+    auto worker = [&]() {
+        for (size_t i = nextIndex.fetch_add(1); i < paths.size(); i = nextIndex.fetch_add(1)) {
+            report.fixtures[i] = evaluateFixture(paths[i], options, engineVersion, compute);
+        }
+    };
+
+    int workers = Geometry::resolveMedialAxisWorkerCount(options.workers, paths.size());
+    if (workers == 1) {
+        worker();
+    } else {
+        std::vector<std::thread> threads;
+        threads.reserve(static_cast<size_t>(workers));
+        for (int t = 0; t < workers; ++t) {
+            threads.emplace_back([&worker]() {
+                SetThreadConsoleLoggingSuppressed(true);
+                worker();
+            });
+        }
+        for (auto& thread : threads) {
+            thread.join();
+        }
+    }
+
+    report.wallMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+    return report;
+}
+
+}  // namespace Testing
+}  // namespace ChipCarving
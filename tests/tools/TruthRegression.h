@@ -0,0 +1,78 @@
+/**
+ * TruthRegression.h
+ *
+ * Parallel medial axis regression runner over truth fixtures (text .truth or
+ * binary .truthb, see geometry/MedialAxisTruthData.h). Fixtures that carry
+ * their input polygon are recomputed and compared to the recorded chains;
+ * chains-only fixtures are loaded and validated. Each fixture is timed per
+ * stage (load, compute, compare) and checked against an optional budget, so
+ * a large regression set stays fast and a slow profile is named, not hidden.
+ */
+
+#pragma once
+
+#include <functional>
+#include <string>
+#include <vector>
+
+#include "geometry/MedialAxisTruthData.h"
+
+namespace ChipCarving {
+namespace Testing {
+
+struct TruthRegressionOptions {
+    int workers = 0;          // 0 = one per hardware thread
+    double tolerance = 1e-6;  // Largest accepted coordinate or clearance difference
+    double budgetMs = 0.0;    // Per-fixture wall-time budget; 0 = unlimited
+};
+
+struct TruthFixtureResult {
+    std::string path;
+    bool passed = false;
+    bool recomputed = false;     // False for chains-only fixtures
+    bool overBudget = false;
+    bool engineChanged = false;  // Recorded with a different OpenVoronoi version than the one running
+    std::string error;           // Why the fixture failed, empty if it passed
+    double loadMs = 0.0;
+    double computeMs = 0.0;
+    double compareMs = 0.0;
+    double totalMs = 0.0;
+};
+
+struct TruthRegressionReport {
+    std::vector<TruthFixtureResult> fixtures;  // In input order
+    double wallMs = 0.0;
+
+    size_t failedCount() const;
+    size_t overBudgetCount() const;
+
+    // True if every fixture passed within its budget
+    bool ok() const;
+
+    // Stage totals, the slowest fixtures and one line per failure
+    std::string summary() const;
+};
+
+// Recompute a fixture's chains from its polygon; false if the computation failed
+using TruthComputeFunction = std::function<bool(const Geometry::TruthFixture&, Geometry::MedialAxisChains&)>;
+
+/**
+ * Default compute: MedialAxisProcessor with the fixture's tolerance and threshold
+ */
+bool computeFixtureMedialAxis(const Geometry::TruthFixture& fixture, Geometry::MedialAxisChains& chains);
+
+/**
+ * The .truth and .truthb files in a directory, sorted by name
+ */
+std::vector<std::string> findTruthFixtures(const std::string& directory);
+
+/**
+ * Evaluate fixtures in parallel, one fixture per task
+ * @param engineVersion Version running now, compared to each fixture's recorded one
+ */
+TruthRegressionReport runTruthRegression(const std::vector<std::string>& paths, const TruthRegressionOptions& options,
+                                         const std::string& engineVersion,
+                                         const TruthComputeFunction& compute = computeFixtureMedialAxis);
+
+}  // namespace Testing
+}  // namespace ChipCarving
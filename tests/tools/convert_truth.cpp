@@ -0,0 +1,111 @@
+/**
+ * convert_truth.cpp
+ *
+ * Converts medial axis truth fixtures between the text and binary formats,
+ * optionally re-recording the chains from the fixture's polygon with the
+ * OpenVoronoi build in use. A new customer profile becomes a fixture by
+ * writing its outline as "vertex i: x y" lines and recording it:
+ *
+ *   convert_truth --record profile.truth profile.truthb
+ */
+
+#include <cstdlib>
+#include <iostream>
+#include <stdexcept>
+#include <string>
+
+#include "TruthRegression.h"
+#include "geometry/MedialAxisDiskCache.h"
+#include "geometry/MedialAxisTruthData.h"
+#include "utils/logging.h"
+
+using namespace ChipCarving::Geometry;
+
+namespace {
+
+void printUsage(const char* program) {
+    std::cerr << "Usage: " << program << " [options] INPUT OUTPUT\n"
+              << "  --record         Recompute the chains from the fixture polygon and stamp the engine version\n"
+              << "  --tolerance T    Polygon tolerance to record with (default: the fixture's)\n"
+              << "  --threshold T    Medial threshold to record with (default: the fixture's)\n"
+              << "  --text           Write the text format (default: binary, or text for a .truth OUTPUT)\n";
+}
+
+bool endsWith(const std::string& text, const std::string& suffix) {
+    return text.size() >= suffix.size() && text.compare(text.size() - suffix.size(), suffix.size(), suffix) == 0;
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+    bool record = false;
+    bool text = false;
+    double tolerance = -1.0;
+    double threshold = -1.0;
+    std::string inputPath;
+    std::string outputPath;
+
+    SetThreadConsoleLoggingSuppressed(true);  // Keep the report readable
+    try {
+        for (int i = 1; i < argc; ++i) {
+            std::string arg = argv[i];
+            if (arg == "-h" || arg == "--help") {
+                printUsage(argv[0]);
+                return 0;
+            }
+            if (arg == "--record") {
+                record = true;
+            } else if (arg == "--text") {
+                text = true;
+            } else if (arg == "--tolerance" && i + 1 < argc) {
+                tolerance = std::stod(argv[++i]);
+            } else if (arg == "--threshold" && i + 1 < argc) {
+                threshold = std::stod(argv[++i]);
+            } else if (arg.rfind("--", 0) == 0) {
+                throw std::invalid_argument("Unknown option or missing value: " + arg);
+            } else if (inputPath.empty()) {
+                inputPath = arg;
+            } else if (outputPath.empty()) {
+                outputPath = arg;
+            } else {
+                throw std::invalid_argument("Unexpected argument: " + arg);
+            }
+        }
+        if (outputPath.empty()) {
+            throw std::invalid_argument("INPUT and OUTPUT are required");
+        }
+
+        TruthFixture fixture;
+        if (!loadTruthFixture(inputPath, fixture)) {
+            throw std::runtime_error("Cannot load " + inputPath);
+        }
+        if (tolerance > 0.0) {
+            fixture.polygonTolerance = tolerance;
+        }
+        if (threshold >= 0.0) {
+            fixture.medialThreshold = threshold;
+        }
+        if (record) {
+            if (fixture.polygon.size() < 3) {
+                throw std::runtime_error(inputPath + " has no polygon to record from");
+            }
+            if (!ChipCarving::Testing::computeFixtureMedialAxis(fixture, fixture.chains)) {
+                throw std::runtime_error("Medial axis computation failed for " + inputPath);
+            }
+            fixture.engineVersion = MedialAxisDiskCache::currentEngineVersion();
+        }
+
+        bool written = text || endsWith(outputPath, ".truth") ? storeTextTruthFixture(outputPath, fixture)
+                                                              : storeBinaryTruthFixture(outputPath, fixture);
+        if (!written) {
+            throw std::runtime_error("Failed to write " + outputPath);
+        }
+        std::cerr << "Wrote " << fixture.chains.size() << " chains, " << fixture.chains.pointCount() << " points to "
+                  << outputPath << "\n";
+        return 0;
+    } catch (const std::exception& e) {
+        std::cerr << "convert_truth: " << e.what() << "\n";
+        printUsage(argv[0]);
+        return EXIT_FAILURE;
+    }
+}
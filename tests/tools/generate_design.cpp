@@ -0,0 +1,97 @@
+/**
+ * generate_design.cpp
+ *
+ * Command-line front end for the synthetic design generator. Writes a
+ * design-schema-v2 file for load testing the import and path pipeline:
+ *
+ *   generate_design --shapes 5000 --pattern rosette --seed 7 -o rosette_5k.json
+ */
+
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <stdexcept>
+#include <string>
+
+#include "DesignGenerator.h"
+
+using namespace ChipCarving::Testing;
+
+namespace {
+
+void printUsage(const char* program) {
+    std::cerr << "Usage: " << program << " [options]\n"
+              << "  --shapes N          Number of shapes (default 100)\n"
+              << "  --pattern NAME      grid, rosette or border (default grid)\n"
+              << "  --seed S            Random seed for shape types and bulges (default 1)\n"
+              << "  --size MM           Shape size in mm (default 10)\n"
+              << "  --spacing MM        Gap between shapes in mm (default 2)\n"
+              << "  --triarc-fraction F Fraction of TRI_ARC shapes, 0..1 (default 0.5)\n"
+              << "  --constants PATH    constants.json with the arc ranges (default " << CHIP_CARVING_SCHEMA_DIR
+              << "/constants.json)\n"
+              << "  -o PATH             Output file (default stdout)\n";
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+    DesignGeneratorOptions options;
+    std::string constantsPath = std::string(CHIP_CARVING_SCHEMA_DIR) + "/constants.json";
+    std::string outputPath;
+
+    try {
+        for (int i = 1; i < argc; ++i) {
+            std::string arg = argv[i];
+            if (arg == "-h" || arg == "--help") {
+                printUsage(argv[0]);
+                return 0;
+            }
+            if (i + 1 >= argc) {
+                throw std::invalid_argument("Missing value for " + arg);
+            }
+            std::string value = argv[++i];
+            if (arg == "--shapes") {
+                options.shapeCount = std::stoi(value);
+            } else if (arg == "--pattern") {
+                if (!parseDesignPattern(value, options.pattern)) {
+                    throw std::invalid_argument("Unknown pattern: " + value);
+                }
+            } else if (arg == "--seed") {
+                options.seed = static_cast<uint32_t>(std::stoul(value));
+            } else if (arg == "--size") {
+                options.shapeSize = std::stod(value);
+            } else if (arg == "--spacing") {
+                options.spacing = std::stod(value);
+            } else if (arg == "--triarc-fraction") {
+                options.triArcFraction = std::stod(value);
+            } else if (arg == "--constants") {
+                constantsPath = value;
+            } else if (arg == "-o") {
+                outputPath = value;
+            } else {
+                throw std::invalid_argument("Unknown option: " + arg);
+            }
+        }
+        if (options.shapeCount < 1 || options.shapeSize <= 0.0) {
+            throw std::invalid_argument("--shapes and --size must be positive");
+        }
+
+        options.ranges = loadShapeRanges(constantsPath);
+        std::string design = generateDesign(options);
+
+        if (outputPath.empty()) {
+            std::cout << design;
+            return 0;
+        }
+        std::ofstream out(outputPath);
+        if (!(out << design)) {
+            throw std::runtime_error("Failed to write " + outputPath);
+        }
+        std::cerr << "Wrote " << options.shapeCount << " shapes to " << outputPath << "\n";
+        return 0;
+    } catch (const std::exception& e) {
+        std::cerr << "generate_design: " << e.what() << "\n";
+        printUsage(argv[0]);
+        return EXIT_FAILURE;
+    }
+}
@@ -0,0 +1,87 @@
+/**
+ * truth_regression.cpp
+ *
+ * Command-line front end for the parallel medial axis truth regression.
+ * Evaluates every fixture given (files, or directories of .truth/.truthb
+ * files) and exits nonzero if any fails or runs over its budget:
+ *
+ *   truth_regression --workers 8 --budget-ms 250 fixtures/customer_profiles
+ */
+
+#include <cstdlib>
+#include <filesystem>
+#include <iostream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "TruthRegression.h"
+#include "geometry/MedialAxisDiskCache.h"
+#include "utils/logging.h"
+
+using namespace ChipCarving::Testing;
+
+namespace {
+
+void printUsage(const char* program) {
+    std::cerr << "Usage: " << program << " [options] [fixture or directory ...]\n"
+              << "  --workers N      Parallel fixtures, 0 = one per hardware thread (default 0)\n"
+              << "  --budget-ms MS   Fail any fixture slower than this, 0 = no budget (default 0)\n"
+              << "  --tolerance T    Largest accepted coordinate or clearance difference (default 1e-6)\n"
+              << "With no fixtures, runs " << MEDIAL_AXIS_TRUTH_DIR << "\n";
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+    TruthRegressionOptions options;
+    std::vector<std::string> paths;
+
+    SetThreadConsoleLoggingSuppressed(true);  // Keep the report readable
+    try {
+        for (int i = 1; i < argc; ++i) {
+            std::string arg = argv[i];
+            if (arg == "-h" || arg == "--help") {
+                printUsage(argv[0]);
+                return 0;
+            }
+            if (arg.rfind("--", 0) != 0) {
+                if (std::filesystem::is_directory(arg)) {
+                    std::vector<std::string> found = findTruthFixtures(arg);
+                    paths.insert(paths.end(), found.begin(), found.end());
+                } else {
+                    paths.push_back(arg);
+                }
+                continue;
+            }
+            if (i + 1 >= argc) {
+                throw std::invalid_argument("Missing value for " + arg);
+            }
+            std::string value = argv[++i];
+            if (arg == "--workers") {
+                options.workers = std::stoi(value);
+            } else if (arg == "--budget-ms") {
+                options.budgetMs = std::stod(value);
+            } else if (arg == "--tolerance") {
+                options.tolerance = std::stod(value);
+            } else {
+                throw std::invalid_argument("Unknown option: " + arg);
+            }
+        }
+        if (paths.empty()) {
+            paths = findTruthFixtures(MEDIAL_AXIS_TRUTH_DIR);
+        }
+        if (paths.empty()) {
+            throw std::invalid_argument("No truth fixtures found");
+        }
+
+        std::string engineVersion = ChipCarving::Geometry::MedialAxisDiskCache::currentEngineVersion();
+        TruthRegressionReport report = runTruthRegression(paths, options, engineVersion);
+        std::cout << "OpenVoronoi " << engineVersion << "\n" << report.summary();
+        return report.ok() ? 0 : EXIT_FAILURE;
+    } catch (const std::exception& e) {
+        std::cerr << "truth_regression: " << e.what() << "\n";
+        printUsage(argv[0]);
+        return EXIT_FAILURE;
+    }
+}
@@ -0,0 +1,91 @@
+/**
+ * test_ApiCallTimer.cpp
+ *
+ * Unit tests for Fusion API call accounting in run metrics and traces
+ */
+
+#include <gtest/gtest.h>
+
+#include <string>
+
+#include "parsers/JsonReader.h"
+#include "utils/ApiCallTimer.h"
+#include "utils/TraceSpan.h"
+
+using ChipCarving::Parsers::JsonReader;
+using ChipCarving::Utils::ApiCallKind;
+using ChipCarving::Utils::ApiCallTimer;
+using ChipCarving::Utils::RunMetrics;
+using ChipCarving::Utils::ScopedRunMetrics;
+using ChipCarving::Utils::TraceRecorder;
+using ChipCarving::Utils::TraceSpan;
+using ChipCarving::Utils::timedApiCall;
+
+TEST(ApiCallTimerTest, TotalsCallsPerKindUnderTheInnermostSpan) {
+    RunMetrics metrics;
+    {
+        ScopedRunMetrics run(metrics);
+        TraceSpan root("generatePaths");
+        ApiCallTimer outsideStages(ApiCallKind::Call);
+        {
+            TraceSpan stage("vcarve");
+            for (int i = 0; i < 3; ++i) {
+                EXPECT_EQ(timedApiCall(ApiCallKind::ObjectCreate, [i] { return i * 2; }), i * 2);
+            }
+            ApiCallTimer batch(ApiCallKind::SketchEntity, 40);
+        }
+        TraceSpan surface("surface");
+        ApiCallTimer ray(ApiCallKind::RayCast);
+    }
+
+    ASSERT_EQ(metrics.apiCalls().size(), 4u);
+    EXPECT_EQ(metrics.apiCallTotals(ApiCallKind::ObjectCreate).count, 3u);
+    EXPECT_EQ(metrics.apiCallTotals(ApiCallKind::SketchEntity).count, 40u);
+    EXPECT_EQ(metrics.apiCallTotals(ApiCallKind::RayCast).count, 1u);
+    EXPECT_EQ(metrics.apiCallTotals(ApiCallKind::Call).count, 1u);
+    EXPECT_EQ(metrics.pathOf(metrics.apiCalls()[0].span), "generatePaths/vcarve");
+    EXPECT_EQ(metrics.pathOf(metrics.apiCalls()[2].span), "generatePaths/surface");
+    EXPECT_EQ(metrics.pathOf(metrics.apiCalls()[3].span), "generatePaths");
+
+    std::string summary = metrics.summary();
+    EXPECT_NE(summary.find("Fusion API calls:\n"), std::string::npos) << summary;
+    EXPECT_NE(summary.find("  objectsCreated: 3 in "), std::string::npos) << summary;
+    EXPECT_NE(summary.find("    generatePaths/vcarve: 40 in "), std::string::npos) << summary;
+
+    std::string json = metrics.toJson();
+    EXPECT_NE(json.find("{\"path\":\"generatePaths/surface\",\"kind\":\"rayCasts\",\"count\":1,"), std::string::npos)
+        << json;
+    JsonReader reader(json);
+    EXPECT_NO_THROW({
+        reader.skipValue();
+        reader.expectEnd();
+    });
+
+    metrics.clear();
+    EXPECT_TRUE(metrics.apiCalls().empty());
+}
+
+TEST(ApiCallTimerTest, TracesRunningCountersAndIgnoresUnboundThreads) {
+    EXPECT_EQ(timedApiCall(ApiCallKind::Call, [] { return 7; }), 7);
+
+    RunMetrics metrics;
+    TraceRecorder recorder;
+    {
+        ScopedRunMetrics run(metrics, &recorder);
+        ApiCallTimer first(ApiCallKind::SketchEntity, 2);
+    }
+    {
+        ScopedRunMetrics run(metrics, &recorder);
+        ApiCallTimer second(ApiCallKind::SketchEntity, 3);
+    }
+
+    // A count and a time counter per call; metrics made outside every span have no path
+    EXPECT_EQ(recorder.eventCount(), 4u);
+    std::string json = recorder.toJson();
+    EXPECT_NE(json.find("\"name\":\"fusion.sketchEntities\",\"ph\":\"C\""), std::string::npos) << json;
+    EXPECT_NE(json.find("\"args\":{\"value\":5.000}"), std::string::npos) << json;
+    EXPECT_NE(json.find("\"name\":\"fusion.sketchEntitiesMs\""), std::string::npos) << json;
+    ASSERT_EQ(metrics.apiCalls().size(), 1u);
+    EXPECT_EQ(metrics.apiCalls()[0].span, RunMetrics::NO_PARENT);
+    EXPECT_NE(metrics.summary().find("(outside spans): 5 in "), std::string::npos) << metrics.summary();
+}
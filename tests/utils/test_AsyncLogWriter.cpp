@@ -0,0 +1,129 @@
+/**
+ * test_AsyncLogWriter.cpp
+ *
+ * Unit tests for the lock-free background log writer behind FusionLogger
+ */
+
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "utils/AsyncLogWriter.h"
+
+using ChipCarving::Utils::AsyncLogWriter;
+
+namespace {
+
+// Records written and flushes seen by the writer thread
+struct RecordingSink {
+    std::mutex mutex;
+    std::vector<std::string> records;
+    int flushes = 0;
+
+    AsyncLogWriter::RecordSink write() {
+        return [this](const std::string& record) {
+            std::lock_guard<std::mutex> lock(mutex);
+            records.push_back(record);
+        };
+    }
+    AsyncLogWriter::FlushSink flush() {
+        return [this]() {
+            std::lock_guard<std::mutex> lock(mutex);
+            ++flushes;
+        };
+    }
+};
+
+}  // namespace
+
+TEST(AsyncLogWriterTest, FlushWritesRecordsInOrder) {
+    RecordingSink sink;
+    AsyncLogWriter writer(sink.write(), sink.flush(), 16);
+
+    for (int i = 0; i < 10; ++i) {
+        EXPECT_TRUE(writer.push("line " + std::to_string(i)));
+    }
+    writer.flush();
+
+    std::lock_guard<std::mutex> lock(sink.mutex);
+    ASSERT_EQ(sink.records.size(), 10u);
+    for (int i = 0; i < 10; ++i) {
+        EXPECT_EQ(sink.records[i], "line " + std::to_string(i));
+    }
+    EXPECT_GE(sink.flushes, 1);
+}
+
+TEST(AsyncLogWriterTest, ShutdownDrainsPendingRecords) {
+    RecordingSink sink;
+    {
+        AsyncLogWriter writer(sink.write(), sink.flush(), 64);
+        for (int i = 0; i < 50; ++i) {
+            writer.push("pending");
+        }
+    }
+    EXPECT_EQ(sink.records.size(), 50u);
+    EXPECT_GE(sink.flushes, 1);
+}
+
+TEST(AsyncLogWriterTest, ConcurrentProducersLoseNothingWithinCapacity) {
+    RecordingSink sink;
+    constexpr int THREADS = 4;
+    constexpr int PER_THREAD = 500;
+    AsyncLogWriter writer(sink.write(), sink.flush(), THREADS * PER_THREAD);
+
+    std::vector<std::thread> producers;
+    for (int t = 0; t < THREADS; ++t) {
+        producers.emplace_back([&writer, t]() {
+            for (int i = 0; i < PER_THREAD; ++i) {
+                writer.push(std::to_string(t) + ":" + std::to_string(i));
+            }
+        });
+    }
+    for (auto& producer : producers) {
+        producer.join();
+    }
+    writer.flush();
+
+    std::lock_guard<std::mutex> lock(sink.mutex);
+    ASSERT_EQ(sink.records.size(), static_cast<size_t>(THREADS * PER_THREAD));
+    EXPECT_EQ(writer.droppedCount(), 0u);
+
+    // Each producer's records keep their relative order
+    std::vector<int> next(THREADS, 0);
+    for (const auto& record : sink.records) {
+        size_t colon = record.find(':');
+        int thread = std::stoi(record.substr(0, colon));
+        EXPECT_EQ(std::stoi(record.substr(colon + 1)), next[thread]++);
+    }
+}
+
+TEST(AsyncLogWriterTest, FullRingDropsInsteadOfBlocking) {
+    std::mutex gate;
+    std::unique_lock<std::mutex> blocked(gate);
+    std::atomic<int> written{0};
+
+    // The sink stalls on the first record until the gate opens
+    AsyncLogWriter writer(
+        [&](const std::string&) {
+            std::lock_guard<std::mutex> wait(gate);
+            ++written;
+        },
+        []() {}, 4);
+
+    int accepted = 0;
+    for (int i = 0; i < 20; ++i) {
+        accepted += writer.push("record") ? 1 : 0;
+    }
+    EXPECT_LT(accepted, 20);
+    EXPECT_EQ(writer.droppedCount(), static_cast<size_t>(20 - accepted));
+
+    blocked.unlock();
+    writer.flush();
+    // Accepted records plus one drop report
+    EXPECT_EQ(written.load(), accepted + 1);
+}
@@ -0,0 +1,119 @@
+/**
+ * test_BoundedQueue.cpp
+ *
+ * Unit tests for the blocking FIFO between pipeline stages
+ */
+
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <thread>
+#include <vector>
+
+#include "utils/BoundedQueue.h"
+
+using ChipCarving::Utils::BoundedQueue;
+
+TEST(BoundedQueueTest, KeepsFifoOrderAndTryPopDoesNotBlock) {
+    BoundedQueue<int> queue(3);
+    EXPECT_EQ(queue.capacity(), 3u);
+
+    int item = 0;
+    EXPECT_FALSE(queue.tryPop(item));
+
+    ASSERT_TRUE(queue.push(1));
+    ASSERT_TRUE(queue.push(2));
+    ASSERT_TRUE(queue.push(3));
+    EXPECT_EQ(queue.size(), 3u);
+
+    ASSERT_TRUE(queue.tryPop(item));
+    EXPECT_EQ(item, 1);
+    ASSERT_TRUE(queue.pop(item));
+    EXPECT_EQ(item, 2);
+    EXPECT_EQ(queue.size(), 1u);
+}
+
+TEST(BoundedQueueTest, CloseDrainsThenStopsConsumers) {
+    BoundedQueue<std::unique_ptr<int>> queue(2);
+    ASSERT_TRUE(queue.push(std::make_unique<int>(7)));
+    queue.close();
+
+    EXPECT_FALSE(queue.push(std::make_unique<int>(8)));
+
+    std::unique_ptr<int> item;
+    ASSERT_TRUE(queue.pop(item));
+    EXPECT_EQ(*item, 7);
+    EXPECT_FALSE(queue.pop(item));
+}
+
+TEST(BoundedQueueTest, ProducerBlocksWhileFull) {
+    BoundedQueue<int> queue(1);
+    ASSERT_TRUE(queue.push(0));
+
+    std::atomic<bool> pushed{false};
+    std::thread producer([&queue, &pushed] {
+        queue.push(1);
+        pushed = true;
+    });
+
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    EXPECT_FALSE(pushed.load());
+
+    int item = -1;
+    ASSERT_TRUE(queue.pop(item));
+    EXPECT_EQ(item, 0);
+    producer.join();
+    EXPECT_TRUE(pushed.load());
+    ASSERT_TRUE(queue.pop(item));
+    EXPECT_EQ(item, 1);
+}
+
+TEST(BoundedQueueTest, CloseWakesBlockedConsumers) {
+    BoundedQueue<int> queue(4);
+    std::vector<std::thread> consumers;
+    std::atomic<int> stopped{0};
+    for (int i = 0; i < 3; ++i) {
+        consumers.emplace_back([&queue, &stopped] {
+            int item = 0;
+            while (queue.pop(item)) {
+            }
+            ++stopped;
+        });
+    }
+
+    queue.close();
+    for (auto& consumer : consumers) {
+        consumer.join();
+    }
+    EXPECT_EQ(stopped.load(), 3);
+}
+
+TEST(BoundedQueueTest, EveryItemReachesExactlyOneConsumer) {
+    BoundedQueue<int> queue(2);
+    const int itemCount = 500;
+    std::atomic<long> sum{0};
+    std::atomic<int> received{0};
+
+    std::vector<std::thread> consumers;
+    for (int i = 0; i < 4; ++i) {
+        consumers.emplace_back([&queue, &sum, &received] {
+            int item = 0;
+            while (queue.pop(item)) {
+                sum += item;
+                ++received;
+            }
+        });
+    }
+    for (int i = 1; i <= itemCount; ++i) {
+        ASSERT_TRUE(queue.push(i));
+    }
+    queue.close();
+    for (auto& consumer : consumers) {
+        consumer.join();
+    }
+
+    EXPECT_EQ(received.load(), itemCount);
+    EXPECT_EQ(sum.load(), static_cast<long>(itemCount) * (itemCount + 1) / 2);
+}
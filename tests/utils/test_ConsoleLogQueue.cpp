@@ -0,0 +1,97 @@
+/**
+ * test_ConsoleLogQueue.cpp
+ *
+ * Unit tests for the queue holding worker-thread console lines for the main thread
+ */
+
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "utils/ConsoleLogQueue.h"
+
+using ChipCarving::Utils::ConsoleLogQueue;
+
+TEST(ConsoleLogQueueTest, OnlyFirstPushIntoEmptyQueueAsksForWakeup) {
+    ConsoleLogQueue queue;
+    EXPECT_TRUE(queue.push("one"));
+    EXPECT_FALSE(queue.push("two"));
+    EXPECT_EQ(queue.size(), 2u);
+
+    std::vector<std::string> written;
+    EXPECT_EQ(queue.drain([&written](const std::string& line) { written.push_back(line); }), 2u);
+    EXPECT_EQ(written, (std::vector<std::string>{"one", "two"}));
+    EXPECT_EQ(queue.size(), 0u);
+
+    // Drained, so the next line needs a new wakeup
+    EXPECT_TRUE(queue.push("three"));
+}
+
+TEST(ConsoleLogQueueTest, DropsPastCapacityAndReportsOnDrain) {
+    ConsoleLogQueue queue(2);
+    EXPECT_TRUE(queue.push("a"));
+    EXPECT_FALSE(queue.push("b"));
+    EXPECT_FALSE(queue.push("c"));
+    EXPECT_FALSE(queue.push("d"));
+    EXPECT_EQ(queue.droppedCount(), 2u);
+
+    std::vector<std::string> written;
+    EXPECT_EQ(queue.drain([&written](const std::string& line) { written.push_back(line); }), 2u);
+    ASSERT_EQ(written.size(), 3u);
+    EXPECT_EQ(written[0], "a");
+    EXPECT_EQ(written[1], "b");
+    EXPECT_NE(written[2].find("2 worker log messages dropped"), std::string::npos);
+
+    // The note is written once; the total keeps counting
+    written.clear();
+    queue.drain([&written](const std::string& line) { written.push_back(line); });
+    EXPECT_TRUE(written.empty());
+    EXPECT_EQ(queue.droppedCount(), 2u);
+}
+
+TEST(ConsoleLogQueueTest, SinkMayPushWhileDraining) {
+    ConsoleLogQueue queue;
+    queue.push("first");
+    std::vector<std::string> written;
+    queue.drain([&](const std::string& line) {
+        written.push_back(line);
+        queue.push("logged by sink");
+    });
+    EXPECT_EQ(written.size(), 1u);
+    EXPECT_EQ(queue.size(), 1u);
+}
+
+TEST(ConsoleLogQueueTest, ConcurrentProducersLoseNothingAndWakeOnce) {
+    ConsoleLogQueue queue;
+    constexpr int kThreads = 4;
+    constexpr int kLinesPerThread = 500;
+    std::atomic<int> wakeups{0};
+
+    std::vector<std::thread> producers;
+    for (int t = 0; t < kThreads; ++t) {
+        producers.emplace_back([&queue, &wakeups, t]() {
+            for (int i = 0; i < kLinesPerThread; ++i) {
+                if (queue.push(std::to_string(t) + ":" + std::to_string(i))) {
+                    ++wakeups;
+                }
+            }
+        });
+    }
+    for (auto& producer : producers) {
+        producer.join();
+    }
+
+    EXPECT_EQ(wakeups.load(), 1);
+    std::vector<int> nextPerThread(kThreads, 0);
+    size_t count = queue.drain([&nextPerThread](const std::string& line) {
+        size_t colon = line.find(':');
+        int thread = std::stoi(line.substr(0, colon));
+        // Each producer's lines keep their order
+        EXPECT_EQ(std::stoi(line.substr(colon + 1)), nextPerThread[thread]++);
+    });
+    EXPECT_EQ(count, static_cast<size_t>(kThreads * kLinesPerThread));
+    EXPECT_EQ(queue.droppedCount(), 0u);
+}
@@ -0,0 +1,189 @@
+/**
+ * test_Inflate.cpp
+ *
+ * Unit tests for the zlib stream decoder used to read heightmap PNGs, and the
+ * streaming gzip decoder used for compressed design files
+ */
+
+#include <gtest/gtest.h>
+
+#include <string>
+#include <vector>
+
+#include "utils/Inflate.h"
+
+using ChipCarving::Utils::GzipReader;
+using ChipCarving::Utils::inflateZlib;
+
+namespace {
+
+// Streams from zlib.compress(..., 9)
+const std::vector<unsigned char> FIXED_STREAM = {0x78, 0xda, 0x4b, 0xce, 0xc8, 0x2c, 0x50, 0x48, 0x46, 0x10, 0x89, 0x45,
+                                                 0x65, 0x99, 0x79, 0xe9, 0x30, 0x1a, 0x00, 0xaa, 0xd2, 0x0b, 0x41};
+
+const std::vector<unsigned char> DYNAMIC_STREAM = {
+    0x78, 0xda, 0x2d, 0xd2, 0x41, 0x12, 0x43, 0x21, 0x08, 0x44, 0xc1, 0x0b, 0xb9, 0x10, 0x14, 0x84, 0xf2, 0xfe, 0xf7,
+    0xca, 0x1b, 0x7f, 0x96, 0xa9, 0x84, 0x76, 0x06, 0x32, 0xc7, 0xbc, 0x36, 0xec, 0xee, 0xe1, 0xb7, 0xc7, 0xba, 0x96,
+    0x63, 0x5f, 0x8f, 0x11, 0x77, 0xe5, 0xc8, 0xbb, 0x7b, 0x9c, 0x9b, 0x7b, 0xd4, 0x2d, 0x1b, 0x7d, 0xd7, 0xb0, 0x79,
+    0x7d, 0x0f, 0x63, 0xe0, 0x0c, 0xf3, 0x7b, 0x9c, 0x79, 0x67, 0x7e, 0x19, 0x40, 0x3a, 0x42, 0x07, 0xc2, 0x5a, 0x08,
+    0x67, 0x22, 0x98, 0x23, 0xc4, 0x42, 0xe8, 0x44, 0xd8, 0x5b, 0x44, 0xdb, 0x23, 0x96, 0x88, 0xde, 0x10, 0x31, 0x31,
+    0x4a, 0x44, 0x40, 0xf8, 0x81, 0xa8, 0x82, 0x88, 0x0d, 0xe1, 0x22, 0xaa, 0x21, 0xf2, 0x85, 0x08, 0x11, 0xf6, 0x88,
+    0x4a, 0x11, 0x99, 0x10, 0xbb, 0x14, 0xc3, 0x31, 0xac, 0x30, 0xd4, 0xa3, 0x95, 0xa2, 0x02, 0xe2, 0xa8, 0xc7, 0x09,
+    0x88, 0xb3, 0x20, 0xce, 0x2b, 0xc2, 0x67, 0x08, 0xbe, 0x82, 0xe0, 0x57, 0x53, 0xbf, 0x37, 0x06, 0xff, 0x02, 0xd6,
+    0x96, 0x1a, 0xf2, 0x53, 0x4f, 0x1d, 0xbd, 0x5a, 0x0a, 0xd0, 0x8a, 0x02, 0x41, 0x2a, 0x08, 0x02, 0x42, 0x84, 0x8a,
+    0x94, 0x52, 0x90, 0xff, 0xdf, 0xa4, 0x20, 0xe8, 0x16, 0x6a, 0x99, 0x2a, 0x7c, 0xd4, 0xbd, 0xb4, 0x86, 0xd6, 0x42,
+    0x20, 0xd8, 0x0d, 0x84, 0x3d, 0x82, 0x8d, 0x4d, 0xed, 0xce, 0xb4, 0xc5, 0xff, 0x3e, 0xd9, 0x2c, 0x17, 0xd1, 0x3a,
+    0x5d, 0xc4, 0x81, 0x70, 0x1d, 0x44, 0x3d, 0xea, 0x85, 0xc8, 0xef, 0x20, 0xaf, 0xc7, 0xd2, 0x2a, 0xb8, 0x9f, 0xe9,
+    0x92, 0xdf, 0x49, 0x37, 0xf3, 0xc6, 0xfc, 0xbb, 0x06, 0xd3, 0x1a, 0x6e, 0x86, 0xed, 0x3d, 0xef, 0x6f, 0x09, 0xeb,
+    0xed, 0x11, 0xe2, 0xd3, 0x04, 0x63, 0xe9, 0x14, 0x9a, 0xe6, 0xd1, 0xff, 0xf3, 0xba, 0xc4, 0x52, 0x01, 0xa2, 0xb5,
+    0x42, 0xda, 0x97, 0xd7, 0x14, 0x1d, 0xc1, 0xf4, 0x7f, 0x88, 0x57, 0x40, 0xcf, 0xff, 0x00, 0x84, 0x5a, 0x7a, 0xa4};
+
+// gzip member named chips.txt; raw deflate with a sync flush after each of the first two phrases, so the
+// last block's matches reach back into earlier blocks
+const std::vector<unsigned char> GZIP_MEMBER = {
+    0x1f, 0x8b, 0x08, 0x08, 0x00, 0x00, 0x00, 0x00, 0x02, 0x03, 0x63, 0x68, 0x69, 0x70, 0x73, 0x2e,
+    0x74, 0x78, 0x74, 0x00, 0x4a, 0xce, 0xc8, 0x2c, 0x50, 0x48, 0x86, 0x13, 0x00, 0x00, 0x00, 0x00,
+    0xff, 0xff, 0x4a, 0x4e, 0x2c, 0x2a, 0xcb, 0xcc, 0x4b, 0x87, 0xd3, 0x00, 0x00, 0x00, 0x00, 0xff,
+    0xff, 0x43, 0x16, 0x04, 0x00, 0xbc, 0xb2, 0x8f, 0x9d, 0x2b, 0x00, 0x00, 0x00};
+
+const char* GZIP_TEXT = "chip chip chip carving carving chip carving";
+
+std::string gunzip(const std::vector<unsigned char>& file, size_t& chunks, bool& ok) {
+    GzipReader reader(file.data(), file.size(), 1000);
+    std::string text;
+    const unsigned char* data = nullptr;
+    size_t size = 0;
+    chunks = 0;
+    while (reader.next(data, size)) {
+        text.append(reinterpret_cast<const char*>(data), size);
+        ++chunks;
+    }
+    ok = !reader.failed();
+    return text;
+}
+
+std::string dynamicPlainText() {
+    std::string text;
+    for (int i = 0; i < 120; ++i) {
+        text += std::to_string(i * i % 97) + "," + std::to_string(i % 13) + ";";
+    }
+    return text;
+}
+
+std::string inflateToString(const std::vector<unsigned char>& stream, size_t maxOutput, bool& ok) {
+    std::vector<unsigned char> out;
+    ok = inflateZlib(stream.data(), stream.size(), out, maxOutput);
+    return std::string(out.begin(), out.end());
+}
+
+}  // namespace
+
+TEST(InflateTest, DecodesFixedHuffmanBlocks) {
+    bool ok = false;
+    EXPECT_EQ(inflateToString(FIXED_STREAM, 1000, ok), "chip chip chip carving carving");
+    EXPECT_TRUE(ok);
+}
+
+TEST(InflateTest, DecodesDynamicHuffmanBlocks) {
+    bool ok = false;
+    EXPECT_EQ(inflateToString(DYNAMIC_STREAM, 1000, ok), dynamicPlainText());
+    EXPECT_TRUE(ok);
+}
+
+TEST(InflateTest, DecodesStoredBlocks) {
+    // Two stored blocks, the second final, then the Adler-32 of "abcde"
+    std::vector<unsigned char> stream = {0x78, 0x01, 0x00, 0x03, 0x00, 0xfc, 0xff, 'a',  'b',  'c',  0x01,
+                                         0x02, 0x00, 0xfd, 0xff, 'd',  'e',  0x05, 0xc8, 0x01, 0xf0};
+    bool ok = false;
+    EXPECT_EQ(inflateToString(stream, 100, ok), "abcde");
+    EXPECT_TRUE(ok);
+
+    // The trailer is required
+    stream.resize(stream.size() - 4);
+    inflateToString(stream, 100, ok);
+    EXPECT_FALSE(ok);
+}
+
+TEST(InflateTest, RejectsBadHeadersTruncationAndOversizedOutput) {
+    bool ok = true;
+    std::vector<unsigned char> badHeader(FIXED_STREAM);
+    badHeader[1] ^= 0x01;
+    inflateToString(badHeader, 1000, ok);
+    EXPECT_FALSE(ok);
+
+    std::vector<unsigned char> truncated(DYNAMIC_STREAM.begin(), DYNAMIC_STREAM.begin() + 100);
+    inflateToString(truncated, 1000, ok);
+    EXPECT_FALSE(ok);
+
+    inflateToString(DYNAMIC_STREAM, dynamicPlainText().size() - 1, ok);
+    EXPECT_FALSE(ok);
+}
+
+TEST(InflateTest, RejectsAdlerMismatch) {
+    bool ok = true;
+    std::vector<unsigned char> wrongChecksum(FIXED_STREAM);
+    wrongChecksum.back() ^= 0x01;
+    inflateToString(wrongChecksum, 1000, ok);
+    EXPECT_FALSE(ok);
+
+    // A damaged stored block decodes, but not to the data the checksum was taken of
+    std::vector<unsigned char> damaged = {0x78, 0x01, 0x01, 0x03, 0x00, 0xfc, 0xff,
+                                          'a',  'b',  'd',  0x02, 0x4d, 0x01, 0x27};
+    inflateToString(damaged, 100, ok);
+    EXPECT_FALSE(ok);
+    damaged[9] = 'c';
+    EXPECT_EQ(inflateToString(damaged, 100, ok), "abc");
+    EXPECT_TRUE(ok);
+}
+
+TEST(InflateTest, GzipReaderDecodesOneBlockAtATime) {
+    EXPECT_TRUE(GzipReader::isGzip(GZIP_MEMBER.data(), GZIP_MEMBER.size()));
+    EXPECT_FALSE(GzipReader::isGzip(FIXED_STREAM.data(), FIXED_STREAM.size()));
+
+    size_t chunks = 0;
+    bool ok = false;
+    EXPECT_EQ(gunzip(GZIP_MEMBER, chunks, ok), GZIP_TEXT);
+    EXPECT_TRUE(ok);
+    EXPECT_EQ(chunks, 3u);
+
+    // Concatenated members read as one stream
+    std::vector<unsigned char> twoMembers(GZIP_MEMBER);
+    twoMembers.insert(twoMembers.end(), GZIP_MEMBER.begin(), GZIP_MEMBER.end());
+    EXPECT_EQ(gunzip(twoMembers, chunks, ok), std::string(GZIP_TEXT) + GZIP_TEXT);
+    EXPECT_TRUE(ok);
+}
+
+TEST(InflateTest, GzipReaderRejectsTruncationAndChecksumOrLengthMismatch) {
+    size_t chunks = 0;
+    bool ok = true;
+    std::vector<unsigned char> truncated(GZIP_MEMBER.begin(), GZIP_MEMBER.end() - 4);
+    gunzip(truncated, chunks, ok);
+    EXPECT_FALSE(ok);
+
+    std::vector<unsigned char> wrongLength(GZIP_MEMBER);
+    wrongLength[wrongLength.size() - 4] ^= 0x01;
+    gunzip(wrongLength, chunks, ok);
+    EXPECT_FALSE(ok);
+
+    std::vector<unsigned char> wrongCrc(GZIP_MEMBER);
+    wrongCrc[wrongCrc.size() - 8] ^= 0x01;
+    gunzip(wrongCrc, chunks, ok);
+    EXPECT_FALSE(ok);
+
+    // Altered data inside a stored block still decodes, and only the CRC catches it
+    // Header of GZIP_MEMBER, one stored block, then the CRC-32 and length of "abc"
+    std::vector<unsigned char> damaged(GZIP_MEMBER.begin(), GZIP_MEMBER.begin() + 20);
+    damaged.insert(damaged.end(), {0x01, 0x03, 0x00, 0xfc, 0xff, 'a', 'b', 'd', 0xc2, 0x41, 0x24, 0x35, 0x03, 0x00,
+                                   0x00, 0x00});
+    EXPECT_EQ(gunzip(damaged, chunks, ok), "abd");
+    EXPECT_FALSE(ok);
+    damaged[27] = 'c';
+    EXPECT_EQ(gunzip(damaged, chunks, ok), "abc");
+    EXPECT_TRUE(ok);
+
+    std::vector<unsigned char> badMethod(GZIP_MEMBER);
+    badMethod[2] = 0x07;
+    gunzip(badMethod, chunks, ok);
+    EXPECT_FALSE(ok);
+    EXPECT_EQ(chunks, 0u);
+}
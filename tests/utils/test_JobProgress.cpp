@@ -0,0 +1,107 @@
+/**
+ * test_JobProgress.cpp
+ *
+ * Unit tests for background job progress reporting and cancellation
+ */
+
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <string>
+#include <thread>
+
+#include "utils/JobProgress.h"
+
+using ChipCarving::Utils::JobProgress;
+
+TEST(JobProgressTest, TracksStagesAndCompletedItems) {
+    JobProgress progress;
+    JobProgress::Snapshot initial = progress.snapshot();
+    EXPECT_EQ(std::string(initial.stage), "");
+    EXPECT_EQ(initial.total, 0u);
+
+    progress.beginStage("Computing medial axes", 4);
+    progress.advance();
+    progress.advance(2);
+    JobProgress::Snapshot first = progress.snapshot();
+    EXPECT_EQ(std::string(first.stage), "Computing medial axes");
+    EXPECT_EQ(first.completed, 3u);
+    EXPECT_EQ(first.total, 4u);
+
+    // A new stage restarts the count
+    progress.beginStage("Computing V-carve toolpaths", 2);
+    JobProgress::Snapshot second = progress.snapshot();
+    EXPECT_EQ(std::string(second.stage), "Computing V-carve toolpaths");
+    EXPECT_EQ(second.completed, 0u);
+    EXPECT_EQ(second.total, 2u);
+    EXPECT_FALSE(progress.isFinished());
+}
+
+TEST(JobProgressTest, ThrottlesAdvanceButNotStagesOrFinish) {
+    JobProgress progress;
+    int notifications = 0;
+    progress.setListener([&notifications] { ++notifications; }, 60000);
+
+    progress.beginStage("stage", 100);
+    EXPECT_EQ(notifications, 1);
+
+    for (int i = 0; i < 100; ++i) {
+        progress.advance();
+    }
+    EXPECT_EQ(notifications, 1);
+
+    progress.finish();
+    EXPECT_EQ(notifications, 2);
+    EXPECT_TRUE(progress.isFinished());
+}
+
+TEST(JobProgressTest, UnthrottledListenerSeesEveryAdvance) {
+    JobProgress progress;
+    int notifications = 0;
+    progress.setListener([&notifications] { ++notifications; }, 0);
+
+    progress.beginStage("stage", 3);
+    progress.advance();
+    progress.advance();
+    progress.advance();
+    EXPECT_EQ(notifications, 4);
+}
+
+TEST(JobProgressTest, CancelIsVisibleToWorkerThread) {
+    JobProgress progress;
+    std::atomic<int> itemsDone{0};
+    progress.beginStage("stage", 1000000);
+
+    std::thread worker([&progress, &itemsDone] {
+        while (!progress.isCancelled()) {
+            progress.advance();
+            ++itemsDone;
+            std::this_thread::yield();
+        }
+        progress.finish();
+    });
+
+    while (itemsDone.load() == 0) {
+        std::this_thread::yield();
+    }
+    progress.cancel();
+    worker.join();
+
+    EXPECT_TRUE(progress.isFinished());
+    JobProgress::Snapshot snapshot = progress.snapshot();
+    EXPECT_TRUE(snapshot.cancelled);
+    EXPECT_EQ(snapshot.completed, static_cast<size_t>(itemsDone.load()));
+    EXPECT_LT(snapshot.completed, snapshot.total);
+}
+
+TEST(JobProgressTest, WaitEndsEarlyWhenCancelled) {
+    JobProgress waited;
+    EXPECT_TRUE(waited.waitUnlessCancelled(0));
+    EXPECT_TRUE(waited.waitUnlessCancelled(JobProgress::CANCEL_POLL_MS + 1));
+
+    JobProgress cancelled;
+    std::thread canceller([&cancelled] { cancelled.cancel(); });
+    canceller.join();
+    // A minute-long wait returns within one poll of the cancel
+    EXPECT_FALSE(cancelled.waitUnlessCancelled(60000));
+}
@@ -0,0 +1,66 @@
+/**
+ * test_MappedFile.cpp
+ *
+ * Unit tests for the read-only file mapping used by the design parser and disk cache
+ */
+
+#include <gtest/gtest.h>
+
+#include <filesystem>
+#include <fstream>
+#include <string>
+
+#include "utils/MappedFile.h"
+
+using ChipCarving::Utils::MappedFile;
+
+namespace {
+
+std::string writeTempFile(const std::string& name, const std::string& contents) {
+    std::string path = (std::filesystem::path(::testing::TempDir()) / name).string();
+    std::ofstream out(path, std::ios::binary | std::ios::trunc);
+    out << contents;
+    return path;
+}
+
+}  // namespace
+
+TEST(MappedFileTest, ExposesWholeFileContents) {
+    std::string contents = "{\"version\": \"2.0\"}\n";
+    contents.push_back('\0');
+    contents += "tail";
+    std::string path = writeTempFile("mapped_file_contents.bin", contents);
+
+    MappedFile file(path);
+    ASSERT_TRUE(file.isOpen());
+    EXPECT_TRUE(file.isMapped());
+    ASSERT_EQ(file.size(), contents.size());
+    EXPECT_EQ(std::string(file.chars(), file.size()), contents);
+    std::filesystem::remove(path);
+}
+
+TEST(MappedFileTest, ReadsIntoABufferWhenNotMapping) {
+    std::string path = writeTempFile("mapped_file_read.bin", "read, not mapped");
+
+    MappedFile file(path, false);
+    ASSERT_TRUE(file.isOpen());
+    EXPECT_FALSE(file.isMapped());
+    EXPECT_EQ(std::string(file.chars(), file.size()), "read, not mapped");
+    std::filesystem::remove(path);
+}
+
+TEST(MappedFileTest, EmptyFileIsOpenWithoutData) {
+    std::string path = writeTempFile("mapped_file_empty.bin", "");
+
+    MappedFile file(path);
+    EXPECT_TRUE(file.isOpen());
+    EXPECT_EQ(file.size(), 0u);
+    EXPECT_EQ(file.data(), nullptr);
+    std::filesystem::remove(path);
+}
+
+TEST(MappedFileTest, MissingFileIsNotOpen) {
+    MappedFile file((std::filesystem::path(::testing::TempDir()) / "mapped_file_missing.bin").string());
+    EXPECT_FALSE(file.isOpen());
+    EXPECT_EQ(file.data(), nullptr);
+}
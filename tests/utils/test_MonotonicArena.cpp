@@ -0,0 +1,44 @@
+/**
+ * test_MonotonicArena.cpp
+ *
+ * Unit tests for the bump allocator behind arena-allocated design parses
+ */
+
+#include <gtest/gtest.h>
+
+#include <cstdint>
+#include <vector>
+
+#include "utils/MonotonicArena.h"
+
+using ChipCarving::Utils::MonotonicArena;
+
+TEST(MonotonicArenaTest, HandsOutAlignedNonOverlappingMemory) {
+    MonotonicArena arena(256);
+    std::vector<char*> chars;
+    std::vector<double*> doubles;
+    for (int i = 0; i < 100; ++i) {
+        chars.push_back(arena.create<char>(static_cast<char>(i)));
+        doubles.push_back(arena.create<double>(i * 0.5));
+    }
+    for (int i = 0; i < 100; ++i) {
+        EXPECT_EQ(*chars[i], static_cast<char>(i));
+        EXPECT_EQ(*doubles[i], i * 0.5);
+        EXPECT_EQ(reinterpret_cast<uintptr_t>(doubles[i]) % alignof(double), 0u);
+    }
+    EXPECT_EQ(arena.bytesUsed(), 100 * (sizeof(char) + sizeof(double)));
+}
+
+TEST(MonotonicArenaTest, BlocksGrowGeometrically) {
+    MonotonicArena arena(1024);
+    for (int i = 0; i < 10000; ++i) {
+        arena.allocate(64);
+    }
+    // 640 KB from 1 KB blocks doubling each time
+    EXPECT_LE(arena.blockCount(), 11u);
+    EXPECT_GE(arena.blockCount(), 9u);
+
+    // A request larger than any block so far still gets memory
+    void* large = arena.allocate(4 * MonotonicArena::MAX_BLOCK_SIZE);
+    EXPECT_NE(large, nullptr);
+}
@@ -0,0 +1,91 @@
+/**
+ * test_RunErrorContext.cpp
+ *
+ * Unit tests for per-run error collection from worker threads
+ */
+
+#include <gtest/gtest.h>
+
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "../adapters/MockLogger.h"
+#include "utils/RunErrorContext.h"
+
+using ChipCarving::Utils::RunErrorContext;
+
+TEST(RunErrorContextTest, GuardRecordsExceptionsAndReturnsWhetherFuncCompleted) {
+    RunErrorContext context;
+    {
+        RunErrorContext::Collector collector(context);
+        int calls = 0;
+        EXPECT_TRUE(collector.guard(0, "sample", [&calls]() { ++calls; }));
+        EXPECT_FALSE(collector.guard(1, "sample", []() { throw std::runtime_error("bad chain"); }));
+        EXPECT_FALSE(collector.guard(2, "fit", []() { throw 42; }));
+        EXPECT_EQ(calls, 1);
+        EXPECT_EQ(collector.size(), 2u);
+
+        // Nothing reaches the context until the collector goes away
+        EXPECT_EQ(context.errorCount(), 0u);
+    }
+    ASSERT_EQ(context.errorCount(), 2u);
+
+    std::vector<RunErrorContext::Error> errors = context.takeErrors();
+    ASSERT_EQ(errors.size(), 2u);
+    EXPECT_EQ(errors[0].profile, 1u);
+    EXPECT_EQ(errors[0].message, "bad chain");
+    EXPECT_EQ(RunErrorContext::describe(errors[0]), "Exception in sample for profile 1: bad chain");
+    EXPECT_EQ(errors[1].profile, 2u);
+    EXPECT_EQ(errors[1].message, "Unknown exception");
+    EXPECT_EQ(context.errorCount(), 0u);
+}
+
+TEST(RunErrorContextTest, WorkersMergeInAnyOrderButReportsFollowProfiles) {
+    RunErrorContext context;
+    constexpr size_t kWorkers = 4;
+    constexpr size_t kProfiles = 200;
+
+    std::vector<std::thread> workers;
+    for (size_t w = 0; w < kWorkers; ++w) {
+        workers.emplace_back([&context, w]() {
+            RunErrorContext::Collector collector(context);
+            // Strided ownership, like workers popping profiles off a queue
+            for (size_t p = kWorkers - 1 - w; p < kProfiles; p += kWorkers) {
+                collector.guard(p, "vcarve", [p]() {
+                    if (p % 3 == 0) {
+                        throw std::runtime_error(std::to_string(p));
+                    }
+                });
+            }
+        });
+    }
+    context.record(RunErrorContext::NO_PROFILE, "run", "surface grid failed");
+    for (auto& worker : workers) {
+        worker.join();
+    }
+
+    std::vector<RunErrorContext::Error> errors = context.takeErrors();
+    ASSERT_EQ(errors.size(), (kProfiles + 2) / 3 + 1);
+    for (size_t i = 0; i + 1 < errors.size(); ++i) {
+        EXPECT_EQ(errors[i].profile, i * 3);
+        EXPECT_EQ(errors[i].message, std::to_string(i * 3));
+    }
+    EXPECT_EQ(errors.back().profile, RunErrorContext::NO_PROFILE);
+    EXPECT_EQ(RunErrorContext::describe(errors.back()), "Exception in run: surface grid failed");
+}
+
+TEST(RunErrorContextTest, ReportLogsEachErrorAndEmptiesTheContext) {
+    MockLogger logger;
+    RunErrorContext context;
+    context.record(5, "vcarve", "second");
+    context.record(2, "vcarve", "first");
+
+    EXPECT_EQ(context.report(&logger), 2u);
+    ASSERT_EQ(logger.warningMessages.size(), 2u);
+    EXPECT_EQ(logger.warningMessages[0], "Exception in vcarve for profile 2: first");
+    EXPECT_EQ(logger.warningMessages[1], "Exception in vcarve for profile 5: second");
+    EXPECT_EQ(context.errorCount(), 0u);
+    EXPECT_EQ(context.report(&logger), 0u);
+}
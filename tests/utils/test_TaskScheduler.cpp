@@ -0,0 +1,108 @@
+/**
+ * test_TaskScheduler.cpp
+ *
+ * Unit tests for the cost-ordered work-stealing pool
+ */
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <mutex>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+#include "utils/TaskScheduler.h"
+
+using ChipCarving::Utils::TaskScheduler;
+
+TEST(TaskSchedulerTest, RunsEveryTaskAndRecordsItsTiming) {
+    TaskScheduler scheduler(3);
+    std::vector<std::atomic<int>> runs(50);
+    for (size_t i = 0; i < runs.size(); ++i) {
+        scheduler.submit(static_cast<double>(i % 7), [&runs, i]() {
+            EXPECT_GE(TaskScheduler::currentWorkerIndex(), 0);
+            ++runs[i];
+        });
+    }
+    scheduler.run();
+
+    for (const auto& count : runs) {
+        EXPECT_EQ(count.load(), 1);
+    }
+    EXPECT_EQ(scheduler.timings().size(), runs.size());
+    EXPECT_EQ(TaskScheduler::currentWorkerIndex(), -1);
+}
+
+TEST(TaskSchedulerTest, SingleWorkerRunsLargestCostFirst) {
+    TaskScheduler scheduler(1);
+    std::vector<double> order;
+    for (double cost : {3.0, 40.0, 1.0, 20000.0, 7.0}) {
+        scheduler.submit(cost, [&order, cost]() { order.push_back(cost); });
+    }
+    scheduler.run();
+    EXPECT_EQ(order, (std::vector<double>{20000.0, 40.0, 7.0, 3.0, 1.0}));
+}
+
+TEST(TaskSchedulerTest, IdleWorkersStealSubtasksOfALongTask) {
+    TaskScheduler scheduler(4);
+    std::mutex mutex;
+    std::vector<int> subtaskWorkers;
+    std::atomic<int> finished{0};
+
+    // One big task splits itself; the small ones finish quickly and leave their workers idle
+    scheduler.submit(1000.0, [&]() {
+        TaskScheduler::TaskGroup group;
+        for (int t = 0; t < 8; ++t) {
+            group.spawn(10.0, [&]() {
+                std::this_thread::sleep_for(std::chrono::milliseconds(20));
+                std::lock_guard<std::mutex> lock(mutex);
+                subtaskWorkers.push_back(TaskScheduler::currentWorkerIndex());
+                ++finished;
+            });
+        }
+        group.wait();
+        EXPECT_EQ(finished.load(), 8);
+    });
+    for (int i = 0; i < 3; ++i) {
+        scheduler.submit(1.0, []() {});
+    }
+    scheduler.run();
+
+    ASSERT_EQ(subtaskWorkers.size(), 8u);
+    std::vector<bool> used(4, false);
+    for (int worker : subtaskWorkers) {
+        used[static_cast<size_t>(worker)] = true;
+    }
+    EXPECT_GT(std::count(used.begin(), used.end(), true), 1);
+
+    size_t spawned = 0;
+    for (const auto& timing : scheduler.timings()) {
+        spawned += timing.spawned ? 1 : 0;
+    }
+    EXPECT_EQ(spawned, 8u);
+    EXPECT_EQ(scheduler.timings().size(), 12u);
+}
+
+TEST(TaskSchedulerTest, RethrowsTheFirstTaskExceptionAfterAllTasksFinish) {
+    TaskScheduler scheduler(2);
+    std::atomic<int> completed{0};
+    scheduler.submit(5.0, []() { throw std::runtime_error("tile failed"); });
+    for (int i = 0; i < 10; ++i) {
+        scheduler.submit(1.0, [&completed]() { ++completed; });
+    }
+    EXPECT_THROW(scheduler.run(), std::runtime_error);
+    EXPECT_EQ(completed.load(), 10);
+}
+
+TEST(TaskSchedulerTest, TaskGroupOutsideATaskThrows) {
+    EXPECT_THROW(TaskScheduler::TaskGroup group, std::logic_error);
+}
+
+TEST(TaskSchedulerTest, FitsSecondsPerCostThroughTheOrigin) {
+    std::vector<TaskScheduler::TaskTiming> timings = {{100.0, 0.2, false}, {300.0, 0.6, false}, {0.0, 5.0, true}};
+    EXPECT_DOUBLE_EQ(TaskScheduler::fitSecondsPerCost(timings), 0.002);
+    EXPECT_DOUBLE_EQ(TaskScheduler::fitSecondsPerCost({}), 0.0);
+}
@@ -0,0 +1,279 @@
+/**
+ * test_TraceSpan.cpp
+ *
+ * Unit tests for scoped trace spans and the per-run metrics tree
+ */
+
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <cstdio>
+#include <fstream>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "parsers/JsonReader.h"
+#include "utils/AllocationTracking.h"
+#include "utils/MemoryUsage.h"
+#include "utils/PlatformTrace.h"
+#include "utils/TraceSpan.h"
+
+using ChipCarving::Parsers::JsonReader;
+using ChipCarving::Utils::RunMetrics;
+using ChipCarving::Utils::ScopedRunMetrics;
+using ChipCarving::Utils::ScopedTraceRecorder;
+using ChipCarving::Utils::TraceRecorder;
+using ChipCarving::Utils::TraceSpan;
+
+TEST(TraceSpanTest, NestsAndMergesRepeatedSpans) {
+    RunMetrics metrics;
+    {
+        ScopedRunMetrics run(metrics);
+        TraceSpan root("run");
+        for (int i = 0; i < 3; ++i) {
+            TraceSpan stage("stage");
+            TraceSpan call("fusion.call");
+        }
+        TraceSpan other("other");
+    }
+
+    ASSERT_EQ(metrics.spans().size(), 4u);
+    const RunMetrics::Span* call = metrics.find("run/stage/fusion.call");
+    ASSERT_NE(call, nullptr);
+    EXPECT_EQ(call->count, 3u);
+    EXPECT_EQ(metrics.find("run/stage")->count, 3u);
+    EXPECT_EQ(metrics.find("run")->count, 1u);
+    EXPECT_NE(metrics.find("run/other"), nullptr);
+    EXPECT_EQ(metrics.find("stage"), nullptr);
+
+    const RunMetrics::Span* root = metrics.find("run");
+    EXPECT_GE(root->totalMs, metrics.find("run/stage")->totalMs);
+    EXPECT_LE(call->maxMs, call->totalMs);
+}
+
+TEST(TraceSpanTest, SpansWithoutBoundRunAreIgnored) {
+    RunMetrics metrics;
+    {
+        TraceSpan unbound("unbound");
+    }
+    EXPECT_TRUE(metrics.empty());
+
+    ScopedRunMetrics run(metrics);
+    std::thread worker([] { TraceSpan workerSpan("worker"); });
+    worker.join();
+    EXPECT_TRUE(metrics.empty());
+}
+
+TEST(TraceSpanTest, ScopedRunMetricsRestoresPreviousBinding) {
+    RunMetrics outer;
+    RunMetrics inner;
+    {
+        ScopedRunMetrics outerRun(outer);
+        {
+            ScopedRunMetrics innerRun(inner);
+            TraceSpan span("inner");
+        }
+        TraceSpan span("outer");
+    }
+    EXPECT_NE(inner.find("inner"), nullptr);
+    EXPECT_EQ(inner.find("outer"), nullptr);
+    EXPECT_NE(outer.find("outer"), nullptr);
+    EXPECT_EQ(outer.find("inner"), nullptr);
+}
+
+TEST(TraceSpanTest, WritesOneJsonLinePerRun) {
+    RunMetrics metrics;
+    {
+        ScopedRunMetrics run(metrics);
+        TraceSpan root("generatePaths");
+        TraceSpan stage("vcarve");
+    }
+
+    std::string json = metrics.toJson();
+    EXPECT_EQ(json.find('\n'), std::string::npos);
+    EXPECT_NE(json.find("\"path\":\"generatePaths/vcarve\",\"count\":1"), std::string::npos) << json;
+
+    std::string summary = metrics.summary();
+    EXPECT_NE(summary.find("generatePaths: "), std::string::npos) << summary;
+    EXPECT_NE(summary.find("\n  vcarve: "), std::string::npos) << summary;
+
+    std::string path = ::testing::TempDir() + "trace_span_metrics.jsonl";
+    std::remove(path.c_str());
+    ASSERT_TRUE(metrics.appendTo(path));
+    ASSERT_TRUE(metrics.appendTo(path));
+
+    std::ifstream in(path);
+    std::string line;
+    int lines = 0;
+    while (std::getline(in, line)) {
+        EXPECT_EQ(line, json);
+        ++lines;
+    }
+    EXPECT_EQ(lines, 2);
+    std::remove(path.c_str());
+
+    metrics.clear();
+    EXPECT_TRUE(metrics.empty());
+}
+
+TEST(TraceSpanTest, AttributesAllocationsToOpenSpans) {
+    RunMetrics metrics;
+    {
+        ScopedRunMetrics run(metrics);
+        TraceSpan root("run");
+        {
+            TraceSpan stage("stage");
+            std::vector<std::unique_ptr<double>> values;
+            values.reserve(4);
+            for (int i = 0; i < 4; ++i) {
+                values.push_back(std::make_unique<double>(i));
+            }
+        }
+        TraceSpan idle("idle");
+    }
+
+    const RunMetrics::Span* root = metrics.find("run");
+    const RunMetrics::Span* stage = metrics.find("run/stage");
+    ASSERT_NE(stage, nullptr);
+    std::string summary = metrics.summary();
+    std::string json = metrics.toJson();
+    if (!ChipCarving::Utils::allocationTrackingEnabled()) {
+        EXPECT_EQ(stage->allocations, 0u);
+        EXPECT_EQ(summary.find("allocs"), std::string::npos) << summary;
+        EXPECT_EQ(json.find("allocations"), std::string::npos) << json;
+        return;
+    }
+
+    // The vector's buffer and four doubles, counted again by the enclosing span
+    EXPECT_EQ(stage->allocations, 5u);
+    EXPECT_GE(stage->allocatedBytes, 4 * sizeof(void*) + 4 * sizeof(double));
+    EXPECT_GE(root->allocations, stage->allocations);
+    EXPECT_EQ(metrics.find("run/idle")->allocations, 0u);
+    EXPECT_NE(summary.find("stage: "), std::string::npos) << summary;
+    EXPECT_NE(summary.find(" [5 allocs, "), std::string::npos) << summary;
+    EXPECT_NE(json.find("\"allocations\":5,\"allocatedBytes\":"), std::string::npos) << json;
+}
+
+TEST(TraceSpanTest, KeepsMemoryPeaksOfNestedSpans) {
+    using ChipCarving::Utils::MemorySampler;
+
+    RunMetrics unsampled;
+    {
+        ScopedRunMetrics run(unsampled);
+        TraceSpan root("run");
+    }
+    EXPECT_EQ(unsampled.find("run")->peakResidentBytes, 0u);
+    EXPECT_EQ(unsampled.toJson().find("peakResidentBytes"), std::string::npos);
+
+    RunMetrics metrics;
+    const size_t blockBytes = 4 << 20;
+    {
+        MemorySampler sampler(1);
+        ScopedRunMetrics run(metrics);
+        TraceSpan root("run");
+        {
+            TraceSpan stage("stage");
+            std::vector<char> block(blockBytes, 1);
+            std::this_thread::sleep_for(std::chrono::milliseconds(5));
+        }
+        TraceSpan idle("idle");
+    }
+
+    const RunMetrics::Span* root = metrics.find("run");
+    const RunMetrics::Span* stage = metrics.find("run/stage");
+    const RunMetrics::Span* idle = metrics.find("run/idle");
+    ASSERT_NE(stage, nullptr);
+    ASSERT_NE(idle, nullptr);
+    if (ChipCarving::Utils::currentResidentBytes() > 0) {
+        EXPECT_GT(stage->peakResidentBytes, 0u);
+        EXPECT_GE(root->peakResidentBytes, stage->peakResidentBytes);
+        EXPECT_GE(root->peakResidentBytes, idle->peakResidentBytes);
+        EXPECT_NE(metrics.toJson().find("\"peakResidentBytes\":"), std::string::npos);
+        EXPECT_NE(metrics.summary().find("[peak RSS "), std::string::npos) << metrics.summary();
+        EXPECT_GE(ChipCarving::Utils::processPeakResidentBytes(), stage->peakResidentBytes / 2);
+    }
+    if (ChipCarving::Utils::allocationTrackingEnabled()) {
+        // The block is freed before idle opens
+        EXPECT_GE(stage->peakLiveBytes, blockBytes);
+        EXPECT_GT(stage->peakLiveBytes, idle->peakLiveBytes + blockBytes / 2);
+        EXPECT_GE(root->peakLiveBytes, stage->peakLiveBytes);
+    } else {
+        EXPECT_EQ(stage->peakLiveBytes, 0u);
+    }
+}
+
+TEST(TraceSpanTest, RecorderKeepsSpansPerThreadAndCounters) {
+    RunMetrics metrics;
+    TraceRecorder recorder;
+    {
+        ScopedRunMetrics run(metrics, &recorder);
+        TraceSpan root("generatePaths");
+        ChipCarving::Utils::traceCount("splinesCreated");
+        ChipCarving::Utils::traceCount("splinesCreated", 2.0);
+
+        TraceRecorder* shared = ChipCarving::Utils::currentTraceRecorder();
+        std::thread worker([shared] {
+            ScopedTraceRecorder trace(shared);
+            TraceSpan span("medialAxisProfile");
+        });
+        worker.join();
+    }
+
+    // Worker spans reach the trace but not the command thread's metrics tree
+    EXPECT_EQ(recorder.eventCount(), 4u);
+    EXPECT_EQ(metrics.spans().size(), 1u);
+
+    std::string json = recorder.toJson();
+    EXPECT_NE(json.find("\"name\":\"medialAxisProfile\",\"ph\":\"X\",\"pid\":1,\"tid\":1"), std::string::npos)
+        << json;
+    EXPECT_NE(json.find("\"name\":\"generatePaths\",\"ph\":\"X\",\"pid\":1,\"tid\":0"), std::string::npos) << json;
+    EXPECT_NE(json.find("\"args\":{\"value\":3.000}"), std::string::npos) << json;
+    EXPECT_NE(json.find("\"args\":{\"name\":\"worker 1\"}"), std::string::npos) << json;
+
+    // Output must be well-formed JSON for the trace viewers
+    JsonReader reader(json);
+    EXPECT_NO_THROW({
+        reader.skipValue();
+        reader.expectEnd();
+    });
+}
+
+TEST(TraceSpanTest, RecorderAloneDoesNotBuildMetrics) {
+    TraceRecorder recorder;
+    {
+        ScopedTraceRecorder trace(&recorder);
+        TraceSpan span("untimed");
+    }
+    EXPECT_EQ(recorder.eventCount(), 1u);
+    EXPECT_EQ(recorder.droppedCount(), 0u);
+    EXPECT_EQ(ChipCarving::Utils::currentTraceRecorder(), nullptr);
+}
+
+TEST(TraceSpanTest, PlatformAnnotationsFollowTheSwitchAndLeaveMetricsAlone) {
+    using ChipCarving::Utils::platformTraceBackend;
+    using ChipCarving::Utils::platformTraceEnabled;
+    using ChipCarving::Utils::setPlatformTraceEnabled;
+
+    std::string backend = platformTraceBackend();
+    EXPECT_TRUE(backend == "os_signpost" || backend == "ITT" || backend == "ETW" || backend == "none") << backend;
+    EXPECT_FALSE(platformTraceEnabled());
+
+    setPlatformTraceEnabled(true);
+    EXPECT_EQ(platformTraceEnabled(), backend != "none");
+    RunMetrics metrics;
+    {
+        TraceSpan unbound("annotatedOnly");
+        ScopedRunMetrics run(metrics);
+        TraceSpan outer("outer");
+        std::thread worker([] { TraceSpan workerSpan("worker"); });
+        worker.join();
+        TraceSpan inner("inner");
+    }
+    setPlatformTraceEnabled(false);
+    EXPECT_FALSE(platformTraceEnabled());
+
+    ASSERT_EQ(metrics.spans().size(), 2u);
+    EXPECT_NE(metrics.find("outer/inner"), nullptr);
+}
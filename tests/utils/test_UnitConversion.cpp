@@ -159,4 +159,32 @@ TEST_F(UnitConversionTest, PracticalParameterValues) {
     double angle60Deg = 60.0;
     double angle60Rad = degreesToFusionAngle(angle60Deg);
     EXPECT_TRUE(isNearlyEqual(angle60Rad, M_PI / 3));
-}
\ No newline at end of file
+}
+
+// Typed lengths
+TEST_F(UnitConversionTest, TypedLengthsConvertOnlyByCast) {
+    constexpr FusionLength toolRadius(0.3175);
+    constexpr Millimeters toolRadiusMm = toMillimeters(toolRadius);
+    static_assert(toolRadiusMm.value() == 0.3175 * 10.0, "converts at compile time");
+    EXPECT_DOUBLE_EQ(toolRadiusMm.value(), 3.175);
+    EXPECT_DOUBLE_EQ(toFusionLength(toolRadiusMm).value(), toolRadius.value());
+
+    // Casts produce exactly what the scalar helpers do
+    const double testValues[] = {0.0, 1.0, 0.1, -5.0, 123.456, 0.00001, 25.4};
+    for (double value : testValues) {
+        EXPECT_EQ(toMillimeters(FusionLength(value)).value(), value * 10.0);
+        EXPECT_EQ(toFusionLength(Millimeters(value)).value(), value / 10.0);
+        EXPECT_EQ(lengthCast<MillimeterUnit>(Millimeters(value)).value(), value);
+    }
+
+    Millimeters a(2.0);
+    Millimeters b(0.5);
+    EXPECT_DOUBLE_EQ((a + b).value(), 2.5);
+    EXPECT_DOUBLE_EQ((a - b).value(), 1.5);
+    EXPECT_DOUBLE_EQ((-a).value(), -2.0);
+    EXPECT_DOUBLE_EQ((a * 3.0).value(), 6.0);
+    EXPECT_DOUBLE_EQ((a / 4.0).value(), 0.5);
+    EXPECT_DOUBLE_EQ(a / b, 4.0);
+    EXPECT_TRUE(b < a);
+    EXPECT_TRUE(Millimeters() == Millimeters(0.0));
+}